@@ -26,6 +26,39 @@ bool ChiObjectFactory::RegistryHasKey(const std::string& key) const
   return object_registry_.count(key) > 0;
 }
 
+// ###################################################################
+/**Adds object types that are only registered once a library is loaded,
+ * by the given loader, when one of them is first made. This keeps, e.g.,
+ * plug-ins from being loaded by inputs that do not use them.*/
+void ChiObjectFactory::AddDeferredObjectTypes(
+  const std::vector<std::string>& types, DeferredLoaderFunc loader)
+{
+  for (const auto& type : types)
+  {
+    AssertRegistryKeyAvailable(type, __PRETTY_FUNCTION__);
+    ChiLogicalErrorIf(deferred_loaders_.count(type) > 0,
+                      "Attempted to defer object \"" + type +
+                        "\" but it is already deferred.");
+    deferred_loaders_[type] = loader;
+  }
+}
+
+// ###################################################################
+/**Removes deferred object types, e.g., when their loader is destroyed.*/
+void ChiObjectFactory::RemoveDeferredObjectTypes(
+  const std::vector<std::string>& types)
+{
+  for (const auto& type : types)
+    deferred_loaders_.erase(type);
+}
+
+// ###################################################################
+/**Returns true if the type is deferred and not yet registered.*/
+bool ChiObjectFactory::IsDeferredObjectType(const std::string& key) const
+{
+  return deferred_loaders_.count(key) > 0 and not RegistryHasKey(key);
+}
+
 // ###################################################################
 /**Makes an object with the given parameters and places on the global
  * object stack. Returns a handle to the object. The object type is
@@ -61,6 +94,19 @@ size_t ChiObjectFactory::MakeRegisteredObjectOfType(
 
   const std::string fname = __PRETTY_FUNCTION__;
 
+  if (IsDeferredObjectType(type))
+  {
+    if (Chi::log.GetVerbosity() >= 2)
+      Chi::log.Log() << "Loading deferred object type " << type;
+
+    const auto loader = deferred_loaders_.at(type);
+    loader();
+
+    ChiLogicalErrorIf(object_registry_.count(type) == 0,
+                      "Loading the library of deferred object type \"" +
+                        type + "\" did not register it.");
+  }
+
   if (object_registry_.count(type) == 0)
     throw std::logic_error(fname + ": No registered type \"" + type +
                            "\" found.");
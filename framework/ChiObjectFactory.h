@@ -6,6 +6,8 @@
 
 #include "chi_log_exceptions.h"
 
+#include <functional>
+
 /**Small utility macro for joining two words.*/
 #define ChiObjectFactoryJoinWordsA(x, y) x##y
 /**IDK why this is needed. Seems like counter doesnt work properly without it*/
@@ -77,6 +79,10 @@ public:
     ObjectConstructorFunc constructor_func = nullptr;
   };
 
+  /**Function loading the library that registers deferred object types.
+   * It must be safe to call more than once.*/
+  using DeferredLoaderFunc = std::function<void()>;
+
   // Deleted copy, move constructors and copy assignment operator
   ChiObjectFactory(const ChiObjectFactory&) = delete;
   ChiObjectFactory(const ChiObjectFactory&&) = delete;
@@ -136,6 +142,15 @@ public:
     return 0;
   }
 
+  /**Adds object types that are only registered once a library is loaded,
+   * by the given loader, when one of them is first made.*/
+  void AddDeferredObjectTypes(const std::vector<std::string>& types,
+                              DeferredLoaderFunc loader);
+  /**Removes deferred object types, e.g., when their loader is destroyed.*/
+  void RemoveDeferredObjectTypes(const std::vector<std::string>& types);
+  /**Returns true if the type is deferred and not yet registered.*/
+  bool IsDeferredObjectType(const std::string& key) const;
+
   size_t MakeRegisteredObject(const chi::ParameterBlock& params) const;
   size_t MakeRegisteredObjectOfType(const std::string& type,
                                     const chi::ParameterBlock& params) const;
@@ -145,6 +160,7 @@ public:
 
 private:
   std::map<std::string, ObjectRegistryEntry> object_registry_;
+  std::map<std::string, DeferredLoaderFunc> deferred_loaders_;
 
   /**Private constructor because this is a singleton.*/
   ChiObjectFactory() = default;
@@ -13,12 +13,15 @@
 #include "chi_mpi.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
+#include "utils/chi_telemetry.h"
+#include "utils/chi_worker_threads.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 
-#ifndef NDEBUG
 #include <unistd.h>
-#endif
 
 //=============================================== Global variables
 chi::Console& Chi::console = chi::Console::GetInstance();
@@ -51,6 +54,15 @@ bool Chi::run_time::allow_petsc_error_handler_ = false;
 bool Chi::run_time::supress_beg_end_timelog_ = false;
 bool Chi::run_time::suppress_color_ = false;
 bool Chi::run_time::dump_registry_ = false;
+std::string Chi::run_time::trace_file_name_;
+size_t Chi::run_time::trace_capacity_ = 262144;
+std::string Chi::run_time::hw_counter_events_;
+std::string Chi::run_time::telemetry_file_name_;
+int Chi::run_time::num_angle_teams_ = 1;
+bool Chi::run_time::pin_threads_ = false;
+std::string Chi::run_time::server_queue_dir_;
+bool Chi::run_time::aggregate_logs_ = false;
+std::string Chi::run_time::location_log_file_base_;
 
 const std::string Chi::run_time::command_line_help_string_ =
   "\nUsage: exe inputfile [options values]\n"
@@ -65,6 +77,32 @@ const std::string Chi::run_time::command_line_help_string_ =
   "     --suppress_color            Suppresses the printing of color.\n"
   "                                 useful for unit tests requiring a diff.\n"
   "     --dump-object-registry      Dumps the object registry.\n"
+  "     --trace=<file>              Writes a Chrome trace of the profiled\n"
+  "                                 regions of every location to file.\n"
+  "     --trace_capacity=<n>        Maximum number of trace events kept\n"
+  "                                 per thread. Default 262144.\n"
+  "     --hw_counters=<events>      Counts the comma separated PAPI events,\n"
+  "                                 e.g. PAPI_DP_OPS,PAPI_L3_TCM, of the\n"
+  "                                 profiled regions. Requires PAPI.\n"
+  "     --telemetry=<file>          Streams the iteration telemetry, in\n"
+  "                                 JSON lines, to file.\n"
+  "     --angle_teams=<n>           Splits the processes into n teams that\n"
+  "                                 each sweep a subset of the angle sets\n"
+  "                                 of a spatial decomposition over the\n"
+  "                                 team. Default 1.\n"
+  "     --pin_threads               Pins the OpenMP worker threads to cores,\n"
+  "                                 grouped by NUMA domain.\n"
+  "     --serve=<dir>               Stays alive after the input file and\n"
+  "                                 executes the .lua files queued in dir,\n"
+  "                                 in name order, until a file named\n"
+  "                                 shutdown appears. Lua globals, meshes\n"
+  "                                 and solvers persist between jobs.\n"
+  "     --aggregate_logs[=<base>]   Defers the all-locations logs to the\n"
+  "                                 barriers, where location 0 prints each\n"
+  "                                 distinct line once with the ranges of\n"
+  "                                 the locations that logged it. With\n"
+  "                                 base, every location also writes them\n"
+  "                                 to base.<location>.log.\n"
   "\n\n\n";
 
 // ############################################### Argument parser
@@ -81,7 +119,68 @@ void Chi::run_time::ParseArguments(int argc, char** argv)
 
     Chi::log.Log() << "Parsing argument " << i << " " << argument;
 
-    if (argument.find("-h") != std::string::npos or
+    if (argument.rfind("--trace=", 0) == 0)
+    {
+      Chi::run_time::trace_file_name_ = argument.substr(8);
+    }
+    else if (argument.rfind("--serve=", 0) == 0)
+    {
+      Chi::run_time::server_queue_dir_ = argument.substr(8);
+      Chi::run_time::sim_option_interactive_ = false;
+    }
+    else if (argument.rfind("--telemetry=", 0) == 0)
+    {
+      Chi::run_time::telemetry_file_name_ = argument.substr(12);
+    }
+    else if (argument.rfind("--hw_counters=", 0) == 0)
+    {
+      Chi::run_time::hw_counter_events_ = argument.substr(14);
+    }
+    else if (argument.rfind("--trace_capacity=", 0) == 0)
+    {
+      try
+      {
+        Chi::run_time::trace_capacity_ = std::stoul(argument.substr(17));
+      }
+      catch (const std::logic_error& e)
+      {
+        std::cerr << "Invalid value used with command line argument "
+                     "--trace_capacity."
+                  << std::endl;
+        Chi::Exit(EXIT_FAILURE);
+      }
+    }
+    else if (argument == "--pin_threads")
+    {
+      Chi::run_time::pin_threads_ = true;
+    }
+    else if (argument.rfind("--aggregate_logs", 0) == 0)
+    {
+      Chi::run_time::aggregate_logs_ = true;
+      if (argument.rfind("--aggregate_logs=", 0) == 0)
+        Chi::run_time::location_log_file_base_ = argument.substr(17);
+    }
+    else if (argument.rfind("--angle_teams=", 0) == 0)
+    {
+      int num_teams = 0;
+      try
+      {
+        num_teams = std::stoi(argument.substr(14));
+      }
+      catch (const std::logic_error& e)
+      {
+      }
+      if (num_teams < 1 or Chi::mpi.process_count % num_teams != 0)
+      {
+        std::cerr << "Invalid value used with command line argument "
+                     "--angle_teams. The number of processes must be "
+                     "divisible by it."
+                  << std::endl;
+        Chi::Exit(EXIT_FAILURE);
+      }
+      Chi::run_time::num_angle_teams_ = num_teams;
+    }
+    else if (argument.find("-h") != std::string::npos or
         argument.find("--help") != std::string::npos)
     {
       Chi::log.Log() << Chi::run_time::command_line_help_string_;
@@ -181,8 +280,33 @@ int Chi::Initialize(int argc,
 
   run_time::ParseArguments(argc, argv);
 
+  if (run_time::num_angle_teams_ > 1)
+  {
+    mpi.SplitIntoAngleTeams(run_time::num_angle_teams_);
+    Chi::console.PostMPIInfo(mpi.location_id, mpi.process_count);
+  }
+
+  if (run_time::aggregate_logs_)
+    log.EnableAggregation(run_time::location_log_file_base_);
+
   run_time::InitPetSc(argc, argv);
 
+  if (not run_time::trace_file_name_.empty())
+    chi::Profiler::GetInstance().EnableTracing(run_time::trace_capacity_);
+
+  if (not run_time::hw_counter_events_.empty())
+    chi::HardwareCounters::GetInstance().Enable(run_time::hw_counter_events_);
+
+  if (not run_time::telemetry_file_name_.empty())
+    chi::Telemetry::GetInstance().Open(run_time::telemetry_file_name_);
+
+  if (run_time::pin_threads_)
+  {
+    auto& worker_threads = chi::WorkerThreads::GetInstance();
+    worker_threads.PinToCores();
+    Chi::log.LogAllVerbose1() << worker_threads.PlacementString();
+  }
+
   return 0;
 }
 
@@ -215,6 +339,13 @@ void Chi::Finalize()
   material_stack.clear();
   multigroup_xs_stack.clear();
 
+  if (not run_time::trace_file_name_.empty())
+    chi::Profiler::GetInstance().WriteChromeTrace(run_time::trace_file_name_);
+
+  chi::HardwareCounters::GetInstance().Finalize();
+  chi::Telemetry::GetInstance().Close();
+  log.FlushAggregatedLogs();
+
   PetscFinalize();
   MPI_Finalize();
 }
@@ -257,6 +388,7 @@ int Chi::RunInteractive(int argc, char** argv)
 
   if (not Chi::run_time::supress_beg_end_timelog_)
   {
+    chi::Profiler::GetInstance().LogReport();
     Chi::log.Log() << "Final program time " << program_timer.GetTimeString();
     Chi::log.Log() << chi::Timer::GetLocalDateTimeString()
                    << " ChiTech finished execution.";
@@ -313,6 +445,7 @@ int Chi::RunBatch(int argc, char** argv)
 
   if (not Chi::run_time::supress_beg_end_timelog_)
   {
+    chi::Profiler::GetInstance().LogReport();
     Chi::log.Log() << "\nFinal program time " << program_timer.GetTimeString();
     Chi::log.Log() << chi::Timer::GetLocalDateTimeString()
                    << " ChiTech finished execution of "
@@ -322,6 +455,162 @@ int Chi::RunBatch(int argc, char** argv)
   return error_code;
 }
 
+// ############################################### Server interface
+namespace
+{
+const std::string SERVER_SHUTDOWN_FILE = "shutdown";
+
+/**Broadcasts a string from location 0 of the first angle team to all the
+ * processes, over the cross-team and then the team communicators.*/
+void BroadcastFromHome(std::string& value)
+{
+  auto Broadcast = [&value](MPI_Comm communicator)
+  {
+    auto size = static_cast<int>(value.size());
+    MPI_Bcast(&size, 1, MPI_INT, 0, communicator);
+    value.resize(size);
+    MPI_Bcast(value.data(), size, MPI_CHAR, 0, communicator);
+  };
+
+  if (Chi::mpi.location_id == 0) Broadcast(Chi::mpi.cross_team_comm);
+  Broadcast(Chi::mpi.comm);
+}
+
+/**Claims the first queued job of the directory, in name order, by
+ * renaming it with a ".running" suffix. Returns the claimed path, the
+ * name of the shutdown file when it is present, or an empty string.*/
+std::string ClaimNextServerJob(const std::filesystem::path& queue_dir)
+{
+  namespace fs = std::filesystem;
+  std::error_code error;
+
+  if (fs::exists(queue_dir / SERVER_SHUTDOWN_FILE, error))
+  {
+    fs::remove(queue_dir / SERVER_SHUTDOWN_FILE, error);
+    return SERVER_SHUTDOWN_FILE;
+  }
+
+  std::vector<fs::path> jobs;
+  for (const auto& entry : fs::directory_iterator(queue_dir, error))
+    if (entry.is_regular_file(error) and entry.path().extension() == ".lua")
+      jobs.push_back(entry.path());
+  if (jobs.empty()) return {};
+
+  const auto job = *std::min_element(jobs.begin(), jobs.end());
+  fs::path running_job = job;
+  running_job += ".running";
+  fs::rename(job, running_job, error);
+  return error ? std::string() : running_job.string();
+}
+} // namespace
+
+/**Runs ChiTech as a persistent server. The input file, if any, is
+ * executed first, e.g., to build the mesh and materials, after which
+ * the server executes the jobs queued in the directory given with
+ * `--serve`. Jobs run in the same Lua state and with the same stacks, so
+ * that an input can reuse the grids, discretizations and solvers of
+ * earlier jobs, e.g., by testing a Lua global set by the first job.
+ * The global `chi_server_job` holds the index of the running job. A
+ * finished job is renamed with a ".done" or ".failed" suffix.*/
+int Chi::RunServer(int argc, char** argv)
+{
+  namespace fs = std::filesystem;
+  const fs::path queue_dir(Chi::run_time::server_queue_dir_);
+  const unsigned int poll_interval_us = 200000;
+
+  Chi::log.Log() << chi::Timer::GetLocalDateTimeString()
+                 << " Running ChiTech in server-mode with "
+                 << Chi::mpi.process_count << " processes, queue directory "
+                 << queue_dir.string();
+  Chi::log.Log() << "ChiTech version " << GetVersionStr();
+  Chi::console.FlushConsole();
+
+  //============================================= Setup input
+  const auto& input_fname = Chi::run_time::input_file_name_;
+  if ((not input_fname.empty()) and (not Chi::run_time::termination_posted_))
+  {
+    try
+    {
+      if (Chi::console.ExecuteFile(input_fname, argc, argv) != EXIT_SUCCESS)
+        Chi::Exit(EXIT_FAILURE);
+    }
+    catch (const std::exception& excp)
+    {
+      Chi::log.LogAllError() << excp.what();
+      Chi::Exit(EXIT_FAILURE);
+    }
+  }
+
+  //============================================= Job loop
+  size_t num_jobs = 0;
+  while (not Chi::run_time::termination_posted_)
+  {
+    std::string job;
+    if (Chi::mpi.location_id == 0 and Chi::mpi.angle_team_id == 0)
+      job = ClaimNextServerJob(queue_dir);
+    BroadcastFromHome(job);
+
+    if (job.empty())
+    {
+      usleep(poll_interval_us);
+      continue;
+    }
+    if (job == SERVER_SHUTDOWN_FILE) break;
+
+    ++num_jobs;
+    // Set directly, the command buffer is re-executed on every flush
+    lua_State* L = Chi::console.GetConsoleState();
+    lua_pushinteger(L, static_cast<lua_Integer>(num_jobs));
+    lua_setglobal(L, "chi_server_job");
+
+    Chi::log.Log() << chi::Timer::GetLocalDateTimeString()
+                   << " Server job " << num_jobs << " " << job;
+    chi::Timer job_timer;
+    job_timer.Reset();
+
+    int local_error_code = EXIT_SUCCESS;
+    try
+    {
+      local_error_code = Chi::console.ExecuteFile(job, argc, argv);
+    }
+    catch (const std::exception& excp)
+    {
+      Chi::log.LogAllError() << excp.what();
+      local_error_code = EXIT_FAILURE;
+    }
+
+    int error_code = EXIT_SUCCESS;
+    MPI_Allreduce(&local_error_code, &error_code, 1, MPI_INT, MPI_MAX,
+                  Chi::mpi.comm);
+
+    //====================================== Mark the job finished
+    const std::string suffix =
+      (error_code == EXIT_SUCCESS) ? ".done" : ".failed";
+    if (Chi::mpi.location_id == 0 and Chi::mpi.angle_team_id == 0)
+    {
+      fs::path finished_job(job);
+      finished_job.replace_extension(suffix);
+      std::error_code error;
+      fs::rename(job, finished_job, error);
+    }
+
+    Chi::log.Log() << "Server job " << num_jobs
+                   << (error_code == EXIT_SUCCESS ? " done" : " failed")
+                   << " in " << job_timer.GetTime() / 1000.0 << " s";
+  }
+
+  if (not Chi::run_time::supress_beg_end_timelog_)
+  {
+    chi::Profiler::GetInstance().LogReport();
+    Chi::log.Log() << "\nFinal program time " << program_timer.GetTimeString();
+    Chi::log.Log() << chi::Timer::GetLocalDateTimeString()
+                   << " ChiTech server finished after " << num_jobs
+                   << " jobs.";
+  }
+
+  return 0;
+}
+
 // ###################################################################
 /** Exits the program appropriately.*/
 void Chi::Exit(int error_code) { MPI_Abort(mpi.comm, error_code); }
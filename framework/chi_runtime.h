@@ -107,6 +107,15 @@ public:
     static bool supress_beg_end_timelog_;
     static bool suppress_color_;
     static bool dump_registry_;
+    static std::string trace_file_name_;
+    static size_t trace_capacity_;
+    static std::string hw_counter_events_;
+    static std::string telemetry_file_name_;
+    static int num_angle_teams_;
+    static bool pin_threads_;
+    static std::string server_queue_dir_;
+    static bool aggregate_logs_;
+    static std::string location_log_file_base_;
 
     static const std::string command_line_help_string_;
 
@@ -152,6 +161,7 @@ public:
 public:
   static int RunInteractive(int argc, char** argv);
   static int RunBatch(int argc, char** argv);
+  static int RunServer(int argc, char** argv);
   static int Initialize(int argc, char** argv, MPI_Comm communicator);
   static void Finalize();
   static void Exit(int error_code);
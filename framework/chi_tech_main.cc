@@ -12,7 +12,9 @@ int main(int argc, char** argv)
   Chi::Initialize(argc, argv, MPI_COMM_WORLD);
 
   int error_code;
-  if (Chi::run_time::sim_option_interactive_)
+  if (not Chi::run_time::server_queue_dir_.empty())
+    error_code = Chi::RunServer(argc, argv);
+  else if (Chi::run_time::sim_option_interactive_)
     error_code = Chi::RunInteractive(argc, argv);
   else
     error_code = Chi::RunBatch(argc, argv);
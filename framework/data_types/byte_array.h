@@ -38,6 +38,41 @@ namespace chi_data_types
         raw_data_.push_back(value_byte_array[b]);
     }
 
+    /**Appends `num_bytes` bytes, copied from `data`, to the internal
+     * byte-array in a single insertion.*/
+    void WriteBytes(const void* data, const size_t num_bytes)
+    {
+      const auto* bytes = static_cast<const std::byte*>(data);
+      raw_data_.insert(raw_data_.end(), bytes, bytes + num_bytes);
+    }
+
+    /**Returns a pointer to `num_bytes` bytes of the internal byte-array
+     * starting at the internal address specified by the argument "address",
+     * without copying them. An optional argument next_address can be used to
+     * return the location after the bytes.
+     *
+     * Bounds-checking is performed as for `Read`.*/
+    const std::byte* ReadBytes(const size_t address,
+                               const size_t num_bytes,
+                               size_t* next_address = nullptr) const
+    {
+      if (num_bytes > raw_data_.size() or
+          address > raw_data_.size() - num_bytes)
+        throw std::logic_error(
+          std::string("ByteArray reading error. ") +
+          " address: " + std::to_string(address) +
+          " size: " + std::to_string(raw_data_.size()) +
+          " num_bytes to read: " + std::to_string(num_bytes));
+
+      if (next_address != nullptr) *next_address = address + num_bytes;
+
+      return raw_data_.data() + address;
+    }
+
+    /**Reserves capacity for the given total number of bytes, e.g., before
+     * writing a sequence of values of known size.*/
+    void Reserve(const size_t num_bytes) { raw_data_.reserve(num_bytes); }
+
     /**Uses the template type `T` to convert `sizeof(T)` number of bytes to
      * a value of type `T`. The bytes are pulled from the internal byte-array
      * starting at the internal address `m_offset` which can be viewed with a
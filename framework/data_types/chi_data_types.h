@@ -24,6 +24,8 @@ namespace chi_data_types
 
   template<typename T>
   class NDArray;
+  template<typename T>
+  class NDArrayView;
 }//namespace chi_data_types
 
 #endif //CHI_DATA_TYPES_CHI_DATA_TYPES_H
\ No newline at end of file
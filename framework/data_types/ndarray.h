@@ -7,6 +7,10 @@
 #include <vector>
 #include <array>
 #include <stdexcept>
+#include <memory>
+#include <new>
+
+#include "ndarray_view.h"
 
 namespace chi_data_types
 {
@@ -33,6 +37,40 @@ private:
   template<typename... U>
   using AllIntegral = typename conjunction<std::is_integral<U>...>::type;
 
+public:
+  /**Alignment, in bytes, of the elements, the size of a cache line and of
+   * the widest vector registers.*/
+  static constexpr size_t ALIGNMENT = 64;
+
+private:
+  /**Allocates aligned memory for `size` elements initialized to `value`.*/
+  static T* Allocate(size_t size, const T& value)
+  {
+    if (size == 0) return nullptr;
+    auto* memory = static_cast<T*>(
+      ::operator new[](size * sizeof(T), std::align_val_t(ALIGNMENT)));
+    std::uninitialized_fill_n(memory, size, value);
+    return memory;
+  }
+
+  /**Allocates aligned memory for a copy of `size` elements.*/
+  static T* AllocateCopy(size_t size, const T* other)
+  {
+    if (size == 0) return nullptr;
+    auto* memory = static_cast<T*>(
+      ::operator new[](size * sizeof(T), std::align_val_t(ALIGNMENT)));
+    std::uninitialized_copy_n(other, size, memory);
+    return memory;
+  }
+
+  /**Destroys and frees memory of `size` elements from Allocate.*/
+  static void Deallocate(T* memory, size_t size) noexcept
+  {
+    if (memory == nullptr) return;
+    std::destroy_n(memory, size);
+    ::operator delete[](memory, std::align_val_t(ALIGNMENT));
+  }
+
 public:
   /** Creates an array with the specified number of elements in each dimension,
    *  from a vector-list.
@@ -73,9 +111,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = 0.0;
+    base_ = Allocate(size_, static_cast<T>(0.0));
   }
 
   /** Creates an array with the specified number of elements in each dimension,
@@ -115,9 +151,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = 0.0;
+    base_ = Allocate(size_, static_cast<T>(0.0));
   }
 
   /** Creates an array with the specified number of elements in each dimension,
@@ -164,9 +198,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = 0.0;
+    base_ = Allocate(size_, static_cast<T>(0.0));
   }
 
   /** Creates an array with the specified number of elements in each dimension,
@@ -209,9 +241,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = value;
+    base_ = Allocate(size_, value);
   }
 
   /** Creates an array with the specified number of elements in each dimension,
@@ -252,9 +282,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = value;
+    base_ = Allocate(size_, value);
   }
 
   /** Creates an array with the specified number of elements in each dimension,
@@ -303,9 +331,7 @@ public:
         strides_[i] *= dimensions_[j];
     }
 
-    base_ = new T[size_];
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = value;
+    base_ = Allocate(size_, value);
   }
 
   /** Creates an empty array.
@@ -333,16 +359,13 @@ public:
     const size_t N = rank_;
     strides_ = new size_t[N];
     dimensions_ = new size_t[N];
-    base_ = new T[size_];
+    base_ = AllocateCopy(size_, other.base_);
 
     for(size_t i = 0; i < N; ++i)
     {
       dimensions_[i] = other.dimensions_[i];
       strides_[i]    = other.strides_[i];
     }
-
-    for (size_t i=0; i < size_; ++i)
-      base_[i] = other.base_[i];
   }
 
   /** Assign from another array.
@@ -439,7 +462,7 @@ public:
     dimensions_ = nullptr;
     delete [] strides_;
     strides_ = nullptr;
-    delete [] base_;
+    Deallocate(base_, size_);
     base_ = nullptr;
 
     NDArray<T>(dims).swap(*this);
@@ -464,7 +487,7 @@ public:
     dimensions_ = nullptr;
     delete [] strides_;
     strides_ = nullptr;
-    delete [] base_;
+    Deallocate(base_, size_);
     base_ = nullptr;
 
     NDArray<T>(dims).swap(*this);
@@ -489,7 +512,7 @@ public:
     dimensions_ = nullptr;
     delete [] strides_;
     strides_ = nullptr;
-    delete [] base_;
+    Deallocate(base_, size_);
     base_ = nullptr;
 
     NDArray<T>(dims).swap(*this);
@@ -599,6 +622,19 @@ public:
     return index;
   }
 
+  /**Returns a non-owning view of the whole array, which can be sliced
+   * without copying.*/
+  NDArrayView<T> View()
+  {
+    return NDArrayView<T>(base_, dimension());
+  }
+
+  /**Returns a non-owning read-only view of the whole array.*/
+  NDArrayView<const T> View() const
+  {
+    return NDArrayView<const T>(base_, dimension());
+  }
+
   /** Deletes the array.
    *
    *  The destructor deletes the underlying array data.
@@ -609,7 +645,7 @@ public:
     dimensions_ = nullptr;
     delete [] strides_;
     strides_ = nullptr;
-    delete [] base_;
+    Deallocate(base_, size_);
     base_ = nullptr;
   }
 };
@@ -0,0 +1,255 @@
+#ifndef CHITECH_NDARRAY_VIEW_H
+#define CHITECH_NDARRAY_VIEW_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <array>
+#include <string>
+#include <stdexcept>
+
+namespace chi_data_types
+{
+
+/**Non-owning, strided view of multi-dimensional data, e.g., of an NDArray
+ * or of an existing solver buffer such as a flux moment vector. Slicing a
+ * view makes another view of the same memory, without copying. The
+ * dimensions and strides are stored inline, hence views are cheap to make
+ * and pass by value.
+ *
+ * The last dimension has unit stride when the view is contiguous, which
+ * vectorized kernels can check with `IsContiguous()` to loop directly
+ * over `data()`.*/
+template<typename T>
+class NDArrayView
+{
+public:
+  /**Maximum rank of a view.*/
+  static constexpr size_t MAX_RANK = 8;
+
+private:
+  T*                          base_ = nullptr;
+  size_t                      rank_ = 0;
+  std::array<size_t, MAX_RANK> dimensions_{};
+  std::array<size_t, MAX_RANK> strides_{};
+
+public:
+  /**Creates an empty view.*/
+  NDArrayView() = default;
+
+  /**Creates a contiguous, row-major view of the given memory.
+   * \param data Memory of at least the product of the dimensions.
+   * \param dims Number of elements in each dimension.*/
+  template<typename D>
+  NDArrayView(T* data, const std::vector<D>& dims) : base_(data)
+  {
+    static_assert(std::is_integral<D>::value,
+                  "NDArrayView dims argument must have integral types.");
+    if (dims.size() > MAX_RANK)
+      throw std::invalid_argument("NDArrayView: Rank " +
+                                  std::to_string(dims.size()) +
+                                  " exceeds the maximum " +
+                                  std::to_string(MAX_RANK));
+    rank_ = dims.size();
+
+    size_t stride = 1;
+    for (size_t i = rank_; i > 0; --i)
+    {
+      dimensions_[i - 1] = static_cast<size_t>(dims[i - 1]);
+      strides_[i - 1] = stride;
+      stride *= dimensions_[i - 1];
+    }
+  }
+
+  /**Creates a contiguous view of a vector, checking that its size is the
+   * product of the dimensions.*/
+  template<typename D, typename V>
+  NDArrayView(std::vector<V>& vector, const std::vector<D>& dims) :
+    NDArrayView(vector.data(), dims)
+  {
+    if (size() != vector.size())
+      throw std::invalid_argument("NDArrayView: The dimensions span " +
+                                  std::to_string(size()) + " elements but "
+                                  "the vector has " +
+                                  std::to_string(vector.size()));
+  }
+
+  /**Creates a view with explicit strides, in elements.*/
+  NDArrayView(T* data,
+              const std::vector<size_t>& dims,
+              const std::vector<size_t>& strides) : base_(data)
+  {
+    if (dims.size() > MAX_RANK or strides.size() != dims.size())
+      throw std::invalid_argument("NDArrayView: Invalid dimensions or "
+                                  "strides.");
+    rank_ = dims.size();
+    for (size_t i = 0; i < rank_; ++i)
+    {
+      dimensions_[i] = dims[i];
+      strides_[i] = strides[i];
+    }
+  }
+
+  /**Allows a mutable view to be passed as a const one.*/
+  template<typename U,
+           typename = std::enable_if_t<std::is_same_v<const U, T>>>
+  NDArrayView(const NDArrayView<U>& other) : base_(other.data()),
+                                             rank_(other.rank())
+  {
+    for (size_t i = 0; i < rank_; ++i)
+    {
+      dimensions_[i] = other.dimension(i);
+      strides_[i] = other.stride(i);
+    }
+  }
+
+  /**Returns a pointer to the first element.*/
+  T* data() const noexcept { return base_; }
+  /**Returns the rank of the view.*/
+  size_t rank() const noexcept { return rank_; }
+  /**Returns the number of elements in the given dimension.*/
+  size_t dimension(size_t i) const noexcept { return dimensions_[i]; }
+  /**Returns the stride, in elements, of the given dimension.*/
+  size_t stride(size_t i) const noexcept { return strides_[i]; }
+
+  /**Returns the number of elements in the view.*/
+  size_t size() const noexcept
+  {
+    if (base_ == nullptr) return 0;
+    size_t n = 1;
+    for (size_t i = 0; i < rank_; ++i) n *= dimensions_[i];
+    return n;
+  }
+
+  /**Returns true if the view has no elements.*/
+  bool empty() const noexcept { return size() == 0; }
+
+  /**Returns true if the elements are contiguous and row-major, in which
+   * case they are `data()[0]` to `data()[size()-1]`.*/
+  bool IsContiguous() const noexcept
+  {
+    size_t stride = 1;
+    for (size_t i = rank_; i > 0; --i)
+    {
+      if (dimensions_[i - 1] > 1 and strides_[i - 1] != stride) return false;
+      stride *= dimensions_[i - 1];
+    }
+    return true;
+  }
+
+  /**Accesses the specified element.*/
+  template<typename... Args>
+  T& operator()(Args... args) const noexcept
+  {
+    static_assert((std::is_integral<Args>::value and ...),
+                  "NDArrayView::operator(): All parameters must be of "
+                  "integral type");
+
+    const size_t indices[] { static_cast<size_t>(args)... };
+    T* address = base_;
+    for (size_t i = 0; i < sizeof...(args); ++i)
+      address += strides_[i] * indices[i];
+    return *address;
+  }
+
+  /** Accesses the specified element with safety checks.
+   *
+   *  \throw std::invalid_argument if the number of arguments are incorrect and
+   *  std::out_of_range if one of the dimension-indices are out of range.*/
+  template<typename... Args>
+  T& at(Args... args) const
+  {
+    if (sizeof...(args) != rank_)
+      throw std::invalid_argument("NDArrayView::at(): Number of arguments " +
+        std::to_string(sizeof...(args)) + " not equal to rank " +
+        std::to_string(rank_));
+
+    const size_t indices[] { static_cast<size_t>(args)... };
+    for (size_t i = 0; i < rank_; ++i)
+      if (indices[i] >= dimensions_[i])
+        throw std::out_of_range("NDArrayView::at(): Index " +
+          std::to_string(i) + " out of range " + std::to_string(indices[i]) +
+          " must be <" + std::to_string(dimensions_[i]));
+
+    return (*this)(args...);
+  }
+
+  /**Returns the view of rank one less at the given index of the first
+   * dimension, e.g., a row of a matrix.*/
+  NDArrayView<T> Slice(size_t index) const
+  {
+    if (rank_ == 0 or index >= dimensions_[0])
+      throw std::out_of_range("NDArrayView::Slice(): Index " +
+                              std::to_string(index) + " out of range.");
+    NDArrayView<T> view;
+    view.base_ = base_ + strides_[0] * index;
+    view.rank_ = rank_ - 1;
+    for (size_t i = 1; i < rank_; ++i)
+    {
+      view.dimensions_[i - 1] = dimensions_[i];
+      view.strides_[i - 1] = strides_[i];
+    }
+    return view;
+  }
+
+  /**Returns the view of the given index along dimension `dim`, of rank one
+   * less, e.g., a column of a matrix for `dim=1`.*/
+  NDArrayView<T> Slice(size_t dim, size_t index) const
+  {
+    if (dim >= rank_ or index >= dimensions_[dim])
+      throw std::out_of_range("NDArrayView::Slice(): Index " +
+                              std::to_string(index) + " of dimension " +
+                              std::to_string(dim) + " out of range.");
+    NDArrayView<T> view;
+    view.base_ = base_ + strides_[dim] * index;
+    view.rank_ = rank_ - 1;
+    for (size_t i = 0, j = 0; i < rank_; ++i)
+    {
+      if (i == dim) continue;
+      view.dimensions_[j] = dimensions_[i];
+      view.strides_[j] = strides_[i];
+      ++j;
+    }
+    return view;
+  }
+
+  /**Returns the view of `count` elements from `begin` along dimension
+   * `dim`, of the same rank, taking every `step`-th element.*/
+  NDArrayView<T> SubView(size_t dim,
+                         size_t begin,
+                         size_t count,
+                         size_t step = 1) const
+  {
+    if (dim >= rank_ or step == 0 or
+        (count > 0 and begin + (count - 1) * step >= dimensions_[dim]))
+      throw std::out_of_range("NDArrayView::SubView(): Range out of "
+                              "dimension " + std::to_string(dim) + ".");
+    NDArrayView<T> view = *this;
+    view.base_ = base_ + strides_[dim] * begin;
+    view.dimensions_[dim] = count;
+    view.strides_[dim] = strides_[dim] * step;
+    return view;
+  }
+
+  /**Sets a value to all the elements of the view.*/
+  void set(const T& value) const
+  {
+    if (IsContiguous())
+    {
+      const size_t n = size();
+      for (size_t k = 0; k < n; ++k) base_[k] = value;
+      return;
+    }
+    if (rank_ == 1)
+    {
+      for (size_t k = 0; k < dimensions_[0]; ++k)
+        base_[k * strides_[0]] = value;
+      return;
+    }
+    for (size_t k = 0; k < dimensions_[0]; ++k) Slice(k).set(value);
+  }
+};
+
+}//namespace chi_data_types
+
+#endif //CHITECH_NDARRAY_VIEW_H
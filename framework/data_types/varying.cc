@@ -1,5 +1,7 @@
 #include "varying.h"
 
+#include "byte_array.h"
+
 #include <algorithm>
 #include <sstream>
 
@@ -75,6 +77,12 @@ double Varying::VaryingArbitraryType<std::vector<std::byte>>::FloatValue() const
 {
   ChiLogicalError("Method not implemented");
 }
+template <>
+std::vector<std::byte>
+Varying::VaryingArbitraryType<std::vector<std::byte>>::BytesValue() const
+{
+  return value_;
+}
 
 //=============================================== VaryingString
 template <>
@@ -97,6 +105,12 @@ double Varying::VaryingArbitraryType<std::string>::FloatValue() const
 {
   ChiLogicalError("Method not implemented");
 }
+template <>
+std::vector<std::byte>
+Varying::VaryingArbitraryType<std::string>::BytesValue() const
+{
+  ChiLogicalError("Method not implemented");
+}
 
 //=============================================== VaryingBool
 template <>
@@ -119,6 +133,11 @@ double Varying::VaryingArbitraryType<bool>::FloatValue() const
 {
   ChiLogicalError("Method not implemented");
 }
+template <>
+std::vector<std::byte> Varying::VaryingArbitraryType<bool>::BytesValue() const
+{
+  ChiLogicalError("Method not implemented");
+}
 
 //=============================================== VaryingInteger
 template <>
@@ -141,6 +160,12 @@ double Varying::VaryingArbitraryType<int64_t>::FloatValue() const
 {
   ChiLogicalError("Method not implemented");
 }
+template <>
+std::vector<std::byte>
+Varying::VaryingArbitraryType<int64_t>::BytesValue() const
+{
+  ChiLogicalError("Method not implemented");
+}
 
 //=============================================== VaryingFloat
 template <>
@@ -163,6 +188,11 @@ double Varying::VaryingArbitraryType<double>::FloatValue() const
 {
   return value_;
 }
+template <>
+std::vector<std::byte> Varying::VaryingArbitraryType<double>::BytesValue() const
+{
+  ChiLogicalError("Method not implemented");
+}
 
 } // namespace chi_data_types
 
@@ -198,15 +228,17 @@ chi_data_types::Varying::Varying(const std::string& value)
 
 /**Copy constructor.*/
 chi_data_types::Varying::Varying(const Varying& other)
+  : type_(other.type_),
+    scalar_(other.scalar_),
+    data_(other.data_ ? other.data_->Clone() : nullptr)
 {
-  data_ = other.data_->Clone();
-  type_ = other.type_;
 }
 
 /**Move constructor.*/
 chi_data_types::Varying::Varying(Varying&& other) noexcept
 {
   std::swap(data_, other.data_);
+  std::swap(scalar_, other.scalar_);
   std::swap(type_, other.type_);
 }
 
@@ -216,7 +248,8 @@ chi_data_types::Varying::operator=(const Varying& other)
 {
   if (this != &other)
   {
-    data_ = other.data_->Clone();
+    data_ = other.data_ ? other.data_->Clone() : nullptr;
+    scalar_ = other.scalar_;
     type_ = other.type_;
   }
   return *this;
@@ -257,7 +290,7 @@ bool chi_data_types::Varying::BoolValue() const
 {
   CheckTypeMatch(type_, VaryingDataType::BOOL);
 
-  return data_->BoolValue();
+  return std::get<bool>(scalar_);
 }
 
 /**Returns the integer value if valid. Otherwise throws std::logic_error.*/
@@ -265,7 +298,7 @@ int64_t chi_data_types::Varying::IntegerValue() const
 {
   CheckTypeMatch(type_, VaryingDataType::INTEGER);
 
-  return data_->IntegerValue();
+  return std::get<int64_t>(scalar_);
 }
 
 /**Returns the float value if valid. Otherwise throws std::logic_error.*/
@@ -273,12 +306,160 @@ double chi_data_types::Varying::FloatValue() const
 {
   CheckTypeMatch(type_, VaryingDataType::FLOAT);
 
-  return data_->FloatValue();
+  return std::get<double>(scalar_);
+}
+
+/**Returns the bytes value if valid. Otherwise throws std::logic_error.*/
+std::vector<std::byte> chi_data_types::Varying::BytesValue() const
+{
+  CheckTypeMatch(type_, VaryingDataType::ARBITRARY_BYTES);
+
+  return data_->BytesValue();
 }
 
 // ###################################################################
 /**Returns the raw byte size associated with the type.*/
-size_t chi_data_types::Varying::ByteSize() const { return data_->Size(); }
+size_t chi_data_types::Varying::ByteSize() const
+{
+  switch (type_)
+  {
+    case VaryingDataType::BOOL:
+      return sizeof(bool);
+    case VaryingDataType::INTEGER:
+      return sizeof(int64_t);
+    case VaryingDataType::FLOAT:
+      return sizeof(double);
+    default:
+      return data_ ? data_->Size() : 0;
+  }
+}
+
+// ###################################################################
+//  Relations
+/**Equality operator. Values of different types are never equal.*/
+bool chi_data_types::Varying::operator==(const Varying& that) const
+{
+  if (type_ != that.type_) return false;
+  if (IsScalar()) return scalar_ == that.scalar_;
+  if (not data_ or not that.data_) return false;
+
+  return *data_ == *that.data_;
+}
+
+/**Relation operators. Values of different types are never ordered.*/
+bool chi_data_types::Varying::operator>(const Varying& that) const
+{
+  if (type_ != that.type_) return false;
+  if (IsScalar()) return scalar_ > that.scalar_;
+  if (not data_ or not that.data_) return false;
+
+  return *data_ > *that.data_;
+}
+
+/**Relation operators. Values of different types are never ordered.*/
+bool chi_data_types::Varying::operator<(const Varying& that) const
+{
+  if (type_ != that.type_) return false;
+  if (IsScalar()) return scalar_ < that.scalar_;
+  if (not data_ or not that.data_) return false;
+
+  return *data_ < *that.data_;
+}
+
+// ###################################################################
+//  Serialization
+/**Appends the type and value to a byte array. Strings and bytes are
+ * written as their size followed by their contents.*/
+void chi_data_types::Varying::Serialize(ByteArray& raw) const
+{
+  raw.Write<VaryingDataType>(type_);
+  switch (type_)
+  {
+    case VaryingDataType::BOOL:
+      raw.Write<bool>(std::get<bool>(scalar_));
+      break;
+    case VaryingDataType::INTEGER:
+      raw.Write<int64_t>(std::get<int64_t>(scalar_));
+      break;
+    case VaryingDataType::FLOAT:
+      raw.Write<double>(std::get<double>(scalar_));
+      break;
+    case VaryingDataType::STRING:
+    {
+      const auto& str = RawValue<std::string>();
+      raw.Write<uint64_t>(str.size());
+      raw.WriteBytes(str.data(), str.size());
+      break;
+    }
+    case VaryingDataType::ARBITRARY_BYTES:
+    {
+      const auto& bytes = RawValue<std::vector<std::byte>>();
+      raw.Write<uint64_t>(bytes.size());
+      raw.WriteBytes(bytes.data(), bytes.size());
+      break;
+    }
+    case VaryingDataType::VOID:
+    default:
+      ChiLogicalError("Cannot serialize a value of type " + TypeName());
+  }
+}
+
+/**Returns the number of bytes appended by Serialize.*/
+size_t chi_data_types::Varying::SerializedSize() const
+{
+  size_t num_bytes = sizeof(VaryingDataType);
+  switch (type_)
+  {
+    case VaryingDataType::BOOL:
+      return num_bytes + sizeof(bool);
+    case VaryingDataType::INTEGER:
+      return num_bytes + sizeof(int64_t);
+    case VaryingDataType::FLOAT:
+      return num_bytes + sizeof(double);
+    case VaryingDataType::STRING:
+      return num_bytes + sizeof(uint64_t) + RawValue<std::string>().size();
+    case VaryingDataType::ARBITRARY_BYTES:
+      return num_bytes + sizeof(uint64_t) +
+             RawValue<std::vector<std::byte>>().size();
+    case VaryingDataType::VOID:
+    default:
+      ChiLogicalError("Cannot serialize a value of type " + TypeName());
+  }
+}
+
+/**Reads a value written by Serialize at the given address, which is
+ * advanced past it.*/
+chi_data_types::Varying
+chi_data_types::Varying::DeSerialize(const ByteArray& raw, size_t& address)
+{
+  const auto type = raw.Read<VaryingDataType>(address, &address);
+  switch (type)
+  {
+    case VaryingDataType::BOOL:
+      return Varying(raw.Read<bool>(address, &address));
+    case VaryingDataType::INTEGER:
+      return Varying(raw.Read<int64_t>(address, &address));
+    case VaryingDataType::FLOAT:
+      return Varying(raw.Read<double>(address, &address));
+    case VaryingDataType::STRING:
+    {
+      const auto size = raw.Read<uint64_t>(address, &address);
+      const auto* chars =
+        reinterpret_cast<const char*>(raw.ReadBytes(address, size, &address));
+      return Varying(std::string(chars, size));
+    }
+    case VaryingDataType::ARBITRARY_BYTES:
+    {
+      const auto size = raw.Read<uint64_t>(address, &address);
+      const std::byte* bytes = raw.ReadBytes(address, size, &address);
+      return Varying(std::vector<std::byte>(bytes, bytes + size));
+    }
+    case VaryingDataType::VOID:
+    default:
+      ChiLogicalError("Invalid serialized value type " +
+                      VaryingDataTypeStringName(type));
+  }
+}
 
 // ###################################################################
 /**Returns a string value for the value.*/
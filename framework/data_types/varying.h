@@ -7,6 +7,7 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <variant>
 
 namespace chi_data_types
 {
@@ -124,12 +125,15 @@ private:
     bool BoolValue() const override;
     int64_t IntegerValue() const override;
     double FloatValue() const override;
+    std::vector<std::byte> BytesValue() const override;
 
     std::unique_ptr<VaryingType> Clone() const override
     {
       return std::make_unique<VaryingArbitraryType<T>>(value_);
     }
     size_t Size() const override { return sizeof(T); }
+    /**Returns a reference to the stored value, without copying it.*/
+    const T& RawValue() const { return value_; }
 
     bool operator==(const VaryingType& that) const override
     {
@@ -214,6 +218,10 @@ private:
 
   /**Type specification*/
   VaryingDataType type_ = VaryingDataType::VOID;
+  /**Inline storage of the scalar types, bool, integer and float, which
+   * are therefore never allocated nor cloned.*/
+  std::variant<bool, int64_t, double> scalar_ = false;
+  /**Heap storage of the string and bytes types only.*/
   std::unique_ptr<VaryingType> data_ = nullptr;
 
 private:
@@ -222,6 +230,22 @@ private:
   void CheckTypeMatch(VaryingDataType type_A,
                       VaryingDataType type_B_required) const;
 
+  /**Returns a reference to the stored string or bytes, without copying
+   * them. The type must have been checked.*/
+  template <typename T>
+  const T& RawValue() const
+  {
+    return static_cast<const VaryingArbitraryType<T>&>(*data_).RawValue();
+  }
+
+  /**Returns true if the value is stored inline.*/
+  bool IsScalar() const
+  {
+    return type_ == VaryingDataType::BOOL or
+           type_ == VaryingDataType::INTEGER or
+           type_ == VaryingDataType::FLOAT;
+  }
+
 private:
 public:
   // Constructors
@@ -249,22 +273,7 @@ public:
       type_ = VaryingDataType::INTEGER;
     }
 
-    data_ = Helper(CastValue(value));
-  }
-
-  static std::unique_ptr<VaryingType> Helper(const bool& value)
-  {
-    return std::make_unique<VaryingArbitraryType<bool>>(value);
-  }
-
-  static std::unique_ptr<VaryingType> Helper(const int64_t& value)
-  {
-    return std::make_unique<VaryingArbitraryType<int64_t>>(value);
-  }
-
-  static std::unique_ptr<VaryingType> Helper(const double& value)
-  {
-    return std::make_unique<VaryingArbitraryType<double>>(value);
+    scalar_ = CastValue(value);
   }
 
 
@@ -343,7 +352,8 @@ public:
   Varying& operator=(const T& value)
   {
     type_ = VaryingDataType::BOOL;
-    data_ = std::make_unique<VaryingArbitraryType<bool>>(value);
+    scalar_ = static_cast<bool>(value);
+    data_ = nullptr;
 
     return *this;
   }
@@ -353,7 +363,8 @@ public:
   Varying& operator=(const T& value)
   {
     type_ = VaryingDataType::INTEGER;
-    data_ = std::make_unique<VaryingArbitraryType<int64_t>>(value);
+    scalar_ = static_cast<int64_t>(value);
+    data_ = nullptr;
 
     return *this;
   }
@@ -363,26 +374,27 @@ public:
   Varying& operator=(const T& value)
   {
     type_ = VaryingDataType::FLOAT;
-    data_ = std::make_unique<VaryingArbitraryType<double>>(value);
+    scalar_ = static_cast<double>(value);
+    data_ = nullptr;
 
     return *this;
   }
 
   /**Equality operator*/
-  bool operator==(const Varying& that) const { return *data_ == *that.data_; }
+  bool operator==(const Varying& that) const;
 
   /**Inequality operator*/
   bool operator!=(const Varying& that) const { return not(*this == that); }
 
   /**Relation operators*/
-  bool operator>(const Varying& that) const { return *data_ > *that.data_; }
+  bool operator>(const Varying& that) const;
   /**Relation operators*/
   bool operator>=(const Varying& that) const
   {
     return (*this > that) or (*this == that);
   }
   /**Relation operators*/
-  bool operator<(const Varying& that) const { return *data_ < *that.data_; }
+  bool operator<(const Varying& that) const;
   /**Relation operators*/
   bool operator<=(const Varying& that) const
   {
@@ -428,7 +440,7 @@ public:
   {
     CheckTypeMatch(type_, VaryingDataType::BOOL);
 
-    return data_->BoolValue();
+    return std::get<bool>(scalar_);
   }
 
   /**Returns floating point values if able.*/
@@ -437,7 +449,7 @@ public:
   {
     CheckTypeMatch(type_, VaryingDataType::FLOAT);
 
-    const double value = data_->FloatValue();
+    const double value = std::get<double>(scalar_);
 
     return static_cast<T>(value);
   }
@@ -457,7 +469,7 @@ public:
   {
     CheckTypeMatch(type_, VaryingDataType::INTEGER);
 
-    const int64_t value = data_->IntegerValue();
+    const int64_t value = std::get<int64_t>(scalar_);
 
     return static_cast<T>(value);
   }
@@ -468,7 +480,7 @@ public:
   {
     CheckTypeMatch(type_, VaryingDataType::INTEGER);
 
-    const int64_t value = data_->IntegerValue();
+    const int64_t value = std::get<int64_t>(scalar_);
 
     if (value < 0)
       throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
@@ -485,10 +497,22 @@ public:
   int64_t IntegerValue() const;
   /**Returns the float value if valid. Otherwise throws std::logic_error.*/
   double FloatValue() const;
+  /**Returns the bytes value if valid. Otherwise throws std::logic_error.*/
+  std::vector<std::byte> BytesValue() const;
 
   /**Returns the raw byte size associated with the type.*/
   size_t ByteSize() const;
 
+public:
+  /**Appends the type and value to a byte array. Strings and bytes are
+   * written as their size followed by their contents.*/
+  void Serialize(ByteArray& raw) const;
+  /**Returns the number of bytes appended by Serialize.*/
+  size_t SerializedSize() const;
+  /**Reads a value written by Serialize at the given address, which is
+   * advanced past it.*/
+  static Varying DeSerialize(const ByteArray& raw, size_t& address);
+
 public:
   /**Returns the current-type of the variable.*/
   VaryingDataType Type() const { return type_; }
@@ -27,14 +27,47 @@ InputParameters Plugin::GetInputParameters()
   params.AddRequiredParameter<std::string>(
     "plugin_path", "Path to the shared library containing the plug-in.");
   params.AddOptionalParameter("entry_function", "", "Entry function to call.");
+  params.AddOptionalParameterArray(
+    "object_types",
+    std::vector<std::string>{},
+    "Manifest of the object types, e.g. \"prk::Solver\", registered by the "
+    "plug-in. If given, the library is only loaded when one of these types "
+    "is first made, rather than at construction.");
 
   return params;
 }
 
 Plugin::Plugin(const InputParameters& params)
   : ChiObject(params),
-    plugin_path_(params.GetParamValue<std::string>("plugin_path"))
+    plugin_path_(params.GetParamValue<std::string>("plugin_path")),
+    entry_function_(params.GetParamValue<std::string>("entry_function")),
+    object_types_(params.GetParamVectorValue<std::string>("object_types"))
 {
+  if (object_types_.empty())
+  {
+    Load();
+    return;
+  }
+
+  //============================================= Defer loading
+  // The types get their lua bindings now, making them through the factory
+  // loads the library
+  Chi::log.Log0Verbose1() << "Deferring plugin \"" << plugin_path_
+                          << "\" until one of its "
+                          << object_types_.size()
+                          << " object types is made";
+  chi::AssertReadibleFile(plugin_path_);
+
+  ChiObjectFactory::GetInstance().AddDeferredObjectTypes(object_types_,
+                                                         [this]() { Load(); });
+  for (const auto& type : object_types_)
+    chi::Console::SetObjectNamespaceTableStructure(type);
+}
+
+void Plugin::Load()
+{
+  if (library_handle_) return;
+
   Chi::log.Log0Verbose1() << "Loading plugin \"" << plugin_path_ << "\"";
   chi::RegistryStatuses registry_statuses = Chi::GetStatusOfRegistries();
 
@@ -44,17 +77,14 @@ Plugin::Plugin(const InputParameters& params)
   ChiLogicalErrorIf(not library_handle_,
                     "Failure loading \"" + plugin_path_ + "\"");
 
-  const auto& user_params = params.ParametersAtAssignment();
-  if (user_params.Has("entry_function"))
+  if (not entry_function_.empty())
   {
-    const auto& entry_function =
-      user_params.GetParamValue<std::string>("entry_function");
     typedef void(some_func)();
 
-    auto func = (some_func*)dlsym(library_handle_, entry_function.c_str());
+    auto func = (some_func*)dlsym(library_handle_, entry_function_.c_str());
 
     ChiLogicalErrorIf(
-      not func, "Failed to call entry function \"" + entry_function + "\"");
+      not func, "Failed to call entry function \"" + entry_function_ + "\"");
 
     // Calling the function
     func();
@@ -63,6 +93,10 @@ Plugin::Plugin(const InputParameters& params)
   Chi::console.UpdateConsoleBindings(registry_statuses);
 }
 
-Plugin::~Plugin() { dlclose(library_handle_); }
+Plugin::~Plugin()
+{
+  ChiObjectFactory::GetInstance().RemoveDeferredObjectTypes(object_types_);
+  if (library_handle_) dlclose(library_handle_);
+}
 
 } // namespace chi
\ No newline at end of file
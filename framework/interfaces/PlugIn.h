@@ -16,7 +16,14 @@ public:
 
 protected:
   const std::string plugin_path_;
+  const std::string entry_function_;
+  /**Object types registered by the plug-in, deferring its loading until
+   * one of them is first made. Empty if loaded eagerly.*/
+  const std::vector<std::string> object_types_;
   void* library_handle_ = nullptr;
+
+  /**Loads the library and calls the entry function, once.*/
+  void Load();
 };
 
 }
@@ -5,6 +5,8 @@
 
 #include "stringstream_color.h"
 
+#include <map>
+#include <set>
 #include <sstream>
 
 // ###################################################################
@@ -30,6 +32,16 @@ chi::ChiLog::ChiLog() noexcept
                                       std::make_shared<EventInfo>());
 }
 
+namespace
+{
+/**Whether this is the location 0 of the first angle team, the other teams
+ * having the same output.*/
+bool IsHomeLocation()
+{
+  return Chi::mpi.location_id == 0 and Chi::mpi.angle_team_id == 0;
+}
+} // namespace
+
 // ###################################################################
 /** Makes a log entry.*/
 chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
@@ -39,7 +51,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     case LOG_0VERBOSE_0:
     case LOG_0:
     {
-      if (Chi::mpi.location_id == 0)
+      if (IsHomeLocation())
       {
         std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
         return {&std::cout, header};
@@ -52,7 +64,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     }
     case LOG_0WARNING:
     {
-      if (Chi::mpi.location_id == 0)
+      if (IsHomeLocation())
       {
         std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
         header += StringStreamColor(FG_YELLOW) + "**WARNING** ";
@@ -66,7 +78,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     }
     case LOG_0ERROR:
     {
-      if (Chi::mpi.location_id == 0)
+      if (IsHomeLocation())
       {
         std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
         header += StringStreamColor(FG_RED) + "**!**ERROR**!** ";
@@ -81,7 +93,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
 
     case LOG_0VERBOSE_1:
     {
-      if ((Chi::mpi.location_id == 0) && (verbosity_ >= 1))
+      if (IsHomeLocation() && (verbosity_ >= 1))
       {
         std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
         header += StringStreamColor(FG_CYAN);
@@ -95,7 +107,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     }
     case ChiLog::LOG_LVL::LOG_0VERBOSE_2:
     {
-      if ((Chi::mpi.location_id == 0) && (verbosity_ >= 2))
+      if (IsHomeLocation() && (verbosity_ >= 2))
       {
         std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
         header += StringStreamColor(FG_MAGENTA);
@@ -110,14 +122,11 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     case LOG_ALLVERBOSE_0:
     case LOG_ALL:
     {
-      std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
-      return {&std::cout, header};
+      return AllLocationsLog("");
     }
     case LOG_ALLWARNING:
     {
-      std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
-      header += StringStreamColor(FG_YELLOW) + "**WARNING** ";
-      return {&std::cout, header};
+      return AllLocationsLog(StringStreamColor(FG_YELLOW) + "**WARNING** ");
     }
     case LOG_ALLERROR:
     {
@@ -130,9 +139,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     {
       if (verbosity_ >= 1)
       {
-        std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
-        header += StringStreamColor(FG_CYAN);
-        return {&std::cout, header};
+        return AllLocationsLog(StringStreamColor(FG_CYAN));
       }
       else
       {
@@ -144,9 +151,7 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
     {
       if (verbosity_ >= 2)
       {
-        std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
-        header += StringStreamColor(FG_MAGENTA);
-        return {&std::cout, header};
+        return AllLocationsLog(StringStreamColor(FG_MAGENTA));
       }
       else
       {
@@ -160,6 +165,141 @@ chi::LogStream chi::ChiLog::Log(LOG_LVL level /*=LOG_0*/)
   }
 }
 
+// ###################################################################
+/** Returns the stream of an all-locations log, which is deferred when
+ * aggregating.*/
+chi::LogStream chi::ChiLog::AllLocationsLog(const std::string& decoration)
+{
+  if (aggregate_) return {&deferred_stream_, decoration};
+
+  std::string header = "[" + std::to_string(Chi::mpi.location_id) + "]  ";
+  return {&std::cout, header + decoration};
+}
+
+// ###################################################################
+/** Enables the aggregation of the all-locations logs.*/
+void chi::ChiLog::EnableAggregation(const std::string& file_base /*=""*/)
+{
+  aggregate_ = true;
+  if (file_base.empty()) return;
+
+  std::string file_name =
+    file_base + "." + std::to_string(Chi::mpi.location_id);
+  if (Chi::mpi.num_angle_teams > 1)
+    file_name += ".team" + std::to_string(Chi::mpi.angle_team_id);
+  file_name += ".log";
+  deferred_stream_.buffer.file.open(file_name);
+  ChiLogicalErrorIf(not deferred_stream_.buffer.file.is_open(),
+                    "Failed to open log file \"" + file_name + "\".");
+}
+
+namespace
+{
+/**Returns the location ranks as comma separated ranges, e.g. 0-3,7.*/
+std::string RankRanges(const std::vector<int>& ranks)
+{
+  std::string ranges;
+  for (size_t i = 0; i < ranks.size();)
+  {
+    size_t j = i;
+    while (j + 1 < ranks.size() and ranks[j + 1] == ranks[j] + 1) ++j;
+
+    if (not ranges.empty()) ranges += ",";
+    ranges += std::to_string(ranks[i]);
+    if (j > i) ranges += "-" + std::to_string(ranks[j]);
+    i = j + 1;
+  }
+  return ranges;
+}
+} // namespace
+
+// ###################################################################
+/** Gathers the aggregated logs to location 0 and prints them.*/
+void chi::ChiLog::FlushAggregatedLogs()
+{
+  if (not aggregate_) return;
+
+  //=================================== Distinct local lines
+  // The color reset of a line is emitted after its line ending
+  const std::string reset = StringStreamColor(RESET);
+  const std::string text = deferred_stream_.TakeText();
+
+  std::set<std::string> local_set;
+  std::string local_lines;
+  size_t begin = 0;
+  while (begin < text.size())
+  {
+    size_t end = text.find('\n', begin);
+    if (end == std::string::npos) end = text.size();
+    std::string line = text.substr(begin, end - begin);
+    begin = end + 1;
+
+    if (not reset.empty() and line.rfind(reset, 0) == 0)
+      line.erase(0, reset.size());
+    if (line.empty() or not local_set.insert(line).second) continue;
+
+    local_lines += line + '\n';
+  }
+
+  //=================================== Gather to location 0
+  const int num_locations = Chi::mpi.process_count;
+  const bool home = Chi::mpi.location_id == 0;
+
+  int local_size = static_cast<int>(local_lines.size());
+  std::vector<int> sizes(home ? num_locations : 0, 0);
+  MPI_Gather(
+    &local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, Chi::mpi.comm);
+
+  std::vector<int> offsets(sizes.size(), 0);
+  int total_size = 0;
+  for (size_t r = 0; r < sizes.size(); ++r)
+  {
+    offsets[r] = total_size;
+    total_size += sizes[r];
+  }
+
+  std::vector<char> all_lines(total_size);
+  MPI_Gatherv(local_lines.data(),
+              local_size,
+              MPI_CHAR,
+              all_lines.data(),
+              sizes.data(),
+              offsets.data(),
+              MPI_CHAR,
+              0,
+              Chi::mpi.comm);
+
+  // Other angle teams log the same as the first team
+  if (not IsHomeLocation() or total_size == 0) return;
+
+  //=================================== Print distinct lines
+  // In order of first appearance, by location
+  std::vector<std::string> lines;
+  std::map<std::string, std::vector<int>> line_ranks;
+  for (int r = 0; r < num_locations; ++r)
+  {
+    size_t line_begin = offsets[r];
+    const size_t location_end = offsets[r] + sizes[r];
+    while (line_begin < location_end)
+    {
+      size_t line_end = line_begin;
+      while (all_lines[line_end] != '\n') ++line_end;
+
+      std::string line(&all_lines[line_begin], line_end - line_begin);
+      auto& ranks = line_ranks[line];
+      if (ranks.empty()) lines.push_back(line);
+      ranks.push_back(r);
+
+      line_begin = line_end + 1;
+    }
+  }
+
+  std::string output;
+  for (const auto& line : lines)
+    output += "[" + RankRanges(line_ranks[line]) + "]  " + line + '\n' + reset;
+  std::cout << output << std::flush;
+}
+
 // ###################################################################
 /** Sets the verbosity level.*/
 void chi::ChiLog::SetVerbosity(int int_level)
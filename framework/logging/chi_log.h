@@ -212,6 +212,9 @@ public:
 private:
   DummyStream dummy_stream_;
   int verbosity_;
+  /**Stream of the all-locations logs when aggregated.*/
+  DeferredStream deferred_stream_;
+  bool aggregate_ = false;
 
 public:
   static ChiLog& GetInstance() noexcept;
@@ -240,6 +243,25 @@ public:
   LogStream LogAllVerbose1() { return Log(LOG_ALLVERBOSE_1); }
   LogStream LogAllVerbose2() { return Log(LOG_ALLVERBOSE_2); }
 
+  /**Enables the aggregation of the all-locations logs, errors excepted.
+   * Their lines are kept by each location until the next call to
+   * FlushAggregatedLogs and, if a file base name is given, also written to
+   * the file `<file_base>.<location_id>.log` as they are logged, the angle
+   * team being appended to the location with angle teams.*/
+  void EnableAggregation(const std::string& file_base = "");
+  /**Gathers the aggregated logs of all the locations and prints each
+   * distinct line once, on location 0, headed by the ranges of the
+   * locations that logged it. Collective over the communicator, and called
+   * by every barrier. Does nothing without aggregation.*/
+  void FlushAggregatedLogs();
+
+private:
+  /**Returns the stream of an all-locations log with the given decoration
+   * of its lines.*/
+  LogStream AllLocationsLog(const std::string& decoration);
+
+public:
+
 private:
   class RepeatingEvent;
 
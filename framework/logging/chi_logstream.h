@@ -1,7 +1,9 @@
 #ifndef CHI_LOGSTREAM_H
 #define CHI_LOGSTREAM_H
 
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 namespace chi
@@ -46,5 +48,51 @@ struct DummyStream: public std::ostream
 
   ~DummyStream() {}
 };
+
+//###################################################################
+/** Stream keeping the text written to it until taken, and also writing it
+ * to a file, if one is open. Writes from concurrent threads are
+ * serialized.*/
+struct DeferredStream: public std::ostream
+{
+  struct DeferredStreamBuffer : std::streambuf
+  {
+    std::mutex mutex;
+    std::string text;
+    std::ofstream file;
+
+    int overflow(int c) override
+    {
+      if (c == traits_type::eof()) return traits_type::not_eof(c);
+      const char ch = traits_type::to_char_type(c);
+      xsputn(&ch, 1);
+      return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      text.append(s, static_cast<size_t>(n));
+      if (file.is_open()) file.write(s, n);
+      return n;
+    }
+    int sync() override
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (file.is_open()) file.flush();
+      return 0;
+    }
+  } buffer;
+
+  DeferredStream(): std::ostream(&buffer) {}
+
+  /** Returns the text written since the last call and clears it.*/
+  std::string TakeText()
+  {
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    std::string text;
+    text.swap(buffer.text);
+    return text;
+  }
+};
 }//namespace chi_objects
 #endif //CHI_LOGSTREAM_H
\ No newline at end of file
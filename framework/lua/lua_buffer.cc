@@ -0,0 +1,398 @@
+#include "lua_buffer.h"
+
+#include "console/chi_console.h"
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace chi_lua
+{
+
+RegisterLuaFunctionAsIs(chiBufferCreate);
+
+namespace
+{
+const char* BUFFER_METATABLE = "chi_lua.LuaBuffer";
+
+//###################################################################
+/**Returns the 0-based index of the 1-based element at the given stack
+ * index, checking its range.*/
+size_t CheckElementIndex(const std::string& func_name,
+                         lua_State* L,
+                         const LuaBuffer& buffer,
+                         int arg)
+{
+  LuaCheckIntegerValue(func_name, L, arg);
+  const lua_Integer i = lua_tointeger(L, arg);
+  ChiInvalidArgumentIf(i < 1 or static_cast<size_t>(i) > buffer.Size(),
+                       func_name + ": Index " + std::to_string(i) +
+                         " out of range for a buffer of size " +
+                         std::to_string(buffer.Size()) + ".");
+  return static_cast<size_t>(i - 1);
+}
+
+void CheckWritable(const std::string& func_name, const LuaBuffer& buffer)
+{
+  ChiLogicalErrorIf(buffer.IsReadOnly(),
+                    func_name + ": The buffer is read only.");
+}
+
+void CheckSameSize(const std::string& func_name,
+                   const LuaBuffer& a,
+                   const LuaBuffer& b)
+{
+  ChiInvalidArgumentIf(a.Size() != b.Size(),
+                       func_name + ": Buffer sizes " +
+                         std::to_string(a.Size()) + " and " +
+                         std::to_string(b.Size()) + " differ.");
+}
+
+//###################################################################
+// Methods
+
+/**Returns the number of elements.*/
+int BufferSize(lua_State* L)
+{
+  const auto& buffer = CheckBuffer("Buffer:Size", L, 1);
+  lua_pushinteger(L, static_cast<lua_Integer>(buffer.Size()));
+  return 1;
+}
+
+/**Returns the elements as a table, optionally only `count` elements from
+ * the 1-based element `first`.*/
+int BufferToTable(lua_State* L)
+{
+  const std::string fname = "Buffer:ToTable";
+  const auto& buffer = CheckBuffer(fname, L, 1);
+  const int num_args = lua_gettop(L);
+
+  size_t first = 0;
+  size_t count = buffer.Size();
+  if (num_args >= 2)
+  {
+    first = CheckElementIndex(fname, L, buffer, 2);
+    count = buffer.Size() - first;
+  }
+  if (num_args >= 3)
+  {
+    LuaCheckIntegerValue(fname, L, 3);
+    count = std::min(count, static_cast<size_t>(lua_tointeger(L, 3)));
+  }
+
+  const double* data = buffer.Data();
+  lua_createtable(L, static_cast<int>(count), 0);
+  for (size_t k = 0; k < count; ++k)
+  {
+    lua_pushnumber(L, data[first + k]);
+    lua_rawseti(L, -2, static_cast<lua_Integer>(k + 1));
+  }
+  return 1;
+}
+
+/**Sets the elements from another buffer or a table, optionally starting
+ * at the 1-based element `first`.*/
+int BufferSet(lua_State* L)
+{
+  const std::string fname = "Buffer:Set";
+  auto& buffer = CheckBuffer(fname, L, 1);
+  CheckWritable(fname, buffer);
+  const int num_args = lua_gettop(L);
+  if (num_args < 2) LuaPostArgAmountError(fname, 2, num_args);
+
+  const size_t first =
+    num_args >= 3 ? CheckElementIndex(fname, L, buffer, 3) : 0;
+  const size_t capacity = buffer.Size() - first;
+
+  if (IsBuffer(L, 2))
+  {
+    const auto& source = CheckBuffer(fname, L, 2);
+    ChiInvalidArgumentIf(source.Size() > capacity,
+                         fname + ": The source does not fit.");
+    std::memmove(buffer.Data() + first, source.Data(),
+                 source.Size() * sizeof(double));
+    return 0;
+  }
+
+  LuaCheckTableValue(fname, L, 2);
+  const auto count = static_cast<size_t>(lua_rawlen(L, 2));
+  ChiInvalidArgumentIf(count > capacity, fname + ": The source does not fit.");
+  double* data = buffer.Data() + first;
+  for (size_t k = 0; k < count; ++k)
+  {
+    lua_rawgeti(L, 2, static_cast<lua_Integer>(k + 1));
+    data[k] = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+  }
+  return 0;
+}
+
+/**Sets all the elements to a value.*/
+int BufferFill(lua_State* L)
+{
+  const std::string fname = "Buffer:Fill";
+  auto& buffer = CheckBuffer(fname, L, 1);
+  CheckWritable(fname, buffer);
+  LuaCheckNumberValue(fname, L, 2);
+
+  std::fill_n(buffer.Data(), buffer.Size(), lua_tonumber(L, 2));
+  return 0;
+}
+
+/**Multiplies all the elements by a value.*/
+int BufferScale(lua_State* L)
+{
+  const std::string fname = "Buffer:Scale";
+  auto& buffer = CheckBuffer(fname, L, 1);
+  CheckWritable(fname, buffer);
+  LuaCheckNumberValue(fname, L, 2);
+
+  const double a = lua_tonumber(L, 2);
+  double* data = buffer.Data();
+  for (size_t k = 0; k < buffer.Size(); ++k) data[k] *= a;
+  return 0;
+}
+
+/**Adds `a` times buffer `x` to the buffer.*/
+int BufferAxpy(lua_State* L)
+{
+  const std::string fname = "Buffer:Axpy";
+  auto& buffer = CheckBuffer(fname, L, 1);
+  CheckWritable(fname, buffer);
+  LuaCheckNumberValue(fname, L, 2);
+  const auto& x = CheckBuffer(fname, L, 3);
+  CheckSameSize(fname, buffer, x);
+
+  const double a = lua_tonumber(L, 2);
+  double* data = buffer.Data();
+  const double* x_data = x.Data();
+  for (size_t k = 0; k < buffer.Size(); ++k) data[k] += a * x_data[k];
+  return 0;
+}
+
+/**Returns the sum of the elements.*/
+int BufferSum(lua_State* L)
+{
+  const auto& buffer = CheckBuffer("Buffer:Sum", L, 1);
+  const double* data = buffer.Data();
+  lua_pushnumber(L, std::accumulate(data, data + buffer.Size(), 0.0));
+  return 1;
+}
+
+/**Returns the dot product with another buffer.*/
+int BufferDot(lua_State* L)
+{
+  const std::string fname = "Buffer:Dot";
+  const auto& buffer = CheckBuffer(fname, L, 1);
+  const auto& x = CheckBuffer(fname, L, 2);
+  CheckSameSize(fname, buffer, x);
+
+  const double* data = buffer.Data();
+  lua_pushnumber(L,
+                 std::inner_product(data, data + buffer.Size(), x.Data(), 0.0));
+  return 1;
+}
+
+/**Returns a new buffer owning a copy of the elements.*/
+int BufferCopy(lua_State* L)
+{
+  const auto& buffer = CheckBuffer("Buffer:Copy", L, 1);
+  auto copy = LuaBuffer::MakeOwned(buffer.Size());
+  std::copy_n(buffer.Data(), buffer.Size(), copy.Data());
+  PushBuffer(L, std::move(copy));
+  return 1;
+}
+
+const luaL_Reg BUFFER_METHODS[] = {{"Size", BufferSize},
+                                   {"ToTable", BufferToTable},
+                                   {"Set", BufferSet},
+                                   {"Fill", BufferFill},
+                                   {"Scale", BufferScale},
+                                   {"Axpy", BufferAxpy},
+                                   {"Sum", BufferSum},
+                                   {"Dot", BufferDot},
+                                   {"Copy", BufferCopy},
+                                   {nullptr, nullptr}};
+
+//###################################################################
+// Metamethods
+
+int BufferIndex(lua_State* L)
+{
+  const std::string fname = "Buffer:__index";
+  const auto& buffer = CheckBuffer(fname, L, 1);
+
+  if (lua_type(L, 2) == LUA_TSTRING)
+  {
+    const std::string key = lua_tostring(L, 2);
+    for (const luaL_Reg* method = BUFFER_METHODS; method->name; ++method)
+      if (key == method->name)
+      {
+        lua_pushcfunction(L, method->func);
+        return 1;
+      }
+    lua_pushnil(L);
+    return 1;
+  }
+
+  lua_pushnumber(L, buffer.Data()[CheckElementIndex(fname, L, buffer, 2)]);
+  return 1;
+}
+
+int BufferNewIndex(lua_State* L)
+{
+  const std::string fname = "Buffer:__newindex";
+  auto& buffer = CheckBuffer(fname, L, 1);
+  CheckWritable(fname, buffer);
+  LuaCheckNumberValue(fname, L, 3);
+
+  buffer.Data()[CheckElementIndex(fname, L, buffer, 2)] = lua_tonumber(L, 3);
+  return 0;
+}
+
+int BufferLength(lua_State* L)
+{
+  const auto& buffer = CheckBuffer("Buffer:__len", L, 1);
+  lua_pushinteger(L, static_cast<lua_Integer>(buffer.Size()));
+  return 1;
+}
+
+int BufferToString(lua_State* L)
+{
+  const auto& buffer = CheckBuffer("Buffer:__tostring", L, 1);
+  const std::string str = std::string(buffer.IsReadOnly() ? "read only " : "") +
+                          "buffer of size " + std::to_string(buffer.Size());
+  lua_pushstring(L, str.c_str());
+  return 1;
+}
+
+int BufferGC(lua_State* L)
+{
+  auto* buffer = static_cast<LuaBuffer*>(luaL_checkudata(L, 1,
+                                                         BUFFER_METATABLE));
+  buffer->~LuaBuffer();
+  return 0;
+}
+} // namespace
+
+//###################################################################
+LuaBuffer::LuaBuffer(std::shared_ptr<const void> owner,
+                     ViewFunction view,
+                     bool read_only)
+  : owner_(std::move(owner)), view_(std::move(view)), read_only_(read_only)
+{
+}
+
+LuaBuffer LuaBuffer::MakeOwned(size_t size, double value)
+{
+  return FromVector(std::make_shared<std::vector<double>>(size, value));
+}
+
+LuaBuffer
+LuaBuffer::FromVector(std::shared_ptr<std::vector<double>> vector,
+                      bool read_only)
+{
+  auto* vector_ptr = vector.get();
+  return {std::move(vector),
+          [vector_ptr]()
+          { return std::make_pair(vector_ptr->data(), vector_ptr->size()); },
+          read_only};
+}
+
+/**The view is read only.*/
+LuaBuffer
+LuaBuffer::FromVector(std::shared_ptr<const std::vector<double>> vector)
+{
+  return FromVector(std::const_pointer_cast<std::vector<double>>(vector),
+                    /*read_only=*/true);
+}
+
+LuaBuffer
+LuaBuffer::FromNDArray(std::shared_ptr<chi_data_types::NDArray<double>> array,
+                       bool read_only)
+{
+  auto* array_ptr = array.get();
+  return {std::move(array),
+          [array_ptr]()
+          { return std::make_pair(array_ptr->data(), array_ptr->size()); },
+          read_only};
+}
+
+//###################################################################
+void PushBuffer(lua_State* L, LuaBuffer buffer)
+{
+  void* memory = lua_newuserdata(L, sizeof(LuaBuffer));
+  new (memory) LuaBuffer(std::move(buffer));
+
+  if (luaL_newmetatable(L, BUFFER_METATABLE))
+  {
+    const luaL_Reg metamethods[] = {{"__index", BufferIndex},
+                                    {"__newindex", BufferNewIndex},
+                                    {"__len", BufferLength},
+                                    {"__tostring", BufferToString},
+                                    {"__gc", BufferGC},
+                                    {nullptr, nullptr}};
+    luaL_setfuncs(L, metamethods, 0);
+  }
+  lua_setmetatable(L, -2);
+}
+
+bool IsBuffer(lua_State* L, int arg)
+{
+  return luaL_testudata(L, arg, BUFFER_METATABLE) != nullptr;
+}
+
+LuaBuffer& CheckBuffer(const std::string& func_name, lua_State* L, int arg)
+{
+  auto* buffer =
+    static_cast<LuaBuffer*>(luaL_testudata(L, arg, BUFFER_METATABLE));
+  ChiInvalidArgumentIf(not buffer,
+                       func_name + ": Argument " + std::to_string(arg) +
+                         " is not a buffer.");
+  return *buffer;
+}
+
+//###################################################################
+/**Creates a buffer owning an array of doubles, which C++ functions read and
+ * write without copying.
+\param size int Number of elements.
+\param value double Optional. Initial value of the elements. Default 0.0.
+
+\return A buffer. Its elements are indexed from 1, `#buffer` is its size,
+and it has the methods `Size()`, `ToTable([first, count])`,
+`Set(table_or_buffer, [first])`, `Fill(value)`, `Scale(a)`, `Axpy(a, x)`,
+`Sum()`, `Dot(x)` and `Copy()`.
+
+\code
+b = chiBufferCreate(10, 1.0)
+b[2] = 3.0
+c = b:Copy()
+c:Axpy(2.0, b)
+print(#c, c:Sum())
+\endcode
+
+\ingroup LuaMath*/
+int chiBufferCreate(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args < 1) LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckIntegerValue(fname, L, 1);
+  const lua_Integer size = lua_tointeger(L, 1);
+  ChiInvalidArgumentIf(size < 0, fname + ": Negative size.");
+
+  double value = 0.0;
+  if (num_args >= 2)
+  {
+    LuaCheckNumberValue(fname, L, 2);
+    value = lua_tonumber(L, 2);
+  }
+
+  PushBuffer(L, LuaBuffer::MakeOwned(static_cast<size_t>(size), value));
+  return 1;
+}
+
+} // namespace chi_lua
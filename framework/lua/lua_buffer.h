@@ -0,0 +1,72 @@
+#ifndef CHI_LUA_BUFFER_H
+#define CHI_LUA_BUFFER_H
+
+#include "chi_lua.h"
+
+#include "data_types/ndarray.h"
+
+#include <functional>
+
+namespace chi_lua
+{
+
+//###################################################################
+/**A contiguous array of doubles exposed to lua as a userdata, without
+ * copying. The memory is either owned by the buffer or that of a C++
+ * vector or NDArray, kept alive by a shared pointer to its owner. The
+ * memory and size are queried on every access, hence a view of a vector
+ * follows it when it is resized.
+ *
+ * In lua, `buffer[i]` gets and sets the 1-based element `i`, `#buffer`
+ * is the size and bulk operations are methods, e.g.
+ * `buffer:Set(other_buffer)`, see PushBuffer.*/
+class LuaBuffer
+{
+public:
+  /**Returns the memory and the number of elements.*/
+  typedef std::function<std::pair<double*, size_t>()> ViewFunction;
+
+private:
+  std::shared_ptr<const void> owner_;
+  ViewFunction view_;
+  bool read_only_ = false;
+
+public:
+  LuaBuffer(std::shared_ptr<const void> owner,
+            ViewFunction view,
+            bool read_only);
+
+  /**Makes a buffer owning a new vector of the given size.*/
+  static LuaBuffer MakeOwned(size_t size, double value = 0.0);
+  /**Makes a view of a vector, the shared pointer typically aliasing the
+   * object holding it.*/
+  static LuaBuffer FromVector(std::shared_ptr<std::vector<double>> vector,
+                              bool read_only = false);
+  static LuaBuffer
+  FromVector(std::shared_ptr<const std::vector<double>> vector);
+  /**Makes a view of the flattened elements of an NDArray.*/
+  static LuaBuffer
+  FromNDArray(std::shared_ptr<chi_data_types::NDArray<double>> array,
+              bool read_only = false);
+
+  double* Data() const { return view_().first; }
+  size_t Size() const { return view_().second; }
+  bool IsReadOnly() const { return read_only_; }
+};
+
+/**Pushes a buffer onto the lua stack, as a userdata with the buffer
+ * metatable.*/
+void PushBuffer(lua_State* L, LuaBuffer buffer);
+
+/**Returns true if the value at the given stack index is a buffer.*/
+bool IsBuffer(lua_State* L, int arg);
+
+/**Returns the buffer at the given stack index, throwing if the value is
+ * not a buffer.*/
+LuaBuffer& CheckBuffer(const std::string& func_name, lua_State* L, int arg);
+
+int chiBufferCreate(lua_State* L);
+
+} // namespace chi_lua
+
+#endif // CHI_LUA_BUFFER_H
@@ -0,0 +1,105 @@
+#include "petsc_element_assembler.h"
+
+#include "chi_log_exceptions.h"
+
+#include <exception>
+
+//###################################################################
+/**Computes the contributions of every element, in parallel if requested.
+ * An exception thrown by the element function is rethrown after the
+ * parallel loop.*/
+void chi_math::PETScUtils::ElementAssembler::
+  ComputeContributions(const ElementFunction& element_function, bool threaded)
+{
+  const auto num_elements = static_cast<int64_t>(contributions_.size());
+
+  std::exception_ptr exception = nullptr;
+#pragma omp parallel for schedule(dynamic, 64) if (threaded)
+  for (int64_t e = 0; e < num_elements; ++e)
+  {
+    auto& contributions = contributions_[e];
+    contributions.Clear();
+    try { element_function(static_cast<size_t>(e), contributions); }
+    catch (...)
+    {
+#pragma omp critical
+      if (not exception) exception = std::current_exception();
+    }
+  }
+
+  if (exception) std::rethrow_exception(exception);
+}
+
+//###################################################################
+/**Computes the element contributions and sets the matrix to their sum.
+ * The vector contributions, if any, are added to b, which can be null if
+ * there are none. The matrix must have its type and sizes set.*/
+void chi_math::PETScUtils::ElementAssembler::
+  Assemble(Mat A, Vec b,
+           const ElementFunction& element_function,
+           bool threaded/*=true*/)
+{
+  ComputeContributions(element_function, threaded);
+
+  //============================================= Gather in element order
+  size_t num_entries = 0;
+  size_t num_vector_entries = 0;
+  for (const auto& contributions : contributions_)
+  {
+    num_entries += contributions.values_.size();
+    num_vector_entries += contributions.vector_values_.size();
+  }
+
+  std::vector<PetscInt> rows;
+  std::vector<PetscInt> cols;
+  rows.reserve(num_entries);
+  cols.reserve(num_entries);
+  coo_values_.clear();
+  coo_values_.reserve(num_entries);
+  for (const auto& contributions : contributions_)
+  {
+    rows.insert(rows.end(),
+                contributions.rows_.begin(), contributions.rows_.end());
+    cols.insert(cols.end(),
+                contributions.cols_.begin(), contributions.cols_.end());
+    coo_values_.insert(coo_values_.end(),
+                       contributions.values_.begin(),
+                       contributions.values_.end());
+  }
+
+  //============================================= Declare the pattern if new
+  if (A != coo_matrix_ or rows != coo_rows_ or cols != coo_cols_)
+  {
+    coo_rows_ = std::move(rows);
+    coo_cols_ = std::move(cols);
+
+    // PETSc may modify the index arrays, hence copies are passed
+    std::vector<PetscInt> rows_copy = coo_rows_;
+    std::vector<PetscInt> cols_copy = coo_cols_;
+    MatSetPreallocationCOO(A, static_cast<PetscCount>(num_entries),
+                           rows_copy.data(), cols_copy.data());
+    coo_matrix_ = A;
+  }
+
+  //============================================= Set the values
+  MatSetValuesCOO(A, coo_values_.data(), INSERT_VALUES);
+
+  //============================================= Vector
+  if (num_vector_entries > 0)
+  {
+    ChiLogicalErrorIf(b == nullptr, "There are vector contributions but no "
+                                    "vector to assemble them into.");
+    for (const auto& contributions : contributions_)
+      if (not contributions.vector_values_.empty())
+        VecSetValues(b,
+                     static_cast<PetscInt>(contributions.vector_rows_.size()),
+                     contributions.vector_rows_.data(),
+                     contributions.vector_values_.data(),
+                     ADD_VALUES);
+  }
+  if (b != nullptr)
+  {
+    VecAssemblyBegin(b);
+    VecAssemblyEnd(b);
+  }
+}
@@ -0,0 +1,98 @@
+#ifndef CHI_MATH_PETSC_ELEMENT_ASSEMBLER_H
+#define CHI_MATH_PETSC_ELEMENT_ASSEMBLER_H
+
+#include <petscksp.h>
+
+#include <functional>
+#include <vector>
+
+namespace chi_math::PETScUtils
+{
+
+//###################################################################
+/**The matrix and vector contributions of a single element, e.g., a cell,
+ * in global indices. Duplicate entries are summed.*/
+class ElementContributions
+{
+  friend class ElementAssembler;
+private:
+  std::vector<PetscInt>    rows_;
+  std::vector<PetscInt>    cols_;
+  std::vector<PetscScalar> values_;
+  std::vector<PetscInt>    vector_rows_;
+  std::vector<PetscScalar> vector_values_;
+
+public:
+  /**Adds a matrix entry.*/
+  void AddMatrixEntry(int64_t row, int64_t col, double value)
+  {
+    rows_.push_back(static_cast<PetscInt>(row));
+    cols_.push_back(static_cast<PetscInt>(col));
+    values_.push_back(value);
+  }
+  /**Adds a vector entry.*/
+  void AddVectorEntry(int64_t row, double value)
+  {
+    vector_rows_.push_back(static_cast<PetscInt>(row));
+    vector_values_.push_back(value);
+  }
+
+  /**Removes the entries, keeping the allocated storage.*/
+  void Clear()
+  {
+    rows_.clear(); cols_.clear(); values_.clear();
+    vector_rows_.clear(); vector_values_.clear();
+  }
+};
+
+//###################################################################
+/**Assembles a PETSc matrix, and optionally a vector, from the
+ * contributions of a fixed set of elements. The contributions are computed
+ * by an element function, in parallel over the elements with OpenMP, into
+ * per-element buffers and are then inserted all at once with the PETSc COO
+ * assembly interface:
+ * - the first assembly declares the nonzero pattern, i.e., the list of
+ *   (row, column) pairs, with `MatSetPreallocationCOO`,
+ * - every assembly sets the values with a single `MatSetValuesCOO`, which
+ *   replaces the previous values. The pattern is declared again only if it
+ *   changes, hence re-assemblies with new coefficients, e.g., in transients,
+ *   cost little more than computing the element contributions.
+ *
+ * The element function must be thread-safe when threading is enabled. It
+ * receives the element index and the cleared contributions to fill.*/
+class ElementAssembler
+{
+public:
+  typedef std::function<void(size_t, ElementContributions&)> ElementFunction;
+
+private:
+  std::vector<ElementContributions> contributions_;
+
+  Mat coo_matrix_ = nullptr;
+  std::vector<PetscInt> coo_rows_;
+  std::vector<PetscInt> coo_cols_;
+  std::vector<PetscScalar> coo_values_;
+
+public:
+  explicit ElementAssembler(size_t num_elements) :
+    contributions_(num_elements) {}
+
+  size_t NumElements() const {return contributions_.size();}
+
+  void Assemble(Mat A, Vec b,
+                const ElementFunction& element_function,
+                bool threaded = true);
+
+  /**Forgets the declared pattern, e.g., after the matrix was
+   * re-preallocated by other means.*/
+  void ResetPattern()
+  {coo_matrix_ = nullptr; coo_rows_.clear(); coo_cols_.clear();}
+
+private:
+  void ComputeContributions(const ElementFunction& element_function,
+                            bool threaded);
+};
+
+}//namespace chi_math::PETScUtils
+
+#endif //CHI_MATH_PETSC_ELEMENT_ASSEMBLER_H
@@ -2,10 +2,22 @@
 #define CHI_MATH_PETSC_UTILS_H
 
 #include <petscksp.h>
+#include <string>
 #include <vector>
 
 namespace chi_math::PETScUtils
 {
+  /**Backends of the matrices and vectors. The device backends keep the
+   * assembled operators, and the Krylov vectors, on the GPUs and are only
+   * available when PETSc is configured with the corresponding package.*/
+  enum class DeviceBackend
+  {
+    CPU    = 0, ///< MATMPIAIJ and VECMPI
+    CUDA   = 1, ///< MATMPIAIJCUSPARSE and VECMPICUDA
+    HIP    = 2, ///< MATMPIAIJHIPSPARSE and VECMPIHIP
+    KOKKOS = 3  ///< MATMPIAIJKOKKOS and VECMPIKOKKOS
+  };
+
   /**Generalized solver structure.*/
   struct PETScSolverSetup
   {
@@ -22,16 +34,21 @@ namespace chi_math::PETScUtils
   };
 
   //01
-  Vec CreateVector(int64_t local_size, int64_t global_size);
-  void CreateVector(Vec& x, int64_t local_size, int64_t global_size);
+  Vec CreateVector(int64_t local_size, int64_t global_size,
+                   DeviceBackend backend = DeviceBackend::CPU);
+  void CreateVector(Vec& x, int64_t local_size, int64_t global_size,
+                    DeviceBackend backend = DeviceBackend::CPU);
 
   Vec CreateVectorWithGhosts(int64_t local_size, int64_t global_size,
                              int64_t nghosts,
-                             const std::vector<int64_t>& ghost_indices);
+                             const std::vector<int64_t>& ghost_indices,
+                             DeviceBackend backend = DeviceBackend::CPU);
 
   //02
-  Mat CreateSquareMatrix(int64_t local_size, int64_t global_size);
-  void CreateSquareMatrix(Mat& A, int64_t local_size, int64_t global_size);
+  Mat CreateSquareMatrix(int64_t local_size, int64_t global_size,
+                         DeviceBackend backend = DeviceBackend::CPU);
+  void CreateSquareMatrix(Mat& A, int64_t local_size, int64_t global_size,
+                          DeviceBackend backend = DeviceBackend::CPU);
   void InitMatrixSparsity(Mat &A,
                           const std::vector<int64_t>& nodal_nnz_in_diag,
                           const std::vector<int64_t>& nodal_nnz_off_diag);
@@ -91,6 +108,16 @@ namespace chi_math::PETScUtils
   GhostVecLocalRaw GetGhostVectorLocalViewRead(Vec x);
   void RestoreGhostVectorLocalViewRead(Vec x,GhostVecLocalRaw& local_data);
 
+  //05
+  DeviceBackend DeviceBackendFromName(const std::string& name);
+  std::string DeviceBackendName(DeviceBackend backend);
+  bool DeviceBackendAvailable(DeviceBackend backend);
+
+  MatType DeviceMatrixType(DeviceBackend backend);
+  VecType DeviceVectorType(DeviceBackend backend);
+
+  bool HypreSupportsBackend(DeviceBackend backend);
+
 
 }//namespace chi_math::PETScUtils
 
@@ -3,24 +3,25 @@
 #include "chi_log.h"
 
 //###################################################################
-/**Creates a general vector.
+/**Creates a general vector, of the vector type of the backend.
  *
 This is a macro for:
 \code
 Vec x;
 VecCreate(PETSC_COMM_WORLD,&x);
-VecSetType(x,VECMPI);
+VecSetType(x,DeviceVectorType(backend));
 VecSetSizes(x, local_size, global_size);
 VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 
 return x;
 \endcode*/
 Vec chi_math::PETScUtils::
-CreateVector(int64_t local_size, int64_t global_size)
+CreateVector(int64_t local_size, int64_t global_size,
+             DeviceBackend backend)
 {
   Vec x;
   VecCreate(PETSC_COMM_WORLD,&x);
-  VecSetType(x,VECMPI);
+  VecSetType(x,DeviceVectorType(backend));
   VecSetSizes(x, local_size, global_size);
   VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 
@@ -28,36 +29,47 @@ CreateVector(int64_t local_size, int64_t global_size)
 }
 
 //###################################################################
-/**Creates a general vector.
+/**Creates a general vector, of the vector type of the backend.
  *
 This is a macro for:
 \code
 VecCreate(PETSC_COMM_WORLD,&x);
-VecSetType(x,VECMPI);
+VecSetType(x,DeviceVectorType(backend));
 VecSetSizes(x, local_size, global_size);
 VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 \endcode*/
 void chi_math::PETScUtils::
-CreateVector(Vec& x, int64_t local_size, int64_t global_size)
+CreateVector(Vec& x, int64_t local_size, int64_t global_size,
+             DeviceBackend backend)
 {
   VecCreate(PETSC_COMM_WORLD,&x);
-  VecSetType(x,VECMPI);
+  VecSetType(x,DeviceVectorType(backend));
   VecSetSizes(x, local_size, global_size);
   VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 }
 
 //###################################################################
-/**Creates a general vector with ghost value support.
+/**Creates a general vector with ghost value support. For the device
+ * backends the ghosts are set on a vector of the device type, since
+ * `VecCreateGhost` only makes host vectors.
  *
 This is a macro for:
 \code
 Vec x;
-VecCreateGhost(PETSC_COMM_WORLD,
-               local_size,
-               global_size,
-               nghosts,
-               ghost_indices.data(),
-               &x);
+if (backend == DeviceBackend::CPU)
+  VecCreateGhost(PETSC_COMM_WORLD,
+                 local_size,
+                 global_size,
+                 nghosts,
+                 ghost_indices.data(),
+                 &x);
+else
+{
+  VecCreate(PETSC_COMM_WORLD,&x);
+  VecSetSizes(x, local_size, global_size);
+  VecSetType(x,DeviceVectorType(backend));
+  VecMPISetGhost(x, nghosts, ghost_indices.data());
+}
 
 VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 
@@ -66,15 +78,26 @@ return x;
 Vec chi_math::PETScUtils::
 CreateVectorWithGhosts(int64_t local_size, int64_t global_size,
                        int64_t nghosts,
-                       const std::vector<int64_t>& ghost_indices)
+                       const std::vector<int64_t>& ghost_indices,
+                       DeviceBackend backend)
 {
   Vec x;
-  VecCreateGhost(PETSC_COMM_WORLD,
-                 local_size,
-                 global_size,
-                 nghosts,
-                 (ghost_indices.empty())? NULL : ghost_indices.data(),
-                 &x);
+  if (backend == DeviceBackend::CPU)
+    VecCreateGhost(PETSC_COMM_WORLD,
+                   local_size,
+                   global_size,
+                   nghosts,
+                   (ghost_indices.empty())? NULL : ghost_indices.data(),
+                   &x);
+  else
+  {
+    VecCreate(PETSC_COMM_WORLD,&x);
+    VecSetSizes(x, local_size, global_size);
+    VecSetType(x,DeviceVectorType(backend));
+    VecMPISetGhost(x,
+                   nghosts,
+                   (ghost_indices.empty())? NULL : ghost_indices.data());
+  }
 
   VecSetOption(x,VEC_IGNORE_NEGATIVE_INDICES,PETSC_TRUE);
 
@@ -3,13 +3,13 @@
 #include "chi_log.h"
 
 //###################################################################
-/**Creates a general square matrix.
+/**Creates a general square matrix, of the matrix type of the backend.
  *
  * This is a macro for:
 \code
 Mat A;
 MatCreate(PETSC_COMM_WORLD,&A);
-MatSetType(A,MATMPIAIJ);
+MatSetType(A,DeviceMatrixType(backend));
 MatSetSizes(A,local_size, local_size,
               global_size, global_size);
 
@@ -22,11 +22,13 @@ return A;
 \endcode
 
 */
-Mat chi_math::PETScUtils::CreateSquareMatrix(int64_t local_size, int64_t global_size)
+Mat chi_math::PETScUtils::
+CreateSquareMatrix(int64_t local_size, int64_t global_size,
+                   DeviceBackend backend)
 {
   Mat A;
   MatCreate(PETSC_COMM_WORLD,&A);
-  MatSetType(A,MATMPIAIJ);
+  MatSetType(A,DeviceMatrixType(backend));
   MatSetSizes(A,local_size, local_size,
               global_size, global_size);
 
@@ -39,12 +41,12 @@ Mat chi_math::PETScUtils::CreateSquareMatrix(int64_t local_size, int64_t global_
 }
 
 //###################################################################
-/**Creates a general square matrix.
+/**Creates a general square matrix, of the matrix type of the backend.
  *
  * This is a macro for:
 \code
 MatCreate(PETSC_COMM_WORLD,&A);
-MatSetType(A,MATMPIAIJ);
+MatSetType(A,DeviceMatrixType(backend));
 MatSetSizes(A,local_size, local_size,
               global_size, global_size);
 
@@ -56,10 +58,11 @@ MatSetOption(A, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE);
 
 */
 void chi_math::PETScUtils::
-CreateSquareMatrix(Mat& A, int64_t local_size, int64_t global_size)
+CreateSquareMatrix(Mat& A, int64_t local_size, int64_t global_size,
+                   DeviceBackend backend)
 {
   MatCreate(PETSC_COMM_WORLD,&A);
-  MatSetType(A,MATMPIAIJ);
+  MatSetType(A,DeviceMatrixType(backend));
   MatSetSizes(A,local_size, local_size,
               global_size, global_size);
 
@@ -0,0 +1,122 @@
+#include "petsc_utils.h"
+
+#include "chi_log_exceptions.h"
+
+//###################################################################
+/**Returns the backend of the given name, i.e., "cpu", "cuda", "hip" or
+ * "kokkos". Throws if the name is unknown or if PETSc was not configured
+ * with the backend.*/
+chi_math::PETScUtils::DeviceBackend
+chi_math::PETScUtils::DeviceBackendFromName(const std::string& name)
+{
+  DeviceBackend backend;
+  if      (name == "cpu")    backend = DeviceBackend::CPU;
+  else if (name == "cuda")   backend = DeviceBackend::CUDA;
+  else if (name == "hip")    backend = DeviceBackend::HIP;
+  else if (name == "kokkos") backend = DeviceBackend::KOKKOS;
+  else
+    ChiInvalidArgument("Unknown device backend \"" + name + "\". Allowed "
+                       "values are \"cpu\", \"cuda\", \"hip\" and "
+                       "\"kokkos\".");
+
+  ChiInvalidArgumentIf(not DeviceBackendAvailable(backend),
+                       "PETSc was not configured with the device backend \"" +
+                         name + "\".");
+
+  return backend;
+}
+
+//###################################################################
+/**Returns the name of the backend, as accepted by DeviceBackendFromName.*/
+std::string chi_math::PETScUtils::DeviceBackendName(DeviceBackend backend)
+{
+  switch (backend)
+  {
+    case DeviceBackend::CUDA:   return "cuda";
+    case DeviceBackend::HIP:    return "hip";
+    case DeviceBackend::KOKKOS: return "kokkos";
+    default:                    return "cpu";
+  }
+}
+
+//###################################################################
+/**Determines whether PETSc was configured with the backend. The Kokkos
+ * matrices require Kokkos-Kernels.*/
+bool chi_math::PETScUtils::DeviceBackendAvailable(DeviceBackend backend)
+{
+  switch (backend)
+  {
+    case DeviceBackend::CPU: return true;
+#if defined(PETSC_HAVE_CUDA)
+    case DeviceBackend::CUDA: return true;
+#endif
+#if defined(PETSC_HAVE_HIP)
+    case DeviceBackend::HIP: return true;
+#endif
+#if defined(PETSC_HAVE_KOKKOS_KERNELS)
+    case DeviceBackend::KOKKOS: return true;
+#endif
+    default: return false;
+  }
+}
+
+//###################################################################
+/**Returns the parallel AIJ matrix type of the backend. The device types
+ * keep the host AIJ preallocation interface, hence
+ * InitMatrixSparsity applies unchanged, and copy the assembled matrix to
+ * the device at assembly end.*/
+MatType chi_math::PETScUtils::DeviceMatrixType(DeviceBackend backend)
+{
+  ChiInvalidArgumentIf(not DeviceBackendAvailable(backend),
+                       "PETSc was not configured with the device backend \"" +
+                         DeviceBackendName(backend) + "\".");
+  switch (backend)
+  {
+#if defined(PETSC_HAVE_CUDA)
+    case DeviceBackend::CUDA: return MATMPIAIJCUSPARSE;
+#endif
+#if defined(PETSC_HAVE_HIP)
+    case DeviceBackend::HIP: return MATMPIAIJHIPSPARSE;
+#endif
+#if defined(PETSC_HAVE_KOKKOS_KERNELS)
+    case DeviceBackend::KOKKOS: return MATMPIAIJKOKKOS;
+#endif
+    default: return MATMPIAIJ;
+  }
+}
+
+//###################################################################
+/**Returns the parallel vector type of the backend.*/
+VecType chi_math::PETScUtils::DeviceVectorType(DeviceBackend backend)
+{
+  ChiInvalidArgumentIf(not DeviceBackendAvailable(backend),
+                       "PETSc was not configured with the device backend \"" +
+                         DeviceBackendName(backend) + "\".");
+  switch (backend)
+  {
+#if defined(PETSC_HAVE_CUDA)
+    case DeviceBackend::CUDA: return VECMPICUDA;
+#endif
+#if defined(PETSC_HAVE_HIP)
+    case DeviceBackend::HIP: return VECMPIHIP;
+#endif
+#if defined(PETSC_HAVE_KOKKOS_KERNELS)
+    case DeviceBackend::KOKKOS: return VECMPIKOKKOS;
+#endif
+    default: return VECMPI;
+  }
+}
+
+//###################################################################
+/**Determines whether hypre can set up and apply its preconditioners on the
+ * matrices of the backend without copying them to the host, i.e., whether
+ * hypre was built for the devices. Otherwise GAMG, which runs on all the
+ * backends, should be used.*/
+bool chi_math::PETScUtils::HypreSupportsBackend(DeviceBackend backend)
+{
+#if defined(PETSC_HAVE_HYPRE_DEVICE)
+  return true;
+#else
+  return backend == DeviceBackend::CPU;
+#endif
+}
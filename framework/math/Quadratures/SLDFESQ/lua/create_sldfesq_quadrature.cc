@@ -14,6 +14,9 @@ RegisterLuaFunctionAsIs(chiCreateSLDFESQAngularQuadrature);
 quadrature based on Spherical Quadrilaterals (SQ). Hence SLDFE-SQ.
 \param initial_refinement_level int Initial refinement level, \f$n\f$ to
        be used. The total number of angles will be \f$ 8{\times}12(n+1)^2 \f$.
+\param cache_directory string Optional. Directory of an on-disk cache of the
+       quadrature, keyed by the refinement level. The first run writes it,
+       later runs read it instead of developing the quadrature.
 
 ##_
 
@@ -32,12 +35,17 @@ With direction points:
 int chiCreateSLDFESQAngularQuadrature(lua_State* L)
 {
   int num_args = lua_gettop(L);
-  if (num_args != 1)
+  if (num_args < 1)
     LuaPostArgAmountError("chiCreateSLDFESQAngularQuadrature",1,num_args);
 
   int init_refinement_level = lua_tonumber(L,1);
 
   auto sldfesq = new chi_math::SimplifiedLDFESQ::Quadrature;
+  if (num_args >= 2)
+  {
+    LuaCheckStringValue("chiCreateSLDFESQAngularQuadrature", L, 2);
+    sldfesq->cache_directory_ = lua_tostring(L,2);
+  }
   sldfesq->GenerateInitialRefinement(init_refinement_level);
 
   std::shared_ptr<chi_math::AngularQuadrature> new_ang_quad =
@@ -65,6 +65,9 @@ public:
   QuadraturePointOptimization qp_optimization_type_ =
     QuadraturePointOptimization::EMPIRICAL;
   std::string output_filename_prefix_;
+  /**Directory of the on-disk cache of the LDFE values of the initial
+   * refinement. No caching when empty.*/
+  std::string cache_directory_;
 
 private:
   static constexpr double a = 0.57735026919; ///< Inscribed cude side length
@@ -118,6 +121,15 @@ private:
     std::array<chi_mesh::Vector3, 4>& radii_vectors_xy_tilde,
     std::array<double,4>& sub_sub_sqr_areas);
 
+  //01e
+  void DevelopSQLDFEValues(const std::vector<SphericalQuadrilateral*>& sqs);
+
+  //01f
+  std::string LDFEValuesCacheFileName() const;
+  bool ReadLDFEValuesCache(const std::vector<SphericalQuadrilateral*>& sqs);
+  void WriteLDFEValuesCache(
+    const std::vector<SphericalQuadrilateral*>& sqs) const;
+
   //01d utilities
   static double ComputeSphericalQuadrilateralArea(
     std::array<chi_mesh::Vertex,4>& vertices_xyz);
@@ -152,8 +164,7 @@ public:
 
 private:
   std::array<SphericalQuadrilateral,4>
-    SplitSQ(SphericalQuadrilateral& sq,
-            chi_math::QuadratureGaussLegendre& legendre);
+    SplitSQ(SphericalQuadrilateral& sq);
 };
 
 //################################################################### Util Func
@@ -50,6 +50,19 @@ void chi_math::SimplifiedLDFESQ::Quadrature::GenerateInitialRefinement(int level
   GenerateReferenceFaceVertices(Ryface,tyface,level);
   GenerateReferenceFaceVertices(Rzface,tzface,level);
 
+  //======================================== Develop LDFE values, or read
+  //                                         them from the cache
+  std::vector<SphericalQuadrilateral*> sqs;
+  sqs.reserve(initial_octant_SQs_.size());
+  for (auto& sq : initial_octant_SQs_)
+    sqs.push_back(&sq);
+
+  if (not ReadLDFEValuesCache(sqs))
+  {
+    DevelopSQLDFEValues(sqs);
+    WriteLDFEValuesCache(sqs);
+  }
+
   //======================================== Compute areas
   double total_area = 0.0;
   double area_max = -100.0;
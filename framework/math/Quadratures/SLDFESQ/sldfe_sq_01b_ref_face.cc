@@ -3,7 +3,8 @@
 #include <algorithm>
 
 //###################################################################
-/**Generates the standard points on the reference face.*/
+/**Generates the standard points on the reference face. The LDFE values
+ * of the SQs are developed afterwards, for all the faces at once.*/
 void chi_math::SimplifiedLDFESQ::Quadrature::
   GenerateReferenceFaceVertices(
                  const chi_mesh::Matrix3x3& rotation_matrix, 
@@ -15,8 +16,6 @@ void chi_math::SimplifiedLDFESQ::Quadrature::
   int Ns = (level + 1);  //Number of subdivisions
   int Np = Ns + 1;         //Number of diagonal points
 
-  chi_math::QuadratureGaussLegendre legendre(QuadratureOrder::THIRTYSECOND);
-
   //============================================= Generate xy_tilde values
   std::vector<VertList> vertices_xy_tilde_ij;
   vertices_xy_tilde_ij.resize(Np, VertList(Np));
@@ -75,9 +74,6 @@ void chi_math::SimplifiedLDFESQ::Quadrature::
       //==================================== Set octant modifier
       sq.octant_modifier = chi_mesh::Vector3(1.0,1.0,1.0);
 
-      //==================================== Develop LDFE values
-      DevelopSQLDFEValues(sq,legendre);
-
       initial_octant_SQs_.push_back(sq);
     }//for j
   }//for i
@@ -0,0 +1,75 @@
+#include "sldfe_sq.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+namespace
+{
+/**Number of values developed per SQ, its 4 points and 4 weights.*/
+constexpr int LDFE_VALUES_PER_SQ = 16;
+}
+
+//###################################################################
+/**Develops the LDFE values of several SQs, splitting them in contiguous
+ * blocks across the locations, each developing its own block, and
+ * gathering all the values on every location.*/
+void chi_math::SimplifiedLDFESQ::Quadrature::
+  DevelopSQLDFEValues(const std::vector<SphericalQuadrilateral*>& sqs)
+{
+  chi_math::QuadratureGaussLegendre legendre(QuadratureOrder::THIRTYSECOND);
+
+  const int num_locations = Chi::mpi.process_count;
+  const int num_sqs = static_cast<int>(sqs.size());
+
+  //============================================= Determine blocks
+  std::vector<int> counts(num_locations, 0);
+  std::vector<int> displs(num_locations, 0);
+  for (int locI=0; locI<num_locations; ++locI)
+  {
+    const int begin = static_cast<int>(
+      static_cast<int64_t>(num_sqs) * locI / num_locations);
+    const int end = static_cast<int>(
+      static_cast<int64_t>(num_sqs) * (locI + 1) / num_locations);
+    counts[locI] = LDFE_VALUES_PER_SQ * (end - begin);
+    displs[locI] = LDFE_VALUES_PER_SQ * begin;
+  }
+
+  //============================================= Develop the local block
+  const int local_begin = displs[Chi::mpi.location_id] / LDFE_VALUES_PER_SQ;
+  const int local_count = counts[Chi::mpi.location_id] / LDFE_VALUES_PER_SQ;
+
+  std::vector<double> local_values;
+  local_values.reserve(LDFE_VALUES_PER_SQ * local_count);
+  for (int k=local_begin; k<local_begin + local_count; ++k)
+  {
+    auto& sq = *sqs[k];
+    DevelopSQLDFEValues(sq, legendre);
+    for (int i=0; i<4; ++i)
+      local_values.insert(local_values.end(), {sq.sub_sqr_points[i].x,
+                                               sq.sub_sqr_points[i].y,
+                                               sq.sub_sqr_points[i].z});
+    for (int i=0; i<4; ++i)
+      local_values.push_back(sq.sub_sqr_weights[i]);
+  }
+
+  if (num_locations == 1) return;
+
+  //============================================= Gather all the blocks
+  std::vector<double> values(LDFE_VALUES_PER_SQ * num_sqs, 0.0);
+  MPI_Allgatherv(local_values.data(),
+                 static_cast<int>(local_values.size()), MPI_DOUBLE,
+                 values.data(), counts.data(), displs.data(), MPI_DOUBLE,
+                 Chi::mpi.comm);
+
+  for (int k=0; k<num_sqs; ++k)
+  {
+    auto& sq = *sqs[k];
+    const double* sq_values = &values[LDFE_VALUES_PER_SQ * k];
+    for (int i=0; i<4; ++i)
+      sq.sub_sqr_points[i] = chi_mesh::Vector3(sq_values[3*i],
+                                               sq_values[3*i + 1],
+                                               sq_values[3*i + 2]);
+    for (int i=0; i<4; ++i)
+      sq.sub_sqr_weights[i] = sq_values[12 + i];
+  }
+}
@@ -0,0 +1,98 @@
+#include "sldfe_sq.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <fstream>
+
+//###################################################################
+/**Returns the name of the cache file of the LDFE values of the initial
+ * refinement, keyed by the refinement level and the quadrature point
+ * optimization.*/
+std::string chi_math::SimplifiedLDFESQ::Quadrature::
+  LDFEValuesCacheFileName() const
+{
+  return cache_directory_ + "/sldfesq_level" +
+         std::to_string(initial_level_) + "_opt" +
+         std::to_string(static_cast<int>(qp_optimization_type_)) + ".data";
+}
+
+//###################################################################
+/**Reads the LDFE values of the given SQs from the cache, on the home
+ * location, broadcasting them to the other locations. Returns false,
+ * on all the locations, if there is no cache or it does not match.*/
+bool chi_math::SimplifiedLDFESQ::Quadrature::
+  ReadLDFEValuesCache(const std::vector<SphericalQuadrilateral*>& sqs)
+{
+  if (cache_directory_.empty()) return false;
+
+  const size_t num_values = 16 * sqs.size();
+  std::vector<double> values(num_values, 0.0);
+
+  int found = 0;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::ifstream file(LDFEValuesCacheFileName(), std::ios::binary);
+    if (file.is_open())
+    {
+      uint64_t num_file_sqs = 0;
+      file.read((char*)&num_file_sqs, sizeof(uint64_t));
+      if (num_file_sqs == sqs.size())
+      {
+        file.read((char*)values.data(),
+                  static_cast<std::streamsize>(num_values * sizeof(double)));
+        found = file ? 1 : 0;
+      }
+    }
+  }
+
+  MPI_Bcast(&found, 1, MPI_INT, 0, Chi::mpi.comm);
+  if (not found) return false;
+
+  MPI_Bcast(values.data(), static_cast<int>(num_values), MPI_DOUBLE,
+            0, Chi::mpi.comm);
+
+  for (size_t k=0; k<sqs.size(); ++k)
+  {
+    auto& sq = *sqs[k];
+    const double* sq_values = &values[16 * k];
+    for (int i=0; i<4; ++i)
+      sq.sub_sqr_points[i] = chi_mesh::Vector3(sq_values[3*i],
+                                               sq_values[3*i + 1],
+                                               sq_values[3*i + 2]);
+    for (int i=0; i<4; ++i)
+      sq.sub_sqr_weights[i] = sq_values[12 + i];
+  }
+
+  Chi::log.Log0Verbose1() << "SLDFESQ LDFE values read from "
+                          << LDFEValuesCacheFileName();
+  return true;
+}
+
+//###################################################################
+/**Writes the LDFE values of the given SQs to the cache, from the home
+ * location. Failing to write only warns, the cache being optional.*/
+void chi_math::SimplifiedLDFESQ::Quadrature::
+  WriteLDFEValuesCache(const std::vector<SphericalQuadrilateral*>& sqs) const
+{
+  if (cache_directory_.empty() or Chi::mpi.location_id != 0) return;
+
+  std::ofstream file(LDFEValuesCacheFileName(), std::ios::binary);
+  if (not file.is_open())
+  {
+    Chi::log.LogAllWarning() << "SLDFESQ could not write the cache file "
+                             << LDFEValuesCacheFileName();
+    return;
+  }
+
+  const uint64_t num_sqs = sqs.size();
+  file.write((char*)&num_sqs, sizeof(uint64_t));
+  for (const auto* sq : sqs)
+  {
+    for (const auto& point : sq->sub_sqr_points)
+      for (const double value : {point.x, point.y, point.z})
+        file.write((char*)&value, sizeof(double));
+    file.write((char*)sq->sub_sqr_weights.data(), 4 * sizeof(double));
+  }
+}
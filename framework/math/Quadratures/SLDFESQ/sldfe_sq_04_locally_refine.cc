@@ -7,11 +7,12 @@
 #include "mesh/chi_meshvector.h"
 
 //###################################################################
-/**Split a SQ.*/
+/**Split a SQ. The LDFE values of the new SQs are not developed, being
+ * done for all the split SQs at once, and need the octant modifier applied
+ * afterwards.*/
 std::array<chi_math::SimplifiedLDFESQ::SphericalQuadrilateral,4>
   chi_math::SimplifiedLDFESQ::Quadrature::
-    SplitSQ(SphericalQuadrilateral &sq,
-            chi_math::QuadratureGaussLegendre& legendre)
+    SplitSQ(SphericalQuadrilateral &sq)
 {
   std::array<SphericalQuadrilateral,4> new_sqs;
 
@@ -55,7 +56,7 @@ std::array<chi_math::SimplifiedLDFESQ::SphericalQuadrilateral,4>
       new_sqs[i].vertices_xyz[v] = new_sqs[i].vertices_xyz_prime[v].Normalized();
 
   //============================================= Compute SQ xyz-centroid,
-  //                                              R,T,area, ldfe
+  //                                              R,T,area
   for (int i=0; i<4; ++i)
   {
     for (int v=0; v<4; ++v)
@@ -67,14 +68,10 @@ std::array<chi_math::SimplifiedLDFESQ::SphericalQuadrilateral,4>
     new_sqs[i].translation_vector = sq.translation_vector;
 
     new_sqs[i].area = ComputeSphericalQuadrilateralArea(new_sqs[i].vertices_xyz);
-    DevelopSQLDFEValues(new_sqs[i],legendre);
     new_sqs[i].octant_modifier = sq.octant_modifier;
 
     for (int v=0; v<4; ++v)
-    {
       new_sqs[i].vertices_xyz[v] = new_sqs[i].vertices_xyz[v]*sq.octant_modifier;
-      new_sqs[i].sub_sqr_points[v] = new_sqs[i].sub_sqr_points[v]*sq.octant_modifier;
-    }
   }
 
   return new_sqs;
@@ -92,7 +89,7 @@ void chi_math::SimplifiedLDFESQ::Quadrature::
   std::vector<SphericalQuadrilateral> new_deployment;
   new_deployment.reserve(deployed_SQs_.size());
 
-  chi_math::QuadratureGaussLegendre legendre(QuadratureOrder::THIRTYSECOND);
+  std::vector<size_t> new_sq_indices;
 
   int num_refined = 0;
   for (auto& sq : deployed_SQs_)
@@ -109,13 +106,29 @@ void chi_math::SimplifiedLDFESQ::Quadrature::
       new_deployment.push_back(sq);
     else
     {
-      auto new_sqs = SplitSQ(sq,legendre);
+      auto new_sqs = SplitSQ(sq);
       for (auto& nsq : new_sqs)
+      {
+        new_sq_indices.push_back(new_deployment.size());
         new_deployment.push_back(nsq);
+      }
       ++num_refined;
     }
   }
 
+  //============================================= Develop LDFE values of
+  //                                              the split SQs
+  std::vector<SphericalQuadrilateral*> new_sqs;
+  new_sqs.reserve(new_sq_indices.size());
+  for (const size_t k : new_sq_indices)
+    new_sqs.push_back(&new_deployment[k]);
+
+  DevelopSQLDFEValues(new_sqs);
+
+  for (auto* nsq : new_sqs)
+    for (auto& point : nsq->sub_sqr_points)
+      point = point*nsq->octant_modifier;
+
   deployed_SQs_.clear();
   deployed_SQs_ = new_deployment;
   deployed_SQs_history_.push_back(new_deployment);
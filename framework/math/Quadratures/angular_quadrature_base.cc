@@ -2,9 +2,12 @@
 
 #include "math/Quadratures/LegendrePoly/legendrepoly.h"
 
+#include "mpi/chi_mpi_node_shared_array.h"
+
 #include "chi_runtime.h"
 #include "chi_log.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -94,6 +97,10 @@ void chi_math::AngularQuadrature::
 
     d2m_op_.push_back(cur_mom);
   }
+  d2m_op_dir_major_.assign(num_angles * num_moms, 0.0);
+  for (size_t m=0; m<num_moms; ++m)
+    for (size_t n=0; n<num_angles; ++n)
+      d2m_op_dir_major_[n * num_moms + m] = d2m_op_[m][n];
   d2m_op_built_ = true;
 
   //=================================== Verbose printout
@@ -148,6 +155,10 @@ void chi_math::AngularQuadrature::
 
     m2d_op_.push_back(cur_mom);
   }//for m
+  m2d_op_dir_major_.assign(num_angles * num_moms, 0.0);
+  for (size_t m=0; m<num_moms; ++m)
+    for (size_t n=0; n<num_angles; ++n)
+      m2d_op_dir_major_[n * num_moms + m] = m2d_op_[m][n];
   m2d_op_built_ = true;
 
   //=================================== Verbose printout
@@ -200,6 +211,66 @@ std::vector<std::vector<double>> const&
   return m2d_op_;
 }
 
+//###################################################################
+/**Returns the d2m operator of a direction, the contiguous values of its
+ * moments. The operator is stored once per quadrature, hence is shared by
+ * all the groupsets using it. This will throw a std::logic_error if the
+ * operator has not been built yet.*/
+const double* chi_math::AngularQuadrature::
+  GetDiscreteToMomentDirection(size_t direction) const
+{
+  const std::string fname = __FUNCTION__;
+  if (not d2m_op_built_)
+    throw std::logic_error(fname + ": Called but D2M operator not yet built. "
+           "Make a call to BuildDiscreteToMomentOperator before using this.");
+  const double* values = d2m_op_node_shared_ ? d2m_op_node_shared_->data()
+                                              : d2m_op_dir_major_.data();
+  return values + direction * d2m_op_.size();
+}
+
+//###################################################################
+/**Returns the m2d operator of a direction, the contiguous values of its
+ * moments. The operator is stored once per quadrature, hence is shared by
+ * all the groupsets using it. This will throw a std::logic_error if the
+ * operator has not been built yet.*/
+const double* chi_math::AngularQuadrature::
+  GetMomentToDiscreteDirection(size_t direction) const
+{
+  const std::string fname = __FUNCTION__;
+  if (not m2d_op_built_)
+    throw std::logic_error(fname + ": Called but M2D operator not yet built. "
+           "Make a call to BuildMomentToDiscreteOperator before using this.");
+  const double* values = m2d_op_node_shared_ ? m2d_op_node_shared_->data()
+                                              : m2d_op_dir_major_.data();
+  return values + direction * m2d_op_.size();
+}
+
+//###################################################################
+/**Moves the built direction-major operators, read by the sweep kernels,
+ * to memory shared by the locations of a node, which then store them once.
+ * Collective over the node communicator, hence all the locations of the
+ * node must share the same quadratures in the same order.*/
+void chi_math::AngularQuadrature::
+  ShareDirectionOperatorsOnNode(MPI_Comm node_communicator)
+{
+  typedef std::shared_ptr<const chi::NodeSharedArray<double>> SharedPtr;
+  auto Share = [node_communicator](bool built,
+                                   std::vector<double>& values,
+                                   SharedPtr& shared_values)
+  {
+    if (not built or shared_values) return;
+
+    shared_values = std::make_shared<chi::NodeSharedArray<double>>(
+      node_communicator, values.size(),
+      [&values](double* node_values)
+      { std::copy(values.begin(), values.end(), node_values); });
+    std::vector<double>().swap(values);
+  };
+
+  Share(d2m_op_built_, d2m_op_dir_major_, d2m_op_node_shared_);
+  Share(m2d_op_built_, m2d_op_dir_major_, m2d_op_node_shared_);
+}
+
 //###################################################################
 /**Returns a reference to the precomputed harmonic index map. This will
  * throw a std::logic_error if the map has not been built yet.*/
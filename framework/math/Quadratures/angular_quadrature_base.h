@@ -1,10 +1,19 @@
 #ifndef CHI_MATH_ANGULAR_QUADRATURE_H
 #define CHI_MATH_ANGULAR_QUADRATURE_H
 
+#include <memory>
 #include <vector>
 
+#include <mpi.h>
+
 #include "mesh/chi_mesh.h"
 
+namespace chi
+{
+template<typename T>
+class NodeSharedArray;
+} // namespace chi
+
 namespace chi_math
 {
 struct QuadraturePointPhiTheta;
@@ -59,6 +68,14 @@ public:
 protected:
   std::vector<std::vector<double>> d2m_op_;
   std::vector<std::vector<double>> m2d_op_;
+  /**Contiguous copies of the operators in direction-major layout, i.e.,
+   * accessed as [d*num_moments + m], for the sweep kernels.*/
+  std::vector<double> d2m_op_dir_major_;
+  std::vector<double> m2d_op_dir_major_;
+  /**The direction-major operators when stored once per node, see
+   * ShareDirectionOperatorsOnNode.*/
+  std::shared_ptr<const chi::NodeSharedArray<double>> d2m_op_node_shared_;
+  std::shared_ptr<const chi::NodeSharedArray<double>> m2d_op_node_shared_;
   std::vector<HarmonicIndices> m_to_ell_em_map_;
   bool d2m_op_built_ = false;
   bool m2d_op_built_ = false;
@@ -89,6 +106,12 @@ public:
 
   std::vector<std::vector<double>> const& GetMomentToDiscreteOperator() const;
 
+  const double* GetDiscreteToMomentDirection(size_t direction) const;
+
+  const double* GetMomentToDiscreteDirection(size_t direction) const;
+
+  void ShareDirectionOperatorsOnNode(MPI_Comm node_communicator);
+
   const std::vector<HarmonicIndices>& GetMomentToHarmonicsIndexMap() const;
 };
 
@@ -0,0 +1,66 @@
+#include "counter_based_rng.h"
+
+/**Constructor for a stream of a seed, positioned at its start.*/
+chi_math::CounterBasedRNG::CounterBasedRNG(uint64_t seed, uint64_t stream) :
+  key_(MakeKey(seed)), stream_(stream)
+{
+}
+
+void chi_math::CounterBasedRNG::SetStream(uint64_t stream)
+{
+  stream_ = stream;
+  position_ = 0;
+  block_counter_ = UINT64_MAX;
+}
+
+void chi_math::CounterBasedRNG::SetPosition(uint64_t position)
+{
+  position_ = position;
+}
+
+/**The block of the current counter is kept, since it holds two numbers.*/
+double chi_math::CounterBasedRNG::Rand()
+{
+  const uint64_t counter = position_ / 2;
+  if (counter != block_counter_)
+  {
+    block_ = Philox(MakeCounter(stream_, counter), key_);
+    block_counter_ = counter;
+  }
+  return ToUniform(block_, position_++ % 2);
+}
+
+/**The whole blocks are computed independently of each other, which
+ * allows the loop over them to be vectorized.*/
+void chi_math::CounterBasedRNG::Fill(double* values, size_t num_values)
+{
+  size_t n = 0;
+
+  //=================================== Second half of a started block
+  if (num_values > 0 and position_ % 2 == 1) values[n++] = Rand();
+
+  //=================================== Whole blocks
+  const uint64_t first_counter = position_ / 2;
+  const size_t num_blocks = (num_values - n) / 2;
+  double* block_values = values + n;
+  for (size_t b = 0; b < num_blocks; ++b)
+  {
+    const Block block =
+      Philox(MakeCounter(stream_, first_counter + b), key_);
+    block_values[2 * b] = ToUniform(block, 0);
+    block_values[2 * b + 1] = ToUniform(block, 1);
+  }
+  position_ += 2 * num_blocks;
+  n += 2 * num_blocks;
+
+  //=================================== First half of a last block
+  if (n < num_values) values[n] = Rand();
+}
+
+double chi_math::CounterBasedRNG::Uniform(uint64_t seed,
+                                           uint64_t stream,
+                                           uint64_t position)
+{
+  const Block block = Philox(MakeCounter(stream, position / 2), MakeKey(seed));
+  return ToUniform(block, position % 2);
+}
@@ -0,0 +1,117 @@
+#ifndef _chi_math_counter_based_rng_h
+#define _chi_math_counter_based_rng_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chi_math
+{
+//#########################################################
+/**Counter-based random number generator, Philox4x32-10 (Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC11).
+ *
+ * The numbers are a pure function of a seed, a stream and a counter, so
+ * that any position of any stream is computed directly, without state
+ * shared between threads or ranks and without skipping ahead. Keying the
+ * stream by, e.g., a global cell id or particle id makes the sampling
+ * independent of the thread and process counts. Each counter value yields
+ * two uniform doubles, with 53 random bits each.
+ \code
+ chi_math::CounterBasedRNG rng(seed, cell.global_id_);
+ const double xi = rng.Rand();
+
+ std::vector<double> xis(1000);
+ rng.Fill(xis);
+ \endcode*/
+class CounterBasedRNG
+{
+public:
+  typedef std::array<uint32_t, 4> Block;
+  typedef std::array<uint32_t, 2> Key;
+
+private:
+  Key key_;
+  uint64_t stream_;
+  uint64_t position_ = 0; ///< Index of the next double in the stream.
+
+  uint64_t block_counter_ = UINT64_MAX;
+  Block block_{};
+
+public:
+  explicit CounterBasedRNG(uint64_t seed = 0, uint64_t stream = 0);
+
+  /**Positions the generator at the start of another stream.*/
+  void SetStream(uint64_t stream);
+  /**Positions the generator at the given double of its stream.*/
+  void SetPosition(uint64_t position);
+
+  uint64_t Stream() const { return stream_; }
+  uint64_t Position() const { return position_; }
+
+  /**Returns the next uniform random number in [0,1) of the stream.*/
+  double Rand();
+
+  /**Fills the values with the next uniform random numbers of the stream,
+   * the same as repeated calls to Rand would.*/
+  void Fill(double* values, size_t num_values);
+  void Fill(std::vector<double>& values) { Fill(values.data(), values.size()); }
+
+  /**Returns the uniform random number at the given position of a stream,
+   * without constructing a generator.*/
+  static double Uniform(uint64_t seed, uint64_t stream, uint64_t position);
+
+  //=================================== Bijection
+  /**The Philox4x32-10 bijection of a counter block for a key.*/
+  static Block Philox(Block counter, Key key)
+  {
+    constexpr uint64_t M0 = 0xD2511F53;
+    constexpr uint64_t M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9;
+    constexpr uint32_t W1 = 0xBB67AE85;
+
+    for (int round = 0; round < 10; ++round)
+    {
+      if (round > 0)
+      {
+        key[0] += W0;
+        key[1] += W1;
+      }
+      const uint64_t product0 = M0 * counter[0];
+      const uint64_t product1 = M1 * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                 static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                 static_cast<uint32_t>(product0)};
+    }
+    return counter;
+  }
+
+private:
+  static Key MakeKey(uint64_t seed)
+  {
+    return {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+  }
+
+  /**The counter block of the given counter of a stream.*/
+  static Block MakeCounter(uint64_t stream, uint64_t counter)
+  {
+    return {static_cast<uint32_t>(counter),
+            static_cast<uint32_t>(counter >> 32),
+            static_cast<uint32_t>(stream),
+            static_cast<uint32_t>(stream >> 32)};
+  }
+
+  /**The double, in [0,1), made of the two words starting at index 2*half
+   * of the block.*/
+  static double ToUniform(const Block& block, size_t half)
+  {
+    const uint64_t bits = (static_cast<uint64_t>(block[2 * half]) << 32) |
+                          block[2 * half + 1];
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+  }
+};
+}
+
+#endif
@@ -2,6 +2,8 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "utils/chi_memory_accounting.h"
 
 #include <iomanip>
 #include <algorithm>
@@ -31,6 +33,11 @@ chi_math::SparseMatrix::
     rowI_values_[i] = (in_matrix.rowI_values_[i]);
     rowI_indices_[i] = (in_matrix.rowI_indices_[i]);
   }
+
+  compressed_      = in_matrix.compressed_;
+  csr_row_offsets_ = in_matrix.csr_row_offsets_;
+  csr_col_indices_ = in_matrix.csr_col_indices_;
+  csr_values_      = in_matrix.csr_values_;
 }
 
 //###################################################################
@@ -38,6 +45,7 @@ chi_math::SparseMatrix::
 void chi_math::SparseMatrix::Insert(size_t i, size_t j, double value)
 {
   CheckInitialized();
+  ClearCompressed();
 
   if ((i<0) || (i >= row_size_) || (j < 0) || (j >= col_size_))
   {
@@ -69,6 +77,7 @@ void chi_math::SparseMatrix::Insert(size_t i, size_t j, double value)
 void chi_math::SparseMatrix::InsertAdd(size_t i, size_t j, double value)
 {
   CheckInitialized();
+  ClearCompressed();
 
   if ((i<0) || (i >= row_size_) || (j < 0) || (j >= col_size_))
   {
@@ -100,6 +109,7 @@ void chi_math::SparseMatrix::InsertAdd(size_t i, size_t j, double value)
 void chi_math::SparseMatrix::SetDiagonal(const std::vector<double>& diag)
 {
   CheckInitialized();
+  ClearCompressed();
 
   size_t num_rows = rowI_values_.size();
   //============================================= Check size
@@ -162,7 +172,9 @@ double chi_math::SparseMatrix::ValueIJ(size_t i, size_t j) const
 }
 
 //###################################################################
-/**Sorts the column indices of each row for faster lookup.*/
+/**Sorts the column indices of each row for faster lookup and builds the
+ * compressed (CSR) storage, with the column indices and values of all the
+ * rows in contiguous arrays, used by RowSpan and the products.*/
 void chi_math::SparseMatrix::Compress()
 {
   for (size_t i=0; i < rowI_indices_.size(); ++i)
@@ -204,6 +216,99 @@ void chi_math::SparseMatrix::Compress()
     }
   }
 
+  //====================================== Build the CSR arrays
+  size_t num_entries = 0;
+  for (const auto& indices : rowI_indices_) num_entries += indices.size();
+
+  csr_row_offsets_.assign(1, 0);
+  csr_row_offsets_.reserve(row_size_ + 1);
+  csr_col_indices_.clear();
+  csr_col_indices_.reserve(num_entries);
+  csr_values_.clear();
+  csr_values_.reserve(num_entries);
+  for (size_t i=0; i < rowI_indices_.size(); ++i)
+  {
+    csr_col_indices_.insert(csr_col_indices_.end(),
+                            rowI_indices_[i].begin(), rowI_indices_[i].end());
+    csr_values_.insert(csr_values_.end(),
+                       rowI_values_[i].begin(), rowI_values_[i].end());
+    csr_row_offsets_.push_back(csr_values_.size());
+  }
+  compressed_ = true;
+}
+
+//###################################################################
+/**Returns a contiguous view of the entries of a row, from the compressed
+ * storage if available.*/
+chi_math::SparseMatrix::RowView
+  chi_math::SparseMatrix::RowSpan(size_t row_id) const
+{
+  if (compressed_)
+  {
+    const size_t begin = csr_row_offsets_[row_id];
+    return {csr_col_indices_.data() + begin,
+            csr_values_.data() + begin,
+            csr_row_offsets_[row_id + 1] - begin};
+  }
+
+  return {rowI_indices_[row_id].data(),
+          rowI_values_[row_id].data(),
+          rowI_values_[row_id].size()};
+}
+
+//###################################################################
+/**Sparse matrix-vector product y += alpha A x, with x and y of at least
+ * NumCols() and NumRows() entries.*/
+void chi_math::SparseMatrix::
+  MultiplyAdd(const double* x, double* y, double alpha/*=1.0*/) const
+{
+  for (size_t i=0; i < row_size_; ++i)
+  {
+    const auto row = RowSpan(i);
+    double sum = 0.0;
+    for (size_t k=0; k < row.size; ++k)
+      sum += row.values[k] * x[row.column_indices[k]];
+    y[i] += alpha * sum;
+  }
+}
+
+//###################################################################
+/**Sparse matrix-vector product y = A x.*/
+void chi_math::SparseMatrix::
+  Multiply(const std::vector<double>& x, std::vector<double>& y) const
+{
+  ChiInvalidArgumentIf(x.size() != col_size_,
+                       "Incompatible vector of size " +
+                       std::to_string(x.size()) + " for a matrix with " +
+                       std::to_string(col_size_) + " columns.");
+  y.assign(row_size_, 0.0);
+  MultiplyAdd(x.data(), y.data());
+}
+
+//###################################################################
+/**Sparse matrix-matrix product Y += alpha A X for a block of vectors,
+ * vector k of X (Y) starting at X + k*x_stride (Y + k*y_stride). Each row
+ * is applied to all the vectors before moving to the next, which keeps
+ * the row in cache.*/
+void chi_math::SparseMatrix::
+  MultiplyAddBlock(size_t num_vectors,
+                   const double* X, size_t x_stride,
+                   double* Y, size_t y_stride,
+                   double alpha/*=1.0*/) const
+{
+  for (size_t i=0; i < row_size_; ++i)
+  {
+    const auto row = RowSpan(i);
+    if (row.size == 0) continue;
+    for (size_t v=0; v < num_vectors; ++v)
+    {
+      const double* x = X + v * x_stride;
+      double sum = 0.0;
+      for (size_t k=0; k < row.size; ++k)
+        sum += row.values[k] * x[row.column_indices[k]];
+      Y[v * y_stride + i] += alpha * sum;
+    }
+  }
 }
 
 //###################################################################
@@ -257,18 +362,33 @@ void chi_math::SparseMatrix::CheckInitialized() const
   }
 }
 
+//###################################################################
+/**Releases the compressed storage, which is stale after a modification.*/
+void chi_math::SparseMatrix::ClearCompressed()
+{
+  if (not compressed_) return;
+  compressed_ = false;
+  csr_row_offsets_.clear();
+  csr_col_indices_.clear();
+  csr_values_.clear();
+}
+
 //###################################################################
 // Iterator routines
 namespace chi_math
 {
+  /**Mutable access to a row. Releases the compressed storage since the
+   * values may be modified.*/
   SparseMatrix::RowIteratorContext SparseMatrix::Row(size_t row_id)
-  {return {*this, row_id};}
+  {ClearCompressed(); return {*this, row_id};}
 
   SparseMatrix::ConstRowIteratorContext SparseMatrix::Row(size_t row_id) const
   {return {*this, row_id};}
 
   SparseMatrix::EntriesIterator SparseMatrix::begin()
   {
+    ClearCompressed();
+
     //Find first non-empty row
     size_t nerow = row_size_; //nerow = non-empty row
     for (size_t r=0; r < row_size_; ++r)
@@ -282,5 +402,12 @@ namespace chi_math
   {return EntriesIterator(*this, row_size_);}
 }
 
-
-
+//###################################################################
+size_t chi_math::SparseMatrix::GetMemoryUsage() const
+{
+  return chi::VectorMemoryUsage(csr_row_offsets_) +
+         chi::VectorMemoryUsage(csr_col_indices_) +
+         chi::VectorMemoryUsage(csr_values_) +
+         chi::VectorMemoryUsage(rowI_indices_) +
+         chi::VectorMemoryUsage(rowI_values_);
+}
@@ -15,6 +15,13 @@ private:
   size_t row_size_;   ///< Maximum number of rows for this matrix
   size_t col_size_;   ///< Maximum number of columns for this matrix
 
+  /**Compressed (CSR) copy of the rows, built by Compress(). The entries of
+   * row i are at [csr_row_offsets_[i], csr_row_offsets_[i+1]).*/
+  bool compressed_ = false;
+  std::vector<size_t> csr_row_offsets_;
+  std::vector<size_t> csr_col_indices_;
+  std::vector<double> csr_values_;
+
 public:
   /**rowI_indices[i] is a vector indices j for the
    * non-zero columns.*/
@@ -36,11 +43,37 @@ public:
   void   SetDiagonal(const std::vector<double>& diag);
 
   void Compress();
+  /**Whether the compressed storage is in use, i.e., Compress() was called
+   * and the matrix has not been modified through Insert, InsertAdd or
+   * SetDiagonal since. Modifying rowI_indices_ or rowI_values_ directly
+   * requires calling Compress() again.*/
+  bool IsCompressed() const {return compressed_;}
+
+  /**Contiguous view of the entries of a row.*/
+  struct RowView
+  {
+    const size_t* column_indices = nullptr;
+    const double* values = nullptr;
+    size_t size = 0;
+  };
+  RowView RowSpan(size_t row_id) const;
+
+  void MultiplyAdd(const double* x, double* y, double alpha = 1.0) const;
+  void Multiply(const std::vector<double>& x, std::vector<double>& y) const;
+  void MultiplyAddBlock(size_t num_vectors,
+                        const double* X, size_t x_stride,
+                        double* Y, size_t y_stride,
+                        double alpha = 1.0) const;
 
   std::string PrintStr() const;
 
+  /**Returns the number of bytes held by the entries, in both the row-wise
+   * and the compressed storage.*/
+  size_t GetMemoryUsage() const;
+
 private:
   void CheckInitialized() const;
+  void ClearCompressed();
 
 public:
   virtual ~SparseMatrix() = default;
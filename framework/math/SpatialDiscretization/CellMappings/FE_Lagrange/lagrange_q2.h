@@ -0,0 +1,114 @@
+#ifndef CHITECH_LAGRANGE_Q2_CELLMAPPING_H
+#define CHITECH_LAGRANGE_Q2_CELLMAPPING_H
+
+#include "math/SpatialDiscretization/CellMappings/cell_mapping_base.h"
+#include "math/Quadratures/quadrature_line.h"
+#include "mesh/chi_mesh.h"
+#include "mesh/Cell/cell.h"
+
+#include <array>
+
+//###################################################################
+namespace chi_math
+{
+/**Triquadratic (Q2) Lagrange mapping for quadrilaterals (9 nodes) and
+ * hexahedra (27 nodes), i.e., polygons and polyhedra with these sub-types.
+ * The geometry is mapped (bi/tri)linearly from the reference cell
+ * \f$ [0,1]^d \f$, of which the corners map to the cell vertices in VTK
+ * order, and the shape functions are tensor products of the 1D quadratic
+ * Lagrange polynomials of the nodes \f$ \{0, \frac{1}{2}, 1\} \f$.
+ *
+ * Node \f$ n = a_0 + 3 a_1 + 9 a_2 \f$ is located at the reference point
+ * \f$ \frac{1}{2}(a_0, a_1, a_2) \f$. The volume quadrature is the tensor
+ * product of a line quadrature, such that the volume unit integrals are
+ * computed with sum-factorized kernels, contracting one dimension at a
+ * time, instead of summing all the quadrature points for each node pair.*/
+class LagrangeQ2MappingFE : public CellMapping
+{
+public:
+  typedef std::vector<double> VecDbl;
+  typedef std::vector<chi_mesh::Vector3> VecVec3;
+  /**Values of the three 1D basis functions, per 1D quadrature point.*/
+  typedef std::vector<std::array<double, 3>> Table1D;
+
+private:
+  const unsigned int dimension_;
+  const QuadratureLine& line_quadrature_;
+  /**The cell vertices, in the order of the reference corners.*/
+  const std::vector<chi_mesh::Vector3> vertices_;
+  /**The reference plane of each face, i.e., the fixed reference
+   * dimension and its value (0 or 1).*/
+  const std::vector<std::pair<unsigned int, unsigned int>> face_planes_;
+
+  std::vector<chi_mesh::Vector3> node_locations_;
+  /**The 1D basis functions and their derivatives at the 1D quadrature
+   * points.*/
+  Table1D basis_;
+  Table1D basis_derivatives_;
+
+public:
+  /**Constructor. Throws if the cell is not a quadrilateral or hexahedron.*/
+  LagrangeQ2MappingFE(const chi_mesh::Cell& cell,
+                      const chi_mesh::MeshContinuum& ref_grid,
+                      const QuadratureLine& line_quadrature);
+
+  unsigned int Dimension() const { return dimension_; }
+
+  //02 Shape functions
+  /**Maps a point to the reference cell, with Newton iterations.*/
+  chi_mesh::Vector3 MapToReference(const chi_mesh::Vector3& xyz) const;
+
+  double ShapeValue(int i, const chi_mesh::Vector3& xyz) const override;
+
+  void ShapeValues(const chi_mesh::Vector3& xyz,
+                   std::vector<double>& shape_values) const override;
+
+  chi_mesh::Vector3 GradShapeValue(int i,
+                                   const chi_mesh::Vector3& xyz) const override;
+
+  void GradShapeValues(
+    const chi_mesh::Vector3& xyz,
+    std::vector<chi_mesh::Vector3>& gradshape_values) const override;
+
+  std::vector<chi_mesh::Vector3> GetNodeLocations() const override
+  { return node_locations_; }
+
+  //03 Unit integrals
+  void ComputeUnitIntegrals(
+    finite_element::UnitIntegralData& ui_data) const override;
+
+  //04 Quadrature point data
+  void InitializeVolumeQuadraturePointData(
+    finite_element::InternalQuadraturePointData& internal_data) const override;
+
+  void InitializeFaceQuadraturePointData(
+    unsigned int face,
+    finite_element::FaceQuadraturePointData& faces_qp_data) const override;
+
+private:
+  //00
+  static unsigned int CellDimension(const chi_mesh::Cell& cell);
+  static std::vector<std::pair<unsigned int, unsigned int>>
+  MakeFacePlanes(const chi_mesh::Cell& cell);
+  static std::vector<std::vector<int>>
+  MakeFaceNodeMappings(const chi_mesh::Cell& cell);
+
+  //02
+  /**The physical point of a reference point.*/
+  chi_mesh::Vector3 MapToPhysical(const chi_mesh::Vector3& xi) const;
+  /**The Jacobian of the geometry map at a reference point. For
+   * quadrilaterals the third column is the z unit vector.*/
+  chi_mesh::Matrix3x3 Jacobian(const chi_mesh::Vector3& xi) const;
+  double ReferenceShapeValue(size_t i, const chi_mesh::Vector3& xi) const;
+  chi_mesh::Vector3 ReferenceShapeGrad(size_t i,
+                                       const chi_mesh::Vector3& xi) const;
+
+  //03
+  void SumFactorizedMatrix(const std::array<const Table1D*, 3>& left,
+                           const std::array<const Table1D*, 3>& right,
+                           const VecDbl& coefficients,
+                           std::vector<VecDbl>& matrix) const;
+};
+}//namespace chi_math
+
+#endif //CHITECH_LAGRANGE_Q2_CELLMAPPING_H
@@ -0,0 +1,155 @@
+#include "lagrange_q2.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_log_exceptions.h"
+
+namespace
+{
+/**Reference coordinates of the cell corners in VTK order. Quadrilaterals
+ * use the first four.*/
+constexpr std::array<std::array<unsigned int, 3>, 8> CORNERS = {{
+  {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+  {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+/**The vertex locations of a cell.*/
+std::vector<chi_mesh::Vector3>
+  GetCellVertices(const chi_mesh::MeshContinuum& grid,
+                  const chi_mesh::Cell& cell)
+{
+  std::vector<chi_mesh::Vector3> vertices;
+  vertices.reserve(cell.vertex_ids_.size());
+  for (const uint64_t vid : cell.vertex_ids_)
+    vertices.push_back(grid.vertices[vid]);
+  return vertices;
+}
+}//namespace
+
+//###################################################################
+/**Constructor.*/
+chi_math::LagrangeQ2MappingFE::
+  LagrangeQ2MappingFE(const chi_mesh::Cell& cell,
+                      const chi_mesh::MeshContinuum& ref_grid,
+                      const QuadratureLine& line_quadrature)
+  : CellMapping(ref_grid, cell,
+                CellDimension(cell) == 2 ? 9 : 27, //num_nodes
+                MakeFaceNodeMappings(cell),
+                &CellMapping::ComputeCellVolumeAndAreas),
+    dimension_(CellDimension(cell)),
+    line_quadrature_(line_quadrature),
+    vertices_(GetCellVertices(ref_grid, cell)),
+    face_planes_(MakeFacePlanes(cell))
+{
+  //======================================== Check orientation
+  const chi_mesh::Vector3 center(0.5, 0.5, dimension_ == 3 ? 0.5 : 0.0);
+  ChiLogicalErrorIf(Jacobian(center).Det() <= 0.0,
+                    "Cell " + std::to_string(cell.global_id_) + " has an "
+                    "inverted geometry map. The vertices must be in VTK order.");
+
+  //======================================== Node locations
+  node_locations_.reserve(num_nodes_);
+  for (size_t n = 0; n < num_nodes_; ++n)
+  {
+    chi_mesh::Vector3 xi;
+    for (unsigned int d = 0, a = n; d < dimension_; ++d, a /= 3)
+      xi(d) = 0.5 * static_cast<double>(a % 3);
+    node_locations_.push_back(MapToPhysical(xi));
+  }
+
+  //======================================== 1D basis tables
+  for (const auto& qpoint : line_quadrature_.qpoints_)
+  {
+    const double x = qpoint.x;
+    basis_.push_back({(1.0 - x) * (1.0 - 2.0 * x),
+                      4.0 * x * (1.0 - x),
+                      x * (2.0 * x - 1.0)});
+    basis_derivatives_.push_back({4.0 * x - 3.0,
+                                  4.0 - 8.0 * x,
+                                  4.0 * x - 1.0});
+  }
+}
+
+//###################################################################
+/**Returns 2 for quadrilaterals and 3 for hexahedra, throws otherwise.*/
+unsigned int chi_math::LagrangeQ2MappingFE::
+  CellDimension(const chi_mesh::Cell& cell)
+{
+  using chi_mesh::CellType;
+  if (cell.Type() == CellType::POLYGON and
+      cell.SubType() == CellType::QUADRILATERAL and
+      cell.vertex_ids_.size() == 4 and cell.faces_.size() == 4)
+    return 2;
+  if (cell.Type() == CellType::POLYHEDRON and
+      cell.SubType() == CellType::HEXAHEDRON and
+      cell.vertex_ids_.size() == 8 and cell.faces_.size() == 6)
+    return 3;
+
+  ChiLogicalError("Q2 Lagrange mappings only support quadrilaterals and "
+                  "hexahedra. Cell " + std::to_string(cell.global_id_) +
+                  " is a " + chi_mesh::CellTypeName(cell.SubType()) + ".");
+}
+
+//###################################################################
+/**Identifies the reference plane of each face from its corners.*/
+std::vector<std::pair<unsigned int, unsigned int>>
+  chi_math::LagrangeQ2MappingFE::MakeFacePlanes(const chi_mesh::Cell& cell)
+{
+  const unsigned int dimension = CellDimension(cell);
+
+  std::vector<std::pair<unsigned int, unsigned int>> face_planes;
+  face_planes.reserve(cell.faces_.size());
+  for (const auto& face : cell.faces_)
+  {
+    //=================================== Reference corners of the face
+    std::vector<size_t> corners;
+    for (const uint64_t fvid : face.vertex_ids_)
+      for (size_t c = 0; c < cell.vertex_ids_.size(); ++c)
+        if (cell.vertex_ids_[c] == fvid) corners.push_back(c);
+
+    //=================================== Plane shared by all the corners
+    bool found = false;
+    for (unsigned int d = 0; d < dimension and not found; ++d)
+      for (unsigned int s = 0; s < 2 and not found; ++s)
+      {
+        size_t num_on_plane = 0;
+        for (const size_t c : corners)
+          if (CORNERS[c][d] == s) ++num_on_plane;
+        if (num_on_plane == corners.size() and
+            corners.size() == (dimension == 2 ? 2 : 4))
+        {
+          face_planes.emplace_back(d, s);
+          found = true;
+        }
+      }
+
+    ChiLogicalErrorIf(not found,
+                      "Cell " + std::to_string(cell.global_id_) +
+                      " has a face that is not a face of the reference cell. "
+                      "The vertices must be in VTK order.");
+  }//for face
+
+  return face_planes;
+}
+
+//###################################################################
+/**Maps the face nodes to the cell nodes, i.e., the nodes on the reference
+ * plane of each face.*/
+std::vector<std::vector<int>>
+  chi_math::LagrangeQ2MappingFE::MakeFaceNodeMappings(const chi_mesh::Cell& cell)
+{
+  const unsigned int dimension = CellDimension(cell);
+  const int num_nodes = dimension == 2 ? 9 : 27;
+
+  std::vector<std::vector<int>> mappings;
+  for (const auto& [d, s] : MakeFacePlanes(cell))
+  {
+    const int stride = d == 0 ? 1 : (d == 1 ? 3 : 9);
+    std::vector<int> face_mapping;
+    for (int n = 0; n < num_nodes; ++n)
+      if ((n / stride) % 3 == static_cast<int>(2 * s))
+        face_mapping.push_back(n);
+    mappings.push_back(std::move(face_mapping));
+  }
+
+  return mappings;
+}
@@ -0,0 +1,173 @@
+#include "lagrange_q2.h"
+
+#include "chi_log_exceptions.h"
+
+#include <cmath>
+
+namespace
+{
+/**The 1D quadratic Lagrange basis function of node a at x.*/
+double Basis1D(unsigned int a, double x)
+{
+  switch (a)
+  {
+    case 0: return (1.0 - x) * (1.0 - 2.0 * x);
+    case 1: return 4.0 * x * (1.0 - x);
+    default: return x * (2.0 * x - 1.0);
+  }
+}
+
+/**The derivative of the 1D quadratic Lagrange basis function of node a.*/
+double Basis1DDerivative(unsigned int a, double x)
+{
+  switch (a)
+  {
+    case 0: return 4.0 * x - 3.0;
+    case 1: return 4.0 - 8.0 * x;
+    default: return 4.0 * x - 1.0;
+  }
+}
+
+/**The (bi/tri)linear corner weight of corner c and its derivative in
+ * reference dimension p, or the weight itself when p >= dimension.*/
+double CornerWeight(size_t c, const chi_mesh::Vector3& xi,
+                    unsigned int dimension, unsigned int p)
+{
+  constexpr std::array<std::array<unsigned int, 3>, 8> CORNERS = {{
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+    {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}}};
+
+  double weight = 1.0;
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    const bool upper = CORNERS[c][d] == 1;
+    if (d == p)
+      weight *= upper ? 1.0 : -1.0;
+    else
+      weight *= upper ? xi[d] : 1.0 - xi[d];
+  }
+  return weight;
+}
+}//namespace
+
+//###################################################################
+/**The physical point of a reference point.*/
+chi_mesh::Vector3 chi_math::LagrangeQ2MappingFE::
+  MapToPhysical(const chi_mesh::Vector3& xi) const
+{
+  chi_mesh::Vector3 xyz;
+  for (size_t c = 0; c < vertices_.size(); ++c)
+    xyz += CornerWeight(c, xi, dimension_, 3) * vertices_[c];
+  return xyz;
+}
+
+//###################################################################
+/**The Jacobian of the geometry map at a reference point.*/
+chi_mesh::Matrix3x3 chi_math::LagrangeQ2MappingFE::
+  Jacobian(const chi_mesh::Vector3& xi) const
+{
+  chi_mesh::Matrix3x3 J;
+  J.SetColJVec(2, chi_mesh::Vector3(0.0, 0.0, 1.0));
+  for (unsigned int p = 0; p < dimension_; ++p)
+  {
+    chi_mesh::Vector3 column;
+    for (size_t c = 0; c < vertices_.size(); ++c)
+      column += CornerWeight(c, xi, dimension_, p) * vertices_[c];
+    J.SetColJVec(static_cast<int>(p), column);
+  }
+  return J;
+}
+
+//###################################################################
+/**Maps a point to the reference cell with Newton iterations. The map is
+ * affine for parallelograms and parallelepipeds, in which case a single
+ * iteration suffices.*/
+chi_mesh::Vector3 chi_math::LagrangeQ2MappingFE::
+  MapToReference(const chi_mesh::Vector3& xyz) const
+{
+  chi_mesh::Vector3 xi(0.5, 0.5, dimension_ == 3 ? 0.5 : 0.0);
+  const double scale = (node_locations_.back() - node_locations_.front()).Norm();
+
+  for (int iteration = 0; iteration < 50; ++iteration)
+  {
+    chi_mesh::Vector3 residual = MapToPhysical(xi) - xyz;
+    if (dimension_ == 2) residual.z = 0.0;
+    if (residual.Norm() <= 1.0e-14 * scale) break;
+
+    xi = xi - Jacobian(xi).Inverse() * residual;
+  }
+
+  return xi;
+}
+
+//###################################################################
+/**The reference shape function of node i.*/
+double chi_math::LagrangeQ2MappingFE::
+  ReferenceShapeValue(size_t i, const chi_mesh::Vector3& xi) const
+{
+  double value = 1.0;
+  for (unsigned int d = 0, a = i; d < dimension_; ++d, a /= 3)
+    value *= Basis1D(a % 3, xi[d]);
+  return value;
+}
+
+//###################################################################
+/**The reference gradient of the shape function of node i.*/
+chi_mesh::Vector3 chi_math::LagrangeQ2MappingFE::
+  ReferenceShapeGrad(size_t i, const chi_mesh::Vector3& xi) const
+{
+  chi_mesh::Vector3 grad;
+  for (unsigned int p = 0; p < dimension_; ++p)
+  {
+    double value = 1.0;
+    for (unsigned int d = 0, a = i; d < dimension_; ++d, a /= 3)
+      value *= d == p ? Basis1DDerivative(a % 3, xi[d])
+                      : Basis1D(a % 3, xi[d]);
+    grad(p) = value;
+  }
+  return grad;
+}
+
+//###################################################################
+/**Shape function i evaluated at the given point.*/
+double chi_math::LagrangeQ2MappingFE::
+  ShapeValue(const int i, const chi_mesh::Vector3& xyz) const
+{
+  return ReferenceShapeValue(i, MapToReference(xyz));
+}
+
+//###################################################################
+/**Populates shape_values with the value of each shape function's
+ * value evaluate at the supplied point.*/
+void chi_math::LagrangeQ2MappingFE::
+  ShapeValues(const chi_mesh::Vector3& xyz,
+              std::vector<double>& shape_values) const
+{
+  const auto xi = MapToReference(xyz);
+  shape_values.resize(num_nodes_);
+  for (size_t i = 0; i < num_nodes_; ++i)
+    shape_values[i] = ReferenceShapeValue(i, xi);
+}
+
+//###################################################################
+/**Returns the evaluation of grad-shape function i at the supplied point.*/
+chi_mesh::Vector3 chi_math::LagrangeQ2MappingFE::
+  GradShapeValue(const int i, const chi_mesh::Vector3& xyz) const
+{
+  const auto xi = MapToReference(xyz);
+  return Jacobian(xi).Inverse().Transpose() * ReferenceShapeGrad(i, xi);
+}
+
+//###################################################################
+/**Populates gradshape_values with the value of each shape function's
+ * gradient evaluated at the supplied point.*/
+void chi_math::LagrangeQ2MappingFE::
+  GradShapeValues(const chi_mesh::Vector3& xyz,
+                  std::vector<chi_mesh::Vector3>& gradshape_values) const
+{
+  const auto xi = MapToReference(xyz);
+  auto JTinv = Jacobian(xi).Inverse().Transpose();
+  gradshape_values.resize(num_nodes_);
+  for (size_t i = 0; i < num_nodes_; ++i)
+    gradshape_values[i] = JTinv * ReferenceShapeGrad(i, xi);
+}
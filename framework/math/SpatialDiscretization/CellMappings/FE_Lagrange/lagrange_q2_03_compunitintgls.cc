@@ -0,0 +1,207 @@
+#include "lagrange_q2.h"
+
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+
+//###################################################################
+/**Accumulates into matrix the tensor-product integral
+ * \f[
+ * A_{ij} = \sum_q c_q \prod_d L_d(q_d, i_d) R_d(q_d, j_d)
+ * \f]
+ * with sum factorization, i.e., contracting the quadrature points one
+ * dimension at a time. For hexahedra this takes
+ * \f$ \mathcal{O}(n_q^3 \cdot 9 + n_q^2 \cdot 81 + n_q \cdot 729) \f$
+ * operations instead of the \f$ \mathcal{O}(27^2 n_q^3) \f$ of a direct
+ * sum over the quadrature points.
+ *
+ * \param left The 1D table of each dimension for the row nodes.
+ * \param right The 1D table of each dimension for the column nodes.
+ * \param coefficients The coefficient at each volume quadrature point,
+ *                     including the weight and Jacobian determinant.
+ * \param matrix The matrix to accumulate into.*/
+void chi_math::LagrangeQ2MappingFE::
+  SumFactorizedMatrix(const std::array<const Table1D*, 3>& left,
+                      const std::array<const Table1D*, 3>& right,
+                      const VecDbl& coefficients,
+                      std::vector<VecDbl>& matrix) const
+{
+  const size_t nq = line_quadrature_.qpoints_.size();
+
+  //======================================== Contract one dimension at a time
+  // The work array is indexed as [pair][q_d + nq*q_rest], with pair the
+  // node-pair indices (3*a + b) of the contracted dimensions.
+  std::vector<double> work = coefficients;
+  size_t num_pairs = 1;
+  size_t num_rest = coefficients.size();
+  for (unsigned int d = 0; d < dimension_; ++d)
+  {
+    num_rest /= nq;
+    const auto& L = *left[d];
+    const auto& R = *right[d];
+
+    std::vector<double> contracted(num_pairs * 9 * num_rest, 0.0);
+    for (size_t pair = 0; pair < num_pairs; ++pair)
+      for (size_t rest = 0; rest < num_rest; ++rest)
+        for (size_t q = 0; q < nq; ++q)
+        {
+          const double value = work[(pair * num_rest + rest) * nq + q];
+          if (value == 0.0) continue;
+          for (size_t a = 0; a < 3; ++a)
+            for (size_t b = 0; b < 3; ++b)
+              contracted[(pair * 9 + 3 * a + b) * num_rest + rest] +=
+                L[q][a] * R[q][b] * value;
+        }
+
+    work = std::move(contracted);
+    num_pairs *= 9;
+  }
+
+  //======================================== Scatter pairs to node indices
+  // The pair index has the first dimension as the most significant digit.
+  for (size_t pair = 0; pair < num_pairs; ++pair)
+  {
+    size_t i = 0, j = 0, digits = pair;
+    for (unsigned int d = dimension_; d-- > 0;)
+    {
+      const size_t stride = d == 0 ? 1 : (d == 1 ? 3 : 9);
+      const size_t ab = digits % 9;
+      digits /= 9;
+      i += (ab / 3) * stride;
+      j += (ab % 3) * stride;
+    }
+    matrix[i][j] += work[pair];
+  }
+}
+
+//###################################################################
+/**Computes the unit integrals. The volume matrices are sum-factorized
+ * over the tensor-product quadrature, the vectors and surface integrals
+ * are summed directly since they are cheap. Surface integrals are only
+ * summed over the face nodes, the other shape functions vanishing on the
+ * face.*/
+void chi_math::LagrangeQ2MappingFE::
+  ComputeUnitIntegrals(chi_math::finite_element::UnitIntegralData& ui_data) const
+{
+  typedef std::vector<VecDbl> MatDbl;
+  typedef std::vector<VecVec3> MatVec3;
+
+  finite_element::InternalQuadraturePointData vol_qp_data;
+  InitializeVolumeQuadraturePointData(vol_qp_data);
+
+  const size_t num_qpoints = vol_qp_data.QuadraturePointIndices().size();
+  const size_t n = num_nodes_;
+
+  //======================================== Geometric factors per qpoint
+  // With JTinv the inverse transposed Jacobian, the physical gradients are
+  // grad N = JTinv * ref_grad N.
+  std::vector<chi_mesh::Matrix3x3> JTinvs(num_qpoints);
+  VecDbl JxW(num_qpoints);
+  {
+    const size_t nq = line_quadrature_.qpoints_.size();
+    for (size_t qp = 0; qp < num_qpoints; ++qp)
+    {
+      chi_mesh::Vector3 xi;
+      for (unsigned int d = 0, q = qp; d < dimension_; ++d, q /= nq)
+        xi(d) = line_quadrature_.qpoints_[q % nq].x;
+      JTinvs[qp] = Jacobian(xi).Inverse().Transpose();
+      JxW[qp] = vol_qp_data.JxW(static_cast<unsigned int>(qp));
+    }
+  }
+
+  auto Tables = [this](int derivative_dim)
+  {
+    std::array<const Table1D*, 3> tables = {&basis_, &basis_, &basis_};
+    if (derivative_dim >= 0) tables[derivative_dim] = &basis_derivatives_;
+    return tables;
+  };
+
+  //======================================== Mass matrix
+  MatDbl IntV_shapeI_shapeJ(n, VecDbl(n, 0.0));
+  SumFactorizedMatrix(Tables(-1), Tables(-1), JxW, IntV_shapeI_shapeJ);
+
+  //======================================== Stiffness matrix
+  // grad N_i . grad N_j = sum_pr (JTinv^T JTinv)_pr d_p N_i d_r N_j
+  MatDbl IntV_gradshapeI_gradshapeJ(n, VecDbl(n, 0.0));
+  VecDbl coefficients(num_qpoints);
+  for (unsigned int p = 0; p < dimension_; ++p)
+    for (unsigned int r = 0; r < dimension_; ++r)
+    {
+      for (size_t qp = 0; qp < num_qpoints; ++qp)
+      {
+        double metric = 0.0;
+        for (int k = 0; k < 3; ++k)
+          metric += JTinvs[qp].GetIJ(k, p) * JTinvs[qp].GetIJ(k, r);
+        coefficients[qp] = metric * JxW[qp];
+      }
+      SumFactorizedMatrix(Tables(p), Tables(r), coefficients,
+                          IntV_gradshapeI_gradshapeJ);
+    }
+
+  //======================================== Gradient matrix
+  // N_i (grad N_j)_k = sum_r JTinv_kr N_i d_r N_j
+  MatVec3 IntV_shapeI_gradshapeJ(n, VecVec3(n));
+  MatDbl component(n, VecDbl(n));
+  for (unsigned int k = 0; k < dimension_; ++k)
+  {
+    for (auto& row : component) row.assign(n, 0.0);
+    for (unsigned int r = 0; r < dimension_; ++r)
+    {
+      for (size_t qp = 0; qp < num_qpoints; ++qp)
+        coefficients[qp] = JTinvs[qp].GetIJ(static_cast<int>(k),
+                                            static_cast<int>(r)) * JxW[qp];
+      SumFactorizedMatrix(Tables(-1), Tables(r), coefficients, component);
+    }
+    for (size_t i = 0; i < n; ++i)
+      for (size_t j = 0; j < n; ++j)
+        IntV_shapeI_gradshapeJ[i][j](k) = component[i][j];
+  }
+
+  //======================================== Volume vectors
+  VecDbl  IntV_shapeI(n, 0.0);
+  VecVec3 IntV_gradshapeI(n);
+  for (size_t i = 0; i < n; ++i)
+    for (const auto qp : vol_qp_data.QuadraturePointIndices())
+    {
+      IntV_shapeI[i] += vol_qp_data.ShapeValue(i, qp) * vol_qp_data.JxW(qp);
+      IntV_gradshapeI[i] += vol_qp_data.ShapeGrad(i, qp) * vol_qp_data.JxW(qp);
+    }
+
+  //======================================== Surface integrals
+  const size_t num_faces = face_node_mappings_.size();
+  std::vector<MatDbl>  IntS_shapeI_shapeJ(num_faces, MatDbl(n, VecDbl(n, 0.0)));
+  std::vector<VecDbl>  IntS_shapeI(num_faces, VecDbl(n, 0.0));
+  std::vector<MatVec3> IntS_shapeI_gradshapeJ(num_faces, MatVec3(n, VecVec3(n)));
+
+  for (size_t f = 0; f < num_faces; ++f)
+  {
+    finite_element::FaceQuadraturePointData face_qp_data;
+    InitializeFaceQuadraturePointData(f, face_qp_data);
+
+    for (const int i : face_node_mappings_[f])
+    {
+      for (const auto qp : face_qp_data.QuadraturePointIndices())
+      {
+        const double shape_i_JxW =
+          face_qp_data.ShapeValue(i, qp) * face_qp_data.JxW(qp);
+
+        IntS_shapeI[f][i] += shape_i_JxW;
+        for (const int j : face_node_mappings_[f])
+          IntS_shapeI_shapeJ[f][i][j] +=
+            shape_i_JxW * face_qp_data.ShapeValue(j, qp);
+        for (size_t j = 0; j < n; ++j)
+          IntS_shapeI_gradshapeJ[f][i][j] +=
+            shape_i_JxW * face_qp_data.ShapeGrad(j, qp);
+      }//for qp
+    }//for face node i
+  }//for f
+
+  ui_data.Initialize(IntV_gradshapeI_gradshapeJ,
+                     IntV_shapeI_gradshapeJ,
+                     IntV_shapeI_shapeJ,
+                     IntV_shapeI,
+                     IntV_gradshapeI,
+                     IntS_shapeI_shapeJ,
+                     IntS_shapeI,
+                     IntS_shapeI_gradshapeJ,
+                     face_node_mappings_,
+                     num_nodes_);
+}
@@ -0,0 +1,148 @@
+#include "lagrange_q2.h"
+
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+
+//###################################################################
+/**Initializes the volume quadrature point data, on the tensor product
+ * of the line quadrature.*/
+void chi_math::LagrangeQ2MappingFE::InitializeVolumeQuadraturePointData(
+  chi_math::finite_element::InternalQuadraturePointData& internal_data) const
+{
+  const size_t nq = line_quadrature_.qpoints_.size();
+  size_t num_qpoints = 1;
+  for (unsigned int d = 0; d < dimension_; ++d) num_qpoints *= nq;
+
+  std::vector<unsigned int> V_quadrature_point_indices(num_qpoints);
+  VecVec3                   V_qpoints_xyz(num_qpoints);
+  std::vector<VecDbl>       V_shape_value(num_nodes_, VecDbl(num_qpoints));
+  std::vector<VecVec3>      V_shape_grad(num_nodes_, VecVec3(num_qpoints));
+  VecDbl                    V_JxW(num_qpoints);
+
+  for (size_t qp = 0; qp < num_qpoints; ++qp)
+  {
+    //=================================== Reference point and weight
+    std::array<size_t, 3> q1d = {0, 0, 0};
+    chi_mesh::Vector3 xi;
+    double weight = 1.0;
+    for (unsigned int d = 0, q = qp; d < dimension_; ++d, q /= nq)
+    {
+      q1d[d] = q % nq;
+      xi(d) = line_quadrature_.qpoints_[q1d[d]].x;
+      weight *= line_quadrature_.weights_[q1d[d]];
+    }
+
+    auto J = Jacobian(xi);
+    auto JTinv = J.Inverse().Transpose();
+
+    V_quadrature_point_indices[qp] = static_cast<unsigned int>(qp);
+    V_qpoints_xyz[qp] = MapToPhysical(xi);
+    V_JxW[qp] = J.Det() * weight;
+
+    //=================================== Shape functions from the 1D tables
+    for (size_t i = 0; i < num_nodes_; ++i)
+    {
+      std::array<unsigned int, 3> a = {0, 0, 0};
+      for (unsigned int d = 0, n = i; d < dimension_; ++d, n /= 3)
+        a[d] = n % 3;
+
+      double value = 1.0;
+      chi_mesh::Vector3 ref_grad;
+      for (unsigned int d = 0; d < dimension_; ++d)
+        value *= basis_[q1d[d]][a[d]];
+      for (unsigned int p = 0; p < dimension_; ++p)
+      {
+        double grad_p = 1.0;
+        for (unsigned int d = 0; d < dimension_; ++d)
+          grad_p *= d == p ? basis_derivatives_[q1d[d]][a[d]]
+                           : basis_[q1d[d]][a[d]];
+        ref_grad(p) = grad_p;
+      }
+
+      V_shape_value[i][qp] = value;
+      V_shape_grad[i][qp] = JTinv * ref_grad;
+    }//for i
+  }//for qp
+
+  internal_data.InitializeData(V_quadrature_point_indices,
+                               V_qpoints_xyz,
+                               V_shape_value,
+                               V_shape_grad,
+                               V_JxW,
+                               face_node_mappings_,
+                               num_nodes_);
+}
+
+//###################################################################
+/**Initializes the quadrature point data of a face, on the tensor product
+ * of the line quadrature over its reference plane.*/
+void chi_math::LagrangeQ2MappingFE::InitializeFaceQuadraturePointData(
+  unsigned int face,
+  chi_math::finite_element::FaceQuadraturePointData& faces_qp_data) const
+{
+  const auto [plane_dim, plane_value] = face_planes_.at(face);
+  const auto& normal = cell_.faces_[face].normal_;
+
+  //=================================== Reference dimensions along the face
+  std::vector<unsigned int> face_dims;
+  for (unsigned int d = 0; d < dimension_; ++d)
+    if (d != plane_dim) face_dims.push_back(d);
+
+  const size_t nq = line_quadrature_.qpoints_.size();
+  const size_t num_qpoints = face_dims.size() == 1 ? nq : nq * nq;
+
+  std::vector<unsigned int> F_quadrature_point_indices(num_qpoints);
+  VecVec3                   F_qpoints_xyz(num_qpoints);
+  std::vector<VecDbl>       F_shape_value(num_nodes_, VecDbl(num_qpoints));
+  std::vector<VecVec3>      F_shape_grad(num_nodes_, VecVec3(num_qpoints));
+  VecDbl                    F_JxW(num_qpoints);
+  VecVec3                   F_normals(num_qpoints, normal);
+
+  for (size_t qp = 0; qp < num_qpoints; ++qp)
+  {
+    chi_mesh::Vector3 xi;
+    xi(plane_dim) = static_cast<double>(plane_value);
+    double weight = 1.0;
+    size_t q = qp;
+    for (const unsigned int d : face_dims)
+    {
+      xi(d) = line_quadrature_.qpoints_[q % nq].x;
+      weight *= line_quadrature_.weights_[q % nq];
+      q /= nq;
+    }
+
+    auto J = Jacobian(xi);
+    auto JTinv = J.Inverse().Transpose();
+
+    //=================================== Surface Jacobian
+    chi_mesh::Vector3 tangent0(J.GetIJ(0, face_dims[0]),
+                               J.GetIJ(1, face_dims[0]),
+                               J.GetIJ(2, face_dims[0]));
+    double surface_detJ = tangent0.Norm();
+    if (face_dims.size() == 2)
+    {
+      const chi_mesh::Vector3 tangent1(J.GetIJ(0, face_dims[1]),
+                                       J.GetIJ(1, face_dims[1]),
+                                       J.GetIJ(2, face_dims[1]));
+      surface_detJ = tangent0.Cross(tangent1).Norm();
+    }
+
+    F_quadrature_point_indices[qp] = static_cast<unsigned int>(qp);
+    F_qpoints_xyz[qp] = MapToPhysical(xi);
+    F_JxW[qp] = surface_detJ * weight;
+
+    for (size_t i = 0; i < num_nodes_; ++i)
+    {
+      F_shape_value[i][qp] = ReferenceShapeValue(i, xi);
+      F_shape_grad[i][qp] = JTinv * ReferenceShapeGrad(i, xi);
+    }
+  }//for qp
+
+  faces_qp_data.InitializeData(F_quadrature_point_indices,
+                               F_qpoints_xyz,
+                               F_shape_value,
+                               F_shape_grad,
+                               F_JxW,
+                               F_normals,
+                               face_node_mappings_,
+                               face_node_mappings_[face].size());
+}
@@ -4,6 +4,8 @@
 
 #include "math/SpatialDiscretization/FiniteElement/finite_element.h"
 
+#include "utils/chi_memory_accounting.h"
+
 #include "chi_runtime.h"
 #include "chi_log.h"
 
@@ -12,6 +14,13 @@ std::vector<chi_mesh::Vector3> chi_math::CellMappingFE_PWL::GetNodeLocations() c
   return node_locations_;
 }
 
+size_t chi_math::CellMappingFE_PWL::GetMemoryUsage() const
+{
+  return CellMapping::GetMemoryUsage() +
+         sizeof(CellMappingFE_PWL) - sizeof(CellMapping) +
+         chi::VectorMemoryUsage(node_locations_);
+}
+
 /** This section just determines a mapping of face dofs
 to cell dofs. This is pretty simple since we can
 just loop over each face dof then subsequently
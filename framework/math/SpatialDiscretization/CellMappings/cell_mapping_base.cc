@@ -6,6 +6,8 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include "utils/chi_memory_accounting.h"
+
 chi_math::CellMapping::
   CellMapping(const chi_mesh::MeshContinuum& in_grid,
               const chi_mesh::Cell& in_cell,
@@ -120,6 +122,12 @@ int chi_math::CellMapping::
   }
 }
 
+size_t chi_math::CellMapping::GetMemoryUsage() const
+{
+  return sizeof(CellMapping) + chi::VectorMemoryUsage(areas_) +
+         chi::VectorMemoryUsage(face_node_mappings_);
+}
+
 void
 chi_math::CellMapping::
   InitializeAllQuadraturePointData(
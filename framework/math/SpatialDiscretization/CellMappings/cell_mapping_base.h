@@ -77,6 +77,10 @@ public:
 
   int MapFaceNode(size_t face_index, size_t face_node_index) const;
 
+  /**Returns the number of bytes held by the mapping. Derived mappings add
+   * the storage they hold.*/
+  virtual size_t GetMemoryUsage() const;
+
   //02 ShapeFuncs
   virtual double ShapeValue(int i, const chi_mesh::Vector3& xyz) const = 0;
 
@@ -0,0 +1,95 @@
+#include "lean_cell_mapping.h"
+
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+
+#include "mesh/Cell/cell.h"
+
+//###################################################################
+/**The volume and areas are copied from the full mapping, hence the
+ * volume-area function is a no-op.*/
+chi_math::LeanCellMapping::
+  LeanCellMapping(const chi_mesh::MeshContinuum& grid,
+                  const chi_mesh::Cell& cell,
+                  const CellMapping& full_mapping,
+                  const FullMappingFactory& full_mapping_factory)
+  : CellMapping(grid, cell, full_mapping.NumNodes(),
+                CopyFaceNodeMappings(cell, full_mapping),
+                [](const chi_mesh::MeshContinuum&, const chi_mesh::Cell&,
+                   double&, std::vector<double>&){}),
+    full_mapping_factory_(full_mapping_factory)
+{
+  volume_ = full_mapping.CellVolume();
+  areas_.reserve(cell.faces_.size());
+  for (size_t f = 0; f < cell.faces_.size(); ++f)
+    areas_.push_back(full_mapping.FaceArea(f));
+}
+
+std::vector<std::vector<int>> chi_math::LeanCellMapping::
+  CopyFaceNodeMappings(const chi_mesh::Cell& cell,
+                       const CellMapping& full_mapping)
+{
+  std::vector<std::vector<int>> face_node_mappings(cell.faces_.size());
+  for (size_t f = 0; f < cell.faces_.size(); ++f)
+  {
+    const size_t num_face_nodes = full_mapping.NumFaceNodes(f);
+    face_node_mappings[f].reserve(num_face_nodes);
+    for (size_t fi = 0; fi < num_face_nodes; ++fi)
+      face_node_mappings[f].push_back(full_mapping.MapFaceNode(f, fi));
+  }
+  return face_node_mappings;
+}
+
+//###################################################################
+double chi_math::LeanCellMapping::
+  ShapeValue(int i, const chi_mesh::Vector3& xyz) const
+{
+  return MakeFullMapping()->ShapeValue(i, xyz);
+}
+
+void chi_math::LeanCellMapping::
+  ShapeValues(const chi_mesh::Vector3& xyz,
+              std::vector<double>& shape_values) const
+{
+  MakeFullMapping()->ShapeValues(xyz, shape_values);
+}
+
+chi_mesh::Vector3 chi_math::LeanCellMapping::
+  GradShapeValue(int i, const chi_mesh::Vector3& xyz) const
+{
+  return MakeFullMapping()->GradShapeValue(i, xyz);
+}
+
+void chi_math::LeanCellMapping::
+  GradShapeValues(const chi_mesh::Vector3& xyz,
+                  std::vector<chi_mesh::Vector3>& gradshape_values) const
+{
+  MakeFullMapping()->GradShapeValues(xyz, gradshape_values);
+}
+
+std::vector<chi_mesh::Vector3> chi_math::LeanCellMapping::
+  GetNodeLocations() const
+{
+  return MakeFullMapping()->GetNodeLocations();
+}
+
+//###################################################################
+void chi_math::LeanCellMapping::
+  ComputeUnitIntegrals(finite_element::UnitIntegralData& ui_data) const
+{
+  MakeFullMapping()->ComputeUnitIntegrals(ui_data);
+}
+
+void chi_math::LeanCellMapping::
+  InitializeVolumeQuadraturePointData(
+    finite_element::InternalQuadraturePointData& internal_data) const
+{
+  MakeFullMapping()->InitializeVolumeQuadraturePointData(internal_data);
+}
+
+void chi_math::LeanCellMapping::
+  InitializeFaceQuadraturePointData(
+    unsigned int face,
+    finite_element::FaceQuadraturePointData& faces_qp_data) const
+{
+  MakeFullMapping()->InitializeFaceQuadraturePointData(face, faces_qp_data);
+}
@@ -0,0 +1,75 @@
+#ifndef CHITECH_LEAN_CELL_MAPPING_H
+#define CHITECH_LEAN_CELL_MAPPING_H
+
+#include "cell_mapping_base.h"
+
+namespace chi_math
+{
+//################################################################### Class def
+/**Cell mapping that keeps only the node count, the face node mappings and
+ * the volume and face areas of a cell, i.e., what the sweeps need. The
+ * shape functions and the quadrature point data are computed on demand by
+ * a full mapping made by a factory, which is owned by the discretization
+ * and must outlive this mapping.
+ *
+ * Every shape function evaluation makes a full mapping, hence code that
+ * evaluates many points of a cell should call MakeFullMapping once
+ * instead.*/
+class LeanCellMapping : public CellMapping
+{
+public:
+  typedef std::function<std::unique_ptr<CellMapping>(const chi_mesh::Cell&)>
+    FullMappingFactory;
+
+private:
+  const FullMappingFactory& full_mapping_factory_;
+
+public:
+  /**Keeps the lean data of `full_mapping`, a mapping of `cell`, made by
+   * `full_mapping_factory`.*/
+  LeanCellMapping(const chi_mesh::MeshContinuum& grid,
+                  const chi_mesh::Cell& cell,
+                  const CellMapping& full_mapping,
+                  const FullMappingFactory& full_mapping_factory);
+
+  /**Makes the full mapping of the cell.*/
+  std::unique_ptr<CellMapping> MakeFullMapping() const
+  {
+    return full_mapping_factory_(cell_);
+  }
+
+  //02 ShapeFuncs
+  double ShapeValue(int i, const chi_mesh::Vector3& xyz) const override;
+
+  void ShapeValues(const chi_mesh::Vector3& xyz,
+                   std::vector<double>& shape_values) const override;
+
+  chi_mesh::Vector3
+  GradShapeValue(int i, const chi_mesh::Vector3& xyz) const override;
+
+  void GradShapeValues(
+    const chi_mesh::Vector3& xyz,
+    std::vector<chi_mesh::Vector3>& gradshape_values) const override;
+
+  std::vector<chi_mesh::Vector3> GetNodeLocations() const override;
+
+  //03 Quadrature
+  void ComputeUnitIntegrals(
+    finite_element::UnitIntegralData& ui_data) const override;
+
+  void InitializeVolumeQuadraturePointData(
+    finite_element::InternalQuadraturePointData& internal_data)
+    const override;
+
+  void InitializeFaceQuadraturePointData(
+    unsigned int face,
+    finite_element::FaceQuadraturePointData& faces_qp_data) const override;
+
+private:
+  static std::vector<std::vector<int>>
+  CopyFaceNodeMappings(const chi_mesh::Cell& cell,
+                       const CellMapping& full_mapping);
+};
+}//namespace chi_math
+
+#endif //CHITECH_LEAN_CELL_MAPPING_H
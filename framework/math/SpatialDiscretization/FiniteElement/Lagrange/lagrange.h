@@ -0,0 +1,104 @@
+#ifndef SPATIAL_DISCRETIZATION_LAGRANGED_H
+#define SPATIAL_DISCRETIZATION_LAGRANGED_H
+
+#include "math/SpatialDiscretization/FiniteElement/spatial_discretization_FE.h"
+
+#include "math/Quadratures/quadrature_line.h"
+
+//######################################################### Class def
+namespace chi_math
+{
+/**Discontinuous Galerkin Finite Element Method with second order (Q2)
+ * Lagrange basis functions on quadrilaterals and hexahedra. Compared to
+ * PWLD each cell carries 9 (2D) or 27 (3D) nodes instead of 4 or 8, such
+ * that a given accuracy is reached with far fewer cells. The cell
+ * mappings compute the unit integrals with sum-factorized tensor-product
+ * kernels.
+ *
+ * Only Cartesian coordinates are supported. The volume quadrature is the
+ * tensor product of a Gauss-Legendre line quadrature of at least the
+ * fifth order, i.e., three points per dimension, integrating the mass
+ * matrices of parallelograms and parallelepipeds exactly.*/
+class SpatialDiscretization_LagrangeD : public SpatialDiscretization_FE
+{
+protected:
+  QuadratureLine line_quad_order_arbitrary_;
+
+  std::vector<int64_t> cell_local_block_address_;
+  std::map<uint64_t, int64_t> neighbor_cell_block_address_;
+
+private:
+  //00
+  explicit
+  SpatialDiscretization_LagrangeD(const chi_mesh::MeshContinuum& in_grid,
+                                  finite_element::SetupFlags setup_flags,
+                                  QuadratureOrder qorder);
+
+public:
+  //prevent anything else other than a shared pointer
+  static
+  std::shared_ptr<SpatialDiscretization_LagrangeD>
+  New(const chi_mesh::MeshContinuum& in_grid,
+      finite_element::SetupFlags setup_flags = finite_element::NO_FLAGS_SET,
+      QuadratureOrder qorder = QuadratureOrder::FIFTH);
+
+protected:
+  //01
+  void CreateCellMappings();
+  void PreComputeCellSDValues();
+
+  //02
+  void OrderNodes();
+
+public:
+  //03
+  void BuildSparsityPattern(std::vector<int64_t>& nodal_nnz_in_diag,
+                            std::vector<int64_t>& nodal_nnz_off_diag,
+                            const UnknownManager& unknown_manager) const override;
+
+  //04
+  int64_t MapDOF(const chi_mesh::Cell& cell,
+                 unsigned int node,
+                 const UnknownManager& unknown_manager,
+                 unsigned int unknown_id,
+                 unsigned int component) const override;
+
+  int64_t MapDOFLocal(const chi_mesh::Cell& cell,
+                      unsigned int node,
+                      const UnknownManager& unknown_manager,
+                      unsigned int unknown_id,
+                      unsigned int component) const override;
+
+  int64_t MapDOF(const chi_mesh::Cell& cell, unsigned int node) const override
+  { return MapDOF(cell,node,UNITARY_UNKNOWN_MANAGER,0,0); }
+
+  int64_t MapDOFLocal(const chi_mesh::Cell& cell, unsigned int node) const override
+  { return MapDOFLocal(cell,node,UNITARY_UNKNOWN_MANAGER,0,0); }
+
+  //05
+  size_t GetNumLocalDOFs(const UnknownManager& unknown_manager) const override;
+  size_t GetNumGlobalDOFs(const UnknownManager& unknown_manager) const override;
+  size_t GetNumGhostDOFs(const UnknownManager& unknown_manager) const override;
+
+  std::vector<int64_t>
+  GetGhostDOFIndices(const UnknownManager& unknown_manager) const override;
+
+  size_t GetCellNumNodes(const chi_mesh::Cell& cell) const override;
+
+  std::vector<chi_mesh::Vector3>
+  GetCellNodeLocations(const chi_mesh::Cell& cell) const override;
+
+  //FE-utils
+  const finite_element::UnitIntegralData&
+  GetUnitIntegrals(const chi_mesh::Cell& cell) override;
+
+  const finite_element::InternalQuadraturePointData&
+  GetQPData_Volumetric(const chi_mesh::Cell& cell) override;
+
+  const finite_element::FaceQuadraturePointData&
+  GetQPData_Surface(const chi_mesh::Cell& cell,
+                    unsigned int face_index) override;
+};
+}
+
+#endif //SPATIAL_DISCRETIZATION_LAGRANGED_H
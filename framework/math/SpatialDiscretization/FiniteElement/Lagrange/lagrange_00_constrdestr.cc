@@ -0,0 +1,63 @@
+#include "lagrange.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <algorithm>
+
+// ###################################################################
+/**Constructor.*/
+chi_math::SpatialDiscretization_LagrangeD::SpatialDiscretization_LagrangeD(
+  const chi_mesh::MeshContinuum& in_grid,
+  chi_math::finite_element::SetupFlags setup_flags,
+  chi_math::QuadratureOrder qorder)
+  : SpatialDiscretization_FE(in_grid,
+                             CoordinateSystemType::CARTESIAN,
+                             SDMType::LAGRANGE_DISCONTINUOUS,
+                             setup_flags,
+                             qorder),
+    line_quad_order_arbitrary_(std::max(qorder, QuadratureOrder::FIFTH))
+{
+  CreateCellMappings();
+  if (setup_flags != chi_math::finite_element::NO_FLAGS_SET)
+    PreComputeCellSDValues();
+  OrderNodes();
+}
+
+// ###################################################################
+/**Construct a shared object using the protected constructor.*/
+std::shared_ptr<chi_math::SpatialDiscretization_LagrangeD>
+chi_math::SpatialDiscretization_LagrangeD::New(
+  const chi_mesh::MeshContinuum& in_grid,
+  finite_element::SetupFlags setup_flags /*=finite_element::NO_FLAGS_SET*/,
+  QuadratureOrder qorder /*=QuadratureOrder::FIFTH*/)
+{
+  const auto LAGD = SpatialDiscretizationType::LAGRANGE_DISCONTINUOUS;
+  // First try to find an existing spatial discretization that matches the
+  // one requested.
+  for (auto& sdm : Chi::sdm_stack)
+    if (sdm->Type() == LAGD and
+        std::addressof(sdm->Grid()) == std::addressof(in_grid))
+    {
+      auto fe_ptr = std::dynamic_pointer_cast<SpatialDiscretization_FE>(sdm);
+
+      ChiLogicalErrorIf(not fe_ptr, "Casting failure to FE");
+
+      if (fe_ptr->GetSetupFlags() != setup_flags) break;
+      if (fe_ptr->GetQuadratureOrder() != qorder) break;
+
+      auto sdm_ptr =
+        std::dynamic_pointer_cast<SpatialDiscretization_LagrangeD>(fe_ptr);
+
+      ChiLogicalErrorIf(not sdm_ptr, "Casting failure");
+
+      return sdm_ptr;
+    }
+
+  auto new_sdm = std::shared_ptr<SpatialDiscretization_LagrangeD>(
+    new SpatialDiscretization_LagrangeD(in_grid, setup_flags, qorder));
+
+  Chi::sdm_stack.push_back(new_sdm);
+
+  return new_sdm;
+}
@@ -0,0 +1,90 @@
+#include "lagrange.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "math/SpatialDiscretization/CellMappings/FE_Lagrange/lagrange_q2.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "utils/chi_timer.h"
+
+//###################################################################
+/**Creates a Q2 Lagrange mapping for each local and ghost cell.*/
+void chi_math::SpatialDiscretization_LagrangeD::CreateCellMappings()
+{
+  cell_mapping_factory_ = [this](const chi_mesh::Cell& cell)
+  {
+    return std::unique_ptr<CellMapping>(std::make_unique<LagrangeQ2MappingFE>(
+      cell, ref_grid_, line_quad_order_arbitrary_));
+  };
+
+  for (const auto& cell : ref_grid_.local_cells)
+    cell_mappings_.push_back(cell_mapping_factory_(cell));
+
+  for (uint64_t ghost_id : ref_grid_.cells.GetGhostGlobalIDs())
+    nb_cell_mappings_.insert(std::make_pair(
+      ghost_id, cell_mapping_factory_(ref_grid_.cells[ghost_id])));
+}
+
+//###################################################################
+/**Precomputes the unit integrals and/or quadrature point data of the
+ * local and ghost cells, as requested by the setup flags.*/
+void chi_math::SpatialDiscretization_LagrangeD::PreComputeCellSDValues()
+{
+  using namespace chi_math::finite_element;
+  const auto ghost_ids = ref_grid_.cells.GetGhostGlobalIDs();
+
+  //============================================= Unit integrals
+  if (setup_flags_ & SetupFlags::COMPUTE_UNIT_INTEGRALS)
+  {
+    Chi::log.Log() << Chi::program_timer.GetTimeString()
+                   << " Computing unit integrals.";
+    fe_unit_integrals_.reserve(ref_grid_.local_cells.size());
+    for (const auto& cell : ref_grid_.local_cells)
+    {
+      UIData ui_data;
+      GetCellMapping(cell).ComputeUnitIntegrals(ui_data);
+      fe_unit_integrals_.push_back(std::move(ui_data));
+    }
+
+    for (uint64_t ghost_id : ghost_ids)
+    {
+      UIData ui_data;
+      GetCellMapping(ref_grid_.cells[ghost_id]).ComputeUnitIntegrals(ui_data);
+      nb_fe_unit_integrals_.insert(std::make_pair(ghost_id, std::move(ui_data)));
+    }
+
+    integral_data_initialized_ = true;
+    nb_integral_data_initialized_ = true;
+  }
+
+  //============================================= Quadrature data
+  if (setup_flags_ & SetupFlags::COMPUTE_QP_DATA)
+  {
+    Chi::log.Log() << Chi::program_timer.GetTimeString()
+                   << " Computing quadrature data.";
+    fe_vol_qp_data_.reserve(ref_grid_.local_cells.size());
+    fe_srf_qp_data_.reserve(ref_grid_.local_cells.size());
+    for (const auto& cell : ref_grid_.local_cells)
+    {
+      fe_vol_qp_data_.emplace_back();
+      fe_srf_qp_data_.emplace_back();
+      GetCellMapping(cell).InitializeAllQuadraturePointData(
+        fe_vol_qp_data_.back(), fe_srf_qp_data_.back());
+    }
+
+    for (uint64_t ghost_id : ghost_ids)
+    {
+      QPDataVol qp_data_vol;
+      std::vector<QPDataFace> qp_data_srf;
+      GetCellMapping(ref_grid_.cells[ghost_id])
+        .InitializeAllQuadraturePointData(qp_data_vol, qp_data_srf);
+      nb_fe_vol_qp_data_.insert(std::make_pair(ghost_id, std::move(qp_data_vol)));
+      nb_fe_srf_qp_data_.insert(std::make_pair(ghost_id, std::move(qp_data_srf)));
+    }
+
+    qp_data_initialized_ = true;
+    nb_qp_data_initialized_ = true;
+  }
+}
@@ -0,0 +1,98 @@
+#include "lagrange.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "chi_mpi_utils.h"
+
+//###################################################################
+/**Assigns contiguous blocks of DOFs to the local cells, and obtains the
+ * block addresses of the ghost cells from their owners.*/
+void chi_math::SpatialDiscretization_LagrangeD::OrderNodes()
+{
+  const std::string fname = __FUNCTION__;
+
+  //================================================== Get local DOF count
+  //                                                   and set
+  //                                                   cell_local_block_address
+  cell_local_block_address_.assign(ref_grid_.local_cells.size(), 0);
+
+  uint64_t local_node_count = 0;
+  for (const auto& cell : ref_grid_.local_cells)
+  {
+    cell_local_block_address_[cell.local_id_] =
+      static_cast<int64_t>(local_node_count);
+    local_node_count += GetCellMapping(cell).NumNodes();
+  }
+
+  //================================================== Allgather node_counts
+  locJ_block_size_.assign(Chi::mpi.process_count, 0);
+  MPI_Allgather(&local_node_count,           //sendbuf
+                1, MPI_UNSIGNED_LONG_LONG,   //sendcount, sendtype
+                locJ_block_size_.data(),     //recvbuf
+                1, MPI_UNSIGNED_LONG_LONG,   //recvcount, recvtype
+                Chi::mpi.comm);              //comm
+
+  //================================================== Assign local_block_address
+  uint64_t running_block_address = 0;
+  for (int locI = 0; locI < Chi::mpi.process_count; ++locI)
+  {
+    if (locI == Chi::mpi.location_id)
+      local_block_address_ = running_block_address;
+
+    running_block_address += locJ_block_size_[locI];
+  }
+
+  local_base_block_size_ = local_node_count;
+  globl_base_block_size_ = running_block_address;
+
+  //================================================== Query the ghost cell
+  //                                                   block addresses
+  std::map<int, std::vector<uint64_t>> ghost_cell_ids_consolidated;
+  for (uint64_t global_id : ref_grid_.cells.GetGhostGlobalIDs())
+  {
+    const auto& cell = ref_grid_.cells[global_id];
+    ghost_cell_ids_consolidated[static_cast<int>(cell.partition_id_)]
+      .push_back(global_id);
+  }
+
+  const std::map<int, std::vector<uint64_t>> query_ghost_cell_ids_consolidated =
+    chi_mpi_utils::MapAllToAll(ghost_cell_ids_consolidated,
+                               MPI_UNSIGNED_LONG_LONG);
+
+  std::map<int, std::vector<uint64_t>> mapped_ghost_cell_ids_consolidated;
+  for (const auto& [pid, cell_id_list] : query_ghost_cell_ids_consolidated)
+  {
+    std::vector<uint64_t>& map_list = mapped_ghost_cell_ids_consolidated[pid];
+    for (uint64_t cell_global_id : cell_id_list)
+    {
+      const auto& cell = ref_grid_.cells[cell_global_id];
+      map_list.push_back(local_block_address_ +
+                         cell_local_block_address_[cell.local_id_]);
+    }
+  }
+
+  const std::map<int, std::vector<uint64_t>> global_id_mapping =
+    chi_mpi_utils::MapAllToAll(mapped_ghost_cell_ids_consolidated,
+                               MPI_UNSIGNED_LONG_LONG);
+
+  for (const auto& [pid, mapping_list] : global_id_mapping)
+  {
+    const auto& global_id_list = ghost_cell_ids_consolidated.at(pid);
+
+    if (mapping_list.size() != global_id_list.size())
+      throw std::logic_error(fname + ": Ghost cell mapping error.");
+
+    for (size_t k = 0; k < mapping_list.size(); ++k)
+      neighbor_cell_block_address_[global_id_list[k]] =
+        static_cast<int64_t>(mapping_list[k]);
+  }
+
+  Chi::log.LogAllVerbose2()
+    << "Local dof count, start, total "
+    << local_node_count << " "
+    << local_block_address_ << " "
+    << globl_base_block_size_;
+}
@@ -0,0 +1,63 @@
+#include "lagrange.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+//###################################################################
+/**Builds the sparsity pattern for a Discontinuous Finite Element Method.
+ * Each node couples with the nodes of its own cell and of the face
+ * neighbors.*/
+void chi_math::SpatialDiscretization_LagrangeD::
+BuildSparsityPattern(std::vector<int64_t>& nodal_nnz_in_diag,
+                     std::vector<int64_t>& nodal_nnz_off_diag,
+                     const chi_math::UnknownManager& unknown_manager) const
+{
+  //============================================= Nodal connectivity
+  std::vector<int64_t> node_nnz_in_diag(local_base_block_size_, 0);
+  std::vector<int64_t> node_nnz_off_diag(local_base_block_size_, 0);
+
+  for (const auto& cell : ref_grid_.local_cells)
+  {
+    const size_t num_nodes = GetCellMapping(cell).NumNodes();
+
+    int64_t in_diag = static_cast<int64_t>(num_nodes);
+    int64_t off_diag = 0;
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      if (not cell.faces_[f].has_neighbor_) continue;
+
+      const auto& adj_cell = ref_grid_.FaceNeighbor(cell, f);
+      const auto adj_num_nodes =
+        static_cast<int64_t>(GetCellMapping(adj_cell).NumNodes());
+
+      if (ref_grid_.GetFaceNeighborIndex(cell, f).local_id >= 0)
+        in_diag += adj_num_nodes;
+      else
+        off_diag += adj_num_nodes;
+    }
+
+    for (size_t i = 0; i < num_nodes; ++i)
+    {
+      const int64_t ir = cell_local_block_address_[cell.local_id_] +
+                         static_cast<int64_t>(i);
+      node_nnz_in_diag[ir] = in_diag;
+      node_nnz_off_diag[ir] = off_diag;
+    }
+  }//for local cell
+
+  //============================================= Spacing according to unknown
+  //                                              manager
+  const unsigned int N = unknown_manager.GetTotalUnknownStructureSize();
+
+  nodal_nnz_in_diag.assign(local_base_block_size_ * N, 0);
+  nodal_nnz_off_diag.assign(local_base_block_size_ * N, 0);
+
+  const bool nodal =
+    unknown_manager.dof_storage_type_ == chi_math::UnknownStorageType::NODAL;
+  for (size_t i = 0; i < local_base_block_size_; ++i)
+    for (unsigned int j = 0; j < N; ++j)
+    {
+      const size_t ir = nodal ? i * N + j : j * local_base_block_size_ + i;
+      nodal_nnz_in_diag[ir] = node_nnz_in_diag[i];
+      nodal_nnz_off_diag[ir] = node_nnz_off_diag[i];
+    }
+}
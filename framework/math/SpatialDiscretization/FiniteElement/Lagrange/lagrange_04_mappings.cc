@@ -0,0 +1,81 @@
+#include "lagrange.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#define sc_int64 static_cast<int64_t>
+
+//###################################################################
+/**Provides a mapping of cell's DOF from a DFEM perspective.*/
+int64_t chi_math::SpatialDiscretization_LagrangeD::
+MapDOF(const chi_mesh::Cell& cell,
+       const unsigned int node,
+       const chi_math::UnknownManager& unknown_manager,
+       const unsigned int unknown_id,
+       const unsigned int component) const
+{
+  auto storage = unknown_manager.dof_storage_type_;
+
+  size_t num_unknowns = unknown_manager.GetTotalUnknownStructureSize();
+  size_t block_id     = unknown_manager.MapUnknown(unknown_id, component);
+
+  if (cell.partition_id_ == Chi::mpi.location_id)
+  {
+    if (storage == chi_math::UnknownStorageType::BLOCK)
+      return sc_int64(local_block_address_ * num_unknowns) +
+             cell_local_block_address_[cell.local_id_] +
+             sc_int64(local_base_block_size_ * block_id + node);
+    else if (storage == chi_math::UnknownStorageType::NODAL)
+      return sc_int64(local_block_address_ * num_unknowns) +
+             cell_local_block_address_[cell.local_id_] * sc_int64(num_unknowns) +
+             sc_int64(node * num_unknowns + block_id);
+  }
+  else
+  {
+    const auto it = neighbor_cell_block_address_.find(cell.global_id_);
+    ChiLogicalErrorIf(it == neighbor_cell_block_address_.end(),
+                      "Mapping failed for cell with global index " +
+                      std::to_string(cell.global_id_) + " and partition-ID " +
+                      std::to_string(cell.partition_id_) + ".");
+    const int64_t cell_block_address = it->second;
+
+    if (storage == chi_math::UnknownStorageType::BLOCK)
+      return cell_block_address +
+             sc_int64(locJ_block_size_[cell.partition_id_] * block_id + node);
+    else if (storage == chi_math::UnknownStorageType::NODAL)
+      return cell_block_address * sc_int64(num_unknowns) +
+             sc_int64(node * num_unknowns + block_id);
+  }
+
+  return -1;
+}
+
+//###################################################################
+/**Provides a local mapping of cell's DOF from a DFEM perspective. Like for
+ * PWLD, there are no ghost DOFs, hence ghost cells map to their global
+ * DOFs.*/
+int64_t chi_math::SpatialDiscretization_LagrangeD::
+MapDOFLocal(const chi_mesh::Cell& cell,
+            const unsigned int node,
+            const chi_math::UnknownManager& unknown_manager,
+            const unsigned int unknown_id,
+            const unsigned int component) const
+{
+  if (cell.partition_id_ != Chi::mpi.location_id)
+    return MapDOF(cell, node, unknown_manager, unknown_id, component);
+
+  auto storage = unknown_manager.dof_storage_type_;
+
+  size_t num_unknowns = unknown_manager.GetTotalUnknownStructureSize();
+  size_t block_id     = unknown_manager.MapUnknown(unknown_id, component);
+
+  if (storage == chi_math::UnknownStorageType::BLOCK)
+    return cell_local_block_address_[cell.local_id_] +
+           sc_int64(local_base_block_size_ * block_id + node);
+  else if (storage == chi_math::UnknownStorageType::NODAL)
+    return cell_local_block_address_[cell.local_id_] * sc_int64(num_unknowns) +
+           sc_int64(node * num_unknowns + block_id);
+
+  return -1;
+}
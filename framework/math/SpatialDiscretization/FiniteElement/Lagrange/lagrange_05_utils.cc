@@ -0,0 +1,112 @@
+#include "lagrange.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+//###################################################################
+/**Get the number of local degrees-of-freedom.*/
+size_t chi_math::SpatialDiscretization_LagrangeD::
+GetNumLocalDOFs(const chi_math::UnknownManager& unknown_manager) const
+{
+  return local_base_block_size_ *
+         unknown_manager.GetTotalUnknownStructureSize();
+}
+
+//###################################################################
+/**Get the number of global degrees-of-freedom.*/
+size_t chi_math::SpatialDiscretization_LagrangeD::
+GetNumGlobalDOFs(const chi_math::UnknownManager& unknown_manager) const
+{
+  return globl_base_block_size_ *
+         unknown_manager.GetTotalUnknownStructureSize();
+}
+
+//###################################################################
+/**Get the number of ghost degrees-of-freedom.*/
+size_t chi_math::SpatialDiscretization_LagrangeD::
+GetNumGhostDOFs(const UnknownManager& unknown_manager) const
+{
+  return 0;
+}
+
+//###################################################################
+/**Returns the ghost DOF indices.*/
+std::vector<int64_t> chi_math::SpatialDiscretization_LagrangeD::
+GetGhostDOFIndices(const UnknownManager& unknown_manager) const
+{
+  return {};
+}
+
+//###################################################################
+/**Returns the number of nodes of a cell, 9 or 27.*/
+size_t chi_math::SpatialDiscretization_LagrangeD::
+  GetCellNumNodes(const chi_mesh::Cell& cell) const
+{
+  return GetCellMapping(cell).NumNodes();
+}
+
+//###################################################################
+/**Returns the node locations of a cell.*/
+std::vector<chi_mesh::Vector3> chi_math::SpatialDiscretization_LagrangeD::
+  GetCellNodeLocations(const chi_mesh::Cell& cell) const
+{
+  return GetCellMapping(cell).GetNodeLocations();
+}
+
+//###################################################################
+/**Returns the unit integrals of a local or ghost cell, computing them in
+ * scratch storage when not precomputed.*/
+const chi_math::finite_element::UnitIntegralData&
+chi_math::SpatialDiscretization_LagrangeD::
+  GetUnitIntegrals(const chi_mesh::Cell& cell)
+{
+  if (ref_grid_.IsCellLocal(cell.global_id_))
+  {
+    if (integral_data_initialized_)
+      return fe_unit_integrals_.at(cell.local_id_);
+  }
+  else if (nb_integral_data_initialized_)
+    return nb_fe_unit_integrals_.at(cell.global_id_);
+
+  scratch_intgl_data_.Reset();
+  GetCellMapping(cell).ComputeUnitIntegrals(scratch_intgl_data_);
+  return scratch_intgl_data_;
+}
+
+//###################################################################
+/**Returns the volume quadrature point data of a local or ghost cell.*/
+const chi_math::finite_element::InternalQuadraturePointData&
+chi_math::SpatialDiscretization_LagrangeD::
+  GetQPData_Volumetric(const chi_mesh::Cell& cell)
+{
+  if (ref_grid_.IsCellLocal(cell.global_id_))
+  {
+    if (qp_data_initialized_)
+      return fe_vol_qp_data_.at(cell.local_id_);
+  }
+  else if (nb_qp_data_initialized_)
+    return nb_fe_vol_qp_data_.at(cell.global_id_);
+
+  GetCellMapping(cell).InitializeVolumeQuadraturePointData(scratch_vol_qp_data_);
+  return scratch_vol_qp_data_;
+}
+
+//###################################################################
+/**Returns the surface quadrature point data of a face of a local or ghost
+ * cell.*/
+const chi_math::finite_element::FaceQuadraturePointData&
+chi_math::SpatialDiscretization_LagrangeD::
+  GetQPData_Surface(const chi_mesh::Cell& cell,
+                    const unsigned int face)
+{
+  if (ref_grid_.IsCellLocal(cell.global_id_))
+  {
+    if (qp_data_initialized_)
+      return fe_srf_qp_data_.at(cell.local_id_).at(face);
+  }
+  else if (nb_qp_data_initialized_)
+    return nb_fe_srf_qp_data_.at(cell.global_id_).at(face);
+
+  GetCellMapping(cell).InitializeFaceQuadraturePointData(face,
+                                                        scratch_face_qp_data_);
+  return scratch_face_qp_data_;
+}
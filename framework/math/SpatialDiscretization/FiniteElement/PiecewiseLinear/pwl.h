@@ -79,6 +79,8 @@ namespace chi_math
     std::vector<int64_t>
     GetGhostDOFIndices(const UnknownManager& unknown_manager) const override;
 
+    size_t GetMemoryUsage() const override;
+
     //Inherited from PWLBase:
     //GetCellNumNodes
     //GetCellNodeLocations
@@ -20,7 +20,7 @@ chi_math::SpatialDiscretization_PWLD::SpatialDiscretization_PWLD(
                                   SDMType::PIECEWISE_LINEAR_DISCONTINUOUS,
                                   in_cs_type)
 {
-  if (setup_flags == chi_math::finite_element::COMPUTE_UNIT_INTEGRALS)
+  if (setup_flags & chi_math::finite_element::COMPUTE_UNIT_INTEGRALS)
   {
     int qorder_min;
     switch (coord_sys_type_)
@@ -35,11 +35,11 @@ BuildSparsityPattern(std::vector<int64_t> &nodal_nnz_in_diag,
     }
 
     //==================================== Local adjacent cell connections
-    for (auto& face : cell.faces_)
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
     {
-      if (face.has_neighbor_ and face.IsNeighborLocal(ref_grid_))
+      if (ref_grid_.GetFaceNeighborIndex(cell, f).local_id >= 0)
       {
-        const auto& adj_cell = ref_grid_.cells[face.neighbor_id_];
+        const auto& adj_cell = ref_grid_.FaceNeighbor(cell, f);
         const auto& adj_cell_mapping = GetCellMapping(adj_cell);
 
         for (int i=0; i<num_nodes; ++i)
@@ -60,11 +60,11 @@ BuildSparsityPattern(std::vector<int64_t> &nodal_nnz_in_diag,
     const auto& cell_mapping = GetCellMapping(cell);
 
     //==================================== Local adjacent cell connections
-    for (auto& face : cell.faces_)
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
     {
-      if (face.has_neighbor_ and (not face.IsNeighborLocal(ref_grid_)))
+      if (ref_grid_.GetFaceNeighborIndex(cell, f).ghost_index >= 0)
       {
-        const auto& adj_cell = ref_grid_.cells[face.neighbor_id_];
+        const auto& adj_cell = ref_grid_.FaceNeighbor(cell, f);
         const auto& adj_cell_mapping = GetCellMapping(adj_cell);
 
         for (int i=0; i < cell_mapping.NumNodes(); ++i)
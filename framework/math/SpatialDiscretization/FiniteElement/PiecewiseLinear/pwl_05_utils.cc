@@ -1,6 +1,7 @@
 #include "pwl.h"
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "utils/chi_memory_accounting.h"
 
 //###################################################################
 /**Get the number of ghost degrees-of-freedom.*/
@@ -18,3 +19,11 @@ GetGhostDOFIndices(const UnknownManager& unknown_manager) const
   return {};
 }
 
+//###################################################################
+/**Adds the block addresses of the cells and their neighbors.*/
+size_t chi_math::SpatialDiscretization_PWLD::GetMemoryUsage() const
+{
+  return SpatialDiscretization_PWLBase::GetMemoryUsage() +
+         chi::VectorMemoryUsage(cell_local_block_address_) +
+         chi::VectorMemoryUsage(neighbor_cell_block_address_);
+}
@@ -2,6 +2,7 @@
 #define SPATIAL_DISCRETIZATION_PWL_BASE_H
 
 #include "math/SpatialDiscretization/FiniteElement/spatial_discretization_FE.h"
+#include "math/SpatialDiscretization/CellMappings/lean_cell_mapping.h"
 
 #include "math/Quadratures/quadrature_line.h"
 #include "math/Quadratures/quadrature_triangle.h"
@@ -19,6 +20,8 @@ namespace chi_math
     QuadratureQuadrilateral quad_quad_order_arbitrary_;
     QuadratureTetrahedron   tet_quad_order_arbitrary_;
 
+    LeanCellMapping::FullMappingFactory full_mapping_factory_;
+
   protected:
     explicit
     SpatialDiscretization_PWLBase(const chi_mesh::MeshContinuum& in_grid,
@@ -34,6 +37,14 @@ namespace chi_math
 
     void CreateCellMappings();
 
+  public:
+    /**Makes the full mapping of a cell, also when the stored mappings are
+     * lean (see SetupFlags::LEAN_CELL_MAPPINGS).*/
+    std::unique_ptr<CellMapping>
+    MakeFullCellMapping(const chi_mesh::Cell& cell) const;
+
+  protected:
+
     //02
     //Child specialized:
     //OrderNodes
@@ -17,10 +17,15 @@ std::invalid_argument((fname) + \
 std::invalid_argument((fname) + \
 ": Unsupported cell type encountered.");
 
-void chi_math::SpatialDiscretization_PWLBase::CreateCellMappings()
+//###################################################################
+/**Makes the full mapping of a cell according to its type and the
+ * coordinate system.*/
+std::unique_ptr<chi_math::CellMapping>
+  chi_math::SpatialDiscretization_PWLBase::
+    MakeFullCellMapping(const chi_mesh::Cell& cell) const
 {
   constexpr std::string_view fname = "chi_math::SpatialDiscretization_PWLBase::"
-                                     "CreateCellMappings";
+                                     "MakeFullCellMapping";
 
   typedef SlabMappingFE_PWL                SlabSlab;
   typedef SlabMappingFE_PWL_Cylindrical    SlabCyli;
@@ -29,72 +34,90 @@ void chi_math::SpatialDiscretization_PWLBase::CreateCellMappings()
   typedef PolygonMappingFE_PWL_Cylindrical PolygonCyli;
   typedef PolyhedronMappingFE_PWL          Polyhedron;
 
-  auto MakeCellMapping = [this, fname](const chi_mesh::Cell& cell)
-  {
-    using namespace std;
-    using namespace chi_math;
-    std::unique_ptr<chi_math::CellMapping> mapping;
+  using namespace std;
+  using namespace chi_math;
+  std::unique_ptr<chi_math::CellMapping> mapping;
 
-    switch (cell.Type())
+  switch (cell.Type())
+  {
+    case chi_mesh::CellType::SLAB:
     {
-      case chi_mesh::CellType::SLAB:
-      {
-        const auto& vol_quad = line_quad_order_arbitrary_;
+      const auto& vol_quad = line_quad_order_arbitrary_;
 
-        switch (coord_sys_type_)
-        {
-          case CoordinateSystemType::CARTESIAN:
-            mapping = make_unique<SlabSlab>(cell, ref_grid_, vol_quad);
-            break;
-          case CoordinateSystemType::CYLINDRICAL:
-            mapping = make_unique<SlabCyli>(cell, ref_grid_, vol_quad);
-            break;
-          case CoordinateSystemType::SPHERICAL:
-            mapping = make_unique<SlabSphr>(cell, ref_grid_, vol_quad);
-            break;
-          default:
-            throw InvalidCoordinateSystem(std::string(fname))
-        }
-        break;
-      }
-      case chi_mesh::CellType::POLYGON:
+      switch (coord_sys_type_)
       {
-        const auto& vol_quad = tri_quad_order_arbitrary_;
-        const auto& area_quad = line_quad_order_arbitrary_;
-
-        switch (coord_sys_type_)
-        {
-          case CoordinateSystemType::CARTESIAN:
-            mapping = make_unique<Polygon>(cell, ref_grid_, vol_quad, area_quad);
-            break;
-          case CoordinateSystemType::CYLINDRICAL:
-            mapping = make_unique<PolygonCyli>(cell, ref_grid_, vol_quad, area_quad);
-            break;
-          default:
-            throw InvalidCoordinateSystem(std::string(fname))
-        }
-        break;
+        case CoordinateSystemType::CARTESIAN:
+          mapping = make_unique<SlabSlab>(cell, ref_grid_, vol_quad);
+          break;
+        case CoordinateSystemType::CYLINDRICAL:
+          mapping = make_unique<SlabCyli>(cell, ref_grid_, vol_quad);
+          break;
+        case CoordinateSystemType::SPHERICAL:
+          mapping = make_unique<SlabSphr>(cell, ref_grid_, vol_quad);
+          break;
+        default:
+          throw InvalidCoordinateSystem(std::string(fname))
       }
-      case chi_mesh::CellType::POLYHEDRON:
+      break;
+    }
+    case chi_mesh::CellType::POLYGON:
+    {
+      const auto& vol_quad = tri_quad_order_arbitrary_;
+      const auto& area_quad = line_quad_order_arbitrary_;
+
+      switch (coord_sys_type_)
       {
-        const auto& vol_quad = tet_quad_order_arbitrary_;
-        const auto& area_quad = tri_quad_order_arbitrary_;
+        case CoordinateSystemType::CARTESIAN:
+          mapping = make_unique<Polygon>(cell, ref_grid_, vol_quad, area_quad);
+          break;
+        case CoordinateSystemType::CYLINDRICAL:
+          mapping = make_unique<PolygonCyli>(cell, ref_grid_, vol_quad, area_quad);
+          break;
+        default:
+          throw InvalidCoordinateSystem(std::string(fname))
+      }
+      break;
+    }
+    case chi_mesh::CellType::POLYHEDRON:
+    {
+      const auto& vol_quad = tet_quad_order_arbitrary_;
+      const auto& area_quad = tri_quad_order_arbitrary_;
 
-        switch (coord_sys_type_)
-        {
-          case CoordinateSystemType::CARTESIAN:
-            mapping = make_unique<Polyhedron>(cell, ref_grid_, vol_quad, area_quad);
-            break;
-          default:
-            throw InvalidCoordinateSystem(std::string(fname))
-        }
-        break;
+      switch (coord_sys_type_)
+      {
+        case CoordinateSystemType::CARTESIAN:
+          mapping = make_unique<Polyhedron>(cell, ref_grid_, vol_quad, area_quad);
+          break;
+        default:
+          throw InvalidCoordinateSystem(std::string(fname))
       }
-      default:
-        throw UnsupportedCellType(std::string(fname))
+      break;
     }
+    default:
+      throw UnsupportedCellType(std::string(fname))
+  }
+  return mapping;
+}
+
+//###################################################################
+/**Creates the mappings of the local and ghost cells. With the flag
+ * LEAN_CELL_MAPPINGS, only the lean data of the mappings is kept, the full
+ * mappings being remade on demand.*/
+void chi_math::SpatialDiscretization_PWLBase::CreateCellMappings()
+{
+  const bool lean = setup_flags_ & finite_element::LEAN_CELL_MAPPINGS;
+  full_mapping_factory_ = [this](const chi_mesh::Cell& cell)
+  { return MakeFullCellMapping(cell); };
+
+  auto MakeCellMapping = [this, lean](const chi_mesh::Cell& cell)
+  {
+    std::unique_ptr<CellMapping> mapping = MakeFullCellMapping(cell);
+    if (lean)
+      mapping = std::make_unique<LeanCellMapping>(
+        ref_grid_, cell, *mapping, full_mapping_factory_);
     return mapping;
   };
+  cell_mapping_factory_ = MakeCellMapping;
 
   for (const auto& cell : ref_grid_.local_cells)
     cell_mappings_.push_back(MakeCellMapping(cell));
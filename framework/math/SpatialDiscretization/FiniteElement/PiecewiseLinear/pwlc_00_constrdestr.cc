@@ -18,7 +18,7 @@ chi_math::SpatialDiscretization_PWLC::SpatialDiscretization_PWLC(
                                   SDMType::PIECEWISE_LINEAR_CONTINUOUS,
                                   in_cs_type)
 {
-  if (setup_flags == chi_math::finite_element::COMPUTE_UNIT_INTEGRALS)
+  if (setup_flags & chi_math::finite_element::COMPUTE_UNIT_INTEGRALS)
   {
     int qorder_min;
     switch (coord_sys_type_)
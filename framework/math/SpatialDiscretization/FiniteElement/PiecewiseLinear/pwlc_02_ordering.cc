@@ -4,6 +4,7 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
 #include "chi_mpi.h"
 
 #include "utils/chi_timer.h"
@@ -17,6 +18,10 @@
 void chi_math::SpatialDiscretization_PWLC::OrderNodes()
 {
   const std::string fname = __FUNCTION__;
+  // Node ownership is decided from the ghost cells sharing each node
+  ChiLogicalErrorIf(ref_grid_.HasFaceNeighborGhostsOnly(),
+                    "Continuous discretizations require the vertex ghost "
+                    "layer, the grid only has face neighbor ghosts.");
   //============================================= Build set of local scope nodes
   // ls_node_id = local scope node id
   std::set<uint64_t> ls_node_ids_set;
@@ -13,7 +13,8 @@ namespace chi_math::finite_element
     NO_FLAGS_SET           = 0,
     COMPUTE_CELL_MAPPINGS  = (1 << 0),
     COMPUTE_UNIT_INTEGRALS = (1 << 1),
-    COMPUTE_QP_DATA        = (1 << 2)
+    COMPUTE_QP_DATA        = (1 << 2),
+    LEAN_CELL_MAPPINGS     = (1 << 3) ///< See LeanCellMapping
   };
 
   inline SetupFlags
@@ -89,6 +90,9 @@ namespace chi_math::finite_element
 
     size_t NumNodes() const { return num_nodes_; }
 
+    /**Returns the number of bytes held by the integrals.*/
+    size_t GetMemoryUsage() const;
+
     const MatDbl  & GetIntV_gradShapeI_gradShapeJ() const {return IntV_gradShapeI_gradShapeJ_;}
     const MatVec3 & GetIntV_shapeI_gradshapeJ()     const {return IntV_shapeI_gradshapeJ_    ;}
     const MatDbl  & GetIntV_shapeI_shapeJ()         const {return IntV_shapeI_shapeJ_        ;}
@@ -133,6 +137,9 @@ namespace chi_math::finite_element
       QuadraturePointIndices() const;
     chi_mesh::Vector3
       QPointXYZ(unsigned int qp) const;
+    /**Returns the locations of all the quadrature points, by qp index.*/
+    const VecVec3&
+      QPointsXYZ() const {return qpoints_xyz_;}
     double
       ShapeValue(unsigned int i, unsigned int qp) const;
     chi_mesh::Vector3
@@ -143,6 +150,9 @@ namespace chi_math::finite_element
       FaceDofMapping(size_t face, size_t face_node_index) const;
     size_t
       NumNodes() const;
+
+    /**Returns the number of bytes held by the quadrature point data.*/
+    size_t GetMemoryUsage() const;
   };
 
   //#############################################
@@ -163,6 +173,10 @@ namespace chi_math::finite_element
                         size_t num_nodes);
     chi_mesh::Vector3
       Normal(unsigned int qp) const;
+
+    /**Returns the number of bytes held by the quadrature point data,
+     * including the normals.*/
+    size_t GetMemoryUsage() const;
   };
 }
 
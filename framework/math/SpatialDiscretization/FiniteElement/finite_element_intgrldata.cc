@@ -1,5 +1,7 @@
 #include "finite_element.h"
 
+#include "utils/chi_memory_accounting.h"
+
 namespace chi_math
 {
 namespace finite_element
@@ -114,6 +116,20 @@ namespace finite_element
     value = rowI.at(j);
     return value;
   }
+
+  size_t UnitIntegralData::GetMemoryUsage() const
+  {
+    using chi::VectorMemoryUsage;
+    return VectorMemoryUsage(IntV_gradShapeI_gradShapeJ_) +
+           VectorMemoryUsage(IntV_shapeI_gradshapeJ_) +
+           VectorMemoryUsage(IntV_shapeI_shapeJ_) +
+           VectorMemoryUsage(IntV_shapeI_) +
+           VectorMemoryUsage(IntV_gradshapeI_) +
+           VectorMemoryUsage(IntS_shapeI_shapeJ_) +
+           VectorMemoryUsage(IntS_shapeI_) +
+           VectorMemoryUsage(IntS_shapeI_gradshapeJ_) +
+           VectorMemoryUsage(face_dof_mappings_);
+  }
 }
 }
 
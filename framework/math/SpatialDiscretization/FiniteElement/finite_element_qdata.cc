@@ -1,5 +1,7 @@
 #include "finite_element.h"
 
+#include "utils/chi_memory_accounting.h"
+
 namespace chi_math
 {
   namespace finite_element
@@ -67,6 +69,17 @@ namespace chi_math
       return num_nodes_;
     }
 
+    size_t InternalQuadraturePointData::GetMemoryUsage() const
+    {
+      using chi::VectorMemoryUsage;
+      return VectorMemoryUsage(quadrature_point_indices_) +
+             VectorMemoryUsage(qpoints_xyz_) +
+             VectorMemoryUsage(shape_value_) +
+             VectorMemoryUsage(shape_grad_) +
+             VectorMemoryUsage(JxW_) +
+             VectorMemoryUsage(face_dof_mappings_);
+    }
+
 
 
 
@@ -97,6 +110,12 @@ namespace chi_math
       if (not initialized_) THROW_QP_UNINIT();
       return normals_.at(qp);
     }
+
+    size_t FaceQuadraturePointData::GetMemoryUsage() const
+    {
+      return InternalQuadraturePointData::GetMemoryUsage() +
+             chi::VectorMemoryUsage(normals_);
+    }
   }
 }
 
@@ -1,5 +1,7 @@
 #include "spatial_discretization_FE.h"
 
+#include "utils/chi_memory_accounting.h"
+
 chi_math::finite_element::SetupFlags
 chi_math::SpatialDiscretization_FE::GetSetupFlags() const
 {
@@ -10,4 +12,78 @@ chi_math::QuadratureOrder
   chi_math::SpatialDiscretization_FE::GetQuadratureOrder() const
 {
   return q_order_;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Remakes the mappings of the cells, then recomputes the unit integrals
+ * and quadrature point data of those cells that have them precomputed.*/
+void chi_math::SpatialDiscretization_FE::
+  UpdateCellMappings(const std::vector<uint64_t>& local_cell_ids,
+                     const std::vector<uint64_t>& ghost_global_ids)
+{
+  SpatialDiscretization::UpdateCellMappings(local_cell_ids, ghost_global_ids);
+
+  const auto num_local_ids = static_cast<int64_t>(local_cell_ids.size());
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t k = 0; k < num_local_ids; ++k)
+  {
+    const uint64_t local_id = local_cell_ids[k];
+    const auto& cell_mapping = *cell_mappings_[local_id];
+    if (local_id < fe_unit_integrals_.size())
+    {
+      fe_unit_integrals_[local_id] = UIData();
+      cell_mapping.ComputeUnitIntegrals(fe_unit_integrals_[local_id]);
+    }
+    if (local_id < fe_vol_qp_data_.size())
+    {
+      fe_vol_qp_data_[local_id] = QPDataVol();
+      fe_srf_qp_data_[local_id].clear();
+      cell_mapping.InitializeAllQuadraturePointData(
+        fe_vol_qp_data_[local_id], fe_srf_qp_data_[local_id]);
+    }
+  }
+
+  for (const uint64_t ghost_id : ghost_global_ids)
+  {
+    const auto& cell_mapping = *nb_cell_mappings_.at(ghost_id);
+    if (nb_fe_unit_integrals_.count(ghost_id) > 0)
+    {
+      auto& ui_data = nb_fe_unit_integrals_[ghost_id];
+      ui_data = UIData();
+      cell_mapping.ComputeUnitIntegrals(ui_data);
+    }
+    if (nb_fe_vol_qp_data_.count(ghost_id) > 0)
+    {
+      auto& qp_data_vol = nb_fe_vol_qp_data_[ghost_id];
+      auto& qp_data_srf = nb_fe_srf_qp_data_[ghost_id];
+      qp_data_vol = QPDataVol();
+      qp_data_srf.clear();
+      cell_mapping.InitializeAllQuadraturePointData(qp_data_vol, qp_data_srf);
+    }
+  }
+}
+
+size_t chi_math::SpatialDiscretization_FE::GetMemoryUsage() const
+{
+  size_t num_bytes = SpatialDiscretization::GetMemoryUsage() +
+                     chi::VectorMemoryUsage(fe_unit_integrals_) +
+                     chi::VectorMemoryUsage(fe_vol_qp_data_) +
+                     chi::VectorMemoryUsage(fe_srf_qp_data_);
+  for (const auto& ui_data : fe_unit_integrals_)
+    num_bytes += ui_data.GetMemoryUsage();
+  for (const auto& qp_data : fe_vol_qp_data_)
+    num_bytes += qp_data.GetMemoryUsage();
+  for (const auto& faces_qp_data : fe_srf_qp_data_)
+    for (const auto& qp_data : faces_qp_data)
+      num_bytes += qp_data.GetMemoryUsage();
+
+  for (const auto& [global_id, ui_data] : nb_fe_unit_integrals_)
+    num_bytes += sizeof(UIData) + ui_data.GetMemoryUsage();
+  for (const auto& [global_id, qp_data] : nb_fe_vol_qp_data_)
+    num_bytes += sizeof(QPDataVol) + qp_data.GetMemoryUsage();
+  for (const auto& [global_id, faces_qp_data] : nb_fe_srf_qp_data_)
+    for (const auto& qp_data : faces_qp_data)
+      num_bytes += sizeof(QPDataFace) + qp_data.GetMemoryUsage();
+
+  return num_bytes;
+}
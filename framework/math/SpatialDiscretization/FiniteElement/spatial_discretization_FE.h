@@ -55,6 +55,15 @@ public:
   finite_element::SetupFlags GetSetupFlags() const;
   QuadratureOrder GetQuadratureOrder() const;
 
+  /**Adds the precomputed unit integrals and quadrature point data.*/
+  size_t GetMemoryUsage() const override;
+
+  /**Also recomputes the precomputed unit integrals and quadrature point
+   * data of the cells.*/
+  void UpdateCellMappings(const std::vector<uint64_t>& local_cell_ids,
+                          const std::vector<uint64_t>& ghost_global_ids)
+    override;
+
 public:
   virtual const finite_element::UnitIntegralData&
   GetUnitIntegrals(const chi_mesh::Cell& cell)
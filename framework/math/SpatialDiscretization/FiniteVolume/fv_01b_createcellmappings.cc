@@ -32,6 +32,7 @@ void chi_math::SpatialDiscretization_FV::CreateCellMappings()
     }
     return mapping;
   };
+  cell_mapping_factory_ = MakeCellMapping;
 
   for (const auto& cell : ref_grid_.local_cells)
     cell_mappings_.push_back(MakeCellMapping(cell));
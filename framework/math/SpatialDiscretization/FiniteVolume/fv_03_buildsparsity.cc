@@ -32,13 +32,12 @@ void chi_math::SpatialDiscretization_FV::BuildSparsityPattern(
 
         nodal_nnz_in_diag[i]   += 1;
 
-        for (auto& face : cell.faces_)
+        for (size_t f = 0; f < cell.faces_.size(); ++f)
         {
-          if (not face.has_neighbor_) continue;
-
-          if (face.IsNeighborLocal(ref_grid_))
+          const auto& neighbor = ref_grid_.GetFaceNeighborIndex(cell, f);
+          if (neighbor.local_id >= 0)
             nodal_nnz_in_diag[i] += 1;
-          else
+          else if (neighbor.ghost_index >= 0)
             nodal_nnz_off_diag[i] += 1;
         }
       }//for cell
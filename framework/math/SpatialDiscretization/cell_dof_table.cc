@@ -0,0 +1,74 @@
+#include "cell_dof_table.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+#include "chi_log_exceptions.h"
+
+//###################################################################
+/**Tabulates the DOF indices of all the local cells and, if requested,
+ * of all the ghost cells.*/
+chi_math::CellDOFTable::
+  CellDOFTable(const SpatialDiscretization& sdm,
+               const UnknownManager& unknown_manager,
+               bool with_ghosts/*=false*/) :
+  grid_(sdm.Grid()),
+  location_id_(static_cast<uint64_t>(Chi::mpi.location_id)),
+  num_blocks_(unknown_manager.GetTotalUnknownStructureSize())
+{
+  //============================================= Unknown-component pairs
+  std::vector<std::pair<unsigned int, unsigned int>> blocks(num_blocks_);
+  for (unsigned int u = 0; u < unknown_manager.unknowns_.size(); ++u)
+    for (unsigned int c = 0;
+         c < unknown_manager.unknowns_[u].num_components_; ++c)
+      blocks[unknown_manager.MapUnknown(u, c)] = {u, c};
+
+  auto Tabulate = [&](const chi_mesh::Cell& cell)
+  {
+    const size_t num_nodes = sdm.GetCellNumNodes(cell);
+    for (unsigned int i = 0; i < num_nodes; ++i)
+      for (const auto& [u, c] : blocks)
+      {
+        global_dofs_.push_back(sdm.MapDOF(cell, i, unknown_manager, u, c));
+        local_dofs_.push_back(sdm.MapDOFLocal(cell, i, unknown_manager, u, c));
+      }
+  };
+
+  //============================================= Local cells
+  local_cell_offsets_.reserve(grid_.local_cells.size());
+  for (const auto& cell : grid_.local_cells)
+  {
+    local_cell_offsets_.push_back(global_dofs_.size());
+    Tabulate(cell);
+  }
+
+  //============================================= Ghost cells
+  if (with_ghosts)
+  {
+    ghost_cell_offsets_.assign(grid_.cells.GetNumGhosts(), 0);
+    for (const uint64_t global_id : grid_.cells.GetGhostGlobalIDs())
+    {
+      const auto& cell = grid_.cells[global_id];
+      ghost_cell_offsets_[grid_.cells.GetGhostLocalID(global_id)] =
+        global_dofs_.size();
+      Tabulate(cell);
+    }
+  }
+
+  global_dofs_.shrink_to_fit();
+  local_dofs_.shrink_to_fit();
+}
+
+//###################################################################
+/**Returns the offset of a ghost cell's indices.*/
+size_t chi_math::CellDOFTable::
+  GhostCellOffset(const chi_mesh::Cell& cell) const
+{
+  ChiLogicalErrorIf(ghost_cell_offsets_.empty(),
+                    "Cell " + std::to_string(cell.global_id_) + " is not a "
+                    "local cell and the ghost cells were not tabulated.");
+
+  return ghost_cell_offsets_[grid_.cells.GetGhostLocalID(cell.global_id_)];
+}
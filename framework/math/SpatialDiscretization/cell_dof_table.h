@@ -0,0 +1,85 @@
+#ifndef CHI_MATH_CELL_DOF_TABLE_H
+#define CHI_MATH_CELL_DOF_TABLE_H
+
+#include "math/UnknownManager/unknown_manager.h"
+#include "mesh/Cell/cell.h"
+
+#include <vector>
+
+namespace chi_mesh
+{
+class MeshContinuum;
+}
+
+namespace chi_math
+{
+class SpatialDiscretization;
+
+//###################################################################
+/**Precomputed global and local DOF indices of the cells of a spatial
+ * discretization for a given unknown manager, such that assembly loops
+ * read the indices instead of calling SpatialDiscretization::MapDOF and
+ * MapDOFLocal for every entry.
+ *
+ * The indices of a cell are stored contiguously as
+ * [node * NumBlocks() + block], with block the flat index
+ * UnknownManager::MapUnknown(unknown_id, component). Ghost cells are only
+ * tabulated when requested, which requires the discretization to map all
+ * of their nodes, e.g., for discontinuous discretizations.*/
+class CellDOFTable
+{
+private:
+  const chi_mesh::MeshContinuum& grid_;
+  const uint64_t location_id_;
+  const size_t num_blocks_;
+
+  std::vector<size_t> local_cell_offsets_;
+  std::vector<size_t> ghost_cell_offsets_;
+  std::vector<int64_t> global_dofs_;
+  std::vector<int64_t> local_dofs_;
+
+public:
+  CellDOFTable(const SpatialDiscretization& sdm,
+               const UnknownManager& unknown_manager,
+               bool with_ghosts = false);
+
+  /**The number of unknown components per node.*/
+  size_t NumBlocks() const {return num_blocks_;}
+
+  /**Returns the number of bytes held by the table.*/
+  size_t GetMemoryUsage() const
+  {
+    return (local_cell_offsets_.capacity() + ghost_cell_offsets_.capacity()) *
+             sizeof(size_t) +
+           (global_dofs_.capacity() + local_dofs_.capacity()) * sizeof(int64_t);
+  }
+
+  /**The global DOF indices of a cell, ordered [node * NumBlocks() + block].*/
+  const int64_t* GlobalDOFs(const chi_mesh::Cell& cell) const
+  {return global_dofs_.data() + CellOffset(cell);}
+  /**The local DOF indices of a cell, ordered [node * NumBlocks() + block].*/
+  const int64_t* LocalDOFs(const chi_mesh::Cell& cell) const
+  {return local_dofs_.data() + CellOffset(cell);}
+
+  /**Equivalent of SpatialDiscretization::MapDOF.*/
+  int64_t MapDOF(const chi_mesh::Cell& cell,
+                 unsigned int node, unsigned int block = 0) const
+  {return GlobalDOFs(cell)[node * num_blocks_ + block];}
+  /**Equivalent of SpatialDiscretization::MapDOFLocal.*/
+  int64_t MapDOFLocal(const chi_mesh::Cell& cell,
+                      unsigned int node, unsigned int block = 0) const
+  {return LocalDOFs(cell)[node * num_blocks_ + block];}
+
+private:
+  size_t CellOffset(const chi_mesh::Cell& cell) const
+  {
+    if (cell.partition_id_ == location_id_)
+      return local_cell_offsets_[cell.local_id_];
+    return GhostCellOffset(cell);
+  }
+  size_t GhostCellOffset(const chi_mesh::Cell& cell) const;
+};
+
+}//namespace chi_math
+
+#endif //CHI_MATH_CELL_DOF_TABLE_H
@@ -10,6 +10,7 @@
 
 #include <petscksp.h>
 
+#include <functional>
 #include <vector>
 #include <map>
 
@@ -25,6 +26,12 @@ protected:
   std::vector<std::unique_ptr<CellMapping>> cell_mappings_;
   std::map<uint64_t, std::shared_ptr<CellMapping>> nb_cell_mappings_;
 
+  typedef std::function<std::unique_ptr<CellMapping>(const chi_mesh::Cell&)>
+    CellMappingFactory;
+  /**Makes the mapping of a cell as stored, set by the discretization when
+   * creating its mappings.*/
+  CellMappingFactory cell_mapping_factory_;
+
   uint64_t local_block_address_ = 0;
   std::vector<uint64_t> locJ_block_address_;
   std::vector<uint64_t> locJ_block_size_;
@@ -53,6 +60,9 @@ protected:
   // 01 AddViewOfContinuum
 public:
   const CellMapping& GetCellMapping(const chi_mesh::Cell& cell) const;
+  virtual void
+  UpdateCellMappings(const std::vector<uint64_t>& local_cell_ids,
+                     const std::vector<uint64_t>& ghost_global_ids);
   SpatialDiscretizationType Type() const;
   /**Returns the reference grid on which this discretization is based.*/
   const chi_mesh::MeshContinuum& Grid() const;
@@ -106,6 +116,10 @@ public:
   std::vector<std::vector<std::vector<int>>>
   MakeInternalFaceNodeMappings(double tolerance = 1.0e-12) const;
 
+  /**Returns the number of bytes held by the cell mappings and the
+   * numbering of the discretization.*/
+  virtual size_t GetMemoryUsage() const;
+
   void CopyVectorWithUnknownScope(const std::vector<double>& from_vector,
                                   std::vector<double>& to_vector,
                                   const UnknownManager& from_vec_uk_structure,
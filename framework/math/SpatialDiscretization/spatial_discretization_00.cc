@@ -2,6 +2,8 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include "chi_log_exceptions.h"
+
 const chi_math::CellMapping& chi_math::SpatialDiscretization::GetCellMapping(
   const chi_mesh::Cell& cell) const
 {
@@ -22,6 +24,32 @@ const chi_math::CellMapping& chi_math::SpatialDiscretization::GetCellMapping(
   }
 }
 
+//###################################################################
+/**Remakes the mappings of the given local cells, by local id, and ghost
+ * cells, by global id, after their geometry changed. The mappings of the
+ * other cells are kept.*/
+void chi_math::SpatialDiscretization::
+  UpdateCellMappings(const std::vector<uint64_t>& local_cell_ids,
+                     const std::vector<uint64_t>& ghost_global_ids)
+{
+  ChiLogicalErrorIf(not cell_mapping_factory_,
+                    "The discretization does not support updating its cell "
+                    "mappings.");
+
+  const auto num_local_ids = static_cast<int64_t>(local_cell_ids.size());
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t k = 0; k < num_local_ids; ++k)
+  {
+    const uint64_t local_id = local_cell_ids[k];
+    cell_mappings_[local_id] =
+      cell_mapping_factory_(ref_grid_.local_cells[local_id]);
+  }
+
+  for (const uint64_t ghost_id : ghost_global_ids)
+    nb_cell_mappings_[ghost_id] =
+      cell_mapping_factory_(ref_grid_.cells[ghost_id]);
+}
+
 chi_math::SpatialDiscretizationType
 chi_math::SpatialDiscretization::Type() const
 {
@@ -2,6 +2,7 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 #include "math/PETScUtils/petsc_utils.h"
+#include "utils/chi_memory_accounting.h"
 
 // ###################################################################
 /**For each cell, for each face of that cell, for each node on that face,
@@ -189,4 +190,18 @@ void chi_math::SpatialDiscretization::LocalizePETScVectorWithGhosts(
 
   chi_math::PETScUtils::CopyVecToSTLvectorWithGhosts(
     petsc_vector, local_vector, num_local_dofs);
-}
\ No newline at end of file
+}
+
+// ###################################################################
+size_t chi_math::SpatialDiscretization::GetMemoryUsage() const
+{
+  size_t num_bytes =
+    chi::VectorMemoryUsage(cell_mappings_) +
+    chi::VectorMemoryUsage(locJ_block_address_) +
+    chi::VectorMemoryUsage(locJ_block_size_);
+  for (const auto& cell_mapping : cell_mappings_)
+    if (cell_mapping) num_bytes += cell_mapping->GetMemoryUsage();
+  for (const auto& [global_id, cell_mapping] : nb_cell_mappings_)
+    if (cell_mapping) num_bytes += cell_mapping->GetMemoryUsage();
+  return num_bytes;
+}
@@ -0,0 +1,89 @@
+#include "alias_sampler.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+
+#include <cmath>
+
+//###################################################################
+/**Vose's construction: bins with less than the average probability are
+ * filled up, to the average, by a bin with more than the average, which
+ * becomes their alias and keeps what remains of its probability. Bins
+ * left over through round-off are accepted with probability one.*/
+chi_math::AliasSampler::AliasSampler(const std::vector<double>& probabilities)
+{
+  const size_t num_bins = probabilities.size();
+  ChiInvalidArgumentIf(num_bins == 0,
+                       "The distribution needs at least one bin.");
+
+  double total = 0.0;
+  for (const double p : probabilities)
+  {
+    ChiInvalidArgumentIf(p < 0.0 or not std::isfinite(p),
+                         "Bin probabilities must be finite and "
+                         "non-negative.");
+    total += p;
+  }
+  ChiInvalidArgumentIf(total <= 0.0,
+                       "The bin probabilities sum to zero.");
+
+  //=================================== Scale so the average is one
+  table_.resize(num_bins);
+  std::vector<double> scaled(num_bins, 0.0);
+  std::vector<int> small;
+  std::vector<int> large;
+  small.reserve(num_bins);
+  large.reserve(num_bins);
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    scaled[i] = probabilities[i] * static_cast<double>(num_bins) / total;
+    (scaled[i] < 1.0 ? small : large).push_back(static_cast<int>(i));
+  }
+
+  //=================================== Pair small bins with large ones
+  while (not small.empty() and not large.empty())
+  {
+    const int s = small.back();
+    small.pop_back();
+    const int l = large.back();
+
+    table_[s] = {scaled[s], l};
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+
+  for (const int i : large) table_[i] = {1.0, i};
+  for (const int i : small) table_[i] = {1.0, i};
+}
+
+//###################################################################
+/**Differences of consecutive CDF values are the bin probabilities.*/
+chi_math::AliasSampler
+  chi_math::AliasSampler::FromCDF(const std::vector<double>& cdf)
+{
+  std::vector<double> probabilities(cdf.size(), 0.0);
+  double previous = 0.0;
+  for (size_t i = 0; i < cdf.size(); ++i)
+  {
+    ChiInvalidArgumentIf(cdf[i] < previous,
+                         "The CDF must be non-decreasing.");
+    probabilities[i] = cdf[i] - previous;
+    previous = cdf[i];
+  }
+
+  return AliasSampler(probabilities);
+}
+
+//###################################################################
+void chi_math::AliasSampler::Sample(const std::vector<double>& x,
+                                    std::vector<int>& bins) const
+{
+  bins.resize(x.size());
+  const size_t num_samples = x.size();
+  for (size_t n = 0; n < num_samples; ++n)
+    bins[n] = Sample(x[n]);
+}
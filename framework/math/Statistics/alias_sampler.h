@@ -0,0 +1,71 @@
+#ifndef CHI_MATH_ALIAS_SAMPLER_H
+#define CHI_MATH_ALIAS_SAMPLER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace chi_math
+{
+//###################################################################
+/**Samples the bins of a discrete distribution in constant time with the
+ * alias method (Walker, with Vose's construction of the tables).
+ *
+ * Each bin holds an acceptance probability and an alias bin, in one
+ * contiguous table. A uniform random number selects a bin with its
+ * integer part, scaled by the number of bins, and the fraction then
+ * chooses between the bin and its alias. Unlike chi_math::CDFSampler, the
+ * cost does not grow with the number of bins, although a given random
+ * number generally does not map to the bin the CDF brackets it in.
+ *
+ \code
+ chi_math::AliasSampler sampler =
+   chi_math::AliasSampler::FromCDF(in_cdf);
+ const int bin = sampler.Sample(rng.Rand());
+ \endcode*/
+class AliasSampler
+{
+private:
+  struct Entry
+  {
+    double acceptance = 1.0;
+    int alias = 0;
+  };
+
+  std::vector<Entry> table_;
+
+public:
+  /**Builds the tables from the, not necessarily normalized, probabilities
+   * of the bins.*/
+  explicit AliasSampler(const std::vector<double>& probabilities);
+
+  /**Builds the tables from a CDF in the format of chi_math::CDFSampler,
+   * i.e., the upper bin boundary of each bin.*/
+  static AliasSampler FromCDF(const std::vector<double>& cdf);
+
+  size_t NumBins() const { return table_.size(); }
+
+  /**Returns the probability that a bin, once selected, is accepted.*/
+  double Acceptance(size_t bin) const { return table_.at(bin).acceptance; }
+  /**Returns the bin sampled when a bin, once selected, is not accepted.*/
+  int Alias(size_t bin) const { return table_.at(bin).alias; }
+
+  /**Returns the bin sampled with the uniform random number x in [0,1].*/
+  int Sample(double x) const
+  {
+    const double scaled_x =
+      std::clamp(x, 0.0, 1.0) * static_cast<double>(table_.size());
+    const size_t bin =
+      std::min(static_cast<size_t>(scaled_x), table_.size() - 1);
+    const Entry& entry = table_[bin];
+    return (scaled_x - static_cast<double>(bin) < entry.acceptance)
+             ? static_cast<int>(bin)
+             : entry.alias;
+  }
+
+  /**Samples one bin per uniform random number.*/
+  void Sample(const std::vector<double>& x, std::vector<int>& bins) const;
+};
+}//namespace chi_math
+
+#endif //CHI_MATH_ALIAS_SAMPLER_H
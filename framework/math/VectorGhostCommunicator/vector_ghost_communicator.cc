@@ -2,8 +2,10 @@
 
 #include <map>
 #include <string>
+#include <algorithm>
 
 #include "mpi/chi_mpi_utils_map_all2all.h"
+#include "utils/chi_profiler.h"
 
 chi_math::VectorGhostCommunicator::
   VectorGhostCommunicator(uint64_t local_size,
@@ -144,6 +146,72 @@ chi_math::VectorGhostCommunicator::
     senddispls_[pid] = static_cast<int>(total_sendcounts);
     total_sendcounts += num_counts;
   }
+
+  //======================================== Premap receive ids
+  ghost_recv_ids_.reserve(ghost_indices_.size());
+  for (int64_t gid : ghost_indices_)
+    ghost_recv_ids_.push_back(ghost_ids_to_recv_map_.at(gid));
+
+  BuildExchangeRequests();
+}
+
+//###################################################################
+/**Destructor. Frees the persistent requests and the private
+ * communicator.*/
+chi_math::VectorGhostCommunicator::~VectorGhostCommunicator()
+{
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized) return;
+
+  if (exchange_active_)
+    MPI_Waitall(static_cast<int>(requests_.size()),
+                requests_.data(), MPI_STATUSES_IGNORE);
+
+  for (auto& request : requests_)
+    if (request != MPI_REQUEST_NULL)
+      MPI_Request_free(&request);
+
+  if (exchange_comm_ != MPI_COMM_NULL)
+    MPI_Comm_free(&exchange_comm_);
+}
+
+//###################################################################
+/**Builds persistent send and receive requests with each neighboring
+ * location. The requests operate on a duplicate of the communicator so
+ * that they cannot match other messages.*/
+void chi_math::VectorGhostCommunicator::BuildExchangeRequests()
+{
+  MPI_Comm_dup(comm_, &exchange_comm_);
+
+  send_buffer_.assign(takers_local_ids_.size(), 0.0);
+  recv_buffer_.assign(ghost_indices_.size(), 0.0);
+
+  giver_pids_.clear();
+  taker_pids_.clear();
+  for (int pid = 0; pid < process_count_; ++pid)
+  {
+    if (recvcounts_[pid] > 0) giver_pids_.push_back(pid);
+    if (sendcounts_[pid] > 0) taker_pids_.push_back(pid);
+  }
+
+  const int tag = 0;
+  requests_.clear();
+  requests_.reserve(giver_pids_.size() + taker_pids_.size());
+  for (int pid : giver_pids_)
+  {
+    requests_.emplace_back();
+    MPI_Recv_init(&recv_buffer_[recvdispls_[pid]],
+                  recvcounts_[pid], MPI_DOUBLE,
+                  pid, tag, exchange_comm_, &requests_.back());
+  }
+  for (int pid : taker_pids_)
+  {
+    requests_.emplace_back();
+    MPI_Send_init(&send_buffer_[senddispls_[pid]],
+                  sendcounts_[pid], MPI_DOUBLE,
+                  pid, tag, exchange_comm_, &requests_.back());
+  }
 }
 
 
@@ -153,52 +221,76 @@ int chi_math::VectorGhostCommunicator::FindOwnerPID(uint64_t global_id) const
   if (global_id >= globl_size_)
     throw std::logic_error(
       "chi_math::VectorWithGhosts:FindOwnerPID global_id >= m_globl_size");
-  for (int locI=0; locI<static_cast<int>(process_count_); ++locI)
-    if (global_id >= locI_extents_[locI] and
-        global_id < locI_extents_[locI + 1])
-      return locI;
-  return int(-1);
+  //The extents are sorted, hence the owner is the last location whose
+  //extent begins at, or before, the global id
+  const auto it = std::upper_bound(locI_extents_.begin(),
+                                   locI_extents_.end(),
+                                   global_id);
+  return static_cast<int>(std::distance(locI_extents_.begin(), it)) - 1;
 }
 
 //###################################################################
+/**Communicates the ghost entries of the given ghosted vector, i.e. sets
+ * the ghost entries to the values of the locations that own them.*/
 void chi_math::VectorGhostCommunicator::
   CommunicateGhostEntries(std::vector<double> &local_vector) const
 {
+  BeginGhostExchange(local_vector);
+  EndGhostExchange(local_vector);
+}
+
+//###################################################################
+/**Starts communicating the ghost entries of the given ghosted vector. The
+ * local entries of the vector may be read, but not modified, until the
+ * exchange is completed with EndGhostExchange.*/
+void chi_math::VectorGhostCommunicator::
+  BeginGhostExchange(const std::vector<double>& local_vector) const
+{
+  ChiProfileRegion("Ghost communication");
   if (local_vector.size() != (local_size_ + ghost_indices_.size()))
     throw std::logic_error(
-      "chi_math::VectorWithGhosts::CommunicateGhostEntries: Vector size "
+      "chi_math::VectorGhostCommunicator::BeginGhostExchange: Vector size "
       "mismatch.");
+  if (exchange_active_)
+    throw std::logic_error(
+      "chi_math::VectorGhostCommunicator::BeginGhostExchange: An exchange "
+      "is already active.");
 
   //======================================== Build data to be sent
   const size_t amount_to_send = takers_local_ids_.size();
-  std::vector<double> send_data;
-  send_data.reserve(amount_to_send);
-  for (const int64_t local_id : takers_local_ids_)
-    send_data.push_back(local_vector[local_id]);
-
-  //======================================== Allocate receive buffer
-  const size_t amount_to_recv = ghost_indices_.size();
-  std::vector<double> recv_data(amount_to_recv, 0.0);
+  for (size_t k=0; k<amount_to_send; ++k)
+    send_buffer_[k] = local_vector[takers_local_ids_[k]];
 
   //======================================== Communicate
-  MPI_Alltoallv(send_data.data(),
-                sendcounts_.data(),
-                senddispls_.data(),
-                MPI_DOUBLE,
-                recv_data.data(),
-                recvcounts_.data(),
-                recvdispls_.data(),
-                MPI_DOUBLE,
-                comm_);
+  MPI_Startall(static_cast<int>(requests_.size()), requests_.data());
+  exchange_active_ = true;
+}
+
+//###################################################################
+/**Completes the exchange started by BeginGhostExchange and populates the
+ * ghost entries of the given ghosted vector.*/
+void chi_math::VectorGhostCommunicator::
+  EndGhostExchange(std::vector<double>& local_vector) const
+{
+  ChiProfileRegion("Ghost communication");
+  if (local_vector.size() != (local_size_ + ghost_indices_.size()))
+    throw std::logic_error(
+      "chi_math::VectorGhostCommunicator::EndGhostExchange: Vector size "
+      "mismatch.");
+  if (not exchange_active_)
+    throw std::logic_error(
+      "chi_math::VectorGhostCommunicator::EndGhostExchange: No exchange "
+      "is active.");
+
+  MPI_Waitall(static_cast<int>(requests_.size()),
+              requests_.data(), MPI_STATUSES_IGNORE);
+  exchange_active_ = false;
 
   //======================================== Populate local vector with ghost
   //                                         data
+  const size_t amount_to_recv = ghost_indices_.size();
   for (size_t k=0; k<amount_to_recv; ++k)
-  {
-    const int64_t gid = ghost_indices_[k];
-    const size_t  rid = ghost_ids_to_recv_map_.at(gid);
-    local_vector[local_size_ + k] = recv_data[rid];
-  }
+    local_vector[local_size_ + k] = recv_buffer_[ghost_recv_ids_[k]];
 }
 
 
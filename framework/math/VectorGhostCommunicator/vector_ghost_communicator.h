@@ -10,7 +10,13 @@
 namespace chi_math
 {
 
-/**Vector with allocation space for ghosts.*/
+/**Vector with allocation space for ghosts.
+ *
+ * Ghost entries are exchanged only with the neighboring locations, i.e.
+ * those that own ghosts of this location or that need entries of this
+ * location, using persistent point-to-point requests on a private
+ * communicator. The exchange can be split into BeginGhostExchange and
+ * EndGhostExchange such that local work can be overlapped with it.*/
 class VectorGhostCommunicator
 {
 protected:
@@ -27,6 +33,15 @@ protected:
   std::vector<int>           recvdispls_;
   std::vector<int64_t>       takers_local_ids_;
   std::map<int64_t,size_t>   ghost_ids_to_recv_map_;
+  std::vector<size_t>        ghost_recv_ids_;
+
+  MPI_Comm                   exchange_comm_ = MPI_COMM_NULL;
+  std::vector<int>           giver_pids_;
+  std::vector<int>           taker_pids_;
+  mutable std::vector<double>      send_buffer_;
+  mutable std::vector<double>      recv_buffer_;
+  mutable std::vector<MPI_Request> requests_;
+  mutable bool               exchange_active_ = false;
 
 public:
   VectorGhostCommunicator(uint64_t local_size,
@@ -34,12 +49,21 @@ public:
                           std::vector<int64_t> ghost_indices,
                           MPI_Comm communicator);
 
+  VectorGhostCommunicator(const VectorGhostCommunicator&) = delete;
+  VectorGhostCommunicator& operator=(const VectorGhostCommunicator&) = delete;
+
+  ~VectorGhostCommunicator();
+
 private:
   int FindOwnerPID(uint64_t global_id) const;
+  void BuildExchangeRequests();
 
 public:
   void CommunicateGhostEntries(std::vector<double>& local_vector) const;
 
+  void BeginGhostExchange(const std::vector<double>& local_vector) const;
+  void EndGhostExchange(std::vector<double>& local_vector) const;
+
   std::vector<double> MakeGhostedVector() const;
   std::vector<double> MakeGhostedVector(
     const std::vector<double>& unghosted_vector) const;
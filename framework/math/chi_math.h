@@ -18,6 +18,7 @@ namespace chi_math
 
   class UnknownManager;
   class CDFSampler;
+  class AliasSampler;
 
   class SpatialDiscretization;
   class SpatialDiscretization_FV;
@@ -80,6 +81,8 @@ namespace chi_math
                     const size_t c,
                     const MatDbl& A );
   void   GaussElimination(MatDbl& A, VecDbl& b, int n);
+  void   GaussEliminationBatched(double* A, double* b, double* lane_scratch,
+                                 int n, int num_lanes);
   MatDbl InverseGEPivoting(const MatDbl& A);
   MatDbl Inverse(const MatDbl& A);
 
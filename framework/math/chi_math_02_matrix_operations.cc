@@ -313,6 +313,73 @@ void chi_math::GaussElimination(MatDbl &A,
 	}
 }
 
+//######################################################### Gauss Elimination
+/** Gauss Elimination without pivoting applied simultaneously to `num_lanes`
+ * systems of size `n`. Matrix entries are stored lane-innermost as
+ * `A[(i*n + j)*num_lanes + lane]` and right-hand sides as
+ * `b[i*num_lanes + lane]`, so that the lane loops vectorize.
+ * `lane_scratch` must hold at least `num_lanes` values. A is overwritten
+ * and b is replaced by the solutions.*/
+void chi_math::GaussEliminationBatched(double* A,
+                                       double* b,
+                                       double* lane_scratch,
+                                       const int n,
+                                       const int num_lanes)
+{
+  const size_t L = num_lanes;
+  double* factor = lane_scratch;
+
+  // Forward elimination
+  for (int i = 0; i < n - 1; ++i)
+  {
+    const double* a_ii = &A[(i * n + i) * L];
+    const double* b_i = &b[i * L];
+#pragma omp simd
+    for (size_t l = 0; l < L; ++l)
+      factor[l] = 1.0 / a_ii[l];
+
+    for (int j = i + 1; j < n; ++j)
+    {
+      // The multiplier overwrites A_ji which is no longer needed
+      double* a_ji = &A[(j * n + i) * L];
+      double* b_j = &b[j * L];
+#pragma omp simd
+      for (size_t l = 0; l < L; ++l)
+      {
+        a_ji[l] *= factor[l];
+        b_j[l] -= a_ji[l] * b_i[l];
+      }
+
+      for (int k = i + 1; k < n; ++k)
+      {
+        double* a_jk = &A[(j * n + k) * L];
+        const double* a_ik = &A[(i * n + k) * L];
+#pragma omp simd
+        for (size_t l = 0; l < L; ++l)
+          a_jk[l] -= a_ji[l] * a_ik[l];
+      }
+    }
+  }
+
+  // Back substitution
+  for (int i = n - 1; i >= 0; --i)
+  {
+    double* b_i = &b[i * L];
+    for (int j = i + 1; j < n; ++j)
+    {
+      const double* a_ij = &A[(i * n + j) * L];
+      const double* b_j = &b[j * L];
+#pragma omp simd
+      for (size_t l = 0; l < L; ++l)
+        b_i[l] -= a_ij[l] * b_j[l];
+    }
+    const double* a_ii = &A[(i * n + i) * L];
+#pragma omp simd
+    for (size_t l = 0; l < L; ++l)
+      b_i[l] /= a_ii[l];
+  }
+}
+
 //#########################################################
 /** Computes the inverse of a matrix using Gauss-Elimination with pivoting.*/
 MatDbl chi_math::InverseGEPivoting(const MatDbl &A)
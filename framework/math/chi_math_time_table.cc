@@ -0,0 +1,71 @@
+#include "chi_math_time_table.h"
+
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <utility>
+
+//###################################################################
+/**Constructs the table from increasing times and, per time, the values of
+ * all the components.*/
+chi_math::TimeTable::TimeTable(std::vector<double> times,
+                               std::vector<double> values,
+                               size_t num_components)
+  : times_(std::move(times)),
+    values_(std::move(values)),
+    num_components_(num_components)
+{
+  ChiInvalidArgumentIf(times_.empty(), "A time table requires one time.");
+  ChiInvalidArgumentIf(num_components_ == 0,
+                       "A time table requires one component.");
+  ChiInvalidArgumentIf(values_.size() != times_.size() * num_components_,
+                       "A time table requires one value per time and "
+                       "component.");
+  for (size_t k = 1; k < times_.size(); ++k)
+    ChiInvalidArgumentIf(times_[k] <= times_[k - 1],
+                         "The times of a time table must be increasing.");
+}
+
+//###################################################################
+/**Interpolates the components at the given time.*/
+void chi_math::TimeTable::Evaluate(const double time,
+                                   std::vector<double>& values) const
+{
+  const size_t C = num_components_;
+  values.resize(C);
+
+  //======================================== Outside of the table
+  if (time <= times_.front() or times_.size() == 1)
+  {
+    std::copy_n(values_.begin(), C, values.begin());
+    return;
+  }
+  if (time >= times_.back())
+  {
+    std::copy_n(values_.end() - static_cast<long>(C), C, values.begin());
+    return;
+  }
+
+  //======================================== Interpolate in the interval
+  const auto upper = std::upper_bound(times_.begin(), times_.end(), time);
+  const size_t k = static_cast<size_t>(upper - times_.begin()) - 1;
+  const double w =
+    (time - times_[k]) / (times_[k + 1] - times_[k]);
+
+  for (size_t c = 0; c < C; ++c)
+    values[c] = (1.0 - w) * values_[k * C + c] + w * values_[(k + 1) * C + c];
+}
+
+//###################################################################
+/**Interpolates the amplitudes of the given number of groups, a table of
+ * a single component applying to all of them.*/
+void chi_math::TimeTable::EvaluateGroups(const double time,
+                                         const size_t num_groups,
+                                         std::vector<double>& amplitudes) const
+{
+  ChiInvalidArgumentIf(num_components_ != 1 and num_components_ != num_groups,
+                       "A time table of group amplitudes requires one or "
+                       "num_groups components.");
+  Evaluate(time, amplitudes);
+  if (num_components_ == 1) amplitudes.assign(num_groups, amplitudes.front());
+}
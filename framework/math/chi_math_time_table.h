@@ -0,0 +1,42 @@
+#ifndef CHITECH_CHI_MATH_TIME_TABLE_H
+#define CHITECH_CHI_MATH_TIME_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace chi_math
+{
+
+//###################################################################
+/**Values tabulated in time, e.g., the multigroup amplitudes of a source,
+ * interpolated linearly between the tabulated times and held constant
+ * outside of them.
+ *
+ * Every time has the same number of components, one amplitude for all the
+ * groups or one per group. Evaluation bisects the times, such that a time
+ * dependent problem only pays a lookup into a short table per step,
+ * whatever the number of degrees of freedom it scales.*/
+class TimeTable
+{
+private:
+  std::vector<double> times_;
+  std::vector<double> values_; ///< Per time, then component
+  size_t num_components_;
+
+public:
+  TimeTable(std::vector<double> times,
+            std::vector<double> values,
+            size_t num_components);
+
+  size_t NumComponents() const { return num_components_; }
+  const std::vector<double>& Times() const { return times_; }
+
+  void Evaluate(double time, std::vector<double>& values) const;
+  void EvaluateGroups(double time,
+                      size_t num_groups,
+                      std::vector<double>& amplitudes) const;
+};
+
+} // namespace chi_math
+
+#endif // CHITECH_CHI_MATH_TIME_TABLE_H
@@ -0,0 +1,284 @@
+#ifndef CHI_MATH_SMALL_DENSE_MATRIX_H
+#define CHI_MATH_SMALL_DENSE_MATRIX_H
+
+#include "chi_math.h"
+#include "chi_log_exceptions.h"
+
+#include <array>
+
+namespace chi_math
+{
+//###################################################################
+/**Dense vector of runtime size up to a compile-time capacity, stored
+ * contiguously in place, i.e., without heap allocations. Intended for
+ * cell-level linear algebra.*/
+template <size_t CAPACITY>
+class SmallVector
+{
+private:
+  std::array<double, CAPACITY> values_;
+  size_t size_ = 0;
+
+public:
+  static constexpr size_t Capacity() { return CAPACITY; }
+
+  SmallVector() = default;
+  explicit SmallVector(size_t size, double value = 0.0) { Resize(size, value); }
+
+  /**Sets the size and all the values.*/
+  void Resize(size_t size, double value = 0.0)
+  {
+    ChiInvalidArgumentIf(size > CAPACITY, "Size exceeds the capacity.");
+    size_ = size;
+    for (size_t i = 0; i < size_; ++i) values_[i] = value;
+  }
+
+  size_t Size() const { return size_; }
+
+  double& operator[](size_t i) { return values_[i]; }
+  double operator[](size_t i) const { return values_[i]; }
+
+  double* Data() { return values_.data(); }
+  const double* Data() const { return values_.data(); }
+};
+
+//###################################################################
+/**Dense matrix of runtime dimensions up to a compile-time capacity
+ * per dimension, stored contiguously in place, row-major with the number
+ * of columns as the row stride. `A[i][j]` addresses an entry like for
+ * `MatDbl`, such that code can be written for both.*/
+template <size_t CAPACITY>
+class SmallMatrix
+{
+private:
+  std::array<double, CAPACITY * CAPACITY> values_;
+  size_t num_rows_ = 0;
+  size_t num_cols_ = 0;
+
+public:
+  static constexpr size_t Capacity() { return CAPACITY; }
+
+  SmallMatrix() = default;
+  SmallMatrix(size_t num_rows, size_t num_cols, double value = 0.0)
+  { Resize(num_rows, num_cols, value); }
+
+  /**Copies a `MatDbl`, or its leading `num_rows` by `num_cols` block.*/
+  void Assign(const MatDbl& A, size_t num_rows, size_t num_cols)
+  {
+    Resize(num_rows, num_cols);
+    for (size_t i = 0; i < num_rows_; ++i)
+      for (size_t j = 0; j < num_cols_; ++j)
+        (*this)(i, j) = A[i][j];
+  }
+
+  /**Sets the dimensions and all the values.*/
+  void Resize(size_t num_rows, size_t num_cols, double value = 0.0)
+  {
+    ChiInvalidArgumentIf(num_rows > CAPACITY or num_cols > CAPACITY,
+                         "Dimensions exceed the capacity.");
+    num_rows_ = num_rows;
+    num_cols_ = num_cols;
+    for (size_t k = 0; k < num_rows_ * num_cols_; ++k) values_[k] = value;
+  }
+
+  size_t NumRows() const { return num_rows_; }
+  size_t NumCols() const { return num_cols_; }
+
+  double& operator()(size_t i, size_t j) { return values_[i * num_cols_ + j]; }
+  double operator()(size_t i, size_t j) const
+  { return values_[i * num_cols_ + j]; }
+
+  /**Pointer to the first entry of row i.*/
+  double* operator[](size_t i) { return &values_[i * num_cols_]; }
+  const double* operator[](size_t i) const { return &values_[i * num_cols_]; }
+
+  double* Data() { return values_.data(); }
+  const double* Data() const { return values_.data(); }
+};
+
+//###################################################################
+/**LU factorization, without pivoting, of a square SmallMatrix. The
+ * factors are kept such that the system can be solved for many
+ * right-hand sides. The arithmetic is the same as that of
+ * chi_math::GaussElimination, i.e., it is meant for the cell systems of
+ * the transport sweeps, which have nonzero pivots.*/
+template <size_t CAPACITY>
+class SmallLU
+{
+private:
+  SmallMatrix<CAPACITY> LU_;
+
+public:
+  SmallLU() = default;
+  explicit SmallLU(const SmallMatrix<CAPACITY>& A) { Factor(A); }
+
+  /**Factors A. L is unit lower triangular and stored, with U, in place.*/
+  void Factor(const SmallMatrix<CAPACITY>& A)
+  {
+    ChiInvalidArgumentIf(A.NumRows() != A.NumCols(),
+                         "The matrix must be square.");
+    LU_ = A;
+    FactorInPlace();
+  }
+
+  /**Factors the matrix currently held, e.g., assembled through Matrix().*/
+  void FactorInPlace()
+  {
+    const size_t n = LU_.NumRows();
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+      const double* a_i = LU_[i];
+      const double factor = 1.0 / a_i[i];
+      for (size_t j = i + 1; j < n; ++j)
+      {
+        double* a_j = LU_[j];
+        const double l_ji = a_j[i] * factor;
+        a_j[i] = l_ji;
+        for (size_t k = i + 1; k < n; ++k)
+          a_j[k] -= l_ji * a_i[k];
+      }
+    }
+  }
+
+  /**The held matrix, to be assembled in place before FactorInPlace.*/
+  SmallMatrix<CAPACITY>& Matrix() { return LU_; }
+
+  size_t Size() const { return LU_.NumRows(); }
+
+  /**Replaces b, of at least Size() entries, with the solution.*/
+  void Solve(double* b) const
+  {
+    const size_t n = LU_.NumRows();
+    //================================ Forward substitution, L y = b
+    for (size_t j = 1; j < n; ++j)
+    {
+      const double* a_j = LU_[j];
+      double b_j = b[j];
+      for (size_t i = 0; i < j; ++i)
+        b_j -= a_j[i] * b[i];
+      b[j] = b_j;
+    }
+    //================================ Back substitution, U x = y
+    for (size_t ii = n; ii > 0; --ii)
+    {
+      const size_t i = ii - 1;
+      const double* a_i = LU_[i];
+      double b_i = b[i];
+      for (size_t j = i + 1; j < n; ++j)
+        b_i -= a_i[j] * b[j];
+      b[i] = b_i / a_i[i];
+    }
+  }
+
+  void Solve(SmallVector<CAPACITY>& b) const { Solve(b.Data()); }
+  void Solve(VecDbl& b) const { Solve(b.data()); }
+};
+
+//###################################################################
+/**Gauss elimination without pivoting of the leading n by n block of A,
+ * with the same arithmetic and signature as the MatDbl version. A is
+ * overwritten and b replaced by the solution.*/
+template <size_t CAPACITY>
+void GaussElimination(SmallMatrix<CAPACITY>& A, VecDbl& b, int n)
+{
+  // Forward elimination
+  for (int i = 0; i < n - 1; ++i)
+  {
+    const double* ai = A[i];
+    const double bi = b[i];
+    const double factor = 1.0 / ai[i];
+    for (int j = i + 1; j < n; ++j)
+    {
+      double* aj = A[j];
+      const double val = aj[i] * factor;
+      b[j] -= val * bi;
+      for (int k = i + 1; k < n; ++k)
+        aj[k] -= val * ai[k];
+    }
+  }
+
+  // Back substitution
+  for (int i = n - 1; i >= 0; --i)
+  {
+    const double* ai = A[i];
+    double bi = b[i];
+    for (int j = i + 1; j < n; ++j)
+      bi -= ai[j] * b[j];
+    b[i] = bi / ai[i];
+  }
+}
+
+//###################################################################
+/**y = alpha A x + beta y, for x and y of at least A.NumCols() and
+ * A.NumRows() entries.*/
+template <size_t CAPACITY>
+void Gemv(double alpha, const SmallMatrix<CAPACITY>& A, const double* x,
+          double beta, double* y)
+{
+  for (size_t i = 0; i < A.NumRows(); ++i)
+  {
+    const double* a_i = A[i];
+    double sum = 0.0;
+    for (size_t j = 0; j < A.NumCols(); ++j)
+      sum += a_i[j] * x[j];
+    y[i] = alpha * sum + beta * y[i];
+  }
+}
+
+/**C = alpha A B + beta C. C must have the dimensions of the product.*/
+template <size_t CAPACITY>
+void Gemm(double alpha, const SmallMatrix<CAPACITY>& A,
+          const SmallMatrix<CAPACITY>& B,
+          double beta, SmallMatrix<CAPACITY>& C)
+{
+  ChiInvalidArgumentIf(A.NumCols() != B.NumRows() or
+                       C.NumRows() != A.NumRows() or
+                       C.NumCols() != B.NumCols(),
+                       "Mismatched dimensions.");
+  for (size_t i = 0; i < C.NumRows(); ++i)
+  {
+    double* c_i = C[i];
+    for (size_t j = 0; j < C.NumCols(); ++j) c_i[j] *= beta;
+    const double* a_i = A[i];
+    for (size_t k = 0; k < A.NumCols(); ++k)
+    {
+      const double alpha_a_ik = alpha * a_i[k];
+      const double* b_k = B[k];
+      for (size_t j = 0; j < C.NumCols(); ++j)
+        c_i[j] += alpha_a_ik * b_k[j];
+    }
+  }
+}
+
+/**C = A + alpha B, the matrices having the same dimensions. C may alias A
+ * or B.*/
+template <size_t CAPACITY>
+void MatAdd(const SmallMatrix<CAPACITY>& A, double alpha,
+            const SmallMatrix<CAPACITY>& B, SmallMatrix<CAPACITY>& C)
+{
+  const size_t num_values = A.NumRows() * A.NumCols();
+  const double* a = A.Data();
+  const double* b = B.Data();
+  double* c = C.Data();
+  for (size_t k = 0; k < num_values; ++k)
+    c[k] = a[k] + alpha * b[k];
+}
+
+/**y += alpha x, over n entries.*/
+inline void Axpy(size_t n, double alpha, const double* x, double* y)
+{
+  for (size_t i = 0; i < n; ++i)
+    y[i] += alpha * x[i];
+}
+
+/**The dot product of x and y, over n entries.*/
+inline double Dot(size_t n, const double* x, const double* y)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    sum += x[i] * y[i];
+  return sum;
+}
+}//namespace chi_math
+
+#endif //CHI_MATH_SMALL_DENSE_MATRIX_H
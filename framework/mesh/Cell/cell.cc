@@ -112,7 +112,8 @@ uint64_t chi_mesh::CellFace::
   GetNeighborLocalID(const chi_mesh::MeshContinuum& grid) const
 {
   if (not has_neighbor_) return -1;
-  if (Chi::mpi.process_count == 1) return neighbor_id_; //cause global_ids=local_ids
+  if (Chi::mpi.process_count == 1 and not grid.LocalCellsRenumbered())
+    return neighbor_id_; //cause global_ids=local_ids
 
   auto& adj_cell = grid.cells[neighbor_id_];
 
@@ -447,4 +448,14 @@ void chi_mesh::Cell::
       face.normal_ = weighted_normal.Normalized();
     }
   }
-}
\ No newline at end of file
+}
+//###################################################################
+/**Returns the number of bytes held by the cell, including its faces.*/
+size_t chi_mesh::Cell::GetMemoryUsage() const
+{
+  size_t num_bytes = sizeof(Cell) + vertex_ids_.capacity() * sizeof(uint64_t) +
+                     faces_.capacity() * sizeof(CellFace);
+  for (const auto& face : faces_)
+    num_bytes += face.vertex_ids_.capacity() * sizeof(uint64_t);
+  return num_bytes;
+}
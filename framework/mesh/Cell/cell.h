@@ -104,6 +104,9 @@ public:
   std::string ToString() const;
 
   void RecomputeCentroidsAndNormals(const chi_mesh::MeshContinuum& grid);
+
+  /**Returns the number of bytes held by the cell, including its faces.*/
+  size_t GetMemoryUsage() const;
 };
 
 }
@@ -0,0 +1,125 @@
+#include "mesh/chi_mesh.h"
+
+#include <array>
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// ###################################################################
+/**Returns the index along a 3D Hilbert curve of a point with `bits`-bit
+ * integer coordinates, using Skilling's transpose algorithm.*/
+uint64_t HilbertIndex3D(std::array<uint64_t, 3> x, const int bits)
+{
+  //======================================== Inverse undo excess work
+  const uint64_t M = uint64_t(1) << (bits - 1);
+  for (uint64_t Q = M; Q > 1; Q >>= 1)
+  {
+    const uint64_t P = Q - 1;
+    for (auto& xi : x)
+    {
+      if (xi & Q) x[0] ^= P;
+      else
+      {
+        const uint64_t t = (x[0] ^ xi) & P;
+        x[0] ^= t;
+        xi ^= t;
+      }
+    }
+  }
+
+  //======================================== Gray encode
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  uint64_t t = 0;
+  for (uint64_t Q = M; Q > 1; Q >>= 1)
+    if (x[2] & Q) t ^= Q - 1;
+  for (auto& xi : x) xi ^= t;
+
+  //======================================== Interleave the transpose
+  uint64_t index = 0;
+  for (int b = bits - 1; b >= 0; --b)
+    for (const auto xi : x)
+      index = (index << 1) | ((xi >> b) & 1);
+
+  return index;
+}
+} // namespace
+
+//###################################################################
+/** Partitions points along a Hilbert space-filling curve. The points are
+ * ordered along the curve, through their bounding box, and the curve is
+ * cut into `num_parts` contiguous pieces of near equal weight. Empty
+ * weights, or weights summing to zero, balance the number of points.
+ * Returns the part of every point.*/
+std::vector<int64_t>
+  chi_mesh::PartitionAlongHilbertCurve(const std::vector<Vector3>& points,
+                                       const std::vector<double>& weights,
+                                       const size_t num_parts)
+{
+  const size_t num_points = points.size();
+  std::vector<int64_t> point_parts(num_points, 0);
+  if (num_points == 0 or num_parts <= 1) return point_parts;
+
+  //======================================== Bounding box of the points
+  chi_mesh::Vector3 xyz_min = points.front();
+  chi_mesh::Vector3 xyz_max = xyz_min;
+  for (const auto& c : points)
+  {
+    xyz_min = {std::min(xyz_min.x, c.x),
+               std::min(xyz_min.y, c.y),
+               std::min(xyz_min.z, c.z)};
+    xyz_max = {std::max(xyz_max.x, c.x),
+               std::max(xyz_max.y, c.y),
+               std::max(xyz_max.z, c.z)};
+  }
+
+  //======================================== Hilbert keys
+  const int bits = 21;
+  const double max_quantum = static_cast<double>((uint64_t(1) << bits) - 1);
+  auto Quantize = [max_quantum](double value, double vmin, double vmax)
+  {
+    if (vmax - vmin < 1.0e-12) return uint64_t(0);
+    return static_cast<uint64_t>((value - vmin) / (vmax - vmin) * max_quantum);
+  };
+
+  std::vector<uint64_t> keys(num_points);
+  for (size_t p = 0; p < num_points; ++p)
+  {
+    const auto& c = points[p];
+    keys[p] = HilbertIndex3D({Quantize(c.x, xyz_min.x, xyz_max.x),
+                              Quantize(c.y, xyz_min.y, xyz_max.y),
+                              Quantize(c.z, xyz_min.z, xyz_max.z)},
+                             bits);
+  }
+
+  std::vector<size_t> order(num_points);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+  //======================================== Cut the curve by weight
+  std::vector<double> point_weights = weights;
+  double total_weight = 0.0;
+  for (const double weight : point_weights)
+    total_weight += weight;
+  if (point_weights.size() != num_points or total_weight <= 0.0)
+  {
+    point_weights.assign(num_points, 1.0);
+    total_weight = static_cast<double>(num_points);
+  }
+
+  double cumulative_weight = 0.0;
+  for (const size_t p : order)
+  {
+    const double weight = point_weights[p];
+    const double midpoint = cumulative_weight + 0.5 * weight;
+    const auto part = static_cast<size_t>(
+      midpoint / total_weight * static_cast<double>(num_parts));
+    point_parts[p] = static_cast<int64_t>(std::min(part, num_parts - 1));
+    cumulative_weight += weight;
+  }
+
+  return point_parts;
+}
@@ -0,0 +1,333 @@
+#include "mesh/chi_mesh.h"
+
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace
+{
+// ###################################################################
+/**Sorts `ids` along the given axis and splits them into consecutive
+ * pieces, one per child, of weight proportional to the child's number of
+ * parts. Splits are moved to the nearest change of coordinate, such that
+ * cells of an orthogonal plane stay together, while keeping every piece
+ * non-empty. Returns the end of each piece.*/
+std::vector<size_t>
+  SplitAlongAxis(const std::vector<chi_mesh::Vector3>& points,
+                 const std::vector<double>& weights,
+                 std::vector<size_t>::iterator ids_begin,
+                 std::vector<size_t>::iterator ids_end,
+                 const size_t axis,
+                 const std::vector<size_t>& child_num_parts,
+                 const double tolerance)
+{
+  auto Coord = [&points, axis](size_t p) { return points[p][axis]; };
+
+  std::stable_sort(ids_begin, ids_end, [&Coord](size_t a, size_t b)
+                   { return Coord(a) < Coord(b); });
+
+  const auto num_ids = static_cast<size_t>(ids_end - ids_begin);
+  std::vector<double> cumulative_weights(num_ids + 1, 0.0);
+  for (size_t i = 0; i < num_ids; ++i)
+    cumulative_weights[i + 1] = cumulative_weights[i] + weights[ids_begin[i]];
+
+  const double total_parts = static_cast<double>(
+    std::accumulate(child_num_parts.begin(), child_num_parts.end(),
+                    size_t(0)));
+  const size_t num_children = child_num_parts.size();
+
+  std::vector<size_t> ends(num_children, num_ids);
+  size_t parts_so_far = 0;
+  size_t previous_end = 0;
+  for (size_t c = 0; c + 1 < num_children; ++c)
+  {
+    parts_so_far += child_num_parts[c];
+    const double target = cumulative_weights.back() *
+                          static_cast<double>(parts_so_far) / total_parts;
+
+    size_t end = std::lower_bound(cumulative_weights.begin(),
+                                  cumulative_weights.end(),
+                                  target) - cumulative_weights.begin();
+
+    //Move to the nearest plane boundary
+    size_t lo = end;
+    size_t hi = end;
+    while (lo > 0 and lo < num_ids and
+           std::fabs(Coord(ids_begin[lo]) - Coord(ids_begin[lo - 1])) <=
+           tolerance)
+      --lo;
+    while (hi > 0 and hi < num_ids and
+           std::fabs(Coord(ids_begin[hi]) - Coord(ids_begin[hi - 1])) <=
+           tolerance)
+      ++hi;
+    end = (end - lo <= hi - end) ? lo : hi;
+
+    //Keep every piece non-empty if possible
+    const size_t remaining_children = num_children - c - 1;
+    const size_t max_end =
+      num_ids > remaining_children ? num_ids - remaining_children : 0;
+    end = std::max(end, std::min(previous_end + 1, max_end));
+    end = std::min(end, max_end);
+
+    ends[c] = end;
+    previous_end = end;
+  }
+
+  return ends;
+}
+
+// ###################################################################
+/**Number of slabs along each outer axis, and the number of parts of every
+ * group of the innermost axis, enumerated slab-major.*/
+struct KBALayout
+{
+  std::vector<size_t> num_slabs;
+  std::vector<size_t> group_num_parts;
+};
+
+// ###################################################################
+/**Recursively splits the points of a slab, or of a group on the innermost
+ * level, and assigns the parts.*/
+void PartitionRecursive(const std::vector<chi_mesh::Vector3>& points,
+                        const std::vector<double>& weights,
+                        const std::vector<size_t>& axes,
+                        const KBALayout& layout,
+                        std::vector<size_t>::iterator ids_begin,
+                        std::vector<size_t>::iterator ids_end,
+                        const size_t level,
+                        const size_t group_begin,
+                        const size_t group_end,
+                        const size_t part_offset,
+                        const double tolerance,
+                        std::vector<int64_t>& point_parts)
+{
+  if (ids_begin == ids_end) return;
+
+  const auto& group_parts = layout.group_num_parts;
+  const bool inner = level == layout.num_slabs.size();
+
+  //======================================== Parts and groups per child
+  std::vector<size_t> child_num_parts;
+  std::vector<size_t> child_group_begins;
+  if (inner)
+    child_num_parts.assign(group_parts[group_begin], 1);
+  else
+  {
+    const size_t num_slabs = layout.num_slabs[level];
+    const size_t groups_per_slab = (group_end - group_begin) / num_slabs;
+    for (size_t s = 0; s < num_slabs; ++s)
+    {
+      const size_t g0 = group_begin + s * groups_per_slab;
+      child_group_begins.push_back(g0);
+      child_num_parts.push_back(
+        std::accumulate(group_parts.begin() + static_cast<int64_t>(g0),
+                        group_parts.begin() +
+                          static_cast<int64_t>(g0 + groups_per_slab),
+                        size_t(0)));
+    }
+  }
+
+  const auto ends = SplitAlongAxis(points, weights, ids_begin, ids_end,
+                                   axes[level], child_num_parts, tolerance);
+
+  //======================================== Assign or recurse
+  size_t child_part_offset = part_offset;
+  size_t begin = 0;
+  for (size_t c = 0; c < child_num_parts.size(); ++c)
+  {
+    const auto child_begin = ids_begin + static_cast<int64_t>(begin);
+    const auto child_end = ids_begin + static_cast<int64_t>(ends[c]);
+    if (inner)
+      for (auto it = child_begin; it != child_end; ++it)
+        point_parts[*it] = static_cast<int64_t>(child_part_offset);
+    else
+    {
+      const size_t groups_per_slab =
+        (group_end - group_begin) / layout.num_slabs[level];
+      PartitionRecursive(points, weights, axes, layout,
+                         child_begin, child_end, level + 1,
+                         child_group_begins[c],
+                         child_group_begins[c] + groups_per_slab,
+                         child_part_offset, tolerance, point_parts);
+    }
+    child_part_offset += child_num_parts[c];
+    begin = ends[c];
+  }
+}
+
+// ###################################################################
+/**Number of distinct coordinates of the points along an axis.*/
+size_t CountPlanes(const std::vector<chi_mesh::Vector3>& points,
+                   const size_t axis,
+                   const double tolerance)
+{
+  std::vector<double> coords;
+  coords.reserve(points.size());
+  for (const auto& point : points)
+    coords.push_back(point[axis]);
+  std::sort(coords.begin(), coords.end());
+
+  size_t num_planes = coords.empty() ? 0 : 1;
+  for (size_t i = 1; i < coords.size(); ++i)
+    if (coords[i] - coords[i - 1] > tolerance) ++num_planes;
+  return num_planes;
+}
+} // namespace
+
+//###################################################################
+/** Partitions points KBA-style without prescribed partition counts.
+ *
+ * The axes with extent are z (outermost), x and y (innermost). The outer
+ * axes are cut into slabs and each resulting group of the innermost axis
+ * receives a whole number of parts, which differ by at most one between
+ * groups. Hence any number of parts can be used. The slab counts are
+ * chosen to minimize the number of sweep stages of a KBA sweep, i.e., the
+ * sum over the axes of the maximum number of parts along it, preferring
+ * equal groups and then the least cut area of blocks of the extents.
+ * Cuts are placed by weight, as for PartitionAlongHilbertCurve, and kept
+ * on planes of equal coordinates wherever possible.
+ *
+ * Returns the part of every point. When `layout_out` is given it receives
+ * a description of the decomposition.*/
+std::vector<int64_t>
+  chi_mesh::PartitionKBAAuto(const std::vector<Vector3>& points,
+                             const std::vector<double>& weights,
+                             const size_t num_parts,
+                             std::string* layout_out/*=nullptr*/)
+{
+  const size_t num_points = points.size();
+  std::vector<int64_t> point_parts(num_points, 0);
+  if (num_points == 0 or num_parts <= 1) return point_parts;
+
+  //======================================== Extents of the points
+  chi_mesh::Vector3 xyz_min = points.front();
+  chi_mesh::Vector3 xyz_max = xyz_min;
+  for (const auto& c : points)
+  {
+    xyz_min = {std::min(xyz_min.x, c.x),
+               std::min(xyz_min.y, c.y),
+               std::min(xyz_min.z, c.z)};
+    xyz_max = {std::max(xyz_max.x, c.x),
+               std::max(xyz_max.y, c.y),
+               std::max(xyz_max.z, c.z)};
+  }
+  const auto extents = xyz_max - xyz_min;
+  const double tolerance = 1.0e-10 * std::max(extents.Norm(), 1.0e-300);
+
+  std::vector<size_t> axes;
+  for (const size_t axis : {2, 0, 1})
+    if (extents[axis] > tolerance) axes.push_back(axis);
+  if (axes.empty()) axes.push_back(2);
+
+  std::vector<size_t> num_planes;
+  for (const size_t axis : axes)
+    num_planes.push_back(CountPlanes(points, axis, tolerance));
+
+  //======================================== Choose the slab counts
+  const size_t num_outer = axes.size() - 1;
+  const size_t P = num_parts;
+
+  typedef std::array<double,3> Cost; //stages, unequal groups, cut area
+  Cost best_cost = {1.0e300, 1.0e300, 1.0e300};
+  std::vector<size_t> best_slabs(num_outer, 1);
+
+  bool respect_planes = true;
+  auto Evaluate = [&](const std::vector<size_t>& slabs)
+  {
+    size_t num_groups = 1;
+    for (const size_t n : slabs) num_groups *= n;
+    if (num_groups > P) return;
+
+    const size_t parts_per_group = P / num_groups;
+    const size_t remainder = P % num_groups;
+    const size_t max_inner = parts_per_group + (remainder > 0 ? 1 : 0);
+    if (respect_planes and max_inner > num_planes.back()) return;
+
+    double stages = static_cast<double>(max_inner);
+    for (const size_t n : slabs) stages += static_cast<double>(n - 1);
+
+    std::vector<double> block(axes.size());
+    for (size_t a = 0; a < num_outer; ++a)
+      block[a] = extents[axes[a]] / static_cast<double>(slabs[a]);
+    block.back() = extents[axes.back()] * static_cast<double>(num_groups) /
+                   static_cast<double>(P);
+
+    double cut_area = 0.0;
+    if (block.size() == 1) cut_area = 1.0;
+    else if (block.size() == 2) cut_area = block[0] + block[1];
+    else
+      cut_area = block[0] * block[1] +
+                 block[1] * block[2] +
+                 block[0] * block[2];
+
+    const Cost cost = {stages, remainder > 0 ? 1.0 : 0.0, cut_area};
+    if (cost < best_cost)
+    {
+      best_cost = cost;
+      best_slabs = slabs;
+    }
+  };
+
+  //More parts than planes along the innermost axis, for every choice,
+  //leaves parts without points rather than failing
+  for (const bool respect : {true, false})
+  {
+    respect_planes = respect;
+    if (num_outer == 0)
+      Evaluate({});
+    else if (num_outer == 1)
+    {
+      for (size_t n0 = 1; n0 <= std::min(P, num_planes[0]); ++n0)
+        Evaluate({n0});
+    }
+    else
+    {
+      for (size_t n0 = 1; n0 <= std::min(P, num_planes[0]); ++n0)
+        for (size_t n1 = 1; n1 <= std::min(P / n0, num_planes[1]); ++n1)
+          Evaluate({n0, n1});
+    }
+    if (best_cost[0] < 1.0e300) break;
+  }
+
+  //======================================== Layout of the groups
+  KBALayout layout;
+  layout.num_slabs = best_slabs;
+  size_t num_groups = 1;
+  for (const size_t n : best_slabs) num_groups *= n;
+  layout.group_num_parts.assign(num_groups, P / num_groups);
+  for (size_t g = 0; g < P % num_groups; ++g)
+    ++layout.group_num_parts[g];
+
+  if (layout_out != nullptr)
+  {
+    const char axis_names[] = {'x', 'y', 'z'};
+    std::string description;
+    for (size_t a = 0; a < num_outer; ++a)
+      description += std::string(1, axis_names[axes[a]]) + "-slabs=" +
+                     std::to_string(best_slabs[a]) + " ";
+    description += std::string(1, axis_names[axes.back()]) + "-parts=" +
+                   std::to_string(layout.group_num_parts.back());
+    if (layout.group_num_parts.front() != layout.group_num_parts.back())
+      description += "-" + std::to_string(layout.group_num_parts.front());
+    *layout_out = description;
+  }
+
+  //======================================== Split recursively
+  std::vector<double> point_weights = weights;
+  double total_weight = 0.0;
+  for (const double weight : point_weights)
+    total_weight += weight;
+  if (point_weights.size() != num_points or total_weight <= 0.0)
+    point_weights.assign(num_points, 1.0);
+
+  std::vector<size_t> ids(num_points);
+  std::iota(ids.begin(), ids.end(), 0);
+
+  PartitionRecursive(points, point_weights, axes, layout,
+                     ids.begin(), ids.end(), /*level=*/0,
+                     /*group_begin=*/0, /*group_end=*/num_groups,
+                     /*part_offset=*/0, tolerance, point_parts);
+
+  return point_parts;
+}
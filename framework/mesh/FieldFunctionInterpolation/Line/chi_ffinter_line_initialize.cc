@@ -47,18 +47,14 @@ void chi_mesh::FieldFunctionInterpolationLine::
 
     //================================================== Find a home for each
     //                                                   point
-    for (const auto& cell : grid.local_cells)
-    {
-      for (int p=0; p < number_of_points_; p++)
+    const auto local_ids =
+      grid.FindLocalCellsContainingPoints(interpolation_points_);
+    for (int p=0; p < number_of_points_; p++)
+      if (local_ids[p] >= 0)
       {
-        const auto& point = interpolation_points_[p];
-        if (grid.CheckPointInsideCell(cell, point))
-        {
-          ff_context.interpolation_points_ass_cell[p] = cell.local_id_;
-          ff_context.interpolation_points_has_ass_cell[p] = true;
-        }
-      }//for point p
-    }//for cell
+        ff_context.interpolation_points_ass_cell[p] = local_ids[p];
+        ff_context.interpolation_points_has_ass_cell[p] = true;
+      }
   }//for ff
 
   Chi::log.Log0Verbose1() << "Finished initializing interpolator.";
@@ -7,6 +7,8 @@
 #include "chi_runtime.h"
 #include "chi_mpi.h"
 
+#include <limits>
+
 //###################################################################
 /**Initializes the point interpolator.*/
 void chi_mesh::FieldFunctionInterpolationPoint::Initialize()
@@ -14,58 +16,15 @@ void chi_mesh::FieldFunctionInterpolationPoint::Initialize()
   const std::string fname = "FieldFunctionInterpolationPoint::Initialize";
   const auto& grid = field_functions_.front()->SDM().Grid();
 
-  std::vector<uint64_t> cells_potentially_owning_point;
-  for (const auto& cell : grid.local_cells)
-  {
-    const auto& vcc = cell.centroid_;
-    const auto& poi = point_of_interest_;
-    const auto nudged_point = poi + 1.0e-6*(vcc-poi);
-    if (grid.CheckPointInsideCell(cell, nudged_point))
-      cells_potentially_owning_point.push_back(cell.global_id_);
-  }
-
-  const int local_count = static_cast<int>(cells_potentially_owning_point.size());
-  std::vector<int> locI_count(Chi::mpi.process_count,0);
-  MPI_Allgather(&local_count,      //sendbuf
-                1, MPI_INT,        //sendcount + sendtype
-                locI_count.data(), //recvbuf + recvtype
-                1, MPI_INT,        //recvcount + recvtype
-                Chi::mpi.comm);   //communicator
-
-  std::vector<int> recvdispls(Chi::mpi.process_count,0);
-
-  int running_count = 0;
-  for (int locI=0; locI< Chi::mpi.process_count; ++locI)
-  {
-    recvdispls[locI] = running_count;
-    running_count += locI_count[locI];
-  }
-
-  const auto& sendbuf = cells_potentially_owning_point;
-  std::vector<uint64_t> recvbuf(running_count, 0);
-  MPI_Allgatherv(sendbuf.data(),            //sendbuf
-                 local_count, MPI_UINT64_T, //sendcount + sendtype
-                 recvbuf.data(),            //recvbuf
-                 locI_count.data(),         //recvcount
-                 recvdispls.data(),         //recvdispl
-                 MPI_UINT64_T,              //recvtype
-                 Chi::mpi.comm);           //communicator
-
- if (recvbuf.empty())
-   throw std::logic_error(fname + ": No cell identified containing the point.");
-
- uint64_t owning_cell_gid = recvbuf.front();
- for (const uint64_t gid : recvbuf)
-   owning_cell_gid = std::min(owning_cell_gid, gid);
-
-  locally_owned_ = false;
- for (const uint64_t gid : cells_potentially_owning_point)
-   if (gid == owning_cell_gid)
-   {
-     locally_owned_ = true;
-     owning_cell_gid_ = owning_cell_gid;
-     break;
-   }
+  const uint64_t owning_cell_gid =
+    grid.FindCellsContainingPoints({point_of_interest_}).front();
+
+  if (owning_cell_gid == std::numeric_limits<uint64_t>::max())
+    throw std::logic_error(fname + ": No cell identified containing the point.");
+
+  locally_owned_ = grid.IsCellLocal(owning_cell_gid);
+  if (locally_owned_)
+    owning_cell_gid_ = owning_cell_gid;
 }
 
 //###################################################################
@@ -24,7 +24,9 @@ void chi_mesh::FieldFunctionInterpolationVolume::Initialize()
   const auto& grid = field_functions_.front()->SDM().Grid();
 
   //================================================== Find cells inside volume
+  const auto& cell_mask = logical_volume_->GetLocalCellMask(grid);
+  cell_local_ids_inside_logvol_.clear();
   for (const auto& cell : grid.local_cells)
-    if (logical_volume_->Inside(cell.centroid_))
+    if (cell_mask[cell.local_id_])
       cell_local_ids_inside_logvol_.push_back(cell.local_id_);
 }
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "chi_ffinter_volume_tallies.h"
+
+#include "mesh/LogicalVolume/LogicalVolume.h"
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <limits>
+
+//###################################################################
+/**Adds a tally and returns its index.*/
+size_t chi_mesh::FieldFunctionVolumeTallies::
+  AddTally(const std::string& name,
+           LogicalVolumePtr logical_volume,
+           FFPtr field_function,
+           const unsigned int component,
+           const ff_interpolation::Operation operation)
+{
+  using namespace ff_interpolation;
+  ChiInvalidArgumentIf(not logical_volume,
+                       "Null logical volume for tally \"" + name + "\".");
+  ChiInvalidArgumentIf(not field_function,
+                       "Null field function for tally \"" + name + "\".");
+  ChiInvalidArgumentIf(operation != Operation::OP_SUM and
+                       operation != Operation::OP_AVG and
+                       operation != Operation::OP_MAX,
+                       "Tally \"" + name + "\": Only the OP_SUM, OP_AVG "
+                       "and OP_MAX operations are supported.");
+  ChiInvalidArgumentIf(
+    component >= field_function->UnkManager().GetTotalUnknownStructureSize(),
+    "Tally \"" + name + "\": Invalid field function component.");
+  ChiInvalidArgumentIf(not field_functions_.empty() and
+                       &field_functions_.front()->SDM().Grid() !=
+                       &field_function->SDM().Grid(),
+                       "All field functions of the volume tallies must be "
+                       "on the same grid.");
+
+  size_t ff_index = 0;
+  while (ff_index < field_functions_.size() and
+         field_functions_[ff_index] != field_function)
+    ++ff_index;
+  if (ff_index == field_functions_.size())
+    field_functions_.push_back(std::move(field_function));
+
+  tallies_.push_back(
+    {name, std::move(logical_volume), ff_index, component, operation});
+  initialized_ = false;
+
+  return tallies_.size() - 1;
+}
+
+//###################################################################
+/**Determines the tallies each local cell belongs to.*/
+void chi_mesh::FieldFunctionVolumeTallies::Initialize()
+{
+  ChiLogicalErrorIf(tallies_.empty(), "No tallies were added.");
+
+  const auto& grid = field_functions_.front()->SDM().Grid();
+  const size_t num_cells = grid.local_cells.size();
+
+  //================================================== Count, then fill
+  cell_tally_offsets_.assign(num_cells + 1, 0);
+  std::vector<std::vector<size_t>> cell_tallies(num_cells);
+  for (size_t t = 0; t < tallies_.size(); ++t)
+  {
+    const auto& cell_mask = tallies_[t].logical_volume->GetLocalCellMask(grid);
+    for (size_t c = 0; c < num_cells; ++c)
+      if (cell_mask[c])
+        cell_tallies[c].push_back(t);
+  }
+
+  cell_tally_ids_.clear();
+  for (size_t c = 0; c < num_cells; ++c)
+  {
+    cell_tally_ids_.insert(cell_tally_ids_.end(),
+                           cell_tallies[c].begin(), cell_tallies[c].end());
+    cell_tally_offsets_[c + 1] = cell_tally_ids_.size();
+  }
+
+  initialized_ = true;
+
+  Chi::log.Log0Verbose1() << "Initialized " << tallies_.size()
+                          << " volume tallies.";
+}
+
+//###################################################################
+/**Evaluates all the tallies in a single pass over the local cells.*/
+void chi_mesh::FieldFunctionVolumeTallies::Execute()
+{
+  using namespace ff_interpolation;
+  if (not initialized_) Initialize();
+
+  const auto& grid = field_functions_.front()->SDM().Grid();
+  const size_t num_tallies = tallies_.size();
+
+  //================================================== Field data, once per
+  //                                                   field function
+  std::vector<std::vector<double>> field_data;
+  field_data.reserve(field_functions_.size());
+  for (const auto& ff : field_functions_)
+    field_data.push_back(ff->GetGhostedFieldVector());
+
+  //================================================== Accumulate
+  // Volume and sum per tally, in one buffer, and the max per tally
+  std::vector<double> local_sums(2 * num_tallies, 0.0);
+  std::vector<double> local_maxs(num_tallies,
+                                 std::numeric_limits<double>::lowest());
+
+  typedef chi_math::finite_element::InternalQuadraturePointData QPData;
+  std::vector<std::pair<const chi_math::SpatialDiscretization*, QPData>>
+    cell_qp_data;
+  std::vector<double> node_dof_values;
+
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = cell.local_id_;
+    if (cell_tally_offsets_[c] == cell_tally_offsets_[c + 1]) continue;
+
+    cell_qp_data.clear();
+    for (size_t k = cell_tally_offsets_[c]; k < cell_tally_offsets_[c + 1]; ++k)
+    {
+      const size_t t = cell_tally_ids_[k];
+      const auto& tally = tallies_[t];
+      const auto& ff = *field_functions_[tally.field_function_index];
+      const auto& ff_data = field_data[tally.field_function_index];
+      const auto& sdm = ff.SDM();
+      const auto& cell_mapping = sdm.GetCellMapping(cell);
+      const size_t num_nodes = cell_mapping.NumNodes();
+
+      //=========================================== Quadrature data, once per
+      //                                             discretization
+      auto qp_it = std::find_if(cell_qp_data.begin(), cell_qp_data.end(),
+                                [&sdm](const auto& entry)
+                                { return entry.first == &sdm; });
+      if (qp_it == cell_qp_data.end())
+      {
+        cell_qp_data.emplace_back(&sdm,
+                                  cell_mapping.MakeVolumeQuadraturePointData());
+        qp_it = cell_qp_data.end() - 1;
+      }
+      const auto& qp_data = qp_it->second;
+
+      node_dof_values.assign(num_nodes, 0.0);
+      for (size_t i = 0; i < num_nodes; ++i)
+      {
+        const int64_t imap =
+          sdm.MapDOFLocal(cell, i, ff.UnkManager(), 0, tally.component);
+        node_dof_values[i] = ff_data[imap];
+      }
+
+      double& local_max = local_maxs[t];
+      for (const double value : node_dof_values)
+        local_max = std::fmax(value, local_max);
+
+      for (const size_t qp : qp_data.QuadraturePointIndices())
+      {
+        double ff_value = 0.0;
+        for (size_t j = 0; j < num_nodes; ++j)
+          ff_value += qp_data.ShapeValue(j, qp) * node_dof_values[j];
+
+        local_sums[2 * t] += qp_data.JxW(qp);
+        local_sums[2 * t + 1] += ff_value * qp_data.JxW(qp);
+        local_max = std::fmax(ff_value, local_max);
+      }//for qp
+    }//for tally
+  }//for cell
+
+  //================================================== Reduce all tallies
+  std::vector<double> global_sums(2 * num_tallies, 0.0);
+  MPI_Allreduce(local_sums.data(),                // sendbuf
+                global_sums.data(),               // recvbuf
+                static_cast<int>(2 * num_tallies),
+                MPI_DOUBLE,                       // count + datatype
+                MPI_SUM,                          // operation
+                Chi::mpi.comm);                   // communicator
+
+  const bool has_max =
+    std::any_of(tallies_.begin(), tallies_.end(), [](const Tally& tally)
+                { return tally.operation == Operation::OP_MAX; });
+
+  std::vector<double> global_maxs(num_tallies, 0.0);
+  if (has_max)
+    MPI_Allreduce(local_maxs.data(),              // sendbuf
+                  global_maxs.data(),             // recvbuf
+                  static_cast<int>(num_tallies),
+                  MPI_DOUBLE,                     // count + datatype
+                  MPI_MAX,                        // operation
+                  Chi::mpi.comm);                 // communicator
+
+  values_.assign(num_tallies, 0.0);
+  for (size_t t = 0; t < num_tallies; ++t)
+  {
+    const double volume = global_sums[2 * t];
+    const double sum = global_sums[2 * t + 1];
+    switch (tallies_[t].operation)
+    {
+      case Operation::OP_SUM: values_[t] = sum; break;
+      case Operation::OP_AVG: values_[t] = sum / volume; break;
+      case Operation::OP_MAX: values_[t] = global_maxs[t]; break;
+      default: break;
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef CHITECH_CHI_FFINTER_VOLUME_TALLIES_H
+#define CHITECH_CHI_FFINTER_VOLUME_TALLIES_H
+
+#include "../chi_ffinterpolation.h"
+#include "ChiObject.h"
+
+#include <string>
+
+namespace chi_mesh
+{
+class LogicalVolume;
+
+//###################################################################
+/**Evaluates many volume tallies, i.e., the volume sum, average or max of
+ * a field function component over a logical volume, at once. The
+ * membership of the local cells in the tallies is determined once by
+ * Initialize, after which Execute makes a single pass over the local
+ * cells, evaluating the quadrature point data of each cell once for all
+ * its tallies, and combines all the tallies with one sum reduction, plus
+ * one max reduction if there are OP_MAX tallies.
+ *
+ * The Lua operations are not supported. All field functions must be
+ * defined on the same grid.*/
+class FieldFunctionVolumeTallies : public ChiObject
+{
+public:
+  typedef std::shared_ptr<const LogicalVolume> LogicalVolumePtr;
+  typedef std::shared_ptr<const chi_physics::FieldFunctionGridBased> FFPtr;
+
+private:
+  struct Tally
+  {
+    std::string name;
+    LogicalVolumePtr logical_volume;
+    size_t field_function_index;
+    unsigned int component;
+    ff_interpolation::Operation operation;
+  };
+
+  std::vector<Tally> tallies_;
+  std::vector<FFPtr> field_functions_;
+
+  /**CSR map of local cells to the tallies they belong to.*/
+  std::vector<size_t> cell_tally_offsets_;
+  std::vector<size_t> cell_tally_ids_;
+  bool initialized_ = false;
+
+  std::vector<double> values_;
+
+public:
+  /**Adds a tally and returns its index. Invalidates the initialization.*/
+  size_t AddTally(const std::string& name,
+                  LogicalVolumePtr logical_volume,
+                  FFPtr field_function,
+                  unsigned int component,
+                  ff_interpolation::Operation operation);
+
+  /**Determines the tallies each local cell belongs to.*/
+  void Initialize();
+
+  /**Evaluates all the tallies. Initializes first if needed. This is a
+   * collective call.*/
+  void Execute();
+
+  size_t NumTallies() const { return tallies_.size(); }
+  const std::string& TallyName(size_t t) const { return tallies_.at(t).name; }
+  /**The tally values in order of addition, as of the last Execute.*/
+  const std::vector<double>& Values() const { return values_; }
+};
+
+}//namespace chi_mesh
+
+#endif //CHITECH_CHI_FFINTER_VOLUME_TALLIES_H
@@ -1,4 +1,5 @@
 #include "chi_lua.h"
+#include "lua/lua_buffer.h"
 #include "mesh/FieldFunctionInterpolation/Point/chi_ffinter_point.h"
 #include "mesh/FieldFunctionInterpolation/Line/chi_ffinter_line.h"
 #include "mesh/FieldFunctionInterpolation/Volume/chi_ffinter_volume.h"
@@ -20,12 +21,17 @@ RegisterLuaFunctionAsIs(chiFFInterpolationGetValue);
  * interpolation type has an associated value.
  *
 \param FFIHandle int Handle to the field function interpolation.
+\param AsBuffers bool Optional. For the LINE type, returns the values of
+       each field function as a read only buffer over the values of the
+       interpolation, instead of copying them into a table. Default false.
 
 ###Note:
 Currently only the POINT, LINE and VOLUME interpolation supports obtaining a
 value. For the POINT and VOLUME types a single value is returned. For the LINE
 type a table of tables is returned with the first index being the field function
 (in the order it was assigned) and the second index being the point index.
+With `AsBuffers` the inner tables are buffers, see chiBufferCreate, which are
+only valid until the interpolation is executed again.
 
 \ingroup LuaFFInterpol
 \author Jan*/
@@ -34,9 +40,16 @@ int chiFFInterpolationGetValue(lua_State *L)
   const std::string fname = __FUNCTION__;
 
   int num_args = lua_gettop(L);
-  if (num_args != 1)
+  if (num_args != 1 and num_args != 2)
     LuaPostArgAmountError("chiFFInterpolationGetValue",1,num_args);
 
+  bool as_buffers = false;
+  if (num_args == 2)
+  {
+    LuaCheckBoolValue(fname, L, 2);
+    as_buffers = lua_toboolean(L, 2);
+  }
+
   //================================================== Get handle to field function
   const size_t ffihandle = lua_tonumber(L,1);
 
@@ -62,8 +75,19 @@ int chiFFInterpolationGetValue(lua_State *L)
     {
       lua_pushnumber(L,ff+1);
 
-      lua_newtable(L);
       const auto& ff_ctx = cur_ffi_line.GetFFContexts()[ff];
+      if (as_buffers)
+      {
+        chi_lua::PushBuffer(
+          L,
+          chi_lua::LuaBuffer::FromVector(
+            std::shared_ptr<const std::vector<double>>(
+              p_ffi, &ff_ctx.interpolation_points_values)));
+        lua_settable(L,-3);
+        continue;
+      }
+
+      lua_newtable(L);
 
       for (int p=0; p<cur_ffi_line.GetInterpolationPoints().size(); p++)
       {
@@ -10,4 +10,9 @@ int chiFFInterpolationExecute(lua_State *L);
 int chiFFInterpolationExportPython(lua_State *L);
 int chiFFInterpolationGetValue(lua_State *L);
 
+int chiVolumeTalliesCreate(lua_State *L);
+int chiVolumeTalliesAdd(lua_State *L);
+int chiVolumeTalliesExecute(lua_State *L);
+int chiVolumeTalliesGetValues(lua_State *L);
+
 #endif //CHITECH_FFINTERPOL_LUA_H
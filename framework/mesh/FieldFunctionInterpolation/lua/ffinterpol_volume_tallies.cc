@@ -0,0 +1,150 @@
+#include "chi_lua.h"
+
+#include "mesh/FieldFunctionInterpolation/Volume/chi_ffinter_volume_tallies.h"
+#include "mesh/LogicalVolume/LogicalVolume.h"
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "ffinterpol_lua.h"
+#include "console/chi_console.h"
+
+RegisterLuaFunctionAsIs(chiVolumeTalliesCreate);
+RegisterLuaFunctionAsIs(chiVolumeTalliesAdd);
+RegisterLuaFunctionAsIs(chiVolumeTalliesExecute);
+RegisterLuaFunctionAsIs(chiVolumeTalliesGetValues);
+
+//#############################################################################
+/** Creates a set of volume tallies, evaluated together in a single pass over
+ * the cells with a single reduction. Prefer this over one volume
+ * interpolation per tally when there are many tallies, e.g., pin powers.
+ *
+\return Handle int Handle to the volume tallies.
+
+\ingroup LuaFFInterpol*/
+int chiVolumeTalliesCreate(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 0) LuaPostArgAmountError(fname, 0, num_args);
+
+  auto tallies = std::make_shared<chi_mesh::FieldFunctionVolumeTallies>();
+  Chi::object_stack.push_back(tallies);
+
+  lua_pushinteger(L, static_cast<lua_Integer>(Chi::object_stack.size() - 1));
+  return 1;
+}
+
+//#############################################################################
+/** Adds a tally to a set of volume tallies.
+ *
+\param Handle int Handle to the volume tallies.
+\param Name char Name of the tally.
+\param LVHandle int Handle to the logical volume.
+\param FFHandle int Global handle to the grid-based field function.
+\param Operation int OP_SUM, OP_AVG or OP_MAX. The Lua operations are not
+                     supported.
+\param Component int Optional. The field function component. Default 0.
+
+\return Index int The 1-based index of the tally in the values returned by
+                  chiVolumeTalliesGetValues.
+
+\ingroup LuaFFInterpol*/
+int chiVolumeTalliesAdd(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 5 and num_args != 6)
+    LuaPostArgAmountError(fname, 5, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+  LuaCheckNumberValue(fname, L, 3);
+  LuaCheckNumberValue(fname, L, 4);
+  LuaCheckNumberValue(fname, L, 5);
+
+  auto& tallies = Chi::GetStackItem<chi_mesh::FieldFunctionVolumeTallies>(
+    Chi::object_stack, lua_tointeger(L, 1), fname);
+  const std::string name = lua_tostring(L, 2);
+
+  auto logical_volume = Chi::GetStackItemPtrAsType<chi_mesh::LogicalVolume>(
+    Chi::object_stack, lua_tointeger(L, 3), fname);
+
+  auto ff_base = Chi::GetStackItemPtr(Chi::field_function_stack,
+                                      lua_tointeger(L, 4), fname);
+  auto ff =
+    std::dynamic_pointer_cast<chi_physics::FieldFunctionGridBased>(ff_base);
+  ChiLogicalErrorIf(not ff, fname + ": Only grid-based field functions can "
+                                    "be tallied.");
+
+  const auto operation =
+    static_cast<chi_mesh::ff_interpolation::Operation>(lua_tointeger(L, 5));
+
+  unsigned int component = 0;
+  if (num_args == 6)
+  {
+    LuaCheckIntegerValue(fname, L, 6);
+    component = static_cast<unsigned int>(lua_tointeger(L, 6));
+  }
+
+  const size_t index =
+    tallies.AddTally(name, logical_volume, ff, component, operation);
+
+  lua_pushinteger(L, static_cast<lua_Integer>(index + 1));
+  return 1;
+}
+
+//#############################################################################
+/** Evaluates all the tallies of a set of volume tallies. This is a
+ * collective call.
+ *
+\param Handle int Handle to the volume tallies.
+
+\ingroup LuaFFInterpol*/
+int chiVolumeTalliesExecute(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1) LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+
+  auto& tallies = Chi::GetStackItem<chi_mesh::FieldFunctionVolumeTallies>(
+    Chi::object_stack, lua_tointeger(L, 1), fname);
+
+  tallies.Execute();
+
+  return 0;
+}
+
+//#############################################################################
+/** Gets the values of a set of volume tallies as of the last execution.
+ *
+\param Handle int Handle to the volume tallies.
+
+\return Values table The tally values, in the order the tallies were added.
+
+\ingroup LuaFFInterpol*/
+int chiVolumeTalliesGetValues(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1) LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+
+  const auto& tallies =
+    Chi::GetStackItem<chi_mesh::FieldFunctionVolumeTallies>(
+      Chi::object_stack, lua_tointeger(L, 1), fname);
+
+  const auto& values = tallies.Values();
+  lua_createtable(L, static_cast<int>(values.size()), 0);
+  for (size_t t = 0; t < values.size(); ++t)
+  {
+    lua_pushnumber(L, values[t]);
+    lua_rawseti(L, -2, static_cast<lua_Integer>(t + 1));
+  }
+
+  return 1;
+}
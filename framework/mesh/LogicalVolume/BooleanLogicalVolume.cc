@@ -80,4 +80,37 @@ bool BooleanLogicalVolume::Inside(const chi_mesh::Vector3& point) const
   return true;
 }
 
+// ###################################################################
+/**Evaluates the parts batch-wise, each on the points not yet excluded by
+ * the previous parts.*/
+std::vector<bool> BooleanLogicalVolume::InsideBatch(
+  const std::vector<chi_mesh::Vector3>& points) const
+{
+  std::vector<size_t> candidates(points.size());
+  for (size_t p = 0; p < points.size(); ++p)
+    candidates[p] = p;
+
+  std::vector<chi_mesh::Vector3> candidate_points;
+  for (const auto& [sense, part] : parts)
+  {
+    if (candidates.empty()) break;
+
+    candidate_points.clear();
+    for (const size_t p : candidates)
+      candidate_points.push_back(points[p]);
+
+    const auto inside = part->InsideBatch(candidate_points);
+
+    size_t num_remaining = 0;
+    for (size_t k = 0; k < candidates.size(); ++k)
+      if (inside[k] == sense) candidates[num_remaining++] = candidates[k];
+    candidates.resize(num_remaining);
+  }
+
+  std::vector<bool> inside(points.size(), false);
+  for (const size_t p : candidates)
+    inside[p] = true;
+  return inside;
+}
+
 } // namespace chi_mesh
\ No newline at end of file
@@ -17,6 +17,8 @@ public:
   explicit BooleanLogicalVolume(const chi::InputParameters& params);
 
   bool Inside(const chi_mesh::Vector3& point) const override;
+  std::vector<bool>
+  InsideBatch(const std::vector<chi_mesh::Vector3>& points) const override;
 };
 
 }
@@ -1,5 +1,7 @@
 #include "LogicalVolume.h"
 
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
 namespace chi_mesh
 {
 
@@ -13,4 +15,36 @@ LogicalVolume::LogicalVolume(const chi::InputParameters& params)
 {
 }
 
-} // namespace chi_mesh
\ No newline at end of file
+// ###################################################################
+/**Evaluates Inside point by point.*/
+std::vector<bool>
+LogicalVolume::InsideBatch(const std::vector<chi_mesh::Vector3>& points) const
+{
+  std::vector<bool> inside(points.size(), false);
+  for (size_t p = 0; p < points.size(); ++p)
+    inside[p] = Inside(points[p]);
+  return inside;
+}
+
+// ###################################################################
+/**Returns the cached mask of the local cells with their centroid inside
+ * the volume.*/
+const std::vector<bool>&
+LogicalVolume::GetLocalCellMask(const MeshContinuum& grid) const
+{
+  auto& cell_mask = cell_masks_[&grid];
+  if (cell_mask.mask.size() != grid.local_cells.size() or
+      cell_mask.cells_state != grid.CellsState())
+  {
+    std::vector<chi_mesh::Vector3> centroids;
+    centroids.reserve(grid.local_cells.size());
+    for (const auto& cell : grid.local_cells)
+      centroids.push_back(cell.centroid_);
+
+    cell_mask.mask = InsideBatch(centroids);
+    cell_mask.cells_state = grid.CellsState();
+  }
+  return cell_mask.mask;
+}
+
+} // namespace chi_mesh
@@ -6,6 +6,8 @@
 #include "../chi_mesh.h"
 #include <chi_log.h>
 #include <array>
+#include <map>
+#include <vector>
 
 namespace chi_mesh
 {
@@ -19,9 +21,28 @@ public:
 
   virtual bool Inside(const chi_mesh::Vector3& point) const { return false; }
 
+  /**Evaluates Inside for a batch of points. Volumes for which a batch
+   * can be evaluated faster than point by point override this.*/
+  virtual std::vector<bool>
+  InsideBatch(const std::vector<chi_mesh::Vector3>& points) const;
+
+  /**Returns, by local id, whether the centroid of each local cell of the
+   * grid is inside the volume. The mask is cached per grid and recomputed
+   * once the grid's cells change, hence the call that (re)computes it is
+   * not thread safe.*/
+  const std::vector<bool>& GetLocalCellMask(const MeshContinuum& grid) const;
+
 protected:
   explicit LogicalVolume() : ChiObject() {}
   explicit LogicalVolume(const chi::InputParameters& parameters);
+
+private:
+  struct CellMask
+  {
+    std::array<size_t, 3> cells_state = {0, 0, 0};
+    std::vector<bool> mask;
+  };
+  mutable std::map<const MeshContinuum*, CellMask> cell_masks_;
 };
 
 } // namespace chi_mesh
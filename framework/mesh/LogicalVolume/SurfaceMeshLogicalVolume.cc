@@ -2,10 +2,12 @@
 
 #include "mesh/chi_mesh.h"
 #include "mesh/SurfaceMesh/chi_surfacemesh.h"
-#include "mesh/Raytrace/raytracing.h"
 
 #include "ChiObjectFactory.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <utility>
 
 namespace chi_mesh
@@ -62,14 +64,102 @@ SurfaceMeshLogicalVolume::SurfaceMeshLogicalVolume(
       zbounds_[1] = std::max(zbounds_[1],z);
     }
   }
+
+  BuildBVH();
+}
+
+// ###################################################################
+/**Builds the hierarchy top-down, splitting the triangles of a node at the
+ * median of their centroids along the longest extent of the centroids,
+ * until a node holds at most a few triangles. The median splits keep the
+ * depth logarithmic, also for the strongly nonuniform triangle sizes of
+ * CAD surfaces.*/
+void SurfaceMeshLogicalVolume::BuildBVH()
+{
+  constexpr size_t max_leaf_size = 4;
+
+  const auto& vertices = surf_mesh->GetVertices();
+  const auto& triangles = surf_mesh->GetTriangles();
+  const size_t num_triangles = triangles.size();
+
+  //======================================== Projected triangle bounds
+  std::vector<std::array<double, 4>> tri_bounds(num_triangles);
+  std::vector<std::array<double, 2>> tri_centroids(num_triangles);
+  for (size_t t = 0; t < num_triangles; ++t)
+  {
+    auto& bounds = tri_bounds[t];
+    bounds = {1.0e300, 1.0e300, -1.0e300, -1.0e300};
+    for (const int v : triangles[t].v_index)
+    {
+      bounds[0] = std::min(bounds[0], vertices[v].x);
+      bounds[1] = std::min(bounds[1], vertices[v].y);
+      bounds[2] = std::max(bounds[2], vertices[v].x);
+      bounds[3] = std::max(bounds[3], vertices[v].y);
+    }
+    tri_centroids[t] = {0.5 * (bounds[0] + bounds[2]),
+                        0.5 * (bounds[1] + bounds[3])};
+  }
+
+  bvh_triangle_ids_.resize(num_triangles);
+  for (size_t t = 0; t < num_triangles; ++t)
+    bvh_triangle_ids_[t] = t;
+
+  bvh_nodes_.clear();
+  bvh_nodes_.reserve(2 * (num_triangles / max_leaf_size + 1));
+  bvh_nodes_.push_back({{}, {}, 0, num_triangles});
+
+  //======================================== Split nodes
+  std::vector<size_t> stack = {0};
+  while (not stack.empty())
+  {
+    const size_t n = stack.back();
+    stack.pop_back();
+
+    const size_t first = bvh_nodes_[n].first;
+    const size_t count = bvh_nodes_[n].count;
+    const auto begin = bvh_triangle_ids_.begin() + first;
+    const auto end = begin + count;
+
+    std::array<double, 2> min_xy = {1.0e300, 1.0e300};
+    std::array<double, 2> max_xy = {-1.0e300, -1.0e300};
+    std::array<double, 2> min_c = {1.0e300, 1.0e300};
+    std::array<double, 2> max_c = {-1.0e300, -1.0e300};
+    for (auto it = begin; it != end; ++it)
+      for (unsigned int d = 0; d < 2; ++d)
+      {
+        min_xy[d] = std::min(min_xy[d], tri_bounds[*it][d]);
+        max_xy[d] = std::max(max_xy[d], tri_bounds[*it][d + 2]);
+        min_c[d] = std::min(min_c[d], tri_centroids[*it][d]);
+        max_c[d] = std::max(max_c[d], tri_centroids[*it][d]);
+      }
+    bvh_nodes_[n].min_xy = min_xy;
+    bvh_nodes_[n].max_xy = max_xy;
+
+    if (count <= max_leaf_size) continue;
+
+    const unsigned int axis =
+      (max_c[0] - min_c[0]) >= (max_c[1] - min_c[1]) ? 0 : 1;
+    const auto mid = begin + static_cast<std::ptrdiff_t>(count / 2);
+    std::nth_element(begin, mid, end,
+                     [&tri_centroids, axis](size_t ta, size_t tb)
+                     { return tri_centroids[ta][axis] <
+                              tri_centroids[tb][axis]; });
+
+    const size_t left = bvh_nodes_.size();
+    bvh_nodes_.push_back({{}, {}, first, count / 2});
+    bvh_nodes_.push_back({{}, {}, first + count / 2, count - count / 2});
+    bvh_nodes_[n].first = left;
+    bvh_nodes_[n].count = 0;
+
+    stack.push_back(left);
+    stack.push_back(left + 1);
+  }//while nodes to split
 }
 
 // ###################################################################
 /**Logical operation for surface mesh.*/
 bool SurfaceMeshLogicalVolume::Inside(const chi_mesh::Vector3& point) const
 {
-  double tolerance = 1.0e-5;
-
   //============================================= Boundbox check
   double x = point.x;
   double y = point.y;
@@ -79,131 +169,80 @@ bool SurfaceMeshLogicalVolume::Inside(const chi_mesh::Vector3& point) const
   if (not((y >= ybounds_[0]) and (y <= ybounds_[1]))) return false;
   if (not((z >= zbounds_[0]) and (z <= zbounds_[1]))) return false;
 
-  //============================================= Cheapshot pass
-  // This pass purely checks if the point have a
-  // negative sense with all the faces of the surface.
-  // If it does then .. bonus .. we don't need to do
-  // anything more because the surface is probably convex.
-  bool cheap_pass = true; // now try to disprove
-  for (auto& face : surf_mesh->GetTriangles())
-  {
-    chi_mesh::Vector3 fc = face.face_centroid;
-    chi_mesh::Vector3 p_to_fc = fc - point;
+  //============================================= Perturb the ray
+  // Shifting the ray by a tiny, irrational fraction of the size of the
+  // surface keeps it from passing exactly through edges and vertices,
+  // which would make crossings count twice or not at all.
+  const double scale = (xbounds_[1] - xbounds_[0]) +
+                       (ybounds_[1] - ybounds_[0]) +
+                       (zbounds_[1] - zbounds_[0]);
+  x += 0.7548776662 * 1.0e-9 * scale;
+  y += 0.5698402910 * 1.0e-9 * scale;
+
+  //============================================= Count crossings along +z
+  const auto& vertices = surf_mesh->GetVertices();
+  const auto& triangles = surf_mesh->GetTriangles();
 
-    p_to_fc = p_to_fc / p_to_fc.Norm();
+  auto Orient = [x, y](const chi_mesh::Vertex& a, const chi_mesh::Vertex& b)
+  { return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x); };
 
-    double sense = p_to_fc.Dot(face.geometric_normal);
+  size_t num_crossings = 0;
+  // Median splits bound the depth by the bits of the triangle count
+  std::array<size_t, 2 * 64> stack;
+  size_t stack_size = 0;
+  if (not bvh_nodes_.empty()) stack[stack_size++] = 0;
+  while (stack_size > 0)
+  {
+    const auto& node = bvh_nodes_[stack[--stack_size]];
+    if (x < node.min_xy[0] or x > node.max_xy[0] or
+        y < node.min_xy[1] or y > node.max_xy[1])
+      continue;
 
-    if (sense < (0.0 - tolerance))
+    if (node.count == 0)
     {
-      cheap_pass = false;
-      break;
+      stack[stack_size++] = node.first;
+      stack[stack_size++] = node.first + 1;
+      continue;
     }
-  } // for f
 
-  // if (!cheap_pass) return false;
-  if (cheap_pass) return true;
-
-  //============================================= Expensive pass
-  // Getting to here means the cheap pass produced
-  // a negative and now we need to do more work.
-  for (size_t f = 0; f < surf_mesh->GetTriangles().size(); f++)
-  {
-    chi_mesh::Vector3 fc = surf_mesh->GetTriangles()[f].face_centroid;
-    chi_mesh::Vector3 p_to_fc = fc - point;
-    double distance_to_face = p_to_fc.Norm();
-    double closest_distance = 1.0e16;
-    bool closest_sense_pos = false;
-
-    p_to_fc = p_to_fc / p_to_fc.Norm();
+    for (size_t k = node.first; k < node.first + node.count; ++k)
+    {
+      const auto& triangle = triangles[bvh_triangle_ids_[k]];
+      const auto& v0 = vertices[triangle.v_index[0]];
+      const auto& v1 = vertices[triangle.v_index[1]];
+      const auto& v2 = vertices[triangle.v_index[2]];
+
+      // Unnormalized barycentric coordinates of the projected point
+      const double w0 = Orient(v1, v2);
+      const double w1 = Orient(v2, v0);
+      const double w2 = Orient(v0, v1);
+
+      const bool inside_projection = (w0 > 0.0 and w1 > 0.0 and w2 > 0.0) or
+                                     (w0 < 0.0 and w1 < 0.0 and w2 < 0.0);
+      if (not inside_projection) continue;
+
+      const double z_crossing =
+        (w0 * v0.z + w1 * v1.z + w2 * v2.z) / (w0 + w1 + w2);
+      if (z_crossing > z) ++num_crossings;
+    } // for triangle in leaf
+  }//while nodes to visit
+
+  return num_crossings % 2 == 1;
+}
 
-    double sense = p_to_fc.Dot(surf_mesh->GetTriangles()[f].geometric_normal);
+// ###################################################################
+/**Evaluates the points concurrently. The results are gathered in bytes,
+ * since the bits of a std::vector<bool> cannot be written concurrently.*/
+std::vector<bool> SurfaceMeshLogicalVolume::InsideBatch(
+  const std::vector<chi_mesh::Vector3>& points) const
+{
+  const auto num_points = static_cast<int64_t>(points.size());
+  std::vector<char> inside_bytes(points.size(), 0);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int64_t p = 0; p < num_points; ++p)
+    inside_bytes[p] = Inside(points[p]) ? 1 : 0;
 
-    bool good_to_go = true;
-    if (sense < (0.0 - tolerance))
-    {
-      good_to_go = false;
-      for (size_t fi = 0; fi < surf_mesh->GetTriangles().size(); fi++)
-      {
-        if (fi == f) continue; // Skip same face
-
-        // Get all the vertices
-        int v0_i = surf_mesh->GetTriangles()[fi].v_index[0];
-        int v1_i = surf_mesh->GetTriangles()[fi].v_index[1];
-        int v2_i = surf_mesh->GetTriangles()[fi].v_index[2];
-        chi_mesh::Vertex v0 = surf_mesh->GetVertices()[v0_i];
-        chi_mesh::Vertex v1 = surf_mesh->GetVertices()[v1_i];
-        chi_mesh::Vertex v2 = surf_mesh->GetVertices()[v2_i];
-
-        //=========================== Check if the line intersects plane
-        chi_mesh::Vertex intp; // Intersection point
-        std::pair<double, double> weights;
-        bool intersects_plane = chi_mesh::CheckPlaneLineIntersect(
-          surf_mesh->GetTriangles()[fi].geometric_normal,
-          v0,
-          point,
-          fc,
-          intp,
-          &weights);
-        if (!intersects_plane) continue;
-
-        //=========================== Check if the line intersects the triangle
-        bool intersects_triangle = true;
-
-        // Compute the legs
-        chi_mesh::Vector3 v01 = v1 - v0;
-        chi_mesh::Vector3 v12 = v2 - v1;
-        chi_mesh::Vector3 v20 = v0 - v2;
-
-        // Compute the vertices to the point
-        chi_mesh::Vector3 v0p = intp - v0;
-        chi_mesh::Vector3 v1p = intp - v1;
-        chi_mesh::Vector3 v2p = intp - v2;
-
-        // Compute the cross products
-        chi_mesh::Vector3 x0p = v01.Cross(v0p);
-        chi_mesh::Vector3 x1p = v12.Cross(v1p);
-        chi_mesh::Vector3 x2p = v20.Cross(v2p);
-
-        // Normalize them
-        x0p = x0p / x0p.Norm();
-        x1p = x1p / x1p.Norm();
-        x2p = x2p / x2p.Norm();
-
-        chi_mesh::Vector3 face_norm =
-          surf_mesh->GetTriangles()[fi].geometric_normal /
-          surf_mesh->GetTriangles()[fi].geometric_normal.Norm();
-
-        if (x0p.Dot(face_norm) < 0.0) intersects_triangle = false;
-        if (x1p.Dot(face_norm) < 0.0) intersects_triangle = false;
-        if (x2p.Dot(face_norm) < 0.0) intersects_triangle = false;
-
-        if (!intersects_triangle) continue;
-
-        //============================ Determine the sense with the triangle
-        double sense_with_this_tri =
-          p_to_fc.Dot(surf_mesh->GetTriangles()[fi].geometric_normal);
-        double distance_to_triangle = weights.second * distance_to_face;
-
-        if (distance_to_triangle < closest_distance)
-        {
-          closest_distance = distance_to_triangle;
-
-          if (sense_with_this_tri > 0.0) closest_sense_pos = true;
-          else
-            closest_sense_pos = false;
-        } //
-
-      } // for inner iter face
-    }   // if sense negative
-
-    if ((closest_distance < distance_to_face) && closest_sense_pos)
-      good_to_go = true;
-
-    if (!good_to_go) return false;
-  } // for f
-
-  return true;
+  return std::vector<bool>(inside_bytes.begin(), inside_bytes.end());
 }
 
 } // namespace chi_mesh
@@ -7,7 +7,10 @@ namespace chi_mesh
 {
 
 // ###################################################################
-/**SurfaceMesh volume*/
+/**SurfaceMesh volume. The surface must be closed. A point is inside if a
+ * ray from it along +z crosses the surface an odd number of times, which
+ * is evaluated using a bounding volume hierarchy of the xy-projections of
+ * the triangles, built once with the volume.*/
 class SurfaceMeshLogicalVolume : public LogicalVolume
 {
 public:
@@ -16,12 +19,32 @@ public:
 
   bool Inside(const chi_mesh::Vector3& point) const override;
 
+  /**Evaluates Inside for the points concurrently.*/
+  std::vector<bool>
+  InsideBatch(const std::vector<chi_mesh::Vector3>& points) const override;
+
 private:
   typedef std::shared_ptr<const chi_mesh::SurfaceMesh> SurfaceMeshPtr;
   const SurfaceMeshPtr surf_mesh = nullptr;
   std::array<double, 2> xbounds_;
   std::array<double, 2> ybounds_;
   std::array<double, 2> zbounds_;
+
+  /**Node of the hierarchy, bounding the xy-projections of its triangles.
+   * Leaves hold `count` triangles from `first` in `bvh_triangle_ids_`,
+   * interior nodes have `count` zero and their two children at `first`
+   * and `first + 1`.*/
+  struct BVHNode
+  {
+    std::array<double, 2> min_xy = {0.0, 0.0};
+    std::array<double, 2> max_xy = {0.0, 0.0};
+    size_t first = 0;
+    size_t count = 0;
+  };
+  std::vector<BVHNode> bvh_nodes_;
+  std::vector<size_t> bvh_triangle_ids_;
+
+  void BuildBVH();
 };
 
 }
@@ -18,6 +18,7 @@ namespace chi_mesh
   class MeshContinuum;
   class Cell;
   class CellFace;
+  class CellIDMap;
 
   //00
   void UploadCellGeometryDiscontinuous(const chi_mesh::MeshContinuum& grid,
@@ -26,11 +27,14 @@ namespace chi_mesh
                                        vtkNew<vtkPoints>& points,
                                        vtkNew<vtkUnstructuredGrid>& ugrid);
   void UploadCellGeometryContinuous(const chi_mesh::Cell &cell,
-                                    const std::vector<uint64_t>& vertex_map,
+                                    const CellIDMap& vertex_map,
                                     vtkNew<vtkUnstructuredGrid>& ugrid);
   void UploadFaceGeometry(const chi_mesh::CellFace& cell_face,
-                          const std::vector<uint64_t>& vertex_map,
+                          const CellIDMap& vertex_map,
                           vtkNew<vtkUnstructuredGrid> &ugrid);
+  CellIDMap UploadVertices(const chi_mesh::MeshContinuum& grid,
+                           std::vector<uint64_t> vertex_ids,
+                           vtkNew<vtkPoints>& points);
 
   //01 Utils for Reading
   typedef vtkSmartPointer<vtkUnstructuredGrid> vtkUGridPtr;
@@ -61,6 +65,8 @@ namespace chi_mesh
   vtkNew<vtkUnstructuredGrid>
     PrepareVtkUnstructuredGrid(const chi_mesh::MeshContinuum& grid,
                               bool discontinuous = true);
+  vtkNew<vtkUnstructuredGrid>
+    PrepareVtkBoundaryUnstructuredGrid(const chi_mesh::MeshContinuum& grid);
 
   void WritePVTUFiles(vtkNew<vtkUnstructuredGrid> &ugrid,
                       const std::string &file_base_name);
@@ -5,6 +5,8 @@
 #include <vtkPoints.h>
 #include <vtkUnstructuredGrid.h>
 
+#include <algorithm>
+
 //###################################################################
 /**Uploads vertices and cells to an unstructured grid.*/
 void chi_mesh::UploadCellGeometryDiscontinuous(const chi_mesh::MeshContinuum &grid,
@@ -97,14 +99,14 @@ void chi_mesh::UploadCellGeometryDiscontinuous(const chi_mesh::MeshContinuum &gr
 /**Uploads vertices and cells to an unstructured grid.*/
 void chi_mesh::
   UploadCellGeometryContinuous(const chi_mesh::Cell &cell,
-                               const std::vector<uint64_t>& vertex_map,
+                               const CellIDMap& vertex_map,
                                vtkNew<vtkUnstructuredGrid> &ugrid)
 {
   size_t num_verts = cell.vertex_ids_.size();
 
   std::vector<vtkIdType> cell_vids(num_verts);
   for (size_t v=0; v<num_verts; v++)
-    cell_vids[v] = static_cast<vtkIdType>(vertex_map[cell.vertex_ids_[v]]);
+    cell_vids[v] = static_cast<vtkIdType>(vertex_map.At(cell.vertex_ids_[v]));
 
   if (cell.Type() == chi_mesh::CellType::SLAB)
   {
@@ -188,14 +190,14 @@ void chi_mesh::
 //###################################################################
 /**Uploads vertices and cells to an unstructured grid.*/
 void chi_mesh::UploadFaceGeometry(const chi_mesh::CellFace& cell_face,
-                                  const std::vector<uint64_t>& vertex_map,
+                                  const CellIDMap& vertex_map,
                                   vtkNew<vtkUnstructuredGrid> &ugrid)
 {
   const size_t num_verts = cell_face.vertex_ids_.size();
 
   std::vector<vtkIdType> cell_vids;
   for (uint64_t vid : cell_face.vertex_ids_)
-    cell_vids.push_back(static_cast<vtkIdType>(vertex_map[vid]));
+    cell_vids.push_back(static_cast<vtkIdType>(vertex_map.At(vid)));
 
   if (num_verts == 1)
   {
@@ -223,4 +225,30 @@ void chi_mesh::UploadFaceGeometry(const chi_mesh::CellFace& cell_face,
                           static_cast<vtkIdType>(num_verts),
                           cell_vids.data());
   }
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Uploads the given vertices, in ascending global id order and without
+ * duplicates, and returns the map from their global ids to point ids.
+ * Unlike a map sized by the global vertex count, this only takes storage
+ * proportional to the uploaded vertices.*/
+chi_mesh::CellIDMap chi_mesh::
+  UploadVertices(const chi_mesh::MeshContinuum& grid,
+                 std::vector<uint64_t> vertex_ids,
+                 vtkNew<vtkPoints>& points)
+{
+  std::sort(vertex_ids.begin(), vertex_ids.end());
+  vertex_ids.erase(std::unique(vertex_ids.begin(), vertex_ids.end()),
+                   vertex_ids.end());
+
+  CellIDMap vertex_map;
+  points->Allocate(static_cast<vtkIdType>(vertex_ids.size()));
+  for (const uint64_t vid : vertex_ids)
+  {
+    const auto& vertex = grid.vertices[vid];
+    vertex_map.Insert(vid, static_cast<uint64_t>(
+      points->InsertNextPoint(vertex.x, vertex.y, vertex.z)));
+  }
+
+  return vertex_map;
+}
@@ -8,10 +8,45 @@
 #include <vtkUnsignedIntArray.h>
 
 #include <vtkXMLUnstructuredGridWriter.h>
-#include <vtkXMLPUnstructuredGridWriter.h>
+#include <vtkPointData.h>
+#include <vtkAbstractArray.h>
 
 #include "chi_runtime.h"
 
+#include <fstream>
+
+namespace
+{
+//###################################################################
+/**Returns the VTK XML name of a VTK data type.*/
+std::string VtkXMLTypeName(const int vtk_data_type)
+{
+  switch (vtk_data_type)
+  {
+    case VTK_DOUBLE:             return "Float64";
+    case VTK_FLOAT:              return "Float32";
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:        return "Int8";
+    case VTK_UNSIGNED_CHAR:      return "UInt8";
+    case VTK_SHORT:              return "Int16";
+    case VTK_UNSIGNED_SHORT:     return "UInt16";
+    case VTK_INT:                return "Int32";
+    case VTK_UNSIGNED_INT:       return "UInt32";
+    case VTK_LONG_LONG:          return "Int64";
+    case VTK_UNSIGNED_LONG_LONG: return "UInt64";
+    case VTK_LONG:
+      return sizeof(long) == 8 ? "Int64" : "Int32";
+    case VTK_UNSIGNED_LONG:
+      return sizeof(long) == 8 ? "UInt64" : "UInt32";
+    case VTK_ID_TYPE:
+      return sizeof(vtkIdType) == 8 ? "Int64" : "Int32";
+    default:
+      throw std::logic_error("VtkXMLTypeName: Unsupported VTK data type " +
+                             std::to_string(vtk_data_type));
+  }
+}
+}//namespace
+
 //###################################################################
 /**Uploads vertices and cells to an unstructured grid. This routine
  * also uploads cell material ids (sub-domain ids) and partition ids.*/
@@ -31,17 +66,16 @@ vtkNew<vtkUnstructuredGrid> chi_mesh::
   material_array->SetName("Material");
   partition_id_array->SetName("Partition");
 
-  std::vector<uint64_t> vertex_map;
+  //============================================= Upload the vertices of the
+  //                                              local cells only
+  CellIDMap vertex_map;
   if (not discontinuous)
   {
-    vertex_map.assign(grid.GetGlobalVertexCount(), 0);
-    const size_t num_verts = grid.GetGlobalVertexCount();
-    for (size_t v=0; v<num_verts; ++v)
-    {
-      vertex_map[v] = v;
-      const auto& vertex = grid.vertices[v];
-      points->InsertNextPoint(vertex.x,vertex.y,vertex.z);
-    }
+    std::vector<uint64_t> vertex_ids;
+    for (const auto& cell : grid.local_cells)
+      vertex_ids.insert(vertex_ids.end(),
+                        cell.vertex_ids_.begin(), cell.vertex_ids_.end());
+    vertex_map = chi_mesh::UploadVertices(grid, std::move(vertex_ids), points);
   }
 
   //############################################# Populate cell information
@@ -67,7 +101,55 @@ vtkNew<vtkUnstructuredGrid> chi_mesh::
 }
 
 //###################################################################
-/**Writes an unstructured grid to files (.pvtu and .vtu).*/
+/**Uploads the boundary faces of the local cells to an unstructured grid,
+ * with their boundary ids and the partition ids of their cells. Only the
+ * vertices on the boundary are uploaded, hence the pieces are much smaller
+ * than those of the volume mesh.*/
+vtkNew<vtkUnstructuredGrid> chi_mesh::
+  PrepareVtkBoundaryUnstructuredGrid(const chi_mesh::MeshContinuum& grid)
+{
+  vtkNew<vtkUnstructuredGrid>         ugrid;
+  vtkNew<vtkPoints>                   points;
+  vtkNew<vtkUnsignedIntArray>         boundary_id_array;
+  vtkNew<vtkUnsignedIntArray>         partition_id_array;
+
+  points->SetDataType(VTK_DOUBLE);
+
+  boundary_id_array->SetName("BoundaryID");
+  partition_id_array->SetName("Partition");
+
+  std::vector<uint64_t> vertex_ids;
+  for (const auto& cell : grid.local_cells)
+    for (const auto& face : cell.faces_)
+      if (not face.has_neighbor_)
+        vertex_ids.insert(vertex_ids.end(),
+                          face.vertex_ids_.begin(), face.vertex_ids_.end());
+
+  const auto vertex_map =
+    chi_mesh::UploadVertices(grid, std::move(vertex_ids), points);
+
+  for (const auto& cell : grid.local_cells)
+    for (const auto& face : cell.faces_)
+      if (not face.has_neighbor_)
+      {
+        chi_mesh::UploadFaceGeometry(face, vertex_map, ugrid);
+        boundary_id_array->InsertNextValue(face.neighbor_id_);
+        partition_id_array->InsertNextValue(cell.partition_id_);
+      }
+  ugrid->SetPoints(points);
+
+  ugrid->GetCellData()->AddArray(boundary_id_array);
+  ugrid->GetCellData()->AddArray(partition_id_array);
+
+  return ugrid;
+}
+
+//###################################################################
+/**Writes an unstructured grid to files (.pvtu and .vtu). Each location
+ * writes its own piece, with the data arrays appended as raw binary, and
+ * location 0 writes the summary file that lists the pieces. The summary
+ * only references the arrays, hence is written directly instead of through
+ * a parallel writer, which would write every piece from location 0.*/
 void chi_mesh::WritePVTUFiles(vtkNew<vtkUnstructuredGrid> &ugrid,
                               const std::string& file_base_name)
 {
@@ -83,24 +165,73 @@ void chi_mesh::WritePVTUFiles(vtkNew<vtkUnstructuredGrid> &ugrid,
   {
     std::string pvtu_file_name = base_filename + std::string(".pvtu");
 
-    auto pgrid_writer = vtkSmartPointer<vtkXMLPUnstructuredGridWriter>::New();
+    //Pieces are referenced relative to the summary file
+    const size_t slash = base_filename.find_last_of('/');
+    const std::string piece_base_name =
+      slash == std::string::npos ? base_filename
+                                 : base_filename.substr(slash + 1);
 
-    pgrid_writer->EncodeAppendedDataOff();
-    pgrid_writer->SetFileName(pvtu_file_name.c_str());
-    pgrid_writer->SetNumberOfPieces(Chi::mpi.process_count);
-    pgrid_writer->SetStartPiece(Chi::mpi.location_id);
-    pgrid_writer->SetEndPiece(Chi::mpi.process_count-1);
-    pgrid_writer->SetInputData(ugrid);
+    std::ofstream file(pvtu_file_name);
+    if (not file.is_open())
+      throw std::runtime_error("WritePVTUFiles: Failed to open file " +
+                               pvtu_file_name);
 
-    pgrid_writer->Write();
+    auto WriteArrayHeaders = [&file](vtkFieldData* data)
+    {
+      for (int a = 0; a < data->GetNumberOfArrays(); ++a)
+      {
+        auto array = data->GetAbstractArray(a);
+        file << "      <PDataArray type=\""
+             << VtkXMLTypeName(array->GetDataType())
+             << "\" Name=\"" << array->GetName()
+             << "\" NumberOfComponents=\""
+             << array->GetNumberOfComponents() << "\"/>\n";
+      }
+    };
+
+    const uint16_t endianness_probe = 1;
+    const bool little_endian =
+      *reinterpret_cast<const uint8_t*>(&endianness_probe) == 1;
+
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+         << "byte_order=\"" << (little_endian ? "LittleEndian" : "BigEndian")
+         << "\" header_type=\"UInt64\">\n"
+         << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+
+    file << "    <PPointData>\n";
+    WriteArrayHeaders(ugrid->GetPointData());
+    file << "    </PPointData>\n";
+
+    file << "    <PCellData>\n";
+    WriteArrayHeaders(ugrid->GetCellData());
+    file << "    </PCellData>\n";
+
+    const int points_type = ugrid->GetPoints() ?
+      ugrid->GetPoints()->GetDataType() : VTK_DOUBLE;
+    file << "    <PPoints>\n"
+         << "      <PDataArray type=\"" << VtkXMLTypeName(points_type)
+         << "\" Name=\"Points\" NumberOfComponents=\"3\"/>\n"
+         << "    </PPoints>\n";
+
+    for (int p = 0; p < Chi::mpi.process_count; ++p)
+      file << "    <Piece Source=\"" << piece_base_name << "_" << p
+           << ".vtu\"/>\n";
+
+    file << "  </PUnstructuredGrid>\n"
+         << "</VTKFile>\n";
   }
-  Chi::mpi.Barrier();
 
-  //============================================= Serial output each piece
+  //============================================= Output each piece
   auto grid_writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
 
   grid_writer->SetInputData(ugrid);
   grid_writer->SetFileName(location_filename.c_str());
+  grid_writer->SetDataModeToAppended();
+  grid_writer->EncodeAppendedDataOff();
+  grid_writer->SetHeaderTypeToUInt64();
 
   grid_writer->Write();
-}
\ No newline at end of file
+
+  Chi::mpi.Barrier();
+}
@@ -3,11 +3,14 @@
 
 #include <memory>
 #include <array>
+#include <map>
 
 #include "../chi_mesh.h"
 #include "chi_meshcontinuum_localcellhandler.h"
 #include "chi_meshcontinuum_globalcellhandler.h"
 #include "chi_meshcontinuum_vertexhandler.h"
+#include "chi_meshcontinuum_compactcells.h"
+#include "chi_meshcontinuum_cellsearch.h"
 
 #include "chi_mpi.h"
 
@@ -41,10 +44,47 @@ private:
   std::vector<std::unique_ptr<chi_mesh::Cell>>
     ghost_cells_; ///< Locally stored ghosts
 
-  std::map<uint64_t, uint64_t> global_cell_id_to_local_id_map_;
-  std::map<uint64_t, uint64_t> global_cell_id_to_nonlocal_id_map_;
+  CellIDMap global_cell_id_to_local_id_map_;
+  CellIDMap global_cell_id_to_nonlocal_id_map_;
 
   uint64_t global_vertex_count_ = 0;
+  bool local_cells_renumbered_ = false;
+  size_t num_cell_revisions_ = 0;
+  bool face_neighbor_ghosts_only_ = false;
+
+public:
+  /**Locality of the neighbor of a local cell face.*/
+  struct FaceNeighborIndex
+  {
+    int64_t local_id = -1;    ///< Local id if the neighbor is local
+    int64_t ghost_index = -1; ///< Index among the ghosts otherwise
+    int partition_id = -1;    ///< Partition, -1 on boundary faces
+  };
+
+private:
+  /**Flattened per-face neighbor pointers and indices of the local cells,
+   * nullptr on boundary faces, built on first use by FaceNeighbor or
+   * GetFaceNeighborIndex.*/
+  mutable std::vector<size_t> face_neighbor_offsets_;
+  mutable std::vector<const chi_mesh::Cell*> face_neighbors_;
+  mutable std::vector<FaceNeighborIndex> face_neighbor_indices_;
+  mutable std::array<size_t, 3> face_neighbor_state_ = {0, 0, 0};
+
+  mutable std::unique_ptr<CompactLocalCells> compact_local_cells_;
+  mutable std::array<size_t, 3> compact_local_cells_state_ = {0, 0, 0};
+
+  mutable std::unique_ptr<LocalCellSearchIndex> cell_search_index_;
+  mutable std::array<size_t, 3> cell_search_index_state_ = {0, 0, 0};
+
+  mutable std::shared_ptr<GridFaceHistogram> grid_face_histogram_;
+  mutable std::array<size_t, 3> grid_face_histogram_state_ = {0, 0, 0};
+  mutable std::pair<double, double> grid_face_histogram_tolerances_;
+
+  /**Local boundary ids as of the last gather of the global ones, which is
+   * repeated only if those of some location changed.*/
+  mutable std::vector<uint64_t> local_boundary_ids_;
+  mutable std::vector<uint64_t> global_boundary_ids_;
+  mutable bool global_boundary_ids_gathered_ = false;
 
 public:
   VertexHandler vertices;
@@ -102,24 +142,77 @@ public:
   {
     local_cells_.clear();
     ghost_cells_.clear();
-    global_cell_id_to_local_id_map_.clear();
-    global_cell_id_to_nonlocal_id_map_.clear();
+    global_cell_id_to_local_id_map_.Clear();
+    global_cell_id_to_nonlocal_id_map_.Clear();
+    face_neighbor_offsets_.clear();
+    face_neighbors_.clear();
+    face_neighbor_indices_.clear();
+    compact_local_cells_ = nullptr;
+    cell_search_index_ = nullptr;
+    grid_face_histogram_ = nullptr;
+    local_boundary_ids_.clear();
+    global_boundary_ids_.clear();
+    global_boundary_ids_gathered_ = false;
     vertices.Clear();
   }
 
   void ExportCellsToObj(const char* fileName,
                         bool per_material = false,
                         int options = 0) const;
-  void ExportCellsToVTK(const std::string& file_base_name) const;
+  void ExportCellsToVTK(const std::string& file_base_name,
+                        bool boundary_only = false) const;
   void ExportCellsToExodus(const std::string& file_base_name,
                            bool suppress_node_sets = false,
                            bool suppress_side_sets = false) const;
+  void ExportCellsToPartitionedFile(const std::string& file_name) const;
+  void ReadCellsFromPartitionedFile(const std::string& file_name);
 
+  /**Cached until the cells or the tolerances change.*/
   std::shared_ptr<GridFaceHistogram>
   MakeGridFaceHistogram(double master_tolerance = 100.0,
                         double slave_tolerance = 1.1) const;
 
   bool IsCellLocal(uint64_t cell_global_index) const;
+
+  /**Returns the number of bytes held by the local and ghost cells, the
+   * vertices, the id maps and the tables derived from the cells.*/
+  size_t GetMemoryUsage() const;
+
+  /**Returns the neighbor, local or ghost, of face `f` of a local cell from
+   * a precomputed table, avoiding a global id look-up per call. The table
+   * is (re)built on the first call after the cells changed, hence that call
+   * is not thread safe. Must not be called on boundary faces.*/
+  const chi_mesh::Cell& FaceNeighbor(const chi_mesh::Cell& local_cell,
+                                     size_t f) const
+  {
+    PrepareFaceNeighborTable();
+    return *face_neighbors_[face_neighbor_offsets_[local_cell.local_id_] + f];
+  }
+
+  /**Returns the local id, ghost index and partition of the neighbor of
+   * face `f` of a local cell from the same table as FaceNeighbor, replacing
+   * the global id look-ups of IsCellLocal and the CellFace neighbor
+   * queries. Valid on boundary faces, where all indices are -1.*/
+  const FaceNeighborIndex&
+  GetFaceNeighborIndex(const chi_mesh::Cell& local_cell, size_t f) const
+  {
+    PrepareFaceNeighborTable();
+    return face_neighbor_indices_[
+      face_neighbor_offsets_[local_cell.local_id_] + f];
+  }
+
+  /**Builds the face neighbor table if the cells changed since it was last
+   * built. Must be called before threaded use of the accessors above.*/
+  void PrepareFaceNeighborTable() const
+  {
+    if (face_neighbor_offsets_.empty() or CellsState() != face_neighbor_state_)
+      BuildFaceNeighborTable();
+  }
+
+  const CompactLocalCells& GetCompactLocalCells() const;
+  /**Frees the compact copy of the local cells, if built.*/
+  void ReleaseCompactLocalCells() const { compact_local_cells_ = nullptr; }
+
   static int GetCellDimension(const chi_mesh::Cell& cell);
 
   /**Creates a mapping of the current face local-ids to the
@@ -145,6 +238,7 @@ public:
 
   size_t GetGlobalNumberOfCells() const;
 
+  /**Collective. Cached until the boundary ids of some location change.*/
   std::vector<uint64_t> GetDomainUniqueBoundaryIDs() const;
 
   size_t
@@ -152,6 +246,12 @@ public:
   bool CheckPointInsideCell(const chi_mesh::Cell& cell,
                             const chi_mesh::Vector3& point) const;
 
+  const LocalCellSearchIndex& GetLocalCellSearchIndex() const;
+  std::vector<int64_t>
+  FindLocalCellsContainingPoints(const std::vector<Vector3>& points) const;
+  std::vector<uint64_t>
+  FindCellsContainingPoints(const std::vector<Vector3>& points) const;
+
   MeshAttributes Attributes() const { return attributes; }
 
   std::array<size_t, 3> GetIJKInfo() const;
@@ -160,7 +260,39 @@ public:
 
   std::pair<chi_mesh::Vector3, chi_mesh::Vector3> GetLocalBoundingBox() const;
 
+  std::vector<uint64_t> MakeMortonLocalCellOrder() const;
+  std::vector<uint64_t>
+  MakeSweepLocalCellOrder(const chi_mesh::Vector3& omega) const;
+  void RenumberLocalCells(const std::vector<uint64_t>& new_to_old_local_ids);
+  void MigrateCells(const std::vector<uint64_t>& new_local_cell_pids,
+                    std::vector<std::vector<double>>& local_cell_data);
+  std::vector<uint64_t>
+  MakeHilbertRepartition(const std::vector<double>& local_cell_weights) const;
+  /**Returns true if the local cells no longer have the order in which they
+   * were created, in which case, for serial runs, local ids no longer
+   * equal global ids.*/
+  bool LocalCellsRenumbered() const { return local_cells_renumbered_; }
+  /**Returns true if the ghost cells are only the face neighbors of the
+   * local cells, instead of all the cells sharing a vertex with them.*/
+  bool HasFaceNeighborGhostsOnly() const { return face_neighbor_ghosts_only_; }
+
+  /**Local ids of the local cells and global ids of the ghost cells that
+   * have at least one of the given vertices.*/
+  std::pair<std::vector<uint64_t>, std::vector<uint64_t>>
+  FindCellsWithVertices(const std::vector<uint64_t>& vertex_ids) const;
+  void RecomputeCellGeometry(const std::vector<uint64_t>& moved_vertex_ids);
+
+  /**Changes whenever local or ghost cells are added, the local cells are
+   * renumbered or the geometry of cells is recomputed, invalidating the
+   * derived per-cell tables.*/
+  std::array<size_t, 3> CellsState() const
+  {
+    return {local_cells_.size(), ghost_cells_.size(), num_cell_revisions_};
+  }
+
 private:
+  void BuildFaceNeighborTable() const;
+
   friend class chi_mesh::VolumeMesher;
   void SetAttributes(MeshAttributes new_attribs,
                      std::array<size_t, 3> ortho_Nis = {0, 0, 0})
@@ -168,6 +300,10 @@ private:
     attributes = attributes | new_attribs;
     ortho_attributes = {ortho_Nis[0], ortho_Nis[1], ortho_Nis[2]};
   }
+  void SetFaceNeighborGhostsOnly(bool face_neighbors_only)
+  {
+    face_neighbor_ghosts_only_ = face_neighbors_only;
+  }
 };
 
 #endif // CHI_MESHCONTINUUM_H_
\ No newline at end of file
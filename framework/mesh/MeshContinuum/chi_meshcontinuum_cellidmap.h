@@ -0,0 +1,117 @@
+#ifndef CHI_MESHCONTINUUM_CELLIDMAP_H_
+#define CHI_MESHCONTINUUM_CELLIDMAP_H_
+
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace chi_mesh
+{
+//##################################################
+/**Flat open-addressing hash map from cell (or vertex) global ids to storage
+ * indices. The keys and values are stored in a single contiguous array
+ * that is probed linearly, hence look-ups mostly touch one cache line
+ * instead of walking the nodes of a tree. The maximum uint64_t is reserved to mark
+ * empty slots and cannot be used as a key.*/
+class CellIDMap
+{
+private:
+  static constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+
+  struct Slot
+  {
+    uint64_t key = EMPTY_KEY;
+    uint64_t value = 0;
+  };
+
+  std::vector<Slot> slots_; ///< Capacity is zero or a power of two
+  size_t size_ = 0;
+  int shift_ = 64;
+
+  /**Fibonacci hashing: the top bits of the key times 2^64 divided by the
+   * golden ratio.*/
+  size_t Bucket(const uint64_t key) const
+  {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  void InsertUnchecked(const uint64_t key, const uint64_t value)
+  {
+    const size_t mask = slots_.size() - 1;
+    for (size_t b = Bucket(key);; b = (b + 1) & mask)
+    {
+      auto& slot = slots_[b];
+      if (slot.key == key) { slot.value = value; return; }
+      if (slot.key == EMPTY_KEY) { slot = {key, value}; ++size_; return; }
+    }
+  }
+
+  void Rehash(const size_t capacity)
+  {
+    std::vector<Slot> old_slots(capacity);
+    old_slots.swap(slots_);
+    size_ = 0;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) --shift_;
+
+    for (const auto& slot : old_slots)
+      if (slot.key != EMPTY_KEY) InsertUnchecked(slot.key, slot.value);
+  }
+
+public:
+  /**Inserts a key, or overwrites its value if already present. The load
+   * factor is kept at or below one half.*/
+  void Insert(const uint64_t key, const uint64_t value)
+  {
+    if (key == EMPTY_KEY)
+      throw std::invalid_argument("CellIDMap: Invalid key " +
+                                  std::to_string(key) + ".");
+    if (2 * (size_ + 1) > slots_.size())
+      Rehash(slots_.empty() ? 16 : 2 * slots_.size());
+    InsertUnchecked(key, value);
+  }
+
+  /**Returns a pointer to the value of a key, or nullptr if the key is
+   * not present. The reserved empty key is never present.*/
+  const uint64_t* Find(const uint64_t key) const
+  {
+    if (key == EMPTY_KEY or slots_.empty()) return nullptr;
+    const size_t mask = slots_.size() - 1;
+    for (size_t b = Bucket(key);; b = (b + 1) & mask)
+    {
+      const auto& slot = slots_[b];
+      if (slot.key == key) return &slot.value;
+      if (slot.key == EMPTY_KEY) return nullptr;
+    }
+  }
+
+  /**Returns the value of a key, throwing `std::out_of_range` if the key
+   * is not present.*/
+  uint64_t At(const uint64_t key) const
+  {
+    const uint64_t* value = Find(key);
+    if (not value)
+      throw std::out_of_range("CellIDMap: Key " + std::to_string(key) +
+                              " not found.");
+    return *value;
+  }
+
+  bool Contains(const uint64_t key) const { return Find(key) != nullptr; }
+  size_t Size() const { return size_; }
+  /**Returns the number of bytes held by the slots.*/
+  size_t GetMemoryUsage() const { return slots_.capacity() * sizeof(Slot); }
+
+  void Clear()
+  {
+    slots_.clear();
+    slots_.shrink_to_fit();
+    size_ = 0;
+    shift_ = 64;
+  }
+};
+
+}//namespace chi_mesh
+
+#endif //CHI_MESHCONTINUUM_CELLIDMAP_H_
@@ -0,0 +1,177 @@
+#include "chi_meshcontinuum_cellsearch.h"
+#include "chi_meshcontinuum.h"
+
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/**Maximum number of bins along a dimension.*/
+constexpr size_t MAX_BINS_PER_DIMENSION = 1024;
+/**Relative growth of the cell bounding boxes, such that points on the
+ * faces of a cell are not missed because of round-off.*/
+constexpr double BOUNDING_BOX_TOLERANCE = 1.0e-8;
+}
+
+//###################################################################
+/**Computes the cell bounding boxes and bins them.*/
+chi_mesh::LocalCellSearchIndex::LocalCellSearchIndex(const MeshContinuum& grid)
+{
+  const size_t num_cells = grid.local_cells.size();
+  ChiLogicalErrorIf(num_cells > std::numeric_limits<uint32_t>::max(),
+                    "Too many local cells for the cell search index.");
+
+  constexpr double infinity = std::numeric_limits<double>::infinity();
+
+  //======================================== Cell bounding boxes
+  cell_bounding_boxes_.resize(num_cells);
+  Vector3 grid_min(infinity, infinity, infinity);
+  Vector3 grid_max(-infinity, -infinity, -infinity);
+  for (const auto& cell : grid.local_cells)
+  {
+    Vector3 cell_min(infinity, infinity, infinity);
+    Vector3 cell_max(-infinity, -infinity, -infinity);
+    for (const uint64_t vid : cell.vertex_ids_)
+    {
+      const auto& vertex = grid.vertices[vid];
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        cell_min(d) = std::min(cell_min[d], vertex[d]);
+        cell_max(d) = std::max(cell_max[d], vertex[d]);
+      }
+    }
+
+    const double tolerance =
+      BOUNDING_BOX_TOLERANCE * (cell_max - cell_min).Norm();
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      cell_min(d) -= tolerance;
+      cell_max(d) += tolerance;
+      grid_min(d) = std::min(grid_min[d], cell_min[d]);
+      grid_max(d) = std::max(grid_max[d], cell_max[d]);
+    }
+
+    cell_bounding_boxes_[cell.local_id_] = {cell_min, cell_max};
+  }
+
+  //======================================== Bin sizes
+  // Dimensions in which the grid is flat, e.g., z for 2D grids, are not
+  // binned and ignored when matching points, like CheckPointInsideCell does.
+  double volume = 1.0;
+  unsigned int num_dims = 0;
+  for (unsigned int d = 0; d < 3; ++d)
+    if (num_cells > 0 and grid_max[d] - grid_min[d] > 0.0)
+    {
+      volume *= grid_max[d] - grid_min[d];
+      ++num_dims;
+    }
+
+  const double bin_size =
+    num_dims > 0 ? std::pow(volume / static_cast<double>(num_cells),
+                            1.0 / static_cast<double>(num_dims))
+                 : 1.0;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    const double extent = grid_max[d] - grid_min[d];
+    if (num_cells == 0 or not(extent > 0.0))
+    {
+      for (auto& bounding_box : cell_bounding_boxes_)
+      {
+        bounding_box[0](d) = -infinity;
+        bounding_box[1](d) = infinity;
+      }
+      continue;
+    }
+
+    num_bins_[d] = std::clamp(
+      static_cast<size_t>(std::lround(extent / bin_size)),
+      size_t{1}, MAX_BINS_PER_DIMENSION);
+    inv_bin_size_[d] = static_cast<double>(num_bins_[d]) / extent;
+  }
+  xyz_min_ = grid_min;
+
+  //======================================== Fill bins, counting first
+  const size_t num_bins = num_bins_[0] * num_bins_[1] * num_bins_[2];
+  bin_offsets_.assign(num_bins + 1, 0);
+
+  auto BinRange = [this](const std::array<Vector3, 2>& bounding_box,
+                         unsigned int d)
+  {
+    if (inv_bin_size_[d] == 0.0) return std::make_pair(size_t{0}, size_t{0});
+
+    auto Index = [this, d](double x)
+    {
+      const double i = std::floor((x - xyz_min_[d]) * inv_bin_size_[d]);
+      return static_cast<size_t>(
+        std::clamp(i, 0.0, static_cast<double>(num_bins_[d] - 1)));
+    };
+    return std::make_pair(Index(bounding_box[0][d]),
+                          Index(bounding_box[1][d]));
+  };
+
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<size_t> bin_fill;
+    if (pass == 1)
+    {
+      for (size_t b = 0; b < num_bins; ++b)
+        bin_offsets_[b + 1] += bin_offsets_[b];
+      bin_cell_ids_.resize(bin_offsets_.back());
+      bin_fill.assign(bin_offsets_.begin(), bin_offsets_.end() - 1);
+    }
+
+    for (uint32_t c = 0; c < num_cells; ++c)
+    {
+      const auto& bounding_box = cell_bounding_boxes_[c];
+      const auto [i0, i1] = BinRange(bounding_box, 0);
+      const auto [j0, j1] = BinRange(bounding_box, 1);
+      const auto [k0, k1] = BinRange(bounding_box, 2);
+
+      for (size_t i = i0; i <= i1; ++i)
+        for (size_t j = j0; j <= j1; ++j)
+          for (size_t k = k0; k <= k1; ++k)
+          {
+            const size_t bin = (i * num_bins_[1] + j) * num_bins_[2] + k;
+            if (pass == 0)
+              ++bin_offsets_[bin + 1];
+            else
+              bin_cell_ids_[bin_fill[bin]++] = c;
+          }
+    }//for cell
+  }//for pass
+}
+
+//###################################################################
+/**Maps a point to its bin. Returns false if the point is outside the
+ * bounding box of the local cells.*/
+bool chi_mesh::LocalCellSearchIndex::MapPointToBin(const Vector3& point,
+                                                   size_t& bin) const
+{
+  if (bin_cell_ids_.empty()) return false;
+
+  std::array<size_t, 3> ijk = {0, 0, 0};
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    if (inv_bin_size_[d] == 0.0) continue;
+
+    const double i = std::floor((point[d] - xyz_min_[d]) * inv_bin_size_[d]);
+    if (i < 0.0 or i > static_cast<double>(num_bins_[d])) return false;
+    ijk[d] = std::min(static_cast<size_t>(i), num_bins_[d] - 1);
+  }
+
+  bin = (ijk[0] * num_bins_[1] + ijk[1]) * num_bins_[2] + ijk[2];
+  return true;
+}
+
+//###################################################################
+/**Returns the number of bytes held by the index.*/
+size_t chi_mesh::LocalCellSearchIndex::GetMemoryUsage() const
+{
+  return bin_offsets_.capacity() * sizeof(size_t) +
+         bin_cell_ids_.capacity() * sizeof(uint32_t) +
+         cell_bounding_boxes_.capacity() * sizeof(std::array<Vector3, 2>);
+}
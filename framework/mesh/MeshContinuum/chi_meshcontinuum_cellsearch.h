@@ -0,0 +1,64 @@
+#ifndef CHI_MESHCONTINUUM_CELLSEARCH_H_
+#define CHI_MESHCONTINUUM_CELLSEARCH_H_
+
+#include "mesh/chi_mesh.h"
+
+#include <array>
+#include <vector>
+
+namespace chi_mesh
+{
+//##################################################
+/**Uniform binning of the bounding boxes of the local cells of a grid,
+ * used to find the cells that may contain a point without scanning all
+ * the local cells. The bins are sized such that there is roughly one
+ * cell per bin, and each bin lists, in CSR form, the local ids of the
+ * cells whose bounding box overlaps it.
+ *
+ * Use MeshContinuum::GetLocalCellSearchIndex to obtain it.*/
+class LocalCellSearchIndex
+{
+private:
+  Vector3 xyz_min_;
+  std::array<double, 3> inv_bin_size_ = {0.0, 0.0, 0.0};
+  std::array<size_t, 3> num_bins_ = {1, 1, 1};
+
+  std::vector<size_t> bin_offsets_;
+  std::vector<uint32_t> bin_cell_ids_;
+  /**Per cell, the bounding box minimum and maximum.*/
+  std::vector<std::array<Vector3, 2>> cell_bounding_boxes_;
+
+public:
+  explicit LocalCellSearchIndex(const MeshContinuum& grid);
+
+  /**Calls `function(local_id)` for every local cell whose bounding box
+   * contains the point, in ascending local id order.*/
+  template<typename Function>
+  void ForEachCandidate(const Vector3& point, Function function) const
+  {
+    size_t bin;
+    if (not MapPointToBin(point, bin)) return;
+
+    for (size_t k = bin_offsets_[bin]; k < bin_offsets_[bin + 1]; ++k)
+    {
+      const uint32_t local_id = bin_cell_ids_[k];
+      const auto& bounding_box = cell_bounding_boxes_[local_id];
+      if (point.x >= bounding_box[0].x and point.x <= bounding_box[1].x and
+          point.y >= bounding_box[0].y and point.y <= bounding_box[1].y and
+          point.z >= bounding_box[0].z and point.z <= bounding_box[1].z)
+        function(static_cast<uint64_t>(local_id));
+    }
+  }
+
+  size_t GetNumBins() const { return bin_offsets_.size() - 1; }
+
+  /**Returns the number of bytes held by the index.*/
+  size_t GetMemoryUsage() const;
+
+private:
+  bool MapPointToBin(const Vector3& point, size_t& bin) const;
+};
+
+}//namespace chi_mesh
+
+#endif //CHI_MESHCONTINUUM_CELLSEARCH_H_
@@ -20,11 +20,11 @@ std::shared_ptr<chi::ChiMPICommunicatorSet>
   local_graph_edges.insert(Chi::mpi.location_id); //add current location
   for (auto& cell : local_cells)
   {
-    for (auto& face : cell.faces_)
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
     {
-      if (face.has_neighbor_)
-        if (not face.IsNeighborLocal(*this))
-          local_graph_edges.insert(face.GetNeighborPartitionID(*this));
+      const auto& neighbor = GetFaceNeighborIndex(cell, f);
+      if (neighbor.ghost_index >= 0)
+        local_graph_edges.insert(neighbor.partition_id);
     }//for f
   }//for local cells
 
@@ -114,7 +114,29 @@ std::shared_ptr<chi::ChiMPICommunicatorSet>
   Chi::log.Log0Verbose1()
     << "Done building communicators.";
 
+  //============================================= Build node communicator
+  //Locations that share a node can exchange data through shared-memory
+  MPI_Comm node_communicator;
+  MPI_Comm_split_type(Chi::mpi.comm,
+                      MPI_COMM_TYPE_SHARED,
+                      Chi::mpi.location_id,
+                      MPI_INFO_NULL,
+                      &node_communicator);
+
+  int node_size;
+  MPI_Comm_size(node_communicator, &node_size);
+
+  std::vector<int> node_locations(node_size, -1);
+  MPI_Allgather(&Chi::mpi.location_id, 1, MPI_INT,
+                node_locations.data(), 1, MPI_INT,
+                node_communicator);
+
+  std::vector<int> node_ranks(Chi::mpi.process_count, -1);
+  for (int r=0; r<node_size; r++)
+    node_ranks[node_locations[r]] = r;
+
   return std::make_shared<chi::ChiMPICommunicatorSet>(
-    communicators, location_groups, world_group);
+    communicators, location_groups, world_group,
+    node_communicator, std::move(node_ranks));
 }
 
@@ -0,0 +1,85 @@
+#include "chi_meshcontinuum_compactcells.h"
+#include "chi_meshcontinuum.h"
+
+//###################################################################
+/**Copies the local cells of the grid into the compact storage.*/
+chi_mesh::CompactLocalCells::CompactLocalCells(const MeshContinuum& grid)
+{
+  const size_t num_cells = grid.local_cells.size();
+
+  //======================================== Count
+  size_t num_cell_vertices = 0;
+  size_t num_faces = 0;
+  size_t num_face_vertices = 0;
+  for (const auto& cell : grid.local_cells)
+  {
+    num_cell_vertices += cell.vertex_ids_.size();
+    num_faces += cell.faces_.size();
+    for (const auto& face : cell.faces_)
+      num_face_vertices += face.vertex_ids_.size();
+  }
+
+  //======================================== Allocate
+  cell_global_ids_.resize(num_cells);
+  cell_material_ids_.resize(num_cells);
+  cell_centroids_.resize(num_cells);
+  cell_vertex_offsets_.assign(num_cells + 1, 0);
+  cell_face_offsets_.assign(num_cells + 1, 0);
+  cell_vertex_ids_.reserve(num_cell_vertices);
+
+  face_vertex_offsets_.reserve(num_faces + 1);
+  face_vertex_ids_.reserve(num_face_vertices);
+  face_normals_.reserve(num_faces);
+  face_centroids_.reserve(num_faces);
+  face_areas_.reserve(num_faces);
+  face_has_neighbor_.reserve(num_faces);
+  face_neighbor_ids_.reserve(num_faces);
+
+  //======================================== Fill, in local id order
+  face_vertex_offsets_.push_back(0);
+  for (size_t c = 0; c < num_cells; ++c)
+  {
+    const auto& cell = grid.local_cells[c];
+
+    cell_global_ids_[c] = cell.global_id_;
+    cell_material_ids_[c] = cell.material_id_;
+    cell_centroids_[c] = cell.centroid_;
+
+    cell_vertex_ids_.insert(cell_vertex_ids_.end(),
+                            cell.vertex_ids_.begin(), cell.vertex_ids_.end());
+    cell_vertex_offsets_[c + 1] = cell_vertex_ids_.size();
+
+    for (const auto& face : cell.faces_)
+    {
+      face_vertex_ids_.insert(face_vertex_ids_.end(),
+                              face.vertex_ids_.begin(),
+                              face.vertex_ids_.end());
+      face_vertex_offsets_.push_back(face_vertex_ids_.size());
+      face_normals_.push_back(face.normal_);
+      face_centroids_.push_back(face.centroid_);
+      face_areas_.push_back(face.ComputeFaceArea(grid));
+      face_has_neighbor_.push_back(face.has_neighbor_);
+      face_neighbor_ids_.push_back(face.neighbor_id_);
+    }
+    cell_face_offsets_[c + 1] = face_areas_.size();
+  }
+}
+
+//###################################################################
+/**Returns the number of bytes held by the compact storage.*/
+size_t chi_mesh::CompactLocalCells::GetMemoryUsage() const
+{
+  return cell_global_ids_.capacity() * sizeof(uint64_t) +
+         cell_material_ids_.capacity() * sizeof(int) +
+         cell_centroids_.capacity() * sizeof(Vertex) +
+         cell_vertex_offsets_.capacity() * sizeof(size_t) +
+         cell_vertex_ids_.capacity() * sizeof(uint64_t) +
+         cell_face_offsets_.capacity() * sizeof(size_t) +
+         face_vertex_offsets_.capacity() * sizeof(size_t) +
+         face_vertex_ids_.capacity() * sizeof(uint64_t) +
+         face_normals_.capacity() * sizeof(chi_mesh::Normal) +
+         face_centroids_.capacity() * sizeof(Vertex) +
+         face_areas_.capacity() * sizeof(double) +
+         face_has_neighbor_.capacity() * sizeof(char) +
+         face_neighbor_ids_.capacity() * sizeof(uint64_t);
+}
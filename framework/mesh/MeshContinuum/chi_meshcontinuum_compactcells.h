@@ -0,0 +1,133 @@
+#ifndef CHI_MESHCONTINUUM_COMPACTCELLS_H_
+#define CHI_MESHCONTINUUM_COMPACTCELLS_H_
+
+#include "mesh/Cell/cell.h"
+
+namespace chi_mesh
+{
+//##################################################
+/**Read-only compact copy of the local cells of a grid. Connectivity is
+ * stored in CSR form (cell-to-vertex, cell-to-face and face-to-vertex)
+ * and the per-face geometry as separate arrays (normals, centroids,
+ * areas, neighbor ids), hence the whole mesh lives in a handful of
+ * contiguous allocations instead of a few per cell and per face.
+ *
+ * Use MeshContinuum::GetCompactLocalCells to obtain it.*/
+class CompactLocalCells
+{
+public:
+  //##################################### Index range
+  /**Contiguous, non-owning range of ids.*/
+  class IDRange
+  {
+  private:
+    const uint64_t* begin_;
+    const uint64_t* end_;
+
+  public:
+    IDRange(const uint64_t* begin, const uint64_t* end) :
+      begin_(begin), end_(end) {}
+
+    const uint64_t* begin() const { return begin_; }
+    const uint64_t* end() const { return end_; }
+    size_t size() const { return static_cast<size_t>(end_ - begin_); }
+    uint64_t operator[](size_t i) const { return begin_[i]; }
+  };
+
+  //##################################### Face view
+  /**View of a single face in the compact storage.*/
+  class FaceView
+  {
+  private:
+    const CompactLocalCells& data_;
+    const size_t face_index_;
+
+  public:
+    FaceView(const CompactLocalCells& data, size_t face_index) :
+      data_(data), face_index_(face_index) {}
+
+    IDRange GetVertexIDs() const
+    {
+      return {data_.face_vertex_ids_.data() +
+                data_.face_vertex_offsets_[face_index_],
+              data_.face_vertex_ids_.data() +
+                data_.face_vertex_offsets_[face_index_ + 1]};
+    }
+    const chi_mesh::Normal& GetNormal() const
+    { return data_.face_normals_[face_index_]; }
+    const Vertex& GetCentroid() const
+    { return data_.face_centroids_[face_index_]; }
+    double GetArea() const { return data_.face_areas_[face_index_]; }
+    bool HasNeighbor() const { return data_.face_has_neighbor_[face_index_]; }
+    /**Global id of the neighbor, or the boundary id if the face has no
+     * neighbor.*/
+    uint64_t GetNeighborID() const
+    { return data_.face_neighbor_ids_[face_index_]; }
+  };
+
+  //##################################### Cell view
+  /**View of a single cell in the compact storage.*/
+  class CellView
+  {
+  private:
+    const CompactLocalCells& data_;
+    const size_t local_id_;
+
+  public:
+    CellView(const CompactLocalCells& data, size_t local_id) :
+      data_(data), local_id_(local_id) {}
+
+    uint64_t GetLocalID() const { return local_id_; }
+    uint64_t GetGlobalID() const { return data_.cell_global_ids_[local_id_]; }
+    int GetMaterialID() const { return data_.cell_material_ids_[local_id_]; }
+    const Vertex& GetCentroid() const
+    { return data_.cell_centroids_[local_id_]; }
+
+    IDRange GetVertexIDs() const
+    {
+      return {data_.cell_vertex_ids_.data() +
+                data_.cell_vertex_offsets_[local_id_],
+              data_.cell_vertex_ids_.data() +
+                data_.cell_vertex_offsets_[local_id_ + 1]};
+    }
+
+    size_t GetNumFaces() const
+    {
+      return data_.cell_face_offsets_[local_id_ + 1] -
+             data_.cell_face_offsets_[local_id_];
+    }
+    FaceView GetFace(size_t f) const
+    { return {data_, data_.cell_face_offsets_[local_id_] + f}; }
+  };
+
+private:
+  std::vector<uint64_t> cell_global_ids_;
+  std::vector<int> cell_material_ids_;
+  std::vector<Vertex> cell_centroids_;
+  std::vector<size_t> cell_vertex_offsets_;
+  std::vector<uint64_t> cell_vertex_ids_;
+  std::vector<size_t> cell_face_offsets_;
+
+  std::vector<size_t> face_vertex_offsets_;
+  std::vector<uint64_t> face_vertex_ids_;
+  std::vector<chi_mesh::Normal> face_normals_;
+  std::vector<Vertex> face_centroids_;
+  std::vector<double> face_areas_;
+  std::vector<char> face_has_neighbor_;
+  std::vector<uint64_t> face_neighbor_ids_;
+
+public:
+  explicit CompactLocalCells(const MeshContinuum& grid);
+
+  size_t GetNumCells() const { return cell_global_ids_.size(); }
+  size_t GetNumFaces() const { return face_areas_.size(); }
+
+  CellView operator[](size_t local_id) const { return {*this, local_id}; }
+
+  /**Returns the number of bytes held by the compact storage.*/
+  size_t GetMemoryUsage() const;
+};
+
+}//namespace chi_mesh
+
+#endif //CHI_MESHCONTINUUM_COMPACTCELLS_H_
@@ -18,10 +18,16 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 
+#include <algorithm>
+
 #define scvtkid static_cast<vtkIdType>
 
 //###################################################################
-/**Exports just the portion of the mesh to ExodusII format.*/
+/**Exports just the portion of the mesh to ExodusII format. In parallel
+ * each location writes its own portion to a Nemesis-style file
+ * `<base>.e.<P>.<rank>` that carries the global node and element ids, such
+ * that the files can be joined with, e.g., SEACAS `epu -auto`, instead of
+ * gathering the mesh to a single location.*/
 void chi_mesh::MeshContinuum::
   ExportCellsToExodus(const std::string& file_base_name,
                       bool suppress_node_sets/*= false*/,
@@ -30,10 +36,6 @@ void chi_mesh::MeshContinuum::
   const std::string fname = "chi_mesh::MeshContinuum::ExportCellsToExodus";
   Chi::log.Log() << "Exporting mesh to Exodus file with base " << file_base_name;
 
-  if (Chi::mpi.process_count != 1)
-    throw std::logic_error(fname + ": Currently this routine is only allowed "
-                                   "in serial.");
-
   const auto& grid = *this;
 
   //============================================= Check block consistency
@@ -52,6 +54,41 @@ void chi_mesh::MeshContinuum::
     }
   }
 
+  //Blocks must also be consistent across the pieces
+  if (Chi::mpi.process_count > 1)
+  {
+    std::vector<int> local_pairs;
+    for (const auto& [mat_id, cell_type] : block_id_map)
+    {
+      local_pairs.push_back(mat_id);
+      local_pairs.push_back(static_cast<int>(cell_type));
+    }
+
+    const int local_size = static_cast<int>(local_pairs.size());
+    std::vector<int> sizes(Chi::mpi.process_count, 0);
+    MPI_Allgather(&local_size, 1, MPI_INT,
+                  sizes.data(), 1, MPI_INT, Chi::mpi.comm);
+
+    std::vector<int> displacements(Chi::mpi.process_count, 0);
+    for (int p = 1; p < Chi::mpi.process_count; ++p)
+      displacements[p] = displacements[p - 1] + sizes[p - 1];
+
+    std::vector<int> global_pairs(displacements.back() + sizes.back());
+    MPI_Allgatherv(local_pairs.data(), local_size, MPI_INT,
+                   global_pairs.data(), sizes.data(), displacements.data(),
+                   MPI_INT, Chi::mpi.comm);
+
+    for (size_t k = 0; k < global_pairs.size(); k += 2)
+    {
+      const auto it = block_id_map.find(global_pairs[k]);
+      if (it != block_id_map.end() and
+          static_cast<int>(it->second) != global_pairs[k + 1])
+        throw std::logic_error(fname + ": Material id " +
+                               std::to_string(global_pairs[k]) + " appearing "
+                               "for more than one cell type.");
+    }
+  }
+
   //============================================= Create unstructured meshes
   //                                              for each material-type pair
   vtkNew<vtkMultiBlockDataSet> grid_blocks;
@@ -71,19 +108,21 @@ void chi_mesh::MeshContinuum::
     vtkNew<vtkIntArray> block_id_list;
     block_id_list->SetName("BlockID");
 
-    //============================ Load vertices
-    std::vector<uint64_t> vertex_map(grid.GetGlobalVertexCount(), 0);
-    const size_t num_verts = grid.GetGlobalVertexCount();
-    for (size_t v=0; v<num_verts; ++v)
-    {
-      vertex_map[v] = v;
-      const auto& vertex = grid.vertices[v];
-      points->InsertNextPoint(vertex.x,vertex.y,vertex.z);
+    //============================ Load vertices of the local cells
+    std::vector<uint64_t> vertex_ids;
+    for (const auto& cell : grid.local_cells)
+      vertex_ids.insert(vertex_ids.end(),
+                        cell.vertex_ids_.begin(), cell.vertex_ids_.end());
+    std::sort(vertex_ids.begin(), vertex_ids.end());
+    vertex_ids.erase(std::unique(vertex_ids.begin(), vertex_ids.end()),
+                     vertex_ids.end());
 
-      //Exodus node- and cell indices are 1-based
-      //therefore we add a 1 here.
-      global_node_id_list->InsertNextValue(scvtkid(v+1));
-    }
+    const auto vertex_map = UploadVertices(grid, vertex_ids, points);
+
+    //Exodus node- and cell indices are 1-based
+    //therefore we add a 1 here.
+    for (const uint64_t vid : vertex_ids)
+      global_node_id_list->InsertNextValue(scvtkid(vid+1));
 
     //============================ Load cells
     for (const auto& cell : grid.local_cells)
@@ -190,29 +229,19 @@ void chi_mesh::MeshContinuum::
         for (uint64_t vid : face_info.face_ptr->vertex_ids_)
           vid_set.insert(vid);
 
-      //========================== Build vertex map
-      std::vector<uint64_t> vertex_map(grid.GetGlobalVertexCount(), 0);
-      {
-        uint64_t mapped_id = 0;
-        for (uint64_t vid : vid_set)
-          vertex_map[vid] = mapped_id++;
-      }
-
       //========================== Load vertices
-      for (uint64_t vid : vid_set)
-      {
-        const auto& vertex = grid.vertices[vid];
-        points->InsertNextPoint(vertex.x,vertex.y,vertex.z);
+      const auto vertex_map = UploadVertices(
+        grid, std::vector<uint64_t>(vid_set.begin(), vid_set.end()), points);
 
-        //Exodus node- and cell indices are 1-based
-        //therefore we add a 1 here.
+      //Exodus node- and cell indices are 1-based
+      //therefore we add a 1 here.
+      for (uint64_t vid : vid_set)
         node_global_ids->InsertNextValue(scvtkid(vid+1));
-      }
 
       //========================== Load cells
       for (uint64_t vid : vid_set)
       {
-        std::vector<vtkIdType> cell_vids = {scvtkid(vertex_map[vid])};
+        std::vector<vtkIdType> cell_vids = {scvtkid(vertex_map.At(vid))};
         ugrid->InsertNextCell(VTK_VERTEX,
                               scvtkid(1),
                               cell_vids.data());
@@ -251,20 +280,9 @@ void chi_mesh::MeshContinuum::
         for (uint64_t vid : face_info.face_ptr->vertex_ids_)
           vid_set.insert(vid);
 
-      //========================== Build vertex map
-      std::vector<uint64_t> vertex_map(grid.GetGlobalVertexCount(), 0);
-      {
-        uint64_t mapped_id = 0;
-        for (uint64_t vid : vid_set)
-          vertex_map[vid] = mapped_id++;
-      }
-
       //========================== Load vertices
-      for (uint64_t vid : vid_set)
-      {
-        const auto& vertex = grid.vertices[vid];
-        points->InsertNextPoint(vertex.x,vertex.y,vertex.z);
-      }
+      const auto vertex_map = UploadVertices(
+        grid, std::vector<uint64_t>(vid_set.begin(), vid_set.end()), points);
 
       //========================== Load faces
       for (const auto& face_info : face_list)
@@ -306,10 +324,21 @@ void chi_mesh::MeshContinuum::
     main_block->GetMetaData(next_block++)->Set(vtkCompositeDataSet::NAME(), "Side Sets");
   }
 
+  //Nemesis convention for the file of a piece, with the rank zero-padded
+  //to the number of digits of the process count
+  std::string file_name = file_base_name + ".e";
+  if (Chi::mpi.process_count > 1)
+  {
+    const std::string num_pieces = std::to_string(Chi::mpi.process_count);
+    std::string rank = std::to_string(Chi::mpi.location_id);
+    rank.insert(0, num_pieces.size() - rank.size(), '0');
+    file_name += "." + num_pieces + "." + rank;
+  }
+
   vtkNew<vtkExodusIIWriter> writer;
   writer->SetBlockIdArrayName("BlockID");
 
-  writer->SetFileName((file_base_name + ".e").c_str());
+  writer->SetFileName(file_name.c_str());
   writer->SetStoreDoubles(1);
 
   writer->SetInputData(main_block);
@@ -10,14 +10,20 @@
 #include "chi_log.h"
 
 //###################################################################
-/**Exports just the mesh to VTK format.*/
-void chi_mesh::MeshContinuum::ExportCellsToVTK(const std::string& file_base_name) const
+/**Exports just the mesh to VTK format, one piece per location. With
+ * `boundary_only` only the boundary faces are exported, with their
+ * boundary ids.*/
+void chi_mesh::MeshContinuum::
+  ExportCellsToVTK(const std::string& file_base_name,
+                   bool boundary_only/*=false*/) const
 {
   Chi::log.Log() << "Exporting mesh to VTK files with base " << file_base_name;
 
   const auto& grid = *this;
 
-  auto ugrid = chi_mesh::PrepareVtkUnstructuredGrid(grid, false);
+  auto ugrid = boundary_only ?
+               chi_mesh::PrepareVtkBoundaryUnstructuredGrid(grid) :
+               chi_mesh::PrepareVtkUnstructuredGrid(grid, false);
 
   chi_mesh::WritePVTUFiles(ugrid, file_base_name);
 
@@ -0,0 +1,72 @@
+#include "chi_meshcontinuum.h"
+
+#include "mesh/Cell/cell.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <algorithm>
+
+//###################################################################
+/**Finds the local and ghost cells with at least one of the given vertices,
+ * checking the vertices of each cell against the sorted vertex ids.*/
+std::pair<std::vector<uint64_t>, std::vector<uint64_t>>
+chi_mesh::MeshContinuum::
+  FindCellsWithVertices(const std::vector<uint64_t>& vertex_ids) const
+{
+  std::vector<uint64_t> sorted_ids = vertex_ids;
+  std::sort(sorted_ids.begin(), sorted_ids.end());
+  sorted_ids.erase(std::unique(sorted_ids.begin(), sorted_ids.end()),
+                   sorted_ids.end());
+
+  auto HasVertex = [&sorted_ids](const chi_mesh::Cell& cell)
+  {
+    for (const uint64_t vid : cell.vertex_ids_)
+      if (std::binary_search(sorted_ids.begin(), sorted_ids.end(), vid))
+        return true;
+    return false;
+  };
+
+  std::vector<uint64_t> local_ids;
+  std::vector<uint64_t> ghost_ids;
+  if (sorted_ids.empty()) return {local_ids, ghost_ids};
+
+  const auto num_local_cells = static_cast<int64_t>(local_cells_.size());
+  std::vector<char> local_flags(local_cells_.size(), 0);
+#pragma omp parallel for
+  for (int64_t c = 0; c < num_local_cells; ++c)
+    local_flags[c] = HasVertex(*local_cells_[c]) ? 1 : 0;
+
+  for (int64_t c = 0; c < num_local_cells; ++c)
+    if (local_flags[c]) local_ids.push_back(c);
+
+  for (const auto& cell : ghost_cells_)
+    if (HasVertex(*cell)) ghost_ids.push_back(cell->global_id_);
+
+  return {local_ids, ghost_ids};
+}
+
+//###################################################################
+/**Recomputes the centroids and face normals of the local and ghost cells
+ * that have a moved vertex, the other cells being unaffected. The cells
+ * state changes, such that the tables derived from the cells are rebuilt
+ * on their next use.*/
+void chi_mesh::MeshContinuum::
+  RecomputeCellGeometry(const std::vector<uint64_t>& moved_vertex_ids)
+{
+  const auto [local_ids, ghost_ids] = FindCellsWithVertices(moved_vertex_ids);
+
+  const auto num_local_ids = static_cast<int64_t>(local_ids.size());
+#pragma omp parallel for
+  for (int64_t k = 0; k < num_local_ids; ++k)
+    local_cells_[local_ids[k]]->RecomputeCentroidsAndNormals(*this);
+
+  for (const uint64_t ghost_id : ghost_ids)
+    cells[ghost_id].RecomputeCentroidsAndNormals(*this);
+
+  ++num_cell_revisions_;
+
+  Chi::log.Log0Verbose1() << "Recomputed the geometry of "
+                          << local_ids.size() << " local and "
+                          << ghost_ids.size() << " ghost cells.";
+}
@@ -17,8 +17,8 @@ void chi_mesh::GlobalCellHandler::
 
     const auto& cell = local_cells_ref_.back();
 
-    global_cell_id_to_native_id_map.insert(std::make_pair(
-      cell->global_id_, local_cells_ref_.size() - 1));
+    global_cell_id_to_native_id_map.Insert(cell->global_id_,
+                                           local_cells_ref_.size() - 1);
   }
   else
   {
@@ -26,8 +26,8 @@ void chi_mesh::GlobalCellHandler::
 
     const auto& cell = ghost_cells_ref_.back();
 
-    global_cell_id_to_foreign_id_map.insert(std::make_pair(
-      cell->global_id_, ghost_cells_ref_.size() - 1));
+    global_cell_id_to_foreign_id_map.Insert(cell->global_id_,
+                                            ghost_cells_ref_.size() - 1);
   }
 
 }
@@ -37,15 +37,17 @@ void chi_mesh::GlobalCellHandler::
 chi_mesh::Cell& chi_mesh::GlobalCellHandler::
   operator[](uint64_t cell_global_index)
 {
-  auto native_location = global_cell_id_to_native_id_map.find(cell_global_index);
+  const auto native_location =
+    global_cell_id_to_native_id_map.Find(cell_global_index);
 
-  if (native_location != global_cell_id_to_native_id_map.end())
-    return *local_cells_ref_[native_location->second];
+  if (native_location)
+    return *local_cells_ref_[*native_location];
   else
   {
-    auto foreign_location = global_cell_id_to_foreign_id_map.find(cell_global_index);
-    if (foreign_location != global_cell_id_to_foreign_id_map.end())
-      return *ghost_cells_ref_[foreign_location->second];
+    const auto foreign_location =
+      global_cell_id_to_foreign_id_map.Find(cell_global_index);
+    if (foreign_location)
+      return *ghost_cells_ref_[*foreign_location];
   }
 
   std::stringstream ostr;
@@ -61,15 +63,17 @@ chi_mesh::Cell& chi_mesh::GlobalCellHandler::
 const chi_mesh::Cell& chi_mesh::GlobalCellHandler::
   operator[](uint64_t cell_global_index) const
 {
-  auto native_location = global_cell_id_to_native_id_map.find(cell_global_index);
+  const auto native_location =
+    global_cell_id_to_native_id_map.Find(cell_global_index);
 
-  if (native_location != global_cell_id_to_native_id_map.end())
-    return *local_cells_ref_[native_location->second];
+  if (native_location)
+    return *local_cells_ref_[*native_location];
   else
   {
-    auto foreign_location = global_cell_id_to_foreign_id_map.find(cell_global_index);
-    if (foreign_location != global_cell_id_to_foreign_id_map.end())
-      return *ghost_cells_ref_[foreign_location->second];
+    const auto foreign_location =
+      global_cell_id_to_foreign_id_map.Find(cell_global_index);
+    if (foreign_location)
+      return *ghost_cells_ref_[*foreign_location];
   }
 
   std::stringstream ostr;
@@ -121,11 +125,11 @@ std::vector<uint64_t> chi_mesh::GlobalCellHandler::
 uint64_t chi_mesh::GlobalCellHandler::
   GetGhostLocalID(uint64_t cell_global_index) const
 {
-  auto foreign_location =
-    global_cell_id_to_foreign_id_map.find(cell_global_index);
+  const auto foreign_location =
+    global_cell_id_to_foreign_id_map.Find(cell_global_index);
 
-  if (foreign_location != global_cell_id_to_foreign_id_map.end())
-    return foreign_location->second;
+  if (foreign_location)
+    return *foreign_location;
 
   std::stringstream ostr;
   ostr << "Grid GetGhostLocalID failed to find cell " << cell_global_index;
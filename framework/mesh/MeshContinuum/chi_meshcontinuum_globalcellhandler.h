@@ -2,8 +2,7 @@
 #define CHI_MESHCONTINUUM_GLOBALCELLHANDLER_H_
 
 #include "mesh/Cell/cell.h"
-
-#include <map>
+#include "chi_meshcontinuum_cellidmap.h"
 
 namespace chi_mesh
 {
@@ -16,16 +15,16 @@ private:
   std::vector<std::unique_ptr<chi_mesh::Cell>>& local_cells_ref_;
   std::vector<std::unique_ptr<chi_mesh::Cell>>& ghost_cells_ref_;
 
-  std::map<uint64_t,uint64_t>& global_cell_id_to_native_id_map;
-  std::map<uint64_t,uint64_t>& global_cell_id_to_foreign_id_map;
+  CellIDMap& global_cell_id_to_native_id_map;
+  CellIDMap& global_cell_id_to_foreign_id_map;
 
 
 private:
   explicit GlobalCellHandler(
     std::vector<std::unique_ptr<chi_mesh::Cell>>& in_native_cells,
     std::vector<std::unique_ptr<chi_mesh::Cell>>& in_foreign_cells,
-    std::map<uint64_t,uint64_t>& in_global_cell_id_to_native_id_map,
-    std::map<uint64_t,uint64_t>& in_global_cell_id_to_foreign_id_map) :
+    CellIDMap& in_global_cell_id_to_native_id_map,
+    CellIDMap& in_global_cell_id_to_foreign_id_map) :
     local_cells_ref_(in_native_cells),
     ghost_cells_ref_(in_foreign_cells),
     global_cell_id_to_native_id_map(in_global_cell_id_to_native_id_map),
@@ -38,7 +37,7 @@ public:
   const chi_mesh::Cell& operator[](uint64_t cell_global_index) const;
 
   size_t GetNumGhosts() const
-  {return global_cell_id_to_foreign_id_map.size();}
+  {return global_cell_id_to_foreign_id_map.Size();}
 
   std::vector<uint64_t> GetGhostGlobalIDs() const;
 
@@ -0,0 +1,340 @@
+#include "chi_meshcontinuum.h"
+#include "mesh/Cell/cell.h"
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+#include "chi_mpi_utils_map_all2all.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// ###################################################################
+/**Appends a cell, the coordinates of its vertices and, optionally, its
+ * data to a byte array.*/
+void PackCell(const chi_mesh::Cell& cell,
+              const chi_mesh::VertexHandler& cell_vertices,
+              const std::vector<double>* cell_data,
+              chi_data_types::ByteArray& raw)
+{
+  raw.Append(cell.Serialize());
+  raw.Write<size_t>(cell.vertex_ids_.size());
+  for (uint64_t vid : cell.vertex_ids_)
+  {
+    raw.Write<uint64_t>(vid);
+    raw.Write<chi_mesh::Vector3>(cell_vertices[vid]);
+  }
+
+  raw.Write<size_t>(cell_data ? cell_data->size() : 0);
+  if (cell_data)
+    for (double value : *cell_data)
+      raw.Write<double>(value);
+}
+
+// ###################################################################
+/**Reads a cell packed by PackCell, inserting its vertices into
+ * `cell_vertices` and returning its data.*/
+std::unique_ptr<chi_mesh::Cell>
+UnpackCell(const chi_data_types::ByteArray& raw,
+           size_t& address,
+           chi_mesh::VertexHandler& cell_vertices,
+           std::vector<double>& cell_data)
+{
+  auto cell = std::make_unique<chi_mesh::Cell>(
+    chi_mesh::Cell::DeSerialize(raw, address));
+
+  const auto num_vertices = raw.Read<size_t>(address, &address);
+  for (size_t v = 0; v < num_vertices; ++v)
+  {
+    const auto vid = raw.Read<uint64_t>(address, &address);
+    const auto vertex = raw.Read<chi_mesh::Vector3>(address, &address);
+    cell_vertices.Insert(vid, vertex);
+  }
+
+  cell_data.resize(raw.Read<size_t>(address, &address));
+  for (double& value : cell_data)
+    value = raw.Read<double>(address, &address);
+
+  return cell;
+}
+} // namespace
+
+// ###################################################################
+/**Moves the local cells to the locations given by `new_local_cell_pids`,
+ * indexed by local id, and rebuilds the local and ghost cells of every
+ * location in place. The ghost cells of a location become all the cells
+ * sharing a vertex with its local cells, even if the grid was created with
+ * face neighbor ghosts only. The new local cells are numbered in global id
+ * order. This is a collective call.
+ *
+ * `local_cell_data` optionally holds, per local cell, data that moves
+ * with the cell, e.g., solution values. On return it holds the data of
+ * the new local cells, indexed by their new local ids.
+ *
+ * Every object referencing the cells of this grid (spatial
+ * discretizations, sweep orderings, field functions, etc.) is invalidated
+ * and must be rebuilt.*/
+void chi_mesh::MeshContinuum::MigrateCells(
+  const std::vector<uint64_t>& new_local_cell_pids,
+  std::vector<std::vector<double>>& local_cell_data)
+{
+  typedef chi_data_types::ByteArray ByteArray;
+  const size_t num_local_cells = local_cells_.size();
+  const auto num_locations = static_cast<uint64_t>(Chi::mpi.process_count);
+
+  ChiInvalidArgumentIf(new_local_cell_pids.size() != num_local_cells,
+                       "A new partition id is required for every local cell.");
+  ChiInvalidArgumentIf(not local_cell_data.empty() and
+                         local_cell_data.size() != num_local_cells,
+                       "Cell data, if supplied, is required for every local "
+                       "cell.");
+  for (uint64_t pid : new_local_cell_pids)
+    ChiInvalidArgumentIf(pid >= num_locations,
+                         "Invalid partition id " + std::to_string(pid) + ".");
+
+  Chi::log.Log() << "Migrating cells.";
+
+  //======================================== Ship the local cells to their
+  //                                         new owners and post their
+  //                                         vertices to the vertex
+  //                                         directory (owner vid % P)
+  std::vector<std::unique_ptr<chi_mesh::Cell>> new_local_cells;
+  std::vector<std::vector<double>> new_local_cell_data;
+  VertexHandler new_vertices;
+
+  std::map<uint64_t, std::vector<std::pair<uint64_t, uint64_t>>>
+    vertex_directory; //vid -> (cell global id, new pid)
+  {
+    std::map<int, std::vector<std::byte>> cell_sends;
+    std::map<int, std::vector<uint64_t>> vertex_posts;
+    for (const auto& cell_ptr : local_cells_)
+    {
+      auto& cell = *cell_ptr;
+      const uint64_t new_pid = new_local_cell_pids[cell.local_id_];
+      cell.partition_id_ = new_pid;
+
+      ByteArray raw;
+      PackCell(cell,
+               vertices,
+               local_cell_data.empty() ? nullptr
+                                       : &local_cell_data[cell.local_id_],
+               raw);
+      auto& send = cell_sends[static_cast<int>(new_pid)];
+      send.insert(send.end(), raw.Data().begin(), raw.Data().end());
+
+      for (uint64_t vid : cell.vertex_ids_)
+      {
+        auto& post = vertex_posts[static_cast<int>(vid % num_locations)];
+        post.insert(post.end(), {vid, cell.global_id_, new_pid});
+      }
+    }
+    local_cell_data.clear();
+
+    const auto received_cells =
+      chi_mpi_utils::MapAllToAll(cell_sends, MPI_BYTE);
+    cell_sends.clear();
+
+    for (const auto& [pid, data] : received_cells)
+    {
+      const ByteArray raw(data);
+      size_t address = 0;
+      while (address < raw.Size())
+      {
+        new_local_cell_data.emplace_back();
+        new_local_cells.push_back(
+          UnpackCell(raw, address, new_vertices, new_local_cell_data.back()));
+      }
+    }
+
+    const auto received_posts =
+      chi_mpi_utils::MapAllToAll(vertex_posts, MPI_UINT64_T);
+    for (const auto& [pid, posts] : received_posts)
+      for (size_t k = 0; k < posts.size(); k += 3)
+        vertex_directory[posts[k]].emplace_back(posts[k + 1], posts[k + 2]);
+  }
+
+  //======================================== Number the new local cells in
+  //                                         global id order
+  {
+    std::vector<size_t> order(new_local_cells.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(),
+              order.end(),
+              [&new_local_cells](size_t a, size_t b)
+              {
+                return new_local_cells[a]->global_id_ <
+                       new_local_cells[b]->global_id_;
+              });
+
+    std::vector<std::unique_ptr<chi_mesh::Cell>> sorted_cells;
+    std::vector<std::vector<double>> sorted_data;
+    sorted_cells.reserve(order.size());
+    sorted_data.reserve(order.size());
+    for (size_t k : order)
+    {
+      sorted_cells.push_back(std::move(new_local_cells[k]));
+      sorted_cells.back()->local_id_ = sorted_cells.size() - 1;
+      sorted_data.push_back(std::move(new_local_cell_data[k]));
+    }
+    new_local_cells = std::move(sorted_cells);
+    new_local_cell_data = std::move(sorted_data);
+  }
+
+  //======================================== The vertex directory asks the
+  //                                         owners of cells sharing a
+  //                                         vertex to ship them to each
+  //                                         other as ghosts
+  std::map<int, std::vector<std::byte>> ghost_sends;
+  {
+    std::map<int, std::vector<uint64_t>> ghost_requests; //(gid, to pid)
+    for (const auto& [vid, vertex_cells] : vertex_directory)
+      for (const auto& [gid, owner] : vertex_cells)
+        for (const auto& other_cell : vertex_cells)
+          if (other_cell.second != owner)
+          {
+            auto& requests = ghost_requests[static_cast<int>(owner)];
+            requests.insert(requests.end(), {gid, other_cell.second});
+          }
+    vertex_directory.clear();
+
+    const auto received_requests =
+      chi_mpi_utils::MapAllToAll(ghost_requests, MPI_UINT64_T);
+    ghost_requests.clear();
+
+    CellIDMap new_local_gid_map;
+    for (const auto& cell : new_local_cells)
+      new_local_gid_map.Insert(cell->global_id_, cell->local_id_);
+
+    std::map<int, std::vector<uint64_t>> ghost_gids_per_pid;
+    for (const auto& [pid, requests] : received_requests)
+      for (size_t k = 0; k < requests.size(); k += 2)
+        ghost_gids_per_pid[static_cast<int>(requests[k + 1])].push_back(
+          requests[k]);
+
+    for (auto& [to_pid, gids] : ghost_gids_per_pid)
+    {
+      std::sort(gids.begin(), gids.end());
+      gids.erase(std::unique(gids.begin(), gids.end()), gids.end());
+
+      ByteArray raw;
+      for (uint64_t gid : gids)
+        PackCell(*new_local_cells[new_local_gid_map.At(gid)],
+                 new_vertices,
+                 nullptr,
+                 raw);
+      ghost_sends[to_pid] = std::move(raw.Data());
+    }
+  }
+
+  //======================================== Receive the ghosts
+  std::vector<std::unique_ptr<chi_mesh::Cell>> new_ghost_cells;
+  {
+    const auto received_ghosts =
+      chi_mpi_utils::MapAllToAll(ghost_sends, MPI_BYTE);
+    ghost_sends.clear();
+
+    std::vector<double> no_data;
+    for (const auto& [pid, data] : received_ghosts)
+    {
+      const ByteArray raw(data);
+      size_t address = 0;
+      while (address < raw.Size())
+        new_ghost_cells.push_back(
+          UnpackCell(raw, address, new_vertices, no_data));
+    }
+  }
+
+  //======================================== Rebuild the grid
+  ClearCellReferences();
+  vertices = std::move(new_vertices);
+  for (auto& cell : new_local_cells)
+    cells.push_back(std::move(cell));
+  for (auto& cell : new_ghost_cells)
+    cells.push_back(std::move(cell));
+
+  local_cells_renumbered_ = false;
+  face_neighbor_ghosts_only_ = false;
+  ++num_cell_revisions_;
+
+  local_cell_data = std::move(new_local_cell_data);
+
+  Chi::log.Log() << "Done migrating cells.";
+}
+
+// ###################################################################
+/**Computes a new partition along a Hilbert curve through the centroids of
+ * all the cells of the grid, balancing `local_cell_weights`, indexed by
+ * local id, or the cell counts if empty. This is a collective call.
+ * Returns the new partition id of every local cell, as expected by
+ * MigrateCells.*/
+std::vector<uint64_t> chi_mesh::MeshContinuum::MakeHilbertRepartition(
+  const std::vector<double>& local_cell_weights) const
+{
+  const size_t num_local_cells = local_cells_.size();
+  ChiInvalidArgumentIf(not local_cell_weights.empty() and
+                         local_cell_weights.size() != num_local_cells,
+                       "Cell weights, if supplied, are required for every "
+                       "local cell.");
+
+  //======================================== Gather centroids and weights
+  const int num_locations = Chi::mpi.process_count;
+  std::vector<int> counts(num_locations, 0);
+  std::vector<int> displs(num_locations, 0);
+  const int local_count = static_cast<int>(num_local_cells);
+  MPI_Allgather(&local_count, 1, MPI_INT,
+                counts.data(), 1, MPI_INT, Chi::mpi.comm);
+
+  int total_count = 0;
+  for (int locI = 0; locI < num_locations; ++locI)
+  {
+    displs[locI] = total_count;
+    total_count += counts[locI];
+  }
+
+  std::vector<double> local_values;
+  local_values.reserve(4 * num_local_cells);
+  for (const auto& cell : local_cells_)
+    local_values.insert(local_values.end(),
+                        {cell->centroid_.x,
+                         cell->centroid_.y,
+                         cell->centroid_.z,
+                         local_cell_weights.empty()
+                           ? 1.0
+                           : local_cell_weights[cell->local_id_]});
+
+  std::vector<int> value_counts(num_locations, 0);
+  std::vector<int> value_displs(num_locations, 0);
+  for (int locI = 0; locI < num_locations; ++locI)
+  {
+    value_counts[locI] = 4 * counts[locI];
+    value_displs[locI] = 4 * displs[locI];
+  }
+
+  std::vector<double> values(4 * static_cast<size_t>(total_count), 0.0);
+  MPI_Allgatherv(local_values.data(), 4 * local_count, MPI_DOUBLE,
+                 values.data(), value_counts.data(), value_displs.data(),
+                 MPI_DOUBLE, Chi::mpi.comm);
+
+  std::vector<chi_mesh::Vector3> centroids(total_count);
+  std::vector<double> weights(total_count);
+  for (size_t k = 0; k < centroids.size(); ++k)
+  {
+    centroids[k] = {values[4 * k], values[4 * k + 1], values[4 * k + 2]};
+    weights[k] = values[4 * k + 3];
+  }
+
+  //======================================== Partition
+  const auto parts = chi_mesh::PartitionAlongHilbertCurve(
+    centroids, weights, static_cast<size_t>(num_locations));
+
+  std::vector<uint64_t> new_local_cell_pids(num_local_cells, 0);
+  const size_t offset = displs[Chi::mpi.location_id];
+  for (size_t c = 0; c < num_local_cells; ++c)
+    new_local_cell_pids[c] = static_cast<uint64_t>(parts[offset + c]);
+
+  return new_local_cell_pids;
+}
@@ -0,0 +1,238 @@
+#include "chi_meshcontinuum.h"
+
+#include "mesh/Cell/cell.h"
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+
+namespace
+{
+/**Identifies partitioned mesh files, "CHIPMESH".*/
+constexpr uint64_t PARTITIONED_FILE_TAG = 0x4853454D50494843;
+constexpr int PARTITIONED_FILE_VERSION = 1;
+
+/**Largest number of bytes read or written by one MPI-IO call.*/
+constexpr size_t MAX_IO_CHUNK = size_t(1) << 30;
+
+/**Writes bytes at the given file offset, in chunks.*/
+void WriteAt(MPI_File file, MPI_Offset offset,
+             const std::vector<std::byte>& bytes)
+{
+  for (size_t b = 0; b < bytes.size(); b += MAX_IO_CHUNK)
+  {
+    const size_t count = std::min(MAX_IO_CHUNK, bytes.size() - b);
+    MPI_File_write_at(file, offset + static_cast<MPI_Offset>(b),
+                      bytes.data() + b, static_cast<int>(count), MPI_BYTE,
+                      MPI_STATUS_IGNORE);
+  }
+}
+
+/**Reads bytes at the given file offset, in chunks.*/
+std::vector<std::byte> ReadAt(MPI_File file, MPI_Offset offset,
+                              size_t num_bytes)
+{
+  std::vector<std::byte> bytes(num_bytes);
+  for (size_t b = 0; b < num_bytes; b += MAX_IO_CHUNK)
+  {
+    const size_t count = std::min(MAX_IO_CHUNK, num_bytes - b);
+    MPI_Status status;
+    MPI_File_read_at(file, offset + static_cast<MPI_Offset>(b),
+                     bytes.data() + b, static_cast<int>(count), MPI_BYTE,
+                     &status);
+    int num_read = 0;
+    MPI_Get_count(&status, MPI_BYTE, &num_read);
+    if (static_cast<size_t>(num_read) != count)
+      throw std::runtime_error("Unexpected end of partitioned mesh file.");
+  }
+  return bytes;
+}
+}//namespace
+
+//###################################################################
+/**Exports the partitioned mesh to a single file, from which runs with the
+ * same number of locations can read it back with
+ * ReadCellsFromPartitionedFile, skipping the building of the connectivity
+ * and the partitioning.
+ *
+ * The file holds a header, with the mesh attributes and boundary names,
+ * an offset table, and the local cells, ghost cells and vertices of each
+ * location, which the locations write concurrently with MPI-IO. Must be
+ * called by all locations.*/
+void chi_mesh::MeshContinuum::
+  ExportCellsToPartitionedFile(const std::string& file_name) const
+{
+  Chi::log.Log() << "Exporting mesh to partitioned file " << file_name;
+
+  const int num_locations = Chi::mpi.process_count;
+
+  //======================================== Serialize mesh level data
+  chi_data_types::ByteArray header;
+  header.Write<uint64_t>(PARTITIONED_FILE_TAG);
+  header.Write<int>(PARTITIONED_FILE_VERSION);
+  header.Write<int>(num_locations);
+  header.Write<int>(static_cast<int>(attributes));
+  header.Write<size_t>(ortho_attributes.Nx);
+  header.Write<size_t>(ortho_attributes.Ny);
+  header.Write<size_t>(ortho_attributes.Nz);
+  header.Write<uint64_t>(global_vertex_count_);
+  header.Write<size_t>(boundary_id_map_.size());
+  for (const auto& [bid, name] : boundary_id_map_)
+  {
+    header.Write<uint64_t>(bid);
+    header.Write<size_t>(name.size());
+    header.WriteBytes(name.data(), name.size());
+  }
+
+  //======================================== Serialize the local data
+  chi_data_types::ByteArray raw;
+  raw.Write<bool>(local_cells_renumbered_);
+  raw.Write<size_t>(local_cells_.size());
+  for (const auto& cell : local_cells_)
+    raw.Append(cell->Serialize());
+  raw.Write<size_t>(ghost_cells_.size());
+  for (const auto& cell : ghost_cells_)
+    raw.Append(cell->Serialize());
+  raw.Write<size_t>(vertices.NumLocallyStored());
+  for (const auto& [vid, vertex] : vertices)
+  {
+    raw.Write<uint64_t>(vid);
+    raw.Write<chi_mesh::Vector3>(vertex);
+  }
+
+  //======================================== Compute the offsets
+  // The file starts with the header size, the header, and the offset and
+  // size of the data of each location
+  uint64_t local_size = raw.Size();
+  std::vector<uint64_t> sizes(num_locations, 0);
+  MPI_Allgather(&local_size, 1, MPI_UINT64_T,
+                sizes.data(), 1, MPI_UINT64_T, Chi::mpi.comm);
+
+  chi_data_types::ByteArray prefix;
+  prefix.Write<uint64_t>(header.Size());
+  prefix.Append(header);
+
+  uint64_t offset = prefix.Size() + 2 * sizeof(uint64_t) * num_locations;
+  uint64_t local_offset = 0;
+  for (int locI = 0; locI < num_locations; ++locI)
+  {
+    if (locI == Chi::mpi.location_id) local_offset = offset;
+    prefix.Write<uint64_t>(offset);
+    prefix.Write<uint64_t>(sizes[locI]);
+    offset += sizes[locI];
+  }
+
+  //======================================== Write the file
+  MPI_File file;
+  const int error = MPI_File_open(Chi::mpi.comm, file_name.c_str(),
+                                  MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                  MPI_INFO_NULL, &file);
+  if (error != MPI_SUCCESS)
+    throw std::runtime_error("Failed to open file: " + file_name +
+                             " in call to ExportCellsToPartitionedFile.");
+  MPI_File_set_size(file, 0);
+
+  if (Chi::mpi.location_id == 0) WriteAt(file, 0, prefix.Data());
+
+  WriteAt(file, static_cast<MPI_Offset>(local_offset), raw.Data());
+
+  MPI_File_close(&file);
+
+  Chi::log.Log() << "Done exporting mesh to partitioned file.";
+}
+
+//###################################################################
+/**Reads the partitioned mesh exported by ExportCellsToPartitionedFile, each
+ * location reading its own cells, ghost cells and vertices with MPI-IO.
+ * The number of locations must be the one the file was exported with.
+ * Must be called by all locations, on an empty grid.*/
+void chi_mesh::MeshContinuum::
+  ReadCellsFromPartitionedFile(const std::string& file_name)
+{
+  Chi::log.Log() << "Reading mesh from partitioned file " << file_name;
+
+  const int num_locations = Chi::mpi.process_count;
+
+  MPI_File file;
+  const int error = MPI_File_open(Chi::mpi.comm, file_name.c_str(),
+                                  MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+  if (error != MPI_SUCCESS)
+    throw std::runtime_error("Failed to open file: " + file_name +
+                             " in call to ReadCellsFromPartitionedFile.");
+
+  //======================================== Read mesh level data
+  size_t address = 0;
+  const chi_data_types::ByteArray header_size_raw(
+    ReadAt(file, 0, sizeof(uint64_t)));
+  const auto header_size = header_size_raw.Read<uint64_t>(0);
+  const chi_data_types::ByteArray header(
+    ReadAt(file, sizeof(uint64_t), header_size));
+
+  ChiLogicalErrorIf(
+    header.Read<uint64_t>(address, &address) != PARTITIONED_FILE_TAG or
+      header.Read<int>(address, &address) != PARTITIONED_FILE_VERSION,
+    file_name + " is not a partitioned mesh file of this version.");
+
+  const auto file_num_locations = header.Read<int>(address, &address);
+  ChiLogicalErrorIf(file_num_locations != num_locations,
+                    file_name + " was exported with " +
+                    std::to_string(file_num_locations) + " locations, " +
+                    std::to_string(num_locations) + " are used.");
+
+  attributes = static_cast<MeshAttributes>(header.Read<int>(address,
+                                                            &address));
+  ortho_attributes.Nx = header.Read<size_t>(address, &address);
+  ortho_attributes.Ny = header.Read<size_t>(address, &address);
+  ortho_attributes.Nz = header.Read<size_t>(address, &address);
+  global_vertex_count_ = header.Read<uint64_t>(address, &address);
+
+  boundary_id_map_.clear();
+  const auto num_boundaries = header.Read<size_t>(address, &address);
+  for (size_t b = 0; b < num_boundaries; ++b)
+  {
+    const auto bid = header.Read<uint64_t>(address, &address);
+    const auto name_size = header.Read<size_t>(address, &address);
+    const auto* name = header.ReadBytes(address, name_size, &address);
+    boundary_id_map_[bid] =
+      std::string(reinterpret_cast<const char*>(name), name_size);
+  }
+
+  //======================================== Read the local data
+  const auto table_offset = static_cast<MPI_Offset>(
+    sizeof(uint64_t) + header_size +
+    2 * sizeof(uint64_t) * Chi::mpi.location_id);
+  const chi_data_types::ByteArray table_entry(
+    ReadAt(file, table_offset, 2 * sizeof(uint64_t)));
+  const auto local_offset = table_entry.Read<uint64_t>(0);
+  const auto local_size = table_entry.Read<uint64_t>(sizeof(uint64_t));
+
+  const chi_data_types::ByteArray raw(
+    ReadAt(file, static_cast<MPI_Offset>(local_offset), local_size));
+  MPI_File_close(&file);
+
+  address = 0;
+  const bool renumbered = raw.Read<bool>(address, &address);
+  const auto num_local_cells = raw.Read<size_t>(address, &address);
+  for (size_t c = 0; c < num_local_cells; ++c)
+    cells.push_back(std::make_unique<chi_mesh::Cell>(
+      chi_mesh::Cell::DeSerialize(raw, address)));
+  const auto num_ghost_cells = raw.Read<size_t>(address, &address);
+  for (size_t c = 0; c < num_ghost_cells; ++c)
+    cells.push_back(std::make_unique<chi_mesh::Cell>(
+      chi_mesh::Cell::DeSerialize(raw, address)));
+
+  const auto num_vertices = raw.Read<size_t>(address, &address);
+  for (size_t v = 0; v < num_vertices; ++v)
+  {
+    const auto vid = raw.Read<uint64_t>(address, &address);
+    const auto vertex = raw.Read<chi_mesh::Vector3>(address, &address);
+    vertices.Insert(vid, vertex);
+  }
+  local_cells_renumbered_ = renumbered;
+
+  Chi::log.Log() << "Done reading mesh from partitioned file.";
+}
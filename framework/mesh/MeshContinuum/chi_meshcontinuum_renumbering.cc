@@ -0,0 +1,163 @@
+#include "chi_meshcontinuum.h"
+#include "mesh/Cell/cell.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <algorithm>
+#include <queue>
+
+namespace
+{
+// ###################################################################
+/**Spreads the lower 21 bits of a value such that there are two zero bits
+ * between each original bit.*/
+uint64_t SpreadBits3D(uint64_t value)
+{
+  value &= 0x1fffff;
+  value = (value | value << 32) & 0x1f00000000ffff;
+  value = (value | value << 16) & 0x1f0000ff0000ff;
+  value = (value | value << 8) & 0x100f00f00f00f00f;
+  value = (value | value << 4) & 0x10c30c30c30c30c3;
+  value = (value | value << 2) & 0x1249249249249249;
+  return value;
+}
+} // namespace
+
+// ###################################################################
+/**Returns the local ids of the local cells ordered along a Morton
+ * (Z-order) space-filling curve through the cell centroids. Entry `k` is the
+ * current local id of the cell to be placed at position `k`.*/
+std::vector<uint64_t> chi_mesh::MeshContinuum::MakeMortonLocalCellOrder() const
+{
+  const size_t num_local_cells = local_cells_.size();
+  std::vector<uint64_t> order(num_local_cells);
+  if (num_local_cells == 0) return order;
+
+  chi_mesh::Vector3 xyz_min = local_cells_.front()->centroid_;
+  chi_mesh::Vector3 xyz_max = xyz_min;
+  for (const auto& cell : local_cells_)
+  {
+    const auto& c = cell->centroid_;
+    xyz_min = {std::min(xyz_min.x, c.x),
+               std::min(xyz_min.y, c.y),
+               std::min(xyz_min.z, c.z)};
+    xyz_max = {std::max(xyz_max.x, c.x),
+               std::max(xyz_max.y, c.y),
+               std::max(xyz_max.z, c.z)};
+  }
+
+  const double max_quantum = static_cast<double>(0x1fffff);
+  auto Quantize = [max_quantum](double value, double vmin, double vmax)
+  {
+    if (vmax - vmin < 1.0e-12) return uint64_t(0);
+    return static_cast<uint64_t>((value - vmin) / (vmax - vmin) * max_quantum);
+  };
+
+  std::vector<uint64_t> keys(num_local_cells);
+  for (const auto& cell : local_cells_)
+  {
+    const auto& c = cell->centroid_;
+    keys[cell->local_id_] =
+      SpreadBits3D(Quantize(c.x, xyz_min.x, xyz_max.x)) |
+      SpreadBits3D(Quantize(c.y, xyz_min.y, xyz_max.y)) << 1 |
+      SpreadBits3D(Quantize(c.z, xyz_min.z, xyz_max.z)) << 2;
+  }
+
+  for (size_t k = 0; k < num_local_cells; ++k)
+    order[k] = k;
+  std::stable_sort(order.begin(),
+                   order.end(),
+                   [&keys](uint64_t a, uint64_t b) { return keys[a] < keys[b]; });
+
+  return order;
+}
+
+// ###################################################################
+/**Returns the local ids of the local cells in the order that a sweep in
+ * direction `omega` would visit them, i.e. a topological ordering of the
+ * local cell dependency graph, traversed in wavefronts. Cycles are broken
+ * by releasing the lowest numbered remaining cell. Entry `k` is the current
+ * local id of the cell to be placed at position `k`.*/
+std::vector<uint64_t> chi_mesh::MeshContinuum::MakeSweepLocalCellOrder(
+  const chi_mesh::Vector3& omega) const
+{
+  const size_t num_local_cells = local_cells_.size();
+
+  //======================================== Count upwind local neighbors
+  std::vector<size_t> num_upwind(num_local_cells, 0);
+  for (const auto& cell : local_cells_)
+    for (const auto& face : cell->faces_)
+      if (face.IsNeighborLocal(*this) and omega.Dot(face.normal_) < 0.0)
+        ++num_upwind[cell->local_id_];
+
+  //======================================== Traverse in wavefronts
+  std::vector<uint64_t> order;
+  order.reserve(num_local_cells);
+  std::vector<bool> visited(num_local_cells, false);
+  std::queue<uint64_t> ready;
+  for (size_t c = 0; c < num_local_cells; ++c)
+    if (num_upwind[c] == 0) ready.push(c);
+
+  size_t next_unvisited = 0;
+  while (order.size() < num_local_cells)
+  {
+    if (ready.empty())
+    {
+      while (visited[next_unvisited]) ++next_unvisited;
+      num_upwind[next_unvisited] = 0;
+      ready.push(next_unvisited);
+    }
+
+    const uint64_t c = ready.front();
+    ready.pop();
+    if (visited[c]) continue;
+    visited[c] = true;
+    order.push_back(c);
+
+    for (const auto& face : local_cells_[c]->faces_)
+    {
+      if (not face.IsNeighborLocal(*this)) continue;
+      if (omega.Dot(face.normal_) <= 0.0) continue;
+
+      const uint64_t d = face.GetNeighborLocalID(*this);
+      if (not visited[d] and num_upwind[d] > 0 and --num_upwind[d] == 0)
+        ready.push(d);
+    }
+  }
+
+  return order;
+}
+
+// ###################################################################
+/**Renumbers the local cells such that the cell currently with local id
+ * `new_to_old_local_ids[k]` gets local id `k`. Global ids, and therefore
+ * face neighbor ids, are unchanged. Data structures indexed by local id
+ * that were built before this call are invalidated, hence this should be
+ * called straight after meshing.*/
+void chi_mesh::MeshContinuum::RenumberLocalCells(
+  const std::vector<uint64_t>& new_to_old_local_ids)
+{
+  const size_t num_local_cells = local_cells_.size();
+  ChiInvalidArgumentIf(new_to_old_local_ids.size() != num_local_cells,
+                       "The new ordering must contain every local cell.");
+
+  std::vector<std::unique_ptr<chi_mesh::Cell>> renumbered_cells(
+    num_local_cells);
+  for (size_t k = 0; k < num_local_cells; ++k)
+  {
+    const uint64_t old_id = new_to_old_local_ids[k];
+    ChiInvalidArgumentIf(old_id >= num_local_cells or
+                           local_cells_[old_id] == nullptr,
+                         "The new ordering must be a permutation of the "
+                         "local cell ids.");
+
+    renumbered_cells[k] = std::move(local_cells_[old_id]);
+    renumbered_cells[k]->local_id_ = k;
+    global_cell_id_to_local_id_map_.Insert(renumbered_cells[k]->global_id_, k);
+  }
+
+  local_cells_ = std::move(renumbered_cells);
+  local_cells_renumbered_ = true;
+  ++num_cell_revisions_;
+}
@@ -8,22 +8,44 @@
 
 //###################################################################
 /**Builds and returns a vector of unique boundary id's present in
- * the mesh.*/
+ * the mesh. The local boundary ids are collected by all threads. The
+ * global ids of the previous call are returned if no location's local
+ * boundary ids changed, which takes a single reduction instead of a
+ * gather. The local ids are compared, rather than the cells state, since
+ * boundary ids may be reassigned in place.*/
 std::vector<uint64_t> chi_mesh::MeshContinuum::GetDomainUniqueBoundaryIDs() const
 {
-  Chi::mpi.Barrier();
-  Chi::log.Log() << "Identifying unique boundary-ids.";
-
   //====================================== Develop local bndry-id set
   std::set<uint64_t> local_bndry_ids_set;
-  for (auto& cell : local_cells)
-    for (auto& face : cell.faces_)
-      if (not face.has_neighbor_)
-        local_bndry_ids_set.insert(face.neighbor_id_);
+  const auto num_local_cells = static_cast<int64_t>(local_cells_.size());
+#pragma omp parallel
+  {
+    std::set<uint64_t> thread_bndry_ids_set;
+#pragma omp for nowait
+    for (int64_t c = 0; c < num_local_cells; ++c)
+      for (const auto& face : local_cells_[c]->faces_)
+        if (not face.has_neighbor_)
+          thread_bndry_ids_set.insert(face.neighbor_id_);
+
+#pragma omp critical
+    local_bndry_ids_set.insert(thread_bndry_ids_set.begin(),
+                               thread_bndry_ids_set.end());
+  }
 
-  //====================================== Vectorify it and get local count
+  //====================================== Reuse the global ids if no
+  //                                       location's ids changed
   std::vector<uint64_t> local_bndry_ids(local_bndry_ids_set.begin(),
                                         local_bndry_ids_set.end());
+  int local_changed = (not global_boundary_ids_gathered_ or
+                       local_bndry_ids != local_boundary_ids_) ? 1 : 0;
+  int any_changed = 0;
+  MPI_Allreduce(&local_changed, &any_changed, 1, MPI_INT, MPI_LOR,
+                Chi::mpi.comm);
+  if (not any_changed) return global_boundary_ids_;
+
+  Chi::log.Log() << "Identifying unique boundary-ids.";
+
+  //====================================== Get local count
   int local_num_bndry_ids = (int)local_bndry_ids.size();
 
   //====================================== Everyone now tells everyone
@@ -67,5 +89,10 @@ std::vector<uint64_t> chi_mesh::MeshContinuum::GetDomainUniqueBoundaryIDs() cons
 
   std::vector<uint64_t> unique_bdnry_ids(globl_bndry_ids_set.begin(),
                                          globl_bndry_ids_set.end());
+
+  local_boundary_ids_ = std::move(local_bndry_ids);
+  global_boundary_ids_ = unique_bdnry_ids;
+  global_boundary_ids_gathered_ = true;
+
   return unique_bdnry_ids;
 }
\ No newline at end of file
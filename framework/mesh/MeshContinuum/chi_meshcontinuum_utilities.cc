@@ -12,9 +12,13 @@
 #include "chi_mpi.h"
 
 #include <algorithm>
+#include <limits>
+#include <map>
 
 // ###################################################################
-/**Populates a face histogram.
+/**Populates a face histogram, or returns the one populated by the previous
+ * call if neither the cells nor the tolerances changed. Consumers therefore
+ * share the same histogram.
  *
  * \param master_tolerance Multiple histograms will only be attempted
  * if the ratio of the maximum dofs-per-face to the average dofs-per-face
@@ -33,32 +37,54 @@ std::shared_ptr<chi_mesh::GridFaceHistogram>
 chi_mesh::MeshContinuum::MakeGridFaceHistogram(double master_tolerance,
                                                double slave_tolerance) const
 {
+  //================================================== Reuse if unchanged
+  if (grid_face_histogram_ and
+      grid_face_histogram_state_ == CellsState() and
+      grid_face_histogram_tolerances_ ==
+        std::make_pair(master_tolerance, slave_tolerance))
+    return grid_face_histogram_;
+
   std::vector<std::pair<size_t, size_t>> face_categories_list;
   //================================================== Fill histogram
-  std::vector<size_t> face_size_histogram;
-  for (const auto& cell : local_cells)
-    for (const auto& face : cell.faces_)
-      face_size_histogram.push_back(face.vertex_ids_.size());
-
-  std::stable_sort(face_size_histogram.begin(), face_size_histogram.end());
+  // Faces are counted per size, threaded, instead of sorting a list of
+  // face sizes
+  std::map<size_t, size_t> face_size_counts;
+  const auto num_local_cells = static_cast<int64_t>(local_cells_.size());
+#pragma omp parallel
+  {
+    std::map<size_t, size_t> thread_face_size_counts;
+#pragma omp for nowait
+    for (int64_t c = 0; c < num_local_cells; ++c)
+      for (const auto& face : local_cells_[c]->faces_)
+        ++thread_face_size_counts[face.vertex_ids_.size()];
+
+#pragma omp critical
+    for (const auto& [face_size, count] : thread_face_size_counts)
+      face_size_counts[face_size] += count;
+  }
 
   //================================================== Determine total face dofs
   size_t total_face_dofs_count = 0;
-  for (auto face_size : face_size_histogram)
-    total_face_dofs_count += face_size;
+  size_t total_num_faces = 0;
+  for (const auto& [face_size, count] : face_size_counts)
+  {
+    total_face_dofs_count += face_size * count;
+    total_num_faces += count;
+  }
 
   //================================================== Compute average and ratio
-  size_t smallest_face = face_size_histogram.front();
-  size_t largest_face = face_size_histogram.back();
-  size_t total_num_faces = face_size_histogram.size();
-  double average_dofs_per_face =
+  // Locations without cells get a single empty bin
+  const bool no_faces = face_size_counts.empty();
+  size_t smallest_face = no_faces ? 0 : face_size_counts.begin()->first;
+  size_t largest_face = no_faces ? 0 : face_size_counts.rbegin()->first;
+  double average_dofs_per_face = no_faces ? 1.0 :
     (double)total_face_dofs_count / (double)total_num_faces;
 
   std::stringstream outstr;
   outstr << "\nSmallest face = " << smallest_face;
   outstr << "\nLargest face = " << largest_face;
   outstr << "\nTotal face dofs = " << total_face_dofs_count;
-  outstr << "\nTotal faces = " << face_size_histogram.size();
+  outstr << "\nTotal faces = " << total_num_faces;
   outstr << "\nAverage dofs/face = " << average_dofs_per_face;
   outstr << "\nMax to avg ratio = "
          << (double)largest_face / average_dofs_per_face;
@@ -75,15 +101,18 @@ chi_mesh::MeshContinuum::MakeGridFaceHistogram(double master_tolerance,
       << "will be constructed.";
 
     //====================================== Build categories
+    // Traverses the faces in ascending size. The running average is at
+    // most the current size, and only moves towards it, hence only the
+    // first face of each size can start a new bin.
     size_t running_total_face_dofs = 0;
     size_t running_face_count = 0;
-    size_t running_face_size = face_size_histogram[0];
+    size_t running_face_size = smallest_face;
 
-    double running_average = (double)face_size_histogram[0];
+    double running_average = (double)smallest_face;
 
-    for (size_t f = 0; f < total_num_faces; ++f)
+    for (const auto& [face_size, count] : face_size_counts)
     {
-      if (((double)face_size_histogram[f] / running_average) > slave_tolerance)
+      if (((double)face_size / running_average) > slave_tolerance)
       {
         face_categories_list.emplace_back(running_face_size,
                                           running_face_count);
@@ -91,9 +120,9 @@ chi_mesh::MeshContinuum::MakeGridFaceHistogram(double master_tolerance,
         running_face_count = 0;
       }
 
-      running_face_size = face_size_histogram[f];
-      running_total_face_dofs += face_size_histogram[f];
-      running_face_count++;
+      running_face_size = face_size;
+      running_total_face_dofs += face_size * count;
+      running_face_count += count;
       running_average =
         (double)running_total_face_dofs / double(running_face_count);
       last_bin_num_faces = running_face_count;
@@ -115,7 +144,12 @@ chi_mesh::MeshContinuum::MakeGridFaceHistogram(double master_tolerance,
 
   Chi::log.LogAllVerbose2() << outstr.str();
 
-  return std::make_shared<GridFaceHistogram>(face_categories_list);
+  grid_face_histogram_ =
+    std::make_shared<GridFaceHistogram>(face_categories_list);
+  grid_face_histogram_state_ = CellsState();
+  grid_face_histogram_tolerances_ = {master_tolerance, slave_tolerance};
+
+  return grid_face_histogram_;
 }
 
 // ###################################################################
@@ -123,11 +157,179 @@ chi_mesh::MeshContinuum::MakeGridFaceHistogram(double master_tolerance,
  * the native index map.*/
 bool chi_mesh::MeshContinuum::IsCellLocal(uint64_t cell_global_index) const
 {
-  auto native_index = global_cell_id_to_local_id_map_.find(cell_global_index);
+  return global_cell_id_to_local_id_map_.Contains(cell_global_index);
+}
 
-  if (native_index != global_cell_id_to_local_id_map_.end()) return true;
+// ###################################################################
+size_t chi_mesh::MeshContinuum::GetMemoryUsage() const
+{
+  size_t num_bytes =
+    (local_cells_.capacity() + ghost_cells_.capacity()) *
+      sizeof(std::unique_ptr<chi_mesh::Cell>) +
+    global_cell_id_to_local_id_map_.GetMemoryUsage() +
+    global_cell_id_to_nonlocal_id_map_.GetMemoryUsage() +
+    vertices.GetMemoryUsage() +
+    face_neighbor_offsets_.capacity() * sizeof(size_t) +
+    face_neighbors_.capacity() * sizeof(const chi_mesh::Cell*) +
+    face_neighbor_indices_.capacity() * sizeof(FaceNeighborIndex);
+
+  for (const auto& cell : local_cells_)
+    num_bytes += cell->GetMemoryUsage();
+  for (const auto& cell : ghost_cells_)
+    num_bytes += cell->GetMemoryUsage();
+
+  if (compact_local_cells_)
+    num_bytes += compact_local_cells_->GetMemoryUsage();
+  if (cell_search_index_) num_bytes += cell_search_index_->GetMemoryUsage();
+
+  return num_bytes;
+}
 
-  return false;
+// ###################################################################
+/**Builds the table of face neighbors of the local cells used by
+ * FaceNeighbor and GetFaceNeighborIndex.*/
+void chi_mesh::MeshContinuum::BuildFaceNeighborTable() const
+{
+  face_neighbor_offsets_.assign(local_cells_.size() + 1, 0);
+  for (const auto& cell : local_cells_)
+    face_neighbor_offsets_[cell->local_id_ + 1] = cell->faces_.size();
+  for (size_t c = 0; c < local_cells_.size(); ++c)
+    face_neighbor_offsets_[c + 1] += face_neighbor_offsets_[c];
+
+  face_neighbors_.assign(face_neighbor_offsets_.back(), nullptr);
+  face_neighbor_indices_.assign(face_neighbor_offsets_.back(), {});
+  for (const auto& cell : local_cells_)
+  {
+    size_t k = face_neighbor_offsets_[cell->local_id_];
+    for (const auto& face : cell->faces_)
+    {
+      if (face.has_neighbor_)
+      {
+        auto& index = face_neighbor_indices_[k];
+        if (const auto local_id =
+              global_cell_id_to_local_id_map_.Find(face.neighbor_id_))
+        {
+          face_neighbors_[k] = local_cells_[*local_id].get();
+          index.local_id = static_cast<int64_t>(*local_id);
+          index.partition_id = Chi::mpi.location_id;
+        }
+        else
+        {
+          const uint64_t ghost_index =
+            global_cell_id_to_nonlocal_id_map_.At(face.neighbor_id_);
+          face_neighbors_[k] = ghost_cells_[ghost_index].get();
+          index.ghost_index = static_cast<int64_t>(ghost_index);
+          index.partition_id =
+            static_cast<int>(ghost_cells_[ghost_index]->partition_id_);
+        }
+      }
+      ++k;
+    }
+  }
+
+  face_neighbor_state_ = CellsState();
+}
+
+// ###################################################################
+/**Returns a compact (CSR) copy of the local cells for read-only loops
+ * over connectivity and face geometry. The copy is built on the first
+ * call, and rebuilt after the cells changed, hence that call is not
+ * thread safe. The copy is held until ReleaseCompactLocalCells is called
+ * or the cells are cleared.*/
+const chi_mesh::CompactLocalCells&
+chi_mesh::MeshContinuum::GetCompactLocalCells() const
+{
+  if (not compact_local_cells_ or
+      CellsState() != compact_local_cells_state_)
+  {
+    compact_local_cells_ = std::make_unique<CompactLocalCells>(*this);
+    compact_local_cells_state_ = CellsState();
+
+    Chi::log.Log0Verbose1()
+      << "Built compact local cells using "
+      << compact_local_cells_->GetMemoryUsage() / 1024 << " kB.";
+  }
+  return *compact_local_cells_;
+}
+
+// ###################################################################
+/**Returns the search index over the local cells, built on the first call
+ * after the cells changed, hence that call is not thread safe.*/
+const chi_mesh::LocalCellSearchIndex&
+chi_mesh::MeshContinuum::GetLocalCellSearchIndex() const
+{
+  if (not cell_search_index_ or CellsState() != cell_search_index_state_)
+  {
+    cell_search_index_ = std::make_unique<LocalCellSearchIndex>(*this);
+    cell_search_index_state_ = CellsState();
+
+    Chi::log.Log0Verbose1()
+      << "Built local cell search index with "
+      << cell_search_index_->GetNumBins() << " bins using "
+      << cell_search_index_->GetMemoryUsage() / 1024 << " kB.";
+  }
+  return *cell_search_index_;
+}
+
+// ###################################################################
+/**For each point, returns the local id of the local cell, with the lowest
+ * global id, containing it, or -1 if no local cell contains it. To find
+ * points on faces and vertices, a point is tested nudged towards the
+ * centroid of each candidate cell.*/
+std::vector<int64_t> chi_mesh::MeshContinuum::FindLocalCellsContainingPoints(
+  const std::vector<Vector3>& points) const
+{
+  const auto& search_index = GetLocalCellSearchIndex();
+
+  std::vector<int64_t> local_ids(points.size(), -1);
+  for (size_t p = 0; p < points.size(); ++p)
+  {
+    const auto& point = points[p];
+    uint64_t owner_global_id = 0;
+    search_index.ForEachCandidate(
+      point,
+      [&](const uint64_t local_id)
+      {
+        const auto& cell = local_cells[local_id];
+        if (local_ids[p] >= 0 and cell.global_id_ >= owner_global_id) return;
+
+        const auto nudged_point = point + 1.0e-6 * (cell.centroid_ - point);
+        if (CheckPointInsideCell(cell, nudged_point))
+        {
+          local_ids[p] = static_cast<int64_t>(local_id);
+          owner_global_id = cell.global_id_;
+        }
+      });
+  }
+
+  return local_ids;
+}
+
+// ###################################################################
+/**For each point, returns the lowest global id of the cells, across all
+ * locations, containing it, or the maximum uint64_t value if no cell
+ * contains it. Needs a single reduction for all the points, hence points
+ * should be located in batches. This is a collective call.*/
+std::vector<uint64_t> chi_mesh::MeshContinuum::FindCellsContainingPoints(
+  const std::vector<Vector3>& points) const
+{
+  const auto local_ids = FindLocalCellsContainingPoints(points);
+
+  std::vector<uint64_t> local_global_ids(points.size(),
+                                         std::numeric_limits<uint64_t>::max());
+  for (size_t p = 0; p < points.size(); ++p)
+    if (local_ids[p] >= 0)
+      local_global_ids[p] = local_cells[local_ids[p]].global_id_;
+
+  std::vector<uint64_t> global_ids(points.size(), 0);
+  MPI_Allreduce(local_global_ids.data(), // sendbuf
+                global_ids.data(),       // recvbuf
+                static_cast<int>(points.size()),
+                MPI_UINT64_T,            // count + datatype
+                MPI_MIN,                 // operation
+                Chi::mpi.comm);          // communicator
+
+  return global_ids;
 }
 
 // ###################################################################
@@ -291,7 +493,7 @@ size_t chi_mesh::MeshContinuum::MapCellFace(const chi_mesh::Cell& cur_cell,
 size_t
 chi_mesh::MeshContinuum::MapCellGlobalID2LocalID(uint64_t global_id) const
 {
-  return global_cell_id_to_local_id_map_.at(global_id);
+  return global_cell_id_to_local_id_map_.At(global_id);
 }
 
 // ###################################################################
@@ -317,9 +519,9 @@ chi_mesh::Vector3 chi_mesh::MeshContinuum::ComputeCentroidFromListOfNodes(
 size_t chi_mesh::MeshContinuum::CountCellsInLogicalVolume(
   const chi_mesh::LogicalVolume& log_vol) const
 {
-  size_t local_count = 0;
-  for (const auto& cell : local_cells)
-    if (log_vol.Inside(cell.centroid_)) ++local_count;
+  const auto& cell_mask = log_vol.GetLocalCellMask(*this);
+  const size_t local_count =
+    std::count(cell_mask.begin(), cell_mask.end(), true);
 
   size_t global_count = 0;
 
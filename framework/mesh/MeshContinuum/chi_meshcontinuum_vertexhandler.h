@@ -2,52 +2,88 @@
 #define CHI_MESHCONTINUUM_VERTEXHANDLER_H
 
 #include "mesh/chi_meshvector.h"
+#include "chi_meshcontinuum_cellidmap.h"
 
-#include <map>
+#include <vector>
+#include <utility>
 
 namespace chi_mesh
 {
 
-/**Manages a vertex map with custom calls.*/
+/**Manages the locally stored vertices with custom calls. The vertices are
+ * stored contiguously, in insertion order, as (global-id, vertex) pairs and
+ * a flat hash map remaps global ids to storage indices. References returned
+ * by the accessors are invalidated by Insert.*/
 class VertexHandler
 {
-  typedef std::map<uint64_t, chi_mesh::Vector3> GlobalIDMap;
+  typedef std::vector<std::pair<uint64_t, chi_mesh::Vector3>> VertexList;
 private:
-  std::map<uint64_t, chi_mesh::Vector3> m_global_id_vertex_map;
+  VertexList m_vertices;
+  CellIDMap m_global_id_to_local_id_map;
 
 public:
   // Iterators
-  GlobalIDMap::iterator begin() {return m_global_id_vertex_map.begin();}
-  GlobalIDMap::iterator end() {return m_global_id_vertex_map.end();}
+  VertexList::iterator begin() {return m_vertices.begin();}
+  VertexList::iterator end() {return m_vertices.end();}
 
-  GlobalIDMap::const_iterator begin() const {return m_global_id_vertex_map.begin();}
-  GlobalIDMap::const_iterator end() const {return m_global_id_vertex_map.end();}
+  VertexList::const_iterator begin() const {return m_vertices.begin();}
+  VertexList::const_iterator end() const {return m_vertices.end();}
 
   // Accessors
   chi_mesh::Vector3& operator[](const uint64_t global_id)
   {
-    return m_global_id_vertex_map.at(global_id);
+    return m_vertices[m_global_id_to_local_id_map.At(global_id)].second;
   }
 
   const chi_mesh::Vector3& operator[](const uint64_t global_id) const
   {
-    return m_global_id_vertex_map.at(global_id);
+    return m_vertices[m_global_id_to_local_id_map.At(global_id)].second;
   }
 
   // Utilities
+  /**Adds a vertex. As for a map, inserting an existing global id leaves
+   * the stored vertex unchanged.*/
   void Insert(const uint64_t global_id, const chi_mesh::Vector3& vec)
   {
-    m_global_id_vertex_map.insert(std::make_pair(global_id, vec));
+    if (m_global_id_to_local_id_map.Contains(global_id)) return;
+    m_global_id_to_local_id_map.Insert(global_id, m_vertices.size());
+    m_vertices.emplace_back(global_id, vec);
+  }
+
+  /**Changes the global id of each vertex with a global id in
+   * [first_id, first_id + new_ids.size()) to `new_ids[id - first_id]`.
+   * Of vertices mapped to the same id only the first stays addressable.*/
+  void RemapGlobalIDs(const uint64_t first_id,
+                      const std::vector<uint64_t>& new_ids)
+  {
+    m_global_id_to_local_id_map.Clear();
+    for (size_t v = 0; v < m_vertices.size(); ++v)
+    {
+      auto& global_id = m_vertices[v].first;
+      if (global_id >= first_id and global_id - first_id < new_ids.size())
+        global_id = new_ids[global_id - first_id];
+      if (not m_global_id_to_local_id_map.Contains(global_id))
+        m_global_id_to_local_id_map.Insert(global_id, v);
+    }
   }
 
   size_t NumLocallyStored() const
   {
-    return m_global_id_vertex_map.size();
+    return m_vertices.size();
+  }
+
+  /**Returns the number of bytes held by the vertices and their map.*/
+  size_t GetMemoryUsage() const
+  {
+    return m_vertices.capacity() * sizeof(VertexList::value_type) +
+           m_global_id_to_local_id_map.GetMemoryUsage();
   }
 
   void Clear()
   {
-    m_global_id_vertex_map.clear();
+    m_vertices.clear();
+    m_vertices.shrink_to_fit();
+    m_global_id_to_local_id_map.Clear();
   }
 };
 
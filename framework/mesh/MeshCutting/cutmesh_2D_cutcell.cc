@@ -3,17 +3,20 @@
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
 #include <algorithm>
-#include <functional>
 
 //###################################################################
-/**Cuts a polygon.*/
+/**Cuts a polygon. The cut edges must be sorted by their unique edges. The
+ * cell is replaced by one of the pieces and the others are appended to
+ * `new_cells`, leaving the mesh unchanged such that cells can be cut
+ * concurrently.*/
 void chi_mesh::mesh_cutting::
   CutPolygon(const std::vector<ECI> &cut_edges,
              const std::set<uint64_t> &cut_vertices,
              const Vector3 &plane_point,
              const Vector3 &plane_normal,
-             MeshContinuum &mesh,
-             chi_mesh::Cell& cell)
+             const MeshContinuum &mesh,
+             chi_mesh::Cell& cell,
+             std::vector<std::unique_ptr<chi_mesh::Cell>>& new_cells)
 {
   const auto& p = plane_point;
   const auto& n = plane_normal;
@@ -32,20 +35,7 @@ void chi_mesh::mesh_cutting::
   /**Utility function to check if an edge is in the "cut_edges" list.*/
   auto EdgeIsCut = [&cut_edges](const Edge& edge)
   {
-    Edge edge_set(std::min(edge.first,edge.second),
-                  std::max(edge.first,edge.second));
-
-    constexpr auto Arg1       = std::placeholders::_1;
-    constexpr auto Comparator = &ECI::Comparator;
-
-    auto result = std::find_if(cut_edges.begin(),
-                               cut_edges.end(),
-                               std::bind(Comparator,Arg1,edge_set));
-
-    if (result != cut_edges.end())
-      return std::make_pair(true,*result);
-
-    return std::make_pair(false,*result);
+    return FindEdgeCut(cut_edges, edge);
   };
 
   //============================================= Create and set vertex and edge
@@ -229,7 +219,8 @@ void chi_mesh::mesh_cutting::
     auto new_cell = std::make_unique<chi_mesh::Cell>(CellType::POLYGON,
                                                      CellType::TRIANGLE);
     PopulatePolygonFromVertices(mesh, loop, *new_cell);
-    mesh.cells.push_back(std::move(new_cell));
+    new_cell->material_id_ = cell.material_id_;
+    new_cells.push_back(std::move(new_cell));
   }
 }
 
@@ -2,6 +2,8 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include <algorithm>
+
 //###################################################################
 /**Makes a unique edge from a regular edge. A unique edge is an edge
  * with its 1st vertex-id the smallest of the two vertex-ids.*/
@@ -12,6 +14,23 @@ chi_mesh::mesh_cutting::Edge chi_mesh::mesh_cutting::
                           std::max(edge.first, edge.second));
 }
 
+//###################################################################
+/**Finds the cut info of an edge by a binary search of a list of cut edges
+ * sorted by their unique edges. The bool is false if the edge is not cut.*/
+std::pair<bool, chi_mesh::mesh_cutting::ECI> chi_mesh::mesh_cutting::
+  FindEdgeCut(const std::vector<ECI>& cut_edges, const Edge& edge)
+{
+  const Edge unique_edge = MakeUniqueEdge(edge);
+
+  auto result = std::lower_bound(cut_edges.begin(), cut_edges.end(),
+                                 unique_edge, &ECI::LessThanEdge);
+
+  if (result != cut_edges.end() and result->vertex_ids == unique_edge)
+    return std::make_pair(true, *result);
+
+  return std::make_pair(false, ECI());
+}
+
 //###################################################################
 /**Make an edge for a polygon given its edge index.*/
 std::pair<uint64_t,uint64_t> chi_mesh::mesh_cutting::
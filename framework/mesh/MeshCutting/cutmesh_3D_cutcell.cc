@@ -7,49 +7,31 @@
 
 #include <queue>
 #include <algorithm>
-#include <functional>
 
 //###################################################################
-/***/
+/**Cuts a polyhedron. The cut edges must be sorted by their unique edges.
+ * The cell is replaced by the piece on the negative side of the plane and
+ * the other piece is appended to `new_cells`, leaving the mesh unchanged
+ * such that cells can be cut concurrently.*/
 void chi_mesh::mesh_cutting::
   Cut3DCell(const std::vector<ECI> &global_cut_edges,
             const std::set<uint64_t> &global_cut_vertices,
             const Vector3 &plane_point,
             const Vector3 &plane_normal,
             double float_compare,
-            MeshContinuum &mesh,
+            const MeshContinuum &mesh,
             chi_mesh::Cell &cell,
+            std::vector<std::unique_ptr<chi_mesh::Cell>>& new_cells,
             bool verbose/*=false*/)
 {
   const auto& p = plane_point;
   const auto& n = plane_normal;
   const size_t cell_num_faces = cell.faces_.size();
 
-  /**Utility lambda to check if a vertex is in generic set.*/
-  auto NumberInSet = [](uint64_t number, const std::set<uint64_t>& the_set)
-  {
-    if (the_set.find(number) != the_set.end()) return true;
-
-    return false;
-  };
-
   /**Utility function to check if an edge is in the "cut_edges" list.*/
   auto EdgeIsCut = [](const Edge& edge, const std::vector<ECI>& cut_edges)
   {
-    Edge edge_set(std::min(edge.first,edge.second),
-                  std::max(edge.first,edge.second));
-
-    constexpr auto Arg1       = std::placeholders::_1;
-    constexpr auto Comparator = &ECI::Comparator;
-
-    auto result = std::find_if(cut_edges.begin(),
-                               cut_edges.end(),
-                               std::bind(Comparator,Arg1,edge_set));
-
-    if (result != cut_edges.end())
-      return std::make_pair(true,*result);
-
-    return std::make_pair(false,*result);
+    return FindEdgeCut(cut_edges, edge);
   };
 
   /**Utility lambda to check if a vertex is in generic list.*/
@@ -91,14 +73,24 @@ void chi_mesh::mesh_cutting::
 
   //============================================= Determine cut-edges relevant
   //                                              to this cell
+  // Looked up per face edge, hence a sorted list like the global one
   std::vector<ECI> local_cut_edges;
-  const std::set<uint64_t> local_vertex_id_set(cell.vertex_ids_.begin(),
-                                               cell.vertex_ids_.end());
-
-  for (auto& eci : global_cut_edges)
-    if (NumberInSet(eci.vertex_ids.first , local_vertex_id_set) and
-        NumberInSet(eci.vertex_ids.second, local_vertex_id_set))
-      local_cut_edges.push_back(eci);
+  for (const auto& face : cell.faces_)
+    for (size_t e=0; e<face.vertex_ids_.size(); ++e)
+    {
+      auto edge_cut_state = EdgeIsCut(
+        MakeEdgeFromPolygonEdgeIndex(face.vertex_ids_, e), global_cut_edges);
+      if (edge_cut_state.first)
+        local_cut_edges.push_back(edge_cut_state.second);
+    }
+  std::sort(local_cut_edges.begin(), local_cut_edges.end(),
+            [](const ECI& a, const ECI& b)
+            { return a.vertex_ids < b.vertex_ids; });
+  local_cut_edges.erase(
+    std::unique(local_cut_edges.begin(), local_cut_edges.end(),
+                [](const ECI& a, const ECI& b)
+                { return a.vertex_ids == b.vertex_ids; }),
+    local_cut_edges.end());
 
   if (verbose)
   {
@@ -323,8 +315,7 @@ void chi_mesh::mesh_cutting::
 
   cell_A_ptr->local_id_ = cell.local_id_;
   cell_A_ptr->global_id_ = cell.global_id_;
-
-  cell_B_ptr->global_id_ = mesh.local_cells.size();
+  cell_A_ptr->partition_id_ = cell.partition_id_;
 
   cell_A_ptr->material_id_ = cell.material_id_;
   cell_B_ptr->material_id_ = cell.material_id_;
@@ -347,7 +338,5 @@ void chi_mesh::mesh_cutting::
   }
 
   cell = cell_A;
-  mesh.cells.push_back(std::move(cell_B_ptr));
-
-
+  new_cells.push_back(std::move(cell_B_ptr));
 }
\ No newline at end of file
@@ -5,8 +5,22 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <map>
+
+namespace
+{
+/**Lexicographic ordering of vertex coordinates.*/
+bool CoordinatesLess(const chi_mesh::Vector3& a, const chi_mesh::Vector3& b)
+{
+  if (a.x != b.x) return a.x < b.x;
+  if (a.y != b.y) return a.y < b.y;
+  return a.z < b.z;
+}
+}//namespace
 
 //###################################################################
 /**Cuts a mesh with a plane.*/
@@ -16,234 +30,328 @@ void chi_mesh::mesh_cutting::
                    const Vector3 &plane_normal,
                    double merge_tolerance/*=1.0e-3*/,
                    double float_compare/*=1.0e-10*/)
+{
+  CutMeshWithPlanes(mesh, {CutPlane{plane_point, plane_normal}},
+                    merge_tolerance, float_compare);
+}
+
+//###################################################################
+/**Cuts a mesh with a sequence of planes, each plane cutting the cells
+ * resulting from the previous ones. The cells are classified and cut
+ * concurrently, and the new cells and vertices are only numbered globally
+ * once all the planes are applied. Must be called by all locations.
+ *
+ * Locations sharing a cut edge compute bit-identical cut points, since the
+ * end points of the edge are ordered by their coordinates, hence the new
+ * vertices are matched across locations by their coordinates.*/
+void chi_mesh::mesh_cutting::
+  CutMeshWithPlanes(MeshContinuum& mesh,
+                    const std::vector<CutPlane>& planes,
+                    double merge_tolerance/*=1.0e-3*/,
+                    double float_compare/*=1.0e-10*/)
 {
   const std::string function_name = __FUNCTION__;
 
-  const auto& p = plane_point;
-  const auto& n = plane_normal.Normalized();
+  const bool is_2D = mesh.local_cells.size() > 0 and
+                     mesh.local_cells[0].Type() == CellType::POLYGON;
 
-  Chi::log.Log() << "Cutting mesh with plane. "
-                << "Ref. Point: " << p.PrintS()
-                << " Normal: " << n.PrintS();
+  const uint64_t first_new_vertex_id = mesh.GetGlobalVertexCount();
+  uint64_t new_vertex_address = first_new_vertex_id;
+  std::vector<std::unique_ptr<chi_mesh::Cell>> new_cells;
 
-  //============================================= Snap vertices to plane within
-  //                                              merge tolerance to avoid
-  //                                              creating small cells or cutting
-  //                                              parallel faces
-  // Order N, num_vertices
-  size_t num_verts_snapped=0;
-  for (auto& id_vertex : mesh.vertices)
+  for (const auto& plane : planes)
   {
-    auto& vertex = id_vertex.second;
-    double d_from_plane = n.Dot(vertex - p);
-
-    if (std::fabs(d_from_plane) < merge_tolerance)
+    const auto& p = plane.point;
+    const auto n = plane.normal.Normalized();
+
+    Chi::log.Log() << "Cutting mesh with plane. "
+                  << "Ref. Point: " << p.PrintS()
+                  << " Normal: " << n.PrintS();
+
+    //========================================== Snap vertices to plane within
+    //                                           merge tolerance to avoid
+    //                                           creating small cells or
+    //                                           cutting parallel faces
+    const auto num_vertices =
+      static_cast<int64_t>(mesh.vertices.NumLocallyStored());
+    const auto vertices_begin = mesh.vertices.begin();
+    size_t num_verts_snapped=0;
+#pragma omp parallel for reduction(+:num_verts_snapped)
+    for (int64_t v = 0; v < num_vertices; ++v)
     {
-      vertex -= n*d_from_plane;
-      ++num_verts_snapped;
-    }
-  }
-
-  Chi::log.Log() << "Number of vertices snapped to plane: "
-                << num_verts_snapped;
+      auto& vertex = (vertices_begin + v)->second;
+      double d_from_plane = n.Dot(vertex - p);
 
-  //============================================= Perform quality checks
-  size_t num_bad_quality_cells = 0;
-  for (const auto& cell : mesh.local_cells)
-  {
-    if (cell.Type() == CellType::POLYGON)
-    {
-      if (not CheckPolygonQuality(mesh,cell))
-        ++num_bad_quality_cells;
+      if (std::fabs(d_from_plane) < merge_tolerance)
+      {
+        vertex -= n*d_from_plane;
+        ++num_verts_snapped;
+      }
     }
-    else if (cell.Type() == CellType::POLYHEDRON)
+
+    Chi::log.Log() << "Number of vertices snapped to plane: "
+                  << num_verts_snapped;
+
+    //========================================== Cells to process, including
+    //                                           those cut off by previous
+    //                                           planes
+    std::vector<chi_mesh::Cell*> cells;
+    cells.reserve(mesh.local_cells.size() + new_cells.size());
+    for (auto& cell : mesh.local_cells)
+      cells.push_back(&cell);
+    for (auto& cell_ptr : new_cells)
+      cells.push_back(cell_ptr.get());
+    const auto num_cells = static_cast<int64_t>(cells.size());
+
+    //========================================== Perform quality checks
+    size_t num_bad_quality_cells = 0;
+    size_t num_unsupported_cells = 0;
+#pragma omp parallel for \
+  reduction(+:num_bad_quality_cells,num_unsupported_cells)
+    for (int64_t c = 0; c < num_cells; ++c)
     {
-      if (not CheckPolyhedronQuality(mesh,cell,/*check_convexity*/true))
-        ++num_bad_quality_cells;
+      const auto& cell = *cells[c];
+      if (cell.Type() == CellType::POLYGON)
+      {
+        if (not CheckPolygonQuality(mesh,cell))
+          ++num_bad_quality_cells;
+      }
+      else if (cell.Type() == CellType::POLYHEDRON)
+      {
+        if (not CheckPolyhedronQuality(mesh,cell,/*check_convexity*/true))
+          ++num_bad_quality_cells;
+      }
+      else
+        ++num_unsupported_cells;
     }
-    else
+    if (num_unsupported_cells > 0)
       throw std::logic_error(function_name + ": Called for a mesh containing"
                              " an unsupported cell-type.");
-  }
-  if (num_bad_quality_cells > 0)
-    throw std::logic_error(function_name + ": Called for a mesh containing " +
-                           std::to_string(num_bad_quality_cells) +
-                           " bad quality cells.");
-
-  //============================================= Determine cells to cut
-  // Order N, num_cells
-  // A cell is a candidate for cutting if its
-  // vertices lay on both sides of the plane.
-  // So this algorithm just checks the sense wrt
-  // the plane. Works for both 2D and 3D
-  std::vector<chi_mesh::Cell*> cells_to_cut;
-
-  for (auto& cell : mesh.local_cells)
-  {
-    size_t num_neg_senses = 0;
-    size_t num_pos_senses = 0;
-    for (auto vid : cell.vertex_ids_)
+    if (num_bad_quality_cells > 0)
+      throw std::logic_error(function_name + ": Called for a mesh containing " +
+                             std::to_string(num_bad_quality_cells) +
+                             " bad quality cells.");
+
+    //========================================== Determine cells to cut
+    // A cell is a candidate for cutting if its
+    // vertices lay on both sides of the plane.
+    // So this algorithm just checks the sense wrt
+    // the plane. Works for both 2D and 3D
+    std::vector<char> cell_is_cut(cells.size(), 0);
+#pragma omp parallel for
+    for (int64_t c = 0; c < num_cells; ++c)
     {
-      const auto& x = mesh.vertices[vid];
-      double new_sense = n.Dot(x-p);
+      size_t num_neg_senses = 0;
+      size_t num_pos_senses = 0;
+      for (auto vid : cells[c]->vertex_ids_)
+      {
+        const auto& x = mesh.vertices[vid];
+        double new_sense = n.Dot(x-p);
 
-      if (new_sense < (0.0-float_compare)) ++num_neg_senses;
-      if (new_sense > (0.0+float_compare)) ++num_pos_senses;
+        if (new_sense < (0.0-float_compare)) ++num_neg_senses;
+        if (new_sense > (0.0+float_compare)) ++num_pos_senses;
 
-      if (num_neg_senses>0 && num_pos_senses>0)
-      {
-        cells_to_cut.emplace_back(&cell);
-        break;
-      }
-    }//for vid
-  }//for cell
-  Chi::log.Log() << "Number of cells to cut: " << cells_to_cut.size();
+        if (num_neg_senses>0 && num_pos_senses>0)
+        {
+          cell_is_cut[c] = 1;
+          break;
+        }
+      }//for vid
+    }//for cell
 
-  //============================================= Two-D algorithm
-  if (mesh.local_cells[0].Type() == CellType::POLYGON)
-  {
-    //====================================== Determine cut vertices
+    std::vector<chi_mesh::Cell*> cells_to_cut;
+    for (int64_t c = 0; c < num_cells; ++c)
+      if (cell_is_cut[c]) cells_to_cut.push_back(cells[c]);
+    Chi::log.Log() << "Number of cells to cut: " << cells_to_cut.size();
+
+    //========================================== Determine cut vertices
     std::set<uint64_t> cut_vertices;
-    {
-      for (auto& cell_ptr : cells_to_cut)
-        for (uint64_t vid : cell_ptr->vertex_ids_)
-        {
-          const auto vertex = mesh.vertices[vid];
-          double dv = std::fabs((vertex-p).Dot(n));
-          if (dv<float_compare)
-            cut_vertices.insert(vid);
-        }//for vid
-    }//populate cut_vertices
+    for (auto& cell_ptr : cells_to_cut)
+      for (uint64_t vid : cell_ptr->vertex_ids_)
+      {
+        const auto& vertex = mesh.vertices[vid];
+        double dv = std::fabs((vertex-p).Dot(n));
+        if (dv<float_compare)
+          cut_vertices.insert(vid);
+      }//for vid
 
     Chi::log.Log() << "Number of cut vertices: " << cut_vertices.size();
 
-    //====================================== Build unique edges
-    size_t num_edges_cut=0;
+    //========================================== Build unique edges
     std::set<Edge> edges_set;
     for (auto& cell_ptr : cells_to_cut)
     {
       const auto& cell = *cell_ptr;
-      const size_t num_edges = cell.vertex_ids_.size();
 
-      for (size_t e=0; e<num_edges; ++e)
-      {
-        auto edge = MakeEdgeFromPolygonEdgeIndex(cell.vertex_ids_, e);
-        edges_set.insert(std::make_pair(std::min(edge.first,edge.second),
-                                        std::max(edge.first,edge.second)));
-      }
+      if (is_2D)
+        for (size_t e=0; e<cell.vertex_ids_.size(); ++e)
+          edges_set.insert(
+            MakeUniqueEdge(MakeEdgeFromPolygonEdgeIndex(cell.vertex_ids_, e)));
+      else
+        for (auto& face : cell.faces_)
+          for (size_t e=0; e<face.vertex_ids_.size(); ++e)
+            edges_set.insert(
+              MakeUniqueEdge(MakeEdgeFromPolygonEdgeIndex(face.vertex_ids_,
+                                                          e)));
     }//for cell - built edges_set
+    const std::vector<Edge> edges(edges_set.begin(), edges_set.end());
+    const auto num_edges = static_cast<int64_t>(edges.size());
+
+    //========================================== Determine cut edges
+    std::vector<char> edge_is_cut(edges.size(), 0);
+    std::vector<chi_mesh::Vector3> cut_points(edges.size());
+#pragma omp parallel for
+    for (int64_t e = 0; e < num_edges; ++e)
+    {
+      const auto* v0 = &mesh.vertices[edges[e].first];
+      const auto* v1 = &mesh.vertices[edges[e].second];
+      if (CoordinatesLess(*v1, *v0)) std::swap(v0, v1);
 
-    uint64_t new_vertex_address = mesh.GetGlobalVertexCount();
+      if (CheckPlaneLineIntersect(n,p,*v0,*v1,cut_points[e]))
+      {
+        double dv0 = std::fabs((*v0-p).Dot(n));
+        double dv1 = std::fabs((*v1-p).Dot(n));
+        if (dv0>float_compare and dv1>float_compare)
+          edge_is_cut[e] = 1;
+      }
+    }//for edge - determine cut
 
-    //====================================== Determine cut edges
+    // The edges are sorted, hence so are the cut edges
     std::vector<ECI> cut_edges;
-    {
-      for (auto& edge : edges_set)
+    for (int64_t e = 0; e < num_edges; ++e)
+      if (edge_is_cut[e])
       {
-        const auto& v0 = mesh.vertices[edge.first];
-        const auto& v1 = mesh.vertices[edge.second];
-
-        chi_mesh::Vector3 cut_point;
-
-        if (CheckPlaneLineIntersect(n,p,v0,v1,cut_point))
-        {
-          double dv0 = std::fabs((v0-p).Dot(n));
-          double dv1 = std::fabs((v1-p).Dot(n));
-          if (dv0>float_compare and dv1>float_compare)
-          {
-            mesh.vertices.Insert(new_vertex_address,cut_point);
-            cut_edges.emplace_back(edge, new_vertex_address++);
-            ++num_edges_cut;
-          }
-        }
-      }//for edge - determine cut
-    }//populate edges cut
-
-    Chi::log.Log() << "Number of cut edges: " << num_edges_cut;
-
-    //====================================== Process cells that are cut
-    for (auto& cell_ptr : cells_to_cut)
-    {
-      auto& cell = *cell_ptr;
+        mesh.vertices.Insert(new_vertex_address, cut_points[e]);
+        cut_edges.emplace_back(edges[e], new_vertex_address++);
+      }
 
-      CutPolygon(cut_edges,cut_vertices,p,n,mesh,cell);
-    }//for cell_ptr
-  }//two-D
+    Chi::log.Log() << "Number of cut edges: " << cut_edges.size();
 
-  //============================================= Three-D algorithm
-  if (mesh.local_cells[0].Type() == CellType::POLYHEDRON)
-  {
-    //====================================== Determine cut vertices
-    std::set<uint64_t> cut_vertices;
-    {
-      for (auto& cell_ptr : cells_to_cut)
-        for (uint64_t vid : cell_ptr->vertex_ids_)
-        {
-          const auto& vertex = mesh.vertices[vid];
-          double dv = std::fabs((vertex-p).Dot(n));
-          if (dv<float_compare)
-            cut_vertices.insert(vid);
-        }//for vid
-    }//populate cut_vertices
-
-    //====================================== Build unique edges
-    size_t num_edges_cut=0;
-    std::set<Edge> edges_set;
-    for (auto& cell_ptr : cells_to_cut)
+    //========================================== Process cells that are cut
+    const auto num_cells_to_cut = static_cast<int64_t>(cells_to_cut.size());
+    std::vector<std::vector<std::unique_ptr<chi_mesh::Cell>>>
+      cut_off_cells(cells_to_cut.size());
+    std::string error;
+    const auto& const_mesh = mesh;
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int64_t c = 0; c < num_cells_to_cut; ++c)
     {
-      const auto& cell = *cell_ptr;
-
-      for (auto& face : cell.faces_)
+      try
       {
-        const size_t num_edges = face.vertex_ids_.size();
+        if (is_2D)
+          CutPolygon(cut_edges,cut_vertices,p,n,
+                     const_mesh,*cells_to_cut[c],cut_off_cells[c]);
+        else
+          Cut3DCell(cut_edges, cut_vertices,
+                    p,n,
+                    float_compare,
+                    const_mesh,*cells_to_cut[c],cut_off_cells[c]);
+      }
+      catch (const std::exception& e)
+      {
+#pragma omp critical
+        error = e.what();
+      }
+    }//for cell
+    if (not error.empty()) throw std::logic_error(function_name + ": " + error);
+
+    for (auto& cell_pieces : cut_off_cells)
+      for (auto& cell_ptr : cell_pieces)
+        new_cells.push_back(std::move(cell_ptr));
+  }//for plane
+
+  //============================================= Consolidate vertex ids
+  const int num_locations = Chi::mpi.process_count;
+  const int num_local_new_vertices =
+    static_cast<int>(new_vertex_address - first_new_vertex_id);
+
+  std::vector<double> local_coordinates;
+  local_coordinates.reserve(3 * num_local_new_vertices);
+  for (uint64_t vid = first_new_vertex_id; vid < new_vertex_address; ++vid)
+  {
+    const auto& vertex = mesh.vertices[vid];
+    local_coordinates.insert(local_coordinates.end(),
+                             {vertex.x, vertex.y, vertex.z});
+  }
 
-        for (size_t e=0; e<num_edges; ++e)
-        {
-          auto edge = MakeEdgeFromPolygonEdgeIndex(face.vertex_ids_, e);
-          edges_set.insert(std::make_pair(std::min(edge.first,edge.second),
-                                          std::max(edge.first,edge.second)));
-        }
-      }//for face
-    }//for cell - built edges_set
+  std::vector<int> counts(num_locations, 0);
+  MPI_Allgather(&num_local_new_vertices, 1, MPI_INT,
+                counts.data(), 1, MPI_INT, Chi::mpi.comm);
 
-    uint64_t new_vertex_address = mesh.GetGlobalVertexCount();
+  std::vector<int> value_counts(num_locations, 0);
+  std::vector<int> value_displs(num_locations, 0);
+  for (int locI = 0; locI < num_locations; ++locI)
+  {
+    value_counts[locI] = 3 * counts[locI];
+    if (locI > 0)
+      value_displs[locI] = value_displs[locI-1] + value_counts[locI-1];
+  }
 
-    //====================================== Determine cut edges
-    std::vector<ECI> cut_edges;
+  std::vector<double> coordinates(
+    static_cast<size_t>(value_displs.back() + value_counts.back()), 0.0);
+  MPI_Allgatherv(local_coordinates.data(), 3 * num_local_new_vertices,
+                 MPI_DOUBLE,
+                 coordinates.data(), value_counts.data(), value_displs.data(),
+                 MPI_DOUBLE, Chi::mpi.comm);
+
+  // Numbered in the order of the locations
+  std::map<std::array<double, 3>, uint64_t> coordinates_to_id;
+  std::vector<uint64_t> new_vertex_ids(num_local_new_vertices);
+  uint64_t global_vertex_count = first_new_vertex_id;
+  size_t k = 0;
+  for (int locI = 0; locI < num_locations; ++locI)
+    for (int v = 0; v < counts[locI]; ++v, k += 3)
     {
-      for (auto& edge : edges_set)
-      {
-        const auto& v0 = mesh.vertices[edge.first];
-        const auto& v1 = mesh.vertices[edge.second];
+      const std::array<double, 3> key = {coordinates[k],
+                                         coordinates[k + 1],
+                                         coordinates[k + 2]};
+      const auto [it, inserted] =
+        coordinates_to_id.emplace(key, global_vertex_count);
+      if (inserted) ++global_vertex_count;
+      if (locI == Chi::mpi.location_id) new_vertex_ids[v] = it->second;
+    }
 
-        chi_mesh::Vector3 cut_point;
+  mesh.vertices.RemapGlobalIDs(first_new_vertex_id, new_vertex_ids);
+  mesh.SetGlobalVertexCount(global_vertex_count);
 
-        if (CheckPlaneLineIntersect(n,p,v0,v1,cut_point))
-        {
-          double dv0 = std::fabs((v0-p).Dot(n));
-          double dv1 = std::fabs((v1-p).Dot(n));
-          if (dv0>float_compare and dv1>float_compare)
-          {
-            mesh.vertices.Insert(new_vertex_address,cut_point);
-            cut_edges.emplace_back(edge, new_vertex_address++);
-            ++num_edges_cut;
-          }
-        }
-      }//for edge - determine cut
-    }//populate edges cut
+  auto RemapIDs = [first_new_vertex_id, &new_vertex_ids](
+    std::vector<uint64_t>& vertex_ids)
+  {
+    for (auto& vid : vertex_ids)
+      if (vid >= first_new_vertex_id and
+          vid - first_new_vertex_id < new_vertex_ids.size())
+        vid = new_vertex_ids[vid - first_new_vertex_id];
+  };
+
+  std::vector<chi_mesh::Cell*> cells;
+  for (auto& cell : mesh.local_cells)
+    cells.push_back(&cell);
+  for (auto& cell_ptr : new_cells)
+    cells.push_back(cell_ptr.get());
+  const auto num_cells = static_cast<int64_t>(cells.size());
+#pragma omp parallel for
+  for (int64_t c = 0; c < num_cells; ++c)
+  {
+    RemapIDs(cells[c]->vertex_ids_);
+    for (auto& face : cells[c]->faces_)
+      RemapIDs(face.vertex_ids_);
+  }
 
-    Chi::log.Log() << "Number of cut edges: " << num_edges_cut;
+  //============================================= Add the new cells
+  const uint64_t num_global_cells = mesh.GetGlobalNumberOfCells();
+  const uint64_t num_local_new_cells = new_cells.size();
+  uint64_t new_cell_offset = 0;
+  MPI_Exscan(&num_local_new_cells, &new_cell_offset, 1, MPI_UINT64_T,
+             MPI_SUM, Chi::mpi.comm);
+  if (Chi::mpi.location_id == 0) new_cell_offset = 0;
 
-    //====================================== Process cells that are cut
-    for (auto& cell_ptr : cells_to_cut)
-    {
-      Cut3DCell(cut_edges, cut_vertices,
-                plane_point,plane_normal,
-                float_compare,
-                mesh,*cell_ptr);
-    }//for cell_ptr
+  for (auto& cell_ptr : new_cells)
+  {
+    cell_ptr->global_id_ = num_global_cells + new_cell_offset++;
+    cell_ptr->partition_id_ = Chi::mpi.location_id;
+    mesh.cells.push_back(std::move(cell_ptr));
   }
 
-  Chi::log.Log() << "Done cutting mesh with plane. Num cells = "
+  Chi::log.Log() << "Done cutting mesh with planes. Num cells = "
                 << mesh.local_cells.size();
-}
\ No newline at end of file
+}
@@ -32,10 +32,27 @@ namespace mesh_cutting
     {
       return ref_edge == edge_cut_info.vertex_ids;
     }
+
+    /**Orders by edge, for binary searches of sorted cut-edge lists.*/
+    static
+    bool LessThanEdge(const ECI& edge_cut_info,
+                      const Edge& ref_edge)
+    {
+      return edge_cut_info.vertex_ids < ref_edge;
+    }
+  };
+
+  /**A cutting plane, given by a reference point and a normal.*/
+  struct CutPlane
+  {
+    Vector3 point;
+    Vector3 normal;
   };
 
   //2D_utils
   Edge MakeUniqueEdge(const Edge& edge);
+  std::pair<bool, ECI> FindEdgeCut(const std::vector<ECI>& cut_edges,
+                                   const Edge& edge);
   Edge MakeEdgeFromPolygonEdgeIndex(const std::vector<uint64_t>& vertex_ids,
                                     size_t edge_index);
   chi_mesh::Vector3 GetEdgeCentroid(const Edge& edge,
@@ -55,8 +72,9 @@ namespace mesh_cutting
                   const std::set<uint64_t>& cut_vertices,
                   const Vector3 &plane_point,
                   const Vector3 &plane_normal,
-                  MeshContinuum& mesh,
-                  chi_mesh::Cell& cell);
+                  const MeshContinuum& mesh,
+                  chi_mesh::Cell& cell,
+                  std::vector<std::unique_ptr<chi_mesh::Cell>>& new_cells);
 
   //3D_utils
   bool CheckPolyhedronQuality(const MeshContinuum& mesh,
@@ -85,8 +103,9 @@ namespace mesh_cutting
                  const Vector3 &plane_point,
                  const Vector3 &plane_normal,
                  double float_compare,
-                 MeshContinuum& mesh,
+                 const MeshContinuum& mesh,
                  chi_mesh::Cell& cell,
+                 std::vector<std::unique_ptr<chi_mesh::Cell>>& new_cells,
                  bool verbose=false);
 
   //plane
@@ -95,6 +114,10 @@ namespace mesh_cutting
                         const Vector3& plane_normal,
                         double merge_tolerance=1.0e-3,
                         double float_compare=1.0e-10);
+  void CutMeshWithPlanes(MeshContinuum& mesh,
+                         const std::vector<CutPlane>& planes,
+                         double merge_tolerance=1.0e-3,
+                         double float_compare=1.0e-10);
 }
 }
 
@@ -35,8 +35,10 @@ int chiMeshHandlerExportMeshToObj(lua_State* L)
 
 
 //###################################################################
-/**Exports the mesh to vtu format.
+/**Exports the mesh to vtu format, one piece per process.
 \param FileName char Base name of the file to be used.
+\param BoundaryOnly bool Optional. Flag to export only the boundary faces.
+                         Default = `false`.
 \ingroup LuaMeshHandler
 */
 int chiMeshHandlerExportMeshToVTK(lua_State* L)
@@ -44,22 +46,31 @@ int chiMeshHandlerExportMeshToVTK(lua_State* L)
   //============================================= Check arguments
   const std::string fname = __FUNCTION__;
   const int num_args = lua_gettop(L);
-  if (num_args != 1)
+  if (num_args < 1)
     LuaPostArgAmountError(fname, 1, num_args);
 
   const std::string file_name = lua_tostring(L,1);
 
+  bool boundary_only = false;
+  if (num_args >= 2)
+  {
+    LuaCheckBoolValue(fname, L, 2);
+    boundary_only = lua_toboolean(L, 2);
+  }
+
   //============================================= Get current handler
   auto& cur_hndlr = chi_mesh::GetCurrentHandler();
 
   auto& grid = cur_hndlr.GetGrid();
-  grid->ExportCellsToVTK(file_name);
+  grid->ExportCellsToVTK(file_name, boundary_only);
 
   return 0;
 }
 
 //###################################################################
-/**Exports the mesh to exodus format (.e extensions).
+/**Exports the mesh to exodus format (.e extensions). In parallel each
+process writes its own file, `FileName.e.<P>.<rank>`, which can be joined
+with SEACAS epu.
 \param FileName char Base name of the file to be used.
 \param suppress_nodesets bool Optional. Flag to suppress exporting nodesets.
                               Default = `false`.
@@ -98,4 +109,43 @@ int chiMeshHandlerExportMeshToExodus(lua_State* L)
   grid->ExportCellsToExodus(file_name, suppress_nodesets, suppress_sidesets);
 
   return 0;
-}
\ No newline at end of file
+}
+//###################################################################
+/**Exports the partitioned mesh to a single file, from which runs with the
+same number of processes can read it with a volume mesher of type
+VOLUMEMESHER_PARTITIONED_FILE, skipping the reading of the source mesh, the
+building of the connectivity and the partitioning.
+\param FileName char Name of the file.
+
+### Example
+\code
+chiVolumeMesherExecute()
+chiMeshHandlerExportMeshToPartitionedFile("mesh.cpm")
+\endcode
+and in subsequent runs
+\code
+chiMeshHandlerCreate()
+chiVolumeMesherCreate(VOLUMEMESHER_PARTITIONED_FILE, "mesh.cpm")
+chiVolumeMesherExecute()
+\endcode
+\ingroup LuaMeshHandler
+*/
+int chiMeshHandlerExportMeshToPartitionedFile(lua_State* L)
+{
+  //============================================= Check arguments
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckStringValue(fname, L, 1);
+  const std::string file_name = lua_tostring(L,1);
+
+  //============================================= Get current handler
+  auto& cur_hndlr = chi_mesh::GetCurrentHandler();
+
+  auto& grid = cur_hndlr.GetGrid();
+  grid->ExportCellsToPartitionedFile(file_name);
+
+  return 0;
+}
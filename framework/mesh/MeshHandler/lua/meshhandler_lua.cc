@@ -14,6 +14,7 @@ RegisterLuaFunctionAsIs(chiMeshHandlerSetCurrent);
 RegisterLuaFunctionAsIs(chiMeshHandlerExportMeshToObj);
 RegisterLuaFunctionAsIs(chiMeshHandlerExportMeshToVTK);
 RegisterLuaFunctionAsIs(chiMeshHandlerExportMeshToExodus);
+RegisterLuaFunctionAsIs(chiMeshHandlerExportMeshToPartitionedFile);
 
 //#############################################################################
 /** Creates a mesh handler and sets it as "current".
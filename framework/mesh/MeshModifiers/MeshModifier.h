@@ -3,10 +3,15 @@
 
 #include "ChiObject.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace chi_mesh
 {
 
-/**Base class for mesh modifiers*/
+/**Base class for mesh modifiers. Modifiers that move vertices report
+ * them, such that the geometry derived from the vertices can be updated
+ * for the affected cells only.*/
 class MeshModifier : public ChiObject
 {
 public:
@@ -14,8 +19,17 @@ public:
 
   virtual void Apply() = 0;
   virtual ~MeshModifier() = default;
+
+  /**Returns the ids of the vertices moved by the last call to Apply.*/
+  const std::vector<uint64_t>& GetMovedVertexIDs() const
+  {
+    return moved_vertex_ids_;
+  }
+
 protected:
   MeshModifier() = default;
+
+  std::vector<uint64_t> moved_vertex_ids_;
 };
 
 }
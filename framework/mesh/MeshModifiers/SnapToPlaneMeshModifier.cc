@@ -9,6 +9,8 @@
 #include "mesh/MeshHandler/chi_meshhandler.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include <algorithm>
+
 namespace chi_mesh
 {
 
@@ -61,12 +63,15 @@ SnapToPlaneMeshModifier::SnapToPlaneMeshModifier(
                     "Cannot only be used in serial");
 }
 
+// ###################################################################
+/**Snaps the vertices and recomputes the geometry of the cells with a
+ * snapped vertex, including the cells that share a snapped vertex with the
+ * cell it was found in.*/
 void SnapToPlaneMeshModifier::Apply()
 {
   auto& grid = *chi_mesh::GetCurrentHandler().GetGrid();
 
   std::vector<uint64_t> snapped_vertex_ids;
-  std::set<uint64_t> cell_ids_modified;
 
   if (check_face_alignment_)
     for (const auto& cell : grid.local_cells)
@@ -84,11 +89,10 @@ void SnapToPlaneMeshModifier::Apply()
           {
             const double d = (grid.vertices[vid] - point_).Dot(normal_);
 
-            if (std::fabs(d) < tol_)
+            if (std::fabs(d) < tol_ and d != 0.0)
             {
               grid.vertices[vid] -= d * normal_;
               snapped_vertex_ids.push_back(vid);
-              cell_ids_modified.insert(cell.local_id_);
             }
           }
       } // for face
@@ -100,25 +104,25 @@ void SnapToPlaneMeshModifier::Apply()
       {
         const double d = (grid.vertices[vid] - point_).Dot(normal_);
 
-        if (std::fabs(d) < tol_)
+        if (std::fabs(d) < tol_ and d != 0.0)
         {
           grid.vertices[vid] -= d * normal_;
           snapped_vertex_ids.push_back(vid);
-          cell_ids_modified.insert(cell.local_id_);
         }
       }
     }   // for cell
 
+  std::sort(snapped_vertex_ids.begin(), snapped_vertex_ids.end());
+  snapped_vertex_ids.erase(
+    std::unique(snapped_vertex_ids.begin(), snapped_vertex_ids.end()),
+    snapped_vertex_ids.end());
+  moved_vertex_ids_ = std::move(snapped_vertex_ids);
+
   // Modifying cells
-  for (const uint64_t cell_local_id : cell_ids_modified)
-  {
-    grid.local_cells[cell_local_id].RecomputeCentroidsAndNormals(grid);
-    //for (const auto& face : grid.local_cells[cell_local_id_].faces_)
-    //  chi::log.Log() << face.normal_.PrintStr();
-  }
-
-  Chi::log.Log0Verbose1() << "Number of cells modified "
-                          << cell_ids_modified.size();
+  grid.RecomputeCellGeometry(moved_vertex_ids_);
+
+  Chi::log.Log0Verbose1() << "Number of vertices snapped "
+                          << moved_vertex_ids_.size();
 }
 
 } // namespace chi_mesh
\ No newline at end of file
@@ -12,6 +12,7 @@
 RegisterLuaFunctionAsIs(chiMeshCreateUnpartitioned1DOrthoMesh);
 RegisterLuaFunctionAsIs(chiMeshCreateUnpartitioned2DOrthoMesh);
 RegisterLuaFunctionAsIs(chiMeshCreateUnpartitioned3DOrthoMesh);
+RegisterLuaFunctionAsIs(chiMeshCreatePartitionedOrthoMesh);
 
 //###################################################################
 /** Creates a 1D Mesh from an array of 1D vertices.
@@ -278,4 +279,50 @@ int chiMeshCreateUnpartitioned3DOrthoMesh(lua_State* L)
   lua_pushnumber(L,0);
 
   return 2;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/** Sets up an orthogonal mesh, from one to three arrays of 1D vertices,
+that the volume mesher builds directly in partitioned form. Every process
+only creates its own KBA block, of the `PARTITION_X/Y/Z` volume mesher
+properties, and its ghost cells. Hence, unlike the unpartitioned macros,
+no process ever holds the whole mesh. Cell ids and boundary ids are the
+same as those of the unpartitioned macros.
+
+\param x_nodes array_float Nodes along x, or along z if it is the only
+                           argument.
+\param y_nodes array_float (Optional) Nodes along y.
+\param z_nodes array_float (Optional) Nodes along z.
+
+\ingroup LuaMeshMacros
+
+##_
+
+### Example
+An example 3D mesh creation on 8 processes below:
+\code
+chiMeshHandlerCreate()
+nodes={0.0,0.1,0.2,0.3,0.4,0.5,0.6,0.7,0.8,0.9,1.0}
+chiMeshCreatePartitionedOrthoMesh(nodes,nodes,nodes)
+chiVolumeMesherSetKBAPartitioningPxPyPz(2,2,2)
+chiVolumeMesherExecute();
+\endcode
+*/
+int chiMeshCreatePartitionedOrthoMesh(lua_State* L)
+{
+  const std::string fname = "chiMeshCreatePartitionedOrthoMesh";
+  const int num_args = lua_gettop(L);
+  if (num_args < 1 or num_args > 3)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  std::vector<std::vector<double>> arrays(num_args);
+  for (int a = 0; a < num_args; ++a)
+  {
+    LuaCheckTableValue(fname, L, a + 1);
+    LuaPopulateVectorFrom1DArray(fname, L, a + 1, arrays[a]);
+  }
+
+  chi_mesh::CreatePartitionedOrthoMesh(arrays);
+
+  return 0;
+}
@@ -4,5 +4,6 @@
 int chiMeshCreateUnpartitioned1DOrthoMesh(lua_State* L);
 int chiMeshCreateUnpartitioned2DOrthoMesh(lua_State* L);
 int chiMeshCreateUnpartitioned3DOrthoMesh(lua_State* L);
+int chiMeshCreatePartitionedOrthoMesh(lua_State* L);
 
 #endif //CHITECH_LUA_MESH_ORTHOMACROS_H
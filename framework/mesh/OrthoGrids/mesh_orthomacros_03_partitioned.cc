@@ -0,0 +1,44 @@
+#include "mesh/chi_mesh.h"
+
+#include "mesh/MeshHandler/chi_meshhandler.h"
+#include "mesh/SurfaceMesher/Predefined/surfmesher_predefined.h"
+#include "mesh/VolumeMesher/OrthoPartitioned/volmesher_orthopart.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+//###################################################################
+/**Sets up an orthogonal mesh, from one to three sets of 1D vertices, that
+ * the volume mesher builds directly in partitioned form. A single set
+ * lies along z, as for CreateUnpartitioned1DOrthoMesh, otherwise the sets
+ * are along x, y and z. Unlike the unpartitioned macros, the mesh is
+ * partitioned KBA-style with the partition_x/y/z volume mesher options.*/
+void chi_mesh::CreatePartitionedOrthoMesh(
+  const std::vector<std::vector<double>>& vertices_1d)
+{
+  const size_t dimension = vertices_1d.size();
+  ChiInvalidArgumentIf(dimension < 1 or dimension > 3,
+                       "One to three vertex lists are required.");
+  for (const auto& vertices : vertices_1d)
+    ChiInvalidArgumentIf(vertices.size() < 2,
+                         "A vertex list needs at least two vertices.");
+
+  std::array<std::vector<double>,3> nodes = {std::vector<double>{0.0},
+                                             std::vector<double>{0.0},
+                                             std::vector<double>{0.0}};
+  if (dimension == 1)
+    nodes[2] = vertices_1d[0];
+  else
+    for (size_t d = 0; d < dimension; ++d)
+      nodes[d] = vertices_1d[d];
+
+  //======================================== Create meshers
+  auto& handler = chi_mesh::GetCurrentHandler();
+  handler.SetSurfaceMesher(
+    std::make_shared<chi_mesh::SurfaceMesherPredefined>());
+  handler.SetVolumeMesher(std::make_shared<
+    chi_mesh::VolumeMesherOrthoPartitioned>(dimension, std::move(nodes)));
+
+  Chi::log.Log() << "Partitioned " << dimension << "D orthogonal mesh set up.";
+}
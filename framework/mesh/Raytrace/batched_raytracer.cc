@@ -0,0 +1,294 @@
+#include "batched_raytracer.h"
+
+#include "mesh/Cell/cell.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "mpi/chi_mpi_utils_map_all2all.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <cstring>
+#include <limits>
+
+namespace chi_mesh
+{
+
+namespace
+{
+/**Number of doubles packed per ray before its values.*/
+constexpr size_t RAY_HEADER_SIZE = 12;
+
+double BitsToDouble(const uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+uint64_t DoubleToBits(const double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(double));
+  return bits;
+}
+
+void PackRay(const BatchRay& ray, std::vector<double>& buffer)
+{
+  buffer.insert(buffer.end(),
+                {ray.position.x,
+                 ray.position.y,
+                 ray.position.z,
+                 ray.omega.x,
+                 ray.omega.y,
+                 ray.omega.z,
+                 ray.distance_left,
+                 BitsToDouble(ray.cell_global_id),
+                 BitsToDouble(ray.id),
+                 static_cast<double>(ray.origin_location),
+                 ray.left_domain ? 1.0 : 0.0,
+                 static_cast<double>(ray.values.size())});
+  buffer.insert(buffer.end(), ray.values.begin(), ray.values.end());
+}
+
+/**Unpacks the ray at the given offset, returning the offset of the next.*/
+size_t UnpackRay(const std::vector<double>& buffer,
+                 const size_t offset,
+                 BatchRay& ray)
+{
+  const double* b = &buffer[offset];
+  ray.position = Vector3(b[0], b[1], b[2]);
+  ray.omega = Vector3(b[3], b[4], b[5]);
+  ray.distance_left = b[6];
+  ray.cell_global_id = DoubleToBits(b[7]);
+  ray.id = DoubleToBits(b[8]);
+  ray.origin_location = static_cast<int>(b[9]);
+  ray.left_domain = b[10] != 0.0;
+  const auto num_values = static_cast<size_t>(b[11]);
+  ray.values.assign(b + RAY_HEADER_SIZE, b + RAY_HEADER_SIZE + num_values);
+
+  return offset + RAY_HEADER_SIZE + num_values;
+}
+} // namespace
+
+//###################################################################
+/**Computes the plane equations of the local cells, their sizes and
+ * whether they are convex.*/
+BatchedRayTracer::BatchedRayTracer(const MeshContinuum& grid) : grid_(grid)
+{
+  const size_t num_local_cells = grid.local_cells.size();
+  cell_plane_offsets_.assign(num_local_cells + 1, 0);
+  cell_convex_.assign(num_local_cells, true);
+  cell_sizes_.assign(num_local_cells, 0.0);
+
+  auto AddPlane = [this](const Vector3& n, const Vector3& p,
+                         const unsigned int f)
+  {
+    plane_nx_.push_back(n.x);
+    plane_ny_.push_back(n.y);
+    plane_nz_.push_back(n.z);
+    plane_d_.push_back(n.Dot(p));
+    plane_face_.push_back(f);
+  };
+
+  for (const auto& cell : grid.local_cells)
+  {
+    const uint64_t c = cell.local_id_;
+    cell_plane_offsets_[c] = plane_d_.size();
+
+    //================================= Planes of the faces, or of the
+    //                                  sides of polyhedron faces
+    const auto num_faces = static_cast<unsigned int>(cell.faces_.size());
+    for (unsigned int f = 0; f < num_faces; ++f)
+    {
+      const auto& face = cell.faces_[f];
+      const auto& vids = face.vertex_ids_;
+      if (cell.Type() == CellType::POLYHEDRON and vids.size() > 3)
+      {
+        const size_t num_sides = vids.size();
+        for (size_t s = 0; s < num_sides; ++s)
+        {
+          const auto& v0 = grid.vertices[vids[s]];
+          const auto& v1 = grid.vertices[vids[(s + 1) % num_sides]];
+          auto n = (v1 - v0).Cross(face.centroid_ - v0);
+          const double norm = n.Norm();
+          if (norm == 0.0) continue;
+          n = n / norm;
+          if (n.Dot(face.normal_) < 0.0) n = -1.0 * n;
+          AddPlane(n, v0, f);
+        }
+      }
+      else
+        AddPlane(face.normal_, grid.vertices[vids[0]], f);
+    } // for f
+
+    //================================= Size and convexity
+    double size = 0.0;
+    for (const uint64_t vid : cell.vertex_ids_)
+      size = std::max(size, (grid.vertices[vid] - cell.centroid_).Norm());
+    cell_sizes_[c] = 2.0 * size;
+
+    const double tolerance = 1.0e-10 * cell_sizes_[c];
+    for (size_t p = cell_plane_offsets_[c]; p < plane_d_.size(); ++p)
+      for (const uint64_t vid : cell.vertex_ids_)
+      {
+        const auto& v = grid.vertices[vid];
+        const double h = plane_nx_[p] * v.x + plane_ny_[p] * v.y +
+                         plane_nz_[p] * v.z - plane_d_[p];
+        if (h > tolerance) cell_convex_[c] = false;
+      }
+  } // for cell
+  cell_plane_offsets_[num_local_cells] = plane_d_.size();
+}
+
+//###################################################################
+std::pair<double, unsigned int>
+BatchedRayTracer::ExitDistance(const Cell& cell,
+                               const Vector3& pos,
+                               const Vector3& omega,
+                               RayTracer& fallback_tracer) const
+{
+  const uint64_t c = cell.local_id_;
+
+  if (not cell_convex_[c])
+  {
+    Vector3 pos_i = pos;
+    Vector3 omega_i = omega;
+    const auto oi = fallback_tracer.TraceRay(cell, pos_i, omega_i);
+    if (oi.particle_lost)
+      throw std::logic_error("BatchedRayTracer: Ray lost. " +
+                             oi.lost_particle_info);
+    return {oi.distance_to_surface, oi.destination_face_index};
+  }
+
+  const size_t begin = cell_plane_offsets_[c];
+  const size_t end = cell_plane_offsets_[c + 1];
+
+  double t_min = std::numeric_limits<double>::max();
+  unsigned int exit_face = 0;
+  for (size_t p = begin; p < end; ++p)
+  {
+    const double mu =
+      plane_nx_[p] * omega.x + plane_ny_[p] * omega.y + plane_nz_[p] * omega.z;
+    if (mu <= 0.0) continue;
+
+    const double h =
+      plane_d_[p] - plane_nx_[p] * pos.x - plane_ny_[p] * pos.y -
+      plane_nz_[p] * pos.z;
+    const double t = h / mu;
+    if (t < t_min)
+    {
+      t_min = t;
+      exit_face = plane_face_[p];
+    }
+  }
+
+  if (t_min == std::numeric_limits<double>::max())
+    throw std::logic_error("BatchedRayTracer: No exit face for direction " +
+                           omega.PrintStr() + " in cell " +
+                           std::to_string(cell.global_id_) + ".");
+
+  return {std::max(t_min, 0.0), exit_face};
+}
+
+//###################################################################
+int BatchedRayTracer::TraceLocal(BatchRay& ray,
+                                 const SegmentFunction& segment_function,
+                                 RayTracer& fallback_tracer) const
+{
+  while (true)
+  {
+    const auto& cell = grid_.cells[ray.cell_global_id];
+    const auto [t_exit, f] =
+      ExitDistance(cell, ray.position, ray.omega, fallback_tracer);
+
+    const bool ends = ray.distance_left <= t_exit;
+    const double length = ends ? ray.distance_left : t_exit;
+
+    if (length > 0.0) segment_function(ray, cell, length);
+    ray.position = ray.position + ray.omega * length;
+    ray.distance_left = ends ? 0.0 : ray.distance_left - length;
+
+    if (ends) return -1;
+
+    const auto& face = cell.faces_[f];
+    if (not face.has_neighbor_)
+    {
+      ray.left_domain = true;
+      return -1;
+    }
+
+    ray.cell_global_id = face.neighbor_id_;
+    if (not grid_.IsCellLocal(face.neighbor_id_))
+      return static_cast<int>(grid_.cells[face.neighbor_id_].partition_id_);
+  }
+}
+
+//###################################################################
+std::vector<BatchRay>
+BatchedRayTracer::Trace(std::vector<BatchRay> rays,
+                        const SegmentFunction& segment_function) const
+{
+  for (auto& ray : rays)
+    ray.origin_location = Chi::mpi.location_id;
+
+  std::vector<BatchRay> ended_rays;
+  while (true)
+  {
+    //============================================= Trace local rays
+    const auto num_rays = static_cast<int64_t>(rays.size());
+    std::vector<int> destinations(rays.size(), -1);
+    std::string error;
+#pragma omp parallel
+    {
+      RayTracer fallback_tracer(grid_, cell_sizes_);
+#pragma omp for schedule(dynamic, 64)
+      for (int64_t r = 0; r < num_rays; ++r)
+      {
+        try
+        {
+          destinations[r] =
+            TraceLocal(rays[r], segment_function, fallback_tracer);
+        }
+        catch (const std::exception& e)
+        {
+#pragma omp critical
+          error = e.what();
+        }
+      }
+    }
+    if (not error.empty()) throw std::logic_error(error);
+
+    //============================================= Sort ended and handed
+    //                                              off rays
+    std::map<int, std::vector<double>> outgoing;
+    uint64_t num_outgoing = 0;
+    for (size_t r = 0; r < rays.size(); ++r)
+      if (destinations[r] < 0) ended_rays.push_back(std::move(rays[r]));
+      else
+      {
+        PackRay(rays[r], outgoing[destinations[r]]);
+        ++num_outgoing;
+      }
+    rays.clear();
+
+    uint64_t global_num_outgoing = 0;
+    MPI_Allreduce(&num_outgoing, &global_num_outgoing, 1, MPI_UINT64_T,
+                  MPI_SUM, Chi::mpi.comm);
+    if (global_num_outgoing == 0) break;
+
+    //============================================= Hand off rays
+    const auto incoming = chi_mpi_utils::MapAllToAll(outgoing, MPI_DOUBLE);
+    for (const auto& [pid, buffer] : incoming)
+      for (size_t offset = 0; offset < buffer.size();)
+      {
+        BatchRay ray;
+        offset = UnpackRay(buffer, offset, ray);
+        rays.push_back(std::move(ray));
+      }
+  } // while rays in flight
+
+  return ended_rays;
+}
+
+} // namespace chi_mesh
@@ -0,0 +1,85 @@
+#ifndef CHI_MESH_BATCHED_RAYTRACER_H
+#define CHI_MESH_BATCHED_RAYTRACER_H
+
+#include "raytracing.h"
+
+#include <functional>
+#include <map>
+
+namespace chi_mesh
+{
+
+//###################################################################
+/**A ray of a batch, traced from its position along its direction over a
+ * given distance. It carries values, e.g., the optical depths of the
+ * groups, accumulated along its segments and handed off with it across
+ * the locations.*/
+struct BatchRay
+{
+  Vector3 position;
+  Vector3 omega;
+  double distance_left = 0.0;
+  uint64_t cell_global_id = 0; ///< Cell the ray is in
+  uint64_t id = 0;             ///< User id, e.g., of the ray's target
+  int origin_location = 0;     ///< Set when traced
+  bool left_domain = false;    ///< Exited through a boundary
+  std::vector<double> values;
+};
+
+//###################################################################
+/**Traces batches of rays through a grid, each ray being followed until its
+ * distance is exhausted or it exits the domain.
+ *
+ * The plane equations of the faces of the local cells, or of the sides of
+ * polyhedron faces, are computed once and stored contiguously, hence the
+ * exit distance from a convex cell is a loop over the planes of the cell.
+ * Non-convex cells fall back to the RayTracer. The rays of a batch are
+ * traced concurrently and those reaching another location are handed to
+ * it.*/
+class BatchedRayTracer
+{
+public:
+  /**Called for each segment of a ray with the cell and its length. It may
+   * modify the ray's values and is called concurrently for different
+   * rays.*/
+  typedef std::function<void(BatchRay&, const Cell&, double)>
+    SegmentFunction;
+
+private:
+  const MeshContinuum& grid_;
+  std::vector<size_t> cell_plane_offsets_;
+  std::vector<double> plane_nx_;
+  std::vector<double> plane_ny_;
+  std::vector<double> plane_nz_;
+  std::vector<double> plane_d_;
+  std::vector<unsigned int> plane_face_;
+  std::vector<bool> cell_convex_;
+  std::vector<double> cell_sizes_;
+
+public:
+  explicit BatchedRayTracer(const MeshContinuum& grid);
+
+  /**Traces the rays starting on this location, in cells of it, handing
+   * them off across locations until all are done. Returns the rays that
+   * ended on this location, with their distance exhausted or having left
+   * the domain. Collective.*/
+  std::vector<BatchRay> Trace(std::vector<BatchRay> rays,
+                              const SegmentFunction& segment_function) const;
+
+private:
+  /**Distance to the exit face of a local cell, and the face, for a
+   * position within it.*/
+  std::pair<double, unsigned int>
+  ExitDistance(const Cell& cell, const Vector3& pos,
+               const Vector3& omega, RayTracer& fallback_tracer) const;
+
+  /**Traces a ray on this location. Returns -1 if the ray ended, otherwise
+   * the location it has to be handed off to.*/
+  int TraceLocal(BatchRay& ray,
+                 const SegmentFunction& segment_function,
+                 RayTracer& fallback_tracer) const;
+};
+
+} // namespace chi_mesh
+
+#endif // CHI_MESH_BATCHED_RAYTRACER_H
@@ -6,130 +6,126 @@
 #include "utils/chi_timer.h"
 
 #include <algorithm>
+#include <array>
+
+namespace
+{
+/**Vertex subscriptions, in compressed row storage, i.e., the faces
+ * subscribing to vertex v are `face_ids[offsets[v]]` up to
+ * `face_ids[offsets[v+1]]`.*/
+struct VertexSubscriptions
+{
+  std::vector<size_t> offsets;
+  std::vector<size_t> face_ids;
+
+  /**Builds the subscriptions from the number of faces and a function
+   * returning the vertex indices of a face.*/
+  template<typename VertexIndices>
+  VertexSubscriptions(size_t num_verts, size_t num_faces,
+                      const VertexIndices& face_vertex_indices) :
+    offsets(num_verts + 1, 0)
+  {
+    for (size_t f=0; f<num_faces; ++f)
+      for (const int v : face_vertex_indices(f))
+        ++offsets[v + 1];
+
+    for (size_t v=0; v<num_verts; ++v)
+      offsets[v + 1] += offsets[v];
+
+    std::vector<size_t> fill = offsets;
+    face_ids.resize(offsets.back());
+    for (size_t f=0; f<num_faces; ++f)
+      for (const int v : face_vertex_indices(f))
+        face_ids[fill[v]++] = f;
+  }
+};
+}//namespace
 
 //#########################################################
 /** Runs over the faces of the surfacemesh and determines
  * neighbors. The algorithm first establishes which cells subscribe to each
  * vertex and then loops over faces and edges. For each edge, only the
- * subscribing faces are searched for neighbors. This routine has
- * time complexity O(N).*/
+ * faces subscribing to its first vertex are searched for the neighbor,
+ * which has the reversed edge. The faces are processed concurrently, each
+ * writing only its own edges. This routine has time complexity O(N).*/
 void chi_mesh::SurfaceMesh::UpdateInternalConnectivity()
 {
-  std::vector<std::vector<size_t >> vertex_subscriptions;
-
-  //======================================== Initialize vertex subscription
-  size_t num_verts = vertices_.size();
-  vertex_subscriptions.resize(num_verts);
-
-  for (auto& vert_sub : vertex_subscriptions)
-    vert_sub.reserve(5);
-
-  //======================================== Loop over cells and determine
-  //                                         which cells subscribe to a vertex
-  //%%%%%% TRIANGLES %%%%%
-  size_t num_tri_faces = faces_.size();
-  for (size_t tf=0; tf<num_tri_faces; tf++)
-  {
-    auto& try_face = faces_[tf];
-    for (int v=0; v<3; ++v)
-      vertex_subscriptions[v].push_back(tf);
-  }
-  //%%%%% POLYGONS %%%%%
-  size_t num_poly_faces = poly_faces_.size();
-  for (size_t pf=0; pf<num_poly_faces; pf++)
-  {
-    auto poly_face = poly_faces_[pf];
-    for (auto v : poly_face->v_indices)
-      vertex_subscriptions[v].push_back(pf);
-  }
+  const size_t num_verts = vertices_.size();
 
   //======================================== Loop over cells and determine
   //                                         connectivity
   //%%%%%% TRIANGLES %%%%%
-  for (auto curFace : faces_)
+  const size_t num_tri_faces = faces_.size();
+  const VertexSubscriptions tri_subscriptions(
+    num_verts, num_tri_faces,
+    [this](size_t tf)
+    {
+      const int* v_index = faces_[tf].v_index;
+      return std::array<int,3>{v_index[0], v_index[1], v_index[2]};
+    });
+
+#pragma omp parallel for
+  for (int64_t tf=0; tf<static_cast<int64_t>(num_tri_faces); ++tf)
   {
-    for (int e=0;e<3;e++)
+    auto& curFace = faces_[tf];
+    for (auto& curface_edge : curFace.e_index)
     {
-      int* curface_edge = curFace.e_index[e];
-      int vi = curface_edge[0];
-      int vf = curface_edge[1];
+      const int vi = curface_edge[0];
 
       //=============================== Search cells subscribing to vi
-      for (auto ofi : vertex_subscriptions[vi])
-      {
-        auto& other_face = faces_[ofi];
-
-        for (size_t e2=0;e2<3;e2++)
-        {
-          if ( (curface_edge[0]==other_face.e_index[e2][1]) &&
-               (curface_edge[1]==other_face.e_index[e2][0]) )
-          {
-            curface_edge[2] = ofi; //cell index
-            curface_edge[3] = e2;  //edge index
-          }
-        }//for e2
-      }//for ofi
-
-      //=============================== Search cells subscribing to vf
-      for (auto ofi : vertex_subscriptions[vf])
+      const size_t begin = tri_subscriptions.offsets[vi];
+      const size_t end   = tri_subscriptions.offsets[vi + 1];
+      for (size_t k=begin; k<end; ++k)
       {
-        auto& other_face = faces_[ofi];
+        const size_t ofi = tri_subscriptions.face_ids[k];
+        const auto& other_face = faces_[ofi];
 
-        for (size_t e2=0;e2<3;e2++)
+        for (int e2=0;e2<3;e2++)
         {
           if ( (curface_edge[0]==other_face.e_index[e2][1]) &&
                (curface_edge[1]==other_face.e_index[e2][0]) )
           {
-            curface_edge[2] = ofi; //cell index
-            curface_edge[3] = e2;  //edge index
+            curface_edge[2] = static_cast<int>(ofi); //cell index
+            curface_edge[3] = e2;                    //edge index
           }
         }//for e2
       }//for ofi
     }//for current face edges
   }//for faces
 
-  //======================================== Loop over cells and determine
-  //                                         connectivity
   //%%%%% POLYGONS %%%%%
-  for (auto curFace : poly_faces_)
+  const size_t num_poly_faces = poly_faces_.size();
+  const VertexSubscriptions poly_subscriptions(
+    num_verts, num_poly_faces,
+    [this](size_t pf) -> const std::vector<int>&
+    { return poly_faces_[pf]->v_indices; });
+
+#pragma omp parallel for
+  for (int64_t pf=0; pf<static_cast<int64_t>(num_poly_faces); ++pf)
   {
+    auto curFace = poly_faces_[pf];
     for (auto& curface_edge : curFace->edges)
     {
-      int vi = curface_edge[0];
-      int vf = curface_edge[1];
+      const int vi = curface_edge[0];
 
       //=============================== Search cells subscribing to vi
-      for (auto ofi : vertex_subscriptions[vi])
+      const size_t begin = poly_subscriptions.offsets[vi];
+      const size_t end   = poly_subscriptions.offsets[vi + 1];
+      for (size_t k=begin; k<end; ++k)
       {
-        auto other_face = poly_faces_[ofi];
+        const size_t ofi = poly_subscriptions.face_ids[k];
+        const auto other_face = poly_faces_[ofi];
 
         for (size_t e2=0;e2<other_face->edges.size();e2++)
         {
           if ( (curface_edge[0]==other_face->edges[e2][1]) &&
                (curface_edge[1]==other_face->edges[e2][0]) )
           {
-            curface_edge[2] = ofi; //cell index
-            curface_edge[3] = e2;  //edge index
+            curface_edge[2] = static_cast<int>(ofi); //cell index
+            curface_edge[3] = static_cast<int>(e2);  //edge index
           }
         }//for e2
       }//for ofi
-
-      //=============================== Search cells subscribing to vf
-      for (auto ofi : vertex_subscriptions[vf])
-      {
-        auto other_face = poly_faces_[ofi];
-
-        for (size_t e2=0;e2<other_face->edges.size();e2++)
-        {
-          if ( (curface_edge[0]==other_face->edges[e2][1]) &&
-               (curface_edge[1]==other_face->edges[e2][0]) )
-          {
-            curface_edge[2] = ofi; //cell index
-            curface_edge[3] = e2;  //edge index
-          }
-        }//for e2
-      }//for other faces
     }//for current face edges
   }//for faces
-
-}
\ No newline at end of file
+}
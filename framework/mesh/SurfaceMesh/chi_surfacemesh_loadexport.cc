@@ -7,375 +7,237 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 
+#include "utils/chi_text_tokenizer.h"
+
+
+namespace
+{
+/**Converts a one-based wavefront index, or a negative one relative to the
+ * number of items read so far, to a zero-based index. Returns -1 for an
+ * empty or invalid field.*/
+int OBJFieldToIndex(std::string_view field, size_t num_items)
+{
+  int index = 0;
+  if (not chi::ParseNumber(field, index) or index == 0) return -1;
+  if (index < 0) index += static_cast<int>(num_items);
+  else           --index;
+  return (index >= 0 and static_cast<size_t>(index) < num_items) ? index : -1;
+}
+}//namespace
 
 //#########################################################
-/** Loads a surface mesh from a wavefront .obj file.*/
+/** Loads a surface mesh from a wavefront .obj file. The file is memory
+ * mapped and tokenized in place, after a first pass counting the entities
+ * to preallocate for. Faces may be given as `v`, `v/vt`, `v//vn` or
+ * `v/vt/vn`, triangles without normals being assigned their geometric
+ * normal.*/
 int chi_mesh::SurfaceMesh::
     ImportFromOBJFile(const std::string& fileName, bool as_poly/*=false*/,
                       const chi_mesh::Vector3& transform/*={0,0,0}*/)
 {
-
-
   //===================================================== Opening the file
-  std::ifstream file;
-  file.open(fileName);
-  if (!file.is_open())
+  chi::MappedTextFile file(fileName);
+  if (not file.IsOpen())
   {
     Chi::log.LogAllError()
       << "Failed to open file: "<< fileName<<" in call "
       << "to ImportFromOBJFile \n";
     Chi::Exit(EXIT_FAILURE);
   }
-  Chi::log.Log() << "Loading surface mesh with transform " << transform.PrintStr();
+  Chi::log.Log() << "Loading surface mesh with transform "
+                 << transform.PrintStr();
 
-  //===================================================== Reading every line and determining size
-  std::string file_line;
-  std::string delimiter = " ";
-  int counter=0;
-  while (std::getline(file,file_line))
+  //===================================================== Counting pass
+  size_t num_v = 0, num_vt = 0, num_vn = 0, num_f = 0, num_l = 0;
+  for (std::string_view text = file.View(); not text.empty();)
   {
-    counter++;
+    std::string_view file_line = chi::PopLine(text);
+    const std::string_view first_word = chi::PopToken(file_line);
+
+    if      (first_word == "v")  ++num_v;
+    else if (first_word == "vt") ++num_vt;
+    else if (first_word == "vn") ++num_vn;
+    else if (first_word == "f")  ++num_f;
+    else if (first_word == "l")  ++num_l;
+  }
 
-    //===================================================== Get the first word
-    size_t beg_of_word = file_line.find_first_not_of(delimiter);
-    size_t end_of_word = file_line.find(delimiter,beg_of_word-beg_of_word);
-    std::string first_word = file_line.substr(beg_of_word,end_of_word);
-    std::string sub_word;
+  vertices_.reserve(vertices_.size() + num_v);
+  tex_vertices_.reserve(tex_vertices_.size() + num_vt);
+  normals_.reserve(normals_.size() + num_vn);
+  if (as_poly) poly_faces_.reserve(poly_faces_.size() + num_f);
+  else         faces_.reserve(faces_.size() + num_f);
+  lines_.reserve(lines_.size() + num_l);
 
-    //===================================================== Keyword "v" for Vertex
-    if (first_word == "v")
+  //===================================================== Reading every line
+  size_t line_number = 0;
+  auto WarnBadLine = [&line_number](const std::string_view& what)
+  {
+    Chi::log.Log0Warning()
+      << "ImportFromOBJFile: failed to convert " << what
+      << " in line " << line_number;
+  };
+
+  auto ReadVector = [&WarnBadLine](std::string_view& file_line,
+                                   size_t num_components)
+  {
+    chi_mesh::Vector3 vec;
+    for (size_t k=0; k<num_components; ++k)
     {
-      chi_mesh::Vertex newVertex;
-      for (int k=1;k<=3;k++)
-      {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
+      const std::string_view sub_word = chi::PopToken(file_line);
+      if (sub_word.empty()) break;
+      if (not chi::ParseNumber(sub_word, vec(k))) WarnBadLine(sub_word);
+    }
+    return vec;
+  };
 
-        //============================= Convert word to number
-        try
-        {
-          double numValue = std::stod(sub_word);
+  std::vector<int> face_v, face_vt, face_vn;
+  for (std::string_view text = file.View(); not text.empty();)
+  {
+    ++line_number;
+    std::string_view file_line = chi::PopLine(text);
+    const std::string_view first_word = chi::PopToken(file_line);
 
-          if (k==1)      newVertex.x = numValue + transform.x;
-          else if (k==2) newVertex.y = numValue + transform.y;
-          else if (k==3) newVertex.z = numValue + transform.z;
-        }
+    //================================================ Keyword "v" for Vertex
+    if (first_word == "v")
+      vertices_.push_back(ReadVector(file_line, 3) + transform);
 
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          std::cout<<"Exception caught!"<<std::endl;
-        }
+    //================================================ Keyword "vt" for Texture
+    else if (first_word == "vt")
+      tex_vertices_.push_back(ReadVector(file_line, 2));
 
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
-      }
-      this->vertices_.push_back(newVertex);
-    }
+    //================================================ Keyword "vn" for normal
+    else if (first_word == "vn")
+      normals_.push_back(ReadVector(file_line, 3));
 
-    //===================================================== Keyword "vt" for Vertex
-    if (first_word.compare("vt")==0) {
-      chi_mesh::Vertex newVertex;
-      for (int k=1;k<=2;k++)
+    //================================================ Keyword "f" for face
+    else if (first_word == "f")
+    {
+      face_v.clear(); face_vt.clear(); face_vn.clear();
+      bool valid = true;
+      for (std::string_view sub_word = chi::PopToken(file_line);
+           not sub_word.empty(); sub_word = chi::PopToken(file_line))
       {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Convert word to number
-        try{ double numValue = std::stod(sub_word);
-          //*newVertex->value[k-1] = numValue;
-          if (k==1)
-          {
-            newVertex.x = numValue;
-          }
-          else if (k==2)
-          {
-            newVertex.y = numValue;
-          }
-          else if (k==3)
-          {
-            newVertex.z = numValue;
-          }
-        }
+        const auto vert_word  = chi::PopField(sub_word, '/');
+        const auto tvert_word = chi::PopField(sub_word, '/');
+        const auto norm_word  = sub_word;
 
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          //*newVertex->value[k-1] = 0.0;
-          std::cout<<"Exception caught!"<<std::endl;
-        }
+        face_v.push_back(OBJFieldToIndex(vert_word, vertices_.size()));
+        face_vt.push_back(OBJFieldToIndex(tvert_word, tex_vertices_.size()));
+        face_vn.push_back(OBJFieldToIndex(norm_word, normals_.size()));
 
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
+        if (face_v.back() < 0) {WarnBadLine(vert_word); valid = false;}
       }
-      this->tex_vertices_.push_back(newVertex);
-    }
-
-    //===================================================== Keyword "vn" for normal
-    if (first_word.compare("vn")==0) {
-      chi_mesh::Normal newNormal;
-      for (int k=1;k<=3;k++)
+      if (not valid or face_v.size() < 3)
       {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Convert word to number
-        try{ double numValue = std::stod(sub_word);
-          //*newNormal->value[k-1] = numValue;
-          if (k==1)
-          {
-            newNormal.x = numValue;
-          }
-          else if (k==2)
-          {
-            newNormal.y = numValue;
-          }
-          else if (k==3)
-          {
-            newNormal.z = numValue;
-          }
-        }
-
-        //============================= Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          //*newNormal->value[k-1] = 0.0;
-          std::cout<<"Exception caught!"<<std::endl;
-        }
-
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
+        WarnBadLine("face");
+        continue;
       }
-      this->normals_.push_back(newNormal);
-    }
 
-    //===================================================== Keyword "f" for face
-    if (first_word.compare("f")==0)
-    {
-      int number_of_verts = std::count(file_line.begin(),file_line.end(),'/')/2;
-      if ((number_of_verts==3) && (!as_poly))
+      if ((face_v.size()==3) && (!as_poly))
       {
-        chi_mesh::Face* newFace = new chi_mesh::Face;
-
-        for (int k=1;k<=3;k++)
+        chi_mesh::Face& newFace = faces_.emplace_back();
+        newFace.SetIndices(face_v[0], face_v[1], face_v[2]);
+        for (int k=0; k<3; ++k)
         {
-          //================================== Extract sub word
-          beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-          end_of_word = file_line.find(delimiter, beg_of_word);
-          sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-          //============================= Extract locations of hiphens
-          size_t first_dash = sub_word.find("/");
-          size_t last_dash  = sub_word.find_last_of("/");
-
-          //============================= Extract the words ass. w vertex and normal
-          std::string vert_word = sub_word.substr(0,first_dash-0);
-          std::string norm_word = sub_word.substr(last_dash+1,sub_word.length()-last_dash-1);
-
-          //============================= Convert word to number (Vertex)
-          try{ int numValue = std::stoi(vert_word);
-            newFace->v_index[k-1] = numValue-1;
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Normal)
-          try{ int numValue = std::stoi(norm_word);
-            newFace->n_index[k-1] = numValue-1;
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Texture Vertex)
-          if (last_dash>(first_dash+1)){
-            std::string tvert_word = sub_word.substr(first_dash+1,last_dash-first_dash-1);
-            try{ int numValue = std::stoi(tvert_word);
-              newFace->vt_index[k-1] = numValue-1;
-            }
-            catch(const std::invalid_argument& ia)
-            {
-              std::cout<<"Exception caught!"<<std::endl;
-            }
-          }
-
-          //============================= Stop word extraction on line end
-          if (end_of_word==std::string::npos) {break;}
+          newFace.n_index[k]  = face_vn[k];
+          newFace.vt_index[k] = face_vt[k];
         }
-
-
-        //==================================== Set edges
-        newFace->e_index[0][0] = newFace->v_index[0];
-        newFace->e_index[0][1] = newFace->v_index[1];
-
-        newFace->e_index[1][0] = newFace->v_index[1];
-        newFace->e_index[1][1] = newFace->v_index[2];
-
-        newFace->e_index[2][0] = newFace->v_index[2];
-        newFace->e_index[2][1] = newFace->v_index[0];
-
-        this->faces_.push_back(*newFace);
       }
       else
       {
-        chi_mesh::PolyFace* newFace = new chi_mesh::PolyFace;
-
-        for (int k=1;k<=number_of_verts;k++)
-        {
-          //================================== Extract sub word
-          beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-          end_of_word = file_line.find(delimiter, beg_of_word);
-          sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-          //============================= Extract locations of hiphens
-          size_t first_dash = sub_word.find("/");
-          size_t last_dash  = sub_word.find_last_of("/");
-
-          //============================= Extract the words ass. w vertex and normal
-          std::string vert_word = sub_word.substr(0,first_dash-0);
-          std::string norm_word = sub_word.substr(last_dash+1,sub_word.length()-last_dash-1);
-
-          //============================= Convert word to number (Vertex)
-          try{ int numValue = std::stoi(vert_word);
-            newFace->v_indices.push_back(numValue-1);
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Normal)
-          try{ int numValue = std::stoi(norm_word);
-            //newFace->n_indices.push_back(numValue-1);
-          }
-          catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-          //============================= Convert word to number (Texture Vertex)
-          if (last_dash>(first_dash+1)){
-            std::string tvert_word = sub_word.substr(first_dash+1,last_dash-first_dash-1);
-            try{ int numValue = std::stoi(tvert_word);
-              //newFace->vt_indices.push_back(numValue-1);
-            }
-            catch(const std::invalid_argument& ia)
-            {
-              std::cout<<"Exception caught!"<<std::endl;
-            }
-          }
-
-          //============================= Stop word extraction on line end
-          if (end_of_word==std::string::npos) {break;}
-        }
-
-        for (int v=0;v<(newFace->v_indices.size());v++)
-        {
-          int* side_indices = new int[4];
-
-          side_indices[0] = newFace->v_indices[v];
-          side_indices[1] = newFace->v_indices[v+1];
-          side_indices[2] = -1;
-          side_indices[3] = -1;
-
-          if ((v+1)>=newFace->v_indices.size())
-          {
-            side_indices[1] = newFace->v_indices[0];
-          }
-
-          newFace->edges.push_back(side_indices);
-        }
-
-
-        this->poly_faces_.push_back(newFace);
+        auto newFace = new chi_mesh::PolyFace;
+        const size_t num_verts = face_v.size();
+        newFace->v_indices = face_v;
+        newFace->edges.reserve(num_verts);
+        for (size_t v=0; v<num_verts; ++v)
+          newFace->edges.push_back(
+            new int[4]{face_v[v], face_v[(v+1)%num_verts], -1, -1});
+
+        poly_faces_.push_back(newFace);
       }
-
-
     }
 
-
-    //=================================================== Keyword "l" for line
-    if (first_word.compare("l")==0){
+    //================================================ Keyword "l" for line
+    else if (first_word == "l")
+    {
       chi_mesh::Edge newEdge;
-
-      //================================== Extract sub word
-      beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-      end_of_word = file_line.find(delimiter, beg_of_word);
-      sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-      //================================== Convert to number
-      try{ int numValue = std::stoi(sub_word);
-        newEdge.v_index[0] = numValue-1;
-      }
-      catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
-
-      //================================== Extract sub word
-      beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-      end_of_word = file_line.find(delimiter, beg_of_word);
-      sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-      //================================== Convert to number
-      try{ int numValue = std::stoi(sub_word);
-        newEdge.v_index[1] = numValue-1;
+      for (int k=0; k<2; ++k)
+        newEdge.v_index[k] = OBJFieldToIndex(chi::PopToken(file_line),
+                                             vertices_.size());
+      if (newEdge.v_index[0] < 0 or newEdge.v_index[1] < 0)
+      {
+        WarnBadLine("line");
+        continue;
       }
-      catch(const std::invalid_argument& ia){std::cout<<"Exception caught!"<<std::endl; }
 
-      newEdge.vertices[0] = this->vertices_.at(newEdge.v_index[0]);
-      newEdge.vertices[1] = this->vertices_.at(newEdge.v_index[1]);
+      newEdge.vertices[0] = vertices_[newEdge.v_index[0]];
+      newEdge.vertices[1] = vertices_[newEdge.v_index[1]];
 
-      this->lines_.push_back(newEdge);
-
-      //printf("line %d->%d\n",newEdge.v_index[0],newEdge.v_index[1]);
+      lines_.push_back(newEdge);
     }
-
   }
-  file.close();
 
-  //======================================================= Calculate face properties
-  std::vector<chi_mesh::Face>::iterator curFace;
-  for (curFace = this->faces_.begin(); curFace != this->faces_.end(); curFace++)
+  //===================================================== Face properties
+  const auto num_tri_faces = static_cast<int64_t>(faces_.size());
+  const size_t num_normals = normals_.size();
+#pragma omp parallel for
+  for (int64_t tf=0; tf<num_tri_faces; ++tf)
   {
+    auto& curFace = faces_[tf];
+
     //=========================================== Calculate geometrical normal
-    chi_mesh::Vertex vA = this->vertices_.at(curFace->v_index[0]);
-    chi_mesh::Vertex vB = this->vertices_.at(curFace->v_index[1]);
-    chi_mesh::Vertex vC = this->vertices_.at(curFace->v_index[2]);
+    const chi_mesh::Vertex& vA = vertices_[curFace.v_index[0]];
+    const chi_mesh::Vertex& vB = vertices_[curFace.v_index[1]];
+    const chi_mesh::Vertex& vC = vertices_[curFace.v_index[2]];
 
     chi_mesh::Vector3 vAB = vB - vA;
     chi_mesh::Vector3 vBC = vC - vB;
 
-    curFace->geometric_normal = vAB.Cross(vBC);
-    curFace->geometric_normal = curFace->geometric_normal/curFace->geometric_normal.Norm();
+    curFace.geometric_normal = vAB.Cross(vBC).Normalized();
 
     //=========================================== Calculate Assigned normal
-    chi_mesh::Vertex nA = this->normals_.at(curFace->n_index[0]);
-    chi_mesh::Vertex nB = this->normals_.at(curFace->n_index[1]);
-    chi_mesh::Vertex nC = this->normals_.at(curFace->n_index[2]);
+    bool has_normals = true;
+    for (int k=0; k<3; ++k)
+      if (curFace.n_index[k] < 0 or
+          static_cast<size_t>(curFace.n_index[k]) >= num_normals)
+        has_normals = false;
 
-    chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
-    nAvg = nAvg/nAvg.Norm();
+    if (has_normals)
+    {
+      const chi_mesh::Vertex& nA = normals_[curFace.n_index[0]];
+      const chi_mesh::Vertex& nB = normals_[curFace.n_index[1]];
+      const chi_mesh::Vertex& nC = normals_[curFace.n_index[2]];
 
-    curFace->assigned_normal = nAvg;
+      chi_mesh::Vector3 nAvg = (nA + nB + nC) / 3.0;
+      curFace.assigned_normal = nAvg/nAvg.Norm();
+    }
+    else
+      curFace.assigned_normal = curFace.geometric_normal;
 
     //=========================================== Compute face center
-    curFace->face_centroid = (vA+vB+vC)/3.0;
+    curFace.face_centroid = (vA+vB+vC)/3.0;
   }
-  std::vector<chi_mesh::PolyFace*>::iterator curPFace;
-  for (curPFace = this->poly_faces_.begin();
-       curPFace!=this->poly_faces_.end();
-       curPFace++)
+
+  const auto num_poly_faces = static_cast<int64_t>(poly_faces_.size());
+#pragma omp parallel for
+  for (int64_t pf=0; pf<num_poly_faces; ++pf)
   {
+    auto& curPFace = *poly_faces_[pf];
     chi_mesh::Vector3 centroid;
-    int num_verts = (*curPFace)->v_indices.size();
-    for (int v=0; v<num_verts; v++)
-      centroid = centroid + vertices_[(*curPFace)->v_indices[v]];
+    const size_t num_verts = curPFace.v_indices.size();
+    for (size_t v=0; v<num_verts; v++)
+      centroid = centroid + vertices_[curPFace.v_indices[v]];
 
-    centroid = centroid/num_verts;
+    centroid = centroid/static_cast<double>(num_verts);
 
-    (*curPFace)->face_centroid = centroid;
+    curPFace.face_centroid = centroid;
 
-    chi_mesh::Vector3 n = (vertices_[(*curPFace)->v_indices[1]] -
-                           vertices_[(*curPFace)->v_indices[0]]).Cross(
-      centroid - vertices_[(*curPFace)->v_indices[1]]);
+    chi_mesh::Vector3 n = (vertices_[curPFace.v_indices[1]] -
+                           vertices_[curPFace.v_indices[0]]).Cross(
+      centroid - vertices_[curPFace.v_indices[1]]);
     n = n/n.Norm();
 
-    (*curPFace)->geometric_normal = n;
+    curPFace.geometric_normal = n;
   }
 
   UpdateInternalConnectivity();
@@ -385,7 +247,6 @@ int chi_mesh::SurfaceMesh::
     << "Surface mesh loaded with "
     << this->faces_.size() << " triangle faces and "
     << this->poly_faces_.size() << " polygon faces.";
-  //chi::Exit(EXIT_FAILURE);
 
   return 0;
 }
@@ -6,6 +6,8 @@
 #include "chi_log.h"
 #include "chi_mpi.h"
 
+#include <algorithm>
+
 #define ExceptionReflectedAngleError                                           \
   std::logic_error(                                                            \
     fname + "Reflected angle not found for angle " + std::to_string(n) +       \
@@ -64,12 +66,7 @@ void chi_mesh::sweep_management::AngleAggregation::ZeroIncomingDelayedPsi()
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxOld())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                  val = 0.0;
+        chi_math::Set(rbndry.GetBoundaryFluxOld(), 0.0);
 
     } // if reflecting
   }   // for bndry
@@ -103,7 +100,6 @@ void chi_mesh::sweep_management::AngleAggregation::InitializeReflectingBCs()
     if (bndry->IsReflecting())
     {
       size_t tot_num_angles = quadrature->abscissae_.size();
-      size_t num_local_cells = grid->local_cells.size();
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       const auto& normal = rbndry.Normal();
@@ -165,52 +161,7 @@ void chi_mesh::sweep_management::AngleAggregation::InitializeReflectingBCs()
 
       //========================================= Initialize storage for all
       //                                          outbound directions
-      auto& heteroflux_new = rbndry.GetHeteroBoundaryFluxNew();
-      auto& heteroflux_old = rbndry.GetHeteroBoundaryFluxOld();
-      heteroflux_new.clear();
-      heteroflux_old.clear();
-      heteroflux_new.resize(tot_num_angles);
-      for (int n = 0; n < tot_num_angles; ++n)
-      {
-        // Only continue if omega is outgoing
-        if (quadrature->omegas_[n].Dot(rbndry.Normal()) < 0.0) continue;
-
-        //================================== For cells
-        auto& cell_vec = heteroflux_new[n];
-        cell_vec.resize(num_local_cells);
-        for (const auto& cell : grid->local_cells)
-        {
-          const uint64_t c = cell.local_id_;
-
-          //=========================== Check cell on ref bndry
-          bool on_ref_bndry = false;
-          for (const auto& face : cell.faces_)
-          {
-            if ((not face.has_neighbor_) and
-                (face.normal_.Dot(rbndry.Normal()) > 0.999999))
-            {
-              on_ref_bndry = true;
-              break;
-            }
-          }
-          if (not on_ref_bndry) continue;
-
-          //=========================== If cell on ref bndry
-          cell_vec[c].resize(cell.faces_.size());
-          int f = 0;
-          for (const auto& face : cell.faces_)
-          {
-            if ((not face.has_neighbor_) and
-                (face.normal_.Dot(rbndry.Normal()) > 0.999999))
-            {
-              cell_vec[c][f].clear();
-              cell_vec[c][f].resize(face.vertex_ids_.size(),
-                                    std::vector<double>(number_of_groups, 0.0));
-            }
-            ++f;
-          }
-        } // for cells
-      }   // for angles
+      rbndry.InitializeFluxStorage(*grid, *quadrature, number_of_groups);
 
       //========================================= Determine if boundary is
       //                                          opposing reflecting
@@ -231,7 +182,7 @@ void chi_mesh::sweep_management::AngleAggregation::InitializeReflectingBCs()
       }
 
       if (rbndry.IsOpposingReflected())
-        rbndry.GetHeteroBoundaryFluxOld() = rbndry.GetHeteroBoundaryFluxNew();
+        rbndry.GetBoundaryFluxOld() = rbndry.GetBoundaryFluxNew();
 
       reflecting_bcs_initialized = true;
     } // if reflecting
@@ -261,11 +212,7 @@ chi_mesh::sweep_management::AngleAggregation::GetNumDelayedAngularDOFs()
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxNew())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                local_ang_unknowns += dofvec.size();
+        local_ang_unknowns += rbndry.GetBoundaryFluxNew().size();
 
     } // if reflecting
   }   // for bndry
@@ -308,15 +255,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxNew())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                {
-                  index++;
-                  x_ref[index] = val;
-                }
+      {
+        const auto& psi = rbndry.GetBoundaryFluxNew();
+        std::copy(psi.begin(), psi.end(), x_ref + index + 1);
+        index += static_cast<int64_t>(psi.size());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -354,15 +297,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxOld())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                {
-                  index++;
-                  x_ref[index] = val;
-                }
+      {
+        const auto& psi = rbndry.GetBoundaryFluxOld();
+        std::copy(psi.begin(), psi.end(), x_ref + index + 1);
+        index += static_cast<int64_t>(psi.size());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -400,15 +339,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxOld())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                {
-                  index++;
-                  val = x_ref[index];
-                }
+      {
+        auto& psi = rbndry.GetBoundaryFluxOld();
+        std::copy_n(x_ref + index + 1, psi.size(), psi.begin());
+        index += static_cast<int64_t>(psi.size());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -446,15 +381,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxNew())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                {
-                  index++;
-                  val = x_ref[index];
-                }
+      {
+        auto& psi = rbndry.GetBoundaryFluxNew();
+        std::copy_n(x_ref + index + 1, psi.size(), psi.begin());
+        index += static_cast<int64_t>(psi.size());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -497,12 +428,10 @@ std::vector<double> chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxNew())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                  psi_vector.push_back(val);
+      {
+        const auto& psi = rbndry.GetBoundaryFluxNew();
+        psi_vector.insert(psi_vector.end(), psi.begin(), psi.end());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -546,12 +475,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxNew())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                  val = stl_vector[index++];
+      {
+        auto& psi = rbndry.GetBoundaryFluxNew();
+        std::copy_n(stl_vector.begin() + index, psi.size(), psi.begin());
+        index += psi.size();
+      }
 
     } // if reflecting
   }   // for bndry
@@ -588,12 +516,10 @@ std::vector<double> chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxOld())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                  psi_vector.push_back(val);
+      {
+        const auto& psi = rbndry.GetBoundaryFluxOld();
+        psi_vector.insert(psi_vector.end(), psi.begin(), psi.end());
+      }
 
     } // if reflecting
   }   // for bndry
@@ -637,12 +563,11 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        for (auto& angle : rbndry.GetHeteroBoundaryFluxOld())
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                  val = stl_vector[index++];
+      {
+        auto& psi = rbndry.GetBoundaryFluxOld();
+        std::copy_n(stl_vector.begin() + index, psi.size(), psi.begin());
+        index += psi.size();
+      }
 
     } // if reflecting
   }   // for bndry
@@ -673,7 +598,7 @@ void chi_mesh::sweep_management::AngleAggregation::SetDelayedPsiOld2New()
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        rbndry.GetHeteroBoundaryFluxNew() = rbndry.GetHeteroBoundaryFluxOld();
+        rbndry.GetBoundaryFluxNew() = rbndry.GetBoundaryFluxOld();
 
     } // if reflecting
   }   // for bndry
@@ -703,7 +628,7 @@ void chi_mesh::sweep_management::AngleAggregation::SetDelayedPsiNew2Old()
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.IsOpposingReflected())
-        rbndry.GetHeteroBoundaryFluxOld() = rbndry.GetHeteroBoundaryFluxNew();
+        rbndry.GetBoundaryFluxOld() = rbndry.GetBoundaryFluxNew();
 
     } // if reflecting
   }   // for bndry
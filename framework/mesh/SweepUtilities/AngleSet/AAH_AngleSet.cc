@@ -44,20 +44,26 @@ void AAH_AngleSet::InitializeDelayedUpstreamData()
 /**This function advances the work stages of an angleset.*/
 AngleSetStatus
 AAH_AngleSet::AngleSetAdvance(SweepChunk& sweep_chunk,
-                              const std::vector<size_t>& timing_tags,
+                              chi::RunningStatistics& chunk_timing,
                               ExecutionPermission permission)
 {
   typedef AngleSetStatus Status;
 
   if (executed_)
   {
+    const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::send_time));
     if (!async_comm_.DoneSending()) async_comm_.ClearDownstreamBuffers();
     return AngleSetStatus::FINISHED;
   }
 
   // Check upstream data available
-  Status status =
-    async_comm_.ReceiveUpstreamPsi(static_cast<int>(this->GetID()));
+  Status status = Status::RECEIVING;
+  {
+    const ScopedSweepTimer timer(
+      StatisticsTime(&SweepStatistics::receive_time));
+    status = async_comm_.ReceiveUpstreamPsi(static_cast<int>(this->GetID()));
+  }
+  const bool upstream_received = status != Status::RECEIVING;
 
   // Also check boundaries
   for (auto& [bid, bndry] : ref_boundaries_)
@@ -67,35 +73,74 @@ AAH_AngleSet::AngleSetAdvance(SweepChunk& sweep_chunk,
       break;
     }
 
+  if (sweep_statistics_ and status == Status::RECEIVING)
+  {
+    if (upstream_received) sweep_statistics_->boundary_blocked_in_pass = true;
+    else
+      sweep_statistics_->upstream_blocked_in_pass = true;
+  }
+
   if (status == Status::RECEIVING) return status;
   else if (status == Status::READY_TO_EXECUTE and
            permission == ExecutionPermission::EXECUTE)
   {
-    async_comm_.InitializeLocalAndDownstreamBuffers();
-
-    Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_BEGIN);
-    sweep_chunk.Sweep(*this); // Execute chunk
-    Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_END);
+    ChiProfileTaggedRegion("Angle set", id_);
+    BeginExecution();
 
-    // Send outgoing psi and clear local and receive buffers
-    async_comm_.SendDownstreamPsi(static_cast<int>(this->GetID()));
-    async_comm_.ClearLocalAndReceiveBuffers();
-
-    // Update boundary readiness
-    for (auto& [bid, bndry] : ref_boundaries_)
-      bndry->UpdateAnglesReadyStatus(angles_, ref_group_subset_);
+    const double chunk_start_time = MPI_Wtime();
+    ExecuteSweepChunk(sweep_chunk);
+    chunk_timing.Add(MPI_Wtime() - chunk_start_time);
 
-    executed_ = true;
+    EndExecution();
     return AngleSetStatus::FINISHED;
   }
   else
     return AngleSetStatus::READY_TO_EXECUTE;
 }
 
+// ###################################################################
+/**Allocates the local and downstream buffers ahead of executing the
+ * sweep chunk. Must be called from the thread that owns MPI
+ * communication.*/
+void AAH_AngleSet::BeginExecution()
+{
+  async_comm_.InitializeLocalAndDownstreamBuffers();
+}
+
+// ###################################################################
+/**Executes the sweep chunk on this angle set. This touches only this
+ * angle set's FLUDS and the chunk's own scratch data and can therefore be
+ * called concurrently for different angle sets, provided each call gets
+ * its own sweep chunk.*/
+void AAH_AngleSet::ExecuteSweepChunk(SweepChunk& sweep_chunk)
+{
+  ChiProfileRegion("Sweep chunk");
+  sweep_chunk.Sweep(*this);
+}
+
+// ###################################################################
+/**Sends outgoing psi, clears the local and receive buffers and updates
+ * boundary readiness. Must be called from the thread that owns MPI
+ * communication.*/
+void AAH_AngleSet::EndExecution()
+{
+  {
+    const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::send_time));
+    async_comm_.SendDownstreamPsi(static_cast<int>(this->GetID()));
+  }
+  async_comm_.ClearLocalAndReceiveBuffers();
+
+  for (auto& [bid, bndry] : ref_boundaries_)
+    bndry->UpdateAnglesReadyStatus(angles_, ref_group_subset_);
+
+  executed_ = true;
+}
+
 // ###################################################################
 /***/
 AngleSetStatus AAH_AngleSet::FlushSendBuffers()
 {
+  const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::send_time));
   if (!async_comm_.DoneSending()) async_comm_.ClearDownstreamBuffers();
 
   if (async_comm_.DoneSending()) return AngleSetStatus::MESSAGES_SENT;
@@ -117,6 +162,37 @@ void AAH_AngleSet::SetMaxBufferMessages(int new_max)
   async_comm_.max_num_mess = new_max;
 }
 
+// ###################################################################
+/**Sets whether psi sent to, and received from, other locations is
+ * communicated in single precision.*/
+void AAH_AngleSet::SetSinglePrecisionMessages(bool flag)
+{
+  async_comm_.SetSinglePrecisionMessages(flag);
+}
+
+// ###################################################################
+/**Sets whether the communicator uses persistent MPI requests.*/
+void AAH_AngleSet::SetPersistentRequests(bool flag)
+{
+  async_comm_.SetPersistentRequests(flag);
+}
+
+// ###################################################################
+/**Sets whether the communicator exchanges psi with locations on the same
+ * node through shared-memory.*/
+void AAH_AngleSet::SetSharedMemoryExchange(bool flag)
+{
+  async_comm_.SetSharedMemoryExchange(flag);
+}
+
+// ###################################################################
+/**Sets location specific message size limits for the communicator.*/
+void AAH_AngleSet::SetLocationEagerLimits(
+  const std::map<int, u_ll_int>& eager_limits)
+{
+  async_comm_.SetLocationEagerLimits(eager_limits);
+}
+
 // ###################################################################
 /**Resets the sweep buffer.*/
 void AAH_AngleSet::ResetSweepBuffers()
@@ -129,9 +205,18 @@ void AAH_AngleSet::ResetSweepBuffers()
 /**Instructs the sweep buffer to receive delayed data.*/
 bool AAH_AngleSet::ReceiveDelayedData()
 {
+  const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::receive_time));
   return async_comm_.ReceiveDelayedData(static_cast<int>(this->GetID()));
 }
 
+// ###################################################################
+/**Sets the statistics of the angle set and of its communicator.*/
+void AAH_AngleSet::SetSweepStatistics(SweepStatistics* sweep_statistics)
+{
+  AngleSet::SetSweepStatistics(sweep_statistics);
+  async_comm_.SetSweepStatistics(sweep_statistics);
+}
+
 // ###################################################################
 /**Returns a pointer to a boundary flux data.*/
 const double* AAH_AngleSet::PsiBndry(uint64_t bndry_map,
@@ -27,13 +27,26 @@ public:
 
   void SetMaxBufferMessages(int new_max) override;
 
+  void SetSinglePrecisionMessages(bool flag);
+
+  void SetPersistentRequests(bool flag);
+
+  void SetSharedMemoryExchange(bool flag);
+
+  void SetLocationEagerLimits(const std::map<int, u_ll_int>& eager_limits);
+
   AngleSetStatus AngleSetAdvance(
     SweepChunk& sweep_chunk,
-    const std::vector<size_t>& timing_tags,
+    chi::RunningStatistics& chunk_timing,
     ExecutionPermission permission) override;
+  void BeginExecution();
+  void ExecuteSweepChunk(SweepChunk& sweep_chunk);
+  void EndExecution();
+
   AngleSetStatus FlushSendBuffers() override;
   void ResetSweepBuffers() override;
   bool ReceiveDelayedData() override;
+  void SetSweepStatistics(SweepStatistics* sweep_statistics) override;
 
   const double* PsiBndry(uint64_t bndry_map,
                          unsigned int angle_num,
@@ -55,6 +55,22 @@ std::map<uint64_t, AngleSet::SweepBndryPtr>& AngleSet::GetBoundaries()
 size_t AngleSet::GetNumGroups() const { return num_grps; }
 size_t AngleSet::GetNumAngles() const { return angles_.size(); }
 
+// ###################################################################
+/**Sets the precomputed face data for this angle set. Supplying nullptr
+ * reverts to computing face data on the fly.*/
+void AngleSet::SetFaceCache(std::shared_ptr<const AngleSetFaceCache> face_cache)
+{
+  face_cache_ = std::move(face_cache);
+}
+
+// ###################################################################
+/**Returns the precomputed face data of this angle set, or nullptr if the
+ * angle set has none.*/
+const AngleSetFaceCache* AngleSet::GetFaceCache() const
+{
+  return face_cache_.get();
+}
+
 AsynchronousCommunicator* AngleSet::GetCommunicator()
 {
   ChiLogicalError("Method not implemented");
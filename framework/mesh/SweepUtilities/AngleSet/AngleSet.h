@@ -5,6 +5,8 @@
 #include "mesh/SweepUtilities/Communicators/AAH_AsynComm.h"
 #include "mesh/SweepUtilities/SweepBoundary/sweep_boundaries.h"
 #include "mesh/SweepUtilities/FLUDS/FLUDS.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
+#include "utils/chi_profiler.h"
 
 #include <chi_mpi.h>
 
@@ -15,6 +17,19 @@ typedef chi_mesh::sweep_management::SweepBoundary SweepBndry;
 namespace chi_mesh::sweep_management
 {
 
+// ###################################################################
+/**Flat cache of angle set face data built once during initialization.
+ * For a cell with local id c the data of face f is located at
+ * `k = (*cell_face_offsets)[c] + f`, with the mu value of the angle set's
+ * a-th direction at `face_mu[k*num_angles + a]`.*/
+struct AngleSetFaceCache
+{
+  size_t num_angles = 0;
+  std::shared_ptr<const std::vector<size_t>> cell_face_offsets;
+  std::vector<double> face_mu;
+  std::vector<FaceOrientation> face_orientations;
+};
+
 class AngleSet
 {
 public:
@@ -37,6 +52,9 @@ public:
   size_t GetNumGroups() const;
   size_t GetNumAngles() const;
 
+  void SetFaceCache(std::shared_ptr<const AngleSetFaceCache> face_cache);
+  const AngleSetFaceCache* GetFaceCache() const;
+
 
   // Virtual methods
   virtual AsynchronousCommunicator* GetCommunicator();
@@ -46,13 +64,28 @@ public:
 
   virtual void SetMaxBufferMessages(int new_max) = 0;
 
+  /**Advances the work stages of the angle set. The durations, in seconds,
+   * of the sweep chunk executions are added to chunk_timing.*/
   virtual AngleSetStatus AngleSetAdvance(
     SweepChunk& sweep_chunk,
-    const std::vector<size_t>& timing_tags,
+    chi::RunningStatistics& chunk_timing,
     ExecutionPermission permission) = 0;
   virtual AngleSetStatus FlushSendBuffers() = 0;
   virtual void ResetSweepBuffers() = 0;
   virtual bool ReceiveDelayedData() = 0;
+  /**Supplies additional sweep chunks with which an angle set can execute
+   * its own work concurrently. The default ignores them.*/
+  virtual void SetWorkerSweepChunks(
+    const std::vector<std::shared_ptr<SweepChunk>>& worker_chunks)
+  {
+  }
+  /**Sets the statistics into which the angle set, and its communicator,
+   * account for its work, or null to disable the instrumentation.
+   * Derived classes must forward the statistics to their communicator.*/
+  virtual void SetSweepStatistics(SweepStatistics* sweep_statistics)
+  {
+    sweep_statistics_ = sweep_statistics;
+  }
 
   virtual const double* PsiBndry(uint64_t bndry_map,
                                  unsigned int angle_num,
@@ -79,8 +112,17 @@ protected:
   const std::vector<size_t> angles_;
   std::map<uint64_t, SweepBndryPtr>& ref_boundaries_;
   const size_t ref_group_subset_;
+  std::shared_ptr<const AngleSetFaceCache> face_cache_ = nullptr;
 
   bool executed_ = false;
+  SweepStatistics* sweep_statistics_ = nullptr;
+
+  /**Returns the address of the given time of the statistics, or null when
+   * the statistics are disabled, for use with ScopedSweepTimer.*/
+  double* StatisticsTime(double SweepStatistics::*time) const
+  {
+    return sweep_statistics_ ? &(sweep_statistics_->*time) : nullptr;
+  }
 };
 
 
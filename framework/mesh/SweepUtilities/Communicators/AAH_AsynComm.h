@@ -6,6 +6,8 @@
 
 #include "AsyncComm.h"
 
+#include <map>
+
 typedef unsigned long long int u_ll_int;
 
 namespace chi
@@ -32,6 +34,7 @@ private:
   bool upstream_data_initialized;
 
   u_ll_int EAGER_LIMIT = 32000;
+  std::map<int, u_ll_int> location_eager_limits_;
 
   std::vector<int> prelocI_message_count;
   std::vector<int> deplocI_message_count;
@@ -50,6 +53,25 @@ private:
 
   std::vector<std::vector<MPI_Request>> deplocI_message_request;
 
+  bool single_precision_ = false;
+  std::vector<float> receive_buffer_sp_;
+
+  bool persistent_requests_ = false;
+  bool persistent_send_requests_built_ = false;
+  bool persistent_recv_requests_built_ = false;
+  std::vector<std::vector<MPI_Request>> prelocI_persistent_request_;
+  std::vector<std::vector<double>> deplocI_persistent_buffer_;
+  std::vector<std::vector<float>> deplocI_persistent_buffer_sp_;
+  std::vector<std::vector<double>> prelocI_persistent_buffer_;
+  std::vector<std::vector<float>> prelocI_persistent_buffer_sp_;
+
+  bool shared_memory_ = false;
+  MPI_Win shared_window_ = MPI_WIN_NULL;
+  u_ll_int shared_sweep_count_ = 1;
+  std::vector<char*> prelocI_shared_slot_;
+  std::vector<bool> prelocI_shared_received_;
+  std::vector<char*> deplocI_shared_slot_;
+
 public:
   int max_num_mess;
 
@@ -58,6 +80,7 @@ public:
               size_t num_angles,
               int sweep_eager_limit,
               const chi::ChiMPICommunicatorSet& in_comm_set);
+  ~AAH_ASynchronousCommunicator() override;
   bool DoneSending() const;
   void InitializeDelayedUpstreamData();
   void InitializeLocalAndDownstreamBuffers();
@@ -67,9 +90,35 @@ public:
   AngleSetStatus ReceiveUpstreamPsi(int angle_set_num);
   void ClearLocalAndReceiveBuffers();
   void Reset();
+  void SetSinglePrecisionMessages(bool flag);
+  void SetPersistentRequests(bool flag);
+  void SetSharedMemoryExchange(bool flag);
+  void SetLocationEagerLimits(
+    const std::map<int, u_ll_int>& location_eager_limits);
 
 protected:
   void BuildMessageStructure();
+  u_ll_int EagerLimit(int locJ) const;
+  int ReceivePsiMessage(double* destination,
+                        u_ll_int message_size,
+                        int source,
+                        int tag,
+                        MPI_Comm comm);
+  int ReceivePsiMessage(float* destination,
+                        u_ll_int message_size,
+                        int source,
+                        int tag,
+                        MPI_Comm comm);
+  void BuildPersistentSendRequests(int angle_set_num);
+  void StartPersistentReceives(int angle_set_num);
+  AngleSetStatus ReceivePersistentUpstreamPsi();
+  void FreePersistentRequests();
+  bool IsPrelocIShared(size_t prelocI) const;
+  bool IsDeplocIShared(size_t deplocI) const;
+  void BuildSharedWindow();
+  void SendSharedDownstreamPsi();
+  bool ReceiveSharedUpstreamPsi();
+  void FreeSharedWindow();
 };
 } // namespace chi_mesh::sweep_management
 #endif // CHI_AAH_ASYNCOMM_H
\ No newline at end of file
@@ -10,6 +10,9 @@
  * Outgoing and incoming data needs to be sub-divided into messages
  * each of which is smaller than the MPI eager-limit. There are
  * three parts to this: predecessors, delayed-predecessors and successors.
+ * Below the eager-limit the data is split per angle, unless persistent
+ * requests are used in which case it is aggregated into a single message.
+ * Links exchanged through shared-memory have no messages.
  *
  * This method gets called by an angleset that subscribes to this
  * sweepbuffer.*/
@@ -21,26 +24,35 @@ void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::BuildMessageStruc
   //============================================= Predecessor locations
   size_t num_dependencies = spds.GetLocationDependencies().size();
 
-  prelocI_message_count.resize(num_dependencies,0);
-  prelocI_message_size.resize(num_dependencies);
-  prelocI_message_blockpos.resize(num_dependencies);
+  prelocI_message_count.assign(num_dependencies,0);
+  prelocI_message_size.assign(num_dependencies, {});
+  prelocI_message_blockpos.assign(num_dependencies, {});
   prelocI_message_received.clear();
 
   for (int prelocI=0; prelocI<num_dependencies; prelocI++)
   {
+    const u_ll_int eager_limit =
+      EagerLimit(spds.GetLocationDependencies()[prelocI]);
     u_ll_int num_unknowns =
       aah_fluds.GetPrelocIFaceDOFCount(prelocI)*num_groups_*num_angles_;
 
+    //Shared-memory links carry no messages
+    if (IsPrelocIShared(prelocI))
+    {
+      prelocI_message_received.emplace_back();
+      continue;
+    }
+
     u_ll_int message_size;
     int      message_count;
-    if ((num_unknowns*8)<=EAGER_LIMIT)
+    if ((num_unknowns*8)<=eager_limit)
     {
-      message_count = static_cast<int>(num_angles_);
+      message_count = persistent_requests_ ? 1 : static_cast<int>(num_angles_);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
     else
     {
-      message_count = ceil((double)num_unknowns*8/(double)(double)EAGER_LIMIT);
+      message_count = ceil((double)num_unknowns*8/(double)eager_limit);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
 
@@ -66,26 +78,28 @@ void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::BuildMessageStruc
   //============================================= Delayed Predecessor locations
   size_t num_delayed_dependencies = spds.GetDelayedLocationDependencies().size();
 
-  delayed_prelocI_message_count.resize(num_delayed_dependencies,0);
-  delayed_prelocI_message_size.resize(num_delayed_dependencies);
-  delayed_prelocI_message_blockpos.resize(num_delayed_dependencies);
+  delayed_prelocI_message_count.assign(num_delayed_dependencies,0);
+  delayed_prelocI_message_size.assign(num_delayed_dependencies, {});
+  delayed_prelocI_message_blockpos.assign(num_delayed_dependencies, {});
   delayed_prelocI_message_received.clear();
 
   for (int prelocI=0; prelocI<num_delayed_dependencies; prelocI++)
   {
+    const u_ll_int eager_limit =
+      EagerLimit(spds.GetDelayedLocationDependencies()[prelocI]);
     u_ll_int num_unknowns =
       aah_fluds.GetDelayedPrelocIFaceDOFCount(prelocI)*num_groups_*num_angles_;
 
     u_ll_int message_size;
     int      message_count;
-    if ((num_unknowns*8)<=EAGER_LIMIT)
+    if ((num_unknowns*8)<=eager_limit)
     {
-      message_count = static_cast<int>(num_angles_);
+      message_count = persistent_requests_ ? 1 : static_cast<int>(num_angles_);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
     else
     {
-      message_count = ceil((double)num_unknowns*8/(double)(double)EAGER_LIMIT);
+      message_count = ceil((double)num_unknowns*8/(double)eager_limit);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
 
@@ -112,27 +126,35 @@ void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::BuildMessageStruc
   //============================================= Successor locations
   size_t num_successors = spds.GetLocationSuccessors().size();
 
-  deplocI_message_count.resize(num_successors,0);
-  deplocI_message_size.resize(num_successors);
-  deplocI_message_blockpos.resize(num_successors);
+  deplocI_message_count.assign(num_successors,0);
+  deplocI_message_size.assign(num_successors, {});
+  deplocI_message_blockpos.assign(num_successors, {});
 
   deplocI_message_request.clear();
 
   for (int deplocI=0; deplocI<num_successors; deplocI++)
   {
+    const u_ll_int eager_limit =
+      EagerLimit(spds.GetLocationSuccessors()[deplocI]);
     u_ll_int num_unknowns =
       aah_fluds.GetDeplocIFaceDOFCount(deplocI)*num_groups_*num_angles_;
 
+    if (IsDeplocIShared(deplocI))
+    {
+      deplocI_message_request.emplace_back();
+      continue;
+    }
+
     u_ll_int message_size;
     int      message_count;
-    if ((num_unknowns*8)<=EAGER_LIMIT)
+    if ((num_unknowns*8)<=eager_limit)
     {
-      message_count = static_cast<int>(num_angles_);
+      message_count = persistent_requests_ ? 1 : static_cast<int>(num_angles_);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
     else
     {
-      message_count = ceil((double)num_unknowns*8/(double)(double)EAGER_LIMIT);
+      message_count = ceil((double)num_unknowns*8/(double)eager_limit);
       message_size  = ceil((double)num_unknowns/(double)message_count);
     }
 
@@ -172,4 +194,31 @@ void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::BuildMessageStruc
 
   //Temporarily assign max_num_mess tot he local maximum
   max_num_mess = angset_max_message_count;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Returns the eager-limit to be used for messages to, or from, the given
+ * location.*/
+u_ll_int chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  EagerLimit(int locJ) const
+{
+  const auto it = location_eager_limits_.find(locJ);
+  if (it != location_eager_limits_.end())
+    return it->second;
+
+  return EAGER_LIMIT;
+}
+
+//###################################################################
+/**Sets location specific eager-limits, e.g. as measured by
+ * MeasureSweepNeighborLinks, and rebuilds the message structure. Locations
+ * not in the map use the default eager-limit. The limits of a pair of
+ * locations must be the same on both locations.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  SetLocationEagerLimits(const std::map<int, u_ll_int>& location_eager_limits)
+{
+  FreePersistentRequests();
+  location_eager_limits_ = location_eager_limits;
+
+  BuildMessageStructure();
+}
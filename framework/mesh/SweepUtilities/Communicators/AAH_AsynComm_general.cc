@@ -2,6 +2,8 @@
 
 #include "mesh/SweepUtilities/AngleSet/AngleSet.h"
 #include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
 
 // ###################################################################
 /**Constructor.*/
@@ -25,6 +27,15 @@ chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
   this->BuildMessageStructure();
 }
 
+// ###################################################################
+/**Destructor.*/
+chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  ~AAH_ASynchronousCommunicator()
+{
+  FreePersistentRequests();
+  FreeSharedWindow();
+}
+
 // ###################################################################
 /**Returns the private flag done_sending.*/
 bool chi_mesh::sweep_management::AAH_ASynchronousCommunicator::DoneSending()
@@ -78,4 +89,86 @@ void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::Reset()
 
   for (auto& message_flags : delayed_prelocI_message_received)
     message_flags.assign(message_flags.size(), false);
-}
\ No newline at end of file
+
+  // Flags raised in shared-memory slots are matched per sweep
+  ++shared_sweep_count_;
+  prelocI_shared_received_.assign(prelocI_shared_received_.size(), false);
+}
+// ###################################################################
+/**Sets whether psi messages are communicated in single precision. The
+ * FLUDS then stores the outgoing psi of the successors and the incoming
+ * psi of the predecessors in single precision, which is sent and received
+ * without conversion. The local psi, and the delayed psi that are unknowns
+ * of the iterative solvers, stay in double precision.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  SetSinglePrecisionMessages(bool flag)
+{
+  single_precision_ = flag;
+  dynamic_cast<AAH_FLUDS&>(fluds_).SetSinglePrecisionNonLocalPsi(flag);
+
+  // The persistent requests are bound to the message datatype
+  FreePersistentRequests();
+}
+
+// ###################################################################
+/**Receives a message of psi values into the given double precision
+ * destination, i.e., the delayed psi, converting from single precision
+ * when single precision messages are active. Returns the MPI error code.*/
+int chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  ReceivePsiMessage(double* destination,
+                    u_ll_int message_size,
+                    int source,
+                    int tag,
+                    MPI_Comm comm)
+{
+  if (sweep_statistics_)
+    sweep_statistics_->CountReceivedMessage(
+      message_size * (single_precision_ ? sizeof(float) : sizeof(double)));
+
+  if (not single_precision_)
+    return MPI_Recv(destination,
+                    static_cast<int>(message_size),
+                    MPI_DOUBLE,
+                    source,
+                    tag,
+                    comm,
+                    MPI_STATUS_IGNORE);
+
+  if (receive_buffer_sp_.size() < message_size)
+    receive_buffer_sp_.resize(message_size);
+
+  const int error_code = MPI_Recv(receive_buffer_sp_.data(),
+                                  static_cast<int>(message_size),
+                                  MPI_FLOAT,
+                                  source,
+                                  tag,
+                                  comm,
+                                  MPI_STATUS_IGNORE);
+
+  for (u_ll_int i = 0; i < message_size; ++i)
+    destination[i] = static_cast<double>(receive_buffer_sp_[i]);
+
+  return error_code;
+}
+
+// ###################################################################
+/**Receives a message of single precision psi values into the given
+ * destination. Returns the MPI error code.*/
+int chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  ReceivePsiMessage(float* destination,
+                    u_ll_int message_size,
+                    int source,
+                    int tag,
+                    MPI_Comm comm)
+{
+  if (sweep_statistics_)
+    sweep_statistics_->CountReceivedMessage(message_size * sizeof(float));
+
+  return MPI_Recv(destination,
+                  static_cast<int>(message_size),
+                  MPI_FLOAT,
+                  source,
+                  tag,
+                  comm,
+                  MPI_STATUS_IGNORE);
+}
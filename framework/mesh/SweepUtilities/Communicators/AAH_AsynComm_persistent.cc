@@ -0,0 +1,248 @@
+#include "AAH_AsynComm.h"
+
+#include "mesh/SweepUtilities/AngleSet/AngleSet.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
+
+#include "mpi/chi_mpi_commset.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <numeric>
+
+// ###################################################################
+/**Sets whether persistent MPI requests are used for the psi messages to
+ * successors and from predecessors. The requests are built once, at the
+ * first sweep, and restarted on every subsequent sweep. Since the
+ * per-message overhead is then mostly gone, the data below the eager-limit
+ * is aggregated into a single message per location instead of one message
+ * per angle. This changes the message structure and must therefore be set
+ * consistently on all locations, before the maximum number of messages is
+ * reconciled.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  SetPersistentRequests(bool flag)
+{
+  if (flag == persistent_requests_) return;
+
+  FreePersistentRequests();
+  persistent_requests_ = flag;
+
+  BuildMessageStructure();
+}
+
+// ###################################################################
+/**Builds the persistent send requests along with the buffers they
+ * reference.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  BuildPersistentSendRequests(int angle_set_num)
+{
+  const auto& location_successors = fluds_.GetSPDS().GetLocationSuccessors();
+  const size_t num_successors = location_successors.size();
+
+  deplocI_persistent_buffer_.assign(num_successors, {});
+  deplocI_persistent_buffer_sp_.assign(num_successors, {});
+  for (size_t deplocI = 0; deplocI < num_successors; ++deplocI)
+  {
+    const int locJ = location_successors[deplocI];
+    const auto& message_sizes = deplocI_message_size[deplocI];
+    const u_ll_int num_unknowns = std::accumulate(
+      message_sizes.begin(), message_sizes.end(), u_ll_int(0));
+
+    if (single_precision_)
+      deplocI_persistent_buffer_sp_[deplocI].assign(num_unknowns, 0.0f);
+    else
+      deplocI_persistent_buffer_[deplocI].assign(num_unknowns, 0.0);
+
+    auto& requests = deplocI_message_request[deplocI];
+    for (int m = 0; m < deplocI_message_count[deplocI]; ++m)
+    {
+      const u_ll_int block_addr = deplocI_message_blockpos[deplocI][m];
+
+      void* send_buffer;
+      MPI_Datatype datatype;
+      if (single_precision_)
+      {
+        send_buffer = &deplocI_persistent_buffer_sp_[deplocI][block_addr];
+        datatype = MPI_FLOAT;
+      }
+      else
+      {
+        send_buffer = &deplocI_persistent_buffer_[deplocI][block_addr];
+        datatype = MPI_DOUBLE;
+      }
+
+      MPI_Send_init(send_buffer,
+                    static_cast<int>(message_sizes[m]),
+                    datatype,
+                    comm_set_.MapIonJ(locJ, locJ),
+                    max_num_mess * angle_set_num + m, // tag
+                    comm_set_.LocICommunicator(locJ),
+                    &requests[m]);
+    } // for message
+  }   // for deplocI
+
+  persistent_send_requests_built_ = true;
+}
+
+// ###################################################################
+/**Starts the persistent receive requests of all predecessors, building
+ * them first if required.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  StartPersistentReceives(int angle_set_num)
+{
+  const auto& location_dependencies =
+    fluds_.GetSPDS().GetLocationDependencies();
+  const size_t num_dependencies = location_dependencies.size();
+
+  if (not persistent_recv_requests_built_)
+  {
+    prelocI_persistent_request_.assign(num_dependencies, {});
+    prelocI_persistent_buffer_.assign(num_dependencies, {});
+    prelocI_persistent_buffer_sp_.assign(num_dependencies, {});
+    for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+    {
+      const int locJ = location_dependencies[prelocI];
+      const auto& message_sizes = prelocI_message_size[prelocI];
+      const u_ll_int num_unknowns = std::accumulate(
+        message_sizes.begin(), message_sizes.end(), u_ll_int(0));
+
+      if (single_precision_)
+        prelocI_persistent_buffer_sp_[prelocI].assign(num_unknowns, 0.0f);
+      else
+        prelocI_persistent_buffer_[prelocI].assign(num_unknowns, 0.0);
+
+      auto& requests = prelocI_persistent_request_[prelocI];
+      requests.assign(prelocI_message_count[prelocI], MPI_REQUEST_NULL);
+      for (int m = 0; m < prelocI_message_count[prelocI]; ++m)
+      {
+        const u_ll_int block_addr = prelocI_message_blockpos[prelocI][m];
+
+        void* recv_buffer;
+        MPI_Datatype datatype;
+        if (single_precision_)
+        {
+          recv_buffer = &prelocI_persistent_buffer_sp_[prelocI][block_addr];
+          datatype = MPI_FLOAT;
+        }
+        else
+        {
+          recv_buffer = &prelocI_persistent_buffer_[prelocI][block_addr];
+          datatype = MPI_DOUBLE;
+        }
+
+        MPI_Recv_init(recv_buffer,
+                      static_cast<int>(message_sizes[m]),
+                      datatype,
+                      comm_set_.MapIonJ(locJ, Chi::mpi.location_id),
+                      max_num_mess * angle_set_num + m, // tag
+                      comm_set_.LocICommunicator(Chi::mpi.location_id),
+                      &requests[m]);
+      } // for message
+    }   // for prelocI
+
+    persistent_recv_requests_built_ = true;
+  }
+
+  for (auto& requests : prelocI_persistent_request_)
+    MPI_Startall(static_cast<int>(requests.size()), requests.data());
+}
+
+// ###################################################################
+/**Tests the persistent receive requests of all predecessors and copies
+ * the completed messages into the FLUDS.*/
+chi_mesh::sweep_management::AngleSetStatus
+chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  ReceivePersistentUpstreamPsi()
+{
+  const size_t num_dependencies = prelocI_persistent_request_.size();
+  auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
+
+  bool ready_to_execute = true;
+  for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+  {
+
+    const int num_mess = prelocI_message_count[prelocI];
+    for (int m = 0; m < num_mess; ++m)
+    {
+      if (prelocI_message_received[prelocI][m]) continue;
+
+      int message_received = 0;
+      MPI_Test(&prelocI_persistent_request_[prelocI][m],
+               &message_received,
+               MPI_STATUS_IGNORE);
+      if (not message_received)
+      {
+        ready_to_execute = false;
+        continue;
+      }
+
+      const u_ll_int block_addr = prelocI_message_blockpos[prelocI][m];
+      const u_ll_int message_size = prelocI_message_size[prelocI][m];
+      if (single_precision_)
+      {
+        const auto& buffer = prelocI_persistent_buffer_sp_[prelocI];
+        auto& upstream_psi = aah_fluds.PrelocIOutgoingPsiSP()[prelocI];
+        std::copy(&buffer[block_addr],
+                  &buffer[block_addr] + message_size,
+                  &upstream_psi[block_addr]);
+      }
+      else
+      {
+        const auto& buffer = prelocI_persistent_buffer_[prelocI];
+        auto& upstream_psi = aah_fluds.PrelocIOutgoingPsi()[prelocI];
+        std::copy(&buffer[block_addr],
+                  &buffer[block_addr] + message_size,
+                  &upstream_psi[block_addr]);
+      }
+
+      prelocI_message_received[prelocI][m] = true;
+
+      if (sweep_statistics_)
+        sweep_statistics_->CountReceivedMessage(
+          message_size * (single_precision_ ? sizeof(float) : sizeof(double)));
+    } // for message
+
+    if (not ready_to_execute) break;
+  } // for prelocI
+
+  if (not ready_to_execute) return AngleSetStatus::RECEIVING;
+  else
+    return AngleSetStatus::READY_TO_EXECUTE;
+}
+
+// ###################################################################
+/**Frees the persistent requests, if any, such that they are rebuilt at the
+ * next sweep.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  FreePersistentRequests()
+{
+  if (not persistent_send_requests_built_ and
+      not persistent_recv_requests_built_)
+    return;
+
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+
+  auto FreeRequests = [finalized](std::vector<MPI_Request>& requests)
+  {
+    for (auto& request : requests)
+    {
+      if (not finalized and request != MPI_REQUEST_NULL)
+        MPI_Request_free(&request);
+      request = MPI_REQUEST_NULL;
+    }
+  };
+
+  if (persistent_send_requests_built_)
+    for (auto& requests : deplocI_message_request)
+      FreeRequests(requests);
+
+  for (auto& requests : prelocI_persistent_request_)
+    FreeRequests(requests);
+
+  persistent_send_requests_built_ = false;
+  persistent_recv_requests_built_ = false;
+}
@@ -51,14 +51,12 @@ bool chi_mesh::sweep_management::AAH_ASynchronousCommunicator::ReceiveDelayedDat
         u_ll_int block_addr = delayed_prelocI_message_blockpos[prelocI][m];
         u_ll_int message_size = delayed_prelocI_message_size[prelocI][m];
 
-        int error_code =
-          MPI_Recv(&upstream_psi[block_addr],
-                   static_cast<int>(message_size),
-                   MPI_DOUBLE,
-                   comm_set_.MapIonJ(locJ, Chi::mpi.location_id),
-                   max_num_mess * angle_set_num + m, // tag
-                   comm_set_.LocICommunicator(Chi::mpi.location_id),
-                   MPI_STATUS_IGNORE);
+        int error_code = ReceivePsiMessage(
+          &upstream_psi[block_addr],
+          message_size,
+          comm_set_.MapIonJ(locJ, Chi::mpi.location_id),
+          max_num_mess * angle_set_num + m, // tag
+          comm_set_.LocICommunicator(Chi::mpi.location_id));
 
         delayed_prelocI_message_received[prelocI][m] = true;
 
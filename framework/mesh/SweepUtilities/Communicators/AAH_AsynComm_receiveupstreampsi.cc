@@ -2,6 +2,7 @@
 
 #include "mesh/SweepUtilities/AngleSet/AngleSet.h"
 #include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
 
 #include "mpi/chi_mpi_commset.h"
 
@@ -23,9 +24,20 @@ chi_mesh::sweep_management::AAH_ASynchronousCommunicator::ReceiveUpstreamPsi(int
     fluds_.AllocatePrelocIOutgoingPsi(
       num_groups_, num_angles_, num_loc_deps);
 
+    if (persistent_requests_) StartPersistentReceives(angle_set_num);
+
     upstream_data_initialized = true;
   }
 
+  //============================== Receive from on-node predecessors
+  const bool shared_psi_received = ReceiveSharedUpstreamPsi();
+
+  if (persistent_requests_)
+  {
+    const auto status = ReceivePersistentUpstreamPsi();
+    return shared_psi_received ? status : AngleSetStatus::RECEIVING;
+  }
+
   //============================== Assume all data is available and now try
   //                               to receive all of it
   bool ready_to_execute = true;
@@ -52,19 +64,24 @@ chi_mesh::sweep_management::AAH_ASynchronousCommunicator::ReceiveUpstreamPsi(int
         } // if message is not available
 
         //============================ Receive upstream data
-        auto& upstream_psi = fluds_.PrelocIOutgoingPsi()[prelocI];
+        auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
 
         u_ll_int block_addr = prelocI_message_blockpos[prelocI][m];
         u_ll_int message_size = prelocI_message_size[prelocI][m];
 
+        const int source = comm_set_.MapIonJ(locJ, Chi::mpi.location_id);
+        const int tag = max_num_mess * angle_set_num + m;
+        const MPI_Comm comm =
+          comm_set_.LocICommunicator(Chi::mpi.location_id);
+
         int error_code =
-          MPI_Recv(&upstream_psi[block_addr],
-                   static_cast<int>(message_size),
-                   MPI_DOUBLE,
-                   comm_set_.MapIonJ(locJ, Chi::mpi.location_id),
-                   max_num_mess * angle_set_num + m, // tag
-                   comm_set_.LocICommunicator(Chi::mpi.location_id),
-                   MPI_STATUS_IGNORE);
+          single_precision_
+            ? ReceivePsiMessage(
+                &aah_fluds.PrelocIOutgoingPsiSP()[prelocI][block_addr],
+                message_size, source, tag, comm)
+            : ReceivePsiMessage(
+                &aah_fluds.PrelocIOutgoingPsi()[prelocI][block_addr],
+                message_size, source, tag, comm);
 
         prelocI_message_received[prelocI][m] = true;
 
@@ -91,7 +108,8 @@ chi_mesh::sweep_management::AAH_ASynchronousCommunicator::ReceiveUpstreamPsi(int
     if (!ready_to_execute) break;
   } // for predecessor
 
-  if (!ready_to_execute) return AngleSetStatus::RECEIVING;
+  if (!ready_to_execute or !shared_psi_received)
+    return AngleSetStatus::RECEIVING;
   else
     return AngleSetStatus::READY_TO_EXECUTE;
 }
\ No newline at end of file
@@ -2,9 +2,13 @@
 
 #include "mesh/SweepUtilities/AngleSet/AngleSet.h"
 #include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
 
 #include "mpi/chi_mpi_commset.h"
 
+#include <algorithm>
+
 //###################################################################
 /**Sends downstream psi. This method gets called after a sweep chunk has
  * executed */
@@ -16,6 +20,54 @@ SendDownstreamPsi(int angle_set_num)
   const auto& location_successors = spds.GetLocationSuccessors();
 
   const size_t num_successors = location_successors.size();
+
+  auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
+
+  //============================== Write to on-node successors
+  SendSharedDownstreamPsi();
+
+  //============================== Start the persistent requests
+  if (persistent_requests_)
+  {
+    if (not persistent_send_requests_built_)
+      BuildPersistentSendRequests(angle_set_num);
+
+    for (size_t deplocI=0; deplocI<num_successors; deplocI++)
+    {
+      if (IsDeplocIShared(deplocI)) continue;
+
+      if (single_precision_)
+      {
+        const auto& psi = aah_fluds.DeplocIOutgoingPsiSP()[deplocI];
+        std::copy(psi.begin(), psi.end(),
+                  deplocI_persistent_buffer_sp_[deplocI].begin());
+      }
+      else
+      {
+        const auto& psi = aah_fluds.DeplocIOutgoingPsi()[deplocI];
+        std::copy(psi.begin(), psi.end(),
+                  deplocI_persistent_buffer_[deplocI].begin());
+      }
+    }
+
+    // Outgoing psi is held by the persistent buffers
+    fluds_.ClearSendPsi();
+
+    for (auto& requests : deplocI_message_request)
+      MPI_Startall(static_cast<int>(requests.size()), requests.data());
+
+    if (sweep_statistics_)
+    {
+      const size_t value_size = single_precision_ ? sizeof(float)
+                                                  : sizeof(double);
+      for (size_t deplocI=0; deplocI<num_successors; deplocI++)
+        if (not IsDeplocIShared(deplocI))
+          for (const u_ll_int message_size : deplocI_message_size[deplocI])
+            sweep_statistics_->CountSentMessage(message_size * value_size);
+    }
+    return;
+  }
+
   for (size_t deplocI=0; deplocI<num_successors; deplocI++)
   {
     int locJ = location_successors[deplocI];
@@ -26,15 +78,30 @@ SendDownstreamPsi(int angle_set_num)
       u_ll_int block_addr   = deplocI_message_blockpos[deplocI][m];
       u_ll_int message_size = deplocI_message_size[deplocI][m];
 
-      const auto& outgoing_psi = fluds_.DeplocIOutgoingPsi()[deplocI];
+      void* send_buffer;
+      MPI_Datatype datatype;
+      if (single_precision_)
+      {
+        send_buffer = &aah_fluds.DeplocIOutgoingPsiSP()[deplocI][block_addr];
+        datatype = MPI_FLOAT;
+      }
+      else
+      {
+        send_buffer = &aah_fluds.DeplocIOutgoingPsi()[deplocI][block_addr];
+        datatype = MPI_DOUBLE;
+      }
 
-      MPI_Isend(&outgoing_psi[block_addr],
+      MPI_Isend(send_buffer,
                 static_cast<int>(message_size),
-                MPI_DOUBLE,
+                datatype,
                 comm_set_.MapIonJ(locJ,locJ),
                 max_num_mess*angle_set_num + m, //tag
                 comm_set_.LocICommunicator(locJ),
                 &deplocI_message_request[deplocI][m]);
+
+      if (sweep_statistics_)
+        sweep_statistics_->CountSentMessage(
+          message_size * (single_precision_ ? sizeof(float) : sizeof(double)));
     }//for message
   }//for deplocI
 }
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "AAH_AsynComm.h"
+
+#include "mesh/SweepUtilities/AngleSet/AngleSet.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
+
+#include "mpi/chi_mpi_commset.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+
+// ###################################################################
+/**Sets whether psi is exchanged through MPI-3 shared-memory windows with
+ * the predecessors and successors that share a node with this location.
+ * Each location exposes one slot per on-node predecessor in a window of
+ * the node communicator. The predecessor writes its outgoing psi straight
+ * into the slot and raises a flag, which replaces the MPI messages of that
+ * link. Links to other nodes, and delayed (cyclic) links, keep using MPI
+ * messages.
+ *
+ * Building the window is collective over the node communicator, hence this
+ * must be called for every angle set, in the same order, on all locations
+ * and before the maximum number of messages is reconciled.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  SetSharedMemoryExchange(bool flag)
+{
+  if (flag == shared_memory_) return;
+  if (comm_set_.NodeCommunicator() == MPI_COMM_NULL) return;
+
+  FreePersistentRequests();
+  FreeSharedWindow();
+  shared_memory_ = flag;
+
+  if (shared_memory_) BuildSharedWindow();
+
+  BuildMessageStructure();
+}
+
+// ###################################################################
+/**Returns true if the psi of the given predecessor is received through
+ * the shared-memory window.*/
+bool chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  IsPrelocIShared(size_t prelocI) const
+{
+  return prelocI < prelocI_shared_slot_.size() and
+         prelocI_shared_slot_[prelocI] != nullptr;
+}
+
+// ###################################################################
+/**Returns true if the psi of the given successor is sent through the
+ * shared-memory window.*/
+bool chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  IsDeplocIShared(size_t deplocI) const
+{
+  return deplocI < deplocI_shared_slot_.size() and
+         deplocI_shared_slot_[deplocI] != nullptr;
+}
+
+// ###################################################################
+/**Allocates the shared-memory window holding the slots of the on-node
+ * predecessors and obtains the slots, in the windows of the on-node
+ * successors, into which this location writes.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  BuildSharedWindow()
+{
+  const auto& spds = fluds_.GetSPDS();
+  auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
+  const MPI_Comm node_comm = comm_set_.NodeCommunicator();
+
+  const auto& location_dependencies = spds.GetLocationDependencies();
+  const auto& delayed_location_dependencies =
+    spds.GetDelayedLocationDependencies();
+  const auto& location_successors = spds.GetLocationSuccessors();
+
+  //============================================= Slot layout
+  // Each slot is a flag followed by the psi of the predecessor. The slots
+  // are sized for double precision psi, hence also hold single precision
+  // psi.
+  const size_t num_dependencies = location_dependencies.size();
+  std::vector<long long> prelocI_offsets(num_dependencies, -1);
+  MPI_Aint window_size = 0;
+  for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+  {
+    if (comm_set_.NodeRank(location_dependencies[prelocI]) < 0) continue;
+
+    const u_ll_int num_unknowns =
+      aah_fluds.GetPrelocIFaceDOFCount(static_cast<int>(prelocI)) *
+      num_groups_ * num_angles_;
+
+    prelocI_offsets[prelocI] = window_size;
+    window_size +=
+      static_cast<MPI_Aint>(sizeof(u_ll_int) + num_unknowns * sizeof(double));
+  }
+
+  char* window_base = nullptr;
+  MPI_Win_allocate_shared(
+    window_size, 1, MPI_INFO_NULL, node_comm, &window_base, &shared_window_);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, shared_window_);
+
+  prelocI_shared_slot_.assign(num_dependencies, nullptr);
+  prelocI_shared_received_.assign(num_dependencies, false);
+  for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+  {
+    if (prelocI_offsets[prelocI] < 0) continue;
+
+    char* slot = window_base + prelocI_offsets[prelocI];
+    *reinterpret_cast<u_ll_int*>(slot) = 0;
+    prelocI_shared_slot_[prelocI] = slot;
+  }
+
+  //============================================= Send offsets to predecessors
+  // Delayed predecessors get -1 since they keep using MPI messages
+  std::vector<std::pair<int, long long>> offsets_to_send;
+  for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+  {
+    const int node_rank = comm_set_.NodeRank(location_dependencies[prelocI]);
+    if (node_rank >= 0)
+      offsets_to_send.emplace_back(node_rank, prelocI_offsets[prelocI]);
+  }
+  for (const int locJ : delayed_location_dependencies)
+  {
+    const int node_rank = comm_set_.NodeRank(locJ);
+    if (node_rank >= 0) offsets_to_send.emplace_back(node_rank, -1);
+  }
+
+  std::vector<MPI_Request> requests(offsets_to_send.size(), MPI_REQUEST_NULL);
+  for (size_t i = 0; i < offsets_to_send.size(); ++i)
+    MPI_Isend(&offsets_to_send[i].second,
+              1,
+              MPI_LONG_LONG,
+              offsets_to_send[i].first,
+              0, // tag
+              node_comm,
+              &requests[i]);
+
+  //============================================= Receive offsets of successors
+  const size_t num_successors = location_successors.size();
+  deplocI_shared_slot_.assign(num_successors, nullptr);
+  for (size_t deplocI = 0; deplocI < num_successors; ++deplocI)
+  {
+    const int node_rank = comm_set_.NodeRank(location_successors[deplocI]);
+    if (node_rank < 0) continue;
+
+    long long offset = -1;
+    MPI_Recv(
+      &offset, 1, MPI_LONG_LONG, node_rank, 0, node_comm, MPI_STATUS_IGNORE);
+    if (offset < 0) continue;
+
+    MPI_Aint segment_size;
+    int disp_unit;
+    char* segment_base = nullptr;
+    MPI_Win_shared_query(
+      shared_window_, node_rank, &segment_size, &disp_unit, &segment_base);
+
+    deplocI_shared_slot_[deplocI] = segment_base + offset;
+  }
+
+  MPI_Waitall(
+    static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+  // Make the zeroed flags visible before any location writes
+  MPI_Win_sync(shared_window_);
+  MPI_Barrier(node_comm);
+}
+
+// ###################################################################
+/**Writes the outgoing psi of the on-node successors into their slots and
+ * raises the flags of the slots.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  SendSharedDownstreamPsi()
+{
+  if (not shared_memory_) return;
+
+  auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
+  const size_t num_successors = deplocI_shared_slot_.size();
+
+  bool any_shared = false;
+  for (size_t deplocI = 0; deplocI < num_successors; ++deplocI)
+  {
+    char* slot = deplocI_shared_slot_[deplocI];
+    if (slot == nullptr) continue;
+
+    char* slot_psi = slot + sizeof(u_ll_int);
+    if (single_precision_)
+    {
+      const auto& psi = aah_fluds.DeplocIOutgoingPsiSP()[deplocI];
+      std::copy(psi.begin(), psi.end(), reinterpret_cast<float*>(slot_psi));
+    }
+    else
+    {
+      const auto& psi = aah_fluds.DeplocIOutgoingPsi()[deplocI];
+      std::copy(psi.begin(), psi.end(), reinterpret_cast<double*>(slot_psi));
+    }
+    any_shared = true;
+  }
+  if (not any_shared) return;
+
+  // The psi must be visible before the flags are
+  MPI_Win_sync(shared_window_);
+
+  for (char* slot : deplocI_shared_slot_)
+    if (slot != nullptr)
+      *reinterpret_cast<volatile u_ll_int*>(slot) = shared_sweep_count_;
+
+  MPI_Win_sync(shared_window_);
+}
+
+// ###################################################################
+/**Copies the psi of the on-node predecessors whose flags are raised into
+ * the FLUDS. Returns true when the psi of all on-node predecessors has been
+ * received.*/
+bool chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  ReceiveSharedUpstreamPsi()
+{
+  if (not shared_memory_) return true;
+
+  const size_t num_dependencies = prelocI_shared_slot_.size();
+  auto& aah_fluds = dynamic_cast<AAH_FLUDS&>(fluds_);
+
+  MPI_Win_sync(shared_window_);
+
+  bool all_received = true;
+  for (size_t prelocI = 0; prelocI < num_dependencies; ++prelocI)
+  {
+    const char* slot = prelocI_shared_slot_[prelocI];
+    if (slot == nullptr or prelocI_shared_received_[prelocI]) continue;
+
+    const auto flag = *reinterpret_cast<const volatile u_ll_int*>(slot);
+    if (flag != shared_sweep_count_)
+    {
+      all_received = false;
+      continue;
+    }
+
+    // Make sure the psi is not read ahead of the flag
+    MPI_Win_sync(shared_window_);
+
+    const char* slot_psi = slot + sizeof(u_ll_int);
+    if (single_precision_)
+    {
+      auto& upstream_psi = aah_fluds.PrelocIOutgoingPsiSP()[prelocI];
+      const auto* psi = reinterpret_cast<const float*>(slot_psi);
+      std::copy(psi, psi + upstream_psi.size(), upstream_psi.begin());
+    }
+    else
+    {
+      auto& upstream_psi = aah_fluds.PrelocIOutgoingPsi()[prelocI];
+      const auto* psi = reinterpret_cast<const double*>(slot_psi);
+      std::copy(psi, psi + upstream_psi.size(), upstream_psi.begin());
+    }
+
+    prelocI_shared_received_[prelocI] = true;
+  }
+
+  return all_received;
+}
+
+// ###################################################################
+/**Frees the shared-memory window, if any. This is collective over the node
+ * communicator unless MPI has been finalized.*/
+void chi_mesh::sweep_management::AAH_ASynchronousCommunicator::
+  FreeSharedWindow()
+{
+  prelocI_shared_slot_.clear();
+  prelocI_shared_received_.clear();
+  deplocI_shared_slot_.clear();
+
+  if (shared_window_ == MPI_WIN_NULL) return;
+
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (not finalized)
+  {
+    MPI_Win_unlock_all(shared_window_);
+    MPI_Win_free(&shared_window_);
+  }
+  shared_window_ = MPI_WIN_NULL;
+}
@@ -14,6 +14,7 @@ namespace chi_mesh::sweep_management
 {
 
 class FLUDS;
+struct SweepStatistics;
 
 class AsynchronousCommunicator
 {
@@ -31,9 +32,17 @@ public:
                                                       size_t angle_set_id,
                                                       size_t data_size);
 
+  /**Sets the statistics into which the messages are counted, or null to
+   * not count them.*/
+  void SetSweepStatistics(SweepStatistics* sweep_statistics)
+  {
+    sweep_statistics_ = sweep_statistics;
+  }
+
 protected:
   FLUDS& fluds_;
   const chi::ChiMPICommunicatorSet& comm_set_;
+  SweepStatistics* sweep_statistics_ = nullptr;
 };
 
 } // namespace chi_mesh::sweep_management
@@ -0,0 +1,123 @@
+#include "SweepLinkTuning.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace chi_mesh::sweep_management
+{
+
+namespace
+{
+/**Returns the average one way time, in seconds, of sending a message of the
+ * given size between this location and `partner`. The lower ranked of the
+ * two locations starts the ping-pong.*/
+double PingPong(int partner, std::vector<char>& buffer, int size, int tag)
+{
+  const int num_repetitions = 10;
+  const bool starts = Chi::mpi.location_id < partner;
+
+  double elapsed = 0.0;
+  for (int r = -1; r < num_repetitions; ++r) // r = -1 is a warm-up
+  {
+    const double t0 = MPI_Wtime();
+    if (starts)
+    {
+      MPI_Send(buffer.data(), size, MPI_CHAR, partner, tag, Chi::mpi.comm);
+      MPI_Recv(buffer.data(), size, MPI_CHAR, partner, tag, Chi::mpi.comm,
+               MPI_STATUS_IGNORE);
+    }
+    else
+    {
+      MPI_Recv(buffer.data(), size, MPI_CHAR, partner, tag, Chi::mpi.comm,
+               MPI_STATUS_IGNORE);
+      MPI_Send(buffer.data(), size, MPI_CHAR, partner, tag, Chi::mpi.comm);
+    }
+    if (r >= 0) elapsed += MPI_Wtime() - t0;
+  }
+
+  return elapsed / (2.0 * num_repetitions);
+}
+} // namespace
+
+// ###################################################################
+/**Measures the links to the neighbor locations.
+ *
+ * Each link is benchmarked with messages of 8 bytes and then of 1 kB up to
+ * `max_message_size`, doubling the size every time. The latency is the time
+ * of the 8 byte message and the bandwidth follows from the largest message.
+ * A message size is considered to be below the eager-limit of the link if
+ * its time exceeds the latency-bandwidth model by less than one latency,
+ * since the rendezvous protocol adds at least one extra round trip. The
+ * selected limit is the largest size for which this holds for all smaller
+ * sizes.
+ *
+ * Links are benchmarked one at a time, in a globally consistent order of
+ * the location pairs, which avoids deadlock. The lower ranked location of
+ * a pair computes the measurement and sends it to its partner such that
+ * both use the same limit.*/
+std::map<int, SweepLinkMeasurement>
+MeasureSweepNeighborLinks(const std::set<int>& neighbor_locations,
+                          int max_message_size)
+{
+  const int tag = 0;
+  const int min_message_size = 1024;
+  max_message_size = std::max(max_message_size, min_message_size);
+
+  std::vector<int> sizes = {8};
+  for (int size = min_message_size; size <= max_message_size; size *= 2)
+    sizes.push_back(size);
+
+  //============================================= Order pairs globally
+  // Pairs are ordered by (lower rank, higher rank). Locations with rank
+  // lower than this location are handled first, in increasing order,
+  // followed by the locations with higher rank.
+  std::vector<int> partners(neighbor_locations.begin(),
+                            neighbor_locations.end());
+  partners.erase(
+    std::remove(partners.begin(), partners.end(), Chi::mpi.location_id),
+    partners.end());
+
+  std::vector<char> buffer(sizes.back(), 0);
+  std::map<int, SweepLinkMeasurement> measurements;
+  for (int partner : partners)
+  {
+    std::vector<double> times;
+    times.reserve(sizes.size());
+    for (int size : sizes)
+      times.push_back(PingPong(partner, buffer, size, tag));
+
+    double results[3] = {0.0, 0.0, 0.0};
+    if (Chi::mpi.location_id < partner)
+    {
+      const double latency = times.front();
+      const double transfer_time = std::max(times.back() - latency, 1.0e-12);
+      const double bandwidth = sizes.back() / transfer_time; // bytes/s
+
+      int eager_limit = min_message_size;
+      for (size_t k = 1; k < sizes.size(); ++k)
+      {
+        const double model_time = latency + sizes[k] / bandwidth;
+        if (times[k] - model_time > latency) break;
+        eager_limit = sizes[k];
+      }
+
+      results[0] = latency * 1.0e6;
+      results[1] = bandwidth / (1024.0 * 1024.0);
+      results[2] = eager_limit;
+      MPI_Send(results, 3, MPI_DOUBLE, partner, tag, Chi::mpi.comm);
+    }
+    else
+      MPI_Recv(results, 3, MPI_DOUBLE, partner, tag, Chi::mpi.comm,
+               MPI_STATUS_IGNORE);
+
+    measurements[partner] = {
+      results[0], results[1], static_cast<int>(results[2])};
+  } // for partner
+
+  return measurements;
+}
+
+} // namespace chi_mesh::sweep_management
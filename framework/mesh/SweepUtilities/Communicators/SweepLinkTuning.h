@@ -0,0 +1,29 @@
+#ifndef CHITECH_SWEEP_LINK_TUNING_H
+#define CHITECH_SWEEP_LINK_TUNING_H
+
+#include <map>
+#include <set>
+
+namespace chi_mesh::sweep_management
+{
+
+/**Measured properties of the link between this location and a neighboring
+ * location.*/
+struct SweepLinkMeasurement
+{
+  double latency_us = 0.0;     ///< One way latency of a small message
+  double bandwidth_mbps = 0.0; ///< Bandwidth of the largest message
+  int eager_limit = 0;         ///< Selected message size limit in bytes
+};
+
+/**Measures, with a ping-pong benchmark, the latency and bandwidth of the
+ * links between this location and each of the given neighbor locations,
+ * and selects a message size limit per link. This is a collective call in
+ * which the neighbor relation must be symmetric.*/
+std::map<int, SweepLinkMeasurement>
+MeasureSweepNeighborLinks(const std::set<int>& neighbor_locations,
+                          int max_message_size);
+
+} // namespace chi_mesh::sweep_management
+
+#endif // CHITECH_SWEEP_LINK_TUNING_H
@@ -1,8 +1,13 @@
 #include "AAH_FLUDS.h"
 
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "math/chi_math.h"
+#include "utils/chi_memory_accounting.h"
+
+#include <algorithm>
 
 namespace chi_mesh::sweep_management
 {
@@ -36,17 +41,17 @@ double* AAH_FLUDS::OutgoingPsi(int cell_so_index,
                                int face_dof,
                                int n)
 {
+  const size_t entry =
+    common_data_.OutbFaceEntry(cell_so_index, outb_face_counter);
   // Face category
-  int fc = common_data_
-             .so_cell_outb_face_face_category[cell_so_index][outb_face_counter];
+  int fc = common_data_.outb_face_face_category[entry];
+  const size_t slot = common_data_.outb_face_slot_indices[entry];
 
   if (fc >= 0)
   {
     size_t index =
       local_psi_Gn_block_strideG[fc] * n +
-      common_data_
-          .so_cell_outb_face_slot_indices[cell_so_index][outb_face_counter] *
-        common_data_.local_psi_stride[fc] * num_groups_ +
+      slot * common_data_.local_psi_stride[fc] * num_groups_ +
       face_dof * num_groups_;
 
     return &local_psi_[fc][index];
@@ -55,9 +60,7 @@ double* AAH_FLUDS::OutgoingPsi(int cell_so_index,
   {
     size_t index =
       delayed_local_psi_Gn_block_strideG * n +
-      common_data_
-          .so_cell_outb_face_slot_indices[cell_so_index][outb_face_counter] *
-        common_data_.delayed_local_psi_stride * num_groups_ +
+      slot * common_data_.delayed_local_psi_stride * num_groups_ +
       face_dof * num_groups_;
 
     return &delayed_local_psi_[index];
@@ -65,9 +68,42 @@ double* AAH_FLUDS::OutgoingPsi(int cell_so_index,
 }
 
 // ###################################################################
-/**Given a outbound face counter this method returns a pointer
- * to the location*/
-double* AAH_FLUDS::NLOutgoingPsi(int outb_face_counter, int face_dof, int n)
+/**Copies the delayed local psi written by the cells at sweep ordering
+ * indices `spls_begin` to `spls_end` (inclusive) from the new to the old
+ * delayed local psi, such that cells reading it see the latest values.
+ * Delayed psi of other cells is left untouched.*/
+void AAH_FLUDS::CopyDelayedLocalPsiToOld(size_t spls_begin, size_t spls_end)
+{
+  const size_t slot_size = common_data_.delayed_local_psi_stride * num_groups_;
+
+  for (size_t so = spls_begin; so <= spls_end; ++so)
+  {
+    for (size_t entry = common_data_.so_cell_outb_face_offsets[so];
+         entry < common_data_.so_cell_outb_face_offsets[so + 1]; ++entry)
+    {
+      const int fc = common_data_.outb_face_face_category[entry];
+      if (fc >= 0) continue;
+
+      const size_t slot = common_data_.outb_face_slot_indices[entry];
+      for (size_t n = 0; n < num_angles_; ++n)
+      {
+        const size_t index =
+          delayed_local_psi_Gn_block_strideG * n + slot * slot_size;
+        std::copy(delayed_local_psi_.begin() + index,
+                  delayed_local_psi_.begin() + index + slot_size,
+                  delayed_local_psi_old_.begin() + index);
+      }
+    }
+  }
+}
+
+// ###################################################################
+/**Given a outbound face counter this method computes the index of the
+ * position in the outgoing psi of the successor `deplocI`.*/
+size_t AAH_FLUDS::NLOutgoingIndex(int outb_face_counter,
+                                  int face_dof,
+                                  int n,
+                                  int& deplocI) const
 {
   if (outb_face_counter > common_data_.nonlocal_outb_face_deplocI_slot.size())
   {
@@ -77,26 +113,49 @@ double* AAH_FLUDS::NLOutgoingPsi(int outb_face_counter, int face_dof, int n)
     Chi::Exit(EXIT_FAILURE);
   }
 
-  int depLocI =
+  deplocI =
     common_data_.nonlocal_outb_face_deplocI_slot[outb_face_counter].first;
   int slot =
     common_data_.nonlocal_outb_face_deplocI_slot[outb_face_counter].second;
   int nonlocal_psi_Gn_blockstride =
-    common_data_.deplocI_face_dof_count[depLocI];
+    common_data_.deplocI_face_dof_count[deplocI];
 
   int index = nonlocal_psi_Gn_blockstride * num_groups_ * n +
               slot * num_groups_ + face_dof * num_groups_;
 
-  if ((index < 0) || (index > deplocI_outgoing_psi_[depLocI].size()))
+  const size_t buffer_size =
+    single_precision_nonlocal_psi_ ? deplocI_outgoing_psi_sp_[deplocI].size()
+                                   : deplocI_outgoing_psi_[deplocI].size();
+  if ((index < 0) || (index > buffer_size))
   {
     Chi::log.LogAllError() << "Invalid index " << index
                            << " encountered in non-local outgoing Psi"
-                           << " max allowed "
-                           << deplocI_outgoing_psi_[depLocI].size();
+                           << " max allowed " << buffer_size;
     Chi::Exit(EXIT_FAILURE);
   }
 
-  return &deplocI_outgoing_psi_[depLocI][index];
+  return index;
+}
+
+// ###################################################################
+/**Given a outbound face counter this method returns a pointer
+ * to the location*/
+double* AAH_FLUDS::NLOutgoingPsi(int outb_face_counter, int face_dof, int n)
+{
+  int deplocI;
+  const size_t index = NLOutgoingIndex(outb_face_counter, face_dof, n, deplocI);
+
+  return &deplocI_outgoing_psi_[deplocI][index];
+}
+
+// ###################################################################
+/**Single precision counterpart of NLOutgoingPsi.*/
+float* AAH_FLUDS::NLOutgoingPsiSP(int outb_face_counter, int face_dof, int n)
+{
+  int deplocI;
+  const size_t index = NLOutgoingIndex(outb_face_counter, face_dof, n, deplocI);
+
+  return &deplocI_outgoing_psi_sp_[deplocI][index];
 }
 
 // ###################################################################
@@ -107,22 +166,21 @@ double* AAH_FLUDS::NLOutgoingPsi(int outb_face_counter, int face_dof, int n)
 double* AAH_FLUDS::UpwindPsi(
   int cell_so_index, int inc_face_counter, int face_dof, int g, int n)
 {
+  const size_t entry =
+    common_data_.IncoFaceEntry(cell_so_index, inc_face_counter);
   // Face category
-  int fc = common_data_
-             .so_cell_inco_face_face_category[cell_so_index][inc_face_counter];
+  int fc = common_data_.inco_face_face_category[entry];
+  const size_t slot = common_data_.inco_face_slot_addresses[entry];
+  const size_t upwind_dof =
+    common_data_.inco_face_upwind_dofs
+      [common_data_.inco_face_dof_offsets[entry] + face_dof];
 
   if (fc >= 0)
   {
     size_t index =
       local_psi_Gn_block_strideG[fc] * n +
-      common_data_
-          .so_cell_inco_face_dof_indices[cell_so_index][inc_face_counter]
-          .slot_address *
-        common_data_.local_psi_stride[fc] * num_groups_ +
-      common_data_
-          .so_cell_inco_face_dof_indices[cell_so_index][inc_face_counter]
-          .upwind_dof_mapping[face_dof] *
-        num_groups_ +
+      slot * common_data_.local_psi_stride[fc] * num_groups_ +
+      upwind_dof * num_groups_ +
       g;
 
     return &local_psi_[fc][index];
@@ -131,14 +189,8 @@ double* AAH_FLUDS::UpwindPsi(
   {
     size_t index =
       delayed_local_psi_Gn_block_strideG * n +
-      common_data_
-          .so_cell_inco_face_dof_indices[cell_so_index][inc_face_counter]
-          .slot_address *
-        common_data_.delayed_local_psi_stride * num_groups_ +
-      common_data_
-          .so_cell_inco_face_dof_indices[cell_so_index][inc_face_counter]
-          .upwind_dof_mapping[face_dof] *
-        num_groups_ +
+      slot * common_data_.delayed_local_psi_stride * num_groups_ +
+      upwind_dof * num_groups_ +
       g;
 
     return &delayed_local_psi_old_[index];
@@ -199,6 +251,41 @@ AAH_FLUDS::NLUpwindPsi(int nonl_inc_face_counter, int face_dof, int g, int n)
   }
 }
 
+// ###################################################################
+/**Single precision counterpart of NLUpwindPsi. Returns `nullptr` when the
+ * face has a delayed predecessor, whose psi is always stored in double
+ * precision and obtained with NLUpwindPsi.*/
+const float* AAH_FLUDS::NLUpwindPsiSP(int nonl_inc_face_counter,
+                                      int face_dof,
+                                      int g,
+                                      int n) const
+{
+  const auto& prelocI_slot_dof =
+    common_data_.nonlocal_inc_face_prelocI_slot_dof[nonl_inc_face_counter];
+  const int prelocI = prelocI_slot_dof.first;
+  if (prelocI < 0) return nullptr;
+
+  int nonlocal_psi_Gn_blockstride =
+    common_data_.prelocI_face_dof_count[prelocI];
+  int slot = prelocI_slot_dof.second.first;
+  int mapped_dof = prelocI_slot_dof.second.second[face_dof];
+
+  int index = nonlocal_psi_Gn_blockstride * num_groups_ * n +
+              slot * num_groups_ + mapped_dof * num_groups_ + g;
+
+  return &prelocI_outgoing_psi_sp_[prelocI][index];
+}
+
+// ###################################################################
+/**Sets whether the non-delayed non-local psi is stored in single
+ * precision. Must not be called whilst sweeping.*/
+void AAH_FLUDS::SetSinglePrecisionNonLocalPsi(bool flag)
+{
+  single_precision_nonlocal_psi_ = flag;
+  ClearLocalAndReceivePsi();
+  ClearSendPsi();
+}
+
 size_t AAH_FLUDS::GetPrelocIFaceDOFCount(int prelocI) const
 {
   return common_data_.prelocI_face_dof_count[prelocI];
@@ -219,9 +306,16 @@ void AAH_FLUDS::ClearLocalAndReceivePsi()
 
   empty_vector = std::vector<std::vector<double>>(0);
   prelocI_outgoing_psi_.swap(empty_vector);
+
+  auto empty_vector_sp = std::vector<std::vector<float>>(0);
+  prelocI_outgoing_psi_sp_.swap(empty_vector_sp);
 }
 
-void AAH_FLUDS::ClearSendPsi() { deplocI_outgoing_psi_.clear(); }
+void AAH_FLUDS::ClearSendPsi()
+{
+  deplocI_outgoing_psi_.clear();
+  deplocI_outgoing_psi_sp_.clear();
+}
 
 void AAH_FLUDS::AllocateInternalLocalPsi(size_t num_grps, size_t num_angles)
 {
@@ -240,6 +334,16 @@ void AAH_FLUDS::AllocateOutgoingPsi(size_t num_grps,
                                     size_t num_angles,
                                     size_t num_loc_sucs)
 {
+  if (single_precision_nonlocal_psi_)
+  {
+    deplocI_outgoing_psi_sp_.resize(num_loc_sucs, std::vector<float>());
+    for (size_t deplocI = 0; deplocI < num_loc_sucs; deplocI++)
+      deplocI_outgoing_psi_sp_[deplocI].resize(
+        common_data_.deplocI_face_dof_count[deplocI] * num_grps * num_angles,
+        0.0f);
+    return;
+  }
+
   deplocI_outgoing_psi_.resize(num_loc_sucs, std::vector<double>());
   for (size_t deplocI = 0; deplocI < num_loc_sucs; deplocI++)
   {
@@ -266,6 +370,16 @@ void AAH_FLUDS::AllocatePrelocIOutgoingPsi(size_t num_grps,
                                            size_t num_angles,
                                            size_t num_loc_deps)
 {
+  if (single_precision_nonlocal_psi_)
+  {
+    prelocI_outgoing_psi_sp_.resize(num_loc_deps, std::vector<float>());
+    for (size_t prelocI = 0; prelocI < num_loc_deps; prelocI++)
+      prelocI_outgoing_psi_sp_[prelocI].resize(
+        common_data_.prelocI_face_dof_count[prelocI] * num_grps * num_angles,
+        0.0f);
+    return;
+  }
+
   prelocI_outgoing_psi_.resize(num_loc_deps, std::vector<double>());
   for (size_t prelocI = 0; prelocI < num_loc_deps; prelocI++)
   {
@@ -296,6 +410,31 @@ void AAH_FLUDS::AllocateDelayedPrelocIOutgoingPsi(size_t num_grps,
   }
 }
 
+size_t AAH_FLUDS::GetMemoryUsage() const
+{
+  size_t num_local_values = 0;
+  for (size_t fc = 0; fc < common_data_.num_face_categories; ++fc)
+    num_local_values += common_data_.local_psi_stride[fc] *
+                        common_data_.local_psi_max_elements[fc];
+
+  size_t num_nonlocal_values = 0;
+  for (const int count : common_data_.deplocI_face_dof_count)
+    num_nonlocal_values += count;
+  for (const int count : common_data_.prelocI_face_dof_count)
+    num_nonlocal_values += count;
+
+  const size_t nonlocal_value_size =
+    single_precision_nonlocal_psi_ ? sizeof(float) : sizeof(double);
+
+  return num_groups_and_angles_ *
+           (num_local_values * sizeof(double) +
+            num_nonlocal_values * nonlocal_value_size) +
+         chi::VectorMemoryUsage(delayed_local_psi_) +
+         chi::VectorMemoryUsage(delayed_local_psi_old_) +
+         chi::VectorMemoryUsage(delayed_prelocI_outgoing_psi_) +
+         chi::VectorMemoryUsage(delayed_prelocI_outgoing_psi_old_);
+}
+
 std::vector<double>& AAH_FLUDS::DelayedLocalPsi() { return delayed_local_psi_; }
 
 std::vector<double>& AAH_FLUDS::DelayedLocalPsiOld()
@@ -322,4 +461,14 @@ std::vector<std::vector<double>>& AAH_FLUDS::DelayedPrelocIOutgoingPsiOld()
   return delayed_prelocI_outgoing_psi_old_;
 }
 
+std::vector<std::vector<float>>& AAH_FLUDS::DeplocIOutgoingPsiSP()
+{
+  return deplocI_outgoing_psi_sp_;
+}
+
+std::vector<std::vector<float>>& AAH_FLUDS::PrelocIOutgoingPsiSP()
+{
+  return prelocI_outgoing_psi_sp_;
+}
+
 } // namespace chi_mesh::sweep_management
\ No newline at end of file
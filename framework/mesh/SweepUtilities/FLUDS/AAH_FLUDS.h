@@ -36,6 +36,15 @@ private:
   std::vector<std::vector<double>> delayed_prelocI_outgoing_psi_;
   std::vector<std::vector<double>> delayed_prelocI_outgoing_psi_old_;
 
+  bool single_precision_nonlocal_psi_ = false;
+  std::vector<std::vector<float>> deplocI_outgoing_psi_sp_;
+  std::vector<std::vector<float>> prelocI_outgoing_psi_sp_;
+
+  size_t NLOutgoingIndex(int outb_face_counter,
+                         int face_dof,
+                         int n,
+                         int& deplocI) const;
+
 public:
   double* OutgoingPsi(int cell_so_index,
                       int outb_face_counter,
@@ -52,10 +61,28 @@ public:
   double*
   NLUpwindPsi(int nonl_inc_face_counter, int face_dof, int g, int n);
 
+  /**Sets whether the outgoing psi of the successors and the incoming psi of
+   * the (non-delayed) predecessors are stored in single precision. The psi
+   * of these locations is then accessed with NLOutgoingPsiSP and
+   * NLUpwindPsiSP, and communicated without conversion.*/
+  void SetSinglePrecisionNonLocalPsi(bool flag);
+  bool SinglePrecisionNonLocalPsi() const
+  {
+    return single_precision_nonlocal_psi_;
+  }
+
+  float* NLOutgoingPsiSP(int outb_face_counter, int face_dof, int n);
+  const float*
+  NLUpwindPsiSP(int nonl_inc_face_counter, int face_dof, int g, int n) const;
+
   size_t GetPrelocIFaceDOFCount(int prelocI) const;
   size_t GetDelayedPrelocIFaceDOFCount(int prelocI) const;
   size_t GetDeplocIFaceDOFCount(int deplocI) const;
 
+  /**The local and outgoing buffers are only allocated during sweeps, hence
+   * their sizes are computed from the common data.*/
+  size_t GetMemoryUsage() const override;
+
   void ClearLocalAndReceivePsi() override;
   void ClearSendPsi() override;
   void AllocateInternalLocalPsi(size_t num_grps, size_t num_angles) override;
@@ -73,6 +100,7 @@ public:
 
   std::vector<double>& DelayedLocalPsi() override;
   std::vector<double>& DelayedLocalPsiOld() override;
+  void CopyDelayedLocalPsiToOld(size_t spls_begin, size_t spls_end);
 
   std::vector<std::vector<double>>& DeplocIOutgoingPsi() override;
 
@@ -80,6 +108,9 @@ public:
 
   std::vector<std::vector<double>>& DelayedPrelocIOutgoingPsi() override;
   std::vector<std::vector<double>>& DelayedPrelocIOutgoingPsiOld() override;
+
+  std::vector<std::vector<float>>& DeplocIOutgoingPsiSP();
+  std::vector<std::vector<float>>& PrelocIOutgoingPsiSP();
 };
 
 } // namespace chi_mesh::sweep_management
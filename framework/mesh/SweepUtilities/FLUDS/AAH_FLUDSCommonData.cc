@@ -1,5 +1,12 @@
 #include "AAH_FLUDSCommonData.h"
 
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
 namespace chi_mesh::sweep_management
 {
 
@@ -10,7 +17,53 @@ AAH_FLUDSCommonData::AAH_FLUDSCommonData(
   : FLUDSCommonData(spds, grid_nodal_mappings)
 {
   this->InitializeAlphaElements(spds, grid_face_histogram);
+  Chi::log.Log(chi::ChiLog::LOG_LVL::LOG_0VERBOSE_2)
+    << "Done with Local Incidence mapping.";
+  Chi::mpi.Barrier();
+
   this->InitializeBetaElements(spds);
 }
 
-} // namespace chi_mesh::sweep_management
\ No newline at end of file
+// ###################################################################
+/**Builds the common data of multiple sweep orderings. The alpha elements
+ * and the non-local incident mappings, which do not communicate, are built
+ * concurrently by the available threads. The cell views are exchanged one
+ * ordering at a time.*/
+std::vector<std::shared_ptr<AAH_FLUDSCommonData>>
+AAH_FLUDSCommonData::MakeCommonData(
+  const std::vector<CellFaceNodalMapping>& grid_nodal_mappings,
+  const std::vector<std::shared_ptr<SPDS>>& spds_list,
+  const chi_mesh::GridFaceHistogram& grid_face_histogram)
+{
+  const int num_orderings = static_cast<int>(spds_list.size());
+
+  std::vector<std::shared_ptr<AAH_FLUDSCommonData>> common_data_list;
+  common_data_list.reserve(num_orderings);
+  for (const auto& spds : spds_list)
+    common_data_list.emplace_back(
+      new AAH_FLUDSCommonData(grid_nodal_mappings, *spds));
+
+  //The face neighbor table is read by all the threads
+  if (not spds_list.empty())
+    spds_list.front()->Grid().PrepareFaceNeighborTable();
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int so = 0; so < num_orderings; ++so)
+    common_data_list[so]->InitializeAlphaElements(*spds_list[so],
+                                                  grid_face_histogram);
+
+  Chi::log.Log(chi::ChiLog::LOG_LVL::LOG_0VERBOSE_2)
+    << "Done with Local Incidence mapping.";
+  Chi::mpi.Barrier();
+
+  for (int so = 0; so < num_orderings; ++so)
+    common_data_list[so]->ExchangeBetaCellViews(*spds_list[so]);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int so = 0; so < num_orderings; ++so)
+    common_data_list[so]->MapNonLocalIncidentFaces(*spds_list[so]);
+
+  return common_data_list;
+}
+
+} // namespace chi_mesh::sweep_management
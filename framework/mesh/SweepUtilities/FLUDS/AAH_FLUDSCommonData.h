@@ -4,7 +4,9 @@
 #include "FLUDSCommonData.h"
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <set>
+#include <vector>
 
 namespace chi_mesh
 {
@@ -16,39 +18,79 @@ class CellFace;
 namespace chi_mesh::sweep_management
 {
 
-// face_slot index, vertex ids
-typedef std::pair<int, std::vector<uint64_t>> CompactFaceView;
-
-// cell_global_id, faces
-typedef std::pair<int, std::vector<CompactFaceView>> CompactCellView;
+// ###################################################################
+/**Flat views of the faces a location shares with a neighboring location,
+ * grouped per cell. Per cell, the global id and its faces, and per face,
+ * the face slot, i.e., the location of the face data in the psi vector,
+ * and the vertex ids, which are used for the dof mapping. The faces of
+ * cell c are [cell_face_offsets[c], cell_face_offsets[c+1]) and the vertex
+ * ids of face f are [face_vertex_offsets[f], face_vertex_offsets[f+1]).*/
+struct CompactCellViews
+{
+  std::vector<int> cell_global_ids;
+  std::vector<uint32_t> cell_face_offsets = {0};
+  std::vector<int> face_slots;
+  std::vector<uint32_t> face_vertex_offsets = {0};
+  std::vector<uint64_t> face_vertex_ids;
 
-class SPDS;
+  size_t NumCells() const { return cell_global_ids.size(); }
 
-class AAH_FLUDSCommonData : public FLUDSCommonData
-{
-public:
-  struct INCOMING_FACE_INFO
+  /**Appends an empty face to the last cell if it has the given global id,
+   * otherwise to a new cell.*/
+  void AddFace(int cell_global_id, int face_slot)
   {
-    int slot_address = 0;
-    short* upwind_dof_mapping = nullptr;
-
-    void Setup(const std::pair<int, std::vector<short>>& input)
+    if (cell_global_ids.empty() or cell_global_ids.back() != cell_global_id)
     {
-      slot_address = input.first;
-      upwind_dof_mapping = new short[input.second.size()];
-      std::copy(input.second.begin(), input.second.end(), upwind_dof_mapping);
+      cell_global_ids.push_back(cell_global_id);
+      cell_face_offsets.push_back(cell_face_offsets.back());
     }
+    ++cell_face_offsets.back();
+    face_slots.push_back(face_slot);
+    face_vertex_offsets.push_back(face_vertex_offsets.back());
+  }
+
+  /**Appends a vertex id to the last face.*/
+  void AddFaceVertex(uint64_t vertex_id)
+  {
+    face_vertex_ids.push_back(vertex_id);
+    ++face_vertex_offsets.back();
+  }
+
+  /**Returns the index of the cell with the given global id, or -1.*/
+  int FindCell(int cell_global_id) const
+  {
+    for (size_t c = 0; c < cell_global_ids.size(); ++c)
+      if (cell_global_ids[c] == cell_global_id) return static_cast<int>(c);
+    return -1;
+  }
+};
+
+class SPDS;
 
-    ~INCOMING_FACE_INFO() { delete[] upwind_dof_mapping; }
-  }; // TODO: Make common
+class AAH_FLUDSCommonData : public FLUDSCommonData
+{
 public:
   explicit AAH_FLUDSCommonData(
     const std::vector<CellFaceNodalMapping>& grid_nodal_mappings,
     const SPDS& spds,
     const chi_mesh::GridFaceHistogram& grid_face_histogram);
 
+  static std::vector<std::shared_ptr<AAH_FLUDSCommonData>>
+  MakeCommonData(const std::vector<CellFaceNodalMapping>& grid_nodal_mappings,
+                 const std::vector<std::shared_ptr<SPDS>>& spds_list,
+                 const chi_mesh::GridFaceHistogram& grid_face_histogram);
+
 protected:
   friend class AAH_FLUDS;
+  /**Only initializes the base, the elements are initialized by
+   * MakeCommonData.*/
+  AAH_FLUDSCommonData(
+    const std::vector<CellFaceNodalMapping>& grid_nodal_mappings,
+    const SPDS& spds)
+    : FLUDSCommonData(spds, grid_nodal_mappings)
+  {
+  }
+
   int largest_face = 0;
   size_t num_face_categories = 0;       // Number of face categories
   std::vector<size_t> local_psi_stride; // Group-angle-faceDOF stride per cat
@@ -71,53 +113,67 @@ protected:
   // face dofs for each dependent location.
   std::vector<int> deplocI_face_dof_count;
 
-  // This is a vector [dependent_location][unordered_cell_index]
-  // that holds an AlphaPair. AlphaPair-first is the cell's global_id
-  // and AlphaPair-second holds a number of BetaPairs. Each BetaPair
-  // comprises BetaPair-first = face_slot_index (the location of this
-  // faces data in the psi vector, and then a vector of vertex indexes
-  // that can be used for dof_mapping.
+  // This is a vector [dependent_location] that holds the compact views of
+  // the cells with faces on the interface with the dependent location.
   // Filled during slot-dynamics.
   // Cleared after beta-pass.
-  std::vector<std::vector<CompactCellView>> deplocI_cell_views;
-
-  // This is a vector [cell_sweep_order_index][outgoing_face_count]
-  // which holds the slot address in the local psi vector where the first
-  // face dof will store its data
-  std::vector<int*> so_cell_outb_face_slot_indices;
-
-  // This is a vector [cell_sweep_order_index][outgoing_face_count]
-  // which holds the face categorization for the face. i.e. the local
-  // psi vector that hold faces of the same category.
-  std::vector<short*> so_cell_outb_face_face_category;
-
-  // This is a vector [cell_sweep_order_index][incoming_face_count]
-  // which holds the face categorization for the face. i.e. the local
-  // psi vector that hold faces of the same category.
-  std::vector<short*> so_cell_inco_face_face_category;
-
-  // This is a vector [cell_sweep_order_index][incoming_face_count]
-  // that will hold a structure. struct.slot_address holds the slot address
-  // where this face's upwind data is stored. struct.upwind_dof_mapping is
-  // a mapping of each of this face's dofs to the upwinded face's dofs
-private:
-  std::vector<INCOMING_FACE_INFO*> so_cell_inco_face_dof_indices;
+  std::vector<CompactCellViews> deplocI_cell_views;
+
+  // The per cell tables below are stored in compressed rows indexed by the
+  // cell sweep order index. The outgoing faces of the cell at sweep order
+  // index so are entries [so_cell_outb_face_offsets[so],
+  // so_cell_outb_face_offsets[so+1]), in face order, and likewise for the
+  // local incoming faces.
+  std::vector<uint32_t> so_cell_outb_face_offsets;
+  std::vector<uint32_t> so_cell_inco_face_offsets;
+
+  // This is a vector [outgoing_face_entry] which holds the slot address in
+  // the local psi vector where the first face dof will store its data
+  std::vector<uint32_t> outb_face_slot_indices;
+
+  // This is a vector [outgoing_face_entry] which holds the face
+  // categorization for the face. i.e. the local psi vector that hold faces
+  // of the same category. Negative for the delayed local psi vector.
+  std::vector<int16_t> outb_face_face_category;
+
+  // This is a vector [incoming_face_entry] which holds the face
+  // categorization for the face. i.e. the local psi vector that hold faces
+  // of the same category. Negative for the delayed local psi vector.
+  std::vector<int16_t> inco_face_face_category;
+
+  // This is a vector [incoming_face_entry] which holds the slot address
+  // where the face's upwind data is stored. The mapping of each of the
+  // face's dofs to the upwinded face's dofs are entries
+  // [inco_face_dof_offsets[i], inco_face_dof_offsets[i+1]) of
+  // inco_face_upwind_dofs.
+  std::vector<uint32_t> inco_face_slot_addresses;
+  std::vector<uint32_t> inco_face_dof_offsets;
+  std::vector<uint16_t> inco_face_upwind_dofs;
+
+  /**Index of the outgoing face entry of a cell's outgoing face.*/
+  size_t OutbFaceEntry(size_t cell_so_index, size_t outb_face_counter) const
+  {
+    return so_cell_outb_face_offsets[cell_so_index] + outb_face_counter;
+  }
+  /**Index of the incoming face entry of a cell's local incoming face.*/
+  size_t IncoFaceEntry(size_t cell_so_index, size_t inc_face_counter) const
+  {
+    return so_cell_inco_face_offsets[cell_so_index] + inc_face_counter;
+  }
 
+private:
   // This is a vector [non_local_outgoing_face_count]
   // that maps a face to a dependent location and associated slot index
   std::vector<std::pair<int, int>> nonlocal_outb_face_deplocI_slot;
 
 private:
-  // This is a vector [predecessor_location][unordered_cell_index]
-  // that holds an AlphaPair. AlphaPair-first is the cell's global_id
-  // and AlphaPair-second holds a number of BetaPairs. Each BetaPair
-  // comprises BetaPair-first = face_slot_index (the location of this
-  // faces data in the psi vector, and then a vector of vertex indexes
-  // that can be used for dof_mapping.
+  // This is a vector [predecessor_location] that holds the compact views
+  // of the cells with faces on the interface with the predecessor
+  // location.
   // Filled in beta-pass
   // Cleared after beta-pass.
-  std::vector<std::vector<CompactCellView>> prelocI_cell_views;
-  std::vector<std::vector<CompactCellView>> delayed_prelocI_cell_views;
+  std::vector<CompactCellViews> prelocI_cell_views;
+  std::vector<CompactCellViews> delayed_prelocI_cell_views;
 
   // This is a small vector [prelocI] that holds the number of
   // face dofs for each predecessor location.
@@ -144,6 +200,18 @@ private:
                     std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
                     std::vector<std::pair<int, short>>& delayed_lock_box,
                     std::set<int>& location_boundary_dependency_set);
+  void ReleaseIncomingSlots(
+    const chi_mesh::Cell& cell,
+    const SPDS& spds,
+    const GridFaceHistogram& grid_face_histogram,
+    std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
+    std::set<int>& location_boundary_dependency_set);
+  void AcquireOutgoingSlots(
+    const chi_mesh::Cell& cell,
+    const SPDS& spds,
+    const GridFaceHistogram& grid_face_histogram,
+    std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
+    std::vector<std::pair<int, short>>& delayed_lock_box);
   void AddFaceViewToDepLocI(int deplocI,
                             int cell_g_index,
                             int face_slot,
@@ -154,13 +222,15 @@ private:
                             std::vector<int>& local_so_cell_mapping);
   // 01
   void InitializeBetaElements(const SPDS& spds, int tag_index = 0);
+  void ExchangeBetaCellViews(const SPDS& spds, int tag_index = 0);
+  void MapNonLocalIncidentFaces(const SPDS& spds);
   // 01a
-  static void SerializeCellInfo(std::vector<CompactCellView>& cell_views,
-                         std::vector<int>& face_indices,
-                         int num_face_dofs);
-  static void DeSerializeCellInfo(std::vector<CompactCellView>& cell_views,
-                           std::vector<int>* face_indices,
-                           int& num_face_dofs);
+  static void SerializeCellInfo(const CompactCellViews& cell_views,
+                                std::vector<int>& face_indices,
+                                int num_face_dofs);
+  static void DeSerializeCellInfo(CompactCellViews& cell_views,
+                                  const std::vector<int>& face_indices,
+                                  int& num_face_dofs);
   // 01b
   void NonLocalIncidentMapping(const chi_mesh::Cell& cell, const SPDS& spds);
 };
@@ -12,6 +12,9 @@ typedef std::vector<std::pair<int,short>> LockBox;
 namespace chi_mesh::sweep_management
 {
 
+/**Performs the slot dynamics and the local incident mapping. This does not
+ * communicate such that it can be executed concurrently for different
+ * sweep orderings.*/
 void AAH_FLUDSCommonData::InitializeAlphaElements(
   const SPDS& spds, const GridFaceHistogram& grid_face_histogram)
 {
@@ -47,28 +50,54 @@ void AAH_FLUDSCommonData::InitializeAlphaElements(
   std::set<int> location_boundary_dependency_set;
 
   // csoi = cell sweep order index
-  so_cell_inco_face_face_category.reserve(spls.item_id.size());
-  so_cell_outb_face_slot_indices.reserve(spls.item_id.size());
-  so_cell_outb_face_face_category.reserve(spls.item_id.size());
-  for (int csoi = 0; csoi < spls.item_id.size(); csoi++)
+  so_cell_inco_face_offsets.assign(1, 0);
+  so_cell_outb_face_offsets.assign(1, 0);
+  so_cell_inco_face_offsets.reserve(spls.item_id.size() + 1);
+  so_cell_outb_face_offsets.reserve(spls.item_id.size() + 1);
+  const auto& level_offsets = spds.GetSPLSLevelOffsets();
+  if (level_offsets.empty())
   {
-    int cell_local_id = spls.item_id[csoi];
-    const auto& cell = grid.local_cells[cell_local_id];
+    for (int csoi = 0; csoi < spls.item_id.size(); csoi++)
+    {
+      int cell_local_id = spls.item_id[csoi];
+      const auto& cell = grid.local_cells[cell_local_id];
 
-    local_so_cell_mapping[cell.local_id_] = csoi; // Set mapping
+      local_so_cell_mapping[cell.local_id_] = csoi; // Set mapping
 
-    SlotDynamics(cell,
-                 spds,
-                 grid_face_histogram,
-                 lock_boxes,
-                 delayed_lock_box,
-                 location_boundary_dependency_set);
-
-  } // for csoi
+      SlotDynamics(cell,
+                   spds,
+                   grid_face_histogram,
+                   lock_boxes,
+                   delayed_lock_box,
+                   location_boundary_dependency_set);
 
-  Chi::log.Log(chi::ChiLog::LOG_LVL::LOG_0VERBOSE_2)
-    << "Done with Slot Dynamics.";
-  Chi::mpi.Barrier();
+    } // for csoi
+  }
+  //================================================== Levelized ordering
+  // The cells of a level may be swept concurrently, hence the slots they
+  // write must not be slots released by the level, i.e., all the outgoing
+  // slots of a level are acquired before its incoming slots are released.
+  else
+  {
+    for (size_t level = 0; level + 1 < level_offsets.size(); ++level)
+    {
+      const int level_begin = static_cast<int>(level_offsets[level]);
+      const int level_end = static_cast<int>(level_offsets[level + 1]);
+
+      for (int csoi = level_begin; csoi < level_end; csoi++)
+      {
+        const auto& cell = grid.local_cells[spls.item_id[csoi]];
+        local_so_cell_mapping[cell.local_id_] = csoi; // Set mapping
+
+        AcquireOutgoingSlots(cell, spds, grid_face_histogram,
+                             lock_boxes, delayed_lock_box);
+      }
+      for (int csoi = level_begin; csoi < level_end; csoi++)
+        ReleaseIncomingSlots(grid.local_cells[spls.item_id[csoi]],
+                             spds, grid_face_histogram, lock_boxes,
+                             location_boundary_dependency_set);
+    } // for level
+  }
 
   //================================================== Populate boundary
   //                                                   dependencies
@@ -78,7 +107,9 @@ void AAH_FLUDSCommonData::InitializeAlphaElements(
   //                      PERFORM INCIDENT MAPPING
   //================================================== Loop over cells in
   //                                                   sweep order
-  so_cell_inco_face_dof_indices.reserve(spls.item_id.size());
+  inco_face_slot_addresses.reserve(inco_face_face_category.size());
+  inco_face_dof_offsets.assign(1, 0);
+  inco_face_dof_offsets.reserve(inco_face_face_category.size() + 1);
   for (int csoi = 0; csoi < spls.item_id.size(); csoi++)
   {
     int cell_local_id = spls.item_id[csoi];
@@ -100,18 +131,15 @@ void AAH_FLUDSCommonData::InitializeAlphaElements(
   delayed_local_psi_Gn_block_stride = largest_face * delayed_lock_box.size();
   delayed_local_psi_Gn_block_strideG = delayed_local_psi_Gn_block_stride * /*G=*/1;
 
-  Chi::log.Log(chi::ChiLog::LOG_LVL::LOG_0VERBOSE_2)
-    << "Done with Local Incidence mapping.";
-  Chi::mpi.Barrier();
-
   //================================================== Clean up
-  so_cell_outb_face_slot_indices.shrink_to_fit();
+  outb_face_slot_indices.shrink_to_fit();
+  outb_face_face_category.shrink_to_fit();
+  inco_face_face_category.shrink_to_fit();
+  inco_face_upwind_dofs.shrink_to_fit();
 
   local_so_cell_mapping.clear();
   local_so_cell_mapping.shrink_to_fit();
 
-  so_cell_inco_face_dof_indices.shrink_to_fit();
-
   nonlocal_outb_face_deplocI_slot.shrink_to_fit();
 }
 
@@ -11,6 +11,9 @@ typedef std::vector<std::pair<int,short>> LockBox;
 namespace chi_mesh::sweep_management
 {
 
+//###################################################################
+/**Releases the slots of the incoming faces of a cell, then acquires slots
+ * for its outgoing faces.*/
 void AAH_FLUDSCommonData::SlotDynamics(
   const chi_mesh::Cell& cell,
   const SPDS& spds,
@@ -18,6 +21,22 @@ void AAH_FLUDSCommonData::SlotDynamics(
   std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
   std::vector<std::pair<int, short>>& delayed_lock_box,
   std::set<int>& location_boundary_dependency_set)
+{
+  ReleaseIncomingSlots(cell, spds, grid_face_histogram, lock_boxes,
+                       location_boundary_dependency_set);
+  AcquireOutgoingSlots(cell, spds, grid_face_histogram, lock_boxes,
+                       delayed_lock_box);
+}
+
+//###################################################################
+/**Releases the lock box slots holding the upwind psi of the incoming local
+ * faces of a cell and registers its boundary dependencies.*/
+void AAH_FLUDSCommonData::ReleaseIncomingSlots(
+  const chi_mesh::Cell& cell,
+  const SPDS& spds,
+  const GridFaceHistogram& grid_face_histogram,
+  std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
+  std::set<int>& location_boundary_dependency_set)
 {
   const chi_mesh::MeshContinuum& grid = spds.Grid();
 
@@ -28,24 +47,23 @@ void AAH_FLUDSCommonData::SlotDynamics(
   //=================================================== Loop over faces
   //           INCIDENT                                 but process
   //                                                    only incident faces
-  std::vector<short> inco_face_face_category;
-  inco_face_face_category.reserve(cell.faces_.size());
   for (int f=0; f < cell.faces_.size(); f++)
   {
     const CellFace& face = cell.faces_[f];
     const auto& orientation = spds.CellFaceOrientations()[cell.local_id_][f];
+    const auto& neighbor = grid.GetFaceNeighborIndex(cell, f);
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Incident face
     if (orientation == FaceOrientation::INCOMING)
     {
 
       //$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ LOCAL CELL DEPENDENCE
-      if (face.IsNeighborLocal(grid))
+      if (neighbor.local_id >= 0)
       {
         size_t num_face_dofs = face.vertex_ids_.size();
         size_t face_categ = grid_face_histogram.MapFaceHistogramBins(num_face_dofs);
 
-        inco_face_face_category.push_back(static_cast<short>(face_categ));
+        inco_face_face_category.push_back(static_cast<int16_t>(face_categ));
 
         LockBox& lock_box = lock_boxes[face_categ];
 
@@ -57,7 +75,7 @@ void AAH_FLUDSCommonData::SlotDynamics(
           int a = cyclic_dependency.first;
           int b = cyclic_dependency.second;
           int c = cell.local_id_;
-          int d = face.GetNeighborLocalID(grid);
+          int d = static_cast<int>(neighbor.local_id);
 
           if ((a == c) && (b == d) )
           {
@@ -100,7 +118,7 @@ void AAH_FLUDSCommonData::SlotDynamics(
             << cell.local_id_
             << " face " << f
             << " looking for cell "
-            << face.GetNeighborLocalID(grid)
+            << neighbor.local_id
             << " face " << ass_face
             << " cat: " << face_categ
             << " omg=" << spds.Omega().PrintS()
@@ -131,25 +149,31 @@ void AAH_FLUDSCommonData::SlotDynamics(
 
   }//for f
 
-  auto raw_inco_face_face_category = new short[inco_face_face_category.size()];
-  std::copy(inco_face_face_category.begin(),
-            inco_face_face_category.end(),
-            raw_inco_face_face_category);
+  so_cell_inco_face_offsets.push_back(
+    static_cast<uint32_t>(inco_face_face_category.size()));
+}
 
-  so_cell_inco_face_face_category.push_back(raw_inco_face_face_category);
+//###################################################################
+/**Acquires lock box slots for the outgoing faces of a cell and maps its
+ * non-local outgoing faces.*/
+void AAH_FLUDSCommonData::AcquireOutgoingSlots(
+  const chi_mesh::Cell& cell,
+  const SPDS& spds,
+  const GridFaceHistogram& grid_face_histogram,
+  std::vector<std::vector<std::pair<int, short>>>& lock_boxes,
+  std::vector<std::pair<int, short>>& delayed_lock_box)
+{
+  const chi_mesh::MeshContinuum& grid = spds.Grid();
 
   //=================================================== Loop over faces
   //                OUTGOING                            but process
   //                                                    only outgoing faces
-  std::vector<int>                outb_face_slot_indices;
-  std::vector<short>              outb_face_face_category;
-  outb_face_slot_indices.reserve(cell.faces_.size());
-  outb_face_face_category.reserve(cell.faces_.size());
   for (int f=0; f < cell.faces_.size(); f++)
   {
     const CellFace&  face   = cell.faces_[f];
     int        cell_g_index = cell.global_id_;
     const auto& orientation = spds.CellFaceOrientations()[cell.local_id_][f];
+    const auto& neighbor = grid.GetFaceNeighborIndex(cell, f);
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Outgoing face
     if (orientation == FaceOrientation::OUTGOING)
@@ -157,20 +181,20 @@ void AAH_FLUDSCommonData::SlotDynamics(
       size_t num_face_dofs = face.vertex_ids_.size();
       size_t face_categ = grid_face_histogram.MapFaceHistogramBins(num_face_dofs);
 
-      outb_face_face_category.push_back(static_cast<short>(face_categ));
+      outb_face_face_category.push_back(static_cast<int16_t>(face_categ));
 
       LockBox* temp_lock_box = &lock_boxes[face_categ];
 
       //========================================== Check if part of cyclic
       //                                           dependency
-      if (face.IsNeighborLocal(grid))
+      if (neighbor.local_id >= 0)
       {
         for (auto cyclic_dependency : spds.GetLocalCyclicDependencies())
         {
           int a = cyclic_dependency.first;
           int b = cyclic_dependency.second;
           int c = cell.local_id_;
-          int d = face.GetNeighborLocalID(grid);
+          int d = static_cast<int>(neighbor.local_id);
 
           if ((a == c) && (b == d) )
           {
@@ -201,7 +225,7 @@ void AAH_FLUDSCommonData::SlotDynamics(
       {
         if (lock_box[k].first < 0)
         {
-          outb_face_slot_indices.push_back(k);
+          outb_face_slot_indices.push_back(static_cast<uint32_t>(k));
           lock_box[k].first = cell_g_index;
           lock_box[k].second= static_cast<short>(f);
           slot_found = true;
@@ -214,14 +238,15 @@ void AAH_FLUDSCommonData::SlotDynamics(
       //                                          push a new one
       if (!slot_found)
       {
-        outb_face_slot_indices.push_back(lock_box.size());
+        outb_face_slot_indices.push_back(
+          static_cast<uint32_t>(lock_box.size()));
         lock_box.push_back(std::pair<int,short>(cell_g_index,f));
       }
 
       //========================================== Non-local outgoing
-      if (face.has_neighbor_ and (not face.IsNeighborLocal(grid)))
+      if (neighbor.ghost_index >= 0)
       {
-        int locJ         = face.GetNeighborPartitionID(grid);
+        int locJ         = neighbor.partition_id;
         int deplocI      = spds.MapLocJToDeplocI(locJ);
         int face_slot    = deplocI_face_dof_count[deplocI];
 
@@ -238,20 +263,8 @@ void AAH_FLUDSCommonData::SlotDynamics(
 
   }//for f
 
-  auto raw_outb_face_slot_indices = new int[outb_face_slot_indices.size()];
-  std::copy(outb_face_slot_indices.begin(),
-            outb_face_slot_indices.end(),
-            raw_outb_face_slot_indices);
-
-  so_cell_outb_face_slot_indices.push_back(raw_outb_face_slot_indices);
-
-
-  auto raw_outb_face_face_category = new short[outb_face_face_category.size()];
-  std::copy(outb_face_face_category.begin(),
-            outb_face_face_category.end(),
-            raw_outb_face_face_category);
-
-  so_cell_outb_face_face_category.push_back(raw_outb_face_face_category);
+  so_cell_outb_face_offsets.push_back(
+    static_cast<uint32_t>(outb_face_face_category.size()));
 }
 
 //###################################################################
@@ -262,30 +275,12 @@ void AAH_FLUDSCommonData::
   AddFaceViewToDepLocI(int deplocI, int cell_g_index, int face_slot,
                        const chi_mesh::CellFace& face)
 {
-  //======================================== Check if cell is already there
-  bool cell_already_there = false;
-  for (auto& cell_view : deplocI_cell_views[deplocI])
-  {
-    if (cell_view.first == cell_g_index)
-    {
-      cell_already_there = true;
-      cell_view.second.emplace_back(face_slot, face.vertex_ids_);
-      break;
-    }
-  }
-
-  //======================================== If the cell is not there yet
-  if (!cell_already_there)
-  {
-    CompactCellView new_cell_view;
-    new_cell_view.first = cell_g_index;
-    new_cell_view.second.
-      emplace_back(face_slot, face.vertex_ids_);
-
-    deplocI_cell_views[deplocI].push_back(new_cell_view);
-  }
-
-
+  //======================================== The faces of a cell are added
+  //                                         consecutively
+  auto& cell_views = deplocI_cell_views[deplocI];
+  cell_views.AddFace(cell_g_index, face_slot);
+  for (const uint64_t vid : face.vertex_ids_)
+    cell_views.AddFaceVertex(vid);
 }
 
 } // namespace chi_mesh::sweep_management
\ No newline at end of file
@@ -13,7 +13,6 @@ void AAH_FLUDSCommonData::LocalIncidentMapping(
 {
   const chi_mesh::MeshContinuum& grid = spds.Grid();
   auto& cell_nodal_mapping = grid_nodal_mappings_[cell.local_id_];
-  std::vector<std::pair<int,std::vector<short>>> inco_face_dof_mapping;
 
   short        incoming_face_count=-1;
 
@@ -24,23 +23,21 @@ void AAH_FLUDSCommonData::LocalIncidentMapping(
   {
     const CellFace& face = cell.faces_[f];
     const auto& orienation = spds.CellFaceOrientations()[cell.local_id_][f];
+    const auto& neighbor = grid.GetFaceNeighborIndex(cell, f);
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Incident face
     if (orienation == FaceOrientation::INCOMING)
     {
-      if (face.IsNeighborLocal(grid))
+      if (neighbor.local_id >= 0)
       {
         incoming_face_count++;
         //======================================== Find associated face for
         //                                         dof mapping
         int ass_face = cell_nodal_mapping[f].associated_face_;
 
-        std::pair<int,std::vector<short>> dof_mapping;
-        dof_mapping.second = cell_nodal_mapping[f].face_node_mapping_;
-
         //======================================== Find associated face
         //                                         counter for slot lookup
-        const auto& adj_cell = grid.cells[face.neighbor_id_];
+        const auto& adj_cell = grid.local_cells[neighbor.local_id];
         const int adj_so_index = local_so_cell_mapping[adj_cell.local_id_];
         const auto& face_oris = spds.CellFaceOrientations()[adj_cell.local_id_];
         int ass_f_counter = -1;
@@ -57,20 +54,16 @@ void AAH_FLUDSCommonData::LocalIncidentMapping(
           }
         }
 
-        dof_mapping.first = /*local_psi_stride*G**/
-          so_cell_outb_face_slot_indices[adj_so_index][ass_f_counter];
+        inco_face_slot_addresses.push_back(/*local_psi_stride*G**/
+          outb_face_slot_indices[OutbFaceEntry(adj_so_index, ass_f_counter)]);
 
-        dof_mapping.second.shrink_to_fit();
-        inco_face_dof_mapping.push_back(dof_mapping);
+        for (const short upwind_dof : cell_nodal_mapping[f].face_node_mapping_)
+          inco_face_upwind_dofs.push_back(static_cast<uint16_t>(upwind_dof));
+        inco_face_dof_offsets.push_back(
+          static_cast<uint32_t>(inco_face_upwind_dofs.size()));
       }//if local
     }//if incident
   }//for incindent f
-
-  auto inco_face_info_array = new INCOMING_FACE_INFO[inco_face_dof_mapping.size()];
-  for (int i=0; i<inco_face_dof_mapping.size(); ++i)
-    inco_face_info_array[i].Setup(inco_face_dof_mapping[i]);
-
-  so_cell_inco_face_dof_indices.push_back(inco_face_info_array);
 }
 
 } // namespace chi_mesh::sweep_management
\ No newline at end of file
@@ -13,9 +13,16 @@ namespace chi_mesh::sweep_management
 void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
                                                  int tag_index/*=0*/)
 {
-  const chi_mesh::MeshContinuum& grid = spds.Grid();
-  const chi_mesh::sweep_management::SPLS& spls = spds.GetSPLS();
+  ExchangeBetaCellViews(spds, tag_index);
+  MapNonLocalIncidentFaces(spds);
+}
 
+// ###################################################################
+/**Exchanges the compact cell views of the partition interfaces with the
+ * predecessor and successor locations.*/
+void AAH_FLUDSCommonData::ExchangeBetaCellViews(const SPDS& spds,
+                                                int tag_index/*=0*/)
+{
   //$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$
   // The first two major steps here are: Send delayed successor information
   // and Receive delayed predecessor information. The send portion is done
@@ -41,10 +48,9 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
                 locJ);
     if ((delayed_successor == delayed_location_successors.end())) continue;
 
-    std::vector<CompactCellView> cell_views = deplocI_cell_views[deplocI];
-
-    SerializeCellInfo(
-      cell_views, multi_face_indices[deplocI], deplocI_face_dof_count[deplocI]);
+    SerializeCellInfo(deplocI_cell_views[deplocI],
+                      multi_face_indices[deplocI],
+                      deplocI_face_dof_count[deplocI]);
 
     MPI_Isend(multi_face_indices[deplocI].data(),
               static_cast<int>(multi_face_indices[deplocI].size()),
@@ -56,16 +62,14 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
 
     // TODO: Watch eager limits on sent data
 
-    deplocI_cell_views[deplocI].clear();
-    deplocI_cell_views[deplocI].shrink_to_fit();
+    deplocI_cell_views[deplocI] = CompactCellViews();
   }
 
   //=============================================== Receive delayed predecessor
   //                                                information
   const auto& delayed_location_dependencies =
     spds.GetDelayedLocationDependencies();
-  delayed_prelocI_cell_views.resize(delayed_location_dependencies.size(),
-                                    std::vector<CompactCellView>());
+  delayed_prelocI_cell_views.resize(delayed_location_dependencies.size());
   delayed_prelocI_face_dof_count.resize(
     delayed_location_dependencies.size(), 0);
   for (int prelocI = 0; prelocI < delayed_location_dependencies.size();
@@ -91,7 +95,7 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
              MPI_STATUS_IGNORE);
 
     DeSerializeCellInfo(delayed_prelocI_cell_views[prelocI],
-                        &face_indices,
+                        face_indices,
                         delayed_prelocI_face_dof_count[prelocI]);
   }
 
@@ -104,8 +108,7 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
   //=============================================== Receive predecessor
   //                                                information
   const auto& location_dependencies = spds.GetLocationDependencies();
-  prelocI_cell_views.resize(location_dependencies.size(),
-                            std::vector<CompactCellView>());
+  prelocI_cell_views.resize(location_dependencies.size());
   prelocI_face_dof_count.resize(location_dependencies.size(), 0);
   for (int prelocI = 0; prelocI < location_dependencies.size(); prelocI++)
   {
@@ -129,7 +132,7 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
              MPI_STATUS_IGNORE);
 
     DeSerializeCellInfo(prelocI_cell_views[prelocI],
-                        &face_indices,
+                        face_indices,
                         prelocI_face_dof_count[prelocI]);
   }
 
@@ -143,10 +146,9 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
                                        locJ);
     if ((delayed_successor != delayed_location_successors.end())) continue;
 
-    std::vector<CompactCellView> cell_views = deplocI_cell_views[deplocI];
-
-    SerializeCellInfo(
-      cell_views, multi_face_indices[deplocI], deplocI_face_dof_count[deplocI]);
+    SerializeCellInfo(deplocI_cell_views[deplocI],
+                      multi_face_indices[deplocI],
+                      deplocI_face_dof_count[deplocI]);
 
     MPI_Isend(multi_face_indices[deplocI].data(),
               static_cast<int>(multi_face_indices[deplocI].size()),
@@ -158,8 +160,7 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
 
     // TODO: Watch eager limits on sent data
 
-    deplocI_cell_views[deplocI].clear();
-    deplocI_cell_views[deplocI].shrink_to_fit();
+    deplocI_cell_views[deplocI] = CompactCellViews();
   }
 
   //================================================== Verify sends completed
@@ -167,6 +168,17 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
     MPI_Wait(&send_requests[deplocI], MPI_STATUS_IGNORE);
   multi_face_indices.clear();
   multi_face_indices.shrink_to_fit();
+}
+
+// ###################################################################
+/**Performs the non-local face mappings of all the cells, which requires
+ * the exchanged compact cell views, and then clears the views. This does
+ * not communicate such that it can be executed concurrently for different
+ * sweep orderings.*/
+void AAH_FLUDSCommonData::MapNonLocalIncidentFaces(const SPDS& spds)
+{
+  const chi_mesh::MeshContinuum& grid = spds.Grid();
+  const chi_mesh::sweep_management::SPLS& spls = spds.GetSPLS();
 
   //$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$
   // In the next process we loop over cells in the sweep order and perform
@@ -182,24 +194,10 @@ void AAH_FLUDSCommonData::InitializeBetaElements(const SPDS& spds,
     NonLocalIncidentMapping(cell, spds);
   } // for csoi
 
-  deplocI_cell_views.clear();
-  deplocI_cell_views.shrink_to_fit();
-
-  prelocI_cell_views.clear();
-  prelocI_cell_views.shrink_to_fit();
-
-  delayed_prelocI_cell_views.clear();
-  delayed_prelocI_cell_views.shrink_to_fit();
-
   //================================================== Clear unneccesary data
-  auto empty_vector = std::vector<std::vector<CompactCellView>>(0);
-  deplocI_cell_views.swap(empty_vector);
-
-  empty_vector = std::vector<std::vector<CompactCellView>>(0);
-  prelocI_cell_views.swap(empty_vector);
-
-  empty_vector = std::vector<std::vector<CompactCellView>>(0);
-  delayed_prelocI_cell_views.swap(empty_vector);
+  std::vector<CompactCellViews>().swap(deplocI_cell_views);
+  std::vector<CompactCellViews>().swap(prelocI_cell_views);
+  std::vector<CompactCellViews>().swap(delayed_prelocI_cell_views);
 }
 
 } // namespace chi_mesh::sweep_management
\ No newline at end of file
@@ -8,11 +8,11 @@ namespace chi_mesh::sweep_management
  * serializes it for MPI transmission. This is easy since all
  * the values are integers.*/
 void AAH_FLUDSCommonData::SerializeCellInfo(
-  std::vector<CompactCellView>& cell_views,
+  const CompactCellViews& cell_views,
   std::vector<int>& face_indices,
   int num_face_dofs)
 {
-  const size_t num_cells = cell_views.size();
+  const size_t num_cells = cell_views.NumCells();
 
   //======================== First entry is number of face dofs
   face_indices.push_back(num_face_dofs);
@@ -29,22 +29,18 @@ void AAH_FLUDSCommonData::SerializeCellInfo(
   // of the face
   for (size_t c = 0; c < num_cells; c++)
   {
-    int glob_index = -cell_views[c].first - 1;
+    int glob_index = -cell_views.cell_global_ids[c] - 1;
 
-    std::vector<CompactFaceView>& cell_face_views = cell_views[c].second;
-
-    size_t num_faces = cell_face_views.size();
-    for (size_t f = 0; f < num_faces; f++)
+    for (size_t f = cell_views.cell_face_offsets[c];
+         f < cell_views.cell_face_offsets[c + 1]; f++)
     {
       face_indices.push_back(glob_index);
-      face_indices.push_back(cell_face_views[f].first);
-      std::vector<uint64_t>& face_vertices = cell_face_views[f].second;
+      face_indices.push_back(cell_views.face_slots[f]);
 
-      size_t num_verts = face_vertices.size();
-      for (int fi = 0; fi < num_verts; fi++)
-      {
-        face_indices.push_back(static_cast<int>(face_vertices[fi]));
-      }
+      for (size_t v = cell_views.face_vertex_offsets[f];
+           v < cell_views.face_vertex_offsets[f + 1]; v++)
+        face_indices.push_back(
+          static_cast<int>(cell_views.face_vertex_ids[v]));
     }
   }
 }
@@ -52,57 +48,30 @@ void AAH_FLUDSCommonData::SerializeCellInfo(
 // ###################################################################
 /**Deserializes face indices.*/
 void AAH_FLUDSCommonData::DeSerializeCellInfo(
-  std::vector<CompactCellView>& cell_views,
-  std::vector<int>* face_indices,
+  CompactCellViews& cell_views,
+  const std::vector<int>& face_indices,
   int& num_face_dofs)
 {
-  num_face_dofs = (*face_indices)[0];
-  int num_cells = (*face_indices)[1];
+  num_face_dofs = face_indices[0];
+  const int num_cells = face_indices[1];
 
-  cell_views.resize(num_cells);
+  cell_views = CompactCellViews();
+  cell_views.cell_global_ids.reserve(num_cells);
+  cell_views.cell_face_offsets.reserve(num_cells + 1);
 
-  int k = 2;
-  int last_cell = -1;
-  int c = -1; // cell counter
-  int f = -1;
-  int v = -1;
-  while (k < face_indices->size())
+  size_t k = 2;
+  while (k < face_indices.size())
   {
-    int entry = (*face_indices)[k];
+    const int entry = face_indices[k];
     //================================= Cell/Face indicator
     if (entry < 0)
     {
-      if (-entry != last_cell)
-      {
-        cell_views.emplace_back();
-        c++;
-        cell_views[c].first = -entry - 1;
-
-        cell_views[c].second.emplace_back();
-        f = 0;
-
-        v = 0;
-        last_cell = -entry;
-
-        cell_views[c].second[f].first = (*face_indices)[k + 1];
-        k++;
-      }
-      else
-      {
-        cell_views[c].second.emplace_back();
-        f++;
-        v = 0;
-
-        cell_views[c].second[f].first = (*face_indices)[k + 1];
-        k++;
-      }
+      cell_views.AddFace(-entry - 1, face_indices[k + 1]);
+      k++;
     }
     //================================= Face vertex
     else
-    {
-      cell_views[c].second[f].second.push_back(entry);
-      v++;
-    }
+      cell_views.AddFaceVertex(entry);
     k++;
   } // while k
 }
@@ -5,6 +5,9 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "utils/chi_arena.h"
+
+#include <algorithm>
 
 namespace chi_mesh::sweep_management
 {
@@ -21,29 +24,24 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
   {
     const CellFace&  face = cell.faces_[f];
     const auto& orientation = spds.CellFaceOrientations()[cell.local_id_][f];
+    const auto& neighbor = grid.GetFaceNeighborIndex(cell, f);
 
     //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Incident face
     if (orientation == FaceOrientation::INCOMING)
     {
-      if ((face.has_neighbor_) and (!face.IsNeighborLocal(grid)) )
+      if (neighbor.ghost_index >= 0)
       {
         //============================== Find prelocI
-        int locJ = face.GetNeighborPartitionID(grid);
+        int locJ = neighbor.partition_id;
         int prelocI = spds.MapLocJToPrelocI(locJ);
 
         //###########################################################
         if (prelocI >= 0)
         {
           //============================== Find the cell in prelocI cell views
-          int ass_cell = -1;
-          for (int c=0; c<prelocI_cell_views[prelocI].size(); c++)
-          {
-            if (prelocI_cell_views[prelocI][c].first == face.neighbor_id_)
-            {
-              ass_cell = c;
-              break;
-            }
-          }
+          const auto& cell_views = prelocI_cell_views[prelocI];
+          const int ass_cell =
+            cell_views.FindCell(static_cast<int>(face.neighbor_id_));
           if (ass_cell<0)
           {
             Chi::log.LogAll()
@@ -55,22 +53,30 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
           }
 
           //============================== Find associated face
-          std::set<int> cfvids(face.vertex_ids_.begin(),
-                               face.vertex_ids_.end());
-          CompactCellView* adj_cell_view =
-            &prelocI_cell_views[prelocI][ass_cell];
-          int ass_face = -1, af = -1;
-          for (auto& adj_face : adj_cell_view->second)
+          // The vertex ids are compared as sorted sets, in a stack arena
+          auto SortUnique = [](std::pmr::vector<uint64_t>& vids)
           {
-            ++af;
-            bool face_matches = true;
-
-            std::set<int> afvids(adj_face.second.begin(),
-                                 adj_face.second.end());
+            std::sort(vids.begin(), vids.end());
+            vids.erase(std::unique(vids.begin(), vids.end()), vids.end());
+          };
+          chi::ScratchArena<> scratch;
+          std::pmr::vector<uint64_t> cfvids(face.vertex_ids_.begin(),
+                                            face.vertex_ids_.end(),
+                                            scratch.Resource());
+          SortUnique(cfvids);
+          std::pmr::vector<uint64_t> afvids(scratch.Resource());
 
-            if (cfvids != afvids) face_matches = false;
+          int ass_face = -1;
+          for (size_t af = cell_views.cell_face_offsets[ass_cell];
+               af < cell_views.cell_face_offsets[ass_cell + 1]; ++af)
+          {
+            afvids.assign(cell_views.face_vertex_ids.begin() +
+                            cell_views.face_vertex_offsets[af],
+                          cell_views.face_vertex_ids.begin() +
+                            cell_views.face_vertex_offsets[af + 1]);
+            SortUnique(afvids);
 
-            if (face_matches){ass_face = af; break;}
+            if (cfvids == afvids){ass_face = static_cast<int>(af); break;}
           }
           if (ass_face<0)
           {
@@ -81,16 +87,19 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
 
           //============================== Map dofs
           std::pair<int,std::vector<int>> dof_mapping;
-          dof_mapping.first = adj_cell_view->second[ass_face].first;
-          std::vector<uint64_t>* ass_face_verts =
-            &adj_cell_view->second[ass_face].second;
+          dof_mapping.first = cell_views.face_slots[ass_face];
+          const size_t ass_face_begin =
+            cell_views.face_vertex_offsets[ass_face];
+          const uint64_t* ass_face_verts =
+            &cell_views.face_vertex_ids[ass_face_begin];
+          const int num_ass_face_verts = static_cast<int>(
+            cell_views.face_vertex_offsets[ass_face + 1] - ass_face_begin);
           for (int fv=0; fv < face.vertex_ids_.size(); fv++)
           {
             bool match_found = false;
-            for (int afv=0; afv<ass_face_verts->size(); afv++)
+            for (int afv=0; afv<num_ass_face_verts; afv++)
             {
-              if (face.vertex_ids_[fv] ==
-                  ass_face_verts->operator[](afv))
+              if (face.vertex_ids_[fv] == ass_face_verts[afv])
               {
                 match_found = true;
                 dof_mapping.second.push_back(afv);
@@ -123,15 +132,9 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
         {
           int delayed_preLocI = abs(prelocI)-1;
           //============================== Find the cell in prelocI cell views
-          int ass_cell = -1;
-          for (int c=0; c<delayed_prelocI_cell_views[delayed_preLocI].size(); c++)
-          {
-            if (delayed_prelocI_cell_views[delayed_preLocI][c].first == face.neighbor_id_)
-            {
-              ass_cell = c;
-              break;
-            }
-          }
+          const auto& cell_views = delayed_prelocI_cell_views[delayed_preLocI];
+          const int ass_cell =
+            cell_views.FindCell(static_cast<int>(face.neighbor_id_));
           if (ass_cell<0)
           {
             Chi::log.LogAll()
@@ -143,19 +146,18 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
           }
 
           //============================== Find associated face
-          CompactCellView* adj_cell_view =
-            &delayed_prelocI_cell_views[delayed_preLocI][ass_cell];
           int ass_face = -1;
-          for (int af=0; af<adj_cell_view->second.size(); af++)
+          for (size_t af = cell_views.cell_face_offsets[ass_cell];
+               af < cell_views.cell_face_offsets[ass_cell + 1]; ++af)
           {
             bool face_matches = true;
-            for (int afv=0; afv<adj_cell_view->second[af].second.size(); afv++)
+            for (size_t afv = cell_views.face_vertex_offsets[af];
+                 afv < cell_views.face_vertex_offsets[af + 1]; afv++)
             {
               bool match_found = false;
               for (int fv=0; fv < face.vertex_ids_.size(); fv++)
               {
-                if (adj_cell_view->second[af].second[afv] ==
-                    face.vertex_ids_[fv])
+                if (cell_views.face_vertex_ids[afv] == face.vertex_ids_[fv])
                 {
                   match_found = true;
                   break;
@@ -165,7 +167,7 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
               if (!match_found){face_matches = false; break;}
             }
 
-            if (face_matches){ass_face = af; break;}
+            if (face_matches){ass_face = static_cast<int>(af); break;}
           }
           if (ass_face<0)
           {
@@ -176,16 +178,19 @@ void AAH_FLUDSCommonData::NonLocalIncidentMapping(const chi_mesh::Cell& cell,
 
           //============================== Map dofs
           std::pair<int,std::vector<int>> dof_mapping;
-          dof_mapping.first = adj_cell_view->second[ass_face].first;
-          std::vector<uint64_t>* ass_face_verts =
-            &adj_cell_view->second[ass_face].second;
+          dof_mapping.first = cell_views.face_slots[ass_face];
+          const size_t ass_face_begin =
+            cell_views.face_vertex_offsets[ass_face];
+          const uint64_t* ass_face_verts =
+            &cell_views.face_vertex_ids[ass_face_begin];
+          const int num_ass_face_verts = static_cast<int>(
+            cell_views.face_vertex_offsets[ass_face + 1] - ass_face_begin);
           for (int fv=0; fv < face.vertex_ids_.size(); fv++)
           {
             bool match_found = false;
-            for (int afv=0; afv<ass_face_verts->size(); afv++)
+            for (int afv=0; afv<num_ass_face_verts; afv++)
             {
-              if (face.vertex_ids_[fv] ==
-                  ass_face_verts->operator[](afv))
+              if (face.vertex_ids_[fv] == ass_face_verts[afv])
               {
                 match_found = true;
                 dof_mapping.second.push_back(afv);
@@ -61,6 +61,10 @@ public:
 
   virtual std::vector<std::vector<double>>& DelayedPrelocIOutgoingPsiOld() = 0;
 
+  /**Returns the number of bytes of the angular flux buffers held whilst
+   * sweeping.*/
+  virtual size_t GetMemoryUsage() const { return 0; }
+
   virtual ~FLUDS() = default;
 
 protected:
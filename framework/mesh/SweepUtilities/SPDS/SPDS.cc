@@ -10,6 +10,7 @@
 #include "utils/chi_timer.h"
 
 #include <algorithm>
+#include <cmath>
 
 // ###################################################################
 /** Given a location J index, maps to a predecessor location.*/
@@ -46,13 +47,183 @@ int chi_mesh::sweep_management::SPDS::MapLocJToDeplocI(int locJ) const
   return 0;
 }
 
+// ###################################################################
+/**Computes the local cycle ranges. Removing the cyclic edge a->b leaves a
+ * path from b to a, hence every cell of the cycle lies between b and a in
+ * the local sweep ordering.*/
+void chi_mesh::sweep_management::SPDS::ComputeLocalCycleSPLSRanges()
+{
+  local_cycle_spls_ranges_.clear();
+  if (local_cyclic_dependencies_.empty()) return;
+
+  const auto& spls = spls_.item_id;
+  std::vector<size_t> spls_position(spls.size(), 0);
+  for (size_t k = 0; k < spls.size(); ++k)
+    spls_position[spls[k]] = k;
+
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (const auto& [a, b] : local_cyclic_dependencies_)
+  {
+    const size_t pos_a = spls_position[a];
+    const size_t pos_b = spls_position[b];
+    ranges.emplace_back(std::min(pos_a, pos_b), std::max(pos_a, pos_b));
+  }
+  std::sort(ranges.begin(), ranges.end());
+
+  for (const auto& range : ranges)
+  {
+    if (not local_cycle_spls_ranges_.empty() and
+        range.first <= local_cycle_spls_ranges_.back().second)
+      local_cycle_spls_ranges_.back().second =
+        std::max(local_cycle_spls_ranges_.back().second, range.second);
+    else
+      local_cycle_spls_ranges_.push_back(range);
+  }
+}
+
+// ###################################################################
+/**On an orthogonal grid, the cell centroids along an axis take the
+ * values of the midpoints of the cuts, and a cell and its upwind neighbor
+ * across a face normal to the axis have consecutive midpoints. Hence,
+ * with \f$ r_a \f$ the rank of the centroid coordinate of a cell along
+ * axis \f$ a \f$, KBA's diagonal index
+ * \f$ \sum_a \mathrm{sign}(\Omega_a) r_a \f$ increases by one along every
+ * dependency, and sorting the cells by it, with a counting sort, gives a
+ * sweep ordering without building the cell graph.
+ *
+ * The closed form is not used if a direction component is zero along an
+ * axis with more than one cut interval, since such faces are oriented by
+ * cell ids, nor if any dependency does not increase the index, e.g., for a
+ * grid that is flagged orthogonal but was modified.*/
+bool chi_mesh::sweep_management::SPDS::MakeOrthogonalSweepOrdering(
+  const CellSuccessors& cell_successors)
+{
+  constexpr double tolerance = 1.0e-16;
+
+  if (not(grid_.Attributes() & MeshAttributes::ORTHOGONAL)) return false;
+
+  const size_t num_local_cells = grid_.local_cells.size();
+  if (num_local_cells == 0) return false;
+
+  const auto [xyz_min, xyz_max] = grid_.GetLocalBoundingBox();
+  const double diagonal = (xyz_max - xyz_min).Norm();
+  const double quantum = 1.0e-10 * (diagonal > 0.0 ? diagonal : 1.0);
+
+  //============================================= Diagonal index
+  std::vector<int64_t> diagonal_index(num_local_cells, 0);
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    std::vector<double> centroids;
+    centroids.reserve(num_local_cells);
+    for (const auto& cell : grid_.local_cells)
+      centroids.push_back(cell.centroid_[d]);
+    std::sort(centroids.begin(), centroids.end());
+
+    std::vector<double> midpoints;
+    for (const double x : centroids)
+      if (midpoints.empty() or x - midpoints.back() > quantum)
+        midpoints.push_back(x);
+    if (midpoints.size() == 1) continue;
+
+    if (std::fabs(omega_[d]) <= tolerance) return false;
+    const int64_t sign = omega_[d] > 0.0 ? 1 : -1;
+
+    for (const auto& cell : grid_.local_cells)
+    {
+      const double x = cell.centroid_[d];
+      const auto it =
+        std::lower_bound(midpoints.begin(), midpoints.end(), x - quantum);
+      diagonal_index[cell.local_id_] += sign * (it - midpoints.begin());
+    }
+  }
+
+  //============================================= Check the dependencies
+  for (size_t c = 0; c < num_local_cells; ++c)
+    for (const auto& successor : cell_successors[c])
+      if (diagonal_index[successor.first] <= diagonal_index[c]) return false;
+
+  //============================================= Counting sort
+  const auto [min_it, max_it] =
+    std::minmax_element(diagonal_index.begin(), diagonal_index.end());
+  const int64_t min_index = *min_it;
+  const auto num_indices = static_cast<size_t>(*max_it - min_index + 1);
+
+  std::vector<size_t> offsets(num_indices + 1, 0);
+  for (const int64_t index : diagonal_index)
+    ++offsets[index - min_index + 1];
+  for (size_t i = 0; i < num_indices; ++i)
+    offsets[i + 1] += offsets[i];
+
+  auto& spls = spls_.item_id;
+  spls.assign(num_local_cells, 0);
+  for (size_t c = 0; c < num_local_cells; ++c)
+    spls[offsets[diagonal_index[c] - min_index]++] = static_cast<int>(c);
+
+  return true;
+}
+
+// ###################################################################
+/**Computes the local sweep planes, the level of a cell being the length of
+ * the longest path of local dependencies leading to it. The edges of lagged
+ * local cycles are ignored.*/
+void chi_mesh::sweep_management::SPDS::ComputeLocalSweepPlanes(
+  const CellSuccessors& cell_successors)
+{
+  const auto& spls = spls_.item_id;
+  local_sweep_planes_.clear();
+  if (spls.empty()) return;
+
+  std::set<std::pair<int, int>> cyclic_edges;
+  for (const auto& [a, b] : local_cyclic_dependencies_)
+  {
+    cyclic_edges.emplace(a, b);
+    cyclic_edges.emplace(b, a);
+  }
+
+  // The ordering is topological, hence the levels of the upwind cells are
+  // final when a cell is reached
+  std::vector<size_t> cell_level(spls.size(), 0);
+  for (const int c : spls)
+  {
+    if (cell_level[c] >= local_sweep_planes_.size())
+      local_sweep_planes_.resize(cell_level[c] + 1);
+    local_sweep_planes_[cell_level[c]].item_id.push_back(c);
+
+    for (const auto& successor : cell_successors[c])
+    {
+      if (cyclic_edges.count({c, successor.first}) != 0) continue;
+      cell_level[successor.first] =
+        std::max(cell_level[successor.first], cell_level[c] + 1);
+    }
+  }
+}
+
+// ###################################################################
+/**Replaces the local sweep ordering by the concatenation of the local
+ * sweep planes, which keeps the relative order of the cells within a
+ * plane. The result is still a valid sweep ordering.*/
+void chi_mesh::sweep_management::SPDS::LevelizeSPLS()
+{
+  auto& spls = spls_.item_id;
+  spls_level_offsets_.clear();
+  if (spls.empty()) return;
+
+  spls.clear();
+  spls_level_offsets_.push_back(0);
+  for (const auto& plane : local_sweep_planes_)
+  {
+    spls.insert(spls.end(), plane.item_id.begin(), plane.item_id.end());
+    spls_level_offsets_.push_back(spls.size());
+  }
+}
+
 // ###################################################################
 /**Populates cell relationships*/
 void chi_mesh::sweep_management::SPDS::PopulateCellRelationships(
   const chi_mesh::Vector3& omega,
   std::set<int>& location_dependencies,
   std::set<int>& location_successors,
-  std::vector<std::set<std::pair<int, double>>>& cell_successors)
+  CellSuccessors& cell_successors)
 {
   constexpr double tolerance = 1.0e-16;
 
@@ -74,10 +245,10 @@ void chi_mesh::sweep_management::SPDS::PopulateCellRelationships(
       //                                        is incident
       FaceOrientation orientation = FOPARALLEL;
       const double mu = omega.Dot(face.normal_);
+      const auto& neighbor = grid_.GetFaceNeighborIndex(cell, f);
 
       bool owns_face = true;
-      if (face.has_neighbor_ and cell.global_id_ > face.neighbor_id_ and
-          grid_.IsCellLocal(face.neighbor_id_))
+      if (neighbor.local_id >= 0 and cell.global_id_ > face.neighbor_id_)
         owns_face = false;
 
       if (owns_face)
@@ -88,12 +259,11 @@ void chi_mesh::sweep_management::SPDS::PopulateCellRelationships(
 
         cell_face_orientations_[cell.local_id_][f] = orientation;
 
-        if (face.has_neighbor_ and grid_.IsCellLocal(face.neighbor_id_))
+        if (neighbor.local_id >= 0)
         {
-          const auto& adj_cell = grid_.cells[face.neighbor_id_];
           const auto ass_face = face.GetNeighborAssociatedFace(grid_);
           auto& adj_face_ori =
-            cell_face_orientations_[adj_cell.local_id_][ass_face];
+            cell_face_orientations_[neighbor.local_id][ass_face];
 
           switch (orientation)
           {
@@ -104,9 +274,9 @@ void chi_mesh::sweep_management::SPDS::PopulateCellRelationships(
         }
         // clang-format on
       } // if face owned
-      else if (face.has_neighbor_ and not grid_.IsCellLocal(face.neighbor_id_))
+      else if (neighbor.ghost_index >= 0)
       {
-        const auto& adj_cell = grid_.cells[face.neighbor_id_];
+        const auto& adj_cell = grid_.FaceNeighbor(cell, f);
         const auto ass_face = face.GetNeighborAssociatedFace(grid_);
         const auto& adj_face = adj_cell.faces_[ass_face];
 
@@ -143,31 +313,29 @@ void chi_mesh::sweep_management::SPDS::PopulateCellRelationships(
     for (auto& face : cell.faces_)
     {
       const double mu = omega.Dot(face.normal_);
+      const auto& neighbor = grid_.GetFaceNeighborIndex(cell, f);
       //======================================= If outgoing determine if
       //                                        it is to a local cell
       if (cell_face_orientations_[cell.local_id_][f] == FOOUTGOING)
       {
-        //================================ If it is a cell and not bndry
-        if (face.has_neighbor_)
+        //========================= If it is in the current location
+        if (neighbor.local_id >= 0)
         {
-          //========================= If it is in the current location
-          if (face.IsNeighborLocal(grid_))
-          {
-            double weight = mu * face.ComputeFaceArea(grid_);
-            cell_successors[c].insert(
-              std::make_pair(face.GetNeighborLocalID(grid_), weight));
-          }
-          else
-            location_successors.insert(face.GetNeighborPartitionID(grid_));
+          double weight = mu * face.ComputeFaceArea(grid_);
+          cell_successors[c].insert(
+            std::make_pair(static_cast<uint64_t>(neighbor.local_id), weight));
         }
+        //========================= If it is a ghost and not bndry
+        else if (neighbor.ghost_index >= 0)
+          location_successors.insert(neighbor.partition_id);
       }
       //======================================= If not outgoing determine
       //                                        what it is dependent on
       else
       {
-        //================================if it is a cell and not bndry
-        if (face.has_neighbor_ and not face.IsNeighborLocal(grid_))
-          location_dependencies.insert(face.GetNeighborPartitionID(grid_));
+        //================================if it is a ghost and not bndry
+        if (neighbor.ghost_index >= 0)
+          location_dependencies.insert(neighbor.partition_id);
       }
       ++f;
     } // for face
@@ -5,6 +5,8 @@
 #include "mesh/chi_mesh.h"
 
 #include <memory>
+#include <memory_resource>
+#include <set>
 
 namespace chi_mesh::sweep_management
 {
@@ -43,11 +45,70 @@ public:
   {
     return local_cyclic_dependencies_;
   }
+  /**Returns the ranges, [first, last] in the local sweep ordering, that
+   * contain the cells of local cycles. The ranges are merged such that they
+   * do not overlap and are sorted.*/
+  const std::vector<std::pair<size_t, size_t>>& GetLocalCycleSPLSRanges() const
+  {
+    return local_cycle_spls_ranges_;
+  }
+  /**Returns the local sweep planes, i.e., the levels of the local cell
+   * dependency graph. The cells of plane l have a longest path of l local
+   * dependencies, lagged local cycles excluded, leading to them, such that
+   * planes can be swept one after the other with the cells of a plane
+   * swept concurrently. The cells of each plane are in sweep ordering
+   * order.*/
+  const std::vector<SPLS>& GetLocalSweepPlanes() const
+  {
+    return local_sweep_planes_;
+  }
+  /**Returns the offsets, into the local sweep ordering, of the sweep
+   * levels when the ordering is levelized, otherwise an empty vector. Level
+   * l spans [offsets[l], offsets[l+1]) and its cells do not depend on each
+   * other, except through lagged local cycles, such that they can be swept
+   * concurrently once the previous levels are swept.*/
+  const std::vector<size_t>& GetSPLSLevelOffsets() const
+  {
+    return spls_level_offsets_;
+  }
   const std::vector<std::vector<FaceOrientation>>& CellFaceOrientations() const
   {
     return cell_face_orientations_;
   }
 
+  /**Quantitative summary of a sweep ordering over all the locations. The
+   * depth of a location is its number of local sweep levels, lagged local
+   * cycles excluded, and the stages are the levels of the location
+   * dependency graph, delayed dependencies excluded. The critical path is
+   * the longest path through the location graph, its length being the sum
+   * of the depths of its locations. A message is the data sent, per sweep,
+   * from a location to one of its successors, its volume being the number
+   * of face nodes on the shared faces, per direction and group.*/
+  struct Analytics
+  {
+    size_t max_local_depth = 0;
+    double avg_local_depth = 0.0;
+    size_t max_level_width = 0;
+    double avg_level_width = 0.0;
+
+    size_t num_stages = 0;
+    size_t critical_path_length = 0;
+    size_t num_locations_in_cycles = 0;
+
+    size_t num_delayed_location_edges = 0;
+    size_t num_delayed_faces = 0;
+    size_t num_local_cyclic_edges = 0;
+
+    size_t num_messages = 0;
+    size_t max_location_messages = 0;
+    size_t min_message_volume = 0;
+    double avg_message_volume = 0.0;
+    size_t max_message_volume = 0;
+    size_t total_message_volume = 0;
+  };
+  /**Computes the analytics of this ordering. Collective.*/
+  Analytics ComputeAnalytics() const;
+
   int MapLocJToPrelocI(int locJ) const;
   int MapLocJToDeplocI(int locJ) const;
 
@@ -66,18 +127,42 @@ protected:
   std::vector<int> delayed_location_successors_;
 
   std::vector<std::pair<int, int>> local_cyclic_dependencies_;
+  std::vector<std::pair<size_t, size_t>> local_cycle_spls_ranges_;
+  std::vector<SPLS> local_sweep_planes_;
+  std::vector<size_t> spls_level_offsets_;
 
   std::vector<std::vector<FaceOrientation>> cell_face_orientations_;
 
   bool verbose_ = false;
 
+  /**Successors of every local cell with the weights of the dependencies,
+   * allocated from a transient arena while building the sweep ordering.*/
+  typedef std::pmr::vector<std::pmr::set<std::pair<int, double>>>
+    CellSuccessors;
+
   /**Populates cell relationships and cell_face_orientations.*/
   void PopulateCellRelationships(
     const chi_mesh::Vector3& omega,
     std::set<int>& location_dependencies,
     std::set<int>& location_successors,
-    std::vector<std::set<std::pair<int, double>>>& cell_successors);
+    CellSuccessors& cell_successors);
+
+  /**Computes the local cycle ranges from the local cyclic dependencies and
+   * the local sweep ordering.*/
+  void ComputeLocalCycleSPLSRanges();
+
+  /**Sets the local sweep ordering in closed form if the grid is
+   * orthogonal, returning false, without changes, otherwise.*/
+  bool MakeOrthogonalSweepOrdering(
+    const CellSuccessors& cell_successors);
+
+  /**Computes the local sweep planes from the local sweep ordering.*/
+  void ComputeLocalSweepPlanes(
+    const CellSuccessors& cell_successors);
 
+  /**Reorders the local sweep ordering by sweep plane and sets the level
+   * offsets.*/
+  void LevelizeSPLS();
 
 
   void PrintedGhostedGraph() const;
@@ -7,8 +7,10 @@
 
 #include "graphs/chi_directed_graph.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_arena.h"
 
 #include <algorithm>
+#include <set>
 
 namespace chi_mesh::sweep_management
 {
@@ -24,15 +26,129 @@ SPDS_AdamsAdamsHawkins::SPDS_AdamsAdamsHawkins(
                           << " Building sweep ordering for Omega = "
                           << omega.PrintS();
 
-  size_t num_loc_cells = grid.local_cells.size();
+  if (verbose_) PrintedGhostedGraph();
+
+  BuildLocalSweepOrdering(cycle_allowance_flag);
+  CheckLocalSweepOrdering();
+
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Create Task
+  //                                                        Dependency Graphs
+  // All locations will gather other locations' dependencies
+  // so that each location has the ability to build
+  // the global task graph.
+
+  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
+                          << " Communicating sweep dependencies.";
+
+  // auto& global_dependencies = sweep_order->global_dependencies;
+  std::vector<std::vector<int>> global_dependencies;
+  global_dependencies.resize(Chi::mpi.process_count);
+
+  CommunicateLocationDependencies(location_dependencies_, global_dependencies);
+
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Build task
+  //                                                        dependency graph
+  BuildTaskDependencyGraph(global_dependencies, cycle_allowance_flag);
+
+  Chi::mpi.Barrier();
+
+  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
+                          << " Done computing sweep ordering.\n\n";
+}
+
+// ###################################################################
+/**Builds the sweep orderings of multiple directions. The local sweep
+ * orderings, which do not communicate, are built concurrently by the
+ * available threads. The location dependencies of all the orderings are
+ * then gathered in a single collective, after which the task dependency
+ * graphs are built one ordering at a time. When levelized, the local
+ * orderings are sorted by sweep level (see SPDS::GetSPLSLevelOffsets).
+ *
+ * When the location dependencies are delayed, every location dependency
+ * is treated as a removed cycle edge, i.e., every location sweeps its cells
+ * with the incoming partition-boundary angular fluxes of the previous
+ * sweep, which are exchanged once per sweep. This is a parallel block-Jacobi
+ * sweep, without pipeline fill, at the cost of more iterations.*/
+std::vector<std::shared_ptr<SPDS_AdamsAdamsHawkins>>
+SPDS_AdamsAdamsHawkins::MakeSweepOrderings(
+  const std::vector<chi_mesh::Vector3>& omegas,
+  const chi_mesh::MeshContinuum& grid,
+  bool cycle_allowance_flag,
+  const std::vector<bool>& verbose_flags,
+  bool levelized /*=false*/,
+  bool delay_location_dependencies /*=false*/)
+{
+  ChiInvalidArgumentIf(verbose_flags.size() != omegas.size(),
+                       "A verbose flag is required for each direction.");
+
+  const int num_orderings = static_cast<int>(omegas.size());
+
+  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
+                          << " Building " << num_orderings
+                          << " sweep orderings.";
+
+  //============================================= Build local orderings
+  std::vector<std::shared_ptr<SPDS_AdamsAdamsHawkins>> sweep_orderings;
+  sweep_orderings.reserve(num_orderings);
+  for (int so = 0; so < num_orderings; ++so)
+  {
+    sweep_orderings.emplace_back(
+      new SPDS_AdamsAdamsHawkins(omegas[so], grid, verbose_flags[so]));
+    if (verbose_flags[so]) sweep_orderings.back()->PrintedGhostedGraph();
+  }
+
+  grid.PrepareFaceNeighborTable();
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int so = 0; so < num_orderings; ++so)
+    sweep_orderings[so]->BuildLocalSweepOrdering(cycle_allowance_flag,
+                                                 levelized);
+
+  for (const auto& sweep_ordering : sweep_orderings)
+    sweep_ordering->CheckLocalSweepOrdering();
+
+  //============================================= Communicate dependencies
+  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
+                          << " Communicating sweep dependencies.";
+
+  std::vector<const std::vector<int>*> location_dependencies;
+  location_dependencies.reserve(num_orderings);
+  for (const auto& sweep_ordering : sweep_orderings)
+    location_dependencies.push_back(&sweep_ordering->location_dependencies_);
+
+  std::vector<std::vector<std::vector<int>>> global_dependencies;
+  CommunicateLocationDependencies(location_dependencies, global_dependencies);
+
+  //============================================= Build task dependency graphs
+  for (int so = 0; so < num_orderings; ++so)
+    sweep_orderings[so]->BuildTaskDependencyGraph(
+      global_dependencies[so], cycle_allowance_flag,
+      delay_location_dependencies);
+
+  Chi::mpi.Barrier();
+
+  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
+                          << " Done computing sweep orderings.\n\n";
+
+  return sweep_orderings;
+}
+
+// ###################################################################
+/**Builds the local cell relationships, removes the local cycles, if
+ * allowed, and generates the local sweep ordering. This does not
+ * communicate, nor log, such that it can be executed concurrently for
+ * different directions.*/
+void SPDS_AdamsAdamsHawkins::BuildLocalSweepOrdering(bool cycle_allowance_flag,
+                                                     bool levelized)
+{
+  size_t num_loc_cells = grid_.local_cells.size();
 
   //============================================= Populate Cell Relationships
-  Chi::log.Log0Verbose1() << "Populating cell relationships";
-  std::vector<std::set<std::pair<int, double>>> cell_successors(num_loc_cells);
+  chi::TransientArena arena;
+  CellSuccessors cell_successors(num_loc_cells, arena.Resource());
   std::set<int> location_successors;
   std::set<int> location_dependencies;
 
-  PopulateCellRelationships(omega,
+  PopulateCellRelationships(omega_,
                             location_dependencies,
                             location_successors,
                             cell_successors);
@@ -46,6 +162,15 @@ SPDS_AdamsAdamsHawkins::SPDS_AdamsAdamsHawkins(
   for (auto v : location_dependencies)
     location_dependencies_.push_back(v);
 
+  //============================================= Closed-form ordering on
+  //                                              orthogonal grids
+  if (MakeOrthogonalSweepOrdering(cell_successors))
+  {
+    ComputeLocalSweepPlanes(cell_successors);
+    if (levelized) LevelizeSPLS();
+    return;
+  }
+
   //============================================= Build graph
   chi::DirectedGraph local_DG;
 
@@ -59,14 +184,8 @@ SPDS_AdamsAdamsHawkins::SPDS_AdamsAdamsHawkins(
       local_DG.AddEdge(c, successor.first, successor.second);
 
   //============================================= Remove local cycles if allowed
-  if (verbose_)
-    PrintedGhostedGraph();
-
   if (cycle_allowance_flag)
   {
-    Chi::log.Log0Verbose1()
-      << Chi::program_timer.GetTimeString() << " Removing inter-cell cycles.";
-
     auto edges_to_remove = local_DG.RemoveCyclicDependencies();
 
     for (auto& edge_to_remove : edges_to_remove)
@@ -77,14 +196,21 @@ SPDS_AdamsAdamsHawkins::SPDS_AdamsAdamsHawkins(
   }
 
   //============================================= Generate topological sorting
-  Chi::log.Log0Verbose1()
-    << Chi::program_timer.GetTimeString()
-    << " Generating topological sorting for local sweep ordering";
   auto so_temp = local_DG.GenerateTopologicalSort();
   spls_.item_id.clear();
   for (auto v : so_temp)
     spls_.item_id.emplace_back(v);
 
+  ComputeLocalSweepPlanes(cell_successors);
+  if (levelized) LevelizeSPLS();
+
+  if (not spls_.item_id.empty()) ComputeLocalCycleSPLSRanges();
+}
+
+// ###################################################################
+/**Exits if the topological sorting of the local sweep ordering failed.*/
+void SPDS_AdamsAdamsHawkins::CheckLocalSweepOrdering() const
+{
   if (spls_.item_id.empty())
   {
     Chi::log.LogAllError()
@@ -93,38 +219,16 @@ SPDS_AdamsAdamsHawkins::SPDS_AdamsAdamsHawkins(
       << " by calling application.";
     Chi::Exit(EXIT_FAILURE);
   }
-
-  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Create Task
-  //                                                        Dependency Graphs
-  // All locations will gather other locations' dependencies
-  // so that each location has the ability to build
-  // the global task graph.
-
-  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
-                          << " Communicating sweep dependencies.";
-
-  // auto& global_dependencies = sweep_order->global_dependencies;
-  std::vector<std::vector<int>> global_dependencies;
-  global_dependencies.resize(Chi::mpi.process_count);
-
-  CommunicateLocationDependencies(location_dependencies_, global_dependencies);
-
-  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Build task
-  //                                                        dependency graph
-  BuildTaskDependencyGraph(global_dependencies, cycle_allowance_flag);
-
-  Chi::mpi.Barrier();
-
-  Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
-                          << " Done computing sweep ordering.\n\n";
 }
 
 // ###################################################################
-/**Builds the task dependency graph.*/
+/**Builds the task dependency graph. When the location dependencies are
+ * delayed all its edges are removed, instead of only those forming cycles.*/
 void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
   BuildTaskDependencyGraph(
   const std::vector<std::vector<int>>& global_dependencies,
-  bool cycle_allowance_flag)
+  bool cycle_allowance_flag,
+  bool delay_location_dependencies /*=false*/)
 {
 
   std::vector<std::pair<int, int>> edges_to_remove;
@@ -147,7 +251,13 @@ void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
         TDG.AddEdge(global_dependencies[loc][dep], loc);
 
     //====================================== Remove cyclic dependencies
-    if (cycle_allowance_flag)
+    if (delay_location_dependencies)
+    {
+      for (int loc = 0; loc < Chi::mpi.process_count; loc++)
+        for (const int dep : global_dependencies[loc])
+          edges_to_remove.emplace_back(dep, loc);
+    }
+    else if (cycle_allowance_flag)
     {
       Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
                               << " Removing intra-cellset cycles.";
@@ -280,15 +390,21 @@ void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
 
   std::vector<int> glob_sweep_order_rank(Chi::mpi.process_count, -1);
 
+  // Delayed location dependencies leave a single stage
+  const std::vector<std::vector<int>> no_dependencies(
+    delay_location_dependencies ? Chi::mpi.process_count : 0);
+  const auto& stage_dependencies =
+    delay_location_dependencies ? no_dependencies : global_dependencies;
+
   int abs_max_rank = 0;
   for (int k = 0; k < Chi::mpi.process_count; k++)
   {
     int loc = glob_linear_sweep_order[k];
-    if (global_dependencies[loc].empty()) glob_sweep_order_rank[k] = 0;
+    if (stage_dependencies[loc].empty()) glob_sweep_order_rank[k] = 0;
     else
     {
       int max_rank = -1;
-      for (auto dep_loc : global_dependencies[loc])
+      for (auto dep_loc : stage_dependencies[loc])
       {
         if (dep_loc < 0) continue;
         int dep_mapped_index = glob_order_mapping[dep_loc];
@@ -301,6 +417,10 @@ void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
     }
   }
 
+  //============================================= Compute priorities
+  ComputeLocationPriorities(
+    global_dependencies, edges_to_remove, glob_linear_sweep_order);
+
   //============================================= Generate TDG structure
   Chi::log.Log0Verbose1() << Chi::program_timer.GetTimeString()
                           << " Generating TDG structure.";
@@ -317,4 +437,82 @@ void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
   }
 }
 
+// ###################################################################
+/**Computes the scheduling priorities of the current location, i.e. its
+ * b-level in the task dependency graph, weighted by the number of local
+ * cells of each location, and its downstream distance along omega. The
+ * removed (delayed) edges are not part of the graph.*/
+void chi_mesh::sweep_management::SPDS_AdamsAdamsHawkins::
+  ComputeLocationPriorities(
+    const std::vector<std::vector<int>>& global_dependencies,
+    const std::vector<std::pair<int, int>>& removed_edges,
+    const std::vector<int>& glob_linear_sweep_order)
+{
+  const int num_locations = Chi::mpi.process_count;
+
+  //============================================= Gather location info
+  // Per location: number of cells and the sum of the cell centroids
+  double local_info[4] = {0.0, 0.0, 0.0, 0.0};
+  for (const auto& cell : grid_.local_cells)
+  {
+    local_info[0] += 1.0;
+    local_info[1] += cell.centroid_.x;
+    local_info[2] += cell.centroid_.y;
+    local_info[3] += cell.centroid_.z;
+  }
+
+  std::vector<double> global_info(4 * num_locations, 0.0);
+  MPI_Allgather(
+    local_info, 4, MPI_DOUBLE, global_info.data(), 4, MPI_DOUBLE, Chi::mpi.comm);
+
+  //============================================= Downstream distance
+  std::vector<double> location_distance(num_locations, 0.0);
+  double max_distance = 0.0;
+  bool max_distance_set = false;
+  for (int loc = 0; loc < num_locations; ++loc)
+  {
+    const double num_cells = global_info[4 * loc];
+    if (num_cells <= 0.0) continue;
+
+    const chi_mesh::Vector3 centroid(global_info[4 * loc + 1] / num_cells,
+                                     global_info[4 * loc + 2] / num_cells,
+                                     global_info[4 * loc + 3] / num_cells);
+    location_distance[loc] = omega_.Dot(centroid);
+    if (not max_distance_set or location_distance[loc] > max_distance)
+    {
+      max_distance = location_distance[loc];
+      max_distance_set = true;
+    }
+  }
+  location_downstream_distance_ =
+    max_distance - location_distance[Chi::mpi.location_id];
+
+  //============================================= Successors without the
+  //                                              removed edges
+  std::set<std::pair<int, int>> removed(removed_edges.begin(),
+                                        removed_edges.end());
+  std::vector<std::vector<int>> global_successors(num_locations);
+  for (int loc = 0; loc < num_locations; ++loc)
+    for (const int dep : global_dependencies[loc])
+      if (dep >= 0 and removed.count({dep, loc}) == 0)
+        global_successors[dep].push_back(loc);
+
+  //============================================= B-level in reverse
+  //                                              topological order
+  std::vector<double> b_level(num_locations, 0.0);
+  for (auto it = glob_linear_sweep_order.rbegin();
+       it != glob_linear_sweep_order.rend();
+       ++it)
+  {
+    const int loc = *it;
+    double max_successor_b_level = 0.0;
+    for (const int successor : global_successors[loc])
+      max_successor_b_level = std::max(max_successor_b_level,
+                                       b_level[successor]);
+
+    b_level[loc] = global_info[4 * loc] + max_successor_b_level;
+  }
+  location_b_level_ = b_level[Chi::mpi.location_id];
+}
+
 } // namespace chi_mesh::sweep_management
\ No newline at end of file
@@ -13,17 +13,55 @@ public:
                          const chi_mesh::MeshContinuum& grid,
                          bool cycle_allowance_flag,
                          bool verbose);
+
+  static std::vector<std::shared_ptr<SPDS_AdamsAdamsHawkins>>
+  MakeSweepOrderings(const std::vector<chi_mesh::Vector3>& omegas,
+                     const chi_mesh::MeshContinuum& grid,
+                     bool cycle_allowance_flag,
+                     const std::vector<bool>& verbose_flags,
+                     bool levelized = false,
+                     bool delay_location_dependencies = false);
+
   const std::vector<STDG>& GetGlobalSweepPlanes() const
   {
     return global_sweep_planes_;
   }
+  /**Returns the b-level of the current location, i.e. the number of cells
+   * on the longest path, through the task dependency graph, from the start
+   * of the current location to the end of the sweep.*/
+  double GetLocationBLevel() const { return location_b_level_; }
+  /**Returns the distance, along omega, from the centroid of the current
+   * location to the centroid of the most downstream location.*/
+  double GetLocationDownstreamDistance() const
+  {
+    return location_downstream_distance_;
+  }
 
 private:
+  /**Only initializes the base, the ordering is built by
+   * MakeSweepOrderings.*/
+  SPDS_AdamsAdamsHawkins(const chi_mesh::Vector3& omega,
+                         const chi_mesh::MeshContinuum& grid,
+                         bool verbose)
+    : SPDS(omega, grid, verbose)
+  {
+  }
+
+  void BuildLocalSweepOrdering(bool cycle_allowance_flag,
+                               bool levelized = false);
+  void CheckLocalSweepOrdering() const;
   void BuildTaskDependencyGraph(
     const std::vector<std::vector<int>>& global_dependencies,
-    bool cycle_allowance_flag);
+    bool cycle_allowance_flag,
+    bool delay_location_dependencies = false);
+  void ComputeLocationPriorities(
+    const std::vector<std::vector<int>>& global_dependencies,
+    const std::vector<std::pair<int, int>>& removed_edges,
+    const std::vector<int>& glob_linear_sweep_order);
 
   std::vector<STDG> global_sweep_planes_; ///< Processor sweep planes
+  double location_b_level_ = 0.0;
+  double location_downstream_distance_ = 0.0;
 };
 
 }
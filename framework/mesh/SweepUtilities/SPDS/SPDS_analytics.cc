@@ -0,0 +1,186 @@
+#include "SPDS.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/SweepUtilities/sweep_namespace.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
+
+// ###################################################################
+/**The local levels are recomputed from the ordering, rather than taken
+ * from the local sweep planes, since not every ordering computes the
+ * planes. The location graph is gathered on every location, which is
+ * inexpensive next to building the ordering.*/
+chi_mesh::sweep_management::SPDS::Analytics
+chi_mesh::sweep_management::SPDS::ComputeAnalytics() const
+{
+  typedef unsigned long long int ULL;
+  const int P = Chi::mpi.process_count;
+  Analytics analytics;
+
+  //============================================= Local levels
+  const auto& spls = spls_.item_id;
+  const size_t num_local_cells = spls.size();
+  std::vector<size_t> position(num_local_cells, 0);
+  for (size_t i = 0; i < num_local_cells; ++i)
+    position[spls[i]] = i;
+
+  // Edges against the ordering are those of lagged local cycles
+  std::vector<size_t> cell_level(num_local_cells, 0);
+  std::vector<size_t> level_widths;
+  for (const int c : spls)
+  {
+    if (cell_level[c] >= level_widths.size())
+      level_widths.resize(cell_level[c] + 1, 0);
+    ++level_widths[cell_level[c]];
+
+    const auto& cell = grid_.local_cells[c];
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const auto& neighbor = grid_.GetFaceNeighborIndex(cell, f);
+      if (cell_face_orientations_[c][f] != FaceOrientation::OUTGOING or
+          neighbor.local_id < 0)
+        continue;
+      const uint64_t successor = neighbor.local_id;
+      if (position[successor] < position[c]) continue;
+      cell_level[successor] =
+        std::max(cell_level[successor], cell_level[c] + 1);
+    }
+  }
+  const size_t local_depth = level_widths.size();
+  size_t local_max_width = 0;
+  for (const size_t width : level_widths)
+    local_max_width = std::max(local_max_width, width);
+
+  //============================================= Outgoing messages
+  const std::set<int> delayed_successors(delayed_location_successors_.begin(),
+                                         delayed_location_successors_.end());
+  std::map<int, size_t> message_volumes;
+  size_t local_delayed_faces = 0;
+  for (const auto& cell : grid_.local_cells)
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const auto& face = cell.faces_[f];
+      const auto& neighbor = grid_.GetFaceNeighborIndex(cell, f);
+      if (cell_face_orientations_[cell.local_id_][f] !=
+            FaceOrientation::OUTGOING or
+          neighbor.ghost_index < 0)
+        continue;
+      const int successor = neighbor.partition_id;
+      message_volumes[successor] += face.vertex_ids_.size();
+      if (delayed_successors.count(successor) != 0) ++local_delayed_faces;
+    }
+
+  ULL local_min_volume = std::numeric_limits<ULL>::max();
+  ULL local_max_volume = 0;
+  ULL local_total_volume = 0;
+  for (const auto& [successor, volume] : message_volumes)
+  {
+    local_min_volume = std::min<ULL>(local_min_volume, volume);
+    local_max_volume = std::max<ULL>(local_max_volume, volume);
+    local_total_volume += volume;
+  }
+
+  //============================================= Reduce
+  // Sums: [0] depth, [1] cells, [2] delayed location edges, [3] delayed
+  // faces, [4] local cyclic edges, [5] messages, [6] message volume
+  const ULL local_sums[] = {local_depth,
+                            num_local_cells,
+                            delayed_location_dependencies_.size(),
+                            local_delayed_faces,
+                            local_cyclic_dependencies_.size(),
+                            message_volumes.size(),
+                            local_total_volume};
+  ULL sums[7];
+  MPI_Allreduce(local_sums, sums, 7, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                Chi::mpi.comm);
+
+  // Maxima: [0] depth, [1] level width, [2] messages, [3] message volume
+  const ULL local_maxs[] = {local_depth,
+                            local_max_width,
+                            message_volumes.size(),
+                            local_max_volume};
+  ULL maxs[4];
+  MPI_Allreduce(local_maxs, maxs, 4, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+                Chi::mpi.comm);
+
+  ULL min_volume = 0;
+  MPI_Allreduce(&local_min_volume, &min_volume, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_MIN, Chi::mpi.comm);
+
+  analytics.max_local_depth = maxs[0];
+  analytics.avg_local_depth = static_cast<double>(sums[0]) / P;
+  analytics.max_level_width = maxs[1];
+  analytics.avg_level_width =
+    sums[0] > 0 ? static_cast<double>(sums[1]) / sums[0] : 0.0;
+  analytics.num_delayed_location_edges = sums[2];
+  analytics.num_delayed_faces = sums[3];
+  analytics.num_local_cyclic_edges = sums[4];
+  analytics.num_messages = sums[5];
+  analytics.max_location_messages = maxs[2];
+  analytics.max_message_volume = maxs[3];
+  analytics.total_message_volume = sums[6];
+  if (sums[5] > 0)
+  {
+    analytics.min_message_volume = min_volume;
+    analytics.avg_message_volume = static_cast<double>(sums[6]) / sums[5];
+  }
+
+  //============================================= Location graph
+  std::vector<std::vector<int>> global_dependencies(P);
+  CommunicateLocationDependencies(location_dependencies_, global_dependencies);
+
+  std::vector<ULL> depths(P, 0);
+  const ULL local_depth_ull = local_depth;
+  MPI_Allgather(&local_depth_ull, 1, MPI_UNSIGNED_LONG_LONG, depths.data(), 1,
+                MPI_UNSIGNED_LONG_LONG, Chi::mpi.comm);
+
+  std::vector<std::vector<int>> global_successors(P);
+  std::vector<size_t> num_pending(P, 0);
+  for (int p = 0; p < P; ++p)
+    for (const int dependency : global_dependencies[p])
+    {
+      global_successors[dependency].push_back(p);
+      ++num_pending[p];
+    }
+
+  // Topological traversal, the locations of cycles never becoming ready
+  std::vector<size_t> stage(P, 0);
+  std::vector<size_t> path_length(P, 0);
+  std::deque<int> ready;
+  for (int p = 0; p < P; ++p)
+    if (num_pending[p] == 0)
+    {
+      path_length[p] = depths[p];
+      ready.push_back(p);
+    }
+
+  size_t num_visited = 0;
+  while (not ready.empty())
+  {
+    const int p = ready.front();
+    ready.pop_front();
+    ++num_visited;
+    analytics.num_stages = std::max(analytics.num_stages, stage[p] + 1);
+    analytics.critical_path_length =
+      std::max(analytics.critical_path_length, path_length[p]);
+
+    for (const int successor : global_successors[p])
+    {
+      stage[successor] = std::max(stage[successor], stage[p] + 1);
+      const size_t successor_length =
+        path_length[p] + static_cast<size_t>(depths[successor]);
+      path_length[successor] =
+        std::max(path_length[successor], successor_length);
+      if (--num_pending[successor] == 0) ready.push_back(successor);
+    }
+  }
+  analytics.num_locations_in_cycles = P - num_visited;
+
+  return analytics;
+}
@@ -30,25 +30,124 @@ HeterogeneousPsiIncoming(uint64_t cell_local_id,
 }
 
 //###################################################################
-/**Performs the setup for a particular quadrature.*/
+/**Evaluates the face nodes one by one.*/
+std::vector<double> chi_mesh::sweep_management::BoundaryFunction::
+EvaluateBatch(
+  const BoundaryFaceNodes& face_nodes,
+  const std::vector<int>& quadrature_angle_indices,
+  const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+  const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+  const std::vector<int>& group_indices,
+  double time)
+{
+  const size_t node_size =
+    quadrature_angle_indices.size() * group_indices.size();
+
+  std::vector<double> psi;
+  psi.reserve(face_nodes.Size() * node_size);
+  for (size_t i=0; i<face_nodes.Size(); ++i)
+  {
+    const auto node_psi = Evaluate(face_nodes.cell_global_ids[i],
+                                   face_nodes.cell_material_ids[i],
+                                   face_nodes.face_indices[i],
+                                   face_nodes.face_node_indices[i],
+                                   face_nodes.locations[i],
+                                   face_nodes.normals[i],
+                                   quadrature_angle_indices,
+                                   quadrature_angle_vectors,
+                                   quadrature_phi_theta_angles,
+                                   group_indices,
+                                   time);
+    if (node_psi.size() != node_size)
+      throw std::logic_error(
+        "BoundaryFunction::EvaluateBatch: The boundary function returned " +
+        std::to_string(node_psi.size()) + " values for a face node, "
+        "instead of num_angles*num_groups, " + std::to_string(node_size) +
+        ".");
+    psi.insert(psi.end(), node_psi.begin(), node_psi.end());
+  }
+  return psi;
+}
+
+//###################################################################
+/**Evaluates a single face node with the functor.*/
+std::vector<double> chi_mesh::sweep_management::BoundaryFunctor::
+Evaluate(size_t cell_global_id,
+         int    cell_material_id,
+         unsigned int face_index,
+         unsigned int face_node_index,
+         const chi_mesh::Vector3& face_node_location,
+         const chi_mesh::Vector3& face_node_normal,
+         const std::vector<int>& quadrature_angle_indices,
+         const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+         const std::vector<std::pair<double,double>>&
+           quadrature_phi_theta_angles,
+         const std::vector<int>& group_indices,
+         double time)
+{
+  BoundaryFaceNodes face_node;
+  face_node.cell_global_ids = {cell_global_id};
+  face_node.cell_material_ids = {cell_material_id};
+  face_node.face_indices = {face_index};
+  face_node.face_node_indices = {face_node_index};
+  face_node.locations = {face_node_location};
+  face_node.normals = {face_node_normal};
+
+  return EvaluateBatch(face_node,
+                       quadrature_angle_indices,
+                       quadrature_angle_vectors,
+                       quadrature_phi_theta_angles,
+                       group_indices,
+                       time);
+}
+
+//###################################################################
+/**Evaluates all the face nodes with the functor.*/
+std::vector<double> chi_mesh::sweep_management::BoundaryFunctor::
+EvaluateBatch(
+  const BoundaryFaceNodes& face_nodes,
+  const std::vector<int>& quadrature_angle_indices,
+  const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+  const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+  const std::vector<int>& group_indices,
+  double time)
+{
+  return functor_(face_nodes,
+                  quadrature_angle_indices,
+                  quadrature_angle_vectors,
+                  quadrature_phi_theta_angles,
+                  group_indices,
+                  time);
+}
+
+//###################################################################
+/**Performs the setup for a particular quadrature. All the face nodes of
+ * the boundary are evaluated with a single call to the boundary function.
+ * The setup is skipped when the grid, the quadrature and the evaluation
+ * time, ignored with a time table since the fluxes are then shapes, are
+ * the same as for the previous one, e.g., for groupsets sharing a
+ * quadrature or when re-initializing a solver.*/
 void chi_mesh::sweep_management::BoundaryIncidentHeterogeneous::
 Setup(const chi_mesh::MeshContinuum &grid,
       const chi_math::AngularQuadrature &quadrature)
 {
   const size_t num_local_cells = grid.local_cells.size();
-  local_cell_data_.clear();
-  local_cell_data_.reserve(num_local_cells);
+  const size_t num_angles = quadrature.omegas_.size();
 
-  std::vector<bool> cell_bndry_flags(num_local_cells,false);
-  for (const auto& cell : grid.local_cells)
-    for (const auto& face : cell.faces_)
-      if (not face.has_neighbor_)
-      {
-        cell_bndry_flags[cell.local_id_] = true;
-        break;
-      }
+  SetupKey setup_key;
+  setup_key.grid = &grid;
+  setup_key.num_local_cells = num_local_cells;
+  setup_key.omegas.reserve(3 * num_angles);
+  for (const auto& omega : quadrature.omegas_)
+    setup_key.omegas.insert(setup_key.omegas.end(),
+                            {omega.x, omega.y, omega.z});
+  setup_key.time = HasTimeTable() ? 0.0 : GetEvaluationTime();
+
+  if (is_setup_ and setup_key == setup_key_) return;
 
-  size_t num_angles = quadrature.omegas_.size();
+  local_cell_data_.clear();
+  reference_cell_data_.clear();
+  local_cell_data_.resize(num_local_cells);
 
   typedef std::pair<double, double> PhiTheta;
 
@@ -77,48 +176,87 @@ Setup(const chi_mesh::MeshContinuum &grid,
   for (int g=0; g<static_cast<int>(num_groups_); ++g)
     group_indices.emplace_back(g);
 
-  const double eval_time = GetEvaluationTime();
-
+  //============================================= Gather the face nodes
+  BoundaryFaceNodes face_nodes;
+  std::vector<uint64_t> face_node_cell_local_ids;
   for (const auto& cell : grid.local_cells)
-  {
-    if (cell_bndry_flags[cell.local_id_])
+    for (size_t f=0; f<cell.faces_.size(); ++f)
     {
-      CellData cell_data(cell.faces_.size());
+      const auto& face = cell.faces_[f];
+      if (face.has_neighbor_) continue;
 
-      for (size_t f=0; f<cell.faces_.size(); ++f)
+      auto& cell_data = local_cell_data_[cell.local_id_];
+      if (cell_data.empty()) cell_data.resize(cell.faces_.size());
+      if (face.neighbor_id_ != ref_boundary_id_) continue;
+
+      const size_t face_num_nodes = face.vertex_ids_.size();
+      cell_data[f].resize(face_num_nodes);
+      for (size_t i=0; i<face_num_nodes; ++i)
       {
-        auto& face = cell.faces_[f];
-        size_t face_num_nodes = face.vertex_ids_.size();
-        FaceData face_data;
-
-        if (not face.has_neighbor_ and face.neighbor_id_ == ref_boundary_id_)
-        {
-          face_data.reserve(face_num_nodes);
-          for (size_t i=0; i<face_num_nodes; ++i)
-          {
-            std::vector<double> face_node_data =
-              boundary_function_->Evaluate(cell.global_id_,
-                                           cell.material_id_,
-                                           f, i,
-                                           grid.vertices[face.vertex_ids_[i]],
-                                           face.normal_,
-                                           angle_indices,
-                                           angle_vectors,
-                                           phi_theta_angles,
-                                           group_indices,
-                                           eval_time);
-
-            face_data.push_back(std::move(face_node_data));
-          }//for face node-i
-        }//bndry face
-
-        cell_data[f] = std::move(face_data);
-      }//for face f
-
-      local_cell_data_.push_back(std::move(cell_data));
-    }//if bndry cell
-    else
-      local_cell_data_.emplace_back();
-
-  }//for cell
+        face_nodes.cell_global_ids.push_back(cell.global_id_);
+        face_nodes.cell_material_ids.push_back(cell.material_id_);
+        face_nodes.face_indices.push_back(static_cast<unsigned int>(f));
+        face_nodes.face_node_indices.push_back(static_cast<unsigned int>(i));
+        face_nodes.locations.push_back(grid.vertices[face.vertex_ids_[i]]);
+        face_nodes.normals.push_back(face.normal_);
+        face_node_cell_local_ids.push_back(cell.local_id_);
+      }
+    }//for face f
+
+  //============================================= Evaluate and distribute
+  const size_t node_size = num_angles * num_groups_;
+  const auto psi = boundary_function_->EvaluateBatch(face_nodes,
+                                                     angle_indices,
+                                                     angle_vectors,
+                                                     phi_theta_angles,
+                                                     group_indices,
+                                                     GetEvaluationTime());
+  if (psi.size() != face_nodes.Size() * node_size)
+    throw std::logic_error(
+      "BoundaryIncidentHeterogeneous::Setup: The boundary function of "
+      "boundary " + std::to_string(ref_boundary_id_) + " returned " +
+      std::to_string(psi.size()) + " values instead of "
+      "num_face_nodes*num_angles*num_groups, " +
+      std::to_string(face_nodes.Size() * node_size) + ".");
+
+  for (size_t k=0; k<face_nodes.Size(); ++k)
+  {
+    const auto begin = psi.begin() + static_cast<ptrdiff_t>(k * node_size);
+    auto& cell_data = local_cell_data_[face_node_cell_local_ids[k]];
+    cell_data[face_nodes.face_indices[k]][face_nodes.face_node_indices[k]] =
+      std::vector<double>(begin, begin + static_cast<ptrdiff_t>(node_size));
+  }
+
+  setup_key_ = std::move(setup_key);
+  is_setup_ = true;
+
+  //============================================= Keep the shapes for the
+  //                                              time amplitudes
+  if (HasTimeTable())
+  {
+    reference_cell_data_ = local_cell_data_;
+    ApplyTimeAmplitudes();
+  }
+}
+
+//###################################################################
+/**Scales the fluxes evaluated at setup by the time amplitudes, such that
+ * the boundary function is not evaluated again as time advances. When the
+ * time table is set after setup, the current fluxes become the shapes.*/
+void chi_mesh::sweep_management::BoundaryIncidentHeterogeneous::
+ApplyTimeAmplitudes()
+{
+  if (time_amplitudes_.empty()) return;
+  if (reference_cell_data_.empty()) reference_cell_data_ = local_cell_data_;
+
+  const size_t G = num_groups_;
+  for (size_t c = 0; c < reference_cell_data_.size(); ++c)
+    for (size_t f = 0; f < reference_cell_data_[c].size(); ++f)
+      for (size_t i = 0; i < reference_cell_data_[c][f].size(); ++i)
+      {
+        const auto& reference = reference_cell_data_[c][f][i];
+        auto& psi = local_cell_data_[c][f][i];
+        for (size_t k = 0; k < reference.size(); ++k)
+          psi[k] = reference[k] * time_amplitudes_[k % G];
+      }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "sweep_boundaries.h"
 
+#include <algorithm>
+
 //###################################################################
 /**Returns a pointer to a homogenous flux storage location.*/
 double* chi_mesh::sweep_management::BoundaryIsotropicHomogenous::
@@ -11,4 +13,14 @@ HeterogeneousPsiIncoming(uint64_t cell_local_id,
                            size_t gs_ss_begin)
 {
   return &boundary_flux[group_num];
-}
\ No newline at end of file
+}
+//###################################################################
+/**Scales the reference fluxes by the time amplitudes.*/
+void chi_mesh::sweep_management::BoundaryIsotropicHomogenous::
+ApplyTimeAmplitudes()
+{
+  const size_t num_groups =
+    std::min(boundary_flux.size(), time_amplitudes_.size());
+  for (size_t g = 0; g < num_groups; ++g)
+    boundary_flux[g] = reference_boundary_flux_[g] * time_amplitudes_[g];
+}
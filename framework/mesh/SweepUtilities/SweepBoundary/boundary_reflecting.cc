@@ -1,8 +1,66 @@
 #include "sweep_boundaries.h"
 
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "math/Quadratures/angular_quadrature_base.h"
+
 #include "chi_log.h"
 #include "chi_mpi.h"
 
+//###################################################################
+/**Allocates the fluxes, of `num_groups` groups, of the outgoing angles on
+ * the face nodes of the boundary. The fluxes are stored in a single block
+ * per angle, and the face nodes of the boundary are indexed per cell and
+ * face.*/
+void chi_mesh::sweep_management::BoundaryReflecting::
+InitializeFluxStorage(const chi_mesh::MeshContinuum& grid,
+                      const chi_math::AngularQuadrature& quadrature,
+                      size_t num_groups)
+{
+  num_flux_groups_ = num_groups;
+
+  //======================================== Index the boundary face nodes
+  num_face_nodes_ = 0;
+  cell_face_indices_.assign(grid.local_cells.size(), -1);
+  face_node_offsets_.clear();
+  for (const auto& cell : grid.local_cells)
+  {
+    bool on_ref_bndry = false;
+    for (const auto& face : cell.faces_)
+      if ((not face.has_neighbor_) and
+          (face.normal_.Dot(normal_) > 0.999999))
+      {
+        on_ref_bndry = true;
+        break;
+      }
+    if (not on_ref_bndry) continue;
+
+    cell_face_indices_[cell.local_id_] =
+      static_cast<int64_t>(face_node_offsets_.size());
+    for (const auto& face : cell.faces_)
+    {
+      if ((not face.has_neighbor_) and
+          (face.normal_.Dot(normal_) > 0.999999))
+      {
+        face_node_offsets_.push_back(static_cast<int64_t>(num_face_nodes_));
+        num_face_nodes_ += face.vertex_ids_.size();
+      }
+      else
+        face_node_offsets_.push_back(-1);
+    }
+  }//for cell
+
+  //======================================== Assign the outgoing angles
+  const size_t num_angles = quadrature.omegas_.size();
+  angle_blocks_.assign(num_angles, -1);
+  int64_t num_blocks = 0;
+  for (size_t n = 0; n < num_angles; ++n)
+    if (quadrature.omegas_[n].Dot(normal_) >= 0.0)
+      angle_blocks_[n] = num_blocks++;
+
+  boundary_flux_.assign(num_blocks * num_face_nodes_ * num_flux_groups_, 0.0);
+  boundary_flux_old_.clear();
+}
+
 //###################################################################
 /**Returns a pointer to a reflected flux storage location.*/
 double* chi_mesh::sweep_management::BoundaryReflecting::
@@ -13,26 +71,16 @@ HeterogeneousPsiIncoming(uint64_t cell_local_id,
                          int group_num,
   size_t gs_ss_begin)
 {
-  double* Psi;
+  const int reflected_angle_num = reflected_anglenum_[angle_num];
 
-  int reflected_angle_num = reflected_anglenum_[angle_num];
+  const size_t face_node =
+    face_node_offsets_[cell_face_indices_[cell_local_id] + face_num] + fi;
+  const size_t address =
+    (angle_blocks_[reflected_angle_num] * num_face_nodes_ + face_node) *
+    num_flux_groups_ + gs_ss_begin;
 
-  if (opposing_reflected_)
-  {
-    Psi = &hetero_boundary_flux_old_[reflected_angle_num]
-    [cell_local_id]
-    [face_num]
-    [fi][gs_ss_begin];
-  }
-  else
-  {
-    Psi = &hetero_boundary_flux_[reflected_angle_num]
-    [cell_local_id]
-    [face_num]
-    [fi][gs_ss_begin];
-  }
-
-  return Psi;
+  if (opposing_reflected_) return &boundary_flux_old_[address];
+  return &boundary_flux_[address];
 }
 
 //###################################################################
@@ -44,10 +92,13 @@ HeterogeneousPsiOutgoing(uint64_t cell_local_id,
   unsigned int angle_num,
   size_t gs_ss_begin)
 {
-  return &hetero_boundary_flux_[angle_num]
-  [cell_local_id]
-  [face_num]
-  [fi][gs_ss_begin];
+  const size_t face_node =
+    face_node_offsets_[cell_face_indices_[cell_local_id] + face_num] + fi;
+  const size_t address =
+    (angle_blocks_[angle_num] * num_face_nodes_ + face_node) *
+    num_flux_groups_ + gs_ss_begin;
+
+  return &boundary_flux_[address];
 }
 
 
@@ -68,7 +119,7 @@ CheckAnglesReadyStatus(const std::vector<size_t>& angles, size_t gs_ss)
   if (opposing_reflected_) return true;
   bool ready_flag = true;
   for (auto& n : angles)
-    if (!hetero_boundary_flux_[reflected_anglenum_[n]].empty())
+    if (angle_blocks_[reflected_anglenum_[n]] >= 0)
       if (not angle_readyflags_[n][gs_ss]) return false;
 
   return ready_flag;
@@ -79,7 +130,7 @@ CheckAnglesReadyStatus(const std::vector<size_t>& angles, size_t gs_ss)
 void chi_mesh::sweep_management::BoundaryReflecting::
 ResetAnglesReadyStatus()
 {
-  hetero_boundary_flux_old_ = hetero_boundary_flux_;
+  boundary_flux_old_ = boundary_flux_;
 
   for (auto& flags : angle_readyflags_)
     for (int gs_ss=0; gs_ss<flags.size(); ++gs_ss)
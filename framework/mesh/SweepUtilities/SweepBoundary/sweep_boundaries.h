@@ -3,7 +3,10 @@
 
 #include "mesh/chi_mesh.h"
 #include "math/chi_math.h"
+#include "math/chi_math_time_table.h"
 
+#include <functional>
+#include <memory>
 #include <vector>
 #include <limits>
 
@@ -26,9 +29,14 @@ private:
   const chi_mesh::sweep_management::BoundaryType type_;
   const chi_math::CoordinateSystemType coord_type_;
   double evaluation_time_ = 0.0; ///< Time value passed to boundary functions
+  /**Optional amplitudes in time of the incident fluxes.*/
+  std::shared_ptr<const chi_math::TimeTable> time_table_ = nullptr;
 protected:
   std::vector<double>  zero_boundary_flux_;
   size_t num_groups_;
+  /**Group amplitudes of the time table at the evaluation time, empty
+   * without a time table.*/
+  std::vector<double> time_amplitudes_;
 
 public:
   explicit SweepBoundary(BoundaryType bndry_type,
@@ -48,7 +56,10 @@ public:
   { return type_ == BoundaryType::REFLECTING; }
 
   double GetEvaluationTime() const {return evaluation_time_;}
-  void SetEvaluationTime(double time) { evaluation_time_ = time;}
+  void SetEvaluationTime(double time);
+
+  void SetTimeTable(std::shared_ptr<const chi_math::TimeTable> time_table);
+  bool HasTimeTable() const {return time_table_ != nullptr;}
 
 
   virtual double* HeterogeneousPsiIncoming(uint64_t cell_local_id,
@@ -74,6 +85,11 @@ public:
                      const chi_math::AngularQuadrature& quadrature) {}
 
   double* ZeroFlux(int group_num) {return &zero_boundary_flux_[group_num];}
+
+protected:
+  /**Scales the incident fluxes by the time_amplitudes_, called when they
+   * change.*/
+  virtual void ApplyTimeAmplitudes() {}
 };
 
 //###################################################################
@@ -106,6 +122,7 @@ public:
 class BoundaryIsotropicHomogenous : public SweepBoundary
 {
 private:
+  const std::vector<double> reference_boundary_flux_;
   std::vector<double> boundary_flux;
 public:
   explicit
@@ -115,7 +132,8 @@ public:
                               chi_math::CoordinateSystemType::CARTESIAN) :
     SweepBoundary(BoundaryType::INCIDENT_ISOTROPIC_HOMOGENOUS, in_num_groups,
                   coord_type),
-    boundary_flux(std::move(ref_boundary_flux))
+    reference_boundary_flux_(std::move(ref_boundary_flux)),
+    boundary_flux(reference_boundary_flux_)
   {}
 
   double* HeterogeneousPsiIncoming(
@@ -125,6 +143,9 @@ public:
                                    unsigned int angle_num,
     int group_num,
                                    size_t gs_ss_begin) override;
+
+protected:
+  void ApplyTimeAmplitudes() override;
 };
 
 //###################################################################
@@ -135,15 +156,21 @@ protected:
   const chi_mesh::Normal normal_;
   bool  opposing_reflected_ = false;
 
-  typedef std::vector<double> DOFVec;   //Groups per DOF
-  typedef std::vector<DOFVec> FaceVec;  //DOFs per face
-  typedef std::vector<FaceVec> CellVec; //Faces per cell
-  typedef std::vector<CellVec> AngVec;  //Cell per angle
-
-  //angle,cell,face,dof,group
-  //Populated by angle aggregation
-  std::vector<AngVec>              hetero_boundary_flux_;
-  std::vector<AngVec>              hetero_boundary_flux_old_;
+  //angle,face node,group
+  //Only the outgoing angles and the face nodes on the boundary are stored
+  std::vector<double>              boundary_flux_;
+  std::vector<double>              boundary_flux_old_;
+
+  size_t                           num_face_nodes_ = 0;
+  size_t                           num_flux_groups_ = 0;
+  /**Block of each angle in the fluxes, -1 for incoming angles.*/
+  std::vector<int64_t>             angle_blocks_;
+  /**Index in face_node_offsets_ of the first face of each local cell, -1
+   * for cells not on the boundary.*/
+  std::vector<int64_t>             cell_face_indices_;
+  /**First face node, in an angle block, of each face of the cells on the
+   * boundary, -1 for faces not on the boundary.*/
+  std::vector<int64_t>             face_node_offsets_;
 
   std::vector<int>                 reflected_anglenum_;
   std::vector<std::vector<bool>>   angle_readyflags_;
@@ -161,8 +188,14 @@ public:
   bool IsOpposingReflected() const {return opposing_reflected_;}
   void SetOpposingReflected(bool value) { opposing_reflected_ = value;}
 
-  std::vector<AngVec>& GetHeteroBoundaryFluxNew() {return hetero_boundary_flux_;}
-  std::vector<AngVec>& GetHeteroBoundaryFluxOld() {return hetero_boundary_flux_old_;}
+  /**Flat storage of the outgoing fluxes, ordered by angle, face node and
+   * group.*/
+  std::vector<double>& GetBoundaryFluxNew() {return boundary_flux_;}
+  std::vector<double>& GetBoundaryFluxOld() {return boundary_flux_old_;}
+
+  void InitializeFluxStorage(const chi_mesh::MeshContinuum& grid,
+                             const chi_math::AngularQuadrature& quadrature,
+                             size_t num_groups);
 
   std::vector<int>& GetReflectedAngleIndexMap() {return reflected_anglenum_;}
   std::vector<std::vector<bool>>&
@@ -187,6 +220,20 @@ public:
   void ResetAnglesReadyStatus();
 };
 
+/**The boundary face nodes of a batched boundary function evaluation, one
+ * entry per node in every array.*/
+struct BoundaryFaceNodes
+{
+  std::vector<uint64_t>          cell_global_ids;
+  std::vector<int>               cell_material_ids;
+  std::vector<unsigned int>      face_indices;
+  std::vector<unsigned int>      face_node_indices;
+  std::vector<chi_mesh::Vector3> locations;
+  std::vector<chi_mesh::Vector3> normals;
+
+  size_t Size() const {return locations.size();}
+};
+
 /**This boundary function class can be derived from to
  * provide a much more custom experience. This function
  * is called during Setup. */
@@ -206,26 +253,105 @@ public:
     const std::vector<int>& group_indices,
     double time) = 0;
 
+  /**Evaluates all the face nodes of a boundary at once, returning, node by
+   * node, then angle by angle, the psi of every group. By default calls
+   * Evaluate for every node. Functions crossing into an interpreter should
+   * override it, the boundary being set up with a single call.*/
+  virtual std::vector<double> EvaluateBatch(
+    const BoundaryFaceNodes& face_nodes,
+    const std::vector<int>& quadrature_angle_indices,
+    const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+    const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+    const std::vector<int>& group_indices,
+    double time);
+
   virtual ~BoundaryFunction() = default;
 };
 
+//###################################################################
+/**Boundary function evaluated by a C++ functor with the signature of
+ * BoundaryFunction::EvaluateBatch, e.g., a lambda.*/
+class BoundaryFunctor : public BoundaryFunction
+{
+public:
+  typedef std::function<std::vector<double>(
+    const BoundaryFaceNodes&,
+    const std::vector<int>&,
+    const std::vector<chi_mesh::Vector3>&,
+    const std::vector<std::pair<double,double>>&,
+    const std::vector<int>&,
+    double)> Functor;
+
+private:
+  const Functor functor_;
+
+public:
+  explicit BoundaryFunctor(Functor functor) : functor_(std::move(functor)) {}
+
+  std::vector<double> Evaluate(
+    size_t cell_global_id,
+    int    cell_material_id,
+    unsigned int face_index,
+    unsigned int face_node_index,
+    const chi_mesh::Vector3& face_node_location,
+    const chi_mesh::Vector3& face_node_normal,
+    const std::vector<int>& quadrature_angle_indices,
+    const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+    const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+    const std::vector<int>& group_indices,
+    double time) override;
+
+  std::vector<double> EvaluateBatch(
+    const BoundaryFaceNodes& face_nodes,
+    const std::vector<int>& quadrature_angle_indices,
+    const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+    const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+    const std::vector<int>& group_indices,
+    double time) override;
+};
+
 //###################################################################
 /** Specified incident fluxes homogenous on a boundary.*/
 class BoundaryIncidentHeterogeneous : public SweepBoundary
 {
 private:
-  std::unique_ptr<BoundaryFunction> boundary_function_;
+  std::shared_ptr<BoundaryFunction> boundary_function_;
   const uint64_t ref_boundary_id_;
+  /**Identifies the boundary function and its parameters, such that a
+   * boundary built from the same ones can be reused with its fluxes.*/
+  std::string function_key_;
+
+  /**What the fluxes were evaluated for, the setup being skipped when
+   * nothing changed.*/
+  struct SetupKey
+  {
+    const chi_mesh::MeshContinuum* grid = nullptr;
+    size_t num_local_cells = 0;
+    std::vector<double> omegas; ///< Directions, x, y and z, one by one
+    double time = 0.0;
+
+    bool operator==(const SetupKey& other) const
+    {
+      return grid == other.grid and
+             num_local_cells == other.num_local_cells and
+             omegas == other.omegas and time == other.time;
+    }
+  };
+  SetupKey setup_key_;
+  bool is_setup_ = false;
 
   typedef std::vector<double>       FaceNodeData;
   typedef std::vector<FaceNodeData> FaceData;
   typedef std::vector<FaceData>     CellData;
 
   std::vector<CellData> local_cell_data_;
+  /**The fluxes evaluated at setup, scaled into local_cell_data_ by the
+   * time amplitudes. Only kept with a time table.*/
+  std::vector<CellData> reference_cell_data_;
 public:
   explicit
   BoundaryIncidentHeterogeneous(size_t in_num_groups,
-                               std::unique_ptr<BoundaryFunction> in_bndry_function,
+                               std::shared_ptr<BoundaryFunction> in_bndry_function,
                                uint64_t in_ref_boundary_id,
                                chi_math::CoordinateSystemType coord_type =
                                chi_math::CoordinateSystemType::CARTESIAN) :
@@ -244,6 +370,12 @@ public:
 
   void Setup(const chi_mesh::MeshContinuum &grid,
              const chi_math::AngularQuadrature &quadrature) override;
+
+  const std::string& FunctionKey() const {return function_key_;}
+  void SetFunctionKey(std::string key) {function_key_ = std::move(key);}
+
+protected:
+  void ApplyTimeAmplitudes() override;
 };
 
 }//namespace sweep_management
@@ -35,4 +35,34 @@ HeterogeneousPsiOutgoing(uint64_t cell_local_id,
        "that has no such information.";
   Chi::Exit(EXIT_FAILURE);
   return nullptr;
-}
\ No newline at end of file
+}
+//###################################################################
+/**Sets the time at which the boundary is evaluated. With a time table,
+ * the incident fluxes are scaled by its amplitudes at that time, without
+ * evaluating the boundary again.*/
+void chi_mesh::sweep_management::SweepBoundary::
+SetEvaluationTime(double time)
+{
+  evaluation_time_ = time;
+  if (not time_table_) return;
+
+  time_table_->EvaluateGroups(time, num_groups_, time_amplitudes_);
+  ApplyTimeAmplitudes();
+}
+
+//###################################################################
+/**Sets the amplitudes in time of the incident fluxes, the fluxes of the
+ * boundary being their shapes. The amplitudes are applied at the current
+ * evaluation time. A null table restores the unscaled fluxes.*/
+void chi_mesh::sweep_management::SweepBoundary::
+SetTimeTable(std::shared_ptr<const chi_math::TimeTable> time_table)
+{
+  time_table_ = std::move(time_table);
+  if (not time_table_ and not time_amplitudes_.empty())
+  {
+    time_amplitudes_.assign(num_groups_, 1.0);
+    ApplyTimeAmplitudes();
+    time_amplitudes_.clear();
+  }
+  SetEvaluationTime(evaluation_time_);
+}
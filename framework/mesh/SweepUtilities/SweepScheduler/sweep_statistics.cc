@@ -0,0 +1,174 @@
+#include "sweep_statistics.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace chi_mesh::sweep_management
+{
+
+namespace
+{
+constexpr size_t NUM_VALUES = 11;
+const char* const VALUE_NAMES[NUM_VALUES] = {"num_sweeps",
+                                             "sweep_time",
+                                             "compute_time",
+                                             "receive_time",
+                                             "send_time",
+                                             "upstream_wait_time",
+                                             "boundary_wait_time",
+                                             "num_messages_sent",
+                                             "num_bytes_sent",
+                                             "num_messages_received",
+                                             "num_bytes_received"};
+
+/**Gathers the values of every location, [location*NUM_VALUES + value],
+ * onto location 0.*/
+std::vector<double> GatherValues(const SweepStatistics& statistics)
+{
+  const double local_values[NUM_VALUES] = {
+    static_cast<double>(statistics.num_sweeps),
+    statistics.sweep_time,
+    statistics.compute_time,
+    statistics.receive_time,
+    statistics.send_time,
+    statistics.upstream_wait_time,
+    statistics.boundary_wait_time,
+    static_cast<double>(statistics.num_messages_sent),
+    static_cast<double>(statistics.num_bytes_sent),
+    static_cast<double>(statistics.num_messages_received),
+    static_cast<double>(statistics.num_bytes_received)};
+
+  std::vector<double> all_values;
+  if (Chi::mpi.location_id == 0)
+    all_values.resize(NUM_VALUES * Chi::mpi.process_count);
+
+  MPI_Gather(local_values, NUM_VALUES, MPI_DOUBLE,
+             all_values.data(), NUM_VALUES, MPI_DOUBLE, 0, Chi::mpi.comm);
+  return all_values;
+}
+
+/**The compute time summed over the locations divided by the number of
+ * locations times the longest sweep time.*/
+double MeasuredEfficiency(const std::vector<double>& all_values)
+{
+  const size_t num_locations = all_values.size() / NUM_VALUES;
+  double total_compute_time = 0.0;
+  double max_sweep_time = 0.0;
+  for (size_t p = 0; p < num_locations; ++p)
+  {
+    max_sweep_time = std::max(max_sweep_time, all_values[p * NUM_VALUES + 1]);
+    total_compute_time += all_values[p * NUM_VALUES + 2];
+  }
+
+  if (max_sweep_time <= 0.0) return 0.0;
+  return total_compute_time /
+         (static_cast<double>(num_locations) * max_sweep_time);
+}
+} // namespace
+
+// ###################################################################
+void SweepStatistics::Reset()
+{
+  const double ideal = ideal_efficiency;
+  *this = SweepStatistics();
+  ideal_efficiency = ideal;
+}
+
+// ###################################################################
+void SweepStatistics::LogReport(const std::string& label) const
+{
+  const auto all_values = GatherValues(*this);
+  if (Chi::mpi.location_id != 0) return;
+
+  const size_t num_locations = all_values.size() / NUM_VALUES;
+
+  std::stringstream outstr;
+  outstr << label << " sweep statistics, per sweep over "
+         << num_locations << " location(s):\n";
+  outstr << std::left << std::setw(24) << "Quantity" << std::right
+         << std::setw(14) << "Min" << std::setw(14) << "Average"
+         << std::setw(14) << "Max" << std::setw(10) << "Loc-max" << "\n";
+  for (size_t v = 1; v < NUM_VALUES; ++v)
+  {
+    double min_value = 0.0;
+    double max_value = 0.0;
+    double avg_value = 0.0;
+    size_t max_location = 0;
+    for (size_t p = 0; p < num_locations; ++p)
+    {
+      const double num_sweeps = all_values[p * NUM_VALUES];
+      const double value =
+        num_sweeps > 0.0 ? all_values[p * NUM_VALUES + v] / num_sweeps : 0.0;
+
+      if (p == 0 or value < min_value) min_value = value;
+      if (p == 0 or value > max_value)
+      {
+        max_value = value;
+        max_location = p;
+      }
+      avg_value += value / static_cast<double>(num_locations);
+    }
+
+    outstr << std::left << std::setw(24) << VALUE_NAMES[v] << std::right
+           << std::setprecision(4) << std::setw(14) << min_value
+           << std::setw(14) << avg_value << std::setw(14) << max_value
+           << std::setw(10) << max_location << "\n";
+  }
+
+  outstr << "Parallel efficiency (measured/ideal): "
+         << MeasuredEfficiency(all_values) << " / ";
+  if (ideal_efficiency >= 0.0) outstr << ideal_efficiency;
+  else
+    outstr << "unknown";
+
+  Chi::log.Log() << outstr.str();
+}
+
+// ###################################################################
+void SweepStatistics::ExportJSON(const std::string& file_name) const
+{
+  const auto all_values = GatherValues(*this);
+  if (Chi::mpi.location_id != 0) return;
+
+  std::ofstream ofile(file_name, std::ofstream::out);
+  if (not ofile.is_open())
+  {
+    Chi::log.LogAllWarning() << "SweepStatistics: failed to open \""
+                             << file_name << "\" for writing.";
+    return;
+  }
+
+  const size_t num_locations = all_values.size() / NUM_VALUES;
+
+  ofile << std::setprecision(10);
+  ofile << "{\n"
+        << "  \"num_locations\": " << num_locations << ",\n"
+        << "  \"measured_efficiency\": " << MeasuredEfficiency(all_values)
+        << ",\n"
+        << "  \"ideal_efficiency\": ";
+  if (ideal_efficiency >= 0.0) ofile << ideal_efficiency;
+  else
+    ofile << "null";
+  ofile << ",\n"
+        << "  \"locations\": [\n";
+
+  for (size_t p = 0; p < num_locations; ++p)
+  {
+    ofile << "    {\"location\": " << p;
+    for (size_t v = 0; v < NUM_VALUES; ++v)
+      ofile << ", \"" << VALUE_NAMES[v]
+            << "\": " << all_values[p * NUM_VALUES + v];
+    ofile << "}" << (p + 1 < num_locations ? "," : "") << "\n";
+  }
+  ofile << "  ]\n"
+        << "}\n";
+}
+
+} // namespace chi_mesh::sweep_management
@@ -0,0 +1,99 @@
+#ifndef CHITECH_SWEEP_STATISTICS_H
+#define CHITECH_SWEEP_STATISTICS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace chi_mesh::sweep_management
+{
+
+// ###################################################################
+/**Breakdown of the sweeps of a scheduler on this location, collected
+ * when instrumentation is enabled on the scheduler (see
+ * SweepScheduler::EnableSweepStatistics). Times are in seconds and are
+ * accumulated over all the sweeps since the last Reset.
+ *
+ * The stalled time, during which no angle set can execute, is attributed
+ * to the upstream wait unless every blocked angle set had received its
+ * upstream data and was only waiting on reflecting boundaries. It
+ * includes the probing for messages during the stalled passes. Messages
+ * and bytes count the MPI point-to-point traffic of the angular fluxes,
+ * i.e., shared-memory exchanges are excluded.*/
+struct SweepStatistics
+{
+  size_t num_sweeps = 0;
+  double sweep_time = 0.0;         ///< Wall time of the sweeps
+  double compute_time = 0.0;       ///< Sweep chunk executions
+  double receive_time = 0.0;       ///< Probing and receiving upstream psi
+  double send_time = 0.0;          ///< Posting and completing the sends
+  double upstream_wait_time = 0.0; ///< Stalled on upstream locations
+  double boundary_wait_time = 0.0; ///< Stalled on reflecting boundaries
+
+  size_t num_messages_sent = 0;
+  size_t num_bytes_sent = 0;
+  size_t num_messages_received = 0;
+  size_t num_bytes_received = 0;
+
+  /**Estimate of the ideal parallel efficiency of the sweeps, set by the
+   * scheduler (see SweepScheduler::EnableSweepStatistics). Negative when
+   * unknown.*/
+  double ideal_efficiency = -1.0;
+
+  /**Blocking state of the angle sets in the current scheduling pass.*/
+  bool upstream_blocked_in_pass = false;
+  bool boundary_blocked_in_pass = false;
+
+  void CountSentMessage(size_t num_bytes)
+  {
+    ++num_messages_sent;
+    num_bytes_sent += num_bytes;
+  }
+  void CountReceivedMessage(size_t num_bytes)
+  {
+    ++num_messages_received;
+    num_bytes_received += num_bytes;
+  }
+
+  /**Zeroes the accumulated quantities. The ideal efficiency is kept.*/
+  void Reset();
+
+  /**Logs the minimum, average and maximum over the locations of the
+   * per-sweep quantities, with the location attaining the maximum, and
+   * the measured against the ideal parallel efficiency. Collective.*/
+  void LogReport(const std::string& label) const;
+
+  /**Writes the quantities of every location, and the efficiencies, to the
+   * given JSON file from location 0. Collective.*/
+  void ExportJSON(const std::string& file_name) const;
+};
+
+// ###################################################################
+/**Adds the duration of its scope, in seconds, to the given time. Does
+ * nothing for a null time, i.e., when the statistics are disabled.*/
+class ScopedSweepTimer
+{
+private:
+  typedef std::chrono::steady_clock Clock;
+  double* const time_;
+  Clock::time_point start_time_;
+
+public:
+  explicit ScopedSweepTimer(double* time) : time_(time)
+  {
+    if (time_) start_time_ = Clock::now();
+  }
+  ~ScopedSweepTimer()
+  {
+    if (not time_) return;
+    const std::chrono::duration<double> duration = Clock::now() - start_time_;
+    *time_ += duration.count();
+  }
+
+  ScopedSweepTimer(const ScopedSweepTimer&) = delete;
+  ScopedSweepTimer& operator=(const ScopedSweepTimer&) = delete;
+};
+
+} // namespace chi_mesh::sweep_management
+
+#endif // CHITECH_SWEEP_STATISTICS_H
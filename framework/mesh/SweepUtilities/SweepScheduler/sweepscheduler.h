@@ -3,6 +3,10 @@
 
 #include "mesh/SweepUtilities/AngleAggregation/angleaggregation.h"
 #include "mesh/SweepUtilities/sweepchunk_base.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
+#include "utils/chi_profiler.h"
+
+#include <functional>
 
 
 namespace chi_mesh::sweep_management
@@ -10,7 +14,9 @@ namespace chi_mesh::sweep_management
   enum class SchedulingAlgorithm
   {
     FIRST_IN_FIRST_OUT = 1, ///< FIFO
-    DEPTH_OF_GRAPH = 2      ///< DOG
+    DEPTH_OF_GRAPH = 2,     ///< DOG
+    B_LEVEL = 3,            ///< Cell weighted critical path to the sweep end
+    FARTHEST_FIRST = 4      ///< Distance along omega to the domain end
   };
 }
 
@@ -34,12 +40,14 @@ private:
     int        sign_of_omegay;
     int        sign_of_omegaz;
     size_t     set_index;
+    double     priority;
 
     explicit RULE_VALUES(std::shared_ptr<TAngleSet>& ref_as) :
       angle_set(ref_as)
     {
       depth_of_graph = 0;
       set_index      = 0;
+      priority       = 0.0;
       sign_of_omegax = 1;
       sign_of_omegay = 1;
       sign_of_omegaz = 1;
@@ -48,9 +56,34 @@ private:
   std::vector<RULE_VALUES> rule_values_;
 
   SweepChunk& sweep_chunk_;
-  const size_t sweep_event_tag_;
-  const std::vector<size_t> sweep_timing_events_tag_;
-
+  /**Durations, in seconds, of the sweeps and of the sweep chunk
+   * executions.*/
+  chi::RunningStatistics sweep_timing_;
+  chi::RunningStatistics chunk_timing_;
+  double sweep_start_time_ = 0.0;
+
+  /**Additional sweep chunks, one per extra thread, used to execute ready
+   * angle sets concurrently. Each worker accumulates flux moments into
+   * its own buffer which is reduced into the primary destination phi at
+   * the end of a sweep.*/
+  std::vector<std::shared_ptr<SweepChunk>> worker_chunks_;
+  std::vector<std::vector<double>> worker_destination_phis_;
+
+  std::vector<std::shared_ptr<TAngleSet>> ready_angle_sets_;
+
+  /**Work performed whilst no angle set is ready to execute, i.e. whilst
+   * waiting on upstream data. Returns true when it did any work.*/
+  std::function<bool()> idle_work_function_;
+  bool executed_in_pass_ = false;
+  double sweep_idle_time_ = 0.0;
+  double sweep_idle_work_time_ = 0.0;
+  double total_idle_time_ = 0.0;
+  double total_idle_work_time_ = 0.0;
+
+  /**Per-location sweep breakdown, collected only when enabled.*/
+  bool sweep_statistics_enabled_ = false;
+  SweepStatistics sweep_statistics_;
+  double sweep_begin_chunk_time_ = 0.0;
 
 public:
   SweepScheduler(SchedulingAlgorithm in_scheduler_type,
@@ -59,19 +92,54 @@ public:
 
   AngleAggregation& AngleAgg() {return angle_agg_;}
 
-  size_t SweepEventTag() const {return sweep_event_tag_;}
+  const chi::RunningStatistics& GetSweepTiming() const {return sweep_timing_;}
 
   void Sweep();
+  static void SweepConcurrently(const std::vector<SweepScheduler*>& schedulers);
   double GetAverageSweepTime() const;
   std::vector<double> GetAngleSetTimings();
+  std::vector<double> GetIdleTimings() const;
   SweepChunk& GetSweepChunk();
 
+  void SetWorkerSweepChunks(
+    std::vector<std::shared_ptr<SweepChunk>> worker_chunks);
+  size_t NumSweepThreads() const {return worker_chunks_.size() + 1;}
+
+  void SetIdleWorkFunction(std::function<bool()> idle_work_function);
+
+  void EnableSweepStatistics(bool flag);
+  bool SweepStatisticsEnabled() const {return sweep_statistics_enabled_;}
+  SweepStatistics& GetSweepStatistics() {return sweep_statistics_;}
+
 private:
   void ScheduleAlgoFIFO(SweepChunk& sweep_chunk);
+  bool AdvanceAngleSetsFIFO(SweepChunk& sweep_chunk);
 
   //02
   void InitializeAlgoDOG();
   void ScheduleAlgoDOG(SweepChunk& sweep_chunk);
+  bool AdvanceAngleSetsDOG(SweepChunk& sweep_chunk);
+
+  //05 common stages
+  void BeginSweepEvent();
+  void EndSweepEvent();
+  bool AdvanceAngleSets();
+  void ProcessStalledPass(double pass_start_time);
+  bool ReceiveDelayedData();
+  void ResetSweepBuffers();
+  double ComputeIdealSweepEfficiency();
+
+  //04 threaded execution
+  void InitializeWorkerChunks();
+  void ExecuteAngleSetsThreaded(
+    const std::vector<std::shared_ptr<TAngleSet>>& angle_sets);
+  void ReduceWorkerDestinationPhis();
+
+  //06 angle teams
+  static void BeginAngleTeamSweep(
+    const std::vector<SweepScheduler*>& schedulers);
+  static void ReduceAngleTeamFluxes(
+    const std::vector<SweepScheduler*>& schedulers);
 
   //03 utils
 public:
@@ -0,0 +1,83 @@
+#include "sweepscheduler.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <set>
+
+namespace chi_mesh::sweep_management
+{
+
+namespace
+{
+/**Returns the distinct destination vectors of the schedulers, since
+ * schedulers of different groupsets may share their flux moments.*/
+template <typename GetVector>
+std::vector<std::vector<double>*>
+  UniqueDestinations(const std::vector<SweepScheduler*>& schedulers,
+                     const GetVector& get_vector)
+{
+  std::vector<std::vector<double>*> destinations;
+  std::set<std::vector<double>*> visited;
+  for (auto scheduler : schedulers)
+  {
+    std::vector<double>* destination = &get_vector(*scheduler);
+    if (visited.insert(destination).second)
+      destinations.push_back(destination);
+  }
+  return destinations;
+}
+
+auto GetPhi = [](SweepScheduler& scheduler) -> std::vector<double>&
+{ return scheduler.GetDestinationPhi(); };
+auto GetPsi = [](SweepScheduler& scheduler) -> std::vector<double>&
+{ return scheduler.GetDestinationPsi(); };
+} // namespace
+
+// ###################################################################
+/**Prepares the destination fluxes for a sweep split over angle teams. The
+ * sweeps of the teams add their angles' contributions to the flux moments,
+ * which are summed over the teams after the sweep, hence only the first
+ * team keeps the flux moments it had before the sweep. The angular fluxes
+ * are overwritten by the sweep of the team owning their angle and are
+ * zeroed on every team.*/
+void SweepScheduler::BeginAngleTeamSweep(
+  const std::vector<SweepScheduler*>& schedulers)
+{
+  if (Chi::mpi.num_angle_teams == 1) return;
+
+  if (Chi::mpi.angle_team_id != 0)
+    for (auto phi : UniqueDestinations(schedulers, GetPhi))
+      phi->assign(phi->size(), 0.0);
+
+  for (auto psi : UniqueDestinations(schedulers, GetPsi))
+    psi->assign(psi->size(), 0.0);
+}
+
+// ###################################################################
+/**Sums the destination flux moments and angular fluxes over the angle
+ * teams, such that every team has the fluxes of all the angles.*/
+void SweepScheduler::ReduceAngleTeamFluxes(
+  const std::vector<SweepScheduler*>& schedulers)
+{
+  if (Chi::mpi.num_angle_teams == 1) return;
+  ChiProfileRegion("Angle team reduction");
+
+  auto Reduce = [](std::vector<double>& destination)
+  {
+    if (destination.empty()) return;
+    MPI_Allreduce(MPI_IN_PLACE,
+                  destination.data(),
+                  static_cast<int>(destination.size()),
+                  MPI_DOUBLE,
+                  MPI_SUM,
+                  Chi::mpi.cross_team_comm);
+  };
+
+  for (auto phi : UniqueDestinations(schedulers, GetPhi))
+    Reduce(*phi);
+  for (auto psi : UniqueDestinations(schedulers, GetPsi))
+    Reduce(*psi);
+}
+
+} // namespace chi_mesh::sweep_management
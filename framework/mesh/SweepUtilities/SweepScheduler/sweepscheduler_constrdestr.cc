@@ -11,16 +11,12 @@ chi_mesh::sweep_management::SweepScheduler::SweepScheduler(
   SweepChunk& in_sweep_chunk)
   : scheduler_type_(in_scheduler_type),
     angle_agg_(in_angle_agg),
-    sweep_chunk_(in_sweep_chunk),
-    sweep_event_tag_(Chi::log.GetRepeatingEventTag("Sweep Timing")),
-    sweep_timing_events_tag_(
-      {Chi::log.GetRepeatingEventTag("Sweep Chunk Only Timing"),
-       sweep_event_tag_})
-
+    sweep_chunk_(in_sweep_chunk)
 {
   angle_agg_.InitializeReflectingBCs();
 
-  if (scheduler_type_ == SchedulingAlgorithm::DEPTH_OF_GRAPH)
+  // The priority based algorithms share the Depth-Of-Graph machinery
+  if (scheduler_type_ != SchedulingAlgorithm::FIRST_IN_FIRST_OUT)
     InitializeAlgoDOG();
 
   //=================================== Initialize delayed upstream data
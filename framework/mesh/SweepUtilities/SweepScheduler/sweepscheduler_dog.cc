@@ -8,9 +8,12 @@
 
 #include <sstream>
 #include <algorithm>
+#include <tuple>
 
 // ###################################################################
-/**Initializes the Depth-Of-Graph algorithm.*/
+/**Initializes the Depth-Of-Graph algorithm. The B-level and
+ * Farthest-First algorithms use the same rule values with a precomputed
+ * priority as the primary sort key.*/
 void chi_mesh::sweep_management::SweepScheduler::InitializeAlgoDOG()
 {
   //================================================== Load all anglesets
@@ -58,6 +61,11 @@ void chi_mesh::sweep_management::SweepScheduler::InitializeAlgoDOG()
         new_rule_vals.sign_of_omegay = (omega.y >= 0) ? 2 : 1;
         new_rule_vals.sign_of_omegaz = (omega.z >= 0) ? 2 : 1;
 
+        if (scheduler_type_ == SchedulingAlgorithm::B_LEVEL)
+          new_rule_vals.priority = spds.GetLocationBLevel();
+        else if (scheduler_type_ == SchedulingAlgorithm::FARTHEST_FIRST)
+          new_rule_vals.priority = spds.GetLocationDownstreamDistance();
+
         rule_values_.push_back(new_rule_vals);
       }
       else
@@ -109,6 +117,24 @@ void chi_mesh::sweep_management::SweepScheduler::InitializeAlgoDOG()
     }
   } compare_omega_z;
 
+  //================================================== Sort by priority
+  // Ties are broken by depth-of-graph and then the signs of omega
+  if (scheduler_type_ != SchedulingAlgorithm::DEPTH_OF_GRAPH)
+  {
+    auto compare_priority = [](const RULE_VALUES& a, const RULE_VALUES& b)
+    {
+      if (a.priority != b.priority) return a.priority > b.priority;
+      if (a.depth_of_graph != b.depth_of_graph)
+        return a.depth_of_graph > b.depth_of_graph;
+      return std::tie(a.sign_of_omegax, a.sign_of_omegay, a.sign_of_omegaz) >
+             std::tie(b.sign_of_omegax, b.sign_of_omegay, b.sign_of_omegaz);
+    };
+
+    std::stable_sort(rule_values_.begin(), rule_values_.end(),
+                     compare_priority);
+    return;
+  }
+
   //================================================== Sort
   std::stable_sort(rule_values_.begin(), rule_values_.end(), compare_D);
   std::stable_sort(rule_values_.begin(), rule_values_.end(), compare_omega_x);
@@ -121,109 +147,94 @@ void chi_mesh::sweep_management::SweepScheduler::InitializeAlgoDOG()
 void chi_mesh::sweep_management::SweepScheduler::ScheduleAlgoDOG(
   SweepChunk& sweep_chunk)
 {
-  typedef ExecutionPermission ExePerm;
-  typedef AngleSetStatus Status;
-
-  Chi::log.LogEvent(sweep_event_tag_, chi::ChiLog::EventType::EVENT_BEGIN);
-
-  auto ev_info =
-    std::make_shared<chi::ChiLog::EventInfo>(std::string("Sweep initiated"));
-
-  Chi::log.LogEvent(
-    sweep_event_tag_, chi::ChiLog::EventType::SINGLE_OCCURRENCE, ev_info);
+  BeginSweepEvent();
 
   //==================================================== Loop till done
   bool finished = false;
-  size_t scheduled_angleset = 0;
   while (!finished)
   {
-    finished = true;
-    for (auto& rule_value : rule_values_)
-    {
-      auto angleset = rule_value.angle_set;
-
-      //=============================== Query angleset status
-      // Status will here be one of the following:
-      //  - RECEIVING.
-      //      Meaning it is either waiting for messages or actively receiving it
-      //  - READY_TO_EXECUTE.
-      //      Meaning it has received all upstream data and can be executed
-      //  - FINISHED.
-      //      Meaning the angleset has executed its sweep chunk
-      Status status = angleset->AngleSetAdvance(sweep_chunk,
-                                                sweep_timing_events_tag_,
-                                                ExePerm::NO_EXEC_IF_READY);
-
-      //=============================== Execute if ready and allowed
-      // If this angleset is the one scheduled to run
-      // and it is ready then it will be given permission
-      if (status == Status::READY_TO_EXECUTE)
-      {
-        std::stringstream message_i;
-        message_i << "Angleset " << angleset->GetID() << " executed on location "
-                  << Chi::mpi.location_id;
-
-        auto ev_info_i =
-          std::make_shared<chi::ChiLog::EventInfo>(message_i.str());
-
-        Chi::log.LogEvent(sweep_event_tag_,
-                          chi::ChiLog::EventType::SINGLE_OCCURRENCE,
-                          ev_info_i);
-
-        status = angleset->AngleSetAdvance(sweep_chunk,
-                                           sweep_timing_events_tag_,
-                                           ExePerm::EXECUTE);
-
-        std::stringstream message_f;
-        message_f << "Angleset " << angleset->GetID() << " finished on location "
-                  << Chi::mpi.location_id;
-
-        auto ev_info_f =
-          std::make_shared<chi::ChiLog::EventInfo>(message_f.str());
-
-        Chi::log.LogEvent(sweep_event_tag_,
-                          chi::ChiLog::EventType::SINGLE_OCCURRENCE,
-                          ev_info_f);
-
-        scheduled_angleset++; // Schedule the next angleset
-      }
-
-      if (status != Status::FINISHED) finished = false;
-    } // for each angleset rule
-  }   // while not finished
+    const double pass_start_time = MPI_Wtime();
+    finished = AdvanceAngleSetsDOG(sweep_chunk);
+    if (not finished and not executed_in_pass_)
+      ProcessStalledPass(pass_start_time);
+  }
 
   //================================================== Receive delayed data
-  Chi::mpi.Barrier();
-  bool received_delayed_data = false;
-  while (not received_delayed_data)
   {
-    received_delayed_data = true;
-
-    for (auto& angle_set_group : angle_agg_.angle_set_groups)
-      for (auto& angle_set : angle_set_group.AngleSets())
-      {
-        if (angle_set->FlushSendBuffers() == Status::MESSAGES_PENDING)
-          received_delayed_data = false;
-
-        if (not angle_set->ReceiveDelayedData())
-          received_delayed_data = false;
-      }
+    ChiProfileRegion("Delayed data");
+    Chi::mpi.Barrier();
+    bool received_delayed_data = false;
+    while (not received_delayed_data)
+      received_delayed_data = ReceiveDelayedData();
   }
 
   //================================================== Reset all
-  for (auto& angle_set_group : angle_agg_.angle_set_groups)
-    for (auto& angle_set : angle_set_group.AngleSets())
-      angle_set->ResetSweepBuffers();
+  ResetSweepBuffers();
+
+  EndSweepEvent();
+}
+
+// ###################################################################
+/**Advances every angle set once, in Depth-Of-Graph priority order,
+ * executing those that are ready. Returns true when all the angle sets
+ * have finished.*/
+bool chi_mesh::sweep_management::SweepScheduler::AdvanceAngleSetsDOG(
+  SweepChunk& sweep_chunk)
+{
+  typedef ExecutionPermission ExePerm;
+  typedef AngleSetStatus Status;
 
-  for (auto& [bid, bndry] : angle_agg_.sim_boundaries)
+  const bool threaded = not worker_chunks_.empty();
+  bool finished = true;
+  executed_in_pass_ = false;
+  ready_angle_sets_.clear();
+  sweep_statistics_.upstream_blocked_in_pass = false;
+  sweep_statistics_.boundary_blocked_in_pass = false;
+  for (auto& rule_value : rule_values_)
   {
-    if (bndry->Type() == chi_mesh::sweep_management::BoundaryType::REFLECTING)
+    auto angleset = rule_value.angle_set;
+
+    //=============================== Query angleset status
+    // Status will here be one of the following:
+    //  - RECEIVING.
+    //      Meaning it is either waiting for messages or actively receiving it
+    //  - READY_TO_EXECUTE.
+    //      Meaning it has received all upstream data and can be executed
+    //  - FINISHED.
+    //      Meaning the angleset has executed its sweep chunk
+    Status status = angleset->AngleSetAdvance(sweep_chunk,
+                                              chunk_timing_,
+                                              ExePerm::NO_EXEC_IF_READY);
+
+    //=============================== Defer to the threaded batch
+    // Ready anglesets are collected in priority order and executed
+    // together once all anglesets have been queried.
+    if (status == Status::READY_TO_EXECUTE and threaded)
+    {
+      ready_angle_sets_.push_back(angleset);
+      finished = false;
+      continue;
+    }
+
+    //=============================== Execute if ready and allowed
+    // If this angleset is the one scheduled to run
+    // and it is ready then it will be given permission
+    if (status == Status::READY_TO_EXECUTE)
     {
-      auto rbndry = std::static_pointer_cast<
-        chi_mesh::sweep_management::BoundaryReflecting>(bndry);
-      rbndry->ResetAnglesReadyStatus();
+      status = angleset->AngleSetAdvance(sweep_chunk,
+                                         chunk_timing_,
+                                         ExePerm::EXECUTE);
+      executed_in_pass_ = true;
     }
+
+    if (status != Status::FINISHED) finished = false;
+  } // for each angleset rule
+
+  if (not ready_angle_sets_.empty())
+  {
+    ExecuteAngleSetsThreaded(ready_angle_sets_);
+    executed_in_pass_ = true;
   }
 
-  Chi::log.LogEvent(sweep_event_tag_, chi::ChiLog::EventType::EVENT_END);
-}
\ No newline at end of file
+  return finished;
+}
@@ -2,70 +2,84 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 // ###################################################################
 /**Applies a First-In-First-Out sweep scheduling.*/
 void chi_mesh::sweep_management::SweepScheduler::ScheduleAlgoFIFO(
   SweepChunk& sweep_chunk)
 {
-  typedef AngleSetStatus Status;
-
-  Chi::log.LogEvent(sweep_event_tag_, chi::ChiLog::EventType::EVENT_BEGIN);
-
-  auto ev_info_i =
-    std::make_shared<chi::ChiLog::EventInfo>(std::string("Sweep initiated"));
-
-  Chi::log.LogEvent(
-    sweep_event_tag_, chi::ChiLog::EventType::SINGLE_OCCURRENCE, ev_info_i);
+  BeginSweepEvent();
 
   //================================================== Loop over AngleSetGroups
-  AngleSetStatus completion_status = AngleSetStatus::NOT_FINISHED;
-  while (completion_status == AngleSetStatus::NOT_FINISHED)
+  bool finished = false;
+  while (not finished)
   {
-    completion_status = AngleSetStatus::FINISHED;
-
-    for (auto& angle_set_group : angle_agg_.angle_set_groups)
-      for (auto& angle_set : angle_set_group.AngleSets())
-      {
-        const auto angle_set_status = angle_set->AngleSetAdvance(
-          sweep_chunk, sweep_timing_events_tag_, ExecutionPermission::EXECUTE);
-        if (angle_set_status == AngleSetStatus::NOT_FINISHED)
-          completion_status = AngleSetStatus::NOT_FINISHED;
-      }// for angleset
-  }// while not finished
+    const double pass_start_time = MPI_Wtime();
+    finished = AdvanceAngleSetsFIFO(sweep_chunk);
+    if (not finished and not executed_in_pass_)
+      ProcessStalledPass(pass_start_time);
+  }
 
   //================================================== Receive delayed data
-  Chi::mpi.Barrier();
-  bool received_delayed_data = false;
-  while (not received_delayed_data)
   {
-    received_delayed_data = true;
-
-    for (auto& angle_set_group : angle_agg_.angle_set_groups)
-      for (auto& angle_set : angle_set_group.AngleSets())
-      {
-        if (angle_set->FlushSendBuffers() == Status::MESSAGES_PENDING)
-          received_delayed_data = false;
-
-        if (not angle_set->ReceiveDelayedData())
-          received_delayed_data = false;
-      }
+    ChiProfileRegion("Delayed data");
+    Chi::mpi.Barrier();
+    bool received_delayed_data = false;
+    while (not received_delayed_data)
+      received_delayed_data = ReceiveDelayedData();
   }
 
   //================================================== Reset all
+  ResetSweepBuffers();
+
+  EndSweepEvent();
+}
+
+// ###################################################################
+/**Advances every angle set once, in FIFO order, executing those that are
+ * ready. Returns true when all the angle sets have finished.*/
+bool chi_mesh::sweep_management::SweepScheduler::AdvanceAngleSetsFIFO(
+  SweepChunk& sweep_chunk)
+{
+  const bool threaded = not worker_chunks_.empty();
+
+  AngleSetStatus completion_status = AngleSetStatus::FINISHED;
+
+  executed_in_pass_ = false;
+  ready_angle_sets_.clear();
+  sweep_statistics_.upstream_blocked_in_pass = false;
+  sweep_statistics_.boundary_blocked_in_pass = false;
   for (auto& angle_set_group : angle_agg_.angle_set_groups)
     for (auto& angle_set : angle_set_group.AngleSets())
-      angle_set->ResetSweepBuffers();
+    {
+      auto angle_set_status =
+        angle_set->AngleSetAdvance(sweep_chunk,
+                                   chunk_timing_,
+                                   ExecutionPermission::NO_EXEC_IF_READY);
+      if (angle_set_status == AngleSetStatus::READY_TO_EXECUTE and threaded)
+      {
+        ready_angle_sets_.push_back(angle_set);
+        completion_status = AngleSetStatus::NOT_FINISHED;
+        continue;
+      }
+      if (angle_set_status == AngleSetStatus::READY_TO_EXECUTE)
+      {
+        angle_set_status =
+          angle_set->AngleSetAdvance(sweep_chunk,
+                                     chunk_timing_,
+                                     ExecutionPermission::EXECUTE);
+        executed_in_pass_ = true;
+      }
+      if (angle_set_status != AngleSetStatus::FINISHED)
+        completion_status = AngleSetStatus::NOT_FINISHED;
+    }// for angleset
 
-  for (auto& [bid, bndry] : angle_agg_.sim_boundaries)
+  if (not ready_angle_sets_.empty())
   {
-    if (bndry->Type() == chi_mesh::sweep_management::BoundaryType::REFLECTING)
-    {
-      auto rbndry = std::static_pointer_cast<
-        chi_mesh::sweep_management::BoundaryReflecting>(bndry);
-      rbndry->ResetAnglesReadyStatus();
-    }
+    ExecuteAngleSetsThreaded(ready_angle_sets_);
+    executed_in_pass_ = true;
   }
 
-  Chi::log.LogEvent(sweep_event_tag_, chi::ChiLog::EventType::EVENT_END);
-}
\ No newline at end of file
+  return completion_status == AngleSetStatus::FINISHED;
+}
@@ -0,0 +1,58 @@
+#include "sweepscheduler.h"
+
+#include "mesh/SweepUtilities/SPDS/SPDS_AdamsAdamsHawkins.h"
+
+#include <algorithm>
+
+namespace chi_mesh::sweep_management
+{
+
+// ###################################################################
+/**Enables, or disables, the collection of the per-location sweep
+ * statistics by this scheduler, its angle sets and their communicators.
+ * Enabling resets the statistics. Disabled statistics cost a null check
+ * per instrumented operation.*/
+void SweepScheduler::EnableSweepStatistics(bool flag)
+{
+  sweep_statistics_enabled_ = flag;
+  if (flag)
+  {
+    sweep_statistics_.ideal_efficiency = ComputeIdealSweepEfficiency();
+    sweep_statistics_.Reset();
+  }
+
+  SweepStatistics* statistics = flag ? &sweep_statistics_ : nullptr;
+  for (auto& angle_set_group : angle_agg_.angle_set_groups)
+    for (auto& angle_set : angle_set_group.AngleSets())
+      angle_set->SetSweepStatistics(statistics);
+}
+
+// ###################################################################
+/**Estimates the parallel efficiency of an ideal KBA pipeline. The n angle
+ * sets of the aggregation stream through the D stages of the deepest
+ * location graph, each angle set taking one stage time per location,
+ * hence a sweep takes n + D - 1 stages of which n are busy on every
+ * location, i.e., the efficiency is n/(n + D - 1). Returns -1 when the
+ * location graphs are unknown, i.e., for non-AAH sweep orderings.*/
+double SweepScheduler::ComputeIdealSweepEfficiency()
+{
+  size_t num_angle_sets = 0;
+  size_t max_depth = 1;
+  for (auto& angle_set_group : angle_agg_.angle_set_groups)
+    for (const auto& angle_set : angle_set_group.AngleSets())
+    {
+      const auto spds =
+        dynamic_cast<const SPDS_AdamsAdamsHawkins*>(&angle_set->GetSPDS());
+      if (spds == nullptr) return -1.0;
+
+      max_depth = std::max(max_depth, spds->GetGlobalSweepPlanes().size());
+      ++num_angle_sets;
+    }
+
+  if (num_angle_sets == 0) return -1.0;
+
+  const auto n = static_cast<double>(num_angle_sets);
+  return n / (n + static_cast<double>(max_depth) - 1.0);
+}
+
+} // namespace chi_mesh::sweep_management
@@ -2,31 +2,229 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <sstream>
 
 //###################################################################
 /**This is the entry point for sweeping.*/
 void chi_mesh::sweep_management::SweepScheduler::
      Sweep()
 {
+  ChiProfileRegion("Sweep");
+  BeginAngleTeamSweep({this});
+  if (not worker_chunks_.empty()) InitializeWorkerChunks();
+
   if (scheduler_type_ == SchedulingAlgorithm::FIRST_IN_FIRST_OUT)
     ScheduleAlgoFIFO(sweep_chunk_);
-  else if (scheduler_type_ == SchedulingAlgorithm::DEPTH_OF_GRAPH)
+  else
     ScheduleAlgoDOG(sweep_chunk_);
+
+  if (not worker_chunks_.empty()) ReduceWorkerDestinationPhis();
+  ReduceAngleTeamFluxes({this});
+}
+
+//###################################################################
+/**Sweeps the angle sets of several schedulers, e.g. those of different
+ * groupsets, in a single scheduling loop. Angle sets of one scheduler
+ * execute whilst those of another are waiting on upstream data, so that
+ * the pipeline fill and drain of the sweeps overlap. The angle sets of the
+ * schedulers must have distinct ids (message tags) and must not couple
+ * through reflecting boundaries.*/
+void chi_mesh::sweep_management::SweepScheduler::
+  SweepConcurrently(const std::vector<SweepScheduler*>& schedulers)
+{
+  ChiProfileRegion("Sweep");
+  BeginAngleTeamSweep(schedulers);
+  for (auto scheduler : schedulers)
+  {
+    if (not scheduler->worker_chunks_.empty())
+      scheduler->InitializeWorkerChunks();
+    scheduler->BeginSweepEvent();
+  }
+
+  //================================================== Loop till done
+  bool finished = false;
+  while (not finished)
+  {
+    const double pass_start_time = MPI_Wtime();
+    finished = true;
+    bool executed_in_pass = false;
+    for (auto scheduler : schedulers)
+    {
+      if (not scheduler->AdvanceAngleSets()) finished = false;
+      if (scheduler->executed_in_pass_) executed_in_pass = true;
+    }
+
+    if (not finished and not executed_in_pass)
+      for (auto scheduler : schedulers)
+        scheduler->ProcessStalledPass(pass_start_time);
+  }
+
+  //================================================== Receive delayed data
+  {
+    ChiProfileRegion("Delayed data");
+    Chi::mpi.Barrier();
+    bool received_delayed_data = false;
+    while (not received_delayed_data)
+    {
+      received_delayed_data = true;
+      for (auto scheduler : schedulers)
+        if (not scheduler->ReceiveDelayedData())
+          received_delayed_data = false;
+    }
+  }
+
+  //================================================== Reset all
+  for (auto scheduler : schedulers)
+  {
+    scheduler->ResetSweepBuffers();
+
+    if (not scheduler->worker_chunks_.empty())
+      scheduler->ReduceWorkerDestinationPhis();
+
+    scheduler->EndSweepEvent();
+  }
+  ReduceAngleTeamFluxes(schedulers);
+}
+
+//###################################################################
+/**Records the beginning of a sweep.*/
+void chi_mesh::sweep_management::SweepScheduler::BeginSweepEvent()
+{
+  sweep_start_time_ = MPI_Wtime();
+  sweep_begin_chunk_time_ = chunk_timing_.total;
+
+  sweep_idle_time_ = 0.0;
+  sweep_idle_work_time_ = 0.0;
+}
+
+//###################################################################
+/**Accumulates the duration and the idle time of the sweep on this
+ * location.*/
+void chi_mesh::sweep_management::SweepScheduler::EndSweepEvent()
+{
+  total_idle_time_ += sweep_idle_time_;
+  total_idle_work_time_ += sweep_idle_work_time_;
+
+  const double sweep_time = MPI_Wtime() - sweep_start_time_;
+  sweep_timing_.Add(sweep_time);
+
+  if (sweep_statistics_enabled_)
+  {
+    ++sweep_statistics_.num_sweeps;
+    sweep_statistics_.sweep_time += sweep_time;
+    sweep_statistics_.compute_time +=
+      chunk_timing_.total - sweep_begin_chunk_time_;
+  }
+}
+
+//###################################################################
+/**Sets the work to be performed whilst no angle set of this scheduler can
+ * execute because all of them are waiting on upstream data. The function
+ * is called once per stalled scheduling pass and must return true when it
+ * did any work, false when it has nothing left to do for the current
+ * sweep. It must not modify data read or written by the sweep. Supplying
+ * an empty function reverts to polling.*/
+void chi_mesh::sweep_management::SweepScheduler::SetIdleWorkFunction(
+  std::function<bool()> idle_work_function)
+{
+  idle_work_function_ = std::move(idle_work_function);
+}
+
+//###################################################################
+/**Accounts for a scheduling pass, started at `pass_start_time`, in which
+ * no angle set executed and fills the wait with the idle work function,
+ * if any.*/
+void chi_mesh::sweep_management::SweepScheduler::ProcessStalledPass(
+  double pass_start_time)
+{
+  const double idle_work_start_time = MPI_Wtime();
+  sweep_idle_time_ += idle_work_start_time - pass_start_time;
+  ChiProfileElapsed("MPI wait", idle_work_start_time - pass_start_time);
+
+  if (sweep_statistics_enabled_)
+  {
+    const double stalled_time = idle_work_start_time - pass_start_time;
+    if (sweep_statistics_.upstream_blocked_in_pass)
+      sweep_statistics_.upstream_wait_time += stalled_time;
+    else if (sweep_statistics_.boundary_blocked_in_pass)
+      sweep_statistics_.boundary_wait_time += stalled_time;
+  }
+
+  if (not idle_work_function_) return;
+
+  if (idle_work_function_())
+  {
+    const double idle_work_time = MPI_Wtime() - idle_work_start_time;
+    sweep_idle_time_ += idle_work_time;
+    sweep_idle_work_time_ += idle_work_time;
+  }
+}
+
+//###################################################################
+/**Advances every angle set once using the scheduling algorithm of this
+ * scheduler. Returns true when all the angle sets have finished.*/
+bool chi_mesh::sweep_management::SweepScheduler::AdvanceAngleSets()
+{
+  if (scheduler_type_ != SchedulingAlgorithm::FIRST_IN_FIRST_OUT)
+    return AdvanceAngleSetsDOG(sweep_chunk_);
+
+  return AdvanceAngleSetsFIFO(sweep_chunk_);
+}
+
+//###################################################################
+/**Flushes the send buffers and receives the delayed data of every angle
+ * set once. Returns true when all messages have been sent and received.*/
+bool chi_mesh::sweep_management::SweepScheduler::ReceiveDelayedData()
+{
+  bool received_delayed_data = true;
+
+  for (auto& angle_set_group : angle_agg_.angle_set_groups)
+    for (auto& angle_set : angle_set_group.AngleSets())
+    {
+      if (angle_set->FlushSendBuffers() == AngleSetStatus::MESSAGES_PENDING)
+        received_delayed_data = false;
+
+      if (not angle_set->ReceiveDelayedData())
+        received_delayed_data = false;
+    }
+
+  return received_delayed_data;
 }
 
 //###################################################################
-/**Get average sweep time from logging system.*/
+/**Resets the angle set buffers and reflecting boundaries in preparation
+ * for the next sweep.*/
+void chi_mesh::sweep_management::SweepScheduler::ResetSweepBuffers()
+{
+  for (auto& angle_set_group : angle_agg_.angle_set_groups)
+    for (auto& angle_set : angle_set_group.AngleSets())
+      angle_set->ResetSweepBuffers();
+
+  for (auto& [bid, bndry] : angle_agg_.sim_boundaries)
+  {
+    if (bndry->Type() == chi_mesh::sweep_management::BoundaryType::REFLECTING)
+    {
+      auto rbndry = std::static_pointer_cast<
+        chi_mesh::sweep_management::BoundaryReflecting>(bndry);
+      rbndry->ResetAnglesReadyStatus();
+    }
+  }
+}
+
+//###################################################################
+/**Get the average sweep time, in seconds.*/
 double chi_mesh::sweep_management::SweepScheduler::GetAverageSweepTime() const
 {
-  return Chi::log.ProcessEvent(sweep_event_tag_,
-                               chi::ChiLog::EventOperation::AVERAGE_DURATION);
+  return sweep_timing_.Average();
 }
 
 //###################################################################
 /**Get relevant sweep timing information.
  *
- * [0] Total sweep time
- * [1] Total chunk time
+ * [0] Total sweep time, in seconds
+ * [1] Total chunk time, in seconds
  * [2] Total chunk time / total sweep time
  * */
 std::vector<double>
@@ -34,12 +232,8 @@ std::vector<double>
 {
   std::vector<double> info;
 
-  double total_sweep_time = Chi::log.ProcessEvent(
-    sweep_event_tag_, chi::ChiLog::EventOperation::TOTAL_DURATION);
-
-  double total_chunk_time =
-    Chi::log.ProcessEvent(
-    sweep_timing_events_tag_[0], chi::ChiLog::EventOperation::TOTAL_DURATION);
+  double total_sweep_time = sweep_timing_.total;
+  double total_chunk_time = chunk_timing_.total;
 
   double ratio_sweep_to_chunk = total_chunk_time/total_sweep_time;
 
@@ -48,4 +242,23 @@ std::vector<double>
   info.push_back(ratio_sweep_to_chunk);
 
   return info;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Get the idle time accumulated over all the sweeps of this scheduler on
+ * this location, i.e. the time during which no angle set could execute.
+ *
+ * [0] Total idle time
+ * [1] Total idle time filled with idle work
+ * [2] Total idle time / total sweep time
+ * */
+std::vector<double>
+  chi_mesh::sweep_management::SweepScheduler::GetIdleTimings() const
+{
+  const double total_sweep_time = sweep_timing_.total;
+
+  const double idle_ratio =
+    total_sweep_time > 0.0 ? total_idle_time_ / total_sweep_time : 0.0;
+
+  return {total_idle_time_, total_idle_work_time_, idle_ratio};
+}
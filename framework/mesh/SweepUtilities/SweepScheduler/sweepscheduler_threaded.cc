@@ -0,0 +1,120 @@
+#include "sweepscheduler.h"
+
+#include "mesh/SweepUtilities/AngleSet/AAH_AngleSet.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace chi_mesh::sweep_management
+{
+
+namespace
+{
+int CurrentThreadID()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
+// ###################################################################
+/**Sets the additional sweep chunks used for threaded angle set execution.
+ * Each chunk must be an independent instance of the same type as the
+ * primary chunk. Supplying an empty vector reverts to serial execution.
+ * The chunks are also handed to every angle set so that angle sets which
+ * thread internally (e.g. CBC) can use them.*/
+void SweepScheduler::SetWorkerSweepChunks(
+  std::vector<std::shared_ptr<SweepChunk>> worker_chunks)
+{
+  worker_chunks_ = std::move(worker_chunks);
+  worker_destination_phis_.clear();
+  worker_destination_phis_.resize(worker_chunks_.size());
+
+  for (auto& angle_set_group : angle_agg_.angle_set_groups)
+    for (auto& angle_set : angle_set_group.AngleSets())
+      angle_set->SetWorkerSweepChunks(worker_chunks_);
+}
+
+// ###################################################################
+/**Points the worker chunks at zeroed private phi buffers and at the same
+ * destination psi and boundary source state as the primary chunk.*/
+void SweepScheduler::InitializeWorkerChunks()
+{
+  const auto& primary_phi = sweep_chunk_.GetDestinationPhi();
+  auto& primary_psi = sweep_chunk_.GetDestinationPsi();
+  const bool surface_source_active = sweep_chunk_.IsSurfaceSourceActive();
+
+  for (size_t w = 0; w < worker_chunks_.size(); ++w)
+  {
+    auto& worker = *worker_chunks_[w];
+    auto& worker_phi = worker_destination_phis_[w];
+
+    worker_phi.assign(primary_phi.size(), 0.0);
+    worker.SetDestinationPhi(worker_phi);
+    worker.SetDestinationPsi(primary_psi);
+    worker.SetBoundarySourceActiveFlag(surface_source_active);
+  }
+}
+
+// ###################################################################
+/**Executes a batch of ready angle sets. Buffer initialization and
+ * communication happens on the calling thread whilst the sweep chunks are
+ * executed concurrently, the primary chunk being used by thread 0.
+ * Non-AAH angle sets are executed serially.*/
+void SweepScheduler::ExecuteAngleSetsThreaded(
+  const std::vector<std::shared_ptr<TAngleSet>>& angle_sets)
+{
+  std::vector<AAH_AngleSet*> aah_angle_sets;
+  aah_angle_sets.reserve(angle_sets.size());
+  for (const auto& angle_set : angle_sets)
+  {
+    auto aah_angle_set = dynamic_cast<AAH_AngleSet*>(angle_set.get());
+    if (aah_angle_set == nullptr)
+      angle_set->AngleSetAdvance(
+        sweep_chunk_, chunk_timing_, ExecutionPermission::EXECUTE);
+    else
+      aah_angle_sets.push_back(aah_angle_set);
+  }
+
+  for (auto angle_set : aah_angle_sets)
+    angle_set->BeginExecution();
+
+  const int num_angle_sets = static_cast<int>(aah_angle_sets.size());
+  const int num_threads = static_cast<int>(NumSweepThreads());
+
+  const double chunk_start_time = MPI_Wtime();
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+  for (int as = 0; as < num_angle_sets; ++as)
+  {
+    const int thread_id = CurrentThreadID();
+    SweepChunk& sweep_chunk =
+      (thread_id == 0) ? sweep_chunk_ : *worker_chunks_[thread_id - 1];
+
+    aah_angle_sets[as]->ExecuteSweepChunk(sweep_chunk);
+  }
+  chunk_timing_.Add(MPI_Wtime() - chunk_start_time);
+
+  for (auto angle_set : aah_angle_sets)
+    angle_set->EndExecution();
+}
+
+// ###################################################################
+/**Adds the worker phi buffers into the primary destination phi.*/
+void SweepScheduler::ReduceWorkerDestinationPhis()
+{
+  auto& primary_phi = sweep_chunk_.GetDestinationPhi();
+  const size_t num_dofs = primary_phi.size();
+
+  for (const auto& worker_phi : worker_destination_phis_)
+    for (size_t i = 0; i < num_dofs; ++i)
+      primary_phi[i] += worker_phi[i];
+}
+
+} // namespace chi_mesh::sweep_management
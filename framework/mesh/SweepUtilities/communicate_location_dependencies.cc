@@ -51,4 +51,74 @@ void chi_mesh::sweep_management::
       global_dependencies[locI][c] = raw_dependencies[addr];
     }
   }
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Communicates the location by location dependencies of multiple sweep
+ * orderings at once. `global_dependencies[so][locI]` holds the
+ * dependencies of location `locI` for sweep ordering `so`.*/
+void chi_mesh::sweep_management::
+  CommunicateLocationDependencies(
+    const std::vector<const std::vector<int>*> &location_dependencies,
+    std::vector<std::vector<std::vector<int>>> &global_dependencies)
+{
+  const int P = Chi::mpi.process_count;
+  const int num_orderings = static_cast<int>(location_dependencies.size());
+
+  //============================================= Communicate location dep counts
+  // Per location, the dependency counts of all the orderings
+  std::vector<int> local_depcounts(num_orderings, 0);
+  std::vector<int> local_raw_dependencies;
+  for (int so=0; so<num_orderings; ++so)
+  {
+    const auto& dependencies = *location_dependencies[so];
+    local_depcounts[so] = static_cast<int>(dependencies.size());
+    local_raw_dependencies.insert(local_raw_dependencies.end(),
+                                  dependencies.begin(), dependencies.end());
+  }
+
+  std::vector<int> depcounts(P * num_orderings, 0);
+  MPI_Allgather(local_depcounts.data(),               //Send Buffer
+                num_orderings, MPI_INT,               //Send count and type
+                depcounts.data(),                     //Recv Buffer
+                num_orderings, MPI_INT,               //Recv count and type
+                Chi::mpi.comm);                       //Communicator
+
+  //============================================= Broadcast dependencies
+  std::vector<int> depcount_per_loc(P, 0);
+  for (int locI=0; locI<P; ++locI)
+    for (int so=0; so<num_orderings; ++so)
+      depcount_per_loc[locI] += depcounts[locI * num_orderings + so];
+
+  std::vector<int> raw_depvec_displs(P, 0);
+  int recv_buf_size = depcount_per_loc[0];
+  for (int locI=1; locI<P; ++locI)
+  {
+    raw_depvec_displs[locI] = raw_depvec_displs[locI-1] + depcount_per_loc[locI-1];
+    recv_buf_size += depcount_per_loc[locI];
+  }
+
+  std::vector<int> raw_dependencies(recv_buf_size,0);
+
+  MPI_Allgatherv(local_raw_dependencies.data(),              //Send buffer
+                 int(local_raw_dependencies.size()),         //Send count
+                 MPI_INT,                                    //Send type
+                 raw_dependencies.data(),                    //Recv buffer
+                 depcount_per_loc.data(),                    //Recv counts array
+                 raw_depvec_displs.data(),                   //Recv displs
+                 MPI_INT,                                    //Recv type
+                 Chi::mpi.comm);                             //Communicator
+
+  global_dependencies.assign(num_orderings, std::vector<std::vector<int>>(P));
+  for (int locI=0; locI<P; ++locI)
+  {
+    int addr = raw_depvec_displs[locI];
+    for (int so=0; so<num_orderings; ++so)
+    {
+      const int count = depcounts[locI * num_orderings + so];
+      global_dependencies[so][locI].assign(raw_dependencies.begin() + addr,
+                                           raw_dependencies.begin() + addr + count);
+      addr += count;
+    }
+  }
+}
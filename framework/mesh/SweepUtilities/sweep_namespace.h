@@ -40,6 +40,7 @@ struct Task
 
 class AAH_ASynchronousCommunicator;
 class AngleSet;
+struct AngleSetFaceCache;
 class AngleSetGroup;
 class AngleAggregation;
 
@@ -50,6 +51,9 @@ class SweepScheduler;
 void CommunicateLocationDependencies(
   const std::vector<int>& location_dependencies,
   std::vector<std::vector<int>>& global_dependencies);
+void CommunicateLocationDependencies(
+  const std::vector<const std::vector<int>*>& location_dependencies,
+  std::vector<std::vector<std::vector<int>>>& global_dependencies);
 
 void PrintSweepOrdering(SPDS* sweep_order, MeshContinuumPtr vol_continuum);
 
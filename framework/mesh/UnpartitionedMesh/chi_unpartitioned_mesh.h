@@ -55,6 +55,14 @@ public:
     size_t ortho_Nz = 0;
 
     std::map<uint64_t, std::string> boundary_id_map;
+
+    /**When true, only the home location reads the mesh and the volume
+     * mesher ships the cells to their owning locations.*/
+    bool home_location_ingestion = false;
+
+    /**When true, the PVTU reader only reads the pieces of the current
+     * location and the volume mesher keeps them as the partitioning.*/
+    bool local_pieces_only = false;
   };
 
   struct BoundBox
@@ -90,6 +98,8 @@ protected:
   void SetBoundaryIDsFromBlocks(
     std::vector<vtkUGridPtrAndName>& bndry_grid_blocks);
 
+  void BroadcastFromHomeLocation();
+
 
 public:
   const BoundBox& GetBoundBox() const {return *bound_box_;}
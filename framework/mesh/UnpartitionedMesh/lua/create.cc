@@ -3,6 +3,7 @@
 #include "mesh/UnpartitionedMesh/chi_unpartitioned_mesh.h"
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 #include "unpartition_mesh_lua_utils.h"
 #include "console/chi_console.h"
@@ -21,6 +22,32 @@ RegisterLuaFunctionAsIs(chiUnpartitionedMeshFromEnsightGold);
 RegisterLuaFunctionAsIs(chiUnpartitionedMeshFromWavefrontOBJ);
 RegisterLuaFunctionAsIs(chiUnpartitionedMeshFromMshFormat);
 RegisterLuaFunctionAsIs(chiUnpartitionedMeshFromExodusII);
+RegisterLuaFunctionAsIs(chiUnpartitionedMeshSetHomeLocationIngestion);
+
+namespace
+{
+/**Whether subsequently read meshes are only read on the home location.*/
+bool home_location_ingestion = false;
+
+typedef void (chi_mesh::UnpartitionedMesh::*MeshReader)(
+  const chi_mesh::UnpartitionedMesh::Options&);
+
+/**Reads a mesh with the given reader. With home location ingestion, the
+ * other locations keep only the options and an empty mesh.*/
+void ReadMesh(chi_mesh::UnpartitionedMesh& umesh,
+              chi_mesh::UnpartitionedMesh::Options& options,
+              MeshReader reader)
+{
+  if (options.local_pieces_only and home_location_ingestion)
+    throw std::logic_error("Home location ingestion is not supported when "
+                           "reading local pieces only.");
+
+  options.home_location_ingestion = home_location_ingestion;
+  if (not home_location_ingestion or Chi::mpi.location_id == 0)
+    (umesh.*reader)(options);
+  umesh.GetMeshOptions().home_location_ingestion = home_location_ingestion;
+}
+}//namespace
 
 //###################################################################
 /**Creates an empty unpartitioned mesh. An empty unpartitioned mesh
@@ -137,7 +164,8 @@ int chiUnpartitionedMeshFromVTU(lua_State* L)
   options.material_id_fieldname = field;
   options.boundary_id_fieldname = field;
 
-  new_object->ReadFromVTU(options);
+  ReadMesh(*new_object, options,
+           &chi_mesh::UnpartitionedMesh::ReadFromVTU);
 
   Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -154,6 +182,12 @@ int chiUnpartitionedMeshFromVTU(lua_State* L)
 \param file_name char Filename of the .vtu file.
 \param field char Name of the cell data field from which to read
                   material and boundary identifiers (optional).
+\param local_pieces_only bool If true, each location only reads its own
+                  pieces of the file, plus a halo of ghost cells obtained
+                  from the other locations, and the pieces are kept as the
+                  partitioning. The file must have at least as many pieces
+                  as locations. Only supported by VOLUMEMESHER_UNPARTITIONED
+                  (optional) [Default=false].
 
 \ingroup LuaUnpartitionedMesh
 
@@ -184,18 +218,23 @@ chiVolumeMesherExecute()
 
     LuaCheckNilValue(func_name,L,1);
     if (num_args >= 2) LuaCheckNilValue(func_name,L,2);
+    if (num_args >= 3) LuaCheckNilValue(func_name,L,3);
 
     const char* temp = lua_tostring(L,1);
     const char* field = "";
     if (num_args >= 2) field = lua_tostring(L,2);
+    bool local_pieces_only = false;
+    if (num_args >= 3) local_pieces_only = lua_toboolean(L,3);
     auto new_object = new chi_mesh::UnpartitionedMesh;
 
     chi_mesh::UnpartitionedMesh::Options options;
     options.file_name = std::string(temp);
     options.material_id_fieldname = field;
     options.boundary_id_fieldname = field;
+    options.local_pieces_only = local_pieces_only;
 
-    new_object->ReadFromPVTU(options);
+    ReadMesh(*new_object, options,
+             &chi_mesh::UnpartitionedMesh::ReadFromPVTU);
 
     Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -250,7 +289,8 @@ int chiUnpartitionedMeshFromEnsightGold(lua_State* L)
   options.file_name = std::string(temp);
   options.scale = scale;
 
-  new_object->ReadFromEnsightGold(options);
+  ReadMesh(*new_object, options,
+           &chi_mesh::UnpartitionedMesh::ReadFromEnsightGold);
 
   Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -300,7 +340,8 @@ int chiUnpartitionedMeshFromWavefrontOBJ(lua_State* L)
   chi_mesh::UnpartitionedMesh::Options options;
   options.file_name = std::string(temp);
 
-  new_object->ReadFromWavefrontOBJ(options);
+  ReadMesh(*new_object, options,
+           &chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ);
 
   Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -311,7 +352,9 @@ int chiUnpartitionedMeshFromWavefrontOBJ(lua_State* L)
 }
 
 //###################################################################
-/**Creates an unpartitioned mesh from a .msh file.
+/**Creates an unpartitioned mesh from a .msh file, in the gmsh legacy ASCII
+format 2.2 or in the ASCII or binary format 4.1. Unless the mesh is only
+read on the home location, the locations parse the elements concurrently.
 
 \param file_name char Filename of the .msh file.
 
@@ -351,7 +394,8 @@ int chiUnpartitionedMeshFromMshFormat(lua_State* L)
   chi_mesh::UnpartitionedMesh::Options options;
   options.file_name = std::string(temp);
 
-  new_object->ReadFromMsh(options);
+  ReadMesh(*new_object, options,
+           &chi_mesh::UnpartitionedMesh::ReadFromMsh);
 
   Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -406,7 +450,8 @@ int chiUnpartitionedMeshFromExodusII(lua_State* L)
   options.file_name = std::string(temp);
   options.scale = scale;
 
-  new_object->ReadFromExodus(options);
+  ReadMesh(*new_object, options,
+           &chi_mesh::UnpartitionedMesh::ReadFromExodus);
 
   Chi::unpartitionedmesh_stack.emplace_back(new_object);
 
@@ -416,4 +461,43 @@ int chiUnpartitionedMeshFromExodusII(lua_State* L)
   return 1;
 }
 
+//###################################################################
+/**Sets whether unpartitioned meshes read from files afterwards are read
+ * only on the home location. The volume mesher then partitions such a mesh
+ * on the home location and ships to every location only its own local and
+ * ghost cells, so that the full mesh is not replicated on every location.
+ * Such meshes are only supported by VOLUMEMESHER_UNPARTITIONED.
+
+\param flag bool Enables or disables home location ingestion
+                 [Default=false].
+
+##_
+
+### Example
+\code
+chiUnpartitionedMeshSetHomeLocationIngestion(true)
+umesh = chiUnpartitionedMeshFromExodusII("resources/TestObjects/Mesh.e")
+
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED)
+chiVolumeMesherCreate(VOLUMEMESHER_UNPARTITIONED, umesh)
+
+chiSurfaceMesherExecute()
+chiVolumeMesherExecute()
+\endcode
+
+\ingroup LuaUnpartitionedMesh*/
+int chiUnpartitionedMeshSetHomeLocationIngestion(lua_State* L)
+{
+  const std::string func_name = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1)
+    LuaPostArgAmountError(func_name,1,num_args);
+
+  LuaCheckNilValue(func_name,L,1);
+
+  home_location_ingestion = lua_toboolean(L,1);
+
+  return 0;
+}
+
 }//namespace chi_mesh::unpartition_mesh_lua_utils
\ No newline at end of file
@@ -17,6 +17,7 @@ namespace chi_mesh::unpartition_mesh_lua_utils
   int chiUnpartitionedMeshFromWavefrontOBJ(lua_State* L);
   int chiUnpartitionedMeshFromMshFormat(lua_State* L);
   int chiUnpartitionedMeshFromExodusII(lua_State* L);
+  int chiUnpartitionedMeshSetHomeLocationIngestion(lua_State* L);
 
   //basic_operations.cc
   int chiUnpartitionedMeshUploadVertex(lua_State* L);
@@ -5,13 +5,93 @@
 
 #include "utils/chi_timer.h"
 
-#include "chi_mpi.h"
+#include <algorithm>
+#include <unordered_set>
+
+
+namespace
+{
+/**Number of shards of the face hash table, processed concurrently.*/
+constexpr size_t NUM_FACE_SHARDS = 1024;
 
 //###################################################################
-/**Establishes neighbor connectivity for the light-weight mesh.*/
+/**Canonical keys of vertex lists, i.e., their sorted unique vertex ids,
+ * stored contiguously with their hashes. Keys are compared by index.*/
+class VertexKeys
+{
+private:
+  std::vector<uint64_t> begins_;
+  std::vector<uint64_t> ends_;
+  std::vector<uint64_t> ids_;
+  std::vector<uint64_t> hashes_;
+
+public:
+  /**Appends the key of a vertex list.*/
+  void Add(const std::vector<uint64_t>& vertex_ids)
+  {
+    begins_.push_back(ids_.size());
+    ids_.insert(ids_.end(), vertex_ids.begin(), vertex_ids.end());
+    ends_.push_back(ids_.size());
+  }
+
+  /**Sorts the vertex ids of every key, removing duplicates, and hashes
+   * them, concurrently.*/
+  void Canonicalize()
+  {
+    const auto num_keys = static_cast<int64_t>(begins_.size());
+    hashes_.assign(num_keys, 0);
+#pragma omp parallel for schedule(static)
+    for (int64_t k = 0; k < num_keys; ++k)
+    {
+      auto* begin = ids_.data() + begins_[k];
+      auto* end = ids_.data() + ends_[k];
+      std::sort(begin, end);
+      end = std::unique(begin, end);
+      ends_[k] = end - ids_.data();
+
+      uint64_t hash = 0;
+      for (auto* v = begin; v != end; ++v)
+        hash ^= *v + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+      hashes_[k] = hash;
+    }
+  }
+
+  size_t Size() const { return begins_.size(); }
+  uint64_t Hash(size_t k) const { return hashes_[k]; }
+
+  bool Equal(size_t a, size_t b) const
+  {
+    return std::equal(ids_.begin() + begins_[a], ids_.begin() + ends_[a],
+                      ids_.begin() + begins_[b], ids_.begin() + ends_[b]);
+  }
+};
+
+/**Set of key indices hashed and compared by their keys.*/
+struct KeyHash
+{
+  const VertexKeys* keys;
+  size_t operator()(size_t k) const { return keys->Hash(k); }
+};
+struct KeyEqual
+{
+  const VertexKeys* keys;
+  bool operator()(size_t a, size_t b) const { return keys->Equal(a, b); }
+};
+typedef std::unordered_set<size_t, KeyHash, KeyEqual> KeySet;
+} // namespace
+
+//###################################################################
+/**Establishes neighbor connectivity for the light-weight mesh.
+ *
+ * The unconnected faces are keyed by their sorted vertex ids, which are
+ * hashed into shards. The faces of every shard are matched through a
+ * hash table, the shards being processed concurrently, such that the
+ * connectivity is built in linear time. The faces of a shard are matched
+ * in cell order, hence the result does not depend on the number of
+ * threads. Faces still unconnected are then matched with the boundary
+ * cells, whose material ids become the boundary ids.*/
 void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
 {
-  const size_t num_raw_cells = raw_cells_.size();
   const size_t num_raw_vertices = vertices_.size();
 
   //======================================== Reset all cell neighbors
@@ -27,8 +107,7 @@ void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
   Chi::log.Log() << Chi::program_timer.GetTimeString()
                 << " Establishing cell connectivity.";
 
-  //======================================== Establish internal connectivity
-  // Populate vertex subscriptions to internal cells
+  //======================================== Populate vertex subscriptions
   vertex_cell_subscriptions_.resize(num_raw_vertices);
   {
     uint64_t cur_cell_id=0;
@@ -40,121 +119,100 @@ void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
     }
   }
 
-  Chi::log.Log() << Chi::program_timer.GetTimeString()
-                << " Vertex cell subscriptions complete.";
-
-  // Process raw cells
+  //======================================== Key the unconnected faces
+  // The keys of the boundary cells follow those of the faces
+  std::vector<std::pair<uint64_t, uint32_t>> open_faces;
+  VertexKeys keys;
   {
-    uint64_t aux_counter = 0;
     uint64_t cur_cell_id=0;
-    for (auto& cell : raw_cells_)
+    for (const auto& cell : raw_cells_)
     {
-      for (auto& cur_cell_face : cell->faces)
+      uint32_t f = 0;
+      for (const auto& face : cell->faces)
       {
-        if (cur_cell_face.has_neighbor) {continue;}
-        const std::set<uint64_t> cfvids(cur_cell_face.vertex_ids.begin(),
-                                        cur_cell_face.vertex_ids.end());
-
-        std::set<size_t> cells_to_search;
-        for (uint64_t vid : cfvids)
-          for (uint64_t cell_id : vertex_cell_subscriptions_.at(vid))
-            if (cell_id != cur_cell_id)
-              cells_to_search.insert(cell_id);
-
-        for (uint64_t adj_cell_id : cells_to_search)
+        if (not face.has_neighbor)
         {
-          auto adj_cell = raw_cells_.at(adj_cell_id);
+          open_faces.emplace_back(cur_cell_id, f);
+          keys.Add(face.vertex_ids);
+        }
+        ++f;
+      }
+      ++cur_cell_id;
+    }
+  }
+  const size_t num_open_faces = open_faces.size();
+  for (const auto& cell : raw_boundary_cells_)
+    keys.Add(cell->vertex_ids);
 
-          for (auto& adj_cell_face : adj_cell->faces)
-          {
-            if (adj_cell_face.has_neighbor) {continue;}
-            const std::set<uint64_t> afvids(adj_cell_face.vertex_ids.begin(),
-                                            adj_cell_face.vertex_ids.end());
+  keys.Canonicalize();
 
-            if (cfvids == afvids)
-            {
-              cur_cell_face.neighbor = adj_cell_id;
-              adj_cell_face.neighbor = cur_cell_id;
+  auto Face = [this, &open_faces](size_t k) -> LightWeightFace&
+  {
+    const auto& [cell_id, f] = open_faces[k];
+    return raw_cells_[cell_id]->faces[f];
+  };
 
-              cur_cell_face.has_neighbor = true;
-              adj_cell_face.has_neighbor = true;
+  //======================================== Establish internal connectivity
+  {
+    std::vector<std::vector<size_t>> shards(NUM_FACE_SHARDS);
+    for (size_t k = 0; k < num_open_faces; ++k)
+      shards[keys.Hash(k) % NUM_FACE_SHARDS].push_back(k);
 
-              goto face_neighbor_found;
-            }
-          }//for adjacent cell face
+    const auto num_shards = static_cast<int64_t>(NUM_FACE_SHARDS);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t s = 0; s < num_shards; ++s)
+    {
+      const auto& shard = shards[s];
+      KeySet unmatched(2 * shard.size(), KeyHash{&keys}, KeyEqual{&keys});
+      for (const size_t k : shard)
+      {
+        const auto match = unmatched.find(k);
+        if (match == unmatched.end() or
+            open_faces[*match].first == open_faces[k].first)
+        {
+          unmatched.insert(k);
+          continue;
         }
-        face_neighbor_found:;
-      }//for face
 
-      ++cur_cell_id;
-      const double fraction_complete = static_cast<double>(cur_cell_id)/
-                                       static_cast<double>(num_raw_cells);
-      if (fraction_complete >= static_cast<double>(aux_counter+1)*0.1)
-      {
-        Chi::log.Log() << Chi::program_timer.GetTimeString()
-                      << " Surpassing cell " << cur_cell_id
-                      << " of " << num_raw_cells
-                      << " (" << (aux_counter+1)*10 << "%)";
-        ++aux_counter;
+        auto& face = Face(k);
+        auto& adj_face = Face(*match);
+        face.neighbor = open_faces[*match].first;
+        adj_face.neighbor = open_faces[k].first;
+        face.has_neighbor = true;
+        adj_face.has_neighbor = true;
+
+        unmatched.erase(match);
       }
-    }//for cell
+    }//for shard
   }
 
   Chi::log.Log() << Chi::program_timer.GetTimeString()
                 << " Establishing cell boundary connectivity.";
 
   //======================================== Establish boundary connectivity
-  // Make list of internal cells on the boundary
-  std::vector<LightWeightCell*> internal_cells_on_boundary;
-  for (auto& cell : raw_cells_)
-  {
-    bool cell_on_boundary = false;
-    for (auto& face : cell->faces)
-      if (not face.has_neighbor)
-      { cell_on_boundary = true; break; }
-
-    if (cell_on_boundary) internal_cells_on_boundary.push_back(cell);
-  }
-
-  // Populate vertex subscriptions to boundary cells
-  std::vector<std::set<uint64_t>> vertex_bndry_cell_subscriptions(vertices_.size());
+  // The first boundary cell of a key is used
   {
-    uint64_t cur_cell_id=0;
-    for (auto& cell : raw_boundary_cells_)
-    {
-      for (auto vid : cell->vertex_ids)
-        vertex_bndry_cell_subscriptions.at(vid).insert(cur_cell_id);
-      ++cur_cell_id;
-    }
-  }
+    KeySet boundary_cells(2 * raw_boundary_cells_.size(),
+                          KeyHash{&keys}, KeyEqual{&keys});
+    for (size_t k = num_open_faces; k < keys.Size(); ++k)
+      boundary_cells.insert(k);
 
-  // Process boundary cells
-  for (auto& cell : internal_cells_on_boundary)
-    for (auto& face : cell->faces)
+    if (not boundary_cells.empty())
     {
-      if (face.has_neighbor) continue;
-      std::set<uint64_t> cfvids(face.vertex_ids.begin(),
-                                face.vertex_ids.end());
-
-      std::set<size_t> cells_to_search;
-      for (uint64_t vid : face.vertex_ids)
-        for (uint64_t cell_id : vertex_bndry_cell_subscriptions[vid])
-          cells_to_search.insert(cell_id);
-
-      for (uint64_t adj_cell_id : cells_to_search)
+      const auto num_faces = static_cast<int64_t>(num_open_faces);
+#pragma omp parallel for schedule(static)
+      for (int64_t k = 0; k < num_faces; ++k)
       {
-        auto& adj_cell = raw_boundary_cells_[adj_cell_id];
-
-        std::set<uint64_t> afvids(adj_cell->vertex_ids.begin(),
-                                  adj_cell->vertex_ids.end());
+        auto& face = Face(k);
+        if (face.has_neighbor) continue;
 
-        if (cfvids == afvids)
-        {
-          face.neighbor = adj_cell->material_id;
-          break;
-        }
-      }//for adj_cell_id
-    }//for face
+        const auto match = boundary_cells.find(k);
+        if (match != boundary_cells.end())
+          face.neighbor =
+            raw_boundary_cells_[*match - num_open_faces]->material_id;
+      }
+    }
+  }
 
   num_bndry_faces = 0;
   for (auto cell : raw_cells_)
@@ -165,8 +223,7 @@ void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
                               << " Number of boundary faces "
                                  "after connectivity: " << num_bndry_faces;
 
-  Chi::mpi.Barrier();
   Chi::log.Log() << Chi::program_timer.GetTimeString()
                 << " Done establishing cell connectivity.";
 
-}
\ No newline at end of file
+}
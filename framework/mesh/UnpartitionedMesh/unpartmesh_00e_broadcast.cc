@@ -0,0 +1,172 @@
+#include "chi_unpartitioned_mesh.h"
+
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+
+namespace
+{
+/**Largest number of bytes broadcast by one MPI call.*/
+constexpr size_t MAX_BCAST_CHUNK = size_t(1) << 30;
+
+/**Broadcasts bytes of any size from the home location, in chunks.*/
+void BroadcastBytes(std::vector<std::byte>& bytes)
+{
+  uint64_t num_bytes = bytes.size();
+  MPI_Bcast(&num_bytes, 1, MPI_UINT64_T, 0, Chi::mpi.comm);
+  bytes.resize(num_bytes);
+
+  for (size_t offset = 0; offset < num_bytes; offset += MAX_BCAST_CHUNK)
+  {
+    const size_t count = std::min(MAX_BCAST_CHUNK, num_bytes - offset);
+    MPI_Bcast(bytes.data() + offset, static_cast<int>(count), MPI_BYTE,
+              0, Chi::mpi.comm);
+  }
+}
+}//namespace
+
+//###################################################################
+/**Broadcasts the mesh read on the home location to all the other
+ * locations, which then need not read the file themselves. The
+ * vertices, cells with their faces and connectivity, boundary cells,
+ * attributes, bound box and boundary names are copied, and the vertex
+ * subscriptions rebuilt. Must be called by all locations.*/
+void chi_mesh::UnpartitionedMesh::BroadcastFromHomeLocation()
+{
+  const bool home = Chi::mpi.location_id == 0;
+
+  typedef chi_data_types::ByteArray ByteArray;
+  auto WriteCell = [](ByteArray& raw, const LightWeightCell& cell)
+  {
+    raw.Write<int>(static_cast<int>(cell.type));
+    raw.Write<int>(static_cast<int>(cell.sub_type));
+    raw.Write<chi_mesh::Vertex>(cell.centroid);
+    raw.Write<int>(cell.material_id);
+    raw.Write<size_t>(cell.vertex_ids.size());
+    raw.WriteBytes(cell.vertex_ids.data(),
+                   cell.vertex_ids.size() * sizeof(uint64_t));
+    raw.Write<size_t>(cell.faces.size());
+    for (const auto& face : cell.faces)
+    {
+      raw.Write<size_t>(face.vertex_ids.size());
+      raw.WriteBytes(face.vertex_ids.data(),
+                     face.vertex_ids.size() * sizeof(uint64_t));
+      raw.Write<bool>(face.has_neighbor);
+      raw.Write<uint64_t>(face.neighbor);
+    }
+  };
+
+  auto ReadIds = [](const ByteArray& raw, size_t& address)
+  {
+    const auto num_ids = raw.Read<size_t>(address, &address);
+    std::vector<uint64_t> ids(num_ids);
+    const auto* bytes =
+      raw.ReadBytes(address, num_ids * sizeof(uint64_t), &address);
+    std::copy_n(bytes, num_ids * sizeof(uint64_t),
+                reinterpret_cast<std::byte*>(ids.data()));
+    return ids;
+  };
+
+  auto ReadCell = [&ReadIds](const ByteArray& raw, size_t& address)
+  {
+    const auto type = static_cast<CellType>(raw.Read<int>(address, &address));
+    const auto sub_type =
+      static_cast<CellType>(raw.Read<int>(address, &address));
+
+    auto cell = new LightWeightCell(type, sub_type);
+    cell->centroid = raw.Read<chi_mesh::Vertex>(address, &address);
+    cell->material_id = raw.Read<int>(address, &address);
+    cell->vertex_ids = ReadIds(raw, address);
+
+    const auto num_faces = raw.Read<size_t>(address, &address);
+    cell->faces.resize(num_faces);
+    for (auto& face : cell->faces)
+    {
+      face.vertex_ids = ReadIds(raw, address);
+      face.has_neighbor = raw.Read<bool>(address, &address);
+      face.neighbor = raw.Read<uint64_t>(address, &address);
+    }
+    return cell;
+  };
+
+  //======================================== Serialize on home location
+  ByteArray raw;
+  if (home)
+  {
+    raw.Write<int>(static_cast<int>(attributes_));
+    raw.Write<bool>(bound_box_ != nullptr);
+    if (bound_box_) raw.Write<BoundBox>(*bound_box_);
+
+    raw.Write<size_t>(mesh_options_.boundary_id_map.size());
+    for (const auto& [bid, name] : mesh_options_.boundary_id_map)
+    {
+      raw.Write<uint64_t>(bid);
+      raw.Write<size_t>(name.size());
+      raw.WriteBytes(name.data(), name.size());
+    }
+
+    raw.Write<size_t>(vertices_.size());
+    raw.WriteBytes(vertices_.data(),
+                   vertices_.size() * sizeof(chi_mesh::Vertex));
+
+    raw.Write<size_t>(raw_cells_.size());
+    for (const auto* cell : raw_cells_) WriteCell(raw, *cell);
+    raw.Write<size_t>(raw_boundary_cells_.size());
+    for (const auto* cell : raw_boundary_cells_) WriteCell(raw, *cell);
+  }
+
+  BroadcastBytes(raw.Data());
+  if (home) return;
+
+  //======================================== Deserialize on other locations
+  CleanUp();
+  size_t address = 0;
+  attributes_ = static_cast<MeshAttributes>(raw.Read<int>(address, &address));
+  bound_box_ = nullptr;
+  if (raw.Read<bool>(address, &address))
+    bound_box_ =
+      std::make_shared<BoundBox>(raw.Read<BoundBox>(address, &address));
+
+  auto& boundary_id_map = mesh_options_.boundary_id_map;
+  boundary_id_map.clear();
+  const auto num_boundaries = raw.Read<size_t>(address, &address);
+  for (size_t b = 0; b < num_boundaries; ++b)
+  {
+    const auto bid = raw.Read<uint64_t>(address, &address);
+    const auto name_size = raw.Read<size_t>(address, &address);
+    const auto* name = raw.ReadBytes(address, name_size, &address);
+    boundary_id_map[bid] =
+      std::string(reinterpret_cast<const char*>(name), name_size);
+  }
+
+  const auto num_vertices = raw.Read<size_t>(address, &address);
+  vertices_.resize(num_vertices);
+  const auto* vertex_bytes =
+    raw.ReadBytes(address, num_vertices * sizeof(chi_mesh::Vertex), &address);
+  std::copy_n(vertex_bytes, num_vertices * sizeof(chi_mesh::Vertex),
+              reinterpret_cast<std::byte*>(vertices_.data()));
+
+  const auto num_cells = raw.Read<size_t>(address, &address);
+  raw_cells_.reserve(num_cells);
+  for (size_t c = 0; c < num_cells; ++c)
+    raw_cells_.push_back(ReadCell(raw, address));
+
+  const auto num_bndry_cells = raw.Read<size_t>(address, &address);
+  raw_boundary_cells_.reserve(num_bndry_cells);
+  for (size_t c = 0; c < num_bndry_cells; ++c)
+    raw_boundary_cells_.push_back(ReadCell(raw, address));
+
+  //======================================== Rebuild vertex subscriptions
+  vertex_cell_subscriptions_.resize(num_vertices);
+  uint64_t cur_cell_id = 0;
+  for (const auto* cell : raw_cells_)
+  {
+    for (auto vid : cell->vertex_ids)
+      vertex_cell_subscriptions_.at(vid).insert(cur_cell_id);
+    ++cur_cell_id;
+  }
+}
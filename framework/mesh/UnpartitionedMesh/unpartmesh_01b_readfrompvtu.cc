@@ -8,8 +8,13 @@
 
 #include <vtkInformation.h>
 
+#include <vtkCellData.h>
+#include <vtkPointData.h>
+
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
 
 #define ErrorReadingFile(fname) \
 std::runtime_error("Failed to open file: " + options.file_name + \
@@ -19,7 +24,10 @@ std::runtime_error("Failed to open file: " + options.file_name + \
 /**Reads a VTK unstructured mesh. This reader will use the following
  * options:
  * - `file_name`, of course.
- * - `material_id_fieldname`, cell data for material_id.*/
+ * - `material_id_fieldname`, cell data for material_id.
+ * - `local_pieces_only`, each location only reads its own pieces of the
+ *   file, which must have at least as many pieces as there are locations.
+ *   The cells and vertices are then numbered locally to the pieces.*/
 void chi_mesh::UnpartitionedMesh::
   ReadFromPVTU(const chi_mesh::UnpartitionedMesh::Options &options)
 {
@@ -39,7 +47,16 @@ void chi_mesh::UnpartitionedMesh::
   if (not reader->CanReadFile(options.file_name.c_str()))
     throw std::logic_error("Unable to read file-type with this routine");
   reader->UpdateInformation();
-  reader->Update();
+  if (options.local_pieces_only)
+  {
+    ChiInvalidArgumentIf(reader->GetNumberOfPieces() < Chi::mpi.process_count,
+                         "Reading local pieces only requires at least as "
+                         "many pieces as locations in file " +
+                         options.file_name + ".");
+    reader->UpdatePiece(Chi::mpi.location_id, Chi::mpi.process_count, 0);
+  }
+  else
+    reader->Update();
 
   //======================================== Get all the grid blocks
   // For vtu files this is very simple. The
@@ -47,8 +64,19 @@ void chi_mesh::UnpartitionedMesh::
   auto ugrid_main = vtkUGridPtr(reader->GetOutput());
   std::vector<vtkUGridPtrAndName> grid_blocks = {{ugrid_main,""}};
 
+  //Global ids of the pieces are not contiguous on a location, the volume
+  //mesher numbers local pieces globally
+  if (options.local_pieces_only)
+  {
+    ugrid_main->GetCellData()->SetGlobalIds(nullptr);
+    ugrid_main->GetPointData()->SetGlobalIds(nullptr);
+  }
+
   //======================================== Get the main + bndry blocks
-  const int max_dimension = chi_mesh::FindHighestDimension(grid_blocks);
+  int max_dimension = chi_mesh::FindHighestDimension(grid_blocks);
+  if (options.local_pieces_only)
+    MPI_Allreduce(MPI_IN_PLACE, &max_dimension, 1, MPI_INT, MPI_MAX,
+                  Chi::mpi.comm);
   std::vector<vtkUGridPtrAndName> domain_grid_blocks =
     chi_mesh::GetBlocksOfDesiredDimension(grid_blocks, max_dimension);
   std::vector<vtkUGridPtrAndName> bndry_grid_blocks =
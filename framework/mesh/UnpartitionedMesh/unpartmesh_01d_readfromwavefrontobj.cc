@@ -5,8 +5,10 @@
 
 #include "chi_mpi.h"
 
+#include "utils/chi_text_tokenizer.h"
+
 #include <algorithm>
-#include <fstream>
+#include <map>
 
 //###################################################################
 /**Reads an unpartitioned mesh from a wavefront .obj file.*/
@@ -15,9 +17,8 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
   const std::string fname = "chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ";
 
   //======================================================= Opening the file
-  std::ifstream file;
-  file.open(options.file_name);
-  if (!file.is_open())
+  chi::MappedTextFile file(options.file_name);
+  if (not file.IsOpen())
   {
     Chi::log.LogAllError()
       << "Failed to open file: " << options.file_name << " in call "
@@ -40,118 +41,92 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
   std::vector<BlockData>        block_data;
   std::vector<chi_mesh::Vertex> file_vertices;
 
+  //======================================================= Counting pass
+  size_t num_file_vertices = 0;
+  for (std::string_view text = file.View(); not text.empty();)
+  {
+    std::string_view file_line = chi::PopLine(text);
+    if (chi::PopToken(file_line) == "v") ++num_file_vertices;
+  }
+  file_vertices.reserve(num_file_vertices);
+
   //======================================================= Reading every line
-  std::string file_line;
-  std::string delimiter = " ";
+  size_t line_number = 0;
+  auto ToVertexIndex = [&file_vertices, &line_number](std::string_view word)
+  {
+    int index = 0;
+    if (not chi::ParseNumber(word, index) or index == 0)
+    {
+      Chi::log.Log0Warning()
+        << "Failed converting word to number in line " << line_number;
+      return uint64_t{0};
+    }
+    // Negative indices are relative to the vertices read so far
+    if (index < 0) return static_cast<uint64_t>(
+      static_cast<int64_t>(file_vertices.size()) + index);
+    return static_cast<uint64_t>(index - 1);
+  };
+
   int material_id = -1;
-  while (std::getline(file,file_line))
+  std::vector<uint64_t> face_vertex_ids;
+  for (std::string_view text = file.View(); not text.empty();)
   {
+    ++line_number;
+    std::string_view file_line = chi::PopLine(text);
+
     //================================================ Get the first word
-    size_t beg_of_word = file_line.find_first_not_of(delimiter);
-    size_t end_of_word = file_line.find(delimiter,beg_of_word-beg_of_word);
-    std::string first_word = file_line.substr(beg_of_word,end_of_word);
-    std::string sub_word;
+    const std::string_view first_word = chi::PopToken(file_line);
 
     if (first_word == "o")
     {
-      beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-      end_of_word = file_line.find(delimiter, beg_of_word);
-      sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-      std::string block_name = sub_word;
+      std::string block_name(chi::PopToken(file_line));
       block_data.push_back({block_name, {}});
     }
 
-    if (first_word == "usemtl")
+    else if (first_word == "usemtl")
     {
-      Chi::log.Log0Verbose1() << "New material at cell count: "
-                              << block_data.back().cells.size();
+      if (not block_data.empty())
+        Chi::log.Log0Verbose1() << "New material at cell count: "
+                                << block_data.back().cells.size();
       ++material_id;
     }
 
     //================================================ Keyword "v" for Vertex
-    if (first_word == "v")
+    else if (first_word == "v")
     {
       chi_mesh::Vertex newVertex;
-      for (int k=1;k<=3;k++)
+      for (size_t k=0; k<3; ++k)
       {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //================================== Convert word to number
-        try
-        {
-          double numValue = std::stod(sub_word);
-
-          if      (k==1) newVertex.x = numValue;
-          else if (k==2) newVertex.y = numValue;
-          else if (k==3) newVertex.z = numValue;
-        }
-
-        //================================== Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
+        const std::string_view sub_word = chi::PopToken(file_line);
+        if (sub_word.empty()) break;
+        if (not chi::ParseNumber(sub_word, newVertex(k)))
           Chi::log.Log0Warning()
-          << "Failed to convert vertex in line " << file_line << std::endl;
-        }
-
-        //================================== Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
+            << "Failed to convert vertex in line " << line_number;
       }
       file_vertices.push_back(newVertex);
     }//if (first_word == "v")
 
     //===================================================== Keyword "f" for face
-    if (first_word == "f")
+    else if (first_word == "f")
     {
-      size_t number_of_verts =
-        std::count(file_line.begin(), file_line.end(), '/')/2;
-
+      //Populate vertex-ids, from the v, v/vt, v//vn or v/vt/vn words
+      face_vertex_ids.clear();
+      for (std::string_view sub_word = chi::PopToken(file_line);
+           not sub_word.empty(); sub_word = chi::PopToken(file_line))
+        face_vertex_ids.push_back(
+          ToVertexIndex(chi::PopField(sub_word, '/')));
+
+      const size_t num_verts = face_vertex_ids.size();
       CellType sub_type = CellType::POLYGON;
-      if      (number_of_verts == 3) sub_type = CellType::TRIANGLE;
-      else if (number_of_verts == 4) sub_type = CellType::QUADRILATERAL;
+      if      (num_verts == 3) sub_type = CellType::TRIANGLE;
+      else if (num_verts == 4) sub_type = CellType::QUADRILATERAL;
 
       auto cell = new LightWeightCell(CellType::POLYGON, sub_type);
       cell->material_id = material_id;
-
-      //Populate vertex-ids
-      for (size_t k=1;k<=number_of_verts;k++)
-      {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //============================= Extract locations of hiphens
-        size_t first_dash = sub_word.find('/');
-        size_t last_dash  = sub_word.find_last_of('/');
-
-        //============================= Extract the words ass. vertex and normal
-        std::string vert_word = sub_word.substr(0,first_dash-0);
-        std::string norm_word = sub_word.substr(last_dash+1,
-                                                sub_word.length()-last_dash-1);
-
-        //============================= Convert word to number (Vertex)
-        try
-        {
-          int numValue = std::stoi(vert_word);
-          cell->vertex_ids.push_back(numValue-1);
-        }
-        catch(const std::invalid_argument& ia)
-        {
-          Chi::log.Log0Warning()
-          << "Failed converting work to number in line "
-          << file_line << std::endl;
-        }
-
-        //============================= Stop word extraction on line end
-        if (end_of_word==std::string::npos) {break;}
-      }
+      cell->vertex_ids = face_vertex_ids;
 
       //Build faces
-      const size_t num_verts = cell->vertex_ids.size();
+      cell->faces.reserve(num_verts);
       for (uint64_t v=0;v<num_verts; ++v)
       {
         LightWeightFace face;
@@ -173,31 +148,11 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
     }//if (first_word == "f")
 
     //===================================================== Keyword "l" for edge
-    if (first_word == "l")
+    else if (first_word == "l")
     {
       Edge edge;
-      for (int k=1;k<=2;++k)
-      {
-        //================================== Extract sub word
-        beg_of_word = file_line.find_first_not_of(delimiter, end_of_word);
-        end_of_word = file_line.find(delimiter, beg_of_word);
-        sub_word = file_line.substr(beg_of_word, end_of_word-beg_of_word);
-
-        //================================== Convert word to number
-        try
-        {
-          int vertex_id = std::stoi(sub_word);
-          if (k==1) edge.first  = vertex_id-1;
-          if (k==2) edge.second = vertex_id-1;
-        }
-
-        //================================== Catch conversion error
-        catch(const std::invalid_argument& ia)
-        {
-          Chi::log.Log0Warning()
-            << "Failed to text to integer in line " << file_line << std::endl;
-        }
-      }//for k
+      edge.first  = ToVertexIndex(chi::PopToken(file_line));
+      edge.second = ToVertexIndex(chi::PopToken(file_line));
 
       if (block_data.empty())
         throw std::logic_error(fname + ": Could not add edge to block-data. "
@@ -207,7 +162,6 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
       block_data.back().edges.push_back(edge);
     }//if (first_word == "l")
   }
-  file.close();
   Chi::log.Log0Verbose0() << "Max material id: " << material_id;
 
   //======================================================= Filter blocks
@@ -246,6 +200,10 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
       for (size_t vid : cell_ptr->vertex_ids)
         cell_vertex_id_set.insert(vid);
 
+    if (not cell_vertex_id_set.empty() and
+        *cell_vertex_id_set.rbegin() >= file_vertices.size())
+      throw std::logic_error(fname + ": Face vertex index out of range.");
+
     //Make cell_vertices and edit map
     {
       size_t new_id = 0;
@@ -267,19 +225,37 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
       }
 
     //Find a match for each boundary vertex and
-    //place it in the map
+    //place it in the map. Cell vertices are sorted
+    //along x such that only those within the
+    //tolerance along x are compared.
+    const double tolerance = 1.0e-6;
+    std::vector<size_t> cvids_by_x(cell_vertices.size());
+    for (size_t cvid=0; cvid<cell_vertices.size(); ++cvid)
+      cvids_by_x[cvid] = cvid;
+    std::sort(cvids_by_x.begin(), cvids_by_x.end(),
+              [&cell_vertices](size_t a, size_t b)
+              { return cell_vertices[a].x < cell_vertices[b].x; });
+
     for (size_t bvid : bndry_vertex_id_set)
     {
+      if (bvid >= file_vertices.size())
+        throw std::logic_error(fname + ": Edge vertex index out of range.");
       const auto& bndry_vertex = file_vertices[bvid];
 
+      auto cvid_it = std::lower_bound(
+        cvids_by_x.begin(), cvids_by_x.end(), bndry_vertex.x - tolerance,
+        [&cell_vertices](size_t cvid, double x)
+        { return cell_vertices[cvid].x < x; });
+
       bool match_found = false;
-      for (size_t cvid=0; cvid<cell_vertices.size(); ++cvid)
+      for (; cvid_it != cvids_by_x.end(); ++cvid_it)
       {
-        const auto& cell_vertex = cell_vertices[cvid];
+        const auto& cell_vertex = cell_vertices[*cvid_it];
+        if (cell_vertex.x > bndry_vertex.x + tolerance) break;
 
         if ((bndry_vertex - cell_vertex).NormSquare() < 1.0e-12)
         {
-          vertex_map[bvid] = cvid;
+          vertex_map[bvid] = *cvid_it;
           match_found = true;
           break;
         }
@@ -327,11 +303,16 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
   }
   else
   {
-    std::vector<LightWeightFace*> bndry_faces;
+    //Boundary faces keyed by their sorted vertex ids
+    std::map<Edge, LightWeightFace*> bndry_faces;
+    auto EdgeKey = [](uint64_t a, uint64_t b)
+    { return a < b ? Edge(a, b) : Edge(b, a); };
+
     for (auto& cell_ptr : raw_cells_)
       for (auto& face : cell_ptr->faces)
         if (not face.has_neighbor)
-          bndry_faces.push_back(&face);
+          bndry_faces.emplace(EdgeKey(face.vertex_ids[0],
+                                      face.vertex_ids[1]), &face);
 
     size_t bndry_id = 0;
     for (size_t bid : bndry_block_ids)
@@ -341,20 +322,12 @@ void chi_mesh::UnpartitionedMesh::ReadFromWavefrontOBJ(const Options &options)
       size_t num_faces_boundarified = 0;
       for (const auto& edge : bndry_edges)
       {
-        std::set<size_t> edge_vert_id_set({edge.first,edge.second});
-
-        for (auto& face_ptr : bndry_faces)
+        auto face_it = bndry_faces.find(EdgeKey(edge.first, edge.second));
+        if (face_it != bndry_faces.end())
         {
-          const auto& vert_ids = face_ptr->vertex_ids;
-          std::set<size_t> face_vert_id_set(vert_ids.begin(), vert_ids.end());
-
-          if (face_vert_id_set == edge_vert_id_set)
-          {
-            face_ptr->neighbor = bndry_id;
-            ++num_faces_boundarified;
-            break;
-          }
-        }//for face
+          face_it->second->neighbor = bndry_id;
+          ++num_faces_boundarified;
+        }
       }//for edge
 
       Chi::log.Log()
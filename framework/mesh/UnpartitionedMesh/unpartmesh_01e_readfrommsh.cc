@@ -2,103 +2,412 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
 
 #include "chi_mpi.h"
 
 #include <map>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <string_view>
+#include <type_traits>
+
+namespace
+{
+//###################################################################
+/**A msh file read into memory with one block read, parsed with a cursor.
+ * Numbers are parsed as text or, in binary mode, copied from the file
+ * bytes with the size of the requested type.*/
+class MshFile
+{
+private:
+  const std::string fname_;
+  std::vector<char> data_;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  bool binary_ = false;
+
+public:
+  MshFile(const std::string& file_name, const std::string& fname) :
+    fname_(fname)
+  {
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+    if (not file.is_open())
+    {
+      Chi::log.LogAllError()
+        << "Failed to open file: "<< file_name<<" in call "
+        << "to ReadFromMsh \n";
+      Chi::Exit(EXIT_FAILURE);
+    }
+    size_ = static_cast<size_t>(file.tellg());
+    data_.resize(size_ + 1, '\0'); //terminates the text parsing
+    file.seekg(0);
+    file.read(data_.data(), static_cast<std::streamsize>(size_));
+    if (not file)
+      throw std::logic_error(fname_ + ": Failed to read " + file_name);
+  }
+
+  void SetBinary(bool binary) { binary_ = binary; }
+  void Seek(size_t position) { pos_ = std::min(position, size_); }
+
+  /**Moves the cursor after the header line of the given section, e.g.
+   * "$Nodes", searching forward. Returns false if there is none.*/
+  bool FindSection(const std::string& name)
+  {
+    const std::string_view view(data_.data(), size_);
+    for (size_t p = view.find(name, pos_); p != std::string_view::npos;
+         p = view.find(name, p + 1))
+    {
+      const size_t end = p + name.size();
+      if ((p == 0 or view[p - 1] == '\n') and
+          (end == size_ or view[end] == '\n' or view[end] == '\r'))
+      {
+        pos_ = end;
+        SkipLine();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**Moves the cursor to the start of the next line.*/
+  void SkipLine()
+  {
+    const void* eol = std::memchr(data_.data() + pos_, '\n', size_ - pos_);
+    pos_ = eol ? static_cast<const char*>(eol) - data_.data() + 1 : size_;
+  }
+
+  /**Skips the given number of records, lines of text or of the given
+   * size in binary mode.*/
+  void SkipRecords(size_t num_records, size_t record_size)
+  {
+    if (binary_)
+    {
+      Seek(pos_ + num_records * record_size);
+      return;
+    }
+    for (size_t r = 0; r < num_records; ++r) SkipLine();
+  }
+
+  /**Moves past the end of the current text record.*/
+  void EndRecord() { if (not binary_) SkipLine(); }
+
+  /**Reads the next number.*/
+  template<typename T>
+  T Read()
+  {
+    T value;
+    ReadArray(&value, 1);
+    return value;
+  }
+
+  /**Reads the next `n` numbers into the given array, with a single copy
+   * in binary mode.*/
+  template<typename T>
+  void ReadArray(T* values, size_t n)
+  {
+    if (binary_)
+    {
+      if (n * sizeof(T) > size_ - pos_)
+        throw std::logic_error(fname_ + ": Unexpected end of file.");
+      std::memcpy(values, data_.data() + pos_, n * sizeof(T));
+      pos_ += n * sizeof(T);
+      return;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      const char* begin = data_.data() + pos_;
+      char* end = nullptr;
+      if constexpr (std::is_floating_point_v<T>)
+        values[i] = static_cast<T>(std::strtod(begin, &end));
+      else
+        values[i] = static_cast<T>(std::strtoll(begin, &end, 10));
+      if (end == begin)
+        throw std::logic_error(fname_ + ": Failed to read a number at "
+                                        "byte " + std::to_string(pos_) + ".");
+      pos_ = end - data_.data();
+    }
+  }
+};
+
+/**Returns the number of nodes of a msh element type, 0 for unsupported
+ * types.*/
+size_t NumElementNodes(int element_type)
+{
+  switch (element_type)
+  {
+    case 1: return 2;  //2-node line
+    case 2: return 3;  //3-node triangle
+    case 3: return 4;  //4-node quadrangle
+    case 4: return 4;  //4-node tetrahedron
+    case 5: return 8;  //8-node hexahedron
+    case 6: return 6;  //6-node prism
+    case 7: return 5;  //5-node pyramid
+    case 15: return 1; //1-node point
+    default: return 0;
+  }
+}
+
+/**Returns the range of the `n` items parsed by this location, all of
+ * them unless the reading is distributed.*/
+std::pair<size_t, size_t> LocalRange(size_t n, bool distributed)
+{
+  if (not distributed) return {0, n};
+  const auto loc = static_cast<size_t>(Chi::mpi.location_id);
+  const auto num_locs = static_cast<size_t>(Chi::mpi.process_count);
+  return {n * loc / num_locs, n * (loc + 1) / num_locs};
+}
+
+/**Concatenates the element records of all the locations, in location
+ * order.*/
+std::vector<int64_t> AllGatherRecords(const std::vector<int64_t>& local)
+{
+  const int num_locations = Chi::mpi.process_count;
+
+  ChiLogicalErrorIf(local.size() > static_cast<size_t>(INT_MAX),
+                    "Too many element records on one location.");
+  const int local_count = static_cast<int>(local.size());
+  std::vector<int> counts(num_locations, 0);
+  MPI_Allgather(&local_count, 1, MPI_INT,
+                counts.data(), 1, MPI_INT, Chi::mpi.comm);
+
+  std::vector<int> displacements(num_locations, 0);
+  size_t total_count = 0;
+  for (int locI = 0; locI < num_locations; ++locI)
+  {
+    displacements[locI] = static_cast<int>(total_count);
+    total_count += counts[locI];
+    ChiLogicalErrorIf(total_count > static_cast<size_t>(INT_MAX),
+                      "Too many element records to gather.");
+  }
+
+  std::vector<int64_t> records(total_count);
+  MPI_Allgatherv(local.data(), local_count, MPI_INT64_T,
+                 records.data(), counts.data(), displacements.data(),
+                 MPI_INT64_T, Chi::mpi.comm);
+  return records;
+}
+}//namespace
 
 //###################################################################
-/**Reads an unpartitioned mesh from a gmesh .msh legacy ASCII format 2 file.*/
+/**Reads an unpartitioned mesh from a gmsh .msh file, in the legacy ASCII
+ * format 2.2 or in the ASCII or binary format 4.1.
+ *
+ * The file is read into memory at once. When all the locations read the
+ * mesh, each one parses a contiguous range of the elements, whose
+ * records are then gathered by all the locations in file order.*/
 void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 {
   const std::string fname = "chi_mesh::UnpartitionedMesh::ReadFromMsh";
+  const bool distributed = not options.home_location_ingestion and
+                           Chi::mpi.process_count > 1;
 
   //===================================================== Opening the file
-  std::ifstream file;
-  file.open(options.file_name);
-  if (!file.is_open())
-  {
-    Chi::log.LogAllError()
-      << "Failed to open file: "<< options.file_name<<" in call "
-      << "to ReadFromMsh \n";
-    Chi::Exit(EXIT_FAILURE);
-  }
+  MshFile file(options.file_name, fname);
 
   Chi::log.Log() << "Making Unpartitioned mesh from msh format file "
                 << options.file_name;
-  Chi::mpi.Barrier();
-
-  //===================================================== Declarations
-  std::string file_line;
-  std::istringstream iss;
-  const std::string node_section_name="$Nodes";
-  const std::string elements_section_name = "$Elements";
-  const std::string format_section_name = "$MeshFormat";
+  if (distributed) Chi::mpi.Barrier();
 
   //=================================================== Check the format of this input
-  // Role file forward until "$MeshFormat" line is encountered.
-  while (std::getline(file, file_line))
-    if ( format_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  double format;
-  if ( !(iss >> format) )
-    throw std::logic_error(fname + ": Failed to read the file format.");
-  else if (format != 2.2)
-    throw std::logic_error(fname + ": Currently, only msh format 2.2 is supported.");
-
-  //=================================================== Find section with node
-  //                                                    information and then
-  //                                                    read the nodes
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( node_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  int num_nodes;
-  if ( !(iss >> num_nodes) )
-    throw std::logic_error(fname + ": Failed while trying to read "
-                                   "the number of nodes.");
+  if (not file.FindSection("$MeshFormat"))
+    throw std::logic_error(fname + ": Failed to find the file format.");
+
+  const auto format = file.Read<double>();
+  const auto file_type = file.Read<int>();
+  const auto data_size = file.Read<int>();
+  file.SkipLine();
+
+  if (format != 2.2 and format != 4.1)
+    throw std::logic_error(fname + ": Currently, only msh formats 2.2 and "
+                                   "4.1 are supported.");
+  if (file_type == 1)
+  {
+    if (format != 4.1)
+      throw std::logic_error(fname + ": Binary msh files are only supported "
+                                     "in format 4.1.");
+    if (data_size != sizeof(size_t))
+      throw std::logic_error(fname + ": Unsupported binary data size " +
+                             std::to_string(data_size) + ".");
+    file.SetBinary(true);
+    if (file.Read<int>() != 1)
+      throw std::logic_error(fname + ": The binary file has a different "
+                                     "endianness.");
+  }
+
+  // Element records are: type, physical region, number of nodes, node tags
+  std::vector<int64_t> local_records;
+  std::vector<size_t> record_nodes;
+  auto AddRecord = [&local_records, &record_nodes](int elem_type,
+                                                    int physical_reg)
+  {
+    local_records.push_back(elem_type);
+    local_records.push_back(physical_reg);
+    local_records.push_back(static_cast<int64_t>(record_nodes.size()));
+    for (size_t node : record_nodes)
+      local_records.push_back(static_cast<int64_t>(node));
+  };
 
   vertices_.clear();
-  vertices_.resize(num_nodes);
+  if (format == 2.2)
+  {
+    //================================================ Read the nodes
+    if (not file.FindSection("$Nodes"))
+      throw std::logic_error(fname + ": Failed to find the nodes.");
+
+    const auto num_nodes = file.Read<size_t>();
+    vertices_.resize(num_nodes);
+    for (size_t n = 0; n < num_nodes; ++n)
+    {
+      const auto vert_index = file.Read<size_t>();
+      if (vert_index < 1 or vert_index > num_nodes)
+        throw std::logic_error(fname + ": Invalid vertex index " +
+                               std::to_string(vert_index) + ".");
+      file.ReadArray(&vertices_[vert_index - 1].x, 3);
+    }
+
+    //================================================ Read the local elements
+    if (not file.FindSection("$Elements"))
+      throw std::logic_error(fname + ": Failed to find the elements.");
 
-  for (int n=0; n<num_nodes; n++)
+    const auto num_elems = file.Read<size_t>();
+    file.SkipLine();
+
+    const auto [begin, end] = LocalRange(num_elems, distributed);
+    file.SkipRecords(begin, 0);
+    std::vector<int> tags;
+    for (size_t n = begin; n < end; ++n)
+    {
+      file.Read<int64_t>(); //element index
+      const auto elem_type = file.Read<int>();
+      const auto num_tags = file.Read<size_t>();
+      tags.resize(num_tags);
+      file.ReadArray(tags.data(), num_tags);
+
+      record_nodes.resize(NumElementNodes(elem_type));
+      if (record_nodes.empty())
+        throw std::logic_error(fname + ": Unsupported element encountered.");
+      file.ReadArray(record_nodes.data(), record_nodes.size());
+      file.EndRecord();
+
+      if (elem_type != 15) //skip point type elements
+        AddRecord(elem_type, tags.empty() ? 0 : tags.front());
+    }
+  }
+  else
   {
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
-
-    int vert_index;
-    if ( !(iss >> vert_index) )
-      throw std::logic_error(fname + ": Failed to read vertex index.");
-
-    if (!(iss >> vertices_[vert_index - 1].x
-              >> vertices_[vert_index - 1].y
-              >> vertices_[vert_index - 1].z))
-      throw std::logic_error(fname + ": Failed while reading the vertex "
-                                     "coordinates.");
+    //================================================ Read the entities
+    // Maps entity dimension and tag to the first physical tag
+    std::map<std::pair<int, int>, int> entity_physical_regs;
+    if (file.FindSection("$Entities"))
+    {
+      size_t num_entities[4];
+      file.ReadArray(num_entities, 4);
+      std::vector<double> bounds(6);
+      std::vector<int> tags;
+      auto ReadTags = [&file, &tags]()
+      {
+        tags.resize(file.Read<size_t>());
+        file.ReadArray(tags.data(), tags.size());
+      };
+
+      for (int dim = 0; dim < 4; ++dim)
+        for (size_t e = 0; e < num_entities[dim]; ++e)
+        {
+          const auto entity_tag = file.Read<int>();
+          file.ReadArray(bounds.data(), dim == 0 ? 3 : 6);
+          ReadTags();
+          entity_physical_regs[{dim, entity_tag}] =
+            tags.empty() ? 0 : tags.front();
+          if (dim > 0) ReadTags(); //bounding entities
+        }
+    }
+
+    //================================================ Read the nodes
+    if (not file.FindSection("$Nodes"))
+      throw std::logic_error(fname + ": Failed to find the nodes.");
+
+    size_t node_header[4]; //blocks, nodes, min tag, max tag
+    file.ReadArray(node_header, 4);
+    vertices_.resize(node_header[3]);
+
+    std::vector<size_t> node_tags;
+    std::vector<double> coords;
+    for (size_t b = 0; b < node_header[0]; ++b)
+    {
+      const auto entity_dim = file.Read<int>();
+      file.Read<int>(); //entity tag
+      const auto parametric = file.Read<int>();
+      const auto num_block_nodes = file.Read<size_t>();
+
+      node_tags.resize(num_block_nodes);
+      file.ReadArray(node_tags.data(), num_block_nodes);
+
+      const size_t num_coords = 3 + (parametric ? entity_dim : 0);
+      coords.resize(num_block_nodes * num_coords);
+      file.ReadArray(coords.data(), coords.size());
+
+      for (size_t n = 0; n < num_block_nodes; ++n)
+      {
+        if (node_tags[n] < 1 or node_tags[n] > vertices_.size())
+          throw std::logic_error(fname + ": Invalid node tag " +
+                                 std::to_string(node_tags[n]) + ".");
+        const double* xyz = &coords[n * num_coords];
+        vertices_[node_tags[n] - 1] = chi_mesh::Vertex(xyz[0], xyz[1], xyz[2]);
+      }
+    }
+
+    //================================================ Read the local elements
+    if (not file.FindSection("$Elements"))
+      throw std::logic_error(fname + ": Failed to find the elements.");
+
+    size_t elem_header[4]; //blocks, elements, min tag, max tag
+    file.ReadArray(elem_header, 4);
+
+    const auto [begin, end] = LocalRange(elem_header[1], distributed);
+    size_t block_begin = 0;
+    for (size_t b = 0; b < elem_header[0]; ++b)
+    {
+      const auto entity_dim = file.Read<int>();
+      const auto entity_tag = file.Read<int>();
+      const auto elem_type = file.Read<int>();
+      const auto num_block_elems = file.Read<size_t>();
+      file.EndRecord();
+
+      const size_t num_elem_nodes = NumElementNodes(elem_type);
+      if (num_elem_nodes == 0)
+        throw std::logic_error(fname + ": Unsupported element encountered.");
+      const size_t record_size = (1 + num_elem_nodes) * sizeof(size_t);
+
+      //Local elements of the block
+      const size_t block_end = block_begin + num_block_elems;
+      const size_t first = std::clamp(begin, block_begin, block_end);
+      const size_t last = std::clamp(end, block_begin, block_end);
+
+      const auto physical_reg = entity_physical_regs[{entity_dim, entity_tag}];
+      file.SkipRecords(first - block_begin, record_size);
+      record_nodes.resize(num_elem_nodes);
+      for (size_t n = first; n < last; ++n)
+      {
+        file.Read<size_t>(); //element tag
+        file.ReadArray(record_nodes.data(), num_elem_nodes);
+        file.EndRecord();
+
+        if (elem_type != 15) //skip point type elements
+          AddRecord(elem_type, physical_reg);
+      }
+      file.SkipRecords(block_end - last, record_size);
+      block_begin = block_end;
+    }
   }
 
-  //================================================== Define utility lambdas
-  /**Lambda for reading nodes.*/
-  auto ReadNodes = [&iss,&fname](int num_nodes)
-  {
-    std::vector<int> raw_nodes(num_nodes,0);
-    for (int i=0; i<num_nodes; ++i)
-      if ( !(iss >> raw_nodes[i]) )
-        throw std::logic_error(fname + ": Failed when reading element "
-                                       "node index.");
-
-    std::vector<uint64_t> nodes(num_nodes,0);
-    for (int i=0; i<num_nodes; ++i)
-      if ((raw_nodes[i]-1)>=0)
-        nodes[i] = raw_nodes[i]-1;
-    return nodes;
-  };
+  const std::vector<int64_t> records =
+    distributed ? AllGatherRecords(local_records) : std::move(local_records);
 
+  //================================================== Define utility lambdas
   /**Lamda for checking if an element is 1D.*/
   auto IsElementType1D = [](int element_type)
   {
@@ -126,15 +435,6 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
     return false;
   };
 
-  /**Lambda for checking supported elements.*/
-  auto IsElementSupported = [](int element_type)
-  {
-    if (element_type >= 1 and element_type <= 7)
-      return true;
-
-    return false;
-  };
-
   /**Lambda giving the cell subtype, given the MSH cell type.*/
   auto CellTypeFromMSHTypeID = [](int element_type)
   {
@@ -155,101 +455,25 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
   // Only 2D and 3D meshes are supported. If the mesh
   // is 1D then no elements will be read but the state
   // would still be safe.
-  // This section will run through all the elements
-  // looking for a 3D element. It will not process
-  // any elements.
   bool mesh_is_2D_assumption = true;
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( elements_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  int num_elems;
-  if (!(iss >> num_elems))
-    throw std::logic_error(fname + ": Failed to read number of elements.");
-
-  for (int n=0; n<num_elems; n++)
-  {
-    int elem_type, num_tags, physical_reg, tag, element_index;
-
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
-
-    if ( !(iss >> element_index >> elem_type >> num_tags) )
-      throw std::logic_error(fname + ": Failed while reading element index, "
-                                     "element type, and number of tags.");
-
-    if( !(iss>>physical_reg) )
-      throw std::logic_error(fname + ": Failed while reading physical region.");
-
-    for (int i=1; i<num_tags; i++)
-      if( !(iss >> tag) )
-        throw std::logic_error(fname + ": Failed when reading tags.");
-
-    if (IsElementType3D(elem_type))
+  for (size_t r = 0; r < records.size(); r += 3 + records[r + 2])
+    if (IsElementType3D(static_cast<int>(records[r])))
     {
       mesh_is_2D_assumption = false;
       Chi::log.Log() << "Mesh identified as 3D.";
       break; //have the answer now leave loop
     }
 
-    if (elem_type == 15) //skip point type element
-      continue;
-
-    if (not IsElementSupported(elem_type))
-      throw std::logic_error(fname + ": Unsupported element encountered.");
-  }//for n
-
-  //================================================== Return to the element
-  //                                                   listing section
-  // Now we will actually read the elements.
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( elements_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  if (!(iss >> num_elems))
-    throw std::logic_error(fname + ": Failed to read number of elements.");
-
-  for (int n=0; n<num_elems; n++)
+  //================================================== Make the cells
+  for (size_t r = 0; r < records.size(); r += 3 + records[r + 2])
   {
-    int elem_type, num_tags, physical_reg, tag, element_index;
+    const auto elem_type = static_cast<int>(records[r]);
+    const auto physical_reg = static_cast<int>(records[r + 1]);
+    const auto num_cell_nodes = static_cast<size_t>(records[r + 2]);
 
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
+    Chi::log.Log0Verbose2() << "Reading element type: " << elem_type;
 
-    if ( !(iss >> element_index >> elem_type >> num_tags) )
-      throw std::logic_error(fname + ": Failed while reading element index, "
-                                     "element type, and number of tags.");
-
-    if( !(iss>>physical_reg) )
-      throw std::logic_error(fname + ": Failed while reading physical region.");
-
-    for (int i=1; i<num_tags; i++)
-      if ( !(iss >> tag) )
-        throw std::logic_error(fname + ": Failed when reading tags.");
-
-    if (elem_type == 15) //skip point type elements
-      continue;
-
-    if (not IsElementSupported(elem_type))
-      throw std::logic_error(fname + ": Unsupported element encountered.");
-
-    Chi::log.Log0Verbose2() << "Reading element: " << file_line
-                                << " type: " << elem_type;
-
-    int num_cell_nodes;
-    if (elem_type == 1)
-      num_cell_nodes = 2;
-    else if (elem_type == 2)      //3-node triangle
-      num_cell_nodes = 3;
-    else if (elem_type == 3 or elem_type == 4) //4-node quadrangle or tet
-      num_cell_nodes = 4;
-    else if (elem_type == 5) //8-node hexahedron
-      num_cell_nodes = 8;
-    else
+    if (elem_type > 5) //prisms and pyramids are not read
       continue;
 
     //====================================== Make the cell on either the volume
@@ -293,7 +517,12 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 
     auto& cell = *raw_cell;
     cell.material_id = physical_reg;
-    cell.vertex_ids = ReadNodes(num_cell_nodes);
+    cell.vertex_ids.resize(num_cell_nodes);
+    for (size_t i = 0; i < num_cell_nodes; ++i)
+    {
+      const auto node = records[r + 3 + i];
+      cell.vertex_ids[i] = node >= 1 ? static_cast<uint64_t>(node - 1) : 0;
+    }
 
     //====================================== Populate faces
     if (elem_type == 1)                        // 2-node edge
@@ -349,8 +578,6 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 
   }//for elements
 
-  file.close();
-
   //======================================== Remap material-ids
   std::set<int>     material_ids_set_as_read;
   std::map<int,int> material_mapping;
@@ -393,6 +620,3 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
                  << "Number of nodes read: " << vertices_.size() << "\n"
                  << "Number of cells read: " << raw_cells_.size();
 }
-
-
-
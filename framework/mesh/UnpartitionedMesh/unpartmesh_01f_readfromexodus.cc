@@ -13,13 +13,16 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 #define ErrorReadingFile(fname) \
 std::runtime_error("Failed to open file: " + options.file_name + \
 " in call to " + #fname + ".")
 
 //###################################################################
-/**Reads an Exodus unstructured mesh.*/
+/**Reads an Exodus unstructured mesh. When all the locations read the
+ * mesh, only the home location reads the file and broadcasts the mesh to
+ * the other locations.*/
 void chi_mesh::UnpartitionedMesh::
   ReadFromExodus(const chi_mesh::UnpartitionedMesh::Options &options)
 {
@@ -31,8 +34,19 @@ void chi_mesh::UnpartitionedMesh::
   if (!file.is_open()) throw ErrorReadingFile(ReadFromExodus);
   file.close();
 
-  //======================================== Read the file
+  //======================================== Receive from the home location
   mesh_options_ = options;
+  const bool broadcast = not options.home_location_ingestion and
+                         Chi::mpi.process_count > 1;
+  if (broadcast and Chi::mpi.location_id != 0)
+  {
+    BroadcastFromHomeLocation();
+    Chi::log.Log() << "Done reading Exodus file: "
+                   << options.file_name << ".";
+    return;
+  }
+
+  //======================================== Read the file
   auto reader = vtkSmartPointer<vtkExodusIIReader>::New();
   reader->SetFileName(options.file_name.c_str());
 
@@ -128,6 +142,8 @@ void chi_mesh::UnpartitionedMesh::
   //======================================== Set boundary ids
   SetBoundaryIDsFromBlocks(bndry_grid_blocks);
 
+  if (broadcast) BroadcastFromHomeLocation();
+
   Chi::log.Log() << "Done reading Exodus file: "
                  << options.file_name << ".";
 }
\ No newline at end of file
@@ -34,6 +34,11 @@ private:
   uint64_t zmax_bndry_id = 4;
   uint64_t zmin_bndry_id = 5;
 
+  std::vector<int>      template_cell_xy_pids_; ///< One per template cell
+  std::vector<int>      layer_z_pids_;          ///< One per cell layer
+  std::vector<uint64_t> local_scope_template_cells_;
+  std::vector<size_t>   local_scope_layers_;
+
 public:
   explicit
   VolumeMesherExtruder(std::shared_ptr<const chi_mesh::UnpartitionedMesh> in_unpartitioned_mesh) :
@@ -53,13 +58,8 @@ private:
 
   chi_mesh::Vector3 ProjectCentroidToLevel(const chi_mesh::Vector3& centroid,
                                            size_t level);
-  int GetCellKBAPartitionIDFromCentroid(chi_mesh::Vector3& centroid);
-
 
-  bool HasLocalScope(
-    const chi_mesh::Cell& template_cell,
-    const chi_mesh::MeshContinuum& template_continuum,
-    size_t z_level);
+  void DetermineLocalScope(const chi_mesh::MeshContinuum& template_grid);
 
   std::unique_ptr<chi_mesh::Cell>
   MakeExtrudedCell(const chi_mesh::Cell& template_cell,
@@ -7,6 +7,8 @@
 
 #include "chi_mpi.h"
 
+#include <algorithm>
+
 
 //###################################################################
 /** Creates nodes that are owned locally from the 2D template grid.*/
@@ -15,46 +17,37 @@ CreateLocalNodes(chi_mesh::MeshContinuum& template_grid,
                  chi_mesh::MeshContinuum& grid)
 {
   //================================================== For each layer
-  std::set<uint64_t> vertex_ids_with_local_scope;
-  for (size_t iz=0; iz<(vertex_layers_.size() - 1); iz++)
+  std::vector<uint64_t> vertex_ids_with_local_scope;
+  for (size_t iz : local_scope_layers_)
   {
-    for (const auto& template_cell : template_grid.local_cells)
+    for (uint64_t tc_id : local_scope_template_cells_)
     {
-      // Check template cell type
-      if (template_cell.Type() != chi_mesh::CellType::POLYGON)
-        throw std::logic_error("Extruder::CreateLocalNodes: "
-                               "Template cell error. Not of base type POLYGON");
-
-      bool has_local_scope = HasLocalScope(template_cell, template_grid, iz);
-
-      if (has_local_scope)
-      {
-        auto& vertex_set = vertex_ids_with_local_scope;
-        for (auto tc_vid : template_cell.vertex_ids_)
-          vertex_set.insert(tc_vid + iz * node_z_index_incr_);
-
-        for (auto tc_vid : template_cell.vertex_ids_)
-          vertex_set.insert(tc_vid + (iz + 1) * node_z_index_incr_);
-      }
+      const auto& template_cell = template_grid.local_cells[tc_id];
+
+      auto& vertex_list = vertex_ids_with_local_scope;
+      for (auto tc_vid : template_cell.vertex_ids_)
+        vertex_list.push_back(tc_vid + iz * node_z_index_incr_);
+
+      for (auto tc_vid : template_cell.vertex_ids_)
+        vertex_list.push_back(tc_vid + (iz + 1) * node_z_index_incr_);
     }//for template cell
   }//for layer
 
+  auto& vertex_list = vertex_ids_with_local_scope;
+  std::sort(vertex_list.begin(), vertex_list.end());
+  vertex_list.erase(std::unique(vertex_list.begin(), vertex_list.end()),
+                    vertex_list.end());
+
   //============================================= Now add all nodes
   //                                              that are local or neighboring
-  uint64_t vid = 0;
-  for (auto layer_z_level : vertex_layers_)
+  for (uint64_t vid : vertex_list)
   {
-    for (auto& id_vertex : template_grid.vertices)
-    {
-      const auto& vertex = id_vertex.second;
-      auto local_scope = vertex_ids_with_local_scope.find(vid);
-
-      if (local_scope != vertex_ids_with_local_scope.end())
-        grid.vertices.Insert(vid, Vector3(vertex.x, vertex.y, layer_z_level));
+    const size_t layer = vid / node_z_index_incr_;
+    const auto& vertex = template_grid.vertices[vid % node_z_index_incr_];
 
-      ++vid;
-    }//for vertex
-  }//for layer
+    grid.vertices.Insert(vid, Vector3(vertex.x, vertex.y,
+                                      vertex_layers_[layer]));
+  }
 
-  grid.SetGlobalVertexCount(vid);
-}
\ No newline at end of file
+  grid.SetGlobalVertexCount(vertex_layers_.size() * node_z_index_incr_);
+}
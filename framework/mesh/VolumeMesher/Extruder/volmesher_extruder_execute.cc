@@ -65,6 +65,35 @@ void chi_mesh::VolumeMesherExtruder::Execute()
       template_unpartitioned_mesh_->GetMeshOptions().boundary_id_map;
   }
 
+  //================================== Checking partitioning parameters
+  if (options.partition_type != KBA_STYLE_XYZ)
+  {
+    Chi::log.LogAllError()
+      << "Any partitioning scheme other than KBA_STYLE_XYZ is currently not"
+         " supported by VolumeMesherExtruder. No worries. There are plans"
+         " to develop this support.";
+    Chi::Exit(EXIT_FAILURE);
+  }
+  if (!options.mesh_global)
+  {
+    int p_tot = options.partition_x*options.partition_y*options.partition_z;
+
+    if (Chi::mpi.process_count != p_tot)
+    {
+      Chi::log.LogAllError()
+        << "ERROR: Number of processors available ("
+        << Chi::mpi.process_count << ") does not match amount of processors "
+        << "required by surface mesher partitioning parameters ("
+        << p_tot << ").";
+      Chi::Exit(EXIT_FAILURE);
+    }
+  }//if mesh-global
+
+  //================================== Determine local scope
+  Chi::log.Log0Verbose1()
+    << "VolumeMesherExtruder: Determining local scope" << std::endl;
+  DetermineLocalScope(*temp_grid);
+
   Chi::log.Log0Verbose1()
     << "VolumeMesherExtruder: Creating local nodes" << std::endl;
   CreateLocalNodes(*temp_grid, *grid);
@@ -102,32 +131,11 @@ void chi_mesh::VolumeMesherExtruder::Execute()
     << total_global_cells
     << std::endl;
 
-  //================================== Checking partitioning parameters
-  if (options.partition_type != KBA_STYLE_XYZ)
-  {
-    Chi::log.LogAllError()
-      << "Any partitioning scheme other than KBA_STYLE_XYZ is currently not"
-         " supported by VolumeMesherExtruder. No worries. There are plans"
-         " to develop this support.";
-    Chi::Exit(EXIT_FAILURE);
-  }
-  if (!options.mesh_global)
-  {
-    int p_tot = options.partition_x*options.partition_y*options.partition_z;
-
-    if (Chi::mpi.process_count != p_tot)
-    {
-      Chi::log.LogAllError()
-        << "ERROR: Number of processors available ("
-        << Chi::mpi.process_count << ") does not match amount of processors "
-        << "required by surface mesher partitioning parameters ("
-        << p_tot << ").";
-      Chi::Exit(EXIT_FAILURE);
-    }
-  }//if mesh-global
-
   Chi::log.LogAllVerbose1() << "Building local cell indices";
 
+  //================================== Renumber local cells
+  ApplyLocalCellOrdering();
+
   //================================== Print info
   Chi::log.LogAllVerbose1()
     << "### LOCATION[" << Chi::mpi.location_id
@@ -5,6 +5,7 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 
 //###################################################################
@@ -62,92 +63,104 @@ chi_mesh::Vector3 chi_mesh::VolumeMesherExtruder::
 }
 
 //###################################################################
-/**Computes a cell's partition id based on a centroid.*/
-int chi_mesh::VolumeMesherExtruder::
-  GetCellKBAPartitionIDFromCentroid(chi_mesh::Vector3& centroid)
+/**Determines which template cells (columns) and which cell layers have
+ * local scope. The KBA partition id of an extruded cell is the product of
+ * an xy-index, depending only on the template cell, and a z-index,
+ * depending only on the layer. An extruded cell is therefore local, or a
+ * direct neighbor to the current partition, if and only if its template
+ * cell or one of its lateral neighbors has the local xy-index, and its
+ * layer or one of the adjacent layers has the local z-index. Both are
+ * determined here once, hence only the extruded cells within local scope
+ * are ever visited.*/
+void chi_mesh::VolumeMesherExtruder::
+  DetermineLocalScope(const chi_mesh::MeshContinuum& template_grid)
 {
-  int px = options.partition_x;
-  int py = options.partition_y;
-
-  chi_mesh::Cell n_gcell(CellType::GHOST, CellType::GHOST);
-  n_gcell.centroid_ = centroid;
-
-  auto xyz_partition_indices = GetCellXYZPartitionID(&n_gcell);
-
-  int nxi = std::get<0>(xyz_partition_indices);
-  int nyi = std::get<1>(xyz_partition_indices);
-  int nzi = std::get<2>(xyz_partition_indices);
+  const chi_mesh::Vector3 khat(0.0,0.0,1.0);
+  const int px = options.partition_x;
+  const int py = options.partition_y;
+  const int local_xy_pid = Chi::mpi.location_id % (px*py);
+  const int local_z_pid  = Chi::mpi.location_id / (px*py);
+
+  const size_t num_template_cells = template_grid.local_cells.size();
+  const size_t num_layers = vertex_layers_.size() - 1;
+
+  //======================================== Compute template cell xy-indices
+  template_cell_xy_pids_.assign(num_template_cells, 0);
+  for (const auto& template_cell : template_grid.local_cells)
+  {
+    //==================================== Check template cell type
+    if (template_cell.Type() != chi_mesh::CellType::POLYGON)
+      throw std::logic_error("Extruder::DetermineLocalScope: "
+                             "Template cell error. Not of base type POLYGON");
 
-  return nzi*px*py + nyi*px + nxi;
-}
+    //==================================== Check cell not inverted
+    {
+      const auto& v0 = template_cell.centroid_;
+      const auto& v1 = template_grid.vertices[template_cell.vertex_ids_[0]];
+      const auto& v2 = template_grid.vertices[template_cell.vertex_ids_[1]];
+
+      auto v01 = v1 - v0;
+      auto v02 = v2 - v0;
+
+      if (v01.Cross(v02).Dot(khat)<0.0)
+        throw std::logic_error("Extruder attempting to extrude a template"
+                               " cell with a normal pointing downward. This"
+                               " causes erratic behavior and needs to be"
+                               " corrected.");
+    }
 
+    chi_mesh::Cell n_gcell(CellType::GHOST, CellType::GHOST);
+    n_gcell.centroid_ = template_cell.centroid_;
 
-//###################################################################
-/**Determines if a template cell is in the current partition or a
- * direct neighbor to the current partition.*/
-bool chi_mesh::VolumeMesherExtruder::
-  HasLocalScope(
-    const chi_mesh::Cell& template_cell,
-    const chi_mesh::MeshContinuum& template_continuum,
-    size_t z_level)
-{
-  //======================================== Check if the template cell
-  //                                         is in the current partition
-  {
-    auto& centroid = template_cell.centroid_;
-    auto projected_centroid = ProjectCentroidToLevel(centroid, z_level);
-    int pid = GetCellKBAPartitionIDFromCentroid(projected_centroid);
-    if (pid == Chi::mpi.location_id)
-      return true;
+    const auto ij_id = GetCellXYPartitionID(&n_gcell);
+    template_cell_xy_pids_[template_cell.local_id_] =
+      ij_id.second*px + ij_id.first;
   }
 
-  const size_t last_z_level = vertex_layers_.size() - 1;
-  const size_t z_level_below = z_level - 1;
-  const size_t z_level_above = z_level + 1;
-
-  //======================================== Build z-levels to search
-  std::vector<size_t> z_levels_to_search;
-  z_levels_to_search.reserve(3);
+  //======================================== Compute layer z-indices
+  layer_z_pids_.assign(num_layers, 0);
+  for (size_t iz=0; iz<num_layers; ++iz)
+  {
+    chi_mesh::Cell n_gcell(CellType::GHOST, CellType::GHOST);
+    n_gcell.centroid_ = ProjectCentroidToLevel(chi_mesh::Vector3(), iz);
 
-                                   z_levels_to_search.push_back(z_level);
-  if (z_level != 0)                z_levels_to_search.push_back(z_level_below);
-  if (z_level != (last_z_level-1)) z_levels_to_search.push_back(z_level_above);
+    layer_z_pids_[iz] = std::get<2>(GetCellXYZPartitionID(&n_gcell));
+  }
 
-  //======================================== Search template cell's
-  //                                         lateral neighbors
+  //======================================== Find columns with local scope
   const auto& vertex_subs =
     template_unpartitioned_mesh_->GetVertextCellSubscriptions();
-  for (uint64_t vid : template_cell.vertex_ids_)
-    for (uint64_t cid : vertex_subs[vid])
-    {
-      if (cid == template_cell.local_id_) continue;
 
-      auto& candidate_cell =
-        template_continuum.local_cells[cid];
-      auto& cc_centroid = candidate_cell.centroid_;
+  local_scope_template_cells_.clear();
+  for (const auto& template_cell : template_grid.local_cells)
+  {
+    bool has_local_scope =
+      template_cell_xy_pids_[template_cell.local_id_] == local_xy_pid;
 
-      for (size_t z : z_levels_to_search)
-      {
-        auto projected_centroid = ProjectCentroidToLevel(cc_centroid, z);
-        int pid = GetCellKBAPartitionIDFromCentroid(projected_centroid);
-        if (pid == Chi::mpi.location_id)
-          return true;
-      }
-    }//for cid
+    for (uint64_t vid : template_cell.vertex_ids_)
+    {
+      if (has_local_scope) break;
+      for (uint64_t cid : vertex_subs[vid])
+        if (template_cell_xy_pids_[cid] == local_xy_pid)
+        { has_local_scope = true; break; }
+    }
 
-  //======================================== Search template cell's
-  //                                         longitudinal neighbors
-  for (size_t z : z_levels_to_search)
-  {
-    if (z == z_level) continue;
+    if (has_local_scope)
+      local_scope_template_cells_.push_back(template_cell.local_id_);
+  }
 
-    auto projected_centroid = ProjectCentroidToLevel(template_cell.centroid_, z);
-    int pid = GetCellKBAPartitionIDFromCentroid(projected_centroid);
-    if (pid == Chi::mpi.location_id)
-      return true;
-  }//for z
+  //======================================== Find layers with local scope
+  local_scope_layers_.clear();
+  for (size_t iz=0; iz<num_layers; ++iz)
+  {
+    const bool has_local_scope =
+      (layer_z_pids_[iz] == local_z_pid) or
+      (iz > 0 and layer_z_pids_[iz-1] == local_z_pid) or
+      (iz+1 < num_layers and layer_z_pids_[iz+1] == local_z_pid);
 
-  return false;
+    if (has_local_scope)
+      local_scope_layers_.push_back(iz);
+  }
 }
 
 //###################################################################
@@ -0,0 +1,36 @@
+#ifndef VOLMESHER_ORTHOPART_H
+#define VOLMESHER_ORTHOPART_H
+
+#include "../chi_volumemesher.h"
+
+#include <array>
+
+//###################################################################
+/**This volume mesher builds an orthogonal grid directly in partitioned
+ * form. Every location creates only its own KBA block, of the
+ * partition_x/y/z decomposition, and its ghost cells, such that no
+ * location ever holds the global mesh.
+ *
+ * Cell and vertex ids, face ordering and boundary ids are those of the
+ * chi_mesh::CreateUnpartitionedNDOrthoMesh macros.*/
+class chi_mesh::VolumeMesherOrthoPartitioned :
+                            public chi_mesh::VolumeMesher
+{
+private:
+  const size_t dimension_;
+  /**Nodes along x, y and z. Unused axes hold a single node at 0.*/
+  const std::array<std::vector<double>,3> nodes_;
+public:
+  VolumeMesherOrthoPartitioned(size_t dimension,
+                               std::array<std::vector<double>,3> nodes) :
+    VolumeMesher(VolumeMesherType::ORTHO_PARTITIONED),
+    dimension_(dimension),
+    nodes_(std::move(nodes)) {}
+
+  void Execute() override;
+
+private:
+  std::vector<int> MakeAxisPartitionIDs(size_t axis,
+                                        int num_partitions) const;
+};
+#endif //VOLMESHER_ORTHOPART_H
@@ -0,0 +1,298 @@
+#include "volmesher_orthopart.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/Cell/cell.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include "utils/chi_timer.h"
+#include "console/chi_console.h"
+
+#include <algorithm>
+
+namespace
+{
+typedef std::array<size_t,3> Offset;
+
+/**Vertices, as ijk offsets from the cell's lowest vertex, and neighbor
+ * direction of a face of an orthogonal cell.*/
+struct FaceTemplate
+{
+  size_t axis;
+  bool positive;
+  uint64_t boundary_id;
+  std::vector<Offset> vertices;
+};
+
+struct CellTemplate
+{
+  chi_mesh::CellType type;
+  chi_mesh::CellType sub_type;
+  std::vector<Offset> vertices;
+  std::vector<FaceTemplate> faces;
+};
+
+/**Returns the cell of the given dimension with the vertex and face
+ * ordering of the unpartitioned orthogonal mesh macros.*/
+CellTemplate MakeCellTemplate(size_t dimension)
+{
+  typedef chi_mesh::CellType CT;
+  if (dimension == 1)
+    return {CT::SLAB, CT::SLAB,
+            {{0,0,0},{0,0,1}},
+            {{2, false, 5/*ZMIN*/, {{0,0,0}}},
+             {2, true,  4/*ZMAX*/, {{0,0,1}}}}};
+
+  if (dimension == 2)
+    return {CT::POLYGON, CT::QUADRILATERAL,
+            {{0,0,0},{1,0,0},{1,1,0},{0,1,0}},
+            {{1, false, 3/*YMIN*/, {{0,0,0},{1,0,0}}},
+             {0, true,  0/*XMAX*/, {{1,0,0},{1,1,0}}},
+             {1, true,  2/*YMAX*/, {{1,1,0},{0,1,0}}},
+             {0, false, 1/*XMIN*/, {{0,1,0},{0,0,0}}}}};
+
+  return {CT::POLYHEDRON, CT::HEXAHEDRON,
+          {{0,0,0},{1,0,0},{1,1,0},{0,1,0},
+           {0,0,1},{1,0,1},{1,1,1},{0,1,1}},
+          {{0, true,  0/*XMAX*/, {{1,0,0},{1,1,0},{1,1,1},{1,0,1}}},
+           {0, false, 1/*XMIN*/, {{0,0,0},{0,0,1},{0,1,1},{0,1,0}}},
+           {1, true,  2/*YMAX*/, {{0,1,0},{0,1,1},{1,1,1},{1,1,0}}},
+           {1, false, 3/*YMIN*/, {{0,0,0},{1,0,0},{1,0,1},{0,0,1}}},
+           {2, true,  4/*ZMAX*/, {{0,0,1},{1,0,1},{1,1,1},{0,1,1}}},
+           {2, false, 5/*ZMIN*/, {{0,0,0},{0,1,0},{1,1,0},{1,0,0}}}}};
+}
+} // namespace
+
+//###################################################################
+/**Returns the partition index, along the given axis, of every cell
+ * index along that axis. Without cuts the cells are split evenly.
+ * Otherwise, as for the KBA partitioning of unpartitioned meshes, the
+ * subsets formed by the cuts are grouped per partition.*/
+std::vector<int> chi_mesh::VolumeMesherOrthoPartitioned::
+  MakeAxisPartitionIDs(size_t axis, int num_partitions) const
+{
+  const auto& nodes = nodes_[axis];
+  const size_t num_cells = std::max<size_t>(nodes.size(), 2) - 1;
+  const auto P = static_cast<size_t>(num_partitions);
+
+  ChiInvalidArgumentIf(num_partitions < 1 or num_cells < P,
+                       "Invalid number of partitions " +
+                       std::to_string(num_partitions) + " along axis " +
+                       std::to_string(axis) + " with " +
+                       std::to_string(num_cells) + " cells.");
+
+  std::vector<int> pids(num_cells, 0);
+  if (P == 1) return pids;
+
+  const std::array<const std::vector<double>*,3> axis_cuts =
+    {&options.xcuts, &options.ycuts, &options.zcuts};
+  const auto& cuts = *axis_cuts[axis];
+
+  if (cuts.empty())
+  {
+    for (size_t n = 0; n < num_cells; ++n)
+      pids[n] = static_cast<int>(n * P / num_cells);
+    return pids;
+  }
+
+  ChiInvalidArgumentIf((cuts.size() + 1) % P != 0,
+                       "The number of subsets formed by the cuts along axis " +
+                       std::to_string(axis) + " needs to be divisible by "
+                       "the number of partitions along it.");
+  const size_t subsets_per_partition = (cuts.size() + 1) / P;
+
+  for (size_t n = 0; n < num_cells; ++n)
+  {
+    const double center = 0.5 * (nodes[n] + nodes[n + 1]);
+    int p = 0;
+    for (size_t i = subsets_per_partition - 1; i < cuts.size();
+         i += subsets_per_partition, ++p)
+      if (center <= cuts[i]) break;
+    pids[n] = p;
+  }
+
+  return pids;
+}
+
+//###################################################################
+/**Creates the local block of cells and its ghost layer, either all the
+ * cells sharing a vertex with the block or only its face neighbors.
+ * Storage scales with the block, plus the nodes along each axis.*/
+void chi_mesh::VolumeMesherOrthoPartitioned::Execute()
+{
+  Chi::log.Log()
+    << Chi::program_timer.GetTimeString()
+    << " VolumeMesherOrthoPartitioned executing. Memory in use = "
+    << chi::Console::GetMemoryUsageInMB() << " MB"
+    << std::endl;
+
+  //======================================== Check partitioning params
+  const std::array<int,3> P = {options.partition_x,
+                               options.partition_y,
+                               options.partition_z};
+
+  ChiInvalidArgumentIf(P[0] * P[1] * P[2] != Chi::mpi.process_count,
+                       "The number of KBA partitions, " +
+                       std::to_string(P[0] * P[1] * P[2]) +
+                       ", does not match the number of processes, " +
+                       std::to_string(Chi::mpi.process_count) + ".");
+
+  //======================================== Partition the axes
+  const int location_id = Chi::mpi.location_id;
+  const std::array<int,3> block_ijk = {location_id % P[0],
+                                       (location_id / P[0]) % P[1],
+                                       location_id / (P[0] * P[1])};
+
+  std::array<std::vector<int>,3> axis_pids;
+  std::array<size_t,3> num_nodes = {0, 0, 0};
+  std::array<size_t,3> num_cells = {0, 0, 0};
+  std::array<size_t,3> block_begin = {0, 0, 0};
+  std::array<size_t,3> block_end = {0, 0, 0};
+  for (size_t d = 0; d < 3; ++d)
+  {
+    const auto& pids = axis_pids[d] = MakeAxisPartitionIDs(d, P[d]);
+    num_nodes[d] = nodes_[d].size();
+    num_cells[d] = pids.size();
+
+    const auto range =
+      std::equal_range(pids.begin(), pids.end(), block_ijk[d]);
+    block_begin[d] = range.first - pids.begin();
+    block_end[d] = range.second - pids.begin();
+
+    ChiLogicalErrorIf(block_begin[d] == block_end[d],
+                      "Location " + std::to_string(location_id) +
+                      " has no cells along axis " + std::to_string(d) + ".");
+  }
+
+  auto CellID = [&num_cells](const std::array<size_t,3>& ijk)
+  {
+    return (ijk[1] * num_cells[0] + ijk[0]) * num_cells[2] + ijk[2];
+  };
+  auto VertexID = [&num_nodes](const std::array<size_t,3>& ijk)
+  {
+    return (ijk[1] * num_nodes[0] + ijk[0]) * num_nodes[2] + ijk[2];
+  };
+  auto PartitionID = [&axis_pids, &P](const std::array<size_t,3>& ijk)
+  {
+    return static_cast<uint64_t>(axis_pids[2][ijk[2]] * P[0] * P[1] +
+                                 axis_pids[1][ijk[1]] * P[0] +
+                                 axis_pids[0][ijk[0]]);
+  };
+
+  //======================================== Create the cells
+  auto grid = chi_mesh::MeshContinuum::New();
+  const auto cell_template = MakeCellTemplate(dimension_);
+
+  auto MakeCell = [&](const std::array<size_t,3>& ijk)
+  {
+    auto cell = std::make_unique<chi_mesh::Cell>(cell_template.type,
+                                                 cell_template.sub_type);
+    cell->global_id_ = CellID(ijk);
+    cell->partition_id_ = PartitionID(ijk);
+
+    auto VertexIJK = [&ijk](const Offset& offset)
+    {
+      return std::array<size_t,3>{ijk[0] + offset[0],
+                                  ijk[1] + offset[1],
+                                  ijk[2] + offset[2]};
+    };
+
+    for (const auto& offset : cell_template.vertices)
+    {
+      const auto vijk = VertexIJK(offset);
+      const auto vid = VertexID(vijk);
+      cell->vertex_ids_.push_back(vid);
+      grid->vertices.Insert(vid, chi_mesh::Vector3(nodes_[0][vijk[0]],
+                                                   nodes_[1][vijk[1]],
+                                                   nodes_[2][vijk[2]]));
+    }
+
+    for (const auto& face_template : cell_template.faces)
+    {
+      chi_mesh::CellFace face;
+      for (const auto& offset : face_template.vertices)
+        face.vertex_ids_.push_back(VertexID(VertexIJK(offset)));
+
+      const size_t axis = face_template.axis;
+      face.has_neighbor_ = face_template.positive
+                             ? ijk[axis] + 1 < num_cells[axis]
+                             : ijk[axis] > 0;
+      if (face.has_neighbor_)
+      {
+        auto nb_ijk = ijk;
+        nb_ijk[axis] = face_template.positive ? ijk[axis] + 1
+                                              : ijk[axis] - 1;
+        face.neighbor_id_ = CellID(nb_ijk);
+      }
+      else
+        face.neighbor_id_ = face_template.boundary_id;
+
+      if (cell_template.type == CellType::SLAB)
+        face.normal_ = chi_mesh::Vector3(0.0, 0.0,
+                                         face_template.positive ? 1.0 : -1.0);
+      cell->faces_.push_back(std::move(face));
+    }
+
+    cell->RecomputeCentroidsAndNormals(*grid);
+    return cell;
+  };
+
+  const bool face_ghosts = options.ghost_layer == GHOST_LAYER_FACE;
+  std::array<size_t,3> layer_begin = {0, 0, 0};
+  std::array<size_t,3> layer_end = {0, 0, 0};
+  for (size_t d = 0; d < 3; ++d)
+  {
+    layer_begin[d] = block_begin[d] > 0 ? block_begin[d] - 1 : 0;
+    layer_end[d] = std::min(block_end[d] + 1, num_cells[d]);
+  }
+
+  // In global id order, as for unpartitioned meshes
+  std::array<size_t,3> ijk = {0, 0, 0};
+  for (ijk[1] = layer_begin[1]; ijk[1] < layer_end[1]; ++ijk[1])
+    for (ijk[0] = layer_begin[0]; ijk[0] < layer_end[0]; ++ijk[0])
+      for (ijk[2] = layer_begin[2]; ijk[2] < layer_end[2]; ++ijk[2])
+      {
+        size_t num_axes_outside = 0;
+        for (size_t d = 0; d < 3; ++d)
+          if (ijk[d] < block_begin[d] or ijk[d] >= block_end[d])
+            ++num_axes_outside;
+
+        if (face_ghosts and num_axes_outside > 1) continue;
+
+        grid->cells.push_back(MakeCell(ijk));
+      }
+
+  grid->SetGlobalVertexCount(num_nodes[0] * num_nodes[1] * num_nodes[2]);
+
+  const std::array<std::string,6> boundary_names =
+    {"XMAX", "XMIN", "YMAX", "YMIN", "ZMAX", "ZMIN"};
+  for (const auto& face_template : cell_template.faces)
+    grid->GetBoundaryIDMap()[face_template.boundary_id] =
+      boundary_names[face_template.boundary_id];
+
+  const std::array<MeshAttributes,3> dimensions =
+    {DIMENSION_1, DIMENSION_2, DIMENSION_3};
+
+  SetContinuum(grid);
+  SetGridAttributes(dimensions[dimension_ - 1] | ORTHOGONAL, num_cells);
+  SetGridFaceNeighborGhostsOnly(face_ghosts);
+
+  //======================================== Renumber local cells
+  ApplyLocalCellOrdering();
+
+  //======================================== Concluding messages
+  Chi::log.LogAllVerbose1()
+    << "### LOCATION[" << Chi::mpi.location_id
+    << "] amount of local cells="
+    << grid->local_cells.size()
+    << " ghost cells="
+    << grid->cells.GetNumGhosts();
+
+  Chi::log.Log()
+    << "VolumeMesherOrthoPartitioned: Cells created = "
+    << num_cells[0] * num_cells[1] * num_cells[2]
+    << std::endl;
+}
@@ -0,0 +1,25 @@
+#ifndef VOLMESHER_PARTITIONEDFILE_H
+#define VOLMESHER_PARTITIONEDFILE_H
+
+#include "../chi_volumemesher.h"
+
+#include <string>
+
+//###################################################################
+/**This volume mesher reads a mesh previously partitioned and exported with
+ * MeshContinuum::ExportCellsToPartitionedFile, each location reading its
+ * own cells.*/
+class chi_mesh::VolumeMesherPartitionedFile :
+                            public chi_mesh::VolumeMesher
+{
+private:
+  const std::string file_name_;
+public:
+  explicit
+  VolumeMesherPartitionedFile(std::string file_name) :
+    VolumeMesher(VolumeMesherType::PARTITIONED_FILE),
+    file_name_(std::move(file_name)) {}
+
+  void Execute() override;
+};
+#endif //VOLMESHER_PARTITIONEDFILE_H
@@ -0,0 +1,35 @@
+#include "volmesher_partitionedfile.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "utils/chi_timer.h"
+
+//###################################################################
+/**Reads the grid from the partitioned file. The cells already have their
+ * partitioning, connectivity and local ordering, hence none of these are
+ * recomputed.*/
+void chi_mesh::VolumeMesherPartitionedFile::Execute()
+{
+  Chi::log.Log()
+    << Chi::program_timer.GetTimeString()
+    << " VolumeMesherPartitionedFile executing.";
+
+  auto grid = chi_mesh::MeshContinuum::New();
+  grid->ReadCellsFromPartitionedFile(file_name_);
+
+  SetContinuum(grid);
+
+  Chi::log.LogAllVerbose1()
+    << "### LOCATION[" << Chi::mpi.location_id
+    << "] amount of local cells="
+    << grid->local_cells.size();
+
+  Chi::log.Log()
+    << "VolumeMesherPartitionedFile: Cells read = "
+    << grid->GetGlobalNumberOfCells()
+    << std::endl;
+}
@@ -21,18 +21,46 @@ public:
 
   void Execute() override;
 
+private:
+  void DistributeFromHomeLocation(chi_mesh::MeshContinuum& grid,
+                                  MeshAttributes& attributes,
+                                  std::array<size_t,3>& ortho_Nis) const;
+  void BuildFromLocalPieces(chi_mesh::MeshContinuum& grid) const;
+public:
+
   static
   bool CellHasLocalScope(
     const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell,
     uint64_t cell_global_id,
     const std::vector<std::set<uint64_t>>& vertex_subscriptions,
     const std::vector<int64_t>& cell_partition_ids);
+  static
+  bool CellHasLocalFaceScope(
+    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell,
+    uint64_t cell_global_id,
+    const std::vector<int64_t>& cell_partition_ids);
+
+  static
+  std::vector<int64_t> KBA(const chi_mesh::UnpartitionedMesh& umesh,
+                           bool broadcast = true);
+
+  static
+  std::vector<int64_t> PARMETIS(const UnpartitionedMesh &umesh,
+                                bool broadcast = true);
+
+  static
+  std::vector<int64_t> PARMETISDistributed(const UnpartitionedMesh &umesh);
+
+  static
+  std::vector<int64_t> SFC(const chi_mesh::UnpartitionedMesh& umesh);
 
   static
-  std::vector<int64_t> KBA(const chi_mesh::UnpartitionedMesh& umesh);
+  std::vector<int64_t> KBAAuto(const chi_mesh::UnpartitionedMesh& umesh);
 
   static
-  std::vector<int64_t> PARMETIS(const UnpartitionedMesh &umesh);
+  std::vector<double> MakeCellWeights(const chi_mesh::UnpartitionedMesh& umesh);
+  static
+  std::vector<int64_t> MakeIntegerCellWeights(const std::vector<double>& weights);
 
   static std::unique_ptr<chi_mesh::Cell>
   MakeCell(
@@ -0,0 +1,90 @@
+#include "volmesher_predefunpart.h"
+
+#include "mesh/MeshHandler/chi_meshhandler.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+
+//###################################################################
+/** Returns the partitioning weight of every raw cell according to the
+ * cell weight model of the current volume mesher. An empty vector is
+ * returned for the uniform model.
+ *
+ * The node and face models estimate the relative cost of a cell in a
+ * sweep, which scales with the number of nodes and faces, and are
+ * multiplied by the optional per-material factors, e.g., to account for
+ * the scattering order. The user model takes the weights as given, e.g.,
+ * per-cell sweep timings measured in a previous run.*/
+std::vector<double> chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  MakeCellWeights(const chi_mesh::UnpartitionedMesh& umesh)
+{
+  const auto& mesher_options =
+    chi_mesh::GetCurrentHandler().GetVolumeMesher().options;
+  const auto& values = mesher_options.cell_weight_values;
+  const auto& raw_cells = umesh.GetRawCells();
+  const size_t num_raw_cells = raw_cells.size();
+
+  std::vector<double> weights;
+  switch (mesher_options.cell_weight_model)
+  {
+    case CELL_WEIGHT_UNIFORM: return weights;
+    case CELL_WEIGHT_USER:
+    {
+      ChiInvalidArgumentIf(values.size() != num_raw_cells,
+                           "The number of user cell weights (" +
+                           std::to_string(values.size()) +
+                           ") does not match the number of cells (" +
+                           std::to_string(num_raw_cells) + ").");
+      weights = values;
+      break;
+    }
+    case CELL_WEIGHT_NODES:
+    case CELL_WEIGHT_NODES_FACES:
+    {
+      const bool add_faces =
+        mesher_options.cell_weight_model == CELL_WEIGHT_NODES_FACES;
+      weights.resize(num_raw_cells);
+      for (size_t c = 0; c < num_raw_cells; ++c)
+      {
+        const auto& raw_cell = *raw_cells[c];
+        double weight = static_cast<double>(raw_cell.vertex_ids.size());
+        if (add_faces) weight += static_cast<double>(raw_cell.faces.size());
+
+        const int mat_id = raw_cell.material_id;
+        if (mat_id >= 0 and static_cast<size_t>(mat_id) < values.size())
+          weight *= values[mat_id];
+        weights[c] = weight;
+      }
+      break;
+    }
+  }
+
+  for (const double weight : weights)
+    ChiInvalidArgumentIf(not std::isfinite(weight) or weight < 0.0,
+                         "Cell weights must be finite and non-negative.");
+
+  return weights;
+}
+
+//###################################################################
+/** Scales cell weights to the positive integers expected by ParMETIS,
+ * with the largest weight mapped to 1000.*/
+std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  MakeIntegerCellWeights(const std::vector<double>& weights)
+{
+  std::vector<int64_t> int_weights(weights.size(), 1);
+  if (weights.empty()) return int_weights;
+
+  const double max_weight = *std::max_element(weights.begin(), weights.end());
+  if (max_weight <= 0.0) return int_weights;
+
+  for (size_t c = 0; c < weights.size(); ++c)
+    int_weights[c] = std::max<int64_t>(
+      1, std::llround(1000.0 * weights[c] / max_weight));
+
+  return int_weights;
+}
@@ -0,0 +1,206 @@
+#include "volmesher_predefunpart.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <climits>
+
+//###################################################################
+/**Builds the grid from an unpartitioned mesh that only the home location
+ * has read.
+ *
+ * The home location partitions the mesh and determines, for every cell,
+ * the locations for which it is a local or ghost cell, by shared vertices
+ * or, with the face ghost layer, by shared faces. It then ships to
+ * each location, one at a time, the serialized cells and the vertices
+ * they use. Mesh level data (attributes, orthogonal sizes, boundary names,
+ * global vertex count) is broadcast to all locations. No other location
+ * ever holds more than its own cells.*/
+void chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  DistributeFromHomeLocation(chi_mesh::MeshContinuum& grid,
+                             MeshAttributes& attributes,
+                             std::array<size_t,3>& ortho_Nis) const
+{
+  const auto& umesh = *umesh_ptr_;
+  const bool home = Chi::mpi.location_id == 0;
+  const int num_locations = Chi::mpi.process_count;
+  const int tag = 4321;
+
+  Chi::log.Log() << "Distributing mesh from home location.";
+
+  //======================================== Broadcast mesh level data
+  {
+    chi_data_types::ByteArray raw;
+    if (home)
+    {
+      const auto& mesh_options = umesh.GetMeshOptions();
+      raw.Write<int>(static_cast<int>(umesh.GetMeshAttributes()));
+      raw.Write<size_t>(mesh_options.ortho_Nx);
+      raw.Write<size_t>(mesh_options.ortho_Ny);
+      raw.Write<size_t>(mesh_options.ortho_Nz);
+      raw.Write<size_t>(umesh.GetVertices().size());
+      raw.Write<size_t>(mesh_options.boundary_id_map.size());
+      for (const auto& [bid, name] : mesh_options.boundary_id_map)
+      {
+        raw.Write<uint64_t>(bid);
+        raw.Write<size_t>(name.size());
+        for (const char c : name)
+          raw.Write<char>(c);
+      }
+    }
+
+    int raw_size = static_cast<int>(raw.Size());
+    MPI_Bcast(&raw_size, 1, MPI_INT, 0, Chi::mpi.comm);
+    raw.Data().resize(raw_size);
+    MPI_Bcast(raw.Data().data(), raw_size, MPI_BYTE, 0, Chi::mpi.comm);
+
+    attributes = static_cast<MeshAttributes>(raw.Read<int>());
+    for (size_t d = 0; d < 3; ++d)
+      ortho_Nis[d] = raw.Read<size_t>();
+    grid.SetGlobalVertexCount(raw.Read<size_t>());
+
+    auto& boundary_id_map = grid.GetBoundaryIDMap();
+    const auto num_boundaries = raw.Read<size_t>();
+    for (size_t b = 0; b < num_boundaries; ++b)
+    {
+      const auto bid = raw.Read<uint64_t>();
+      const auto name_size = raw.Read<size_t>();
+      std::string name(name_size, ' ');
+      for (auto& c : name)
+        c = raw.Read<char>();
+      boundary_id_map[bid] = name;
+    }
+  }
+
+  //======================================== Receive the cells
+  if (not home)
+  {
+    MPI_Status status;
+    MPI_Probe(0, tag, Chi::mpi.comm, &status);
+    int raw_size = 0;
+    MPI_Get_count(&status, MPI_BYTE, &raw_size);
+
+    chi_data_types::ByteArray raw(static_cast<size_t>(raw_size));
+    MPI_Recv(raw.Data().data(), raw_size, MPI_BYTE,
+             0, tag, Chi::mpi.comm, MPI_STATUS_IGNORE);
+
+    size_t address = 0;
+    const auto num_cells = raw.Read<size_t>(address, &address);
+    for (size_t c = 0; c < num_cells; ++c)
+      grid.cells.push_back(std::make_unique<chi_mesh::Cell>(
+        chi_mesh::Cell::DeSerialize(raw, address)));
+
+    const auto num_vertices = raw.Read<size_t>(address, &address);
+    for (size_t v = 0; v < num_vertices; ++v)
+    {
+      const auto vid = raw.Read<uint64_t>(address, &address);
+      const auto vertex = raw.Read<chi_mesh::Vector3>(address, &address);
+      grid.vertices.Insert(vid, vertex);
+    }
+    return;
+  }
+
+  //======================================== Partition on home location
+  std::vector<int64_t> cell_pids;
+  if (options.partition_type == KBA_STYLE_XYZ)
+    cell_pids = KBA(umesh, /*broadcast=*/false);
+  else if (options.partition_type == SPACE_FILLING_CURVE)
+    cell_pids = SFC(umesh);
+  else if (options.partition_type == KBA_STYLE_AUTO)
+    cell_pids = KBAAuto(umesh);
+  else
+    cell_pids = PARMETIS(umesh, /*broadcast=*/false);
+
+  //======================================== Determine the cells of each
+  //                                         location
+  const auto& raw_cells = umesh.GetRawCells();
+  const auto& vertices = umesh.GetVertices();
+  const auto& vertex_subs = umesh.GetVertextCellSubscriptions();
+  const bool face_ghosts = options.ghost_layer == GHOST_LAYER_FACE;
+
+  std::vector<std::vector<uint64_t>> location_cell_ids(num_locations);
+  {
+    std::vector<int> cell_locations;
+    for (uint64_t cid = 0; cid < raw_cells.size(); ++cid)
+    {
+      cell_locations.assign(1, static_cast<int>(cell_pids[cid]));
+      if (face_ghosts)
+      {
+        for (const auto& face : raw_cells[cid]->faces)
+          if (face.has_neighbor)
+            cell_locations.push_back(
+              static_cast<int>(cell_pids[face.neighbor]));
+      }
+      else
+        for (uint64_t vid : raw_cells[cid]->vertex_ids)
+          for (uint64_t adj_cid : vertex_subs[vid])
+            cell_locations.push_back(static_cast<int>(cell_pids[adj_cid]));
+
+      std::sort(cell_locations.begin(), cell_locations.end());
+      cell_locations.erase(
+        std::unique(cell_locations.begin(), cell_locations.end()),
+        cell_locations.end());
+
+      for (int locI : cell_locations)
+        location_cell_ids[locI].push_back(cid);
+    }
+  }
+
+  //======================================== Ship the cells
+  for (int locI = 1; locI < num_locations; ++locI)
+  {
+    auto& cell_ids = location_cell_ids[locI];
+    std::vector<uint64_t> location_vids;
+
+    chi_data_types::ByteArray raw;
+    raw.Write<size_t>(cell_ids.size());
+    for (uint64_t cid : cell_ids)
+    {
+      const auto cell =
+        MakeCell(*raw_cells[cid], cid, cell_pids[cid], vertices);
+      raw.Append(cell->Serialize());
+      location_vids.insert(location_vids.end(),
+                           cell->vertex_ids_.begin(),
+                           cell->vertex_ids_.end());
+    }
+
+    std::sort(location_vids.begin(), location_vids.end());
+    location_vids.erase(
+      std::unique(location_vids.begin(), location_vids.end()),
+      location_vids.end());
+
+    raw.Write<size_t>(location_vids.size());
+    for (uint64_t vid : location_vids)
+    {
+      raw.Write<uint64_t>(vid);
+      raw.Write<chi_mesh::Vector3>(vertices[vid]);
+    }
+
+    ChiLogicalErrorIf(raw.Size() > static_cast<size_t>(INT_MAX),
+                      "The cells of location " + std::to_string(locI) +
+                      " exceed the maximum message size.");
+
+    MPI_Send(raw.Data().data(), static_cast<int>(raw.Size()), MPI_BYTE,
+             locI, tag, Chi::mpi.comm);
+
+    cell_ids.clear();
+    cell_ids.shrink_to_fit();
+  }
+
+  //======================================== Load the home location cells
+  for (uint64_t cid : location_cell_ids[0])
+  {
+    auto cell = MakeCell(*raw_cells[cid], cid, cell_pids[cid], vertices);
+
+    for (uint64_t vid : cell->vertex_ids_)
+      grid.vertices.Insert(vid, vertices[vid]);
+
+    grid.cells.push_back(std::move(cell));
+  }
+}
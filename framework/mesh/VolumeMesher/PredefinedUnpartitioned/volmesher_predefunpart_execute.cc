@@ -56,48 +56,78 @@ void chi_mesh::VolumeMesherPredefinedUnpartitioned::Execute()
   std::vector<int64_t> cell_pids;
   auto grid = chi_mesh::MeshContinuum::New();
 
-  grid->GetBoundaryIDMap() = umesh_ptr_->GetMeshOptions().boundary_id_map;
-
-  if (options.partition_type == PartitionType::KBA_STYLE_XYZ)
-    cell_pids = KBA(*umesh_ptr_);
+  MeshAttributes attributes = umesh_ptr_->GetMeshAttributes();
+  std::array<size_t,3> ortho_Nis = {umesh_ptr_->GetMeshOptions().ortho_Nx,
+                                    umesh_ptr_->GetMeshOptions().ortho_Ny,
+                                    umesh_ptr_->GetMeshOptions().ortho_Nz};
+
+  if (umesh_ptr_->GetMeshOptions().home_location_ingestion)
+    DistributeFromHomeLocation(*grid, attributes, ortho_Nis);
+  else if (umesh_ptr_->GetMeshOptions().local_pieces_only)
+  {
+    grid->GetBoundaryIDMap() = umesh_ptr_->GetMeshOptions().boundary_id_map;
+    BuildFromLocalPieces(*grid);
+  }
   else
-    cell_pids = PARMETIS(*umesh_ptr_);
-
-  //======================================== Load up the cells
-  auto& vertex_subs = umesh_ptr_->GetVertextCellSubscriptions();
-  size_t cell_globl_id = 0;
-  for (auto raw_cell : umesh_ptr_->GetRawCells())
   {
-    if (CellHasLocalScope(*raw_cell, cell_globl_id, vertex_subs, cell_pids))
+    grid->GetBoundaryIDMap() = umesh_ptr_->GetMeshOptions().boundary_id_map;
+
+    if (options.partition_type == PartitionType::KBA_STYLE_XYZ)
+      cell_pids = KBA(*umesh_ptr_);
+    else if (options.partition_type == PartitionType::PARMETIS_DISTRIBUTED)
+      cell_pids = PARMETISDistributed(*umesh_ptr_);
+    else if (options.partition_type == PartitionType::SPACE_FILLING_CURVE)
+      cell_pids = SFC(*umesh_ptr_);
+    else if (options.partition_type == PartitionType::KBA_STYLE_AUTO)
+      cell_pids = KBAAuto(*umesh_ptr_);
+    else
+      cell_pids = PARMETIS(*umesh_ptr_);
+
+    //==================================== Load up the cells
+    auto& vertex_subs = umesh_ptr_->GetVertextCellSubscriptions();
+    const bool face_ghosts = options.ghost_layer == GHOST_LAYER_FACE;
+    size_t cell_globl_id = 0;
+    for (auto raw_cell : umesh_ptr_->GetRawCells())
     {
-      auto cell = MakeCell(*raw_cell, cell_globl_id,
-                           cell_pids[cell_globl_id], umesh_ptr_->GetVertices());
-
-      for (uint64_t vid : cell->vertex_ids_)
-        grid->vertices.Insert(vid, umesh_ptr_->GetVertices()[vid]);
-
-      grid->cells.push_back(std::move(cell));
-    }
-
-    ++cell_globl_id;
-  }//for raw_cell
-
-  grid->SetGlobalVertexCount(umesh_ptr_->GetVertices().size());
+      const bool local_scope =
+        face_ghosts
+          ? CellHasLocalFaceScope(*raw_cell, cell_globl_id, cell_pids)
+          : CellHasLocalScope(*raw_cell, cell_globl_id, vertex_subs, cell_pids);
+      if (local_scope)
+      {
+        auto cell = MakeCell(*raw_cell, cell_globl_id,
+                             cell_pids[cell_globl_id],
+                             umesh_ptr_->GetVertices());
+
+        for (uint64_t vid : cell->vertex_ids_)
+          grid->vertices.Insert(vid, umesh_ptr_->GetVertices()[vid]);
+
+        grid->cells.push_back(std::move(cell));
+      }
+
+      ++cell_globl_id;
+    }//for raw_cell
+
+    grid->SetGlobalVertexCount(umesh_ptr_->GetVertices().size());
+  }
 
   Chi::log.Log() << "Cells loaded.";
   Chi::mpi.Barrier();
 
   SetContinuum(grid);
-  SetGridAttributes(umesh_ptr_->GetMeshAttributes(),
-                    {umesh_ptr_->GetMeshOptions().ortho_Nx,
-                     umesh_ptr_->GetMeshOptions().ortho_Ny,
-                     umesh_ptr_->GetMeshOptions().ortho_Nz});
+  SetGridAttributes(attributes, ortho_Nis);
+  SetGridFaceNeighborGhostsOnly(options.ghost_layer == GHOST_LAYER_FACE);
+
+  //======================================== Renumber local cells
+  ApplyLocalCellOrdering();
 
   //======================================== Concluding messages
   Chi::log.LogAllVerbose1()
     << "### LOCATION[" << Chi::mpi.location_id
     << "] amount of local cells="
-    << grid->local_cells.size();
+    << grid->local_cells.size()
+    << " ghost cells="
+    << grid->cells.GetNumGhosts();
 
   size_t total_local_cells = grid->local_cells.size();
   size_t total_global_cells = 0;
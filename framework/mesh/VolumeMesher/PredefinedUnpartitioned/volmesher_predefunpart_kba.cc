@@ -12,9 +12,10 @@
 
 
 //###################################################################
-/** Applies KBA-style partitioning to the mesh.*/
+/** Applies KBA-style partitioning to the mesh.
+ * When `broadcast` is false only the home location holds the partition ids.*/
 std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
-  KBA(const chi_mesh::UnpartitionedMesh& umesh)
+  KBA(const chi_mesh::UnpartitionedMesh& umesh, bool broadcast)
 {
   Chi::log.Log() << "Partitioning mesh KBA-style.";
 
@@ -53,11 +54,12 @@ std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
 
   //======================================== Broadcast partitioning to all
   //                                         locations
-  MPI_Bcast(cell_pids.data(),                 //buffer [IN/OUT]
-            static_cast<int>(num_raw_cells),  //count
-            MPI_LONG_LONG_INT,                //data type
-            0,                                //root
-            Chi::mpi.comm);                  //communicator
+  if (broadcast)
+    MPI_Bcast(cell_pids.data(),                 //buffer [IN/OUT]
+              static_cast<int>(num_raw_cells),  //count
+              MPI_LONG_LONG_INT,                //data type
+              0,                                //root
+              Chi::mpi.comm);                  //communicator
   Chi::log.Log() << "Done partitioning mesh.";
 
   return cell_pids;
@@ -0,0 +1,321 @@
+#include "volmesher_predefunpart.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "chi_mpi_utils_map_all2all.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+
+namespace
+{
+/**Returns the location owning the global numbering of a vertex, given its
+ * coordinates.*/
+int VertexOwner(const chi_mesh::Vector3& vertex)
+{
+  const std::hash<double> hasher;
+  size_t h = hasher(vertex.x);
+  h = h * 1000003u ^ hasher(vertex.y);
+  h = h * 1000003u ^ hasher(vertex.z);
+  return static_cast<int>(h % static_cast<size_t>(Chi::mpi.process_count));
+}
+
+/**Returns the location matching a face, given its sorted vertex ids.*/
+int FaceOwner(const std::vector<uint64_t>& sorted_vids)
+{
+  const std::hash<uint64_t> hasher;
+  size_t h = 0;
+  for (uint64_t vid : sorted_vids)
+    h = h * 1000003u ^ hasher(vid);
+  return static_cast<int>(h % static_cast<size_t>(Chi::mpi.process_count));
+}
+}//namespace
+
+//###################################################################
+/**Builds the grid from an unpartitioned mesh of which every location only
+ * read its own pieces, with locally numbered cells and vertices. The pieces
+ * are kept as the partitioning.
+ *
+ * Cells are numbered globally by location. Vertices are numbered globally
+ * by matching exact coordinates on an owner location, determined by hashing
+ * the coordinates, which also returns the locations sharing each vertex.
+ * Faces left unconnected within a piece are matched across pieces, in the
+ * same fashion, by hashing their vertex ids. Finally, every cell touching a
+ * vertex shared with another location is sent to that location as a ghost
+ * cell, together with its vertices. With the face ghost layer only the
+ * cells sharing a face with another location are sent.*/
+void chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  BuildFromLocalPieces(chi_mesh::MeshContinuum& grid) const
+{
+  typedef std::array<double,3> Coords;
+  const auto& umesh = *umesh_ptr_;
+  const auto& raw_cells = umesh.GetRawCells();
+  const auto& vertices = umesh.GetVertices();
+  const uint64_t num_local_cells = raw_cells.size();
+  const size_t num_local_vertices = vertices.size();
+  const auto location_id = static_cast<uint64_t>(Chi::mpi.location_id);
+
+  Chi::log.Log() << "Building grid from local pieces.";
+
+  //======================================== Global cell ids
+  uint64_t cell_offset = 0;
+  MPI_Exscan(&num_local_cells, &cell_offset, 1, MPI_UINT64_T, MPI_SUM,
+             Chi::mpi.comm);
+  if (Chi::mpi.location_id == 0) cell_offset = 0;
+
+  //======================================== Global vertex ids
+  std::vector<uint64_t> vertex_gids(num_local_vertices, 0);
+  std::vector<std::vector<uint64_t>> vertex_sharing_pids(num_local_vertices);
+  {
+    // Query the owners of the vertex coordinates
+    std::map<int, std::vector<double>> coord_queries;
+    std::vector<std::pair<int, size_t>> query_slots(num_local_vertices);
+    for (size_t v = 0; v < num_local_vertices; ++v)
+    {
+      const auto& vertex = vertices[v];
+      const int owner = VertexOwner(vertex);
+      auto& queries = coord_queries[owner];
+      query_slots[v] = {owner, queries.size() / 3};
+      queries.insert(queries.end(), {vertex.x, vertex.y, vertex.z});
+    }
+
+    const auto received_queries =
+      chi_mpi_utils::MapAllToAll(coord_queries, MPI_DOUBLE);
+
+    // Number the owned vertices and collect their locations
+    std::map<Coords, std::pair<uint64_t, std::vector<uint64_t>>> owned;
+    for (const auto& [pid, coords] : received_queries)
+      for (size_t i = 0; i < coords.size() / 3; ++i)
+      {
+        const Coords key = {coords[3*i], coords[3*i + 1], coords[3*i + 2]};
+        auto it = owned.find(key);
+        if (it == owned.end())
+          it = owned.insert({key, {owned.size(), {}}}).first;
+        auto& pids = it->second.second;
+        if (pids.empty() or pids.back() != static_cast<uint64_t>(pid))
+          pids.push_back(pid);
+      }
+
+    const uint64_t num_owned = owned.size();
+    uint64_t vertex_offset = 0;
+    MPI_Exscan(&num_owned, &vertex_offset, 1, MPI_UINT64_T, MPI_SUM,
+               Chi::mpi.comm);
+    if (Chi::mpi.location_id == 0) vertex_offset = 0;
+
+    uint64_t num_global_vertices = 0;
+    MPI_Allreduce(&num_owned, &num_global_vertices, 1, MPI_UINT64_T,
+                  MPI_SUM, Chi::mpi.comm);
+    grid.SetGlobalVertexCount(num_global_vertices);
+
+    // Reply with the global id, the number of sharing locations, and the
+    // sharing locations
+    std::map<int, std::vector<uint64_t>> replies;
+    for (const auto& [pid, coords] : received_queries)
+    {
+      auto& reply = replies[pid];
+      for (size_t i = 0; i < coords.size() / 3; ++i)
+      {
+        const Coords key = {coords[3*i], coords[3*i + 1], coords[3*i + 2]};
+        const auto& [id, pids] = owned.at(key);
+        reply.push_back(vertex_offset + id);
+        reply.push_back(pids.size());
+        reply.insert(reply.end(), pids.begin(), pids.end());
+      }
+    }
+    owned.clear();
+
+    const auto received_replies =
+      chi_mpi_utils::MapAllToAll(replies, MPI_UINT64_T);
+
+    // Replies are variable length, hence are indexed per owner first
+    std::map<int, std::vector<size_t>> reply_addresses;
+    for (const auto& [pid, reply] : received_replies)
+    {
+      auto& addresses = reply_addresses[pid];
+      for (size_t k = 0; k < reply.size(); k += 2 + reply[k + 1])
+        addresses.push_back(k);
+    }
+
+    for (size_t v = 0; v < num_local_vertices; ++v)
+    {
+      const auto [owner, slot] = query_slots[v];
+      const auto& reply = received_replies.at(owner);
+      const size_t k = reply_addresses.at(owner)[slot];
+
+      vertex_gids[v] = reply[k];
+      for (size_t p = 0; p < reply[k + 1]; ++p)
+        if (reply[k + 2 + p] != location_id)
+          vertex_sharing_pids[v].push_back(reply[k + 2 + p]);
+    }
+  }
+
+  //======================================== Make the local cells
+  std::vector<std::unique_ptr<chi_mesh::Cell>> local_cells;
+  local_cells.reserve(num_local_cells);
+  for (uint64_t c = 0; c < num_local_cells; ++c)
+  {
+    //Geometry is computed with the local vertex ids
+    auto cell = MakeCell(*raw_cells[c], cell_offset + c, location_id,
+                         vertices);
+
+    for (uint64_t& vid : cell->vertex_ids_)
+      vid = vertex_gids[vid];
+    for (size_t f = 0; f < cell->faces_.size(); ++f)
+    {
+      auto& face = cell->faces_[f];
+      for (uint64_t& vid : face.vertex_ids_)
+        vid = vertex_gids[vid];
+      if (face.has_neighbor_)
+        face.neighbor_id_ = cell_offset + raw_cells[c]->faces[f].neighbor;
+    }
+    local_cells.push_back(std::move(cell));
+  }
+
+  //======================================== Match faces across pieces
+  // The locations of the neighbors across pieces, per local cell
+  std::vector<std::vector<uint64_t>> face_sharing_pids(num_local_cells);
+  {
+    // Each query is: local cell id, face index, number of vertices, and
+    // the sorted face vertex ids
+    std::map<int, std::vector<uint64_t>> face_queries;
+    for (uint64_t c = 0; c < num_local_cells; ++c)
+    {
+      const auto& cell = *local_cells[c];
+      for (size_t f = 0; f < cell.faces_.size(); ++f)
+      {
+        const auto& face = cell.faces_[f];
+        if (face.has_neighbor_) continue;
+
+        auto sorted_vids = face.vertex_ids_;
+        std::sort(sorted_vids.begin(), sorted_vids.end());
+
+        auto& queries = face_queries[FaceOwner(sorted_vids)];
+        queries.insert(queries.end(), {c, f, sorted_vids.size()});
+        queries.insert(queries.end(), sorted_vids.begin(), sorted_vids.end());
+      }
+    }
+
+    const auto received_queries =
+      chi_mpi_utils::MapAllToAll(face_queries, MPI_UINT64_T);
+
+    // Pair the faces with identical vertices. Each entry holds the
+    // querying location, local cell id, and face index
+    typedef std::array<uint64_t,3> FaceRef;
+    std::map<std::vector<uint64_t>, std::vector<FaceRef>> face_refs;
+    for (const auto& [pid, queries] : received_queries)
+      for (size_t k = 0; k < queries.size(); k += 3 + queries[k + 2])
+      {
+        const auto begin = queries.begin() + static_cast<int64_t>(k) + 3;
+        std::vector<uint64_t> key(begin, begin + queries[k + 2]);
+        face_refs[key].push_back({static_cast<uint64_t>(pid),
+                                  queries[k], queries[k + 1]});
+      }
+
+    // Reply with: local cell id, face index, and neighbor location and its
+    // local cell id
+    std::map<int, std::vector<uint64_t>> replies;
+    for (const auto& [key, refs] : face_refs)
+    {
+      if (refs.size() != 2) continue;
+      for (size_t r = 0; r < 2; ++r)
+      {
+        const auto& ref = refs[r];
+        const auto& nb_ref = refs[1 - r];
+        auto& reply = replies[static_cast<int>(ref[0])];
+        reply.insert(reply.end(), {ref[1], ref[2], nb_ref[0], nb_ref[1]});
+      }
+    }
+    face_refs.clear();
+
+    // The neighbor's global id needs its location's cell offset
+    std::vector<uint64_t> cell_offsets(Chi::mpi.process_count, 0);
+    MPI_Allgather(&cell_offset, 1, MPI_UINT64_T,
+                  cell_offsets.data(), 1, MPI_UINT64_T, Chi::mpi.comm);
+
+    const auto received_replies =
+      chi_mpi_utils::MapAllToAll(replies, MPI_UINT64_T);
+    for (const auto& [pid, reply] : received_replies)
+      for (size_t k = 0; k < reply.size(); k += 4)
+      {
+        auto& face = local_cells[reply[k]]->faces_[reply[k + 1]];
+        face.has_neighbor_ = true;
+        face.neighbor_id_ = cell_offsets[reply[k + 2]] + reply[k + 3];
+        face_sharing_pids[reply[k]].push_back(reply[k + 2]);
+      }
+  }
+
+  //======================================== Exchange ghost cells
+  {
+    std::map<int, std::vector<std::byte>> ghost_data;
+    for (uint64_t c = 0; c < num_local_cells; ++c)
+    {
+      std::vector<uint64_t> pids;
+      if (options.ghost_layer == GHOST_LAYER_FACE)
+        pids.swap(face_sharing_pids[c]);
+      else
+        for (uint64_t vid : raw_cells[c]->vertex_ids)
+          pids.insert(pids.end(),
+                      vertex_sharing_pids[vid].begin(),
+                      vertex_sharing_pids[vid].end());
+      std::sort(pids.begin(), pids.end());
+      pids.erase(std::unique(pids.begin(), pids.end()), pids.end());
+      if (pids.empty()) continue;
+
+      const auto& cell = *local_cells[c];
+      chi_data_types::ByteArray raw = cell.Serialize();
+      raw.Write<size_t>(cell.vertex_ids_.size());
+      for (size_t v = 0; v < cell.vertex_ids_.size(); ++v)
+      {
+        raw.Write<uint64_t>(cell.vertex_ids_[v]);
+        raw.Write<chi_mesh::Vector3>(vertices[raw_cells[c]->vertex_ids[v]]);
+      }
+
+      for (uint64_t pid : pids)
+      {
+        auto& data = ghost_data[static_cast<int>(pid)];
+        data.insert(data.end(), raw.Data().begin(), raw.Data().end());
+      }
+    }
+
+    const auto received_ghosts =
+      chi_mpi_utils::MapAllToAll(ghost_data, MPI_BYTE);
+    ghost_data.clear();
+
+    for (const auto& [pid, data] : received_ghosts)
+    {
+      const chi_data_types::ByteArray raw(data);
+      size_t address = 0;
+      while (address < raw.Size())
+      {
+        auto cell = std::make_unique<chi_mesh::Cell>(
+          chi_mesh::Cell::DeSerialize(raw, address));
+
+        const auto num_vertices = raw.Read<size_t>(address, &address);
+        for (size_t v = 0; v < num_vertices; ++v)
+        {
+          const auto vid = raw.Read<uint64_t>(address, &address);
+          const auto vertex = raw.Read<chi_mesh::Vector3>(address, &address);
+          grid.vertices.Insert(vid, vertex);
+        }
+
+        grid.cells.push_back(std::move(cell));
+      }
+    }
+  }
+
+  //======================================== Load the local cells
+  for (uint64_t c = 0; c < num_local_cells; ++c)
+  {
+    const auto& raw_vids = raw_cells[c]->vertex_ids;
+    for (size_t v = 0; v < raw_vids.size(); ++v)
+      grid.vertices.Insert(local_cells[c]->vertex_ids_[v],
+                           vertices[raw_vids[v]]);
+
+    grid.cells.push_back(std::move(local_cells[c]));
+  }
+}
@@ -11,9 +11,10 @@
 #include "petsc.h"
 
 //###################################################################
-/** Applies KBA-style partitioning to the mesh.*/
+/** Applies ParMETIS partitioning to the mesh on the home location.
+ * When `broadcast` is false only the home location holds the partition ids.*/
 std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
-  PARMETIS(const UnpartitionedMesh &umesh)
+  PARMETIS(const UnpartitionedMesh &umesh, bool broadcast)
 {
   Chi::log.Log() << "Partitioning mesh with ParMETIS.";
 
@@ -87,6 +88,18 @@ std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
       MatPartitioningSetAdjacency(part,Adj);
       MatPartitioningSetType(part,"parmetis");
       MatPartitioningSetNParts(part, Chi::mpi.process_count);
+
+      const auto cell_weights = MakeCellWeights(umesh);
+      if (not cell_weights.empty())
+      {
+        const auto int_weights = MakeIntegerCellWeights(cell_weights);
+        int64_t* weights_raw; //PETSc takes ownership
+        PetscMalloc(num_raw_cells*sizeof(int64_t),&weights_raw);
+        for (size_t i=0; i<num_raw_cells; ++i)
+          weights_raw[i] = int_weights[i];
+        MatPartitioningSetVertexWeights(part, weights_raw);
+      }
+
       MatPartitioningApply(part,&is);
       MatPartitioningDestroy(&part);
       MatDestroy(&Adj);
@@ -106,11 +119,12 @@ std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
 
   //======================================== Broadcast partitioning to all
   //                                         locations
-  MPI_Bcast(cell_pids.data(),                 //buffer [IN/OUT]
-            static_cast<int>(num_raw_cells),  //count
-            MPI_LONG_LONG_INT,                //data type
-            0,                                //root
-            Chi::mpi.comm);                  //communicator
+  if (broadcast)
+    MPI_Bcast(cell_pids.data(),                 //buffer [IN/OUT]
+              static_cast<int>(num_raw_cells),  //count
+              MPI_LONG_LONG_INT,                //data type
+              0,                                //root
+              Chi::mpi.comm);                  //communicator
   Chi::log.Log() << "Done partitioning mesh.";
 
   return cell_pids;
@@ -0,0 +1,124 @@
+#include "volmesher_predefunpart.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "petsc.h"
+
+#include <algorithm>
+
+//###################################################################
+/** Partitions the mesh with ParMETIS on a distributed dual graph. Each
+ * location builds the rows of the dual graph for a contiguous slice of the
+ * cells, the graph is partitioned in parallel, and the partition ids are
+ * gathered on all locations. No location ever holds the full graph.*/
+std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  PARMETISDistributed(const UnpartitionedMesh &umesh)
+{
+  const size_t num_raw_cells = umesh.GetNumberOfCells();
+  const auto num_locations = static_cast<size_t>(Chi::mpi.process_count);
+
+  //ParMETIS does not support locations without vertices
+  if (num_raw_cells < 2 * num_locations)
+    return PARMETIS(umesh);
+
+  Chi::log.Log() << "Partitioning mesh with distributed ParMETIS.";
+
+  //================================================== Determine slices
+  std::vector<int> slice_sizes(num_locations, 0);
+  std::vector<int> slice_offsets(num_locations, 0);
+  for (size_t locI = 0; locI < num_locations; ++locI)
+  {
+    const size_t begin = locI * num_raw_cells / num_locations;
+    const size_t end = (locI + 1) * num_raw_cells / num_locations;
+    slice_offsets[locI] = static_cast<int>(begin);
+    slice_sizes[locI] = static_cast<int>(end - begin);
+  }
+
+  const auto& raw_cells = umesh.GetRawCells();
+  const size_t slice_begin = slice_offsets[Chi::mpi.location_id];
+  const size_t num_local_cells = slice_sizes[Chi::mpi.location_id];
+
+  //================================================== Build local rows
+  //ParMETIS takes ownership of the raw arrays
+  size_t num_local_edges = 0;
+  for (size_t c = 0; c < num_local_cells; ++c)
+    for (const auto& face : raw_cells[slice_begin + c]->faces)
+      if (face.has_neighbor) ++num_local_edges;
+
+  int64_t* i_indices_raw;
+  int64_t* j_indices_raw;
+  PetscMalloc((num_local_cells + 1) * sizeof(int64_t), &i_indices_raw);
+  PetscMalloc(std::max<size_t>(num_local_edges, 1) * sizeof(int64_t),
+              &j_indices_raw);
+  {
+    int64_t icount = 0;
+    for (size_t c = 0; c < num_local_cells; ++c)
+    {
+      i_indices_raw[c] = icount;
+      for (const auto& face : raw_cells[slice_begin + c]->faces)
+        if (face.has_neighbor)
+          j_indices_raw[icount++] = static_cast<int64_t>(face.neighbor);
+    }
+    i_indices_raw[num_local_cells] = icount;
+  }
+
+  Chi::log.Log0Verbose1() << "Done building distributed indices.";
+
+  //================================================== Create adjacency matrix
+  Mat Adj; //Adjacency matrix
+  MatCreateMPIAdj(Chi::mpi.comm,
+                  (int64_t)num_local_cells,
+                  (int64_t)num_raw_cells,
+                  i_indices_raw, j_indices_raw, nullptr, &Adj);
+
+  //================================================== Create partitioning
+  MatPartitioning part;
+  IS is;
+  MatPartitioningCreate(Chi::mpi.comm,&part);
+  MatPartitioningSetAdjacency(part,Adj);
+  MatPartitioningSetType(part,"parmetis");
+  MatPartitioningSetNParts(part, Chi::mpi.process_count);
+
+  const auto cell_weights = MakeCellWeights(umesh);
+  if (not cell_weights.empty())
+  {
+    const auto int_weights = MakeIntegerCellWeights(cell_weights);
+    int64_t* weights_raw; //PETSc takes ownership
+    PetscMalloc(num_local_cells * sizeof(int64_t), &weights_raw);
+    for (size_t c = 0; c < num_local_cells; ++c)
+      weights_raw[c] = int_weights[slice_begin + c];
+    MatPartitioningSetVertexWeights(part, weights_raw);
+  }
+
+  MatPartitioningApply(part,&is);
+  MatPartitioningDestroy(&part);
+  MatDestroy(&Adj);
+  Chi::log.Log0Verbose1() << "Done building distributed partitioning.";
+
+  //================================================== Gather partition ids
+  std::vector<int64_t> local_cell_pids(num_local_cells, 0);
+  {
+    const int64_t* cell_pids_raw;
+    ISGetIndices(is,&cell_pids_raw);
+    for (size_t c = 0; c < num_local_cells; ++c)
+      local_cell_pids[c] = cell_pids_raw[c];
+    ISRestoreIndices(is,&cell_pids_raw);
+    ISDestroy(&is);
+  }
+
+  std::vector<int64_t> cell_pids(num_raw_cells, 0);
+  MPI_Allgatherv(local_cell_pids.data(),              //sendbuf
+                 static_cast<int>(num_local_cells),   //sendcount
+                 MPI_LONG_LONG_INT,                   //sendtype
+                 cell_pids.data(),                    //recvbuf
+                 slice_sizes.data(),                  //recvcounts
+                 slice_offsets.data(),                //displs
+                 MPI_LONG_LONG_INT,                   //recvtype
+                 Chi::mpi.comm);                      //communicator
+
+  Chi::log.Log() << "Done partitioning mesh.";
+
+  return cell_pids;
+}
@@ -0,0 +1,62 @@
+#include "volmesher_predefunpart.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+//###################################################################
+/** Partitions the mesh along a Hilbert space-filling curve through the
+ * cell centroids. The curve is cut into contiguous pieces of near equal
+ * weight, with the cell weights given by MakeCellWeights. Every location
+ * computes the same partition independently, hence no communication is
+ * required and any number of locations is supported.*/
+std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  SFC(const chi_mesh::UnpartitionedMesh& umesh)
+{
+  Chi::log.Log() << "Partitioning mesh along a space-filling curve.";
+
+  const auto& raw_cells = umesh.GetRawCells();
+  const auto num_locations = static_cast<size_t>(Chi::mpi.process_count);
+
+  std::vector<chi_mesh::Vector3> centroids;
+  centroids.reserve(raw_cells.size());
+  for (const auto& raw_cell : raw_cells)
+    centroids.push_back(raw_cell->centroid);
+
+  auto cell_pids = PartitionAlongHilbertCurve(centroids,
+                                              MakeCellWeights(umesh),
+                                              num_locations);
+
+  Chi::log.Log() << "Done partitioning mesh.";
+
+  return cell_pids;
+}
+
+//###################################################################
+/** Partitions the mesh KBA-style with PartitionKBAAuto, which chooses
+ * the partition counts from the number of locations and the mesh
+ * extents. As for SFC, every location computes the same partition and any
+ * number of locations is supported.*/
+std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  KBAAuto(const chi_mesh::UnpartitionedMesh& umesh)
+{
+  Chi::log.Log() << "Partitioning mesh KBA-style with automatic counts.";
+
+  const auto& raw_cells = umesh.GetRawCells();
+  const auto num_locations = static_cast<size_t>(Chi::mpi.process_count);
+
+  std::vector<chi_mesh::Vector3> centroids;
+  centroids.reserve(raw_cells.size());
+  for (const auto& raw_cell : raw_cells)
+    centroids.push_back(raw_cell->centroid);
+
+  std::string layout;
+  auto cell_pids = PartitionKBAAuto(centroids,
+                                    MakeCellWeights(umesh),
+                                    num_locations,
+                                    &layout);
+
+  Chi::log.Log() << "Done partitioning mesh. KBA layout: " << layout;
+
+  return cell_pids;
+}
@@ -34,4 +34,29 @@ bool chi_mesh::VolumeMesherPredefinedUnpartitioned::
     }
 
   return false;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Determines if a chi_mesh::UnpartitionedMesh::LightWeightCell is a local
+ * cell or a face neighbor of a local cell. Unlike CellHasLocalScope, cells
+ * only sharing vertices or edges with the local cells are excluded.*/
+bool chi_mesh::VolumeMesherPredefinedUnpartitioned::
+  CellHasLocalFaceScope(
+    const chi_mesh::UnpartitionedMesh::LightWeightCell& lwcell,
+    uint64_t cell_global_id,
+    const std::vector<int64_t>& cell_partition_ids)
+{
+  int cell_pid = static_cast<int>(cell_partition_ids[cell_global_id]);
+  if (cell_pid == Chi::mpi.location_id)
+    return true;
+
+  for (const auto& face : lwcell.faces)
+  {
+    if (not face.has_neighbor) continue;
+    int adj_pid = static_cast<int>(cell_partition_ids[face.neighbor]);
+    if (adj_pid == Chi::mpi.location_id)
+      return true;
+  }
+
+  return false;
+}
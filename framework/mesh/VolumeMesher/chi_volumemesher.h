@@ -13,8 +13,10 @@ namespace chi_mesh
 {
   enum class VolumeMesherType
   {
-    EXTRUDER      = 4,
-    UNPARTITIONED = 6
+    EXTRUDER         = 4,
+    UNPARTITIONED    = 6,
+    PARTITIONED_FILE = 7,
+    ORTHO_PARTITIONED = 8
   };
   enum VolumeMesherProperty
   {
@@ -31,7 +33,10 @@ namespace chi_mesh
     MATID_FROMLOGICAL         = 11,
     BNDRYID_FROMLOGICAL       = 12,
     MATID_FROM_LUA_FUNCTION   = 13,
-    BNDRYID_FROM_LUA_FUNCTION = 14
+    BNDRYID_FROM_LUA_FUNCTION = 14,
+    LOCAL_CELL_ORDERING       = 15,
+    CELL_WEIGHTS              = 16,
+    GHOST_LAYER               = 17
   };
 }
 
@@ -45,8 +50,29 @@ private:
 public:
   enum PartitionType
   {
-    KBA_STYLE_XYZ = 2,
-    PARMETIS      = 3
+    KBA_STYLE_XYZ        = 2,
+    PARMETIS             = 3,
+    PARMETIS_DISTRIBUTED = 4, ///< ParMETIS on a distributed dual graph
+    SPACE_FILLING_CURVE  = 5, ///< Hilbert curve through the cell centroids
+    KBA_STYLE_AUTO       = 6  ///< KBA with automatic partition counts
+  };
+  enum LocalCellOrdering
+  {
+    CELL_ORDER_NATIVE = 0, ///< Order in which cells were created
+    CELL_ORDER_MORTON = 1, ///< Morton space-filling curve of the centroids
+    CELL_ORDER_SWEEP  = 2  ///< Sweep order of a representative direction
+  };
+  enum CellWeightModel
+  {
+    CELL_WEIGHT_UNIFORM     = 0, ///< Balance cell counts
+    CELL_WEIGHT_NODES       = 1, ///< Number of cell vertices
+    CELL_WEIGHT_NODES_FACES = 2, ///< Number of cell vertices plus faces
+    CELL_WEIGHT_USER        = 3  ///< User supplied per-cell weights
+  };
+  enum GhostLayer
+  {
+    GHOST_LAYER_VERTEX = 0, ///< All cells sharing a vertex with a local cell
+    GHOST_LAYER_FACE   = 1  ///< Only the face neighbors of the local cells
   };
   struct VOLUME_MESHER_OPTIONS
   {
@@ -60,6 +86,19 @@ public:
     std::vector<double> ycuts;
     std::vector<double> zcuts;
     PartitionType partition_type = PARMETIS;
+
+    LocalCellOrdering local_cell_ordering = CELL_ORDER_NATIVE;
+    std::array<double,3> cell_order_sweep_direction = {1.0, 1.0, 1.0};
+
+    CellWeightModel cell_weight_model = CELL_WEIGHT_UNIFORM;
+    /**Per material multipliers of the model weights, indexed by material
+     * id, or per-cell weights, indexed by global id, with
+     * CELL_WEIGHT_USER.*/
+    std::vector<double> cell_weight_values;
+
+    /**The face layer suffices for discontinuous discretizations and
+     * sweeps, but not for continuous discretizations.*/
+    GhostLayer ghost_layer = GHOST_LAYER_VERTEX;
   };
   VOLUME_MESHER_OPTIONS options;
 public:
@@ -71,6 +110,7 @@ public:
   MeshContinuumPtr& GetContinuum();
   void SetGridAttributes(MeshAttributes new_attribs,
                          std::array<size_t,3> ortho_Nis={0,0,0});
+  void SetGridFaceNeighborGhostsOnly(bool face_neighbors_only);
   VolumeMesherType Type() const;
 
   //01a
@@ -104,6 +144,9 @@ public:
   //02
   virtual void Execute();
 
+  //03
+  void ApplyLocalCellOrdering();
+
 
 
 
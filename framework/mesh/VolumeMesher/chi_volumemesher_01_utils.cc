@@ -30,6 +30,15 @@ void chi_mesh::VolumeMesher::
   grid_ptr_->SetAttributes(new_attribs, ortho_Nis);
 }
 
+//###################################################################
+/**Flags the grid as having only the face neighbors of its local cells as
+ * ghost cells.*/
+void chi_mesh::VolumeMesher::
+  SetGridFaceNeighborGhostsOnly(bool face_neighbors_only)
+{
+  grid_ptr_->SetFaceNeighborGhostsOnly(face_neighbors_only);
+}
+
 
 //###################################################################
 /**Gets the volume mesher's type.*/
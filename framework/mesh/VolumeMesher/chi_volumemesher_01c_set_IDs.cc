@@ -28,19 +28,26 @@ void chi_mesh::VolumeMesher::
   chi_mesh::MeshContinuumPtr vol_cont = handler.GetGrid();
 
   int num_cells_modified = 0;
+  const auto& cell_mask = log_vol.GetLocalCellMask(*vol_cont);
   for (auto& cell : vol_cont->local_cells)
   {
-    if (log_vol.Inside(cell.centroid_) && sense){
+    if (cell_mask[cell.local_id_] && sense){
       cell.material_id_ = mat_id;
       ++num_cells_modified;
     }
   }
 
   const auto& ghost_ids = vol_cont->cells.GetGhostGlobalIDs();
+  std::vector<chi_mesh::Vector3> ghost_centroids;
+  ghost_centroids.reserve(ghost_ids.size());
   for (uint64_t ghost_id : ghost_ids)
+    ghost_centroids.push_back(vol_cont->cells[ghost_id].centroid_);
+
+  const auto ghost_inside = log_vol.InsideBatch(ghost_centroids);
+  for (size_t g = 0; g < ghost_ids.size(); ++g)
   {
-    auto& cell = vol_cont->cells[ghost_id];
-    if (log_vol.Inside(cell.centroid_) && sense)
+    auto& cell = vol_cont->cells[ghost_ids[g]];
+    if (ghost_inside[g] && sense)
       cell.material_id_ = mat_id;
   }
 
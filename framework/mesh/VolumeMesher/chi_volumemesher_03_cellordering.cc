@@ -0,0 +1,33 @@
+#include "chi_volumemesher.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+//###################################################################
+/**Renumbers the local cells of the grid according to the
+ * `local_cell_ordering` option. Cells that are close in the new order are
+ * close in memory, which improves cache reuse during sweeps and source
+ * evaluations. All the per-cell data built afterwards by solvers follows
+ * the new order.*/
+void chi_mesh::VolumeMesher::ApplyLocalCellOrdering()
+{
+  if (options.local_cell_ordering == CELL_ORDER_NATIVE) return;
+
+  auto& grid = *grid_ptr_;
+
+  std::vector<uint64_t> new_to_old_local_ids;
+  if (options.local_cell_ordering == CELL_ORDER_MORTON)
+    new_to_old_local_ids = grid.MakeMortonLocalCellOrder();
+  else if (options.local_cell_ordering == CELL_ORDER_SWEEP)
+  {
+    const auto& direction = options.cell_order_sweep_direction;
+    const chi_mesh::Vector3 omega =
+      chi_mesh::Vector3(direction[0], direction[1], direction[2]).Normalized();
+    new_to_old_local_ids = grid.MakeSweepLocalCellOrder(omega);
+  }
+
+  grid.RenumberLocalCells(new_to_old_local_ids);
+
+  Chi::log.Log0Verbose1() << "VolumeMesher: Local cells renumbered.";
+}
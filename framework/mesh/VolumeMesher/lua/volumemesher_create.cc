@@ -1,6 +1,7 @@
 #include "chi_lua.h"
 #include "mesh/VolumeMesher/Extruder/volmesher_extruder.h"
 #include "mesh/VolumeMesher/PredefinedUnpartitioned/volmesher_predefunpart.h"
+#include "mesh/VolumeMesher/PartitionedFile/volmesher_partitionedfile.h"
 
 #include "mesh/MeshHandler/chi_meshhandler.h"
 #include "mesh/UnpartitionedMesh/chi_unpartitioned_mesh.h"
@@ -9,12 +10,15 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
 #include "volumemesher_lua.h"
 #include "console/chi_console.h"
 
 RegisterLuaFunctionAsIs(chiVolumeMesherCreate);
 RegisterLuaConstantAsIs(VOLUMEMESHER_EXTRUDER, chi_data_types::Varying(4));
 RegisterLuaConstantAsIs(VOLUMEMESHER_UNPARTITIONED, chi_data_types::Varying(6));
+RegisterLuaConstantAsIs(VOLUMEMESHER_PARTITIONED_FILE,
+                        chi_data_types::Varying(7));
 
 RegisterLuaConstant(ExtruderTemplateType,
                     SURFACE_MESH,
@@ -35,6 +39,9 @@ Remesher types:\n
  VOLUMEMESHER_UNPARTITIONED = Create the mesh from the latest UnpartitionedMesh.
  Requires a single additional argument, `handle`, which is a handle to
  a valid unpartitioned mesh.\n
+ VOLUMEMESHER_PARTITIONED_FILE = Reads the mesh from a file exported with
+ chiMeshHandlerExportMeshToPartitionedFile, with the same number of
+ processes. Requires a single additional argument, the file name.\n
 
 ##_
 
@@ -93,6 +100,12 @@ int chiVolumeMesherCreate(lua_State* L)
       auto p_umesh = Chi::GetStackItemPtr(
         Chi::unpartitionedmesh_stack, template_handle, fname);
 
+      ChiInvalidArgumentIf(
+        p_umesh->GetMeshOptions().home_location_ingestion or
+          p_umesh->GetMeshOptions().local_pieces_only,
+        fname + ": The extruder does not support unpartitioned meshes read "
+                "with home location ingestion or as local pieces.");
+
       new_mesher = std::make_shared<chi_mesh::VolumeMesherExtruder>(p_umesh);
     }
     else
@@ -122,12 +135,30 @@ int chiVolumeMesherCreate(lua_State* L)
     new_mesher =
       std::make_shared<chi_mesh::VolumeMesherPredefinedUnpartitioned>(p_umesh);
   }
+  else if (mesher_type == chi_mesh::VolumeMesherType::PARTITIONED_FILE)
+  {
+    if (num_args != 2)
+    {
+      Chi::log.LogAllError()
+        << fname + ": "
+                   "When specifying VOLUMEMESHER_PARTITIONED_FILE, the "
+                   "file name must also be supplied.";
+      Chi::Exit(EXIT_FAILURE);
+    }
+
+    LuaCheckStringValue(fname, L, 2);
+    const std::string file_name = lua_tostring(L, 2);
+
+    new_mesher =
+      std::make_shared<chi_mesh::VolumeMesherPartitionedFile>(file_name);
+  }
   else
   {
     Chi::log.Log0Error() << "Invalid Volume mesher type in function "
                             "chiVolumeMesherCreate. Allowed options are"
-                            "VOLUMEMESHER_EXTRUDER or "
-                            "VOLUMEMESHER_UNPARTITIONED";
+                            "VOLUMEMESHER_EXTRUDER, "
+                            "VOLUMEMESHER_UNPARTITIONED or "
+                            "VOLUMEMESHER_PARTITIONED_FILE";
     Chi::Exit(EXIT_FAILURE);
   }
 
@@ -24,11 +24,26 @@ RegisterLuaConstantAsIs(CUTS_X, chi_data_types::Varying(8));
 RegisterLuaConstantAsIs(PARTITION_TYPE, chi_data_types::Varying(9));
 RegisterLuaConstantAsIs(KBA_STYLE_XYZ, chi_data_types::Varying(2));
 RegisterLuaConstantAsIs(PARMETIS, chi_data_types::Varying(3));
+RegisterLuaConstantAsIs(PARMETIS_DISTRIBUTED, chi_data_types::Varying(4));
+RegisterLuaConstantAsIs(SPACE_FILLING_CURVE, chi_data_types::Varying(5));
+RegisterLuaConstantAsIs(KBA_STYLE_AUTO, chi_data_types::Varying(6));
 RegisterLuaConstantAsIs(EXTRUSION_LAYER, chi_data_types::Varying(10));
 RegisterLuaConstantAsIs(MATID_FROMLOGICAL, chi_data_types::Varying(11));
 RegisterLuaConstantAsIs(BNDRYID_FROMLOGICAL, chi_data_types::Varying(12));
 RegisterLuaConstantAsIs(MATID_FROM_LUA_FUNCTION, chi_data_types::Varying(13));
 RegisterLuaConstantAsIs(BNDRYID_FROM_LUA_FUNCTION, chi_data_types::Varying(14));
+RegisterLuaConstantAsIs(LOCAL_CELL_ORDERING, chi_data_types::Varying(15));
+RegisterLuaConstantAsIs(CELL_ORDER_NATIVE, chi_data_types::Varying(0));
+RegisterLuaConstantAsIs(CELL_ORDER_MORTON, chi_data_types::Varying(1));
+RegisterLuaConstantAsIs(CELL_ORDER_SWEEP, chi_data_types::Varying(2));
+RegisterLuaConstantAsIs(CELL_WEIGHTS, chi_data_types::Varying(16));
+RegisterLuaConstantAsIs(CELL_WEIGHT_UNIFORM, chi_data_types::Varying(0));
+RegisterLuaConstantAsIs(CELL_WEIGHT_NODES, chi_data_types::Varying(1));
+RegisterLuaConstantAsIs(CELL_WEIGHT_NODES_FACES, chi_data_types::Varying(2));
+RegisterLuaConstantAsIs(CELL_WEIGHT_USER, chi_data_types::Varying(3));
+RegisterLuaConstantAsIs(GHOST_LAYER, chi_data_types::Varying(17));
+RegisterLuaConstantAsIs(GHOST_LAYER_VERTEX, chi_data_types::Varying(0));
+RegisterLuaConstantAsIs(GHOST_LAYER_FACE, chi_data_types::Varying(1));
 
 RegisterLuaFunctionAsIs(chiVolumeMesherSetKBAPartitioningPxPyPz);
 RegisterLuaFunctionAsIs(chiVolumeMesherSetKBACutsX);
@@ -93,13 +108,59 @@ is
                            the face's centroid x,y,z values (doubles), the
                            face's normal x,y,z values (double), and the
                            current face-boundary id (int). The function must
-                           return a boundary id.
+                           return a boundary id.\n
+ LOCAL_CELL_ORDERING = <B>LocalCellOrdering:[int],
+                       (omega_x,omega_y,omega_z):[double](Optional)</B>
+                       Renumbers the local cells, after partitioning, to
+                       improve memory locality. The optional direction is
+                       used by CELL_ORDER_SWEEP [Default=(1,1,1)].\n
+ CELL_WEIGHTS = <B>CellWeightModel:[int], values:[table](Optional)</B>
+                Sets the per-cell weights balanced by the PARMETIS,
+                PARMETIS_DISTRIBUTED, SPACE_FILLING_CURVE and
+                KBA_STYLE_AUTO partitioners.
+                For the node and face models the optional table holds
+                per-material multipliers, with entry m+1 applying to
+                material m. For CELL_WEIGHT_USER the table is required and
+                holds one weight per cell, in global id order.\n
+ GHOST_LAYER = <B>GhostLayer:[int]</B> Sets the ghost cells stored by the
+               unpartitioned mesher. See below.
 ## _
 
 ### PartitionType
 Can be any of the following:
  - KBA_STYLE_XYZ
- - PARMETIS
+ - PARMETIS, the dual graph is built and partitioned on the home location.
+ - PARMETIS_DISTRIBUTED, every location builds the dual graph of a slice of
+   the cells and the graph is partitioned in parallel.
+ - SPACE_FILLING_CURVE, a Hilbert curve through the cell centroids is cut
+   into pieces of near equal vertex count. Fast, and works with any number
+   of locations, at the cost of partition quality.
+ - KBA_STYLE_AUTO, KBA-style cuts without PARTITION_X/Y/Z. The number of
+   partitions along each axis is chosen, from the number of processes and
+   the mesh extents, to minimize the number of sweep stages. The slabs of
+   the last axis can hold different numbers of processes, hence any number
+   of processes is supported.
+
+### CellWeightModel
+Can be any of the following:
+ - CELL_WEIGHT_UNIFORM, balances cell counts [Default].
+ - CELL_WEIGHT_NODES, the number of vertices of the cell.
+ - CELL_WEIGHT_NODES_FACES, the number of vertices plus faces of the cell.
+ - CELL_WEIGHT_USER, user supplied weights, e.g., measured sweep timings.
+
+### GhostLayer
+Can be any of the following:
+ - GHOST_LAYER_VERTEX, all the cells sharing a vertex with a local cell
+   [Default].
+ - GHOST_LAYER_FACE, only the cells sharing a face with a local cell. Far
+   fewer ghosts on tetrahedral and polyhedral meshes, sufficient for sweeps
+   and discontinuous discretizations but not for continuous ones (PWLC).
+
+### LocalCellOrdering
+Can be any of the following:
+ - CELL_ORDER_NATIVE, the order in which cells were created [Default].
+ - CELL_ORDER_MORTON, a Morton space-filling curve through the cell centroids.
+ - CELL_ORDER_SWEEP, the sweep order of the given direction.
 
 \ingroup LuaVolumeMesher
 \author Jan*/
@@ -173,7 +234,7 @@ int chiVolumeMesherSetProperty(lua_State* L)
   {
     int p = lua_tonumber(L, 2);
     if (p >= chi_mesh::VolumeMesher::PartitionType::KBA_STYLE_XYZ and
-        p <= chi_mesh::VolumeMesher::PartitionType::PARMETIS)
+        p <= chi_mesh::VolumeMesher::PartitionType::KBA_STYLE_AUTO)
       volume_mesher.options.partition_type =
         (chi_mesh::VolumeMesher::PartitionType)p;
     else
@@ -271,6 +332,62 @@ int chiVolumeMesherSetProperty(lua_State* L)
 
     chi_mesh::VolumeMesher::SetBndryIDFromLuaFunction(lua_fname);
   }
+  else if (property_index == VMP::LOCAL_CELL_ORDERING)
+  {
+    typedef chi_mesh::VolumeMesher VM;
+    int p = lua_tonumber(L, 2);
+    if (p >= VM::CELL_ORDER_NATIVE and p <= VM::CELL_ORDER_SWEEP)
+      volume_mesher.options.local_cell_ordering = (VM::LocalCellOrdering)p;
+    else
+    {
+      Chi::log.LogAllError()
+        << "Unsupported local cell ordering used in call to " << fname << ".";
+      Chi::Exit(EXIT_FAILURE);
+    }
+
+    if (num_args == 5)
+    {
+      auto& direction = volume_mesher.options.cell_order_sweep_direction;
+      direction[0] = lua_tonumber(L, 3);
+      direction[1] = lua_tonumber(L, 4);
+      direction[2] = lua_tonumber(L, 5);
+    }
+  }
+  else if (property_index == VMP::CELL_WEIGHTS)
+  {
+    typedef chi_mesh::VolumeMesher VM;
+    LuaCheckIntegerValue(fname, L, 2);
+    const int p = lua_tointeger(L, 2);
+    if (p >= VM::CELL_WEIGHT_UNIFORM and p <= VM::CELL_WEIGHT_USER)
+      volume_mesher.options.cell_weight_model = (VM::CellWeightModel)p;
+    else
+    {
+      Chi::log.LogAllError()
+        << "Unsupported cell weight model used in call to " << fname << ".";
+      Chi::Exit(EXIT_FAILURE);
+    }
+
+    auto& values = volume_mesher.options.cell_weight_values;
+    values.clear();
+    if (num_args >= 3)
+      LuaPopulateVectorFrom1DArray(fname, L, 3, values);
+    else if (p == VM::CELL_WEIGHT_USER)
+      LuaPostArgAmountError(fname, 3, num_args);
+  }
+  else if (property_index == VMP::GHOST_LAYER)
+  {
+    typedef chi_mesh::VolumeMesher VM;
+    LuaCheckIntegerValue(fname, L, 2);
+    const int p = lua_tointeger(L, 2);
+    if (p >= VM::GHOST_LAYER_VERTEX and p <= VM::GHOST_LAYER_FACE)
+      volume_mesher.options.ghost_layer = (VM::GhostLayer)p;
+    else
+    {
+      Chi::log.LogAllError()
+        << "Unsupported ghost layer used in call to " << fname << ".";
+      Chi::Exit(EXIT_FAILURE);
+    }
+  }
   else
   {
     Chi::log.LogAllError() << "Invalid property specified " << property_index
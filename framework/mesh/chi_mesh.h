@@ -4,6 +4,7 @@
 #include<vector>
 #include<iostream>
 #include<memory>
+#include<string>
 
 
 /** # Namespace for all meshing features
@@ -65,6 +66,8 @@ namespace chi_mesh
   class VolumeMesher;
   class VolumeMesherExtruder;
   class VolumeMesherPredefinedUnpartitioned;
+  class VolumeMesherPartitionedFile;
+  class VolumeMesherOrthoPartitioned;
 
   enum MeshAttributes : int
   {
@@ -93,6 +96,15 @@ namespace chi_mesh
                     std::vector<double>& x_cuts,
                     std::vector<double>& y_cuts);
   void   DecomposeSurfaceMeshPxPy(const SurfaceMesh& smesh, int Px, int Py);
+  std::vector<int64_t>
+         PartitionAlongHilbertCurve(const std::vector<Vector3>& points,
+                                    const std::vector<double>& weights,
+                                    size_t num_parts);
+  std::vector<int64_t>
+         PartitionKBAAuto(const std::vector<Vector3>& points,
+                          const std::vector<double>& weights,
+                          size_t num_parts,
+                          std::string* layout_out = nullptr);
 
   size_t CreateUnpartitioned1DOrthoMesh(std::vector<double>& vertices_1d);
 
@@ -102,6 +114,9 @@ namespace chi_mesh
   size_t CreateUnpartitioned3DOrthoMesh(std::vector<double>& vertices_1d_x,
                                         std::vector<double>& vertices_1d_y,
                                         std::vector<double>& vertices_1d_z);
+
+  void CreatePartitionedOrthoMesh(
+    const std::vector<std::vector<double>>& vertices_1d);
 }
 
 #include "chi_meshvector.h"
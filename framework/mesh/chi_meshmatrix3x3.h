@@ -56,6 +56,9 @@ struct chi_mesh::Matrix3x3
   }
 
   /**Copy constructor*/
+  Matrix3x3(const Matrix3x3& inM) = default;
+
+  /**Copy assignment operator*/
   Matrix3x3& operator=(const Matrix3x3& inM)
   {
     for (int k=0;k<9;k++)
@@ -24,6 +24,12 @@ private:
   std::vector<MPI_Group> location_groups_;
   /**Used to translate ranks.*/
   MPI_Group              world_group_;
+  /**A communicator containing the locations that share a node, i.e. that
+   * can create shared-memory windows, with locI.*/
+  MPI_Comm               node_communicator_ = MPI_COMM_NULL;
+  /**A list, size P, mapping each location to its rank in the node
+   * communicator, -1 if it is not on the node of locI.*/
+  std::vector<int>       node_ranks_;
 
 public:
   ChiMPICommunicatorSet(std::vector<MPI_Comm>&  communicators,
@@ -34,6 +40,18 @@ public:
     world_group_(world_group)
   {}
 
+  ChiMPICommunicatorSet(std::vector<MPI_Comm>&  communicators,
+                        std::vector<MPI_Group>& location_groups,
+                        MPI_Group&               world_group,
+                        MPI_Comm                 node_communicator,
+                        std::vector<int>         node_ranks) :
+    communicators_(communicators),
+    location_groups_(location_groups),
+    world_group_(world_group),
+    node_communicator_(node_communicator),
+    node_ranks_(std::move(node_ranks))
+  {}
+
   MPI_Comm LocICommunicator(int locI) const
   {
     return communicators_[locI];
@@ -47,6 +65,21 @@ public:
 
     return group_rank;
   }
+
+  /**Returns the node-local communicator, MPI_COMM_NULL if it was not
+   * built.*/
+  MPI_Comm NodeCommunicator() const
+  {
+    return node_communicator_;
+  }
+
+  /**Returns the rank of locJ in the node-local communicator, or -1 if locJ
+   * does not share a node with the current location.*/
+  int NodeRank(int locJ) const
+  {
+    if (node_ranks_.empty()) return -1;
+    return node_ranks_[locJ];
+  }
 };
 }//namespace chi_objects
 
@@ -0,0 +1,94 @@
+#ifndef CHI_MPI_NODE_SHARED_ARRAY_H
+#define CHI_MPI_NODE_SHARED_ARRAY_H
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace chi
+{
+
+//################################################################### Class def
+/**Read-only array stored once per node, in an MPI-3 shared-memory window
+ * of a node communicator, e.g., the one of a chi::ChiMPICommunicatorSet.
+ * The first location of the node allocates and fills the array, and all
+ * the locations of the node then read it in place.
+ *
+ * Construction and destruction are collective over the node communicator,
+ * hence the locations of a node must create and destroy their arrays in the
+ * same order.
+ \code
+ chi::NodeSharedArray<double> table(
+   comm_set.NodeCommunicator(), num_values,
+   [&](double* values) { std::copy(local.begin(), local.end(), values); });
+ \endcode*/
+template<typename T>
+class NodeSharedArray
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Node shared values must be trivially copyable.");
+
+private:
+  MPI_Win window_ = MPI_WIN_NULL;
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+
+public:
+  /**Allocates the array of the given size, which the fill function
+   * initializes on the first location of the node only.*/
+  NodeSharedArray(MPI_Comm node_communicator, size_t size,
+                  const std::function<void(T*)>& fill) : size_(size)
+  {
+    int node_rank = 0;
+    MPI_Comm_rank(node_communicator, &node_rank);
+
+    const auto local_bytes =
+      static_cast<MPI_Aint>(node_rank == 0 ? size * sizeof(T) : 0);
+    T* base = nullptr;
+    MPI_Win_allocate_shared(local_bytes, sizeof(T), MPI_INFO_NULL,
+                            node_communicator, &base, &window_);
+
+    if (node_rank != 0)
+    {
+      MPI_Aint bytes = 0;
+      int displacement_unit = 0;
+      MPI_Win_shared_query(window_, 0, &bytes, &displacement_unit, &base);
+    }
+
+    //=================================== Fill and make the values visible
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+    if (node_rank == 0 and size > 0) fill(base);
+    MPI_Win_sync(window_);
+    MPI_Barrier(node_communicator);
+    MPI_Win_sync(window_);
+
+    data_ = base;
+  }
+
+  ~NodeSharedArray()
+  {
+    // Skipped for arrays outliving MPI, e.g., on static stacks
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (finalized or window_ == MPI_WIN_NULL) return;
+
+    MPI_Win_unlock_all(window_);
+    MPI_Win_free(&window_);
+  }
+
+  NodeSharedArray(const NodeSharedArray&) = delete;
+  NodeSharedArray& operator=(const NodeSharedArray&) = delete;
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  const T& operator[](size_t i) const { return data_[i]; }
+
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+};
+
+}//namespace chi
+
+#endif //CHI_MPI_NODE_SHARED_ARRAY_H
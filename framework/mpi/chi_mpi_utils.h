@@ -2,6 +2,7 @@
 #define CHITECH_CHI_MPI_UTILS_H
 
 #include "chi_mpi_utils_map_all2all.h"
+#include "chi_mpi_utils_distribute_allgather.h"
 
 namespace chi_mpi_utils
 {
@@ -0,0 +1,119 @@
+#ifndef CHI_MPI_DISTRIBUTE_ALLGATHER_H
+#define CHI_MPI_DISTRIBUTE_ALLGATHER_H
+
+#include <vector>
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+namespace chi_mpi_utils
+{
+
+/**Computes the `num_items` items distributed round-robin over the
+ * processes of the communicator, item k on process k modulo the number of
+ * processes, and returns all the items on every process.
+ *
+ * `compute_item(k)` must return the item k as a `std::vector<double>`,
+ * whose size may differ between items, and is only called on the process
+ * owning item k. The call is collective, and `num_items` must be the same
+ * on all processes.*/
+template<class ComputeFunction> std::vector<std::vector<double>>
+  DistributeAndAllGather(const size_t num_items,
+                         ComputeFunction compute_item,
+                         const MPI_Comm communicator=Chi::mpi.comm)
+{
+  int process_count = 1;
+  int rank = 0;
+  MPI_Comm_size(communicator, &process_count);
+  MPI_Comm_rank(communicator, &rank);
+
+  const auto Owner = [process_count](size_t k)
+  { return static_cast<int>(k % process_count); };
+
+  //============================================= Compute the local items
+  std::vector<int> local_sizes;
+  std::vector<double> local_data;
+  for (size_t k = 0; k < num_items; ++k)
+  {
+    if (Owner(k) != rank) continue;
+    const std::vector<double> item = compute_item(k);
+    local_sizes.push_back(static_cast<int>(item.size()));
+    local_data.insert(local_data.end(), item.begin(), item.end());
+  }
+
+  std::vector<std::vector<double>> items(num_items);
+  if (process_count == 1)
+  {
+    size_t offset = 0;
+    for (size_t k = 0; k < num_items; ++k)
+    {
+      items[k].assign(local_data.begin() + offset,
+                      local_data.begin() + offset + local_sizes[k]);
+      offset += local_sizes[k];
+    }
+    return items;
+  }
+
+  //============================================= Gather the item sizes
+  // The number of items per process is known everywhere
+  std::vector<int> num_items_per_process(process_count, 0);
+  for (size_t k = 0; k < num_items; ++k)
+    ++num_items_per_process[Owner(k)];
+
+  std::vector<int> items_displs(process_count, 0);
+  for (int p = 1; p < process_count; ++p)
+    items_displs[p] = items_displs[p - 1] + num_items_per_process[p - 1];
+
+  std::vector<int> sizes(num_items, 0);
+  MPI_Allgatherv(local_sizes.data(),                //sendbuf
+                 static_cast<int>(local_sizes.size()), MPI_INT,
+                 sizes.data(),                      //recvbuf
+                 num_items_per_process.data(),      //recvcounts
+                 items_displs.data(),               //displs
+                 MPI_INT,                           //recvtype
+                 communicator);
+
+  //============================================= Gather the item data
+  // Sizes are ordered by process, then by item
+  std::vector<int> data_counts(process_count, 0);
+  {
+    size_t i = 0;
+    for (int p = 0; p < process_count; ++p)
+      for (int n = 0; n < num_items_per_process[p]; ++n)
+        data_counts[p] += sizes[i++];
+  }
+
+  std::vector<int> data_displs(process_count, 0);
+  for (int p = 1; p < process_count; ++p)
+    data_displs[p] = data_displs[p - 1] + data_counts[p - 1];
+
+  std::vector<double> data(data_displs.back() + data_counts.back());
+  MPI_Allgatherv(local_data.data(),                 //sendbuf
+                 static_cast<int>(local_data.size()), MPI_DOUBLE,
+                 data.data(),                       //recvbuf
+                 data_counts.data(),                //recvcounts
+                 data_displs.data(),                //displs
+                 MPI_DOUBLE,                        //recvtype
+                 communicator);
+
+  //============================================= Unpack in item order
+  // Item k is the (k / process_count)-th item of its owner
+  std::vector<int> item_offsets(process_count, 0);
+  for (int p = 0; p < process_count; ++p)
+    item_offsets[p] = data_displs[p];
+
+  for (size_t k = 0; k < num_items; ++k)
+  {
+    const int p = Owner(k);
+    const int size = sizes[items_displs[p] + k / process_count];
+    items[k].assign(data.begin() + item_offsets[p],
+                    data.begin() + item_offsets[p] + size);
+    item_offsets[p] += size;
+  }
+
+  return items;
+}
+
+}//namespace chi_mpi_utils
+
+#endif//CHI_MPI_DISTRIBUTE_ALLGATHER_H
@@ -0,0 +1,124 @@
+#include "chi_lua.h"
+
+#include "chi_mpi_lua.h"
+#include "parameters/parameter_block.h"
+#include "data_types/byte_array.h"
+
+#include "console/chi_console.h"
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+namespace chi_mpi_utils
+{
+
+RegisterLuaFunctionAsIs(chiEvaluateOnRoot);
+
+//###################################################################
+/**Calls a lua function on the root location only and returns its result,
+a table, on all locations. The table is broadcast as a parameter block,
+hence it may only hold booleans, numbers, strings and tables.
+
+This avoids redoing expensive setup work on every location, e.g., reading
+files or generating data in loops, and keeps the file system from being
+accessed by all the locations at once. Collective.
+
+\param Function function The function to call, with the remaining
+       arguments. It must return a table, or nothing.
+\param ... Optional. Arguments passed to the function on the root.
+
+\return The table returned on the root, or nil.
+
+\code
+function ReadCoefficients(file_name)
+  local values = {}
+  for line in io.lines(file_name) do
+    values[#values + 1] = tonumber(line)
+  end
+  return { values = values }
+end
+
+data = chiEvaluateOnRoot(ReadCoefficients, "coefficients.txt")
+\endcode
+
+The table can also be the parameters of objects, e.g., for `chiMakeObject`,
+which every location then makes from the same broadcast parameters.
+
+\ingroup chiMPI*/
+int chiEvaluateOnRoot(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args < 1) LuaPostArgAmountError(fname, 1, num_args);
+
+  ChiInvalidArgumentIf(not lua_isfunction(L, 1),
+                       fname + ": The first argument must be a function.");
+
+  //============================================= Evaluate on the root
+  // The first byte flags whether the evaluation failed, in which case the
+  // error message follows, otherwise whether a table follows
+  chi_data_types::ByteArray bytes;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::string error;
+    bool has_table = false;
+    chi::ParameterBlock block;
+    if (lua_pcall(L, num_args - 1, 1, 0) != 0)
+      error = lua_tostring(L, -1);
+    else if (lua_istable(L, -1))
+    {
+      try
+      {
+        block =
+          chi_lua::TableParserAsParameterBlock::ParseTable(L, lua_gettop(L));
+        has_table = true;
+      }
+      catch (const std::exception& e)
+      {
+        error = e.what();
+      }
+    }
+    else if (not lua_isnil(L, -1))
+      error = "The function must return a table or nothing.";
+    lua_pop(L, 1);
+
+    bytes.Write<bool>(not error.empty());
+    if (not error.empty())
+    {
+      bytes.Write<uint64_t>(error.size());
+      bytes.WriteBytes(error.data(), error.size());
+    }
+    else
+    {
+      bytes.Write<bool>(has_table);
+      if (has_table) bytes.Append(block.Serialize());
+    }
+  }
+
+  //============================================= Broadcast
+  uint64_t num_bytes = bytes.Size();
+  MPI_Bcast(&num_bytes, 1, MPI_UINT64_T, 0, Chi::mpi.comm);
+  bytes.Data().resize(num_bytes);
+  MPI_Bcast(bytes.Data().data(), static_cast<int>(num_bytes), MPI_BYTE, 0,
+            Chi::mpi.comm);
+
+  //============================================= Push the result
+  size_t address = 0;
+  if (bytes.Read<bool>(address, &address))
+  {
+    const auto size = bytes.Read<uint64_t>(address, &address);
+    const auto* chars =
+      reinterpret_cast<const char*>(bytes.ReadBytes(address, size));
+    ChiLogicalError(fname + ": Evaluation on the root failed. " +
+                    std::string(chars, size));
+  }
+
+  if (not bytes.Read<bool>(address, &address)) return 0;
+
+  const auto block = chi::ParameterBlock::DeSerialize(bytes, address);
+  chi_lua::PushParameterBlock(L, block, /*level=*/1);
+  return 1;
+}
+
+} // namespace chi_mpi_utils
@@ -1,7 +1,11 @@
 #include "mpi_info.h"
 
+#include "chi_runtime.h"
+#include "chi_log.h"
 #include "chi_log_exceptions.h"
 
+#include <string>
+
 namespace chi
 {
 
@@ -35,8 +39,45 @@ void MPI_Info::SetProcessCount(int in_process_count)
   process_count_set_ = true;
 }
 
+/**Splits the processes of the communicator into the given number of angle
+ * teams, of consecutive processes, which each sweep a subset of the angles.
+ * The communicator, location id and process count then become those of
+ * the team, such that the spatial domain is decomposed over the team, and
+ * the cross-team communicator connects the processes of the different teams
+ * with the same location id. The number of processes must be divisible by
+ * the number of teams.*/
+void MPI_Info::SplitIntoAngleTeams(int num_teams)
+{
+  ChiInvalidArgumentIf(num_teams < 1 or process_count_ % num_teams != 0,
+                       "The number of processes, " +
+                       std::to_string(process_count_) +
+                       ", is not divisible by the number of angle teams, " +
+                       std::to_string(num_teams) + ".");
+  if (num_teams == 1) return;
+
+  const int team_size = process_count_ / num_teams;
+  const int team_id = location_id_ / team_size;
+  const int team_location_id = location_id_ % team_size;
+
+  MPI_Comm team_communicator;
+  MPI_Comm cross_team_communicator;
+  MPI_Comm_split(communicator_, team_id, team_location_id,
+                 &team_communicator);
+  MPI_Comm_split(communicator_, team_location_id, team_id,
+                 &cross_team_communicator);
+
+  communicator_ = team_communicator;
+  location_id_ = team_location_id;
+  process_count_ = team_size;
+
+  cross_team_communicator_ = cross_team_communicator;
+  angle_team_id_ = team_id;
+  num_angle_teams_ = num_teams;
+}
+
 void MPI_Info::Barrier() const
 {
+  Chi::log.FlushAggregatedLogs();
   MPI_Barrier(this->communicator_);
 }
 
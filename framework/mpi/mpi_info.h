@@ -22,11 +22,21 @@ private:
   bool location_id_set_ = false;
   bool process_count_set_ = false;
 
+  MPI_Comm cross_team_communicator_ = MPI_COMM_SELF;
+  int angle_team_id_ = 0;
+  int num_angle_teams_ = 1;
+
 public:
   const int& location_id = location_id_;     ///< Current process rank.
   const int& process_count = process_count_; ///< Total number of processes.
   const MPI_Comm& comm = communicator_; ///< MPI communicator
 
+  const int& angle_team_id = angle_team_id_;     ///< Angle team of process.
+  const int& num_angle_teams = num_angle_teams_; ///< Number of angle teams.
+  /**Communicator of the processes, one per angle team, with the same
+   * location id, i.e., owning the same part of the spatial domain.*/
+  const MPI_Comm& cross_team_comm = cross_team_communicator_;
+
 private:
   MPI_Info() = default;
 
@@ -44,9 +54,12 @@ protected:
   void SetLocationID(int in_location_id);
   /**Sets the number of processes in the communicator.*/
   void SetProcessCount(int in_process_count);
+  /**Splits the processes of the communicator into angle teams.*/
+  void SplitIntoAngleTeams(int num_teams);
 
 public:
-  /**Calls the generic `MPI_Barrier` with the current communicator.*/
+  /**Calls the generic `MPI_Barrier` with the current communicator, after
+   * flushing the aggregated logs, if any.*/
   void Barrier() const;
   static void Call(int mpi_error_code);
 
@@ -43,9 +43,7 @@ ParameterBlock::ParameterBlock(const ParameterBlock& other)
   type_ = other.type_;
   name_ = other.name_;
 
-  using namespace chi_data_types;
-  if (other.value_ptr_)
-    value_ptr_ = std::make_unique<Varying>(*other.value_ptr_);
+  value_ptr_ = other.value_ptr_;
 
   parameters_ = other.parameters_;
   error_origin_scope_ = other.error_origin_scope_;
@@ -58,9 +56,7 @@ ParameterBlock& ParameterBlock::operator=(const ParameterBlock& other)
   type_ = other.type_;
   name_ = other.name_;
 
-  using namespace chi_data_types;
-  if (other.value_ptr_)
-    value_ptr_ = std::make_unique<Varying>(*other.value_ptr_);
+  value_ptr_ = other.value_ptr_;
 
   parameters_ = other.parameters_;
   error_origin_scope_ = other.error_origin_scope_;
@@ -97,7 +93,7 @@ const chi_data_types::Varying& ParameterBlock::Value() const
     case ParameterBlockType::STRING:
     case ParameterBlockType::INTEGER:
     {
-      if (value_ptr_ == nullptr)
+      if (not value_ptr_)
         throw std::runtime_error(
           error_origin_scope_ + std::string(__PRETTY_FUNCTION__) +
           ": Uninitialized Varying value for block " + this->Name());
@@ -343,4 +339,106 @@ void ParameterBlock::RecursiveDumpToString(std::string& outstr,
 }
 // NOLINTEND(misc-no-recursion)
 
+// #################################################################
+namespace
+{
+/**Tag and version leading a serialized block, rejecting bytes that are
+ * not one or are of another format.*/
+constexpr uint32_t SERIALIZATION_TAG = 0x42504843; // "CHPB"
+constexpr uint32_t SERIALIZATION_VERSION = 1;
+} // namespace
+
+/**Serializes the block with its sub-parameters into a byte array, sized
+ * once, after a tag and format version. Values are stored in binary
+ * hence they round-trip exactly.*/
+chi_data_types::ByteArray ParameterBlock::Serialize() const
+{
+  chi_data_types::ByteArray raw;
+  raw.Reserve(2 * sizeof(uint32_t) + SerializedNodeSize());
+
+  raw.Write<uint32_t>(SERIALIZATION_TAG);
+  raw.Write<uint32_t>(SERIALIZATION_VERSION);
+  SerializeNode(raw);
+
+  return raw;
+}
+
+/**Deserializes a block serialized with Serialize at the given address,
+ * which is advanced past it.*/
+ParameterBlock ParameterBlock::DeSerialize(const chi_data_types::ByteArray& raw,
+                                           size_t& address)
+{
+  const auto tag = raw.Read<uint32_t>(address, &address);
+  const auto version = raw.Read<uint32_t>(address, &address);
+  if (tag != SERIALIZATION_TAG)
+    throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                           ": The bytes are not a serialized ParameterBlock.");
+  if (version != SERIALIZATION_VERSION)
+    throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                           ": Unsupported serialization version " +
+                           std::to_string(version) + ".");
+
+  return DeSerializeNode(raw, address);
+}
+
+// NOLINTBEGIN(misc-no-recursion)
+/**Writes the type, name, value if any, and sub-parameters.*/
+void ParameterBlock::SerializeNode(chi_data_types::ByteArray& raw) const
+{
+  raw.Write<ParameterBlockType>(type_);
+  raw.Write<uint64_t>(name_.size());
+  raw.WriteBytes(name_.data(), name_.size());
+
+  raw.Write<bool>(value_ptr_.has_value());
+  if (value_ptr_) value_ptr_->Serialize(raw);
+
+  raw.Write<uint64_t>(parameters_.size());
+  for (const auto& param : parameters_)
+    param.SerializeNode(raw);
+}
+
+/**Returns the number of bytes written by SerializeNode.*/
+size_t ParameterBlock::SerializedNodeSize() const
+{
+  size_t num_bytes = sizeof(ParameterBlockType) + sizeof(uint64_t) +
+                     name_.size() + sizeof(bool) + sizeof(uint64_t);
+  if (value_ptr_) num_bytes += value_ptr_->SerializedSize();
+
+  for (const auto& param : parameters_)
+    num_bytes += param.SerializedNodeSize();
+
+  return num_bytes;
+}
+
+/**Reads a block written by SerializeNode. The sub-parameters are moved
+ * in directly, in their serialized order, bypassing the duplicate checks
+ * and sorting of AddParameter which the original block already passed.*/
+ParameterBlock
+ParameterBlock::DeSerializeNode(const chi_data_types::ByteArray& raw,
+                                size_t& address)
+{
+  const auto type = raw.Read<ParameterBlockType>(address, &address);
+  const auto name_size = raw.Read<uint64_t>(address, &address);
+  const auto* name =
+    reinterpret_cast<const char*>(raw.ReadBytes(address, name_size, &address));
+
+  ParameterBlock block(std::string(name, name_size));
+  block.type_ = type;
+
+  if (raw.Read<bool>(address, &address))
+    block.value_ptr_.emplace(
+      chi_data_types::Varying::DeSerialize(raw, address));
+
+  const auto num_params = raw.Read<uint64_t>(address, &address);
+  if (num_params > raw.Size() - address)
+    throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                           ": Corrupt serialized ParameterBlock.");
+  block.parameters_.reserve(num_params);
+  for (uint64_t p = 0; p < num_params; ++p)
+    block.parameters_.push_back(DeSerializeNode(raw, address));
+
+  return block;
+}
+// NOLINTEND(misc-no-recursion)
+
 } // namespace chi_objects
\ No newline at end of file
@@ -2,8 +2,10 @@
 #define CHITECH_PARAMETER_BLOCK_H
 
 #include "data_types/varying.h"
+#include "data_types/byte_array.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 
@@ -40,7 +42,7 @@ class ParameterBlock
 private:
   ParameterBlockType type_ = ParameterBlockType::BLOCK;
   std::string name_;
-  std::unique_ptr<chi_data_types::Varying> value_ptr_ = nullptr;
+  std::optional<chi_data_types::Varying> value_ptr_;
   std::vector<ParameterBlock> parameters_;
   std::string error_origin_scope_ = "Unknown Scope";
 
@@ -101,7 +103,7 @@ public:
     if (IsString<T>::value) type_ = ParameterBlockType::STRING;
     if (IsInteger<T>::value) type_ = ParameterBlockType::INTEGER;
 
-    value_ptr_ = std::make_unique<chi_data_types::Varying>(value);
+    value_ptr_.emplace(value);
   }
 
   /**Copy constructor*/
@@ -183,7 +185,7 @@ public:
   template <typename T>
   T GetValue() const
   {
-    if (value_ptr_ == nullptr)
+    if (not value_ptr_)
       throw std::logic_error(error_origin_scope_ +
                              std::string(__PRETTY_FUNCTION__) +
                              ": Value not available for block type " +
@@ -266,6 +268,22 @@ public:
    * tree and print values into the reference string.*/
   void RecursiveDumpToString(std::string& outstr,
                              const std::string& offset = "") const;
+
+  // Serialization
+  /**Serializes the block with its sub-parameters into a byte array, sized
+   * once, after a tag and format version. Values are stored in binary
+   * hence they round-trip exactly.*/
+  chi_data_types::ByteArray Serialize() const;
+  /**Deserializes a block serialized with Serialize at the given address,
+   * which is advanced past it.*/
+  static ParameterBlock DeSerialize(const chi_data_types::ByteArray& raw,
+                                    size_t& address);
+
+private:
+  void SerializeNode(chi_data_types::ByteArray& raw) const;
+  size_t SerializedNodeSize() const;
+  static ParameterBlock DeSerializeNode(const chi_data_types::ByteArray& raw,
+                                        size_t& address);
 };
 
 } // namespace chi_objects
@@ -0,0 +1,89 @@
+#include "coefficient_from_lua.h"
+
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "math/Functions/function_dimA_to_dimB.h"
+
+#include "chi_runtime.h"
+
+namespace chi_physics::lua_utils
+{
+
+//###################################################################
+/**Makes a coefficient from the lua arguments starting at the given one,
+ * being the kind of coefficient followed by its value:
+ * - "material_constants", a table of values keyed by material id,
+ * - "field_function", the handle of a grid-based field function, with
+ *   optionally the component, 0 by default,
+ * - "function", the handle of a function object of x, y, z and the
+ *   material id,
+ * - "lua", the name of a lua function of the material id and x, y and z.*/
+CoefficientPtr CoefficientFromLua(const std::string& fname,
+                                  lua_State* L,
+                                  const int kind_arg)
+{
+  const int num_args = lua_gettop(L);
+  if (num_args < kind_arg + 1)
+    LuaPostArgAmountError(fname, kind_arg + 1, num_args);
+
+  LuaCheckStringValue(fname, L, kind_arg);
+  const std::string kind = lua_tostring(L, kind_arg);
+  const int value_arg = kind_arg + 1;
+
+  if (kind == "material_constants")
+  {
+    LuaCheckTableValue(fname, L, value_arg);
+
+    std::map<int, double> material_values;
+    lua_pushnil(L);
+    while (lua_next(L, value_arg) != 0)
+    {
+      if (not lua_isinteger(L, -2) or not lua_isnumber(L, -1))
+        throw std::invalid_argument(fname + ": The material constants must "
+                                            "be numbers keyed by material "
+                                            "id.");
+      material_values[static_cast<int>(lua_tointeger(L, -2))] =
+        lua_tonumber(L, -1);
+      lua_pop(L, 1);
+    }
+
+    return std::make_shared<MaterialConstantCoefficient>(
+      std::move(material_values));
+  }
+  if (kind == "field_function")
+  {
+    LuaCheckIntegerValue(fname, L, value_arg);
+    const size_t ff_handle = lua_tointeger(L, value_arg);
+
+    unsigned int component = 0;
+    if (num_args >= value_arg + 1)
+    {
+      LuaCheckIntegerValue(fname, L, value_arg + 1);
+      component = static_cast<unsigned int>(lua_tointeger(L, value_arg + 1));
+    }
+
+    auto ff = Chi::GetStackItemPtrAsType<FieldFunctionGridBased>(
+      Chi::field_function_stack, ff_handle, fname);
+
+    return std::make_shared<FieldFunctionCoefficient>(ff, component);
+  }
+  if (kind == "function")
+  {
+    LuaCheckIntegerValue(fname, L, value_arg);
+    const size_t function_handle = lua_tointeger(L, value_arg);
+
+    auto function = Chi::GetStackItemPtrAsType<chi_math::FunctionDimAToDimB>(
+      Chi::object_stack, function_handle, fname);
+
+    return std::make_shared<FunctionCoefficient>(function);
+  }
+  if (kind == "lua")
+  {
+    LuaCheckStringValue(fname, L, value_arg);
+    return std::make_shared<LuaCoefficient>(lua_tostring(L, value_arg));
+  }
+
+  throw std::invalid_argument(fname + ": Invalid coefficient kind \"" +
+                              kind + "\".");
+}
+
+} // namespace chi_physics::lua_utils
@@ -0,0 +1,15 @@
+#ifndef CHITECH_COEFFICIENT_FROM_LUA_H
+#define CHITECH_COEFFICIENT_FROM_LUA_H
+
+#include "physics/Coefficients/spatial_material_coefficient.h"
+
+#include "chi_lua.h"
+
+namespace chi_physics::lua_utils
+{
+CoefficientPtr CoefficientFromLua(const std::string& fname,
+                                  lua_State* L,
+                                  int kind_arg);
+} // namespace chi_physics::lua_utils
+
+#endif // CHITECH_COEFFICIENT_FROM_LUA_H
@@ -0,0 +1,167 @@
+#include "spatial_material_coefficient.h"
+
+#include "mesh/Cell/cell.h"
+
+#include "math/Functions/function_dimA_to_dimB.h"
+#include "math/SpatialDiscretization/spatial_discretization.h"
+
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+
+#include "console/chi_console.h"
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+#include "chi_lua.h"
+
+namespace chi_physics
+{
+
+//###################################################################
+void SpatialMaterialCoefficient::EvaluatePoints(
+  const chi_mesh::Cell& cell,
+  const std::vector<chi_mesh::Vector3>& points,
+  std::vector<double>& values) const
+{
+  values.resize(points.size());
+  for (size_t p = 0; p < points.size(); ++p)
+    values[p] = Evaluate(cell, points[p]);
+}
+
+//###################################################################
+MaterialConstantCoefficient::MaterialConstantCoefficient(
+  std::map<int, double> material_values)
+  : material_values_(std::move(material_values))
+{
+}
+
+double
+MaterialConstantCoefficient::Evaluate(const chi_mesh::Cell& cell,
+                                      const chi_mesh::Vector3& xyz) const
+{
+  const auto it = material_values_.find(cell.material_id_);
+  ChiInvalidArgumentIf(it == material_values_.end(),
+                       "No value for material " +
+                         std::to_string(cell.material_id_) + ".");
+  return it->second;
+}
+
+/**Looks up the material once for all the points.*/
+void MaterialConstantCoefficient::EvaluatePoints(
+  const chi_mesh::Cell& cell,
+  const std::vector<chi_mesh::Vector3>& points,
+  std::vector<double>& values) const
+{
+  values.assign(points.size(),
+                points.empty() ? 0.0 : Evaluate(cell, points.front()));
+}
+
+//###################################################################
+FieldFunctionCoefficient::FieldFunctionCoefficient(
+  std::shared_ptr<const FieldFunctionGridBased> field_function,
+  unsigned int component)
+  : field_function_(std::move(field_function)),
+    component_(component),
+    ghosted_field_vector_(field_function_->GetGhostedFieldVector())
+{
+  ChiInvalidArgumentIf(component_ >=
+                         field_function_->Unknown().NumComponents(),
+                       "Invalid component " + std::to_string(component_) +
+                         " of field function " +
+                         field_function_->TextName() + ".");
+}
+
+double
+FieldFunctionCoefficient::Evaluate(const chi_mesh::Cell& cell,
+                                   const chi_mesh::Vector3& xyz) const
+{
+  const auto& sdm = field_function_->SDM();
+  const auto& cell_mapping = sdm.GetCellMapping(cell);
+
+  std::vector<double> shape_values;
+  cell_mapping.ShapeValues(xyz, shape_values);
+
+  const auto& uk_man = field_function_->UnkManager();
+  double value = 0.0;
+  const size_t num_nodes = cell_mapping.NumNodes();
+  for (size_t j = 0; j < num_nodes; ++j)
+  {
+    const int64_t dof_map = sdm.MapDOFLocal(cell, j, uk_man, 0, component_);
+    value += ghosted_field_vector_[dof_map] * shape_values[j];
+  }
+
+  return value;
+}
+
+//###################################################################
+FunctorCoefficient::FunctorCoefficient(Function function)
+  : function_(std::move(function))
+{
+}
+
+double FunctorCoefficient::Evaluate(const chi_mesh::Cell& cell,
+                                    const chi_mesh::Vector3& xyz) const
+{
+  return function_(cell.material_id_, xyz);
+}
+
+//###################################################################
+FunctionCoefficient::FunctionCoefficient(
+  std::shared_ptr<const chi_math::FunctionDimAToDimB> function)
+  : function_(std::move(function))
+{
+  ChiInvalidArgumentIf(function_->InputDimension() != 4 or
+                         function_->OutputDimension() != 1,
+                       "A coefficient function needs to be callable with "
+                       "x,y,z,material_id and return a single value.");
+}
+
+double FunctionCoefficient::Evaluate(const chi_mesh::Cell& cell,
+                                     const chi_mesh::Vector3& xyz) const
+{
+  return function_->Evaluate(
+    {xyz.x, xyz.y, xyz.z, static_cast<double>(cell.material_id_)})[0];
+}
+
+//###################################################################
+LuaCoefficient::LuaCoefficient(std::string lua_function_name)
+  : lua_function_name_(std::move(lua_function_name))
+{
+}
+
+double LuaCoefficient::Evaluate(const chi_mesh::Cell& cell,
+                                const chi_mesh::Vector3& xyz) const
+{
+  lua_State* L = Chi::console.GetConsoleState();
+
+  //============= Load lua function
+  lua_getglobal(L, lua_function_name_.c_str());
+
+  //============= Error check lua function
+  ChiLogicalErrorIf(not lua_isfunction(L, -1),
+                    "Attempted to access lua-function, " +
+                      lua_function_name_ +
+                      ", but it seems the function could not be retrieved.");
+
+  //============= Push arguments
+  lua_pushinteger(L, cell.material_id_);
+  lua_pushnumber(L, xyz.x);
+  lua_pushnumber(L, xyz.y);
+  lua_pushnumber(L, xyz.z);
+
+  //============= Call lua function
+  //4 arguments, 1 result (double), 0=original error object
+  double lua_return;
+  if (lua_pcall(L, 4, 1, 0) == 0)
+  {
+    LuaCheckNumberValue(__FUNCTION__, L, -1);
+    lua_return = lua_tonumber(L, -1);
+  }
+  else
+    ChiLogicalError("Attempted to call lua-function, " + lua_function_name_ +
+                    ", but the call failed. " + xyz.PrintStr());
+
+  lua_pop(L, 1); //pop the double, or error code
+
+  return lua_return;
+}
+
+} // namespace chi_physics
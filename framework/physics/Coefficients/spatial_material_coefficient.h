@@ -0,0 +1,132 @@
+#ifndef CHITECH_SPATIAL_MATERIAL_COEFFICIENT_H
+#define CHITECH_SPATIAL_MATERIAL_COEFFICIENT_H
+
+#include "mesh/chi_mesh.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace chi_math
+{
+class FunctionDimAToDimB;
+}
+
+namespace chi_physics
+{
+class FieldFunctionGridBased;
+
+//###################################################################
+/**A scalar coefficient of a PDE, e.g., a diffusion coefficient, a cross
+ * section or a source, as a function of the material of a cell and the
+ * location. Solvers evaluate it during their assembly, at the quadrature
+ * points of the cells or their faces, which may be ghost cells.*/
+class SpatialMaterialCoefficient
+{
+public:
+  virtual double Evaluate(const chi_mesh::Cell& cell,
+                          const chi_mesh::Vector3& xyz) const = 0;
+
+  /**Evaluates the coefficient at several points of a cell, e.g., its
+   * quadrature points. The default evaluates the points one at a time.*/
+  virtual void EvaluatePoints(const chi_mesh::Cell& cell,
+                              const std::vector<chi_mesh::Vector3>& points,
+                              std::vector<double>& values) const;
+
+  virtual ~SpatialMaterialCoefficient() = default;
+};
+
+typedef std::shared_ptr<const SpatialMaterialCoefficient> CoefficientPtr;
+
+//###################################################################
+/**A coefficient constant per material.*/
+class MaterialConstantCoefficient : public SpatialMaterialCoefficient
+{
+private:
+  const std::map<int, double> material_values_;
+
+public:
+  explicit MaterialConstantCoefficient(std::map<int, double> material_values);
+
+  double Evaluate(const chi_mesh::Cell& cell,
+                  const chi_mesh::Vector3& xyz) const override;
+  void EvaluatePoints(const chi_mesh::Cell& cell,
+                      const std::vector<chi_mesh::Vector3>& points,
+                      std::vector<double>& values) const override;
+};
+
+//###################################################################
+/**A coefficient tabulated by a component of a grid-based field
+ * function, on the grid of the solver, interpolated by the shape functions
+ * of its discretization. The field, with its ghost values, is copied at
+ * construction, which is collective.*/
+class FieldFunctionCoefficient : public SpatialMaterialCoefficient
+{
+private:
+  const std::shared_ptr<const FieldFunctionGridBased> field_function_;
+  const unsigned int component_;
+  const std::vector<double> ghosted_field_vector_;
+
+public:
+  explicit FieldFunctionCoefficient(
+    std::shared_ptr<const FieldFunctionGridBased> field_function,
+    unsigned int component = 0);
+
+  double Evaluate(const chi_mesh::Cell& cell,
+                  const chi_mesh::Vector3& xyz) const override;
+};
+
+//###################################################################
+/**A coefficient given by a compiled function of the material id and the
+ * location.*/
+class FunctorCoefficient : public SpatialMaterialCoefficient
+{
+public:
+  typedef std::function<double(int, const chi_mesh::Vector3&)> Function;
+
+private:
+  const Function function_;
+
+public:
+  explicit FunctorCoefficient(Function function);
+
+  double Evaluate(const chi_mesh::Cell& cell,
+                  const chi_mesh::Vector3& xyz) const override;
+};
+
+//###################################################################
+/**A coefficient given by a function object, called with x, y, z and the
+ * material id, as the field operations do, and with a single output.*/
+class FunctionCoefficient : public SpatialMaterialCoefficient
+{
+private:
+  const std::shared_ptr<const chi_math::FunctionDimAToDimB> function_;
+
+public:
+  explicit FunctionCoefficient(
+    std::shared_ptr<const chi_math::FunctionDimAToDimB> function);
+
+  double Evaluate(const chi_mesh::Cell& cell,
+                  const chi_mesh::Vector3& xyz) const override;
+};
+
+//###################################################################
+/**A coefficient given by a lua function, called with the material id and
+ * x, y and z. The slowest of the coefficients, calling into lua at every
+ * point, it is the fallback of the solvers for coefficients not set
+ * otherwise.*/
+class LuaCoefficient : public SpatialMaterialCoefficient
+{
+private:
+  const std::string lua_function_name_;
+
+public:
+  explicit LuaCoefficient(std::string lua_function_name);
+
+  double Evaluate(const chi_mesh::Cell& cell,
+                  const chi_mesh::Vector3& xyz) const override;
+};
+
+} // namespace chi_physics
+
+#endif // CHITECH_SPATIAL_MATERIAL_COEFFICIENT_H
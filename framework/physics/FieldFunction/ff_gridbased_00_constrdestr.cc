@@ -46,8 +46,8 @@ FieldFunctionGridBased::FieldFunctionGridBased(
   if (sdm_type == "PWLC") sdm_ = PWLC::New(*grid_ptr);
   if (sdm_type == "PWLD") sdm_ = PWLD::New(*grid_ptr);
 
-  const size_t num_local_dofs = sdm_->GetNumLocalDOFs(UnkManager());
-  field_vector_.assign(num_local_dofs,
+  num_local_dofs_ = sdm_->GetNumLocalDOFs(UnkManager());
+  field_vector_.assign(num_local_dofs_,
                        params.GetParamValue<double>("initial_value"));
 
   vector_ghost_communicator_ = MakeGhostCommunicator();
@@ -61,12 +61,30 @@ FieldFunctionGridBased::FieldFunctionGridBased(const std::string& text_name,
     sdm_(sdm_ptr),
     local_grid_bounding_box_(sdm_->Grid().GetLocalBoundingBox())
 {
-  const size_t num_local_dofs = sdm_->GetNumLocalDOFs(UnkManager());
-  field_vector_.assign(num_local_dofs, 0.0);
+  num_local_dofs_ = sdm_->GetNumLocalDOFs(UnkManager());
 
   vector_ghost_communicator_ = MakeGhostCommunicator();
 }
 
+// ##################################################################
+FieldFunctionGridBased::FieldFunctionGridBased(
+  const std::string& text_name,
+  chi_math::SMDPtr& sdm_ptr,
+  chi_math::Unknown unknown,
+  VectorGhostCommPtr ghost_communicator)
+  : FieldFunction(text_name, std::move(unknown)),
+    sdm_(sdm_ptr),
+    local_grid_bounding_box_(sdm_->Grid().GetLocalBoundingBox()),
+    vector_ghost_communicator_(std::move(ghost_communicator))
+{
+  if (not vector_ghost_communicator_)
+    throw std::logic_error(std::string(__FUNCTION__) +
+                           ": Constructor called without a ghost "
+                           "communicator.");
+
+  num_local_dofs_ = sdm_->GetNumLocalDOFs(UnkManager());
+}
+
 // ##################################################################
 FieldFunctionGridBased::FieldFunctionGridBased(const std::string& text_name,
                                                chi_math::SMDPtr& sdm_ptr,
@@ -77,8 +95,8 @@ FieldFunctionGridBased::FieldFunctionGridBased(const std::string& text_name,
     local_grid_bounding_box_(sdm_->Grid().GetLocalBoundingBox())
 {
   const std::string fname = __FUNCTION__;
-  const size_t num_local_dofs = sdm_->GetNumLocalDOFs(UnkManager());
-  if (field_vector.size() != num_local_dofs)
+  num_local_dofs_ = sdm_->GetNumLocalDOFs(UnkManager());
+  if (field_vector.size() != num_local_dofs_)
     throw std::logic_error(fname +
                            ": Constructor initialized with incompatible "
                            "size field vector.");
@@ -97,8 +115,8 @@ FieldFunctionGridBased::FieldFunctionGridBased(const std::string& text_name,
     sdm_(sdm_ptr),
     local_grid_bounding_box_(sdm_->Grid().GetLocalBoundingBox())
 {
-  const size_t num_local_dofs = sdm_->GetNumLocalDOFs(UnkManager());
-  field_vector_.assign(num_local_dofs, field_value);
+  num_local_dofs_ = sdm_->GetNumLocalDOFs(UnkManager());
+  field_vector_.assign(num_local_dofs_, field_value);
 
   vector_ghost_communicator_ = MakeGhostCommunicator();
 }
@@ -5,10 +5,11 @@
 void chi_physics::FieldFunctionGridBased::
   UpdateFieldVector(const std::vector<double> &field_vector)
 {
-  if (field_vector.size() < field_vector_.size())
+  if (field_vector.size() < num_local_dofs_)
     throw std::logic_error("chi_physics::FieldFunction::UpdateFieldVector: "
                            "Attempted update with a vector of insufficient size.");
 
+  ClearFieldVectorView();
   field_vector_ = field_vector;
 }
 
@@ -20,13 +21,73 @@ void chi_physics::FieldFunctionGridBased::
   PetscInt n;
   VecGetLocalSize(field_vector, &n);
 
-  if (n < field_vector_.size())
+  if (n < num_local_dofs_)
     throw std::logic_error("chi_physics::FieldFunction::UpdateFieldVector: "
                            "Attempted update with a vector of insufficient size.");
 
+  ClearFieldVectorView();
+  field_vector_.resize(n, 0.0);
+
   const double* x;
   VecGetArrayRead(field_vector, &x);
   for (size_t i=0; i<n; ++i)
     field_vector_[i] = x[i];
   VecRestoreArrayRead(field_vector, &x);
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Makes the field vector a non-owning strided view over `source`, i.e.,
+ * entry `i` is `source[i*stride + offset]`, instead of a copy. The
+ * source must outlive the view, or the view must be cleared, and
+ * InvalidateFieldVector must be called whenever the source changes. The
+ * values are copied lazily, only when the field vector is read, e.g., for
+ * exports or interpolations. Writes through FieldVector() persist until
+ * the view is next invalidated.*/
+void chi_physics::FieldFunctionGridBased::
+  SetFieldVectorView(const std::vector<double>& source,
+                     const size_t offset, const size_t stride)
+{
+  if (stride == 0 or offset >= stride)
+    throw std::logic_error("chi_physics::FieldFunction::SetFieldVectorView: "
+                           "Invalid offset or stride.");
+
+  view_.source = &source;
+  view_.offset = offset;
+  view_.stride = stride;
+  view_stale_ = true;
+}
+
+//###################################################################
+/**Materializes the field vector from its view, if any, and detaches the
+ * view, making the field vector owning again.*/
+void chi_physics::FieldFunctionGridBased::ClearFieldVectorView()
+{
+  MaterializeFieldVector();
+  view_ = FieldVectorView();
+  view_stale_ = false;
+}
+
+//###################################################################
+/**Allocates the field vector, filled with zeros, if it was not yet, and
+ * copies the values of the view's source if the field vector is stale.*/
+void chi_physics::FieldFunctionGridBased::MaterializeFieldVector() const
+{
+  if (field_vector_.empty() and num_local_dofs_ > 0)
+    field_vector_.assign(num_local_dofs_, 0.0);
+
+  if (not view_stale_) return;
+
+  const auto& source = *view_.source;
+  const size_t num_values = field_vector_.size();
+  if (num_values > 0 and
+      (num_values - 1) * view_.stride + view_.offset >= source.size())
+    throw std::logic_error("chi_physics::FieldFunction::"
+                           "MaterializeFieldVector: The view exceeds the "
+                           "size of its source.");
+
+  const double* src = source.data() + view_.offset;
+  for (size_t i=0; i<num_values; ++i)
+    field_vector_[i] = src[i * view_.stride];
+
+  view_stale_ = false;
+}
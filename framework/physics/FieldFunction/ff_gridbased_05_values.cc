@@ -9,80 +9,76 @@ namespace chi_physics
 {
 
 // ##################################################################
-/**Not necessarily an optimal routine to use when repeatedly querying
- * a field function.*/
+/**Returns the component values at a point. Points are best evaluated in
+ * batches with GetPointValues.*/
 std::vector<double>
 FieldFunctionGridBased::GetPointValue(const chi_mesh::Vector3& point) const
+{
+  return GetPointValues({point}).front();
+}
+
+// ##################################################################
+/**Returns, for each point, the component values at the point. The
+ * containing cells are found with the grid's local cell search index and
+ * all the points are reduced with a single collective call. A point on a
+ * location boundary gets the average of the values of the locations
+ * containing it, and a point outside the domain gets NaN values.*/
+std::vector<std::vector<double>> FieldFunctionGridBased::GetPointValues(
+  const std::vector<chi_mesh::Vector3>& points) const
 {
   typedef const int64_t cint64_t;
   const auto& uk_man = UnkManager();
   const size_t num_components = uk_man.GetTotalUnknownStructureSize();
+  const size_t num_points = points.size();
+  const auto& grid = sdm_->Grid();
+  const auto& field_vector = FieldVectorRead();
 
-  size_t local_num_point_hits = 0;
-  std::vector<double> local_point_value(num_components, 0.0);
-
-  const auto& xyz_min = local_grid_bounding_box_.first;
-  const auto& xyz_max = local_grid_bounding_box_.second;
+  //============================================= Local values, with the
+  //                                              number of hits appended
+  //                                              per point
+  const size_t stride = num_components + 1;
+  std::vector<double> local_values(num_points * stride, 0.0);
 
-  const double xmin = xyz_min.x;
-  const double ymin = xyz_min.y;
-  const double zmin = xyz_min.z;
+  const auto local_ids = grid.FindLocalCellsContainingPoints(points);
+  std::vector<double> shape_values;
+  for (size_t p = 0; p < num_points; ++p)
+  {
+    if (local_ids[p] < 0) continue;
 
-  const double xmax = xyz_max.x;
-  const double ymax = xyz_max.y;
-  const double zmax = xyz_max.z;
+    const auto& cell = grid.local_cells[local_ids[p]];
+    const auto& cell_mapping = sdm_->GetCellMapping(cell);
+    cell_mapping.ShapeValues(points[p], shape_values);
 
-  if (point.x >= xmin and point.x <= xmax and point.y >= ymin and
-      point.y <= ymax and point.z >= zmin and point.z <= zmax)
-  {
-    const auto& grid = sdm_->Grid();
-    for (const auto& cell : grid.local_cells)
-    {
-      if (grid.CheckPointInsideCell(cell, point))
+    double* point_values = &local_values[p * stride];
+    const size_t num_nodes = cell_mapping.NumNodes();
+    for (size_t c = 0; c < num_components; ++c)
+      for (size_t j = 0; j < num_nodes; ++j)
       {
-        const auto& cell_mapping = sdm_->GetCellMapping(cell);
-        std::vector<double> shape_values;
-        cell_mapping.ShapeValues(point, shape_values);
-
-        local_num_point_hits += 1;
-
-        const size_t num_nodes = cell_mapping.NumNodes();
-        for (size_t c = 0; c < num_components; ++c)
-        {
-          for (size_t j = 0; j < num_nodes; ++j)
-          {
-            cint64_t dof_map_j = sdm_->MapDOFLocal(cell, j, uk_man, 0, c);
-            const double dof_value_j = field_vector_[dof_map_j];
-
-            local_point_value[c] += dof_value_j * shape_values[j];
-          } // for node i
-        }   // for component c
-      }     // if inside cell
-    }       // for cell
-  }         // if in bounding box
-
-  //============================================= Communicate number of
-  //                                              point hits
-  size_t globl_num_point_hits;
-  MPI_Allreduce(&local_num_point_hits, // sendbuf
-                &globl_num_point_hits, // recvbuf
-                1,
-                MPIU_SIZE_T,     // count + datatype
-                MPI_SUM,         // operation
-                Chi::mpi.comm); // communicator
-
-  std::vector<double> globl_point_value(num_components, 0.0);
-  MPI_Allreduce(local_point_value.data(), // sendbuf
-                globl_point_value.data(), // recvbuf
-                1,
-                MPI_DOUBLE,      // count + datatype
-                MPI_SUM,         // operation
-                Chi::mpi.comm); // communicator
-
-  chi_math::Scale(globl_point_value,
-                  1.0 / static_cast<double>(globl_num_point_hits));
-
-  return globl_point_value;
+        cint64_t dof_map_j = sdm_->MapDOFLocal(cell, j, uk_man, 0, c);
+        point_values[c] += field_vector[dof_map_j] * shape_values[j];
+      } // for node j
+    point_values[num_components] = 1.0;
+  } // for point p
+
+  //============================================= Reduce all the points
+  //                                              at once
+  std::vector<double> globl_values(num_points * stride, 0.0);
+  MPI_Allreduce(local_values.data(), // sendbuf
+                globl_values.data(), // recvbuf
+                static_cast<int>(globl_values.size()),
+                MPI_DOUBLE,          // count + datatype
+                MPI_SUM,             // operation
+                Chi::mpi.comm);      // communicator
+
+  std::vector<std::vector<double>> point_values(num_points);
+  for (size_t p = 0; p < num_points; ++p)
+  {
+    const double* values = &globl_values[p * stride];
+    point_values[p].assign(values, values + num_components);
+    chi_math::Scale(point_values[p], 1.0 / values[num_components]);
+  }
+
+  return point_values;
 }
 
 // ##################################################################
@@ -102,7 +98,7 @@ double FieldFunctionGridBased::Evaluate(const chi_mesh::Cell& cell,
   {
     cint64_t dof_map = sdm_->MapDOFLocal(cell, j, UnkManager(), 0, component);
 
-    value += field_vector_.at(dof_map) * shape_values[j];
+    value += FieldVectorRead().at(dof_map) * shape_values[j];
   }
 
   return value;
@@ -33,11 +33,26 @@ public:
 
 protected:
   chi_math::SMDPtr sdm_;
-  std::vector<double> field_vector_;
+  mutable std::vector<double> field_vector_;
 
 private:
   const BoundingBox local_grid_bounding_box_;
   VectorGhostCommPtr vector_ghost_communicator_ = nullptr;
+  /**Size of the field vector, which is only allocated when first read for
+   * field functions created without values.*/
+  size_t num_local_dofs_ = 0;
+
+  /**Non-owning strided view over an external vector, with
+   * `field_vector_[i] = (*source)[i*stride + offset]`. The field vector
+   * is only materialized from the source when it is stale and read.*/
+  struct FieldVectorView
+  {
+    const std::vector<double>* source = nullptr;
+    size_t offset = 0;
+    size_t stride = 1;
+  };
+  FieldVectorView view_;
+  mutable bool view_stale_ = false;
 
 public:
   /**Returns required input parameters.*/
@@ -46,11 +61,21 @@ public:
   /**ObjectMaker based constructor.*/
   explicit FieldFunctionGridBased(const chi::InputParameters& params);
 
-  /**Creates a field function, filling it with zeros.*/
+  /**Creates a field function, filling it with zeros. The zeros are only
+   * allocated when the field vector is first read.*/
   FieldFunctionGridBased(const std::string& text_name,
                          chi_math::SMDPtr& sdm_ptr,
                          chi_math::Unknown unknown);
 
+  /**Creates a field function like the above, sharing the
+   * ghost communicator of another field function with the same spatial
+   * discretization and unknown structure. Many field functions can thereby
+   * be created without the collective setup of their ghost communicators.*/
+  FieldFunctionGridBased(const std::string& text_name,
+                         chi_math::SMDPtr& sdm_ptr,
+                         chi_math::Unknown unknown,
+                         VectorGhostCommPtr ghost_communicator);
+
   /**Creates a field function with an associated field vector.
    * The field's data vector is set to the incoming field vector.*/
   FieldFunctionGridBased(const std::string& text_name,
@@ -73,13 +98,40 @@ private:
 public:
   // Getters
   const chi_math::SpatialDiscretization& SDM() const { return *sdm_; }
-  const std::vector<double>& FieldVectorRead() const { return field_vector_; }
-  std::vector<double>& FieldVector() { return field_vector_; }
+  /**Returns the ghost communicator, which can be shared by field functions
+   * with the same spatial discretization and unknown structure.*/
+  const VectorGhostCommPtr& GetGhostCommunicator() const
+  {
+    return vector_ghost_communicator_;
+  }
+  const std::vector<double>& FieldVectorRead() const
+  {
+    MaterializeFieldVector();
+    return field_vector_;
+  }
+  std::vector<double>& FieldVector()
+  {
+    MaterializeFieldVector();
+    return field_vector_;
+  }
 
   // 01 Updates
   void UpdateFieldVector(const std::vector<double>& field_vector);
   void UpdateFieldVector(const Vec& field_vector);
 
+  void SetFieldVectorView(const std::vector<double>& source,
+                          size_t offset, size_t stride);
+  /**Marks the field vector as outdated with respect to its view's source,
+   * which must be called whenever the source changes.*/
+  void InvalidateFieldVector() { view_stale_ = view_.source != nullptr; }
+  void ClearFieldVectorView();
+  bool HasFieldVectorView() const { return view_.source != nullptr; }
+
+private:
+  void MaterializeFieldVector() const;
+
+public:
+
   // 03 Export VTK
   typedef std::vector<std::shared_ptr<const FieldFunctionGridBased>> FFList;
   static void ExportMultipleToVTK(const std::string& file_base_name,
@@ -93,6 +145,10 @@ public:
   /**\brief Returns the component values at requested point.*/
   virtual std::vector<double>
   GetPointValue(const chi_mesh::Vector3& point) const;
+  /**\brief Returns the component values at each of the requested points,
+   * with a single collective reduction.*/
+  std::vector<std::vector<double>>
+  GetPointValues(const std::vector<chi_mesh::Vector3>& points) const;
 
   double Evaluate(const chi_mesh::Cell& cell,
                   const chi_mesh::Vector3& position,
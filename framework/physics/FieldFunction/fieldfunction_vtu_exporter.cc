@@ -0,0 +1,442 @@
+#include "fieldfunction_vtu_exporter.h"
+
+#include "fieldfunction_gridbased.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "math/SpatialDiscretization/spatial_discretization.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace
+{
+//VTK cell type ids
+const uint8_t VTK_LINE_ID       = 3;
+const uint8_t VTK_TRIANGLE_ID   = 5;
+const uint8_t VTK_POLYGON_ID    = 7;
+const uint8_t VTK_QUAD_ID       = 9;
+const uint8_t VTK_TETRA_ID      = 10;
+const uint8_t VTK_HEXAHEDRON_ID = 12;
+const uint8_t VTK_WEDGE_ID      = 13;
+const uint8_t VTK_PYRAMID_ID    = 14;
+const uint8_t VTK_POLYHEDRON_ID = 42;
+
+/**Returns the VTK cell type id of a cell.*/
+uint8_t VTKCellType(const chi_mesh::Cell& cell)
+{
+  using chi_mesh::CellType;
+  switch (cell.SubType())
+  {
+    case CellType::SLAB:          return VTK_LINE_ID;
+    case CellType::TRIANGLE:      return VTK_TRIANGLE_ID;
+    case CellType::QUADRILATERAL: return VTK_QUAD_ID;
+    case CellType::POLYGON:       return VTK_POLYGON_ID;
+    case CellType::TETRAHEDRON:   return VTK_TETRA_ID;
+    case CellType::HEXAHEDRON:    return VTK_HEXAHEDRON_ID;
+    case CellType::WEDGE:         return VTK_WEDGE_ID;
+    case CellType::PYRAMID:       return VTK_PYRAMID_ID;
+    default: break;
+  }
+  return cell.Type() == CellType::POLYGON ? VTK_POLYGON_ID : VTK_POLYHEDRON_ID;
+}
+
+/**Returns the byte order of this machine in VTK's notation.*/
+std::string ByteOrder()
+{
+  const uint16_t probe = 1;
+  return *reinterpret_cast<const uint8_t*>(&probe) == 1 ?
+         "LittleEndian" : "BigEndian";
+}
+
+/**Writes an array as a block of appended raw data, i.e., its byte count
+ * followed by its bytes.*/
+template<typename T>
+void WriteAppendedBlock(std::ofstream& file, const std::vector<T>& values)
+{
+  const uint64_t num_bytes = values.size() * sizeof(T);
+  file.write((const char*)&num_bytes, sizeof(uint64_t));
+  file.write((const char*)values.data(),
+             static_cast<std::streamsize>(num_bytes));
+}
+
+/**Returns the file name without its directory.*/
+std::string FileNameOnly(const std::string& path)
+{
+  const size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+}//namespace
+
+//###################################################################
+/**Creates an exporter writing files starting with `file_base_name`.*/
+chi_physics::FieldFunctionVTUExporter::
+  FieldFunctionVTUExporter(std::string file_base_name) :
+  file_base_name_(std::move(file_base_name))
+{
+}
+
+//###################################################################
+/**Assembles the cached geometry of the local cells.*/
+void chi_physics::FieldFunctionVTUExporter::
+  BuildGeometry(const chi_mesh::MeshContinuum& grid)
+{
+  grid_ = &grid;
+  num_cells_ = grid.local_cells.size();
+  num_points_ = 0;
+  for (const auto& cell : grid.local_cells)
+    num_points_ += cell.vertex_ids_.size();
+
+  points_.clear();        points_.reserve(3 * num_points_);
+  connectivity_.clear();  connectivity_.reserve(num_points_);
+  offsets_.clear();       offsets_.reserve(num_cells_);
+  types_.clear();         types_.reserve(num_cells_);
+  faces_.clear();
+  face_offsets_.clear();
+  materials_.clear();     materials_.reserve(num_cells_);
+  partitions_.clear();    partitions_.reserve(num_cells_);
+
+  bool has_polyhedra = false;
+  std::vector<int64_t> cell_face_offsets;
+  cell_face_offsets.reserve(num_cells_);
+
+  int64_t node_count = 0;
+  for (const auto& cell : grid.local_cells)
+  {
+    const int64_t first_node = node_count;
+    for (uint64_t vid : cell.vertex_ids_)
+    {
+      const auto& vertex = grid.vertices[vid];
+      points_.insert(points_.end(), {vertex.x, vertex.y, vertex.z});
+      connectivity_.push_back(node_count++);
+    }
+    offsets_.push_back(node_count);
+
+    const uint8_t type = VTKCellType(cell);
+    types_.push_back(type);
+
+    //Polyhedra are described by their faces, in terms of the cell's points
+    if (type == VTK_POLYHEDRON_ID)
+    {
+      has_polyhedra = true;
+      faces_.push_back(static_cast<int64_t>(cell.faces_.size()));
+      for (const auto& face : cell.faces_)
+      {
+        faces_.push_back(static_cast<int64_t>(face.vertex_ids_.size()));
+        for (uint64_t fvid : face.vertex_ids_)
+        {
+          size_t v = 0;
+          for (size_t cv=0; cv<cell.vertex_ids_.size(); ++cv)
+            if (cell.vertex_ids_[cv] == fvid) { v = cv; break; }
+          faces_.push_back(first_node + static_cast<int64_t>(v));
+        }
+      }
+      cell_face_offsets.push_back(static_cast<int64_t>(faces_.size()));
+    }
+    else
+      cell_face_offsets.push_back(-1);
+
+    materials_.push_back(cell.material_id_);
+    partitions_.push_back(static_cast<uint32_t>(cell.partition_id_));
+  }//for local cells
+
+  if (has_polyhedra)
+    face_offsets_ = std::move(cell_face_offsets);
+}
+
+//###################################################################
+/**Returns the names of the arrays of each field function component.*/
+std::vector<std::string> chi_physics::FieldFunctionVTUExporter::
+  MakeArrayNames(const FFList& ff_list)
+{
+  std::vector<std::string> names;
+  for (const auto& ff_ptr : ff_list)
+  {
+    const auto& unknown = ff_ptr->Unknown();
+    const size_t num_comps = unknown.NumComponents();
+    for (size_t c=0; c<num_comps; ++c)
+    {
+      std::string component_name = ff_ptr->TextName() + unknown.text_name_;
+      if (num_comps > 1)
+        component_name += unknown.component_text_names_[c];
+      names.push_back(component_name);
+    }
+  }
+  return names;
+}
+
+//###################################################################
+/**Exports the field functions as the next time step of the series.*/
+void chi_physics::FieldFunctionVTUExporter::
+  ExportTimeStep(const double time, const FFList& ff_list)
+{
+  const std::string fname =
+    "chi_physics::FieldFunctionVTUExporter::ExportTimeStep";
+
+  ChiInvalidArgumentIf(ff_list.empty(),
+                       fname + ": Cannot be used with empty field-function "
+                               "list");
+
+  const auto& grid = ff_list.front()->SDM().Grid();
+  for (const auto& ff_ptr : ff_list)
+    ChiInvalidArgumentIf(&ff_ptr->SDM().Grid() != &grid,
+                         fname + ": Cannot be used with field functions "
+                                 "based on different grids.");
+
+  //============================================= Build the geometry once
+  if (grid_ == nullptr) BuildGeometry(grid);
+  ChiLogicalErrorIf(grid_ != &grid or num_cells_ != grid.local_cells.size(),
+                    fname + ": The grid changed between time steps.");
+
+  //============================================= Make file names
+  std::stringstream step_name;
+  step_name << file_base_name_ << "_"
+            << std::setw(6) << std::setfill('0') << time_steps_.size();
+  const std::string step_base_name = step_name.str();
+  const std::string pvtu_file_name = step_base_name + ".pvtu";
+  const std::string piece_file_name =
+    step_base_name + "_" + std::to_string(Chi::mpi.location_id) + ".vtu";
+
+  Chi::log.Log() << "Exporting field functions to VTU time step "
+                 << time_steps_.size() << " (time " << time << ") with "
+                 << "file base \"" << step_base_name << "\"";
+
+  //============================================= Write files
+  WritePiece(piece_file_name, ff_list);
+
+  time_steps_.emplace_back(time, FileNameOnly(pvtu_file_name));
+  if (Chi::mpi.location_id == 0)
+  {
+    WritePVTUFile(pvtu_file_name, FileNameOnly(step_base_name), ff_list);
+    WritePVDFile();
+  }
+
+  Chi::mpi.Barrier();
+}
+
+//###################################################################
+/**Writes the piece of the current location. The field arrays are
+ * computed and streamed one at a time.*/
+void chi_physics::FieldFunctionVTUExporter::
+  WritePiece(const std::string& file_name, const FFList& ff_list) const
+{
+  const auto names = MakeArrayNames(ff_list);
+
+  //============================================= Determine array layout
+  const uint64_t point_array_bytes = num_points_ * sizeof(double);
+  const uint64_t cell_array_bytes  = num_cells_ * sizeof(double);
+
+  std::vector<ArrayInfo> point_arrays, cell_arrays, geometry_arrays;
+  for (const auto& name : names)
+  {
+    point_arrays.push_back({name, "Float64", 1, point_array_bytes});
+    cell_arrays.push_back({name, "Float64", 1, cell_array_bytes});
+  }
+  cell_arrays.push_back({"Material", "Int32", 1,
+                         materials_.size() * sizeof(int32_t)});
+  cell_arrays.push_back({"Partition", "UInt32", 1,
+                         partitions_.size() * sizeof(uint32_t)});
+
+  const ArrayInfo points_array = {"Points", "Float64", 3,
+                                  points_.size() * sizeof(double)};
+  geometry_arrays.push_back({"connectivity", "Int64", 1,
+                             connectivity_.size() * sizeof(int64_t)});
+  geometry_arrays.push_back({"offsets", "Int64", 1,
+                             offsets_.size() * sizeof(int64_t)});
+  geometry_arrays.push_back({"types", "UInt8", 1,
+                             types_.size() * sizeof(uint8_t)});
+  if (not face_offsets_.empty())
+  {
+    geometry_arrays.push_back({"faces", "Int64", 1,
+                               faces_.size() * sizeof(int64_t)});
+    geometry_arrays.push_back({"faceoffsets", "Int64", 1,
+                               face_offsets_.size() * sizeof(int64_t)});
+  }
+
+  //============================================= Write the XML header
+  uint64_t offset = 0;
+  auto DataArrayXML = [&offset](const ArrayInfo& array)
+  {
+    std::stringstream xml;
+    xml << "        <DataArray type=\"" << array.type << "\" Name=\""
+        << array.name << "\"";
+    if (array.num_components > 1)
+      xml << " NumberOfComponents=\"" << array.num_components << "\"";
+    xml << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+    offset += sizeof(uint64_t) + array.num_bytes;
+    return xml.str();
+  };
+
+  std::ofstream file(file_name, std::ofstream::binary |
+                                std::ofstream::out |
+                                std::ofstream::trunc);
+  ChiLogicalErrorIf(not file.is_open(), "Failed to open " + file_name);
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << ByteOrder() << "\" header_type=\"UInt64\">\n"
+       << "  <UnstructuredGrid>\n"
+       << "    <Piece NumberOfPoints=\"" << num_points_
+       << "\" NumberOfCells=\"" << num_cells_ << "\">\n";
+
+  file << "      <PointData>\n";
+  for (const auto& array : point_arrays) file << DataArrayXML(array);
+  file << "      </PointData>\n";
+
+  file << "      <CellData>\n";
+  for (const auto& array : cell_arrays) file << DataArrayXML(array);
+  file << "      </CellData>\n";
+
+  file << "      <Points>\n" << DataArrayXML(points_array)
+       << "      </Points>\n";
+
+  file << "      <Cells>\n";
+  for (const auto& array : geometry_arrays) file << DataArrayXML(array);
+  file << "      </Cells>\n";
+
+  file << "    </Piece>\n"
+       << "  </UnstructuredGrid>\n"
+       << "  <AppendedData encoding=\"raw\">\n   _";
+
+  //============================================= Stream the field arrays
+  //Point arrays are written for all the fields first, then the cell
+  //arrays, following the order of the header.
+  const auto& grid = *grid_;
+  std::vector<std::vector<double>> cell_averages;
+  std::vector<double> point_values;
+  for (const auto& ff_ptr : ff_list)
+  {
+    const auto field_vector = ff_ptr->GetGhostedFieldVector();
+
+    const auto& uk_man = ff_ptr->UnkManager();
+    const auto& sdm = ff_ptr->SDM();
+    const size_t num_comps = ff_ptr->Unknown().NumComponents();
+
+    for (unsigned int c=0; c<num_comps; ++c)
+    {
+      point_values.clear();
+      point_values.reserve(num_points_);
+      cell_averages.emplace_back();
+      auto& cell_values = cell_averages.back();
+      cell_values.reserve(num_cells_);
+
+      for (const auto& cell : grid.local_cells)
+      {
+        const size_t num_nodes = sdm.GetCellNumNodes(cell);
+
+        double node_average = 0.0;
+        for (size_t n=0; n<num_nodes; ++n)
+          node_average += field_vector[sdm.MapDOFLocal(cell,n,uk_man,0,c)];
+        node_average /= static_cast<double>(num_nodes);
+
+        if (num_nodes == cell.vertex_ids_.size())
+          for (size_t n=0; n<num_nodes; ++n)
+            point_values.push_back(
+              field_vector[sdm.MapDOFLocal(cell,n,uk_man,0,c)]);
+        else
+          point_values.insert(point_values.end(),
+                              cell.vertex_ids_.size(), node_average);
+
+        cell_values.push_back(node_average);
+      }//for cell
+
+      WriteAppendedBlock(file, point_values);
+    }//for component
+  }//for ff_ptr
+
+  for (const auto& cell_values : cell_averages)
+    WriteAppendedBlock(file, cell_values);
+  WriteAppendedBlock(file, materials_);
+  WriteAppendedBlock(file, partitions_);
+
+  //============================================= Write the cached geometry
+  WriteAppendedBlock(file, points_);
+  WriteAppendedBlock(file, connectivity_);
+  WriteAppendedBlock(file, offsets_);
+  WriteAppendedBlock(file, types_);
+  if (not face_offsets_.empty())
+  {
+    WriteAppendedBlock(file, faces_);
+    WriteAppendedBlock(file, face_offsets_);
+  }
+
+  file << "\n  </AppendedData>\n"
+       << "</VTKFile>\n";
+
+  ChiLogicalErrorIf(not file.good(), "Failed to write " + file_name);
+  file.close();
+}
+
+//###################################################################
+/**Writes the parallel file referencing the pieces of all locations.*/
+void chi_physics::FieldFunctionVTUExporter::
+  WritePVTUFile(const std::string& file_name,
+                const std::string& piece_base_name,
+                const FFList& ff_list) const
+{
+  const auto names = MakeArrayNames(ff_list);
+
+  std::ofstream file(file_name, std::ofstream::out | std::ofstream::trunc);
+  ChiLogicalErrorIf(not file.is_open(), "Failed to open " + file_name);
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\""
+       << ByteOrder() << "\" header_type=\"UInt64\">\n"
+       << "  <PUnstructuredGrid GhostLevel=\"0\">\n";
+
+  file << "    <PPointData>\n";
+  for (const auto& name : names)
+    file << "      <PDataArray type=\"Float64\" Name=\"" << name << "\"/>\n";
+  file << "    </PPointData>\n";
+
+  file << "    <PCellData>\n";
+  for (const auto& name : names)
+    file << "      <PDataArray type=\"Float64\" Name=\"" << name << "\"/>\n";
+  file << "      <PDataArray type=\"Int32\" Name=\"Material\"/>\n"
+       << "      <PDataArray type=\"UInt32\" Name=\"Partition\"/>\n"
+       << "    </PCellData>\n";
+
+  file << "    <PPoints>\n"
+       << "      <PDataArray type=\"Float64\" Name=\"Points\" "
+          "NumberOfComponents=\"3\"/>\n"
+       << "    </PPoints>\n";
+
+  for (int p=0; p<Chi::mpi.process_count; ++p)
+    file << "    <Piece Source=\"" << piece_base_name << "_" << p
+         << ".vtu\"/>\n";
+
+  file << "  </PUnstructuredGrid>\n"
+       << "</VTKFile>\n";
+
+  ChiLogicalErrorIf(not file.good(), "Failed to write " + file_name);
+  file.close();
+}
+
+//###################################################################
+/**Writes the collection file indexing all exported time steps.*/
+void chi_physics::FieldFunctionVTUExporter::WritePVDFile() const
+{
+  const std::string file_name = file_base_name_ + ".pvd";
+
+  std::ofstream file(file_name, std::ofstream::out | std::ofstream::trunc);
+  ChiLogicalErrorIf(not file.is_open(), "Failed to open " + file_name);
+
+  file << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\""
+       << ByteOrder() << "\">\n"
+       << "  <Collection>\n";
+  file << std::setprecision(16);
+  for (const auto& [time, pvtu_file_name] : time_steps_)
+    file << "    <DataSet timestep=\"" << time << "\" group=\"\" part=\"0\" "
+         << "file=\"" << pvtu_file_name << "\"/>\n";
+  file << "  </Collection>\n"
+       << "</VTKFile>\n";
+
+  ChiLogicalErrorIf(not file.good(), "Failed to write " + file_name);
+  file.close();
+}
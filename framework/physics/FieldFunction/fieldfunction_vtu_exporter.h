@@ -0,0 +1,90 @@
+#ifndef CHITECH_FIELDFUNCTION_VTU_EXPORTER_H
+#define CHITECH_FIELDFUNCTION_VTU_EXPORTER_H
+
+#include "ChiObject.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+namespace chi_mesh
+{
+class MeshContinuum;
+}
+
+namespace chi_physics
+{
+class FieldFunctionGridBased;
+
+// ################################################################### Class def
+/**Exports time series of grid-based field functions to VTK XML files
+ * without going through VTK.
+ *
+ * The geometry of the local cells is assembled once, on the first
+ * exported time step, and cached in the form it is written. Each time
+ * step then only evaluates the field arrays, which are streamed directly
+ * to the files. Every time step produces one `.vtu` piece per location,
+ * with the data appended in raw binary, and a `.pvtu` file, and the
+ * `.pvd` collection indexing all the time steps is rewritten.
+ *
+ * As for FieldFunctionGridBased::ExportMultipleToVTK, the points are
+ * discontinuous, i.e., each cell has its own copy of its vertices.*/
+class FieldFunctionVTUExporter : public ChiObject
+{
+public:
+  typedef std::vector<std::shared_ptr<const FieldFunctionGridBased>> FFList;
+
+private:
+  /**An array with its name and VTK type name.*/
+  struct ArrayInfo
+  {
+    std::string name;
+    std::string type;
+    size_t num_components = 1;
+    uint64_t num_bytes = 0;
+  };
+
+  const std::string file_base_name_;
+  const chi_mesh::MeshContinuum* grid_ = nullptr;
+
+  //Cached geometry
+  uint64_t num_points_ = 0;
+  uint64_t num_cells_ = 0;
+  std::vector<double> points_;
+  std::vector<int64_t> connectivity_;
+  std::vector<int64_t> offsets_;
+  std::vector<uint8_t> types_;
+  std::vector<int64_t> faces_;
+  std::vector<int64_t> face_offsets_;
+  std::vector<int32_t> materials_;
+  std::vector<uint32_t> partitions_;
+
+  std::vector<std::pair<double, std::string>> time_steps_;
+
+public:
+  /**Creates an exporter writing files starting with `file_base_name`.*/
+  explicit FieldFunctionVTUExporter(std::string file_base_name);
+
+  /**Exports the field functions (all on the same grid) as the next time
+   * step of the series. This is a collective call.*/
+  void ExportTimeStep(double time, const FFList& ff_list);
+
+  /**Returns the number of exported time steps.*/
+  size_t NumTimeSteps() const { return time_steps_.size(); }
+
+private:
+  void BuildGeometry(const chi_mesh::MeshContinuum& grid);
+  void WritePiece(const std::string& file_name, const FFList& ff_list) const;
+  void WritePVTUFile(const std::string& file_name,
+                     const std::string& piece_base_name,
+                     const FFList& ff_list) const;
+  void WritePVDFile() const;
+
+  static std::vector<std::string> MakeArrayNames(const FFList& ff_list);
+};
+
+} // namespace chi_physics
+
+#endif // CHITECH_FIELDFUNCTION_VTU_EXPORTER_H
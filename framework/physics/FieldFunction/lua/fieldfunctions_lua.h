@@ -6,6 +6,9 @@
 int chiGetFieldFunctionHandleByName(lua_State *L);
 int chiExportFieldFunctionToVTK(lua_State *L);
 int chiExportMultiFieldFunctionToVTK(lua_State *L);
+int chiCreateFieldFunctionVTUExporter(lua_State *L);
+int chiExportFieldFunctionsToVTUTimeStep(lua_State *L);
+int chiFieldFunctionGetPointValues(lua_State *L);
 
 
 #endif //CHITECH_FIELDFUNCTIONS_LUA_H
@@ -1,6 +1,7 @@
 #include "chi_lua.h"
 
 #include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "physics/FieldFunction/fieldfunction_vtu_exporter.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -9,6 +10,8 @@
 
 RegisterLuaFunctionAsIs(chiExportFieldFunctionToVTK);
 RegisterLuaFunctionAsIs(chiExportMultiFieldFunctionToVTK);
+RegisterLuaFunctionAsIs(chiCreateFieldFunctionVTUExporter);
+RegisterLuaFunctionAsIs(chiExportFieldFunctionsToVTUTimeStep);
 
 // #############################################################################
 /** Exports a field function to VTK format.
@@ -86,3 +89,91 @@ int chiExportMultiFieldFunctionToVTK(lua_State* L)
 
   return 0;
 }
+
+// #############################################################################
+/** Creates an exporter of time series of field functions to VTU files. The
+ * geometry is assembled once, on the first time step, and every time step
+ * only writes the field arrays, as appended raw binary data, and one file
+ * per location. A `.pvd` collection indexes all the time steps.
+ *
+\param BaseName char Base name for the exported files. Time step `k` is
+                     written to `BaseName_k.pvtu`, with the pieces in
+                     `BaseName_k_<location>.vtu`, and the collection to
+                     `BaseName.pvd`.
+
+\return Handle int Handle to the exporter.
+
+\ingroup LuaFieldFunc*/
+int chiCreateFieldFunctionVTUExporter(lua_State* L)
+{
+  const std::string fname = "chiCreateFieldFunctionVTUExporter";
+  const int num_args = lua_gettop(L);
+  if (num_args != 1) LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckStringValue(fname, L, 1);
+  const std::string base_name = lua_tostring(L, 1);
+
+  auto exporter =
+    std::make_shared<chi_physics::FieldFunctionVTUExporter>(base_name);
+
+  Chi::object_stack.push_back(exporter);
+
+  lua_pushinteger(L, static_cast<lua_Integer>(Chi::object_stack.size() - 1));
+  return 1;
+}
+
+// #############################################################################
+/** Exports the field functions in a list as the next time step of a VTU
+ * exporter created with chiCreateFieldFunctionVTUExporter. All the field
+ * functions must be on the same grid, which may not change between time
+ * steps.
+ *
+\param ExporterHandle int Handle to the exporter.
+\param listFFHandles table Global handles to the field functions.
+\param Time double The time of the time step.
+
+\ingroup LuaFieldFunc*/
+int chiExportFieldFunctionsToVTUTimeStep(lua_State* L)
+{
+  const std::string fname = "chiExportFieldFunctionsToVTUTimeStep";
+  const int num_args = lua_gettop(L);
+  if (num_args != 3) LuaPostArgAmountError(fname, 3, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+  LuaCheckNumberValue(fname, L, 3);
+
+  const size_t exporter_handle = lua_tointeger(L, 1);
+  const double time = lua_tonumber(L, 3);
+
+  auto& exporter =
+    Chi::GetStackItem<chi_physics::FieldFunctionVTUExporter>(
+      Chi::object_stack, exporter_handle, fname);
+
+  const size_t table_size = lua_rawlen(L, 2);
+  chi_physics::FieldFunctionVTUExporter::FFList ffs;
+  ffs.reserve(table_size);
+  for (int i = 0; i < table_size; ++i)
+  {
+    lua_pushnumber(L, i + 1);
+    lua_gettable(L, 2);
+
+    int ff_handle = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+
+    auto ff_base =
+      Chi::GetStackItemPtr(Chi::field_function_stack, ff_handle, fname);
+
+    typedef chi_physics::FieldFunctionGridBased FFGridBased;
+    auto ff = std::dynamic_pointer_cast<FFGridBased>(ff_base);
+
+    ChiLogicalErrorIf(not ff,
+                      "Only grid-based field functions can be exported");
+
+    ffs.push_back(ff);
+  }
+
+  exporter.ExportTimeStep(time, ffs);
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include "chi_lua.h"
+
+#include "chi_runtime.h"
+
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "mesh/chi_meshvector.h"
+
+#include "fieldfunctions_lua.h"
+#include "console/chi_console.h"
+
+RegisterLuaFunctionAsIs(chiFieldFunctionGetPointValues);
+
+//###################################################################
+/**Probes a grid-based field function at a cloud of points. The cells
+ * containing the points are found with a search index over the local
+ * cells, and all the points are reduced with a single collective call,
+ * hence probing many points in one call is much cheaper than a point
+ * interpolation per point. This is a collective call.
+
+\param FFHandle int Global handle to the field function.
+\param Points table A table of points, each a table `{x, y, z}`.
+
+\return Values table A table, per point, of the table of component values.
+                     Points outside the domain get NaN values.
+
+\ingroup LuaFieldFunc
+ */
+int chiFieldFunctionGetPointValues(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2) LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+
+  auto ff_base = Chi::GetStackItemPtr(Chi::field_function_stack,
+                                      lua_tointeger(L, 1), fname);
+  auto ff =
+    std::dynamic_pointer_cast<chi_physics::FieldFunctionGridBased>(ff_base);
+  ChiLogicalErrorIf(not ff, fname + ": Only grid-based field functions can "
+                                    "be probed.");
+
+  //============================================= Read the points
+  const size_t num_points = lua_rawlen(L, 2);
+  std::vector<chi_mesh::Vector3> points(num_points);
+  for (size_t p = 0; p < num_points; ++p)
+  {
+    lua_rawgeti(L, 2, static_cast<lua_Integer>(p + 1));
+    ChiInvalidArgumentIf(not lua_istable(L, -1) or lua_rawlen(L, -1) != 3,
+                         fname + ": Point " + std::to_string(p + 1) +
+                         " must be a table {x, y, z}.");
+    for (int d = 0; d < 3; ++d)
+    {
+      lua_rawgeti(L, -1, d + 1);
+      points[p](d) = lua_tonumber(L, -1);
+      lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+  }
+
+  const auto point_values = ff->GetPointValues(points);
+
+  //============================================= Push the values
+  lua_createtable(L, static_cast<int>(num_points), 0);
+  for (size_t p = 0; p < num_points; ++p)
+  {
+    const auto& values = point_values[p];
+    lua_createtable(L, static_cast<int>(values.size()), 0);
+    for (size_t c = 0; c < values.size(); ++c)
+    {
+      lua_pushnumber(L, values[c]);
+      lua_rawseti(L, -2, static_cast<lua_Integer>(c + 1));
+    }
+    lua_rawseti(L, -2, static_cast<lua_Integer>(p + 1));
+  }
+
+  return 1;
+}
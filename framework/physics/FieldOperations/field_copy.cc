@@ -4,6 +4,9 @@
 #include "math/SpatialDiscretization/spatial_discretization.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
 namespace chi_physics::field_operations
 {
 
@@ -74,8 +77,8 @@ FieldCopyOperation::FieldCopyOperation(
 
     from_ff_ = std::dynamic_pointer_cast<FieldFunctionGridBased>(from_base_ptr);
 
-    ChiLogicalErrorIf(not to_ff_,
-                      "\"to\" field function must be based on "
+    ChiLogicalErrorIf(not from_ff_,
+                      "\"from\" field function must be based on "
                       "FieldFunctionGridBased");
   }
 
@@ -123,45 +126,56 @@ FieldCopyOperation::FieldCopyOperation(
       from_components_.push_back(c);
     }
   }
-
-  //============================================= Check grids are compatible
-  ChiInvalidArgumentIf(std::addressof(to_ff_->SDM().Grid()) !=
-                         std::addressof(from_ff_->SDM().Grid()),
-                       "Currently the two field functions must operate on the "
-                       "same grid");
 }
 
+// ##################################################################
+/**Copies the field values through the interpolation operator, which is
+ * built on the first call. When the grids differ this is a collective
+ * call, with a single all-to-all exchange.*/
 void FieldCopyOperation::Execute()
 {
-  typedef const int64_t cint64_t;
-  const auto& sdm = to_ff_->SDM();
-  const auto& uk_man = to_ff_->UnkManager();
-  const auto& grid = sdm.Grid();
-
-  const size_t num_comps = to_components_.size();
-
-  for (const auto& cell : grid.local_cells)
+  if (not interpolation_built_)
   {
-    const auto& cell_mapping = sdm.GetCellMapping(cell);
-    const size_t num_nodes = cell_mapping.NumNodes();
-
-    const auto nodes_xyz = cell_mapping.GetNodeLocations();
+    BuildInterpolationOperator();
+    interpolation_built_ = true;
+  }
 
-    for (size_t i = 0; i < num_nodes; ++i)
-    {
-      for (size_t c = 0; c < num_comps; ++c)
-      {
-        const size_t cto = to_components_[c];
-        const size_t cfrom = from_components_[c];
+  auto& op = interpolation_;
+  const auto& from_vector = from_ff_->FieldVectorRead();
 
-        const double value = from_ff_->Evaluate(cell, nodes_xyz[i], cfrom);
+  //============================================= Apply the operator
+  const size_t num_rows = op.row_begin.size() - 1;
+  op.send_values.assign(num_rows, 0.0);
+  for (size_t r = 0; r < num_rows; ++r)
+  {
+    double value = 0.0;
+    for (size_t k = op.row_begin[r]; k < op.row_begin[r + 1]; ++k)
+      value += op.weights[k] * from_vector[op.from_dofs[k]];
+    op.send_values[r] = value;
+  }
 
-        cint64_t dof_map = sdm.MapDOFLocal(cell, i, uk_man, 0, cto);
+  //============================================= Send values to the
+  //                                              locations owning the nodes
+  const std::vector<double>* values = &op.send_values;
+  if (not op.same_grid)
+  {
+    op.recv_values.assign(op.to_dofs.size(), 0.0);
+    MPI_Alltoallv(op.send_values.data(),
+                  op.send_counts.data(),
+                  op.send_displs.data(),
+                  MPI_DOUBLE,
+                  op.recv_values.data(),
+                  op.recv_counts.data(),
+                  op.recv_displs.data(),
+                  MPI_DOUBLE,
+                  Chi::mpi.comm);
+    values = &op.recv_values;
+  }
 
-        to_ff_->FieldVector()[dof_map] = value;
-      } // for component c
-    }   // for node i
-  }     // for cell
+  auto& to_vector = to_ff_->FieldVector();
+  const size_t num_values = op.to_dofs.size();
+  for (size_t k = 0; k < num_values; ++k)
+    to_vector[op.to_dofs[k]] = (*values)[k];
 }
 
-} // namespace chi_physics::field_operations
\ No newline at end of file
+} // namespace chi_physics::field_operations
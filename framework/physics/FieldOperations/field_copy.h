@@ -8,7 +8,8 @@ namespace chi_physics::field_operations
 {
 
 /**Field operaiton that copies components of one field to the
-* components of another.*/
+* components of another. The fields may be on different grids, in which
+* case the "from" field is interpolated at the nodes of the "to" field.*/
 class FieldCopyOperation : public FieldOperation
 {
 private:
@@ -21,12 +22,40 @@ private:
   std::shared_ptr<FieldFunctionGridBased> to_ff_;
   std::shared_ptr<const FieldFunctionGridBased> from_ff_;
 
+  /**Sparse operator evaluating the "from" field at the nodes of the "to"
+   * field, built on the first execution. Each CSR row is the value of one
+   * component at one node, for this or, when the grids differ, another
+   * location. Rows are sent, ordered by location, to the locations owning
+   * the nodes, which write them to the listed "to" dofs.*/
+  struct InterpolationOperator
+  {
+    bool same_grid = true;
+
+    std::vector<size_t> row_begin;
+    std::vector<int64_t> from_dofs;
+    std::vector<double> weights;
+
+    std::vector<int> send_counts;
+    std::vector<int> send_displs;
+    std::vector<int> recv_counts;
+    std::vector<int> recv_displs;
+    std::vector<int64_t> to_dofs;
+
+    std::vector<double> send_values;
+    std::vector<double> recv_values;
+  };
+  InterpolationOperator interpolation_;
+  bool interpolation_built_ = false;
+
 public:
   static chi::InputParameters GetInputParameters();
 
   explicit FieldCopyOperation(const chi::InputParameters& params);
 
   void Execute() override;
+
+private:
+  void BuildInterpolationOperator();
 };
 
 }
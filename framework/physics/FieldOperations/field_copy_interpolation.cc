@@ -0,0 +1,197 @@
+#include "field_copy.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mpi/chi_mpi_utils_map_all2all.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+
+namespace chi_physics::field_operations
+{
+
+// ##################################################################
+/**Builds the interpolation operator. On the same grid each node is
+ * evaluated in its own cell. Otherwise the nodes are sent to the
+ * locations whose "from" bounding boxes contain them, which locate them
+ * in their local cells, and the lowest location finding a node evaluates
+ * it. Nodes outside the "from" grid keep their values. This is a
+ * collective call when the grids differ.*/
+void FieldCopyOperation::BuildInterpolationOperator()
+{
+  typedef chi_mesh::Vector3 Vec3;
+  const auto& to_sdm = to_ff_->SDM();
+  const auto& from_sdm = from_ff_->SDM();
+  const auto& to_uk_man = to_ff_->UnkManager();
+  const auto& from_uk_man = from_ff_->UnkManager();
+  const auto& to_grid = to_sdm.Grid();
+  const auto& from_grid = from_sdm.Grid();
+  const size_t num_comps = to_components_.size();
+
+  auto& op = interpolation_;
+  op = InterpolationOperator();
+  op.same_grid = std::addressof(to_grid) == std::addressof(from_grid);
+  op.row_begin = {0};
+
+  // Appends the rows, one per component, of a point in a local cell of
+  // the "from" grid
+  std::vector<double> shape_values;
+  auto AppendRows = [&](const chi_mesh::Cell& cell, const Vec3& point)
+  {
+    const auto& cell_mapping = from_sdm.GetCellMapping(cell);
+    cell_mapping.ShapeValues(point, shape_values);
+    const size_t num_nodes = cell_mapping.NumNodes();
+    for (size_t c = 0; c < num_comps; ++c)
+    {
+      for (size_t j = 0; j < num_nodes; ++j)
+      {
+        op.from_dofs.push_back(
+          from_sdm.MapDOFLocal(cell, j, from_uk_man, 0, from_components_[c]));
+        op.weights.push_back(shape_values[j]);
+      }
+      op.row_begin.push_back(op.from_dofs.size());
+    }
+  };
+
+  //============================================= Nodes of the "to" field
+  std::vector<Vec3> points;
+  std::vector<int64_t> point_to_dofs;
+  for (const auto& cell : to_grid.local_cells)
+  {
+    const auto& cell_mapping = to_sdm.GetCellMapping(cell);
+    const auto nodes_xyz = cell_mapping.GetNodeLocations();
+    for (size_t i = 0; i < nodes_xyz.size(); ++i)
+    {
+      auto& dofs = op.same_grid ? op.to_dofs : point_to_dofs;
+      for (size_t c = 0; c < num_comps; ++c)
+        dofs.push_back(
+          to_sdm.MapDOFLocal(cell, i, to_uk_man, 0, to_components_[c]));
+
+      if (op.same_grid)
+        AppendRows(cell, nodes_xyz[i]);
+      else
+        points.push_back(nodes_xyz[i]);
+    }
+  }
+
+  if (op.same_grid) return;
+
+  //============================================= Bounding boxes of the
+  //                                              "from" locations
+  const int num_locations = Chi::mpi.process_count;
+  constexpr size_t BOX_SIZE = 7;
+  std::vector<double> boxes(BOX_SIZE * num_locations, 0.0);
+  {
+    const auto [xyz_min, xyz_max] = from_grid.GetLocalBoundingBox();
+    const double tolerance = 1.0e-8 * (xyz_max - xyz_min).Norm();
+    const std::vector<double> box = {
+      xyz_min.x - tolerance, xyz_min.y - tolerance, xyz_min.z - tolerance,
+      xyz_max.x + tolerance, xyz_max.y + tolerance, xyz_max.z + tolerance,
+      from_grid.local_cells.size() > 0 ? 1.0 : 0.0};
+    MPI_Allgather(box.data(), BOX_SIZE, MPI_DOUBLE,
+                  boxes.data(), BOX_SIZE, MPI_DOUBLE, Chi::mpi.comm);
+  }
+
+  auto BoxContains = [&boxes](int location, const Vec3& point)
+  {
+    const double* box = &boxes[BOX_SIZE * location];
+    return box[6] > 0.0 and
+           point.x >= box[0] and point.y >= box[1] and point.z >= box[2] and
+           point.x <= box[3] and point.y <= box[4] and point.z <= box[5];
+  };
+
+  //============================================= Send the nodes to the
+  //                                              candidate locations
+  std::map<int, std::vector<double>> pid_points;
+  std::map<int, std::vector<size_t>> pid_point_ids;
+  for (size_t p = 0; p < points.size(); ++p)
+    for (int pid = 0; pid < num_locations; ++pid)
+      if (BoxContains(pid, points[p]))
+      {
+        auto& xyz = pid_points[pid];
+        xyz.insert(xyz.end(), {points[p].x, points[p].y, points[p].z});
+        pid_point_ids[pid].push_back(p);
+      }
+
+  const auto recv_points = chi_mpi_utils::MapAllToAll(pid_points, MPI_DOUBLE);
+
+  //============================================= Locate the received nodes
+  std::map<int, std::vector<Vec3>> pid_requests;
+  std::map<int, std::vector<int64_t>> pid_request_cells;
+  std::map<int, std::vector<int>> pid_found;
+  for (const auto& [pid, xyz] : recv_points)
+  {
+    auto& requests = pid_requests[pid];
+    for (size_t k = 0; k + 2 < xyz.size(); k += 3)
+      requests.emplace_back(xyz[k], xyz[k + 1], xyz[k + 2]);
+
+    auto& cells = pid_request_cells[pid];
+    cells = from_grid.FindLocalCellsContainingPoints(requests);
+
+    auto& found = pid_found[pid];
+    for (const int64_t local_id : cells)
+      found.push_back(local_id >= 0 ? 1 : 0);
+  }
+
+  const auto found_replies = chi_mpi_utils::MapAllToAll(pid_found, MPI_INT);
+
+  //============================================= The lowest location finding
+  //                                              a node evaluates it
+  std::vector<int> point_owners(points.size(), -1);
+  for (const auto& [pid, found] : found_replies)
+  {
+    const auto& point_ids = pid_point_ids.at(pid);
+    for (size_t k = 0; k < found.size(); ++k)
+      if (found[k] and point_owners[point_ids[k]] < 0)
+        point_owners[point_ids[k]] = pid;
+  }
+
+  op.recv_counts.assign(num_locations, 0);
+  op.recv_displs.assign(num_locations, 0);
+  std::map<int, std::vector<int>> pid_kept;
+  for (const auto& [pid, point_ids] : pid_point_ids)
+  {
+    op.recv_displs[pid] = static_cast<int>(op.to_dofs.size());
+    auto& kept = pid_kept[pid];
+    for (size_t k = 0; k < point_ids.size(); ++k)
+    {
+      const size_t p = point_ids[k];
+      if (point_owners[p] != pid) continue;
+      kept.push_back(static_cast<int>(k));
+      for (size_t c = 0; c < num_comps; ++c)
+        op.to_dofs.push_back(point_to_dofs[p * num_comps + c]);
+    }
+    op.recv_counts[pid] = static_cast<int>(kept.size() * num_comps);
+  }
+
+  const size_t local_num_outside = static_cast<size_t>(
+    std::count(point_owners.begin(), point_owners.end(), -1));
+  size_t num_outside = 0;
+  MPI_Allreduce(&local_num_outside, &num_outside, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_SUM, Chi::mpi.comm);
+  if (num_outside > 0)
+    Chi::log.Log0Warning()
+      << "FieldCopyOperation: " << num_outside << " nodes of field function "
+      << "\"" << to_ff_->TextName() << "\" are outside the grid of "
+      << "\"" << from_ff_->TextName() << "\" and keep their values.";
+
+  const auto kept_requests = chi_mpi_utils::MapAllToAll(pid_kept, MPI_INT);
+
+  //============================================= Rows of the kept requests
+  op.send_counts.assign(num_locations, 0);
+  op.send_displs.assign(num_locations, 0);
+  for (const auto& [pid, kept] : kept_requests)
+  {
+    op.send_displs[pid] = static_cast<int>(op.row_begin.size() - 1);
+    const auto& requests = pid_requests.at(pid);
+    const auto& cells = pid_request_cells.at(pid);
+    for (const int k : kept)
+      AppendRows(from_grid.local_cells[cells[k]], requests[k]);
+    op.send_counts[pid] = static_cast<int>(kept.size() * num_comps);
+  }
+}
+
+} // namespace chi_physics::field_operations
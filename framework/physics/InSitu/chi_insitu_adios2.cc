@@ -0,0 +1,119 @@
+#include "chi_insitu_output.h"
+
+#ifdef CHITECH_HAVE_ADIOS2
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <adios2.h>
+
+//###################################################################
+/**The ADIOS2 objects, kept out of the header.*/
+struct chi_physics::ADIOS2InSituSink::Implementation
+{
+  adios2::ADIOS adios;
+  adios2::IO io;
+  adios2::Engine engine;
+
+  bool cell_ids_put = false;
+
+  Implementation() : adios(Chi::mpi.comm) {}
+
+  /**Defines, or updates the decomposition of, a global array and puts the
+   * local block of this location.*/
+  template<typename T>
+  void PutGlobalArray(const std::string& name, const std::vector<T>& values)
+  {
+    const uint64_t local_count = values.size();
+    uint64_t offset = 0;
+    uint64_t global_count = 0;
+    MPI_Exscan(&local_count, &offset, 1, MPI_UINT64_T, MPI_SUM,
+               Chi::mpi.comm);
+    if (Chi::mpi.location_id == 0) offset = 0;
+    MPI_Allreduce(&local_count, &global_count, 1, MPI_UINT64_T, MPI_SUM,
+                  Chi::mpi.comm);
+
+    auto variable = io.InquireVariable<T>(name);
+    if (not variable)
+      variable = io.DefineVariable<T>(name, {global_count},
+                                      {offset}, {local_count});
+    else
+    {
+      variable.SetShape({global_count});
+      variable.SetSelection({{offset}, {local_count}});
+    }
+
+    engine.Put(variable, values.data(), adios2::Mode::Sync);
+  }
+
+  /**Defines a single value variable, put by location 0.*/
+  template<typename T>
+  void PutSingleValue(const std::string& name, const T value)
+  {
+    auto variable = io.InquireVariable<T>(name);
+    if (not variable) variable = io.DefineVariable<T>(name);
+
+    if (Chi::mpi.location_id == 0)
+      engine.Put(variable, value, adios2::Mode::Sync);
+  }
+};
+
+//###################################################################
+/**Opens the stream with the given engine type, e.g., "SST" or "BP5".*/
+chi_physics::ADIOS2InSituSink::
+  ADIOS2InSituSink(const std::string& stream_name,
+                   const std::string& engine_type) :
+  impl_(std::make_unique<Implementation>())
+{
+  impl_->io = impl_->adios.DeclareIO("ChiTechInSitu");
+  impl_->io.SetEngine(engine_type);
+  impl_->engine = impl_->io.Open(stream_name, adios2::Mode::Write);
+
+  Chi::log.Log() << "Opened ADIOS2 " << engine_type
+                 << " in-situ stream \"" << stream_name << "\"";
+}
+
+//###################################################################
+/**Closes the stream.*/
+chi_physics::ADIOS2InSituSink::~ADIOS2InSituSink()
+{
+  if (impl_->engine) impl_->engine.Close();
+}
+
+void chi_physics::ADIOS2InSituSink::BeginStep(const size_t step,
+                                              const double time)
+{
+  impl_->engine.BeginStep();
+  impl_->cell_ids_put = false;
+
+  impl_->PutSingleValue<uint64_t>("step", step);
+  impl_->PutSingleValue<double>("time", time);
+}
+
+void chi_physics::ADIOS2InSituSink::
+  PutCellField(const std::string& name,
+               const std::vector<uint64_t>& cell_global_ids,
+               const std::vector<double>& values)
+{
+  if (not impl_->cell_ids_put)
+  {
+    impl_->PutGlobalArray("cell_global_ids", cell_global_ids);
+    impl_->cell_ids_put = true;
+  }
+
+  impl_->PutGlobalArray(name, values);
+}
+
+void chi_physics::ADIOS2InSituSink::PutScalar(const std::string& name,
+                                              const double value)
+{
+  impl_->PutSingleValue(name, value);
+}
+
+void chi_physics::ADIOS2InSituSink::EndStep()
+{
+  impl_->engine.EndStep();
+}
+
+#endif //CHITECH_HAVE_ADIOS2
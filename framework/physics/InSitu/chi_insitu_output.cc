@@ -0,0 +1,166 @@
+#include "chi_insitu_output.h"
+
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "mesh/FieldFunctionInterpolation/Volume/chi_ffinter_volume.h"
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "console/chi_console.h"
+
+//###################################################################
+/**Creates an in-situ output streaming to the given sink on every
+ * `cadence`-th call to Execute.*/
+chi_physics::InSituOutput::InSituOutput(std::unique_ptr<InSituSink> sink,
+                                        const size_t cadence) :
+  sink_(std::move(sink)),
+  cadence_(cadence)
+{
+  ChiInvalidArgumentIf(not sink_, "The in-situ sink must not be null.");
+  ChiInvalidArgumentIf(cadence_ == 0, "The cadence must be at least 1.");
+}
+
+//###################################################################
+/**Adds a field function of which every component is streamed.*/
+void chi_physics::InSituOutput::AddFieldFunction(FFPtr field_function)
+{
+  ChiInvalidArgumentIf(not field_function, "Null field function.");
+  ChiInvalidArgumentIf(not field_functions_.empty() and
+                       &field_functions_.front()->SDM().Grid() !=
+                       &field_function->SDM().Grid(),
+                       "All field functions of an in-situ output must be "
+                       "on the same grid.");
+
+  field_functions_.push_back(std::move(field_function));
+}
+
+//###################################################################
+/**Adds a tally streamed as a scalar.*/
+void chi_physics::InSituOutput::
+  AddTally(const std::string& name, VolumeInterpolationPtr interpolation)
+{
+  ChiInvalidArgumentIf(not interpolation, "Null volume interpolation.");
+  ChiInvalidArgumentIf(interpolation->GetFieldFunctions().empty(),
+                       "The volume interpolation for tally \"" + name +
+                       "\" has no field function.");
+
+  tallies_.emplace_back(name, std::move(interpolation));
+}
+
+//###################################################################
+/**Streams a step if this call is due according to the cadence.*/
+bool chi_physics::InSituOutput::Execute(const double time)
+{
+  if ((num_calls_++) % cadence_ != 0) return false;
+
+  sink_->BeginStep(num_steps_, time);
+
+  //============================================= Cell averages of the fields
+  if (not field_functions_.empty())
+  {
+    const auto& grid = field_functions_.front()->SDM().Grid();
+
+    std::vector<uint64_t> cell_global_ids;
+    cell_global_ids.reserve(grid.local_cells.size());
+    for (const auto& cell : grid.local_cells)
+      cell_global_ids.push_back(cell.global_id_);
+
+    std::vector<double> values;
+    for (const auto& ff_ptr : field_functions_)
+    {
+      const auto field_vector = ff_ptr->GetGhostedFieldVector();
+
+      const auto& uk_man = ff_ptr->UnkManager();
+      const auto& unknown = ff_ptr->Unknown();
+      const auto& sdm = ff_ptr->SDM();
+      const size_t num_comps = unknown.NumComponents();
+
+      for (unsigned int c=0; c<num_comps; ++c)
+      {
+        std::string component_name = ff_ptr->TextName() + unknown.text_name_;
+        if (num_comps > 1)
+          component_name += unknown.component_text_names_[c];
+
+        values.clear();
+        values.reserve(grid.local_cells.size());
+        for (const auto& cell : grid.local_cells)
+        {
+          const size_t num_nodes = sdm.GetCellNumNodes(cell);
+          double node_average = 0.0;
+          for (size_t n=0; n<num_nodes; ++n)
+            node_average += field_vector[sdm.MapDOFLocal(cell,n,uk_man,0,c)];
+          values.push_back(node_average / static_cast<double>(num_nodes));
+        }
+
+        sink_->PutCellField(component_name, cell_global_ids, values);
+      }//for component
+    }//for ff_ptr
+  }
+
+  //============================================= Tallies
+  for (auto& [name, interpolation] : tallies_)
+  {
+    interpolation->Execute();
+    sink_->PutScalar(name, interpolation->GetOpValue());
+  }
+
+  sink_->EndStep();
+
+  ++num_steps_;
+  return true;
+}
+
+//###################################################################
+/**Creates a sink calling the named global Lua function.*/
+chi_physics::LuaCallbackInSituSink::
+  LuaCallbackInSituSink(std::string lua_function_name) :
+  lua_function_name_(std::move(lua_function_name))
+{
+}
+
+void chi_physics::LuaCallbackInSituSink::BeginStep(const size_t step,
+                                                   const double time)
+{
+  step_ = step;
+  time_ = time;
+  scalars_.clear();
+}
+
+void chi_physics::LuaCallbackInSituSink::PutScalar(const std::string& name,
+                                                   const double value)
+{
+  scalars_.emplace_back(name, value);
+}
+
+//###################################################################
+/**Calls the Lua function with the step, the time and the scalars.*/
+void chi_physics::LuaCallbackInSituSink::EndStep()
+{
+  lua_State* L = Chi::console.GetConsoleState();
+
+  lua_getglobal(L, lua_function_name_.c_str());
+  ChiLogicalErrorIf(not lua_isfunction(L, -1),
+                    "In-situ callback \"" + lua_function_name_ +
+                    "\" is not a Lua function.");
+
+  lua_pushinteger(L, static_cast<lua_Integer>(step_));
+  lua_pushnumber(L, time_);
+  lua_newtable(L);
+  for (const auto& [name, value] : scalars_)
+  {
+    lua_pushstring(L, name.c_str());
+    lua_pushnumber(L, value);
+    lua_settable(L, -3);
+  }
+
+  //3 arguments, 0 results, 0=original error object
+  if (lua_pcall(L, 3, 0, 0) != 0)
+  {
+    const std::string error = lua_tostring(L, -1);
+    lua_pop(L, 1);
+    ChiLogicalError("In-situ callback \"" + lua_function_name_ +
+                    "\" failed: " + error);
+  }
+}
@@ -0,0 +1,132 @@
+#ifndef CHITECH_CHI_INSITU_OUTPUT_H
+#define CHITECH_CHI_INSITU_OUTPUT_H
+
+#include "ChiObject.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+namespace chi_mesh
+{
+class FieldFunctionInterpolationVolume;
+}
+
+namespace chi_physics
+{
+class FieldFunctionGridBased;
+
+// ################################################################### Class def
+/**Destination of in-situ output. A step consists of a call to BeginStep,
+ * any number of Put calls, made in the same order on all locations, and
+ * a call to EndStep. All calls are collective.*/
+class InSituSink
+{
+public:
+  virtual void BeginStep(size_t step, double time) = 0;
+  /**Puts the values of a field on the local cells, in the order of
+   * `cell_global_ids`.*/
+  virtual void PutCellField(const std::string& name,
+                            const std::vector<uint64_t>& cell_global_ids,
+                            const std::vector<double>& values) = 0;
+  /**Puts a global scalar, identical on all locations.*/
+  virtual void PutScalar(const std::string& name, double value) = 0;
+  virtual void EndStep() = 0;
+
+  virtual ~InSituSink() = default;
+};
+
+// ################################################################### Class def
+/**Streams the cell averages of field functions, and tallies obtained from
+ * volume field function interpolations, to an in-situ sink at a given
+ * cadence, i.e., on every `cadence`-th call to Execute. Nothing is
+ * written to disk unless the sink itself does so.*/
+class InSituOutput : public ChiObject
+{
+public:
+  typedef std::shared_ptr<const FieldFunctionGridBased> FFPtr;
+  typedef std::shared_ptr<chi_mesh::FieldFunctionInterpolationVolume>
+    VolumeInterpolationPtr;
+
+private:
+  std::unique_ptr<InSituSink> sink_;
+  const size_t cadence_;
+
+  std::vector<FFPtr> field_functions_;
+  std::vector<std::pair<std::string, VolumeInterpolationPtr>> tallies_;
+
+  size_t num_calls_ = 0;
+  size_t num_steps_ = 0;
+
+public:
+  InSituOutput(std::unique_ptr<InSituSink> sink, size_t cadence);
+
+  /**Adds a field function of which every component is streamed. All field
+   * functions must be on the same grid.*/
+  void AddFieldFunction(FFPtr field_function);
+
+  /**Adds a tally, the operation value of an initialized volume
+   * interpolation, streamed as a scalar.*/
+  void AddTally(const std::string& name, VolumeInterpolationPtr interpolation);
+
+  /**Streams a step if this call is due according to the cadence. Returns
+   * true if a step was streamed. This is a collective call.*/
+  bool Execute(double time);
+
+  size_t NumSteps() const { return num_steps_; }
+};
+
+// ################################################################### Class def
+/**Calls a Lua function on every location at the end of each step, with
+ * the step number, the time and a table of the scalars by name. The
+ * fields are not passed.*/
+class LuaCallbackInSituSink : public InSituSink
+{
+private:
+  const std::string lua_function_name_;
+  size_t step_ = 0;
+  double time_ = 0.0;
+  std::vector<std::pair<std::string, double>> scalars_;
+
+public:
+  explicit LuaCallbackInSituSink(std::string lua_function_name);
+
+  void BeginStep(size_t step, double time) override;
+  void PutCellField(const std::string& name,
+                    const std::vector<uint64_t>& cell_global_ids,
+                    const std::vector<double>& values) override {}
+  void PutScalar(const std::string& name, double value) override;
+  void EndStep() override;
+};
+
+#ifdef CHITECH_HAVE_ADIOS2
+// ################################################################### Class def
+/**Streams through an ADIOS2 engine, e.g., SST for staging to a running
+ * consumer or BP5. Every field is a global array over all the cells, in
+ * location order, along with the array "cell_global_ids" identifying
+ * the cells, and every scalar is a single value.*/
+class ADIOS2InSituSink : public InSituSink
+{
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> impl_;
+
+public:
+  ADIOS2InSituSink(const std::string& stream_name,
+                   const std::string& engine_type);
+  ~ADIOS2InSituSink() override;
+
+  void BeginStep(size_t step, double time) override;
+  void PutCellField(const std::string& name,
+                    const std::vector<uint64_t>& cell_global_ids,
+                    const std::vector<double>& values) override;
+  void PutScalar(const std::string& name, double value) override;
+  void EndStep() override;
+};
+#endif
+
+} // namespace chi_physics
+
+#endif // CHITECH_CHI_INSITU_OUTPUT_H
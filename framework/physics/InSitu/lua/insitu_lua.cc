@@ -0,0 +1,188 @@
+#include "insitu_lua.h"
+
+#include "physics/InSitu/chi_insitu_output.h"
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+#include "mesh/FieldFunctionInterpolation/Volume/chi_ffinter_volume.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "console/chi_console.h"
+
+RegisterLuaFunctionAsIs(chiInSituOutputCreate);
+RegisterLuaFunctionAsIs(chiInSituOutputAddFieldFunctions);
+RegisterLuaFunctionAsIs(chiInSituOutputAddTally);
+RegisterLuaFunctionAsIs(chiInSituOutputExecute);
+
+// #############################################################################
+/** Creates an in-situ output, streaming field functions and tallies
+ * without writing them to disk.
+ *
+\param SinkType char The sink. One of:
+ - "LUA_CALLBACK": Calls the Lua function named by `Target`, on every
+   location, as `Target(step, time, tallies)`, where `tallies` is a table
+   of the tally values by name. Field functions are not passed.
+ - "ADIOS2_SST", "ADIOS2_BP5": Streams to the ADIOS2 stream named by
+   `Target` with the SST or BP5 engine. Each field function component is
+   a global array of cell averages, along with the array
+   "cell_global_ids", and each tally a single value. Only available when
+   ChiTech is built with ADIOS2.
+\param Target char The Lua function or stream name.
+\param Cadence int Optional. A step is streamed on every Cadence-th call
+                   to chiInSituOutputExecute. Default 1.
+
+\return Handle int Handle to the in-situ output.
+
+\ingroup LuaFieldFunc*/
+int chiInSituOutputCreate(lua_State* L)
+{
+  const std::string fname = "chiInSituOutputCreate";
+  const int num_args = lua_gettop(L);
+  if (num_args < 2 or num_args > 3) LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckStringValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+
+  const std::string sink_type = lua_tostring(L, 1);
+  const std::string target = lua_tostring(L, 2);
+
+  size_t cadence = 1;
+  if (num_args == 3)
+  {
+    LuaCheckIntegerValue(fname, L, 3);
+    const lua_Integer value = lua_tointeger(L, 3);
+    ChiInvalidArgumentIf(value < 1, fname + ": The cadence must be at "
+                                            "least 1.");
+    cadence = static_cast<size_t>(value);
+  }
+
+  std::unique_ptr<chi_physics::InSituSink> sink;
+  if (sink_type == "LUA_CALLBACK")
+    sink = std::make_unique<chi_physics::LuaCallbackInSituSink>(target);
+#ifdef CHITECH_HAVE_ADIOS2
+  else if (sink_type == "ADIOS2_SST")
+    sink = std::make_unique<chi_physics::ADIOS2InSituSink>(target, "SST");
+  else if (sink_type == "ADIOS2_BP5")
+    sink = std::make_unique<chi_physics::ADIOS2InSituSink>(target, "BP5");
+#else
+  else if (sink_type == "ADIOS2_SST" or sink_type == "ADIOS2_BP5")
+    ChiInvalidArgument(fname + ": ChiTech was built without ADIOS2.");
+#endif
+  else
+    ChiInvalidArgument(fname + ": Unknown sink type \"" + sink_type + "\".");
+
+  auto output =
+    std::make_shared<chi_physics::InSituOutput>(std::move(sink), cadence);
+
+  Chi::object_stack.push_back(output);
+
+  lua_pushinteger(L, static_cast<lua_Integer>(Chi::object_stack.size() - 1));
+  return 1;
+}
+
+// #############################################################################
+/** Adds grid-based field functions to an in-situ output.
+ *
+\param Handle int Handle to the in-situ output.
+\param listFFHandles table Global handles to the field functions.
+
+\ingroup LuaFieldFunc*/
+int chiInSituOutputAddFieldFunctions(lua_State* L)
+{
+  const std::string fname = "chiInSituOutputAddFieldFunctions";
+  const int num_args = lua_gettop(L);
+  if (num_args != 2) LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+
+  auto& output = Chi::GetStackItem<chi_physics::InSituOutput>(
+    Chi::object_stack, lua_tointeger(L, 1), fname);
+
+  const size_t table_size = lua_rawlen(L, 2);
+  for (int i = 0; i < table_size; ++i)
+  {
+    lua_pushnumber(L, i + 1);
+    lua_gettable(L, 2);
+
+    int ff_handle = lua_tonumber(L, -1);
+    lua_pop(L, 1);
+
+    auto ff_base =
+      Chi::GetStackItemPtr(Chi::field_function_stack, ff_handle, fname);
+
+    typedef chi_physics::FieldFunctionGridBased FFGridBased;
+    auto ff = std::dynamic_pointer_cast<FFGridBased>(ff_base);
+
+    ChiLogicalErrorIf(not ff,
+                      "Only grid-based field functions can be streamed");
+
+    output.AddFieldFunction(ff);
+  }
+
+  return 0;
+}
+
+// #############################################################################
+/** Adds a tally to an in-situ output. The tally is the operation value of
+ * an initialized volume field function interpolation, e.g., the volume
+ * integral of a fission rate, and is re-evaluated at every streamed step.
+ *
+\param Handle int Handle to the in-situ output.
+\param Name char Name of the tally.
+\param FFIHandle int Handle to the volume field function interpolation.
+
+\ingroup LuaFieldFunc*/
+int chiInSituOutputAddTally(lua_State* L)
+{
+  const std::string fname = "chiInSituOutputAddTally";
+  const int num_args = lua_gettop(L);
+  if (num_args != 3) LuaPostArgAmountError(fname, 3, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+  LuaCheckNumberValue(fname, L, 3);
+
+  auto& output = Chi::GetStackItem<chi_physics::InSituOutput>(
+    Chi::object_stack, lua_tointeger(L, 1), fname);
+  const std::string name = lua_tostring(L, 2);
+
+  auto interpolation =
+    Chi::GetStackItemPtr(Chi::field_func_interpolation_stack,
+                         lua_tointeger(L, 3), fname);
+  auto volume_interpolation =
+    std::dynamic_pointer_cast<chi_mesh::FieldFunctionInterpolationVolume>(
+      interpolation);
+
+  ChiLogicalErrorIf(not volume_interpolation,
+                    fname + ": Only volume interpolations can be tallied.");
+
+  output.AddTally(name, volume_interpolation);
+
+  return 0;
+}
+
+// #############################################################################
+/** Streams a step of an in-situ output if the call is due according to the
+ * cadence. This is a collective call.
+ *
+\param Handle int Handle to the in-situ output.
+\param Time double The time of the step.
+
+\return Streamed bool True if a step was streamed.
+
+\ingroup LuaFieldFunc*/
+int chiInSituOutputExecute(lua_State* L)
+{
+  const std::string fname = "chiInSituOutputExecute";
+  const int num_args = lua_gettop(L);
+  if (num_args != 2) LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckNumberValue(fname, L, 2);
+
+  auto& output = Chi::GetStackItem<chi_physics::InSituOutput>(
+    Chi::object_stack, lua_tointeger(L, 1), fname);
+
+  lua_pushboolean(L, output.Execute(lua_tonumber(L, 2)));
+  return 1;
+}
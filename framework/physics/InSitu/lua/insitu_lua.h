@@ -0,0 +1,11 @@
+#ifndef CHITECH_INSITU_LUA_H
+#define CHITECH_INSITU_LUA_H
+
+#include "chi_lua.h"
+
+int chiInSituOutputCreate(lua_State *L);
+int chiInSituOutputAddFieldFunctions(lua_State *L);
+int chiInSituOutputAddTally(lua_State *L);
+int chiInSituOutputExecute(lua_State *L);
+
+#endif //CHITECH_INSITU_LUA_H
@@ -1,36 +1,83 @@
 #include "adjoint_mgxs.h"
 
+#include "utils/chi_memory_accounting.h"
 
-chi_physics::AdjointMGXS::
-AdjointMGXS(const MultiGroupXS& xs) : xs_(xs)
+
+//######################################################################
+/**Computes the transposed transfer and production matrices if they have
+ * not been computed for the current revision of the forward cross
+ * section.
+ *
+ * The transfer matrices are transposed by counting the entries of each
+ * column first, which sizes every row of the transpose exactly and
+ * avoids the search for existing entries done by SparseMatrix::Insert.*/
+void chi_physics::AdjointMGXS::ComputeTransposes() const
 {
+  std::lock_guard<std::mutex> lock(transpose_mutex_);
+  if (transposes_valid_ and transposes_revision_ == xs_.Revision()) return;
+
+  const size_t G = xs_.NumGroups();
+
   // transpose transfer matrices
-  for (unsigned int ell = 0; ell <= xs_.ScatteringOrder(); ++ell)
+  transposed_transfer_matrices_.clear();
+  for (const auto& S_ell : xs_.TransferMatrices())
   {
-    const auto& S_ell = xs_.TransferMatrix(ell);
-    chi_math::SparseMatrix S_ell_transpose(xs_.NumGroups(), xs_.NumGroups());
-    for (size_t g = 0; g < xs_.NumGroups(); ++g)
+    std::vector<size_t> col_counts(G, 0);
+    for (size_t g = 0; g < G; ++g)
     {
-      const size_t row_len = S_ell.rowI_indices_[g].size();
-      const size_t* col_ptr = S_ell.rowI_indices_[g].data();
-      const double* val_ptr = S_ell.rowI_values_[g].data();
+      const auto row = S_ell.RowSpan(g);
+      for (size_t j = 0; j < row.size; ++j)
+        ++col_counts[row.column_indices[j]];
+    }
 
-      for (size_t j = 0; j < row_len; ++j)
-        S_ell_transpose.Insert(*col_ptr++, g, *val_ptr++);
+    chi_math::SparseMatrix S_ell_transpose(G, G);
+    for (size_t gp = 0; gp < G; ++gp)
+    {
+      S_ell_transpose.rowI_indices_[gp].reserve(col_counts[gp]);
+      S_ell_transpose.rowI_values_[gp].reserve(col_counts[gp]);
     }
-    transposed_transfer_matrices_.push_back(S_ell_transpose);
+
+    for (size_t g = 0; g < G; ++g)
+    {
+      const auto row = S_ell.RowSpan(g);
+      const size_t* col_ptr = row.column_indices;
+      const double* val_ptr = row.values;
+
+      for (size_t j = 0; j < row.size; ++j)
+      {
+        S_ell_transpose.rowI_indices_[*col_ptr].push_back(g);
+        S_ell_transpose.rowI_values_[*col_ptr++].push_back(*val_ptr++);
+      }
+    }
+    S_ell_transpose.Compress();
+    transposed_transfer_matrices_.push_back(std::move(S_ell_transpose));
   }//for ell
 
   // transpose production matrices
+  transposed_production_matrices_.clear();
   if (xs_.IsFissionable())
   {
-    const auto& F = xs_.ProductionMatrix();
-    for (size_t g = 0; g < xs_.NumGroups(); ++g)
-    {
-      std::vector<double> F_g_transpose;
-      for (size_t gp = 0; gp < xs_.NumGroups(); ++gp)
-        F_g_transpose.emplace_back(F[gp][g]);
-      transposed_production_matrices_.push_back(F_g_transpose);
-    }
+    const auto F = xs_.ProductionMatrix();
+    transposed_production_matrices_.assign(G, std::vector<double>(G, 0.0));
+    for (size_t g = 0; g < G; ++g)
+      for (size_t gp = 0; gp < G; ++gp)
+        transposed_production_matrices_[g][gp] = F[gp][g];
   }
+  transposed_production_.SetMatrix(transposed_production_matrices_);
+
+  transposes_revision_ = xs_.Revision();
+  transposes_valid_ = true;
+}
+
+//######################################################################
+size_t chi_physics::AdjointMGXS::GetMemoryUsage() const
+{
+  std::lock_guard<std::mutex> lock(transpose_mutex_);
+  size_t num_bytes =
+    chi::VectorMemoryUsage(transposed_transfer_matrices_) +
+    chi::VectorMemoryUsage(transposed_production_matrices_) +
+    transposed_production_.GetMemoryUsage();
+  for (const auto& matrix : transposed_transfer_matrices_)
+    num_bytes += matrix.GetMemoryUsage();
+  return num_bytes;
 }
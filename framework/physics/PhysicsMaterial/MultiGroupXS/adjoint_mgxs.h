@@ -3,6 +3,8 @@
 
 #include "multigroup_xs.h"
 
+#include <mutex>
+
 
 namespace chi_physics
 {
@@ -14,25 +16,40 @@ namespace chi_physics
  * In adjoint simulations, the transfer and production matrices are transposed.
  * While the respective matrices could be queried by simply flipping the
  * indices, access attempts in this fashion are quite costly. Rather, this
- * class precomputes and stores these transpose operators. Along with this, a
+ * class computes and stores these transpose operators. Along with this, a
  * reference to an instance of MultiGroupXS is stored. In this class, accessors
  * for vector data call the respective accessor from MultiGroupXS and accessors
  * for transfer and production matrices access the respective transposed data
  * stored in this class.
+ *
+ * The transposes are computed on first access, hence cross sections of
+ * materials never accessed on a location (e.g. not present on the local
+ * partition) cost nothing. They are recomputed when the forward cross
+ * section is modified in place.
  */
 class AdjointMGXS : public MultiGroupXS
 {
 private:
   const MultiGroupXS& xs_;
-  std::vector<chi_math::SparseMatrix> transposed_transfer_matrices_;
-  std::vector<std::vector<double>> transposed_production_matrices_;
+
+  mutable std::mutex transpose_mutex_;
+  mutable bool transposes_valid_ = false;
+  mutable size_t transposes_revision_ = 0;
+  mutable std::vector<chi_math::SparseMatrix> transposed_transfer_matrices_;
+  mutable std::vector<std::vector<double>> transposed_production_matrices_;
+  mutable ProductionOperator transposed_production_;
+
+  void ComputeTransposes() const;
 
 public:
   AdjointMGXS() = delete;
   AdjointMGXS(const AdjointMGXS&) = delete;
   AdjointMGXS(AdjointMGXS&&) = delete;
 
-  explicit AdjointMGXS(const MultiGroupXS& xs);
+  explicit AdjointMGXS(const MultiGroupXS& xs) : xs_(xs) {}
+
+  /**The adjoint changes whenever the forward cross section does.*/
+  size_t Revision() const override { return xs_.Revision(); }
 
   //Accessors
   const unsigned int NumGroups() const override { return xs_.NumGroups(); }
@@ -73,13 +90,16 @@ public:
   { return xs_.InverseVelocity(); }
 
   const std::vector<chi_math::SparseMatrix>& TransferMatrices() const override
-  { return transposed_transfer_matrices_; }
+  { ComputeTransposes(); return transposed_transfer_matrices_; }
 
   const chi_math::SparseMatrix& TransferMatrix(unsigned int ell) const override
-  { return transposed_transfer_matrices_.at(ell); }
+  { ComputeTransposes(); return transposed_transfer_matrices_.at(ell); }
 
   const std::vector<std::vector<double>> ProductionMatrix() const override
-  { return transposed_production_matrices_; }
+  { ComputeTransposes(); return transposed_production_matrices_; }
+
+  const ProductionOperator& Production() const override
+  { ComputeTransposes(); return transposed_production_; }
 
   const std::vector<Precursor>& Precursors() const override
   { return xs_.Precursors(); }
@@ -96,6 +116,9 @@ public:
   const std::vector<double>& SigmaSGtoG() const override
   { return xs_.SigmaSGtoG(); }
 
+  /**Counts the transposes only, the forward data being owned by the
+   * forward cross section.*/
+  size_t GetMemoryUsage() const override;
 };
 
 }
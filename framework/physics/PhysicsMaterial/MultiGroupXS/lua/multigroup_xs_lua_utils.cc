@@ -3,6 +3,7 @@
 
 #include "physics/chi_physics_namespace.h"
 #include "physics/PhysicsMaterial/MultiGroupXS/single_state_mgxs.h"
+#include "physics/PhysicsMaterial/MultiGroupXS/multi_state_mgxs.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -15,6 +16,9 @@ RegisterLuaFunctionAsIs(chiPhysicsTransportXSMakeCombined);
 RegisterLuaFunctionAsIs(chiPhysicsTransportXSSetCombined);
 RegisterLuaFunctionAsIs(chiPhysicsTransportXSGet);
 RegisterLuaFunctionAsIs(chiPhysicsTransportXSExportToChiTechFormat);
+RegisterLuaFunctionAsIs(chiPhysicsTransportXSExportToChiTechBinaryFormat);
+RegisterLuaFunctionAsIs(chiPhysicsTransportXSCreateMultiState);
+RegisterLuaFunctionAsIs(chiPhysicsTransportXSSetState);
 
 RegisterLuaConstantAsIs(SINGLE_VALUE, chi_data_types::Varying( 0));
 RegisterLuaConstantAsIs(FROM_ARRAY,   chi_data_types::Varying( 1));
@@ -22,6 +26,7 @@ RegisterLuaConstantAsIs(SIMPLEXS0,    chi_data_types::Varying(20));
 RegisterLuaConstantAsIs(SIMPLEXS1,    chi_data_types::Varying(21));
 RegisterLuaConstantAsIs(EXISTING,     chi_data_types::Varying(22));
 RegisterLuaConstantAsIs(CHI_XSFILE,   chi_data_types::Varying(23));
+RegisterLuaConstantAsIs(CHI_XSFILE_BINARY, chi_data_types::Varying(24));
 
 //###################################################################
 /**Creates a stand-alone transport cross section.
@@ -98,6 +103,14 @@ CHI_XSFILE\n
 Loads transport cross sections from CHI type cross section files. Expects
 to be followed by a filepath specifying the xs-file.
 
+####_
+
+CHI_XSFILE_BINARY\n
+Loads transport cross sections from binary CHI cross section files, as
+written by chiPhysicsTransportXSExportToChiTechBinaryFormat. The file is read
+by a single location and broadcast to the others. Expects to be followed by a
+filepath specifying the xs-file.
+
 
 ##_
 ### Example
@@ -171,6 +184,15 @@ int chiPhysicsTransportXSSet(lua_State* L)
 
     xs->MakeFromChiXSFile(std::string(file_name_c));
   }
+  else if (operation_index == static_cast<int>(OpType::CHI_XSFILE_BINARY))
+  {
+    if (num_args != 3)
+      LuaPostArgAmountError("chiPhysicsTransportXSSet",3,num_args);
+
+    const char* file_name_c = lua_tostring(L,3);
+
+    xs->MakeFromChiXSBinaryFile(std::string(file_name_c));
+  }
   else
   {
     Chi::log.LogAllError()
@@ -186,6 +208,9 @@ int chiPhysicsTransportXSSet(lua_State* L)
 /**Obtains a lua table of all the cross section values.
 
  \param XS_handle int Handle to the cross section to be modified.
+ \param AsBuffers bool Optional. Returns the 1D cross sections, e.g.
+        `sigma_t`, as read only buffers over those of the cross section
+        instead of copying them into tables. Default false.
 
  ## _
 
@@ -195,6 +220,13 @@ xs = chiPhysicsTransportXSGet(xs_handle)
 for i,v in pairs(xs) do
     print(i,v)
 end
+\endcode
+
+ The buffers, see chiBufferCreate, reflect later modifications of the
+ cross section:
+\code
+xs = chiPhysicsTransportXSGet(xs_handle, true)
+print(#xs.sigma_t, xs.sigma_t[1], xs.sigma_t:Sum())
 \endcode
 \ingroup LuaTransportXSs*/
 int chiPhysicsTransportXSGet(lua_State* L)
@@ -211,10 +243,9 @@ int chiPhysicsTransportXSGet(lua_State* L)
 
   int handle = lua_tonumber(L,1);
 
-  std::shared_ptr<chi_physics::SingleStateMGXS> xs;
+  std::shared_ptr<chi_physics::MultiGroupXS> xs;
   try {
-    xs = std::dynamic_pointer_cast<chi_physics::SingleStateMGXS>(
-      Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle));
+    xs = Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle);
   }
   catch(const std::out_of_range& o){
     Chi::log.LogAllError()
@@ -224,7 +255,10 @@ int chiPhysicsTransportXSGet(lua_State* L)
     Chi::Exit(EXIT_FAILURE);
   }
 
-  xs->PushLuaTable(L);
+  const bool as_buffers = num_args >= 2 and lua_toboolean(L, 2);
+  if (as_buffers) xs->PushLuaTable(L, xs);
+  else
+    xs->PushLuaTable(L);
 
   return 1;
 }
@@ -480,4 +514,165 @@ int chiPhysicsTransportXSExportToChiTechFormat(lua_State* L)
   xs->ExportToChiXSFile(file_name);
 
   return 0;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/** Exports a cross section to the binary ChiTech format, which loads
+ * without parsing using the CHI_XSFILE_BINARY operation. Combined with
+ * CHI_XSFILE this converts text cross section files:
+\code
+xs = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs, CHI_XSFILE, "xs_3_170.cxs")
+chiPhysicsTransportXSExportToChiTechBinaryFormat(xs, "xs_3_170.cxsb")
+\endcode
+ *
+\param XS_handle int Handle to the cross section to be exported.
+\param file_name string The name of the file to which the XS is to be exported.
+
+\ingroup LuaTransportXSs
+ */
+int chiPhysicsTransportXSExportToChiTechBinaryFormat(lua_State* L)
+{
+  int num_args = lua_gettop(L);
+
+  if (num_args != 2)
+    LuaPostArgAmountError(__FUNCTION__,2,num_args);
+
+  LuaCheckNilValue(__FUNCTION__,L,1);
+  LuaCheckNilValue(__FUNCTION__,L,2);
+
+  //======================================== Process handle
+  int handle = lua_tonumber(L,1);
+
+  std::shared_ptr<chi_physics::MultiGroupXS> xs;
+  try {
+    xs = Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle);
+  }
+  catch(const std::out_of_range& o){
+    Chi::log.LogAllError()
+      << "ERROR: Invalid cross section handle"
+      << " in call to " << __FUNCTION__ << "."
+      << std::endl;
+    Chi::Exit(EXIT_FAILURE);
+  }
+
+  std::string file_name = lua_tostring(L,2);
+
+  xs->ExportToChiXSBinaryFile(file_name);
+
+  return 0;
+}
+
+//###################################################################
+/**Creates a cross section that interpolates, in temperature, between
+ * cross sections tabulated at several temperatures. All the tabulated
+ * cross sections must have the same number of groups and precursors. The
+ * state is initially set to the lowest temperature.
+ *
+\param States table A lua-table with each element another table containing
+                    a temperature and a handle to an existing xs.
+
+\code
+xs_cold = chiPhysicsTransportXSCreate()
+xs_hot = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs_cold, CHI_XSFILE, "fuel_600K.cxs")
+chiPhysicsTransportXSSet(xs_hot, CHI_XSFILE, "fuel_1200K.cxs")
+
+fuel_xs = chiPhysicsTransportXSCreateMultiState({{600.0, xs_cold},
+                                                 {1200.0, xs_hot}})
+chiPhysicsMaterialSetProperty(materials[1],
+                              TRANSPORT_XSECTIONS,
+                              EXISTING,
+                              fuel_xs)
+\endcode
+ *
+\return Returns a handle to the new cross section.
+
+\ingroup LuaTransportXSs
+ */
+int chiPhysicsTransportXSCreateMultiState(lua_State* L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args != 1)
+    LuaPostArgAmountError(__FUNCTION__,1,num_args);
+
+  LuaCheckTableValue(__FUNCTION__,L,1);
+
+  auto new_xs = std::make_shared<chi_physics::MultiStateMGXS>();
+
+  const size_t table_len = lua_rawlen(L,1);
+  for (size_t v=0; v<table_len; ++v)
+  {
+    lua_pushnumber(L,static_cast<lua_Number>(v+1));
+    lua_gettable(L,1);
+    LuaCheckTableValue((std::string(__FUNCTION__) + ":A1:E").c_str(),L,-1);
+
+    lua_pushinteger(L,1);
+    lua_gettable(L,-2);
+    LuaCheckNilValue((std::string(__FUNCTION__) + ":A1:E1").c_str(),L,-1);
+    const double temperature = lua_tonumber(L,-1); lua_pop(L,1);
+
+    lua_pushinteger(L,2);
+    lua_gettable(L,-2);
+    LuaCheckNilValue((std::string(__FUNCTION__) + ":A1:E2").c_str(),L,-1);
+    const int handle = lua_tonumber(L,-1); lua_pop(L,1);
+
+    lua_pop(L,1); //pop off table
+
+    new_xs->AddState(temperature,
+                     Chi::GetStackItemPtr(Chi::multigroup_xs_stack,
+                                          handle, __FUNCTION__));
+  }
+
+  ChiInvalidArgumentIf(new_xs->NumStates() == 0,
+                       "At least one state must be supplied.");
+
+  Chi::multigroup_xs_stack.push_back(new_xs);
+  lua_pushinteger(L,
+                  static_cast<lua_Integer>(Chi::multigroup_xs_stack.size()) - 1);
+
+  return 1;
+}
+
+//###################################################################
+/**Sets the state of a multi-state cross section. The data of the cross
+ * section is modified in place, hence solvers using it only need a call to
+ * chiLBSUpdateCrossSections to pick up the new state.
+ *
+\param XS_handle int Handle to a cross section made with
+                     chiPhysicsTransportXSCreateMultiState.
+\param Temperature double The temperature to interpolate to. Temperatures
+                          outside the table are clamped to it.
+\param DensityScale double (Optional) Ratio of the density to the density
+                           of the tabulated cross sections. Default 1.0.
+
+\ingroup LuaTransportXSs
+ */
+int chiPhysicsTransportXSSetState(lua_State* L)
+{
+  int num_args = lua_gettop(L);
+  if (num_args < 2 or num_args > 3)
+    LuaPostArgAmountError(__FUNCTION__,2,num_args);
+
+  LuaCheckNilValue(__FUNCTION__,L,1);
+  LuaCheckNilValue(__FUNCTION__,L,2);
+
+  const int handle = lua_tonumber(L,1);
+  const double temperature = lua_tonumber(L,2);
+  double density_scale = 1.0;
+  if (num_args == 3)
+  {
+    LuaCheckNilValue(__FUNCTION__,L,3);
+    density_scale = lua_tonumber(L,3);
+  }
+
+  auto xs = std::dynamic_pointer_cast<chi_physics::MultiStateMGXS>(
+    Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle, __FUNCTION__));
+  ChiInvalidArgumentIf(not xs,
+                       "The cross section is not a multi-state cross "
+                       "section.");
+
+  xs->SetState(temperature, density_scale);
+
+  return 0;
+}
@@ -9,5 +9,8 @@ int chiPhysicsTransportXSMakeCombined(lua_State* L);
 int chiPhysicsTransportXSSetCombined(lua_State* L);
 int chiPhysicsTransportXSGet(lua_State* L);
 int chiPhysicsTransportXSExportToChiTechFormat(lua_State* L);
+int chiPhysicsTransportXSExportToChiTechBinaryFormat(lua_State* L);
+int chiPhysicsTransportXSCreateMultiState(lua_State* L);
+int chiPhysicsTransportXSSetState(lua_State* L);
 
 #endif //CHITECH_XSECTIONS_LUA_UTILS_H
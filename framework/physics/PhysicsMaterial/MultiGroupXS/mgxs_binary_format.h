@@ -0,0 +1,87 @@
+#ifndef CHI_PHYSICS_MGXS_BINARY_FORMAT_H
+#define CHI_PHYSICS_MGXS_BINARY_FORMAT_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**Layout of binary ChiXS files, all values in native byte order:
+ * - 8 bytes: the characters `CHIXSBIN`,
+ * - uint32: format version,
+ * - uint32: number of groups, scattering order, number of precursors and
+ *   fissionable flag,
+ * - 1D data in the order sigma_t, sigma_a, sigma_f, nu_sigma_f,
+ *   nu_prompt_sigma_f, nu_delayed_sigma_f and inverse velocity, each as a
+ *   uint64 size followed by the values,
+ * - uint64 number of transfer matrices, then for every matrix and row a
+ *   uint64 number of entries followed by the column indices (uint64) and
+ *   the values,
+ * - uint32 production matrix form (see ProductionForm) followed by its data,
+ * - for each precursor the decay constant, the fractional yield and the
+ *   emission spectrum as 1D data.*/
+namespace chi_physics::mgxs_binary
+{
+
+constexpr char MAGIC[8] = {'C', 'H', 'I', 'X', 'S', 'B', 'I', 'N'};
+constexpr uint32_t VERSION = 1;
+
+/**How the production matrix is stored.*/
+enum class ProductionForm : uint32_t
+{
+  NONE = 0,     ///< No production matrix.
+  DENSE = 1,    ///< G x G values, row by row.
+  FACTORED = 2  ///< Spectrum and production cross section, as 1D data.
+};
+
+/**Attempts to write the given production matrix as the outer product of a
+ * spectrum and a production cross section, which holds for any production
+ * matrix built from a single fission spectrum. Returns false when the
+ * matrix is not of that form, within round-off.*/
+inline bool FactorProductionMatrix(const std::vector<std::vector<double>>& F,
+                                   std::vector<double>& spectrum,
+                                   std::vector<double>& nu_sigma_f)
+{
+  const size_t num_groups = F.size();
+
+  //find the pivot, the entry of largest magnitude
+  size_t row = 0, col = 0;
+  double max_value = 0.0;
+  for (size_t g = 0; g < num_groups; ++g)
+    for (size_t gp = 0; gp < F[g].size(); ++gp)
+      if (std::fabs(F[g][gp]) > max_value)
+      {
+        max_value = std::fabs(F[g][gp]);
+        row = g;
+        col = gp;
+      }
+  if (max_value == 0.0) return false;
+
+  //scale the pivot column to a unit-sum spectrum
+  double col_sum = 0.0;
+  for (size_t g = 0; g < num_groups; ++g)
+    col_sum += F[g][col];
+  if (col_sum == 0.0) return false;
+
+  spectrum.assign(num_groups, 0.0);
+  for (size_t g = 0; g < num_groups; ++g)
+    spectrum[g] = F[g][col] / col_sum;
+
+  nu_sigma_f.assign(num_groups, 0.0);
+  for (size_t gp = 0; gp < num_groups; ++gp)
+    nu_sigma_f[gp] = F[row][gp] / spectrum[row];
+
+  //check the factorization
+  const double tolerance = 1.0e-12 * max_value;
+  for (size_t g = 0; g < num_groups; ++g)
+  {
+    if (F[g].size() != num_groups) return false;
+    for (size_t gp = 0; gp < num_groups; ++gp)
+      if (std::fabs(F[g][gp] - spectrum[g] * nu_sigma_f[gp]) > tolerance)
+        return false;
+  }
+  return true;
+}
+
+}//namespace chi_physics::mgxs_binary
+
+#endif //CHI_PHYSICS_MGXS_BINARY_FORMAT_H
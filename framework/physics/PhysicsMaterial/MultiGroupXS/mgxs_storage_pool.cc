@@ -0,0 +1,127 @@
+#include "mgxs_storage_pool.h"
+
+#include <functional>
+
+namespace
+{
+
+/**Mixes the hash of a value into a running hash.*/
+template <typename T>
+void HashCombine(size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t HashValues(const std::vector<double>& values)
+{
+  size_t seed = values.size();
+  for (double value : values)
+    HashCombine(seed, value);
+  return seed;
+}
+
+bool SameMatrices(const std::vector<chi_math::SparseMatrix>& a,
+                  const std::vector<chi_math::SparseMatrix>& b)
+{
+  if (a.size() != b.size()) return false;
+  for (size_t m = 0; m < a.size(); ++m)
+    if (a[m].NumRows() != b[m].NumRows() or
+        a[m].NumCols() != b[m].NumCols() or
+        a[m].rowI_indices_ != b[m].rowI_indices_ or
+        a[m].rowI_values_ != b[m].rowI_values_)
+      return false;
+  return true;
+}
+
+}//namespace
+
+//######################################################################
+/**Returns the pool singleton.*/
+chi_physics::MGXSStoragePool& chi_physics::MGXSStoragePool::
+  GetInstance() noexcept
+{
+  static MGXSStoragePool singleton;
+  return singleton;
+}
+
+//######################################################################
+/**Looks up a block with the same contents, purging the entries that have
+ * expired, and otherwise adds the given block to the pool.*/
+template <typename T, typename Equal>
+std::shared_ptr<const T> chi_physics::MGXSStoragePool::
+  Intern(Entries<T>& entries, size_t hash, T&& values, Equal equal)
+{
+  auto range = entries.equal_range(hash);
+  for (auto it = range.first; it != range.second;)
+  {
+    auto block = it->second.lock();
+    if (not block)
+    {
+      it = entries.erase(it);
+      continue;
+    }
+    if (equal(*block, values)) return block;
+    ++it;
+  }
+
+  auto block = std::make_shared<const T>(std::move(values));
+  entries.emplace(hash, block);
+  return block;
+}
+
+//######################################################################
+/**Interns a vector of values.*/
+std::shared_ptr<const chi_physics::MGXSStoragePool::VecDbl>
+chi_physics::MGXSStoragePool::Intern(VecDbl&& values)
+{
+  const size_t hash = HashValues(values);
+  return Intern(vectors_, hash, std::move(values), std::equal_to<VecDbl>());
+}
+
+//######################################################################
+/**Interns a dense matrix.*/
+std::shared_ptr<const chi_physics::MGXSStoragePool::MatDbl>
+chi_physics::MGXSStoragePool::Intern(MatDbl&& values)
+{
+  size_t hash = values.size();
+  for (const auto& row : values)
+    HashCombine(hash, HashValues(row));
+  return Intern(matrices_, hash, std::move(values), std::equal_to<MatDbl>());
+}
+
+//######################################################################
+/**Interns a list of sparse matrices, such as the transfer matrices of all
+ * the scattering moments. The matrices are compressed since the interned
+ * copy is read-only.*/
+std::shared_ptr<const chi_physics::MGXSStoragePool::SparseMatrices>
+chi_physics::MGXSStoragePool::Intern(SparseMatrices&& matrices)
+{
+  size_t hash = matrices.size();
+  for (auto& matrix : matrices)
+  {
+    matrix.Compress();
+    HashCombine(hash, matrix.NumRows());
+    HashCombine(hash, matrix.NumCols());
+    for (size_t i = 0; i < matrix.rowI_indices_.size(); ++i)
+    {
+      for (size_t j : matrix.rowI_indices_[i])
+        HashCombine(hash, j);
+      HashCombine(hash, HashValues(matrix.rowI_values_[i]));
+    }
+  }
+  return Intern(sparse_matrices_, hash, std::move(matrices), SameMatrices);
+}
+
+//######################################################################
+/**Returns the number of distinct blocks currently in use.*/
+size_t chi_physics::MGXSStoragePool::NumBlocks() const
+{
+  size_t count = 0;
+  for (const auto& entry : vectors_)
+    if (not entry.second.expired()) ++count;
+  for (const auto& entry : matrices_)
+    if (not entry.second.expired()) ++count;
+  for (const auto& entry : sparse_matrices_)
+    if (not entry.second.expired()) ++count;
+  return count;
+}
@@ -0,0 +1,59 @@
+#ifndef CHI_PHYSICS_MGXS_STORAGE_POOL_H
+#define CHI_PHYSICS_MGXS_STORAGE_POOL_H
+
+#include "math/SparseMatrix/chi_math_sparse_matrix.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace chi_physics
+{
+
+//######################################################################
+/**Process wide pool of cross section data shared by all the
+ * multi-group cross sections. Interning a block of data returns a shared,
+ * read-only copy which is reused for every other block with the same
+ * contents, such as the group structure, inverse velocities and transfer
+ * matrices common to many materials of a library.
+ *
+ * The pool only holds weak references, hence a block is released when the
+ * last cross section using it is destroyed.*/
+class MGXSStoragePool
+{
+public:
+  typedef std::vector<double> VecDbl;
+  typedef std::vector<VecDbl> MatDbl;
+  typedef std::vector<chi_math::SparseMatrix> SparseMatrices;
+
+private:
+  template <typename T>
+  using Entries = std::unordered_multimap<size_t, std::weak_ptr<const T>>;
+
+  Entries<VecDbl> vectors_;
+  Entries<MatDbl> matrices_;
+  Entries<SparseMatrices> sparse_matrices_;
+
+  MGXSStoragePool() = default;
+
+public:
+  MGXSStoragePool(const MGXSStoragePool&) = delete;
+  MGXSStoragePool& operator=(const MGXSStoragePool&) = delete;
+
+  static MGXSStoragePool& GetInstance() noexcept;
+
+  std::shared_ptr<const VecDbl> Intern(VecDbl&& values);
+  std::shared_ptr<const MatDbl> Intern(MatDbl&& values);
+  std::shared_ptr<const SparseMatrices> Intern(SparseMatrices&& matrices);
+
+  /**Returns the number of distinct blocks currently in use.*/
+  size_t NumBlocks() const;
+
+private:
+  template <typename T, typename Equal>
+  static std::shared_ptr<const T>
+  Intern(Entries<T>& entries, size_t hash, T&& values, Equal equal);
+};
+
+}//namespace chi_physics
+
+#endif //CHI_PHYSICS_MGXS_STORAGE_POOL_H
@@ -0,0 +1,251 @@
+#include "multi_state_mgxs.h"
+
+#include "utils/chi_memory_accounting.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <algorithm>
+
+
+//######################################################################
+/**Adds a tabulated state at the given temperature. All the states must
+ * share the group structure, the number of precursors and whether they are
+ * fissionable. The current state is re-evaluated afterwards.*/
+void chi_physics::MultiStateMGXS::
+  AddState(double temperature, std::shared_ptr<const MultiGroupXS> xs)
+{
+  ChiInvalidArgumentIf(not xs, "Null cross sections supplied.");
+
+  if (not states_.empty())
+  {
+    const auto& ref_xs = *states_.front().xs;
+    ChiInvalidArgumentIf(xs->NumGroups() != ref_xs.NumGroups(),
+                         "All the states must have the same number of "
+                         "groups.");
+    ChiInvalidArgumentIf(xs->NumPrecursors() != ref_xs.NumPrecursors(),
+                         "All the states must have the same number of "
+                         "precursors.");
+    ChiInvalidArgumentIf(xs->IsFissionable() != ref_xs.IsFissionable(),
+                         "Either all or none of the states must be "
+                         "fissionable.");
+  }
+
+  auto it = std::lower_bound(
+    states_.begin(), states_.end(), temperature,
+    [](const State& state, double T) { return state.temperature < T; });
+  ChiInvalidArgumentIf(it != states_.end() and it->temperature == temperature,
+                       "A state already exists at temperature " +
+                         std::to_string(temperature) + ".");
+
+  State state;
+  state.temperature = temperature;
+  state.xs = std::move(xs);
+  if (state.xs->IsFissionable())
+    state.production_matrix = state.xs->ProductionMatrix();
+  states_.insert(it, std::move(state));
+
+  //============================================= Properties of the table
+  num_groups_ = states_.front().xs->NumGroups();
+  num_precursors_ = states_.front().xs->NumPrecursors();
+  is_fissionable_ = states_.front().xs->IsFissionable();
+  scattering_order_ = 0;
+  diffusion_initialized_ = true;
+  for (const auto& s : states_)
+  {
+    scattering_order_ = std::max(scattering_order_, s.xs->ScatteringOrder());
+    diffusion_initialized_ &= s.xs->DiffusionInitialized();
+  }
+
+  BuildTransferPattern();
+
+  if (states_.size() == 1) temperature_ = temperature;
+  SetState(temperature_, density_scale_);
+}
+
+//######################################################################
+/**Builds the transfer matrices with the union sparsity pattern of all the
+ * states and aligns the values of each state to that pattern. Moments
+ * beyond the scattering order of a state are zero for that state.*/
+void chi_physics::MultiStateMGXS::BuildTransferPattern()
+{
+  const size_t G = num_groups_;
+
+  transfer_matrices_.clear();
+  for (unsigned int ell = 0; ell <= scattering_order_; ++ell)
+  {
+    chi_math::SparseMatrix pattern(G, G);
+    for (const auto& state : states_)
+    {
+      if (ell >= state.xs->TransferMatrices().size()) continue;
+      const auto& S = state.xs->TransferMatrix(ell);
+      for (size_t g = 0; g < G; ++g)
+        for (size_t gp : S.rowI_indices_[g])
+          pattern.InsertAdd(g, gp, 0.0);
+    }
+    pattern.Compress();
+    transfer_matrices_.push_back(pattern);
+  }
+
+  for (auto& state : states_)
+  {
+    const auto& S_list = state.xs->TransferMatrices();
+    state.transfer_values.assign(scattering_order_ + 1, MatDbl(G));
+    for (unsigned int ell = 0; ell <= scattering_order_; ++ell)
+      for (size_t g = 0; g < G; ++g)
+      {
+        const auto& cols = transfer_matrices_[ell].rowI_indices_[g];
+        auto& values = state.transfer_values[ell][g];
+        values.assign(cols.size(), 0.0);
+        if (ell >= S_list.size()) continue;
+
+        for (size_t j = 0; j < cols.size(); ++j)
+          values[j] = S_list[ell].ValueIJ(g, cols[j]);
+      }
+  }
+}
+
+//######################################################################
+/**Evaluates the cross sections at the given temperature and density scale
+ * into the buffers of this object. This does not allocate memory after
+ * the first call.*/
+void chi_physics::MultiStateMGXS::
+  SetState(double temperature, double density_scale)
+{
+  ChiLogicalErrorIf(states_.empty(), "No states have been added.");
+  ChiInvalidArgumentIf(density_scale <= 0.0,
+                       "The density scale must be positive.");
+
+  ++revision_;
+  temperature_ = temperature;
+  density_scale_ = density_scale;
+
+  //============================================= Bracketing states
+  size_t s1 = std::upper_bound(
+                states_.begin(), states_.end(), temperature,
+                [](double T, const State& state)
+                { return T < state.temperature; }) - states_.begin();
+  size_t s0 = s1 == 0 ? 0 : s1 - 1;
+  s1 = std::min(s1, states_.size() - 1);
+
+  double w1 = 0.0;
+  if (s1 != s0)
+  {
+    const double T0 = states_[s0].temperature;
+    const double T1 = states_[s1].temperature;
+    w1 = std::clamp((temperature - T0) / (T1 - T0), 0.0, 1.0);
+  }
+  const double w0 = 1.0 - w1;
+
+  const auto& state0 = states_[s0];
+  const auto& state1 = states_[s1];
+  const auto& xs0 = *state0.xs;
+  const auto& xs1 = *state1.xs;
+  const double rho = density_scale;
+
+  // Interpolates the given vectors, treating missing data as zero
+  auto Interpolate = [w0, w1](const VecDbl& v0,
+                              const VecDbl& v1,
+                              double scale,
+                              VecDbl& dest)
+  {
+    const size_t size = std::max(v0.size(), v1.size());
+    dest.resize(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      const double a = i < v0.size() ? v0[i] : 0.0;
+      const double b = i < v1.size() ? v1[i] : 0.0;
+      dest[i] = scale * (w0 * a + w1 * b);
+    }
+  };
+
+  //============================================= Vector data
+  Interpolate(xs0.SigmaTotal(), xs1.SigmaTotal(), rho, sigma_t_);
+  Interpolate(xs0.SigmaAbsorption(), xs1.SigmaAbsorption(), rho, sigma_a_);
+  Interpolate(xs0.SigmaFission(), xs1.SigmaFission(), rho, sigma_f_);
+  Interpolate(xs0.NuSigmaF(), xs1.NuSigmaF(), rho, nu_sigma_f_);
+  Interpolate(
+    xs0.NuPromptSigmaF(), xs1.NuPromptSigmaF(), rho, nu_prompt_sigma_f_);
+  Interpolate(
+    xs0.NuDelayedSigmaF(), xs1.NuDelayedSigmaF(), rho, nu_delayed_sigma_f_);
+  Interpolate(xs0.InverseVelocity(), xs1.InverseVelocity(), 1.0, inv_velocity_);
+
+  //============================================= Transfer matrices
+  for (unsigned int ell = 0; ell <= scattering_order_; ++ell)
+    for (size_t g = 0; g < num_groups_; ++g)
+      Interpolate(state0.transfer_values[ell][g],
+                  state1.transfer_values[ell][g],
+                  rho,
+                  transfer_matrices_[ell].rowI_values_[g]);
+  for (auto& S : transfer_matrices_)
+    S.Compress();
+
+  //============================================= Production matrix
+  production_matrix_.resize(state0.production_matrix.size());
+  for (size_t g = 0; g < production_matrix_.size(); ++g)
+    Interpolate(state0.production_matrix[g],
+                state1.production_matrix[g],
+                rho,
+                production_matrix_[g]);
+  production_.SetMatrix(production_matrix_);
+
+  //============================================= Precursors
+  const auto& precursors0 = xs0.Precursors();
+  const auto& precursors1 = xs1.Precursors();
+  precursors_.resize(precursors0.size());
+  for (size_t j = 0; j < precursors_.size(); ++j)
+  {
+    const auto& p0 = precursors0[j];
+    const auto& p1 = precursors1[j];
+    auto& precursor = precursors_[j];
+    precursor.decay_constant =
+      w0 * p0.decay_constant + w1 * p1.decay_constant;
+    precursor.fractional_yield =
+      w0 * p0.fractional_yield + w1 * p1.fractional_yield;
+    Interpolate(p0.emission_spectrum,
+                p1.emission_spectrum,
+                1.0,
+                precursor.emission_spectrum);
+  }
+
+  //============================================= Diffusion quantities
+  if (diffusion_initialized_)
+  {
+    const auto& D0 = xs0.DiffusionCoefficient();
+    const auto& D1 = xs1.DiffusionCoefficient();
+    diffusion_coeff_.resize(num_groups_);
+    for (size_t g = 0; g < num_groups_; ++g)
+      diffusion_coeff_[g] = 1.0 / (rho * (w0 / D0[g] + w1 / D1[g]));
+
+    Interpolate(xs0.SigmaRemoval(), xs1.SigmaRemoval(), rho, sigma_removal_);
+    Interpolate(xs0.SigmaSGtoG(), xs1.SigmaSGtoG(), rho, sigma_s_gtog_);
+  }
+}
+
+//######################################################################
+size_t chi_physics::MultiStateMGXS::GetMemoryUsage() const
+{
+  using chi::VectorMemoryUsage;
+  size_t num_bytes =
+    VectorMemoryUsage(states_) + VectorMemoryUsage(sigma_t_) +
+    VectorMemoryUsage(sigma_a_) + VectorMemoryUsage(sigma_f_) +
+    VectorMemoryUsage(nu_sigma_f_) + VectorMemoryUsage(nu_prompt_sigma_f_) +
+    VectorMemoryUsage(nu_delayed_sigma_f_) + VectorMemoryUsage(inv_velocity_) +
+    VectorMemoryUsage(transfer_matrices_) +
+    VectorMemoryUsage(production_matrix_) + production_.GetMemoryUsage() +
+    VectorMemoryUsage(precursors_) + VectorMemoryUsage(diffusion_coeff_) +
+    VectorMemoryUsage(sigma_removal_) + VectorMemoryUsage(sigma_s_gtog_);
+
+  for (const auto& matrix : transfer_matrices_)
+    num_bytes += matrix.GetMemoryUsage();
+  for (const auto& precursor : precursors_)
+    num_bytes += VectorMemoryUsage(precursor.emission_spectrum);
+  for (const auto& state : states_)
+  {
+    num_bytes += VectorMemoryUsage(state.transfer_values) +
+                 VectorMemoryUsage(state.production_matrix);
+    if (state.xs) num_bytes += state.xs->GetMemoryUsage();
+  }
+
+  return num_bytes;
+}
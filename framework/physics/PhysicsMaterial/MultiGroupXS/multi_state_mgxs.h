@@ -0,0 +1,156 @@
+#ifndef CHI_PHYSICS_MULTI_STATE_MGXS_H
+#define CHI_PHYSICS_MULTI_STATE_MGXS_H
+
+#include "multigroup_xs.h"
+
+#include <memory>
+
+namespace chi_physics
+{
+
+//######################################################################
+/**
+ * A class for multi-group cross sections tabulated at several temperatures.
+ *
+ * The cross sections of the current state are interpolated linearly, in
+ * temperature, between the two bracketing tabulated states and scaled by a
+ * density ratio. Temperatures outside the table are clamped to it. The
+ * interpolated data is held in buffers that are reused by every call to
+ * SetState, hence the references handed out by the accessors, and therefore
+ * the views that solvers hold on this object, remain valid when the state
+ * changes. Only the data changes, which is signalled by Revision().
+ *
+ * The macroscopic cross sections and transfer and production matrices are
+ * scaled by the density ratio. The inverse velocities and precursor data
+ * are not. The diffusion coefficient is interpolated in its reciprocal,
+ * i.e. in the transport cross section.
+ */
+class MultiStateMGXS : public MultiGroupXS
+{
+private:
+  typedef std::vector<double> VecDbl;
+  typedef std::vector<VecDbl> MatDbl;
+
+  /**A tabulated state with its data aligned to the union sparsity
+   * pattern of the transfer matrices.*/
+  struct State
+  {
+    double temperature = 0.0;
+    std::shared_ptr<const MultiGroupXS> xs;
+    /**Values of transfer matrix ell, row g, aligned to the pattern.*/
+    std::vector<MatDbl> transfer_values;
+    MatDbl production_matrix;
+  };
+
+  std::vector<State> states_; ///< Sorted by temperature
+
+  double temperature_ = 0.0;
+  double density_scale_ = 1.0;
+
+  unsigned int num_groups_ = 0;
+  unsigned int scattering_order_ = 0;
+  unsigned int num_precursors_ = 0;
+  bool is_fissionable_ = false;
+  bool diffusion_initialized_ = false;
+
+  VecDbl sigma_t_;
+  VecDbl sigma_a_;
+  VecDbl sigma_f_;
+  VecDbl nu_sigma_f_;
+  VecDbl nu_prompt_sigma_f_;
+  VecDbl nu_delayed_sigma_f_;
+  VecDbl inv_velocity_;
+  std::vector<chi_math::SparseMatrix> transfer_matrices_;
+  MatDbl production_matrix_;
+  ProductionOperator production_;
+  std::vector<Precursor> precursors_;
+
+  VecDbl diffusion_coeff_;
+  VecDbl sigma_removal_;
+  VecDbl sigma_s_gtog_;
+
+public:
+  MultiStateMGXS() = default;
+
+  void AddState(double temperature, std::shared_ptr<const MultiGroupXS> xs);
+  void SetState(double temperature, double density_scale = 1.0);
+
+  double Temperature() const { return temperature_; }
+  double DensityScale() const { return density_scale_; }
+  size_t NumStates() const { return states_.size(); }
+
+private:
+  void BuildTransferPattern();
+
+public:
+  //Accessors
+  const unsigned int NumGroups() const override { return num_groups_; }
+
+  const unsigned int ScatteringOrder() const override
+  { return scattering_order_; }
+
+  const unsigned int NumPrecursors() const override { return num_precursors_; }
+
+  const bool IsFissionable() const override { return is_fissionable_; }
+
+  const bool DiffusionInitialized() const override
+  { return diffusion_initialized_; }
+
+  /**Monte-Carlo scattering data is not interpolated.*/
+  const bool ScatteringInitialized() const override { return false; }
+
+  const std::vector<double>& SigmaTotal() const override { return sigma_t_; }
+  const std::vector<double>& SigmaAbsorption() const override { return sigma_a_; }
+  const std::vector<double>& SigmaFission() const override { return sigma_f_; }
+
+  const std::vector<double>& NuSigmaF() const override { return nu_sigma_f_; }
+
+  const std::vector<double>& NuPromptSigmaF() const override
+  { return nu_prompt_sigma_f_; }
+
+  const std::vector<double>& NuDelayedSigmaF() const override
+  { return nu_delayed_sigma_f_; }
+
+  const std::vector<double>& InverseVelocity() const override
+  { return inv_velocity_; }
+
+  const std::vector<chi_math::SparseMatrix>& TransferMatrices() const override
+  { return transfer_matrices_; }
+
+  const chi_math::SparseMatrix& TransferMatrix(unsigned int ell) const override
+  { return transfer_matrices_.at(ell); }
+
+  const std::vector<std::vector<double>> ProductionMatrix() const override
+  { return production_matrix_; }
+
+  const ProductionOperator& Production() const override
+  { return production_; }
+
+  const std::vector<Precursor>& Precursors() const override
+  { return precursors_; }
+
+  const std::vector<double>& DiffusionCoefficient() const override
+  { return diffusion_coeff_; }
+
+  std::vector<double> SigmaTransport() const override
+  {
+    std::vector<double> sigma_tr(num_groups_, 0.0);
+    for (size_t g = 0; g < num_groups_; ++g)
+      sigma_tr[g] = (1.0/diffusion_coeff_[g])/3.0;
+
+    return sigma_tr;
+  }
+
+  const std::vector<double>& SigmaRemoval() const override
+  { return sigma_removal_; }
+
+  const std::vector<double>& SigmaSGtoG() const override
+  { return sigma_s_gtog_; }
+
+  /**Includes the tabulated states.*/
+  size_t GetMemoryUsage() const override;
+};
+
+}//namespace chi_physics
+
+#endif //CHI_PHYSICS_MULTI_STATE_MGXS_H
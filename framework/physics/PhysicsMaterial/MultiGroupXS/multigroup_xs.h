@@ -3,6 +3,7 @@
 
 #include "physics/PhysicsMaterial/material_property_base.h"
 #include "math/SparseMatrix/chi_math_sparse_matrix.h"
+#include "production_operator.h"
 
 
 namespace chi_physics
@@ -22,13 +23,34 @@ public:
     std::vector<double> emission_spectrum;
   };
 
+protected:
+  /**Incremented whenever the data changes in place.*/
+  size_t revision_ = 0;
+
+public:
   MultiGroupXS()
       : MaterialProperty(PropertyType::TRANSPORT_XSECTIONS)
   {}
 
+  /**Returns a counter that changes whenever the cross sections are
+   * modified in place, which invalidates any data derived from them.*/
+  virtual size_t Revision() const { return revision_; }
+
+  /**Returns a 64-bit hash of the contents of the cross sections, equal for
+   * cross sections holding the same data, for instance on different
+   * locations or for different material ids.*/
+  uint64_t ComputeHash() const;
+
   void ExportToChiXSFile(const std::string& file_name,
                          const double fission_scaling = 1.0) const;
+  void ExportToChiXSBinaryFile(const std::string& file_name,
+                               const double fission_scaling = 1.0) const;
   void PushLuaTable(lua_State* L) const override;
+  /**Pushes the table, with the 1D cross sections as read only buffers
+   * over those of this cross section, which the given owner keeps alive,
+   * instead of tables.*/
+  void PushLuaTable(lua_State* L,
+                    std::shared_ptr<const MultiGroupXS> buffer_owner) const;
 
   virtual const unsigned int NumGroups() const = 0;
 
@@ -64,6 +86,10 @@ public:
 
   virtual const std::vector <std::vector<double>> ProductionMatrix() const = 0;
 
+  /**Returns the production matrix in compact form, for applying it without
+   * a dense copy.*/
+  virtual const ProductionOperator& Production() const = 0;
+
   virtual const std::vector <Precursor>& Precursors() const = 0;
 
   virtual const std::vector<double>& DiffusionCoefficient() const = 0;
@@ -73,6 +99,10 @@ public:
   virtual const std::vector<double>& SigmaRemoval() const = 0;
 
   virtual const std::vector<double>& SigmaSGtoG() const = 0;
+
+  /**Returns the number of bytes held by the cross section data. Data
+   * shared between cross sections is counted for each of them.*/
+  virtual size_t GetMemoryUsage() const = 0;
 };
 
 }//namespace chi_physics
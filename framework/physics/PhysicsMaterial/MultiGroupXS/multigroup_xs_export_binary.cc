@@ -0,0 +1,134 @@
+#include "multigroup_xs.h"
+#include "mgxs_binary_format.h"
+
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <fstream>
+
+//###################################################################
+/**
+ * Exports the cross section information to the binary ChiXS format, which
+ * can be loaded without parsing with
+ * SingleStateMGXS::MakeFromChiXSBinaryFile. See mgxs_binary_format.h for
+ * the layout.
+ *
+ * Only location 0 writes the file.
+ *
+ * \param file_name The name of the file to save the cross sections to.
+ * \param fission_scaling A factor to scale fission data to, as in
+ *      ExportToChiXSFile.
+ */
+void chi_physics::MultiGroupXS::
+ExportToChiXSBinaryFile(const std::string& file_name,
+                        const double fission_scaling /* = 1.0 */) const
+{
+  Chi::log.Log() << "Exporting transport cross section to binary file: "
+                 << file_name;
+
+  //the file is shared, hence only the home location writes it
+  if (Chi::mpi.location_id != 0) return;
+
+  namespace bin = mgxs_binary;
+  chi_data_types::ByteArray buffer;
+
+  /**Lambda to write 1D data, scaled*/
+  auto Write1D = [&buffer](const std::vector<double>& values,
+                           double scaling = 1.0)
+  {
+    buffer.Write<uint64_t>(values.size());
+    for (double value : values)
+      buffer.Write<double>(value * scaling);
+  };
+
+  //============================================================
+  // Header
+  //============================================================
+  for (char c : bin::MAGIC)
+    buffer.Write<char>(c);
+  buffer.Write<uint32_t>(bin::VERSION);
+  buffer.Write<uint32_t>(NumGroups());
+  buffer.Write<uint32_t>(ScatteringOrder());
+  buffer.Write<uint32_t>(NumPrecursors());
+  buffer.Write<uint32_t>(IsFissionable() ? 1 : 0);
+
+  //============================================================
+  // 1D data
+  //============================================================
+  Write1D(SigmaTotal());
+  Write1D(SigmaAbsorption());
+  Write1D(SigmaFission(), fission_scaling);
+  Write1D(NuSigmaF(), fission_scaling);
+  Write1D(NuPromptSigmaF(), fission_scaling);
+  Write1D(NuDelayedSigmaF(), fission_scaling);
+  Write1D(InverseVelocity());
+
+  //============================================================
+  // Transfer matrices
+  //============================================================
+  const auto& transfer_matrices = TransferMatrices();
+  buffer.Write<uint64_t>(transfer_matrices.size());
+  for (const auto& matrix : transfer_matrices)
+    for (size_t g = 0; g < matrix.NumRows(); ++g)
+    {
+      const auto& col_indices = matrix.rowI_indices_[g];
+      const auto& col_values = matrix.rowI_values_[g];
+
+      buffer.Write<uint64_t>(col_indices.size());
+      for (size_t col : col_indices)
+        buffer.Write<uint64_t>(col);
+      for (double value : col_values)
+        buffer.Write<double>(value);
+    }
+
+  //============================================================
+  // Production matrix
+  //============================================================
+  const auto F = ProductionMatrix();
+  std::vector<double> spectrum, nu_sigma_f;
+  if (F.empty())
+    buffer.Write<uint32_t>(static_cast<uint32_t>(bin::ProductionForm::NONE));
+  else if (bin::FactorProductionMatrix(F, spectrum, nu_sigma_f))
+  {
+    buffer.Write<uint32_t>(
+      static_cast<uint32_t>(bin::ProductionForm::FACTORED));
+    Write1D(spectrum);
+    Write1D(nu_sigma_f, fission_scaling);
+  }
+  else
+  {
+    buffer.Write<uint32_t>(static_cast<uint32_t>(bin::ProductionForm::DENSE));
+    for (const auto& row : F)
+      for (double value : row)
+        buffer.Write<double>(value * fission_scaling);
+  }
+
+  //============================================================
+  // Precursors
+  //============================================================
+  for (const auto& precursor : Precursors())
+  {
+    buffer.Write<double>(precursor.decay_constant);
+    buffer.Write<double>(precursor.fractional_yield);
+    Write1D(precursor.emission_spectrum);
+  }
+
+  //============================================================
+  // Write the file
+  //============================================================
+  std::ofstream ofile(file_name, std::ios::binary);
+  if (not ofile.is_open())
+    throw std::runtime_error("Failed to open binary cross section file \"" +
+                             file_name + "\" for writing in call to " +
+                             std::string(__FUNCTION__));
+
+  ofile.write(reinterpret_cast<const char*>(buffer.Data().data()),
+              static_cast<std::streamsize>(buffer.Size()));
+  ofile.close();
+
+  Chi::log.Log0Verbose1() << "Done exporting transport "
+                             "cross section to binary file: " << file_name;
+}
@@ -0,0 +1,69 @@
+#include "multigroup_xs.h"
+
+namespace
+{
+
+//###################################################################
+/**FNV-1a hash accumulator.*/
+class FNV1aHash
+{
+  uint64_t value_ = 14695981039346656037ULL;
+
+public:
+  void Add(const void* data, size_t num_bytes)
+  {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t b = 0; b < num_bytes; ++b)
+    {
+      value_ ^= bytes[b];
+      value_ *= 1099511628211ULL;
+    }
+  }
+
+  template<typename T>
+  void Add(const T& value) { Add(&value, sizeof(T)); }
+
+  void Add(const std::vector<double>& values)
+  {
+    Add(values.size());
+    if (not values.empty())
+      Add(values.data(), values.size() * sizeof(double));
+  }
+
+  uint64_t Value() const { return value_; }
+};
+
+}//namespace
+
+//###################################################################
+/**The hash covers the number of groups, the total, absorption and
+ * production cross sections, the diffusion coefficients, when initialized,
+ * and the entries of the transfer matrices.*/
+uint64_t chi_physics::MultiGroupXS::ComputeHash() const
+{
+  FNV1aHash hash;
+
+  const unsigned int num_groups = NumGroups();
+  hash.Add(num_groups);
+  hash.Add(SigmaTotal());
+  hash.Add(SigmaAbsorption());
+  hash.Add(NuSigmaF());
+
+  const bool diffusion_initialized = DiffusionInitialized();
+  hash.Add(diffusion_initialized);
+  if (diffusion_initialized)
+    hash.Add(DiffusionCoefficient());
+
+  const auto& transfer_matrices = TransferMatrices();
+  hash.Add(transfer_matrices.size());
+  for (const auto& matrix : transfer_matrices)
+    for (size_t g = 0; g < matrix.NumRows(); ++g)
+      for (const auto& [row_g, gprime, sigma] : matrix.Row(g))
+      {
+        hash.Add(row_g);
+        hash.Add(gprime);
+        hash.Add(sigma);
+      }
+
+  return hash.Value();
+}
@@ -1,10 +1,19 @@
 #include "multigroup_xs.h"
 
+#include "lua/lua_buffer.h"
+
 #include "chi_log.h"
 
 //###################################################################
 /**Pushes all of the relevant items of the transport xs to a lua table.*/
 void chi_physics::MultiGroupXS::PushLuaTable(lua_State *L) const
+{
+  PushLuaTable(L, nullptr);
+}
+
+//###################################################################
+void chi_physics::MultiGroupXS::PushLuaTable(
+  lua_State* L, std::shared_ptr<const MultiGroupXS> buffer_owner) const
 {
   //================================================== General data
   lua_newtable(L);
@@ -30,10 +39,19 @@ void chi_physics::MultiGroupXS::PushLuaTable(lua_State *L) const
 
   //================================================== 1D cross sections
   auto Push1DXS =
-      [L](const std::vector<double>& xs,
-          const std::string& name)
+      [L, &buffer_owner](const std::vector<double>& xs,
+                         const std::string& name)
   {
     lua_pushstring(L, name.c_str());
+    if (buffer_owner)
+    {
+      chi_lua::PushBuffer(
+        L,
+        chi_lua::LuaBuffer::FromVector(
+          std::shared_ptr<const std::vector<double>>(buffer_owner, &xs)));
+      lua_settable(L, -3);
+      return;
+    }
     lua_newtable(L);
     {
       unsigned int g = 0;
@@ -0,0 +1,153 @@
+#include "production_operator.h"
+#include "mgxs_binary_format.h"
+
+#include "chi_log_exceptions.h"
+#include "utils/chi_memory_accounting.h"
+
+
+//######################################################################
+/**Sets the operator to the outer product of the given spectrum and
+ * production cross section. Storage is reused.*/
+void chi_physics::ProductionOperator::
+  SetRankOne(const std::vector<double>& spectrum,
+             const std::vector<double>& nu_sigma_f)
+{
+  ChiInvalidArgumentIf(spectrum.size() != nu_sigma_f.size(),
+                       "The spectrum and production cross section must "
+                       "have the same number of groups.");
+
+  num_groups_ = spectrum.size();
+  rank_one_ = true;
+  spectrum_.assign(spectrum.begin(), spectrum.end());
+  nu_sigma_f_.assign(nu_sigma_f.begin(), nu_sigma_f.end());
+  row_offsets_.clear();
+  col_ids_.clear();
+  values_.clear();
+}
+
+//######################################################################
+/**Sets the operator to the given dense production matrix, factored into a
+ * spectrum and a production cross section when possible and otherwise
+ * keeping only its non-zero entries. Storage is reused.*/
+void chi_physics::ProductionOperator::
+  SetMatrix(const std::vector<std::vector<double>>& F)
+{
+  if (F.empty())
+  {
+    Clear();
+    return;
+  }
+
+  if (mgxs_binary::FactorProductionMatrix(F, spectrum_, nu_sigma_f_))
+  {
+    num_groups_ = F.size();
+    rank_one_ = true;
+    row_offsets_.clear();
+    col_ids_.clear();
+    values_.clear();
+    return;
+  }
+
+  num_groups_ = F.size();
+  rank_one_ = false;
+  spectrum_.clear();
+  nu_sigma_f_.clear();
+
+  row_offsets_.assign(1, 0);
+  col_ids_.clear();
+  values_.clear();
+  for (const auto& F_g : F)
+  {
+    ChiInvalidArgumentIf(F_g.size() != num_groups_,
+                         "The production matrix must be square.");
+    for (size_t gp = 0; gp < num_groups_; ++gp)
+      if (F_g[gp] != 0.0)
+      {
+        col_ids_.push_back(gp);
+        values_.push_back(F_g[gp]);
+      }
+    row_offsets_.push_back(col_ids_.size());
+  }
+}
+
+//######################################################################
+/**Removes all production.*/
+void chi_physics::ProductionOperator::Clear()
+{
+  num_groups_ = 0;
+  rank_one_ = false;
+  spectrum_.clear();
+  nu_sigma_f_.clear();
+  row_offsets_.clear();
+  col_ids_.clear();
+  values_.clear();
+}
+
+//######################################################################
+size_t chi_physics::ProductionOperator::GetMemoryUsage() const
+{
+  return chi::VectorMemoryUsage(spectrum_) +
+         chi::VectorMemoryUsage(nu_sigma_f_) +
+         chi::VectorMemoryUsage(row_offsets_) +
+         chi::VectorMemoryUsage(col_ids_) + chi::VectorMemoryUsage(values_);
+}
+
+//######################################################################
+/**Adds the production into groups `g_begin` to `g_end`, from fission in
+ * groups `gp_begin` to `gp_end` (inclusive ranges), to the destination,
+ * i.e. `destination[g] += sum_gp F[g][gp] * phi[gp]`. Both `phi` and
+ * `destination` are indexed by absolute group number. Empty ranges are
+ * allowed.*/
+void chi_physics::ProductionOperator::Apply(const double* phi,
+                                            size_t gp_begin,
+                                            size_t gp_end,
+                                            size_t g_begin,
+                                            size_t g_end,
+                                            double* destination) const
+{
+  if (num_groups_ == 0 or gp_begin > gp_end or g_begin > g_end) return;
+
+  if (rank_one_)
+  {
+    //the fission rate is the same for all destination groups
+    double fission_rate = 0.0;
+    for (size_t gp = gp_begin; gp <= gp_end; ++gp)
+      fission_rate += nu_sigma_f_[gp] * phi[gp];
+
+    for (size_t g = g_begin; g <= g_end; ++g)
+      destination[g] += spectrum_[g] * fission_rate;
+    return;
+  }
+
+  for (size_t g = g_begin; g <= g_end; ++g)
+  {
+    double value = 0.0;
+    for (size_t k = row_offsets_[g]; k < row_offsets_[g + 1]; ++k)
+    {
+      const size_t gp = col_ids_[k];
+      if (gp < gp_begin) continue;
+      if (gp > gp_end) break;
+      value += values_[k] * phi[gp];
+    }
+    destination[g] += value;
+  }
+}
+
+//######################################################################
+/**Expands the operator into a dense matrix.*/
+std::vector<std::vector<double>>
+chi_physics::ProductionOperator::ToMatrix() const
+{
+  std::vector<std::vector<double>> F(num_groups_,
+                                     std::vector<double>(num_groups_, 0.0));
+  for (size_t g = 0; g < num_groups_; ++g)
+  {
+    if (rank_one_)
+      for (size_t gp = 0; gp < num_groups_; ++gp)
+        F[g][gp] = spectrum_[g] * nu_sigma_f_[gp];
+    else
+      for (size_t k = row_offsets_[g]; k < row_offsets_[g + 1]; ++k)
+        F[g][col_ids_[k]] = values_[k];
+  }
+  return F;
+}
@@ -0,0 +1,63 @@
+#ifndef CHI_PHYSICS_PRODUCTION_OPERATOR_H
+#define CHI_PHYSICS_PRODUCTION_OPERATOR_H
+
+#include <cstddef>
+#include <vector>
+
+namespace chi_physics
+{
+
+//######################################################################
+/**Compact form of a multigroup production matrix F, where F[g][g'] is the
+ * production into group g from fission in group g'. Production matrices
+ * built from a single fission spectrum are stored as the outer product of
+ * the spectrum and the production cross section, which needs O(G) storage
+ * and work. Any other matrix is stored in compressed sparse row form.
+ *
+ * The operator is applied, restricted to ranges of source and destination
+ * groups, with Apply, which replaces the dense G x G loops over copies of
+ * the production matrix.*/
+class ProductionOperator
+{
+private:
+  size_t num_groups_ = 0;
+  bool rank_one_ = false;
+
+  //rank-one form
+  std::vector<double> spectrum_;
+  std::vector<double> nu_sigma_f_;
+
+  //sparse form
+  std::vector<size_t> row_offsets_;
+  std::vector<size_t> col_ids_;
+  std::vector<double> values_;
+
+public:
+  ProductionOperator() = default;
+
+  void SetRankOne(const std::vector<double>& spectrum,
+                  const std::vector<double>& nu_sigma_f);
+  void SetMatrix(const std::vector<std::vector<double>>& F);
+  void Clear();
+
+  /**Returns the number of groups, zero when there is no production.*/
+  size_t NumGroups() const { return num_groups_; }
+  /**Returns true when the operator is stored as an outer product.*/
+  bool IsRankOne() const { return rank_one_; }
+
+  void Apply(const double* phi,
+             size_t gp_begin,
+             size_t gp_end,
+             size_t g_begin,
+             size_t g_end,
+             double* destination) const;
+
+  std::vector<std::vector<double>> ToMatrix() const;
+
+  /**Returns the number of bytes held by the operator.*/
+  size_t GetMemoryUsage() const;
+};
+
+}//namespace chi_physics
+
+#endif //CHI_PHYSICS_PRODUCTION_OPERATOR_H
@@ -3,6 +3,10 @@
 
 #include "multigroup_xs.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace chi_physics
 {
 
@@ -23,28 +27,44 @@ protected:
 
   bool is_fissionable_ = false;
 
-  std::vector<std::vector<double>> e_bounds_; ///< Energy bin boundaries in MeV
+  /**Energy bin boundaries in MeV*/
+  std::shared_ptr<const std::vector<std::vector<double>>> e_bounds_;
 
   std::vector<double> sigma_t_;  ///< Total cross section
-  std::vector<double> sigma_a_;  ///< Absorption cross section
+  /**Absorption cross section. Estimated from the transfer matrices on
+   * first access when not supplied.*/
+  mutable std::vector<double> sigma_a_;
   std::vector<double> sigma_f_;  ///< Fission cross section
 
   std::vector<double> nu_sigma_f_;
   std::vector<double> nu_prompt_sigma_f_;
   std::vector<double> nu_delayed_sigma_f_;
 
-  std::vector<double> inv_velocity_;
+  std::shared_ptr<const std::vector<double>> inv_velocity_;
 
-  std::vector<chi_math::SparseMatrix> transfer_matrices_;
-  std::vector<std::vector<double>> production_matrix_;
+  std::shared_ptr<const std::vector<chi_math::SparseMatrix>> transfer_matrices_;
+  /**Dense production matrix. Only stored when the production matrix is
+   * not the outer product of the production spectrum and the production
+   * cross section.*/
+  std::shared_ptr<const std::vector<std::vector<double>>> production_matrix_;
+  std::shared_ptr<const std::vector<double>> production_spectrum_;
+  std::shared_ptr<const std::vector<double>> production_nu_sigma_f_;
 
   std::vector<Precursor> precursors_;
 
-  //Diffusion quantities
-  bool diffusion_initialized_ = false;
-  std::vector<double> diffusion_coeff_; ///< Transport corrected diffusion coeff
-  std::vector<double> sigma_removal_;   ///< Removal cross section
-  std::vector<double> sigma_s_gtog_;    ///< Within-group scattering xs
+  //Diffusion quantities, computed on first access
+  mutable std::atomic<bool> diffusion_initialized_ = false;
+  mutable std::vector<double> diffusion_coeff_; ///< Transport corrected diffusion coeff
+  mutable std::vector<double> sigma_removal_;   ///< Removal cross section
+  mutable std::vector<double> sigma_s_gtog_;    ///< Within-group scattering xs
+
+  mutable std::atomic<bool> absorption_initialized_ = false;
+
+  mutable std::atomic<bool> production_initialized_ = false;
+  mutable ProductionOperator production_;
+  /**Guards the quantities derived on first access, which can be requested
+   * concurrently.*/
+  mutable std::mutex derived_data_mutex_;
 
   //Monte-Carlo quantities
 protected:
@@ -59,7 +79,7 @@ public:
       MultiGroupXS(),
       num_groups_(0), scattering_order_(0), num_precursors_(0),
       diffusion_initialized_(false), scattering_initialized_(false)
-  {}
+  { Clear(); }
 
   //00
   void MakeSimple0(unsigned int num_groups, double sigma_t);
@@ -72,11 +92,14 @@ private:
 public:
   //01
   void MakeFromChiXSFile(const std::string &file_name);
+  //03
+  void MakeFromChiXSBinaryFile(const std::string& file_name);
 
 private:
   //02
-  void ComputeAbsorption();
-  void ComputeDiffusionParameters();
+  void ComputeAbsorption() const;
+  void ComputeDiffusionParameters() const;
+  void ComputeProduction() const;
 
 public:
   //Accessors
@@ -89,14 +112,19 @@ public:
 
   const bool IsFissionable() const override { return is_fissionable_; }
 
-  const bool DiffusionInitialized() const override
-  { return diffusion_initialized_; }
+  /**The diffusion quantities are available, on demand, as soon as the
+   * cross sections are.*/
+  const bool DiffusionInitialized() const override { return num_groups_ > 0; }
 
   const bool ScatteringInitialized() const override
   { return scattering_initialized_; }
 
   const std::vector<double>& SigmaTotal() const override { return sigma_t_; }
-  const std::vector<double>& SigmaAbsorption() const override { return sigma_a_; }
+  const std::vector<double>& SigmaAbsorption() const override
+  {
+    if (not absorption_initialized_) ComputeAbsorption();
+    return sigma_a_;
+  }
   const std::vector<double>& SigmaFission() const override { return sigma_f_; }
 
   const std::vector<double>& NuSigmaF() const override { return nu_sigma_f_; }
@@ -108,37 +136,54 @@ public:
   { return nu_delayed_sigma_f_; }
 
   const std::vector<double>& InverseVelocity() const override
-  { return inv_velocity_; }
+  { return *inv_velocity_; }
 
   const std::vector<chi_math::SparseMatrix>& TransferMatrices() const override
-  { return transfer_matrices_; }
+  { return *transfer_matrices_; }
 
   const chi_math::SparseMatrix& TransferMatrix(unsigned int ell) const override
-  { return transfer_matrices_.at(ell); }
+  { return transfer_matrices_->at(ell); }
+
+  const std::vector<std::vector<double>> ProductionMatrix() const override;
 
-  const std::vector<std::vector<double>> ProductionMatrix() const override
-  { return production_matrix_; }
+  const ProductionOperator& Production() const override
+  {
+    if (not production_initialized_) ComputeProduction();
+    return production_;
+  }
 
   const std::vector<Precursor>& Precursors() const override
   { return precursors_; }
 
   const std::vector<double>& DiffusionCoefficient() const override
-  { return diffusion_coeff_; }
+  {
+    if (not diffusion_initialized_) ComputeDiffusionParameters();
+    return diffusion_coeff_;
+  }
 
   std::vector<double> SigmaTransport() const override
   {
+    const auto& diffusion_coeff = DiffusionCoefficient();
     std::vector<double> sigma_tr(num_groups_, 0.0);
     for (size_t g = 0; g < num_groups_; ++g)
-      sigma_tr[g] = (1.0/diffusion_coeff_[g])/3.0;
+      sigma_tr[g] = (1.0/diffusion_coeff[g])/3.0;
 
     return sigma_tr;
   }
 
   const std::vector<double>& SigmaRemoval() const override
-  { return sigma_removal_; }
+  {
+    if (not diffusion_initialized_) ComputeDiffusionParameters();
+    return sigma_removal_;
+  }
 
   const std::vector<double>& SigmaSGtoG() const override
-  { return sigma_s_gtog_; }
+  {
+    if (not diffusion_initialized_) ComputeDiffusionParameters();
+    return sigma_s_gtog_;
+  }
+
+  size_t GetMemoryUsage() const override;
 };
 
 }//namespace chi_physics
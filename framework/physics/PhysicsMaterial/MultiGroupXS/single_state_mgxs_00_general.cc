@@ -1,4 +1,6 @@
 #include "single_state_mgxs.h"
+#include "mgxs_storage_pool.h"
+#include "utils/chi_memory_accounting.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -9,6 +11,9 @@
 //######################################################################
 void chi_physics::SingleStateMGXS::Clear()
 {
+  auto& pool = MGXSStoragePool::GetInstance();
+
+  ++revision_;
   num_groups_ = 0;
   scattering_order_ = 0;
   num_precursors_ = 0;
@@ -22,14 +27,20 @@ void chi_physics::SingleStateMGXS::Clear()
   nu_prompt_sigma_f_.clear();
   nu_delayed_sigma_f_.clear();
 
-  inv_velocity_.clear();
+  e_bounds_ = pool.Intern(std::vector<std::vector<double>>());
+  inv_velocity_ = pool.Intern(std::vector<double>());
 
-  transfer_matrices_.clear();
-  production_matrix_.clear();
+  transfer_matrices_ = pool.Intern(std::vector<chi_math::SparseMatrix>());
+  production_matrix_ = pool.Intern(std::vector<std::vector<double>>());
+  production_spectrum_ = nullptr;
+  production_nu_sigma_f_ = nullptr;
+  production_initialized_ = false;
+  production_.Clear();
 
   precursors_.clear();
 
   //Diffusion quantities
+  absorption_initialized_ = false;
   diffusion_initialized_ = false;
   diffusion_coeff_.clear();
   sigma_removal_.clear();
@@ -52,8 +63,6 @@ MakeSimple0(unsigned int num_groups, double sigma_t)
   num_groups_ = num_groups;
   sigma_t_.resize(num_groups, sigma_t);
   sigma_a_.resize(num_groups, sigma_t);
-
-  ComputeDiffusionParameters();
 }
 
 
@@ -70,13 +79,14 @@ MakeSimple1(unsigned int num_groups, double sigma_t, double c)
 
   num_groups_ = num_groups;
   sigma_t_.resize(num_groups, sigma_t);
-  transfer_matrices_.emplace_back(num_groups, num_groups);
+  std::vector<chi_math::SparseMatrix> transfer_matrices;
+  transfer_matrices.emplace_back(num_groups, num_groups);
 
   // When multi-group, assign half the scattering cross section
   // to within-group scattering. The other half will be used for
   // up/down-scattering.
 
-  auto& S = transfer_matrices_.back();
+  auto& S = transfer_matrices.back();
   double scale = (num_groups_ == 1) ? 1.0 : 0.5;
   S.SetDiagonal(std::vector<double>(num_groups, sigma_t * c * scale));
 
@@ -110,8 +120,8 @@ MakeSimple1(unsigned int num_groups, double sigma_t, double c)
     }
   }//for g
 
-  ComputeAbsorption();
-  ComputeDiffusionParameters();
+  transfer_matrices_ =
+    MGXSStoragePool::GetInstance().Intern(std::move(transfer_matrices));
 }
 
 
@@ -194,18 +204,21 @@ MakeCombined(std::vector<std::pair<int, double> > &combinations)
 
   //init transfer matrices only if at least one exists
   using XSPtr = chi_physics::MultiGroupXSPtr;
+  std::vector<chi_math::SparseMatrix> transfer_matrices;
   if (std::any_of(xsecs.begin(), xsecs.end(),
                   [](const XSPtr& x)
                   { return not x->TransferMatrices().empty(); }))
-    transfer_matrices_.assign(scattering_order_ + 1,
-                              chi_math::SparseMatrix(num_groups_, num_groups_));
+    transfer_matrices.assign(scattering_order_ + 1,
+                             chi_math::SparseMatrix(num_groups_, num_groups_));
 
   //init fission data
+  std::vector<std::vector<double>> production_matrix;
+  std::vector<double> inv_velocity;
   if (is_fissionable_)
   {
     sigma_f_.assign(n_grps, 0.0);
     nu_sigma_f_.assign(n_grps, 0.0);
-    production_matrix_.assign(
+    production_matrix.assign(
         num_groups_, std::vector<double>(num_groups_, 0.0));
 
     //init prompt/delayed fission data
@@ -255,7 +268,7 @@ MakeCombined(std::vector<std::pair<int, double> > &combinations)
         sigma_f_[g] += sig_f[g] * N_i;
         nu_sigma_f_[g] += sig_f[g] * N_i;
         for (unsigned int gp = 0; gp < num_groups_; ++gp)
-          production_matrix_[g][gp] += F[g][gp] * N_i;
+          production_matrix[g][gp] += F[g][gp] * N_i;
 
         if (n_precs > 0)
         {
@@ -298,8 +311,8 @@ MakeCombined(std::vector<std::pair<int, double> > &combinations)
     //============================================================
 
     if (x == 0 && !xsecs[x]->InverseVelocity().empty())
-      inv_velocity_ = xsecs[x]->InverseVelocity();
-    else if (xsecs[x]->InverseVelocity() != inv_velocity_)
+      inv_velocity = xsecs[x]->InverseVelocity();
+    else if (xsecs[x]->InverseVelocity() != inv_velocity)
       throw std::logic_error(
           "Invalid cross sections encountered.\n"
           "All cross sections being combined must share a group "
@@ -319,18 +332,75 @@ MakeCombined(std::vector<std::pair<int, double> > &combinations)
     {
       for (unsigned int m = 0; m < xsecs[x]->ScatteringOrder() + 1; ++m)
       {
-        auto& Sm = transfer_matrices_[m];
+        auto& Sm = transfer_matrices[m];
         const auto& Sm_other = xsecs[x]->TransferMatrix(m);
         for (unsigned int g = 0; g < num_groups_; ++g)
         {
-          const auto& cols = Sm_other.rowI_indices_[g];
-          const auto& vals = Sm_other.rowI_values_[g];
-          for (size_t t = 0; t < cols.size(); ++t)
-            Sm.InsertAdd(g, t, vals[t] * N_i);
+          const auto row = Sm_other.RowSpan(g);
+          for (size_t t = 0; t < row.size; ++t)
+            Sm.InsertAdd(g, row.column_indices[t], row.values[t] * N_i);
         }
       }
     }
   }//for cross sections
 
-  ComputeDiffusionParameters();
+  auto& pool = MGXSStoragePool::GetInstance();
+  inv_velocity_ = pool.Intern(std::move(inv_velocity));
+  transfer_matrices_ = pool.Intern(std::move(transfer_matrices));
+  production_matrix_ = pool.Intern(std::move(production_matrix));
+}
+
+//######################################################################
+/**Returns the production matrix, expanding it from the production
+ * spectrum and production cross section when it is not stored densely.*/
+const std::vector<std::vector<double>>
+chi_physics::SingleStateMGXS::ProductionMatrix() const
+{
+  if (not production_spectrum_) return *production_matrix_;
+
+  const auto& chi = *production_spectrum_;
+  const auto& nu_sigma_f = *production_nu_sigma_f_;
+
+  std::vector<std::vector<double>> F(num_groups_,
+                                     std::vector<double>(num_groups_, 0.0));
+  for (unsigned int g = 0; g < num_groups_; ++g)
+    for (unsigned int gp = 0; gp < num_groups_; ++gp)
+      F[g][gp] = chi[g] * nu_sigma_f[gp];
+
+  return F;
+}
+
+//######################################################################
+size_t chi_physics::SingleStateMGXS::GetMemoryUsage() const
+{
+  using chi::VectorMemoryUsage;
+  std::lock_guard<std::mutex> lock(derived_data_mutex_);
+
+  size_t num_bytes =
+    VectorMemoryUsage(sigma_t_) + VectorMemoryUsage(sigma_a_) +
+    VectorMemoryUsage(sigma_f_) + VectorMemoryUsage(nu_sigma_f_) +
+    VectorMemoryUsage(nu_prompt_sigma_f_) +
+    VectorMemoryUsage(nu_delayed_sigma_f_) + VectorMemoryUsage(precursors_) +
+    VectorMemoryUsage(diffusion_coeff_) + VectorMemoryUsage(sigma_removal_) +
+    VectorMemoryUsage(sigma_s_gtog_) + production_.GetMemoryUsage() +
+    VectorMemoryUsage(cdf_gprime_g_) + VectorMemoryUsage(scat_angles_gprime_g_);
+
+  for (const auto& precursor : precursors_)
+    num_bytes += VectorMemoryUsage(precursor.emission_spectrum);
+
+  if (e_bounds_) num_bytes += VectorMemoryUsage(*e_bounds_);
+  if (inv_velocity_) num_bytes += VectorMemoryUsage(*inv_velocity_);
+  if (transfer_matrices_)
+  {
+    num_bytes += VectorMemoryUsage(*transfer_matrices_);
+    for (const auto& matrix : *transfer_matrices_)
+      num_bytes += matrix.GetMemoryUsage();
+  }
+  if (production_matrix_) num_bytes += VectorMemoryUsage(*production_matrix_);
+  if (production_spectrum_)
+    num_bytes += VectorMemoryUsage(*production_spectrum_);
+  if (production_nu_sigma_f_)
+    num_bytes += VectorMemoryUsage(*production_nu_sigma_f_);
+
+  return num_bytes;
 }
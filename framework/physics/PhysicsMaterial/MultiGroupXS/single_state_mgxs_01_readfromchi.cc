@@ -1,4 +1,5 @@
 #include "single_state_mgxs.h"
+#include "mgxs_storage_pool.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -257,6 +258,11 @@ void chi_physics::SingleStateMGXS::
   std::vector<double> nu, nu_prompt, nu_delayed, beta;
   std::vector<double> chi, chi_prompt;
 
+  std::vector<std::vector<double>> e_bounds;
+  std::vector<double> inv_velocity;
+  std::vector<chi_math::SparseMatrix> transfer_matrices;
+  std::vector<std::vector<double>> production_matrix;
+
   std::string word, line;
   unsigned int line_number = 0;
   while (std::getline(file, line))
@@ -315,29 +321,29 @@ void chi_physics::SingleStateMGXS::
 
       if (fw == "GROUP_STRUCTURE_BEGIN")
         ReadGroupStructure("GROUP_STRUCTURE",
-                           e_bounds_, num_groups_, f, ls, ln);
+                           e_bounds, num_groups_, f, ls, ln);
 
       if (fw == "INV_VELOCITY_BEGIN")
       {
-        Read1DData("INV_VELOCITY", inv_velocity_, num_groups_, f, ls, ln);
+        Read1DData("INV_VELOCITY", inv_velocity, num_groups_, f, ls, ln);
 
-        if (not IsPositive(inv_velocity_))
+        if (not IsPositive(inv_velocity))
           throw std::logic_error(
               "Invalid inverse velocity value encountered.\n"
               "Only strictly positive values are permitted.");
       }
-      if (fw == "VELOCITY_BEGIN" and inv_velocity_.empty())
+      if (fw == "VELOCITY_BEGIN" and inv_velocity.empty())
       {
-        Read1DData("VELOCITY", inv_velocity_, num_groups_, f, ls, ln);
+        Read1DData("VELOCITY", inv_velocity, num_groups_, f, ls, ln);
 
-        if (not IsPositive(inv_velocity_))
+        if (not IsPositive(inv_velocity))
           throw std::logic_error(
               "Invalid velocity value encountered.\n"
               "Only strictly positive values are permitted.");
 
         //compute inverse
         for (unsigned int g = 0; g < num_groups_; ++g)
-          inv_velocity_[g] = 1.0 / inv_velocity_[g];
+          inv_velocity[g] = 1.0 / inv_velocity[g];
       }
 
       //==================================================
@@ -634,12 +640,12 @@ void chi_physics::SingleStateMGXS::
       //==================================================
 
       if (fw == "TRANSFER_MOMENTS_BEGIN")
-        ReadTransferMatrices("TRANSFER_MOMENTS", transfer_matrices_,
+        ReadTransferMatrices("TRANSFER_MOMENTS", transfer_matrices,
                              scattering_order_ + 1, num_groups_, f, ls, ln);
 
       if (fw == "PRODUCTION_MATRIX_BEGIN")
         Read2DData("PRODUCTION_MATRIX", "GPRIME_G_VAL",
-                   production_matrix_, num_groups_, num_groups_, f, ls, ln);
+                   production_matrix, num_groups_, num_groups_, f, ls, ln);
     }//try
 
     catch (const std::runtime_error& err)
@@ -671,9 +677,14 @@ void chi_physics::SingleStateMGXS::
   }//while not EOF, read each lines
   file.close();
 
-  if (sigma_a_.empty())
-    ComputeAbsorption();
-  ComputeDiffusionParameters();
+  //shared data
+  auto& pool = MGXSStoragePool::GetInstance();
+  e_bounds_ = pool.Intern(std::move(e_bounds));
+  inv_velocity_ = pool.Intern(std::move(inv_velocity));
+  transfer_matrices_ = pool.Intern(std::move(transfer_matrices));
+
+  // Absorption, when not supplied, and the diffusion quantities are
+  // computed on first access
 
   //============================================================
   // Compute and check fission data
@@ -681,7 +692,7 @@ void chi_physics::SingleStateMGXS::
 
   //determine if the material is fissionable
   is_fissionable_ = not sigma_f_.empty() or not nu_sigma_f_.empty() or
-                    not production_matrix_.empty();
+                    not production_matrix.empty();
 
   //clear fission data if not fissionable
   if (not is_fissionable_)
@@ -697,7 +708,7 @@ void chi_physics::SingleStateMGXS::
   else
   {
     //check vector data inputs
-    if (production_matrix_.empty())
+    if (production_matrix.empty())
     {
       //check for non-delayed fission neutron yield data
       if (nu.empty() and nu_prompt.empty())
@@ -813,18 +824,14 @@ void chi_physics::SingleStateMGXS::
           nu_delayed_sigma_f_[g] = nu_delayed[g] * sigma_f_[g];
       }
 
-      //compute production matrix
-      const auto chi_ = not chi_prompt.empty()? chi_prompt : chi;
-      const auto nu_sigma_f =
+      //set the production matrix, which is the outer product of the
+      //spectrum and the production cross section, in factored form
+      auto chi_ = not chi_prompt.empty()? chi_prompt : chi;
+      auto nu_sigma_f =
           not nu_prompt.empty() ? nu_prompt_sigma_f_ : nu_sigma_f_;
 
-      for (unsigned int g = 0; g < num_groups_; ++g)
-      {
-        std::vector<double> prod;
-        for (unsigned int gp = 0.0; gp < num_groups_; ++gp)
-          prod.push_back(chi_[g] * nu_sigma_f[gp]);
-        production_matrix_.push_back(prod);
-      }
+      production_spectrum_ = pool.Intern(std::move(chi_));
+      production_nu_sigma_f_ = pool.Intern(std::move(nu_sigma_f));
     }//if production_matrix empty
 
     else
@@ -852,7 +859,7 @@ void chi_physics::SingleStateMGXS::
       nu_sigma_f_.assign(num_groups_, 0.0);
       for (unsigned int g = 0; g < num_groups_; ++g)
         for (unsigned int gp = 0; gp < num_groups_; ++gp)
-          nu_sigma_f_[gp] += production_matrix_[g][gp];
+          nu_sigma_f_[gp] += production_matrix[g][gp];
 
       //check for reasonable fission neutron yield
       nu.assign(num_groups_, 0.0);
@@ -869,6 +876,8 @@ void chi_physics::SingleStateMGXS::
             "or in the range (1.0, 10.0).");
     }
 
+    production_matrix_ = pool.Intern(std::move(production_matrix));
+
     ChiLogicalErrorIf(sigma_f_.empty(), "After reading xs, a fissionable "
                                         "material's sigma_f is not defined");
   }//if fissionable
@@ -4,12 +4,25 @@
 
 
 //######################################################################
-void chi_physics::SingleStateMGXS::ComputeAbsorption()
+/**Estimates the absorption cross section from the transfer matrices, unless
+ * it was supplied. This is done on first access and is safe to call
+ * concurrently.*/
+void chi_physics::SingleStateMGXS::ComputeAbsorption() const
 {
+  std::lock_guard<std::mutex> lock(derived_data_mutex_);
+  if (absorption_initialized_)
+    return;
+
+  if (sigma_a_.size() == num_groups_)
+  {
+    absorption_initialized_ = true;
+    return;
+  }
+
   sigma_a_.assign(num_groups_, 0.0);
 
   // compute for a pure absorber
-  if (transfer_matrices_.empty())
+  if (transfer_matrices_->empty())
     for (size_t g = 0; g < num_groups_; ++g)
       sigma_a_[g] = sigma_t_[g];
 
@@ -19,24 +32,22 @@ void chi_physics::SingleStateMGXS::ComputeAbsorption()
     Chi::log.Log0Warning()
         << "Estimating absorption from the transfer matrices.";
 
-    const auto& S0 = transfer_matrices_[0];
+    // estimate the scattering cross sections, i.e. the column sums, in one
+    // pass over the entries
+    const auto& S0 = transfer_matrices_->front();
+    std::vector<double> sig_s(num_groups_, 0.0);
+    for (size_t row = 0; row < S0.NumRows(); ++row)
+    {
+      const auto& cols = S0.rowI_indices_[row];
+      const auto& vals = S0.rowI_values_[row];
+      for (size_t t = 0; t < cols.size(); ++t)
+        if (cols[t] < num_groups_)
+          sig_s[cols[t]] += vals[t];
+    }
+
     for (size_t g = 0; g < num_groups_; ++g)
     {
-      // estimate the scattering cross section
-      double sig_s = 0.0;
-      for (size_t row = 0; row < S0.NumRows(); ++row)
-      {
-        const auto& cols = S0.rowI_indices_[row];
-        const auto& vals = S0.rowI_values_[row];
-        for (size_t t = 0; t < cols.size(); ++t)
-          if (cols[t] == g)
-          {
-            sig_s += vals[t];
-            break;
-          }
-      }
-
-      sigma_a_[g] = sigma_t_[g] - sig_s;
+      sigma_a_[g] = sigma_t_[g] - sig_s[g];
 
       // TODO: Should negative absorption be allowed?
       if (sigma_a_[g] < 0.0)
@@ -46,43 +57,50 @@ void chi_physics::SingleStateMGXS::ComputeAbsorption()
             << "transfer matrices";
     }//for g
   }//if scattering present
+
+  absorption_initialized_ = true;
 }
 
 
 //######################################################################
-void chi_physics::SingleStateMGXS::ComputeDiffusionParameters()
+/**Computes the diffusion coefficients, within-group scattering and removal
+ * cross sections. This is done on first access, hence materials only used
+ * in pure transport never compute them, and is safe to call concurrently
+ * such that the quantities of several materials can be computed in
+ * parallel.*/
+void chi_physics::SingleStateMGXS::ComputeDiffusionParameters() const
 {
+  std::lock_guard<std::mutex> lock(derived_data_mutex_);
   if (diffusion_initialized_)
     return;
 
   //initialize diffusion data
-  diffusion_coeff_.resize(num_groups_, 1.0);
-  sigma_s_gtog_.resize(num_groups_, 0.0);
-  sigma_removal_.resize(num_groups_, 0.1);
+  diffusion_coeff_.assign(num_groups_, 1.0);
+  sigma_s_gtog_.assign(num_groups_, 0.0);
+  sigma_removal_.assign(num_groups_, 0.1);
+
+  //sum the first moment scattering into each group, in one pass over
+  //the entries
+  const auto& S = *transfer_matrices_;
+  std::vector<double> sig_1_in(num_groups_, 0.0);
+  if (S.size() > 1)
+    for (unsigned int gp = 0; gp < num_groups_; ++gp)
+    {
+      const auto& cols = S[1].rowI_indices_[gp];
+      const auto& vals = S[1].rowI_values_[gp];
+      for (size_t t = 0; t < cols.size(); ++t)
+        if (cols[t] < num_groups_)
+          sig_1_in[cols[t]] += vals[t];
+    }//for gp
 
   //perfom computations group-wise
-  const auto& S = transfer_matrices_;
   for (unsigned int g = 0; g < num_groups_; ++g)
   {
     //============================================================
     // Determine transport correction
     //============================================================
 
-    double sig_1 = 0.0;
-    if (S.size() > 1)
-    {
-      for (unsigned int gp = 0; gp < num_groups_; ++gp)
-      {
-        const auto& cols = S[1].rowI_indices_[gp];
-        const auto& vals = S[1].rowI_values_[gp];
-        for (size_t t = 0; t < cols.size(); ++t)
-          if (cols[t] == g)
-          {
-            sig_1 += vals[t];
-            break;
-          }
-      }//for gp
-    }//if moment 1 available
+    double sig_1 = sig_1_in[g];
 
     //============================================================
     // Compute diffusion coefficient
@@ -128,3 +146,24 @@ void chi_physics::SingleStateMGXS::ComputeDiffusionParameters()
 
   diffusion_initialized_ = true;
 }
+
+
+//######################################################################
+/**Builds the compact production operator from the production spectrum and
+ * production cross section, or from the dense production matrix. This is
+ * done on first access and is safe to call concurrently.*/
+void chi_physics::SingleStateMGXS::ComputeProduction() const
+{
+  std::lock_guard<std::mutex> lock(derived_data_mutex_);
+  if (production_initialized_)
+    return;
+
+  if (production_spectrum_)
+    production_.SetRankOne(*production_spectrum_, *production_nu_sigma_f_);
+  else if (is_fissionable_)
+    production_.SetMatrix(*production_matrix_);
+  else
+    production_.Clear();
+
+  production_initialized_ = true;
+}
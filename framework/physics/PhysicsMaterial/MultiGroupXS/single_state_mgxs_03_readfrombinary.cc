@@ -0,0 +1,162 @@
+#include "single_state_mgxs.h"
+#include "mgxs_binary_format.h"
+#include "mgxs_storage_pool.h"
+
+#include "data_types/byte_array.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <climits>
+#include <fstream>
+
+//###################################################################
+/**This method populates a transport cross section from a binary ChiXS
+ * file, as written by MultiGroupXS::ExportToChiXSBinaryFile. The file is
+ * read by location 0 and broadcast to all the other locations, hence this
+ * must be called on all locations.*/
+void chi_physics::SingleStateMGXS::
+  MakeFromChiXSBinaryFile(const std::string& file_name)
+{
+  Clear();
+
+  Chi::log.Log()
+      << "Reading binary Chi cross section file \"" << file_name << "\"\n";
+
+  //============================================================
+  // Read on the home location and broadcast
+  //============================================================
+  chi_data_types::ByteArray buffer;
+  long long num_bytes = -1;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+    if (file.is_open())
+    {
+      const std::streamsize file_size = file.tellg();
+      file.seekg(0);
+      buffer.Data().resize(static_cast<size_t>(file_size));
+      if (file.read(reinterpret_cast<char*>(buffer.Data().data()), file_size))
+        num_bytes = file_size;
+    }
+  }
+
+  MPI_Bcast(&num_bytes, 1, MPI_LONG_LONG, 0, Chi::mpi.comm);
+  if (num_bytes < 0)
+    throw std::runtime_error(
+        "Failed to read binary Chi cross section file "
+        "\"" + file_name + "\" in call to " +
+        std::string(__FUNCTION__));
+
+  buffer.Data().resize(static_cast<size_t>(num_bytes));
+  for (long long offset = 0; offset < num_bytes; offset += INT_MAX)
+  {
+    const auto count = static_cast<int>(
+      std::min<long long>(INT_MAX, num_bytes - offset));
+    MPI_Bcast(buffer.Data().data() + offset, count, MPI_BYTE, 0,
+              Chi::mpi.comm);
+  }
+
+  //============================================================
+  // Parse the buffer
+  //============================================================
+  namespace bin = mgxs_binary;
+  auto& pool = MGXSStoragePool::GetInstance();
+
+  /**Lambda to read 1D data.*/
+  auto Read1D = [&buffer]()
+  {
+    std::vector<double> values(buffer.Read<uint64_t>());
+    for (double& value : values)
+      value = buffer.Read<double>();
+    return values;
+  };
+
+  try
+  {
+    for (char c : bin::MAGIC)
+      if (buffer.Read<char>() != c)
+        throw std::logic_error("Not a binary Chi cross section file.");
+
+    const auto version = buffer.Read<uint32_t>();
+    if (version != bin::VERSION)
+      throw std::logic_error("Unsupported binary format version " +
+                             std::to_string(version) + ".");
+
+    num_groups_ = buffer.Read<uint32_t>();
+    scattering_order_ = buffer.Read<uint32_t>();
+    num_precursors_ = buffer.Read<uint32_t>();
+    is_fissionable_ = buffer.Read<uint32_t>() != 0;
+
+    //1D data
+    sigma_t_ = Read1D();
+    sigma_a_ = Read1D();
+    sigma_f_ = Read1D();
+    nu_sigma_f_ = Read1D();
+    nu_prompt_sigma_f_ = Read1D();
+    nu_delayed_sigma_f_ = Read1D();
+    inv_velocity_ = pool.Intern(Read1D());
+
+    //transfer matrices
+    std::vector<chi_math::SparseMatrix> transfer_matrices;
+    const auto num_transfer_matrices = buffer.Read<uint64_t>();
+    for (uint64_t m = 0; m < num_transfer_matrices; ++m)
+    {
+      transfer_matrices.emplace_back(num_groups_, num_groups_);
+      auto& matrix = transfer_matrices.back();
+      for (unsigned int g = 0; g < num_groups_; ++g)
+      {
+        auto& col_indices = matrix.rowI_indices_[g];
+        auto& col_values = matrix.rowI_values_[g];
+
+        col_indices.resize(buffer.Read<uint64_t>());
+        for (size_t& col : col_indices)
+          col = buffer.Read<uint64_t>();
+        col_values.resize(col_indices.size());
+        for (double& value : col_values)
+          value = buffer.Read<double>();
+      }
+    }
+    transfer_matrices_ = pool.Intern(std::move(transfer_matrices));
+
+    //production matrix
+    const auto form = static_cast<bin::ProductionForm>(
+      buffer.Read<uint32_t>());
+    if (form == bin::ProductionForm::FACTORED)
+    {
+      production_spectrum_ = pool.Intern(Read1D());
+      production_nu_sigma_f_ = pool.Intern(Read1D());
+    }
+    else if (form == bin::ProductionForm::DENSE)
+    {
+      std::vector<std::vector<double>> production_matrix(
+        num_groups_, std::vector<double>(num_groups_, 0.0));
+      for (auto& row : production_matrix)
+        for (double& value : row)
+          value = buffer.Read<double>();
+      production_matrix_ = pool.Intern(std::move(production_matrix));
+    }
+    else if (form != bin::ProductionForm::NONE)
+      throw std::logic_error("Invalid production matrix form.");
+
+    //precursors
+    precursors_.resize(num_precursors_);
+    for (auto& precursor : precursors_)
+    {
+      precursor.decay_constant = buffer.Read<double>();
+      precursor.fractional_yield = buffer.Read<double>();
+      precursor.emission_spectrum = Read1D();
+    }
+  }
+  catch (const std::exception& err)
+  {
+    throw std::runtime_error(
+        "Error reading binary Chi cross section file "
+        "\"" + file_name + "\".\n" + err.what());
+  }
+
+  ChiLogicalErrorIf(sigma_t_.size() != num_groups_,
+                    "Binary Chi cross section file \"" + file_name +
+                    "\" has inconsistent group data.");
+}
@@ -5,6 +5,8 @@
 
 #include "ChiObjectFactory.h"
 
+#include "utils/chi_profiler.h"
+
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "console/chi_console.h"
@@ -72,6 +74,7 @@ int chiSolverInitialize(lua_State* L)
   auto& solver = Chi::GetStackItem<chi_physics::Solver>(
     Chi::object_stack, solver_handle, fname);
 
+  ChiProfileRegion("Solver initialize");
   solver.Initialize();
 
   return 0;
@@ -98,6 +101,7 @@ int chiSolverExecute(lua_State* L)
   auto& solver = Chi::GetStackItem<chi_physics::Solver>(
     Chi::object_stack, solver_handle, fname);
 
+  ChiProfileRegion("Solver execute");
   solver.Execute();
 
   return 0;
@@ -124,6 +128,7 @@ int chiSolverStep(lua_State* L)
   auto& solver = Chi::GetStackItem<chi_physics::Solver>(
     Chi::object_stack, solver_handle, fname);
 
+  ChiProfileRegion("Solver step");
   solver.Step();
 
   return 0;
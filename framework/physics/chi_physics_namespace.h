@@ -12,7 +12,8 @@ namespace chi_physics
     SIMPLEXS0    = 20,
     SIMPLEXS1    = 21,
     EXISTING     = 22,
-    CHI_XSFILE   = 23
+    CHI_XSFILE   = 23,
+    CHI_XSFILE_BINARY = 24
   };
 
   class FieldFunctionGridBased;
@@ -240,6 +240,12 @@ to be followed by a filepath specifying the xs-file.
 
 ####_
 
+CHI_XSFILE_BINARY\n
+Loads transport cross-sections from binary CHI cross-section files. Expects
+to be followed by a filepath specifying the xs-file.
+
+####_
+
 EXISTING\n
 Supply handle to an existing cross-section and simply swap them out.
 
@@ -414,9 +420,20 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
     //================================= If the property is valid
     if (location_of_prop>=0)
     {
-      auto prop = std::static_pointer_cast<chi_physics::SingleStateMGXS>(
+      auto prop = std::dynamic_pointer_cast<chi_physics::SingleStateMGXS>(
                   cur_material->properties_[location_of_prop]);
 
+      // Only single-state cross sections can be built in place
+      if (not prop and
+          operation_index != static_cast<int>(OpType::EXISTING))
+      {
+        Chi::log.LogAllError()
+          << "chiPhysicsMaterialSetProperty: The transport cross sections "
+          << "of material \"" << cur_material->name_ << "\" can only be "
+          << "replaced with EXISTING.";
+        Chi::Exit(EXIT_FAILURE);
+      }
+
       //========================== Process operation
       if (operation_index == static_cast<int>(OpType::SIMPLEXS0))
       {
@@ -448,6 +465,16 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
 
         prop->MakeFromChiXSFile(std::string(file_name_c));
       }
+      else if (operation_index ==
+               static_cast<int>(OpType::CHI_XSFILE_BINARY))
+      {
+        if (numArgs != 4)
+          LuaPostArgAmountError("chiPhysicsMaterialSetProperty",4,numArgs);
+
+        const char* file_name_c = lua_tostring(L,4);
+
+        prop->MakeFromChiXSBinaryFile(std::string(file_name_c));
+      }
       else if (operation_index == static_cast<int>(OpType::EXISTING))
       {
         if (numArgs != 4)
@@ -456,10 +483,9 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
         LuaCheckNilValue("chiPhysicsMaterialSetProperty",L,4);
         int handle = lua_tonumber(L,4);
 
-        std::shared_ptr<chi_physics::SingleStateMGXS> xs;
+        std::shared_ptr<chi_physics::MultiGroupXS> xs;
         try {
-          xs = std::dynamic_pointer_cast<chi_physics::SingleStateMGXS>(
-            Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle, fname));
+          xs = Chi::GetStackItemPtr(Chi::multigroup_xs_stack, handle, fname);
         }
         catch(const std::out_of_range& o){
           Chi::log.LogAllError()
@@ -469,9 +495,8 @@ int chiPhysicsMaterialSetProperty(lua_State *L)
           Chi::Exit(EXIT_FAILURE);
         }
 //        auto old_prop = prop;
-        prop = xs;
-
-        cur_material->properties_[location_of_prop] = prop;
+        // Any kind of cross section, e.g. multi-state, can be attached
+        cur_material->properties_[location_of_prop] = xs;
 
 //        delete old_prop; //Still debating if this should be deleted
       }
@@ -0,0 +1,66 @@
+#ifndef CHI_ARENA_H
+#define CHI_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace chi
+{
+
+//###################################################################
+/**Memory arena for the transient containers of initialization paths,
+ * e.g., a `std::pmr::vector<std::pmr::set<T>>` of per-cell sets. Freed
+ * nodes are pooled by size and reused, and the whole memory is returned
+ * at once when the arena is destroyed, such that the temporaries neither
+ * fragment the heap nor depend on the allocator returning it.
+ *
+ * The containers must be destroyed before the arena. Not thread safe, an
+ * arena is meant to be local to a function.
+ * \code
+ * chi::TransientArena arena;
+ * std::pmr::vector<std::pmr::set<uint64_t>> subscriptions(num_vertices,
+ *                                                         arena.Resource());
+ * \endcode*/
+class TransientArena
+{
+private:
+  std::pmr::unsynchronized_pool_resource resource_;
+
+public:
+  TransientArena() = default;
+  TransientArena(const TransientArena&) = delete;
+  TransientArena& operator=(const TransientArena&) = delete;
+
+  /**Returns the memory resource to make containers with.*/
+  std::pmr::memory_resource* Resource() { return &resource_; }
+};
+
+//###################################################################
+/**Stack-buffer arena for the few small containers of one iteration of a
+ * loop, e.g., the vertex ids of a face. Allocations are bumped off the
+ * buffer, falling back on the heap once it is exhausted, and frees are
+ * no-ops. Declaring the arena in the loop body, before its containers,
+ * reuses the buffer at every iteration.*/
+template <size_t N = 1024>
+class ScratchArena
+{
+private:
+  alignas(std::max_align_t) std::byte buffer_[N];
+  std::pmr::monotonic_buffer_resource resource_;
+
+public:
+  ScratchArena() : resource_(buffer_, N) {}
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  /**Returns the memory resource to make containers with.*/
+  std::pmr::memory_resource* Resource() { return &resource_; }
+
+  /**Frees all the allocations, whose containers must no longer be used,
+   * and reuses the buffer.*/
+  void Release() { resource_.release(); }
+};
+
+} // namespace chi
+
+#endif // CHI_ARENA_H
@@ -0,0 +1,141 @@
+#include "chi_hardware_counters.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#ifdef CHITECH_HAVE_PAPI
+#include <papi.h>
+#endif
+#ifdef CHITECH_HAVE_LIKWID
+#include <likwid.h>
+#include <mutex>
+#endif
+
+namespace
+{
+#ifdef CHITECH_HAVE_PAPI
+/**Identifies the calling thread to PAPI.*/
+unsigned long PAPIThreadID()
+{
+  return static_cast<unsigned long>(
+    std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+/**Throws on a PAPI error code.*/
+void PAPICheck(int retval, const std::string& what)
+{
+  ChiLogicalErrorIf(retval != PAPI_OK,
+                    "PAPI " + what + " failed: " +
+                      std::string(PAPI_strerror(retval)));
+}
+#endif
+} // namespace
+
+//###################################################################
+/**Access to the singleton.*/
+chi::HardwareCounters& chi::HardwareCounters::GetInstance() noexcept
+{
+  static HardwareCounters instance;
+  return instance;
+}
+
+//###################################################################
+void chi::HardwareCounters::Enable(const std::string& event_list)
+{
+  std::vector<std::string> names;
+  {
+    std::istringstream events(event_list);
+    for (std::string name; std::getline(events, name, ',');)
+      if (not name.empty()) names.push_back(name);
+  }
+  ChiInvalidArgumentIf(names.empty(), "No hardware counter events given.");
+  ChiInvalidArgumentIf(names.size() > MAX_EVENTS,
+                       "At most " + std::to_string(MAX_EVENTS) +
+                         " hardware counter events are supported.");
+
+#ifdef CHITECH_HAVE_PAPI
+  const int version = PAPI_library_init(PAPI_VER_CURRENT);
+  ChiLogicalErrorIf(version != PAPI_VER_CURRENT,
+                    "PAPI library initialization failed.");
+  PAPICheck(PAPI_thread_init(PAPIThreadID), "thread initialization");
+
+  event_codes_.clear();
+  for (const auto& name : names)
+  {
+    int code = 0;
+    PAPICheck(PAPI_event_name_to_code(name.c_str(), &code),
+              "lookup of event \"" + name + "\"");
+    event_codes_.push_back(code);
+  }
+  event_names_ = names;
+  enabled_ = true;
+
+  Chi::log.Log0Verbose1() << "Hardware counters enabled for "
+                          << event_list << ".";
+#else
+  Chi::log.Log0Warning() << "Hardware counters \"" << event_list
+                         << "\" requested, but ChiTech was built without "
+                            "PAPI. The counters are disabled.";
+#endif
+}
+
+//###################################################################
+void chi::HardwareCounters::Finalize()
+{
+#ifdef CHITECH_HAVE_PAPI
+  if (enabled_) PAPI_shutdown();
+#endif
+#ifdef CHITECH_HAVE_LIKWID
+  likwid_markerClose();
+#endif
+  enabled_ = false;
+}
+
+//###################################################################
+/**The event set of a thread is created on the thread's first read.*/
+void chi::HardwareCounters::Read(Counts& counts)
+{
+  counts.fill(0);
+#ifdef CHITECH_HAVE_PAPI
+  if (not enabled_) return;
+
+  thread_local int event_set = PAPI_NULL;
+  if (event_set == PAPI_NULL)
+  {
+    PAPICheck(PAPI_register_thread(), "thread registration");
+    PAPICheck(PAPI_create_eventset(&event_set), "event set creation");
+    for (const int code : event_codes_)
+      PAPICheck(PAPI_add_event(event_set, code), "event addition");
+    PAPICheck(PAPI_start(event_set), "start");
+  }
+  PAPICheck(PAPI_read(event_set, counts.data()), "read");
+#endif
+}
+
+//###################################################################
+void chi::HardwareCounters::MarkerStart(const std::string& name)
+{
+#ifdef CHITECH_HAVE_LIKWID
+  static std::once_flag init_flag;
+  std::call_once(init_flag, []() { likwid_markerInit(); });
+  thread_local bool thread_initialized = false;
+  if (not thread_initialized)
+  {
+    likwid_markerThreadInit();
+    thread_initialized = true;
+  }
+  likwid_markerStartRegion(name.c_str());
+#endif
+}
+
+void chi::HardwareCounters::MarkerStop(const std::string& name)
+{
+#ifdef CHITECH_HAVE_LIKWID
+  likwid_markerStopRegion(name.c_str());
+#endif
+}
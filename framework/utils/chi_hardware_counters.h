@@ -0,0 +1,66 @@
+#ifndef CHI_HARDWARE_COUNTERS_H
+#define CHI_HARDWARE_COUNTERS_H
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace chi
+{
+
+//###################################################################
+/**Optional hardware performance counters of the profiled regions.
+ *
+ * With PAPI (CHITECH_HAVE_PAPI), Enable selects up to MAX_EVENTS preset or
+ * native events, e.g., "PAPI_DP_OPS,PAPI_L3_TCM", which every thread then
+ * counts in its own event set. The profiler reads the counters on entering
+ * and exiting a region and accumulates the differences alongside the
+ * timings, such that its report includes the counts, and the derived FLOP
+ * rate and memory bandwidth, of every call path.
+ *
+ * With likwid (CHITECH_HAVE_LIKWID), every profiled region is also a likwid
+ * marker region of the same name, the counts of which likwid-perfctr -m
+ * measures and reports itself. The markers are inert otherwise.*/
+class HardwareCounters
+{
+public:
+  static constexpr size_t MAX_EVENTS = 4;
+  typedef std::array<long long, MAX_EVENTS> Counts;
+
+private:
+  std::vector<std::string> event_names_;
+  std::vector<int> event_codes_;
+  bool enabled_ = false;
+
+public:
+  static HardwareCounters& GetInstance() noexcept;
+
+  HardwareCounters(const HardwareCounters&) = delete;
+  HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+  /**Starts counting the comma separated events on every thread. Must be
+   * called before any thread enters a profiled region.*/
+  void Enable(const std::string& event_list);
+  /**Stops counting and releases the counters.*/
+  void Finalize();
+
+  bool Enabled() const { return enabled_; }
+  size_t NumEvents() const { return event_names_.size(); }
+  const std::vector<std::string>& EventNames() const { return event_names_; }
+
+  /**Reads the current counts of the calling thread, zero beyond
+   * NumEvents.*/
+  void Read(Counts& counts);
+
+  /**Starts and stops the likwid marker region of the given name. No-ops
+   * without likwid.*/
+  static void MarkerStart(const std::string& name);
+  static void MarkerStop(const std::string& name);
+
+private:
+  HardwareCounters() = default;
+};
+
+} // namespace chi
+
+#endif // CHI_HARDWARE_COUNTERS_H
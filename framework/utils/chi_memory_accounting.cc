@@ -0,0 +1,161 @@
+#include "chi_memory_accounting.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "console/chi_console.h"
+
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+/**Returns the union over all the locations of the given names, sorted, on
+ * every location.*/
+std::vector<std::string>
+MakeUnionOfNames(const std::map<std::string, size_t>& local_map)
+{
+  std::string local_names;
+  for (const auto& [name, _] : local_map)
+    local_names += name + "\n";
+
+  int local_size = static_cast<int>(local_names.size());
+  std::vector<int> sizes(Chi::mpi.process_count, 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0,
+             Chi::mpi.comm);
+
+  std::vector<int> displacements(Chi::mpi.process_count, 0);
+  int total_size = 0;
+  for (int p = 0; p < Chi::mpi.process_count; ++p)
+  {
+    displacements[p] = total_size;
+    total_size += sizes[p];
+  }
+  std::string all_names(total_size, '\0');
+  MPI_Gatherv(local_names.data(), local_size, MPI_CHAR,
+              all_names.data(), sizes.data(), displacements.data(), MPI_CHAR,
+              0, Chi::mpi.comm);
+
+  std::string union_names;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::set<std::string> names_set;
+    std::istringstream names(all_names);
+    for (std::string name; std::getline(names, name);)
+      if (not name.empty()) names_set.insert(name);
+    for (const auto& name : names_set)
+      union_names += name + "\n";
+  }
+  int union_size = static_cast<int>(union_names.size());
+  MPI_Bcast(&union_size, 1, MPI_INT, 0, Chi::mpi.comm);
+  union_names.resize(union_size);
+  MPI_Bcast(union_names.data(), union_size, MPI_CHAR, 0, Chi::mpi.comm);
+
+  std::vector<std::string> names_list;
+  std::istringstream names(union_names);
+  for (std::string name; std::getline(names, name);)
+    names_list.push_back(name);
+  return names_list;
+}
+} // namespace
+
+//###################################################################
+/**Access to the singleton.*/
+chi::MemoryAccounting& chi::MemoryAccounting::GetInstance() noexcept
+{
+  static MemoryAccounting instance;
+  return instance;
+}
+
+//###################################################################
+void chi::MemoryAccounting::SetUsage(const std::string& owner,
+                                     size_t num_bytes)
+{
+  usage_[owner] = num_bytes;
+}
+
+//###################################################################
+size_t chi::MemoryAccounting::GetUsage(const std::string& owner) const
+{
+  const auto it = usage_.find(owner);
+  return it != usage_.end() ? it->second : 0;
+}
+
+//###################################################################
+size_t chi::MemoryAccounting::GetTotalUsage() const
+{
+  size_t total = 0;
+  for (const auto& [owner, num_bytes] : usage_)
+    total += num_bytes;
+  return total;
+}
+
+//###################################################################
+void chi::MemoryAccounting::LogReport(const std::string& label) const
+{
+  const auto owners = MakeUnionOfNames(usage_);
+
+  //============================================= Gather the usages
+  // The owners, then the accounted total and the resident memory
+  const size_t num_values = owners.size() + 2;
+  std::vector<double> local_values;
+  local_values.reserve(num_values);
+  for (const auto& owner : owners)
+    local_values.push_back(static_cast<double>(GetUsage(owner)));
+  local_values.push_back(static_cast<double>(GetTotalUsage()));
+  local_values.push_back(chi::Console::GetMemoryUsage().memory_bytes);
+
+  std::vector<double> all_values;
+  if (Chi::mpi.location_id == 0)
+    all_values.resize(num_values * Chi::mpi.process_count);
+  MPI_Gather(local_values.data(), static_cast<int>(num_values), MPI_DOUBLE,
+             all_values.data(), static_cast<int>(num_values), MPI_DOUBLE, 0,
+             Chi::mpi.comm);
+
+  if (Chi::mpi.location_id != 0) return;
+
+  //============================================= Print
+  const size_t num_locations = Chi::mpi.process_count;
+  constexpr double MB = 1024.0 * 1024.0;
+
+  std::stringstream outstr;
+  outstr << label << " memory usage in MB, per location over "
+         << num_locations << " location(s):\n";
+  outstr << std::left << std::setw(28) << "Owner" << std::right
+         << std::setw(12) << "Min" << std::setw(12) << "Average"
+         << std::setw(12) << "Max" << std::setw(10) << "Loc-max"
+         << std::setw(12) << "Total" << "\n";
+  for (size_t v = 0; v < num_values; ++v)
+  {
+    double min_value = 0.0;
+    double max_value = 0.0;
+    double total_value = 0.0;
+    size_t max_location = 0;
+    for (size_t p = 0; p < num_locations; ++p)
+    {
+      const double value = all_values[p * num_values + v] / MB;
+      if (p == 0 or value < min_value) min_value = value;
+      if (p == 0 or value > max_value)
+      {
+        max_value = value;
+        max_location = p;
+      }
+      total_value += value;
+    }
+
+    std::string name = "Process resident";
+    if (v < owners.size()) name = owners[v];
+    else if (v == owners.size())
+      name = "Total accounted";
+
+    outstr << std::left << std::setw(28) << name << std::right << std::fixed
+           << std::setprecision(2) << std::setw(12) << min_value
+           << std::setw(12) << total_value / static_cast<double>(num_locations)
+           << std::setw(12) << max_value << std::setw(10) << max_location
+           << std::setw(12) << total_value << "\n";
+  }
+
+  Chi::log.Log() << outstr.str();
+}
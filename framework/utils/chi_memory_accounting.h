@@ -0,0 +1,71 @@
+#ifndef CHI_MEMORY_ACCOUNTING_H
+#define CHI_MEMORY_ACCOUNTING_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace chi
+{
+
+//###################################################################
+/**Registry of the bytes held, on this location, by the major owners of
+ * memory, e.g., the mesh, the spatial discretization and the solver
+ * vectors. Owners report their usage, normally after initialization, and
+ * LogReport aggregates the usage of every owner over the locations, which
+ * identifies both the dominant owners and the imbalance between locations.
+ * Every owner is named and reporting an owner again replaces its usage.*/
+class MemoryAccounting
+{
+private:
+  std::map<std::string, size_t> usage_;
+
+public:
+  static MemoryAccounting& GetInstance() noexcept;
+
+  MemoryAccounting(const MemoryAccounting&) = delete;
+  MemoryAccounting& operator=(const MemoryAccounting&) = delete;
+
+  /**Sets the number of bytes held by the named owner.*/
+  void SetUsage(const std::string& owner, size_t num_bytes);
+  /**Returns the bytes of the named owner, zero if not reported.*/
+  size_t GetUsage(const std::string& owner) const;
+  /**Returns the bytes of all the owners.*/
+  size_t GetTotalUsage() const;
+
+  /**Forgets all the owners.*/
+  void Clear() { usage_.clear(); }
+
+  /**Logs, on location 0, the minimum, average and maximum per location,
+   * with the location attaining the maximum, and the global total of every
+   * owner reported on any location, along with the resident memory of the
+   * processes. Collective.*/
+  void LogReport(const std::string& label) const;
+
+private:
+  MemoryAccounting() = default;
+};
+
+/**Returns the bytes held by the storage of a vector, excluding any memory
+ * owned by its elements.*/
+template <typename T>
+size_t VectorMemoryUsage(const std::vector<T>& values)
+{
+  return values.capacity() * sizeof(T);
+}
+
+/**Returns the bytes held by the storage of nested vectors, including the
+ * inner vectors.*/
+template <typename T>
+size_t VectorMemoryUsage(const std::vector<std::vector<T>>& values)
+{
+  size_t num_bytes = values.capacity() * sizeof(std::vector<T>);
+  for (const auto& inner_values : values)
+    num_bytes += VectorMemoryUsage(inner_values);
+  return num_bytes;
+}
+
+} // namespace chi
+
+#endif // CHI_MEMORY_ACCOUNTING_H
@@ -0,0 +1,534 @@
+#include "chi_profiler.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace
+{
+/**Separates the regions of a call path. It sorts before any printable
+ * character, such that a path is followed by its sub-paths.*/
+constexpr char PATH_SEPARATOR = '\x1f';
+} // namespace
+
+//###################################################################
+/**Access to the singleton.*/
+chi::Profiler& chi::Profiler::GetInstance() noexcept
+{
+  static Profiler instance;
+  return instance;
+}
+
+//###################################################################
+chi::Profiler::RegionID chi::Profiler::GetRegionID(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t r = 0; r < region_names_.size(); ++r)
+    if (region_names_[r] == name) return r;
+
+  region_names_.push_back(name);
+  return region_names_.size() - 1;
+}
+
+std::string chi::Profiler::RegionName(RegionID region_id) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return region_names_.at(region_id);
+}
+
+//###################################################################
+/**The tree of the calling thread, created on the thread's first use.*/
+chi::Profiler::ThreadTree& chi::Profiler::GetThreadTree()
+{
+  thread_local ThreadTree* tree = nullptr;
+  if (tree == nullptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_trees_.push_back(std::make_unique<ThreadTree>());
+    tree = thread_trees_.back().get();
+  }
+  return *tree;
+}
+
+/**The child node of the current node for the region, created if new.*/
+size_t chi::Profiler::GetChild(ThreadTree& tree, RegionID region_id)
+{
+  for (const size_t child : tree.nodes[tree.current].children)
+    if (tree.nodes[child].region_id == region_id) return child;
+
+  const size_t child = tree.nodes.size();
+  tree.nodes.emplace_back();
+  tree.nodes[child].region_id = region_id;
+  tree.nodes[child].parent = tree.current;
+  tree.nodes[tree.current].children.push_back(child);
+  return child;
+}
+
+//###################################################################
+void chi::Profiler::BeginRegion(RegionID region_id, int64_t tag/*=-1*/)
+{
+  auto& tree = GetThreadTree();
+  tree.current = GetChild(tree, region_id);
+#ifdef CHITECH_HAVE_LIKWID
+  HardwareCounters::MarkerStart(RegionName(region_id));
+#endif
+
+  // The counters are read last, to exclude the profiler's own work
+  auto& start = tree.start_times.emplace_back();
+  start.tag = tag;
+  start.time = Clock::now();
+  if (hw_counters_.Enabled()) hw_counters_.Read(start.hw_counts);
+}
+
+void chi::Profiler::EndRegion(RegionID region_id)
+{
+  HardwareCounters::Counts end_counts{};
+  if (hw_counters_.Enabled()) hw_counters_.Read(end_counts);
+  const auto end_time = Clock::now();
+  auto& tree = GetThreadTree();
+  auto& node = tree.nodes[tree.current];
+  ChiLogicalErrorIf(tree.start_times.empty() or node.region_id != region_id,
+                    "Profiler region ended without being the current one.");
+
+  const auto& start = tree.start_times.back();
+  const auto start_time = start.time;
+  const auto tag = start.tag;
+  const std::chrono::duration<double> duration = end_time - start_time;
+  node.timing.Add(duration.count());
+  if (hw_counters_.Enabled())
+    for (size_t e = 0; e < HardwareCounters::MAX_EVENTS; ++e)
+      node.hw_counts[e] += end_counts[e] - start.hw_counts[e];
+#ifdef CHITECH_HAVE_LIKWID
+  HardwareCounters::MarkerStop(RegionName(region_id));
+#endif
+
+  if (tracing_)
+    RecordTraceEvent(tree, region_id, tag, start_time, end_time);
+
+  tree.start_times.pop_back();
+  tree.current = node.parent;
+}
+
+void chi::Profiler::AddElapsedRegion(RegionID region_id, double duration)
+{
+  const auto end_time = Clock::now();
+  auto& tree = GetThreadTree();
+  tree.nodes[GetChild(tree, region_id)].timing.Add(duration);
+
+  if (tracing_)
+  {
+    const auto start_time =
+      end_time - std::chrono::duration_cast<Clock::duration>(
+                   std::chrono::duration<double>(duration));
+    RecordTraceEvent(tree, region_id, -1, start_time, end_time);
+  }
+}
+
+void chi::Profiler::AddToCounter(RegionID region_id, double value)
+{
+  auto& tree = GetThreadTree();
+  tree.nodes[GetChild(tree, region_id)].counter.Add(value);
+}
+
+//###################################################################
+/**Appends an event to the ring buffer of the tree, overwriting the oldest
+ * event when full.*/
+void chi::Profiler::RecordTraceEvent(ThreadTree& tree,
+                                     RegionID region_id,
+                                     int64_t tag,
+                                     Clock::time_point begin,
+                                     Clock::time_point end) const
+{
+  const std::chrono::duration<double> begin_time = begin - trace_origin_;
+  const std::chrono::duration<double> end_time = end - trace_origin_;
+  const TraceEvent event{region_id, tag, begin_time.count(), end_time.count()};
+
+  if (tree.trace.size() < trace_capacity_)
+  {
+    tree.trace.push_back(event);
+    return;
+  }
+  if (trace_capacity_ == 0) return;
+
+  tree.trace[tree.trace_next] = event;
+  tree.trace_next = (tree.trace_next + 1) % trace_capacity_;
+  ++tree.num_dropped_events;
+}
+
+//###################################################################
+chi::RunningStatistics
+chi::Profiler::GetLocalStatistics(RegionID region_id) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  RunningStatistics statistics;
+  for (const auto& tree : thread_trees_)
+    for (const auto& node : tree->nodes)
+      if (&node != &tree->nodes.front() and node.region_id == region_id)
+        statistics.Merge(node.timing);
+  return statistics;
+}
+
+//###################################################################
+void chi::Profiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& tree : thread_trees_)
+    for (auto& node : tree->nodes)
+    {
+      node.timing = RunningStatistics();
+      node.counter = RunningStatistics();
+      node.hw_counts.fill(0);
+    }
+}
+
+//###################################################################
+void chi::Profiler::CollectPaths(const ThreadTree& tree,
+                                 size_t node,
+                                 const std::string& path,
+                                 std::vector<std::string>& paths,
+                                 std::vector<RunningStatistics>& timings,
+                                 std::vector<RunningStatistics>& counters,
+                                 std::vector<HardwareCounters::Counts>&
+                                   hw_counts) const
+{
+  for (const size_t child : tree.nodes[node].children)
+  {
+    const auto& child_node = tree.nodes[child];
+    const std::string child_path =
+      path + PATH_SEPARATOR + region_names_[child_node.region_id];
+    paths.push_back(child_path);
+    timings.push_back(child_node.timing);
+    counters.push_back(child_node.counter);
+    hw_counts.push_back(child_node.hw_counts);
+    CollectPaths(tree, child, child_path, paths, timings, counters, hw_counts);
+  }
+}
+
+//###################################################################
+/**For every call path, the total time on each location is reduced to its
+ * minimum, maximum and mean over the locations having the path. The
+ * calls and counter totals are averaged likewise.*/
+void chi::Profiler::LogReport() const
+{
+  //============================================= Merge the local threads
+  struct PathTotals
+  {
+    RunningStatistics timing;
+    RunningStatistics counter;
+    HardwareCounters::Counts hw_counts{};
+  };
+  std::map<std::string, PathTotals> local_paths;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& tree : thread_trees_)
+    {
+      std::vector<std::string> paths;
+      std::vector<RunningStatistics> timings;
+      std::vector<RunningStatistics> counters;
+      std::vector<HardwareCounters::Counts> hw_counts;
+      CollectPaths(*tree, 0, "", paths, timings, counters, hw_counts);
+      for (size_t p = 0; p < paths.size(); ++p)
+      {
+        auto& totals = local_paths[paths[p]];
+        totals.timing.Merge(timings[p]);
+        totals.counter.Merge(counters[p]);
+        for (size_t e = 0; e < HardwareCounters::MAX_EVENTS; ++e)
+          totals.hw_counts[e] += hw_counts[p][e];
+      }
+    }
+  }
+
+  //============================================= Union of the paths
+  std::string local_names;
+  for (const auto& [path, _] : local_paths)
+    local_names += path + "\n";
+
+  int local_size = static_cast<int>(local_names.size());
+  std::vector<int> sizes(Chi::mpi.process_count, 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0,
+             Chi::mpi.comm);
+
+  std::vector<int> displacements(Chi::mpi.process_count, 0);
+  int total_size = 0;
+  for (int p = 0; p < Chi::mpi.process_count; ++p)
+  {
+    displacements[p] = total_size;
+    total_size += sizes[p];
+  }
+  std::string all_names(total_size, '\0');
+  MPI_Gatherv(local_names.data(), local_size, MPI_CHAR,
+              all_names.data(), sizes.data(), displacements.data(), MPI_CHAR,
+              0, Chi::mpi.comm);
+
+  std::string union_names;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::map<std::string, int> union_paths;
+    std::istringstream names(all_names);
+    for (std::string path; std::getline(names, path);)
+      if (not path.empty()) union_paths[path] = 0;
+    for (const auto& [path, _] : union_paths)
+      union_names += path + "\n";
+  }
+  int union_size = static_cast<int>(union_names.size());
+  MPI_Bcast(&union_size, 1, MPI_INT, 0, Chi::mpi.comm);
+  union_names.resize(union_size);
+  MPI_Bcast(union_names.data(), union_size, MPI_CHAR, 0, Chi::mpi.comm);
+
+  std::vector<std::string> paths;
+  {
+    std::istringstream names(union_names);
+    for (std::string path; std::getline(names, path);)
+      paths.push_back(path);
+  }
+  if (paths.empty()) return;
+
+  //============================================= Reduce
+  // [0] time, [1] calls, [2] counter total, [3] number of locations
+  const size_t num_paths = paths.size();
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> local_min(3 * num_paths, inf);
+  std::vector<double> local_max(3 * num_paths, -inf);
+  std::vector<double> local_sum(4 * num_paths, 0.0);
+  const size_t num_events = hw_counters_.NumEvents();
+  std::vector<double> local_hw_sum(num_events * num_paths, 0.0);
+  for (size_t p = 0; p < num_paths; ++p)
+  {
+    const auto it = local_paths.find(paths[p]);
+    if (it == local_paths.end()) continue;
+    const auto& [timing, counter, hw_counts] = it->second;
+    const double values[] = {timing.total,
+                             static_cast<double>(timing.count),
+                             counter.total};
+    for (size_t e = 0; e < num_events; ++e)
+      local_hw_sum[num_events * p + e] = static_cast<double>(hw_counts[e]);
+    for (size_t v = 0; v < 3; ++v)
+    {
+      local_min[3 * p + v] = values[v];
+      local_max[3 * p + v] = values[v];
+      local_sum[4 * p + v] = values[v];
+    }
+    local_sum[4 * p + 3] = 1.0;
+  }
+
+  std::vector<double> global_min(local_min.size());
+  std::vector<double> global_max(local_max.size());
+  std::vector<double> global_sum(local_sum.size());
+  MPI_Reduce(local_min.data(), global_min.data(),
+             static_cast<int>(local_min.size()), MPI_DOUBLE, MPI_MIN, 0,
+             Chi::mpi.comm);
+  MPI_Reduce(local_max.data(), global_max.data(),
+             static_cast<int>(local_max.size()), MPI_DOUBLE, MPI_MAX, 0,
+             Chi::mpi.comm);
+  MPI_Reduce(local_sum.data(), global_sum.data(),
+             static_cast<int>(local_sum.size()), MPI_DOUBLE, MPI_SUM, 0,
+             Chi::mpi.comm);
+  std::vector<double> global_hw_sum(local_hw_sum.size());
+  if (hw_counters_.Enabled())
+    MPI_Reduce(local_hw_sum.data(), global_hw_sum.data(),
+               static_cast<int>(local_hw_sum.size()), MPI_DOUBLE, MPI_SUM, 0,
+               Chi::mpi.comm);
+
+  if (Chi::mpi.location_id != 0) return;
+
+  //============================================= Print
+  std::stringstream outstr;
+  outstr << "Profiler report over " << Chi::mpi.process_count
+         << " location(s). Times in seconds, per location:\n";
+  outstr << std::left << std::setw(40) << "Region" << std::right
+         << std::setw(12) << "Calls" << std::setw(12) << "Min"
+         << std::setw(12) << "Max" << std::setw(12) << "Mean"
+         << std::setw(12) << "Count" << "\n";
+
+  for (size_t p = 0; p < num_paths; ++p)
+  {
+    const auto& path = paths[p];
+    const auto depth =
+      std::count(path.begin(), path.end(), PATH_SEPARATOR) - 1;
+    const std::string name =
+      std::string(2 * depth, ' ') + path.substr(path.rfind(PATH_SEPARATOR) + 1);
+
+    const double num_locations = global_sum[4 * p + 3];
+    const double mean_calls = global_sum[4 * p + 1] / num_locations;
+    outstr << std::left << std::setw(40) << name << std::right
+           << std::setprecision(4) << std::setw(12) << mean_calls;
+    if (mean_calls > 0.0)
+      outstr << std::setw(12) << global_min[3 * p]
+             << std::setw(12) << global_max[3 * p]
+             << std::setw(12) << global_sum[4 * p] / num_locations;
+    else
+      outstr << std::setw(36) << "";
+
+    const double mean_counter = global_sum[4 * p + 2] / num_locations;
+    if (mean_counter != 0.0) outstr << std::setw(12) << mean_counter;
+    outstr << "\n";
+  }
+
+  if (hw_counters_.Enabled())
+    AppendHardwareCounterReport(outstr, paths, global_sum, global_hw_sum);
+
+  Chi::log.Log() << outstr.str();
+}
+
+//###################################################################
+/**The counts are averaged over the locations having the path. The FLOP
+ * rate is derived from a floating point operation event, e.g., PAPI_DP_OPS,
+ * and the memory bandwidth is estimated from the last-level cache misses of
+ * PAPI_L3_TCM, as 64 byte lines, both per location.*/
+void chi::Profiler::AppendHardwareCounterReport(
+  std::stringstream& outstr,
+  const std::vector<std::string>& paths,
+  const std::vector<double>& global_sum,
+  const std::vector<double>& global_hw_sum)
+{
+  const auto& event_names = HardwareCounters::GetInstance().EventNames();
+  const size_t num_events = event_names.size();
+
+  int flop_event = -1;
+  int miss_event = -1;
+  for (size_t e = 0; e < num_events; ++e)
+  {
+    const auto& name = event_names[e];
+    if (flop_event < 0 and (name == "PAPI_DP_OPS" or name == "PAPI_FP_OPS" or
+                            name == "PAPI_SP_OPS"))
+      flop_event = static_cast<int>(e);
+    if (miss_event < 0 and name == "PAPI_L3_TCM")
+      miss_event = static_cast<int>(e);
+  }
+  constexpr double CACHE_LINE_BYTES = 64.0;
+
+  outstr << "Hardware counters, per location:\n";
+  outstr << std::left << std::setw(40) << "Region" << std::right;
+  for (const auto& name : event_names)
+    outstr << std::setw(14) << name;
+  if (flop_event >= 0) outstr << std::setw(12) << "GFLOP/s";
+  if (miss_event >= 0) outstr << std::setw(12) << "GB/s";
+  outstr << "\n";
+
+  for (size_t p = 0; p < paths.size(); ++p)
+  {
+    const auto& path = paths[p];
+    const auto depth =
+      std::count(path.begin(), path.end(), PATH_SEPARATOR) - 1;
+    const std::string name =
+      std::string(2 * depth, ' ') + path.substr(path.rfind(PATH_SEPARATOR) + 1);
+
+    const double num_locations = global_sum[4 * p + 3];
+    const double mean_time = global_sum[4 * p] / num_locations;
+    const auto MeanCount = [&](size_t e)
+    { return global_hw_sum[num_events * p + e] / num_locations; };
+
+    outstr << std::left << std::setw(40) << name << std::right
+           << std::setprecision(4);
+    for (size_t e = 0; e < num_events; ++e)
+      outstr << std::setw(14) << MeanCount(e);
+    if (mean_time > 0.0)
+    {
+      if (flop_event >= 0)
+        outstr << std::setw(12) << MeanCount(flop_event) / mean_time / 1.0e9;
+      if (miss_event >= 0)
+        outstr << std::setw(12)
+               << CACHE_LINE_BYTES * MeanCount(miss_event) / mean_time / 1.0e9;
+    }
+    outstr << "\n";
+  }
+}
+
+//###################################################################
+void chi::Profiler::EnableTracing(size_t capacity)
+{
+  MPI_Barrier(Chi::mpi.comm);
+  std::lock_guard<std::mutex> lock(mutex_);
+  trace_capacity_ = capacity;
+  trace_origin_ = Clock::now();
+  for (auto& tree : thread_trees_)
+  {
+    tree->trace.clear();
+    tree->trace.reserve(capacity);
+    tree->trace_next = 0;
+    tree->num_dropped_events = 0;
+  }
+  tracing_ = true;
+}
+
+//###################################################################
+std::string chi::Profiler::SerializeTrace() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream outstr;
+  outstr << std::fixed << std::setprecision(3);
+
+  const int pid = Chi::mpi.location_id;
+  outstr << R"({"name": "process_name", "ph": "M", "pid": )" << pid
+         << R"(, "args": {"name": "Location )" << pid << R"("}},)" << "\n";
+
+  for (size_t t = 0; t < thread_trees_.size(); ++t)
+  {
+    const auto& tree = *thread_trees_[t];
+    const size_t num_events = tree.trace.size();
+    for (size_t e = 0; e < num_events; ++e)
+    {
+      // Oldest first, the oldest event being at trace_next when wrapped
+      const auto& event = tree.trace[(tree.trace_next + e) % num_events];
+      outstr << R"({"name": ")" << region_names_[event.region_id]
+             << R"(", "ph": "X", "pid": )" << pid << R"(, "tid": )" << t
+             << R"(, "ts": )" << event.begin * 1.0e6
+             << R"(, "dur": )" << (event.end - event.begin) * 1.0e6;
+      if (event.tag >= 0) outstr << R"(, "args": {"tag": )" << event.tag
+                                 << "}";
+      outstr << "},\n";
+    }
+    if (tree.num_dropped_events > 0)
+      Chi::log.LogAllWarning()
+        << "Profiler trace: thread " << t << " dropped its "
+        << tree.num_dropped_events << " oldest event(s).";
+  }
+  return outstr.str();
+}
+
+//###################################################################
+/**The events of every location are sent to location 0 in turn, such that
+ * location 0 holds the events of a single location at a time.*/
+void chi::Profiler::WriteChromeTrace(const std::string& file_name) const
+{
+  const std::string local_events = SerializeTrace();
+
+  constexpr int TRACE_TAG = 319;
+  if (Chi::mpi.location_id != 0)
+  {
+    const int size = static_cast<int>(local_events.size());
+    MPI_Send(&size, 1, MPI_INT, 0, TRACE_TAG, Chi::mpi.comm);
+    MPI_Send(local_events.data(), size, MPI_CHAR, 0, TRACE_TAG, Chi::mpi.comm);
+    return;
+  }
+
+  std::ofstream ofile(file_name, std::ofstream::out);
+  ChiLogicalErrorIf(not ofile.is_open(),
+                    "Failed to open trace file \"" + file_name + "\".");
+
+  ofile << "{\"traceEvents\": [\n" << local_events;
+  std::string events;
+  for (int p = 1; p < Chi::mpi.process_count; ++p)
+  {
+    int size = 0;
+    MPI_Recv(&size, 1, MPI_INT, p, TRACE_TAG, Chi::mpi.comm,
+             MPI_STATUS_IGNORE);
+    events.resize(size);
+    MPI_Recv(events.data(), size, MPI_CHAR, p, TRACE_TAG, Chi::mpi.comm,
+             MPI_STATUS_IGNORE);
+    ofile << events;
+  }
+  // Closes the trailing comma of the last event
+  ofile << R"({"name": "trace_end", "ph": "M", "pid": 0})" << "\n"
+        << "], \"displayTimeUnit\": \"ms\"}\n";
+
+  Chi::log.Log() << "Profiler trace written to \"" << file_name << "\".";
+}
@@ -0,0 +1,284 @@
+#ifndef CHI_PROFILER_H
+#define CHI_PROFILER_H
+
+#include "chi_hardware_counters.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace chi
+{
+
+//###################################################################
+/**Constant-memory statistics of a repeatedly sampled quantity, e.g.,
+ * the durations, in seconds, of a repeatedly executed operation.*/
+struct RunningStatistics
+{
+  size_t count = 0;
+  double total = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+
+  /**Adds a sample.*/
+  void Add(double value)
+  {
+    min = (count == 0 or value < min) ? value : min;
+    max = (count == 0 or value > max) ? value : max;
+    total += value;
+    ++count;
+  }
+
+  /**Adds all the samples of other.*/
+  void Merge(const RunningStatistics& other)
+  {
+    if (other.count == 0) return;
+    min = (count == 0 or other.min < min) ? other.min : min;
+    max = (count == 0 or other.max > max) ? other.max : max;
+    total += other.total;
+    count += other.count;
+  }
+
+  double Average() const
+  {
+    return count > 0 ? total / static_cast<double>(count) : 0.0;
+  }
+};
+
+//###################################################################
+/**Hierarchical profiler of timed regions and counters.
+ *
+ * Regions are identified by names, registered once for an id, and are
+ * entered and exited in nested fashion, such that the same region entered
+ * from different enclosing regions is accounted for separately, e.g.,
+ * "Sweep/Angle set/Sweep chunk". Every thread accumulates into its own
+ * tree of call paths, without locking, hence the memory is proportional
+ * to the number of distinct call paths, not to the number of calls. A
+ * thread's paths start at the regions it entered itself, i.e., the
+ * regions entered by OpenMP workers are rooted at the worker.
+ *
+ * Instrumentation normally uses the macros ChiProfileRegion,
+ * ChiProfileTaggedRegion, ChiProfileElapsed and ChiProfileCount, which
+ * compile to nothing when CHITECH_DISABLE_PROFILER is defined. LogReport,
+ * called at the end of a run, aggregates the paths over all locations.
+ *
+ * With tracing enabled, every exited region is also recorded, with its
+ * begin and end times, into a per-thread ring buffer of bounded capacity,
+ * such that the most recent events are kept. WriteChromeTrace writes the
+ * timelines of all the locations in the Chrome trace event format, which
+ * Perfetto and chrome://tracing load.
+ *
+ * With hardware counters enabled, see HardwareCounters, the counts of every
+ * call path are accumulated too and reported after the timings.*/
+class Profiler
+{
+public:
+  typedef size_t RegionID;
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  /**Accumulation node of a call path.*/
+  struct Node
+  {
+    RegionID region_id = 0;
+    size_t parent = 0;
+    std::vector<size_t> children;
+    RunningStatistics timing;  ///< Durations in seconds
+    RunningStatistics counter; ///< Counter increments
+    HardwareCounters::Counts hw_counts{}; ///< Hardware counter totals
+  };
+  /**The start of an entered region.*/
+  struct StartRecord
+  {
+    Clock::time_point time;
+    int64_t tag = -1;
+    HardwareCounters::Counts hw_counts{};
+  };
+  /**An exited region, with times in seconds since the trace origin.*/
+  struct TraceEvent
+  {
+    RegionID region_id = 0;
+    int64_t tag = -1;
+    double begin = 0.0;
+    double end = 0.0;
+  };
+  /**The call paths of a thread, node 0 being the root, and its trace
+   * ring buffer.*/
+  struct ThreadTree
+  {
+    std::vector<Node> nodes = std::vector<Node>(1);
+    size_t current = 0;
+    std::vector<StartRecord> start_times;
+
+    std::vector<TraceEvent> trace;
+    size_t trace_next = 0;
+    size_t num_dropped_events = 0;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<std::string> region_names_;
+  std::vector<std::unique_ptr<ThreadTree>> thread_trees_;
+
+  HardwareCounters& hw_counters_ = HardwareCounters::GetInstance();
+
+  std::atomic<bool> tracing_{false};
+  size_t trace_capacity_ = 0;
+  Clock::time_point trace_origin_;
+
+public:
+  static Profiler& GetInstance() noexcept;
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  /**Returns the id of the named region, registering it if new.*/
+  RegionID GetRegionID(const std::string& name);
+  /**Returns the name of a registered region.*/
+  std::string RegionName(RegionID region_id) const;
+
+  /**Enters a region. The tag, if not negative, identifies the instance
+   * in the trace, e.g., the id of an angle set.*/
+  void BeginRegion(RegionID region_id, int64_t tag = -1);
+  void EndRegion(RegionID region_id);
+  /**Accounts for a region, within the current region, that ended now
+   * after the given duration in seconds, e.g., a wait that is only known
+   * to be one after the fact.*/
+  void AddElapsedRegion(RegionID region_id, double duration);
+  /**Adds value to the counter named by the region, within the current
+   * region of the calling thread.*/
+  void AddToCounter(RegionID region_id, double value);
+
+  /**Returns the timing of a region on this location, summed over all
+   * the call paths and threads.*/
+  RunningStatistics GetLocalStatistics(RegionID region_id) const;
+
+  /**Logs, on location 0, the statistics of every call path over the
+   * locations. Collective.*/
+  void LogReport() const;
+
+  /**Zeroes all the statistics. Must not be called whilst any thread is
+   * within a region.*/
+  void Reset();
+
+  /**Starts recording the exited regions, keeping at most capacity events
+   * per thread. The trace origin is taken after a barrier, which aligns
+   * the timelines of the locations. Must not be called whilst any thread
+   * is within a region. Collective.*/
+  void EnableTracing(size_t capacity);
+  bool TracingEnabled() const { return tracing_; }
+  /**Writes the trace events of all the locations, the location being the
+   * process and the thread the Chrome trace thread, to the given file from
+   * location 0. Collective.*/
+  void WriteChromeTrace(const std::string& file_name) const;
+
+private:
+  Profiler() = default;
+
+  ThreadTree& GetThreadTree();
+  static size_t GetChild(ThreadTree& tree, RegionID region_id);
+  void RecordTraceEvent(ThreadTree& tree,
+                        RegionID region_id,
+                        int64_t tag,
+                        Clock::time_point begin,
+                        Clock::time_point end) const;
+  /**The trace events of this location as Chrome trace JSON objects, each
+   * followed by a comma and a newline.*/
+  std::string SerializeTrace() const;
+
+  /**Appends the call paths of a tree, with their timing, counter and
+   * hardware counter totals, to the given lists.*/
+  void CollectPaths(const ThreadTree& tree,
+                    size_t node,
+                    const std::string& path,
+                    std::vector<std::string>& paths,
+                    std::vector<RunningStatistics>& timings,
+                    std::vector<RunningStatistics>& counters,
+                    std::vector<HardwareCounters::Counts>& hw_counts) const;
+  /**Appends, to the report, the hardware counts summed over the locations
+   * of every call path, with the per path sums of the times, calls, counter
+   * totals and location counts of LogReport.*/
+  static void AppendHardwareCounterReport(
+    std::stringstream& outstr,
+    const std::vector<std::string>& paths,
+    const std::vector<double>& global_sum,
+    const std::vector<double>& global_hw_sum);
+};
+
+//###################################################################
+/**Enters a region on construction and exits it on destruction.*/
+class ScopedProfilerRegion
+{
+private:
+  const Profiler::RegionID region_id_;
+
+public:
+  explicit ScopedProfilerRegion(Profiler::RegionID region_id,
+                                int64_t tag = -1)
+    : region_id_(region_id)
+  {
+    Profiler::GetInstance().BeginRegion(region_id_, tag);
+  }
+  ~ScopedProfilerRegion() { Profiler::GetInstance().EndRegion(region_id_); }
+
+  ScopedProfilerRegion(const ScopedProfilerRegion&) = delete;
+  ScopedProfilerRegion& operator=(const ScopedProfilerRegion&) = delete;
+};
+
+} // namespace chi
+
+#define ChiProfilerConcat_(a, b) a##b
+#define ChiProfilerConcat(a, b) ChiProfilerConcat_(a, b)
+
+#ifndef CHITECH_DISABLE_PROFILER
+/**Profiles the remainder of the enclosing scope as the named region.*/
+#define ChiProfileRegion(name)                                               \
+  static const chi::Profiler::RegionID ChiProfilerConcat(chi_prof_id_,       \
+                                                         __LINE__) =         \
+    chi::Profiler::GetInstance().GetRegionID(name);                          \
+  const chi::ScopedProfilerRegion ChiProfilerConcat(chi_prof_region_,        \
+                                                    __LINE__)(               \
+    ChiProfilerConcat(chi_prof_id_, __LINE__))
+
+/**Profiles the remainder of the enclosing scope as the named region, the
+ * integer tag identifying the instance in the trace.*/
+#define ChiProfileTaggedRegion(name, tag)                                    \
+  static const chi::Profiler::RegionID ChiProfilerConcat(chi_prof_id_,       \
+                                                         __LINE__) =         \
+    chi::Profiler::GetInstance().GetRegionID(name);                          \
+  const chi::ScopedProfilerRegion ChiProfilerConcat(chi_prof_region_,        \
+                                                    __LINE__)(               \
+    ChiProfilerConcat(chi_prof_id_, __LINE__), static_cast<int64_t>(tag))
+
+/**Accounts for the named region that ended now after duration seconds.*/
+#define ChiProfileElapsed(name, duration)                                    \
+  do                                                                         \
+  {                                                                          \
+    static const chi::Profiler::RegionID chi_prof_elapsed_id_ =              \
+      chi::Profiler::GetInstance().GetRegionID(name);                        \
+    chi::Profiler::GetInstance().AddElapsedRegion(                           \
+      chi_prof_elapsed_id_, static_cast<double>(duration));                  \
+  } while (false)
+
+/**Adds value to the named counter of the current region.*/
+#define ChiProfileCount(name, value)                                         \
+  do                                                                         \
+  {                                                                          \
+    static const chi::Profiler::RegionID chi_prof_counter_id_ =              \
+      chi::Profiler::GetInstance().GetRegionID(name);                        \
+    chi::Profiler::GetInstance().AddToCounter(chi_prof_counter_id_,          \
+                                              static_cast<double>(value));   \
+  } while (false)
+#else
+#define ChiProfileRegion(name) static_cast<void>(0)
+#define ChiProfileTaggedRegion(name, tag) static_cast<void>(0)
+#define ChiProfileElapsed(name, duration) static_cast<void>(0)
+#define ChiProfileCount(name, value) static_cast<void>(0)
+#endif
+
+#endif // CHI_PROFILER_H
@@ -0,0 +1,147 @@
+#include "chi_telemetry.h"
+
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+#include "chi_log_exceptions.h"
+
+#include "utils/chi_timer.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+//###################################################################
+/**Access to the singleton.*/
+chi::Telemetry& chi::Telemetry::GetInstance() noexcept
+{
+  static Telemetry instance;
+  return instance;
+}
+
+namespace
+{
+/**Quotes and escapes a string for JSON.*/
+std::string JSONString(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (const char c : text)
+  {
+    if (c == '"' or c == '\\') quoted += '\\';
+    if (c == '\n') quoted += "\\n";
+    else
+      quoted += c;
+  }
+  return quoted + "\"";
+}
+} // namespace
+
+//###################################################################
+void chi::Telemetry::Record::AppendKey(const std::string& key)
+{
+  json_ += ", " + JSONString(key) + ": ";
+}
+
+chi::Telemetry::Record& chi::Telemetry::Record::Add(const std::string& key,
+                                                   const std::string& value)
+{
+  AppendKey(key);
+  json_ += JSONString(value);
+  return *this;
+}
+
+chi::Telemetry::Record& chi::Telemetry::Record::Add(const std::string& key,
+                                                   bool value)
+{
+  AppendKey(key);
+  json_ += value ? "true" : "false";
+  return *this;
+}
+
+/**Non-finite values, which JSON cannot represent, are written as null.*/
+chi::Telemetry::Record& chi::Telemetry::Record::Add(const std::string& key,
+                                                   double value)
+{
+  AppendKey(key);
+  if (not std::isfinite(value))
+  {
+    json_ += "null";
+    return *this;
+  }
+  std::ostringstream outstr;
+  outstr << std::setprecision(std::numeric_limits<double>::max_digits10)
+         << value;
+  json_ += outstr.str();
+  return *this;
+}
+
+//###################################################################
+void chi::Telemetry::Open(const std::string& file_name)
+{
+  if (Chi::mpi.location_id != 0) return;
+  ChiLogicalErrorIf(enabled_, "The telemetry stream is already open.");
+
+  file_.open(file_name, std::ofstream::out);
+  ChiLogicalErrorIf(not file_.is_open(),
+                    "Failed to open telemetry file \"" + file_name + "\".");
+
+  closing_ = false;
+  writer_ = std::thread(&Telemetry::WriterLoop, this);
+  enabled_ = true;
+}
+
+//###################################################################
+void chi::Telemetry::Close()
+{
+  if (not enabled_) return;
+  enabled_ = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+  condition_.notify_one();
+  writer_.join();
+  file_.close();
+}
+
+//###################################################################
+void chi::Telemetry::Emit(const std::string& event, const Record& record)
+{
+  if (not enabled_) return;
+
+  std::ostringstream line;
+  line << "{\"event\": " << JSONString(event) << ", \"time\": " << std::fixed
+       << std::setprecision(6) << Chi::program_timer.GetTime() / 1000.0
+       << record.JSON() << "}\n";
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_lines_.push_back(line.str());
+  }
+  condition_.notify_one();
+}
+
+//###################################################################
+/**Writes the pending lines in batches, outside the lock, until closed.*/
+void chi::Telemetry::WriterLoop()
+{
+  std::deque<std::string> batch;
+  while (true)
+  {
+    bool closing = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(
+        lock, [this]() { return closing_ or not pending_lines_.empty(); });
+      batch.swap(pending_lines_);
+      closing = closing_;
+    }
+
+    for (const auto& line : batch)
+      file_ << line;
+    file_.flush();
+    batch.clear();
+
+    if (closing) return;
+  }
+}
@@ -0,0 +1,104 @@
+#ifndef CHI_TELEMETRY_H
+#define CHI_TELEMETRY_H
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+namespace chi
+{
+
+//###################################################################
+/**Structured stream of solver telemetry, in JSON lines.
+ *
+ * Every emitted record is one JSON object on its own line, with the event
+ * name, the program time in seconds and the fields of the record, e.g.,
+ * {"event": "wgs_iteration", "time": 1.25, "groupset": 0, "residual": 1e-4}.
+ * The stream is written by location 0 only, from a writer thread that
+ * flushes the file after every batch of records, such that the solver does
+ * not wait on the file system and an external process can follow the file
+ * as it grows. Records are emitted by location 0 only, the quantities
+ * recorded being global ones.
+ *
+ * Instrumentation checks Enabled before assembling a record:
+ * \code
+ * auto& telemetry = chi::Telemetry::GetInstance();
+ * if (telemetry.Enabled())
+ *   telemetry.Emit("wgs_iteration",
+ *                  chi::Telemetry::Record().Add("residual", residual));
+ * \endcode*/
+class Telemetry
+{
+public:
+  /**The fields of a record, as JSON.*/
+  class Record
+  {
+  private:
+    std::string json_;
+
+  public:
+    Record& Add(const std::string& key, const std::string& value);
+    Record& Add(const std::string& key, const char* value)
+    {
+      return Add(key, std::string(value));
+    }
+    Record& Add(const std::string& key, bool value);
+    Record& Add(const std::string& key, double value);
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral_v<T> and
+                                          not std::is_same_v<T, bool>>>
+    Record& Add(const std::string& key, T value)
+    {
+      AppendKey(key);
+      json_ += std::to_string(value);
+      return *this;
+    }
+
+    const std::string& JSON() const { return json_; }
+
+  private:
+    void AppendKey(const std::string& key);
+  };
+
+private:
+  bool enabled_ = false;
+  std::ofstream file_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::string> pending_lines_;
+  bool closing_ = false;
+  std::thread writer_;
+
+public:
+  static Telemetry& GetInstance() noexcept;
+
+  Telemetry(const Telemetry&) = delete;
+  Telemetry& operator=(const Telemetry&) = delete;
+
+  /**Opens the stream on location 0 and starts its writer thread.*/
+  void Open(const std::string& file_name);
+  /**Writes the pending records and closes the stream.*/
+  void Close();
+
+  /**True, on location 0, when the stream is open.*/
+  bool Enabled() const { return enabled_; }
+
+  /**Queues a record of the named event for writing.*/
+  void Emit(const std::string& event, const Record& record);
+
+  ~Telemetry() { Close(); }
+
+private:
+  Telemetry() = default;
+
+  void WriterLoop();
+};
+
+} // namespace chi
+
+#endif // CHI_TELEMETRY_H
@@ -0,0 +1,96 @@
+#include "chi_text_tokenizer.h"
+
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chi
+{
+// #################################################################
+MappedTextFile::MappedTextFile(const std::string& file_name)
+{
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) == 0 and S_ISREG(file_stat.st_mode))
+    {
+      size_ = static_cast<size_t>(file_stat.st_size);
+      is_open_ = true;
+      if (size_ > 0)
+      {
+        void* map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+          madvise(map, size_, MADV_SEQUENTIAL);
+          data_ = static_cast<const char*>(map);
+          is_mapped_ = true;
+        }
+      }
+    }
+    close(fd);
+    if (is_open_ and (is_mapped_ or size_ == 0)) return;
+  }
+
+  //=================================== Fall back to reading the file
+  is_open_ = false;
+  std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+  if (not file.is_open()) return;
+
+  buffer_.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  is_open_ = static_cast<bool>(file);
+}
+
+// #################################################################
+MappedTextFile::~MappedTextFile()
+{
+  if (is_mapped_)
+    munmap(const_cast<char*>(data_), size_);
+}
+
+// #################################################################
+std::string_view PopLine(std::string_view& text)
+{
+  const size_t end = text.find('\n');
+  std::string_view line = text.substr(0, end);
+  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+  if (not line.empty() and line.back() == '\r') line.remove_suffix(1);
+  return line;
+}
+
+// #################################################################
+std::string_view PopToken(std::string_view& line)
+{
+  constexpr std::string_view BLANKS = " \t\f\v\r";
+  const size_t begin = line.find_first_not_of(BLANKS);
+  if (begin == std::string_view::npos)
+  {
+    line = {};
+    return {};
+  }
+  line.remove_prefix(begin);
+
+  const size_t end = line.find_first_of(BLANKS);
+  std::string_view token = line.substr(0, end);
+  line.remove_prefix(token.size());
+  return token;
+}
+
+// #################################################################
+std::string_view PopField(std::string_view& token, char delimiter)
+{
+  const size_t end = token.find(delimiter);
+  std::string_view field = token.substr(0, end);
+  token.remove_prefix(end == std::string_view::npos ? token.size() : end + 1);
+  return field;
+}
+}//namespace chi
@@ -0,0 +1,82 @@
+#ifndef CHI_TEXT_TOKENIZER_H
+#define CHI_TEXT_TOKENIZER_H
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace chi
+{
+
+//###################################################################
+/**Read-only view of a whole text file, memory mapped when possible and
+ * otherwise read into a buffer with a single read. Meant for the parsers
+ * of large ascii mesh files, which then tokenize the view without copying
+ * lines or words.
+ * \code
+ * chi::MappedTextFile file(file_name);
+ * std::string_view text = file.View();
+ * while (not text.empty())
+ * {
+ *   std::string_view line = chi::PopLine(text);
+ *   std::string_view keyword = chi::PopToken(line);
+ * }
+ * \endcode*/
+class MappedTextFile
+{
+private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool is_open_ = false;
+  bool is_mapped_ = false;
+  std::string buffer_;
+
+public:
+  explicit MappedTextFile(const std::string& file_name);
+  ~MappedTextFile();
+
+  MappedTextFile(const MappedTextFile&) = delete;
+  MappedTextFile& operator=(const MappedTextFile&) = delete;
+
+  /**Whether the file could be opened and read.*/
+  bool IsOpen() const { return is_open_; }
+
+  /**The whole content of the file, valid for the lifetime of this.*/
+  std::string_view View() const { return {data_, size_}; }
+};
+
+/**Removes the first line from the text and returns it, without its line
+ * ending.*/
+std::string_view PopLine(std::string_view& text);
+
+/**Removes the first blank-separated token from the line and returns it.
+ * Returns an empty view when the line has no more tokens.*/
+std::string_view PopToken(std::string_view& line);
+
+/**Removes the first occurrence of the delimiter, and what precedes it,
+ * from the token and returns what precedes it, e.g., the vertex index of
+ * the wavefront face token `v/vt/vn`.*/
+std::string_view PopField(std::string_view& token, char delimiter);
+
+//###################################################################
+/**Converts the whole token to a number, with `std::from_chars`, and
+ * returns false, leaving the value unchanged, if it is not one. A leading
+ * '+', which `std::from_chars` does not accept, is allowed.*/
+template<typename T>
+bool ParseNumber(std::string_view token, T& value)
+{
+  if (not token.empty() and token.front() == '+') token.remove_prefix(1);
+  if (token.empty()) return false;
+
+  T parsed_value;
+  const char* end = token.data() + token.size();
+  const auto [ptr, ec] = std::from_chars(token.data(), end, parsed_value);
+  if (ec != std::errc() or ptr != end) return false;
+
+  value = parsed_value;
+  return true;
+}
+}//namespace chi
+
+#endif //CHI_TEXT_TOKENIZER_H
@@ -0,0 +1,168 @@
+#include "chi_worker_threads.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <sstream>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+chi::WorkerThreads& chi::WorkerThreads::GetInstance() noexcept
+{
+  static WorkerThreads instance;
+  return instance;
+}
+
+namespace
+{
+/**Returns the NUMA domain of a cpu from sysfs, -1 when unknown.*/
+int NUMANodeOfCPU(int cpu)
+{
+  namespace fs = std::filesystem;
+  const fs::path cpu_dir("/sys/devices/system/cpu/cpu" + std::to_string(cpu));
+
+  std::error_code error;
+  for (const auto& entry : fs::directory_iterator(cpu_dir, error))
+  {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) == 0 and name.size() > 4 and
+        std::all_of(name.begin() + 4, name.end(), ::isdigit))
+      return std::stoi(name.substr(4));
+  }
+  return -1;
+}
+} // namespace
+
+//###################################################################
+/**Pins the workers to the cores allowed for the location, see the class
+ * description. Does nothing without OpenMP or when the allowed cores
+ * cannot be queried.*/
+void chi::WorkerThreads::PinToCores(int num_workers)
+{
+#ifdef _OPENMP
+  if (num_workers < 1) num_workers = omp_get_max_threads();
+
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+
+  //=================================== Allowed cpus ordered by domain
+  std::vector<std::pair<int, int>> numa_cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &allowed))
+      numa_cpus.emplace_back(NUMANodeOfCPU(cpu), cpu);
+  if (numa_cpus.empty()) return;
+  std::stable_sort(numa_cpus.begin(), numa_cpus.end(),
+                   [](const auto& a, const auto& b)
+                   { return a.first < b.first; });
+
+  //=================================== Spread the workers
+  const auto num_cpus = numa_cpus.size();
+  const auto W = static_cast<size_t>(num_workers);
+  worker_cpus_.assign(W, -1);
+  worker_numa_nodes_.assign(W, -1);
+  for (size_t t = 0; t < W; ++t)
+  {
+    const auto& [numa_node, cpu] = numa_cpus[(t * num_cpus / W) % num_cpus];
+    worker_cpus_[t] = cpu;
+    worker_numa_nodes_[t] = numa_node;
+  }
+
+#pragma omp parallel num_threads(num_workers)
+  {
+    const int t = omp_get_thread_num();
+    cpu_set_t worker_set;
+    CPU_ZERO(&worker_set);
+    CPU_SET(worker_cpus_[t], &worker_set);
+    sched_setaffinity(0, sizeof(worker_set), &worker_set);
+  }
+#endif
+}
+
+//###################################################################
+std::string chi::WorkerThreads::PlacementString() const
+{
+  if (not IsPinned()) return "Worker threads are not pinned.";
+
+  std::stringstream outstr;
+  outstr << "Worker threads pinned to cpu(NUMA domain):";
+  for (size_t t = 0; t < worker_cpus_.size(); ++t)
+    outstr << " " << worker_cpus_[t] << "(" << worker_numa_nodes_[t] << ")";
+  return outstr.str();
+}
+
+//###################################################################
+/**Splits consecutive items, e.g., the local cells, into one contiguous
+ * range per worker with about the same total weight, e.g., the number of
+ * nodes. Returns the num_workers+1 range boundaries.*/
+std::vector<size_t>
+chi::WorkerThreads::PartitionByWeight(const std::vector<size_t>& item_weights,
+                                      int num_workers)
+{
+  const auto W = static_cast<size_t>(std::max(num_workers, 1));
+  const size_t total_weight =
+    std::accumulate(item_weights.begin(), item_weights.end(), size_t(0));
+
+  std::vector<size_t> bounds(W + 1, item_weights.size());
+  bounds[0] = 0;
+  size_t weight = 0;
+  size_t t = 1;
+  for (size_t i = 0; i < item_weights.size() and t < W; ++i)
+  {
+    weight += item_weights[i];
+    while (t < W and weight * W >= t * total_weight)
+      bounds[t++] = i + 1;
+  }
+  return bounds;
+}
+
+//###################################################################
+/**Places the pages of an array of zeros by first touch, the worker t
+ * touching the elements [worker_offsets[t], worker_offsets[t+1]). The
+ * pages fully inside the array are first released, since the
+ * allocation already touched them, and read as zeros afterwards, hence
+ * the array must only hold zeros.*/
+void chi::WorkerThreads::FirstTouchZeros(
+  std::vector<double>& values, const std::vector<size_t>& worker_offsets)
+{
+  FirstTouchZeros(values, std::vector<std::vector<size_t>>{worker_offsets});
+}
+
+//###################################################################
+/**Same as above for an array made of blocks, the worker t touching the
+ * elements [offsets[t], offsets[t+1]) of each block's offsets.*/
+void chi::WorkerThreads::FirstTouchZeros(
+  std::vector<double>& values,
+  const std::vector<std::vector<size_t>>& block_worker_offsets)
+{
+  if (values.empty() or block_worker_offsets.empty() or
+      block_worker_offsets.front().size() < 2)
+    return;
+
+  const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const auto begin = reinterpret_cast<uintptr_t>(values.data());
+  const auto end = begin + values.size() * sizeof(double);
+  const uintptr_t pages_begin = (begin + page_size - 1) / page_size * page_size;
+  const uintptr_t pages_end = end / page_size * page_size;
+  if (pages_end > pages_begin)
+    madvise(reinterpret_cast<void*>(pages_begin),
+            pages_end - pages_begin,
+            MADV_DONTNEED);
+
+  const auto num_workers =
+    static_cast<int>(block_worker_offsets.front().size() - 1);
+  double* data = values.data();
+#pragma omp parallel for num_threads(num_workers) schedule(static, 1)
+  for (int t = 0; t < num_workers; ++t)
+    for (const auto& worker_offsets : block_worker_offsets)
+      std::fill(data + std::min(worker_offsets[t], values.size()),
+                data + std::min(worker_offsets[t + 1], values.size()),
+                0.0);
+}
@@ -0,0 +1,71 @@
+#ifndef CHI_WORKER_THREADS_H
+#define CHI_WORKER_THREADS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace chi
+{
+
+//###################################################################
+/**The OpenMP worker threads of a location, their placement on cores and
+ * NUMA domains, and the partitioning of the local cells among them.
+ *
+ * With the `--pin_threads` command line option, the workers are pinned,
+ * in order, to cores spread over the cores the location may run on, which
+ * are ordered by NUMA domain. Consecutive workers, hence consecutive blocks
+ * of cells, then share a domain. OpenMP reuses the pinned threads for all
+ * later parallel regions of at most that many threads.
+ *
+ * Large per-cell arrays are placed by first touch: the pages of a block of
+ * the array are allocated on the NUMA domain of the worker first writing
+ * them.
+ * \code
+ * const auto cell_bounds =
+ *   chi::WorkerThreads::PartitionByWeight(cell_num_nodes, num_workers);
+ * chi::WorkerThreads::FirstTouchZeros(phi, worker_offsets);
+ * \endcode*/
+class WorkerThreads
+{
+private:
+  std::vector<int> worker_cpus_;
+  std::vector<int> worker_numa_nodes_;
+
+  WorkerThreads() = default;
+
+public:
+  static WorkerThreads& GetInstance() noexcept;
+
+  WorkerThreads(const WorkerThreads&) = delete;
+  WorkerThreads& operator=(const WorkerThreads&) = delete;
+
+  /**Pins the given number of workers, -1 for the OpenMP maximum.*/
+  void PinToCores(int num_workers = -1);
+
+  bool IsPinned() const { return not worker_cpus_.empty(); }
+  /**The cpu of each pinned worker.*/
+  const std::vector<int>& WorkerCPUs() const { return worker_cpus_; }
+  /**The NUMA domain of each pinned worker, -1 when unknown.*/
+  const std::vector<int>& WorkerNUMANodes() const
+  {
+    return worker_numa_nodes_;
+  }
+  /**A one line description of the placement of the workers.*/
+  std::string PlacementString() const;
+
+  //=================================== Cell partitioning
+  static std::vector<size_t>
+  PartitionByWeight(const std::vector<size_t>& item_weights, int num_workers);
+
+  //=================================== First touch
+  static void FirstTouchZeros(std::vector<double>& values,
+                              const std::vector<size_t>& worker_offsets);
+  static void FirstTouchZeros(
+    std::vector<double>& values,
+    const std::vector<std::vector<size_t>>& block_worker_offsets);
+};
+
+}//namespace chi
+
+#endif //CHI_WORKER_THREADS_H
@@ -16,7 +16,9 @@
 //============================================= constructor
 cfem_diffusion::Solver::Solver(const std::string& in_solver_name):
   chi_physics::Solver(in_solver_name, { {"max_iters", int64_t(500)   },
-                                        {"residual_tolerance", 1.0e-2}})
+                                        {"residual_tolerance", 1.0e-2},
+                                        {"device_backend",
+                                         std::string("cpu")}})
 {}
 
 //============================================= destructor
@@ -24,7 +26,9 @@ cfem_diffusion::Solver::~Solver()
 {
   VecDestroy(&x_);
   VecDestroy(&b_);
+  VecDestroy(&b_fixed_);
   MatDestroy(&A_);
+  KSPDestroy(&petsc_solver_.ksp);
 }
 
 //============================================= Initialize
@@ -136,9 +140,12 @@ void cfem_diffusion::Solver::Initialize()
   const auto n = static_cast<int64_t>(num_local_dofs_);
   const auto N = static_cast<int64_t>(num_globl_dofs_);
 
-  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N);
-  x_ = chi_math::PETScUtils::CreateVector(n, N);
-  b_ = chi_math::PETScUtils::CreateVector(n, N);
+  const auto backend = chi_math::PETScUtils::DeviceBackendFromName(
+    basic_options_("device_backend").StringValue());
+
+  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N, backend);
+  x_ = chi_math::PETScUtils::CreateVector(n, N, backend);
+  b_ = chi_math::PETScUtils::CreateVector(n, N, backend);
  
   std::vector<int64_t> nodal_nnz_in_diag;
   std::vector<int64_t> nodal_nnz_off_diag;
@@ -176,19 +183,26 @@ void cfem_diffusion::Solver::Execute()
   const auto& grid = *grid_ptr_;
   const auto& sdm  = *sdm_ptr_;
 
-  lua_State* L = Chi::console.GetConsoleState();
+  const auto D_coef  = GetCoefficient("D_coef");
+  const auto sigma_a = GetCoefficient("Sigma_a");
+  const auto q_ext   = GetCoefficient("Q_ext");
 
   //============================================= Assemble the system
   Chi::log.Log() << "Assembling system: ";
+  VecDbl D_qp, sigma_a_qp, q_ext_qp;
   for (const auto& cell : grid.local_cells)
   {
     const auto& cell_mapping = sdm.GetCellMapping(cell);
     const auto  qp_data      = cell_mapping.MakeVolumeQuadraturePointData();
  
-    const auto imat  = cell.material_id_;
     const size_t num_nodes = cell_mapping.NumNodes();
     MatDbl Acell(num_nodes, VecDbl(num_nodes, 0.0));
     VecDbl cell_rhs(num_nodes, 0.0);
+
+    //======================= Evaluate coefficients, once per qp
+    D_coef->EvaluatePoints(cell, qp_data.QPointsXYZ(), D_qp);
+    sigma_a->EvaluatePoints(cell, qp_data.QPointsXYZ(), sigma_a_qp);
+    q_ext->EvaluatePoints(cell, qp_data.QPointsXYZ(), q_ext_qp);
  
     for (size_t i=0; i<num_nodes; ++i)
     {
@@ -199,10 +213,10 @@ void cfem_diffusion::Solver::Execute()
         {
           entry_aij +=
             (
-              CallLua_iXYZFunction(L, "D_coef",imat,qp_data.QPointXYZ(qp))  *
+              D_qp[qp] *
               qp_data.ShapeGrad(i, qp).Dot(qp_data.ShapeGrad(j, qp))
               +
-              CallLua_iXYZFunction(L, "Sigma_a",imat,qp_data.QPointXYZ(qp))  *
+              sigma_a_qp[qp] *
               qp_data.ShapeValue(i, qp) * qp_data.ShapeValue(j, qp)
             )
             *
@@ -211,7 +225,7 @@ void cfem_diffusion::Solver::Execute()
         Acell[i][j] = entry_aij;
       }//for j
       for (size_t qp : qp_data.QuadraturePointIndices())
-        cell_rhs[i] += CallLua_iXYZFunction(L,"Q_ext",imat,qp_data.QPointXYZ(qp)) * qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
+        cell_rhs[i] += q_ext_qp[qp] * qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
     }//for i
  
     //======================= Flag nodes for being on a boundary
@@ -334,7 +348,11 @@ void cfem_diffusion::Solver::Execute()
 
   //============================================= Create Krylov Solver
   Chi::log.Log() << "Solving: ";
-  auto petsc_solver =
+  // kept, with its preconditioner, for solving other sources
+  KSPDestroy(&petsc_solver_.ksp);
+  VecDestroy(&b_fixed_);
+  executed_source_ = q_ext;
+  petsc_solver_ =
     chi_math::PETScUtils::CreateCommonKrylovSolverSetup(
         A_,              //Matrix
         TextName(),      //Solver name
@@ -345,7 +363,7 @@ void cfem_diffusion::Solver::Execute()
     );
  
   //============================================= Solve
-  KSPSolve(petsc_solver.ksp, b_, x_);
+  KSPSolve(petsc_solver_.ksp, b_, x_);
 
   UpdateFieldFunctions();
 
@@ -0,0 +1,128 @@
+#include "cfem_diffusion_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+
+//###################################################################
+/**Assembles the contribution of a volumetric source to a RHS. As in
+ * Execute, the Dirichlet nodes receive none.*/
+void cfem_diffusion::Solver::AssembleSourceVector(
+  const chi_physics::SpatialMaterialCoefficient& q,
+  Vec b) const
+{
+  const auto& grid = *grid_ptr_;
+  const auto& sdm  = *sdm_ptr_;
+
+  VecDbl q_qp;
+  VecSet(b, 0.0);
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto& cell_mapping = sdm.GetCellMapping(cell);
+    const auto  qp_data      = cell_mapping.MakeVolumeQuadraturePointData();
+
+    const size_t num_nodes = cell_mapping.NumNodes();
+    q.EvaluatePoints(cell, qp_data.QPointsXYZ(), q_qp);
+
+    //======================= Flag Dirichlet nodes
+    std::vector<bool> is_dirichlet(num_nodes, false);
+    const size_t num_faces = cell.faces_.size();
+    for (size_t f=0; f<num_faces; ++f)
+    {
+      const auto& face = cell.faces_[f];
+      if (face.has_neighbor_) continue;
+      if (boundaries_.at(face.neighbor_id_).type_ != BoundaryType::Dirichlet)
+        continue;
+
+      const size_t num_face_nodes = face.vertex_ids_.size();
+      for (size_t fi=0; fi<num_face_nodes; ++fi)
+        is_dirichlet[cell_mapping.MapFaceNode(f,fi)] = true;
+    }//for face f
+
+    //======================= Assembly into the vector
+    for (size_t i=0; i<num_nodes; ++i)
+    {
+      if (is_dirichlet[i]) continue;
+
+      double entry_rhs_i = 0.0;
+      for (size_t qp : qp_data.QuadraturePointIndices())
+        entry_rhs_i += q_qp[qp] * qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
+      VecSetValue(b, sdm.MapDOF(cell, i), entry_rhs_i, ADD_VALUES);
+    }//for i
+  }//for cell
+
+  VecAssemblyBegin(b);
+  VecAssemblyEnd(b);
+}
+
+//###################################################################
+/**Solves the system for several volumetric sources, each given by the
+ * name of a lua function with the signature of "Q_ext". The matrix, the
+ * boundary contributions and the preconditioner of the last Execute are
+ * reused, with the source of that Execute subtracted, such that a batch
+ * of sources costs a source assembly and a Krylov solve each. A field
+ * function is created for every source, named after the solver and the
+ * source, and pushed onto the field function stack.*/
+std::vector<std::shared_ptr<chi_physics::FieldFunctionGridBased>>
+cfem_diffusion::Solver::SolveSources(
+  const std::vector<std::string>& source_functions)
+{
+  if (not petsc_solver_.ksp or not executed_source_)
+    throw std::logic_error(std::string(__PRETTY_FUNCTION__) +
+                           " The solver must be executed before solving "
+                           "other sources.");
+
+  Vec b_source;
+  VecDuplicate(b_, &b_source);
+
+  //============================================= RHS without the source
+  if (not b_fixed_)
+  {
+    VecDuplicate(b_, &b_fixed_);
+    AssembleSourceVector(*executed_source_, b_source);
+    VecWAXPY(b_fixed_, -1.0, b_source, b_);
+  }
+
+  //============================================= Solve the sources
+  std::string solver_name;
+  if (not TextName().empty()) solver_name = TextName() + "-";
+
+  std::vector<std::shared_ptr<chi_physics::FieldFunctionGridBased>> ffs;
+  for (const auto& source_function : source_functions)
+  {
+    Chi::log.Log() << "Solving source " << source_function;
+
+    AssembleSourceVector(chi_physics::LuaCoefficient(source_function),
+                         b_source);
+    VecAXPY(b_source, 1.0, b_fixed_);
+
+    Vec x;
+    VecDuplicate(x_, &x);
+    VecSet(x, 0.0);
+    KSPSolve(petsc_solver_.ksp, b_source, x);
+
+    using namespace chi_math;
+    auto ff = std::make_shared<chi_physics::FieldFunctionGridBased>(
+      solver_name + "phi_" + source_function, //Text name
+      sdm_ptr_,                                //Spatial Discretization
+      Unknown(UnknownType::SCALAR));           //Unknown/Variable
+    ff->UpdateFieldVector(x);
+    VecDestroy(&x);
+
+    Chi::field_function_stack.push_back(ff);
+    ffs.push_back(ff);
+  }//for source
+
+  VecDestroy(&b_source);
+
+  Chi::log.Log() << "Done solving " << source_functions.size()
+                 << " sources";
+
+  return ffs;
+}
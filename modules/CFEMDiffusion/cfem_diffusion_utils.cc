@@ -60,4 +60,34 @@ void cfem_diffusion::Solver::UpdateFieldFunctions()
   auto& ff = *field_functions_.front();
 
   ff.UpdateFieldVector(x_);
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Sets the provider of a coefficient, "D_coef", "Sigma_a" or "Q_ext",
+ * used at the next Execute. Coefficients not set are evaluated by the lua
+ * functions of the same names, the slowest option.*/
+void cfem_diffusion::Solver::SetCoefficient(
+  const std::string& name,
+  chi_physics::CoefficientPtr coefficient)
+{
+  if (name != "D_coef" and name != "Sigma_a" and name != "Q_ext")
+    throw std::invalid_argument(std::string(__PRETTY_FUNCTION__) +
+                                " Invalid coefficient name \"" + name +
+                                "\".");
+
+  if (coefficient) coefficients_[name] = std::move(coefficient);
+  else
+    coefficients_.erase(name);
+}
+
+//###################################################################
+/**Returns the provider of a coefficient, the lua function of the same
+ * name when it is not set.*/
+chi_physics::CoefficientPtr
+cfem_diffusion::Solver::GetCoefficient(const std::string& name) const
+{
+  const auto it = coefficients_.find(name);
+  if (it != coefficients_.end()) return it->second;
+
+  return std::make_shared<chi_physics::LuaCoefficient>(name);
+}
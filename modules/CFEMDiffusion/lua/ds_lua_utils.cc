@@ -9,6 +9,8 @@ void cfem_diffusion::cfem_diffusion_lua_utils::RegisterLuaEntities(lua_State *L)
 {
   LUA_FMACRO1(chiCFEMDiffusionSolverCreate);
   LUA_FMACRO1(chiCFEMDiffusionSetBCProperty);
+  LUA_FMACRO1(chiCFEMDiffusionSetCoefficient);
+  LUA_FMACRO1(chiCFEMDiffusionSolveSources);
 
   LUA_CMACRO1(MAX_ITERATIONS, 1);
   LUA_CMACRO1(TOLERANCE     , 2);
@@ -8,6 +8,8 @@ namespace cfem_diffusion::cfem_diffusion_lua_utils
 {
   int chiCFEMDiffusionSolverCreate(lua_State *L);
   int chiCFEMDiffusionSetBCProperty(lua_State *L);
+  int chiCFEMDiffusionSetCoefficient(lua_State *L);
+  int chiCFEMDiffusionSolveSources(lua_State *L);
 
   void RegisterLuaEntities(lua_State *L);
 }//namespace cfem_diffusion
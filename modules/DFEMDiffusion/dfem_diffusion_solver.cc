@@ -12,13 +12,16 @@
 #include "physics/FieldFunction/fieldfunction_gridbased.h"
 
 #include "math/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
+#include "math/SpatialDiscretization/cell_dof_table.h"
 
 #define DefaultBCDirichlet BoundaryCondition{BCType::DIRICHLET,{0,0,0}}
 
 //============================================= constructor
 dfem_diffusion::Solver::Solver(const std::string& in_solver_name):
   chi_physics::Solver(in_solver_name, { {"max_iters", int64_t(500)   },
-                                        {"residual_tolerance", 1.0e-2}})
+                                        {"residual_tolerance", 1.0e-2},
+                                        {"device_backend",
+                                         std::string("cpu")}})
 {}
 
 //============================================= destructor
@@ -26,7 +29,9 @@ dfem_diffusion::Solver::~Solver()
 {
   VecDestroy(&x_);
   VecDestroy(&b_);
+  VecDestroy(&b_fixed_);
   MatDestroy(&A_);
+  KSPDestroy(&petsc_solver_.ksp);
 }
 
 //============================================= Initialize
@@ -139,9 +144,12 @@ void dfem_diffusion::Solver::Initialize()
   const auto n = static_cast<int64_t>(num_local_dofs_);
   const auto N = static_cast<int64_t>(num_globl_dofs_);
 
-  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N);
-  x_ = chi_math::PETScUtils::CreateVector(n, N);
-  b_ = chi_math::PETScUtils::CreateVector(n, N);
+  const auto backend = chi_math::PETScUtils::DeviceBackendFromName(
+    basic_options_("device_backend").StringValue());
+
+  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N, backend);
+  x_ = chi_math::PETScUtils::CreateVector(n, N, backend);
+  b_ = chi_math::PETScUtils::CreateVector(n, N, backend);
  
   std::vector<int64_t> nodal_nnz_in_diag;
   std::vector<int64_t> nodal_nnz_off_diag;
@@ -178,8 +186,12 @@ void dfem_diffusion::Solver::Execute()
 
   const auto& grid = *grid_ptr_;
   const auto& sdm  = *sdm_ptr_;
+  const chi_math::CellDOFTable dof_table(sdm, sdm.UNITARY_UNKNOWN_MANAGER,
+                                         /*with_ghosts=*/true);
 
-  lua_State* L = Chi::console.GetConsoleState();
+  const auto D_coef  = GetCoefficient("D_coef");
+  const auto sigma_a = GetCoefficient("Sigma_a");
+  const auto q_ext   = GetCoefficient("Q_ext");
 
   //============================================= Assemble the system
   // is this needed?
@@ -187,6 +199,7 @@ void dfem_diffusion::Solver::Execute()
 
   Chi::log.Log() << "Assembling system: ";
 
+  VecDbl D_qp, sigma_a_qp, q_ext_qp, D_fqp, D_fqp_neigh;
   for (const auto& cell : grid.local_cells)
   {
     const auto& cell_mapping = sdm.GetCellMapping(cell);
@@ -194,27 +207,31 @@ void dfem_diffusion::Solver::Execute()
     const auto   cc_nodes    = cell_mapping.GetNodeLocations();
     const auto  qp_data      = cell_mapping.MakeVolumeQuadraturePointData();
 
-    const auto imat  = cell.material_id_;
     MatDbl Acell(num_nodes, VecDbl(num_nodes, 0.0));
     VecDbl cell_rhs(num_nodes, 0.0);
 
+    //==================================== Evaluate coefficients
+    D_coef->EvaluatePoints(cell, qp_data.QPointsXYZ(), D_qp);
+    sigma_a->EvaluatePoints(cell, qp_data.QPointsXYZ(), sigma_a_qp);
+    q_ext->EvaluatePoints(cell, qp_data.QPointsXYZ(), q_ext_qp);
+
     //==================================== Assemble volumetric terms
     for (size_t i=0; i<num_nodes; ++i)
     {
-      const int64_t imap = sdm.MapDOF(cell, i);
+      const int64_t imap = dof_table.MapDOF(cell, i);
 
       for (size_t j=0; j<num_nodes; ++j)
       {
-        const int64_t jmap = sdm.MapDOF(cell, j);
+        const int64_t jmap = dof_table.MapDOF(cell, j);
         double entry_aij = 0.0;
         for (size_t qp : qp_data.QuadraturePointIndices())
         {
           entry_aij +=
             (
-              CallLua_iXYZFunction(L, "D_coef",imat,qp_data.QPointXYZ(qp))  *
+              D_qp[qp] *
               qp_data.ShapeGrad(i, qp).Dot(qp_data.ShapeGrad(j, qp))
               +
-              CallLua_iXYZFunction(L, "Sigma_a",imat,qp_data.QPointXYZ(qp))  *
+              sigma_a_qp[qp] *
               qp_data.ShapeValue(i, qp) * qp_data.ShapeValue(j, qp)
             )
             *
@@ -224,8 +241,7 @@ void dfem_diffusion::Solver::Execute()
       }//for j
       double entry_rhs_i = 0.0;
       for (size_t qp : qp_data.QuadraturePointIndices())
-        entry_rhs_i += CallLua_iXYZFunction(L,"Q_ext",imat,qp_data.QPointXYZ(qp))
-          * qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
+        entry_rhs_i += q_ext_qp[qp] * qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
       VecSetValue(b_, imap, entry_rhs_i, ADD_VALUES);
     }//for i
 
@@ -239,6 +255,8 @@ void dfem_diffusion::Solver::Execute()
 
       const double hm = HPerpendicular(cell, f);
 
+      D_coef->EvaluatePoints(cell, fqp_data.QPointsXYZ(), D_fqp);
+
       typedef chi_mesh::MeshContinuum Grid;
 
       // interior face
@@ -250,7 +268,7 @@ void dfem_diffusion::Solver::Execute()
         const size_t acf = Grid::MapCellFace(cell, adj_cell, f);
         const double hp_neigh = HPerpendicular(adj_cell, acf);
 
-        const auto imat_neigh = adj_cell.material_id_;
+        D_coef->EvaluatePoints(adj_cell, fqp_data.QPointsXYZ(), D_fqp_neigh);
 
         //========================= Compute Ckappa IP
         double Ckappa = 1.0;
@@ -264,21 +282,20 @@ void dfem_diffusion::Solver::Execute()
         //========================= Assembly penalty terms
         for (size_t fi = 0; fi < num_face_nodes; ++fi) {
           const int i = cell_mapping.MapFaceNode(f, fi);
-          const int64_t imap = sdm.MapDOF(cell, i);
+          const int64_t imap = dof_table.MapDOF(cell, i);
 
           for (size_t fj = 0; fj < num_face_nodes; ++fj) {
             const int jm = cell_mapping.MapFaceNode(f, fj);      //j-minus
-            const int64_t jmmap = sdm.MapDOF(cell, jm);
+            const int64_t jmmap = dof_table.MapDOF(cell, jm);
 
             const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                            f, acf, fj);         //j-plus
-            const int64_t jpmap = sdm.MapDOF(adj_cell, jp);
+            const int64_t jpmap = dof_table.MapDOF(adj_cell, jp);
 
             double aij = 0.0;
             for (size_t qp: fqp_data.QuadraturePointIndices())
               aij += Ckappa *
-                     (CallLua_iXYZFunction(L, "D_coef", imat, fqp_data.QPointXYZ(qp)) / hm +
-                      CallLua_iXYZFunction(L, "D_coef", imat_neigh, fqp_data.QPointXYZ(qp)) / hp_neigh) / 2.
+                     (D_fqp[qp] / hm + D_fqp_neigh[qp] / hp_neigh) / 2.
                      *
                      fqp_data.ShapeValue(i, qp) * fqp_data.ShapeValue(jm, qp) *
                      fqp_data.JxW(qp);
@@ -297,20 +314,20 @@ void dfem_diffusion::Solver::Execute()
 
         // loop over node of current cell (gradient of b_i)
         for (int i = 0; i < num_nodes; ++i) {
-          const int64_t imap = sdm.MapDOF(cell, i);
+          const int64_t imap = dof_table.MapDOF(cell, i);
 
           // loop over faces
           for (int fj = 0; fj < num_face_nodes; ++fj) {
             const int jm = cell_mapping.MapFaceNode(f, fj);      //j-minus
-            const int64_t jmmap = sdm.MapDOF(cell, jm);
+            const int64_t jmmap = dof_table.MapDOF(cell, jm);
             const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                            f, acf, fj);         //j-plus
-            const int64_t jpmap = sdm.MapDOF(adj_cell, jp);
+            const int64_t jpmap = dof_table.MapDOF(adj_cell, jp);
 
             chi_mesh::Vector3 vec_aij;
             for (size_t qp: fqp_data.QuadraturePointIndices())
               vec_aij +=
-                CallLua_iXYZFunction(L, "D_coef", imat, fqp_data.QPointXYZ(qp)) *
+                D_fqp[qp] *
                 fqp_data.ShapeValue(jm, qp) * fqp_data.ShapeGrad(i, qp) *
                 fqp_data.JxW(qp);
             const double aij = -0.5 * n_f.Dot(vec_aij);
@@ -324,19 +341,19 @@ void dfem_diffusion::Solver::Execute()
         // 0.5*D* n dot (b_i^+ - b_i^-)*nabla b_j^-
         for (int fi = 0; fi < num_face_nodes; ++fi) {
           const int im = cell_mapping.MapFaceNode(f, fi);       //i-minus
-          const int64_t immap = sdm.MapDOF(cell, im);
+          const int64_t immap = dof_table.MapDOF(cell, im);
 
           const int ip = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                          f, acf, fi);            //i-plus
-          const int64_t ipmap = sdm.MapDOF(adj_cell, ip);
+          const int64_t ipmap = dof_table.MapDOF(adj_cell, ip);
 
           for (int j = 0; j < num_nodes; ++j) {
-            const int64_t jmap = sdm.MapDOF(cell, j);
+            const int64_t jmap = dof_table.MapDOF(cell, j);
 
             chi_mesh::Vector3 vec_aij;
             for (size_t qp: fqp_data.QuadraturePointIndices())
               vec_aij +=
-                CallLua_iXYZFunction(L, "D_coef", imat, fqp_data.QPointXYZ(qp)) *
+                D_fqp[qp] *
                 fqp_data.ShapeValue(im, qp) * fqp_data.ShapeGrad(j, qp) *
                 fqp_data.JxW(qp);
             const double aij = -0.5 * n_f.Dot(vec_aij);
@@ -370,12 +387,12 @@ void dfem_diffusion::Solver::Execute()
 
           for (size_t fi = 0; fi < num_face_nodes; fi++) {
             const uint i = cell_mapping.MapFaceNode(f, fi);
-            const int64_t ir = sdm.MapDOF(cell, i);
+            const int64_t ir = dof_table.MapDOF(cell, i);
 
             if (std::fabs(aval) >= 1.0e-12) {
               for (size_t fj = 0; fj < num_face_nodes; fj++) {
                 const uint j = cell_mapping.MapFaceNode(f, fj);
-                const int64_t jr = sdm.MapDOF(cell, j);
+                const int64_t jr = dof_table.MapDOF(cell, j);
 
                 double aij = 0.0;
                 for (size_t qp: fqp_data.QuadraturePointIndices())
@@ -411,16 +428,16 @@ void dfem_diffusion::Solver::Execute()
           //========================= Assembly penalty terms
           for (size_t fi = 0; fi < num_face_nodes; ++fi) {
             const uint i = cell_mapping.MapFaceNode(f, fi);
-            const int64_t imap = sdm.MapDOF(cell, i);
+            const int64_t imap = dof_table.MapDOF(cell, i);
 
             for (size_t fj = 0; fj < num_face_nodes; ++fj) {
               const uint jm = cell_mapping.MapFaceNode(f, fj);
-              const int64_t jmmap = sdm.MapDOF(cell, jm);
+              const int64_t jmmap = dof_table.MapDOF(cell, jm);
 
               double aij = 0.0;
               for (size_t qp: fqp_data.QuadraturePointIndices())
                 aij += Ckappa *
-                       CallLua_iXYZFunction(L, "D_coef", imat, fqp_data.QPointXYZ(qp)) / hm *
+                       D_fqp[qp] / hm *
                        fqp_data.ShapeValue(i, qp) * fqp_data.ShapeValue(jm, qp) *
                        fqp_data.JxW(qp);
               double aij_bc_value = aij * bc_value;
@@ -436,18 +453,17 @@ void dfem_diffusion::Solver::Execute()
 
           // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
           for (size_t i = 0; i < num_nodes; i++) {
-            const int64_t imap = sdm.MapDOF(cell, i);
+            const int64_t imap = dof_table.MapDOF(cell, i);
 
             for (size_t j = 0; j < num_nodes; j++) {
-              const int64_t jmap = sdm.MapDOF(cell, j);
+              const int64_t jmap = dof_table.MapDOF(cell, j);
 
               chi_mesh::Vector3 vec_aij;
               for (size_t qp: fqp_data.QuadraturePointIndices())
                 vec_aij +=
                   (fqp_data.ShapeValue(j, qp) * fqp_data.ShapeGrad(i, qp) +
                    fqp_data.ShapeValue(i, qp) * fqp_data.ShapeGrad(j, qp)) *
-                  fqp_data.JxW(qp) *
-                  CallLua_iXYZFunction(L, "D_coef", imat, fqp_data.QPointXYZ(qp));
+                  fqp_data.JxW(qp) * D_fqp[qp];
 
               const double aij = -n_f.Dot(vec_aij);
               double aij_bc_value = aij * bc_value;
@@ -484,7 +500,11 @@ void dfem_diffusion::Solver::Execute()
 
   //============================================= Create Krylov Solver
   Chi::log.Log() << "Solving: ";
-  auto petsc_solver =
+  // kept, with its preconditioner, for solving other sources
+  KSPDestroy(&petsc_solver_.ksp);
+  VecDestroy(&b_fixed_);
+  executed_source_ = q_ext;
+  petsc_solver_ =
     chi_math::PETScUtils::CreateCommonKrylovSolverSetup(
         A_,               //Matrix
         TextName(),      //Solver name
@@ -495,7 +515,7 @@ void dfem_diffusion::Solver::Execute()
     );
 
   //============================================= Solve
-  KSPSolve(petsc_solver.ksp, b_, x_);
+  KSPSolve(petsc_solver_.ksp, b_, x_);
 
   Chi::log.Log() << "Done solving";
 
@@ -3,6 +3,7 @@
 
 #include "physics/SolverBase/chi_solver.h"
 #include "math/PETScUtils/petsc_utils.h"
+#include "physics/Coefficients/spatial_material_coefficient.h"
 
 #include "dfem_diffusion_bndry.h"
 #include "utils/chi_timer.h"
@@ -47,6 +48,12 @@ public:
   Vec            b_ = nullptr;            // RHS
   Mat            A_ = nullptr;            // linear system matrix
 
+  chi_math::PETScUtils::PETScSolverSetup petsc_solver_{}; // kept for sources
+  Vec            b_fixed_ = nullptr;      // RHS without the source
+  chi_physics::CoefficientPtr executed_source_ = nullptr;
+
+  std::map<std::string, chi_physics::CoefficientPtr> coefficients_;
+
   typedef std::pair<BoundaryType,std::vector<double>> BoundaryInfo;
   typedef std::map<std::string, BoundaryInfo> BoundaryPreferences;
   BoundaryPreferences      boundary_preferences_;
@@ -75,6 +82,16 @@ public:
                                      const chi_mesh::Vector3&);
 
   void UpdateFieldFunctions();
+
+  void SetCoefficient(const std::string& name,
+                      chi_physics::CoefficientPtr coefficient);
+  chi_physics::CoefficientPtr GetCoefficient(const std::string& name) const;
+
+  void AssembleSourceVector(const chi_physics::SpatialMaterialCoefficient& q,
+                            Vec b) const;
+
+  std::vector<std::shared_ptr<chi_physics::FieldFunctionGridBased>>
+  SolveSources(const std::vector<std::string>& source_functions);
 };
 
 } // namespace dfem_diffusion
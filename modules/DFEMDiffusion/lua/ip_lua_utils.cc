@@ -14,6 +14,8 @@ void dfem_diffusion::dfem_diffusion_lua_utils::RegisterLuaEntities(lua_State *L)
 {
   LUA_FMACRO1(chiDFEMDiffusionSolverCreate);
   LUA_FMACRO1(chiDFEMDiffusionSetBCProperty);
+  LUA_FMACRO1(chiDFEMDiffusionSetCoefficient);
+  LUA_FMACRO1(chiDFEMDiffusionSolveSources);
 
   LUA_CMACRO1(MAX_ITERATIONS, 1);
   LUA_CMACRO1(TOLERANCE     , 2);
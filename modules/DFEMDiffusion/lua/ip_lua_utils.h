@@ -6,6 +6,8 @@
 
 int chiDFEMDiffusionSolverCreate(lua_State *L);
 int chiDFEMDiffusionSetBCProperty(lua_State *L);
+int chiDFEMDiffusionSetCoefficient(lua_State *L);
+int chiDFEMDiffusionSolveSources(lua_State *L);
 
 
 namespace dfem_diffusion
@@ -0,0 +1,53 @@
+#include "chi_lua.h"
+
+#include "../dfem_diffusion_solver.h"
+
+#include "physics/Coefficients/lua/coefficient_from_lua.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+//#############################################################################
+/** Sets a coefficient of a DFEM Diffusion solver by a provider evaluated
+ * in C++, instead of by the lua function of the same name, being called at
+ * every quadrature point.
+
+\param SolverHandle int Handle to an existing diffusion solver.
+\param CoefficientName string "D_coef", "Sigma_a" or "Q_ext".
+\param Kind string "material_constants", "field_function", "function" or
+       "lua".
+\param Value varying A table of values keyed by material id, the handle of
+       a field function, optionally followed by its component, the handle
+       of a function object of x, y, z and the material id, or the name of
+       a lua function.
+
+\code
+chiDFEMDiffusionSetCoefficient(solver, "D_coef", "material_constants",
+                               {[0]=1.0, [1]=0.5})
+\endcode
+\ingroup LuaDiffusion
+*/
+int chiDFEMDiffusionSetCoefficient(lua_State *L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args < 4)
+    LuaPostArgAmountError(fname, 4, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+
+  //============================================= Get solver
+  const int solver_index = lua_tonumber(L,1);
+  auto& solver = Chi::GetStackItem<dfem_diffusion::Solver>(Chi::object_stack,
+                                                           solver_index,
+                                                           fname);
+
+  //============================================= Set coefficient
+  const std::string coefficient_name = lua_tostring(L, 2);
+  solver.SetCoefficient(coefficient_name,
+                        chi_physics::lua_utils::CoefficientFromLua(fname,
+                                                                   L, 3));
+
+  return 0;
+}
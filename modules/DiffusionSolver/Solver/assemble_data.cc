@@ -0,0 +1,109 @@
+#include "diffusion_solver.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+//###################################################################
+/**Caches, per local cell, the data of the assemblies that does not change
+ * between them: the DOF maps and, for PWLC, the Dirichlet nodes with
+ * their averaged values, or, for PWLD, per face the h-perpendiculars and,
+ * for interior faces, the nodes, DOFs and face integrals of the adjacent
+ * cell. Assemblies hence no longer compute the unit integrals of ghost
+ * cells nor map faces and nodes onto neighbors.*/
+void chi_diffusion::Solver::InitializeAssemblyData()
+{
+  const auto& grid = *grid_ptr_;
+  const auto fem_method =
+    basic_options_("discretization_method").StringValue();
+
+  auto pwl_sdm =
+    std::static_pointer_cast<chi_math::SpatialDiscretization_PWLBase>(
+      discretization_);
+
+  cell_assembly_data_.assign(grid.local_cells.size(), {});
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
+    const size_t num_nodes = fe_intgrl_values.NumNodes();
+    auto& cell_data = cell_assembly_data_[cell.local_id_];
+
+    //=========================================== DOF map
+    cell_data.dof_map.resize(num_nodes);
+    for (size_t i=0; i<num_nodes; ++i)
+      cell_data.dof_map[i] = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, 0);
+
+    const size_t num_faces = cell.faces_.size();
+
+    //=========================================== PWLC Dirichlet nodes
+    if (fem_method == "PWLC")
+    {
+      cell_data.dirichlet_count.assign(num_nodes, 0);
+      cell_data.dirichlet_value.assign(num_nodes, 0.0);
+      for (size_t f=0; f<num_faces; ++f)
+      {
+        const auto& face = cell.faces_[f];
+        if (face.has_neighbor_) continue;
+
+        const auto& bndry = *boundaries_.at(face.neighbor_id_);
+        if (bndry.type_ != BoundaryType::Dirichlet) continue;
+
+        const auto& dirichlet_bndry =
+          static_cast<const chi_diffusion::BoundaryDirichlet&>(bndry);
+
+        const size_t num_face_dofs = face.vertex_ids_.size();
+        for (size_t fi=0; fi<num_face_dofs; ++fi)
+        {
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+          cell_data.dirichlet_count[i] += 1;
+          cell_data.dirichlet_value[i] += dirichlet_bndry.boundary_value;
+        }
+      }//for f
+
+      for (size_t i=0; i<num_nodes; ++i)
+        if (cell_data.dirichlet_count[i] > 0)
+          cell_data.dirichlet_value[i] /= cell_data.dirichlet_count[i];
+
+      continue;
+    }
+
+    //=========================================== PWLD face data
+    cell_data.faces.resize(num_faces);
+    for (size_t f=0; f<num_faces; ++f)
+      cell_data.faces[f].hm = HPerpendicular(cell, fe_intgrl_values, f);
+
+    for (size_t f=0; f<num_faces; ++f)
+    {
+      const auto& face = cell.faces_[f];
+      auto& face_data = cell_data.faces[f];
+
+      if (not face.has_neighbor_) continue;
+
+      const auto& adj_cell = grid.cells[face.neighbor_id_];
+      const unsigned int fmap = MapCellFace(cell, adj_cell, f);
+
+      // the unit integrals of ghost cells live in scratch storage;
+      // everything needed from them is extracted at once
+      const auto& adj_fe_intgrl_values = pwl_sdm->GetUnitIntegrals(adj_cell);
+      face_data.hp = HPerpendicular(adj_cell, adj_fe_intgrl_values, fmap);
+
+      const size_t num_face_dofs = face.vertex_ids_.size();
+      face_data.adj_face_nodes.resize(num_face_dofs);
+      face_data.adj_dof_map.resize(num_face_dofs);
+      face_data.adj_IntS_shapeI.resize(num_face_dofs);
+      for (size_t fi=0; fi<num_face_dofs; ++fi)
+      {
+        const int imap = static_cast<int>(
+          MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids_[fi]));
+        face_data.adj_face_nodes[fi] = imap;
+        face_data.adj_dof_map[fi] =
+          pwl_sdm->MapDOF(adj_cell, imap, unknown_manager_, 0, 0);
+        face_data.adj_IntS_shapeI[fi] =
+          adj_fe_intgrl_values.IntS_shapeI(fmap, imap);
+      }
+    }//for f
+  }//for cell
+
+  Chi::log.Log0Verbose1() << TextName() << ": Assembly data initialized";
+}
@@ -9,6 +9,7 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
 {
   auto pwl_sdm = std::static_pointer_cast<chi_math::SpatialDiscretization_PWLC>(this->discretization_);
   const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
+  const auto& cell_data = cell_assembly_data_[cell.local_id_];
 
   size_t num_nodes = fe_intgrl_values.NumNodes();
 
@@ -29,14 +30,12 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
   cell_matrix.resize(num_nodes, Row(num_nodes, 0.0));
   cell_rhs.resize(num_nodes, 0.0);
 
-  std::vector<int64_t> dof_global_row_ind(num_nodes, -1);
-  std::vector<int64_t> dof_global_col_ind(num_nodes, -1);
+  const std::vector<int64_t>& dof_global_row_ind = cell_data.dof_map;
+  std::vector<int64_t> dof_global_col_ind = dof_global_row_ind;
 
   //========================================= Loop over DOFs
   for (int i=0; i<num_nodes; i++)
   {
-    dof_global_row_ind[i] = pwl_sdm->MapDOF(cell,i);
-
     for (int j=0; j<num_nodes; j++)
     {
       double mat_entry =
@@ -49,13 +48,12 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
     //====================== Develop RHS entry
     cell_rhs[i] = q[i]* fe_intgrl_values.IntV_shapeI(i);
   }//for i
-  dof_global_col_ind = dof_global_row_ind;
 
-  //======================================== Apply Dirichlet,Vacuum, Neumann and
+  //======================================== Apply Vacuum, Neumann and
   //                                         Robin BCs
-  // Dirichlets are just collected
-  std::vector<int>    dirichlet_count(num_nodes, 0);
-  std::vector<double> dirichlet_value(num_nodes, 0.0);
+  // Dirichlets are cached, with their averaged values
+  const auto& dirichlet_count = cell_data.dirichlet_count;
+  const auto& dirichlet_value = cell_data.dirichlet_value;
   for (int f=0; f<cell.faces_.size(); f++)
   {
     if (not cell.faces_[f].has_neighbor_)
@@ -63,27 +61,11 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
       uint64_t ir_boundary_index = cell.faces_[f].neighbor_id_;
       auto ir_boundary_type  = boundaries_.at(ir_boundary_index)->type_;
 
-      if (ir_boundary_type == BoundaryType::Dirichlet)
-      {
-        auto& dirichlet_bndry =
-          (chi_diffusion::BoundaryDirichlet&)*boundaries_.at(ir_boundary_index);
-
-        int num_face_dofs = cell.faces_[f].vertex_ids_.size();
-        for (int fi=0; fi<num_face_dofs; fi++)
-        {
-          int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-          dirichlet_count[i] += 1;
-          dirichlet_value[i] += dirichlet_bndry.boundary_value;
-        }
-      }
-
       if (ir_boundary_type == BoundaryType::Robin)
       {
         auto& robin_bndry =
           (chi_diffusion::BoundaryRobin&)*boundaries_.at(ir_boundary_index);
 
-        std::cout << robin_bndry.a << " " << robin_bndry.b << " " << robin_bndry.f << std::endl;
-
         int num_face_dofs = cell.faces_[f].vertex_ids_.size();
         for (int fi=0; fi<num_face_dofs; fi++)
         {
@@ -111,10 +93,6 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
   }//for face
 
   //======================================== Apply dirichlet BCs
-  //Compute average dirichlet value
-  for (int i=0; i<num_nodes; ++i)
-    dirichlet_value[i] /= (dirichlet_count[i] > 0)? dirichlet_count[i] : 1;
-
   for (int i=0; i<num_nodes; ++i)
   {
     if (dirichlet_count[i] > 0)
@@ -6,109 +6,96 @@
 #include "chi_runtime.h"
 
 //###################################################################
-/**Assembles PWLC matrix for polygon cells.*/
+/**Assembles PWLD matrix for polygon cells. The cell's own entries are
+ * gathered in a cell matrix, and those coupling to each neighbor in two
+ * face blocks, inserted with one call each, using the cached assembly
+ * data.*/
 void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
                                                   int component)
 {
   auto pwl_sdm = std::static_pointer_cast<chi_math::SpatialDiscretization_PWLD>(this->discretization_);
   const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
+  const auto& cell_data = cell_assembly_data_[cell.local_id_];
+  const auto& dof_map = cell_data.dof_map;
 
-  size_t num_nodes = fe_intgrl_values.NumNodes();
+  const size_t num_nodes = fe_intgrl_values.NumNodes();
+  const auto nn = static_cast<int64_t>(num_nodes);
 
   //====================================== Process material id
-  int mat_id = cell.material_id_;
-
   std::vector<double> D(num_nodes, 1.0);
   std::vector<double> q(num_nodes, 1.0);
   std::vector<double> siga(num_nodes, 0.0);
 
   GetMaterialProperties(cell, num_nodes, D, q, siga, component);
 
+  MatDbl Acell(num_nodes, VecDbl(num_nodes, 0.0));
+  VecDbl cell_rhs(num_nodes, 0.0);
+
   //========================================= Loop over DOFs
-  for (int i=0; i<num_nodes; i++)
+  for (size_t i=0; i<num_nodes; i++)
   {
-    int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
-    double rhsvalue =0.0;
-
     //====================== Develop matrix entry
-    for (int j=0; j<num_nodes; j++)
+    for (size_t j=0; j<num_nodes; j++)
     {
-      int jr = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
-
-      double jr_mat_entry =
-        D[j]* fe_intgrl_values.IntV_gradShapeI_gradShapeJ(i, j);
-
-      jr_mat_entry +=
+      Acell[i][j] =
+        D[j]* fe_intgrl_values.IntV_gradShapeI_gradShapeJ(i, j) +
         siga[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
 
-      MatSetValue(A_, ir, jr, jr_mat_entry, ADD_VALUES);
-
-      rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+      cell_rhs[i] += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
     }//for j
-
-    //====================== Apply RHS entry
-    VecSetValue(b_, ir, rhsvalue, ADD_VALUES);
-
   }//for i
 
-
   //========================================= Loop over faces
-  int num_faces = cell.faces_.size();
+  std::vector<double> adj_D,adj_Q,adj_sigma;
+  const size_t num_faces = cell.faces_.size();
   for (unsigned int f=0; f<num_faces; f++)
   {
-    auto& face = cell.faces_[f];
+    const auto& face = cell.faces_[f];
+    const auto& face_data = cell_data.faces[f];
 
     //================================== Get face normal
-    chi_mesh::Vector3 n  = face.normal_;
+    const chi_mesh::Vector3& n  = face.normal_;
 
-    int num_face_dofs = face.vertex_ids_.size();
+    const size_t num_face_dofs = face.vertex_ids_.size();
+    const auto nf = static_cast<int64_t>(num_face_dofs);
 
-    if (face.has_neighbor_)
+    //================================== Compute surface average D
+    double D_avg = 0.0;
+    double intS = 0.0;
+    for (size_t fi=0; fi<num_face_dofs; fi++)
     {
-      const auto& adj_cell = grid_ptr_->cells[face.neighbor_id_];
-      const auto& adj_fe_intgrl_values = pwl_sdm->GetUnitIntegrals(adj_cell);
-
-
-      //========================= Get the current map to the adj cell's face
-      unsigned int fmap = MapCellFace(cell,adj_cell,f);
+      const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+      D_avg += D[i]* fe_intgrl_values.IntS_shapeI(f, i);
+      intS += fe_intgrl_values.IntS_shapeI(f, i);
+    }
+    D_avg /= intS;
 
-      //========================= Compute penalty coefficient
-      double hp = HPerpendicular(adj_cell, adj_fe_intgrl_values, fmap);
-      double hm = HPerpendicular(cell, fe_intgrl_values, f);
+    const double hm = face_data.hm;
 
-      std::vector<double> adj_D,adj_Q,adj_sigma;
+    if (face.has_neighbor_)
+    {
+      const auto& adj_cell = grid_ptr_->cells[face.neighbor_id_];
 
       GetMaterialProperties(adj_cell,
-                            adj_fe_intgrl_values.NumNodes(),
+                            adj_cell.vertex_ids_.size(),
                             adj_D,
                             adj_Q,
                             adj_sigma,
                             component);
 
-      //========================= Compute surface average D
-      double D_avg = 0.0;
-      double intS = 0.0;
-      for (int fi=0; fi<num_face_dofs; fi++)
-      {
-        int i = fe_intgrl_values.FaceDofMapping(f,fi);
-        D_avg += D[i]* fe_intgrl_values.IntS_shapeI(f, i);
-        intS += fe_intgrl_values.IntS_shapeI(f, i);
-      }
-      D_avg /= intS;
-
       //========================= Compute surface average D_adj
       double adj_D_avg = 0.0;
       double adj_intS = 0.0;
-      for (int fi=0; fi<num_face_dofs; fi++)
+      for (size_t fi=0; fi<num_face_dofs; fi++)
       {
-        int i    = fe_intgrl_values.FaceDofMapping(f,fi);
-        int imap = MapCellLocalNodeIDFromGlobalID(adj_cell, cell.vertex_ids_[i]);
-        adj_D_avg += adj_D[imap]* adj_fe_intgrl_values.IntS_shapeI(fmap, imap);
-        adj_intS += adj_fe_intgrl_values.IntS_shapeI(fmap, imap);
+        const int imap = face_data.adj_face_nodes[fi];
+        adj_D_avg += adj_D[imap]* face_data.adj_IntS_shapeI[fi];
+        adj_intS += face_data.adj_IntS_shapeI[fi];
       }
       adj_D_avg /= adj_intS;
 
       //========================= Compute kappa
+      const double hp = face_data.hp;
       double kappa = 1.0;
       if (cell.Type() == chi_mesh::CellType::SLAB)
         kappa = fmax(2.0*(adj_D_avg/hp + D_avg/hm),0.25);
@@ -117,25 +104,25 @@ void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
       if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
         kappa = fmax(4.0*(adj_D_avg/hp + D_avg/hm),0.25);
 
+      // rows of this cell, columns of the adjacent face nodes
+      VecDbl A_cell_adj(num_nodes * num_face_dofs, 0.0);
+      // rows of the adjacent face nodes, columns of this cell
+      VecDbl A_adj_cell(num_face_dofs * num_nodes, 0.0);
+
       //========================= Assembly penalty terms
-      for (int fi=0; fi<num_face_dofs; fi++)
+      for (size_t fi=0; fi<num_face_dofs; fi++)
       {
-        int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-        int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
+        const int i = fe_intgrl_values.FaceDofMapping(f,fi);
 
-        for (int fj=0; fj<num_face_dofs; fj++)
+        for (size_t fj=0; fj<num_face_dofs; fj++)
         {
-          int j     = fe_intgrl_values.FaceDofMapping(f,fj);
-          int jr    = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
-          int jmap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids_[fj]);
-          int jrmap = pwl_sdm->MapDOF(adj_cell, jmap, unknown_manager_, 0, component);
+          const int j = fe_intgrl_values.FaceDofMapping(f,fj);
 
-          double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
+          const double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
 
-          MatSetValue(A_, ir    , jr   , aij, ADD_VALUES);
-          MatSetValue(A_, ir    , jrmap, -aij, ADD_VALUES);
+          Acell[i][j] += aij;
+          A_cell_adj[i*num_face_dofs + fj] -= aij;
         }//for fj
-
       }//for fi
 
       //========================= Assemble gradient terms
@@ -143,45 +130,40 @@ void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
       // Dk = 0.5* n dot nabla bk
 
       // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
-      for (int i=0; i<fe_intgrl_values.NumNodes(); i++)
+      for (size_t i=0; i<num_nodes; i++)
       {
-        int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
-
-        for (int fj=0; fj<num_face_dofs; fj++)
+        for (size_t fj=0; fj<num_face_dofs; fj++)
         {
-          int j     = fe_intgrl_values.FaceDofMapping(f,fj);
-          int jr    = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
-          int jmap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids_[fj]);
-          int jrmap = pwl_sdm->MapDOF(adj_cell, jmap, unknown_manager_, 0, component);
+          const int j = fe_intgrl_values.FaceDofMapping(f,fj);
 
-          double aij =
+          const double aij =
             -0.5*D_avg*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
 
-          MatSetValue(A_, ir, jr   , aij, ADD_VALUES);
-          MatSetValue(A_, ir, jrmap, -aij, ADD_VALUES);
+          Acell[i][j] += aij;
+          A_cell_adj[i*num_face_dofs + fj] -= aij;
         }//for fj
       }//for i
 
       // 0.5*D* n dot (b_i^+ - b_i^-)*nabla b_j^-
-      for (int fi=0; fi<num_face_dofs; fi++)
+      for (size_t fi=0; fi<num_face_dofs; fi++)
       {
-        int i     = fe_intgrl_values.FaceDofMapping(f,fi);
-        int ir    = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
-        int imap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids_[fi]);
-        int irmap = pwl_sdm->MapDOF(adj_cell, imap, unknown_manager_, 0, component);
+        const int i = fe_intgrl_values.FaceDofMapping(f,fi);
 
-        for (int j=0; j<fe_intgrl_values.NumNodes(); j++)
+        for (size_t j=0; j<num_nodes; j++)
         {
-          int jr = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
-
-          double aij =
+          const double aij =
             -0.5*D_avg*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j));
 
-          MatSetValue(A_, ir   , jr, aij, ADD_VALUES);
-          MatSetValue(A_, irmap, jr, -aij, ADD_VALUES);
+          Acell[i][j] += aij;
+          A_adj_cell[fi*num_nodes + j] -= aij;
         }//for j
       }//for fi
 
+      const auto& adj_dof_map = face_data.adj_dof_map;
+      MatSetValues(A_, nn, dof_map.data(), nf, adj_dof_map.data(),
+                   A_cell_adj.data(), ADD_VALUES);
+      MatSetValues(A_, nf, adj_dof_map.data(), nn, dof_map.data(),
+                   A_adj_cell.data(), ADD_VALUES);
     }//if not bndry
     else
     {
@@ -190,23 +172,9 @@ void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
 
       if (ir_boundary_type == BoundaryType::Dirichlet)
       {
-        auto dc_boundary =
+        auto& dc_boundary =
           (chi_diffusion::BoundaryDirichlet&)*boundaries_.at(ir_boundary_index);
 
-        //========================= Compute penalty coefficient
-        double hm = HPerpendicular(cell, fe_intgrl_values, f);
-
-        //========================= Compute surface average D
-        double D_avg = 0.0;
-        double intS = 0.0;
-        for (int fi=0; fi<num_face_dofs; fi++)
-        {
-          int i = fe_intgrl_values.FaceDofMapping(f,fi);
-          D_avg += D[i]* fe_intgrl_values.IntS_shapeI(f, i);
-          intS += fe_intgrl_values.IntS_shapeI(f, i);
-        }
-        D_avg /= intS;
-
         double kappa = 1.0;
         if (cell.Type() == chi_mesh::CellType::SLAB)
           kappa = fmax(4.0*(D_avg/hm),0.25);
@@ -216,87 +184,88 @@ void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
           kappa = fmax(8.0*(D_avg/hm),0.25);
 
         //========================= Assembly penalty terms
-        for (int fi=0; fi<num_face_dofs; fi++)
+        for (size_t fi=0; fi<num_face_dofs; fi++)
         {
-          int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
 
-          for (int fj=0; fj<num_face_dofs; fj++)
+          for (size_t fj=0; fj<num_face_dofs; fj++)
           {
-            int j  = fe_intgrl_values.FaceDofMapping(f,fj);
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
+            const int j = fe_intgrl_values.FaceDofMapping(f,fj);
 
-            double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
+            const double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
 
-            MatSetValue(A_, ir    , jr, aij, ADD_VALUES);
-            VecSetValue(b_, ir, aij * dc_boundary.boundary_value, ADD_VALUES);
+            Acell[i][j] += aij;
+            cell_rhs[i] += aij * dc_boundary.boundary_value;
           }//for fj
         }//for fi
 
         // -Di^- bj^- and
         // -Dj^- bi^-
-        for (int i=0; i<fe_intgrl_values.NumNodes(); i++)
+        for (size_t i=0; i<num_nodes; i++)
         {
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
-
-          for (int j=0; j<fe_intgrl_values.NumNodes(); j++)
+          for (size_t j=0; j<num_nodes; j++)
           {
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
-
-            double gij =
+            const double gij =
               n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j) +
                     fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
-            double aij = -0.5*D_avg*gij;
+            const double aij = -0.5*D_avg*gij;
 
-            MatSetValue(A_, ir, jr, aij, ADD_VALUES);
-            VecSetValue(b_, ir, aij * dc_boundary.boundary_value, ADD_VALUES);
+            Acell[i][j] += aij;
+            cell_rhs[i] += aij * dc_boundary.boundary_value;
           }//for j
         }//for i
       }//Dirichlet
       else if (ir_boundary_type == BoundaryType::Robin)
       {
-        auto robin_bndry =
+        auto& robin_bndry =
           (chi_diffusion::BoundaryRobin&)*boundaries_.at(ir_boundary_index);
 
-        for (int fi=0; fi<num_face_dofs; fi++)
+        for (size_t fi=0; fi<num_face_dofs; fi++)
         {
-          int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
 
-          for (int fj=0; fj<num_face_dofs; fj++)
+          for (size_t fj=0; fj<num_face_dofs; fj++)
           {
-            int j  = fe_intgrl_values.FaceDofMapping(f,fj);
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager_, 0, component);
+            const int j = fe_intgrl_values.FaceDofMapping(f,fj);
 
             double aij = robin_bndry.a* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
             aij /= robin_bndry.b;
 
-            MatSetValue(A_, ir , jr, aij, ADD_VALUES);
+            Acell[i][j] += aij;
           }//for fj
 
           double bi = robin_bndry.f* fe_intgrl_values.IntS_shapeI(f, i);
           bi /= robin_bndry.b;
 
-          VecSetValue(b_, ir, bi, ADD_VALUES);
+          cell_rhs[i] += bi;
         }//for fi
       }//robin
     }
   }//for f
+
+  //========================================= Add to global
+  VecDbl Acell_cont(num_nodes * num_nodes);
+  for (size_t i=0; i<num_nodes; ++i)
+    for (size_t j=0; j<num_nodes; ++j)
+      Acell_cont[i*num_nodes + j] = Acell[i][j];
+
+  MatSetValues(A_, nn, dof_map.data(), nn, dof_map.data(),
+               Acell_cont.data(), ADD_VALUES);
+  VecSetValues(b_, nn, dof_map.data(), cell_rhs.data(), ADD_VALUES);
 }
 
 //###################################################################
-/**Assembles PWLC matrix for polygon cells.*/
+/**Assembles the PWLD RHS for polygon cells.*/
 void chi_diffusion::Solver::PWLD_Assemble_b(const chi_mesh::Cell& cell,
                                             int component)
 {
   auto pwl_sdm = std::static_pointer_cast<chi_math::SpatialDiscretization_PWLD>(this->discretization_);
   const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
+  const auto& dof_map = cell_assembly_data_[cell.local_id_].dof_map;
 
-  size_t num_nodes = fe_intgrl_values.NumNodes();
+  const size_t num_nodes = fe_intgrl_values.NumNodes();
 
   //====================================== Process material id
-  int mat_id = cell.material_id_;
-
   std::vector<double> D(num_nodes, 1.0);
   std::vector<double> q(num_nodes, 1.0);
   std::vector<double> siga(num_nodes, 1.0);
@@ -304,19 +273,15 @@ void chi_diffusion::Solver::PWLD_Assemble_b(const chi_mesh::Cell& cell,
   GetMaterialProperties(cell, num_nodes, D, q, siga, component);
 
   //========================================= Loop over DOFs
-  for (int i=0; i<num_nodes; i++)
+  VecDbl cell_rhs(num_nodes, 0.0);
+  for (size_t i=0; i<num_nodes; i++)
   {
-    int ir = pwl_sdm->MapDOF(cell, i, unknown_manager_, 0, component);
-
     //====================== Develop rhs entry
-    double rhsvalue =0.0;
-    for (int j=0; j<num_nodes; j++)
-      rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
-
-    //====================== Apply RHS entry
-    VecSetValue(b_, ir, rhsvalue, ADD_VALUES);
-
+    for (size_t j=0; j<num_nodes; j++)
+      cell_rhs[i] += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
   }//for i
 
-
+  //====================== Apply RHS entries
+  VecSetValues(b_, static_cast<int64_t>(num_nodes), dof_map.data(),
+               cell_rhs.data(), ADD_VALUES);
 }
@@ -74,6 +74,27 @@ public:
   int    G_ = 1;
   std::string options_string_;
 
+  /**Face data fixed over the assemblies.*/
+  struct FaceAssemblyData
+  {
+    double hm = 1.0;                        ///< h-perpendicular, this cell
+    double hp = 1.0;                        ///< h-perpendicular, adj cell
+    std::vector<int> adj_face_nodes;        ///< Adj cell nodes, by fi
+    std::vector<int64_t> adj_dof_map;       ///< Adj cell DOFs, by fi
+    std::vector<double> adj_IntS_shapeI;    ///< Adj cell face integrals
+  };
+  /**Cell data fixed over the assemblies, cached once by
+   * InitializeAssemblyData such that assemblies neither look up the
+   * DOFs, the faces of the neighbors nor their unit integrals.*/
+  struct CellAssemblyData
+  {
+    std::vector<int64_t> dof_map;
+    std::vector<FaceAssemblyData> faces;  ///< PWLD only
+    std::vector<int> dirichlet_count;     ///< PWLC only
+    std::vector<double> dirichlet_value;  ///< PWLC only, averaged
+  };
+  std::vector<CellAssemblyData> cell_assembly_data_;
+
 public:
   //00
   Solver (const Solver&) = delete;
@@ -101,6 +122,9 @@ public:
   void Execute() override { ExecuteS(); }
   int ExecuteS(bool suppress_assembly = false, bool suppress_solve = false);
 
+  //02b
+  void InitializeAssemblyData();
+
   void CFEM_Assemble_A_and_b(chi_mesh::Cell& cell, int group=0);
 
   //02c_c
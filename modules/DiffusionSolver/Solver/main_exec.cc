@@ -24,6 +24,15 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
   VecSet(x_, 0.0);
   VecSet(b_, 0.0);
 
+  //================================================== Clear a previous
+  //                                                   assembly
+  if (!suppress_assembly)
+  {
+    PetscBool assembled = PETSC_FALSE;
+    MatAssembled(A_, &assembled);
+    if (assembled) MatZeroEntries(A_);
+  }
+
   if (!suppress_assembly)
     Chi::log.Log() << Chi::program_timer.GetTimeString() << " "
                        << TextName() << ": Assembling A locally";
@@ -95,6 +95,9 @@ int chi_diffusion::Solver::Initialize(bool verbose)
                             nodal_nnz_off_diag,
                             unknown_manager_);
 
+  //================================================== Cache assembly data
+  InitializeAssemblyData();
+
   Chi::log.Log()
     << Chi::program_timer.GetTimeString() << " "
     << TextName() << ": Diffusion Solver initialization time "
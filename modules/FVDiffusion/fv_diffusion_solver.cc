@@ -15,7 +15,9 @@
 //============================================= constructor
 fv_diffusion::Solver::Solver(const std::string& in_solver_name):
   chi_physics::Solver(in_solver_name, { {"max_iters", int64_t(500)   },
-                                        {"residual_tolerance", 1.0e-2}})
+                                        {"residual_tolerance", 1.0e-2},
+                                        {"device_backend",
+                                         std::string("cpu")}})
 {}
 
 //============================================= destructor
@@ -23,7 +25,9 @@ fv_diffusion::Solver::~Solver()
 {
   VecDestroy(&x_);
   VecDestroy(&b_);
+  VecDestroy(&b_fixed_);
   MatDestroy(&A_);
+  KSPDestroy(&petsc_solver_.ksp);
 }
 
 //============================================= Initialize
@@ -135,9 +139,12 @@ void fv_diffusion::Solver::Initialize()
   const auto n = static_cast<int64_t>(num_local_dofs_);
   const auto N = static_cast<int64_t>(num_globl_dofs_);
 
-  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N);
-  x_ = chi_math::PETScUtils::CreateVector(n, N);
-  b_ = chi_math::PETScUtils::CreateVector(n, N);
+  const auto backend = chi_math::PETScUtils::DeviceBackendFromName(
+    basic_options_("device_backend").StringValue());
+
+  A_ = chi_math::PETScUtils::CreateSquareMatrix(n, N, backend);
+  x_ = chi_math::PETScUtils::CreateVector(n, N, backend);
+  b_ = chi_math::PETScUtils::CreateVector(n, N, backend);
  
   std::vector<int64_t> nodal_nnz_in_diag;
   std::vector<int64_t> nodal_nnz_off_diag;
@@ -175,7 +182,9 @@ void fv_diffusion::Solver::Execute()
   const auto& grid = *grid_ptr_;
   const auto& sdm  = *sdm_ptr_;
 
-  lua_State* L = Chi::console.GetConsoleState();
+  const auto D_coef  = GetCoefficient("D_coef");
+  const auto sigma_a = GetCoefficient("Sigma_a");
+  const auto q_ext   = GetCoefficient("Q_ext");
 
   //============================================= Assemble the system
   // P ~ Present cell
@@ -187,15 +196,13 @@ void fv_diffusion::Solver::Execute()
     const double volume_P = cell_mapping.CellVolume(); //Volume of present cell
     const auto& x_cc_P = cell_P.centroid_;
 
-    const auto imat  = cell_P.material_id_;
-
-    const double sigma_a = CallLua_iXYZFunction(L, "Sigma_a",imat,x_cc_P);
-    const double q_ext   = CallLua_iXYZFunction(L, "Q_ext"  ,imat,x_cc_P);
-    const double D_P     = CallLua_iXYZFunction(L, "D_coef" ,imat,x_cc_P);
+    const double sigma_a_P = sigma_a->Evaluate(cell_P, x_cc_P);
+    const double q_ext_P   = q_ext->Evaluate(cell_P, x_cc_P);
+    const double D_P       = D_coef->Evaluate(cell_P, x_cc_P);
 
     const int64_t imap = sdm.MapDOF(cell_P, 0);
-    MatSetValue(A_, imap, imap, sigma_a * volume_P, ADD_VALUES);
-    VecSetValue(b_, imap, q_ext * volume_P, ADD_VALUES);
+    MatSetValue(A_, imap, imap, sigma_a_P * volume_P, ADD_VALUES);
+    VecSetValue(b_, imap, q_ext_P * volume_P, ADD_VALUES);
 
     for (size_t f=0; f < cell_P.faces_.size(); ++f)
     {
@@ -208,11 +215,10 @@ void fv_diffusion::Solver::Execute()
       if (face.has_neighbor_)
       {
         const auto& cell_N = grid.cells[face.neighbor_id_];
-        const int   jmat   = cell_N.material_id_;
         const auto& x_cc_N = cell_N.centroid_;
         const auto  x_PN   = x_cc_N - x_cc_P;
 
-        const double D_N = CallLua_iXYZFunction(L, "D_coef",jmat,x_cc_N);
+        const double D_N = D_coef->Evaluate(cell_N, x_cc_N);
 
         const double w = x_PF.Norm()/x_PN.Norm();
         const double D_f = 1.0/(w/D_P + (1.0-w)/D_N);
@@ -271,7 +277,11 @@ void fv_diffusion::Solver::Execute()
 
   //============================================= Create Krylov Solver
   Chi::log.Log() << "Solving: ";
-  auto petsc_solver =
+  // kept, with its preconditioner, for solving other sources
+  KSPDestroy(&petsc_solver_.ksp);
+  VecDestroy(&b_fixed_);
+  executed_source_ = q_ext;
+  petsc_solver_ =
     chi_math::PETScUtils::CreateCommonKrylovSolverSetup(
         A_,               //Matrix
       TextName(),      //Solver name
@@ -282,7 +292,7 @@ void fv_diffusion::Solver::Execute()
       );
  
   //============================================= Solve
-  KSPSolve(petsc_solver.ksp, b_, x_);
+  KSPSolve(petsc_solver_.ksp, b_, x_);
 
   UpdateFieldFunctions();
 
@@ -3,6 +3,7 @@
 
 #include "physics/SolverBase/chi_solver.h"
 #include "math/PETScUtils/petsc_utils.h"
+#include "physics/Coefficients/spatial_material_coefficient.h"
 
 #include "fv_diffusion_bndry.h"
 #include "utils/chi_timer.h"
@@ -44,6 +45,12 @@ namespace fv_diffusion
     Vec            b_ = nullptr;            // RHS
     Mat            A_ = nullptr;            // linear system matrix
 
+    chi_math::PETScUtils::PETScSolverSetup petsc_solver_{}; // kept for sources
+    Vec            b_fixed_ = nullptr;      // RHS without the source
+    chi_physics::CoefficientPtr executed_source_ = nullptr;
+
+    std::map<std::string, chi_physics::CoefficientPtr> coefficients_;
+
     typedef std::pair<fv_diffusion::BoundaryType,std::vector<double>> BoundaryInfo;
     typedef std::map<std::string, BoundaryInfo> BoundaryPreferences;
     BoundaryPreferences      boundary_preferences_;
@@ -62,6 +69,16 @@ namespace fv_diffusion
                                        const chi_mesh::Vector3&);
 
     void UpdateFieldFunctions();
+
+    void SetCoefficient(const std::string& name,
+                        chi_physics::CoefficientPtr coefficient);
+    chi_physics::CoefficientPtr GetCoefficient(const std::string& name) const;
+
+    void AssembleSourceVector(const chi_physics::SpatialMaterialCoefficient& q,
+                              Vec b) const;
+
+    std::vector<std::shared_ptr<chi_physics::FieldFunctionGridBased>>
+    SolveSources(const std::vector<std::string>& source_functions);
   };
 
 } // namespace fv_diffusion
@@ -9,6 +9,8 @@ void fv_diffusion::fv_diffusion_lua_utils::RegisterLuaEntities(lua_State *L)
 {
   LUA_FMACRO1(chiFVDiffusionSolverCreate);
   LUA_FMACRO1(chiFVDiffusionSetBCProperty);
+  LUA_FMACRO1(chiFVDiffusionSetCoefficient);
+  LUA_FMACRO1(chiFVDiffusionSolveSources);
 
   LUA_CMACRO1(MAX_ITERATIONS, 1);
   LUA_CMACRO1(TOLERANCE     , 2);
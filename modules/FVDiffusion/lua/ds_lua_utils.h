@@ -8,6 +8,8 @@ namespace fv_diffusion::fv_diffusion_lua_utils
 {
   int chiFVDiffusionSolverCreate(lua_State *L);
   int chiFVDiffusionSetBCProperty(lua_State *L);
+  int chiFVDiffusionSetCoefficient(lua_State *L);
+  int chiFVDiffusionSolveSources(lua_State *L);
 
   void RegisterLuaEntities(lua_State *L);
 }//namespace cfem_diffusion
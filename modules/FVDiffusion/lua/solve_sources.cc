@@ -0,0 +1,68 @@
+#include "chi_lua.h"
+
+#include "../fv_diffusion_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace fv_diffusion::fv_diffusion_lua_utils
+{
+
+//#############################################################################
+/** Solves an executed FV Diffusion solver for several volumetric sources,
+ * reusing its matrix and preconditioner. Each source is the name of a lua
+ * function with the same arguments as "Q_ext".
+
+\param SolverHandle int Handle to an executed diffusion solver.
+\param SourceFunctions table Names of the source lua functions.
+
+\return Handles table Handles to the field functions of the sources, in the
+        order of the source functions.
+\ingroup LuaDiffusion
+*/
+int chiFVDiffusionSolveSources(lua_State *L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNumberValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+
+  //============================================= Get solver
+  const int solver_index = lua_tonumber(L,1);
+  auto& solver = Chi::GetStackItem<fv_diffusion::Solver>(Chi::object_stack,
+                                                         solver_index,
+                                                         fname);
+
+  //============================================= Get source functions
+  std::vector<std::string> source_functions;
+  const size_t num_sources = lua_rawlen(L, 2);
+  for (size_t s=0; s<num_sources; ++s)
+  {
+    lua_rawgeti(L, 2, static_cast<lua_Integer>(s)+1);
+    if (not lua_isstring(L, -1))
+      throw std::invalid_argument(fname + ": The source functions must be "
+                                          "given by name.");
+    source_functions.emplace_back(lua_tostring(L, -1));
+    lua_pop(L, 1);
+  }
+
+  //============================================= Solve
+  const auto ffs = solver.SolveSources(source_functions);
+
+  // the field functions are pushed last onto the stack
+  const size_t first_ff_index = Chi::field_function_stack.size() - ffs.size();
+  lua_newtable(L);
+  for (size_t s=0; s<ffs.size(); ++s)
+  {
+    lua_pushinteger(L, static_cast<lua_Integer>(s)+1);
+    lua_pushinteger(L, static_cast<lua_Integer>(first_ff_index + s));
+    lua_settable(L, -3);
+  }
+
+  return 1;
+}
+
+}//namespace fv_diffusion::fv_diffusion_lua_utils
@@ -42,6 +42,18 @@ PackGroupsetXS(const std::map<int, MGXSPtr>& matid_to_xs_map,
   ChiInvalidArgumentIf(num_gs_groups < 0,
                        "last_grp_index must be >= first_grp_index");
 
+  //============================================= Compute diffusion quantities
+  // These are computed on first access, here concurrently over materials
+  std::vector<const chi_physics::MultiGroupXS*> xs_list;
+  for (const auto& matid_xs_pair : matid_to_xs_map)
+    xs_list.push_back(matid_xs_pair.second.get());
+
+  const int num_xs = static_cast<int>(xs_list.size());
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < num_xs; ++i)
+    xs_list[i]->DiffusionCoefficient();
+
+  //============================================= Pack groupset ranges
   typedef lbs::acceleration::Multigroup_D_and_sigR MGXS;
   typedef std::map<int, lbs::acceleration::Multigroup_D_and_sigR> MatID2XSMap;
   MatID2XSMap matid_2_mgxs_map;
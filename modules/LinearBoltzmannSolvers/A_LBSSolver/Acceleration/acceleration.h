@@ -72,6 +72,14 @@ TwoGridCollapsedInfo
 MakeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
                          EnergyCollapseScheme scheme);
 
+typedef std::shared_ptr<chi_physics::MultiGroupXS> MGXSPtr;
+
+/**Makes the two-grid collapsed data of every material, distributing the
+ * computations over the processes. Collective.*/
+std::map<int, TwoGridCollapsedInfo>
+MakeTwoGridCollapsedInfos(const std::map<int, MGXSPtr>& matid_to_xs_map,
+                          EnergyCollapseScheme scheme);
+
 typedef std::shared_ptr<chi_mesh::sweep_management::SweepBoundary> SwpBndryPtr;
 
 /**Translates sweep boundary conditions to that used in diffusion acceleration
@@ -80,8 +88,6 @@ std::map<uint64_t, BoundaryCondition>
 TranslateBCs(const std::map<uint64_t, SwpBndryPtr>& sweep_boundaries,
              bool vaccum_bcs_are_dirichlet = true);
 
-typedef std::shared_ptr<chi_physics::MultiGroupXS> MGXSPtr;
-
 /**Makes a packaged set of XSs, suitable for diffusion, for a particular
  * set of groups.*/
 std::map<int, Multigroup_D_and_sigR>
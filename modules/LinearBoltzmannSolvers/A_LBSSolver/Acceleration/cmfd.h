@@ -0,0 +1,127 @@
+#ifndef CHITECH_LBS_ACCEL_CMFD_H
+#define CHITECH_LBS_ACCEL_CMFD_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ############################################### Forward declarations
+namespace chi_mesh
+{
+struct Vector3;
+}
+
+namespace lbs
+{
+class LBSSolver;
+}
+
+namespace lbs::acceleration
+{
+
+/**Coarse mesh finite difference (CMFD) accelerator, i.e. nonlinear
+ * diffusion acceleration on a coarse mesh.
+ *
+ * The coarse mesh is a logically Cartesian partition of the global bounding
+ * box into `dims` bins, each fine cell belonging to the bin containing its
+ * centroid. Coarse cells, coarse faces and all coarse data are replicated on
+ * all processes.
+ *
+ * Tally integrates the flux weighted cross sections of a transport iterate
+ * over the coarse cells, and the upwind net currents, from the angular
+ * fluxes, over the coarse faces. The coarse diffusion coupling coefficients
+ * are then corrected such that the coarse currents of the transport iterate
+ * are reproduced exactly. SolveEigenvalue solves the resulting coarse
+ * k-eigenvalue problem and Prolongate scales the fine flux moments by the
+ * ratio of the new to the tallied coarse fluxes.
+ *
+ * The angular fluxes must be stored (`save_angular_flux`).*/
+class CMFDAccelerator
+{
+public:
+  struct Options
+  {
+    std::array<size_t, 3> dims = {1, 1, 1}; ///< Coarse bins per direction
+    int max_iters = 500;       ///< Coarse power iterations
+    double k_tol = 1.0e-8;     ///< Coarse k-eigenvalue tolerance
+    int inner_sweeps = 5;      ///< Gauss-Seidel sweeps per group and iteration
+    bool verbose = false;
+  };
+
+protected:
+  /**A face between two coarse cells, oriented from `c0` to `c1`.*/
+  struct CoarseFace
+  {
+    size_t c0 = 0;
+    size_t c1 = 0;
+    double area = 0.0;
+    double h0 = 0.0; ///< Distance from the centroid of c0 to the face
+    double h1 = 0.0; ///< Distance from the centroid of c1 to the face
+  };
+
+  /**A coupling of a coarse cell into the balance of another.*/
+  struct CoarseNeighbor
+  {
+    size_t cell = 0;
+    size_t face = 0;
+    bool is_c0 = true; ///< True when the owning cell is `c0` of the face
+  };
+
+  const std::string text_name_;
+  LBSSolver& lbs_solver_;
+  const Options options_;
+
+  size_t num_coarse_cells_ = 0;
+  size_t num_groups_ = 0;
+
+  std::vector<size_t> cell_coarse_ids_;              ///< Per local cell
+  std::vector<std::vector<int64_t>> cell_face_ids_;  ///< -1 interior to bin
+
+  std::vector<double> coarse_volumes_;
+  std::vector<CoarseFace> coarse_faces_;
+  std::vector<std::vector<CoarseNeighbor>> coarse_neighbors_;
+
+  /**Union over the materials of the isotropic scattering structure, in
+   * compressed row form.*/
+  std::vector<size_t> scat_row_offsets_;
+  std::vector<size_t> scat_col_ids_;
+
+  //Tallies (N x G unless noted)
+  std::vector<double> phi_int_;        ///< Int phi
+  std::vector<double> sigt_rr_;        ///< Int sigma_t phi
+  std::vector<double> diff_rr_;        ///< Int D phi
+  std::vector<double> prod_rr_;        ///< Int of the fission source
+  std::vector<double> nsf_rr_;         ///< Int nu-sigma_f phi per source grp
+  std::vector<double> scat_rr_;        ///< N x nnz, Int sigma_s phi
+  std::vector<double> face_currents_;  ///< Faces x G, net current c0 to c1
+  std::vector<double> bndry_currents_; ///< Net outward boundary current
+
+  std::vector<double> phi_coarse_new_;
+
+public:
+  CMFDAccelerator(std::string text_name,
+                  LBSSolver& lbs_solver,
+                  const Options& options);
+
+  void Initialize();
+
+  size_t NumCoarseCells() const { return num_coarse_cells_; }
+
+  void Tally(const std::vector<double>& phi);
+
+  bool SolveEigenvalue(double& k_eff);
+
+  void Prolongate(std::vector<double>& phi) const;
+
+protected:
+  size_t MapCoarseCell(const chi_mesh::Vector3& point,
+                       const chi_mesh::Vector3& xyz_min,
+                       const chi_mesh::Vector3& xyz_max) const;
+
+  size_t ScatteringEntry(size_t g, size_t gp) const;
+};
+
+} // namespace lbs::acceleration
+
+#endif // CHITECH_LBS_ACCEL_CMFD_H
@@ -0,0 +1,275 @@
+#include "cmfd.h"
+
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace lbs::acceleration
+{
+
+// ###################################################################
+/**Constructor.*/
+CMFDAccelerator::CMFDAccelerator(std::string text_name,
+                                 LBSSolver& lbs_solver,
+                                 const Options& options)
+  : text_name_(std::move(text_name)),
+    lbs_solver_(lbs_solver),
+    options_(options)
+{
+  for (const size_t dim : options_.dims)
+    ChiInvalidArgumentIf(dim == 0,
+                         text_name_ + ": The coarse mesh needs at least one "
+                                      "bin in each direction.");
+}
+
+// ###################################################################
+/**Returns the coarse cell containing the given point.*/
+size_t CMFDAccelerator::MapCoarseCell(const chi_mesh::Vector3& point,
+                                      const chi_mesh::Vector3& xyz_min,
+                                      const chi_mesh::Vector3& xyz_max) const
+{
+  std::array<size_t, 3> ijk = {0, 0, 0};
+  for (int d = 0; d < 3; ++d)
+  {
+    const double length = xyz_max[d] - xyz_min[d];
+    if (length <= 0.0) continue;
+
+    const double s = (point[d] - xyz_min[d]) / length;
+    const auto n = static_cast<double>(options_.dims[d]);
+    ijk[d] = static_cast<size_t>(
+      std::clamp(std::floor(s * n), 0.0, n - 1.0));
+  }
+  return (ijk[2] * options_.dims[1] + ijk[1]) * options_.dims[0] + ijk[0];
+}
+
+// ###################################################################
+/**Returns the index of the scattering entry for the transfer from group
+ * `gp` into group `g`.*/
+size_t CMFDAccelerator::ScatteringEntry(const size_t g, const size_t gp) const
+{
+  const auto begin = scat_col_ids_.begin() + scat_row_offsets_[g];
+  const auto end = scat_col_ids_.begin() + scat_row_offsets_[g + 1];
+  return std::lower_bound(begin, end, gp) - scat_col_ids_.begin();
+}
+
+// ###################################################################
+/**Builds the coarse cells and faces, and their geometric data.*/
+void CMFDAccelerator::Initialize()
+{
+  const auto& grid = lbs_solver_.Grid();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& unit_cell_matrices = lbs_solver_.GetUnitCellMatrices();
+  const auto& lbs_options = lbs_solver_.Options();
+
+  for (const auto& groupset : lbs_solver_.Groupsets())
+    ChiInvalidArgumentIf(not lbs_solver_.SavesAngularFlux(groupset.id_),
+                         text_name_ + ": Requires options.save_angular_flux "
+                                      "to be true for all groupsets.");
+  ChiInvalidArgumentIf(
+    lbs_options.geometry_type != GeometryType::ONED_SLAB and
+      lbs_options.geometry_type != GeometryType::TWOD_CARTESIAN and
+      lbs_options.geometry_type != GeometryType::THREED_CARTESIAN,
+    text_name_ + ": Only cartesian geometries are supported.");
+
+  num_groups_ = lbs_solver_.NumGroups();
+  num_coarse_cells_ = options_.dims[0] * options_.dims[1] * options_.dims[2];
+  const size_t N = num_coarse_cells_;
+
+  //============================================= Global bounding box
+  const auto [local_min, local_max] = grid.GetLocalBoundingBox();
+  double local_bounds[6] = {-local_min.x, -local_min.y, -local_min.z,
+                            local_max.x, local_max.y, local_max.z};
+  double global_bounds[6];
+  MPI_Allreduce(local_bounds,   //sendbuf
+                global_bounds,  //recvbuf
+                6, MPI_DOUBLE,  //count+datatype
+                MPI_MAX,        //operation
+                Chi::mpi.comm); //communicator
+
+  const chi_mesh::Vector3 xyz_min(
+    -global_bounds[0], -global_bounds[1], -global_bounds[2]);
+  const chi_mesh::Vector3 xyz_max(
+    global_bounds[3], global_bounds[4], global_bounds[5]);
+
+  //============================================= Coarse cells
+  std::vector<double> local_cell_data(4 * N, 0.0); //volume + V*centroid
+  cell_coarse_ids_.assign(grid.local_cells.size(), 0);
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = MapCoarseCell(cell.centroid_, xyz_min, xyz_max);
+    const double volume = transport_views[cell.local_id_].Volume();
+
+    cell_coarse_ids_[cell.local_id_] = c;
+    local_cell_data[4 * c] += volume;
+    for (int d = 0; d < 3; ++d)
+      local_cell_data[4 * c + 1 + d] += volume * cell.centroid_[d];
+  }
+
+  std::vector<double> cell_data(4 * N, 0.0);
+  MPI_Allreduce(local_cell_data.data(),               //sendbuf
+                cell_data.data(),                     //recvbuf
+                static_cast<int>(4 * N), MPI_DOUBLE,  //count+datatype
+                MPI_SUM,                              //operation
+                Chi::mpi.comm);                       //communicator
+
+  coarse_volumes_.assign(N, 0.0);
+  std::vector<chi_mesh::Vector3> coarse_centroids(N);
+  for (size_t c = 0; c < N; ++c)
+  {
+    coarse_volumes_[c] = cell_data[4 * c];
+    if (coarse_volumes_[c] > 0.0)
+      coarse_centroids[c] = chi_mesh::Vector3(cell_data[4 * c + 1],
+                                              cell_data[4 * c + 2],
+                                              cell_data[4 * c + 3]) /
+                            coarse_volumes_[c];
+  }
+
+  //============================================= Coarse faces
+  // Faces are identified by the key c0 * N + c1, with c0 < c1, and are
+  // ordered by key on all processes
+  std::set<uint64_t> local_face_keys;
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = cell_coarse_ids_[cell.local_id_];
+    for (const auto& face : cell.faces_)
+    {
+      if (not face.has_neighbor_) continue;
+      const auto& adj_cell = grid.cells[face.neighbor_id_];
+      const size_t c_adj = MapCoarseCell(adj_cell.centroid_, xyz_min, xyz_max);
+      if (c_adj != c)
+        local_face_keys.insert(std::min(c, c_adj) * N + std::max(c, c_adj));
+    }
+  }
+
+  const std::vector<uint64_t> local_keys(local_face_keys.begin(),
+                                         local_face_keys.end());
+  const int local_count = static_cast<int>(local_keys.size());
+  std::vector<int> counts(Chi::mpi.process_count, 0);
+  MPI_Allgather(&local_count,   //sendbuf
+                1, MPI_INT,     //sendcount + sendtype
+                counts.data(),  //recvbuf
+                1, MPI_INT,     //recvcount + recvtype
+                Chi::mpi.comm); //communicator
+
+  std::vector<int> displs(Chi::mpi.process_count, 0);
+  int total_count = 0;
+  for (int locI = 0; locI < Chi::mpi.process_count; ++locI)
+  {
+    displs[locI] = total_count;
+    total_count += counts[locI];
+  }
+
+  std::vector<uint64_t> face_keys(total_count, 0);
+  MPI_Allgatherv(local_keys.data(),          //sendbuf
+                 local_count, MPI_UINT64_T,  //sendcount + sendtype
+                 face_keys.data(),           //recvbuf
+                 counts.data(),              //recvcount
+                 displs.data(),              //recvdispl
+                 MPI_UINT64_T,               //recvtype
+                 Chi::mpi.comm);             //communicator
+
+  std::sort(face_keys.begin(), face_keys.end());
+  face_keys.erase(std::unique(face_keys.begin(), face_keys.end()),
+                  face_keys.end());
+  const size_t num_faces = face_keys.size();
+
+  //============================================= Map the fine faces and
+  //                                              accumulate face geometry
+  std::vector<double> local_face_data(4 * num_faces, 0.0); //area + A*centroid
+  cell_face_ids_.assign(grid.local_cells.size(), {});
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = cell_coarse_ids_[cell.local_id_];
+    const auto& fe_values = unit_cell_matrices[cell.local_id_];
+    auto& face_ids = cell_face_ids_[cell.local_id_];
+    face_ids.assign(cell.faces_.size(), -1);
+
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const auto& face = cell.faces_[f];
+      if (not face.has_neighbor_) continue;
+      const auto& adj_cell = grid.FaceNeighbor(cell, f);
+      const size_t c_adj = MapCoarseCell(adj_cell.centroid_, xyz_min, xyz_max);
+      if (c_adj == c) continue;
+
+      const uint64_t key = std::min(c, c_adj) * N + std::max(c, c_adj);
+      const size_t face_id =
+        std::lower_bound(face_keys.begin(), face_keys.end(), key) -
+        face_keys.begin();
+      face_ids[f] = static_cast<int64_t>(face_id);
+
+      double area = 0.0;
+      const double* IntF_shapeI = fe_values.face_Si_vectors[f];
+      for (size_t i = 0; i < fe_values.num_nodes; ++i)
+        area += IntF_shapeI[i];
+
+      //every fine face is visited from both sides
+      local_face_data[4 * face_id] += 0.5 * area;
+      for (int d = 0; d < 3; ++d)
+        local_face_data[4 * face_id + 1 + d] += 0.5 * area * face.centroid_[d];
+    }
+  }
+
+  std::vector<double> face_data(4 * num_faces, 0.0);
+  MPI_Allreduce(local_face_data.data(),                      //sendbuf
+                face_data.data(),                            //recvbuf
+                static_cast<int>(4 * num_faces), MPI_DOUBLE, //count+datatype
+                MPI_SUM,                                     //operation
+                Chi::mpi.comm);                              //communicator
+
+  coarse_faces_.assign(num_faces, {});
+  coarse_neighbors_.assign(N, {});
+  for (size_t k = 0; k < num_faces; ++k)
+  {
+    auto& coarse_face = coarse_faces_[k];
+    coarse_face.c0 = face_keys[k] / N;
+    coarse_face.c1 = face_keys[k] % N;
+    coarse_face.area = face_data[4 * k];
+
+    const chi_mesh::Vector3 centroid =
+      chi_mesh::Vector3(face_data[4 * k + 1],
+                        face_data[4 * k + 2],
+                        face_data[4 * k + 3]) / coarse_face.area;
+    coarse_face.h0 = (centroid - coarse_centroids[coarse_face.c0]).Norm();
+    coarse_face.h1 = (centroid - coarse_centroids[coarse_face.c1]).Norm();
+
+    coarse_neighbors_[coarse_face.c0].push_back({coarse_face.c1, k, true});
+    coarse_neighbors_[coarse_face.c1].push_back({coarse_face.c0, k, false});
+  }
+
+  //============================================= Scattering structure
+  std::vector<std::set<size_t>> scat_cols(num_groups_);
+  for (const auto& [mat_id, xs] : lbs_solver_.GetMatID2XSMap())
+  {
+    if (xs->TransferMatrices().empty()) continue;
+    const auto& S0 = xs->TransferMatrices().front();
+    for (size_t g = 0; g < num_groups_ and g < S0.rowI_indices_.size(); ++g)
+      for (const size_t gp : S0.rowI_indices_[g])
+        if (gp < num_groups_) scat_cols[g].insert(gp);
+  }
+
+  scat_row_offsets_.assign(1, 0);
+  scat_col_ids_.clear();
+  for (const auto& cols : scat_cols)
+  {
+    scat_col_ids_.insert(scat_col_ids_.end(), cols.begin(), cols.end());
+    scat_row_offsets_.push_back(scat_col_ids_.size());
+  }
+
+  const size_t num_active = std::count_if(coarse_volumes_.begin(),
+                                          coarse_volumes_.end(),
+                                          [](double V) { return V > 0.0; });
+  Chi::log.Log() << text_name_ << ": Coarse mesh with " << num_active
+                 << " cells and " << num_faces << " interior faces.";
+}
+
+} // namespace lbs::acceleration
@@ -0,0 +1,220 @@
+#include "cmfd.h"
+
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "math/SpatialDiscretization/CellMappings/cell_mapping_base.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <map>
+
+namespace lbs::acceleration
+{
+
+// ###################################################################
+/**Tallies the coarse cell reaction rates of the given flux moments, and
+ * the coarse face currents of the stored angular fluxes, which must belong
+ * to the same transport iterate.
+ *
+ * Interior currents use the upwind angular flux, i.e. each side tallies its
+ * own outgoing partial current. Boundary currents are zero on reflecting
+ * boundaries and only outgoing on vacuum boundaries. Other boundaries use
+ * the cell's own trace for the incoming directions.*/
+void CMFDAccelerator::Tally(const std::vector<double>& phi)
+{
+  typedef chi_mesh::sweep_management::BoundaryType BoundaryType;
+
+  const auto& grid = lbs_solver_.Grid();
+  const auto& sdm = lbs_solver_.SpatialDiscretization();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& unit_cell_matrices = lbs_solver_.GetUnitCellMatrices();
+  const auto& sweep_boundaries = lbs_solver_.SweepBoundaries();
+  const auto& psi = lbs_solver_.PsiNewLocal();
+  auto& groupsets = lbs_solver_.Groupsets();
+
+  const size_t N = num_coarse_cells_;
+  const size_t G = num_groups_;
+  const size_t nnz = scat_col_ids_.size();
+  const size_t num_faces = coarse_faces_.size();
+
+  //============================================= Fission source of the
+  //                                              iterate
+  std::vector<double> q_fission(phi.size(), 0.0);
+  const auto source_function = lbs_solver_.GetActiveSetSourceFunction();
+  for (auto& groupset : groupsets)
+    source_function(groupset, q_fission, phi,
+                    APPLY_AGS_FISSION_SOURCES | APPLY_WGS_FISSION_SOURCES);
+
+  //============================================= Total production per
+  //                                              source group
+  std::map<const chi_physics::MultiGroupXS*, std::vector<double>> xs_nu_sigf;
+  for (const auto& [mat_id, xs] : lbs_solver_.GetMatID2XSMap())
+  {
+    if (not xs->IsFissionable()) continue;
+    auto& nu_sigf = xs_nu_sigf[xs.get()];
+    nu_sigf.assign(G, 0.0);
+
+    const auto F = xs->Production().ToMatrix();
+    for (size_t g = 0; g < F.size() and g < G; ++g)
+      for (size_t gp = 0; gp < F[g].size() and gp < G; ++gp)
+        nu_sigf[gp] += F[g][gp];
+
+    if (lbs_solver_.Options().use_precursors and xs->NumPrecursors() > 0)
+      for (size_t gp = 0; gp < G; ++gp)
+        nu_sigf[gp] += xs->NuDelayedSigmaF()[gp];
+  }
+
+  //============================================= Packed local tallies
+  const size_t phi_offset = 0;
+  const size_t sigt_offset = phi_offset + N * G;
+  const size_t diff_offset = sigt_offset + N * G;
+  const size_t prod_offset = diff_offset + N * G;
+  const size_t nsf_offset = prod_offset + N * G;
+  const size_t scat_offset = nsf_offset + N * G;
+  const size_t face_offset = scat_offset + N * nnz;
+  const size_t bndry_offset = face_offset + num_faces * G;
+  const size_t tally_size = bndry_offset + N * G;
+
+  std::vector<double> local_tallies(tally_size, 0.0);
+
+  //============================================= Reaction rates
+  std::vector<double> phi_scratch, q_scratch;
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = cell_coarse_ids_[cell.local_id_];
+    const auto& transport_view = transport_views[cell.local_id_];
+    const auto& fe_values = unit_cell_matrices[cell.local_id_];
+    const auto& xs = transport_view.XS();
+
+    const auto& sigma_t = xs.SigmaTotal();
+    const auto& D = xs.DiffusionCoefficient();
+    const auto nsf_it = xs_nu_sigf.find(&xs);
+    const auto* nu_sigf =
+      nsf_it != xs_nu_sigf.end() ? &nsf_it->second : nullptr;
+    const auto* S0 =
+      xs.TransferMatrices().empty() ? nullptr : &xs.TransferMatrices().front();
+
+    for (int i = 0; i < transport_view.NumNodes(); ++i)
+    {
+      const double* phi_i = transport_view.GroupValues(phi, i, 0, phi_scratch);
+      const double* q_i =
+        transport_view.GroupValues(q_fission, i, 0, q_scratch);
+      const double IntV_ShapeI = fe_values.Vi_vectors[i];
+
+      for (size_t g = 0; g < G; ++g)
+      {
+        const double phi_g = phi_i[g] * IntV_ShapeI;
+        const size_t cg = c * G + g;
+
+        local_tallies[phi_offset + cg] += phi_g;
+        local_tallies[sigt_offset + cg] += sigma_t[g] * phi_g;
+        local_tallies[diff_offset + cg] += D[g] * phi_g;
+        local_tallies[prod_offset + cg] += q_i[g] * IntV_ShapeI;
+        if (nu_sigf) local_tallies[nsf_offset + cg] += (*nu_sigf)[g] * phi_g;
+      }
+
+      if (S0)
+        for (size_t g = 0; g < G and g < S0->rowI_indices_.size(); ++g)
+        {
+          const auto& col_ids = S0->rowI_indices_[g];
+          const auto& col_vals = S0->rowI_values_[g];
+          for (size_t k = 0; k < col_ids.size(); ++k)
+          {
+            const size_t gp = col_ids[k];
+            if (gp >= G) continue;
+            local_tallies[scat_offset + c * nnz + ScatteringEntry(g, gp)] +=
+              col_vals[k] * phi_i[gp] * IntV_ShapeI;
+          }
+        }
+    }//for node
+  }//for cell
+
+  //============================================= Currents
+  for (size_t gs_id = 0; gs_id < groupsets.size(); ++gs_id)
+  {
+    const auto& groupset = groupsets[gs_id];
+    const auto& psi_uk_man = groupset.psi_uk_man_;
+    const auto& quadrature = groupset.quadrature_;
+    const auto& gs_psi = psi[gs_id];
+
+    ChiLogicalErrorIf(gs_psi.empty(),
+                      text_name_ + ": No angular fluxes stored for "
+                                   "groupset " + std::to_string(gs_id) + ".");
+
+    const size_t num_angles = quadrature->omegas_.size();
+    const int gsi = groupset.groups_.front().id_;
+    const int gs_num_groups = static_cast<int>(groupset.groups_.size());
+
+    for (const auto& cell : grid.local_cells)
+    {
+      const size_t c = cell_coarse_ids_[cell.local_id_];
+      const auto& cell_mapping = sdm.GetCellMapping(cell);
+      const auto& fe_values = unit_cell_matrices[cell.local_id_];
+      const auto& face_ids = cell_face_ids_[cell.local_id_];
+
+      for (size_t f = 0; f < cell.faces_.size(); ++f)
+      {
+        const auto& face = cell.faces_[f];
+
+        double* tally = nullptr;
+        double sign = 1.0;
+        bool outgoing_only = true;
+        if (face.has_neighbor_)
+        {
+          if (face_ids[f] < 0) continue;
+          const auto& coarse_face = coarse_faces_[face_ids[f]];
+          tally = &local_tallies[face_offset + face_ids[f] * G];
+          sign = (c == coarse_face.c0) ? 1.0 : -1.0;
+        }
+        else
+        {
+          const auto& bndry = sweep_boundaries.at(face.neighbor_id_);
+          if (bndry->IsReflecting()) continue;
+          tally = &local_tallies[bndry_offset + c * G];
+          outgoing_only = bndry->Type() == BoundaryType::INCIDENT_VACCUUM;
+        }
+
+        const auto& IntF_shapeI = fe_values.face_Si_vectors[f];
+        const size_t num_face_nodes = cell_mapping.NumFaceNodes(f);
+        for (size_t fi = 0; fi < num_face_nodes; ++fi)
+        {
+          const int i = cell_mapping.MapFaceNode(f, fi);
+          for (size_t n = 0; n < num_angles; ++n)
+          {
+            const double mu = quadrature->omegas_[n].Dot(face.normal_);
+            if (outgoing_only and mu <= 0.0) continue;
+
+            const double wt = sign * quadrature->weights_[n] * mu *
+                              IntF_shapeI[i];
+            const int64_t imap = sdm.MapDOFLocal(cell, i, psi_uk_man, n, 0);
+            for (int gsg = 0; gsg < gs_num_groups; ++gsg)
+              tally[gsi + gsg] += wt * gs_psi[imap + gsg];
+          }//for n
+        }//for face node
+      }//for face
+    }//for cell
+  }//for groupset
+
+  //============================================= Reduce the tallies
+  std::vector<double> tallies(tally_size, 0.0);
+  MPI_Allreduce(local_tallies.data(),                     //sendbuf
+                tallies.data(),                           //recvbuf
+                static_cast<int>(tally_size), MPI_DOUBLE, //count+datatype
+                MPI_SUM,                                  //operation
+                Chi::mpi.comm);                           //communicator
+
+  const auto begin = tallies.begin();
+  phi_int_.assign(begin + phi_offset, begin + sigt_offset);
+  sigt_rr_.assign(begin + sigt_offset, begin + diff_offset);
+  diff_rr_.assign(begin + diff_offset, begin + prod_offset);
+  prod_rr_.assign(begin + prod_offset, begin + nsf_offset);
+  nsf_rr_.assign(begin + nsf_offset, begin + scat_offset);
+  scat_rr_.assign(begin + scat_offset, begin + face_offset);
+  face_currents_.assign(begin + face_offset, begin + bndry_offset);
+  bndry_currents_.assign(begin + bndry_offset, tallies.end());
+}
+
+} // namespace lbs::acceleration
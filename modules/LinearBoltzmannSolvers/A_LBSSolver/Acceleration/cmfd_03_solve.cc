@@ -0,0 +1,253 @@
+#include "cmfd.h"
+
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <cmath>
+
+namespace lbs::acceleration
+{
+
+// ###################################################################
+/**Solves the coarse k-eigenvalue problem of the last tally, starting from
+ * the given eigenvalue, which is updated on success.
+ *
+ * The coarse balance of cell c and group g reads
+ * sum_faces J_f + kappa_cg Phi_cg + sigt_cg V_c Phi_cg =
+ * sum_g' sigs_cgg' V_c Phi_cg' + chi_cg F_c / k, with the corrected face
+ * current J_f = -Dtilde (Phi_1 - Phi_0) + Dhat (Phi_0 + Phi_1). The problem
+ * is solved with power iterations using Gauss-Seidel sweeps over the groups
+ * and coarse cells. The coarse solution is normalized to the production of
+ * the tallied iterate.
+ *
+ * Returns false, leaving the eigenvalue unchanged, when the tallied iterate
+ * does not yield a well posed coarse problem (non-positive coarse fluxes
+ * or diagonals, or no production).*/
+bool CMFDAccelerator::SolveEigenvalue(double& k_eff)
+{
+  const size_t N = num_coarse_cells_;
+  const size_t G = num_groups_;
+  const size_t nnz = scat_col_ids_.size();
+  const size_t num_faces = coarse_faces_.size();
+
+  ChiLogicalErrorIf(phi_int_.size() != N * G,
+                    text_name_ + ": Tally must be called before solving.");
+
+  auto Fail = [this](const std::string& reason)
+  {
+    if (options_.verbose)
+      Chi::log.Log0Warning() << text_name_ << ": Coarse solve skipped, "
+                             << reason << ".";
+    return false;
+  };
+
+  //============================================= Coarse fluxes
+  std::vector<double> phi_c(N * G, 0.0);
+  for (size_t c = 0; c < N; ++c)
+  {
+    const double V = coarse_volumes_[c];
+    if (V <= 0.0) continue;
+    for (size_t g = 0; g < G; ++g)
+    {
+      const double phi_int = phi_int_[c * G + g];
+      if (not(phi_int > 0.0)) return Fail("non-positive coarse flux");
+      phi_c[c * G + g] = phi_int / V;
+    }
+  }
+
+  //============================================= Homogenized coefficients,
+  //                                              multiplied by the volume
+  std::vector<double> sigt_coef(N * G, 0.0);
+  std::vector<double> nsf_coef(N * G, 0.0);
+  std::vector<double> chi(N * G, 0.0);
+  std::vector<double> scat_coef(N * nnz, 0.0);
+  std::vector<double> diff_coef(N * G, 0.0);
+  double total_production = 0.0;
+  for (size_t c = 0; c < N; ++c)
+  {
+    if (coarse_volumes_[c] <= 0.0) continue;
+
+    double nsf_sum = 0.0;
+    for (size_t g = 0; g < G; ++g)
+    {
+      const size_t cg = c * G + g;
+      sigt_coef[cg] = sigt_rr_[cg] / phi_c[cg];
+      nsf_coef[cg] = nsf_rr_[cg] / phi_c[cg];
+      diff_coef[cg] = diff_rr_[cg] / phi_int_[cg];
+      nsf_sum += nsf_rr_[cg];
+    }
+    total_production += nsf_sum;
+
+    if (nsf_sum > 0.0)
+      for (size_t g = 0; g < G; ++g)
+        chi[c * G + g] = prod_rr_[c * G + g] / nsf_sum;
+
+    for (size_t g = 0; g < G; ++g)
+      for (size_t k = scat_row_offsets_[g]; k < scat_row_offsets_[g + 1]; ++k)
+        scat_coef[c * nnz + k] =
+          scat_rr_[c * nnz + k] / phi_c[c * G + scat_col_ids_[k]];
+  }
+
+  if (not(total_production > 0.0)) return Fail("no fission production");
+
+  //============================================= Face coupling coefficients
+  std::vector<double> D_tilde(num_faces * G, 0.0);
+  std::vector<double> D_hat(num_faces * G, 0.0);
+  for (size_t f = 0; f < num_faces; ++f)
+  {
+    const auto& face = coarse_faces_[f];
+    for (size_t g = 0; g < G; ++g)
+    {
+      const double D0 = diff_coef[face.c0 * G + g];
+      const double D1 = diff_coef[face.c1 * G + g];
+      const double phi0 = phi_c[face.c0 * G + g];
+      const double phi1 = phi_c[face.c1 * G + g];
+      const double J = face_currents_[f * G + g];
+
+      const double Dt = face.area / (face.h0 / D0 + face.h1 / D1);
+      D_tilde[f * G + g] = Dt;
+      D_hat[f * G + g] = (J + Dt * (phi1 - phi0)) / (phi0 + phi1);
+    }
+  }
+
+  //============================================= Diagonals
+  std::vector<double> diag(N * G, 0.0);
+  for (size_t c = 0; c < N; ++c)
+  {
+    if (coarse_volumes_[c] <= 0.0) continue;
+    for (size_t g = 0; g < G; ++g)
+    {
+      const size_t cg = c * G + g;
+      double d = sigt_coef[cg] + bndry_currents_[cg] / phi_c[cg];
+
+      const size_t k = ScatteringEntry(g, g);
+      if (k < scat_row_offsets_[g + 1] and scat_col_ids_[k] == g)
+        d -= scat_coef[c * nnz + k];
+
+      for (const auto& nb : coarse_neighbors_[c])
+      {
+        const size_t fg = nb.face * G + g;
+        d += nb.is_c0 ? D_tilde[fg] + D_hat[fg] : D_tilde[fg] - D_hat[fg];
+      }
+
+      if (not(d > 0.0)) return Fail("non-positive diagonal");
+      diag[cg] = d;
+    }
+  }
+
+  //============================================= Power iterations
+  auto ComputeProduction = [&](const std::vector<double>& phi,
+                               std::vector<double>& production)
+  {
+    double total = 0.0;
+    for (size_t c = 0; c < N; ++c)
+    {
+      double F = 0.0;
+      for (size_t g = 0; g < G; ++g)
+        F += nsf_coef[c * G + g] * phi[c * G + g];
+      production[c] = F;
+      total += F;
+    }
+    return total;
+  };
+
+  std::vector<double> phi = phi_c;
+  std::vector<double> production(N, 0.0);
+  double production_total = ComputeProduction(phi, production);
+  double k = k_eff;
+  double k_change = 1.0;
+  int nit = 0;
+  for (; nit < options_.max_iters; ++nit)
+  {
+    for (size_t g = 0; g < G; ++g)
+      for (int sweep = 0; sweep < options_.inner_sweeps; ++sweep)
+        for (size_t c = 0; c < N; ++c)
+        {
+          if (coarse_volumes_[c] <= 0.0) continue;
+          const size_t cg = c * G + g;
+
+          double rhs = chi[cg] * production[c] / k;
+          for (size_t e = scat_row_offsets_[g]; e < scat_row_offsets_[g + 1];
+               ++e)
+          {
+            const size_t gp = scat_col_ids_[e];
+            if (gp != g) rhs += scat_coef[c * nnz + e] * phi[c * G + gp];
+          }
+
+          for (const auto& nb : coarse_neighbors_[c])
+          {
+            const size_t fg = nb.face * G + g;
+            const double coupling = nb.is_c0 ? -D_tilde[fg] + D_hat[fg]
+                                             : -D_tilde[fg] - D_hat[fg];
+            rhs -= coupling * phi[nb.cell * G + g];
+          }
+
+          phi[cg] = rhs / diag[cg];
+        }
+
+    const double production_new = ComputeProduction(phi, production);
+    const double k_new = k * production_new / production_total;
+    if (not std::isfinite(k_new) or not(k_new > 0.0))
+      return Fail("diverged coarse iterations");
+
+    k_change = std::fabs(k_new - k) / k_new;
+    k = k_new;
+    production_total = production_new;
+
+    if (k_change < options_.k_tol) break;
+  }
+
+  //============================================= Normalize and store
+  const double scale = total_production / production_total;
+  for (double& value : phi)
+    value *= scale;
+
+  phi_coarse_new_ = std::move(phi);
+  k_eff = k;
+
+  if (options_.verbose)
+    Chi::log.Log() << text_name_ << ": Coarse k_eff " << k << " after "
+                   << nit << " iterations, change " << k_change << ".";
+
+  return true;
+}
+
+// ###################################################################
+/**Scales all the flux moments of every local cell by the ratio of the new
+ * to the tallied flux of its coarse cell.*/
+void CMFDAccelerator::Prolongate(std::vector<double>& phi) const
+{
+  const size_t G = num_groups_;
+  ChiLogicalErrorIf(phi_coarse_new_.size() != num_coarse_cells_ * G,
+                    text_name_ + ": SolveEigenvalue must succeed before "
+                                 "prolongating.");
+
+  std::vector<double> ratio(num_coarse_cells_ * G, 1.0);
+  for (size_t c = 0; c < num_coarse_cells_; ++c)
+  {
+    const double V = coarse_volumes_[c];
+    if (V <= 0.0) continue;
+    for (size_t g = 0; g < G; ++g)
+      ratio[c * G + g] = phi_coarse_new_[c * G + g] * V / phi_int_[c * G + g];
+  }
+
+  const auto& grid = lbs_solver_.Grid();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
+  const size_t num_moments = lbs_solver_.NumMoments();
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t c = cell_coarse_ids_[cell.local_id_];
+    const auto& transport_view = transport_views[cell.local_id_];
+    for (int i = 0; i < transport_view.NumNodes(); ++i)
+      for (size_t m = 0; m < num_moments; ++m)
+        for (size_t g = 0; g < G; ++g)
+          phi[transport_view.MapDOF(i, m, g)] *= ratio[c * G + g];
+  }
+}
+
+} // namespace lbs::acceleration
@@ -17,7 +17,7 @@ DiffusionSolver::DiffusionSolver(
   const chi_math::UnknownManager& uk_man,
   std::map<uint64_t, BoundaryCondition> bcs,
   MatID2XSMap map_mat_id_2_xs,
-  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+  const PackedUnitCellMatrices& unit_cell_matrices,
   const bool verbose,
   const bool requires_ghosts)
   : text_name_(std::move(text_name)),
@@ -29,10 +29,14 @@ DiffusionSolver::DiffusionSolver(
     unit_cell_matrices_(unit_cell_matrices),
     num_local_dofs_(static_cast<int64_t>(sdm_.GetNumLocalDOFs(uk_man_))),
     num_global_dofs_(static_cast<int64_t>(sdm_.GetNumGlobalDOFs(uk_man_))),
+    dof_table_(sdm_, uk_man_,
+               /*with_ghosts=*/sdm_.Type() == chi_math::SpatialDiscretizationType::
+                                                PIECEWISE_LINEAR_DISCONTINUOUS),
     A_(nullptr),
     rhs_(nullptr),
     ksp_(nullptr),
-    requires_ghosts_(requires_ghosts)
+    requires_ghosts_(requires_ghosts),
+    pc_mat_id_2_xs_map_(mat_id_2_xs_map_)
 {
   options.verbose = verbose;
 }
@@ -75,6 +79,25 @@ lbs::acceleration::DiffusionSolver::GetNumPhiIterativeUnknowns()
   return {sdm_.GetNumLocalDOFs(uk_man_), sdm_.GetNumGlobalDOFs(uk_man_)};
 }
 
+// ##################################################################
+size_t lbs::acceleration::DiffusionSolver::GetMemoryUsage() const
+{
+  size_t num_bytes = dof_table_.GetMemoryUsage();
+  if (A_)
+  {
+    MatInfo info;
+    MatGetInfo(A_, MAT_LOCAL, &info);
+    num_bytes += static_cast<size_t>(info.memory);
+  }
+  if (rhs_)
+  {
+    PetscInt local_size = 0;
+    VecGetLocalSize(rhs_, &local_size);
+    num_bytes += static_cast<size_t>(local_size) * sizeof(PetscScalar);
+  }
+  return num_bytes;
+}
+
 // ##################################################################
 /**Adds to the right-hand side without applying spatial discretization.*/
 void lbs::acceleration::DiffusionSolver::AddToRHS(
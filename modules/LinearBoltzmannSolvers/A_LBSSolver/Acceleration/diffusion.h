@@ -3,8 +3,13 @@
 
 #include "acceleration.h"
 #include "math/UnknownManager/unknown_manager.h"
+#include "math/SpatialDiscretization/cell_dof_table.h"
+#include "math/PETScUtils/petsc_element_assembler.h"
+#include "math/PETScUtils/petsc_utils.h"
 #include "petscksp.h"
 
+#include <memory>
+
 // ############################################### Forward declarations
 namespace chi_mesh
 {
@@ -20,7 +25,7 @@ class SpatialDiscretization;
 
 namespace lbs
 {
-struct UnitCellMatrices;
+class PackedUnitCellMatrices;
 }
 
 namespace lbs::acceleration
@@ -41,19 +46,31 @@ protected:
 
   const std::map<uint64_t, BoundaryCondition> bcs_;
 
-  const MatID2XSMap mat_id_2_xs_map_;
+  MatID2XSMap mat_id_2_xs_map_;
 
-  const std::vector<UnitCellMatrices>& unit_cell_matrices_;
+  const PackedUnitCellMatrices& unit_cell_matrices_;
 
   const int64_t num_local_dofs_;
   const int64_t num_global_dofs_;
+  /**DOF indices of the cells, including the ghost cells for discontinuous
+   * discretizations, with the unknown components as blocks.*/
+  const chi_math::CellDOFTable dof_table_;
 
   Mat A_ = nullptr;
   Vec rhs_ = nullptr;
   KSP ksp_ = nullptr;
+  /**Inserts the cell contributions of the matrix assembly, keeping the
+   * declared nonzero pattern for re-assemblies.*/
+  std::unique_ptr<chi_math::PETScUtils::ElementAssembler> element_assembler_;
 
   const bool requires_ghosts_;
 
+  /**Material data the preconditioner was last set up with.*/
+  MatID2XSMap pc_mat_id_2_xs_map_;
+  /**Number of solves since the preconditioner was last set up.*/
+  int pc_num_solves_ = 0;
+  bool pc_reused_ = false;
+
 public:
   struct Options
   {
@@ -66,6 +83,30 @@ public:
     std::string ref_solution_lua_function; ///< for mms
     std::string additional_options_string;
     double penalty_factor = 4.0;
+    /**Number of solves, since its setup, for which the preconditioner is
+     * kept when the material data is updated. Zero always rebuilds it.*/
+    int pc_reuse_max_solves = 0;
+    /**Maximum relative change of the material data, since the setup of the
+     * preconditioner, for which it is kept.*/
+    double pc_reuse_tolerance = 0.1;
+    /**Applies the operator without assembling the matrix, when supported by
+     * the solver, with a preconditioner built on a low-order operator.*/
+    bool matrix_free = false;
+    /**Declares the components of the unknowns, e.g. the groups of a
+     * groupset, as the block structure of the matrix, such that BoomerAMG
+     * coarsens and interpolates each component separately while the
+     * components are solved together.*/
+    bool use_component_blocks = false;
+    /**Uses pipelined CG, whose single global reduction per iteration
+     * overlaps the operator application and the preconditioner, hiding its
+     * latency at large location counts.*/
+    bool pipelined = false;
+    /**Backend of the assembled matrix and of the vectors, the device
+     * backends keeping the solve on the GPUs. BoomerAMG is used if hypre
+     * was built for the devices, otherwise GAMG. With `matrix_free` only the
+     * low-order preconditioner solve uses the backend.*/
+    chi_math::PETScUtils::DeviceBackend device_backend =
+      chi_math::PETScUtils::DeviceBackend::CPU;
   } options;
 
 public:
@@ -74,7 +115,7 @@ public:
                   const chi_math::UnknownManager& uk_man,
                   std::map<uint64_t, BoundaryCondition> bcs,
                   MatID2XSMap map_mat_id_2_xs,
-                  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+                  const PackedUnitCellMatrices& unit_cell_matrices,
                   bool verbose,
                   bool requires_ghosts);
 
@@ -87,6 +128,11 @@ public:
 
   std::pair<size_t, size_t> GetNumPhiIterativeUnknowns();
 
+  /**Returns the number of bytes held by the matrix, as reported by PETSc,
+   * the right-hand side and the DOF table. The memory of the Krylov solver
+   * and of the preconditioner is not included.*/
+  size_t GetMemoryUsage() const;
+
   virtual ~DiffusionSolver();
 
   void Initialize();
@@ -96,8 +142,16 @@ public:
   virtual void Assemble_b(Vec petsc_q_vector) = 0;
   void AddToRHS(const std::vector<double>& values);
 
+  void UpdateXSs(MatID2XSMap map_mat_id_2_xs);
+
   void Solve(std::vector<double>& solution, bool use_initial_guess=false);
   void Solve(Vec petsc_solution, bool use_initial_guess=false);
+
+  void ApplyPreconditioner(Vec b, Vec x);
+  virtual void PreparePreconditioner();
+
+protected:
+  virtual void InitializeMatrixFree();
 };
 
 } // namespace lbs::acceleration
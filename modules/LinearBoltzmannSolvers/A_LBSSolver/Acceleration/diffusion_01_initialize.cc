@@ -12,7 +12,8 @@
 /**Initializes the diffusion solver. This involves creating the
  * sparse matrix with the appropriate sparsity pattern. Creating the
  * RHS vector. Creating the KSP solver. Setting the very specialized parameters
- * for Hypre's BooomerAMG. Note: `PCSetFromOptions` and
+ * for Hypre's BooomerAMG, or GAMG if hypre cannot run on the device backend
+ * of `options.device_backend`. Note: `PCSetFromOptions` and
  * `KSPSetFromOptions` are called at the end. Therefore, any number of
  * additional PETSc options can be passed via the commandline.*/
 void lbs::acceleration::DiffusionSolver::Initialize()
@@ -24,34 +25,61 @@ void lbs::acceleration::DiffusionSolver::Initialize()
     Chi::log.Log() << text_name_
                    << ": Global number of DOFs=" << num_global_dofs_;
 
-  Chi::mpi.Barrier();
-  Chi::log.Log() << "Sparsity pattern";
-  Chi::mpi.Barrier();
-  //============================================= Create Matrix
-  std::vector<int64_t> nodal_nnz_in_diag;
-  std::vector<int64_t> nodal_nnz_off_diag;
-  sdm_.BuildSparsityPattern(nodal_nnz_in_diag, nodal_nnz_off_diag, uk_man_);
-  Chi::mpi.Barrier();
-  Chi::log.Log() << "Done Sparsity pattern";
-  Chi::mpi.Barrier();
-  A_ =
-    chi_math::PETScUtils::CreateSquareMatrix(num_local_dofs_, num_global_dofs_);
-  chi_math::PETScUtils::InitMatrixSparsity(
-    A_, nodal_nnz_in_diag, nodal_nnz_off_diag);
-  Chi::mpi.Barrier();
-  Chi::log.Log() << "Done matrix creation";
-  Chi::mpi.Barrier();
+  if (not options.matrix_free)
+  {
+    Chi::mpi.Barrier();
+    Chi::log.Log() << "Sparsity pattern";
+    Chi::mpi.Barrier();
+    //============================================= Create Matrix
+    std::vector<int64_t> nodal_nnz_in_diag;
+    std::vector<int64_t> nodal_nnz_off_diag;
+    sdm_.BuildSparsityPattern(nodal_nnz_in_diag, nodal_nnz_off_diag, uk_man_);
+    Chi::mpi.Barrier();
+    Chi::log.Log() << "Done Sparsity pattern";
+    Chi::mpi.Barrier();
+    const auto block_size =
+      static_cast<PetscInt>(uk_man_.GetTotalUnknownStructureSize());
+    const bool use_blocks =
+      options.use_component_blocks and block_size > 1 and
+      uk_man_.dof_storage_type_ == chi_math::UnknownStorageType::NODAL;
+
+    if (not use_blocks)
+      A_ = chi_math::PETScUtils::CreateSquareMatrix(num_local_dofs_,
+                                                    num_global_dofs_,
+                                                    options.device_backend);
+    else
+    {
+      // The block size must be set before the layout is set up
+      MatCreate(PETSC_COMM_WORLD, &A_);
+      MatSetType(A_,
+                 chi_math::PETScUtils::DeviceMatrixType(
+                   options.device_backend));
+      MatSetSizes(A_, num_local_dofs_, num_local_dofs_,
+                  num_global_dofs_, num_global_dofs_);
+      MatSetBlockSize(A_, block_size);
+    }
+    chi_math::PETScUtils::InitMatrixSparsity(
+      A_, nodal_nnz_in_diag, nodal_nnz_off_diag);
+    Chi::mpi.Barrier();
+    Chi::log.Log() << "Done matrix creation";
+    Chi::mpi.Barrier();
+  }
 
   //============================================= Create RHS
+  // The matrix-free operator is applied on the host
+  const auto vector_backend = options.matrix_free
+                                ? chi_math::PETScUtils::DeviceBackend::CPU
+                                : options.device_backend;
   if (not requires_ghosts_)
-    rhs_ =
-      chi_math::PETScUtils::CreateVector(num_local_dofs_, num_global_dofs_);
+    rhs_ = chi_math::PETScUtils::CreateVector(
+      num_local_dofs_, num_global_dofs_, vector_backend);
   else
     rhs_ = chi_math::PETScUtils::CreateVectorWithGhosts(
       num_local_dofs_,
       num_global_dofs_,
       static_cast<int64_t>(sdm_.GetNumGhostDOFs(uk_man_)),
-      sdm_.GetGhostDOFIndices(uk_man_));
+      sdm_.GetGhostDOFIndices(uk_man_),
+      vector_backend);
 
   Chi::mpi.Barrier();
   Chi::log.Log() << "Done vector creation";
@@ -60,24 +88,50 @@ void lbs::acceleration::DiffusionSolver::Initialize()
   //============================================= Create KSP
   KSPCreate(PETSC_COMM_WORLD, &ksp_);
   KSPSetOptionsPrefix(ksp_, text_name_.c_str());
-  KSPSetType(ksp_, KSPCG);
+  KSPSetType(ksp_, options.pipelined ? KSPPIPECG : KSPCG);
 
   KSPSetTolerances(
     ksp_, 1.e-50, options.residual_tolerance, 1.0e50, options.max_iters);
 
+  //============================================= Matrix-free operator and
+  //                                              preconditioner
+  if (options.matrix_free)
+  {
+    InitializeMatrixFree();
+
+    PetscOptionsInsertString(nullptr,
+                             options.additional_options_string.c_str());
+    KSPSetFromOptions(ksp_);
+    return;
+  }
+
   //============================================= Set Pre-conditioner
   PC pc;
   KSPGetPC(ksp_, &pc);
-  //  PCSetType(pc, PCGAMG);
+  if (not chi_math::PETScUtils::HypreSupportsBackend(options.device_backend))
+  {
+    PCSetType(pc, PCGAMG);
+
+    PetscOptionsInsertString(nullptr,
+                             options.additional_options_string.c_str());
+    PCSetFromOptions(pc);
+    KSPSetFromOptions(ksp_);
+    return;
+  }
+
   PCSetType(pc, PCHYPRE);
 
+  // Hybrid symmetric Gauss-Seidel is a host only smoother
+  const bool on_device =
+    options.device_backend != chi_math::PETScUtils::DeviceBackend::CPU;
   PCHYPRESetType(pc, "boomeramg");
   std::vector<std::string> pc_options = {
     "pc_hypre_boomeramg_agg_nl 1",
     "pc_hypre_boomeramg_P_max 4",
     "pc_hypre_boomeramg_grid_sweeps_coarse 1",
     "pc_hypre_boomeramg_max_levels 25",
-    "pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi",
+    on_device ? "pc_hypre_boomeramg_relax_type_all l1scaled-Jacobi"
+              : "pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi",
     "pc_hypre_boomeramg_coarsen_type HMIS",
     "pc_hypre_boomeramg_interp_type ext+i"};
 
@@ -93,4 +147,13 @@ void lbs::acceleration::DiffusionSolver::Initialize()
 
   PCSetFromOptions(pc);
   KSPSetFromOptions(ksp_);
-}
\ No newline at end of file
+}
+
+// ###################################################################
+/**Creates the matrix-free operator and its preconditioner. Solvers that
+ * support `options.matrix_free` override this.*/
+void lbs::acceleration::DiffusionSolver::InitializeMatrixFree()
+{
+  ChiLogicalError(text_name_ + ": Matrix-free operation is not supported "
+                               "by this diffusion solver.");
+}
@@ -7,6 +7,35 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "utils/chi_profiler.h"
+#include "utils/chi_telemetry.h"
+#include "utils/chi_timer.h"
+
+namespace
+{
+/**Emits the telemetry of a completed KSP solve, the duration in seconds.*/
+void EmitSolveTelemetry(const std::string& solver_name,
+                        KSP ksp,
+                        double duration)
+{
+  PetscInt num_iterations = 0;
+  double residual_norm = 0.0;
+  KSPConvergedReason reason;
+  KSPGetIterationNumber(ksp, &num_iterations);
+  KSPGetResidualNorm(ksp, &residual_norm);
+  KSPGetConvergedReason(ksp, &reason);
+
+  chi::Telemetry::GetInstance().Emit(
+    "dsa_solve",
+    chi::Telemetry::Record()
+      .Add("solver", solver_name)
+      .Add("iterations", num_iterations)
+      .Add("residual", residual_norm)
+      .Add("converged", reason > 0)
+      .Add("reason", chi_physics::GetPETScConvergedReasonstring(reason))
+      .Add("duration", duration));
+}
+} // namespace
 
 // ###################################################################
 /**Solves the system and stores the local solution in the vector provide.
@@ -17,6 +46,7 @@
 void lbs::acceleration::DiffusionSolver::Solve(
   std::vector<double>& solution, bool use_initial_guess /*=false*/)
 {
+  ChiProfileRegion("Diffusion solve");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::Solve";
   Vec x;
   VecDuplicate(rhs_, &x);
@@ -32,7 +62,7 @@ void lbs::acceleration::DiffusionSolver::Solve(
                    1.0e50,
                    options.max_iters);
 
-  if (options.perform_symmetry_check)
+  if (options.perform_symmetry_check and not options.matrix_free)
   {
     PetscBool symmetry = PETSC_FALSE;
     MatIsSymmetric(A_, 1.0e-6, &symmetry);
@@ -64,7 +94,13 @@ void lbs::acceleration::DiffusionSolver::Solve(
   }
 
   //============================================= Solve
+  PreparePreconditioner();
+  const bool emit_telemetry = chi::Telemetry::GetInstance().Enabled();
+  const double solve_start = emit_telemetry ? Chi::program_timer.GetTime() : 0;
   KSPSolve(ksp_, rhs_, x);
+  if (emit_telemetry)
+    EmitSolveTelemetry(
+      TextName(), ksp_, (Chi::program_timer.GetTime() - solve_start) / 1000.0);
 
   //============================================= Print convergence info
   if (options.verbose)
@@ -104,6 +140,7 @@ void lbs::acceleration::DiffusionSolver::Solve(
 void lbs::acceleration::DiffusionSolver::Solve(
   Vec petsc_solution, bool use_initial_guess /*=false*/)
 {
+  ChiProfileRegion("Diffusion solve");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::Solve";
   Vec x;
   VecDuplicate(rhs_, &x);
@@ -119,7 +156,7 @@ void lbs::acceleration::DiffusionSolver::Solve(
                    1.0e50,
                    options.max_iters);
 
-  if (options.perform_symmetry_check)
+  if (options.perform_symmetry_check and not options.matrix_free)
   {
     PetscBool symmetry = PETSC_FALSE;
     MatIsSymmetric(A_, 1.0e-6, &symmetry);
@@ -143,7 +180,13 @@ void lbs::acceleration::DiffusionSolver::Solve(
   if (use_initial_guess) { VecCopy(petsc_solution, x); }
 
   //============================================= Solve
+  PreparePreconditioner();
+  const bool emit_telemetry = chi::Telemetry::GetInstance().Enabled();
+  const double solve_start = emit_telemetry ? Chi::program_timer.GetTime() : 0;
   KSPSolve(ksp_, rhs_, x);
+  if (emit_telemetry)
+    EmitSolveTelemetry(
+      TextName(), ksp_, (Chi::program_timer.GetTime() - solve_start) / 1000.0);
 
   //============================================= Print convergence info
   if (options.verbose)
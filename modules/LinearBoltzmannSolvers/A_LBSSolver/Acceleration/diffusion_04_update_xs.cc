@@ -0,0 +1,118 @@
+#include "diffusion.h"
+
+#include "acceleration.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <cmath>
+
+namespace lbs::acceleration
+{
+
+namespace
+{
+/**Returns the largest relative difference between two sets of values.*/
+double MaxRelativeChange(const std::vector<double>& ref_values,
+                         const std::vector<double>& values)
+{
+  if (ref_values.size() != values.size()) return INFINITY;
+
+  double max_change = 0.0;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    const double scale = std::max(std::fabs(ref_values[i]), 1.0e-12);
+    max_change =
+      std::max(max_change, std::fabs(values[i] - ref_values[i]) / scale);
+  }
+  return max_change;
+}
+} // namespace
+
+// ###################################################################
+/**Replaces the material data and re-assembles the matrix, keeping the
+ * allocated matrix, vectors and KSP.
+ *
+ * When preconditioner reuse is enabled, and the material data has not
+ * changed by more than `options.pc_reuse_tolerance` since the preconditioner
+ * was set up, the preconditioner is kept such that only the operator values
+ * used by the Krylov solver are refreshed. Otherwise, the preconditioner is
+ * set up again on the next solve.*/
+void DiffusionSolver::UpdateXSs(MatID2XSMap map_mat_id_2_xs)
+{
+  ChiInvalidArgumentIf(A_ == nullptr or rhs_ == nullptr or ksp_ == nullptr,
+                       text_name_ + ": Initialize must be called before "
+                                    "updating the material data.");
+
+  //============================================= Determine the change since
+  //                                              the preconditioner setup
+  double max_change = 0.0;
+  for (const auto& [mat_id, xs] : map_mat_id_2_xs)
+  {
+    const auto it = pc_mat_id_2_xs_map_.find(mat_id);
+    if (it == pc_mat_id_2_xs_map_.end())
+    {
+      max_change = INFINITY;
+      break;
+    }
+    max_change = std::max(max_change, MaxRelativeChange(it->second.Dg, xs.Dg));
+    max_change =
+      std::max(max_change, MaxRelativeChange(it->second.sigR, xs.sigR));
+  }
+
+  mat_id_2_xs_map_ = std::move(map_mat_id_2_xs);
+
+  //============================================= Re-assemble
+  if (not options.matrix_free) MatZeroEntries(A_);
+  std::vector<double> dummy_rhs(sdm_.GetNumLocalAndGhostDOFs(uk_man_), 0.0);
+  AssembleAand_b(dummy_rhs);
+
+  //============================================= Apply the reuse policy
+  const bool reuse = options.pc_reuse_max_solves > 0 and
+                     pc_num_solves_ < options.pc_reuse_max_solves and
+                     max_change <= options.pc_reuse_tolerance;
+
+  KSPSetReusePreconditioner(ksp_, reuse ? PETSC_TRUE : PETSC_FALSE);
+  pc_reused_ = reuse;
+  if (not reuse)
+  {
+    pc_mat_id_2_xs_map_ = mat_id_2_xs_map_;
+    pc_num_solves_ = 0;
+  }
+
+  if (options.verbose)
+    Chi::log.Log() << text_name_ << ": Material data updated. Max relative "
+                   << "change " << max_change << ", preconditioner "
+                   << (reuse ? "reused" : "rebuilt") << ".";
+}
+
+// ###################################################################
+/**Applies the preconditioner of the solver once, `x = M^{-1} b`, setting it
+ * up for the current operator when required.*/
+void DiffusionSolver::ApplyPreconditioner(Vec b, Vec x)
+{
+  KSPSetUp(ksp_);
+  PC pc;
+  KSPGetPC(ksp_, &pc);
+  PCApply(pc, b, x);
+}
+
+// ###################################################################
+/**Counts the solves with the current preconditioner and, once a reused
+ * preconditioner has served `options.pc_reuse_max_solves` solves, has it
+ * set up again for the current operator.*/
+void DiffusionSolver::PreparePreconditioner()
+{
+  if (pc_reused_ and pc_num_solves_ >= options.pc_reuse_max_solves)
+  {
+    KSPSetReusePreconditioner(ksp_, PETSC_FALSE);
+    pc_reused_ = false;
+    pc_mat_id_2_xs_map_ = mat_id_2_xs_map_;
+    pc_num_solves_ = 0;
+  }
+  ++pc_num_solves_;
+}
+
+} // namespace lbs::acceleration
@@ -2,12 +2,14 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 #include "math/SpatialDiscretization/spatial_discretization.h"
+#include "math/PETScUtils/petsc_element_assembler.h"
 
-#include "A_LBSSolver/lbs_structs.h"
+#include "A_LBSSolver/lbs_packed_unit_cell_matrices.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
 
 #define DefaultBCDirichlet                                                     \
   BoundaryCondition                                                            \
@@ -22,6 +24,7 @@ namespace lbs::acceleration
  * the routines used in the production versions.*/
 void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const size_t num_local_dofs = sdm_.GetNumLocalAndGhostDOFs(uk_man_);
   ChiInvalidArgumentIf(q_vector.size() != num_local_dofs,
                        std::string("q_vector size mismatch. ") +
@@ -39,9 +42,13 @@ void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
 
   const size_t num_groups = uk_man_.unknowns_.front().num_components_;
 
-  VecSet(rhs_, 0.0);
-  for (const auto& cell : grid_.local_cells)
+  //============================================= Cell contributions
+  // Computed in parallel and inserted at once, see ElementAssembler
+  auto CellContributions =
+    [&](size_t local_id,
+        chi_math::PETScUtils::ElementContributions& contributions)
   {
+    const auto& cell = grid_.local_cells[local_id];
     const size_t num_faces = cell.faces_.size();
     const auto& cell_mapping = sdm_.GetCellMapping(cell);
     const size_t num_nodes = cell_mapping.NumNodes();
@@ -82,33 +89,33 @@ void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
 
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j = 0; j < num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       for (size_t i = 0; i < num_nodes; i++)
       {
         if (node_is_dirichlet[i].first) continue;
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0;
         for (size_t j = 0; j < num_nodes; j++)
         {
-          const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+          const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
           const double entry_aij =
             Dg * cell_K_matrix[i][j] + sigr_g * cell_M_matrix[i][j];
 
           if (not node_is_dirichlet[j].first)
-            MatSetValue(A_, imap, jmap, entry_aij, ADD_VALUES);
+            contributions.AddMatrixEntry(imap, jmap, entry_aij);
           else
           {
             const double bcvalue = node_is_dirichlet[j].second;
-            VecSetValue(rhs_, imap, -entry_aij * bcvalue, ADD_VALUES);
+            contributions.AddVectorEntry(imap, -entry_aij * bcvalue);
           }
 
           entry_rhs_i += qg[j] * cell_M_matrix[i][j];
         } // for j
 
-        VecSetValue(rhs_, imap, entry_rhs_i, ADD_VALUES);
+        contributions.AddVectorEntry(imap, entry_rhs_i);
       } // for i
 
       //==================================== Assemble face terms
@@ -133,12 +140,12 @@ void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
             for (size_t fi = 0; fi < num_face_nodes; ++fi)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               // MatSetValue(A_, imap, imap, cell_Vi[i], ADD_VALUES);
               // VecSetValue(rhs_, imap, bc_value * cell_Vi[i], ADD_VALUES);
-              MatSetValue(A_, imap, imap, 1.0, ADD_VALUES);
-              VecSetValue(rhs_, imap, bc_value, ADD_VALUES);
+              contributions.AddMatrixEntry(imap, imap, 1.0);
+              contributions.AddVectorEntry(imap, bc_value);
             } // for fi
 
           } // Dirichlet BC
@@ -153,18 +160,18 @@ void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
             for (size_t fi = 0; fi < num_face_nodes; fi++)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(aval) >= 1.0e-12)
               {
                 for (size_t fj = 0; fj < num_face_nodes; fj++)
                 {
                   const int j = cell_mapping.MapFaceNode(f, fj);
-                  const int64_t jr = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+                  const int64_t jr = dof_table_.MapDOF(cell, j, g);
 
                   const double aij = (aval / bval) * face_M[i][j];
 
-                  MatSetValue(A_, ir, jr, aij, ADD_VALUES);
+                  contributions.AddMatrixEntry(ir, jr, aij);
                 } // for fj
               }   // if a nonzero
 
@@ -172,19 +179,21 @@ void DiffusionPWLCSolver::AssembleAand_b(const std::vector<double>& q_vector)
               {
                 const double rhs_val = (fval / bval) * face_Si[i];
 
-                VecSetValue(rhs_, ir, rhs_val, ADD_VALUES);
+                contributions.AddVectorEntry(ir, rhs_val);
               } // if f nonzero
             }   // for fi
           }     // Robin BC
         }       // boundary face
       }         // for face
     }           // for g
-  }             // for cell
+  };//CellContributions
 
-  MatAssemblyBegin(A_, MAT_FINAL_ASSEMBLY);
-  MatAssemblyEnd(A_, MAT_FINAL_ASSEMBLY);
-  VecAssemblyBegin(rhs_);
-  VecAssemblyEnd(rhs_);
+  VecSet(rhs_, 0.0);
+  if (element_assembler_ == nullptr)
+    element_assembler_ =
+      std::make_unique<chi_math::PETScUtils::ElementAssembler>(
+        grid_.local_cells.size());
+  element_assembler_->Assemble(A_, rhs_, CellContributions);
 
   if (options.verbose)
   {
@@ -8,11 +8,12 @@
 
 #include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
 
-#include "LinearBoltzmannSolvers/A_LBSSolver/lbs_structs.h"
+#include "LinearBoltzmannSolvers/A_LBSSolver/lbs_packed_unit_cell_matrices.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
 #include "console/chi_console.h"
 
 #define DefaultBCDirichlet                                                     \
@@ -27,6 +28,7 @@
 void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
   const std::vector<double>& q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const size_t num_local_dofs = sdm_.GetNumLocalAndGhostDOFs(uk_man_);
   ChiInvalidArgumentIf(q_vector.size() != num_local_dofs,
                        std::string("q_vector size mismatch. ") +
@@ -83,7 +85,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
       //==================================== Get coefficient and nodal src
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j = 0; j < num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       const double Dg = xs.Dg[g];
@@ -92,7 +94,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
       for (size_t i = 0; i < num_nodes; i++)
       {
         if (node_is_dirichlet[i].first) continue;
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0;
         for (size_t j = 0; j < num_nodes; j++)
         {
@@ -133,7 +135,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
             for (size_t fi = 0; fi < num_face_nodes; ++fi)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               // VecSetValue(rhs_, imap, bc_value * cell_Vi[i], ADD_VALUES);
               VecSetValue(rhs_, imap, bc_value, ADD_VALUES);
@@ -150,7 +152,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
             for (size_t fi = 0; fi < num_face_nodes; fi++)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(fval) >= 1.0e-12)
               {
@@ -178,6 +180,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(
  * the routines used in the production versions.*/
 void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(Vec petsc_q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::"
                             "Assemble_b";
   if (A_ == nullptr or rhs_ == nullptr or ksp_ == nullptr)
@@ -227,13 +230,13 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(Vec petsc_q_vector)
       //==================================== Get coefficient and nodal src
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j = 0; j < num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       for (size_t i = 0; i < num_nodes; i++)
       {
         if (node_is_dirichlet[i]) continue;
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0;
         for (size_t j = 0; j < num_nodes; j++)
           entry_rhs_i += qg[j] * cell_M_matrix[i][j];
@@ -263,7 +266,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(Vec petsc_q_vector)
             for (size_t fi = 0; fi < num_face_nodes; ++fi)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               VecSetValue(rhs_, imap, bc_value * cell_Vi[i], ADD_VALUES);
             } // for fi
@@ -279,7 +282,7 @@ void lbs::acceleration::DiffusionPWLCSolver::Assemble_b(Vec petsc_q_vector)
             for (size_t fi = 0; fi < num_face_nodes; fi++)
             {
               const int i = cell_mapping.MapFaceNode(f, fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(fval) >= 1.0e-12)
               {
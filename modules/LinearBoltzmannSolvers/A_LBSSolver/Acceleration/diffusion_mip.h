@@ -15,11 +15,12 @@ namespace chi_mesh
 namespace chi_math
 {
   class SpatialDiscretization;
+  class VectorGhostCommunicator;
 }
 
 namespace lbs
 {
-  struct UnitCellMatrices;
+  class PackedUnitCellMatrices;
 }
 
 //############################################### Namespace lbs::acceleration
@@ -30,6 +31,30 @@ namespace lbs::acceleration
  * of Bruno Turcksin and Jean Ragusa.*/
 class DiffusionMIPSolver : public lbs::acceleration::DiffusionSolver
 {
+private:
+  /**Face data of a local cell, precomputed for the matrix-free operator.*/
+  struct MatrixFreeFaceInfo
+  {
+    double hm = 0.0;          ///< H-perpendicular of the cell
+    double hp = 0.0;          ///< H-perpendicular of the neighbor
+    size_t acf = 0;           ///< Face index on the neighbor
+    /**Neighbor node of each face node of the cell.*/
+    std::vector<int> adj_face_nodes;
+    /**Cell node of each face node of the neighbor.*/
+    std::vector<int> cur_face_nodes;
+  };
+
+  std::vector<std::vector<MatrixFreeFaceInfo>> mf_face_info_;
+  std::shared_ptr<chi_math::VectorGhostCommunicator> mf_ghost_comm_;
+  std::map<int64_t, int64_t> mf_ghost_global_id_2_local_map_;
+  mutable std::vector<double> mf_x_with_ghosts_;
+  std::vector<double> mf_inv_diagonal_;
+
+  std::shared_ptr<chi_math::SpatialDiscretization> lo_sdm_;
+  std::shared_ptr<DiffusionSolver> lo_solver_;
+  Vec lo_r_ = nullptr;
+  Vec lo_x_ = nullptr;
+
 public:
   //00
   DiffusionMIPSolver(std::string text_name,
@@ -37,7 +62,7 @@ public:
                      const chi_math::UnknownManager& uk_man,
                      std::map<uint64_t, BoundaryCondition> bcs,
                      MatID2XSMap map_mat_id_2_xs,
-                     const std::vector<UnitCellMatrices>& unit_cell_matrices,
+                     const PackedUnitCellMatrices& unit_cell_matrices,
                      bool verbose);
 
   //02a
@@ -65,7 +90,26 @@ public:
   double CallLuaXYZFunction(lua_State* L, const std::string& lua_func_name,
                             const chi_mesh::Vector3& xyz);
 
-  virtual ~DiffusionMIPSolver() = default;
+  //06
+  void PreparePreconditioner() override;
+
+protected:
+  void InitializeMatrixFree() override;
+
+private:
+  template<typename Accumulator>
+  void EvaluateMatrixFreeOperator(const Accumulator& accumulate) const;
+  int64_t MatrixFreeDOF(const chi_mesh::Cell& cell,
+                        unsigned int node,
+                        unsigned int g) const;
+  void ComputeMatrixFreeDiagonal();
+  void AssembleMatrixFree(const std::vector<double>& q_vector);
+
+  static PetscErrorCode MatrixFreeMult(Mat A, Vec x, Vec y);
+  static PetscErrorCode LowOrderPCApply(PC pc, Vec r, Vec z);
+
+public:
+  ~DiffusionMIPSolver() override;
 };
 
 }//namespace lbs::acceleration
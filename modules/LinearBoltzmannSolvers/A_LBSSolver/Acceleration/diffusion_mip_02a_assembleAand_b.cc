@@ -11,6 +11,7 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
 #include "console/chi_console.h"
 
 #define DefaultBCDirichlet BoundaryCondition{BCType::DIRICHLET,{0,0,0}}
@@ -21,6 +22,7 @@
 void lbs::acceleration::DiffusionMIPSolver::
   AssembleAand_b_wQpoints(const std::vector<double>& q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::"
                             "AssembleAand_b_wQpoints";
   if (A_ == nullptr or rhs_ == nullptr or ksp_ == nullptr)
@@ -56,16 +58,16 @@ void lbs::acceleration::DiffusionMIPSolver::
 
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j=0; j<num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       for (size_t i=0; i<num_nodes; i++)
       {
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0; //entry may accumulate over j
         for (size_t j=0; j<num_nodes; j++)
         {
-          const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+          const int64_t jmap = dof_table_.MapDOF(cell, j, g);
           double entry_aij = 0.0;
           for (size_t qp : qp_data.QuadraturePointIndices())
           {
@@ -112,7 +114,7 @@ void lbs::acceleration::DiffusionMIPSolver::
 
         if (face.has_neighbor_)
         {
-          const auto&  adj_cell         = grid_.cells[face.neighbor_id_];
+          const auto&  adj_cell         = grid_.FaceNeighbor(cell, f);
           const auto&  adj_cell_mapping = sdm_.GetCellMapping(adj_cell);
           const auto   ac_nodes         = adj_cell_mapping.GetNodeLocations();
           const size_t acf              = Grid::MapCellFace(cell, adj_cell, f);
@@ -134,15 +136,15 @@ void lbs::acceleration::DiffusionMIPSolver::
           for (size_t fi=0; fi<num_face_nodes; ++fi)
           {
             const int i  = cell_mapping.MapFaceNode(f,fi);
-            const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+            const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
             for (size_t fj=0; fj<num_face_nodes; ++fj)
             {
               const int jm = cell_mapping.MapFaceNode(f,fj);      //j-minus
               const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                              f, acf, fj);         //j-plus
-              const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
-              const int64_t jpmap = sdm_.MapDOF(adj_cell, jp, uk_man_, 0, g);
+              const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
+              const int64_t jpmap = dof_table_.MapDOF(adj_cell, jp, g);
 
               double aij = 0.0;
               for (size_t qp : fqp_data.QuadraturePointIndices())
@@ -162,15 +164,15 @@ void lbs::acceleration::DiffusionMIPSolver::
           // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
           for (int i=0; i<num_nodes; i++)
           {
-            const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+            const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
             for (int fj=0; fj<num_face_nodes; fj++)
             {
               const int jm = cell_mapping.MapFaceNode(f,fj);      //j-minus
               const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                              f, acf, fj);         //j-plus
-              const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
-              const int64_t jpmap = sdm_.MapDOF(adj_cell, jp, uk_man_, 0, g);
+              const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
+              const int64_t jpmap = dof_table_.MapDOF(adj_cell, jp, g);
 
               chi_mesh::Vector3 vec_aij;
               for (size_t qp : fqp_data.QuadraturePointIndices())
@@ -190,12 +192,12 @@ void lbs::acceleration::DiffusionMIPSolver::
             const int im = cell_mapping.MapFaceNode(f,fi);       //i-minus
             const int ip = MapFaceNodeDisc(cell,adj_cell,cc_nodes,ac_nodes,
                                            f,acf,fi);            //i-plus
-            const int64_t immap = sdm_.MapDOF(cell, im, uk_man_, 0, g);
-            const int64_t ipmap = sdm_.MapDOF(adj_cell, ip, uk_man_, 0, g);
+            const int64_t immap = dof_table_.MapDOF(cell, im, g);
+            const int64_t ipmap = dof_table_.MapDOF(adj_cell, ip, g);
 
             for (int j=0; j<num_nodes; j++)
             {
-              const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+              const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
               chi_mesh::Vector3 vec_aij;
               for (size_t qp : fqp_data.QuadraturePointIndices())
@@ -233,12 +235,12 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; ++fi)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t fj=0; fj<num_face_nodes; ++fj)
               {
                 const int jm = cell_mapping.MapFaceNode(f,fj);
-                const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
+                const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
 
                 double aij = 0.0;
                 for (size_t qp : fqp_data.QuadraturePointIndices())
@@ -270,11 +272,11 @@ void lbs::acceleration::DiffusionMIPSolver::
             // D* n dot (b_j^+ - b_j^-)*nabla b_i^-
             for (size_t i=0; i<num_nodes; i++)
             {
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t j=0; j<num_nodes; j++)
               {
-                const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+                const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
                 chi_mesh::Vector3 vec_aij;
                 for (size_t qp : fqp_data.QuadraturePointIndices())
@@ -317,14 +319,14 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; fi++)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(aval) >= 1.0e-12)
               {
                 for (size_t fj=0; fj<num_face_nodes; fj++)
                 {
                   const int j  = cell_mapping.MapFaceNode(f,fj);
-                  const int64_t jr = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+                  const int64_t jr = dof_table_.MapDOF(cell, j, g);
 
                   double aij = 0.0;
                   for (size_t qp : fqp_data.QuadraturePointIndices())
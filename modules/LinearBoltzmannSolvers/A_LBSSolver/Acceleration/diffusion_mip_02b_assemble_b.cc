@@ -11,6 +11,7 @@
 #include "chi_runtime.h" //TODO:Remove
 #include "chi_log.h"     //TODO:Remove
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
 #include "console/chi_console.h"
 
 #define DefaultBCDirichlet BoundaryCondition{BCType::DIRICHLET,{0,0,0}}
@@ -21,6 +22,7 @@
 void lbs::acceleration::DiffusionMIPSolver::
   Assemble_b_wQpoints(const std::vector<double>& q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::"
                             "AssembleAand_b_wQpoints";
   if (A_ == nullptr or rhs_ == nullptr or ksp_ == nullptr)
@@ -53,12 +55,12 @@ void lbs::acceleration::DiffusionMIPSolver::
 
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j=0; j<num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       for (size_t i=0; i<num_nodes; i++)
       {
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0; //entry may accumulate over j
         if (source_function.empty())
           for (size_t j=0; j<num_nodes; j++)
@@ -116,7 +118,7 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; ++fi)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t fj=0; fj<num_face_nodes; ++fj)
               {
@@ -151,7 +153,7 @@ void lbs::acceleration::DiffusionMIPSolver::
             // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
             for (size_t i=0; i<num_nodes; i++)
             {
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t j=0; j<num_nodes; j++)
               {
@@ -194,7 +196,7 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; fi++)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(fval) >= 1.0e-12)
               {
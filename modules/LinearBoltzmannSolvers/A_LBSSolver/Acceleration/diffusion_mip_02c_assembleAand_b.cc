@@ -5,14 +5,16 @@
 
 #include "math/SpatialDiscretization/spatial_discretization.h"
 #include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+#include "math/PETScUtils/petsc_element_assembler.h"
 
 #include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
 
-#include "A_LBSSolver/lbs_structs.h"
+#include "A_LBSSolver/lbs_packed_unit_cell_matrices.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_profiler.h"
 #include "console/chi_console.h"
 
 #define DefaultBCDirichlet BoundaryCondition{BCType::DIRICHLET,{0,0,0}}
@@ -23,6 +25,7 @@
 void lbs::acceleration::DiffusionMIPSolver::
   AssembleAand_b(const std::vector<double>& q_vector)
 {
+  ChiProfileRegion("Diffusion assemble");
   const std::string fname = "lbs::acceleration::DiffusionMIPSolver::"
                             "AssembleAand_b";
   if (A_ == nullptr or rhs_ == nullptr or ksp_ == nullptr)
@@ -31,11 +34,21 @@ void lbs::acceleration::DiffusionMIPSolver::
   if (options.verbose)
     Chi::log.Log() << Chi::program_timer.GetTimeString() << " Starting assembly";
 
+  if (options.matrix_free)
+  {
+    AssembleMatrixFree(q_vector);
+    return;
+  }
+
   const size_t num_groups   = uk_man_.unknowns_.front().num_components_;
 
-  VecSet(rhs_, 0.0);
-  for (const auto& cell : grid_.local_cells)
+  //============================================= Cell contributions
+  // Computed in parallel and inserted at once, see ElementAssembler
+  auto CellContributions =
+    [&](size_t local_id,
+        chi_math::PETScUtils::ElementContributions& contributions)
   {
+    const auto& cell = grid_.local_cells[local_id];
     const size_t num_faces    = cell.faces_.size();
     const auto&  cell_mapping = sdm_.GetCellMapping(cell);
     const size_t num_nodes    = cell_mapping.NumNodes();
@@ -55,16 +68,16 @@ void lbs::acceleration::DiffusionMIPSolver::
 
       std::vector<double> qg(num_nodes, 0.0);
       for (size_t j=0; j<num_nodes; j++)
-        qg[j] = q_vector[sdm_.MapDOFLocal(cell, j, uk_man_, 0, g)];
+        qg[j] = q_vector[dof_table_.MapDOFLocal(cell, j, g)];
 
       //==================================== Assemble continuous terms
       for (size_t i=0; i<num_nodes; i++)
       {
-        const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+        const int64_t imap = dof_table_.MapDOF(cell, i, g);
         double entry_rhs_i = 0.0;
         for (size_t j=0; j<num_nodes; j++)
         {
-          const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+          const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
           const double entry_aij =
             Dg * cell_K_matrix[i][j] +
@@ -72,10 +85,10 @@ void lbs::acceleration::DiffusionMIPSolver::
 
           entry_rhs_i += qg[j]* cell_M_matrix[i][j];
 
-          MatSetValue(A_, imap, jmap, entry_aij, ADD_VALUES);
+          contributions.AddMatrixEntry(imap, jmap, entry_aij);
         }//for j
 
-        VecSetValue(rhs_, imap, entry_rhs_i, ADD_VALUES);
+        contributions.AddVectorEntry(imap, entry_rhs_i);
       }//for i
 
       //==================================== Assemble face terms
@@ -95,7 +108,7 @@ void lbs::acceleration::DiffusionMIPSolver::
 
         if (face.has_neighbor_)
         {
-          const auto&  adj_cell         = grid_.cells[face.neighbor_id_];
+          const auto&  adj_cell         = grid_.FaceNeighbor(cell, f);
           const auto&  adj_cell_mapping = sdm_.GetCellMapping(adj_cell);
           const auto   ac_nodes         = adj_cell_mapping.GetNodeLocations();
           const size_t acf              = Grid::MapCellFace(cell, adj_cell, f);
@@ -117,20 +130,20 @@ void lbs::acceleration::DiffusionMIPSolver::
           for (size_t fi=0; fi<num_face_nodes; ++fi)
           {
             const int i  = cell_mapping.MapFaceNode(f,fi);
-            const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+            const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
             for (size_t fj=0; fj<num_face_nodes; ++fj)
             {
               const int jm = cell_mapping.MapFaceNode(f,fj);      //j-minus
               const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                              f, acf, fj);         //j-plus
-              const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
-              const int64_t jpmap = sdm_.MapDOF(adj_cell, jp, uk_man_, 0, g);
+              const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
+              const int64_t jpmap = dof_table_.MapDOF(adj_cell, jp, g);
 
               const double aij = kappa * face_M[i][jm];
 
-              MatSetValue(A_, imap, jmmap, aij, ADD_VALUES);
-              MatSetValue(A_, imap, jpmap, -aij, ADD_VALUES);
+              contributions.AddMatrixEntry(imap, jmmap, aij);
+              contributions.AddMatrixEntry(imap, jpmap, -aij);
             }//for fj
           }//for fi
 
@@ -141,20 +154,20 @@ void lbs::acceleration::DiffusionMIPSolver::
           // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
           for (int i=0; i<num_nodes; i++)
           {
-            const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+            const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
             for (int fj=0; fj<num_face_nodes; fj++)
             {
               const int jm = cell_mapping.MapFaceNode(f,fj);      //j-minus
               const int jp = MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes,
                                              f, acf, fj);         //j-plus
-              const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
-              const int64_t jpmap = sdm_.MapDOF(adj_cell, jp, uk_man_, 0, g);
+              const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
+              const int64_t jpmap = dof_table_.MapDOF(adj_cell, jp, g);
 
               const double aij = -0.5*Dg*n_f.Dot(face_G[jm][i]);
 
-              MatSetValue(A_, imap, jmmap, aij, ADD_VALUES);
-              MatSetValue(A_, imap, jpmap, -aij, ADD_VALUES);
+              contributions.AddMatrixEntry(imap, jmmap, aij);
+              contributions.AddMatrixEntry(imap, jpmap, -aij);
             }//for fj
           }//for i
 
@@ -164,17 +177,17 @@ void lbs::acceleration::DiffusionMIPSolver::
             const int im = cell_mapping.MapFaceNode(f,fi);       //i-minus
             const int ip = MapFaceNodeDisc(cell,adj_cell,cc_nodes,ac_nodes,
                                            f,acf,fi);            //i-plus
-            const int64_t immap = sdm_.MapDOF(cell, im, uk_man_, 0, g);
-            const int64_t ipmap = sdm_.MapDOF(adj_cell, ip, uk_man_, 0, g);
+            const int64_t immap = dof_table_.MapDOF(cell, im, g);
+            const int64_t ipmap = dof_table_.MapDOF(adj_cell, ip, g);
 
             for (int j=0; j<num_nodes; j++)
             {
-              const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+              const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
               const double aij = -0.5*Dg*n_f.Dot(face_G[im][j]);
 
-              MatSetValue(A_, immap, jmap, aij, ADD_VALUES);
-              MatSetValue(A_, ipmap, jmap, -aij, ADD_VALUES);
+              contributions.AddMatrixEntry(immap, jmap, aij);
+              contributions.AddMatrixEntry(ipmap, jmap, -aij);
             }//for j
           }//for fi
 
@@ -202,18 +215,18 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; ++fi)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t fj=0; fj<num_face_nodes; ++fj)
               {
                 const int jm = cell_mapping.MapFaceNode(f,fj);
-                const int64_t jmmap = sdm_.MapDOF(cell, jm, uk_man_, 0, g);
+                const int64_t jmmap = dof_table_.MapDOF(cell, jm, g);
 
                 const double aij = kappa*face_M[i][jm];
                 const double aij_bc_value = aij*bc_value;
 
-                MatSetValue(A_  , imap, jmmap, aij, ADD_VALUES);
-                VecSetValue(rhs_, imap, aij_bc_value, ADD_VALUES);
+                contributions.AddMatrixEntry(imap, jmmap, aij);
+                contributions.AddVectorEntry(imap, aij_bc_value);
               }//for fj
             }//for fi
 
@@ -224,18 +237,18 @@ void lbs::acceleration::DiffusionMIPSolver::
             // D* n dot (b_j^+ - b_j^-)*nabla b_i^-
             for (size_t i=0; i<num_nodes; i++)
             {
-              const int64_t imap = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t imap = dof_table_.MapDOF(cell, i, g);
 
               for (size_t j=0; j<num_nodes; j++)
               {
-                const int64_t jmap = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+                const int64_t jmap = dof_table_.MapDOF(cell, j, g);
 
                 const double aij = -Dg*n_f.Dot(face_G[j][i] + face_G[i][j]);
                 const double aij_bc_value = aij*bc_value;
 
 
-                MatSetValue(A_, imap, jmap, aij, ADD_VALUES);
-                VecSetValue(rhs_, imap, aij_bc_value, ADD_VALUES);
+                contributions.AddMatrixEntry(imap, jmap, aij);
+                contributions.AddVectorEntry(imap, aij_bc_value);
               }//for fj
             }//for i
           }//Dirichlet BC
@@ -250,18 +263,18 @@ void lbs::acceleration::DiffusionMIPSolver::
             for (size_t fi=0; fi<num_face_nodes; fi++)
             {
               const int i  = cell_mapping.MapFaceNode(f,fi);
-              const int64_t ir = sdm_.MapDOF(cell, i, uk_man_, 0, g);
+              const int64_t ir = dof_table_.MapDOF(cell, i, g);
 
               if (std::fabs(aval) >= 1.0e-12)
               {
                 for (size_t fj=0; fj<num_face_nodes; fj++)
                 {
                   const int j  = cell_mapping.MapFaceNode(f,fj);
-                  const int64_t jr = sdm_.MapDOF(cell, j, uk_man_, 0, g);
+                  const int64_t jr = dof_table_.MapDOF(cell, j, g);
 
                   const double aij = (aval/bval) * face_M[i][j];
 
-                  MatSetValue(A_, ir , jr, aij, ADD_VALUES);
+                  contributions.AddMatrixEntry(ir , jr, aij);
                 }//for fj
               }//if a nonzero
 
@@ -269,19 +282,21 @@ void lbs::acceleration::DiffusionMIPSolver::
               {
                 const double rhs_val = (fval/bval) * face_Si[i];
 
-                VecSetValue(rhs_, ir, rhs_val, ADD_VALUES);
+                contributions.AddVectorEntry(ir, rhs_val);
               }//if f nonzero
             }//for fi
           }//Robin BC
         }//boundary face
       }//for face
     }//for g
-  }//for cell
+  };//CellContributions
 
-  MatAssemblyBegin(A_, MAT_FINAL_ASSEMBLY);
-  MatAssemblyEnd(A_, MAT_FINAL_ASSEMBLY);
-  VecAssemblyBegin(rhs_);
-  VecAssemblyEnd(rhs_);
+  VecSet(rhs_, 0.0);
+  if (element_assembler_ == nullptr)
+    element_assembler_ =
+      std::make_unique<chi_math::PETScUtils::ElementAssembler>(
+        grid_.local_cells.size());
+  element_assembler_->Assemble(A_, rhs_, CellContributions);
 
   if (options.verbose)
   {
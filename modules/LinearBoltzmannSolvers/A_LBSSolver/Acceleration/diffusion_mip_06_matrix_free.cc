@@ -0,0 +1,508 @@
+#include "diffusion_mip.h"
+#include "diffusion_PWLC.h"
+#include "acceleration.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "math/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwlc.h"
+#include "math/VectorGhostCommunicator/vector_ghost_communicator.h"
+#include "math/PETScUtils/petsc_utils.h"
+
+#include "A_LBSSolver/lbs_packed_unit_cell_matrices.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "utils/chi_timer.h"
+
+#include <algorithm>
+#include <set>
+
+#define DefaultBCDirichlet BoundaryCondition{BCType::DIRICHLET,{0,0,0}}
+
+namespace lbs::acceleration
+{
+
+//###################################################################
+/**Creates the shell matrix applying the MIP operator from the unit cell
+ * matrices, and its preconditioner. The preconditioner is additive,
+ * `M^{-1} = D^{-1} + P A_c^{-1} P^T`, with D the diagonal of the MIP
+ * operator, A_c the continuous PWLC diffusion operator of the same
+ * materials, approximately inverted by its own preconditioner (BoomerAMG),
+ * and P the injection of PWLC nodal values into the PWLD nodes. The memory
+ * of the operator and preconditioner hence scales with the number of cells
+ * and vertices instead of the fill of the face couplings.*/
+void DiffusionMIPSolver::InitializeMatrixFree()
+{
+  const auto& ghost_cell_ids = grid_.cells.GetGhostGlobalIDs();
+
+  for (const uint64_t ghost_id : ghost_cell_ids)
+    ChiLogicalErrorIf(not unit_cell_matrices_.HasGhost(ghost_id),
+                      text_name_ + ": The matrix-free operator requires the "
+                                   "unit cell matrices of the ghost cells.");
+
+  //============================================= Precompute face data
+  mf_face_info_.assign(grid_.local_cells.size(), {});
+  for (const auto& cell : grid_.local_cells)
+  {
+    const auto& cell_mapping = sdm_.GetCellMapping(cell);
+    const auto cc_nodes = cell_mapping.GetNodeLocations();
+    auto& cell_face_info = mf_face_info_[cell.local_id_];
+    cell_face_info.resize(cell.faces_.size());
+
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const auto& face = cell.faces_[f];
+      auto& face_info = cell_face_info[f];
+      face_info.hm = HPerpendicular(cell, f);
+
+      if (not face.has_neighbor_) continue;
+
+      const auto& adj_cell = grid_.FaceNeighbor(cell, f);
+      const auto& adj_cell_mapping = sdm_.GetCellMapping(adj_cell);
+      const auto ac_nodes = adj_cell_mapping.GetNodeLocations();
+      const size_t acf =
+        chi_mesh::MeshContinuum::MapCellFace(cell, adj_cell, f);
+
+      face_info.acf = acf;
+      face_info.hp = HPerpendicular(adj_cell, acf);
+
+      const size_t num_face_nodes = cell_mapping.NumFaceNodes(f);
+      face_info.adj_face_nodes.resize(num_face_nodes);
+      for (size_t fj = 0; fj < num_face_nodes; ++fj)
+        face_info.adj_face_nodes[fj] =
+          MapFaceNodeDisc(cell, adj_cell, cc_nodes, ac_nodes, f, acf, fj);
+
+      const size_t num_adj_face_nodes = adj_cell_mapping.NumFaceNodes(acf);
+      face_info.cur_face_nodes.resize(num_adj_face_nodes);
+      for (size_t fi = 0; fi < num_adj_face_nodes; ++fi)
+        face_info.cur_face_nodes[fi] =
+          MapFaceNodeDisc(adj_cell, cell, ac_nodes, cc_nodes, acf, f, fi);
+    }//for f
+  }//for cell
+
+  //============================================= Ghost communicator
+  // The DOFs of the ghost cells are appended to the local DOFs. Only the
+  // ghost cells across partition-boundary faces couple with the local
+  // cells, hence only their DOFs are exchanged, and not those of the ghost
+  // cells merely sharing vertices with the local cells.
+  std::set<uint64_t> face_ghost_cell_ids;
+  for (const auto& cell : grid_.local_cells)
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+      if (grid_.GetFaceNeighborIndex(cell, f).ghost_index >= 0)
+        face_ghost_cell_ids.insert(cell.faces_[f].neighbor_id_);
+
+  std::set<int64_t> ghost_dof_ids_set;
+  const size_t num_groups = uk_man_.unknowns_.front().num_components_;
+  for (const uint64_t global_id : face_ghost_cell_ids)
+  {
+    const auto& cell = grid_.cells[global_id];
+    const size_t num_nodes = sdm_.GetCellMapping(cell).NumNodes();
+    for (size_t i = 0; i < num_nodes; ++i)
+      for (size_t g = 0; g < num_groups; ++g)
+        ghost_dof_ids_set.insert(dof_table_.MapDOF(cell, i, g));
+  }
+
+  std::vector<int64_t> ghost_dof_ids(ghost_dof_ids_set.begin(),
+                                     ghost_dof_ids_set.end());
+  mf_ghost_global_id_2_local_map_.clear();
+  for (size_t k = 0; k < ghost_dof_ids.size(); ++k)
+    mf_ghost_global_id_2_local_map_[ghost_dof_ids[k]] =
+      num_local_dofs_ + static_cast<int64_t>(k);
+
+  mf_x_with_ghosts_.assign(num_local_dofs_ + ghost_dof_ids.size(), 0.0);
+  mf_ghost_comm_ = std::make_shared<chi_math::VectorGhostCommunicator>(
+    num_local_dofs_, num_global_dofs_, ghost_dof_ids, Chi::mpi.comm);
+
+  //============================================= Shell matrix
+  MatCreateShell(PETSC_COMM_WORLD,
+                 num_local_dofs_, num_local_dofs_,
+                 num_global_dofs_, num_global_dofs_,
+                 this, &A_);
+  MatShellSetOperation(A_, MATOP_MULT, (void (*)(void))MatrixFreeMult);
+
+  //============================================= Low-order solver
+  lo_sdm_ = chi_math::SpatialDiscretization_PWLC::New(grid_);
+  lo_solver_ = std::make_shared<DiffusionPWLCSolver>(text_name_ + "_LO",
+                                                     *lo_sdm_,
+                                                     uk_man_,
+                                                     bcs_,
+                                                     mat_id_2_xs_map_,
+                                                     unit_cell_matrices_,
+                                                     options.verbose);
+  lo_solver_->options.pc_reuse_max_solves = options.pc_reuse_max_solves;
+  lo_solver_->options.pc_reuse_tolerance = options.pc_reuse_tolerance;
+  lo_solver_->options.device_backend = options.device_backend;
+  lo_solver_->Initialize();
+
+  VecDuplicate(lo_solver_->RHS(), &lo_r_);
+  VecDuplicate(lo_solver_->RHS(), &lo_x_);
+
+  //============================================= Shell preconditioner
+  PC pc;
+  KSPGetPC(ksp_, &pc);
+  PCSetType(pc, PCSHELL);
+  PCShellSetContext(pc, this);
+  PCShellSetApply(pc, LowOrderPCApply);
+  PCShellSetName(pc, "MIP diagonal plus PWLC low-order");
+
+  ComputeMatrixFreeDiagonal();
+}
+
+//###################################################################
+/**Maps a node of a local or ghost cell to its index in the local vector
+ * with the ghost DOFs appended.*/
+int64_t DiffusionMIPSolver::MatrixFreeDOF(const chi_mesh::Cell& cell,
+                                          unsigned int node,
+                                          unsigned int g) const
+{
+  if (cell.partition_id_ == Chi::mpi.location_id)
+    return dof_table_.MapDOFLocal(cell, node, g);
+
+  return mf_ghost_global_id_2_local_map_.at(
+    dof_table_.MapDOF(cell, node, g));
+}
+
+//###################################################################
+/**Visits the entries of the local rows of the MIP operator, calling
+ * `accumulate(row, column, value)` with the local row, the column in the
+ * local vector with ghosts and the value. The entries are those assembled
+ * by AssembleAand_b, where the contributions of the neighbors to the rows
+ * of a cell are computed from the unit cell matrices of the neighbors.*/
+template<typename Accumulator>
+void DiffusionMIPSolver::EvaluateMatrixFreeOperator(
+  const Accumulator& accumulate) const
+{
+  const size_t num_groups = uk_man_.unknowns_.front().num_components_;
+
+  for (const auto& cell : grid_.local_cells)
+  {
+    const size_t num_faces    = cell.faces_.size();
+    const auto&  cell_mapping = sdm_.GetCellMapping(cell);
+    const size_t num_nodes    = cell_mapping.NumNodes();
+    const auto&  unit_cell_matrices = unit_cell_matrices_[cell.local_id_];
+    const auto&  cell_face_info = mf_face_info_[cell.local_id_];
+
+    const auto& cell_K_matrix = unit_cell_matrices.K_matrix;
+    const auto& cell_M_matrix = unit_cell_matrices.M_matrix;
+
+    const auto& xs = mat_id_2_xs_map_.at(cell.material_id_);
+
+    for (unsigned int g=0; g<num_groups; ++g)
+    {
+      const double Dg     = xs.Dg[g];
+      const double sigr_g = xs.sigR[g];
+
+      //==================================== Continuous terms
+      for (size_t i=0; i<num_nodes; i++)
+      {
+        const int64_t imap = MatrixFreeDOF(cell, i, g);
+        for (size_t j=0; j<num_nodes; j++)
+          accumulate(imap, MatrixFreeDOF(cell, j, g),
+                     Dg * cell_K_matrix[i][j] + sigr_g * cell_M_matrix[i][j]);
+      }//for i
+
+      //==================================== Face terms
+      for (size_t f=0; f<num_faces; ++f)
+      {
+        const auto&  face           = cell.faces_[f];
+        const auto&  n_f            = face.normal_;
+        const size_t num_face_nodes = cell_mapping.NumFaceNodes(f);
+        const auto&  face_info      = cell_face_info[f];
+
+        const auto& face_M = unit_cell_matrices.face_M_matrices[f];
+        const auto& face_G = unit_cell_matrices.face_G_matrices[f];
+
+        const double hm = face_info.hm;
+
+        if (face.has_neighbor_)
+        {
+          const auto&  adj_cell         = grid_.FaceNeighbor(cell, f);
+          const auto&  adj_cell_mapping = sdm_.GetCellMapping(adj_cell);
+          const size_t adj_num_nodes    = adj_cell_mapping.NumNodes();
+          const size_t acf              = face_info.acf;
+          const double hp               = face_info.hp;
+
+          const auto adj_unit_cell_matrices =
+            (adj_cell.partition_id_ == Chi::mpi.location_id)
+              ? unit_cell_matrices_[adj_cell.local_id_]
+              : unit_cell_matrices_.Ghost(adj_cell.global_id_);
+          const auto& adj_face_G =
+            adj_unit_cell_matrices.face_G_matrices[acf];
+          const auto& adj_n_f = adj_cell.faces_[acf].normal_;
+
+          const auto&  adj_xs   = mat_id_2_xs_map_.at(adj_cell.material_id_);
+          const double adj_Dg   = adj_xs.Dg[g];
+
+          //========================= Compute kappa
+          double kappa = 1.0;
+          if (cell.Type() == chi_mesh::CellType::SLAB)
+            kappa = fmax(options.penalty_factor*(adj_Dg/hp + Dg/hm)*0.5,0.25);
+          if (cell.Type() == chi_mesh::CellType::POLYGON)
+            kappa = fmax(options.penalty_factor*(adj_Dg/hp + Dg/hm)*0.5,0.25);
+          if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
+            kappa = fmax(options.penalty_factor*2.0*(adj_Dg/hp + Dg/hm)*0.5,0.25);
+
+          //========================= Penalty terms
+          for (size_t fi=0; fi<num_face_nodes; ++fi)
+          {
+            const int i  = cell_mapping.MapFaceNode(f,fi);
+            const int64_t imap = MatrixFreeDOF(cell, i, g);
+
+            for (size_t fj=0; fj<num_face_nodes; ++fj)
+            {
+              const int jm = cell_mapping.MapFaceNode(f,fj);
+              const int jp = face_info.adj_face_nodes[fj];
+
+              const double aij = kappa * face_M[i][jm];
+
+              accumulate(imap, MatrixFreeDOF(cell, jm, g), aij);
+              accumulate(imap, MatrixFreeDOF(adj_cell, jp, g), -aij);
+            }//for fj
+          }//for fi
+
+          //========================= Gradient terms
+          // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
+          for (size_t i=0; i<num_nodes; i++)
+          {
+            const int64_t imap = MatrixFreeDOF(cell, i, g);
+
+            for (size_t fj=0; fj<num_face_nodes; fj++)
+            {
+              const int jm = cell_mapping.MapFaceNode(f,fj);
+              const int jp = face_info.adj_face_nodes[fj];
+
+              const double aij = -0.5*Dg*n_f.Dot(face_G[jm][i]);
+
+              accumulate(imap, MatrixFreeDOF(cell, jm, g), aij);
+              accumulate(imap, MatrixFreeDOF(adj_cell, jp, g), -aij);
+            }//for fj
+          }//for i
+
+          // 0.5*D* n dot (b_i^+ - b_i^-)*nabla b_j^-, for the rows of this
+          // cell
+          for (size_t fi=0; fi<num_face_nodes; fi++)
+          {
+            const int im = cell_mapping.MapFaceNode(f,fi);
+            const int64_t immap = MatrixFreeDOF(cell, im, g);
+
+            for (size_t j=0; j<num_nodes; j++)
+              accumulate(immap, MatrixFreeDOF(cell, j, g),
+                         -0.5*Dg*n_f.Dot(face_G[im][j]));
+          }//for fi
+
+          // The same term assembled by the neighbor, for the rows of this
+          // cell
+          const size_t adj_num_face_nodes = face_info.cur_face_nodes.size();
+          for (size_t fi=0; fi<adj_num_face_nodes; fi++)
+          {
+            const int im = adj_cell_mapping.MapFaceNode(acf,fi);
+            const int ip = face_info.cur_face_nodes[fi];
+            const int64_t ipmap = MatrixFreeDOF(cell, ip, g);
+
+            for (size_t j=0; j<adj_num_nodes; j++)
+              accumulate(ipmap, MatrixFreeDOF(adj_cell, j, g),
+                         0.5*adj_Dg*adj_n_f.Dot(adj_face_G[im][j]));
+          }//for fi
+        }//internal face
+        else
+        {
+          auto bc = DefaultBCDirichlet;
+          if (bcs_.count(face.neighbor_id_) > 0)
+            bc = bcs_.at(face.neighbor_id_);
+
+          if (bc.type == BCType::DIRICHLET)
+          {
+            //========================= Compute kappa
+            double kappa = 1.0;
+            if (cell.Type() == chi_mesh::CellType::SLAB)
+              kappa = fmax(options.penalty_factor*Dg/hm,0.25);
+            if (cell.Type() == chi_mesh::CellType::POLYGON)
+              kappa = fmax(options.penalty_factor*Dg/hm,0.25);
+            if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
+              kappa = fmax(options.penalty_factor*2.0*Dg/hm,0.25);
+
+            //========================= Penalty terms
+            for (size_t fi=0; fi<num_face_nodes; ++fi)
+            {
+              const int i  = cell_mapping.MapFaceNode(f,fi);
+              const int64_t imap = MatrixFreeDOF(cell, i, g);
+
+              for (size_t fj=0; fj<num_face_nodes; ++fj)
+              {
+                const int jm = cell_mapping.MapFaceNode(f,fj);
+                accumulate(imap, MatrixFreeDOF(cell, jm, g),
+                           kappa*face_M[i][jm]);
+              }//for fj
+            }//for fi
+
+            //========================= Gradient terms
+            for (size_t i=0; i<num_nodes; i++)
+            {
+              const int64_t imap = MatrixFreeDOF(cell, i, g);
+
+              for (size_t j=0; j<num_nodes; j++)
+                accumulate(imap, MatrixFreeDOF(cell, j, g),
+                           -Dg*n_f.Dot(face_G[j][i] + face_G[i][j]));
+            }//for i
+          }//Dirichlet BC
+          else if (bc.type == BCType::ROBIN)
+          {
+            const double aval = bc.values[0];
+            const double bval = bc.values[1];
+
+            if (std::fabs(bval) < 1.0e-12) continue; //a and f assumed zero
+            if (std::fabs(aval) < 1.0e-12) continue;
+
+            for (size_t fi=0; fi<num_face_nodes; fi++)
+            {
+              const int i  = cell_mapping.MapFaceNode(f,fi);
+              const int64_t ir = MatrixFreeDOF(cell, i, g);
+
+              for (size_t fj=0; fj<num_face_nodes; fj++)
+              {
+                const int j  = cell_mapping.MapFaceNode(f,fj);
+                accumulate(ir, MatrixFreeDOF(cell, j, g),
+                           (aval/bval) * face_M[i][j]);
+              }//for fj
+            }//for fi
+          }//Robin BC
+        }//boundary face
+      }//for face
+    }//for g
+  }//for cell
+}
+
+//###################################################################
+/**Computes the inverse of the diagonal of the MIP operator, used by the
+ * preconditioner.*/
+void DiffusionMIPSolver::ComputeMatrixFreeDiagonal()
+{
+  std::vector<double> diagonal(num_local_dofs_, 0.0);
+  EvaluateMatrixFreeOperator(
+    [&diagonal](int64_t row, int64_t col, double value)
+    {
+      if (row == col) diagonal[row] += value;
+    });
+
+  mf_inv_diagonal_.assign(num_local_dofs_, 0.0);
+  for (int64_t k = 0; k < num_local_dofs_; ++k)
+    if (std::fabs(diagonal[k]) > 1.0e-300)
+      mf_inv_diagonal_[k] = 1.0 / diagonal[k];
+}
+
+//###################################################################
+/**Matrix-free counterpart of AssembleAand_b. Only the right-hand side is
+ * assembled, while the low-order operator and the diagonal are assembled for
+ * the current material data.*/
+void DiffusionMIPSolver::AssembleMatrixFree(const std::vector<double>& q_vector)
+{
+  lo_solver_->UpdateXSs(mat_id_2_xs_map_);
+  ComputeMatrixFreeDiagonal();
+
+  Assemble_b(q_vector);
+
+  KSPSetOperators(ksp_, A_, A_);
+
+  if (options.verbose)
+    Chi::log.Log() << Chi::program_timer.GetTimeString()
+                   << " Matrix-free assembly completed";
+}
+
+//###################################################################
+/**Also counts the solves of the low-order preconditioner.*/
+void DiffusionMIPSolver::PreparePreconditioner()
+{
+  DiffusionSolver::PreparePreconditioner();
+  if (lo_solver_) lo_solver_->PreparePreconditioner();
+}
+
+//###################################################################
+/**Shell matrix multiplication, `y = A x`.*/
+PetscErrorCode DiffusionMIPSolver::MatrixFreeMult(Mat A, Vec x, Vec y)
+{
+  DiffusionMIPSolver* solver;
+  MatShellGetContext(A, &solver);
+
+  const size_t num_local_dofs = solver->num_local_dofs_;
+  auto& x_with_ghosts = solver->mf_x_with_ghosts_;
+
+  const double* x_raw;
+  VecGetArrayRead(x, &x_raw);
+  std::copy(x_raw, x_raw + num_local_dofs, x_with_ghosts.begin());
+  VecRestoreArrayRead(x, &x_raw);
+
+  solver->mf_ghost_comm_->CommunicateGhostEntries(x_with_ghosts);
+
+  double* y_raw;
+  VecGetArray(y, &y_raw);
+  std::fill(y_raw, y_raw + num_local_dofs, 0.0);
+  solver->EvaluateMatrixFreeOperator(
+    [y_raw, &x_with_ghosts](int64_t row, int64_t col, double value)
+    {
+      y_raw[row] += value * x_with_ghosts[col];
+    });
+  VecRestoreArray(y, &y_raw);
+
+  return 0;
+}
+
+//###################################################################
+/**Shell preconditioner application, `z = D^{-1} r + P A_c^{-1} P^T r`.*/
+PetscErrorCode DiffusionMIPSolver::LowOrderPCApply(PC pc, Vec r, Vec z)
+{
+  DiffusionMIPSolver* solver;
+  PCShellGetContext(pc, &solver);
+
+  const auto& sdm = solver->sdm_;
+  const auto& lo_sdm = *solver->lo_sdm_;
+  const auto& uk_man = solver->uk_man_;
+  const auto& grid = solver->grid_;
+  const size_t num_groups = uk_man.unknowns_.front().num_components_;
+
+  //============================================= Restrict to PWLC
+  const double* r_raw;
+  VecGetArrayRead(r, &r_raw);
+  VecSet(solver->lo_r_, 0.0);
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t num_nodes = sdm.GetCellMapping(cell).NumNodes();
+    for (size_t i = 0; i < num_nodes; ++i)
+      for (size_t g = 0; g < num_groups; ++g)
+        VecSetValue(solver->lo_r_,
+                    lo_sdm.MapDOF(cell, i, uk_man, 0, g),
+                    r_raw[sdm.MapDOFLocal(cell, i, uk_man, 0, g)],
+                    ADD_VALUES);
+  }
+  VecAssemblyBegin(solver->lo_r_);
+  VecAssemblyEnd(solver->lo_r_);
+
+  //============================================= Low-order correction
+  solver->lo_solver_->ApplyPreconditioner(solver->lo_r_, solver->lo_x_);
+
+  std::vector<double> lo_x_local;
+  chi_math::PETScUtils::CommunicateGhostEntries(solver->lo_x_);
+  lo_sdm.LocalizePETScVectorWithGhosts(solver->lo_x_, lo_x_local, uk_man);
+
+  //============================================= Prolongate and add the
+  //                                              Jacobi term
+  const auto& inv_diagonal = solver->mf_inv_diagonal_;
+  double* z_raw;
+  VecGetArray(z, &z_raw);
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t num_nodes = sdm.GetCellMapping(cell).NumNodes();
+    for (size_t i = 0; i < num_nodes; ++i)
+      for (size_t g = 0; g < num_groups; ++g)
+      {
+        const int64_t dof = sdm.MapDOFLocal(cell, i, uk_man, 0, g);
+        z_raw[dof] = inv_diagonal[dof] * r_raw[dof] +
+                     lo_x_local[lo_sdm.MapDOFLocal(cell, i, uk_man, 0, g)];
+      }
+  }
+  VecRestoreArray(z, &z_raw);
+  VecRestoreArrayRead(r, &r_raw);
+
+  return 0;
+}
+
+}//namespace lbs::acceleration
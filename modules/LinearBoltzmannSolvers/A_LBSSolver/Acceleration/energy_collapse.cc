@@ -4,14 +4,21 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi_utils.h"
+
+#include <algorithm>
 
 namespace lbs::acceleration
 {
+namespace
+{
 // ###################################################################
-/***/
+/**Computes the two-grid collapsed data of the cross sections and the
+ * fundamental eigenvalue of the iteration matrix.*/
 TwoGridCollapsedInfo
-MakeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
-                         EnergyCollapseScheme scheme)
+ComputeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
+                            EnergyCollapseScheme scheme,
+                            double& rho)
 {
   const std::string fname = "lbs::acceleration::MakeTwoGridCollapsedInfo";
 
@@ -72,7 +79,7 @@ MakeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
   std::vector<double> spectrum(num_groups, 1.0);
 
   //============================================= Perform power iteration
-  double rho = chi_math::PowerIteration(C, E, 1000, 1.0e-12);
+  rho = chi_math::PowerIteration(C, E, 1000, 1.0e-12);
 
   //======================================== Compute two-grid diffusion
   // quantities
@@ -93,14 +100,101 @@ MakeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
       collapsed_sig_a -= S[g][gp] * spectrum[gp];
   }
 
-  //======================================== Verbose output the spectrum
+  return {collapsed_D, collapsed_sig_a, spectrum};
+}
+
+// ###################################################################
+/**Verbose output of the spectrum.*/
+void LogTwoGridSpectrum(double rho, const std::vector<double>& spectrum)
+{
   Chi::log.Log0Verbose1() << "Fundamental eigen-value: " << rho;
   std::stringstream outstr;
   for (auto& xi : spectrum)
     outstr << xi << '\n';
   Chi::log.Log0Verbose1() << outstr.str();
+}
+} // namespace
 
-  return {collapsed_D, collapsed_sig_a, spectrum};
+// ###################################################################
+/***/
+TwoGridCollapsedInfo
+MakeTwoGridCollapsedInfo(const chi_physics::MultiGroupXS& xs,
+                         EnergyCollapseScheme scheme)
+{
+  double rho = 0.0;
+  auto tginfo = ComputeTwoGridCollapsedInfo(xs, scheme, rho);
+  LogTwoGridSpectrum(rho, tginfo.spectrum);
+
+  return tginfo;
+}
+
+// ###################################################################
+/**Makes the two-grid collapsed data of every material of the map.
+ *
+ * The collapsed data are cached per cross section hash and scheme, hence
+ * materials sharing their cross sections, and later calls with unchanged
+ * cross sections, are not recomputed. The materials not in the cache are
+ * distributed round-robin over the processes and the results shared with
+ * an allgather. The call is collective, and since every process holds the
+ * same cross sections, the caches remain identical on all processes.*/
+std::map<int, TwoGridCollapsedInfo>
+MakeTwoGridCollapsedInfos(const std::map<int, MGXSPtr>& matid_to_xs_map,
+                          EnergyCollapseScheme scheme)
+{
+  static std::map<std::pair<uint64_t, int>, TwoGridCollapsedInfo> cache;
+
+  //============================================= Find the uncached xs
+  std::map<int, std::pair<uint64_t, int>> matid_to_key;
+  std::vector<std::pair<uint64_t, int>> uncached_keys;
+  std::vector<const chi_physics::MultiGroupXS*> uncached_xs;
+  for (const auto& [mat_id, xs] : matid_to_xs_map)
+  {
+    const std::pair<uint64_t, int> key{xs->ComputeHash(),
+                                       static_cast<int>(scheme)};
+    matid_to_key[mat_id] = key;
+
+    if (cache.count(key) > 0 or
+        std::find(uncached_keys.begin(), uncached_keys.end(), key) !=
+          uncached_keys.end())
+      continue;
+
+    uncached_keys.push_back(key);
+    uncached_xs.push_back(xs.get());
+  }
+
+  //============================================= Compute and share
+  // Packed as [D, sig_a, rho, spectrum...]
+  const auto packed_infos = chi_mpi_utils::DistributeAndAllGather(
+    uncached_keys.size(),
+    [&uncached_xs, scheme](size_t k)
+    {
+      double rho = 0.0;
+      const auto tginfo =
+        ComputeTwoGridCollapsedInfo(*uncached_xs[k], scheme, rho);
+
+      std::vector<double> packed = {
+        tginfo.collapsed_D, tginfo.collapsed_sig_a, rho};
+      packed.insert(
+        packed.end(), tginfo.spectrum.begin(), tginfo.spectrum.end());
+      return packed;
+    });
+
+  for (size_t k = 0; k < uncached_keys.size(); ++k)
+  {
+    const auto& packed = packed_infos[k];
+    TwoGridCollapsedInfo tginfo{
+      packed[0], packed[1], {packed.begin() + 3, packed.end()}};
+    LogTwoGridSpectrum(packed[2], tginfo.spectrum);
+
+    cache[uncached_keys[k]] = std::move(tginfo);
+  }
+
+  //============================================= Map to materials
+  std::map<int, TwoGridCollapsedInfo> matid_to_tginfo;
+  for (const auto& [mat_id, key] : matid_to_key)
+    matid_to_tginfo[mat_id] = cache.at(key);
+
+  return matid_to_tginfo;
 }
 
 } // namespace lbs::acceleration
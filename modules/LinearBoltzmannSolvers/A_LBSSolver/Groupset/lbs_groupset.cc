@@ -50,6 +50,15 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
     "The number of subsets to apply to the set of groups in this set. This is "
     "useful for increasing pipeline size for parallel simulations");
 
+  params.AddOptionalParameter(
+    "angle_set_auto_tune",
+    false,
+    "Flag, when set, times trial sweeps of a few combinations of "
+    "angle_aggregation_num_subsets and groupset_num_subsets during "
+    "initialization, for the AAH sweep type, and uses the fastest. The "
+    "selected values are logged such that these can be supplied in later "
+    "runs.");
+
   params.AddOptionalParameter(
     "inner_linear_method",
     "richardson",
@@ -63,6 +72,12 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
                               30,
                               "If this inner linear solver is gmres, sets the"
                               " number of iterations before a restart occurs.");
+  params.AddOptionalParameter(
+    "wgs_recycle_size",
+    0,
+    "Number of previous inner linear solutions kept to form the initial "
+    "guess of later solves with the same operator, e.g. in later outer "
+    "iterations or time steps. 0 disables recycling.");
 
   params.AddOptionalParameter(
     "allow_cycles",
@@ -72,6 +87,31 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
   params.AddOptionalParameter(
     "log_sweep_events", false, "Turns on a log of sweep events");
 
+  params.AddOptionalParameter(
+    "sweep_statistics",
+    false,
+    "Collects, per location, the time of the sweeps split into compute, "
+    "receive, send, upstream wait and boundary wait time, and the messages "
+    "and bytes communicated. They are logged after every groupset solve, "
+    "with the measured and ideal KBA parallel efficiencies.");
+  params.AddOptionalParameter(
+    "sweep_statistics_file",
+    "",
+    "If not empty, the sweep statistics of every location are also written "
+    "to this JSON file after every groupset solve. Implies "
+    "sweep_statistics.");
+
+  params.AddOptionalParameter(
+    "angular_flux_precision",
+    "double",
+    "The precision with which angular fluxes are stored and communicated "
+    "between locations during sweeps. With \"single\" the sweep buffers of "
+    "the successor and predecessor locations hold floats, which are sent "
+    "and received as is, halving both the sweep traffic and the memory of "
+    "these buffers. The local cell solves, the psi of local faces, the "
+    "delayed psi and the flux moment accumulation remain in double "
+    "precision.");
+
   // WG DSA options
   params.AddOptionalParameter("apply_wgdsa",
                               false,
@@ -85,6 +125,12 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
     "wgdsa_verbose", false, "If true, WGDSA routines will print verbosely");
   params.AddOptionalParameter(
     "wgdsa_petsc_options", "", "PETSc options to pass to WGDSA solver");
+  params.AddOptionalParameter(
+    "wgdsa_group_blocks",
+    false,
+    "If true, the groups of the groupset are declared as the block structure "
+    "of the WGDSA matrix, such that the single BoomerAMG setup and solve "
+    "treats each group's diffusion operator separately.");
 
   // TG DSA options
   params.AddOptionalParameter(
@@ -100,12 +146,71 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
   params.AddOptionalParameter(
     "tgdsa_petsc_options", "", "PETSc options to pass to TGDSA solver");
 
+  // Angular multigrid options
+  params.AddOptionalParameter(
+    "apply_angular_mg",
+    false,
+    "Flag to precondition the within-groupset Krylov solves with coarse "
+    "angle transport sweeps, using the quadrature given by "
+    "\"angular_mg_quadrature_handle\", which is useful for anisotropic "
+    "scattering problems where DSA degrades.");
+  params.AddOptionalParameter<size_t>(
+    "angular_mg_quadrature_handle",
+    0,
+    "Handle to the lower order angular quadrature of the angular multigrid "
+    "coarse level. Required when \"apply_angular_mg\" is true.");
+  params.AddOptionalParameter(
+    "angular_mg_l_max_its",
+    2,
+    "Number of coarse level source iterations per preconditioner "
+    "application.");
+  params.AddOptionalParameter(
+    "angular_mg_verbose", false, "If true, angular multigrid prints verbosely");
+
+  // DSA preconditioner reuse
+  params.AddOptionalParameter(
+    "dsa_pc_reuse_max_solves",
+    0,
+    "When the DSA operators are updated for new cross sections, the "
+    "preconditioner (e.g. the AMG hierarchy) is kept, and only the operator "
+    "values refreshed, for at most this number of solves since the "
+    "preconditioner was set up. Zero always rebuilds the preconditioner.");
+  params.AddOptionalParameter(
+    "dsa_pc_reuse_tolerance",
+    0.1,
+    "Maximum relative change of the diffusion coefficients and removal cross "
+    "sections, since the DSA preconditioner was set up, for which it is "
+    "reused.");
+  params.AddOptionalParameter(
+    "dsa_matrix_free",
+    false,
+    "If true, the DSA diffusion operators are applied without assembling "
+    "their matrices, with a preconditioner built on the continuous PWLC "
+    "diffusion operator.");
+  params.AddOptionalParameter(
+    "dsa_pipelined",
+    false,
+    "If true, the DSA diffusion systems are solved with pipelined CG, which "
+    "overlaps the global reduction of each iteration with the operator "
+    "application and the preconditioner. This hides the reduction latency "
+    "at large location counts, at the cost of slightly more vector "
+    "operations per iteration.");
+  params.AddOptionalParameter(
+    "dsa_device_backend",
+    "cpu",
+    "Backend of the DSA diffusion matrices and vectors. The device backends "
+    "\"cuda\", \"hip\" and \"kokkos\" assemble the matrices on the "
+    "GPUs, where the solves then run, and require PETSc to be configured "
+    "with the corresponding package. The AMG preconditioner is BoomerAMG if "
+    "hypre was built for the devices, otherwise GAMG.");
+
   // ============================================ Constraints
   using namespace chi_data_types;
 
   params.ConstrainParameterRange(
     "angle_aggregation_type",
-    AllowableRangeList::New({"polar", "single", "azimuthal"}));
+    AllowableRangeList::New(
+      {"polar", "single", "azimuthal", "sweep_ordering"}));
 
   params.ConstrainParameterRange("angle_aggregation_num_subsets",
                                  AllowableRangeLowLimit::New(1));
@@ -122,6 +227,20 @@ chi::InputParameters lbs::LBSGroupset::GetInputParameters()
   params.ConstrainParameterRange("l_max_its", AllowableRangeLowLimit::New(0));
   params.ConstrainParameterRange("gmres_restart_interval",
                                  AllowableRangeLowLimit::New(1));
+  params.ConstrainParameterRange("wgs_recycle_size",
+                                 AllowableRangeLowLimit::New(0));
+
+  params.ConstrainParameterRange(
+    "angular_flux_precision", AllowableRangeList::New({"double", "single"}));
+  params.ConstrainParameterRange(
+    "dsa_device_backend",
+    AllowableRangeList::New({"cpu", "cuda", "hip", "kokkos"}));
+  params.ConstrainParameterRange("angular_mg_l_max_its",
+                                 AllowableRangeLowLimit::New(1));
+  params.ConstrainParameterRange("dsa_pc_reuse_max_solves",
+                                 AllowableRangeLowLimit::New(0));
+  params.ConstrainParameterRange("dsa_pc_reuse_tolerance",
+                                 AllowableRangeLowLimit::New(0.0));
 
   // clang-format on
 
@@ -178,9 +297,12 @@ lbs::LBSGroupset::LBSGroupset(const chi::InputParameters& params,
     angleagg_method_ = AngleAggregationType::SINGLE;
   else if (angle_agg_typestr == "azimuthal")
     angleagg_method_ = AngleAggregationType::AZIMUTHAL;
+  else if (angle_agg_typestr == "sweep_ordering")
+    angleagg_method_ = AngleAggregationType::SWEEP_ORDERING;
 
   master_num_ang_subsets_ =
     params.GetParamValue<int>("angle_aggregation_num_subsets");
+  angle_set_auto_tune_ = params.GetParamValue<bool>("angle_set_auto_tune");
 
   // ============================================ Inner solver
   const auto inner_linear_method =
@@ -195,9 +317,16 @@ lbs::LBSGroupset::LBSGroupset(const chi::InputParameters& params,
   allow_cycles_ = params.GetParamValue<bool>("allow_cycles");
   residual_tolerance_ = params.GetParamValue<double>("l_abs_tol");
   max_iterations_ = params.GetParamValue<int>("l_max_its");
+  wgs_recycle_size_ = params.GetParamValue<int>("wgs_recycle_size");
 
   // ============================================ Misc.
   log_sweep_events_ = params.GetParamValue<bool>("log_sweep_events");
+  sweep_statistics_file_ =
+    params.GetParamValue<std::string>("sweep_statistics_file");
+  sweep_statistics_ = params.GetParamValue<bool>("sweep_statistics") or
+                      not sweep_statistics_file_.empty();
+  angular_flux_single_precision_ =
+    params.GetParamValue<std::string>("angular_flux_precision") == "single";
 
   // ============================================ DSA
   apply_wgdsa_ = params.GetParamValue<bool>("apply_wgdsa");
@@ -213,7 +342,32 @@ lbs::LBSGroupset::LBSGroupset(const chi::InputParameters& params,
   tgdsa_verbose_ = params.GetParamValue<bool>("tgdsa_verbose");
 
   wgdsa_string_ = params.GetParamValue<std::string>("wgdsa_petsc_options");
+  wgdsa_group_blocks_ = params.GetParamValue<bool>("wgdsa_group_blocks");
   tgdsa_string_ = params.GetParamValue<std::string>("tgdsa_petsc_options");
+
+  // ============================================ Angular multigrid
+  apply_angular_mg_ = params.GetParamValue<bool>("apply_angular_mg");
+  angular_mg_max_iters_ = params.GetParamValue<int>("angular_mg_l_max_its");
+  angular_mg_verbose_ = params.GetParamValue<bool>("angular_mg_verbose");
+  if (apply_angular_mg_)
+  {
+    ChiInvalidArgumentIf(
+      not params.ParametersAtAssignment().Has("angular_mg_quadrature_handle"),
+      "Parameter \"apply_angular_mg\" requires "
+      "\"angular_mg_quadrature_handle\".");
+    const size_t mg_quad_handle =
+      params.GetParamValue<size_t>("angular_mg_quadrature_handle");
+    angular_mg_quadrature_ = Chi::GetStackItemPtr<chi_math::AngularQuadrature>(
+      Chi::angular_quadrature_stack, mg_quad_handle, fname);
+  }
+
+  dsa_pc_reuse_max_solves_ =
+    params.GetParamValue<int>("dsa_pc_reuse_max_solves");
+  dsa_pc_reuse_tol_ = params.GetParamValue<double>("dsa_pc_reuse_tolerance");
+  dsa_matrix_free_ = params.GetParamValue<bool>("dsa_matrix_free");
+  dsa_pipelined_ = params.GetParamValue<bool>("dsa_pipelined");
+  dsa_device_backend_ = chi_math::PETScUtils::DeviceBackendFromName(
+    params.GetParamValue<std::string>("dsa_device_backend"));
 }
 
 // ##################################################################
@@ -277,9 +431,10 @@ void lbs::LBSGroupset::BuildSubsets()
 }
 
 // ##################################################################
-/**Constructs the groupset subsets.*/
-void lbs::LBSGroupset::PrintSweepInfoFile(size_t ev_tag,
-                                          const std::string& file_name)
+/**Prints the angle sets and the sweep timing of this location.*/
+void lbs::LBSGroupset::
+  PrintSweepInfoFile(const chi::RunningStatistics& sweep_timing,
+                     const std::string& file_name)
 {
   if (not log_sweep_events_) return;
 
@@ -313,8 +468,10 @@ void lbs::LBSGroupset::PrintSweepInfoFile(size_t ev_tag,
     }
   }
 
-  //======================================== Print event history
-  ofile << Chi::log.PrintEventHistory(ev_tag);
+  //======================================== Print sweep timing
+  ofile << "Sweeps " << sweep_timing.count << ", time (s) total "
+        << sweep_timing.total << " min " << sweep_timing.min
+        << " max " << sweep_timing.max << "\n";
 
   ofile.close();
 }
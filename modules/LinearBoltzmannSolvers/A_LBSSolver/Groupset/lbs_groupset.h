@@ -9,6 +9,7 @@
 #include "math/Quadratures/LegendrePoly/legendrepoly.h"
 #include "math/Quadratures/angular_quadrature_base.h"
 #include "math/UnknownManager/unknown_manager.h"
+#include "math/PETScUtils/petsc_utils.h"
 
 #include "mesh/SweepUtilities/AngleAggregation/angleaggregation.h"
 
@@ -16,6 +17,7 @@
 #include "LinearBoltzmannSolvers/A_LBSSolver/Tools/lbs_make_subset.h"
 
 #include "physics/chi_physics_namespace.h"
+#include "utils/chi_profiler.h"
 
 #include "A_LBSSolver/Acceleration/acceleration.h"
 
@@ -45,6 +47,7 @@ public:
 
   int                                          master_num_grp_subsets_ = 1;
   int                                          master_num_ang_subsets_ = 1;
+  bool                                         angle_set_auto_tune_ = false;
 
   std::vector<SubSetInfo>                      grp_subset_infos_;
 
@@ -53,9 +56,13 @@ public:
   double               residual_tolerance_ = 1.0e-6;
   int                  max_iterations_ = 200;
   int                  gmres_restart_intvl_ = 30;
+  int                  wgs_recycle_size_ = 0;
 
   bool                 allow_cycles_ = false;
   bool                 log_sweep_events_ = false;
+  bool                 sweep_statistics_ = false;
+  std::string          sweep_statistics_file_;
+  bool                 angular_flux_single_precision_ = false;
 
   bool                 apply_wgdsa_ = false;
   bool                 apply_tgdsa_ = false;
@@ -66,7 +73,22 @@ public:
   bool                 wgdsa_verbose_ = false;
   bool                 tgdsa_verbose_ = false;
   std::string          wgdsa_string_;
+  bool                 wgdsa_group_blocks_ = false;
   std::string          tgdsa_string_;
+  int                  dsa_pc_reuse_max_solves_ = 0;
+  double               dsa_pc_reuse_tol_ = 0.1;
+  bool                 dsa_matrix_free_ = false;
+  bool                 dsa_pipelined_ = false;
+  chi_math::PETScUtils::DeviceBackend dsa_device_backend_ =
+    chi_math::PETScUtils::DeviceBackend::CPU;
+
+  bool                 apply_angular_mg_ = false;
+  int                  angular_mg_max_iters_ = 2;
+  bool                 angular_mg_verbose_ = false;
+  std::shared_ptr<chi_math::AngularQuadrature> angular_mg_quadrature_ = nullptr;
+  /**Coarse angular level, i.e. a copy of this groupset with the angular
+   * multigrid quadrature and its own angle aggregation.*/
+  std::shared_ptr<LBSGroupset> angular_mg_groupset_ = nullptr;
 
   std::shared_ptr<lbs::acceleration::DiffusionMIPSolver> wgdsa_solver_;
   std::shared_ptr<lbs::acceleration::DiffusionMIPSolver> tgdsa_solver_;
@@ -95,7 +117,8 @@ public:
                             GeometryType geometry_type);
   void BuildSubsets();
 public:
-  void PrintSweepInfoFile(size_t ev_tag,const std::string& file_name);
+  void PrintSweepInfoFile(const chi::RunningStatistics& sweep_timing,
+                          const std::string& file_name);
 };
 }
 
@@ -1,6 +1,7 @@
 #include "ags_linear_solver.h"
 
 #include "A_LBSSolver/lbs_solver.h"
+#include "A_LBSSolver/IterativeMethods/wgs_context.h"
 
 #include "math/PETScUtils/petsc_utils.h"
 #include "math/LinearSolver/linear_matrix_action_Ax.h"
@@ -19,6 +20,83 @@
 namespace lbs
 {
 
+namespace
+{
+/**Returns true if any material couples groups [src_first, src_last] into
+ * groups [dest_first, dest_last] through the sources in the given scope.*/
+bool GroupsCoupled(const LBSSolver& lbs_solver,
+                   const int scope,
+                   const size_t dest_first, const size_t dest_last,
+                   const size_t src_first, const size_t src_last)
+{
+  for (const auto& [mat_id, xs] : lbs_solver.GetMatID2XSMap())
+  {
+    if (scope & APPLY_AGS_SCATTER_SOURCES)
+      for (const auto& S_ell : xs->TransferMatrices())
+        for (size_t g = dest_first;
+             g <= dest_last and g < S_ell.rowI_indices_.size(); ++g)
+        {
+          const auto& col_ids = S_ell.rowI_indices_[g];
+          const auto& col_vals = S_ell.rowI_values_[g];
+          for (size_t k = 0; k < col_ids.size(); ++k)
+            if (col_ids[k] >= src_first and col_ids[k] <= src_last and
+                col_vals[k] != 0.0)
+              return true;
+        }
+
+    if ((scope & APPLY_AGS_FISSION_SOURCES) and xs->IsFissionable())
+    {
+      //delayed production couples through the precursors
+      if (lbs_solver.Options().use_precursors) return true;
+
+      const auto F = xs->Production().ToMatrix();
+      for (size_t g = dest_first; g <= dest_last and g < F.size(); ++g)
+        for (size_t gp = src_first; gp <= src_last and gp < F[g].size(); ++gp)
+          if (F[g][gp] != 0.0) return true;
+    }
+  }
+  return false;
+}
+
+/**Returns the number of leading sub-solvers whose groupsets receive no
+ * source from the groupsets of later sub-solvers. Such groupsets only
+ * depend on themselves and on earlier groupsets, hence their solutions do
+ * not change after the first across-groupset iteration.*/
+size_t NumLeadingDecoupledSolvers(
+  const LBSSolver& lbs_solver,
+  const std::vector<AGSContext<Mat,Vec,KSP>::LinSolveBaseTypePtr>& solvers)
+{
+  std::vector<std::shared_ptr<WGSContext<Mat,Vec,KSP>>> contexts;
+  for (const auto& solver : solvers)
+  {
+    auto context = std::dynamic_pointer_cast<WGSContext<Mat,Vec,KSP>>(
+      solver->GetContext());
+    if (not context) return 0;
+    contexts.push_back(context);
+  }
+
+  size_t num_decoupled = 0;
+  for (size_t i = 0; i < contexts.size(); ++i)
+  {
+    const auto& dest_gs = contexts[i]->groupset_;
+    const int scope = contexts[i]->lhs_src_scope_ |
+                      contexts[i]->rhs_src_scope_;
+    for (size_t j = i + 1; j < contexts.size(); ++j)
+    {
+      const auto& src_gs = contexts[j]->groupset_;
+      if (GroupsCoupled(lbs_solver, scope,
+                        dest_gs.groups_.front().id_,
+                        dest_gs.groups_.back().id_,
+                        src_gs.groups_.front().id_,
+                        src_gs.groups_.back().id_))
+        return num_decoupled;
+    }
+    ++num_decoupled;
+  }
+  return num_decoupled;
+}
+}//namespace
+
 template<>
 void AGSLinearSolver<Mat,Vec,KSP>::SetSystemSize()
 {
@@ -91,15 +169,28 @@ void AGSLinearSolver<Mat,Vec,KSP>::Solve()
   //and for keigen-value problems
   const auto saved_qmoms = lbs_solver.QMomentsLocal();
 
+  //Leading groupsets without sources from later groupsets, e.g. fast
+  //groupsets without upscatter, are converged after the first iteration
+  //and are not solved again
+  auto& sub_solvers = ags_context_ptr->sub_solvers_list_;
+  const size_t num_decoupled =
+    tolerance_options_.maximum_iterations > 1 ?
+    NumLeadingDecoupledSolvers(lbs_solver, sub_solvers) : 0;
+
+  if (verbose_ and num_decoupled > 0)
+    Chi::log.Log() << "AGS solver: the first " << num_decoupled
+                   << " groupset(s) receive no source from later groupsets"
+                   << " and are only solved in the first iteration.";
+
   for (int iter = 0; iter < tolerance_options_.maximum_iterations; ++iter)
   {
 
     lbs_solver.SetGroupScopedPETScVecFromPrimarySTLvector(gid_i,gid_f,x_old,phi);
 
-    for (auto& solver : ags_context_ptr->sub_solvers_list_)
+    for (size_t s = (iter == 0 ? 0 : num_decoupled); s < sub_solvers.size(); ++s)
     {
-      solver->Setup();
-      solver->Solve();
+      sub_solvers[s]->Setup();
+      sub_solvers[s]->Solve();
     }
 
     lbs_solver.SetGroupScopedPETScVecFromPrimarySTLvector(gid_i,gid_f,x_,phi);
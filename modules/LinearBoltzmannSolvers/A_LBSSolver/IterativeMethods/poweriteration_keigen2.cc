@@ -10,6 +10,7 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
 
 #include <iomanip>
 
@@ -177,6 +178,19 @@ void PowerIterationKEigen2(LBSSolver& lbs_solver,
       Chi::log.Log() << k_iter_info.str();
     }
 
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "power_iteration_nlkeigen")
+                       .Add("iteration", nit)
+                       .Add("k_eff", k_eff)
+                       .Add("k_eff_change", k_eff_change)
+                       .Add("reactivity", reactivity)
+                       .Add("sweeps",
+                            frons_wgs_context->counter_applications_of_inv_op_)
+                       .Add("converged", converged));
+
     if (converged) break;
   }//for k iterations
 
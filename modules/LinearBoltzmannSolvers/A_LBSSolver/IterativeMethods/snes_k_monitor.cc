@@ -3,6 +3,7 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
 
 #include <petscsnes.h>
 #include <iomanip>
@@ -32,6 +33,16 @@ PetscErrorCode KEigenSNESMonitor(SNES, PetscInt iter,
 
   Chi::log.Log() << iter_info.str();
 
+  auto& telemetry = chi::Telemetry::GetInstance();
+  if (telemetry.Enabled())
+    telemetry.Emit("nonlinear_k_outer",
+                   chi::Telemetry::Record()
+                     .Add("solver", residual_context.solver_name)
+                     .Add("iteration", iter)
+                     .Add("residual", rnorm)
+                     .Add("k_eff", k_eff)
+                     .Add("reactivity", reactivity));
+
   return 0;
 }
 
@@ -50,6 +61,14 @@ PetscErrorCode KEigenKSPMonitor(KSP ksp, PetscInt iter, PetscReal rnorm,
 
   Chi::log.Log() << iter_info.str();
 
+  auto& telemetry = chi::Telemetry::GetInstance();
+  if (telemetry.Enabled())
+    telemetry.Emit("nonlinear_k_inner",
+                   chi::Telemetry::Record()
+                     .Add("solver", residual_context.solver_name)
+                     .Add("iteration", iter)
+                     .Add("residual", rnorm));
+
   return 0;
 }
 
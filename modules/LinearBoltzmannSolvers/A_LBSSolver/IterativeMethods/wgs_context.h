@@ -31,6 +31,18 @@ struct WGSContext : public chi_math::LinearSolverContext<MatType, VecType>
   int rhs_src_scope_;
   bool log_info_ = true;
   size_t counter_applications_of_inv_op_ = 0;
+  /**Residual tolerance used instead of the groupset's when it is larger,
+   * e.g. by inexact outer iterations. Zero disables it.*/
+  double relaxed_residual_tolerance_ = 0.0;
+
+  /**Previous solutions, and the right-hand sides they solve, from which
+   * the initial guess of the next solve is formed when recycling is
+   * enabled on the groupset. The right-hand sides are kept orthonormal.
+   * The subspace is only valid for the lhs scope it was built with.*/
+  std::vector<VecType> recycled_solutions_;
+  std::vector<VecType> recycled_rhs_;
+  VecType recycled_last_solution_ = nullptr;
+  int recycled_lhs_scope_ = 0;
 
   WGSContext(LBSSolver& lbs_solver,
              LBSGroupset& groupset,
@@ -66,6 +78,8 @@ struct WGSContext : public chi_math::LinearSolverContext<MatType, VecType>
   virtual void ApplyInverseTransportOperator(int scope) = 0;
 
   virtual void PostSolveCallback() {};
+
+  void ClearRecycledSubspace();
 };
 
 }//namespace lbs
@@ -27,8 +27,11 @@ int WGSContext<Mat, Vec, KSP>::MatrixAction(Mat& matrix,
 
   //============================================= Setting the source using
   //                                              updated phi_old
+  // Only the groupset's groups are swept, and the source of the others is
+  // restored by the solver, hence only the groupset's span is zeroed
   auto& q_moments_local = lbs_solver_.QMomentsLocal();
-  q_moments_local.assign(q_moments_local.size(), 0.0);
+  lbs_solver.ZeroGroupSpan(groupset.groups_.front().id_,
+                           groupset.groups_.back().id_, q_moments_local);
   set_source_function_(groupset, q_moments_local,
                        lbs_solver.PhiOldLocal(),
                        lhs_src_scope_);
@@ -54,5 +57,17 @@ int WGSContext<Mat, Vec, KSP>::MatrixAction(Mat& matrix,
   return 0;
 }
 
+/**Destroys the recycled solutions and right-hand sides, which is required
+ * whenever the operator changes.*/
+template<>
+void WGSContext<Mat, Vec, KSP>::ClearRecycledSubspace()
+{
+  for (auto& vec : recycled_solutions_) VecDestroy(&vec);
+  for (auto& vec : recycled_rhs_) VecDestroy(&vec);
+  recycled_solutions_.clear();
+  recycled_rhs_.clear();
+  if (recycled_last_solution_) VecDestroy(&recycled_last_solution_);
+  recycled_last_solution_ = nullptr;
 }
 
+}
@@ -7,6 +7,7 @@
 #include "chi_log.h"
 
 #include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
 
 #include <iomanip>
 
@@ -67,7 +68,8 @@ PetscErrorCode GSConvergenceTest(KSP ksp, PetscInt n, PetscReal rnorm,
     << " Iteration " << std::setw(5) << n
     << " Residual " << std::setw(9) << scaled_residual;
 
-  if (scaled_residual < tol)
+  const bool converged = scaled_residual < tol;
+  if (converged)
   {
     *convergedReason = KSP_CONVERGED_RTOL;
     iter_info << " CONVERGED\n";
@@ -75,6 +77,18 @@ PetscErrorCode GSConvergenceTest(KSP ksp, PetscInt n, PetscReal rnorm,
 
   if (context->log_info_) Chi::log.Log() << iter_info.str() << std::endl;
 
+  auto& telemetry = chi::Telemetry::GetInstance();
+  if (telemetry.Enabled())
+    telemetry.Emit("wgs_iteration",
+                   chi::Telemetry::Record()
+                     .Add("groupset", context->groupset_.id_)
+                     .Add("first_group", context->groupset_.groups_.front().id_)
+                     .Add("last_group", context->groupset_.groups_.back().id_)
+                     .Add("iteration", n)
+                     .Add("residual", scaled_residual)
+                     .Add("sweeps", context->counter_applications_of_inv_op_)
+                     .Add("converged", converged));
+
   return KSP_CONVERGED_ITERATING;
 }
 
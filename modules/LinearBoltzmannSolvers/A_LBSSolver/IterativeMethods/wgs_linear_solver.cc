@@ -8,12 +8,14 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
 #include "utils/chi_timer.h"
 
 #include <petscksp.h>
 #include <memory>
 #include <iomanip>
+#include <algorithm>
 
 #define sc_double static_cast<double>
 #define sc_int64_t static_cast<int64_t>
@@ -94,11 +96,20 @@ void WGSLinearSolver<Mat, Vec, KSP>::PostSetupCallback()
   gs_context_ptr->PostSetupCallback();
 }
 
+/**Applies the residual tolerance for the coming solve, which is the
+ * groupset's tolerance unless the context relaxes it, followed by the
+ * context specific callback.*/
 template <>
 void WGSLinearSolver<Mat, Vec, KSP>::PreSolveCallback()
 {
   auto gs_context_ptr = GetGSContextPtr(context_ptr_);
 
+  auto& tolerance_options = this->ToleranceOptions();
+  tolerance_options.residual_absolute =
+    std::max(gs_context_ptr->groupset_.residual_tolerance_,
+             gs_context_ptr->relaxed_residual_tolerance_);
+  this->ApplyToleranceOptions();
+
   gs_context_ptr->PreSolveCallback();
 }
 
@@ -127,6 +138,121 @@ void WGSLinearSolver<Mat, Vec, KSP>::SetInitialGuess()
   }
 }
 
+/**Replaces the initial guess by the combination of the recycled solutions
+ * whose right-hand sides best approximate the current right-hand side.
+ * Since the recycled solutions include the last solution, the new guess has
+ * no larger residual than the default guess, which is only replaced when it
+ * is zero or still the last solution.*/
+template <>
+void WGSLinearSolver<Mat, Vec, KSP>::FormRecycledInitialGuess()
+{
+  auto gs_context_ptr = GetGSContextPtr(context_ptr_);
+
+  if (gs_context_ptr->groupset_.wgs_recycle_size_ <= 0) return;
+  if (gs_context_ptr->recycled_lhs_scope_ != gs_context_ptr->lhs_src_scope_)
+    gs_context_ptr->ClearRecycledSubspace();
+
+  auto& solutions = gs_context_ptr->recycled_solutions_;
+  auto& rhs = gs_context_ptr->recycled_rhs_;
+  if (rhs.empty()) return;
+
+  //============================================= Check the current guess
+  PetscBool guess_nonzero;
+  KSPGetInitialGuessNonzero(solver_, &guess_nonzero);
+  if (guess_nonzero)
+  {
+    Vec diff;
+    VecDuplicate(x_, &diff);
+    VecWAXPY(diff, -1.0, gs_context_ptr->recycled_last_solution_, x_);
+
+    double diff_norm = 0.0, x_norm = 0.0;
+    VecNorm(diff, NORM_2, &diff_norm);
+    VecNorm(x_, NORM_2, &x_norm);
+    VecDestroy(&diff);
+
+    if (diff_norm > 1.0e-12 * x_norm) return;
+  }
+
+  //============================================= Project the rhs
+  const auto num_vecs = static_cast<PetscInt>(rhs.size());
+  std::vector<PetscScalar> coefficients(rhs.size(), 0.0);
+  VecMDot(b_, num_vecs, rhs.data(), coefficients.data());
+
+  VecSet(x_, 0.0);
+  VecMAXPY(x_, num_vecs, coefficients.data(), solutions.data());
+  KSPSetInitialGuessNonzero(solver_, PETSC_TRUE);
+
+  if (gs_context_ptr->log_info_)
+    Chi::log.Log() << "Using " << num_vecs
+                   << " recycled solutions as initial guess.";
+}
+
+/**Adds the last solution and right-hand side to the recycled subspace,
+ * orthonormalizing the right-hand side against the kept ones and applying
+ * the same combination to the solution. The oldest pair is dropped when
+ * the subspace is full, which keeps the right-hand sides orthonormal.*/
+template <>
+void WGSLinearSolver<Mat, Vec, KSP>::UpdateRecycledSubspace()
+{
+  auto gs_context_ptr = GetGSContextPtr(context_ptr_);
+
+  const int max_size = gs_context_ptr->groupset_.wgs_recycle_size_;
+  if (max_size <= 0 or GetKSPSolveSuppressionFlag()) return;
+  if (gs_context_ptr->recycled_lhs_scope_ != gs_context_ptr->lhs_src_scope_)
+    gs_context_ptr->ClearRecycledSubspace();
+  gs_context_ptr->recycled_lhs_scope_ = gs_context_ptr->lhs_src_scope_;
+
+  auto& solutions = gs_context_ptr->recycled_solutions_;
+  auto& rhs = gs_context_ptr->recycled_rhs_;
+
+  auto& last_solution = gs_context_ptr->recycled_last_solution_;
+  if (not last_solution) VecDuplicate(x_, &last_solution);
+  VecCopy(x_, last_solution);
+
+  double b_norm = 0.0;
+  VecNorm(b_, NORM_2, &b_norm);
+  if (b_norm <= 0.0) return;
+
+  Vec x_new, b_new;
+  VecDuplicate(x_, &x_new);
+  VecDuplicate(b_, &b_new);
+  VecCopy(x_, x_new);
+  VecCopy(b_, b_new);
+
+  //============================================= Modified Gram-Schmidt
+  for (size_t i = 0; i < rhs.size(); ++i)
+  {
+    PetscScalar h;
+    VecDot(b_new, rhs[i], &h);
+    VecAXPY(b_new, -h, rhs[i]);
+    VecAXPY(x_new, -h, solutions[i]);
+  }
+
+  double b_new_norm = 0.0;
+  VecNorm(b_new, NORM_2, &b_new_norm);
+
+  //============================================= Drop dependent pairs
+  if (b_new_norm <= 1.0e-8 * b_norm)
+  {
+    VecDestroy(&x_new);
+    VecDestroy(&b_new);
+    return;
+  }
+
+  VecScale(x_new, 1.0 / b_new_norm);
+  VecScale(b_new, 1.0 / b_new_norm);
+  solutions.push_back(x_new);
+  rhs.push_back(b_new);
+
+  if (rhs.size() > static_cast<size_t>(max_size))
+  {
+    VecDestroy(&solutions.front());
+    VecDestroy(&rhs.front());
+    solutions.erase(solutions.begin());
+    rhs.erase(rhs.begin());
+  }
+}
+
 template <>
 void WGSLinearSolver<Mat, Vec, KSP>::SetRHS()
 {
@@ -171,6 +297,8 @@ void WGSLinearSolver<Mat, Vec, KSP>::SetRHS()
     PCApply(pc, b_, temp_vec);
     VecNorm(temp_vec, NORM_2, &context_ptr_->rhs_preconditioned_norm);
     VecDestroy(&temp_vec);
+
+    FormRecycledInitialGuess();
   }
   // If we have a single richardson iteration then the user probably wants
   // only a single sweep. Therefore, we are going to combine the scattering
@@ -224,6 +352,8 @@ void WGSLinearSolver<Mat, Vec, KSP>::PostSolveCallback()
                                   reason);
   }
 
+  UpdateRecycledSubspace();
+
   //============================================= Copy x to local solution
   auto gs_context_ptr = GetGSContextPtr(context_ptr_);
 
@@ -238,6 +368,24 @@ void WGSLinearSolver<Mat, Vec, KSP>::PostSolveCallback()
   //============================================= Restore saved q_moms
   lbs_solver.QMomentsLocal() = saved_q_moments_local_;
 
+  //============================================= Write restart data
+  // The decision is made on location 0 so that all locations agree
+  const auto& options = lbs_solver.Options();
+  if (options.write_restart_data)
+  {
+    const double time_minutes = Chi::program_timer.GetTime() / 60000.0;
+    char write_due = (time_minutes - lbs_solver.LastRestartWrite()) >=
+                     options.write_restart_interval;
+    MPI_Bcast(&write_due, 1, MPI_CHAR, 0, Chi::mpi.comm);
+
+    if (write_due)
+    {
+      lbs_solver.WriteRestartData(options.write_restart_folder_name,
+                                  options.write_restart_file_base);
+      lbs_solver.LastRestartWrite() = time_minutes;
+    }
+  }
+
   //============================================= Context specific callback
   gs_context_ptr->PostSolveCallback();
 }
@@ -245,6 +393,9 @@ void WGSLinearSolver<Mat, Vec, KSP>::PostSolveCallback()
 template <>
 WGSLinearSolver<Mat, Vec, KSP>::~WGSLinearSolver()
 {
+  auto gs_context_ptr = GetGSContextPtr(context_ptr_);
+  if (gs_context_ptr) gs_context_ptr->ClearRecycledSubspace();
+
   MatDestroy(&A_);
 }
 } // namespace lbs
@@ -59,6 +59,8 @@ protected:
   void SetRHS() override;                   //Generic + with context elements
   void SetInitialGuess() override;          //Generic
   void PostSolveCallback() override;        //Generic + with context elements
+  void FormRecycledInitialGuess();
+  void UpdateRecycledSubspace();
 public:
   /*virtual void Solve();*/
 
@@ -4,6 +4,9 @@
 #include <utility>
 
 #include "mesh/chi_mesh.h"
+#include "math/chi_math_time_table.h"
+
+#include <memory>
 
 namespace lbs
 {
@@ -13,6 +16,9 @@ class PointSource
 private:
   const chi_mesh::Vector3 location_;
   const std::vector<double> groupwise_strength_;
+  /**Optional amplitudes in time of the strength.*/
+  std::shared_ptr<const chi_math::TimeTable> time_table_ = nullptr;
+  std::vector<double> strength_;
 
 public:
   struct ContainingCellInfo
@@ -29,12 +35,33 @@ public:
   PointSource(const chi_mesh::Vector3& location,
               std::vector<double>  strength) :
       location_(location),
-      groupwise_strength_(std::move(strength))
+      groupwise_strength_(std::move(strength)),
+      strength_(groupwise_strength_)
   {}
 
   const chi_mesh::Vector3& Location() const { return location_; }
 
-  const std::vector<double>& Strength() const { return groupwise_strength_; }
+  /**Returns the strength at the last evaluation time.*/
+  const std::vector<double>& Strength() const { return strength_; }
+
+  /**Sets the amplitudes in time of the strength, applied from the next
+   * evaluation time.*/
+  void SetTimeTable(std::shared_ptr<const chi_math::TimeTable> time_table)
+  {
+    time_table_ = std::move(time_table);
+    strength_ = groupwise_strength_;
+  }
+
+  /**Scales the strength by the amplitudes of the time table at the given
+   * time.*/
+  void SetEvaluationTime(double time)
+  {
+    if (not time_table_) return;
+    std::vector<double> amplitudes;
+    time_table_->EvaluateGroups(time, groupwise_strength_.size(), amplitudes);
+    for (size_t g = 0; g < strength_.size(); ++g)
+      strength_[g] = groupwise_strength_[g] * amplitudes[g];
+  }
 
   void AddContainingCellInfo(double volume_weight,
                              uint64_t cell_local_id,
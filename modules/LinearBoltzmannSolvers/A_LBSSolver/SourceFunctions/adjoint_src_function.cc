@@ -57,9 +57,9 @@ void AdjointSourceFunction::
           const int num_nodes = full_cell_view.NumNodes();
           for (int i = 0; i < num_nodes; ++i)
           {
-            size_t uk_map = full_cell_view.MapDOF(i, 0, 0); //unknown map
+            size_t uk_map = full_cell_view.MapDOF(i, 0, gs_i); //unknown map
             for (size_t g = gs_i; g <= gs_f; ++g)
-              destination_q[uk_map + g] += response[g];
+              destination_q[uk_map + g - gs_i] += response[g];
           }//for node
         }//for local cell-id of qoi
       }//if ref-qoi
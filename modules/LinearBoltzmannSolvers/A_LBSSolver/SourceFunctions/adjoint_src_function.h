@@ -14,7 +14,8 @@ public:
   explicit
   AdjointSourceFunction(const LBSSolver& lbs_solver);
 
-  double AddSourceMoments() const override {return 0.0;}
+  double AddSourceMoments(const double* /*fixed_src_moments*/,
+                          size_t /*g*/) const override {return 0.0;}
 
   void AddAdditionalSources(LBSGroupset& groupset,
                             std::vector<double>& destination_q,
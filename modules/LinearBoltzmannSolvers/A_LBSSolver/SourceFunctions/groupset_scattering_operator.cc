@@ -0,0 +1,101 @@
+#include "groupset_scattering_operator.h"
+
+namespace lbs
+{
+
+//###################################################################
+/**Compiles the transfer matrices of the given cross section for the
+ * groupset spanning groups `gs_i` to `gs_f`.*/
+GroupsetScatteringOperator::
+  GroupsetScatteringOperator(const chi_physics::MultiGroupXS& xs,
+                             size_t gs_i,
+                             size_t gs_f) :
+  gs_i_(gs_i), gs_f_(gs_f)
+{
+  const auto& S = xs.TransferMatrices();
+  const size_t num_orders = S.size();
+  const size_t num_rows = gs_f - gs_i + 1;
+
+  wgs_blocks_.resize(num_orders);
+  ags_blocks_.resize(num_orders);
+  self_scattering_.assign(num_orders, std::vector<double>(num_rows, 0.0));
+
+  for (size_t ell = 0; ell < num_orders; ++ell)
+  {
+    auto& wgs = wgs_blocks_[ell];
+    auto& ags = ags_blocks_[ell];
+    wgs.row_offsets.assign(1, 0);
+    ags.row_offsets.assign(1, 0);
+
+    for (size_t g = gs_i; g <= gs_f; ++g)
+    {
+      const auto row = S[ell].RowSpan(g);
+      for (size_t j = 0; j < row.size; ++j)
+      {
+        const size_t gp = row.column_indices[j];
+        const double sigma_sm = row.values[j];
+        if (gp == g)
+          self_scattering_[ell][g - gs_i] += sigma_sm;
+        else if (gp >= gs_i and gp <= gs_f)
+        {
+          wgs.col_ids.push_back(gp);
+          wgs.values.push_back(sigma_sm);
+        }
+        else
+        {
+          ags.col_ids.push_back(gp);
+          ags.values.push_back(sigma_sm);
+        }
+      }
+      wgs.row_offsets.push_back(wgs.values.size());
+      ags.row_offsets.push_back(ags.values.size());
+    }//for g
+  }//for ell
+}
+
+//###################################################################
+/**Adds the scattering source of Legendre order `ell` to the destination
+ * for each of the given unknown maps, i.e. the offsets of group zero of
+ * the node-moment pairs of a cell with this order. Each row of the
+ * operator is applied to all the node-moment pairs before moving to the
+ * next, which keeps the row in cache, similar to a matrix-matrix product.*/
+void GroupsetScatteringOperator::
+  AddScattering(unsigned int ell,
+                const std::vector<size_t>& uk_maps,
+                const std::vector<double>& phi,
+                std::vector<double>& destination_q,
+                bool apply_wgs,
+                bool apply_ags,
+                bool suppress_self_scattering) const
+{
+  if (ell >= NumOrders()) return;
+
+  const auto& wgs = wgs_blocks_[ell];
+  const auto& ags = ags_blocks_[ell];
+  const auto& self_scattering = self_scattering_[ell];
+
+  const size_t num_rows = gs_f_ - gs_i_ + 1;
+  for (size_t r = 0; r < num_rows; ++r)
+  {
+    const size_t g = gs_i_ + r;
+    const double sigma_self =
+      (apply_wgs and not suppress_self_scattering) ? self_scattering[r] : 0.0;
+
+    for (const size_t uk_map : uk_maps)
+    {
+      const double* phi_c = &phi[uk_map];
+
+      double value = sigma_self * phi_c[g];
+      if (apply_ags)
+        for (size_t k = ags.row_offsets[r]; k < ags.row_offsets[r + 1]; ++k)
+          value += ags.values[k] * phi_c[ags.col_ids[k]];
+      if (apply_wgs)
+        for (size_t k = wgs.row_offsets[r]; k < wgs.row_offsets[r + 1]; ++k)
+          value += wgs.values[k] * phi_c[wgs.col_ids[k]];
+
+      destination_q[uk_map + g] += value;
+    }
+  }//for r
+}
+
+}//namespace lbs
@@ -0,0 +1,53 @@
+#ifndef CHITECH_LBS_GROUPSET_SCATTERING_OPERATOR_H
+#define CHITECH_LBS_GROUPSET_SCATTERING_OPERATOR_H
+
+#include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
+
+#include <vector>
+
+namespace lbs
+{
+
+//###################################################################
+/**The transfer matrices of a cross section restricted to the rows of a
+ * groupset. Per Legendre order, the rows are stored as contiguous CSR
+ * blocks split into the within-groupset (WGS) and across-groupset (AGS)
+ * columns, hence no range checks are needed when applying these. The
+ * within-group (self) scattering is kept apart such that it can be
+ * suppressed.*/
+class GroupsetScatteringOperator
+{
+private:
+  struct CSRBlock
+  {
+    std::vector<size_t> row_offsets;
+    std::vector<size_t> col_ids;
+    std::vector<double> values;
+  };
+
+  size_t gs_i_ = 0;
+  size_t gs_f_ = 0;
+  std::vector<CSRBlock> wgs_blocks_;
+  std::vector<CSRBlock> ags_blocks_;
+  std::vector<std::vector<double>> self_scattering_;
+
+public:
+  GroupsetScatteringOperator(const chi_physics::MultiGroupXS& xs,
+                             size_t gs_i,
+                             size_t gs_f);
+
+  /**Returns the number of Legendre orders.*/
+  size_t NumOrders() const { return wgs_blocks_.size(); }
+
+  void AddScattering(unsigned int ell,
+                     const std::vector<size_t>& uk_maps,
+                     const std::vector<double>& phi,
+                     std::vector<double>& destination_q,
+                     bool apply_wgs,
+                     bool apply_ags,
+                     bool suppress_self_scattering) const;
+};
+
+}//namespace lbs
+
+#endif //CHITECH_LBS_GROUPSET_SCATTERING_OPERATOR_H
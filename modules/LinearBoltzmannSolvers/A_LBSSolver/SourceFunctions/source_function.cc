@@ -6,6 +6,8 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 
+#include <thread>
+
 namespace lbs
 {
 
@@ -35,174 +37,394 @@ void SourceFunction::operator()(LBSGroupset &groupset,
 {
   if (source_flags & NO_FLAGS_SET) return;
 
-  const size_t source_event_tag = lbs_solver_.GetSourceEventTag();
-  Chi::log.LogEvent(source_event_tag, chi::ChiLog::EventType::EVENT_BEGIN);
+  ChiProfileRegion("Set source");
+  const double start_time = MPI_Wtime();
 
-  apply_fixed_src_       = (source_flags & APPLY_FIXED_SOURCES);
-  apply_wgs_scatter_src_ = (source_flags & APPLY_WGS_SCATTER_SOURCES);
-  apply_ags_scatter_src_ = (source_flags & APPLY_AGS_SCATTER_SOURCES);
-  apply_wgs_fission_src_ = (source_flags & APPLY_WGS_FISSION_SOURCES);
-  apply_ags_fission_src_ = (source_flags & APPLY_AGS_FISSION_SOURCES);
-  suppress_wg_scatter_src_ = (source_flags & SUPPRESS_WG_SCATTER);
+  const auto state = MakeEvaluationState(groupset, source_flags);
 
-  //================================================== Get group setup
-  gs_i_ = static_cast<size_t>(groupset.groups_.front().id_);
-  gs_f_ = static_cast<size_t>(groupset.groups_.back().id_);
+  //================================================== Loop over local cells
+  // Cells are visited material by material, which keeps the cross sections
+  // of a material in cache. Each cell only contributes to its own unknowns.
+  const auto& batched_cell_ids =
+    lbs_solver_.GetCellMaterialTable().BatchedCellIDs();
+  const size_t num_local_cells = batched_cell_ids.size();
+#pragma omp parallel
+  {
+  CellScratch scratch;
 
-  first_grp_ = static_cast<size_t>(lbs_solver_.Groups().front().id_);
-  last_grp_ = static_cast<size_t>(lbs_solver_.Groups().back().id_);
+#pragma omp for schedule(static)
+  for (size_t c = 0; c < num_local_cells; ++c)
+    EvaluateCell(state, batched_cell_ids[c], phi_local, destination_q,
+                 scratch);
+  }//omp parallel
 
-  default_zero_src_.assign(lbs_solver_.Groups().size(), 0.0);
+  AddAdditionalSources(groupset, destination_q, phi_local, source_flags);
 
-  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
-  const auto& matid_to_src_map = lbs_solver_.GetMatID2IsoSrcMap();
+  lbs_solver_.GetSourceTiming().Add(MPI_Wtime() - start_time);
+}
 
-  const size_t num_moments = lbs_solver_.NumMoments();
-  const auto& ext_src_moments_local = lbs_solver_.ExtSrcMomentsLocal();
+//###################################################################
+/**Makes the state of a source evaluation for the given groupset and
+ * flags, compiling the scattering operators it needs up front, since the
+ * cells are evaluated concurrently.*/
+SourceFunction::EvaluationState
+SourceFunction::MakeEvaluationState(LBSGroupset& groupset,
+                                    SourceFlags source_flags)
+{
+  EvaluationState state;
+  state.apply_fixed_src       = (source_flags & APPLY_FIXED_SOURCES);
+  state.apply_wgs_scatter_src = (source_flags & APPLY_WGS_SCATTER_SOURCES);
+  state.apply_ags_scatter_src = (source_flags & APPLY_AGS_SCATTER_SOURCES);
+  state.apply_wgs_fission_src = (source_flags & APPLY_WGS_FISSION_SOURCES);
+  state.apply_ags_fission_src = (source_flags & APPLY_AGS_FISSION_SOURCES);
+  state.suppress_wg_scatter_src = (source_flags & SUPPRESS_WG_SCATTER);
 
-  const auto& m_to_ell_em_map =
-    groupset.quadrature_->GetMomentToHarmonicsIndexMap();
+  //================================================== Get group setup
+  const auto gs_i = static_cast<size_t>(groupset.groups_.front().id_);
+  const auto gs_f = static_cast<size_t>(groupset.groups_.back().id_);
+  state.gs_i = gs_i;
+  state.gs_f = gs_f;
+
+  state.first_grp = static_cast<size_t>(lbs_solver_.Groups().front().id_);
+  state.last_grp = static_cast<size_t>(lbs_solver_.Groups().back().id_);
+
+  const size_t num_groups = lbs_solver_.Groups().size();
+  state.default_zero_src.assign(num_groups, 0.0);
+
+  for (const auto& harmonic :
+       groupset.quadrature_->GetMomentToHarmonicsIndexMap())
+    state.moment_ell.push_back(harmonic.ell);
+
+  //================================================== Compile scattering
+  //                                                   operators
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  const size_t num_materials = cell_materials.NumMaterials();
+  state.material_scattering.assign(num_materials, nullptr);
+  state.material_production.assign(num_materials, nullptr);
+  for (size_t mat = 0; mat < num_materials; ++mat)
+  {
+    const auto& xs = cell_materials.XS(mat);
+    state.material_scattering[mat] = &GetScatteringOperator(xs, gs_i, gs_f);
+    state.material_production[mat] = &xs.Production();
+  }
 
-  //================================================== Loop over local cells
-  const auto& grid = lbs_solver_.Grid();
-  // Apply all nodal sources
-  for (const auto& cell : grid.local_cells)
+  if (lbs_solver_.Options().use_precursors)
+    DelayedEmissionSpectra(state.delayed_spectra);
+
+  const auto& src_amplitudes = lbs_solver_.VolumetricSourceAmplitudes();
+  if (not src_amplitudes.empty())
   {
-    auto& transport_view = cell_transport_views[cell.local_id_];
-    cell_volume_ = transport_view.Volume();
+    state.scaled_material_srcs.assign(num_materials * num_groups, 0.0);
+    for (size_t mat = 0; mat < num_materials; ++mat)
+      if (const auto& P0_src = cell_materials.Source(mat))
+        for (size_t g = 0; g < num_groups; ++g)
+          state.scaled_material_srcs[mat * num_groups + g] =
+            P0_src->source_value_g_[g] * src_amplitudes[g];
+  }
+
+  return state;
+}
 
-    //==================== Obtain xs
-    const auto& xs = transport_view.XS();
+//###################################################################
+/**Adds the source moments of a single cell, for the groups of the
+ * evaluated groupset, to the destination vector. Only the cell's own
+ * unknowns are written, hence distinct cells can be evaluated
+ * concurrently. The kernels read all the groups of a node and moment
+ * contiguously, hence the cell's unknowns are gathered to the scratch
+ * space when the flux moments are not group interleaved.*/
+void SourceFunction::EvaluateCell(const EvaluationState& state,
+                                  uint64_t cell_local_id,
+                                  const std::vector<double>& phi_local,
+                                  std::vector<double>& destination_q,
+                                  CellScratch& scratch) const
+{
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  const size_t mat = cell_materials.CellMaterialIndex(cell_local_id);
+  const auto& transport_view =
+    lbs_solver_.GetCellTransportViews()[cell_local_id];
+  const double cell_volume = transport_view.Volume();
+
+  const size_t gs_i = state.gs_i;
+  const size_t gs_f = state.gs_f;
+  const size_t num_groups = state.default_zero_src.size();
+  const size_t num_moments = state.moment_ell.size();
+  const auto& ext_src_moments_local = lbs_solver_.ExtSrcMomentsLocal();
+  const bool use_src_moments = lbs_solver_.Options().use_src_moments;
+  const bool use_precursors = lbs_solver_.Options().use_precursors;
+
+  //==================== Obtain xs
+  const auto& xs = cell_materials.XS(mat);
+  const auto& P0_src = cell_materials.Source(mat);
+
+  const auto& scattering = *state.material_scattering[mat];
+  const bool fissionable = xs.IsFissionable();
+  const auto& production = *state.material_production[mat];
+  const bool delayed_avail =
+    fissionable and use_precursors and xs.NumPrecursors() > 0;
+  const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+  const double* delayed_spectrum =
+    delayed_avail ? &state.delayed_spectra[mat * num_groups] : nullptr;
+  const double delayed_scale =
+    delayed_avail ? DelayedFissionCellScale(cell_volume) : 0.0;
+
+  const int num_nodes = transport_view.NumNodes();
+
+  //======================================== Cell unknowns
+  // Indexed by cell_address + (i * M + m) * G + g
+  const bool interleaved = transport_view.GroupsInterleaved();
+  const size_t cell_address = interleaved ? transport_view.MapDOF(0, 0, 0) : 0;
+  if (not interleaved)
+  {
+    transport_view.GatherUnknowns(phi_local, scratch.phi);
+    if (use_src_moments)
+      transport_view.GatherUnknowns(ext_src_moments_local,
+                                    scratch.src_moments);
+    scratch.q.assign(scratch.phi.size(), 0.0);
+  }
+  const auto& cell_phi = interleaved ? phi_local : scratch.phi;
+  const auto& cell_src_moments =
+    interleaved ? ext_src_moments_local : scratch.src_moments;
+  auto& cell_q = interleaved ? destination_q : scratch.q;
+
+  //======================================== Apply scattering sources
+  // Per Legendre order, over all the nodes and moments of the cell
+  auto& ell_uk_maps = scratch.ell_uk_maps;
+  if (state.apply_ags_scatter_src or state.apply_wgs_scatter_src)
+    for (unsigned int ell = 0; ell < scattering.NumOrders(); ++ell)
+    {
+      ell_uk_maps.clear();
+      for (int i = 0; i < num_nodes; ++i)
+        for (int m = 0; m < static_cast<int>(num_moments); ++m)
+          if (state.moment_ell[m] == ell)
+            ell_uk_maps.push_back(cell_address +
+                                  (i * num_moments + m) * num_groups);
+      if (ell_uk_maps.empty()) continue;
+
+      scattering.AddScattering(ell,
+                               ell_uk_maps,
+                               cell_phi,
+                               cell_q,
+                               state.apply_wgs_scatter_src,
+                               state.apply_ags_scatter_src,
+                               state.suppress_wg_scatter_src);
+    }
+
+  //======================================== Loop over nodes
+  for (int i = 0; i < num_nodes; ++i)
+  {
+    //=================================== Loop over moments
+    for (int m = 0; m < static_cast<int>(num_moments); ++m)
+    {
+      unsigned int ell = state.moment_ell[m];
 
-      std::shared_ptr<chi_physics::IsotropicMultiGrpSource> P0_src = nullptr;
-    if (matid_to_src_map.count(cell.material_id_) > 0)
-      P0_src = matid_to_src_map.at(cell.material_id_);
+      //unknown map
+      const size_t uk_map = cell_address + (i * num_moments + m) * num_groups;
 
-    const auto& S = xs.TransferMatrices();
-    const auto& F = xs.ProductionMatrix();
-    const auto& precursors = xs.Precursors();
-    const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+      const double* phi = &cell_phi[uk_map];
 
-    //======================================== Loop over nodes
-    const int num_nodes = transport_view.NumNodes();
-    for (int i = 0; i < num_nodes; ++i)
-    {
-      //=================================== Loop over moments
-      for (int m = 0; m < static_cast<int>(num_moments); ++m)
+      //==================== Declare moment src
+      const double* fixed_src_moments = state.default_zero_src.data();
+      if (P0_src and ell == 0)
+        fixed_src_moments = state.scaled_material_srcs.empty()
+                              ? P0_src->source_value_g_.data()
+                              : &state.scaled_material_srcs[mat * num_groups];
+
+      if (use_src_moments)
+        fixed_src_moments = &cell_src_moments[uk_map];
+
+      //==================== Prompt fission sources
+      // Added straight to the groupset groups of the destination
+      if (fissionable and ell == 0)
+      {
+        double* q = &cell_q[uk_map];
+        if (state.apply_ags_fission_src)
+        {
+          if (gs_i > state.first_grp)
+            production.Apply(phi, state.first_grp, gs_i - 1, gs_i, gs_f, q);
+          if (gs_f < state.last_grp)
+            production.Apply(phi, gs_f + 1, state.last_grp, gs_i, gs_f, q);
+        }
+
+        if (state.apply_wgs_fission_src)
+          production.Apply(phi, gs_i, gs_f, gs_i, gs_f, q);
+      }
+
+      //==================== Delayed fission rate
+      // The same for all the groups, only the spectrum differs
+      double delayed_rate = 0.0;
+      if (delayed_avail and ell == 0)
       {
-        unsigned int ell = m_to_ell_em_map[m].ell;
+        if (state.apply_ags_fission_src)
+          for (size_t gp = state.first_grp; gp <= state.last_grp; ++gp)
+            if (gp < gs_i or gp > gs_f)
+              delayed_rate += nu_delayed_sigma_f[gp] * phi[gp];
 
-        size_t uk_map = transport_view.MapDOF(i, m, 0); //unknown map
+        if (state.apply_wgs_fission_src)
+          for (size_t gp = gs_i; gp <= gs_f; ++gp)
+            delayed_rate += nu_delayed_sigma_f[gp] * phi[gp];
 
-        const double* phi = &phi_local[uk_map];
+        delayed_rate *= delayed_scale;
+      }
 
-        //==================== Declare moment src
-        if (P0_src and ell == 0)
-          fixed_src_moments_ = P0_src->source_value_g_.data();
-        else
-          fixed_src_moments_ = default_zero_src_.data();
+      //============================= Loop over groupset groups
+      for (size_t g = gs_i; g <= gs_f; ++g)
+      {
+        double rhs = 0.0;
 
-        if (lbs_solver_.Options().use_src_moments)
-          fixed_src_moments_ = &ext_src_moments_local[uk_map];
+        //============================== Apply fixed sources
+        if (state.apply_fixed_src)
+          rhs += this->AddSourceMoments(fixed_src_moments, g);
 
-        //============================= Loop over groupset groups
-        for (size_t g = gs_i_; g <= gs_f_; ++g)
-        {
-          g_ = g;
-
-          double rhs = 0.0;
-
-          //============================== Apply fixed sources
-          if (apply_fixed_src_) rhs += this->AddSourceMoments();
-
-          //============================== Apply scattering sources
-          if (ell < S.size())
-          {
-            const auto& S_ell = S[ell];
-            //==================== Add Across GroupSet Scattering (AGS)
-            if (apply_ags_scatter_src_)
-              for (const auto& [_, gp, sigma_sm] : S_ell.Row(g))
-                if (gp < gs_i_ or gp > gs_f_)
-                  rhs += sigma_sm * phi[gp];
-
-            //==================== Add Within GroupSet Scattering (WGS)
-            if (apply_wgs_scatter_src_)
-              for (const auto& [_, gp, sigma_sm] : S_ell.Row(g))
-                if (gp >= gs_i_ and gp <= gs_f_)
-                {
-                  if (suppress_wg_scatter_src_ and g_ == gp) continue;
-                  rhs += sigma_sm * phi[gp];
-                }
-          }
-
-          //============================== Apply fission sources
-          const bool fission_avail = ell == 0 and xs.IsFissionable();
-
-          if (fission_avail)
-          {
-            const auto& F_g = F[g];
-            if (apply_ags_fission_src_)
-              for (size_t gp = first_grp_; gp <= last_grp_; ++gp)
-                if (gp < gs_i_ or gp > gs_f_)
-                  rhs += F_g[gp] * phi[gp];
-
-            if (apply_wgs_fission_src_)
-              for (size_t gp = gs_i_; gp <= gs_f_; ++gp)
-                rhs += F_g[gp] * phi[gp];
-
-            if (lbs_solver_.Options().use_precursors)
-              rhs += this->AddDelayedFission(
-                precursors, nu_delayed_sigma_f, &phi_local[uk_map]);
-          }
-
-          //============================== Add to destination vector
-          destination_q[uk_map + g] += rhs;
-
-        }//for g
-      }//for m
-    }//for dof i
-  }//for cell
+        //============================== Apply delayed fission sources
+        if (delayed_avail and ell == 0)
+          rhs += delayed_spectrum[g] * delayed_rate;
 
-  AddAdditionalSources(groupset, destination_q, phi_local, source_flags);
+        //============================== Add to destination vector
+        cell_q[uk_map + g] += rhs;
+
+      }//for g
+    }//for m
+  }//for dof i
 
-  Chi::log.LogEvent(source_event_tag, chi::ChiLog::EventType::EVENT_END);
+  if (not interleaved)
+    transport_view.ScatterAddUnknowns(scratch.q, gs_i, gs_f, destination_q);
 }
 
-double SourceFunction::AddSourceMoments() const
+//###################################################################
+/**Same as operator(), except that the cells are not evaluated here but
+ * by the sweep chunks of the groupset, each on its first visit during the
+ * next sweep, see EvaluateDeferredCell. The cell's source moments are then
+ * computed while its flux moments and unknowns are in cache, and read back
+ * by the remaining angle sets, which saves the full-domain pass over the
+ * destination vector. The additional sources are applied right away, since
+ * the contributions are summed anyway. The destination and phi vectors must
+ * remain unchanged, but for the former's groupset span, until
+ * CompleteDeferredEvaluation is called after the sweep.*/
+void SourceFunction::DeferEvaluation(LBSGroupset& groupset,
+                                     std::vector<double>& destination_q,
+                                     const std::vector<double>& phi,
+                                     SourceFlags source_flags)
 {
-  return fixed_src_moments_[g_];
+  if (source_flags & NO_FLAGS_SET) return;
+
+  ChiProfileRegion("Set source");
+  const double start_time = MPI_Wtime();
+
+  CompleteDeferredEvaluation(groupset.id_);
+
+  const size_t num_local_cells = lbs_solver_.GetCellTransportViews().size();
+
+  auto& deferred = deferred_evaluations_[groupset.id_];
+  deferred.state = MakeEvaluationState(groupset, source_flags);
+  deferred.destination_q = &destination_q;
+  deferred.phi = &phi;
+  deferred.cell_status =
+    std::make_unique<std::atomic<uint8_t>[]>(num_local_cells);
+  deferred.num_local_cells = num_local_cells;
+  for (size_t c = 0; c < num_local_cells; ++c)
+    deferred.cell_status[c].store(PENDING, std::memory_order_relaxed);
+
+  AddAdditionalSources(groupset, destination_q, phi, source_flags);
+
+  lbs_solver_.GetSourceTiming().Add(MPI_Wtime() - start_time);
 }
 
+//###################################################################
+/**Evaluates the given cell of the deferred evaluation of the groupset,
+ * if any and unless already evaluated. Safe to call concurrently from the
+ * threads of a sweep, a thread finding the cell being evaluated by another
+ * waits for it.*/
+void SourceFunction::EvaluateDeferredCell(int groupset_id,
+                                          uint64_t cell_local_id) const
+{
+  const auto it = deferred_evaluations_.find(groupset_id);
+  if (it == deferred_evaluations_.end()) return;
+  const auto& deferred = it->second;
+
+  auto& status = deferred.cell_status[cell_local_id];
+  if (status.load(std::memory_order_acquire) == EVALUATED) return;
+
+  uint8_t expected = PENDING;
+  if (status.compare_exchange_strong(expected, IN_PROGRESS,
+                                     std::memory_order_acquire))
+  {
+    thread_local CellScratch scratch;
+    EvaluateCell(deferred.state, cell_local_id, *deferred.phi,
+                 *deferred.destination_q, scratch);
+    status.store(EVALUATED, std::memory_order_release);
+    return;
+  }
+
+  while (status.load(std::memory_order_acquire) != EVALUATED)
+    std::this_thread::yield();
+}
 
 //###################################################################
-/**Adds delayed particle precursor sources.*/
-double SourceFunction::
-  AddDelayedFission(const PrecursorList &precursors,
-                    const std::vector<double> &nu_delayed_sigma_f,
-                    const double *phi) const
+/**Evaluates the cells of the deferred evaluation of the groupset that
+ * were not visited, e.g., by a sweep without angle sets on this location,
+ * and drops the evaluation. Does nothing without a deferred evaluation.*/
+void SourceFunction::CompleteDeferredEvaluation(int groupset_id)
 {
-  double value = 0.0;
-  if (apply_ags_fission_src_)
-    for (size_t gp = first_grp_; gp <= last_grp_; ++gp)
-      if (gp < gs_i_ or gp > gs_f_)
-        for (const auto& precursor : precursors)
-          value += precursor.emission_spectrum[g_] *
-                   precursor.fractional_yield *
-                   nu_delayed_sigma_f[gp] * phi[gp];
-
-  if (apply_wgs_fission_src_)
-    for (size_t gp = gs_i_; gp <= gs_f_; ++gp)
-      for (const auto& precursor : precursors)
-        value += precursor.emission_spectrum[g_] *
-                 precursor.fractional_yield *
-                 nu_delayed_sigma_f[gp] * phi[gp];
-
-  return value;
+  const auto it = deferred_evaluations_.find(groupset_id);
+  if (it == deferred_evaluations_.end()) return;
+
+  const size_t num_local_cells = it->second.num_local_cells;
+#pragma omp parallel for schedule(static)
+  for (size_t c = 0; c < num_local_cells; ++c)
+    EvaluateDeferredCell(groupset_id, c);
+
+  deferred_evaluations_.erase(it);
+}
+
+//###################################################################
+/**Returns the scattering operator of the given cross section for the
+ * groupset spanning groups `gs_i` to `gs_f`, compiling it on first use.
+ * The operator is recompiled when the cross section has been modified in
+ * place since.*/
+const GroupsetScatteringOperator&
+SourceFunction::GetScatteringOperator(const chi_physics::MultiGroupXS& xs,
+                                      size_t gs_i,
+                                      size_t gs_f)
+{
+  const auto key = std::make_tuple(&xs, gs_i, gs_f);
+
+  auto it = scattering_operators_.find(key);
+  if (it != scattering_operators_.end() and
+      it->second.first != xs.Revision())
+  {
+    scattering_operators_.erase(it);
+    it = scattering_operators_.end();
+  }
+  if (it == scattering_operators_.end())
+    it = scattering_operators_.emplace(
+      key,
+      std::make_pair(xs.Revision(),
+                     GroupsetScatteringOperator(xs, gs_i, gs_f))).first;
+
+  return it->second.second;
+}
+
+double SourceFunction::AddSourceMoments(const double* fixed_src_moments,
+                                        size_t g) const
+{
+  return fixed_src_moments[g];
 }
 
 
 //###################################################################
-/**Adds point sources to the source moments.*/
+/**Computes, per material index of the cell material table and group (at
+ * `mat * G + g`), the fraction of the delayed fission rate emitted into the
+ * group. At steady state this is the yield weighted sum of the precursor
+ * emission spectra.*/
+void SourceFunction::DelayedEmissionSpectra(std::vector<double>& spectra) const
+{
+  spectra = lbs_solver_.GetPrecursorEngine().SteadyStateEmissionSpectra();
+}
+
+
+//###################################################################
+/**Adds point sources to the source moments, or their first-collision
+ * source when used.*/
 void SourceFunction::
   AddPointSources(LBSGroupset &groupset,
                   std::vector<double> &destination_q,
@@ -217,6 +439,13 @@ void SourceFunction::
   const auto gs_f = static_cast<size_t>(groupset.groups_.back().id_);
 
   //================================================== Apply point sources
+  if (lbs_solver_.Options().use_first_collision_source)
+  {
+    if (not lbs_solver_.Options().use_src_moments and apply_fixed_src)
+      AddFirstCollisionSource(groupset, destination_q);
+    return;
+  }
+
   if (not lbs_solver_.Options().use_src_moments and apply_fixed_src)
     for (const auto& point_source : lbs_solver_.PointSources())
     {
@@ -232,12 +461,110 @@ void SourceFunction::
         const int num_nodes = transport_view.NumNodes();
         for (int i = 0; i < num_nodes; ++i)
         {
-          const size_t uk_map = transport_view.MapDOF(i, /*moment=*/0, /*grp=*/0);
+          const size_t uk_map = transport_view.MapDOF(i, /*moment=*/0, gs_i);
           for (size_t g = gs_i; g <= gs_f; ++g)
-            destination_q[uk_map + g] += strength[g] * node_weights[i] * vol_w;
+            destination_q[uk_map + g - gs_i] +=
+              strength[g] * node_weights[i] * vol_w;
         }//for node i
       }//for cell
     }//for point source
 }
 
-}//namespace lbs
\ No newline at end of file
+//###################################################################
+/**Adds the first-collision source of the point sources, being the
+ * scattering and fission sources of their uncollided flux, to the groupset
+ * groups. Fission is at steady state, the delayed fission being emitted
+ * with the spectra of DelayedEmissionSpectra.*/
+void SourceFunction::AddFirstCollisionSource(LBSGroupset& groupset,
+                                             std::vector<double>& destination_q)
+{
+  const auto& uncollided_phi = lbs_solver_.UncollidedPhiLocal();
+  if (uncollided_phi.empty()) return;
+
+  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+
+  const auto gs_i = static_cast<size_t>(groupset.groups_.front().id_);
+  const auto gs_f = static_cast<size_t>(groupset.groups_.back().id_);
+  const size_t num_groups = lbs_solver_.Groups().size();
+  const size_t num_moments = lbs_solver_.NumMoments();
+  const bool use_precursors = lbs_solver_.Options().use_precursors;
+
+  const auto& m_to_ell_em_map =
+    groupset.quadrature_->GetMomentToHarmonicsIndexMap();
+
+  std::vector<double> delayed_spectra;
+  if (use_precursors) DelayedEmissionSpectra(delayed_spectra);
+
+  CellScratch scratch;
+  auto& ell_uk_maps = scratch.ell_uk_maps;
+  for (const auto& transport_view : cell_transport_views)
+  {
+    const size_t cell_local_id =
+      &transport_view - cell_transport_views.data();
+    const size_t mat_index = cell_materials.CellMaterialIndex(cell_local_id);
+    const auto& xs = cell_materials.XS(mat_index);
+    const auto& scattering = GetScatteringOperator(xs, gs_i, gs_f);
+    const int num_nodes = transport_view.NumNodes();
+
+    //=========================================== Cell unknowns
+    // Gathered as in EvaluateCell
+    const bool interleaved = transport_view.GroupsInterleaved();
+    const size_t cell_address =
+      interleaved ? transport_view.MapDOF(0, 0, 0) : 0;
+    if (not interleaved)
+    {
+      transport_view.GatherUnknowns(uncollided_phi, scratch.phi);
+      scratch.q.assign(scratch.phi.size(), 0.0);
+    }
+    const auto& cell_phi = interleaved ? uncollided_phi : scratch.phi;
+    auto& cell_q = interleaved ? destination_q : scratch.q;
+
+    //=========================================== Scattering
+    for (unsigned int ell = 0; ell < scattering.NumOrders(); ++ell)
+    {
+      ell_uk_maps.clear();
+      for (int i = 0; i < num_nodes; ++i)
+        for (size_t m = 0; m < num_moments; ++m)
+          if (m_to_ell_em_map[m].ell == ell)
+            ell_uk_maps.push_back(cell_address +
+                                  (i * num_moments + m) * num_groups);
+      if (ell_uk_maps.empty()) continue;
+
+      scattering.AddScattering(ell, ell_uk_maps, cell_phi, cell_q,
+                               /*apply_wgs=*/true, /*apply_ags=*/true,
+                               /*suppress_self_scattering=*/false);
+    }
+
+    //=========================================== Fission
+    if (xs.IsFissionable())
+    {
+      const bool delayed_avail = use_precursors and xs.NumPrecursors() > 0;
+      const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+      const double delayed_scale =
+        delayed_avail ? DelayedFissionCellScale(transport_view.Volume())
+                      : 0.0;
+      for (int i = 0; i < num_nodes; ++i)
+      {
+        const size_t uk_map = cell_address + i * num_moments * num_groups;
+        const double* phi = &cell_phi[uk_map];
+        double* q = &cell_q[uk_map];
+
+        xs.Production().Apply(phi, 0, num_groups - 1, gs_i, gs_f, q);
+
+        if (not delayed_avail) continue;
+        double delayed_rate = 0.0;
+        for (size_t gp = 0; gp < num_groups; ++gp)
+          delayed_rate += nu_delayed_sigma_f[gp] * phi[gp];
+        delayed_rate *= delayed_scale;
+        for (size_t g = gs_i; g <= gs_f; ++g)
+          q[g] += delayed_spectra[mat_index * num_groups + g] * delayed_rate;
+      }
+    }
+
+    if (not interleaved)
+      transport_view.ScatterAddUnknowns(scratch.q, gs_i, gs_f, destination_q);
+  }//for cell
+}
+
+}//namespace lbs
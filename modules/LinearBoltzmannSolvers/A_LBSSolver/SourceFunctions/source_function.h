@@ -5,7 +5,12 @@
 
 #include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
 
+#include "groupset_scattering_operator.h"
+
+#include <atomic>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 namespace lbs
@@ -19,25 +24,73 @@ class LBSGroupset;
  * simulations. It needs some customization for adjoint and transient.*/
 class SourceFunction
 {
+public:
+  /**The settings of a single source evaluation, and the tables shared by
+   * its cells. These are passed around, instead of being stored in the
+   * source function, such that the cells can be evaluated concurrently.*/
+  struct EvaluationState
+  {
+    bool apply_fixed_src         = false;
+    bool apply_wgs_scatter_src   = false;
+    bool apply_ags_scatter_src   = false;
+    bool apply_wgs_fission_src   = false;
+    bool apply_ags_fission_src   = false;
+    bool suppress_wg_scatter_src = false;
+
+    size_t gs_i      = 0;
+    size_t gs_f      = 0;
+    size_t first_grp = 0;
+    size_t last_grp  = 0;
+
+    /**The Legendre order of each moment.*/
+    std::vector<unsigned int> moment_ell;
+    /**Per material index of the cell material table.*/
+    std::vector<const GroupsetScatteringOperator*> material_scattering;
+    std::vector<const chi_physics::ProductionOperator*> material_production;
+    /**Per material index and group, see DelayedEmissionSpectra.*/
+    std::vector<double> delayed_spectra;
+    /**Per material index and group, the volumetric sources scaled by their
+     * amplitudes in time, if any.*/
+    std::vector<double> scaled_material_srcs;
+    std::vector<double> default_zero_src;
+  };
+
+  /**Scratch space of the cell evaluations, one per thread.*/
+  struct CellScratch
+  {
+    std::vector<size_t> ell_uk_maps;
+    /**The cell's flux moments, source moments and destination, gathered
+     * in the group interleaved order when the flux moment vectors are not
+     * in that order, see CellLBSView::GatherUnknowns.*/
+    std::vector<double> phi;
+    std::vector<double> src_moments;
+    std::vector<double> q;
+  };
+
+  /**A source evaluation deferred to the sweep, in which the sweep chunks
+   * evaluate each cell on its first visit, see EvaluateDeferredCell.*/
+  struct DeferredEvaluation
+  {
+    EvaluationState state;
+    std::vector<double>* destination_q = nullptr;
+    const std::vector<double>* phi = nullptr;
+    /**Per local cell, one of the CellStatus values.*/
+    std::unique_ptr<std::atomic<uint8_t>[]> cell_status;
+    size_t num_local_cells = 0;
+  };
+
 protected:
   const LBSSolver& lbs_solver_;
 
-  bool apply_fixed_src_         = false;
-  bool apply_wgs_scatter_src_   = false;
-  bool apply_ags_scatter_src_   = false;
-  bool apply_wgs_fission_src_   = false;
-  bool apply_ags_fission_src_   = false;
-  bool suppress_wg_scatter_src_ = false;
-
-  size_t gs_i_      = 0;
-  size_t gs_f_      = 0;
-  size_t first_grp_ = 0;
-  size_t last_grp_  = 0;
+  /**Scattering operators compiled on first use, per cross section and
+   * groupset range, with the cross section revision they were compiled
+   * from.*/
+  std::map<std::tuple<const chi_physics::MultiGroupXS*, size_t, size_t>,
+           std::pair<size_t, GroupsetScatteringOperator>> scattering_operators_;
 
-  double        cell_volume_       = 0.0;
-  size_t        g_                 = 0;
-  const double* fixed_src_moments_ = nullptr;
-  std::vector<double> default_zero_src_;
+  enum CellStatus : uint8_t {EVALUATED = 0, PENDING = 1, IN_PROGRESS = 2};
+  /**Deferred evaluations per groupset id.*/
+  std::map<int, DeferredEvaluation> deferred_evaluations_;
 
 public:
   explicit
@@ -49,13 +102,23 @@ public:
                           const std::vector<double>& phi,
                           SourceFlags source_flags);
 
-  virtual double AddSourceMoments() const;
+  void DeferEvaluation(LBSGroupset& groupset,
+                       std::vector<double>& destination_q,
+                       const std::vector<double>& phi,
+                       SourceFlags source_flags);
+  void EvaluateDeferredCell(int groupset_id, uint64_t cell_local_id) const;
+  void CompleteDeferredEvaluation(int groupset_id);
+
+  virtual double AddSourceMoments(const double* fixed_src_moments,
+                                  size_t g) const;
+
+  virtual void DelayedEmissionSpectra(std::vector<double>& spectra) const;
 
-  typedef std::vector<chi_physics::MultiGroupXS::Precursor> PrecursorList;
-  virtual
-  double AddDelayedFission(const PrecursorList& precursors,
-                           const std::vector<double>& nu_delayed_sigma_f,
-                           const double* phi) const;
+  /**Returns the factor applied to the delayed fission rate of a cell.*/
+  virtual double DelayedFissionCellScale(double /*cell_volume*/) const
+  {
+    return 1.0;
+  }
 
   virtual void AddAdditionalSources(LBSGroupset& groupset,
                                     std::vector<double>& destination_q,
@@ -65,10 +128,27 @@ public:
     AddPointSources(groupset, destination_q, phi, source_flags);
   }
 
+  const GroupsetScatteringOperator&
+  GetScatteringOperator(const chi_physics::MultiGroupXS& xs,
+                        size_t gs_i,
+                        size_t gs_f);
+
   void AddPointSources(LBSGroupset& groupset,
                        std::vector<double>& destination_q,
                        const std::vector<double>& phi,
                        SourceFlags source_flags);
+
+  void AddFirstCollisionSource(LBSGroupset& groupset,
+                               std::vector<double>& destination_q);
+
+protected:
+  EvaluationState MakeEvaluationState(LBSGroupset& groupset,
+                                      SourceFlags source_flags);
+  void EvaluateCell(const EvaluationState& state,
+                    uint64_t cell_local_id,
+                    const std::vector<double>& phi_local,
+                    std::vector<double>& destination_q,
+                    CellScratch& scratch) const;
 };
 
 }//namespace lbs
@@ -1,66 +1,118 @@
 #include "transient_source_function.h"
 
+#include "A_LBSSolver/lbs_solver.h"
+
+#include <algorithm>
+
 //###################################################################
-/**Constructor for the transient source function. The only difference
- * as compared to a steady source function is the treatment of delayed fission.*/
+/**Constructor for the transient source function. The time step and the
+ * theta of the time integration are referenced, such that the source
+ * follows their changes.*/
 lbs::TransientSourceFunction::
 TransientSourceFunction(const LBSSolver& lbs_solver,
-                        double &ref_dt, chi_math::SteppingMethod &method) :
+                        const double& ref_dt, const double& ref_theta) :
   SourceFunction(lbs_solver),
   dt_(ref_dt),
-  method_(method)
+  theta_(ref_theta)
 {}
 
 //###################################################################
-/**Customized delayed fission source..*/
-double lbs::TransientSourceFunction::
-AddDelayedFission(const PrecursorList &precursors,
-                  const std::vector<double> &nu_delayed_sigma_f,
-                  const double *phi) const
+/**Sets the flux moments at the start of the step, from which the time
+ * source of the groupsets without stored angular fluxes is expanded, and
+ * the precursor concentrations at the start of the step, whose decay
+ * during the step is emitted. Either may be nullptr, for no such source.*/
+void lbs::TransientSourceFunction::
+  SetPreviousState(const std::vector<double>* phi_prev,
+                   const std::vector<double>* precursors_prev)
 {
-  const auto& BackwardEuler = chi_math::SteppingMethod::IMPLICIT_EULER;
-  const auto& CrankNicolson = chi_math::SteppingMethod::CRANK_NICOLSON;
+  phi_prev_ = phi_prev;
+  precursors_prev_ = precursors_prev;
+}
 
-  double theta;
-  if      (method_ == BackwardEuler) theta = 1.0;
-  else if (method_ == CrankNicolson) theta = 0.5;
-  else                              theta = 0.7;
+//###################################################################
+/**Customized delayed fission source. The delayed neutrons emitted during
+ * the time step are those of the precursors produced during the step that
+ * decay within it.*/
+void lbs::TransientSourceFunction::
+  DelayedEmissionSpectra(std::vector<double>& spectra) const
+{
+  const double eff_dt = theta_ * dt_;
 
-  const double eff_dt = theta * dt_;
+  lbs_solver_.GetPrecursorEngine().ComputeTransientEmissionSpectra(eff_dt,
+                                                                   spectra);
+}
 
-  double value = 0.0;
-  if (apply_ags_fission_src_)
-    for (size_t gp = first_grp_; gp <= last_grp_; ++gp)
-      if (gp < gs_i_ or gp > gs_f_)
-        for (const auto& precursor : precursors)
-        {
-          const double coeff =
-            precursor.emission_spectrum[g_] *
-            precursor.decay_constant /
-            (1.0 + eff_dt * precursor.decay_constant);
+//###################################################################
+/**Adds, with the fixed sources, the sources of the state at the start of
+ * the step. The time source is the time absorption, the inverse velocity
+ * over theta times the time step, times the flux moments at the start of
+ * the step, in all the moments, since the sweeps expand the angular flux
+ * at the start of the step from these. The decay source is the isotropic
+ * emission of the precursors at the start of the step decaying during the
+ * step.*/
+void lbs::TransientSourceFunction::
+  AddAdditionalSources(LBSGroupset& groupset,
+                       std::vector<double>& destination_q,
+                       const std::vector<double>& phi,
+                       SourceFlags source_flags)
+{
+  SourceFunction::AddAdditionalSources(groupset, destination_q, phi,
+                                       source_flags);
 
-          value += coeff * eff_dt *
-                   precursor.fractional_yield *
-                   nu_delayed_sigma_f[gp] *
-                   phi[gp] /
-                   cell_volume_;
-        }
+  const bool apply_fixed_src = (source_flags & APPLY_FIXED_SOURCES);
+  const bool add_time_src = apply_fixed_src and phi_prev_ != nullptr;
+  const bool add_decay_src = apply_fixed_src and precursors_prev_ and
+                             lbs_solver_.Options().use_precursors;
+  if (not add_time_src and not add_decay_src) return;
 
-  if (apply_wgs_fission_src_)
-    for (size_t gp = gs_i_; gp <= gs_f_; ++gp)
-      for (const auto& precursor : precursors)
-      {
-        const double coeff =
-          precursor.emission_spectrum[g_] *
-          precursor.decay_constant /
-          (1.0 + eff_dt * precursor.decay_constant);
+  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  const auto& precursor_engine = lbs_solver_.GetPrecursorEngine();
+
+  const auto gs_i = static_cast<size_t>(groupset.groups_.front().id_);
+  const auto gs_f = static_cast<size_t>(groupset.groups_.back().id_);
+  const auto num_moments = static_cast<int>(lbs_solver_.NumMoments());
+  const size_t J = lbs_solver_.GetMaxPrecursorsPerMaterial();
+  const double eff_dt = theta_ * dt_;
+  const double inv_theta_dt = 1.0 / eff_dt;
+
+  std::vector<double> emission(lbs_solver_.NumGroups(), 0.0);
+  for (const auto& transport_view : cell_transport_views)
+  {
+    const size_t cell_local_id =
+      &transport_view - cell_transport_views.data();
+    const size_t mat_index = cell_materials.CellMaterialIndex(cell_local_id);
+    const int num_nodes = transport_view.NumNodes();
 
-        value += coeff * eff_dt *
-                 precursor.fractional_yield *
-                 nu_delayed_sigma_f[gp] *
-                 phi[gp] /
-                 cell_volume_;
-      }
+    //=========================================== Time source
+    if (add_time_src)
+    {
+      const auto& inv_velocity = cell_materials.XS(mat_index).InverseVelocity();
+      const auto& phi_prev = *phi_prev_;
+      for (int i = 0; i < num_nodes; ++i)
+        for (int m = 0; m < num_moments; ++m)
+        {
+          const size_t uk_map = transport_view.MapDOF(i, m, gs_i);
+          for (size_t g = gs_i; g <= gs_f; ++g)
+            destination_q[uk_map + g - gs_i] +=
+              inv_velocity[g] * inv_theta_dt * phi_prev[uk_map + g - gs_i];
+        }//for node i
+    }
+
+    //=========================================== Decay source
+    if (add_decay_src and precursor_engine.NumPrecursors(mat_index) > 0)
+    {
+      std::fill(emission.begin(), emission.end(), 0.0);
+      precursor_engine.AddDecayEmission(mat_index,
+                                        &(*precursors_prev_)[cell_local_id * J],
+                                        eff_dt, gs_i, gs_f, emission.data());
 
-  return value;
-}
\ No newline at end of file
+      for (int i = 0; i < num_nodes; ++i)
+      {
+        const size_t uk_map = transport_view.MapDOF(i, /*moment=*/0, gs_i);
+        for (size_t g = gs_i; g <= gs_f; ++g)
+          destination_q[uk_map + g - gs_i] += emission[g];
+      }//for node i
+    }
+  }//for cell
+}
@@ -3,26 +3,37 @@
 
 #include "source_function.h"
 
-#include "math/chi_math_time_stepping.h"
-
 namespace lbs
 {
 
-/**A transient source function needs to adjust the AddDelayedFission
- * routine to properly fit with the current timestepping method and timestep.*/
+/**A transient source function needs to adjust the delayed fission
+ * source to properly fit with the current timestepping method and timestep.
+ * It also adds the sources of the state at the start of the time step, see
+ * SetPreviousState.*/
 class TransientSourceFunction : public SourceFunction
 {
 private:
-  double& dt_;
-  chi_math::SteppingMethod& method_;
+  const double& dt_;
+  const double& theta_;
+  /**Flux moments and precursor concentrations at the start of the step,
+   * or nullptr.*/
+  const std::vector<double>* phi_prev_ = nullptr;
+  const std::vector<double>* precursors_prev_ = nullptr;
+
 public:
   TransientSourceFunction(const LBSSolver& lbs_solver,
-                          double& ref_dt,
-                          chi_math::SteppingMethod& method);
+                          const double& ref_dt,
+                          const double& ref_theta);
+
+  void SetPreviousState(const std::vector<double>* phi_prev,
+                        const std::vector<double>* precursors_prev);
+
+  void DelayedEmissionSpectra(std::vector<double>& spectra) const override;
 
-  double AddDelayedFission(const PrecursorList& precursors,
-                           const std::vector<double>& nu_delayed_sigma_f,
-                           const double* phi) const override;
+  void AddAdditionalSources(LBSGroupset& groupset,
+                            std::vector<double>& destination_q,
+                            const std::vector<double>& phi,
+                            SourceFlags source_flags) override;
 };
 
 }//namespace lbs
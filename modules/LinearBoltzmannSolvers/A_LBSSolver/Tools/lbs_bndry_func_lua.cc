@@ -6,95 +6,98 @@
 #include "chi_log.h"
 #include "console/chi_console.h"
 
-//###################################################################
-/**Customized boundary function by calling a lua routine.*/
-std::vector<double> lbs::BoundaryFunctionToLua::
-Evaluate(size_t cell_global_id,
-         int    cell_material_id,
-         unsigned int face_index,
-         unsigned int face_node_index,
-         const chi_mesh::Vector3& face_node_location,
-         const chi_mesh::Vector3& face_node_normal,
-         const std::vector<int>& quadrature_angle_indices,
-         const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
-         const std::vector<std::pair<double, double>>& quadrature_phi_theta_angles,
-         const std::vector<int>& group_indices,
-         double time)
+#include <functional>
+
+namespace
 {
-  const std::string fname = "LinearBoltzmann::BoundaryFunctionToLua";
-  //======================================== Utility lambdas
-  auto PushVector3AsTable = [](lua_State* L, const chi_mesh::Vector3& vec)
-  {
-    lua_newtable(L);
 
-    lua_pushstring(L, "x");
-    lua_pushnumber(L, vec.x);
-    lua_settable(L, -3);
+//======================================== Utility functions
+void PushVector3AsTable(lua_State* L, const chi_mesh::Vector3& vec)
+{
+  lua_newtable(L);
 
-    lua_pushstring(L, "y");
-    lua_pushnumber(L, vec.y);
-    lua_settable(L, -3);
+  lua_pushstring(L, "x");
+  lua_pushnumber(L, vec.x);
+  lua_settable(L, -3);
 
-    lua_pushstring(L, "z");
-    lua_pushnumber(L, vec.z);
-    lua_settable(L, -3);
-  };
+  lua_pushstring(L, "y");
+  lua_pushnumber(L, vec.y);
+  lua_settable(L, -3);
 
-  auto PushVecIntAsTable = [](lua_State* L, const std::vector<int>& vec)
-  {
-    lua_newtable(L);
+  lua_pushstring(L, "z");
+  lua_pushnumber(L, vec.z);
+  lua_settable(L, -3);
+}
 
-    for (int i=0; i<static_cast<int>(vec.size()); ++i)
-    {
-      lua_pushinteger(L, i+1);
-      lua_pushinteger(L, static_cast<lua_Integer>(vec[i]));
-      lua_settable(L, -3);
-    }
-  };
+template<typename T>
+void PushVecIntAsTable(lua_State* L, const std::vector<T>& vec)
+{
+  lua_newtable(L);
 
-  auto PushPhiThetaPairTable = [](lua_State* L, const std::pair<double, double>& phi_theta)
+  for (int i=0; i<static_cast<int>(vec.size()); ++i)
   {
-    lua_newtable(L);
-
-    lua_pushstring(L, "phi");
-    lua_pushnumber(L, phi_theta.first);
+    lua_pushinteger(L, i+1);
+    lua_pushinteger(L, static_cast<lua_Integer>(vec[i]));
     lua_settable(L, -3);
+  }
+}
 
-    lua_pushstring(L, "theta");
-    lua_pushnumber(L, phi_theta.second);
+void PushVecVector3AsTable(lua_State* L,
+                           const std::vector<chi_mesh::Vector3>& vecs)
+{
+  lua_newtable(L);
+  int n=0;
+  for (auto& vec : vecs)
+  {
+    lua_pushinteger(L, n+1);
+    PushVector3AsTable(L, vec);
     lua_settable(L, -3);
-  };
+    ++n;
+  }
+}
 
+void PushPhiThetaPairTable(lua_State* L,
+                           const std::pair<double, double>& phi_theta)
+{
+  lua_newtable(L);
+
+  lua_pushstring(L, "phi");
+  lua_pushnumber(L, phi_theta.first);
+  lua_settable(L, -3);
+
+  lua_pushstring(L, "theta");
+  lua_pushnumber(L, phi_theta.second);
+  lua_settable(L, -3);
+}
+
+/**Calls the lua function with the node arguments, pushed by the given
+ * function, followed by the quadrature, the groups and the time, and
+ * returns the table it returns.*/
+std::vector<double> CallLuaBoundaryFunction(
+  const std::string& fname,
+  const std::string& lua_function_name,
+  const std::function<void(lua_State*)>& push_node_args,
+  const std::vector<int>& quadrature_angle_indices,
+  const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+  const std::vector<std::pair<double, double>>& quadrature_phi_theta_angles,
+  const std::vector<int>& group_indices,
+  double time)
+{
   //======================================== Get lua function
   lua_State* L = Chi::console.GetConsoleState();
-  lua_getglobal(L, m_lua_function_name.c_str());
+  lua_getglobal(L, lua_function_name.c_str());
 
   //======================================== Error check lua function
   if (not lua_isfunction(L, -1))
     throw std::logic_error(fname + " attempted to access lua-function, " +
-                           m_lua_function_name + ", but it seems the function"
-                                                 " could not be retrieved.");
+                           lua_function_name + ", but it seems the function"
+                                               " could not be retrieved.");
 
   //======================================== Push arguments
-  lua_pushinteger(L, static_cast<lua_Integer>(cell_global_id));
-  lua_pushinteger(L, static_cast<lua_Integer>(cell_material_id));
-
-  PushVector3AsTable(L, face_node_location);
-  PushVector3AsTable(L, face_node_normal);
+  push_node_args(L);
 
   PushVecIntAsTable(L, quadrature_angle_indices);
-
-  {
-    lua_newtable(L);
-    int n=0;
-    for (auto& omega : quadrature_angle_vectors)
-    {
-      lua_pushinteger(L, n+1);
-      PushVector3AsTable(L, omega);
-      lua_settable(L, -3);
-      ++n;
-    }
-  }//push omegas
+  PushVecVector3AsTable(L, quadrature_angle_vectors);
 
   {
     lua_newtable(L);
@@ -129,10 +132,50 @@ Evaluate(size_t cell_global_id,
   }
   else
     throw std::logic_error(fname + " attempted to call lua-function, " +
-                           m_lua_function_name + ", but the call failed.");
+                           lua_function_name + ", but the call failed.");
 
   lua_pop(L,1); //pop the table, or error code
 
+  return psi;
+}
+
+}//namespace
+
+//###################################################################
+/**Customized boundary function by calling a lua routine.*/
+std::vector<double> lbs::BoundaryFunctionToLua::
+Evaluate(size_t cell_global_id,
+         int    cell_material_id,
+         unsigned int face_index,
+         unsigned int face_node_index,
+         const chi_mesh::Vector3& face_node_location,
+         const chi_mesh::Vector3& face_node_normal,
+         const std::vector<int>& quadrature_angle_indices,
+         const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+         const std::vector<std::pair<double, double>>& quadrature_phi_theta_angles,
+         const std::vector<int>& group_indices,
+         double time)
+{
+  const std::string fname = "LinearBoltzmann::BoundaryFunctionToLua";
+
+  auto push_node_args = [&](lua_State* L)
+  {
+    lua_pushinteger(L, static_cast<lua_Integer>(cell_global_id));
+    lua_pushinteger(L, static_cast<lua_Integer>(cell_material_id));
+
+    PushVector3AsTable(L, face_node_location);
+    PushVector3AsTable(L, face_node_normal);
+  };
+
+  const auto psi = CallLuaBoundaryFunction(fname,
+                                           m_lua_function_name,
+                                           push_node_args,
+                                           quadrature_angle_indices,
+                                           quadrature_angle_vectors,
+                                           quadrature_phi_theta_angles,
+                                           group_indices,
+                                           time);
+
   //======================================== Error check psi vector
   size_t num_angles = quadrature_angle_indices.size();
   size_t num_groups = group_indices.size();
@@ -145,4 +188,61 @@ Evaluate(size_t cell_global_id,
                            std::to_string(psi.size()) + ".");
 
   return psi;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Calls the lua routine once for all the face nodes when batched, with
+ * tables of the cell global ids, material ids, locations and normals of
+ * the nodes instead of single values. The node loop then happens in lua,
+ * avoiding a call and the pushing of the quadrature per node.*/
+std::vector<double> lbs::BoundaryFunctionToLua::
+EvaluateBatch(
+  const chi_mesh::sweep_management::BoundaryFaceNodes& face_nodes,
+  const std::vector<int>& quadrature_angle_indices,
+  const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+  const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+  const std::vector<int>& group_indices,
+  double time)
+{
+  if (not m_batched)
+    return BoundaryFunction::EvaluateBatch(face_nodes,
+                                           quadrature_angle_indices,
+                                           quadrature_angle_vectors,
+                                           quadrature_phi_theta_angles,
+                                           group_indices,
+                                           time);
+
+  const std::string fname = "LinearBoltzmann::BoundaryFunctionToLua";
+
+  auto push_node_args = [&face_nodes](lua_State* L)
+  {
+    PushVecIntAsTable(L, face_nodes.cell_global_ids);
+    PushVecIntAsTable(L, face_nodes.cell_material_ids);
+
+    PushVecVector3AsTable(L, face_nodes.locations);
+    PushVecVector3AsTable(L, face_nodes.normals);
+  };
+
+  const auto psi = CallLuaBoundaryFunction(fname,
+                                           m_lua_function_name,
+                                           push_node_args,
+                                           quadrature_angle_indices,
+                                           quadrature_angle_vectors,
+                                           quadrature_phi_theta_angles,
+                                           group_indices,
+                                           time);
+
+  //======================================== Error check psi vector
+  const size_t size = face_nodes.Size() * quadrature_angle_indices.size() *
+                      group_indices.size();
+
+  if (psi.size() != size)
+    throw std::logic_error(fname + " the returned vector from lua-function, " +
+                           m_lua_function_name + ", did not produce the "
+                           "required size vector. The size must equal "
+                           "num_face_nodes*num_angles*num_groups, " +
+                           std::to_string(size) + ", but the size is " +
+                           std::to_string(psi.size()) + ".");
+
+  return psi;
+}
@@ -9,14 +9,20 @@
 namespace lbs
 {
 
+/**Boundary function calling a lua routine, either once per face node or,
+ * batched, once for all the face nodes of a boundary with tables of them,
+ * returning the flat psi of all the nodes.*/
 class BoundaryFunctionToLua : public chi_mesh::sweep_management::BoundaryFunction
 {
 private:
   const std::string m_lua_function_name;
+  const bool m_batched;
 public:
   explicit
-  BoundaryFunctionToLua(std::string  lua_function_name) :
-    m_lua_function_name(std::move(lua_function_name)) {}
+  BoundaryFunctionToLua(std::string  lua_function_name,
+                        bool batched = false) :
+    m_lua_function_name(std::move(lua_function_name)),
+    m_batched(batched) {}
 
   std::vector<double> Evaluate(
     size_t        cell_global_id,
@@ -30,6 +36,14 @@ public:
     const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
     const std::vector<int>& group_indices,
     double time) override;
+
+  std::vector<double> EvaluateBatch(
+    const chi_mesh::sweep_management::BoundaryFaceNodes& face_nodes,
+    const std::vector<int>& quadrature_angle_indices,
+    const std::vector<chi_mesh::Vector3>& quadrature_angle_vectors,
+    const std::vector<std::pair<double,double>>& quadrature_phi_theta_angles,
+    const std::vector<int>& group_indices,
+    double time) override;
 };
 
 }//namespace LinearBoltzmann
@@ -0,0 +1,38 @@
+#include "lbs_bndry_func_registry.h"
+
+#include <map>
+
+namespace lbs
+{
+
+namespace
+{
+/**The registered boundary functions by name.*/
+std::map<std::string, BoundaryFunctionPtr>& BoundaryFunctionRegistry()
+{
+  static std::map<std::string, BoundaryFunctionPtr> registry;
+  return registry;
+}
+} // namespace
+
+//###################################################################
+/**Registers a C++ boundary function under a name.*/
+void RegisterBoundaryFunction(const std::string& name,
+                              BoundaryFunctionPtr function)
+{
+  auto& registry = BoundaryFunctionRegistry();
+  if (function) registry[name] = std::move(function);
+  else
+    registry.erase(name);
+}
+
+//###################################################################
+/**Returns the boundary function registered under a name.*/
+BoundaryFunctionPtr GetRegisteredBoundaryFunction(const std::string& name)
+{
+  const auto& registry = BoundaryFunctionRegistry();
+  const auto it = registry.find(name);
+  return it != registry.end() ? it->second : nullptr;
+}
+
+}//namespace lbs
@@ -0,0 +1,29 @@
+#ifndef CHITECH_LBS_BNDRY_FUNC_REGISTRY_H
+#define CHITECH_LBS_BNDRY_FUNC_REGISTRY_H
+
+#include "mesh/SweepUtilities/SweepBoundary/sweep_boundaries.h"
+
+#include <memory>
+#include <string>
+
+namespace lbs
+{
+
+typedef std::shared_ptr<chi_mesh::sweep_management::BoundaryFunction>
+  BoundaryFunctionPtr;
+
+/**Registers a C++ boundary function, e.g., a
+ * chi_mesh::sweep_management::BoundaryFunctor, under a name. Boundaries of
+ * type `"incident_anisotropic_heterogeneous"` with that `function_name`
+ * evaluate it instead of a lua function. Registering a null function
+ * removes the name.*/
+void RegisterBoundaryFunction(const std::string& name,
+                              BoundaryFunctionPtr function);
+
+/**Returns the boundary function registered under a name, or a null
+ * pointer when there is none.*/
+BoundaryFunctionPtr GetRegisteredBoundaryFunction(const std::string& name);
+
+}//namespace lbs
+
+#endif //CHITECH_LBS_BNDRY_FUNC_REGISTRY_H
@@ -0,0 +1,299 @@
+#include "lbs_cell_data_io.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <cstring>
+
+namespace lbs
+{
+
+namespace
+{
+//File layout constants
+const MPI_Offset HEADER_SIZE      = 512;
+const size_t     HEADER_TEXT_SIZE = 448;
+const size_t     MAX_ATTRIBUTES   = 5;
+const MPI_Offset INDEX_ENTRY_SIZE = 2 * sizeof(uint64_t);
+
+/**Binary part of the header, following the text.*/
+struct HeaderValues
+{
+  uint64_t num_global_cells = 0;
+  uint64_t total_values = 0;
+  uint64_t num_attributes = 0;
+  uint64_t attributes[MAX_ATTRIBUTES] = {0};
+};
+
+/**Returns the indices that sort the given ids.*/
+std::vector<size_t> SortedOrder(const std::vector<uint64_t>& ids)
+{
+  std::vector<size_t> order(ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+  return order;
+}
+
+/**Sets a view of the index entries of the given, sorted and unique,
+ * global ids.*/
+bool SetIndexView(MPI_File file,
+                  const std::vector<uint64_t>& sorted_global_ids,
+                  MPI_Datatype& index_type)
+{
+  std::vector<MPI_Aint> displacements;
+  displacements.reserve(sorted_global_ids.size());
+  for (uint64_t gid : sorted_global_ids)
+    displacements.push_back(static_cast<MPI_Aint>(gid * INDEX_ENTRY_SIZE));
+
+  MPI_Type_create_hindexed_block(static_cast<int>(displacements.size()),
+                                 2, displacements.data(),
+                                 MPI_UINT64_T, &index_type);
+  MPI_Type_commit(&index_type);
+
+  return MPI_File_set_view(file, HEADER_SIZE, MPI_UINT64_T, index_type,
+                           "native", MPI_INFO_NULL) == MPI_SUCCESS;
+}
+}//namespace
+
+//###################################################################
+/**Collectively writes per-cell blocks to a single file.*/
+bool WriteCellDataCollective(const std::string& file_name,
+                             const std::string& description,
+                             const std::vector<uint64_t>& attributes,
+                             const uint64_t num_global_cells,
+                             const CellDataBlocks& blocks)
+{
+  ChiInvalidArgumentIf(attributes.size() > MAX_ATTRIBUTES,
+                       "At most " + std::to_string(MAX_ATTRIBUTES) +
+                       " attributes can be stored.");
+  ChiInvalidArgumentIf(blocks.values.size() > INT_MAX,
+                       "Too many values on a single location.");
+
+  //======================================== Determine this location's
+  //                                         segment of the values
+  const uint64_t num_local_values = blocks.values.size();
+  uint64_t local_value_offset = 0;
+  uint64_t total_values = 0;
+  MPI_Exscan(&num_local_values, &local_value_offset, 1,
+             MPI_UINT64_T, MPI_SUM, Chi::mpi.comm);
+  if (Chi::mpi.location_id == 0) local_value_offset = 0;
+  MPI_Allreduce(&num_local_values, &total_values, 1,
+                MPI_UINT64_T, MPI_SUM, Chi::mpi.comm);
+
+  //======================================== Open the file
+  MPI_File file;
+  if (MPI_File_open(Chi::mpi.comm, file_name.c_str(),
+                    MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                    MPI_INFO_NULL, &file) != MPI_SUCCESS)
+    return false;
+  MPI_File_set_size(file, 0);
+
+  bool succeeded = true;
+
+  //======================================== Write the header
+  if (Chi::mpi.location_id == 0)
+  {
+    std::vector<char> header_bytes(HEADER_SIZE, 0);
+    memset(header_bytes.data(), '-', HEADER_TEXT_SIZE);
+    strncpy(header_bytes.data(), description.c_str(),
+            std::min(description.size(), HEADER_TEXT_SIZE - 1));
+    header_bytes[HEADER_TEXT_SIZE - 1] = '\0';
+
+    HeaderValues header_values;
+    header_values.num_global_cells = num_global_cells;
+    header_values.total_values = total_values;
+    header_values.num_attributes = attributes.size();
+    std::copy(attributes.begin(), attributes.end(), header_values.attributes);
+    memcpy(header_bytes.data() + HEADER_TEXT_SIZE,
+           &header_values, sizeof(HeaderValues));
+
+    succeeded &= MPI_File_write_at(file, 0, header_bytes.data(),
+                                   static_cast<int>(HEADER_SIZE), MPI_CHAR,
+                                   MPI_STATUS_IGNORE) == MPI_SUCCESS;
+  }
+
+  //======================================== Write the index entries
+  const auto order = SortedOrder(blocks.cell_global_ids);
+
+  std::vector<uint64_t> sorted_global_ids;
+  std::vector<uint64_t> index_entries;
+  sorted_global_ids.reserve(order.size());
+  index_entries.reserve(2 * order.size());
+  for (size_t c : order)
+  {
+    const uint64_t gid = blocks.cell_global_ids[c];
+    ChiLogicalErrorIf(gid >= num_global_cells,
+                      "Cell global id " + std::to_string(gid) +
+                      " exceeds the number of global cells.");
+
+    sorted_global_ids.push_back(gid);
+    index_entries.push_back(local_value_offset + blocks.offsets[c]);
+    index_entries.push_back(blocks.offsets[c + 1] - blocks.offsets[c]);
+  }
+
+  MPI_Datatype index_type;
+  succeeded &= SetIndexView(file, sorted_global_ids, index_type);
+  succeeded &= MPI_File_write_all(file, index_entries.data(),
+                                  static_cast<int>(index_entries.size()),
+                                  MPI_UINT64_T,
+                                  MPI_STATUS_IGNORE) == MPI_SUCCESS;
+  MPI_Type_free(&index_type);
+
+  //======================================== Write the values
+  MPI_File_set_view(file, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+
+  const MPI_Offset data_start =
+    HEADER_SIZE + static_cast<MPI_Offset>(num_global_cells) * INDEX_ENTRY_SIZE;
+  const MPI_Offset local_start =
+    data_start +
+    static_cast<MPI_Offset>(local_value_offset * sizeof(double));
+
+  succeeded &= MPI_File_write_at_all(file, local_start, blocks.values.data(),
+                                     static_cast<int>(num_local_values),
+                                     MPI_DOUBLE,
+                                     MPI_STATUS_IGNORE) == MPI_SUCCESS;
+
+  MPI_File_close(&file);
+
+  return succeeded;
+}
+
+//###################################################################
+/**Collectively reads per-cell blocks from a single file.*/
+bool ReadCellDataCollective(const std::string& file_name,
+                            const std::vector<uint64_t>& attributes,
+                            const uint64_t num_global_cells,
+                            const std::vector<uint64_t>& cell_global_ids,
+                            CellDataBlocks& blocks)
+{
+  blocks = CellDataBlocks();
+
+  //======================================== Open the file
+  MPI_File file;
+  if (MPI_File_open(Chi::mpi.comm, file_name.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &file) != MPI_SUCCESS)
+    return false;
+
+  //======================================== Read and check the header.
+  //                                         All locations reach the same
+  //                                         conclusion.
+  std::vector<char> header_bytes(HEADER_SIZE, 0);
+  bool succeeded = MPI_File_read_at_all(file, 0, header_bytes.data(),
+                                        static_cast<int>(HEADER_SIZE),
+                                        MPI_CHAR,
+                                        MPI_STATUS_IGNORE) == MPI_SUCCESS;
+
+  HeaderValues header_values;
+  memcpy(&header_values, header_bytes.data() + HEADER_TEXT_SIZE,
+         sizeof(HeaderValues));
+
+  bool compatible = header_values.num_global_cells == num_global_cells and
+                    header_values.num_attributes == attributes.size();
+  for (size_t a = 0; compatible and a < attributes.size(); ++a)
+    compatible = header_values.attributes[a] == attributes[a];
+
+  if (not (succeeded and compatible))
+  {
+    MPI_File_close(&file);
+    return false;
+  }
+
+  //======================================== Read the index entries of the
+  //                                         unique requested cells, since
+  //                                         views may not overlap
+  std::vector<uint64_t> unique_global_ids = cell_global_ids;
+  std::sort(unique_global_ids.begin(), unique_global_ids.end());
+  unique_global_ids.erase(std::unique(unique_global_ids.begin(),
+                                      unique_global_ids.end()),
+                          unique_global_ids.end());
+  ChiLogicalErrorIf(not unique_global_ids.empty() and
+                    unique_global_ids.back() >= num_global_cells,
+                    "Cell global id " +
+                    std::to_string(unique_global_ids.back()) +
+                    " exceeds the number of global cells.");
+
+  const size_t num_unique = unique_global_ids.size();
+  std::vector<uint64_t> index_entries(2 * num_unique, 0);
+
+  MPI_Datatype index_type;
+  succeeded &= SetIndexView(file, unique_global_ids, index_type);
+  succeeded &= MPI_File_read_all(file, index_entries.data(),
+                                 static_cast<int>(index_entries.size()),
+                                 MPI_UINT64_T,
+                                 MPI_STATUS_IGNORE) == MPI_SUCCESS;
+  MPI_Type_free(&index_type);
+
+  //======================================== Make the values view, which
+  //                                         must be ordered by file offset
+  std::vector<uint64_t> value_offsets(num_unique, 0);
+  std::vector<uint64_t> value_sizes(num_unique, 0);
+  for (size_t k = 0; k < num_unique; ++k)
+  {
+    value_offsets[k] = index_entries[2 * k];
+    value_sizes[k] = index_entries[2 * k + 1];
+  }
+
+  const auto read_order = SortedOrder(value_offsets);
+
+  const MPI_Offset data_start =
+    HEADER_SIZE + static_cast<MPI_Offset>(num_global_cells) * INDEX_ENTRY_SIZE;
+
+  std::vector<int> block_lengths;
+  std::vector<MPI_Aint> displacements;
+  std::vector<uint64_t> read_positions(num_unique, 0);
+  uint64_t num_values = 0;
+  for (size_t k : read_order)
+  {
+    read_positions[k] = num_values;
+    if (value_sizes[k] == 0) continue;
+    block_lengths.push_back(static_cast<int>(value_sizes[k]));
+    displacements.push_back(
+      static_cast<MPI_Aint>(data_start + value_offsets[k] * sizeof(double)));
+    num_values += value_sizes[k];
+  }
+  ChiLogicalErrorIf(succeeded and num_values > INT_MAX,
+                    "Too many values requested on a single location.");
+  if (not succeeded) num_values = 0;
+
+  MPI_Datatype values_type;
+  MPI_Type_create_hindexed(static_cast<int>(block_lengths.size()),
+                           block_lengths.data(), displacements.data(),
+                           MPI_DOUBLE, &values_type);
+  MPI_Type_commit(&values_type);
+
+  std::vector<double> read_values(num_values, 0.0);
+  succeeded &= MPI_File_set_view(file, 0, MPI_DOUBLE, values_type,
+                                 "native", MPI_INFO_NULL) == MPI_SUCCESS;
+  succeeded &= MPI_File_read_all(file, read_values.data(),
+                                 static_cast<int>(num_values), MPI_DOUBLE,
+                                 MPI_STATUS_IGNORE) == MPI_SUCCESS;
+  MPI_Type_free(&values_type);
+
+  MPI_File_close(&file);
+
+  if (not succeeded) return false;
+
+  //======================================== Put the blocks in requested
+  //                                         order
+  blocks.values.reserve(num_values);
+  for (uint64_t gid : cell_global_ids)
+  {
+    const size_t k = std::lower_bound(unique_global_ids.begin(),
+                                      unique_global_ids.end(), gid) -
+                     unique_global_ids.begin();
+
+    blocks.AddCell(gid);
+    for (uint64_t v = 0; v < value_sizes[k]; ++v)
+      blocks.AddValue(read_values[read_positions[k] + v]);
+  }
+
+  return succeeded;
+}
+
+}//namespace lbs
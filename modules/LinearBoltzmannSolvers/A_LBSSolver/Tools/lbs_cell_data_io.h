@@ -0,0 +1,61 @@
+#ifndef CHITECH_LBS_CELL_DATA_IO_H
+#define CHITECH_LBS_CELL_DATA_IO_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace lbs
+{
+
+/**Per-cell blocks of values. The values of cell i are
+ * `values[offsets[i]]` to `values[offsets[i+1]-1]`.*/
+struct CellDataBlocks
+{
+  std::vector<uint64_t> cell_global_ids;
+  std::vector<uint64_t> offsets = {0};
+  std::vector<double> values;
+
+  /**Appends an empty block for a cell, to be filled via `values`.*/
+  void AddCell(uint64_t cell_global_id)
+  {
+    cell_global_ids.push_back(cell_global_id);
+    offsets.push_back(offsets.back());
+  }
+  /**Appends a value to the last cell's block.*/
+  void AddValue(double value)
+  {
+    values.push_back(value);
+    ++offsets.back();
+  }
+  size_t NumCells() const { return cell_global_ids.size(); }
+};
+
+/**Collectively writes the given per-cell blocks of all locations to a
+ * single file with MPI-IO. The file holds a 512 byte header, an index
+ * of (offset, size) pairs at the position of each cell global id, and
+ * the values of every location as one contiguous segment. Up to 5
+ * attributes may be stored in the header to describe the blocks.
+ * Returns false on this location if the file could not be written.*/
+bool WriteCellDataCollective(const std::string& file_name,
+                             const std::string& description,
+                             const std::vector<uint64_t>& attributes,
+                             uint64_t num_global_cells,
+                             const CellDataBlocks& blocks);
+
+/**Collectively reads the blocks of the requested cells from a file
+ * written with WriteCellDataCollective. Any location may request any
+ * cells, hence the file can be read on any number of locations and
+ * with any partition. The blocks are returned in the order of the
+ * requested global ids. Returns false on this location if the file
+ * could not be read, does not match the number of global cells, or the
+ * attributes differ from the expected ones.*/
+bool ReadCellDataCollective(const std::string& file_name,
+                            const std::vector<uint64_t>& attributes,
+                            uint64_t num_global_cells,
+                            const std::vector<uint64_t>& cell_global_ids,
+                            CellDataBlocks& blocks);
+
+}//namespace lbs
+
+#endif //CHITECH_LBS_CELL_DATA_IO_H
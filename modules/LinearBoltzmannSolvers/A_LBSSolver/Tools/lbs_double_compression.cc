@@ -0,0 +1,294 @@
+#include "lbs_double_compression.h"
+
+#include "chi_log_exceptions.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace lbs
+{
+
+namespace
+{
+//Run-length control bytes: [0,127] are followed by 1 to 128 literal bytes,
+//[128,255] by a single byte repeated 3 to 130 times.
+const size_t MAX_LITERAL = 128;
+const size_t MIN_RUN     = 3;
+const size_t MAX_RUN     = 130;
+
+/**Run-length encodes bytes and appends them to `out`.*/
+void RunLengthEncode(const std::vector<uint8_t>& bytes,
+                     std::vector<uint8_t>& out)
+{
+  const size_t n = bytes.size();
+  size_t i = 0;
+  size_t literal_start = 0;
+
+  auto FlushLiterals = [&bytes, &out, &literal_start](size_t end)
+  {
+    while (literal_start < end)
+    {
+      const size_t count = std::min(MAX_LITERAL, end - literal_start);
+      out.push_back(static_cast<uint8_t>(count - 1));
+      out.insert(out.end(),
+                 bytes.begin() + static_cast<int64_t>(literal_start),
+                 bytes.begin() + static_cast<int64_t>(literal_start + count));
+      literal_start += count;
+    }
+  };
+
+  while (i < n)
+  {
+    size_t run = 1;
+    while (i + run < n and run < MAX_RUN and bytes[i + run] == bytes[i])
+      ++run;
+
+    if (run >= MIN_RUN)
+    {
+      FlushLiterals(i);
+      out.push_back(static_cast<uint8_t>(128 + run - MIN_RUN));
+      out.push_back(bytes[i]);
+      i += run;
+      literal_start = i;
+    }
+    else
+      i += run;
+  }
+  FlushLiterals(n);
+}
+
+/**Decodes exactly `num_bytes` run-length encoded bytes. Returns false if
+ * the data is corrupt.*/
+bool RunLengthDecode(const uint8_t* data, size_t size,
+                     size_t num_bytes, std::vector<uint8_t>& bytes)
+{
+  bytes.clear();
+  bytes.reserve(num_bytes);
+
+  size_t k = 0;
+  while (k < size)
+  {
+    const uint8_t control = data[k++];
+    if (control < 128)
+    {
+      const size_t count = size_t(control) + 1;
+      if (k + count > size or bytes.size() + count > num_bytes) return false;
+      bytes.insert(bytes.end(), data + k, data + k + count);
+      k += count;
+    }
+    else
+    {
+      const size_t count = size_t(control) - 128 + MIN_RUN;
+      if (k >= size or bytes.size() + count > num_bytes) return false;
+      bytes.insert(bytes.end(), count, data[k++]);
+    }
+  }
+
+  return bytes.size() == num_bytes;
+}
+
+/**Transposes `n` words of `W` bytes into `W` planes of `n` bytes.*/
+template<size_t W>
+std::vector<uint8_t> Shuffle(const uint8_t* words, size_t n)
+{
+  std::vector<uint8_t> planes(n * W);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t b = 0; b < W; ++b)
+      planes[b * n + i] = words[i * W + b];
+  return planes;
+}
+
+/**Inverse of Shuffle.*/
+template<size_t W>
+void Unshuffle(const std::vector<uint8_t>& planes, size_t n, uint8_t* words)
+{
+  for (size_t i = 0; i < n; ++i)
+    for (size_t b = 0; b < W; ++b)
+      words[i * W + b] = planes[b * n + i];
+}
+
+void AppendUInt64(uint64_t value, std::vector<uint8_t>& out)
+{
+  uint8_t bytes[sizeof(uint64_t)];
+  memcpy(bytes, &value, sizeof(uint64_t));
+  out.insert(out.end(), bytes, bytes + sizeof(uint64_t));
+}
+
+bool ReadUInt64(const uint8_t* data, size_t size, size_t& k, uint64_t& value)
+{
+  if (k + sizeof(uint64_t) > size) return false;
+  memcpy(&value, data + k, sizeof(uint64_t));
+  k += sizeof(uint64_t);
+  return true;
+}
+
+//Largest quantization delta stored in a code. Code 0 marks a verbatim
+//value.
+const int64_t MAX_QUANTIZED_DELTA = (int64_t(1) << 30) - 1;
+//Largest quantized magnitude, keeping deltas free of overflow.
+const double MAX_QUANTIZED_VALUE = 4.0e18;
+
+uint32_t ZigZag(int64_t delta)
+{
+  return static_cast<uint32_t>((delta << 1) ^ (delta >> 63));
+}
+
+int64_t UnZigZag(uint32_t code)
+{
+  return static_cast<int64_t>(code >> 1) ^ -static_cast<int64_t>(code & 1);
+}
+}//namespace
+
+//###################################################################
+/**Compresses a block of doubles.*/
+std::vector<uint8_t> CompressDoubles(const std::vector<double>& values,
+                                     const DoubleCompression compression,
+                                     const double tolerance)
+{
+  const size_t n = values.size();
+  std::vector<uint8_t> out;
+
+  if (compression == DoubleCompression::NONE)
+  {
+    out.resize(n * sizeof(double));
+    memcpy(out.data(), values.data(), out.size());
+  }
+  else if (compression == DoubleCompression::LOSSLESS)
+  {
+    std::vector<uint64_t> words(n);
+    memcpy(words.data(), values.data(), n * sizeof(double));
+    for (size_t i = n; i-- > 1;)
+      words[i] ^= words[i - 1];
+
+    const auto planes =
+      Shuffle<sizeof(uint64_t)>((const uint8_t*)words.data(), n);
+    RunLengthEncode(planes, out);
+  }
+  else if (compression == DoubleCompression::LOSSY)
+  {
+    ChiInvalidArgumentIf(not (tolerance > 0.0),
+                         "The lossy compression tolerance must be positive.");
+    const double bin = 2.0 * tolerance;
+
+    std::vector<uint32_t> codes(n, 0);
+    std::vector<double> verbatim;
+    int64_t previous = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      const double v = values[i];
+      const double q = std::round(v / bin);
+      if (std::isfinite(q) and std::fabs(q) < MAX_QUANTIZED_VALUE)
+      {
+        const auto quantized = static_cast<int64_t>(q);
+        const int64_t delta = quantized - previous;
+        if (std::fabs(static_cast<double>(quantized) * bin - v) <= tolerance and
+            delta >= -MAX_QUANTIZED_DELTA and delta <= MAX_QUANTIZED_DELTA)
+        {
+          codes[i] = ZigZag(delta) + 1;
+          previous = quantized;
+          continue;
+        }
+      }
+      verbatim.push_back(v);
+    }
+
+    const auto planes =
+      Shuffle<sizeof(uint32_t)>((const uint8_t*)codes.data(), n);
+    std::vector<uint8_t> encoded;
+    RunLengthEncode(planes, encoded);
+
+    AppendUInt64(verbatim.size(), out);
+    AppendUInt64(encoded.size(), out);
+    out.insert(out.end(), encoded.begin(), encoded.end());
+    const auto* verbatim_bytes = (const uint8_t*)verbatim.data();
+    out.insert(out.end(), verbatim_bytes,
+               verbatim_bytes + verbatim.size() * sizeof(double));
+  }
+  else
+    ChiInvalidArgument("Unknown compression.");
+
+  return out;
+}
+
+//###################################################################
+/**Decompresses a block of doubles.*/
+bool DecompressDoubles(const uint8_t* data,
+                       const size_t size,
+                       const size_t num_values,
+                       const DoubleCompression compression,
+                       const double tolerance,
+                       std::vector<double>& values)
+{
+  const size_t n = num_values;
+  values.assign(n, 0.0);
+
+  if (compression == DoubleCompression::NONE)
+  {
+    if (size != n * sizeof(double)) return false;
+    memcpy(values.data(), data, size);
+    return true;
+  }
+
+  if (compression == DoubleCompression::LOSSLESS)
+  {
+    std::vector<uint8_t> planes;
+    if (not RunLengthDecode(data, size, n * sizeof(uint64_t), planes))
+      return false;
+
+    std::vector<uint64_t> words(n);
+    Unshuffle<sizeof(uint64_t)>(planes, n, (uint8_t*)words.data());
+    for (size_t i = 1; i < n; ++i)
+      words[i] ^= words[i - 1];
+
+    memcpy(values.data(), words.data(), n * sizeof(double));
+    return true;
+  }
+
+  if (compression == DoubleCompression::LOSSY)
+  {
+    if (not (tolerance > 0.0)) return false;
+    const double bin = 2.0 * tolerance;
+
+    size_t k = 0;
+    uint64_t num_verbatim = 0, encoded_size = 0;
+    if (not ReadUInt64(data, size, k, num_verbatim) or
+        not ReadUInt64(data, size, k, encoded_size) or
+        encoded_size > size - k or
+        num_verbatim > n or
+        size - k - encoded_size != num_verbatim * sizeof(double))
+      return false;
+
+    std::vector<uint8_t> planes;
+    if (not RunLengthDecode(data + k, encoded_size,
+                            n * sizeof(uint32_t), planes))
+      return false;
+    k += encoded_size;
+
+    std::vector<uint32_t> codes(n);
+    Unshuffle<sizeof(uint32_t)>(planes, n, (uint8_t*)codes.data());
+
+    std::vector<double> verbatim(num_verbatim);
+    memcpy(verbatim.data(), data + k, num_verbatim * sizeof(double));
+
+    size_t v = 0;
+    int64_t previous = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (codes[i] == 0)
+      {
+        if (v >= num_verbatim) return false;
+        values[i] = verbatim[v++];
+        continue;
+      }
+      previous += UnZigZag(codes[i] - 1);
+      values[i] = static_cast<double>(previous) * bin;
+    }
+
+    return v == num_verbatim;
+  }
+
+  return false;
+}
+
+}//namespace lbs
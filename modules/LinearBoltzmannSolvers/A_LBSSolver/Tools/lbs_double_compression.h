@@ -0,0 +1,48 @@
+#ifndef CHITECH_LBS_DOUBLE_COMPRESSION_H
+#define CHITECH_LBS_DOUBLE_COMPRESSION_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace lbs
+{
+
+/**Compression applied to blocks of doubles.*/
+enum class DoubleCompression : int
+{
+  NONE     = 0, ///< Raw doubles
+  LOSSLESS = 1, ///< XOR-delta, byte-shuffle and run-length encoding
+  LOSSY    = 2  ///< Error-bounded quantization of a 1D prediction
+};
+
+/**Compresses a block of doubles.
+ *
+ * LOSSLESS: each value's bits are XORed with those of its predecessor,
+ * the bytes are shuffled into 8 planes (byte k of every value, then byte
+ * k+1, etc.) and the planes are run-length encoded. Smooth fields share
+ * sign, exponent and leading mantissa bits, which become long runs of
+ * zero bytes.
+ *
+ * LOSSY: every value is predicted by its reconstructed predecessor and
+ * the residual is quantized into bins of width 2*tolerance, hence the
+ * reconstruction error is at most `tolerance` for every value. Values
+ * that cannot be quantized within the bound are stored verbatim. The
+ * quantization codes are then byte-shuffled and run-length encoded.*/
+std::vector<uint8_t> CompressDoubles(const std::vector<double>& values,
+                                     DoubleCompression compression,
+                                     double tolerance = 0.0);
+
+/**Decompresses a block of `num_values` doubles compressed with
+ * CompressDoubles with the same compression and tolerance. Returns false
+ * if the block is corrupt.*/
+bool DecompressDoubles(const uint8_t* data,
+                       size_t size,
+                       size_t num_values,
+                       DoubleCompression compression,
+                       double tolerance,
+                       std::vector<double>& values);
+
+}//namespace lbs
+
+#endif //CHITECH_LBS_DOUBLE_COMPRESSION_H
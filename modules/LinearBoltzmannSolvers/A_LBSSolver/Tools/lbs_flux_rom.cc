@@ -0,0 +1,234 @@
+#include "lbs_flux_rom.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace lbs
+{
+
+namespace
+{
+/**Computes the eigenvalues and orthonormal eigenvectors, as the columns of
+ * V, of the symmetric matrix A with cyclic Jacobi rotations. A is
+ * overwritten.*/
+void SymmetricEigen(std::vector<std::vector<double>>& A,
+                    std::vector<double>& values,
+                    std::vector<std::vector<double>>& V)
+{
+  const size_t n = A.size();
+  V.assign(n, std::vector<double>(n, 0.0));
+  for (size_t i = 0; i < n; ++i)
+    V[i][i] = 1.0;
+
+  for (int sweep = 0; sweep < 100; ++sweep)
+  {
+    double off_norm = 0.0;
+    double norm = 0.0;
+    for (size_t i = 0; i < n; ++i)
+      for (size_t j = 0; j < n; ++j)
+      {
+        norm += A[i][j] * A[i][j];
+        if (i != j) off_norm += A[i][j] * A[i][j];
+      }
+    if (off_norm <= 1.0e-30 * norm) break;
+
+    for (size_t p = 0; p + 1 < n; ++p)
+      for (size_t q = p + 1; q < n; ++q)
+      {
+        if (A[p][q] == 0.0) continue;
+
+        const double theta = (A[q][q] - A[p][p]) / (2.0 * A[p][q]);
+        const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                         (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+        const double c = 1.0 / std::sqrt(t * t + 1.0);
+        const double s = t * c;
+
+        for (size_t k = 0; k < n; ++k)
+        {
+          const double a_kp = A[k][p];
+          const double a_kq = A[k][q];
+          A[k][p] = c * a_kp - s * a_kq;
+          A[k][q] = s * a_kp + c * a_kq;
+        }
+        for (size_t k = 0; k < n; ++k)
+        {
+          const double a_pk = A[p][k];
+          const double a_qk = A[q][k];
+          A[p][k] = c * a_pk - s * a_qk;
+          A[q][k] = s * a_pk + c * a_qk;
+        }
+        for (size_t k = 0; k < n; ++k)
+        {
+          const double v_kp = V[k][p];
+          const double v_kq = V[k][q];
+          V[k][p] = c * v_kp - s * v_kq;
+          V[k][q] = s * v_kp + c * v_kq;
+        }
+      }
+  }
+
+  values.resize(n);
+  for (size_t i = 0; i < n; ++i)
+    values[i] = A[i][i];
+}
+}//namespace
+
+//###################################################################
+void FluxSnapshotROM::AddSnapshot(const double parameter,
+                                  const std::vector<double>& phi)
+{
+  ChiInvalidArgumentIf(not snapshots_.empty() and
+                         phi.size() != snapshots_.front().size(),
+                       "The snapshot size differs from that of the previous "
+                       "snapshots.");
+
+  parameters_.push_back(parameter);
+  snapshots_.push_back(phi);
+
+  basis_.clear();
+  singular_values_.clear();
+  coordinates_.clear();
+}
+
+//###################################################################
+size_t FluxSnapshotROM::BuildBasis(const double energy_tolerance,
+                                   const size_t max_rank)
+{
+  const size_t N = snapshots_.size();
+  ChiLogicalErrorIf(N == 0, "No snapshots.");
+
+  //============================================= Gram matrix
+  std::vector<double> local_gram(N * N, 0.0);
+  for (size_t i = 0; i < N; ++i)
+    for (size_t j = i; j < N; ++j)
+      local_gram[i * N + j] =
+        std::inner_product(snapshots_[i].begin(), snapshots_[i].end(),
+                           snapshots_[j].begin(), 0.0);
+
+  std::vector<double> global_gram(N * N, 0.0);
+  MPI_Allreduce(local_gram.data(),  //sendbuf
+                global_gram.data(), //recvbuf
+                static_cast<int>(N * N), MPI_DOUBLE,
+                MPI_SUM,            //operation
+                Chi::mpi.comm);     //communicator
+
+  std::vector<std::vector<double>> C(N, std::vector<double>(N, 0.0));
+  for (size_t i = 0; i < N; ++i)
+    for (size_t j = i; j < N; ++j)
+      C[i][j] = C[j][i] = global_gram[i * N + j];
+
+  //============================================= Eigen decomposition
+  std::vector<double> lambda;
+  std::vector<std::vector<double>> V;
+  SymmetricEigen(C, lambda, V);
+
+  std::vector<size_t> order(N);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&lambda](size_t a, size_t b) { return lambda[a] > lambda[b]; });
+
+  //============================================= Rank
+  double total_energy = 0.0;
+  for (const double l : lambda)
+    total_energy += std::max(l, 0.0);
+
+  size_t rank = 0;
+  double energy = 0.0;
+  while (rank < N and (max_rank == 0 or rank < max_rank))
+  {
+    const double l = lambda[order[rank]];
+    if (l <= 1.0e-14 * lambda[order[0]]) break;
+    if (rank > 0 and energy >= (1.0 - energy_tolerance) * total_energy)
+      break;
+    energy += l;
+    ++rank;
+  }
+
+  //============================================= Basis and coordinates
+  const size_t num_local = snapshots_.front().size();
+  basis_.assign(rank, std::vector<double>(num_local, 0.0));
+  singular_values_.resize(rank);
+  coordinates_.assign(N, std::vector<double>(rank, 0.0));
+  for (size_t r = 0; r < rank; ++r)
+  {
+    const size_t e = order[r];
+    const double sigma = std::sqrt(lambda[e]);
+    singular_values_[r] = sigma;
+
+    auto& u = basis_[r];
+    for (size_t k = 0; k < N; ++k)
+    {
+      const double factor = V[k][e] / sigma;
+      const auto& s = snapshots_[k];
+      for (size_t i = 0; i < num_local; ++i)
+        u[i] += factor * s[i];
+
+      coordinates_[k][r] = sigma * V[k][e];
+    }
+  }
+
+  return rank;
+}
+
+//###################################################################
+std::vector<double> FluxSnapshotROM::Predict(const double parameter) const
+{
+  ChiLogicalErrorIf(basis_.empty(), "No basis, see BuildBasis.");
+
+  const size_t N = parameters_.size();
+  const size_t rank = basis_.size();
+
+  //============================================= Interpolation weights
+  // Between the two nearest snapshots bracketing the parameter, or the
+  // two nearest ones if outside of the range
+  std::vector<size_t> order(N);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t a, size_t b)
+                   { return parameters_[a] < parameters_[b]; });
+
+  std::vector<double> a(rank, 0.0);
+  if (N == 1)
+    a = coordinates_.front();
+  else
+  {
+    size_t hi = 1;
+    while (hi + 1 < N and parameters_[order[hi]] < parameter)
+      ++hi;
+    const size_t k0 = order[hi - 1];
+    const size_t k1 = order[hi];
+
+    const double dp = parameters_[k1] - parameters_[k0];
+    const double w1 = dp != 0.0 ? (parameter - parameters_[k0]) / dp : 0.5;
+    for (size_t r = 0; r < rank; ++r)
+      a[r] = (1.0 - w1) * coordinates_[k0][r] + w1 * coordinates_[k1][r];
+  }
+
+  //============================================= Reconstruction
+  std::vector<double> phi(basis_.front().size(), 0.0);
+  for (size_t r = 0; r < rank; ++r)
+  {
+    const auto& u = basis_[r];
+    for (size_t i = 0; i < phi.size(); ++i)
+      phi[i] += a[r] * u[i];
+  }
+
+  return phi;
+}
+
+//###################################################################
+void FluxSnapshotROM::Clear()
+{
+  parameters_.clear();
+  snapshots_.clear();
+  basis_.clear();
+  singular_values_.clear();
+  coordinates_.clear();
+}
+
+}//namespace lbs
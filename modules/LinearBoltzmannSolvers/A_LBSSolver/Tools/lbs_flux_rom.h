@@ -0,0 +1,59 @@
+#ifndef CHITECH_LBS_FLUX_ROM_H
+#define CHITECH_LBS_FLUX_ROM_H
+
+#include <vector>
+#include <cstddef>
+
+namespace lbs
+{
+
+/**Reduced-order model of the flux moments over a scalar parameter, e.g.,
+ * a material property of parametric runs or the time of a transient,
+ * built from snapshots of converged solutions.
+ *
+ * The proper orthogonal decomposition (POD) basis is computed in parallel
+ * with the method of snapshots: the Gram matrix of the distributed
+ * snapshots is reduced over all locations and its eigenvectors combine the
+ * snapshots into the basis. The flux at a new parameter is predicted by
+ * interpolating, piecewise linearly, the reduced coordinates of the
+ * snapshots and extrapolating linearly outside of their range. The
+ * prediction, used as the initial guess of the iterative solvers, costs a
+ * combination of the basis vectors and no sweep.*/
+class FluxSnapshotROM
+{
+private:
+  std::vector<double> parameters_;
+  std::vector<std::vector<double>> snapshots_;
+
+  std::vector<std::vector<double>> basis_;
+  std::vector<double> singular_values_;
+  /**Per snapshot, its coordinates in the basis.*/
+  std::vector<std::vector<double>> coordinates_;
+
+public:
+  /**Adds the snapshot of the local flux moments for the given parameter,
+   * which invalidates the basis.*/
+  void AddSnapshot(double parameter, const std::vector<double>& phi);
+
+  /**Builds the POD basis with the smallest rank capturing all but the
+   * `energy_tolerance` fraction of the snapshot energy, the sum of the
+   * squared singular values, limited to `max_rank` if nonzero. Returns the
+   * rank. Collective.*/
+  size_t BuildBasis(double energy_tolerance, size_t max_rank);
+
+  /**Returns the predicted local flux moments for the given parameter.
+   * Requires a basis.*/
+  std::vector<double> Predict(double parameter) const;
+
+  size_t NumSnapshots() const { return snapshots_.size(); }
+  size_t Rank() const { return basis_.size(); }
+  const std::vector<double>& SingularValues() const
+  { return singular_values_; }
+
+  /**Removes the snapshots and the basis.*/
+  void Clear();
+};
+
+}//namespace lbs
+
+#endif //CHITECH_LBS_FLUX_ROM_H
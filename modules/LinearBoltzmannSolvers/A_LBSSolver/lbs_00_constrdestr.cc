@@ -1,10 +1,14 @@
 #include "lbs_solver.h"
 
 #include "chi_log.h"
+#include "chi_mpi.h"
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
 
 #include "IterativeMethods/wgs_context.h"
 #include "math/TimeIntegrations/time_integration.h"
 
+#include <algorithm>
+
 namespace lbs
 {
 //RegisterChiObject(lbs, LBSSolver); Should not be constructible
@@ -76,9 +80,27 @@ LBSSolver::LBSSolver(const chi::InputParameters& params)
   }
 }
 
-/**Returns the source event tag used for logging the time it
- * takes to set source moments.*/
-size_t LBSSolver::GetSourceEventTag() const { return source_event_tag_; }
+/**Waits for a pending asynchronous restart write. Its failure is only
+ * reported locally since the locations cannot synchronize here.*/
+LBSSolver::~LBSSolver()
+{
+  if (restart_write_future_.valid() and not restart_write_future_.get())
+    Chi::log.LogAllError()
+      << "Failed to write asynchronous restart file for location "
+      << Chi::mpi.location_id;
+
+  //Field functions may outlive the solver, hence the views over the
+  //solver's vectors are materialized.
+  for (auto& ff_ptr : field_functions_)
+    ff_ptr->ClearFieldVectorView();
+}
+
+/**Returns the timing of the source evaluations. Source functions hold
+ * the solver by const reference, hence the timing is mutable.*/
+chi::RunningStatistics& LBSSolver::GetSourceTiming() const
+{
+  return source_timing_;
+}
 
 /**Returns the time at which the last restart was written.*/
 double LBSSolver::LastRestartWrite() const { return last_restart_write_; }
@@ -92,6 +114,9 @@ Options& LBSSolver::Options() { return options_; }
 /**Returns a constant reference to the solver options.*/
 const Options& LBSSolver::Options() const { return options_; }
 
+/**Returns true once the solver has been initialized.*/
+bool LBSSolver::IsInitialized() const { return initialized_; }
+
 /**Returns the number of moments for the solver. This will only be non-zero
  * after initialization.*/
 size_t LBSSolver::NumMoments() const { return num_moments_; }
@@ -167,14 +192,29 @@ const std::map<int, IsotropicSrcPtr>& LBSSolver::GetMatID2IsoSrcMap() const
   return matid_to_src_map_;
 }
 
+/**Returns the flat mapping of local cells to material indices, and the
+ * per material cell batches.*/
+const CellMaterialTable& LBSSolver::GetCellMaterialTable() const
+{
+  return cell_material_table_;
+}
+
+/**Returns the precursor data of the materials of the cell material
+ * table.*/
+const PrecursorEngine& LBSSolver::GetPrecursorEngine() const
+{
+  return precursor_engine_;
+}
+
 /**Obtains a reference to the spatial discretization.*/
 const chi_math::SpatialDiscretization& LBSSolver::SpatialDiscretization() const
 {
   return *discretization_;
 }
 
-/**Returns read-only access to the unit cell matrices.*/
-const std::vector<UnitCellMatrices>& LBSSolver::GetUnitCellMatrices() const
+/**Returns read-only access to the unit cell matrices of the local and
+ * ghost cells.*/
+const PackedUnitCellMatrices& LBSSolver::GetUnitCellMatrices() const
 {
   return unit_cell_matrices_;
 }
@@ -188,12 +228,20 @@ const std::vector<CellLBSView>& LBSSolver::GetCellTransportViews() const
   return cell_transport_views_;
 }
 
-/**Obtains a reference to the unknown manager for flux-moments.*/
+/**Obtains a reference to the unknown manager for flux-moments. It maps
+ * the unknowns of the group interleaved layout only, otherwise the cell
+ * transport views must be used, see FluxMomentBlocks.*/
 const chi_math::UnknownManager& LBSSolver::UnknownManager() const
 {
   return flux_moments_uk_man_;
 }
 
+/**Returns the group blocks of the flux-moment vectors.*/
+const FluxMomentBlocks& LBSSolver::GetFluxMomentBlocks() const
+{
+  return flux_moment_blocks_;
+}
+
 /**Returns the local node count for the flux-moments data structures.*/
 size_t LBSSolver::LocalNodeCount() const { return local_node_count_; }
 
@@ -253,6 +301,18 @@ const std::vector<VecDbl>& LBSSolver::PsiNewLocal() const
   return psi_new_local_;
 }
 
+/**Returns true if the angular fluxes of the given groupset are saved, in
+ * which case its psi vector is allocated.*/
+bool LBSSolver::SavesAngularFlux(int groupset_id) const
+{
+  if (not options_.save_angular_flux) return false;
+
+  const auto& groupset_ids = options_.save_angular_flux_groupsets;
+  return groupset_ids.empty() or
+         std::find(groupset_ids.begin(), groupset_ids.end(), groupset_id) !=
+           groupset_ids.end();
+}
+
 /**Returns the sweep boundaries as a read only reference*/
 const std::map<uint64_t, std::shared_ptr<SweepBndry>>&
 LBSSolver::SweepBoundaries() const
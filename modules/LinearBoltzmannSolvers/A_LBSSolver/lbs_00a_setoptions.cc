@@ -38,6 +38,50 @@ chi::InputParameters LBSSolver::OptionsBlock()
   "on the given platform will start to suffer. One can gain a small amount of"
   "parallel efficiency by lowering this limit, however, there is a point where"
   "the parallel efficiency will actually get worse so use with caution.");
+  params.AddOptionalParameter("sweep_num_threads",1,
+  "Number of threads per MPI rank used during sweeps. AAH sweeps execute "
+  "ready angle sets concurrently, or the cells of each sweep level with the "
+  "\"LEVEL_BATCHED\" sweep chunk mode, whilst CBC sweeps execute ready cell "
+  "tasks concurrently using work-stealing. Each thread gets its own sweep "
+  "chunk and flux-moment accumulation buffer. Has no effect unless ChiTech was "
+  "built with OpenMP.");
+  params.AddOptionalParameter("sweep_eager_limit_auto",false,
+  "Flag indicating whether the sweep message size limits are tuned "
+  "automatically. During initialization the latency and bandwidth of the "
+  "links to each neighboring location are measured and a message size limit "
+  "is selected per link, replacing `sweep_eager_limit` for that link. The "
+  "measurements are recorded in the \"Sweep Link Tuning\" event log.");
+  params.AddOptionalParameter("sweep_persistent_requests",false,
+  "Flag indicating whether AAH sweeps use persistent MPI requests that are "
+  "built once and restarted every sweep. When enabled, the data sent to a "
+  "location below the eager limit is aggregated into a single message instead "
+  "of one message per angle.");
+  params.AddOptionalParameter("sweep_shared_memory",false,
+  "Flag indicating whether AAH sweeps exchange angular fluxes with locations "
+  "on the same node through MPI-3 shared-memory windows instead of MPI "
+  "messages. Locations on other nodes, and cyclic dependencies, still use "
+  "MPI messages.");
+  params.AddOptionalParameter("node_shared_quadrature",false,
+  "Flag indicating whether the direction-major moment operators of the "
+  "groupset quadratures, read by the sweeps, are stored once per node in "
+  "MPI-3 shared memory instead of once per location.");
+  params.AddOptionalParameter("numa_first_touch",false,
+  "Flag indicating whether the pages of the flux moment, source moment and "
+  "angular flux vectors are placed by first touch of the sweep_num_threads "
+  "worker threads, each touching a contiguous block of local cells. Best "
+  "combined with the --pin_threads command line option.");
+  params.AddOptionalParameter("lean_cell_mappings",false,
+  "Flag indicating whether the spatial discretization keeps, per cell, only "
+  "the node counts and face node mappings needed by the sweeps. The shape "
+  "functions and quadrature data are then recomputed on demand, e.g., for "
+  "post-processing, which reduces the memory used by polyhedral meshes.");
+  params.AddOptionalParameter("flux_moment_layout","group_interleaved",
+  "Ordering of the flux moment unknowns. With `\"group_interleaved\"` all "
+  "the groups of a node and moment are contiguous. With "
+  "`\"groupset_major\"` the unknowns of each groupset are a contiguous "
+  "sub-vector, ordered by node, moment and groupset group, which the sweeps "
+  "and within-groupset solves of each groupset stream through. The "
+  "kernels reading across groupsets then gather the groups of each cell.");
   params.AddOptionalParameter("read_restart_data",false,
   "Flag indicating whether restart data is to be read.");
   params.AddOptionalParameter("read_restart_folder_name","YRestart",
@@ -57,8 +101,18 @@ chi::InputParameters LBSSolver::OptionsBlock()
   params.AddOptionalParameter("use_source_moments",false,
   "Flag for ignoring fixed sources and selectively using source moments "
   "obtained elsewhere.");
+  params.AddOptionalParameter("use_first_collision_source",false,
+  "Flag for replacing the point sources by their first-collision source. The "
+  "uncollided flux of the point sources is computed along rays and only the "
+  "collided flux is solved for, which avoids the ray effects of the point "
+  "sources with coarse angular quadratures. 3D only.");
   params.AddOptionalParameter("save_angular_flux",false,
   "Flag indicating whether angular fluxes are to be stored or not.");
+  params.AddOptionalParameterArray("save_angular_flux_groupsets",
+  std::vector<int>(),
+  "Ids of the groupsets whose angular fluxes are stored when "
+  "`save_angular_flux` is true. The angular fluxes of all the groupsets are "
+  "stored when empty, which is the default.");
   params.AddOptionalParameter("verbose_inner_iterations",true,
   "Flag to control verbosity of inner iterations.");
   params.AddOptionalParameter("verbose_outer_iterations",true,
@@ -101,6 +155,9 @@ chi::InputParameters LBSSolver::OptionsBlock()
   params.ConstrainParameterRange("spatial_discretization",
       AllowableRangeList::New({"pwld"}));
 
+  params.ConstrainParameterRange("sweep_num_threads",
+      AllowableRangeLowLimit::New(1));
+
   params.ConstrainParameterRange("field_function_prefix_option",
     AllowableRangeList::New({"prefix", "solver_name"}));
   // clang-format on
@@ -135,6 +192,11 @@ chi::InputParameters LBSSolver::BoundaryOptionsBlock()
   "Text name of the lua function to be called for this boundary condition. For"
   " more on this boundary condition type.");
 
+  params.AddOptionalParameter("function_batched", false,
+  "If true, the lua function `function_name` is called once for all the face "
+  "nodes of the boundary, with tables of the node values, instead of once per "
+  "node. See \\ref LBSBCs");
+
   using namespace chi_data_types;
   params.ConstrainParameterRange("name", AllowableRangeList::New({
   "xmin", "xmax", "ymin", "ymax", "zmin", "zmax"}));
@@ -170,6 +232,40 @@ void LBSSolver::SetOptions(const chi::InputParameters& params)
     else if (spec.Name() == "sweep_eager_limit")
       Options().sweep_eager_limit = spec.GetValue<int>();
 
+    else if (spec.Name() == "sweep_eager_limit_auto")
+      Options().sweep_eager_limit_auto = spec.GetValue<bool>();
+
+    else if (spec.Name() == "sweep_persistent_requests")
+      Options().sweep_persistent_requests = spec.GetValue<bool>();
+
+    else if (spec.Name() == "sweep_shared_memory")
+      Options().sweep_shared_memory = spec.GetValue<bool>();
+
+    else if (spec.Name() == "node_shared_quadrature")
+      Options().node_shared_quadrature = spec.GetValue<bool>();
+
+    else if (spec.Name() == "numa_first_touch")
+      Options().numa_first_touch = spec.GetValue<bool>();
+
+    else if (spec.Name() == "sweep_num_threads")
+      Options().sweep_num_threads = spec.GetValue<int>();
+
+    else if (spec.Name() == "lean_cell_mappings")
+      Options().lean_cell_mappings = spec.GetValue<bool>();
+
+    else if (spec.Name() == "flux_moment_layout")
+    {
+      const auto layout = spec.GetValue<std::string>();
+      ChiInvalidArgumentIf(layout != "group_interleaved" and
+                             layout != "groupset_major",
+                           "Unknown flux_moment_layout \"" + layout +
+                             "\". Allowed values are \"group_interleaved\" "
+                             "and \"groupset_major\".");
+      Options().flux_moment_layout = layout == "groupset_major"
+                                       ? FluxMomentLayout::GROUPSET_MAJOR
+                                       : FluxMomentLayout::GROUP_INTERLEAVED;
+    }
+
     else if (spec.Name() == "read_restart_data")
       Options().read_restart_data = spec.GetValue<bool>();
 
@@ -201,9 +297,15 @@ void LBSSolver::SetOptions(const chi::InputParameters& params)
     else if (spec.Name() == "use_source_moments")
       Options().use_src_moments = spec.GetValue<bool>();
 
+    else if (spec.Name() == "use_first_collision_source")
+      Options().use_first_collision_source = spec.GetValue<bool>();
+
     else if (spec.Name() == "save_angular_flux")
       Options().save_angular_flux = spec.GetValue<bool>();
 
+    else if (spec.Name() == "save_angular_flux_groupsets")
+      Options().save_angular_flux_groupsets = spec.GetVectorValue<int>();
+
     else if (spec.Name() == "verbose_inner_iterations")
       Options().verbose_inner_iterations = spec.GetValue<bool>();
 
@@ -311,7 +413,11 @@ void LBSSolver::SetBoundaryOptions(const chi::InputParameters& params)
       const auto bndry_function_name =
         user_params.GetParamValue<std::string>("function_name");
 
-      BoundaryPreferences()[bid] = {type, {}, bndry_function_name};
+      const bool batched =
+        user_params.Has("function_batched") and
+        user_params.GetParamValue<bool>("function_batched");
+
+      BoundaryPreferences()[bid] = {type, {}, bndry_function_name, batched};
       break;
     }
   }
@@ -1,4 +1,5 @@
 #include "lbs_solver.h"
+#include "IterativeMethods/wgs_context.h"
 
 #include "physics/PhysicsMaterial/chi_physicsmaterial.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
@@ -179,8 +180,133 @@ void lbs::LBSSolver::InitMaterials()
       transport_view.ReassingXS(*xs_ptr);
     }
 
+  cell_material_table_ =
+    CellMaterialTable(*grid_ptr_, matid_to_xs_map_, matid_to_src_map_);
+  precursor_engine_ = PrecursorEngine(
+    cell_material_table_, groups_.size(), max_precursors_per_material_);
+  fission_engine_ = FissionEngine(cell_material_table_, groups_.size());
+
   Chi::log.Log0Verbose1()
     << "Materials Initialized:\n" << materials_list.str() << "\n";
 
   MPI_Barrier(Chi::mpi.comm);
 }
+
+//###################################################################
+/**Updates the solver to cross sections that have changed since
+ * initialization, either because a material's transport cross section
+ * property was replaced or because a cross section was modified in place
+ * (e.g. a MultiStateMGXS set to a new state). This re-maps the cells to
+ * the cross sections of their materials and rebuilds the DSA solvers,
+ * which hold copies of the cross sections, without re-initializing the
+ * materials or any other solver data. The materials of the cells, and the
+ * number of groups and precursors of their cross sections, must not
+ * change.*/
+void lbs::LBSSolver::UpdateCrossSections()
+{
+  const std::string fname = "lbs::LBSSolver::UpdateCrossSections";
+
+  //================================================== Re-fetch cross sections
+  for (auto& [mat_id, xs] : matid_to_xs_map_)
+  {
+    auto current_material =
+      Chi::GetStackItemPtr(Chi::material_stack, mat_id, fname);
+
+    XSPtr new_xs = nullptr;
+    for (const auto& property : current_material->properties_)
+      if (property->Type() == chi_physics::PropertyType::TRANSPORT_XSECTIONS)
+        new_xs = std::static_pointer_cast<chi_physics::MultiGroupXS>(property);
+
+    ChiLogicalErrorIf(not new_xs,
+                      "Found no transport cross-section property for "
+                      "material \"" + current_material->name_ + "\".");
+    ChiLogicalErrorIf(new_xs->NumGroups() < groups_.size(),
+                      "Material \"" + current_material->name_ + "\" has "
+                      "fewer groups than the simulation.");
+    ChiLogicalErrorIf(new_xs->NumPrecursors() != xs->NumPrecursors(),
+                      "The number of precursors of material \"" +
+                        current_material->name_ + "\" changed.");
+    xs = new_xs;
+  }
+
+  UpdateCellCrossSections();
+
+  //================================================== Update DSA solvers
+  // The solvers are kept, re-assembled, and their preconditioners possibly
+  // reused
+  for (auto& groupset : groupsets_)
+  {
+    UpdateWGDSA(groupset);
+    UpdateTGDSA(groupset);
+  }
+
+  //================================================== Invalidate recycled
+  //                                                   WGS subspaces
+  for (auto& wgs_solver : wgs_solvers_)
+  {
+    auto wgs_context = std::dynamic_pointer_cast<WGSContext<Mat, Vec, KSP>>(
+      wgs_solver->GetContext());
+    if (wgs_context) wgs_context->ClearRecycledSubspace();
+  }
+}
+
+//###################################################################
+/**Updates the solver to isotropic material sources and point sources that
+ * have changed since initialization, without re-initializing the materials
+ * or any other solver data. Sources only enter the right-hand side, hence
+ * the iterative and DSA solvers are kept as they are.*/
+void lbs::LBSSolver::UpdateSources()
+{
+  const std::string fname = "lbs::LBSSolver::UpdateSources";
+
+  //================================================== Re-fetch sources
+  matid_to_src_map_.clear();
+  for (const auto& [mat_id, xs] : matid_to_xs_map_)
+  {
+    auto current_material =
+      Chi::GetStackItemPtr(Chi::material_stack, mat_id, fname);
+
+    for (const auto& property : current_material->properties_)
+      if (property->Type() == chi_physics::PropertyType::ISOTROPIC_MG_SOURCE)
+      {
+        auto mg_source =
+          std::static_pointer_cast<chi_physics::IsotropicMultiGrpSource>(
+            property);
+
+        if (mg_source->source_value_g_.size() < groups_.size())
+          Chi::log.LogAllWarning()
+            << fname + ": Isotropic Multigroup source specified in "
+            << "material \"" << current_material->name_ << "\" has fewer "
+            << "energy groups than called for in the simulation. "
+            << "Source will be ignored.";
+        else
+          matid_to_src_map_[mat_id] = mg_source;
+      }
+  }
+
+  //Rebuilds the cell material table with the new sources
+  UpdateCellCrossSections();
+
+  InitializePointSources();
+}
+
+//###################################################################
+/**Points the cell transport views and the cell material table to the
+ * current cross sections of the materials.*/
+void lbs::LBSSolver::UpdateCellCrossSections()
+{
+  if (grid_ptr_->local_cells.size() == cell_transport_views_.size())
+    for (const auto& cell : grid_ptr_->local_cells)
+    {
+      const auto& xs_ptr = matid_to_xs_map_[cell.material_id_];
+      auto& transport_view = cell_transport_views_[cell.local_id_];
+
+      transport_view.ReassingXS(*xs_ptr);
+    }
+
+  cell_material_table_ =
+    CellMaterialTable(*grid_ptr_, matid_to_xs_map_, matid_to_src_map_);
+  precursor_engine_ = PrecursorEngine(
+    cell_material_table_, groups_.size(), max_precursors_per_material_);
+  fission_engine_ = FissionEngine(cell_material_table_, groups_.size());
+}
@@ -1,7 +1,9 @@
 #include "lbs_solver.h"
+#include "IterativeMethods/wgs_context.h"
 
 #include "math/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/Cell/cell.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -11,160 +13,311 @@
 
 
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
-void lbs::LBSSolver::InitializeSpatialDiscretization()
+namespace
 {
-  using namespace chi_math::finite_element;
-  Chi::log.Log() << "Initializing spatial discretization.\n";
-  discretization_ = chi_math::SpatialDiscretization_PWLD::New(*grid_ptr_);
-
-  ComputeUnitIntegrals();
-}
-
-void lbs::LBSSolver::ComputeUnitIntegrals()
+//###################################################################
+/**Makes a key that is identical for cells that are identical up to a
+ * translation: the cell types, the vertex coordinates relative to the
+ * first vertex in multiples of `quantum`, and the face-to-vertex
+ * connectivity in terms of the cell's vertex numbering.*/
+std::vector<int64_t> MakeCellCongruenceKey(const chi_mesh::MeshContinuum& grid,
+                                           const chi_mesh::Cell& cell,
+                                           const double quantum)
 {
-  Chi::log.Log() << "Computing unit integrals.\n";
-  const auto& sdm = *discretization_;
+  const auto& vertex_ids = cell.vertex_ids_;
+  std::vector<int64_t> key = {static_cast<int64_t>(cell.Type()),
+                              static_cast<int64_t>(cell.SubType()),
+                              static_cast<int64_t>(vertex_ids.size())};
 
-  //======================================== Define spatial weighting functions
-  struct SpatialWeightFunction //SWF
+  const auto& v0 = grid.vertices[vertex_ids.front()];
+  for (const uint64_t vid : vertex_ids)
   {
-    virtual double operator()(const chi_mesh::Vector3& pt) const
-    { return 1.0; }
-    virtual ~SpatialWeightFunction() = default;
-  };
+    const auto relative = grid.vertices[vid] - v0;
+    for (unsigned int d = 0; d < 3; ++d)
+      key.push_back(std::llround(relative[d] / quantum));
+  }
 
-  struct SphericalSWF : public SpatialWeightFunction
+  key.push_back(static_cast<int64_t>(cell.faces_.size()));
+  for (const auto& face : cell.faces_)
   {
-    double operator()(const chi_mesh::Vector3& pt) const override
-    { return pt[2]*pt[2]; }
-  };
+    key.push_back(static_cast<int64_t>(face.vertex_ids_.size()));
+    for (const uint64_t vid : face.vertex_ids_)
+      key.push_back(std::find(vertex_ids.begin(), vertex_ids.end(), vid) -
+                    vertex_ids.begin());
+  }
 
-  struct CylindricalSWF : public SpatialWeightFunction
+  return key;
+}
+
+/**FNV-1a hash of a congruence key.*/
+struct CellCongruenceKeyHash
+{
+  size_t operator()(const std::vector<int64_t>& key) const
   {
-    double operator()(const chi_mesh::Vector3& pt) const override
-    { return pt[0]; }
-  };
+    uint64_t hash = 14695981039346656037ull;
+    for (const int64_t value : key)
+    {
+      hash ^= static_cast<uint64_t>(value);
+      hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+  }
+};
+}//namespace
+
+namespace lbs
+{
+namespace
+{
+//###################################################################
+/**Spatial weighting of the unit integrals.*/
+struct SpatialWeightFunction //SWF
+{
+  virtual double operator()(const chi_mesh::Vector3& pt) const
+  { return 1.0; }
+  virtual ~SpatialWeightFunction() = default;
+};
 
-  auto swf_ptr = std::make_shared<SpatialWeightFunction>();
-  if (options_.geometry_type == lbs::GeometryType::ONED_SPHERICAL)
-    swf_ptr = std::make_shared<SphericalSWF>();
-  if (options_.geometry_type == lbs::GeometryType::TWOD_CYLINDRICAL)
-    swf_ptr = std::make_shared<CylindricalSWF>();
+struct SphericalSWF : public SpatialWeightFunction
+{
+  double operator()(const chi_mesh::Vector3& pt) const override
+  { return pt[2]*pt[2]; }
+};
 
-  auto ComputeCellUnitIntegrals = [&sdm](const chi_mesh::Cell& cell,
-                                         const SpatialWeightFunction& swf)
+struct CylindricalSWF : public SpatialWeightFunction
+{
+  double operator()(const chi_mesh::Vector3& pt) const override
+  { return pt[0]; }
+};
+
+/**Returns the spatial weighting of the given geometry type.*/
+std::shared_ptr<SpatialWeightFunction>
+MakeSpatialWeightFunction(const GeometryType geometry_type)
+{
+  if (geometry_type == GeometryType::ONED_SPHERICAL)
+    return std::make_shared<SphericalSWF>();
+  if (geometry_type == GeometryType::TWOD_CYLINDRICAL)
+    return std::make_shared<CylindricalSWF>();
+  return std::make_shared<SpatialWeightFunction>();
+}
+
+//###################################################################
+/**Integrates the unit cell matrices of a cell.*/
+UnitCellMatrices
+ComputeCellUnitIntegrals(const chi_math::SpatialDiscretization& sdm,
+                         const chi_mesh::Cell& cell,
+                         const SpatialWeightFunction& swf)
+{
+  const auto& cell_mapping = sdm.GetCellMapping(cell);
+  const size_t cell_num_faces = cell.faces_.size();
+  const size_t cell_num_nodes = cell_mapping.NumNodes();
+  const auto vol_qp_data = cell_mapping.MakeVolumeQuadraturePointData();
+
+  MatDbl  IntV_gradshapeI_gradshapeJ(cell_num_nodes, VecDbl(cell_num_nodes));
+  MatVec3 IntV_shapeI_gradshapeJ(cell_num_nodes, VecVec3(cell_num_nodes));
+  MatDbl  IntV_shapeI_shapeJ(cell_num_nodes, VecDbl(cell_num_nodes));
+  VecDbl  IntV_shapeI(cell_num_nodes);
+
+  std::vector<MatDbl>  IntS_shapeI_shapeJ(cell_num_faces);
+  std::vector<MatVec3> IntS_shapeI_gradshapeJ(cell_num_faces);
+  std::vector<VecDbl>  IntS_shapeI(cell_num_faces);
+
+  //Volume integrals
+  for (unsigned int i = 0; i < cell_num_nodes; ++i)
   {
-    const auto& cell_mapping = sdm.GetCellMapping(cell);
-    const size_t cell_num_faces = cell.faces_.size();
-    const size_t cell_num_nodes = cell_mapping.NumNodes();
-    const auto vol_qp_data = cell_mapping.MakeVolumeQuadraturePointData();
+    for (unsigned int j = 0; j < cell_num_nodes; ++j)
+    {
+      for (const auto& qp : vol_qp_data.QuadraturePointIndices())
+      {
+        IntV_gradshapeI_gradshapeJ[i][j]
+          += swf(vol_qp_data.QPointXYZ(qp)) *
+             vol_qp_data.ShapeGrad(i, qp).Dot(vol_qp_data.ShapeGrad(j, qp)) *
+             vol_qp_data.JxW(qp);  //K-matrix
+
+        IntV_shapeI_gradshapeJ[i][j]
+          += swf(vol_qp_data.QPointXYZ(qp)) *
+             vol_qp_data.ShapeValue(i, qp) *
+             vol_qp_data.ShapeGrad(j, qp) *
+             vol_qp_data.JxW(qp);  //G-matrix
 
-    MatDbl  IntV_gradshapeI_gradshapeJ(cell_num_nodes, VecDbl(cell_num_nodes));
-    MatVec3 IntV_shapeI_gradshapeJ(cell_num_nodes, VecVec3(cell_num_nodes));
-    MatDbl  IntV_shapeI_shapeJ(cell_num_nodes, VecDbl(cell_num_nodes));
-    VecDbl  IntV_shapeI(cell_num_nodes);
+        IntV_shapeI_shapeJ[i][j]
+          += swf(vol_qp_data.QPointXYZ(qp)) *
+             vol_qp_data.ShapeValue(i, qp) *
+             vol_qp_data.ShapeValue(j, qp) *
+             vol_qp_data.JxW(qp);  //M-matrix
+      }// for qp
+    }// for j
 
-    std::vector<MatDbl>  IntS_shapeI_shapeJ(cell_num_faces);
-    std::vector<MatVec3> IntS_shapeI_gradshapeJ(cell_num_faces);
-    std::vector<VecDbl>  IntS_shapeI(cell_num_faces);
+    for (const auto& qp : vol_qp_data.QuadraturePointIndices())
+    {
+      IntV_shapeI[i]
+        += swf(vol_qp_data.QPointXYZ(qp)) *
+           vol_qp_data.ShapeValue(i, qp) * vol_qp_data.JxW(qp);
+    }// for qp
+  }//for i
+
+  //  surface integrals
+  for (size_t f = 0; f < cell_num_faces; ++f)
+  {
+    const auto faces_qp_data = cell_mapping.MakeFaceQuadraturePointData(f);
+    IntS_shapeI_shapeJ[f].resize(cell_num_nodes, VecDbl(cell_num_nodes));
+    IntS_shapeI[f].resize(cell_num_nodes);
+    IntS_shapeI_gradshapeJ[f].resize(cell_num_nodes, VecVec3(cell_num_nodes));
 
-    //Volume integrals
     for (unsigned int i = 0; i < cell_num_nodes; ++i)
     {
       for (unsigned int j = 0; j < cell_num_nodes; ++j)
       {
-        for (const auto& qp : vol_qp_data.QuadraturePointIndices())
+        for (const auto& qp : faces_qp_data.QuadraturePointIndices())
         {
-          IntV_gradshapeI_gradshapeJ[i][j]
-            += swf(vol_qp_data.QPointXYZ(qp)) *
-               vol_qp_data.ShapeGrad(i, qp).Dot(vol_qp_data.ShapeGrad(j, qp)) *
-               vol_qp_data.JxW(qp);  //K-matrix
-
-          IntV_shapeI_gradshapeJ[i][j]
-            += swf(vol_qp_data.QPointXYZ(qp)) *
-               vol_qp_data.ShapeValue(i, qp) *
-               vol_qp_data.ShapeGrad(j, qp) *
-               vol_qp_data.JxW(qp);  //G-matrix
-
-          IntV_shapeI_shapeJ[i][j]
-            += swf(vol_qp_data.QPointXYZ(qp)) *
-               vol_qp_data.ShapeValue(i, qp) *
-               vol_qp_data.ShapeValue(j, qp) *
-               vol_qp_data.JxW(qp);  //M-matrix
+          IntS_shapeI_shapeJ[f][i][j]
+            += swf(faces_qp_data.QPointXYZ(qp)) *
+               faces_qp_data.ShapeValue(i, qp) *
+               faces_qp_data.ShapeValue(j, qp) *
+               faces_qp_data.JxW(qp);
+          IntS_shapeI_gradshapeJ[f][i][j]
+            += swf(faces_qp_data.QPointXYZ(qp)) *
+               faces_qp_data.ShapeValue(i, qp) *
+               faces_qp_data.ShapeGrad(j, qp) *
+               faces_qp_data.JxW(qp);
         }// for qp
-      }// for j
+      }//for j
 
-      for (const auto& qp : vol_qp_data.QuadraturePointIndices())
+      for (const auto& qp : faces_qp_data.QuadraturePointIndices())
       {
-        IntV_shapeI[i]
-          += swf(vol_qp_data.QPointXYZ(qp)) *
-             vol_qp_data.ShapeValue(i, qp) * vol_qp_data.JxW(qp);
+        IntS_shapeI[f][i]
+          += swf(faces_qp_data.QPointXYZ(qp)) *
+             faces_qp_data.ShapeValue(i, qp) * faces_qp_data.JxW(qp);
       }// for qp
     }//for i
+  }//for f
 
-    //  surface integrals
-    for (size_t f = 0; f < cell_num_faces; ++f)
-    {
-      const auto faces_qp_data = cell_mapping.MakeFaceQuadraturePointData(f);
-      IntS_shapeI_shapeJ[f].resize(cell_num_nodes, VecDbl(cell_num_nodes));
-      IntS_shapeI[f].resize(cell_num_nodes);
-      IntS_shapeI_gradshapeJ[f].resize(cell_num_nodes, VecVec3(cell_num_nodes));
+  return
+    UnitCellMatrices{IntV_gradshapeI_gradshapeJ, //K-matrix
+                     IntV_shapeI_gradshapeJ,     //G-matrix
+                     IntV_shapeI_shapeJ,         //M-matrix
+                     IntV_shapeI,                //Vi-vectors
 
-      for (unsigned int i = 0; i < cell_num_nodes; ++i)
-      {
-        for (unsigned int j = 0; j < cell_num_nodes; ++j)
-        {
-          for (const auto& qp : faces_qp_data.QuadraturePointIndices())
-          {
-            IntS_shapeI_shapeJ[f][i][j]
-              += swf(faces_qp_data.QPointXYZ(qp)) *
-                 faces_qp_data.ShapeValue(i, qp) *
-                 faces_qp_data.ShapeValue(j, qp) *
-                 faces_qp_data.JxW(qp);
-            IntS_shapeI_gradshapeJ[f][i][j]
-              += swf(faces_qp_data.QPointXYZ(qp)) *
-                 faces_qp_data.ShapeValue(i, qp) *
-                 faces_qp_data.ShapeGrad(j, qp) *
-                 faces_qp_data.JxW(qp);
-          }// for qp
-        }//for j
+                     IntS_shapeI_shapeJ,         //face M-matrices
+                     IntS_shapeI_gradshapeJ,     //face G-matrices
+                     IntS_shapeI};               //face Si-vectors
+}
+}//namespace
+}//namespace lbs
 
-        for (const auto& qp : faces_qp_data.QuadraturePointIndices())
-        {
-          IntS_shapeI[f][i]
-            += swf(faces_qp_data.QPointXYZ(qp)) *
-               faces_qp_data.ShapeValue(i, qp) * faces_qp_data.JxW(qp);
-        }// for qp
-      }//for i
-    }//for f
-
-    return
-      UnitCellMatrices{IntV_gradshapeI_gradshapeJ, //K-matrix
-                       IntV_shapeI_gradshapeJ,     //G-matrix
-                       IntV_shapeI_shapeJ,         //M-matrix
-                       IntV_shapeI,                //Vi-vectors
-
-                       IntS_shapeI_shapeJ,         //face M-matrices
-                       IntS_shapeI_gradshapeJ,     //face G-matrices
-                       IntS_shapeI};               //face Si-vectors
-  };
+void lbs::LBSSolver::InitializeSpatialDiscretization()
+{
+  namespace fe = chi_math::finite_element;
+  Chi::log.Log() << "Initializing spatial discretization.\n";
+  const auto setup_flags =
+    options_.lean_cell_mappings ? fe::LEAN_CELL_MAPPINGS : fe::NO_FLAGS_SET;
+  discretization_ =
+    chi_math::SpatialDiscretization_PWLD::New(*grid_ptr_, setup_flags);
 
-  const size_t num_local_cells = grid_ptr_->local_cells.size();
-  unit_cell_matrices_.resize(num_local_cells);
+  ComputeUnitIntegrals();
+}
 
-  for (const auto& cell : grid_ptr_->local_cells)
-    unit_cell_matrices_[cell.local_id_] = ComputeCellUnitIntegrals(cell, *swf_ptr);
+void lbs::LBSSolver::ComputeUnitIntegrals()
+{
+  Chi::log.Log() << "Computing unit integrals.\n";
+  const auto& sdm = *discretization_;
+
+  const auto swf_ptr = MakeSpatialWeightFunction(options_.geometry_type);
 
+  //============================================= Local cells, then ghosts
+  const size_t num_local_cells = grid_ptr_->local_cells.size();
   const auto ghost_ids = grid_ptr_->cells.GetGhostGlobalIDs();
+
+  std::vector<const chi_mesh::Cell*> cells;
+  cells.reserve(num_local_cells + ghost_ids.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+    cells.push_back(&cell);
   for (uint64_t ghost_id : ghost_ids)
-    unit_ghost_cell_matrices_[ghost_id] =
-      ComputeCellUnitIntegrals(grid_ptr_->cells[ghost_id],*swf_ptr);
+    cells.push_back(&grid_ptr_->cells[ghost_id]);
+
+  //============================================= Find congruent cells
+  // Cells identical up to a translation have identical matrices, unless
+  // the weighting depends on the position, hence only the first of each
+  // such group of cells is integrated.
+  const bool translation_invariant =
+    options_.geometry_type != lbs::GeometryType::ONED_SPHERICAL and
+    options_.geometry_type != lbs::GeometryType::TWOD_CYLINDRICAL and
+    sdm.GetCoordinateSystemType() == chi_math::CoordinateSystemType::CARTESIAN;
+
+  std::vector<size_t> representatives(cells.size());
+  for (size_t c = 0; c < cells.size(); ++c)
+    representatives[c] = c;
+
+  if (translation_invariant)
+  {
+    const auto [xyz_min, xyz_max] = grid_ptr_->GetLocalBoundingBox();
+    const double diagonal = (xyz_max - xyz_min).Norm();
+    const double quantum = 1.0e-10 * (diagonal > 0.0 ? diagonal : 1.0);
+
+    std::unordered_map<std::vector<int64_t>, size_t,
+                       CellCongruenceKeyHash> first_congruent_cell;
+    for (size_t c = 0; c < cells.size(); ++c)
+    {
+      auto key = MakeCellCongruenceKey(*grid_ptr_, *cells[c], quantum);
+      const auto [it, inserted] = first_congruent_cell.emplace(std::move(key), c);
+      representatives[c] = it->second;
+    }
+  }
+
+  std::vector<size_t> cells_to_integrate;
+  for (size_t c = 0; c < cells.size(); ++c)
+    if (representatives[c] == c) cells_to_integrate.push_back(c);
+
+  Chi::log.Log0Verbose1()
+    << "Integrating " << cells_to_integrate.size() << " of " << cells.size()
+    << " local and ghost cells, the others being congruent.";
+
+  //============================================= Allocate the packed storage
+  std::vector<PackedUnitCellMatrices::CellShape> cell_shapes(cells.size());
+  for (size_t c = 0; c < cells.size(); ++c)
+    cell_shapes[c] = {sdm.GetCellMapping(*cells[c]).NumNodes(),
+                      cells[c]->faces_.size()};
+
+  const std::vector<PackedUnitCellMatrices::CellShape> local_cell_shapes(
+    cell_shapes.begin(), cell_shapes.begin() + num_local_cells);
+  const std::vector<PackedUnitCellMatrices::CellShape> ghost_cell_shapes(
+    cell_shapes.begin() + num_local_cells, cell_shapes.end());
+
+  unit_cell_matrices_.Allocate(local_cell_shapes, ghost_ids, ghost_cell_shapes);
+
+  // Storage index of cell c, local cells first, then ghosts
+  auto StorageIndex = [&](size_t c)
+  {
+    return c < num_local_cells
+             ? c
+             : unit_cell_matrices_.GhostIndex(ghost_ids[c - num_local_cells]);
+  };
+
+  //============================================= Integrate, threaded, directly
+  //                                              into the packed storage
+  const int64_t num_cells_to_integrate =
+    static_cast<int64_t>(cells_to_integrate.size());
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t k = 0; k < num_cells_to_integrate; ++k)
+  {
+    const size_t c = cells_to_integrate[k];
+    unit_cell_matrices_.Set(
+      StorageIndex(c), ComputeCellUnitIntegrals(sdm, *cells[c], *swf_ptr));
+  }
+
+  for (size_t c = 0; c < cells.size(); ++c)
+    if (representatives[c] != c)
+      unit_cell_matrices_.Copy(StorageIndex(c),
+                               StorageIndex(representatives[c]));
 
   //============================================= Assessing global unit cell
   //                                              matrix storage
   std::array<size_t,2> num_local_ucms = {unit_cell_matrices_.size(),
-                                         unit_ghost_cell_matrices_.size()};
+                                         unit_cell_matrices_.NumGhostCells()};
   std::array<size_t,2> num_globl_ucms = {0,0};
 
   MPI_Allreduce(num_local_ucms.data(), //sendbuf
@@ -184,4 +337,84 @@ void lbs::LBSSolver::ComputeUnitIntegrals()
     << "Cell matrices computed.                   Process memory = "
     << std::setprecision(3)
     << chi::Console::GetMemoryUsageInMB() << " MB";
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Updates the solver to vertices that were moved in place, e.g. by mesh
+ * modifiers, without re-initializing it. Only the cells with a moved vertex
+ * get new cell mappings and unit cell matrices, after which the cell
+ * volumes, the point sources and the DSA solvers are brought up to date.
+ *
+ * The sweep orderings and the face orientations of the cell transport views
+ * are kept, hence the motion must neither change the topology of the mesh
+ * nor flip a face with respect to any angle of the quadratures. The
+ * geometry of the grid cells must already be updated, see
+ * chi_mesh::MeshContinuum::RecomputeCellGeometry.*/
+void lbs::LBSSolver::UpdateGeometry(
+  const std::vector<uint64_t>& moved_vertex_ids)
+{
+  ChiLogicalErrorIf(
+    options_.geometry_type == GeometryType::ONED_SPHERICAL or
+    options_.geometry_type == GeometryType::TWOD_CYLINDRICAL,
+    "Geometry updates are not supported for curvilinear geometries.");
+
+  const auto [local_ids, ghost_ids] =
+    grid_ptr_->FindCellsWithVertices(moved_vertex_ids);
+
+  //============================================= Cell mappings
+  discretization_->UpdateCellMappings(local_ids, ghost_ids);
+
+  //============================================= Unit cell matrices
+  const auto& sdm = *discretization_;
+  const auto swf_ptr = MakeSpatialWeightFunction(options_.geometry_type);
+  const bool have_views =
+    cell_transport_views_.size() == grid_ptr_->local_cells.size();
+
+  const auto num_local_ids = static_cast<int64_t>(local_ids.size());
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t k = 0; k < num_local_ids; ++k)
+  {
+    const uint64_t local_id = local_ids[k];
+    const auto& cell = grid_ptr_->local_cells[local_id];
+
+    unit_cell_matrices_.Set(local_id,
+                            ComputeCellUnitIntegrals(sdm, cell, *swf_ptr));
+
+    if (have_views)
+    {
+      const auto cell_matrices = unit_cell_matrices_[local_id];
+      double cell_volume = 0.0;
+      for (size_t i = 0; i < cell_matrices.num_nodes; ++i)
+        cell_volume += cell_matrices.Vi_vectors[i];
+      cell_transport_views_[local_id].SetVolume(cell_volume);
+    }
+  }
+
+  for (const uint64_t ghost_id : ghost_ids)
+    unit_cell_matrices_.Set(
+      unit_cell_matrices_.GhostIndex(ghost_id),
+      ComputeCellUnitIntegrals(sdm, grid_ptr_->cells[ghost_id], *swf_ptr));
+
+  Chi::log.Log0Verbose1()
+    << "Updated the unit cell matrices of " << local_ids.size()
+    << " local and " << ghost_ids.size() << " ghost cells.";
+
+  InitializePointSources();
+
+  //================================================== Update DSA solvers
+  // The solvers reference the unit cell matrices, hence re-assembly suffices
+  for (auto& groupset : groupsets_)
+  {
+    UpdateWGDSA(groupset);
+    UpdateTGDSA(groupset);
+  }
+
+  //================================================== Invalidate recycled
+  //                                                   WGS subspaces
+  for (auto& wgs_solver : wgs_solvers_)
+  {
+    auto wgs_context = std::dynamic_pointer_cast<WGSContext<Mat, Vec, KSP>>(
+      wgs_solver->GetContext());
+    if (wgs_context) wgs_context->ClearRecycledSubspace();
+  }
+}
@@ -5,9 +5,12 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "chi_mpi.h"
+#include "mpi/chi_mpi_commset.h"
 #include "console/chi_console.h"
+#include "utils/chi_worker_threads.h"
 
 #include <iomanip>
+#include <numeric>
 
 // ###################################################################
 /**Initializes parallel arrays.*/
@@ -38,17 +41,32 @@ void lbs::LBSSolver::InitializeParrays()
   Chi::log.LogAllVerbose1()
     << "LBS Number of phi unknowns: " << local_unknown_count;
 
+  //================================================== Group blocks
+  std::vector<std::pair<size_t, size_t>> block_group_ranges;
+  if (options_.flux_moment_layout == FluxMomentLayout::GROUPSET_MAJOR)
+    for (const auto& groupset : groupsets_)
+      block_group_ranges.emplace_back(groupset.groups_.front().id_,
+                                      groupset.groups_.back().id_);
+  flux_moment_blocks_ = FluxMomentBlocks(
+    block_group_ranges, num_grps, num_moments_, local_node_count_);
+
   //================================================== Size local vectors
   q_moments_local_.assign(local_unknown_count, 0.0);
   phi_old_local_.assign(local_unknown_count, 0.0);
   phi_new_local_.assign(local_unknown_count, 0.0);
 
   //============================================= Setup groupset psi vectors
+  for (const int groupset_id : options_.save_angular_flux_groupsets)
+    ChiInvalidArgumentIf(groupset_id < 0 or groupset_id >= groupsets_.size(),
+                         "Invalid groupset id " +
+                           std::to_string(groupset_id) +
+                           " in save_angular_flux_groupsets.");
+
   psi_new_local_.clear();
   for (auto& groupset : groupsets_)
   {
     psi_new_local_.emplace_back();
-    if (options_.save_angular_flux)
+    if (SavesAngularFlux(groupset.id_))
     {
       size_t num_ang_unknowns =
         discretization_->GetNumLocalDOFs(groupset.psi_uk_man_);
@@ -56,6 +74,57 @@ void lbs::LBSSolver::InitializeParrays()
     }
   }
 
+  //============================================= NUMA placement
+  // The vectors are stored cell by cell, in each of their blocks, with
+  // sizes proportional to the number of nodes of the cells, and still
+  // hold zeros.
+  if (options_.numa_first_touch and options_.sweep_num_threads > 1)
+  {
+    std::vector<size_t> cell_num_nodes;
+    cell_num_nodes.reserve(grid_ptr_->local_cells.size());
+    for (const auto& cell : grid_ptr_->local_cells)
+      cell_num_nodes.push_back(discretization_->GetCellNumNodes(cell));
+
+    const auto cell_bounds = chi::WorkerThreads::PartitionByWeight(
+      cell_num_nodes, options_.sweep_num_threads);
+    std::vector<size_t> node_bounds(cell_bounds.size(), 0);
+    for (size_t t = 1; t < cell_bounds.size(); ++t)
+      node_bounds[t] = node_bounds[t - 1] +
+                       std::accumulate(cell_num_nodes.begin() +
+                                         cell_bounds[t - 1],
+                                       cell_num_nodes.begin() + cell_bounds[t],
+                                       size_t(0));
+
+    // Each worker touches its nodes in every block, given by its offset
+    // and node stride.
+    typedef std::vector<std::pair<size_t, size_t>> Blocks;
+    auto FirstTouch = [&node_bounds](std::vector<double>& values,
+                                     const Blocks& blocks)
+    {
+      if (values.empty()) return;
+      std::vector<std::vector<size_t>> block_offsets;
+      for (const auto& [block_offset, node_stride] : blocks)
+      {
+        std::vector<size_t> offsets(node_bounds.size(), 0);
+        for (size_t t = 0; t < node_bounds.size(); ++t)
+          offsets[t] = block_offset + node_bounds[t] * node_stride;
+        block_offsets.push_back(std::move(offsets));
+      }
+      chi::WorkerThreads::FirstTouchZeros(values, block_offsets);
+    };
+
+    Blocks phi_blocks;
+    for (size_t b = 0; b < flux_moment_blocks_.NumBlocks(); ++b)
+      phi_blocks.emplace_back(flux_moment_blocks_.BlockOffset(b),
+                              flux_moment_blocks_.BlockNodeStride(b));
+
+    FirstTouch(q_moments_local_, phi_blocks);
+    FirstTouch(phi_old_local_, phi_blocks);
+    FirstTouch(phi_new_local_, phi_blocks);
+    for (auto& psi : psi_new_local_)
+      FirstTouch(psi, {{0, psi.size() / local_node_count_}});
+  }
+
   //============================================= Setup precursor vector
   if (options_.use_precursors)
   {
@@ -82,7 +151,7 @@ void lbs::LBSSolver::InitializeParrays()
   // amount of nodes on the cell. max_cell_dof_count is
   // initialized here.
   //
-  size_t block_MG_counter = 0; // Counts the strides of moment and group
+  size_t node_counter = 0; // Counts the local nodes of the preceding cells
 
   const chi_mesh::Vector3 ihat(1.0, 0.0, 0.0);
   const chi_mesh::Vector3 jhat(0.0, 1.0, 0.0);
@@ -102,8 +171,6 @@ void lbs::LBSSolver::InitializeParrays()
     for (size_t i = 0; i < num_nodes; ++i)
       cell_volume += IntV_shapeI[i];
 
-    size_t cell_phi_address = block_MG_counter;
-
     const size_t num_faces = cell.faces_.size();
     std::vector<bool> face_local_flags(num_faces, true);
     std::vector<int> face_locality(num_faces, Chi::mpi.location_id);
@@ -137,10 +204,10 @@ void lbs::LBSSolver::InitializeParrays()
       } // if bndry
       else
       {
-        const int neighbor_partition = face.GetNeighborPartitionID(*grid_ptr_);
-        face_local_flags[f] = (neighbor_partition == Chi::mpi.location_id);
-        face_locality[f] = neighbor_partition;
-        neighbor_cell_ptrs[f] = &grid_ptr_->cells[face.neighbor_id_];
+        const auto& neighbor = grid_ptr_->GetFaceNeighborIndex(cell, f);
+        face_local_flags[f] = neighbor.local_id >= 0;
+        face_locality[f] = neighbor.partition_id;
+        neighbor_cell_ptrs[f] = &grid_ptr_->FaceNeighbor(cell, f);
       }
 
       ++f;
@@ -148,7 +215,8 @@ void lbs::LBSSolver::InitializeParrays()
 
     if (num_nodes > max_cell_dof_count_) max_cell_dof_count_ = num_nodes;
 
-    cell_transport_views_.emplace_back(cell_phi_address,
+    cell_transport_views_.emplace_back(node_counter,
+                                       flux_moment_blocks_,
                                        num_nodes,
                                        num_grps,
                                        num_moments_,
@@ -158,7 +226,7 @@ void lbs::LBSSolver::InitializeParrays()
                                        face_locality,
                                        neighbor_cell_ptrs,
                                        cell_on_boundary);
-    block_MG_counter += num_nodes * num_grps * num_moments_;
+    node_counter += num_nodes;
   } // for local cell
 
   //================================================== Populate grid nodal
@@ -195,6 +263,13 @@ void lbs::LBSSolver::InitializeParrays()
   //                                                   communicator set
   grid_local_comm_set_ = grid_ptr_->MakeMPILocalCommunicatorSet();
 
+  //================================================== Store the quadrature
+  //                                                   operators per node
+  if (options_.node_shared_quadrature)
+    for (auto& groupset : groupsets_)
+      groupset.quadrature_->ShareDirectionOperatorsOnNode(
+        grid_local_comm_set_->NodeCommunicator());
+
   //================================================== Make face histogram
   grid_face_histogram_ = grid_ptr_->MakeGridFaceHistogram();
 
@@ -7,12 +7,34 @@
 namespace lbs
 {
 
+/**Creates the flux moment and power generation field functions. Their
+ * field vectors are only allocated when read, and they share the ghost
+ * communicator of the first one, hence creating a field function for every
+ * group and moment is cheap even when most are never used.*/
 void LBSSolver::InitializeFieldFunctions()
 {
   using namespace chi_math;
+  typedef chi_physics::FieldFunctionGridBased FFGridBased;
 
   if (not field_functions_.empty()) return;
 
+  FFGridBased::VectorGhostCommPtr ghost_communicator;
+  auto MakeScalarFieldFunction = [this, &ghost_communicator](
+                                   const std::string& text_name)
+  {
+    auto ff =
+      ghost_communicator
+        ? std::make_shared<FFGridBased>(text_name,
+                                        discretization_,
+                                        Unknown(UnknownType::SCALAR),
+                                        ghost_communicator)
+        : std::make_shared<FFGridBased>(text_name,
+                                        discretization_,
+                                        Unknown(UnknownType::SCALAR));
+    ghost_communicator = ff->GetGhostCommunicator();
+    return ff;
+  };
+
   //============================================= Initialize Field Functions
   //                                              for flux moments
   phi_field_functions_local_map_.clear();
@@ -39,10 +61,7 @@ void LBSSolver::InitializeFieldFunctions()
                static_cast<int>(m));
       const std::string text_name = std::string(buff);
 
-      auto group_ff = std::make_shared<chi_physics::FieldFunctionGridBased>(
-        text_name,                     // Field name
-        discretization_,               // Spatial discretization
-        Unknown(UnknownType::SCALAR)); // Unknown/Variable
+      auto group_ff = MakeScalarFieldFunction(text_name);
 
       Chi::field_function_stack.push_back(group_ff);
       field_functions_.push_back(group_ff);
@@ -64,10 +83,7 @@ void LBSSolver::InitializeFieldFunctions()
     if (options_.field_function_prefix_option == "solver_name")
       prefix = TextName() + "_";
 
-    auto power_ff = std::make_shared<chi_physics::FieldFunctionGridBased>(
-      prefix + "power_generation", // Field name
-      discretization_,                  // Spatial discretization
-      Unknown(UnknownType::SCALAR));    // Unknown/Variable
+    auto power_ff = MakeScalarFieldFunction(prefix + "power_generation");
 
     Chi::field_function_stack.push_back(power_ff);
     field_functions_.push_back(power_ff);
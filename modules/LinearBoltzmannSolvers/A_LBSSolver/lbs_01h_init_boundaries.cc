@@ -1,10 +1,14 @@
 #include "lbs_solver.h"
 
 #include "Tools/lbs_bndry_func_lua.h"
+#include "Tools/lbs_bndry_func_registry.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <sstream>
 
 #define mk_shrd(x) std::make_shared<x>
 #define SweepVaccuumBndry \
@@ -26,8 +30,48 @@ std::logic_error(fname + ": Not all face normals are," \
 " within tolerance, globally the same for the reflecting boundary" \
 " condition requested.")
 
+namespace
+{
 //###################################################################
-/**Initializes transport related boundaries. */
+/**Makes an incident anisotropic heterogeneous boundary, evaluating the
+ * C++ function registered under the function name of the preference, if
+ * any, or else the lua function of that name. The previous boundary is
+ * returned instead when it was made from the same function, keeping its
+ * evaluated fluxes.*/
+std::shared_ptr<SweepAniHeteroBndry> MakeHeterogeneousBoundary(
+  size_t num_groups,
+  uint64_t bid,
+  const lbs::BoundaryPreference& bndry_pref,
+  const std::shared_ptr<chi_mesh::sweep_management::SweepBoundary>& previous)
+{
+  const auto& name = bndry_pref.source_function;
+  auto function = lbs::GetRegisteredBoundaryFunction(name);
+
+  std::stringstream key;
+  if (function) key << "registered:" << name << ":" << function.get();
+  else
+  {
+    key << "lua:" << name << (bndry_pref.batched_function ? ":batched" : "");
+    function = std::make_shared<lbs::BoundaryFunctionToLua>(
+      name, bndry_pref.batched_function);
+  }
+
+  auto previous_hetero =
+    std::dynamic_pointer_cast<SweepAniHeteroBndry>(previous);
+  if (previous_hetero and previous_hetero->FunctionKey() == key.str())
+    return previous_hetero;
+
+  auto bndry =
+    mk_shrd(SweepAniHeteroBndry)(num_groups, std::move(function), bid);
+  bndry->SetFunctionKey(key.str());
+  return bndry;
+}
+} // namespace
+
+//###################################################################
+/**Initializes transport related boundaries. Heterogeneous boundaries made
+ * from the same function as before are kept, such that re-initializing a
+ * solver does not evaluate their functions again. */
 void lbs::LBSSolver::InitializeBoundaries()
 {
   const std::string fname = "lbs::LBSSolver::InitializeBoundaries";
@@ -83,6 +127,7 @@ void lbs::LBSSolver::InitializeBoundaries()
   //                                                   incident boundary
   const size_t G = num_groups_;
 
+  auto previous_boundaries = std::move(sweep_boundaries_);
   sweep_boundaries_.clear();
   for (uint64_t bid : globl_unique_bids_set)
   {
@@ -103,9 +148,11 @@ void lbs::LBSSolver::InitializeBoundaries()
         sweep_boundaries_[bid] = mk_shrd(SweepIncHomoBndry)(G, mg_q);
       else if (bndry_pref.type == BoundaryType::INCIDENT_ANISTROPIC_HETEROGENEOUS)
       {
-        sweep_boundaries_[bid] = mk_shrd(SweepAniHeteroBndry)(G,
-          std::make_unique<BoundaryFunctionToLua>(bndry_pref.source_function),
-          bid);
+        const auto previous_it = previous_boundaries.find(bid);
+        sweep_boundaries_[bid] = MakeHeterogeneousBoundary(
+          G, bid, bndry_pref,
+          previous_it != previous_boundaries.end() ? previous_it->second
+                                                   : nullptr);
       }
       else if (bndry_pref.type == lbs::BoundaryType::REFLECTING)
       {
@@ -165,4 +212,63 @@ void lbs::LBSSolver::InitializeBoundaries()
       }
     }//non-defaulted
   }//for bndry id
-}
\ No newline at end of file
+
+  for (const auto& [bid, bndry] : sweep_boundaries_)
+    ApplyBoundaryTimeTable(bid);
+}
+//###################################################################
+/**Rebuilds the non-reflecting sweep boundaries from the current boundary
+ * preferences, e.g. after changing an incident source with chiLBSSetOptions,
+ * keeping the sweep structures and the iterative and DSA solvers. Whether a
+ * boundary is reflecting cannot change, since reflecting boundaries are part
+ * of the sweep structures, and the DSA boundary conditions only depend on
+ * it. Heterogeneous boundaries are always made anew, evaluating their
+ * functions again, since what they depend on may have changed.*/
+void lbs::LBSSolver::UpdateBoundaries()
+{
+  const std::string fname = "lbs::LBSSolver::UpdateBoundaries";
+  const size_t G = num_groups_;
+
+  //================================================== Rebuild boundaries
+  for (auto& [bid, bndry] : sweep_boundaries_)
+  {
+    const auto pref_it = boundary_preferences_.find(bid);
+    const bool has_preference = pref_it != boundary_preferences_.end();
+    const bool to_reflecting =
+      has_preference and pref_it->second.type == BoundaryType::REFLECTING;
+
+    ChiInvalidArgumentIf(to_reflecting != bndry->IsReflecting(),
+                         fname + ": Boundary " + std::to_string(bid) +
+                           " cannot change from or to reflecting without "
+                           "re-initializing the solver.");
+    if (bndry->IsReflecting()) continue;
+
+    if (not has_preference or pref_it->second.type == BoundaryType::VACUUM)
+      bndry = mk_shrd(SweepVaccuumBndry)(G);
+    else if (pref_it->second.type == BoundaryType::INCIDENT_ISOTROPIC)
+      bndry = mk_shrd(SweepIncHomoBndry)(G,
+                                         pref_it->second.isotropic_mg_source);
+    else if (pref_it->second.type ==
+             BoundaryType::INCIDENT_ANISTROPIC_HETEROGENEOUS)
+      bndry = MakeHeterogeneousBoundary(G, bid, pref_it->second, nullptr);
+
+    ApplyBoundaryTimeTable(bid);
+  }//for bndry id
+
+  //================================================== Pass the boundaries to
+  //                                                   the angle aggregations
+  // Boundaries are set up for the quadrature of every groupset, as when the
+  // angle aggregations are constructed
+  for (auto& groupset : groupsets_)
+  {
+    if (not groupset.angle_agg_) continue;
+    for (auto& [bid, bndry] : groupset.angle_agg_->sim_boundaries)
+    {
+      const auto& new_bndry = sweep_boundaries_.at(bid);
+      if (new_bndry == bndry) continue;
+
+      new_bndry->Setup(*grid_ptr_, *groupset.quadrature_);
+      bndry = new_bndry;
+    }
+  }
+}
@@ -5,7 +5,8 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 
-/**Intializes all point sources.*/
+/**Intializes all point sources, and their first-collision source if
+ * used.*/
 void lbs::LBSSolver::InitializePointSources()
 {
   const std::string fname = "InitializePointSources";
@@ -38,12 +39,12 @@ void lbs::LBSSolver::InitializePointSources()
         cell_view.ShapeValues(point_source.Location(),
                               shape_values/**ByRef*/);
 
-        const auto M_inv = chi_math::Inverse(M);
+        const auto M_inv = chi_math::Inverse(M.ToNested());
 
         const auto q_p_weights = chi_math::MatMul(M_inv, shape_values);
 
         double v_cell = 0.0;
-        for (double val : I) v_cell += val;
+        for (size_t i = 0; i < cell_matrices.num_nodes; ++i) v_cell += I[i];
         v_total += v_cell;
 
         temp_list.push_back(
@@ -60,10 +61,10 @@ void lbs::LBSSolver::InitializePointSources()
       const auto& neighbor_cell = grid_ptr_->cells[ghost_global_id];
       if (grid_ptr_->CheckPointInsideCell(neighbor_cell, p))
       {
-        const auto& cell_matrices =
-          unit_ghost_cell_matrices_[neighbor_cell.global_id_];
-        for (double val : cell_matrices.Vi_vectors)
-          v_total += val;
+        const auto cell_matrices =
+          unit_cell_matrices_.Ghost(neighbor_cell.global_id_);
+        for (size_t i = 0; i < cell_matrices.num_nodes; ++i)
+          v_total += cell_matrices.Vi_vectors[i];
       }//if point inside
     }//for ghost cell
 
@@ -87,4 +88,6 @@ void lbs::LBSSolver::InitializePointSources()
       }
     }//for info in temp list
   }//for point_source
+
+  InitializeFirstCollisionSource();
 }
\ No newline at end of file
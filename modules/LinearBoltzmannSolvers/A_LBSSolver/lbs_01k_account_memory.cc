@@ -0,0 +1,51 @@
+#include "lbs_solver.h"
+
+#include "A_LBSSolver/Acceleration/diffusion_mip.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "utils/chi_memory_accounting.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+//###################################################################
+void lbs::LBSSolver::AccountMemoryUsage() const
+{
+  using chi::VectorMemoryUsage;
+  auto& accounting = chi::MemoryAccounting::GetInstance();
+
+  if (grid_ptr_) accounting.SetUsage("Mesh", grid_ptr_->GetMemoryUsage());
+  if (discretization_)
+    accounting.SetUsage("Spatial discretization",
+                        discretization_->GetMemoryUsage());
+
+  size_t xs_bytes = 0;
+  for (const auto& [mat_id, xs] : matid_to_xs_map_)
+    if (xs) xs_bytes += xs->GetMemoryUsage();
+  accounting.SetUsage("Cross sections", xs_bytes);
+
+  accounting.SetUsage("LBS vectors",
+                      VectorMemoryUsage(q_moments_local_) +
+                        VectorMemoryUsage(ext_src_moments_local_) +
+                        VectorMemoryUsage(phi_new_local_) +
+                        VectorMemoryUsage(phi_old_local_) +
+                        VectorMemoryUsage(psi_new_local_) +
+                        VectorMemoryUsage(precursor_new_local_));
+
+  size_t dsa_bytes = 0;
+  for (const auto& groupset : groupsets_)
+  {
+    if (groupset.wgdsa_solver_)
+      dsa_bytes += groupset.wgdsa_solver_->GetMemoryUsage();
+    if (groupset.tgdsa_solver_)
+      dsa_bytes += groupset.tgdsa_solver_->GetMemoryUsage();
+  }
+  accounting.SetUsage("DSA matrices", dsa_bytes);
+}
+
+//###################################################################
+/**Meant to be called at the end of the initialization of the solvers.*/
+void lbs::LBSSolver::LogMemoryUsage() const
+{
+  AccountMemoryUsage();
+  chi::MemoryAccounting::GetInstance().LogReport(TextName());
+}
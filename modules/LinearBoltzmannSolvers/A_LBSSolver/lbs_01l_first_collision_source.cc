@@ -0,0 +1,233 @@
+#include "lbs_solver.h"
+
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/Raytrace/batched_raytracer.h"
+#include "math/Quadratures/LegendrePoly/legendrepoly.h"
+#include "mpi/chi_mpi_utils_map_all2all.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+//###################################################################
+/**Computes the uncollided flux moments of every point source, for a unit
+ * strength in every group, when the first-collision source is used.
+ *
+ * A ray is traced from every volumetric quadrature point of the local cells
+ * to the source, accumulating the optical depths of the groups. The
+ * uncollided angular flux at a point is a delta in the direction from the
+ * source, of scalar flux \f$ e^{-\tau_g}/(4\pi r^2) \f$, hence its moments
+ * are that flux times the spherical harmonics of the direction. These are
+ * projected onto the nodes with the mass matrices of the cells. Rays
+ * leaving the domain are taken as blocked, the domain being surrounded by
+ * vacuum. Collective.*/
+void lbs::LBSSolver::InitializeFirstCollisionSource()
+{
+  point_source_uncollided_phi_local_.clear();
+  uncollided_phi_local_.clear();
+  if (not options_.use_first_collision_source or point_sources_.empty())
+    return;
+
+  ChiLogicalErrorIf(options_.geometry_type != GeometryType::THREED_CARTESIAN,
+                    "The first-collision source is only available in 3D "
+                    "cartesian geometry.");
+  ChiLogicalErrorIf(groupsets_.empty(),
+                    "The first-collision source requires the groupsets "
+                    "to be initialized.");
+
+  const auto& grid = *grid_ptr_;
+  const size_t num_groups = num_groups_;
+  const size_t num_moments = num_moments_;
+  const auto& m_to_ell_em_map =
+    groupsets_.front().quadrature_->GetMomentToHarmonicsIndexMap();
+
+  const chi_mesh::BatchedRayTracer ray_tracer(grid);
+  const chi_mesh::BatchedRayTracer::SegmentFunction AccumulateOpticalDepth =
+    [this, num_groups](chi_mesh::BatchRay& ray,
+                       const chi_mesh::Cell& cell,
+                       double length)
+  {
+    const auto& sigma_t =
+      cell_transport_views_[cell.local_id_].XS().SigmaTotal();
+    for (size_t g = 0; g < num_groups; ++g)
+      ray.values[g] += sigma_t[g] * length;
+  };
+
+  size_t num_rays = 0;
+  for (const auto& point_source : point_sources_)
+  {
+    const auto& p = point_source.Location();
+
+    //============================================= Make the rays from the
+    //                                              quadrature points
+    // Quadrature points at the source itself are skipped
+    std::vector<chi_mesh::BatchRay> rays;
+    uint64_t qp_count = 0;
+    for (const auto& cell : grid.local_cells)
+    {
+      const auto qp_data =
+        discretization_->GetCellMapping(cell).MakeVolumeQuadraturePointData();
+      for (const unsigned int qp : qp_data.QuadraturePointIndices())
+      {
+        const auto x = qp_data.QPointXYZ(qp);
+        const double r = (p - x).Norm();
+        if (r > 1.0e-12)
+        {
+          chi_mesh::BatchRay ray;
+          ray.position = x;
+          ray.omega = (p - x) / r;
+          ray.distance_left = r;
+          ray.cell_global_id = cell.global_id_;
+          ray.id = qp_count;
+          ray.values.assign(num_groups, 0.0);
+          rays.push_back(std::move(ray));
+        }
+        ++qp_count;
+      }
+    }//for cell
+    num_rays += rays.size();
+
+    //============================================= Trace and return the
+    //                                              optical depths
+    // Per quadrature point, a negative depth marks a blocked or skipped
+    // point
+    std::vector<double> optical_depths(qp_count * num_groups, -1.0);
+    {
+      const auto ended_rays =
+        ray_tracer.Trace(std::move(rays), AccumulateOpticalDepth);
+
+      std::map<int, std::vector<double>> outgoing;
+      for (const auto& ray : ended_rays)
+      {
+        if (ray.left_domain) continue;
+        auto& buffer = outgoing[ray.origin_location];
+        buffer.push_back(static_cast<double>(ray.id));
+        buffer.insert(buffer.end(), ray.values.begin(), ray.values.end());
+      }
+
+      const auto incoming = chi_mpi_utils::MapAllToAll(outgoing, MPI_DOUBLE);
+      for (const auto& [pid, buffer] : incoming)
+        for (size_t k = 0; k < buffer.size(); k += num_groups + 1)
+        {
+          const auto id = static_cast<uint64_t>(buffer[k]);
+          std::copy(&buffer[k + 1], &buffer[k + 1] + num_groups,
+                    &optical_depths[id * num_groups]);
+        }
+    }
+
+    //============================================= Project the uncollided
+    //                                              flux moments
+    std::vector<double> unit_phi(phi_new_local_.size(), 0.0);
+    std::vector<double> ylm(num_moments, 0.0);
+    qp_count = 0;
+    for (const auto& cell : grid.local_cells)
+    {
+      const auto& transport_view = cell_transport_views_[cell.local_id_];
+      const auto qp_data =
+        discretization_->GetCellMapping(cell).MakeVolumeQuadraturePointData();
+      const size_t num_nodes = transport_view.NumNodes();
+      const size_t block_size = num_moments * num_groups;
+
+      // Per node i, moment m and group g at (i*num_moments + m)*G + g
+      std::vector<double> rhs(num_nodes * block_size, 0.0);
+      for (const unsigned int qp : qp_data.QuadraturePointIndices())
+      {
+        const double* tau = &optical_depths[qp_count * num_groups];
+        ++qp_count;
+        if (tau[0] < 0.0) continue;
+
+        const auto omega = qp_data.QPointXYZ(qp) - p;
+        const double r = omega.Norm();
+        const double theta = std::acos(std::max(-1.0,
+                                                std::min(1.0, omega.z / r)));
+        double varphi = std::atan2(omega.y, omega.x);
+        if (varphi < 0.0) varphi += 2.0 * M_PI;
+        for (size_t m = 0; m < num_moments; ++m)
+          ylm[m] = chi_math::Ylm(m_to_ell_em_map[m].ell,
+                                 m_to_ell_em_map[m].m, varphi, theta);
+
+        const double geometric = 1.0 / (4.0 * M_PI * r * r);
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+          const double w = qp_data.ShapeValue(i, qp) * qp_data.JxW(qp);
+          for (size_t m = 0; m < num_moments; ++m)
+            for (size_t g = 0; g < num_groups; ++g)
+              rhs[i * block_size + m * num_groups + g] +=
+                w * ylm[m] * geometric * std::exp(-tau[g]);
+        }
+      }//for qp
+
+      const auto M_inv = chi_math::Inverse(
+        unit_cell_matrices_[cell.local_id_].M_matrix.ToNested());
+      for (size_t i = 0; i < num_nodes; ++i)
+        for (size_t m = 0; m < num_moments; ++m)
+          for (size_t g = 0; g < num_groups; ++g)
+          {
+            double& phi = unit_phi[transport_view.MapDOF(i, m, g)];
+            for (size_t j = 0; j < num_nodes; ++j)
+              phi += M_inv[i][j] * rhs[j * block_size + m * num_groups + g];
+          }
+    }//for cell
+
+    point_source_uncollided_phi_local_.push_back(std::move(unit_phi));
+  }//for point_source
+
+  uint64_t global_num_rays = 0;
+  const uint64_t local_num_rays = num_rays;
+  MPI_Allreduce(&local_num_rays, &global_num_rays, 1, MPI_UINT64_T,
+                MPI_SUM, Chi::mpi.comm);
+  Chi::log.Log() << TextName() << ": First-collision source of "
+                 << point_sources_.size() << " point source(s) computed "
+                 << "from " << global_num_rays << " rays.";
+
+  UpdateUncollidedFlux();
+}
+
+//###################################################################
+/**Sums the uncollided flux moments of the point sources at their
+ * strengths at the evaluation time. They are cleared when the point
+ * sources have changed since the first-collision source was computed.*/
+void lbs::LBSSolver::UpdateUncollidedFlux()
+{
+  if (point_source_uncollided_phi_local_.size() != point_sources_.size())
+  {
+    point_source_uncollided_phi_local_.clear();
+    uncollided_phi_local_.clear();
+    return;
+  }
+  if (point_source_uncollided_phi_local_.empty()) return;
+
+  uncollided_phi_local_.assign(phi_new_local_.size(), 0.0);
+  for (size_t s = 0; s < point_sources_.size(); ++s)
+  {
+    const auto& strength = point_sources_[s].Strength();
+    const auto& unit_phi = point_source_uncollided_phi_local_[s];
+    for (const auto& transport_view : cell_transport_views_)
+    {
+      const int num_nodes = transport_view.NumNodes();
+      for (int i = 0; i < num_nodes; ++i)
+        for (size_t m = 0; m < num_moments_; ++m)
+          for (size_t g = 0; g < num_groups_; ++g)
+          {
+            const size_t uk_map = transport_view.MapDOF(i, m, g);
+            uncollided_phi_local_[uk_map] += strength[g] * unit_phi[uk_map];
+          }
+    }
+  }//for point source
+}
+
+//###################################################################
+/**Adds the uncollided flux moments to the flux moments, which then hold
+ * the total flux, the solve only yielding the collided flux with a
+ * first-collision source.*/
+void lbs::LBSSolver::AddUncollidedFlux()
+{
+  if (uncollided_phi_local_.empty()) return;
+
+  for (size_t k = 0; k < uncollided_phi_local_.size(); ++k)
+  {
+    phi_old_local_[k] += uncollided_phi_local_[k];
+    phi_new_local_[k] += uncollided_phi_local_[k];
+  }
+}
@@ -44,6 +44,12 @@ void lbs::LBSSolver::InitWGDSA(LBSGroupset& groupset,
     solver->options.max_iters = groupset.wgdsa_max_iters_;
     solver->options.verbose = groupset.wgdsa_verbose_;
     solver->options.additional_options_string = groupset.wgdsa_string_;
+    solver->options.pc_reuse_max_solves = groupset.dsa_pc_reuse_max_solves_;
+    solver->options.pc_reuse_tolerance = groupset.dsa_pc_reuse_tol_;
+    solver->options.matrix_free = groupset.dsa_matrix_free_;
+    solver->options.pipelined = groupset.dsa_pipelined_;
+    solver->options.device_backend = groupset.dsa_device_backend_;
+    solver->options.use_component_blocks = groupset.wgdsa_group_blocks_;
 
     solver->Initialize();
 
@@ -55,6 +61,26 @@ void lbs::LBSSolver::InitWGDSA(LBSGroupset& groupset,
   }
 }
 
+// ###################################################################
+/**Updates the Within-Group DSA solver for the current cross sections,
+ * keeping the solver and, depending on the reuse policy, its
+ * preconditioner.*/
+void lbs::LBSSolver::UpdateWGDSA(LBSGroupset& groupset)
+{
+  if (not groupset.apply_wgdsa_) return;
+
+  if (not groupset.wgdsa_solver_)
+  {
+    InitWGDSA(groupset);
+    return;
+  }
+
+  groupset.wgdsa_solver_->UpdateXSs(
+    acceleration::PackGroupsetXS(matid_to_xs_map_,
+                                 groupset.groups_.front().id_,
+                                 groupset.groups_.back().id_));
+}
+
 // ###################################################################
 /**Cleans up memory consuming items. */
 void lbs::LBSSolver::CleanUpWGDSA(LBSGroupset& groupset)
@@ -71,7 +97,6 @@ lbs::LBSSolver::WGSCopyOnlyPhi0(const LBSGroupset& groupset,
 {
   const auto& sdm = *discretization_;
   const auto& dphi_uk_man = groupset.wgdsa_solver_->UnknownStructure();
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -86,7 +111,8 @@ lbs::LBSSolver::WGSCopyOnlyPhi0(const LBSGroupset& groupset,
     for (size_t i = 0; i < num_nodes; i++)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i, dphi_uk_man, 0, 0);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      const int64_t phi_map =
+        cell_transport_views_[cell.local_id_].MapDOF(i, 0, gsi);
 
       double* output_mapped = &output_phi_local[dphi_map];
       const double* phi_in_mapped = &phi_in[phi_map];
@@ -110,7 +136,6 @@ void lbs::LBSSolver::GSProjectBackPhi0(const LBSGroupset& groupset,
 {
   const auto& sdm = *discretization_;
   const auto& dphi_uk_man = groupset.wgdsa_solver_->UnknownStructure();
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -123,7 +148,8 @@ void lbs::LBSSolver::GSProjectBackPhi0(const LBSGroupset& groupset,
     for (size_t i = 0; i < num_nodes; i++)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i, dphi_uk_man, 0, 0);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      const int64_t phi_map =
+        cell_transport_views_[cell.local_id_].MapDOF(i, 0, gsi);
 
       const double* input_mapped = &input[dphi_map];
       double* output_mapped = &output[phi_map];
@@ -143,7 +169,6 @@ void lbs::LBSSolver::AssembleWGDSADeltaPhiVector(
 {
   const auto& sdm = *discretization_;
   const auto& dphi_uk_man = groupset.wgdsa_solver_->UnknownStructure();
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -160,7 +185,8 @@ void lbs::LBSSolver::AssembleWGDSADeltaPhiVector(
     for (size_t i = 0; i < num_nodes; i++)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i, dphi_uk_man, 0, 0);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      const int64_t phi_map =
+        cell_transport_views_[cell.local_id_].MapDOF(i, 0, gsi);
 
       double* delta_phi_mapped = &delta_phi_local[dphi_map];
       const double* phi_in_mapped = &phi_in[phi_map];
@@ -182,7 +208,6 @@ void lbs::LBSSolver::DisAssembleWGDSADeltaPhiVector(
 {
   const auto& sdm = *discretization_;
   const auto& dphi_uk_man = groupset.wgdsa_solver_->UnknownStructure();
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -195,7 +220,8 @@ void lbs::LBSSolver::DisAssembleWGDSADeltaPhiVector(
     for (size_t i = 0; i < num_nodes; i++)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i, dphi_uk_man, 0, 0);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      const int64_t phi_map =
+        cell_transport_views_[cell.local_id_].MapDOF(i, 0, gsi);
 
       const double* delta_phi_mapped = &delta_phi_local[dphi_map];
       double* phi_new_mapped = &ref_phi_new[phi_map];
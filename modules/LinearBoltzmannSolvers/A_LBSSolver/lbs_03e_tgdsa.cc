@@ -18,35 +18,8 @@ void lbs::LBSSolver::InitTGDSA(LBSGroupset& groupset)
     //=========================================== Make boundary conditions
     auto bcs = acceleration::TranslateBCs(sweep_boundaries_);
 
-    //=========================================== Make TwoGridInfo
-     for (const auto& mat_id_xs_pair : matid_to_xs_map_)
-    {
-       const auto& mat_id = mat_id_xs_pair.first;
-       const auto& xs     = mat_id_xs_pair.second;
-
-       acceleration::TwoGridCollapsedInfo tginfo =
-         MakeTwoGridCollapsedInfo(*xs,
-         acceleration::EnergyCollapseScheme::JFULL);
-
-       groupset.tg_acceleration_info_.map_mat_id_2_tginfo.insert(
-         std::make_pair(mat_id, std::move(tginfo)));
-     }
-
     //=========================================== Make xs map
-     typedef lbs::acceleration::Multigroup_D_and_sigR MGXS;
-     typedef std::map<int, MGXS> MatID2MGDXSMap;
-     MatID2MGDXSMap matid_2_mgxs_map;
-     for (const auto& matid_xs_pair : matid_to_xs_map_)
-    {
-       const auto& mat_id = matid_xs_pair.first;
-
-       const auto& tg_info =
-         groupset.tg_acceleration_info_.map_mat_id_2_tginfo.at(mat_id);
-
-       matid_2_mgxs_map.insert(
-         std::make_pair(mat_id, MGXS{{tg_info.collapsed_D},
-                                     {tg_info.collapsed_sig_a}}));
-     }
+    auto matid_2_mgxs_map = PackTGDSAXS(groupset);
 
     //=========================================== Create solver
     const auto& sdm = *discretization_;
@@ -64,6 +37,11 @@ void lbs::LBSSolver::InitTGDSA(LBSGroupset& groupset)
     solver->options.max_iters = groupset.tgdsa_max_iters_;
     solver->options.verbose = groupset.tgdsa_verbose_;
     solver->options.additional_options_string = groupset.tgdsa_string_;
+    solver->options.pc_reuse_max_solves = groupset.dsa_pc_reuse_max_solves_;
+    solver->options.pc_reuse_tolerance = groupset.dsa_pc_reuse_tol_;
+    solver->options.matrix_free = groupset.dsa_matrix_free_;
+    solver->options.pipelined = groupset.dsa_pipelined_;
+    solver->options.device_backend = groupset.dsa_device_backend_;
 
     solver->Initialize();
 
@@ -75,6 +53,52 @@ void lbs::LBSSolver::InitTGDSA(LBSGroupset& groupset)
   }
 }
 
+// ###################################################################
+/**Computes the two-grid collapsed data of the materials and returns the
+ * collapsed diffusion coefficients and absorption cross sections.*/
+std::map<int, lbs::acceleration::Multigroup_D_and_sigR>
+lbs::LBSSolver::PackTGDSAXS(LBSGroupset& groupset)
+{
+  //=========================================== Make TwoGridInfo
+  auto& map_mat_id_2_tginfo =
+    groupset.tg_acceleration_info_.map_mat_id_2_tginfo;
+  map_mat_id_2_tginfo = acceleration::MakeTwoGridCollapsedInfos(
+    matid_to_xs_map_, acceleration::EnergyCollapseScheme::JFULL);
+
+  //=========================================== Make xs map
+  typedef lbs::acceleration::Multigroup_D_and_sigR MGXS;
+  typedef std::map<int, MGXS> MatID2MGDXSMap;
+  MatID2MGDXSMap matid_2_mgxs_map;
+  for (const auto& matid_xs_pair : matid_to_xs_map_)
+  {
+    const auto& mat_id = matid_xs_pair.first;
+
+    const auto& tg_info = map_mat_id_2_tginfo.at(mat_id);
+
+    matid_2_mgxs_map.insert(
+      std::make_pair(mat_id, MGXS{{tg_info.collapsed_D},
+                                  {tg_info.collapsed_sig_a}}));
+  }
+
+  return matid_2_mgxs_map;
+}
+
+// ###################################################################
+/**Updates the Two-Grid DSA solver for the current cross sections, keeping
+ * the solver and, depending on the reuse policy, its preconditioner.*/
+void lbs::LBSSolver::UpdateTGDSA(LBSGroupset& groupset)
+{
+  if (not groupset.apply_tgdsa_) return;
+
+  if (not groupset.tgdsa_solver_)
+  {
+    InitTGDSA(groupset);
+    return;
+  }
+
+  groupset.tgdsa_solver_->UpdateXSs(PackTGDSAXS(groupset));
+}
+
 // ###################################################################
 /**Cleans up memory consuming items. */
 void lbs::LBSSolver::CleanUpTGDSA(LBSGroupset& groupset)
@@ -90,7 +114,6 @@ void lbs::LBSSolver::AssembleTGDSADeltaPhiVector(
   std::vector<double>& delta_phi_local)
 {
   const auto& sdm = *discretization_;
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -98,6 +121,7 @@ void lbs::LBSSolver::AssembleTGDSADeltaPhiVector(
   delta_phi_local.clear();
   delta_phi_local.assign(local_node_count_, 0.0);
 
+  std::vector<double> phi_scratch;
   for (const auto& cell : grid_ptr_->local_cells)
   {
     const auto& cell_mapping = sdm.GetCellMapping(cell);
@@ -107,10 +131,11 @@ void lbs::LBSSolver::AssembleTGDSADeltaPhiVector(
     for (size_t i = 0; i < num_nodes; ++i)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, 0);
 
       double& delta_phi_mapped = delta_phi_local[dphi_map];
-      const double* phi_in_mapped = &phi_in[phi_map];
+      const double* phi_in_mapped =
+        cell_transport_views_[cell.local_id_].GroupValues(
+          phi_in, static_cast<int>(i), 0, phi_scratch);
 
       for (size_t g = 0; g < gss; ++g)
       {
@@ -133,7 +158,6 @@ void lbs::LBSSolver::DisAssembleTGDSADeltaPhiVector(
   std::vector<double>& ref_phi_new)
 {
   const auto& sdm = *discretization_;
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -151,7 +175,8 @@ void lbs::LBSSolver::DisAssembleTGDSADeltaPhiVector(
     for (size_t i = 0; i < num_nodes; ++i)
     {
       const int64_t dphi_map = sdm.MapDOFLocal(cell, i);
-      const int64_t phi_map = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      const int64_t phi_map =
+        cell_transport_views_[cell.local_id_].MapDOF(i, 0, gsi);
 
       const double delta_phi_mapped = delta_phi_local[dphi_map];
       double* phi_new_mapped = &ref_phi_new[phi_map];
@@ -1,21 +1,203 @@
 #include "lbs_solver.h"
 
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum_cellidmap.h"
+
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "chi_mpi.h"
+#include "chi_mpi_utils_map_all2all.h"
 
 #include <sys/stat.h>
+#include <algorithm>
 #include <fstream>
 #include <cstring>
+#include <future>
+
+namespace
+{
+/**Marks the restart file format keyed by cell global ids.*/
+const uint64_t RESTART_FILE_MAGIC = 0x3230545352534C42; //"LBSRST02"
+
+/**Indices into the restart file header.*/
+enum RestartHeaderEntry : size_t
+{
+  HEADER_MAGIC          = 0,
+  HEADER_NUM_FILES      = 1,
+  HEADER_NUM_MOMENTS    = 2,
+  HEADER_NUM_GROUPS     = 3,
+  HEADER_NUM_PSI_GS     = 4,
+  HEADER_NUM_PRECURSORS = 5,
+  HEADER_NUM_CELLS      = 6,
+  HEADER_SIZE           = 7
+};
+
+/**The content of a single restart file. The values of cell `c` are
+ * `counts[c]` consecutive entries of `values`.*/
+struct RestartData
+{
+  std::vector<uint64_t> header = std::vector<uint64_t>(HEADER_SIZE, 0);
+  std::vector<uint64_t> cell_global_ids;
+  std::vector<uint64_t> counts;
+  std::vector<double>   values;
+};
 
 //###################################################################
-/**Writes phi_old to restart file.*/
+/**Writes restart data to a file, with each part written as one block.*/
+bool WriteRestartFile(const std::string& file_name, const RestartData& data)
+{
+  std::ofstream ofile;
+  ofile.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (not ofile.is_open()) return false;
+
+  auto WriteBlock = [&ofile](const auto& vec)
+  {
+    ofile.write((char*)vec.data(),
+                static_cast<std::streamsize>(vec.size() *
+                                             sizeof(vec.front())));
+  };
+
+  WriteBlock(data.header);
+  WriteBlock(data.cell_global_ids);
+  WriteBlock(data.counts);
+  WriteBlock(data.values);
+
+  const bool succeeded = ofile.good();
+  ofile.close();
+
+  return succeeded;
+}
+
+//###################################################################
+/**Reads restart data from a file. Only the header is read if
+ * `header_only` is true.*/
+bool ReadRestartFile(const std::string& file_name,
+                     RestartData& data,
+                     bool header_only = false)
+{
+  std::ifstream ifile;
+  ifile.open(file_name, std::ios::in | std::ios::binary);
+
+  if (not ifile.is_open()) return false;
+
+  auto ReadBlock = [&ifile](auto& vec)
+  {
+    ifile.read((char*)vec.data(),
+               static_cast<std::streamsize>(vec.size() *
+                                            sizeof(vec.front())));
+  };
+
+  ReadBlock(data.header);
+  if (not ifile.good() or data.header[HEADER_MAGIC] != RESTART_FILE_MAGIC)
+    return false;
+  if (header_only) return true;
+
+  const size_t num_cells = data.header[HEADER_NUM_CELLS];
+  data.cell_global_ids.resize(num_cells);
+  data.counts.resize(num_cells);
+  ReadBlock(data.cell_global_ids);
+  ReadBlock(data.counts);
+
+  uint64_t num_values = 0;
+  for (uint64_t count : data.counts) num_values += count;
+  data.values.resize(num_values);
+  ReadBlock(data.values);
+
+  const bool succeeded = ifile.good();
+  ifile.close();
+
+  return succeeded;
+}
+
+//###################################################################
+/**Returns the name of the restart file of a location.*/
+std::string MakeRestartFileName(const std::string& folder_name,
+                                const std::string& file_base,
+                                int location_id)
+{
+  char location_cstr[20];
+  snprintf(location_cstr,20,"%d.r", location_id);
+
+  return folder_name + std::string("/") +
+         file_base + std::string(location_cstr);
+}
+}//namespace
+
+//###################################################################
+/**Writes phi_old, and, if available, the angular fluxes and precursors to
+ * restart files, one per location. The values are stored per cell and
+ * keyed by the cells' global ids, hence ReadRestartData can read them back
+ * on any number of locations and with any partition of the same mesh.
+ *
+ * With the `write_restart_async` option the data is copied into a
+ * staging buffer and written by a background thread, hence the call
+ * returns without synchronizing the locations or waiting on the file
+ * system. The success of an asynchronous write is consolidated by the
+ * next call to WriteRestartData, ReadRestartData or
+ * FinalizeRestartData.*/
 void lbs::LBSSolver::WriteRestartData(const std::string& folder_name,
                                       const std::string& file_base)
 {
   typedef struct stat Stat;
   Stat st;
 
+  //======================================== Consolidate the previous write
+  FinalizeRestartData();
+
+  const std::string file_name =
+    MakeRestartFileName(folder_name, file_base, Chi::mpi.location_id);
+
+  //======================================== Snapshot the data
+  RestartData data;
+  data.header[HEADER_MAGIC]          = RESTART_FILE_MAGIC;
+  data.header[HEADER_NUM_FILES]      = Chi::mpi.process_count;
+  data.header[HEADER_NUM_MOMENTS]    = num_moments_;
+  data.header[HEADER_NUM_GROUPS]     = num_groups_;
+  data.header[HEADER_NUM_PSI_GS]     =
+    std::count_if(groupsets_.begin(), groupsets_.end(),
+                  [this](const LBSGroupset& groupset)
+                  { return SavesAngularFlux(groupset.id_); });
+  data.header[HEADER_NUM_PRECURSORS] =
+    options_.use_precursors ? max_precursors_per_material_ : 0;
+  data.header[HEADER_NUM_CELLS]      = grid_ptr_->local_cells.size();
+
+  data.cell_global_ids.reserve(grid_ptr_->local_cells.size());
+  data.counts.reserve(grid_ptr_->local_cells.size());
+  for (auto& cell : grid_ptr_->local_cells)
+  {
+    const size_t num_values_before = data.values.size();
+    ForEachCellStateValue(cell, /*include_phi_new=*/false,
+                          [&data](double& value)
+                          { data.values.push_back(value); });
+
+    data.cell_global_ids.push_back(cell.global_id_);
+    data.counts.push_back(data.values.size() - num_values_before);
+  }
+
+  //======================================== Asynchronous write
+  if (options_.write_restart_async)
+  {
+    //Every location makes sure the folder exists, which avoids
+    //synchronizing with location 0.
+    restart_write_name_ = folder_name + std::string("/") +
+                          file_base + std::string("X.r");
+    restart_write_future_ =
+      std::async(std::launch::async,
+                 [folder_name, file_name, staging = std::move(data)]()
+                 {
+                   Stat folder_st;
+                   if (stat(folder_name.c_str(), &folder_st) != 0)
+                     if ((mkdir(folder_name.c_str(),
+                                S_IRWXU | S_IRWXG | S_IRWXO) != 0) and
+                         (errno != EEXIST))
+                       return false;
+
+                   return WriteRestartFile(file_name, staging);
+                 });
+    return;
+  }
+
   //======================================== Make sure folder exists
   if (Chi::mpi.location_id == 0)
   {
@@ -36,32 +218,10 @@ void lbs::LBSSolver::WriteRestartData(const std::string& folder_name,
   //can create quite a messy output if we print it all.
   //We also need to consolidate the error to determine if
   //the process as whole succeeded.
-  bool location_succeeded = true;
-  char location_cstr[20];
-  snprintf(location_cstr,20,"%d.r", Chi::mpi.location_id);
-
-  std::string file_name = folder_name + std::string("/") +
-                          file_base + std::string(location_cstr);
-
-  std::ofstream ofile;
-  ofile.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
-
-  if (not ofile.is_open())
-  {
+  bool location_succeeded = WriteRestartFile(file_name, data);
+  if (not location_succeeded)
     Chi::log.LogAllError()
-      << "Failed to create restart file: " << file_name;
-    ofile.close();
-    location_succeeded = false;
-  }
-  else
-  {
-    size_t phi_old_size = phi_old_local_.size();
-    ofile.write((char*)&phi_old_size, sizeof(size_t));
-    for (auto val : phi_old_local_)
-      ofile.write((char*)&val, sizeof(double));
-
-    ofile.close();
-  }
+      << "Failed to write restart file: " << file_name;
 
   //======================================== Wait for all processes
   //                                         then check success status
@@ -88,65 +248,212 @@ void lbs::LBSSolver::WriteRestartData(const std::string& folder_name,
 }
 
 //###################################################################
-/**Read phi_old from restart file.*/
+/**Waits for a pending asynchronous restart write and consolidates its
+ * success over all locations. This is a collective call and does nothing
+ * if no write is pending.*/
+void lbs::LBSSolver::FinalizeRestartData()
+{
+  if (not restart_write_future_.valid()) return;
+
+  bool location_succeeded = restart_write_future_.get();
+  if (not location_succeeded)
+    Chi::log.LogAllError()
+      << "Failed to write asynchronous restart file for location "
+      << Chi::mpi.location_id;
+
+  bool global_succeeded = true;
+  MPI_Allreduce(&location_succeeded,   //Send buffer
+                &global_succeeded,     //Recv buffer
+                1,                     //count
+                MPI_CXX_BOOL,          //Data type
+                MPI_LAND,              //Operation - Logical and
+                Chi::mpi.comm);       //Communicator
+
+  //======================================== Write status message
+  if (global_succeeded)
+    Chi::log.Log()
+      << "Successfully wrote restart data: " << restart_write_name_;
+  else
+    Chi::log.Log0Error()
+      << "Failed to write restart data: " << restart_write_name_;
+}
+
+//###################################################################
+/**Reads phi_old, and, if available, the angular fluxes and precursors
+ * from restart files written by WriteRestartData. The files may have
+ * been written by any number of locations with any partition of the same
+ * mesh. Each location reads a share of the files and the cell data is
+ * then redistributed to the current owners of the cells: a directory,
+ * keyed by global id modulo the number of locations, resolves the owner
+ * of every cell read.*/
 void lbs::LBSSolver::ReadRestartData(const std::string& folder_name,
                                      const std::string& file_base)
 {
+  FinalizeRestartData();
+
   Chi::mpi.Barrier();
 
-  //======================================== Open files
+  const int num_locations = Chi::mpi.process_count;
+
+  //======================================== Get the number of files
   //This step might fail for specific locations and
   //can create quite a messy output if we print it all.
   //We also need to consolidate the error to determine if
   //the process as whole succeeded.
   bool location_succeeded = true;
-  char location_cstr[20];
-  snprintf(location_cstr,20,"%d.r", Chi::mpi.location_id);
-
-  std::string file_name = folder_name + std::string("/") +
-                          file_base + std::string(location_cstr);
-
-  std::ifstream ifile;
-  ifile.open(file_name, std::ios::in | std::ios::binary );
-
-  if (not ifile.is_open())
+  uint64_t num_files = 0;
+  if (Chi::mpi.location_id == 0)
   {
-    ifile.close();
-    location_succeeded = false;
+    RestartData data;
+    if (ReadRestartFile(MakeRestartFileName(folder_name, file_base, 0),
+                        data, /*header_only=*/true))
+      num_files = data.header[HEADER_NUM_FILES];
   }
-  else
+  MPI_Bcast(&num_files, 1, MPI_UINT64_T, 0, Chi::mpi.comm);
+  if (num_files == 0) location_succeeded = false;
+
+  //======================================== Read this location's share of
+  //                                         the files
+  const uint64_t expected_num_psi_gs =
+    std::count_if(groupsets_.begin(), groupsets_.end(),
+                  [this](const LBSGroupset& groupset)
+                  { return SavesAngularFlux(groupset.id_); });
+  const uint64_t expected_num_precursors =
+    options_.use_precursors ? max_precursors_per_material_ : 0;
+
+  std::vector<RestartData> file_data;
+  for (uint64_t f = Chi::mpi.location_id; f < num_files; f += num_locations)
   {
-    size_t number_of_unknowns;
-    ifile.read((char*)&number_of_unknowns, sizeof(size_t));
+    file_data.emplace_back();
+    auto& data = file_data.back();
+    const bool file_read =
+      ReadRestartFile(MakeRestartFileName(folder_name, file_base,
+                                          static_cast<int>(f)), data);
 
-    if (number_of_unknowns != phi_old_local_.size())
+    if (not file_read or
+        data.header[HEADER_NUM_FILES]      != num_files or
+        data.header[HEADER_NUM_MOMENTS]    != num_moments_ or
+        data.header[HEADER_NUM_GROUPS]     != num_groups_ or
+        data.header[HEADER_NUM_PSI_GS]     != expected_num_psi_gs or
+        data.header[HEADER_NUM_PRECURSORS] != expected_num_precursors)
     {
       location_succeeded = false;
-      ifile.close();
+      file_data.pop_back();
     }
-    else
-    {
-      std::vector<double> temp_phi_old(phi_old_local_.size(), 0.0);
+  }
+
+  //======================================== Register the local cells with
+  //                                         the directory
+  chi_mesh::CellIDMap directory;
+  {
+    std::map<int, std::vector<uint64_t>> registrations;
+    for (const auto& cell : grid_ptr_->local_cells)
+      registrations[static_cast<int>(cell.global_id_ % num_locations)]
+        .push_back(cell.global_id_);
+
+    const auto received =
+      chi_mpi_utils::MapAllToAll(registrations, MPI_UINT64_T);
+    for (const auto& [pid, gids] : received)
+      for (uint64_t gid : gids)
+        directory.Insert(gid, static_cast<uint64_t>(pid));
+  }
 
-      size_t v=0;
-      while (not ifile.eof())
+  //======================================== Query the owners of the cells
+  //                                         read
+  std::map<int, std::vector<uint64_t>> queries;
+  for (const auto& data : file_data)
+    for (uint64_t gid : data.cell_global_ids)
+      queries[static_cast<int>(gid % num_locations)].push_back(gid);
+
+  std::map<int, std::vector<uint64_t>> replies;
+  {
+    const auto received = chi_mpi_utils::MapAllToAll(queries, MPI_UINT64_T);
+    for (const auto& [pid, gids] : received)
+    {
+      auto& reply = replies[pid];
+      reply.reserve(gids.size());
+      for (uint64_t gid : gids)
       {
-        ifile.read((char*)&temp_phi_old[v], sizeof(double));
-        ++v;
+        const uint64_t* owner = directory.Find(gid);
+        reply.push_back(owner ? *owner : static_cast<uint64_t>(num_locations));
       }
+    }
+  }
+  directory.Clear();
+  auto owners = chi_mpi_utils::MapAllToAll(replies, MPI_UINT64_T);
+  replies.clear();
 
-      if (v != (number_of_unknowns+1))
+  //======================================== Send the cell data to the
+  //                                         owners
+  std::map<int, std::vector<uint64_t>> send_records; //(gid, count)
+  std::map<int, std::vector<double>>   send_values;
+  {
+    std::map<int, size_t> reply_position;
+    for (const auto& data : file_data)
+    {
+      size_t v = 0;
+      for (size_t c = 0; c < data.cell_global_ids.size(); ++c)
       {
-        location_succeeded = false;
-        ifile.close();
+        const uint64_t gid = data.cell_global_ids[c];
+        const uint64_t count = data.counts[c];
+        const int directory_pid = static_cast<int>(gid % num_locations);
+        const uint64_t owner = owners[directory_pid]
+                                     [reply_position[directory_pid]++];
+
+        if (owner < static_cast<uint64_t>(num_locations))
+        {
+          auto& records = send_records[static_cast<int>(owner)];
+          records.insert(records.end(), {gid, count});
+          auto& values = send_values[static_cast<int>(owner)];
+          values.insert(values.end(),
+                        data.values.begin() + static_cast<int64_t>(v),
+                        data.values.begin() + static_cast<int64_t>(v + count));
+        }
+        v += count;
       }
-      else
-        phi_old_local_ = std::move(temp_phi_old);
+    }
+  }
+  file_data.clear();
+  queries.clear();
+  owners.clear();
+
+  const auto received_records =
+    chi_mpi_utils::MapAllToAll(send_records, MPI_UINT64_T);
+  send_records.clear();
+  const auto received_values =
+    chi_mpi_utils::MapAllToAll(send_values, MPI_DOUBLE);
+  send_values.clear();
 
-      ifile.close();
+  //======================================== Stage the received data
+  std::vector<std::vector<double>> cell_data(grid_ptr_->local_cells.size());
+  for (const auto& [pid, records] : received_records)
+  {
+    const auto& values = received_values.at(pid);
+    size_t v = 0;
+    for (size_t r = 0; r < records.size(); r += 2)
+    {
+      const uint64_t gid = records[r];
+      const uint64_t count = records[r + 1];
+      const auto& cell = grid_ptr_->cells[gid];
+
+      cell_data[cell.local_id_].assign(
+        values.begin() + static_cast<int64_t>(v),
+        values.begin() + static_cast<int64_t>(v + count));
+      v += count;
     }
   }
 
+  //======================================== Check every local cell
+  //                                         received its data
+  for (auto& cell : grid_ptr_->local_cells)
+  {
+    size_t expected_size = 0;
+    ForEachCellStateValue(cell, /*include_phi_new=*/false,
+                          [&expected_size](double&) { ++expected_size; });
+    if (cell_data[cell.local_id_].size() != expected_size)
+      location_succeeded = false;
+  }
+
   //======================================== Wait for all processes
   //                                         then check success status
   Chi::mpi.Barrier();
@@ -158,6 +465,16 @@ void lbs::LBSSolver::ReadRestartData(const std::string& folder_name,
                 MPI_LAND,              //Operation - Logical and
                 Chi::mpi.comm);       //Communicator
 
+  //======================================== Commit the data
+  if (global_succeeded)
+    for (auto& cell : grid_ptr_->local_cells)
+    {
+      const auto& data = cell_data[cell.local_id_];
+      size_t k = 0;
+      ForEachCellStateValue(cell, /*include_phi_new=*/false,
+                            [&data, &k](double& value) { value = data[k++]; });
+    }
+
   //======================================== Write status message
   if (global_succeeded) Chi::log.Log() << "Successfully read restart data";
   else
@@ -4,21 +4,43 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_log_exceptions.h"
 #include "LinearBoltzmannSolvers/A_LBSSolver/Groupset/lbs_groupset.h"
 
 
 #include <fstream>
 #include <cstring>
 
+namespace
+{
+/**Leading text of the header of compressed angular flux files.*/
+const char* const COMPRESSED_ANGULAR_FLUX_HEADER =
+  "Chi-Tech LinearBoltzmann::Groupset compressed angular flux file\n";
+
+/**Number of values compressed per block.*/
+const size_t COMPRESSION_BLOCK_SIZE = 65536;
+}//namespace
+
 //###################################################################
-/**Writes the groupset's angular fluxes to file.*/
+/**Writes the groupset's angular fluxes to file. With a compression
+ * other than NONE the values are written in compressed blocks, see
+ * WriteGroupsetAngularFluxesCompressed.*/
 void lbs::LBSSolver::
   WriteGroupsetAngularFluxes(const LBSGroupset& groupset,
-                             const std::string& file_base)
+                             const std::string& file_base,
+                             const DoubleCompression compression,
+                             const double tolerance)
 {
   std::string file_name =
     file_base + std::to_string(Chi::mpi.location_id) + ".data";
 
+  if (compression != DoubleCompression::NONE)
+  {
+    WriteGroupsetAngularFluxesCompressed(groupset, file_name,
+                                         compression, tolerance);
+    return;
+  }
+
   //============================================= Open file
   std::ofstream file(file_name,
                      std::ofstream::binary | //binary file
@@ -103,7 +125,8 @@ void lbs::LBSSolver::
 }
 
 //###################################################################
-/**Prints the groupset's angular fluxes to file.*/
+/**Reads the groupset's angular fluxes from file. Files written with
+ * compression are detected from their header and decompressed.*/
 void lbs::LBSSolver::
   ReadGroupsetAngularFluxes(LBSGroupset& groupset,
                             const std::string& file_base)
@@ -145,6 +168,14 @@ void lbs::LBSSolver::
   char header_bytes[320]; header_bytes[319] = '\0';
   file.read(header_bytes,319);
 
+  if (strncmp(header_bytes, COMPRESSED_ANGULAR_FLUX_HEADER,
+              strlen(COMPRESSED_ANGULAR_FLUX_HEADER)) == 0)
+  {
+    ReadGroupsetAngularFluxesCompressed(groupset, file, file_name);
+    file.close();
+    return;
+  }
+
   file.read((char*)&file_num_local_nodes, sizeof(size_t));
   file.read((char*)&file_num_angles     , sizeof(size_t));
   file.read((char*)&file_num_groups     , sizeof(size_t));
@@ -200,4 +231,276 @@ void lbs::LBSSolver::
 
   //============================================= Clean-up
   file.close();
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Writes the groupset's angular fluxes to file in compressed blocks. The
+ * values are ordered by cell, node, angle and group, with the cells in
+ * the order of the global ids stored ahead of the blocks.*/
+void lbs::LBSSolver::
+  WriteGroupsetAngularFluxesCompressed(const LBSGroupset& groupset,
+                                       const std::string& file_name,
+                                       const DoubleCompression compression,
+                                       const double tolerance)
+{
+  ChiInvalidArgumentIf(compression == DoubleCompression::LOSSY and
+                       not (tolerance > 0.0),
+                       "The lossy compression tolerance must be positive.");
+
+  //============================================= Open file
+  std::ofstream file(file_name,
+                     std::ofstream::binary | //binary file
+                     std::ofstream::out |    //no accidental reading
+                     std::ofstream::trunc);  //clear file contents when opened
+
+  //============================================= Check file is open
+  if (not file.is_open())
+  {
+    Chi::log.LogAllWarning()
+      << __FUNCTION__ << "Failed to open " << file_name;
+    return;
+  }
+
+  //============================================= Write header
+  std::string header_info =
+    std::string(COMPRESSED_ANGULAR_FLUX_HEADER) +
+    "Header size: 320 bytes\n"
+    "Structure(type-info):\n"
+    "size_t-num_local_nodes\n"
+    "size_t-num_angles\n"
+    "size_t-num_groups\n"
+    "size_t-num_local_dofs\n"
+    "size_t-compression\n"
+    "double-tolerance\n"
+    "size_t-num_cells\n"
+    "uint64_t-cell_global_ids[num_cells]\n"
+    "size_t-num_blocks\n"
+    "Each block:\n"
+    "size_t-num_values\n"
+    "size_t-num_bytes\n"
+    "bytes-compressed_values\n";
+
+  int header_size = (int)header_info.length();
+
+  char header_bytes[320];
+  memset(header_bytes, '-', 320);
+  strncpy(header_bytes, header_info.c_str(),std::min(header_size,319));
+  header_bytes[319]='\0';
+
+  file << header_bytes;
+
+  //============================================= Get relevant items
+  auto NODES_ONLY = chi_math::UnknownManager::GetUnitaryUnknownManager();
+
+  size_t num_local_nodes = discretization_->GetNumLocalDOFs(NODES_ONLY);
+  size_t num_angles      = groupset.quadrature_->abscissae_.size();
+  size_t num_groups      = groupset.groups_.size();
+  size_t num_local_dofs  = psi_new_local_[groupset.id_].size();
+  size_t compression_id  = static_cast<size_t>(compression);
+  size_t num_cells       = grid_ptr_->local_cells.size();
+  auto   dof_handler     = groupset.psi_uk_man_;
+  const auto& psi        = psi_new_local_[groupset.id_];
+
+  //============================================= Write num_ quantities
+  file.write((char*)&num_local_nodes,sizeof(size_t));
+  file.write((char*)&num_angles     ,sizeof(size_t));
+  file.write((char*)&num_groups     ,sizeof(size_t));
+  file.write((char*)&num_local_dofs ,sizeof(size_t));
+  file.write((char*)&compression_id ,sizeof(size_t));
+  file.write((char*)&tolerance      ,sizeof(double));
+  file.write((char*)&num_cells      ,sizeof(size_t));
+
+  std::vector<uint64_t> cell_global_ids;
+  cell_global_ids.reserve(num_cells);
+  for (const auto& cell : grid_ptr_->local_cells)
+    cell_global_ids.push_back(cell.global_id_);
+  file.write((char*)cell_global_ids.data(),
+             static_cast<std::streamsize>(num_cells * sizeof(uint64_t)));
+
+  //============================================= Gather the values
+  auto& sdm = discretization_;
+
+  std::vector<double> values;
+  values.reserve(num_local_dofs);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const size_t num_nodes = sdm->GetCellNumNodes(cell);
+    for (unsigned int i=0; i < num_nodes; ++i)
+      for (unsigned int n=0; n<num_angles; ++n)
+        for (unsigned int g=0; g<num_groups; ++g)
+          values.push_back(psi[sdm->MapDOFLocal(cell,i,dof_handler,n,g)]);
+  }
+
+  //============================================= Write compressed blocks
+  size_t num_blocks =
+    (values.size() + COMPRESSION_BLOCK_SIZE - 1) / COMPRESSION_BLOCK_SIZE;
+  file.write((char*)&num_blocks, sizeof(size_t));
+
+  size_t num_bytes_written = 0;
+  std::vector<double> block_values;
+  for (size_t b=0; b<num_blocks; ++b)
+  {
+    const size_t begin = b * COMPRESSION_BLOCK_SIZE;
+    const size_t end = std::min(begin + COMPRESSION_BLOCK_SIZE, values.size());
+    block_values.assign(values.begin() + static_cast<int64_t>(begin),
+                        values.begin() + static_cast<int64_t>(end));
+
+    const auto bytes = CompressDoubles(block_values, compression, tolerance);
+
+    size_t num_values = block_values.size();
+    size_t num_bytes  = bytes.size();
+    file.write((char*)&num_values, sizeof(size_t));
+    file.write((char*)&num_bytes , sizeof(size_t));
+    file.write((char*)bytes.data(), static_cast<std::streamsize>(num_bytes));
+    num_bytes_written += num_bytes;
+  }
+
+  if (not file.good())
+    Chi::log.LogAllWarning()
+      << __FUNCTION__ << "Failed to write " << file_name;
+  else
+    Chi::log.LogAllVerbose1()
+      << "Compressed angular fluxes from "
+      << values.size() * sizeof(double) << " to "
+      << num_bytes_written << " bytes in " << file_name;
+
+  //============================================= Clean-up
+  file.close();
+}
+
+//###################################################################
+/**Reads the groupset's angular fluxes from a file, written with
+ * WriteGroupsetAngularFluxesCompressed, of which the header text has
+ * already been read.*/
+void lbs::LBSSolver::
+  ReadGroupsetAngularFluxesCompressed(LBSGroupset& groupset,
+                                      std::ifstream& file,
+                                      const std::string& file_name)
+{
+  //============================================= Get relevant items
+  auto NODES_ONLY = chi_math::UnknownManager::GetUnitaryUnknownManager();
+
+  size_t num_local_nodes   = discretization_->GetNumLocalDOFs(NODES_ONLY);
+  size_t num_angles        = groupset.quadrature_->abscissae_.size();
+  size_t num_groups        = groupset.groups_.size();
+  size_t num_local_dofs    = psi_new_local_[groupset.id_].size();
+  std::vector<double>& psi = psi_new_local_[groupset.id_];
+  auto   dof_handler       = groupset.psi_uk_man_;
+
+  size_t file_num_local_nodes;
+  size_t file_num_angles     ;
+  size_t file_num_groups     ;
+  size_t file_num_local_dofs ;
+  size_t file_compression_id ;
+  double file_tolerance      ;
+  size_t file_num_cells      ;
+
+  file.read((char*)&file_num_local_nodes, sizeof(size_t));
+  file.read((char*)&file_num_angles     , sizeof(size_t));
+  file.read((char*)&file_num_groups     , sizeof(size_t));
+  file.read((char*)&file_num_local_dofs , sizeof(size_t));
+  file.read((char*)&file_compression_id , sizeof(size_t));
+  file.read((char*)&file_tolerance      , sizeof(double));
+  file.read((char*)&file_num_cells      , sizeof(size_t));
+
+  //============================================= Check compatibility
+  if (not file.good() or
+      file_num_local_nodes != num_local_nodes or
+      file_num_angles      != num_angles      or
+      file_num_groups      != num_groups      or
+      file_num_local_dofs  != num_local_dofs  or
+      file_num_cells       != grid_ptr_->local_cells.size() or
+      file_compression_id  > static_cast<size_t>(DoubleCompression::LOSSY))
+  {
+    std::stringstream outstr;
+    outstr << "num_local_nodes: " << file_num_local_nodes << "\n";
+    outstr << "num_angles     : " << file_num_angles << "\n";
+    outstr << "num_groups     : " << file_num_groups << "\n";
+    outstr << "num_local_dofs : " << file_num_local_dofs << "\n";
+    outstr << "num_cells      : " << file_num_cells << "\n";
+    outstr << "compression    : " << file_compression_id << "\n";
+    Chi::log.LogAll()
+      << "Incompatible DOF data found in file " << file_name << "\n"
+      << outstr.str();
+    return;
+  }
+
+  const auto compression = static_cast<DoubleCompression>(file_compression_id);
+
+  std::vector<uint64_t> cell_global_ids(file_num_cells);
+  file.read((char*)cell_global_ids.data(),
+            static_cast<std::streamsize>(file_num_cells * sizeof(uint64_t)));
+  for (uint64_t cell_global_id : cell_global_ids)
+    if (not file.good() or not grid_ptr_->IsCellLocal(cell_global_id))
+    {
+      Chi::log.LogAll()
+        << "Incompatible cells found in file " << file_name;
+      return;
+    }
+
+  //============================================= Decompress the blocks
+  size_t num_blocks = 0;
+  file.read((char*)&num_blocks, sizeof(size_t));
+
+  std::vector<double> values;
+  values.reserve(num_local_dofs);
+  std::vector<uint8_t> bytes;
+  std::vector<double> block_values;
+  for (size_t b=0; b<num_blocks; ++b)
+  {
+    size_t num_values = 0;
+    size_t num_bytes  = 0;
+    file.read((char*)&num_values, sizeof(size_t));
+    file.read((char*)&num_bytes , sizeof(size_t));
+
+    const bool valid_block =
+      file.good() and values.size() + num_values <= num_local_dofs and
+      num_bytes <= COMPRESSION_BLOCK_SIZE * 2 * sizeof(double);
+    if (valid_block)
+    {
+      bytes.resize(num_bytes);
+      file.read((char*)bytes.data(), static_cast<std::streamsize>(num_bytes));
+    }
+
+    if (not valid_block or not file.good() or
+        not DecompressDoubles(bytes.data(), num_bytes, num_values,
+                              compression, file_tolerance, block_values))
+    {
+      Chi::log.LogAll()
+        << "Corrupt compressed block found in file " << file_name;
+      return;
+    }
+    values.insert(values.end(), block_values.begin(), block_values.end());
+  }
+
+  if (values.size() != num_local_dofs)
+  {
+    Chi::log.LogAll()
+      << "Incomplete angular flux data found in file " << file_name;
+    return;
+  }
+
+  //============================================= Commit the values
+  auto& sdm = discretization_;
+
+  size_t v = 0;
+  for (uint64_t cell_global_id : cell_global_ids)
+  {
+    const auto& cell = grid_ptr_->cells[cell_global_id];
+    const size_t num_nodes = sdm->GetCellNumNodes(cell);
+    for (unsigned int i=0; i < num_nodes; ++i)
+      for (unsigned int n=0; n<num_angles; ++n)
+        for (unsigned int g=0; g<num_groups; ++g)
+        {
+          if (v >= values.size()) goto cell_count_mismatch;
+          psi[sdm->MapDOFLocal(cell,i,dof_handler,n,g)] = values[v++];
+        }
+  }
+
+  Chi::log.LogAll() << "Number of cells read: " << cell_global_ids.size();
+  return;
+
+  cell_count_mismatch:
+  Chi::log.LogAll()
+    << "Incompatible DOF data found in file " << file_name;
+}
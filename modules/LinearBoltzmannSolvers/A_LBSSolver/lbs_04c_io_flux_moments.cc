@@ -132,7 +132,8 @@ void lbs::LBSSolver::
         for (unsigned int g=0; g < num_groups_; ++g)
         {
           uint64_t cell_global_id = cell.global_id_;
-          uint64_t dof_map = sdm->MapDOFLocal(cell, i, flux_moments_uk_man_, m, g);
+          uint64_t dof_map =
+            cell_transport_views_[cell.local_id_].MapDOF(i, m, g);
 
           assert(dof_map < flux_moments.size());
           double value = flux_moments[dof_map];
@@ -313,11 +314,8 @@ void lbs::LBSSolver::ReadFluxMoments(
 
       size_t node_mapped = node_mapping.at(node);
 
-      size_t dof_map = sdm->MapDOFLocal(cell,
-                                        node_mapped,
-                                        flux_moments_uk_man_,
-                                        moment,
-                                        group);
+      size_t dof_map = cell_transport_views_[cell.local_id_].MapDOF(
+        node_mapped, moment, group);
 
       assert(dof_map < flux_moments.size());
       flux_moments[dof_map] = flux_value;
@@ -0,0 +1,234 @@
+#include "lbs_solver.h"
+
+#include "A_LBSSolver/Tools/lbs_cell_data_io.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+namespace
+{
+//Attribute tags identifying the content of collective files
+const uint64_t FLUX_MOMENTS_TAG  = 1;
+const uint64_t ANGULAR_FLUX_TAG  = 2;
+
+/**Consolidates the success of a collective operation over all locations.*/
+bool AllSucceeded(bool location_succeeded)
+{
+  bool global_succeeded = true;
+  MPI_Allreduce(&location_succeeded,   //Send buffer
+                &global_succeeded,     //Recv buffer
+                1,                     //count
+                MPI_CXX_BOOL,          //Data type
+                MPI_LAND,              //Operation - Logical and
+                Chi::mpi.comm);       //Communicator
+  return global_succeeded;
+}
+}//namespace
+
+//###################################################################
+/**Collectively writes a flux-moments vector to a single file. The values of
+ * each cell are stored node by node, moment by moment and group by group,
+ * keyed by the cell's global id, hence the file can be read back on any
+ * number of locations and with any partition of the same mesh.*/
+void lbs::LBSSolver::
+  WriteFluxMomentsCollective(const std::string& file_name,
+                             const std::vector<double>& flux_moments)
+{
+  Chi::log.Log() << "Writing flux-moments to single file " << file_name;
+
+  const auto& sdm = *discretization_;
+
+  CellDataBlocks blocks;
+  blocks.values.reserve(flux_moments.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
+    blocks.AddCell(cell.global_id_);
+    for (size_t i=0; i<sdm.GetCellNumNodes(cell); ++i)
+      for (unsigned int m=0; m<num_moments_; ++m)
+        for (unsigned int g=0; g<num_groups_; ++g)
+          blocks.AddValue(flux_moments[transport_view.MapDOF(i, m, g)]);
+  }
+
+  const std::string description =
+    "Chi-Tech LinearBoltzmann: Collective flux moments file\n"
+    "Attributes: tag, num_moments, num_groups\n"
+    "Each cell: nodes x moments x groups doubles\n";
+
+  const bool succeeded =
+    WriteCellDataCollective(file_name, description,
+                            {FLUX_MOMENTS_TAG, num_moments_, num_groups_},
+                            grid_ptr_->GetGlobalNumberOfCells(), blocks);
+
+  if (not AllSucceeded(succeeded))
+    Chi::log.Log0Error() << "Failed to write flux-moments file " << file_name;
+}
+
+//###################################################################
+/**Collectively reads a flux-moments vector from a file written with
+ * WriteFluxMomentsCollective.*/
+void lbs::LBSSolver::
+  ReadFluxMomentsCollective(const std::string& file_name,
+                            std::vector<double>& flux_moments)
+{
+  Chi::log.Log() << "Reading flux-moments from single file " << file_name;
+
+  const auto& sdm = *discretization_;
+
+  std::vector<uint64_t> cell_global_ids;
+  cell_global_ids.reserve(grid_ptr_->local_cells.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+    cell_global_ids.push_back(cell.global_id_);
+
+  CellDataBlocks blocks;
+  bool succeeded =
+    ReadCellDataCollective(file_name,
+                           {FLUX_MOMENTS_TAG, num_moments_, num_groups_},
+                           grid_ptr_->GetGlobalNumberOfCells(),
+                           cell_global_ids, blocks);
+
+  //======================================== Check the block sizes
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    if (not succeeded) break;
+    const size_t c = cell.local_id_;
+    const size_t expected_size =
+      sdm.GetCellNumNodes(cell) * num_moments_ * num_groups_;
+    succeeded = (blocks.offsets[c+1] - blocks.offsets[c]) == expected_size;
+  }
+
+  if (not AllSucceeded(succeeded))
+  {
+    Chi::log.Log0Error()
+      << "Failed to read flux-moments file " << file_name
+      << ". The file is either missing or incompatible with the system.";
+    return;
+  }
+
+  //======================================== Commit the values
+  flux_moments.assign(sdm.GetNumLocalDOFs(flux_moments_uk_man_), 0.0);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
+    size_t v = blocks.offsets[cell.local_id_];
+    for (size_t i=0; i<sdm.GetCellNumNodes(cell); ++i)
+      for (unsigned int m=0; m<num_moments_; ++m)
+        for (unsigned int g=0; g<num_groups_; ++g)
+          flux_moments[transport_view.MapDOF(i, m, g)] = blocks.values[v++];
+  }
+}
+
+//###################################################################
+/**Collectively writes the groupset's angular fluxes to a single file.
+ * The values of each cell are stored node by node, angle by angle and
+ * group by group, keyed by the cell's global id.*/
+void lbs::LBSSolver::
+  WriteGroupsetAngularFluxesCollective(const LBSGroupset& groupset,
+                                       const std::string& file_name)
+{
+  if (not SavesAngularFlux(groupset.id_))
+  {
+    Chi::log.Log0Warning()
+      << __FUNCTION__ << ": Angular fluxes are not saved by the solver. "
+      << "No file is written.";
+    return;
+  }
+
+  Chi::log.Log() << "Writing angular fluxes to single file " << file_name;
+
+  const auto& sdm = *discretization_;
+  const auto& dof_handler = groupset.psi_uk_man_;
+  const auto& psi = psi_new_local_[groupset.id_];
+  const uint64_t num_angles = groupset.quadrature_->abscissae_.size();
+  const uint64_t num_gs_groups = groupset.groups_.size();
+
+  CellDataBlocks blocks;
+  blocks.values.reserve(psi.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    blocks.AddCell(cell.global_id_);
+    for (size_t i=0; i<sdm.GetCellNumNodes(cell); ++i)
+      for (unsigned int n=0; n<num_angles; ++n)
+        for (unsigned int g=0; g<num_gs_groups; ++g)
+          blocks.AddValue(psi[sdm.MapDOFLocal(cell, i, dof_handler, n, g)]);
+  }
+
+  const std::string description =
+    "Chi-Tech LinearBoltzmann::Groupset collective angular flux file\n"
+    "Attributes: tag, num_angles, num_groups\n"
+    "Each cell: nodes x angles x groups doubles\n";
+
+  const bool succeeded =
+    WriteCellDataCollective(file_name, description,
+                            {ANGULAR_FLUX_TAG, num_angles, num_gs_groups},
+                            grid_ptr_->GetGlobalNumberOfCells(), blocks);
+
+  if (not AllSucceeded(succeeded))
+    Chi::log.Log0Error() << "Failed to write angular flux file " << file_name;
+}
+
+//###################################################################
+/**Collectively reads the groupset's angular fluxes from a file written
+ * with WriteGroupsetAngularFluxesCollective.*/
+void lbs::LBSSolver::
+  ReadGroupsetAngularFluxesCollective(LBSGroupset& groupset,
+                                      const std::string& file_name)
+{
+  if (not SavesAngularFlux(groupset.id_))
+  {
+    Chi::log.Log0Warning()
+      << __FUNCTION__ << ": Angular fluxes are not saved by the solver. "
+      << "No file is read.";
+    return;
+  }
+
+  Chi::log.Log() << "Reading angular fluxes from single file " << file_name;
+
+  const auto& sdm = *discretization_;
+  const auto& dof_handler = groupset.psi_uk_man_;
+  auto& psi = psi_new_local_[groupset.id_];
+  const uint64_t num_angles = groupset.quadrature_->abscissae_.size();
+  const uint64_t num_gs_groups = groupset.groups_.size();
+
+  std::vector<uint64_t> cell_global_ids;
+  cell_global_ids.reserve(grid_ptr_->local_cells.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+    cell_global_ids.push_back(cell.global_id_);
+
+  CellDataBlocks blocks;
+  bool succeeded =
+    ReadCellDataCollective(file_name,
+                           {ANGULAR_FLUX_TAG, num_angles, num_gs_groups},
+                           grid_ptr_->GetGlobalNumberOfCells(),
+                           cell_global_ids, blocks);
+
+  //======================================== Check the block sizes
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    if (not succeeded) break;
+    const size_t c = cell.local_id_;
+    const size_t expected_size =
+      sdm.GetCellNumNodes(cell) * num_angles * num_gs_groups;
+    succeeded = (blocks.offsets[c+1] - blocks.offsets[c]) == expected_size;
+  }
+
+  if (not AllSucceeded(succeeded))
+  {
+    Chi::log.Log0Error()
+      << "Failed to read angular flux file " << file_name
+      << ". The file is either missing or incompatible with the system.";
+    return;
+  }
+
+  //======================================== Commit the values
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    size_t v = blocks.offsets[cell.local_id_];
+    for (size_t i=0; i<sdm.GetCellNumNodes(cell); ++i)
+      for (unsigned int n=0; n<num_angles; ++n)
+        for (unsigned int g=0; g<num_gs_groups; ++g)
+          psi[sdm.MapDOFLocal(cell, i, dof_handler, n, g)] = blocks.values[v++];
+  }
+}
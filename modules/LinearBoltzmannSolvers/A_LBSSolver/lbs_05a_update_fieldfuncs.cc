@@ -9,18 +9,35 @@ namespace lbs
 {
 
 // ###################################################################
-/**Copy relevant section of phi_old to the field functions.*/
+/**Copy relevant section of phi_old to the field functions. With nodal
+ * storage of the flux moments, the flux moment field functions are
+ * strided views over phi_old, within the group block of their group, which
+ * are only invalidated here and copied lazily when read.*/
 void LBSSolver::UpdateFieldFunctions()
 {
   const auto& sdm = *discretization_;
   const auto& phi_uk_man = flux_moments_uk_man_;
 
   //======================================== Update flux moments
+  const bool nodal_storage =
+    phi_uk_man.dof_storage_type_ == chi_math::UnknownStorageType::NODAL;
   for (const auto& [g_and_m, ff_index] : phi_field_functions_local_map_)
   {
     const size_t g = g_and_m.first;
     const size_t m = g_and_m.second;
 
+    auto& ff_ptr = field_functions_.at(ff_index);
+    if (nodal_storage)
+    {
+      const auto b = flux_moment_blocks_.GroupBlock(g);
+      if (not ff_ptr->HasFieldVectorView())
+        ff_ptr->SetFieldVectorView(phi_old_local_,
+                                   flux_moment_blocks_.MapDOF(0, m, g),
+                                   flux_moment_blocks_.BlockNodeStride(b));
+      ff_ptr->InvalidateFieldVector();
+      continue;
+    }
+
     std::vector<double> data_vector_local(local_node_count_, 0.0);
 
     for (const auto& cell : grid_ptr_->local_cells)
@@ -28,16 +45,16 @@ void LBSSolver::UpdateFieldFunctions()
       const auto& cell_mapping = sdm.GetCellMapping(cell);
       const size_t num_nodes = cell_mapping.NumNodes();
 
+      const auto& transport_view = cell_transport_views_[cell.local_id_];
       for (size_t i = 0; i < num_nodes; ++i)
       {
-        const int64_t imapA = sdm.MapDOFLocal(cell, i, phi_uk_man, m, g);
+        const int64_t imapA = transport_view.MapDOF(i, m, g);
         const int64_t imapB = sdm.MapDOFLocal(cell, i);
 
         data_vector_local[imapB] = phi_old_local_[imapA];
       } // for node
     }   // for cell
 
-    auto& ff_ptr = field_functions_.at(ff_index);
     ff_ptr->UpdateFieldVector(data_vector_local);
   }
   // for (size_t g = 0; g < groups_.size(); ++g)
@@ -76,40 +93,46 @@ void LBSSolver::UpdateFieldFunctions()
   {
     std::vector<double> data_vector_local(local_node_count_, 0.0);
 
-    double local_total_power = 0.0;
-    for (const auto& cell : grid_ptr_->local_cells)
+    // The kappa is currently the default one for all the groups
+    const size_t num_groups = groups_.size();
+    const double kappa = options_.power_default_kappa;
+    const auto& batched_cell_ids = cell_material_table_.BatchedCellIDs();
+    for (size_t mat = 0; mat < cell_material_table_.NumMaterials(); ++mat)
     {
-      const auto& cell_mapping = sdm.GetCellMapping(cell);
-      const size_t num_nodes = cell_mapping.NumNodes();
-
-      const auto& Vi = unit_cell_matrices_[cell.local_id_].Vi_vectors;
+      if (not fission_engine_.IsFissionable(mat)) continue;
+      const double* sigma_f = fission_engine_.FissionRateWeights(mat);
 
-      const auto& xs = matid_to_xs_map_.at(cell.material_id_);
-
-      if (not xs->IsFissionable()) continue;
-
-      for (size_t i = 0; i < num_nodes; ++i)
+      const size_t batch_end = cell_material_table_.BatchEnd(mat);
+#pragma omp parallel
+      {
+      std::vector<double> phi_scratch;
+#pragma omp for schedule(static)
+      for (size_t c = cell_material_table_.BatchBegin(mat); c < batch_end; ++c)
       {
-        const int64_t imapA = sdm.MapDOFLocal(cell, i);
-        const int64_t imapB = sdm.MapDOFLocal(cell, i, phi_uk_man, 0, 0);
+        const auto& cell = grid_ptr_->local_cells[batched_cell_ids[c]];
+        const auto& transport_view = cell_transport_views_[cell.local_id_];
 
-        double nodal_power = 0.0;
-        for (size_t g = 0; g < groups_.size(); ++g)
+        for (int i = 0; i < transport_view.NumNodes(); ++i)
         {
-          const double sigma_fg = xs->SigmaFission()[g];
-          // const double kappa_g = xs->Kappa()[g];
-          const double kappa_g = options_.power_default_kappa;
+          const double* phi_i =
+            transport_view.GroupValues(phi_old_local_, i, 0, phi_scratch);
 
-          nodal_power += kappa_g * sigma_fg * phi_old_local_[imapB + g];
-        } // for g
+          double nodal_fission_rate = 0.0;
+#pragma omp simd reduction(+:nodal_fission_rate)
+          for (size_t g = 0; g < num_groups; ++g)
+            nodal_fission_rate += sigma_f[g] * phi_i[g];
 
-        data_vector_local[imapA] = nodal_power;
-        local_total_power += nodal_power * Vi[i];
-      } // for node
-    }   // for cell
+          data_vector_local[sdm.MapDOFLocal(cell, i)] =
+            kappa * nodal_fission_rate;
+        } // for node
+      }   // for cell
+      }   // omp parallel
+    }     // for material
 
     if (options_.power_normalization > 0.0)
     {
+      const double local_total_power =
+        kappa * IntegrateFissionWeights(phi_old_local_, false);
       double globl_total_power;
       MPI_Allreduce(&local_total_power, // sendbuf
                     &globl_total_power, // recvbuf
@@ -147,7 +170,6 @@ void LBSSolver::SetPhiFromFieldFunctions(PhiSTLOption which_phi,
       g_ids_to_copy.push_back(g);
 
   const auto& sdm = *discretization_;
-  const auto& phi_uk_man = flux_moments_uk_man_;
 
   for (const size_t m : m_ids_to_copy)
   {
@@ -161,11 +183,12 @@ void LBSSolver::SetPhiFromFieldFunctions(PhiSTLOption which_phi,
       {
         const auto& cell_mapping = sdm.GetCellMapping(cell);
         const size_t num_nodes = cell_mapping.NumNodes();
+        const auto& transport_view = cell_transport_views_[cell.local_id_];
 
         for (size_t i = 0; i < num_nodes; ++i)
         {
           const int64_t imapA = sdm.MapDOFLocal(cell, i);
-          const int64_t imapB = sdm.MapDOFLocal(cell, i, phi_uk_man, m, g);
+          const int64_t imapB = transport_view.MapDOF(i, m, g);
 
           if (which_phi == PhiSTLOption::PHI_OLD)
             phi_old_local_[imapB] = ff_data[imapA];
@@ -6,51 +6,77 @@
 using namespace lbs;
 
 //###################################################################
-/**Compute the total fission production in the problem.
-\author Zachary Hardy.*/
-double LBSSolver::ComputeFissionProduction(const std::vector<double>& phi)
+/**Integrates, over the local fissionable cells, the dot product of the
+ * zeroth flux moments with the fission weights of the cell materials,
+ * either the production weights or the fission cross sections.
+ *
+ * Cells are visited material by material, concurrently. The volume
+ * weighted fluxes of a cell are accumulated per group before the dot
+ * product, such that the inner loops are contiguous over the groups. The
+ * cell integrals are summed in batched cell order, hence the result does
+ * not depend on the number of threads.*/
+double LBSSolver::
+  IntegrateFissionWeights(const std::vector<double>& phi,
+                          bool production) const
 {
-  const int first_grp = groups_.front().id_;
-  const int last_grp = groups_.back().id_;
+  const size_t num_groups = groups_.size();
+  const auto& batched_cell_ids = cell_material_table_.BatchedCellIDs();
 
-  //============================================= Loop over local cells
-  double local_production = 0.0;
-  for (auto& cell : grid_ptr_->local_cells)
+  std::vector<double> cell_integrals(batched_cell_ids.size(), 0.0);
+  for (size_t mat = 0; mat < cell_material_table_.NumMaterials(); ++mat)
   {
-    const auto& transport_view = cell_transport_views_[cell.local_id_];
-    const auto& cell_matrices = unit_cell_matrices_[cell.local_id_];
-
-    //====================================== Obtain xs
-    const auto& xs = transport_view.XS();
-    const auto& F = xs.ProductionMatrix();
-    const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
-
-    if (not xs.IsFissionable()) continue;
-
-    //====================================== Loop over nodes
-    const int num_nodes = transport_view.NumNodes();
-    for (int i = 0; i < num_nodes; ++i)
+    if (not fission_engine_.IsFissionable(mat)) continue;
+    const double* weights =
+      production
+        ? fission_engine_.ProductionWeights(mat, options_.use_precursors)
+        : fission_engine_.FissionRateWeights(mat);
+
+    const size_t batch_begin = cell_material_table_.BatchBegin(mat);
+    const size_t batch_end = cell_material_table_.BatchEnd(mat);
+#pragma omp parallel
     {
-      const size_t uk_map = transport_view.MapDOF(i, 0, 0);
-      const double IntV_ShapeI = cell_matrices.Vi_vectors[i];
-
-      //=============================== Loop over groups
-      for (size_t g = first_grp; g <= last_grp; ++g)
+      std::vector<double> cell_phi(num_groups);
+      std::vector<double> phi_scratch;
+#pragma omp for schedule(static)
+      for (size_t c = batch_begin; c < batch_end; ++c)
       {
-        const auto& prod = F[g];
-        for (size_t gp = 0; gp <= last_grp; ++gp)
-          local_production += prod[gp] *
-                              phi[uk_map + gp] *
-                              IntV_ShapeI;
-
-        if (options_.use_precursors)
-          for (unsigned int j = 0; j < xs.NumPrecursors(); ++j)
-            local_production += nu_delayed_sigma_f[g] *
-                                phi[uk_map + g] *
-                                IntV_ShapeI;
+        const uint64_t cell_local_id = batched_cell_ids[c];
+        const auto& IntV_shapeI = unit_cell_matrices_[cell_local_id].Vi_vectors;
+        const auto& transport_view = cell_transport_views_[cell_local_id];
+
+        cell_phi.assign(num_groups, 0.0);
+        for (int i = 0; i < transport_view.NumNodes(); ++i)
+        {
+          const double* phi_i =
+            transport_view.GroupValues(phi, i, 0, phi_scratch);
+          const double V_i = IntV_shapeI[i];
+#pragma omp simd
+          for (size_t g = 0; g < num_groups; ++g)
+            cell_phi[g] += V_i * phi_i[g];
+        }
+
+        double integral = 0.0;
+#pragma omp simd reduction(+:integral)
+        for (size_t g = 0; g < num_groups; ++g)
+          integral += weights[g] * cell_phi[g];
+        cell_integrals[c] = integral;
       }
-    }//for node
-  }//for cell
+    }
+  }
+
+  double local_integral = 0.0;
+  for (const double integral : cell_integrals)
+    local_integral += integral;
+
+  return local_integral;
+}
+
+//###################################################################
+/**Compute the total fission production in the problem.
+\author Zachary Hardy.*/
+double LBSSolver::ComputeFissionProduction(const std::vector<double>& phi)
+{
+  const double local_production = IntegrateFissionWeights(phi, true);
 
   //============================================= Allreduce global production
   double global_production = 0.0;
@@ -68,35 +94,7 @@ double LBSSolver::ComputeFissionProduction(const std::vector<double>& phi)
 \author Zachary Hardy.*/
 double LBSSolver::ComputeFissionRate(const std::vector<double>& phi)
 {
-  const int first_grp = groups_.front().id_;
-  const int last_grp = groups_.back().id_;
-
-  //============================================= Loop over local cells
-  double local_fission_rate = 0.0;
-  for (auto& cell : grid_ptr_->local_cells)
-  {
-    const auto& transport_view = cell_transport_views_[cell.local_id_];
-    const auto& cell_matrices = unit_cell_matrices_[cell.local_id_];
-
-    //====================================== Obtain xs
-    const auto& xs = transport_view.XS();
-    const auto& sigma_f = xs.SigmaFission();
-
-    // skip non-fissionable material
-    if (not xs.IsFissionable()) continue;
-
-    //====================================== Loop over nodes
-    const int num_nodes = transport_view.NumNodes();
-    for (int i = 0; i < num_nodes; ++i)
-    {
-      const size_t uk_map = transport_view.MapDOF(i, 0, 0);
-      const double IntV_ShapeI = cell_matrices.Vi_vectors[i];
-
-      //=============================== Loop over groups
-      for (size_t g = first_grp; g <= last_grp; ++g)
-        local_fission_rate += sigma_f[g] * phi[uk_map + g] * IntV_ShapeI;
-    }//for node
-  }//for cell
+  const double local_fission_rate = IntegrateFissionWeights(phi, false);
 
   //============================================= Allreduce global production
   double global_fission_rate = 0.0;
@@ -107,4 +105,4 @@ double LBSSolver::ComputeFissionRate(const std::vector<double>& phi)
                 Chi::mpi.comm);      //communicator
 
   return global_fission_rate;
-}
\ No newline at end of file
+}
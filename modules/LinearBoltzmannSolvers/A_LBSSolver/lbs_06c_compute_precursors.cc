@@ -9,44 +9,60 @@
 /**Compute the steady state delayed neutron precursor concentrations.*/
 void lbs::LBSSolver::ComputePrecursors()
 {
-  const size_t J = max_precursors_per_material_;
+  std::vector<double> delayed_fission_rates;
+  ComputeDelayedFissionRates(phi_new_local_, delayed_fission_rates);
 
-  precursor_new_local_.assign(precursor_new_local_.size(), 0.0);
+  precursor_engine_.ComputeSteadyStateConcentrations(
+    cell_material_table_, delayed_fission_rates, precursor_new_local_);
+}
 
-  //================================================== Loop over cells
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    const auto& fe_values = unit_cell_matrices_[cell.local_id_];
-    const auto& transport_view = cell_transport_views_[cell.local_id_];
-    const double cell_volume = transport_view.Volume();
+//###################################################################
+/**Computes the cell averaged delayed fission rate, i.e. the volume
+ * fraction weighted sum over the nodes of the delayed fission production,
+ * of every local cell. The rates are indexed by cell local id. Cells are
+ * visited material by material.*/
+void lbs::LBSSolver::
+  ComputeDelayedFissionRates(const std::vector<double>& phi,
+                             std::vector<double>& rates) const
+{
+  const size_t num_groups = groups_.size();
+  const auto& batched_cell_ids = cell_material_table_.BatchedCellIDs();
+
+  rates.assign(grid_ptr_->local_cells.size(), 0.0);
 
-    //==================== Obtain xs
-    const auto& xs = transport_view.XS();
-    const auto& precursors = xs.Precursors();
-    const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+  for (size_t mat = 0; mat < cell_material_table_.NumMaterials(); ++mat)
+  {
+    const auto& xs = cell_material_table_.XS(mat);
+    if (xs.NumPrecursors() == 0 or xs.NuDelayedSigmaF().empty()) continue;
+    const double* nu_delayed_sigma_f = xs.NuDelayedSigmaF().data();
 
-    //======================================== Loop over precursors
-    for (unsigned int j = 0; j < xs.NumPrecursors(); ++j)
+    const size_t batch_end = cell_material_table_.BatchEnd(mat);
+#pragma omp parallel
+    {
+    std::vector<double> phi_scratch;
+#pragma omp for schedule(static)
+    for (size_t c = cell_material_table_.BatchBegin(mat); c < batch_end; ++c)
     {
-      size_t dof = cell.local_id_ * J + j;
-      const auto& precursor = precursors[j];
-      const double coeff = precursor.fractional_yield /
-                           precursor.decay_constant;
+      const uint64_t cell_local_id = batched_cell_ids[c];
+      const auto& fe_values = unit_cell_matrices_[cell_local_id];
+      const auto& transport_view = cell_transport_views_[cell_local_id];
+      const double cell_volume = transport_view.Volume();
 
-      //=================================== Loop over nodes
+      double rate = 0.0;
       for (int i = 0; i < transport_view.NumNodes(); ++i)
       {
-        const size_t uk_map = transport_view.MapDOF(i, 0, 0);
-        const double node_V_fraction = fe_values.Vi_vectors[i]/cell_volume;
-
-        //============================== Loop over groups
-        for (unsigned int g = 0; g < groups_.size(); ++g)
-          precursor_new_local_[dof] += coeff *
-                                       nu_delayed_sigma_f[g] *
-                                       phi_new_local_[uk_map + g] *
-                                       node_V_fraction;
-      }//for node i
-    }//for precursor j
-
-  }//for cell
-}
\ No newline at end of file
+        const double* phi_i =
+          transport_view.GroupValues(phi, i, 0, phi_scratch);
+
+        double node_rate = 0.0;
+#pragma omp simd reduction(+:node_rate)
+        for (size_t g = 0; g < num_groups; ++g)
+          node_rate += nu_delayed_sigma_f[g] * phi_i[g];
+
+        rate += node_rate * fe_values.Vi_vectors[i] / cell_volume;
+      }
+      rates[cell_local_id] = rate;
+    }
+    }//omp parallel
+  }
+}
@@ -3,6 +3,8 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
+#include <algorithm>
+
 //###################################################################
 /**Sets a value to the zeroth (scalar) moment of the vector.*/
 void lbs::LBSSolver::SetPhiVectorScalarValues(std::vector<double> &phi_vector,
@@ -11,24 +13,14 @@ void lbs::LBSSolver::SetPhiVectorScalarValues(std::vector<double> &phi_vector,
   const size_t first_grp = groups_.front().id_;
   const size_t final_grp = groups_.back().id_;
 
-  const auto& sdm = *discretization_;
-
-  typedef const int64_t cint64_t;
   for (const auto& cell : grid_ptr_->local_cells)
   {
-    const auto& cell_mapping = sdm.GetCellMapping(cell);
-    const size_t num_nodes = cell_mapping.NumNodes();
-
-    for (size_t i=0; i<num_nodes; ++i)
-    {
-      cint64_t dof_map = sdm.MapDOFLocal(cell, i, flux_moments_uk_man_,
-                                         /*m*/0, /*g*/0);
-
-      double* phi = &phi_vector[dof_map];
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
+    const int num_nodes = transport_view.NumNodes();
 
+    for (int i=0; i<num_nodes; ++i)
       for (size_t g=first_grp; g<=final_grp; ++g)
-        phi[g] = value;
-    }//for node i
+        phi_vector[transport_view.MapDOF(i, /*m*/0, g)] = value;
   }//for cell
 }
 
@@ -68,28 +60,8 @@ SetGSPETScVecFromPrimarySTLvector(LBSGroupset& groupset, Vec x,
   double* x_ref;
   VecGetArray(x,&x_ref);
 
-  int gsi = groupset.groups_.front().id_;
-  int gsf = groupset.groups_.back().id_;
-  int gss = gsf-gsi+1;
-
-  int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          x_ref[index] = (*y_ptr)[mapping+g]; //Offset on purpose
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  CopyGroupSpanToArray(groupset.groups_.front().id_,
+                       groupset.groups_.back().id_, *y_ptr, x_ref);
 
   VecRestoreArray(x,&x_ref);
 }
@@ -112,28 +84,8 @@ void lbs::LBSSolver::
   const double* x_ref;
   VecGetArrayRead(x_src,&x_ref);
 
-  int gsi = groupset.groups_.front().id_;
-  int gsf = groupset.groups_.back().id_;
-  int gss = gsf-gsi+1;
-
-  int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          (*y_ptr)[mapping+g] = x_ref[index];
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  CopyGroupSpanFromArray(groupset.groups_.front().id_,
+                         groupset.groups_.back().id_, x_ref, *y_ptr);
 
   VecRestoreArrayRead(x_src,&x_ref);
 }
@@ -222,28 +174,7 @@ void lbs::LBSSolver::
   double* x_ref;
   VecGetArray(x,&x_ref);
 
-  int gsi = first_group_id;
-  int gsf = last_group_id;
-  int gss = gsf-gsi+1;
-
-  int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          x_ref[index] = y[mapping+g]; //Offset on purpose
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  CopyGroupSpanToArray(first_group_id, last_group_id, y, x_ref);
 
   VecRestoreArray(x,&x_ref);
 }
@@ -259,28 +190,7 @@ void lbs::LBSSolver::
   const double* x_ref;
   VecGetArrayRead(x_src,&x_ref);
 
-  int gsi = first_group_id;
-  int gsf = last_group_id;
-  int gss = gsf-gsi+1;
-
-  int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          y[mapping+g] = x_ref[index];
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  CopyGroupSpanFromArray(first_group_id, last_group_id, x_ref, y);
 
   VecRestoreArrayRead(x_src,&x_ref);
 }
@@ -308,27 +218,9 @@ void lbs::LBSSolver::
   {
     const auto& groupset = groupsets_.at(gs_id);
 
-    int gsi = groupset.groups_.front().id_;
-    int gsf = groupset.groups_.back().id_;
-    int gss = gsf-gsi+1;
-
-    for (const auto& cell : grid_ptr_->local_cells)
-    {
-      auto& transport_view = cell_transport_views_[cell.local_id_];
-
-      for (int i=0; i < cell.vertex_ids_.size(); i++)
-      {
-        for (int m=0; m < num_moments_; m++)
-        {
-          size_t mapping = transport_view.MapDOF(i,m,gsi);
-          for (int g=0; g<gss; g++)
-          {
-            index++;
-            x_ref[index] = (*y_ptr)[mapping+g]; //Offset on purpose
-          }//for g
-        }//for moment
-      }//for dof
-    }//for cell
+    index += CopyGroupSpanToArray(groupset.groups_.front().id_,
+                                  groupset.groups_.back().id_,
+                                  *y_ptr, x_ref + index + 1);
   }//for groupset id
 
   VecRestoreArray(x,&x_ref);
@@ -358,28 +250,129 @@ void lbs::LBSSolver::
   {
     const auto& groupset = groupsets_.at(gs_id);
 
-    int gsi = groupset.groups_.front().id_;
-    int gsf = groupset.groups_.back().id_;
-    int gss = gsf-gsi+1;
-
-    for (const auto& cell : grid_ptr_->local_cells)
-    {
-      auto& transport_view = cell_transport_views_[cell.local_id_];
-
-      for (int i=0; i < cell.vertex_ids_.size(); i++)
-      {
-        for (int m=0; m < num_moments_; m++)
-        {
-          size_t mapping = transport_view.MapDOF(i,m,gsi);
-          for (int g=0; g<gss; g++)
-          {
-            index++;
-            (*y_ptr)[mapping+g] = x_ref[index];
-          }//for g
-        }//for moment
-      }//for dof
-    }//for cell
+    index += CopyGroupSpanFromArray(groupset.groups_.front().id_,
+                                    groupset.groups_.back().id_,
+                                    x_ref + index + 1, *y_ptr);
   }//for groupset id
 
   VecRestoreArrayRead(x_src,&x_ref);
-}
\ No newline at end of file
+}
+//###################################################################
+/**Copies the unknowns of a group span of a flux moment vector to a
+ * contiguous array, ordered by group block and, within each, by node,
+ * moment and group, see FluxMomentBlocks. The groups of a block being
+ * contiguous per node and moment, each row is block copied, and a span of
+ * all the groups of a block is a single copy, e.g., a groupset with the
+ * groupset major layout. Returns the number of unknowns copied.*/
+size_t lbs::LBSSolver::
+  CopyGroupSpanToArray(int first_group_id, int last_group_id,
+                       const std::vector<double>& phi, double* x) const
+{
+  const auto& blocks = flux_moment_blocks_;
+  const size_t num_rows = local_node_count_ * num_moments_;
+
+  size_t count = 0;
+  for (size_t b = 0; b < blocks.NumBlocks(); ++b)
+  {
+    const size_t block_gi = blocks.BlockFirstGroup(b);
+    const size_t block_gs = blocks.BlockNumGroups(b);
+    const size_t gsi = std::max<size_t>(first_group_id, block_gi);
+    const size_t gsf = std::min<size_t>(last_group_id, block_gi + block_gs - 1);
+    if (gsi > gsf) continue;
+    const size_t gss = gsf - gsi + 1;
+    const double* phi_b = phi.data() + blocks.BlockOffset(b) + gsi - block_gi;
+
+    if (gss == block_gs)
+      std::copy_n(phi_b, num_rows * block_gs, x + count);
+    else
+      for (size_t r = 0; r < num_rows; ++r)
+        std::copy_n(phi_b + r * block_gs, gss, x + count + r * gss);
+    count += num_rows * gss;
+  }
+
+  return count;
+}
+
+//###################################################################
+/**Copies a contiguous array, ordered as by CopyGroupSpanToArray, to the
+ * unknowns of a group span of a flux moment vector. Returns the number
+ * of unknowns copied.*/
+size_t lbs::LBSSolver::
+  CopyGroupSpanFromArray(int first_group_id, int last_group_id,
+                         const double* x, std::vector<double>& phi) const
+{
+  const auto& blocks = flux_moment_blocks_;
+  const size_t num_rows = local_node_count_ * num_moments_;
+
+  size_t count = 0;
+  for (size_t b = 0; b < blocks.NumBlocks(); ++b)
+  {
+    const size_t block_gi = blocks.BlockFirstGroup(b);
+    const size_t block_gs = blocks.BlockNumGroups(b);
+    const size_t gsi = std::max<size_t>(first_group_id, block_gi);
+    const size_t gsf = std::min<size_t>(last_group_id, block_gi + block_gs - 1);
+    if (gsi > gsf) continue;
+    const size_t gss = gsf - gsi + 1;
+    double* phi_b = phi.data() + blocks.BlockOffset(b) + gsi - block_gi;
+
+    if (gss == block_gs)
+      std::copy_n(x + count, num_rows * block_gs, phi_b);
+    else
+      for (size_t r = 0; r < num_rows; ++r)
+        std::copy_n(x + count + r * gss, gss, phi_b + r * block_gs);
+    count += num_rows * gss;
+  }
+
+  return count;
+}
+
+//###################################################################
+/**Zeros the unknowns of a group span of a moment vector.*/
+void lbs::LBSSolver::
+  ZeroGroupSpan(int first_group_id, int last_group_id,
+                std::vector<double>& moments) const
+{
+  const auto& blocks = flux_moment_blocks_;
+  const size_t num_rows = local_node_count_ * num_moments_;
+
+  for (size_t b = 0; b < blocks.NumBlocks(); ++b)
+  {
+    const size_t block_gi = blocks.BlockFirstGroup(b);
+    const size_t block_gs = blocks.BlockNumGroups(b);
+    const size_t gsi = std::max<size_t>(first_group_id, block_gi);
+    const size_t gsf = std::min<size_t>(last_group_id, block_gi + block_gs - 1);
+    if (gsi > gsf) continue;
+    const size_t gss = gsf - gsi + 1;
+    double* moments_b = moments.data() + blocks.BlockOffset(b) + gsi - block_gi;
+
+    if (gss == block_gs)
+      std::fill_n(moments_b, num_rows * block_gs, 0.0);
+    else
+      for (size_t r = 0; r < num_rows; ++r)
+        std::fill_n(moments_b + r * block_gs, gss, 0.0);
+  }
+}
+
+//###################################################################
+/**Returns a copy of a flux moment vector in the group interleaved layout,
+ * i.e., the layout mapped by UnknownManager().*/
+std::vector<double> lbs::LBSSolver::
+  InterleavedFluxMoments(const std::vector<double>& phi) const
+{
+  if (flux_moment_blocks_.NumBlocks() == 1) return phi;
+
+  const auto& sdm = *discretization_;
+  std::vector<double> interleaved(phi.size(), 0.0);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
+    const size_t num_nodes = sdm.GetCellNumNodes(cell);
+    for (size_t i = 0; i < num_nodes; ++i)
+      for (unsigned int m = 0; m < num_moments_; ++m)
+        for (unsigned int g = 0; g < num_groups_; ++g)
+          interleaved[sdm.MapDOFLocal(cell, i, flux_moments_uk_man_, m, g)] =
+            phi[transport_view.MapDOF(i, m, g)];
+  }
+
+  return interleaved;
+}
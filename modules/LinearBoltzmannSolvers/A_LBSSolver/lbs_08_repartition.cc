@@ -0,0 +1,132 @@
+#include "lbs_solver.h"
+
+#include "mesh/MeshHandler/chi_meshhandler.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "physics/FieldFunction/fieldfunction_gridbased.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <functional>
+
+//###################################################################
+/**Moves the cells of the grid, with their flux moments, angular fluxes
+ * and precursors, to the locations in `new_local_cell_pids`, indexed by
+ * local cell id, and re-initializes the solver in place on the migrated
+ * grid. This is a collective call.
+ *
+ * The field functions of the solver are rebuilt with the same stack
+ * handles. Any other object built on the grid, e.g., other solvers or
+ * field function interpolations, must be re-created.*/
+void lbs::LBSSolver::Repartition(
+  const std::vector<uint64_t>& new_local_cell_pids)
+{
+  const std::string fname = "lbs::LBSSolver::Repartition";
+  ChiLogicalErrorIf(cell_transport_views_.size() !=
+                      grid_ptr_->local_cells.size(),
+                    fname + ": The solver must be initialized.");
+  ChiLogicalErrorIf(chi_mesh::GetCurrentHandler().GetGrid() != grid_ptr_,
+                    fname + ": The grid of the solver must be the grid of "
+                            "the current mesh handler, on which the solver "
+                            "is re-initialized.");
+
+  //======================================== Pack
+  std::vector<std::vector<double>> cell_data(grid_ptr_->local_cells.size());
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    auto& data = cell_data[cell.local_id_];
+    ForEachCellStateValue(cell, /*include_phi_new=*/true,
+                          [&data](double& value) { data.push_back(value); });
+  }
+
+  //======================================== Migrate
+  grid_ptr_->MigrateCells(new_local_cell_pids, cell_data);
+
+  //======================================== Re-initialize
+  // The snapshots of the flux ROM follow the old partition
+  flux_rom_.Clear();
+
+  std::vector<size_t> ff_stack_indices;
+  for (const auto& ff : field_functions_)
+  {
+    const auto& stack = Chi::field_function_stack;
+    const auto it = std::find(stack.begin(), stack.end(), ff);
+    ChiLogicalErrorIf(it == stack.end(),
+                      fname + ": Field function not found on the stack.");
+    ff_stack_indices.push_back(std::distance(stack.begin(), it));
+  }
+  field_functions_.clear();
+
+  const bool read_restart_data = options_.read_restart_data;
+  options_.read_restart_data = false;
+  Initialize();
+  options_.read_restart_data = read_restart_data;
+
+  ChiLogicalErrorIf(field_functions_.size() != ff_stack_indices.size(),
+                    fname + ": The number of field functions changed.");
+  for (size_t k = 0; k < field_functions_.size(); ++k)
+  {
+    auto& stack = Chi::field_function_stack;
+    const auto& ff = field_functions_[k];
+    stack.erase(std::find(stack.begin(), stack.end(), ff));
+    stack[ff_stack_indices[k]] = ff;
+  }
+
+  //======================================== Unpack
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& data = cell_data[cell.local_id_];
+    size_t k = 0;
+    ForEachCellStateValue(cell, /*include_phi_new=*/true,
+                          [&data, &k](double& value) { value = data[k++]; });
+  }
+
+  UpdateFieldFunctions();
+
+  Chi::log.Log() << "Solver repartitioned.";
+}
+
+//###################################################################
+/**Visits the flux moments, the angular fluxes, if saved, and the
+ * precursors, if used, of a local cell in a fixed order. phi_new is
+ * only visited if `include_phi_new` is true. The visit relies on the
+ * discretization, the flux moment blocks and the unknown managers only,
+ * hence it can be used before the cell transport views are initialized.*/
+void lbs::LBSSolver::
+  ForEachCellStateValue(const chi_mesh::Cell& cell,
+                        bool include_phi_new,
+                        const std::function<void(double&)>& visit)
+{
+  const auto& sdm = *discretization_;
+  const size_t num_nodes = sdm.GetCellNumNodes(cell);
+
+  std::vector<std::vector<double>*> phis = {&phi_old_local_};
+  if (include_phi_new) phis.push_back(&phi_new_local_);
+
+  for (auto* phi : phis)
+    for (size_t i = 0; i < num_nodes; ++i)
+      for (unsigned int m = 0; m < num_moments_; ++m)
+        for (unsigned int g = 0; g < num_groups_; ++g)
+          visit((*phi)[flux_moment_blocks_.MapDOF(sdm.MapDOFLocal(cell, i),
+                                                  m, g)]);
+
+  for (const auto& groupset : groupsets_)
+    if (SavesAngularFlux(groupset.id_))
+    {
+      auto& psi = psi_new_local_[groupset.id_];
+      const auto& uk_man = groupset.psi_uk_man_;
+      const size_t num_angles = groupset.quadrature_->abscissae_.size();
+      const size_t gs_num_groups = groupset.groups_.size();
+      for (size_t i = 0; i < num_nodes; ++i)
+        for (unsigned int n = 0; n < num_angles; ++n)
+          for (unsigned int gsg = 0; gsg < gs_num_groups; ++gsg)
+            visit(psi[sdm.MapDOFLocal(cell, i, uk_man, n, gsg)]);
+    }
+
+  if (options_.use_precursors)
+    for (size_t j = 0; j < max_precursors_per_material_; ++j)
+      visit(precursor_new_local_[
+        cell.local_id_ * max_precursors_per_material_ + j]);
+}
@@ -0,0 +1,94 @@
+#include "lbs_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+//###################################################################
+/**Sets the amplitudes in time of the incident fluxes of a boundary, its
+ * fluxes, or those of its boundary function evaluated once at setup,
+ * being their shapes in space, angle and energy. Kept across the rebuilds
+ * of the boundary. A null table removes the time dependence.*/
+void lbs::LBSSolver::SetBoundaryTimeTable(uint64_t boundary_id,
+                                          TimeTablePtr time_table)
+{
+  const auto bndry_it = sweep_boundaries_.find(boundary_id);
+  ChiInvalidArgumentIf(bndry_it != sweep_boundaries_.end() and
+                         bndry_it->second->IsReflecting(),
+                       "Boundary " + std::to_string(boundary_id) +
+                         " is reflecting and cannot have a time table.");
+
+  if (time_table) boundary_time_tables_[boundary_id] = std::move(time_table);
+  else
+    boundary_time_tables_.erase(boundary_id);
+
+  if (bndry_it != sweep_boundaries_.end())
+  {
+    bndry_it->second->SetTimeTable(nullptr);
+    ApplyBoundaryTimeTable(boundary_id);
+  }
+}
+
+//###################################################################
+/**Sets the amplitudes in time of the strength of a point source, by its
+ * index in the order the point sources were added.*/
+void lbs::LBSSolver::SetPointSourceTimeTable(size_t point_source_index,
+                                             TimeTablePtr time_table)
+{
+  ChiInvalidArgumentIf(point_source_index >= point_sources_.size(),
+                       "Invalid point source index " +
+                         std::to_string(point_source_index) + ".");
+
+  auto& point_source = point_sources_[point_source_index];
+  point_source.SetTimeTable(std::move(time_table));
+  point_source.SetEvaluationTime(source_evaluation_time_);
+  UpdateUncollidedFlux();
+}
+
+//###################################################################
+/**Sets the amplitudes in time of the volumetric sources of all the
+ * materials.*/
+void lbs::LBSSolver::SetVolumetricSourceTimeTable(TimeTablePtr time_table)
+{
+  volumetric_source_time_table_ = std::move(time_table);
+  volumetric_source_amplitudes_.clear();
+  SetSourceEvaluationTime(source_evaluation_time_);
+}
+
+//###################################################################
+/**Sets the time at which the boundaries and sources are evaluated, e.g.,
+ * by a transient solver before every step. Sources and boundaries with a
+ * time table are scaled by its amplitudes at that time, which costs an
+ * interpolation into the table per source and a scaling of the stored
+ * fluxes per boundary, the boundary functions not being evaluated again.*/
+void lbs::LBSSolver::SetSourceEvaluationTime(double time)
+{
+  source_evaluation_time_ = time;
+
+  for (auto& [bid, bndry] : sweep_boundaries_)
+    bndry->SetEvaluationTime(time);
+
+  for (auto& point_source : point_sources_)
+    point_source.SetEvaluationTime(time);
+  UpdateUncollidedFlux();
+
+  if (volumetric_source_time_table_)
+    volumetric_source_time_table_->EvaluateGroups(
+      time, num_groups_, volumetric_source_amplitudes_);
+}
+
+//###################################################################
+/**Passes the time table of a boundary, if any, to its sweep boundary.*/
+void lbs::LBSSolver::ApplyBoundaryTimeTable(uint64_t boundary_id)
+{
+  auto& bndry = sweep_boundaries_.at(boundary_id);
+  bndry->SetEvaluationTime(source_evaluation_time_);
+
+  const auto table_it = boundary_time_tables_.find(boundary_id);
+  if (table_it == boundary_time_tables_.end()) return;
+
+  ChiInvalidArgumentIf(bndry->IsReflecting(),
+                       "Boundary " + std::to_string(boundary_id) +
+                         " is reflecting and cannot have a time table.");
+  bndry->SetTimeTable(table_it->second);
+}
@@ -0,0 +1,68 @@
+#include "lbs_cell_material_table.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**Builds the material indices and the per material cell batches of the
+ * local cells of the given grid.*/
+CellMaterialTable::CellMaterialTable(
+  const chi_mesh::MeshContinuum& grid,
+  const std::map<int, XSPtr>& matid_to_xs_map,
+  const std::map<int, IsotropicSrcPtr>& matid_to_src_map)
+{
+  //============================================= Index the materials
+  std::map<int, size_t> matid_to_index;
+  for (const auto& [mat_id, xs] : matid_to_xs_map)
+  {
+    ChiLogicalErrorIf(not xs, "Material " + std::to_string(mat_id) +
+                                " has no cross sections.");
+
+    matid_to_index[mat_id] = material_ids_.size();
+    material_ids_.push_back(mat_id);
+    material_xs_.push_back(xs.get());
+
+    const auto src_it = matid_to_src_map.find(mat_id);
+    material_srcs_.push_back(
+      src_it != matid_to_src_map.end() ? src_it->second : nullptr);
+  }
+
+  //============================================= Map the cells
+  const size_t num_materials = material_ids_.size();
+  const size_t num_local_cells = grid.local_cells.size();
+
+  cell_material_indices_.assign(num_local_cells, 0);
+  batch_offsets_.assign(num_materials + 1, 0);
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto it = matid_to_index.find(cell.material_id_);
+    ChiLogicalErrorIf(it == matid_to_index.end(),
+                      "Cell " + std::to_string(cell.global_id_) +
+                        " has material id " +
+                        std::to_string(cell.material_id_) +
+                        " which has no cross sections.");
+
+    cell_material_indices_[cell.local_id_] = it->second;
+    ++batch_offsets_[it->second + 1];
+  }
+
+  //============================================= Build the batches
+  for (size_t m = 0; m < num_materials; ++m)
+    batch_offsets_[m + 1] += batch_offsets_[m];
+
+  std::vector<size_t> batch_fill(batch_offsets_.begin(),
+                                 batch_offsets_.end() - 1);
+  batched_cell_ids_.assign(num_local_cells, 0);
+  for (const auto& cell : grid.local_cells)
+  {
+    const size_t m = cell_material_indices_[cell.local_id_];
+    batched_cell_ids_[batch_fill[m]++] = cell.local_id_;
+  }
+}
+
+} // namespace lbs
@@ -0,0 +1,89 @@
+#ifndef CHITECH_LBS_CELL_MATERIAL_TABLE_H
+#define CHITECH_LBS_CELL_MATERIAL_TABLE_H
+
+#include "lbs_structs.h"
+
+namespace chi_mesh
+{
+class MeshContinuum;
+}
+
+namespace lbs
+{
+
+// ##################################################################
+/**Flat mapping of the local cells to their materials. Materials are
+ * identified by a contiguous index, in ascending material id order, which
+ * replaces the material id map lookups within the cell loops. The local
+ * cells are also grouped into one batch per material so that cell loops can
+ * process all the cells of a material together.
+ *
+ * The cross sections are referenced, not owned, hence the table must be
+ * rebuilt whenever the material id to cross section map changes.*/
+class CellMaterialTable
+{
+private:
+  std::vector<int> material_ids_;
+  std::vector<const chi_physics::MultiGroupXS*> material_xs_;
+  std::vector<IsotropicSrcPtr> material_srcs_;
+
+  std::vector<size_t> cell_material_indices_;
+  std::vector<size_t> batch_offsets_;
+  std::vector<uint64_t> batched_cell_ids_;
+
+public:
+  CellMaterialTable() = default;
+  CellMaterialTable(const chi_mesh::MeshContinuum& grid,
+                    const std::map<int, XSPtr>& matid_to_xs_map,
+                    const std::map<int, IsotropicSrcPtr>& matid_to_src_map);
+
+  /**Returns the number of materials.*/
+  size_t NumMaterials() const { return material_ids_.size(); }
+  /**Returns the material id of the given material index.*/
+  int MaterialID(size_t mat_index) const { return material_ids_[mat_index]; }
+  /**Returns the cross sections of the given material index.*/
+  const chi_physics::MultiGroupXS& XS(size_t mat_index) const
+  {
+    return *material_xs_[mat_index];
+  }
+  /**Returns the isotropic source of the given material index, which is
+   * null if the material has none.*/
+  const IsotropicSrcPtr& Source(size_t mat_index) const
+  {
+    return material_srcs_[mat_index];
+  }
+
+  /**Returns the material index of the cell with the given local id.*/
+  size_t CellMaterialIndex(uint64_t local_id) const
+  {
+    return cell_material_indices_[local_id];
+  }
+  /**Returns the cross sections of the cell with the given local id.*/
+  const chi_physics::MultiGroupXS& CellXS(uint64_t local_id) const
+  {
+    return *material_xs_[cell_material_indices_[local_id]];
+  }
+
+  /**Returns the local ids of all the local cells, sorted by material index.
+   * The cells of a material keep their local id order.*/
+  const std::vector<uint64_t>& BatchedCellIDs() const
+  {
+    return batched_cell_ids_;
+  }
+  /**Returns the position, in the batched cell ids, of the first cell of
+   * the given material index.*/
+  size_t BatchBegin(size_t mat_index) const
+  {
+    return batch_offsets_[mat_index];
+  }
+  /**Returns the position, in the batched cell ids, one past the last cell
+   * of the given material index.*/
+  size_t BatchEnd(size_t mat_index) const
+  {
+    return batch_offsets_[mat_index + 1];
+  }
+};
+
+} // namespace lbs
+
+#endif // CHITECH_LBS_CELL_MATERIAL_TABLE_H
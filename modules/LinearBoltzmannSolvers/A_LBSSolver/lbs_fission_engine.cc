@@ -0,0 +1,49 @@
+#include "lbs_fission_engine.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Computes the fission weights of the materials of the given table.
+ * Delayed production is counted once per precursor of the material.*/
+FissionEngine::FissionEngine(const CellMaterialTable& cell_materials,
+                             size_t num_groups)
+  : num_groups_(num_groups)
+{
+  const size_t num_materials = cell_materials.NumMaterials();
+  const size_t G = num_groups_;
+
+  fissionable_.assign(num_materials, false);
+  sigma_f_.assign(num_materials * G, 0.0);
+  prompt_production_.assign(num_materials * G, 0.0);
+  total_production_.assign(num_materials * G, 0.0);
+
+  for (size_t mat = 0; mat < num_materials; ++mat)
+  {
+    const auto& xs = cell_materials.XS(mat);
+    if (not xs.IsFissionable()) continue;
+    fissionable_[mat] = true;
+
+    const auto& sigma_f = xs.SigmaFission();
+    std::copy_n(sigma_f.begin(), std::min(G, sigma_f.size()),
+                sigma_f_.begin() + mat * G);
+
+    double* prompt = &prompt_production_[mat * G];
+    const auto F = xs.Production().ToMatrix();
+    for (const auto& F_g : F)
+      for (size_t gp = 0; gp < std::min(G, F_g.size()); ++gp)
+        prompt[gp] += F_g[gp];
+
+    double* total = &total_production_[mat * G];
+    std::copy_n(prompt, G, total);
+
+    const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+    const double num_precursors = xs.NumPrecursors();
+    for (size_t g = 0; g < std::min(G, nu_delayed_sigma_f.size()); ++g)
+      total[g] += num_precursors * nu_delayed_sigma_f[g];
+  }
+}
+
+} // namespace lbs
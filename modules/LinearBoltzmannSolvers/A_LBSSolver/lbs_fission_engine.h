@@ -0,0 +1,58 @@
+#ifndef CHITECH_LBS_FISSION_ENGINE_H
+#define CHITECH_LBS_FISSION_ENGINE_H
+
+#include "lbs_cell_material_table.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**Group weights of the fission rate and fission production of the
+ * materials, per material index and group (at `mat * G + g`).
+ *
+ * The production weight of a group is the column sum of the production
+ * operator, i.e. the neutrons produced in all groups by a unit flux in that
+ * group. The total production of a node is therefore a dot product over the
+ * groups of its zeroth flux moments, instead of a production operator
+ * application. The delayed production weights are kept separately because
+ * the precursor option can change after initialization.
+ *
+ * The weights are copied from the cross sections, therefore the engine must
+ * be rebuilt with the cell material table.*/
+class FissionEngine
+{
+private:
+  size_t num_groups_ = 0;
+
+  std::vector<bool> fissionable_;
+  std::vector<double> sigma_f_;
+  std::vector<double> prompt_production_;
+  std::vector<double> total_production_;
+
+public:
+  FissionEngine() = default;
+  FissionEngine(const CellMaterialTable& cell_materials, size_t num_groups);
+
+  /**Returns true if the material of the given index is fissionable.*/
+  bool IsFissionable(size_t mat_index) const
+  {
+    return fissionable_[mat_index];
+  }
+  /**Returns the fission cross sections of the given material index.*/
+  const double* FissionRateWeights(size_t mat_index) const
+  {
+    return &sigma_f_[mat_index * num_groups_];
+  }
+  /**Returns the production weights of the given material index, with or
+   * without the delayed production.*/
+  const double* ProductionWeights(size_t mat_index, bool with_delayed) const
+  {
+    const auto& weights = with_delayed ? total_production_
+                                       : prompt_production_;
+    return &weights[mat_index * num_groups_];
+  }
+};
+
+} // namespace lbs
+
+#endif // CHITECH_LBS_FISSION_ENGINE_H
@@ -0,0 +1,204 @@
+#include "lbs_packed_unit_cell_matrices.h"
+
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Packs the given unit cell matrices of the local cells, indexed by cell
+ * local id, and of the ghost cells, keyed by cell global id.*/
+PackedUnitCellMatrices::PackedUnitCellMatrices(
+  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+  const std::map<uint64_t, UnitCellMatrices>& unit_ghost_cell_matrices)
+{
+  auto ShapeOf = [](const UnitCellMatrices& ucm)
+  { return CellShape{ucm.M_matrix.size(), ucm.face_M_matrices.size()}; };
+
+  std::vector<CellShape> local_cell_shapes;
+  local_cell_shapes.reserve(unit_cell_matrices.size());
+  for (const auto& ucm : unit_cell_matrices)
+    local_cell_shapes.push_back(ShapeOf(ucm));
+
+  std::vector<uint64_t> ghost_ids;
+  std::vector<CellShape> ghost_cell_shapes;
+  for (const auto& [ghost_id, ucm] : unit_ghost_cell_matrices)
+  {
+    ghost_ids.push_back(ghost_id);
+    ghost_cell_shapes.push_back(ShapeOf(ucm));
+  }
+
+  Allocate(local_cell_shapes, ghost_ids, ghost_cell_shapes);
+
+  for (size_t c = 0; c < unit_cell_matrices.size(); ++c)
+    Set(c, unit_cell_matrices[c]);
+  for (const auto& [ghost_id, ucm] : unit_ghost_cell_matrices)
+    Set(GhostIndex(ghost_id), ucm);
+}
+
+// ##################################################################
+/**Returns the number of scalars stored for a cell of the given shape.*/
+size_t PackedUnitCellMatrices::ScalarSize(const CellShape& shape)
+{
+  const size_t n = shape.num_nodes;
+  return 2 * n * n + n + shape.num_faces * (n * n + n);
+}
+
+// ##################################################################
+/**Returns the number of vectors stored for a cell of the given shape.*/
+size_t PackedUnitCellMatrices::VectorSize(const CellShape& shape)
+{
+  const size_t n = shape.num_nodes;
+  return (1 + shape.num_faces) * n * n;
+}
+
+// ##################################################################
+/**Allocates zeroed storage for the local cells, indexed by cell local id,
+ * followed by the ghost cells with the given global ids. Any previously
+ * stored matrices are discarded.*/
+void PackedUnitCellMatrices::Allocate(
+  const std::vector<CellShape>& local_cell_shapes,
+  const std::vector<uint64_t>& ghost_ids,
+  const std::vector<CellShape>& ghost_cell_shapes)
+{
+  ChiInvalidArgumentIf(ghost_ids.size() != ghost_cell_shapes.size(),
+                       "The number of ghost ids and ghost cell shapes "
+                       "differ.");
+
+  num_local_cells_ = local_cell_shapes.size();
+  cell_entries_.assign(num_local_cells_ + ghost_ids.size(), {});
+  ghost_indices_.clear();
+
+  size_t scalar_size = 0;
+  size_t vector_size = 0;
+  auto AddEntry = [&](size_t index, const CellShape& shape)
+  {
+    auto& entry = cell_entries_[index];
+    entry.num_nodes = shape.num_nodes;
+    entry.num_faces = shape.num_faces;
+    entry.scalar_offset = scalar_size;
+    entry.vector_offset = vector_size;
+
+    scalar_size += ScalarSize(shape);
+    vector_size += VectorSize(shape);
+  };
+
+  for (size_t c = 0; c < num_local_cells_; ++c)
+    AddEntry(c, local_cell_shapes[c]);
+  for (size_t g = 0; g < ghost_ids.size(); ++g)
+  {
+    const size_t index = num_local_cells_ + g;
+    ChiInvalidArgumentIf(not ghost_indices_.emplace(ghost_ids[g], index).second,
+                         "Duplicate ghost id " +
+                           std::to_string(ghost_ids[g]) + ".");
+    AddEntry(index, ghost_cell_shapes[g]);
+  }
+
+  scalar_data_.assign(scalar_size, 0.0);
+  vector_data_.assign(vector_size, chi_mesh::Vector3());
+}
+
+// ##################################################################
+/**Returns the storage index of a ghost cell. The local cells have
+ * storage indices equal to their local ids, the ghost cells follow.*/
+size_t PackedUnitCellMatrices::GhostIndex(uint64_t global_id) const
+{
+  const auto it = ghost_indices_.find(global_id);
+  ChiInvalidArgumentIf(it == ghost_indices_.end(),
+                       "No unit cell matrices are stored for ghost cell " +
+                         std::to_string(global_id) + ".");
+  return it->second;
+}
+
+// ##################################################################
+/**Copies the matrices of a cell to its packed storage, e.g. after its
+ * geometry changed. The number of nodes and faces of the cell must match
+ * the allocated ones. Missing stiffness or gradient matrices are stored as
+ * zeros. Distinct cells may be set concurrently.*/
+void PackedUnitCellMatrices::Set(size_t index, const UnitCellMatrices& ucm)
+{
+  const auto& entry = cell_entries_.at(index);
+  ChiInvalidArgumentIf(ucm.M_matrix.size() != entry.num_nodes or
+                         ucm.face_M_matrices.size() != entry.num_faces,
+                       "The number of nodes or faces of the cell differs "
+                       "from the allocated one.");
+
+  const size_t n = entry.num_nodes;
+  const size_t nf = entry.num_faces;
+
+  double* scalars = &scalar_data_[entry.scalar_offset];
+  chi_mesh::Vector3* vectors = &vector_data_[entry.vector_offset];
+
+  auto PackMatrix = [n](const auto& matrix, auto* block)
+  {
+    for (size_t i = 0; i < matrix.size(); ++i)
+      for (size_t j = 0; j < matrix[i].size(); ++j)
+        block[i * n + j] = matrix[i][j];
+  };
+
+  PackMatrix(ucm.M_matrix, scalars);
+  scalars += n * n;
+
+  for (size_t i = 0; i < ucm.Vi_vectors.size(); ++i)
+    scalars[i] = ucm.Vi_vectors[i];
+  scalars += n;
+
+  for (size_t f = 0; f < nf; ++f)
+  {
+    PackMatrix(ucm.face_M_matrices[f], scalars);
+    scalars += n * n;
+  }
+
+  for (size_t f = 0; f < nf; ++f)
+  {
+    if (f < ucm.face_Si_vectors.size())
+      for (size_t i = 0; i < ucm.face_Si_vectors[f].size(); ++i)
+        scalars[i] = ucm.face_Si_vectors[f][i];
+    scalars += n;
+  }
+
+  PackMatrix(ucm.K_matrix, scalars);
+
+  PackMatrix(ucm.G_matrix, vectors);
+  vectors += n * n;
+
+  for (size_t f = 0; f < ucm.face_G_matrices.size() and f < nf; ++f)
+  {
+    PackMatrix(ucm.face_G_matrices[f], vectors);
+    vectors += n * n;
+  }
+}
+
+// ##################################################################
+/**Copies the packed matrices of one cell to another cell of the same
+ * shape, e.g. a congruent cell.*/
+void PackedUnitCellMatrices::Copy(size_t dst_index, size_t src_index)
+{
+  const auto& dst = cell_entries_.at(dst_index);
+  const auto& src = cell_entries_.at(src_index);
+  ChiInvalidArgumentIf(dst.num_nodes != src.num_nodes or
+                         dst.num_faces != src.num_faces,
+                       "The number of nodes or faces of the cells differ.");
+
+  const CellShape shape{src.num_nodes, src.num_faces};
+  std::copy_n(scalar_data_.begin() + static_cast<ptrdiff_t>(src.scalar_offset),
+              ScalarSize(shape),
+              scalar_data_.begin() + static_cast<ptrdiff_t>(dst.scalar_offset));
+  std::copy_n(vector_data_.begin() + static_cast<ptrdiff_t>(src.vector_offset),
+              VectorSize(shape),
+              vector_data_.begin() + static_cast<ptrdiff_t>(dst.vector_offset));
+}
+
+// ##################################################################
+/**Returns the storage size, in bytes, of the packed buffers.*/
+size_t PackedUnitCellMatrices::MemoryUsage() const
+{
+  return cell_entries_.size() * sizeof(CellEntry) +
+         ghost_indices_.size() * (sizeof(uint64_t) + sizeof(size_t)) +
+         scalar_data_.size() * sizeof(double) +
+         vector_data_.size() * sizeof(chi_mesh::Vector3);
+}
+
+} // namespace lbs
@@ -0,0 +1,223 @@
+#ifndef CHITECH_LBS_PACKED_UNIT_CELL_MATRICES_H
+#define CHITECH_LBS_PACKED_UNIT_CELL_MATRICES_H
+
+#include "lbs_structs.h"
+
+#include <map>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Read-only view of a dense, row-major, square block of a packed buffer.
+ * Entries are accessed as `view[i][j]`.*/
+template <typename T>
+class PackedMatrixView
+{
+private:
+  const T* data_ = nullptr;
+  size_t size_ = 0;
+
+public:
+  PackedMatrixView() = default;
+  PackedMatrixView(const T* data, size_t size) : data_(data), size_(size) {}
+
+  /**Returns a pointer to the start of row `i`.*/
+  const T* operator[](size_t i) const { return data_ + i * size_; }
+  /**Returns the number of rows (and columns).*/
+  size_t size() const { return size_; }
+  const T* data() const { return data_; }
+
+  /**Returns a nested copy of the block, e.g. for the dense matrix
+   * routines of chi_math.*/
+  std::vector<std::vector<T>> ToNested() const
+  {
+    std::vector<std::vector<T>> nested(size_);
+    for (size_t i = 0; i < size_; ++i)
+      nested[i].assign(data_ + i * size_, data_ + (i + 1) * size_);
+    return nested;
+  }
+};
+
+// ##################################################################
+/**Read-only view of a list of consecutive blocks of a packed buffer, one per
+ * cell face. Each block is either a vector or a square matrix.*/
+template <typename BlockView, typename T = double>
+class PackedFaceBlocksView
+{
+private:
+  const T* data_ = nullptr;
+  size_t num_faces_ = 0;
+  size_t num_nodes_ = 0;
+  size_t block_stride_ = 0;
+
+public:
+  PackedFaceBlocksView() = default;
+  PackedFaceBlocksView(const T* data,
+                       size_t num_faces,
+                       size_t num_nodes,
+                       size_t block_stride)
+    : data_(data),
+      num_faces_(num_faces),
+      num_nodes_(num_nodes),
+      block_stride_(block_stride)
+  {
+  }
+
+  /**Returns the block of face `f`.*/
+  BlockView operator[](size_t f) const;
+  /**Returns the number of faces.*/
+  size_t size() const { return num_faces_; }
+};
+
+template <>
+inline const double*
+PackedFaceBlocksView<const double*>::operator[](size_t f) const
+{
+  return data_ + f * block_stride_;
+}
+
+template <>
+inline PackedMatrixView<double>
+PackedFaceBlocksView<PackedMatrixView<double>>::operator[](size_t f) const
+{
+  return {data_ + f * block_stride_, num_nodes_};
+}
+
+template <>
+inline PackedMatrixView<chi_mesh::Vector3>
+PackedFaceBlocksView<PackedMatrixView<chi_mesh::Vector3>,
+                     chi_mesh::Vector3>::operator[](size_t f) const
+{
+  return {data_ + f * block_stride_, num_nodes_};
+}
+
+// ##################################################################
+/**Contiguous storage of the unit cell matrices of the local cells and of
+ * the ghost cells. All the cells share one scalar buffer and one vector
+ * buffer with per-cell offsets, which replaces the many small allocations
+ * of the nested UnitCellMatrices with two allocations and keeps the data of
+ * a cell together in memory.
+ *
+ * Per cell, the scalar buffer holds the mass matrix, the volume integrals
+ * of the shape functions, the face mass matrices, the face integrals of
+ * the shape functions and the stiffness matrix, in that order, such that
+ * the data read by the sweeps comes first. The vector buffer holds the
+ * gradient matrix followed by the face gradient matrices.
+ *
+ * The storage is either packed from nested matrices or allocated from the
+ * cell shapes with Allocate and filled cell by cell with Set, which never
+ * holds the nested matrices of more than one cell per thread.*/
+class PackedUnitCellMatrices
+{
+public:
+  /**Views of the matrices of a single cell.*/
+  struct CellView
+  {
+    size_t num_nodes = 0;
+    size_t num_faces = 0;
+
+    PackedMatrixView<double> K_matrix;
+    PackedMatrixView<chi_mesh::Vector3> G_matrix;
+    PackedMatrixView<double> M_matrix;
+    const double* Vi_vectors = nullptr;
+
+    PackedFaceBlocksView<PackedMatrixView<double>> face_M_matrices;
+    PackedFaceBlocksView<PackedMatrixView<chi_mesh::Vector3>,
+                         chi_mesh::Vector3> face_G_matrices;
+    PackedFaceBlocksView<const double*> face_Si_vectors;
+  };
+
+  /**Number of nodes and faces of a cell.*/
+  struct CellShape
+  {
+    size_t num_nodes = 0;
+    size_t num_faces = 0;
+  };
+
+private:
+  struct CellEntry
+  {
+    size_t num_nodes = 0;
+    size_t num_faces = 0;
+    size_t scalar_offset = 0;
+    size_t vector_offset = 0;
+  };
+
+  size_t num_local_cells_ = 0;
+  std::vector<CellEntry> cell_entries_;
+  std::map<uint64_t, size_t> ghost_indices_;
+  std::vector<double> scalar_data_;
+  std::vector<chi_mesh::Vector3> vector_data_;
+
+public:
+  PackedUnitCellMatrices() = default;
+  /**Packs the given unit cell matrices of the local cells, indexed by cell
+   * local id, and of the ghost cells, keyed by cell global id.*/
+  explicit PackedUnitCellMatrices(
+    const std::vector<UnitCellMatrices>& unit_cell_matrices,
+    const std::map<uint64_t, UnitCellMatrices>& unit_ghost_cell_matrices =
+      {});
+
+  /**Returns the views of the cell with the given local id.*/
+  CellView operator[](size_t local_id) const { return View(local_id); }
+
+  /**Returns the views of the ghost cell with the given global id.*/
+  CellView Ghost(uint64_t global_id) const
+  {
+    return View(GhostIndex(global_id));
+  }
+  /**Determines whether the matrices of the ghost cell are stored.*/
+  bool HasGhost(uint64_t global_id) const
+  {
+    return ghost_indices_.count(global_id) > 0;
+  }
+
+  /**Returns the number of local cells.*/
+  size_t size() const { return num_local_cells_; }
+  /**Returns the number of ghost cells.*/
+  size_t NumGhostCells() const { return ghost_indices_.size(); }
+  /**Returns the storage size, in bytes, of the packed buffers.*/
+  size_t MemoryUsage() const;
+
+  void Allocate(const std::vector<CellShape>& local_cell_shapes,
+                const std::vector<uint64_t>& ghost_ids,
+                const std::vector<CellShape>& ghost_cell_shapes);
+
+  /**Returns the storage index of a ghost cell. The local cells have
+   * storage indices equal to their local ids, the ghost cells follow.*/
+  size_t GhostIndex(uint64_t global_id) const;
+
+  void Set(size_t index, const UnitCellMatrices& ucm);
+  void Copy(size_t dst_index, size_t src_index);
+
+private:
+  CellView View(size_t index) const
+  {
+    const auto& entry = cell_entries_[index];
+    const size_t n = entry.num_nodes;
+    const size_t nf = entry.num_faces;
+    const double* scalars = scalar_data_.data() + entry.scalar_offset;
+    const chi_mesh::Vector3* vectors =
+      vector_data_.data() + entry.vector_offset;
+
+    CellView view;
+    view.num_nodes = n;
+    view.num_faces = nf;
+    view.M_matrix = {scalars, n};
+    view.Vi_vectors = scalars + n * n;
+    view.face_M_matrices = {scalars + n * n + n, nf, n, n * n};
+    view.face_Si_vectors = {scalars + n * n + n + nf * n * n, nf, n, n};
+    view.K_matrix = {scalars + n * n + n + nf * (n * n + n), n};
+    view.G_matrix = {vectors, n};
+    view.face_G_matrices = {vectors + n * n, nf, n, n * n};
+    return view;
+  }
+
+  static size_t ScalarSize(const CellShape& shape);
+  static size_t VectorSize(const CellShape& shape);
+};
+
+} // namespace lbs
+
+#endif // CHITECH_LBS_PACKED_UNIT_CELL_MATRICES_H
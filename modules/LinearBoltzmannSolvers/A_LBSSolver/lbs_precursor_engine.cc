@@ -0,0 +1,200 @@
+#include "lbs_precursor_engine.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Copies the precursor data of the materials of the given table.*/
+PrecursorEngine::PrecursorEngine(const CellMaterialTable& cell_materials,
+                                 size_t num_groups,
+                                 size_t max_precursors)
+  : num_groups_(num_groups), max_precursors_(max_precursors)
+{
+  const size_t num_materials = cell_materials.NumMaterials();
+  const size_t G = num_groups_;
+
+  material_offsets_.assign(num_materials + 1, 0);
+  for (size_t mat = 0; mat < num_materials; ++mat)
+    material_offsets_[mat + 1] =
+      material_offsets_[mat] + cell_materials.XS(mat).NumPrecursors();
+
+  const size_t total_precursors = material_offsets_.back();
+  decay_constants_.assign(total_precursors, 0.0);
+  fractional_yields_.assign(total_precursors, 0.0);
+  emission_spectra_.assign(total_precursors * G, 0.0);
+  steady_state_spectra_.assign(num_materials * G, 0.0);
+
+  for (size_t mat = 0; mat < num_materials; ++mat)
+  {
+    const auto& precursors = cell_materials.XS(mat).Precursors();
+    for (size_t j = 0; j < precursors.size(); ++j)
+    {
+      const size_t jj = material_offsets_[mat] + j;
+      const auto& precursor = precursors[j];
+      decay_constants_[jj] = precursor.decay_constant;
+      fractional_yields_[jj] = precursor.fractional_yield;
+
+      const size_t num_spectrum_groups =
+        std::min(G, precursor.emission_spectrum.size());
+      for (size_t g = 0; g < num_spectrum_groups; ++g)
+      {
+        emission_spectra_[jj * G + g] = precursor.emission_spectrum[g];
+        steady_state_spectra_[mat * G + g] +=
+          precursor.fractional_yield * precursor.emission_spectrum[g];
+      }
+    }
+  }
+}
+
+// ##################################################################
+/**Computes, per material index and group, the fraction of the delayed
+ * fission rate emitted into the group during an implicit time step of
+ * effective size `eff_dt`, i.e. the emission spectra weighted by
+ * `eff_dt * lambda_j / (1 + eff_dt * lambda_j)` and the yields.*/
+void PrecursorEngine::ComputeTransientEmissionSpectra(
+  double eff_dt, std::vector<double>& spectra) const
+{
+  const size_t num_materials = material_offsets_.size() - 1;
+  const size_t G = num_groups_;
+
+  spectra.assign(num_materials * G, 0.0);
+  for (size_t mat = 0; mat < num_materials; ++mat)
+  {
+    double* mat_spectrum = &spectra[mat * G];
+    for (size_t jj = material_offsets_[mat]; jj < material_offsets_[mat + 1];
+         ++jj)
+    {
+      const double lambda = decay_constants_[jj];
+      const double weight =
+        fractional_yields_[jj] * eff_dt * lambda / (1.0 + eff_dt * lambda);
+      const double* spectrum = &emission_spectra_[jj * G];
+
+#pragma omp simd
+      for (size_t g = 0; g < G; ++g)
+        mat_spectrum[g] += weight * spectrum[g];
+    }
+  }
+}
+
+// ##################################################################
+/**Adds, to the groups `first_grp` to `last_grp` of `emission`, the
+ * neutrons emitted during an implicit time step of effective size `eff_dt`
+ * by the given concentrations of a cell of material index `mat_index`, at
+ * the start of the step, i.e. the emission spectra weighted by
+ * `lambda_j / (1 + eff_dt * lambda_j) * C_j`.*/
+void PrecursorEngine::AddDecayEmission(size_t mat_index,
+                                       const double* concentrations,
+                                       double eff_dt,
+                                       size_t first_grp,
+                                       size_t last_grp,
+                                       double* emission) const
+{
+  const size_t G = num_groups_;
+  const size_t offset = material_offsets_[mat_index];
+
+  for (size_t j = 0; j < NumPrecursors(mat_index); ++j)
+  {
+    const double lambda = decay_constants_[offset + j];
+    const double weight =
+      lambda / (1.0 + eff_dt * lambda) * concentrations[j];
+    const double* spectrum = &emission_spectra_[(offset + j) * G];
+
+#pragma omp simd
+    for (size_t g = first_grp; g <= last_grp; ++g)
+      emission[g] += weight * spectrum[g];
+  }
+}
+
+// ##################################################################
+/**Computes the steady state concentrations, `beta_j / lambda_j` times the
+ * delayed fission rate, of all the local cells. The delayed fission rates
+ * are indexed by cell local id.*/
+void PrecursorEngine::ComputeSteadyStateConcentrations(
+  const CellMaterialTable& cell_materials,
+  const std::vector<double>& delayed_fission_rates,
+  std::vector<double>& concentrations) const
+{
+  const size_t J = max_precursors_;
+  const auto& batched_cell_ids = cell_materials.BatchedCellIDs();
+
+  concentrations.assign(concentrations.size(), 0.0);
+
+  std::vector<double> coeffs(J, 0.0);
+  for (size_t mat = 0; mat < cell_materials.NumMaterials(); ++mat)
+  {
+    const size_t num_precursors = NumPrecursors(mat);
+    if (num_precursors == 0) continue;
+
+    const size_t offset = material_offsets_[mat];
+    for (size_t j = 0; j < num_precursors; ++j)
+      coeffs[j] = fractional_yields_[offset + j] / decay_constants_[offset + j];
+
+    const size_t batch_end = cell_materials.BatchEnd(mat);
+#pragma omp parallel for schedule(static)
+    for (size_t c = cell_materials.BatchBegin(mat); c < batch_end; ++c)
+    {
+      const uint64_t cell_local_id = batched_cell_ids[c];
+      const double rate = delayed_fission_rates[cell_local_id];
+      double* C = &concentrations[cell_local_id * J];
+
+#pragma omp simd
+      for (size_t j = 0; j < num_precursors; ++j)
+        C[j] = coeffs[j] * rate;
+    }
+  }
+}
+
+// ##################################################################
+/**Advances the concentrations of all the local cells over a time step of
+ * size `dt` with the theta scheme, given the delayed fission rates
+ * (indexed by cell local id) at the theta point of the step.*/
+void PrecursorEngine::StepConcentrations(
+  const CellMaterialTable& cell_materials,
+  const std::vector<double>& delayed_fission_rates,
+  const std::vector<double>& prev_concentrations,
+  double dt,
+  double theta,
+  std::vector<double>& concentrations) const
+{
+  const size_t J = max_precursors_;
+  const double eff_dt = theta * dt;
+  const double inv_theta = 1.0 / theta;
+  const auto& batched_cell_ids = cell_materials.BatchedCellIDs();
+
+  concentrations.assign(concentrations.size(), 0.0);
+
+  // C^{n+1} = (a_j C^n + b_j R + (theta-1) C^n) / theta
+  std::vector<double> prev_coeffs(J, 0.0);
+  std::vector<double> rate_coeffs(J, 0.0);
+  for (size_t mat = 0; mat < cell_materials.NumMaterials(); ++mat)
+  {
+    const size_t num_precursors = NumPrecursors(mat);
+    if (num_precursors == 0) continue;
+
+    const size_t offset = material_offsets_[mat];
+    for (size_t j = 0; j < num_precursors; ++j)
+    {
+      const double a = 1.0 / (1.0 + eff_dt * decay_constants_[offset + j]);
+      prev_coeffs[j] = inv_theta * (a + theta - 1.0);
+      rate_coeffs[j] = inv_theta * a * eff_dt * fractional_yields_[offset + j];
+    }
+
+    const size_t batch_end = cell_materials.BatchEnd(mat);
+#pragma omp parallel for schedule(static)
+    for (size_t c = cell_materials.BatchBegin(mat); c < batch_end; ++c)
+    {
+      const uint64_t cell_local_id = batched_cell_ids[c];
+      const double rate = delayed_fission_rates[cell_local_id];
+      const double* C_prev = &prev_concentrations[cell_local_id * J];
+      double* C = &concentrations[cell_local_id * J];
+
+#pragma omp simd
+      for (size_t j = 0; j < num_precursors; ++j)
+        C[j] = prev_coeffs[j] * C_prev[j] + rate_coeffs[j] * rate;
+    }
+  }
+}
+
+} // namespace lbs
@@ -0,0 +1,81 @@
+#ifndef CHITECH_LBS_PRECURSOR_ENGINE_H
+#define CHITECH_LBS_PRECURSOR_ENGINE_H
+
+#include "lbs_cell_material_table.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**Delayed neutron precursor data of the materials, in structure-of-arrays
+ * layout, with the kernels that update the precursor concentrations of all
+ * the cells of a material together.
+ *
+ * The decay constants and fractional yields of a material are contiguous,
+ * as are its emission spectra, group by group. The concentrations keep the
+ * layout of the solver, i.e. `cell_local_id * max_precursors + j`, hence
+ * the precursors of a cell are contiguous and the per-precursor loops of
+ * the kernels vectorize.
+ *
+ * The data is copied from the cross sections, therefore the engine must be
+ * rebuilt with the cell material table.*/
+class PrecursorEngine
+{
+private:
+  size_t num_groups_ = 0;
+  size_t max_precursors_ = 0;
+
+  std::vector<size_t> material_offsets_;
+  std::vector<double> decay_constants_;
+  std::vector<double> fractional_yields_;
+  /**Spectrum of precursor j of material m at group g, at
+   * `(material_offsets_[m] + j) * num_groups_ + g`.*/
+  std::vector<double> emission_spectra_;
+  /**Yield weighted sum of the emission spectra, per material and group.*/
+  std::vector<double> steady_state_spectra_;
+
+public:
+  PrecursorEngine() = default;
+  PrecursorEngine(const CellMaterialTable& cell_materials,
+                  size_t num_groups,
+                  size_t max_precursors);
+
+  /**Returns the number of precursors of the given material index.*/
+  size_t NumPrecursors(size_t mat_index) const
+  {
+    return material_offsets_[mat_index + 1] - material_offsets_[mat_index];
+  }
+
+  /**Returns, per material index and group (at `mat * G + g`), the fraction
+   * of the delayed fission rate emitted into the group at steady state.*/
+  const std::vector<double>& SteadyStateEmissionSpectra() const
+  {
+    return steady_state_spectra_;
+  }
+
+  void ComputeTransientEmissionSpectra(double eff_dt,
+                                       std::vector<double>& spectra) const;
+
+  void AddDecayEmission(size_t mat_index,
+                        const double* concentrations,
+                        double eff_dt,
+                        size_t first_grp,
+                        size_t last_grp,
+                        double* emission) const;
+
+  void ComputeSteadyStateConcentrations(
+    const CellMaterialTable& cell_materials,
+    const std::vector<double>& delayed_fission_rates,
+    std::vector<double>& concentrations) const;
+
+  void StepConcentrations(const CellMaterialTable& cell_materials,
+                          const std::vector<double>& delayed_fission_rates,
+                          const std::vector<double>& prev_concentrations,
+                          double dt,
+                          double theta,
+                          std::vector<double>& concentrations) const;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_LBS_PRECURSOR_ENGINE_H
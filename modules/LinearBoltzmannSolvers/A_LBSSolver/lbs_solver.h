@@ -7,13 +7,24 @@
 #include "math/SpatialDiscretization/spatial_discretization.h"
 #include "math/LinearSolver/linear_solver.h"
 #include "lbs_structs.h"
+#include "lbs_packed_unit_cell_matrices.h"
+#include "lbs_cell_material_table.h"
+#include "lbs_precursor_engine.h"
+#include "lbs_fission_engine.h"
 #include "mesh/SweepUtilities/sweep_namespace.h"
 #include "mesh/SweepUtilities/SweepBoundary/sweep_boundaries.h"
 
 #include "A_LBSSolver/PointSource/lbs_point_source.h"
+#include "A_LBSSolver/Tools/lbs_double_compression.h"
+#include "A_LBSSolver/Tools/lbs_flux_rom.h"
+#include "utils/chi_profiler.h"
 
 #include <petscksp.h>
 
+#include <future>
+#include <iosfwd>
+#include <functional>
+
 namespace lbs
 {
 template <class MatType, class VecType, class SolverType>
@@ -55,8 +66,11 @@ public:
 protected:
   typedef chi_mesh::sweep_management::CellFaceNodalMapping CellFaceNodalMapping;
 
-  size_t source_event_tag_ = 0;
+  /**Durations, in seconds, of the source evaluations.*/
+  mutable chi::RunningStatistics source_timing_;
   double last_restart_write_ = 0.0;
+  std::future<bool> restart_write_future_;
+  std::string restart_write_name_;
 
   lbs::Options options_;
   size_t num_moments_ = 0;
@@ -70,6 +84,9 @@ protected:
 
   std::map<int, XSPtr> matid_to_xs_map_;
   std::map<int, IsotropicSrcPtr> matid_to_src_map_;
+  CellMaterialTable cell_material_table_;
+  PrecursorEngine precursor_engine_;
+  FissionEngine fission_engine_;
 
   std::shared_ptr<chi_math::SpatialDiscretization> discretization_ = nullptr;
   chi_mesh::MeshContinuumPtr grid_ptr_;
@@ -78,14 +95,22 @@ protected:
   MPILocalCommSetPtr grid_local_comm_set_ = nullptr;
   GridFaceHistogramPtr grid_face_histogram_ = nullptr;
 
-  std::vector<UnitCellMatrices> unit_cell_matrices_;
-  std::map<uint64_t, UnitCellMatrices> unit_ghost_cell_matrices_;
+  PackedUnitCellMatrices unit_cell_matrices_;
   std::vector<lbs::CellLBSView> cell_transport_views_;
 
   std::map<uint64_t, BoundaryPreference> boundary_preferences_;
   std::map<uint64_t, std::shared_ptr<SweepBndry>> sweep_boundaries_;
 
+  typedef std::shared_ptr<const chi_math::TimeTable> TimeTablePtr;
+  /**Amplitudes in time of the boundary incident fluxes, by boundary id,
+   * and of the volumetric material sources, see SetSourceEvaluationTime.*/
+  std::map<uint64_t, TimeTablePtr> boundary_time_tables_;
+  TimeTablePtr volumetric_source_time_table_ = nullptr;
+  std::vector<double> volumetric_source_amplitudes_;
+  double source_evaluation_time_ = 0.0;
+
   chi_math::UnknownManager flux_moments_uk_man_;
+  FluxMomentBlocks flux_moment_blocks_;
 
   size_t max_cell_dof_count_ = 0;
   uint64_t local_node_count_ = 0;
@@ -96,6 +121,16 @@ protected:
   std::vector<std::vector<double>> psi_new_local_;
   std::vector<double> precursor_new_local_;
 
+  /**Uncollided flux moments of the point sources, per point source for a
+   * unit strength in every group and summed at their strengths, see
+   * InitializeFirstCollisionSource.*/
+  std::vector<std::vector<double>> point_source_uncollided_phi_local_;
+  std::vector<double> uncollided_phi_local_;
+
+  /**Snapshot-based reduced-order model of the flux moments, e.g., for
+   * predicting the initial guess of parametric runs.*/
+  FluxSnapshotROM flux_rom_;
+
   SetSourceFunction active_set_source_function_;
 
   std::vector<AGSLinSolverPtr> ags_solvers_;
@@ -108,6 +143,10 @@ protected:
   /**Time integration parameter meant to be set by an executor*/
   std::shared_ptr<const chi_math::TimeIntegration> time_integration_ = nullptr;
 
+  /**Set once initialized, such that executors sharing the solver can
+   * reuse its state rather than initialize it again.*/
+  bool initialized_ = false;
+
 public:
   static chi::InputParameters GetInputParameters();
   explicit LBSSolver(const std::string& text_name);
@@ -116,9 +155,9 @@ public:
   LBSSolver(const LBSSolver&) = delete;
   LBSSolver& operator=(const LBSSolver&) = delete;
 
-  virtual ~LBSSolver() = default;
+  virtual ~LBSSolver();
 
-  size_t GetSourceEventTag() const;
+  chi::RunningStatistics& GetSourceTiming() const;
 
   double LastRestartWrite() const;
   double& LastRestartWrite();
@@ -126,6 +165,8 @@ public:
   lbs::Options& Options();
   const lbs::Options& Options() const;
 
+  bool IsInitialized() const;
+
   static chi::InputParameters OptionsBlock();
   static chi::InputParameters BoundaryOptionsBlock();
   void SetOptions(const chi::InputParameters& params);
@@ -150,9 +191,11 @@ public:
 
   const std::map<int, XSPtr>& GetMatID2XSMap() const;
   const std::map<int, IsotropicSrcPtr>& GetMatID2IsoSrcMap() const;
+  const CellMaterialTable& GetCellMaterialTable() const;
+  const PrecursorEngine& GetPrecursorEngine() const;
 
   const chi_math::SpatialDiscretization& SpatialDiscretization() const;
-  const std::vector<UnitCellMatrices>& GetUnitCellMatrices() const;
+  const PackedUnitCellMatrices& GetUnitCellMatrices() const;
   const chi_mesh::MeshContinuum& Grid() const;
 
   const std::vector<lbs::CellLBSView>& GetCellTransportViews() const;
@@ -160,6 +203,7 @@ public:
   std::map<uint64_t, BoundaryPreference>& BoundaryPreferences();
 
   const chi_math::UnknownManager& UnknownManager() const;
+  const FluxMomentBlocks& GetFluxMomentBlocks() const;
 
   size_t LocalNodeCount() const;
   size_t GlobalNodeCount() const;
@@ -176,6 +220,8 @@ public:
   const std::vector<double>& PrecursorsNewLocal() const;
   std::vector<VecDbl>& PsiNewLocal();
   const std::vector<VecDbl>& PsiNewLocal() const;
+  bool SavesAngularFlux(int groupset_id) const;
+  FluxSnapshotROM& FluxROM() { return flux_rom_; }
 
   /**Returns the sweep boundaries as a read only reference*/
   const std::map<uint64_t, std::shared_ptr<SweepBndry>>&
@@ -210,11 +256,19 @@ protected:
 public:
   // 01c
   void InitMaterials();
+  void UpdateCrossSections();
+  void UpdateSources();
 
 protected:
+  virtual void UpdateCellCrossSections();
   // 01d
   virtual void InitializeSpatialDiscretization();
   void ComputeUnitIntegrals();
+
+public:
+  void UpdateGeometry(const std::vector<uint64_t>& moved_vertex_ids);
+
+protected:
   // 01e
   void InitializeGroupsets();
   // 01f
@@ -227,14 +281,34 @@ protected:
   void InitializeBoundaries();
 
 public:
+  void UpdateBoundaries();
+
   // 01i
   void InitializePointSources();
+  // 01l
+  void InitializeFirstCollisionSource();
+  void UpdateUncollidedFlux();
+  /**Uncollided flux moments of the point sources at the evaluation time,
+   * empty without a first-collision source.*/
+  const std::vector<double>& UncollidedPhiLocal() const
+  {
+    return uncollided_phi_local_;
+  }
+  void AddUncollidedFlux();
 
 protected:
   // 01j
   virtual void InitializeSolverSchemes();
   virtual void InitializeWGSSolvers(){};
 
+  // 01k
+  /**Reports the bytes held by the mesh, the spatial discretization, the
+   * cross sections, the solver vectors and the DSA solvers to the memory
+   * accounting registry.*/
+  virtual void AccountMemoryUsage() const;
+  /**Accounts for the memory and logs its report. Collective.*/
+  void LogMemoryUsage() const;
+
   // 03d
 public:
   void InitWGDSA(LBSGroupset& groupset, bool vaccum_bcs_are_dirichlet = true);
@@ -255,10 +329,14 @@ public:
                                  std::vector<double>& ref_phi_new);
 
 protected:
+  void UpdateWGDSA(LBSGroupset& groupset);
   static void CleanUpWGDSA(LBSGroupset& groupset);
 
   // 03e
   void InitTGDSA(LBSGroupset& groupset);
+  std::map<int, acceleration::Multigroup_D_and_sigR>
+  PackTGDSAXS(LBSGroupset& groupset);
+  void UpdateTGDSA(LBSGroupset& groupset);
 
 public:
   void AssembleTGDSADeltaPhiVector(const LBSGroupset& groupset,
@@ -278,11 +356,24 @@ public:
                         const std::string& file_base);
   void ReadRestartData(const std::string& folder_name,
                        const std::string& file_base);
+  void FinalizeRestartData();
   // 04b
-  void WriteGroupsetAngularFluxes(const LBSGroupset& groupset,
-                                  const std::string& file_base);
+  void WriteGroupsetAngularFluxes(
+    const LBSGroupset& groupset,
+    const std::string& file_base,
+    DoubleCompression compression = DoubleCompression::NONE,
+    double tolerance = 0.0);
   void ReadGroupsetAngularFluxes(LBSGroupset& groupset,
                                  const std::string& file_base);
+protected:
+  void WriteGroupsetAngularFluxesCompressed(const LBSGroupset& groupset,
+                                            const std::string& file_name,
+                                            DoubleCompression compression,
+                                            double tolerance);
+  void ReadGroupsetAngularFluxesCompressed(LBSGroupset& groupset,
+                                           std::ifstream& file,
+                                           const std::string& file_name);
+public:
 
   // 04c
   std::vector<double> MakeSourceMomentsFromPhi();
@@ -292,6 +383,16 @@ public:
                        std::vector<double>& flux_moments,
                        bool single_file = false);
 
+  // 04d
+  void WriteFluxMomentsCollective(const std::string& file_name,
+                                  const std::vector<double>& flux_moments);
+  void ReadFluxMomentsCollective(const std::string& file_name,
+                                 std::vector<double>& flux_moments);
+  void WriteGroupsetAngularFluxesCollective(const LBSGroupset& groupset,
+                                            const std::string& file_name);
+  void ReadGroupsetAngularFluxesCollective(LBSGroupset& groupset,
+                                           const std::string& file_name);
+
   // 05a
   void UpdateFieldFunctions();
   void SetPhiFromFieldFunctions(PhiSTLOption which_phi,
@@ -299,6 +400,9 @@ public:
                                 const std::vector<size_t>& g_indices);
 
   // 06b
+protected:
+  double IntegrateFissionWeights(const std::vector<double>& phi,
+                                 bool production) const;
 public:
   double ComputeFissionProduction(const std::vector<double>& phi);
   double ComputeFissionRate(const std::vector<double>& phi);
@@ -306,6 +410,8 @@ public:
   // 06c
 public:
   void ComputePrecursors();
+  void ComputeDelayedFissionRates(const std::vector<double>& phi,
+                                  std::vector<double>& rates) const;
 
   // 07 Vector assembly
 public:
@@ -339,6 +445,43 @@ public:
 
   virtual void SetPrimarySTLvectorFromMultiGSPETScVecFrom(
     const std::vector<int>& gs_ids, Vec x_src, PhiSTLOption which_phi);
+
+  size_t CopyGroupSpanToArray(int first_group_id, int last_group_id,
+                              const std::vector<double>& phi,
+                              double* x) const;
+  size_t CopyGroupSpanFromArray(int first_group_id, int last_group_id,
+                                const double* x,
+                                std::vector<double>& phi) const;
+  void ZeroGroupSpan(int first_group_id, int last_group_id,
+                     std::vector<double>& moments) const;
+  std::vector<double>
+  InterleavedFluxMoments(const std::vector<double>& phi) const;
+
+  // 08 Repartitioning
+public:
+  void Repartition(const std::vector<uint64_t>& new_local_cell_pids);
+protected:
+  void ForEachCellStateValue(const chi_mesh::Cell& cell,
+                             bool include_phi_new,
+                             const std::function<void(double&)>& visit);
+
+  // 09 Time dependent sources
+public:
+  void SetBoundaryTimeTable(uint64_t boundary_id, TimeTablePtr time_table);
+  void SetPointSourceTimeTable(size_t point_source_index,
+                               TimeTablePtr time_table);
+  void SetVolumetricSourceTimeTable(TimeTablePtr time_table);
+  void SetSourceEvaluationTime(double time);
+  double SourceEvaluationTime() const { return source_evaluation_time_; }
+  /**Group amplitudes of the volumetric material sources at the evaluation
+   * time, empty without a time table.*/
+  const std::vector<double>& VolumetricSourceAmplitudes() const
+  {
+    return volumetric_source_amplitudes_;
+  }
+
+protected:
+  void ApplyBoundaryTimeTable(uint64_t boundary_id);
 };
 
 } // namespace lbs
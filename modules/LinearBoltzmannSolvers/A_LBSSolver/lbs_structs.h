@@ -5,6 +5,9 @@
 #include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
 #include "physics/PhysicsMaterial/material_property_isotropic_mg_src.h"
 
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
 #include <functional>
 #include <map>
 
@@ -67,6 +70,7 @@ enum class AngleAggregationType
   SINGLE = 1,
   POLAR = 2,
   AZIMUTHAL = 3,
+  SWEEP_ORDERING = 4,
 };
 
 enum class BoundaryType
@@ -82,6 +86,7 @@ struct BoundaryPreference
   BoundaryType type;
   std::vector<double> isotropic_mg_source;
   std::string source_function;
+  bool batched_function = false;
 };
 
 enum SourceFlags : int
@@ -107,6 +112,13 @@ enum class PhiSTLOption
   PHI_NEW = 2
 };
 
+/**Ordering of the flux moment unknowns, see FluxMomentBlocks.*/
+enum class FluxMomentLayout
+{
+  GROUP_INTERLEAVED = 1,
+  GROUPSET_MAJOR = 2
+};
+
 class LBSGroupset;
 typedef std::function<void(LBSGroupset& groupset,
                            std::vector<double>& destination_q,
@@ -125,6 +137,14 @@ struct Options
   SDMType sd_type = SDMType::PIECEWISE_LINEAR_DISCONTINUOUS;
   unsigned int scattering_order = 1;
   int sweep_eager_limit = 32000; // see chiLBSSetProperty documentation
+  bool sweep_eager_limit_auto = false;
+  int sweep_num_threads = 1;
+  bool sweep_persistent_requests = false;
+  bool sweep_shared_memory = false;
+  bool node_shared_quadrature = false;
+  bool numa_first_touch = false;
+  bool lean_cell_mappings = false;
+  FluxMomentLayout flux_moment_layout = FluxMomentLayout::GROUP_INTERLEAVED;
 
   bool read_restart_data = false;
   std::string read_restart_folder_name = std::string("YRestart");
@@ -134,11 +154,15 @@ struct Options
   std::string write_restart_folder_name = std::string("YRestart");
   std::string write_restart_file_base = std::string("restart");
   double write_restart_interval = 30.0;
+  bool write_restart_async = false;
 
   bool use_precursors = false;
   bool use_src_moments = false;
+  bool use_first_collision_source = false;
 
   bool save_angular_flux = false;
+  /**Groupsets whose angular fluxes are saved, all of them when empty.*/
+  std::vector<int> save_angular_flux_groupsets;
 
   bool verbose_inner_iterations = true;
   bool verbose_ags_iterations = false;
@@ -156,23 +180,117 @@ struct Options
   std::vector<AGSSchemeEntry> ags_scheme;
 };
 
+//###################################################################
+/**The group blocks of the local flux moment vectors, i.e., phi, the
+ * source moments and any vector of the same layout. A block holds a
+ * contiguous range of groups, its unknowns being ordered by local node,
+ * moment and group, and the blocks follow each other. The group
+ * interleaved layout is a single block of all the groups, whereas the
+ * groupset major layout has a block per groupset, such that the unknowns
+ * of a groupset are a contiguous sub-vector.*/
+class FluxMomentBlocks
+{
+private:
+  size_t num_moments_ = 0;
+  std::vector<unsigned int> group_block_; ///< The block of each group
+  std::vector<size_t> first_group_;       ///< Per block
+  std::vector<size_t> num_groups_;        ///< Per block
+  std::vector<size_t> offset_;            ///< Per block
+
+public:
+  FluxMomentBlocks() = default;
+  /**Builds the blocks of the given, disjoint, inclusive group ranges,
+   * in that order, for the given number of local nodes. The groups not
+   * covered by a range follow in blocks of consecutive groups.*/
+  FluxMomentBlocks(const std::vector<std::pair<size_t, size_t>>& group_ranges,
+                   size_t num_groups,
+                   size_t num_moments,
+                   size_t num_local_nodes)
+    : num_moments_(num_moments)
+  {
+    const auto no_block = static_cast<unsigned int>(-1);
+    group_block_.assign(num_groups, no_block);
+
+    auto AddBlock = [this](size_t first_group, size_t last_group)
+    {
+      for (size_t g = first_group; g <= last_group; ++g)
+        group_block_[g] = static_cast<unsigned int>(first_group_.size());
+      first_group_.push_back(first_group);
+      num_groups_.push_back(last_group - first_group + 1);
+    };
+
+    for (const auto& [first_group, last_group] : group_ranges)
+    {
+      ChiInvalidArgumentIf(first_group > last_group or
+                             last_group >= num_groups,
+                           "Invalid group range.");
+      for (size_t g = first_group; g <= last_group; ++g)
+        ChiInvalidArgumentIf(group_block_[g] != no_block,
+                             "Group " + std::to_string(g) +
+                               " is in more than one range.");
+      AddBlock(first_group, last_group);
+    }
+
+    for (size_t g = 0; g < num_groups; ++g)
+      if (group_block_[g] == no_block)
+      {
+        size_t last_group = g;
+        while (last_group + 1 < num_groups and
+               group_block_[last_group + 1] == no_block)
+          ++last_group;
+        AddBlock(g, last_group);
+      }
+
+    size_t offset = 0;
+    for (const size_t block_num_groups : num_groups_)
+    {
+      offset_.push_back(offset);
+      offset += num_local_nodes * num_moments * block_num_groups;
+    }
+  }
+
+  size_t NumBlocks() const { return first_group_.size(); }
+  unsigned int GroupBlock(size_t g) const { return group_block_[g]; }
+  size_t BlockFirstGroup(size_t b) const { return first_group_[b]; }
+  size_t BlockNumGroups(size_t b) const { return num_groups_[b]; }
+  size_t BlockOffset(size_t b) const { return offset_[b]; }
+  /**The stride between the unknowns of consecutive nodes in a block.*/
+  size_t BlockNodeStride(size_t b) const
+  {
+    return num_moments_ * num_groups_[b];
+  }
+
+  /**Maps a local node, counted over all the local cells, a moment and a
+   * group to its unknown.*/
+  size_t MapDOF(size_t node, unsigned int moment, unsigned int grp) const
+  {
+    const unsigned int b = group_block_[grp];
+    const size_t block_num_groups = num_groups_[b];
+    return offset_[b] + (node * num_moments_ + moment) * block_num_groups +
+           grp - first_group_[b];
+  }
+};
+
 /**Transport view of a cell*/
 class CellLBSView
 {
 private:
-  size_t phi_address_;
+  size_t node_address_;
+  const FluxMomentBlocks* flux_moment_blocks_;
   int num_nodes_;
   int num_groups_;
-  int num_grps_moms_;
+  int num_moments_;
   const chi_physics::MultiGroupXS* xs_;
   double volume_;
   const std::vector<bool> face_local_flags_;
   const std::vector<int> face_locality_;
   const std::vector<const chi_mesh::Cell*> neighbor_cell_ptrs_;
-  std::vector<double> outflow_;
+  std::vector<double> outflow_; ///< Per face and group, on boundary cells
 
 public:
-  CellLBSView(size_t phi_address,
+  /**The node address is the number of local nodes preceding the cell.*/
+  CellLBSView(size_t node_address,
+              const FluxMomentBlocks& flux_moment_blocks,
               int num_nodes,
               int num_groups,
               int num_moments,
@@ -182,22 +300,93 @@ public:
               const std::vector<int>& face_locality,
               const std::vector<const chi_mesh::Cell*>& neighbor_cell_ptrs,
               bool cell_on_boundary)
-    : phi_address_(phi_address),
+    : node_address_(node_address),
+      flux_moment_blocks_(&flux_moment_blocks),
       num_nodes_(num_nodes),
       num_groups_(num_groups),
-      num_grps_moms_(num_groups * num_moments),
+      num_moments_(num_moments),
       xs_(&xs_mapping),
       volume_(volume),
       face_local_flags_(face_local_flags),
       face_locality_(face_locality),
       neighbor_cell_ptrs_(neighbor_cell_ptrs)
   {
-    if (cell_on_boundary) outflow_.resize(num_groups_, 0.0);
+    if (cell_on_boundary)
+      outflow_.resize(face_local_flags_.size() * num_groups_, 0.0);
   }
 
+  /**Maps a node, moment and group of the cell to its flux moment unknown,
+   * see FluxMomentBlocks. The groups of a groupset are always contiguous,
+   * whereas all the groups of a node and moment are only contiguous with
+   * the group interleaved layout, see GroupsInterleaved.*/
   size_t MapDOF(int node, int moment, int grp) const
   {
-    return phi_address_ + node * num_grps_moms_ + num_groups_ * moment + grp;
+    return flux_moment_blocks_->MapDOF(node_address_ + node, moment, grp);
+  }
+
+  /**Returns true when all the groups of a node and moment are contiguous,
+   * the unknowns of the cell then being the contiguous block starting at
+   * MapDOF(0, 0, 0).*/
+  bool GroupsInterleaved() const
+  {
+    return flux_moment_blocks_->NumBlocks() == 1;
+  }
+
+  /**Returns a pointer to all the groups of a node and moment of a flux
+   * moment vector, into the vector itself when the groups are contiguous,
+   * otherwise to their copy in `scratch`.*/
+  const double* GroupValues(const std::vector<double>& src,
+                            int node,
+                            int moment,
+                            std::vector<double>& scratch) const
+  {
+    if (GroupsInterleaved()) return &src[MapDOF(node, moment, 0)];
+
+    const auto& blocks = *flux_moment_blocks_;
+    scratch.resize(num_groups_);
+    for (size_t b = 0; b < blocks.NumBlocks(); ++b)
+    {
+      const auto gi = static_cast<int>(blocks.BlockFirstGroup(b));
+      std::copy_n(&src[MapDOF(node, moment, gi)],
+                  blocks.BlockNumGroups(b),
+                  &scratch[gi]);
+    }
+    return scratch.data();
+  }
+
+  /**Copies the unknowns of the cell from a flux moment vector to `dst`, in
+   * the group interleaved order of index (node * M + moment) * G + group.*/
+  void GatherUnknowns(const std::vector<double>& src,
+                      std::vector<double>& dst) const
+  {
+    const auto& blocks = *flux_moment_blocks_;
+    const size_t num_rows = static_cast<size_t>(num_nodes_) * num_moments_;
+    dst.resize(num_rows * num_groups_);
+    for (size_t b = 0; b < blocks.NumBlocks(); ++b)
+    {
+      const size_t gb = blocks.BlockNumGroups(b);
+      const double* block_src = &src[MapDOF(0, 0, blocks.BlockFirstGroup(b))];
+      double* block_dst = &dst[blocks.BlockFirstGroup(b)];
+      for (size_t r = 0; r < num_rows; ++r)
+        for (size_t g = 0; g < gb; ++g)
+          block_dst[r * num_groups_ + g] = block_src[r * gb + g];
+    }
+  }
+
+  /**Adds the groups `first_grp` to `last_grp` of unknowns ordered as by
+   * GatherUnknowns to a flux moment vector.*/
+  void ScatterAddUnknowns(const std::vector<double>& src,
+                          size_t first_grp,
+                          size_t last_grp,
+                          std::vector<double>& dst) const
+  {
+    for (int i = 0; i < num_nodes_; ++i)
+      for (int m = 0; m < num_moments_; ++m)
+      {
+        const double* row = &src[(i * num_moments_ + m) * num_groups_];
+        for (size_t g = first_grp; g <= last_grp; ++g)
+          dst[MapDOF(i, m, static_cast<int>(g))] += row[g];
+      }
   }
 
   const chi_physics::MultiGroupXS& XS() const { return *xs_; }
@@ -216,16 +405,29 @@ public:
   void ZeroOutflow() { outflow_.assign(outflow_.size(), 0.0); }
   void ZeroOutflow(int g)
   {
-    if (g < outflow_.size()) outflow_[g] = 0.0;
+    if (g < num_groups_)
+      for (size_t f = 0; f < outflow_.size() / num_groups_; ++f)
+        outflow_[f * num_groups_ + g] = 0.0;
   }
-  void AddOutflow(int g, double intS_mu_psi)
+  /**Adds to the outflow of group g through face f. The update is atomic
+   * because threaded sweeps can have more than one angle set touching the
+   * same cell.*/
+  void AddOutflow(int f, int g, double intS_mu_psi)
   {
-    if (g < outflow_.size()) outflow_[g] += intS_mu_psi;
+    const size_t index = static_cast<size_t>(f) * num_groups_ + g;
+    if (index < outflow_.size())
+    {
+#pragma omp atomic
+      outflow_[index] += intS_mu_psi;
+    }
   }
 
-  double GetOutflow(int g) const
+  /**Returns the outflow of group g through face f, tallied for boundary
+   * faces only.*/
+  double GetOutflow(int f, int g) const
   {
-    if (g < outflow_.size()) return outflow_[g];
+    const size_t index = static_cast<size_t>(f) * num_groups_ + g;
+    if (index < outflow_.size()) return outflow_[index];
     else
       return 0.0;
   }
@@ -234,6 +436,8 @@ public:
   {
     xs_ = &xs_mapped;
   }
+
+  void SetVolume(double volume) { volume_ = volume; }
 };
 
 struct UnitCellMatrices
@@ -248,6 +452,21 @@ struct UnitCellMatrices
   std::vector<VecDbl> face_Si_vectors;
 };
 
+/**Time derivative term of the sweeps of a theta-scheme time step, which
+ * then solve for the angular flux at the theta point of the step. The
+ * inverse velocities times `inv_theta_dt` are added to the total cross
+ * sections and, times the angular fluxes at the start of the step, to the
+ * sources of the sweeps with surface sources. A groupset without these
+ * angular fluxes gets its time source from the source function instead.*/
+struct TimeDerivativeTerm
+{
+  double inv_theta_dt = 0.0;
+  /**Angular fluxes at the start of the step, per groupset id.*/
+  std::vector<std::vector<double>> psi_prev;
+
+  bool IsActive() const { return inv_theta_dt > 0.0; }
+};
+
 enum class AGSSchemeEntryType
 {
   GROUPSET_ID = 1,
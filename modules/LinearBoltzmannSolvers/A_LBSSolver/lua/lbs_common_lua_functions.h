@@ -33,12 +33,24 @@ namespace lbs::common_lua_utils
   int chiLBSReadSourceMoments(lua_State *L);
   int chiLBSReadFluxMoments(lua_State *L);
 
+  int chiLBSWriteFluxMomentsCollective(lua_State *L);
+  int chiLBSReadFluxMomentsCollective(lua_State *L);
+  int chiLBSWriteGroupsetAngularFluxCollective(lua_State *L);
+  int chiLBSReadGroupsetAngularFluxCollective(lua_State *L);
+
   int chiLBSComputeFissionRate(lua_State *L);
   int chiLBSInitializeMaterials(lua_State* L);
+  int chiLBSUpdateCrossSections(lua_State* L);
+  int chiLBSUpdateGeometry(lua_State* L);
+  int chiLBSUpdateSourcesAndBoundaries(lua_State* L);
+  int chiLBSRepartition(lua_State* L);
 
   int chiLBSAddPointSource(lua_State *L);
   int chiLBSClearPointSources(lua_State *L);
   int chiLBSInitializePointSources(lua_State *L);
+
+  int chiLBSSetSourceTimeTable(lua_State *L);
+  int chiLBSSetSourceEvaluationTime(lua_State *L);
 }
 
 #endif //CHITECH_LBS_COMMON_LUA_FUNCTIONS_H
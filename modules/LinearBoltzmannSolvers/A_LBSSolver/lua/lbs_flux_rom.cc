@@ -0,0 +1,163 @@
+#include "lbs_lua_utils.h"
+
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "console/chi_console.h"
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace lbs::common_lua_utils
+{
+
+RegisterLuaFunctionAsIs(chiLBSROMAddSnapshot);
+RegisterLuaFunctionAsIs(chiLBSROMBuildBasis);
+RegisterLuaFunctionAsIs(chiLBSROMWarmStart);
+RegisterLuaFunctionAsIs(chiLBSROMClear);
+
+//###################################################################
+/**Adds the current flux moments (phi-new) of the solver as a snapshot of
+the reduced-order model of the solver, for the given parameter value.
+
+\param SolverIndex int Handle to the solver.
+\param Parameter double Value of the parameter of the solution, e.g., a
+                        material property or the time.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSROMAddSnapshot(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckNumberValue(fname, L, 2);
+
+  const int solver_handle = lua_tointeger(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  const double parameter = lua_tonumber(L, 2);
+  lbs_solver.FluxROM().AddSnapshot(parameter, lbs_solver.PhiNewLocal());
+
+  return 0;
+}
+
+//###################################################################
+/**Builds the POD basis of the reduced-order model of the solver from its
+snapshots. Collective.
+
+\param SolverIndex int Handle to the solver.
+\param EnergyTolerance double Optional. Fraction of the snapshot energy
+                              that the basis may leave out. Default 1.0e-8.
+\param MaxRank int Optional. Maximum rank of the basis, 0 for no limit.
+                   Default 0.
+
+\return rank int The rank of the basis.
+\ingroup LBSLuaFunctions*/
+int chiLBSROMBuildBasis(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args < 1 or num_args > 3)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+
+  const int solver_handle = lua_tointeger(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  double energy_tolerance = 1.0e-8;
+  if (num_args >= 2)
+  {
+    LuaCheckNumberValue(fname, L, 2);
+    energy_tolerance = lua_tonumber(L, 2);
+  }
+  size_t max_rank = 0;
+  if (num_args == 3)
+  {
+    LuaCheckIntegerValue(fname, L, 3);
+    max_rank = static_cast<size_t>(lua_tointeger(L, 3));
+  }
+
+  auto& rom = lbs_solver.FluxROM();
+  const size_t rank = rom.BuildBasis(energy_tolerance, max_rank);
+
+  Chi::log.Log() << lbs_solver.TextName() << ": Flux ROM basis of rank "
+                 << rank << " from " << rom.NumSnapshots() << " snapshots.";
+
+  lua_pushinteger(L, static_cast<lua_Integer>(rank));
+  return 1;
+}
+
+//###################################################################
+/**Sets the flux moments of the solver, phi-old and phi-new, to the
+prediction of its reduced-order model for the given parameter value, such
+that the next execution starts from it.
+
+\param SolverIndex int Handle to the solver.
+\param Parameter double Value of the parameter of the next solution.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSROMWarmStart(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckNumberValue(fname, L, 2);
+
+  const int solver_handle = lua_tointeger(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  const double parameter = lua_tonumber(L, 2);
+  auto phi = lbs_solver.FluxROM().Predict(parameter);
+
+  ChiInvalidArgumentIf(phi.size() != lbs_solver.PhiOldLocal().size(),
+                       "The snapshots do not match the flux moments of the "
+                       "solver.");
+
+  lbs_solver.PhiNewLocal() = phi;
+  lbs_solver.PhiOldLocal() = std::move(phi);
+
+  return 0;
+}
+
+//###################################################################
+/**Removes the snapshots and basis of the reduced-order model of the
+solver.
+
+\param SolverIndex int Handle to the solver.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSROMClear(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+
+  const int solver_handle = lua_tointeger(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.FluxROM().Clear();
+
+  return 0;
+}
+
+}//namespace lbs::common_lua_utils
@@ -317,6 +317,10 @@ LBSGroupset.ANGLE_AGG_SINGLE\n
 LBSGroupset.ANGLE_AGG_AZIMUTHAL\n
  Use Azimuthal angle aggregation.\n\n
 
+LBSGroupset.ANGLE_AGG_SWEEP_ORDERING\n
+ Aggregate the directions having the same sweep ordering on the grid,
+ for any quadrature, e.g., SLDFESQ or custom ones.\n\n
+
 Example:
 \code
 chiLBSGroupsetSetAngleAggregationType(phys1,cur_gs,LBSGroupset.ANGLE_AGG_POLAR)
@@ -365,6 +369,8 @@ int chiLBSGroupsetSetAngleAggregationType(lua_State *L)
     groupset->angleagg_method_ = lbs::AngleAggregationType::POLAR;
   else if (agg_type == (int)lbs::AngleAggregationType::AZIMUTHAL)
     groupset->angleagg_method_ = lbs::AngleAggregationType::AZIMUTHAL;
+  else if (agg_type == (int)lbs::AngleAggregationType::SWEEP_ORDERING)
+    groupset->angleagg_method_ = lbs::AngleAggregationType::SWEEP_ORDERING;
   else
   {
     Chi::log.LogAllError()
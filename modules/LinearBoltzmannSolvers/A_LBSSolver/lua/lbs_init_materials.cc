@@ -1,4 +1,5 @@
 #include "A_LBSSolver/lbs_solver.h"
+#include "mesh/MeshModifiers/MeshModifier.h"
 
 #include "chi_runtime.h"
 
@@ -38,4 +39,125 @@ int chiLBSInitializeMaterials(lua_State *L)
   return 0;
 }
 
-}//namespace lbs::common_lua_utils
\ No newline at end of file
+//###################################################################
+/**Updates the solver to cross sections that have changed since
+ * initialization, e.g. multi-state cross sections set to a new state or
+ * transport cross section properties that were replaced. Unlike
+ * chiLBSInitializeMaterials this also rebuilds the DSA solvers and is
+ * cheap enough to be called every iteration of a coupled multiphysics
+ * loop. The materials of the cells cannot change.
+ *
+\param SolverIndex int Handle to the solver maintaining the information.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSUpdateCrossSections(lua_State *L)
+{
+  const std::string fname = "chiLBSUpdateCrossSections";
+  const int num_args = lua_gettop(L);
+
+  if (num_args != 1)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.UpdateCrossSections();
+
+  return 0;
+}
+
+//###################################################################
+/**Updates the solver to a mesh that was changed in place by mesh modifiers,
+ * e.g. vertices snapped to a plane. Only the cells with a vertex moved by
+ * the given modifiers are re-integrated and the DSA solvers re-assembled,
+ * which is much cheaper than re-initializing the solver. The motion must
+ * not change the topology of the mesh nor flip any face.
+ *
+\param SolverIndex int Handle to the solver maintaining the information.
+\param ModifierHandles table Handles to the mesh modifiers that were
+                       applied since the last update.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSUpdateGeometry(lua_State *L)
+{
+  const std::string fname = "chiLBSUpdateGeometry";
+  const int num_args = lua_gettop(L);
+
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  //============================================= Collect moved vertices
+  std::vector<double> modifier_handles;
+  LuaPopulateVectorFrom1DArray(fname, L, 2, modifier_handles);
+
+  std::vector<uint64_t> moved_vertex_ids;
+  for (const double handle : modifier_handles)
+  {
+    const auto& modifier =
+      Chi::GetStackItem<chi_mesh::MeshModifier>(
+        Chi::object_stack, static_cast<size_t>(handle), fname);
+
+    const auto& vertex_ids = modifier.GetMovedVertexIDs();
+    moved_vertex_ids.insert(moved_vertex_ids.end(),
+                            vertex_ids.begin(), vertex_ids.end());
+  }
+
+  lbs_solver.UpdateGeometry(moved_vertex_ids);
+
+  return 0;
+}
+
+//###################################################################
+/**Updates the solver to material sources, point sources and boundary
+ * conditions that have changed since initialization, e.g. through material
+ * properties, chiLBSAddPointSource or chiLBSSetOptions. The sweep
+ * structures, the iterative solvers and the DSA solvers are kept, such that
+ * a following execute only re-solves. Boundaries cannot change from or to
+ * reflecting.
+ *
+\param SolverIndex int Handle to the solver maintaining the information.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSUpdateSourcesAndBoundaries(lua_State *L)
+{
+  const std::string fname = "chiLBSUpdateSourcesAndBoundaries";
+  const int num_args = lua_gettop(L);
+
+  if (num_args != 1)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.UpdateSources();
+  lbs_solver.UpdateBoundaries();
+
+  return 0;
+}
+
+}//namespace lbs::common_lua_utils
@@ -19,13 +19,22 @@ is to be created.
 \param file_base string Path+Filename_base to use for the output. Each location
                         will append its id to the back plus an extension ".data"
 
+\param compression string Optional. The compression of the values, either
+                          "NONE" (default), "LOSSLESS" or "LOSSY".
+
+\param tolerance double Optional, required for "LOSSY". The maximum absolute
+                        error of any decompressed value.
+
+Compressed files are detected and decompressed by
+chiLBSReadGroupsetAngularFlux.
+
 */
 int chiLBSWriteGroupsetAngularFlux(lua_State *L)
 {
   const std::string fname = "chiLBSWriteGroupsetAngularFlux";
   //============================================= Get arguments
   const int num_args = lua_gettop(L);
-  if (num_args != 3)
+  if (num_args < 3 or num_args > 5)
     LuaPostArgAmountError(fname,3,num_args);
 
   LuaCheckNilValue(fname,L,1);
@@ -36,6 +45,32 @@ int chiLBSWriteGroupsetAngularFlux(lua_State *L)
   const int      grpset_index  = lua_tonumber(L,2);
   const std::string file_base  = lua_tostring(L,3);
 
+  auto compression = lbs::DoubleCompression::NONE;
+  if (num_args >= 4)
+  {
+    LuaCheckStringValue(fname,L,4);
+    const std::string compression_name = lua_tostring(L,4);
+    if      (compression_name == "NONE")
+      compression = lbs::DoubleCompression::NONE;
+    else if (compression_name == "LOSSLESS")
+      compression = lbs::DoubleCompression::LOSSLESS;
+    else if (compression_name == "LOSSY")
+      compression = lbs::DoubleCompression::LOSSY;
+    else
+      throw std::invalid_argument(fname + ": Unknown compression \"" +
+                                  compression_name + "\".");
+  }
+
+  double tolerance = 0.0;
+  if (num_args == 5)
+  {
+    LuaCheckNumberValue(fname,L,5);
+    tolerance = lua_tonumber(L,5);
+  }
+  if (compression == lbs::DoubleCompression::LOSSY and not (tolerance > 0.0))
+    throw std::invalid_argument(fname + ": LOSSY compression requires a "
+                                        "positive tolerance.");
+
   //============================================= Get pointer to solver
   auto& lbs_solver =
     Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
@@ -55,7 +90,8 @@ int chiLBSWriteGroupsetAngularFlux(lua_State *L)
     Chi::Exit(EXIT_FAILURE);
   }
 
-  lbs_solver.WriteGroupsetAngularFluxes(*groupset, file_base);
+  lbs_solver.WriteGroupsetAngularFluxes(*groupset, file_base,
+                                        compression, tolerance);
 
   return 0;
 }
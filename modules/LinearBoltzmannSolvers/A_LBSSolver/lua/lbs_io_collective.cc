@@ -0,0 +1,185 @@
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "A_LBSSolver/Groupset/lbs_groupset.h"
+
+namespace lbs::common_lua_utils
+{
+
+//###################################################################
+/**Collectively writes the flux-moments of a LBS solution (phi_old_local)
+ * to a single file. The file is keyed by cell global ids and can be read
+ * with chiLBSReadFluxMomentsCollective on any number of processes.
+
+\param SolverIndex int Handle to the solver.
+
+\param file_name string Path+Filename of the file.
+
+*/
+int chiLBSWriteFluxMomentsCollective(lua_State *L)
+{
+  const std::string fname = "chiLBSWriteFluxMomentsCollective";
+  //============================================= Get arguments
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname,2,num_args);
+
+  LuaCheckNilValue(fname,L,1);
+  LuaCheckNilValue(fname,L,2);
+
+  const int      solver_handle = lua_tonumber(L,1);
+  const std::string file_name = lua_tostring(L,2);
+
+  //============================================= Get pointer to solver
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.WriteFluxMomentsCollective(file_name, lbs_solver.PhiOldLocal());
+
+  return 0;
+}
+
+//###################################################################
+/**Collectively reads flux-moments from a single file, written with
+ * chiLBSWriteFluxMomentsCollective, to phi_old_local (the initial flux
+ * solution).
+
+\param SolverIndex int Handle to the solver.
+
+\param file_name string Path+Filename of the file.
+
+*/
+int chiLBSReadFluxMomentsCollective(lua_State *L)
+{
+  const std::string fname = "chiLBSReadFluxMomentsCollective";
+  //============================================= Get arguments
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname,2,num_args);
+
+  LuaCheckNilValue(fname,L,1);
+  LuaCheckNilValue(fname,L,2);
+
+  const int      solver_handle = lua_tonumber(L,1);
+  const std::string file_name = lua_tostring(L,2);
+
+  //============================================= Get pointer to solver
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.ReadFluxMomentsCollective(file_name, lbs_solver.PhiOldLocal());
+
+  return 0;
+}
+
+//###################################################################
+/**Collectively writes the angular fluxes of a LBS groupset to a single
+ * file. The file is keyed by cell global ids and can be read with
+ * chiLBSReadGroupsetAngularFluxCollective on any number of processes.
+
+\param SolverIndex int Handle to the solver.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+
+\param file_name string Path+Filename of the file.
+
+*/
+int chiLBSWriteGroupsetAngularFluxCollective(lua_State *L)
+{
+  const std::string fname = "chiLBSWriteGroupsetAngularFluxCollective";
+  //============================================= Get arguments
+  const int num_args = lua_gettop(L);
+  if (num_args != 3)
+    LuaPostArgAmountError(fname,3,num_args);
+
+  LuaCheckNilValue(fname,L,1);
+  LuaCheckNilValue(fname,L,2);
+  LuaCheckNilValue(fname,L,3);
+
+  const int      solver_handle = lua_tonumber(L, 1);
+  const int      grpset_index  = lua_tonumber(L,2);
+  const std::string file_name  = lua_tostring(L,3);
+
+  //============================================= Get pointer to solver
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  //============================================= Obtain pointer to groupset
+  lbs::LBSGroupset* groupset = nullptr;
+  try{
+    groupset = &lbs_solver.Groupsets().at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    Chi::log.LogAllError()
+      << "Invalid handle to groupset "
+      << "in call to " << fname;
+    Chi::Exit(EXIT_FAILURE);
+  }
+
+  lbs_solver.WriteGroupsetAngularFluxesCollective(*groupset, file_name);
+
+  return 0;
+}
+
+//###################################################################
+/**Collectively reads the angular fluxes of a LBS groupset from a single
+ * file written with chiLBSWriteGroupsetAngularFluxCollective.
+
+\param SolverIndex int Handle to the solver.
+
+\param GroupsetIndex int Index to the groupset to which this function should
+                         apply
+
+\param file_name string Path+Filename of the file.
+
+*/
+int chiLBSReadGroupsetAngularFluxCollective(lua_State *L)
+{
+  const std::string fname = "chiLBSReadGroupsetAngularFluxCollective";
+  //============================================= Get arguments
+  const int num_args = lua_gettop(L);
+  if (num_args != 3)
+    LuaPostArgAmountError(fname,3,num_args);
+
+  LuaCheckNilValue(fname,L,1);
+  LuaCheckNilValue(fname,L,2);
+  LuaCheckNilValue(fname,L,3);
+
+  const int      solver_handle = lua_tonumber(L, 1);
+  const int      grpset_index  = lua_tonumber(L,2);
+  const std::string file_name  = lua_tostring(L,3);
+
+  //============================================= Get pointer to solver
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  //============================================= Obtain pointer to groupset
+  lbs::LBSGroupset* groupset = nullptr;
+  try{
+    groupset = &lbs_solver.Groupsets().at(grpset_index);
+  }
+  catch (const std::out_of_range& o)
+  {
+    Chi::log.LogAllError()
+      << "Invalid handle to groupset "
+      << "in call to " << fname;
+    Chi::Exit(EXIT_FAILURE);
+  }
+
+  lbs_solver.ReadGroupsetAngularFluxesCollective(*groupset, file_name);
+
+  return 0;
+}
+
+}//namespace lbs::common_lua_utils
@@ -0,0 +1,73 @@
+#include "lbs_lua_utils.h"
+
+#include "lua/lua_buffer.h"
+
+#include "LinearBoltzmannSolvers/A_LBSSolver/lbs_solver.h"
+
+#include "console/chi_console.h"
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace lbs::common_lua_utils
+{
+
+RegisterLuaFunctionAsIs(chiLBSGetPhiBuffer);
+
+/**Gets a buffer over the local flux moments of the solver, without copying
+them. Writing to the buffer writes the flux moments, e.g., to couple them
+to another code every time step without marshalling them element by
+element.
+\param handle int Handle to the lbs-based object.
+\param which_phi string Optional. Can be "old" or "new". Denotes which phi
+       version to expose. Default: `"old"`.
+
+\return A buffer, see chiBufferCreate, over the local flux moments in the
+order of the solver's unknown manager. It follows the flux moments when
+the solver is reinitialized.
+
+### Example usage
+Example:
+\code
+phi = chiLBSGetPhiBuffer(phys1)
+phi_prev = phi:Copy()
+chiSolverExecute(phys1)
+phi_prev:Axpy(-1.0, phi)
+print(phi_prev:Dot(phi_prev))
+\endcode
+*/
+int chiLBSGetPhiBuffer(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 1 and num_args != 2)
+    LuaPostArgAmountError(fname, /*expected=*/1, /*given=*/num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  const size_t handle = lua_tointeger(L, 1);
+
+  auto lbs_solver =
+    Chi::GetStackItemPtrAsType<lbs::LBSSolver>(Chi::object_stack,
+                                               handle, fname);
+
+  std::string phi_str = "old";
+  if (num_args == 2)
+  {
+    LuaCheckStringValue(fname, L, 2);
+    phi_str = lua_tostring(L, 2);
+  }
+  ChiInvalidArgumentIf(phi_str != "old" and phi_str != "new",
+                       std::string("Parameter \"which_phi\" can only be"
+                                   " \"old\" or \"new\". ") +
+                         "\"" + phi_str + "\" is not allowed.");
+
+  auto& phi = phi_str == "old" ? lbs_solver->PhiOldLocal()
+                               : lbs_solver->PhiNewLocal();
+
+  chi_lua::PushBuffer(L,
+                      chi_lua::LuaBuffer::FromVector(
+                        std::shared_ptr<std::vector<double>>(lbs_solver,
+                                                              &phi)));
+  return 1;
+}
+
+} // namespace lbs::common_lua_utils
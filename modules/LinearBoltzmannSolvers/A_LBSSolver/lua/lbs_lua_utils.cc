@@ -47,6 +47,7 @@ namespace lbs::common_lua_utils
       RegisterNumber(VERBOSE_INNER_ITERATIONS, 10);
       RegisterNumber(VERBOSE_OUTER_ITERATIONS, 11);
       RegisterNumber(USE_PRECURSORS, 12);
+      RegisterNumber(USE_FIRST_COLLISION_SOURCE, 13);
 
     RegisterTable(LBSBoundaryTypes);
     RegisterNumberValueToTable(VACUUM            ,1,LBSBoundaryTypes);
@@ -63,6 +64,7 @@ namespace lbs::common_lua_utils
       RegisterNumberValueToTable(ANGLE_AGG_SINGLE, 1, LBSGroupset);
       RegisterNumberValueToTable(ANGLE_AGG_POLAR, 2, LBSGroupset);
       RegisterNumberValueToTable(ANGLE_AGG_AZIMUTHAL, 3, LBSGroupset);
+      RegisterNumberValueToTable(ANGLE_AGG_SWEEP_ORDERING, 4, LBSGroupset);
     RegisterFunction(chiLBSGroupsetSetAngleAggDiv);
     RegisterFunction(chiLBSGroupsetSetGroupSubsets);
     RegisterFunction(chiLBSGroupsetSetIterativeMethod);
@@ -90,11 +92,23 @@ namespace lbs::common_lua_utils
     RegisterFunction(chiLBSReadSourceMoments);
     RegisterFunction(chiLBSReadFluxMoments);
 
+    RegisterFunction(chiLBSWriteFluxMomentsCollective);
+    RegisterFunction(chiLBSReadFluxMomentsCollective);
+    RegisterFunction(chiLBSWriteGroupsetAngularFluxCollective);
+    RegisterFunction(chiLBSReadGroupsetAngularFluxCollective);
+
     RegisterFunction(chiLBSComputeFissionRate);
     RegisterFunction(chiLBSInitializeMaterials);
+    RegisterFunction(chiLBSUpdateCrossSections);
+    RegisterFunction(chiLBSUpdateGeometry);
+    RegisterFunction(chiLBSUpdateSourcesAndBoundaries);
+    RegisterFunction(chiLBSRepartition);
 
     RegisterFunction(chiLBSAddPointSource);
     RegisterFunction(chiLBSClearPointSources);
     RegisterFunction(chiLBSInitializePointSources);
+
+    RegisterFunction(chiLBSSetSourceTimeTable);
+    RegisterFunction(chiLBSSetSourceEvaluationTime);
   }
 }
\ No newline at end of file
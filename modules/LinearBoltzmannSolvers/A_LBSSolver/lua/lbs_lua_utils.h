@@ -21,6 +21,11 @@ SetOptions(const chi::InputParameters& params);
 
 int chiLBSSetOptions(lua_State* L);
 int chiLBSSetPhiFromFieldFunction(lua_State* L);
+int chiLBSGetPhiBuffer(lua_State* L);
+int chiLBSROMAddSnapshot(lua_State* L);
+int chiLBSROMBuildBasis(lua_State* L);
+int chiLBSROMWarmStart(lua_State* L);
+int chiLBSROMClear(lua_State* L);
 void RegisterLuaEntities(lua_State* L);
 } // namespace lbs::common_lua_utils
 
@@ -0,0 +1,51 @@
+#include "A_LBSSolver/lbs_solver.h"
+#include "mesh/MeshHandler/chi_meshhandler.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+
+namespace lbs::common_lua_utils
+{
+
+//###################################################################
+/**Rebalances the solver between executions. A new partition is computed
+ * along a Hilbert curve through the cell centroids, the cells are moved,
+ * with their flux moments, angular fluxes and precursors, to their new
+ * locations and the solver is re-initialized in place. Any other object
+ * built on the grid, e.g., other solvers, must be re-created.
+ *
+\param SolverIndex int Handle to the solver.
+\param CellWeights table Optional. One weight per local cell, in local id
+                   order, e.g., measured cell costs. The cell count is
+                   balanced if not supplied.
+
+\ingroup LBSLuaFunctions*/
+int chiLBSRepartition(lua_State *L)
+{
+  const std::string fname = "chiLBSRepartition";
+  const int num_args = lua_gettop(L);
+
+  if (num_args < 1)
+    LuaPostArgAmountError(fname, 1, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  std::vector<double> cell_weights;
+  if (num_args >= 2)
+    LuaPopulateVectorFrom1DArray(fname, L, 2, cell_weights);
+
+  const auto& grid = lbs_solver.Grid();
+  lbs_solver.Repartition(grid.MakeHilbertRepartition(cell_weights));
+
+  return 0;
+}
+
+}//namespace lbs::common_lua_utils
@@ -29,6 +29,7 @@ enum class PropertyCode : int
   VERBOSE_INNER_ITERATIONS = 10,
   VERBOSE_OUTER_ITERATIONS = 11,
   USE_PRECURSORS = 12,
+  USE_FIRST_COLLISION_SOURCE = 13,
 };
 
 // ###################################################################
@@ -60,7 +61,8 @@ READ_RESTART_DATA\n
  The value can be followed by two
  optional strings. The first is the folder name which can be relative or
  absolute, and the second is the file base name. These are defaulted to
- "YRestart" and "restart" respectively.\n\n
+ "YRestart" and "restart" respectively. The restart data may have been
+ written with any number of processes.\n\n
 
 SAVE_ANGULAR_FLUX\n
 Sets the flag for saving the angular flux. Expects to be followed by true/false.
@@ -85,6 +87,12 @@ USE_PRECURSORS\n
  Flag for using delayed neutron precursors. Default false. This expects
  to be followed by a boolean.\n\n
 
+USE_FIRST_COLLISION_SOURCE\n
+ Flag for replacing the point sources by their first-collision source, the
+ uncollided flux being computed along rays and added to the solved collided
+ flux. Takes effect when the point sources are initialized. 3D only.
+ Default false. This expects to be followed by a boolean.\n\n
+
 \code
 chiLBSSetProperty(phys1,READ_RESTART_DATA,"YRestart1")
 \endcode
@@ -96,10 +104,14 @@ WRITE_RESTART_DATA\n
  absolute, and the second string is the file base name. The number is the time
  interval (in minutes) for a restart write to be triggered (apart from GMRES
  restarts and the conclusion of groupset completions) .These are defaulted to
- "YRestart", "restart" and 30 minutes respectively.\n\n
+ "YRestart", "restart" and 30 minutes respectively. An optional boolean may
+ follow the interval which, when true, writes the restart data
+ asynchronously from a background thread such that the solve continues
+ while the files are written. Default false.\n\n
 
 \code
 chiLBSSetProperty(phys1,WRITE_RESTART_DATA,"YRestart1","restart",1)
+chiLBSSetProperty(phys1,WRITE_RESTART_DATA,"YRestart1","restart",1,true)
 \endcode
 
 ###Discretization methods
@@ -423,13 +435,20 @@ int chiLBSSetProperty(lua_State* L)
       lbs_solver.Options().write_restart_file_base = std::string(filebase);
       Chi::log.Log() << "Restart output filebase set to " << filebase;
     }
-    if (numArgs == 5)
+    if (numArgs >= 5)
     {
       LuaCheckNilValue(fname, L, 5);
 
       const double interval = lua_tonumber(L, 5);
       lbs_solver.Options().write_restart_interval = interval;
     }
+    if (numArgs == 6)
+    {
+      LuaCheckNilValue(fname, L, 6);
+
+      const bool async_flag = lua_toboolean(L, 6);
+      lbs_solver.Options().write_restart_async = async_flag;
+    }
     lbs_solver.Options().write_restart_data = true;
   }
   else if (scpcode(property) == PropertyCode::SAVE_ANGULAR_FLUX)
@@ -482,6 +501,17 @@ int chiLBSSetProperty(lua_State* L)
 
     Chi::log.Log() << "LBS option: use_precursors set to " << flag;
   }
+  else if (scpcode(property) == PropertyCode::USE_FIRST_COLLISION_SOURCE)
+  {
+    LuaCheckNilValue(fname, L, 3);
+
+    const bool flag = lua_toboolean(L, 3);
+
+    lbs_solver.Options().use_first_collision_source = flag;
+
+    Chi::log.Log() << "LBS option: use_first_collision_source set to "
+                   << flag;
+  }
   else
     throw std::logic_error(fname +
                            ": Invalid property in chiLBSSetProperty.\n");
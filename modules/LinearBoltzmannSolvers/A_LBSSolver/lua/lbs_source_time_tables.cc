@@ -0,0 +1,114 @@
+#include "A_LBSSolver/lbs_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace lbs::common_lua_utils
+{
+
+//###################################################################
+/**Sets the amplitudes in time of a boundary, a point source or the
+ * volumetric sources of an LBS solver. The incident fluxes or strengths
+ * are scaled by the amplitudes, interpolated linearly in time, such that
+ * boundary functions are evaluated once and only provide the shapes.
+\param SolverIndex int Handle to the solver.
+\param Kind string Either "boundary", "point_source" or "volumetric".
+\param Index int The boundary id or the point source index, starting at 0,
+       omitted for "volumetric".
+\param Times table Increasing times of the table.
+\param Amplitudes table Amplitudes, one per time or, time after time, one
+       per group.
+
+ \ingroup LBSLuaFunctions
+ */
+int chiLBSSetSourceTimeTable(lua_State *L)
+{
+  const std::string fname = "chiLBSSetSourceTimeTable";
+  const int num_args = lua_gettop(L);
+  if (num_args != 4 and num_args != 5)
+    LuaPostArgAmountError(fname, 5, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  //============================================= Get other arguments
+  const std::string kind = lua_tostring(L, 2);
+  const bool volumetric = kind == "volumetric";
+  if (not volumetric and kind != "boundary" and kind != "point_source")
+    throw std::invalid_argument(fname + ": Invalid kind \"" + kind + "\".");
+  if (num_args != (volumetric ? 4 : 5))
+    LuaPostArgAmountError(fname, volumetric ? 4 : 5, num_args);
+
+  size_t index = 0;
+  if (not volumetric)
+  {
+    LuaCheckIntegerValue(fname, L, 3);
+    const auto value = lua_tointeger(L, 3);
+    if (value < 0)
+      throw std::invalid_argument(fname + ": Invalid index.");
+    index = static_cast<size_t>(value);
+  }
+
+  const int times_arg = volumetric ? 3 : 4;
+  LuaCheckTableValue(fname, L, times_arg);
+  LuaCheckTableValue(fname, L, times_arg + 1);
+
+  std::vector<double> times, amplitudes;
+  LuaPopulateVectorFrom1DArray(fname, L, times_arg, times);
+  LuaPopulateVectorFrom1DArray(fname, L, times_arg + 1, amplitudes);
+
+  if (times.empty() or amplitudes.size() % times.size() != 0)
+    throw std::invalid_argument(fname + ": The number of amplitudes must be "
+                                        "a multiple of the number of times.");
+
+  const size_t num_components = amplitudes.size() / times.size();
+  auto time_table = std::make_shared<const chi_math::TimeTable>(
+    std::move(times), std::move(amplitudes), num_components);
+
+  if (volumetric) lbs_solver.SetVolumetricSourceTimeTable(time_table);
+  else if (kind == "boundary")
+    lbs_solver.SetBoundaryTimeTable(index, time_table);
+  else
+    lbs_solver.SetPointSourceTimeTable(index, time_table);
+
+  return 0;
+}
+
+//###################################################################
+/**Sets the time at which the time tables of the boundaries and sources of
+ * an LBS solver are evaluated. Transient solvers set it every step.
+\param SolverIndex int Handle to the solver.
+\param Time double The evaluation time.
+
+ \ingroup LBSLuaFunctions
+ */
+int chiLBSSetSourceEvaluationTime(lua_State *L)
+{
+  const std::string fname = "chiLBSSetSourceEvaluationTime";
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckNumberValue(fname, L, 2);
+
+  //============================================= Get pointer to solver
+  const int solver_handle = lua_tonumber(L, 1);
+  auto& lbs_solver =
+    Chi::GetStackItem<lbs::LBSSolver>(Chi::object_stack,
+                                      solver_handle,
+                                      fname);
+
+  lbs_solver.SetSourceEvaluationTime(lua_tonumber(L, 2));
+
+  return 0;
+}
+
+}//namespace lbs::common_lua_utils
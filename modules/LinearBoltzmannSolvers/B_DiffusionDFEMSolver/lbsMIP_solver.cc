@@ -6,6 +6,7 @@
 #include "A_LBSSolver/Acceleration/diffusion_mip.h"
 #include "A_LBSSolver/IterativeMethods/wgs_linear_solver.h"
 #include "IterativeMethods/mip_wgs_context2.h"
+#include "utils/chi_memory_accounting.h"
 
 namespace lbs
 {
@@ -60,6 +61,7 @@ void DiffusionDFEMSolver::Initialize()
     InitTGDSA(groupset);
 
   LBSSolver::InitializeSolverSchemes();
+  LogMemoryUsage();
 }
 
 // ##################################################################
@@ -177,4 +179,17 @@ void DiffusionDFEMSolver::InitializeWGSSolvers()
   } // for groupset
 }
 
+// ##################################################################
+/**Adds the groupset diffusion solvers to the DSA matrices.*/
+void DiffusionDFEMSolver::AccountMemoryUsage() const
+{
+  LBSSolver::AccountMemoryUsage();
+
+  auto& accounting = chi::MemoryAccounting::GetInstance();
+  size_t num_bytes = accounting.GetUsage("DSA matrices");
+  for (const auto& mip_solver : gs_mip_solvers_)
+    if (mip_solver) num_bytes += mip_solver->GetMemoryUsage();
+  accounting.SetUsage("DSA matrices", num_bytes);
+}
+
 } // namespace lbs
\ No newline at end of file
@@ -22,6 +22,7 @@ public:
   // 01
   void Initialize() override;
   void InitializeWGSSolvers() override;
+  void AccountMemoryUsage() const override;
 };
 
 } // namespace lbs
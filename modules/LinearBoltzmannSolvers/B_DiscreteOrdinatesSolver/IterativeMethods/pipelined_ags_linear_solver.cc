@@ -0,0 +1,166 @@
+#include "pipelined_ags_linear_solver.h"
+
+#include "sweep_wgs_context.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include <petscksp.h>
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "utils/chi_timer.h"
+
+#include <iomanip>
+#include <cmath>
+
+#define GetAGSContextPtr(x) \
+        std::dynamic_pointer_cast<AGSContext<Mat,Vec,KSP>>(x)
+#define GetSweepWGSContextPtr(x) \
+        std::dynamic_pointer_cast<SweepWGSContext<Mat,Vec,KSP>>(x)
+
+namespace lbs
+{
+
+namespace
+{
+/**Computes the global 2-norm of the change between the new and old flux
+ * moments of a groupset, along with the 2-norm of the new flux moments.*/
+std::pair<double, double> ComputeGroupsetChange(const LBSSolver& lbs_solver,
+                                                const LBSGroupset& groupset)
+{
+  const auto& phi_new = lbs_solver.PhiNewLocal();
+  const auto& phi_old = lbs_solver.PhiOldLocal();
+  const auto& cell_transport_views = lbs_solver.GetCellTransportViews();
+  const size_t num_moments = lbs_solver.NumMoments();
+
+  const int gsi = groupset.groups_.front().id_;
+  const int gsf = groupset.groups_.back().id_;
+
+  double local_sums[2] = {0.0, 0.0};
+  for (const auto& cell : lbs_solver.Grid().local_cells)
+  {
+    const auto& transport_view = cell_transport_views[cell.local_id_];
+    for (int i = 0; i < transport_view.NumNodes(); ++i)
+      for (size_t m = 0; m < num_moments; ++m)
+      {
+        const size_t uk_map = transport_view.MapDOF(i, m, gsi);
+        for (int gsg = 0; gsg <= gsf - gsi; ++gsg)
+        {
+          const double delta = phi_new[uk_map + gsg] - phi_old[uk_map + gsg];
+          local_sums[0] += delta * delta;
+          local_sums[1] += phi_new[uk_map + gsg] * phi_new[uk_map + gsg];
+        }
+      }
+  }
+
+  double global_sums[2] = {0.0, 0.0};
+  MPI_Allreduce(local_sums, global_sums, 2, MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+
+  return {std::sqrt(global_sums[0]), std::sqrt(global_sums[1])};
+}
+} // namespace
+
+template<>
+void PipelinedAGSLinearSolver<Mat,Vec,KSP>::Solve()
+{
+  typedef chi_mesh::sweep_management::SweepScheduler SweepScheduler;
+
+  auto ags_context_ptr = GetAGSContextPtr(context_ptr_);
+  auto& lbs_solver = ags_context_ptr->lbs_solver_;
+
+  std::vector<std::shared_ptr<SweepWGSContext<Mat,Vec,KSP>>> contexts;
+  std::vector<SweepScheduler*> schedulers;
+  int max_iterations = 0;
+  for (auto& solver : ags_context_ptr->sub_solvers_list_)
+  {
+    auto context = GetSweepWGSContextPtr(solver->GetContext());
+    ChiLogicalErrorIf(not context,
+                      "Pipelined AGS sweeps require sweep based "
+                      "within-groupset contexts.");
+
+    max_iterations =
+      std::max(max_iterations, context->groupset_.max_iterations_);
+    schedulers.push_back(&context->sweep_scheduler_);
+    contexts.push_back(std::move(context));
+  }
+
+  //Save qmoms to be restored after each iteration.
+  //This is necessary for multiple ags iterations to function
+  //and for keigen-value problems
+  const auto saved_qmoms = lbs_solver.QMomentsLocal();
+  auto& q_moments = lbs_solver.QMomentsLocal();
+
+  for (int iter = 0; iter < max_iterations; ++iter)
+  {
+    //=============================================== Sources of all groupsets
+    q_moments = saved_qmoms;
+    for (auto& context : contexts)
+    {
+      const int scope = context->lhs_src_scope_ | context->rhs_src_scope_;
+      context->set_source_function_(
+        context->groupset_, q_moments, lbs_solver.PhiOldLocal(), scope);
+
+      const bool use_bndry_source_flag =
+        (scope & APPLY_FIXED_SOURCES) and
+        (not lbs_solver.Options().use_src_moments);
+
+      auto& sweep_scheduler = context->sweep_scheduler_;
+      sweep_scheduler.SetBoundarySourceActiveFlag(use_bndry_source_flag);
+      sweep_scheduler.SetDestinationPhi(lbs_solver.PhiNewLocal());
+      sweep_scheduler.ZeroOutputFluxDataStructures();
+      ++context->counter_applications_of_inv_op_;
+    }
+
+    //=============================================== Sweep all groupsets
+    for (auto& context : contexts)
+      context->lbs_ss_solver_.UpdateCellFactorCache(context->groupset_);
+    SweepScheduler::SweepConcurrently(schedulers);
+    for (auto& context : contexts)
+      context->lbs_ss_solver_.CompleteDeferredSources(context->groupset_);
+
+    //=============================================== Check convergence
+    bool all_converged = true;
+    for (auto& context : contexts)
+    {
+      auto& groupset = context->groupset_;
+
+      groupset.angle_agg_->SetDelayedPsiNew2Old();
+
+      const auto [change_norm, phi_norm] =
+        ComputeGroupsetChange(lbs_solver, groupset);
+      const double relative_change =
+        phi_norm > 1.0e-25 ? change_norm / phi_norm : change_norm;
+
+      lbs_solver.GSScopedCopyPrimarySTLvectors(
+        groupset, PhiSTLOption::PHI_NEW, PhiSTLOption::PHI_OLD);
+
+      const bool converged = relative_change < groupset.residual_tolerance_;
+      if (not converged) all_converged = false;
+
+      if (context->log_info_)
+        Chi::log.Log()
+          << Chi::program_timer.GetTimeString() << " "
+          << "Pipelined WGS groups [" << groupset.groups_.front().id_ << "-"
+          << groupset.groups_.back().id_ << "]"
+          << " Iteration " << std::setw(5) << iter
+          << " Relative change " << std::setw(9) << relative_change
+          << (converged ? " CONVERGED" : "");
+    }
+
+    if (verbose_)
+      Chi::log.Log()
+        << "********** Pipelined AGS solver iteration " << std::setw(3)
+        << iter << (all_converged ? " CONVERGED" : "");
+
+    if (all_converged) break;
+  }//for iteration
+
+  q_moments = saved_qmoms; //Restore qmoms
+
+  for (auto& context : contexts)
+    context->PostSolveCallback();
+}
+
+}//namespace lbs
@@ -0,0 +1,46 @@
+#ifndef CHITECH_PIPELINED_AGS_LINEAR_SOLVER_H
+#define CHITECH_PIPELINED_AGS_LINEAR_SOLVER_H
+
+#include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
+
+namespace lbs
+{
+
+//################################################################### Class def
+/**Across-GroupSet solver that sweeps all the groupsets concurrently. Each
+ * iteration builds the sources of every groupset from the previous
+ * iterate and then executes the sweeps of all groupsets in a single
+ * scheduling loop, so that the sweep of one groupset fills the pipeline
+ * idle time of another. Iterations continue until every groupset has met
+ * its own tolerance. Within-groupset solves are replaced by this source
+ * iteration, hence all groupsets must use richardson without DSA.*/
+template<class MatType, class VecType, class SolverType>
+class PipelinedAGSLinearSolver : public
+                                 AGSLinearSolver<MatType,VecType,SolverType>
+{
+public:
+  typedef typename AGSLinearSolver<MatType,VecType,SolverType>::AGSContextPtr
+    AGSContextPtr;
+
+  /**Constructor.
+   * \param ags_context_ptr Pointer Pointer to the context to use.
+   * \param groupspan_first_id int First group index.
+   * \param groupspan_last_id int Last group index.
+   * \param verbose bool Flag to enable verbose output.*/
+  PipelinedAGSLinearSolver(AGSContextPtr ags_context_ptr,
+                           int groupspan_first_id,
+                           int groupspan_last_id,
+                           bool verbose = true) :
+    AGSLinearSolver<MatType,VecType,SolverType>("richardson",
+                                                std::move(ags_context_ptr),
+                                                groupspan_first_id,
+                                                groupspan_last_id,
+                                                verbose)
+  {}
+
+  void Solve() override;
+};
+
+}//namespace lbs
+
+#endif //CHITECH_PIPELINED_AGS_LINEAR_SOLVER_H
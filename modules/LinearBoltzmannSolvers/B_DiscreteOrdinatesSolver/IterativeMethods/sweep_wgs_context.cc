@@ -7,7 +7,9 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
 
+#include <cmath>
 #include <iomanip>
 
 #define sc_double static_cast<double>
@@ -47,6 +49,103 @@ void SweepWGSContext<Mat, Vec, KSP>::PreSetupCallback()
   }
 }
 
+/**Sets up the sweeps of the angular multigrid coarse level, using the
+ * given sweep chunk of the coarse groupset.*/
+template <>
+void SweepWGSContext<Mat, Vec, KSP>::SetAngularMGSweepChunk(
+  std::shared_ptr<chi_mesh::sweep_management::SweepChunk> sweep_chunk)
+{
+  auto& coarse_groupset = *groupset_.angular_mg_groupset_;
+
+  angular_mg_sweep_chunk_ = std::move(sweep_chunk);
+  angular_mg_sweep_scheduler_ =
+    std::make_unique<chi_mesh::sweep_management::SweepScheduler>(
+      lbs_ss_solver_.SweepSchedulingAlgorithm(),
+      *coarse_groupset.angle_agg_,
+      *angular_mg_sweep_chunk_);
+
+  angular_mg_phi_.assign(lbs_solver_.PhiNewLocal().size(), 0.0);
+  angular_mg_sweep_scheduler_->SetDestinationPhi(angular_mg_phi_);
+}
+
+/**Applies the two-level angular multigrid preconditioner, i.e. the coarse
+ * angle correction of transport synthetic acceleration. For the input r,
+ * the correction e solves (I - T_c) e = T_c r, where T_c is the
+ * within-groupset transport operator swept with the coarse quadrature. It
+ * is approximated with `angular_mg_l_max_its` source iterations
+ * e = T_c (r + e), starting from zero, and the output is r + e.*/
+template <>
+void SweepWGSContext<Mat, Vec, KSP>::ApplyAngularMG(Vec phi_input,
+                                                    Vec pc_output)
+{
+  auto& phi_new_local = lbs_solver_.PhiNewLocal();
+  lbs_solver_.SetPrimarySTLvectorFromGSPETScVec(
+    groupset_, phi_input, PhiSTLOption::PHI_NEW);
+
+  const std::vector<double> r = phi_new_local;
+  std::vector<double> x = phi_new_local;
+
+  auto& q_moments_local = lbs_solver_.QMomentsLocal();
+  auto& sweep_scheduler = *angular_mg_sweep_scheduler_;
+  sweep_scheduler.SetBoundarySourceActiveFlag(false);
+
+  for (int k = 0; k < groupset_.angular_mg_max_iters_; ++k)
+  {
+    lbs_solver_.ZeroGroupSpan(groupset_.groups_.front().id_,
+                              groupset_.groups_.back().id_, q_moments_local);
+    set_source_function_(groupset_, q_moments_local, x, lhs_src_scope_);
+
+    sweep_scheduler.ZeroIncomingDelayedPsi();
+    sweep_scheduler.ZeroOutputFluxDataStructures();
+    sweep_scheduler.Sweep();
+    lbs_ss_solver_.CompleteDeferredSources(groupset_);
+
+    for (size_t i = 0; i < x.size(); ++i)
+      x[i] = r[i] + angular_mg_phi_[i];
+  }
+
+  if (groupset_.angular_mg_verbose_)
+  {
+    double local_norms[2] = {0.0, 0.0};
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+      local_norms[0] += r[i] * r[i];
+      local_norms[1] += (x[i] - r[i]) * (x[i] - r[i]);
+    }
+    double norms[2] = {0.0, 0.0};
+    MPI_Allreduce(local_norms, norms, 2, MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+
+    Chi::log.Log() << "Groupset " << groupset_.id_ << " angular multigrid "
+                   << "correction norm "
+                   << std::sqrt(norms[1]) / std::max(std::sqrt(norms[0]),
+                                                     1.0e-300);
+  }
+
+  phi_new_local = std::move(x);
+  lbs_solver_.SetGSPETScVecFromPrimarySTLvector(
+    groupset_, pc_output, PhiSTLOption::PHI_NEW);
+}
+
+namespace
+{
+/**Applies angular multigrid followed, when enabled, by WGDSA or TGDSA.*/
+int AngularMG_PreConditionerMult(PC pc, Vec phi_input, Vec pc_output)
+{
+  void* context;
+  PCShellGetContext(pc, &context);
+
+  auto gs_context_ptr = (SweepWGSContext<Mat, Vec, KSP>*)(context);
+
+  gs_context_ptr->ApplyAngularMG(phi_input, pc_output);
+
+  const auto& groupset = gs_context_ptr->groupset_;
+  if (groupset.apply_wgdsa_ or groupset.apply_tgdsa_)
+    WGDSA_TGDSA_PreConditionerMult2(*gs_context_ptr, pc_output, pc_output);
+
+  return 0;
+}
+} // namespace
+
 /**Sets the preconditioner application function.*/
 template <>
 void SweepWGSContext<Mat, Vec, KSP>::SetPreconditioner(KSP& solver)
@@ -56,7 +155,13 @@ void SweepWGSContext<Mat, Vec, KSP>::SetPreconditioner(KSP& solver)
   PC pc;
   KSPGetPC(ksp, &pc);
 
-  if (groupset_.apply_wgdsa_ or groupset_.apply_tgdsa_)
+  if (angular_mg_sweep_scheduler_)
+  {
+    PCSetType(pc, PCSHELL);
+    PCShellSetApply(pc, (PCShellPtr)AngularMG_PreConditionerMult);
+    PCShellSetContext(pc, &(*this));
+  }
+  else if (groupset_.apply_wgdsa_ or groupset_.apply_tgdsa_)
   {
     PCSetType(pc, PCSHELL);
     PCShellSetApply(pc, (PCShellPtr)WGDSA_TGDSA_PreConditionerMult);
@@ -116,9 +221,12 @@ void SweepWGSContext<Mat, Vec, KSP>::ApplyInverseTransportOperator(int scope)
   if (scope & ZERO_INCOMING_DELAYED_PSI)
     sweep_scheduler_.ZeroIncomingDelayedPsi();
 
-  // Sweep
+  // Sweep, tallying the outflow of this sweep only
+  lbs_ss_solver_.ZeroOutflowBalanceVars(groupset_);
+  lbs_ss_solver_.UpdateCellFactorCache(groupset_);
   sweep_scheduler_.ZeroOutputFluxDataStructures();
   sweep_scheduler_.Sweep();
+  lbs_ss_solver_.CompleteDeferredSources(groupset_);
 }
 
 /**This method implements an additional sweep for two reasons:
@@ -134,8 +242,6 @@ void SweepWGSContext<Mat, Vec, KSP>::PostSolveCallback()
   //                                                   delayed psi dofs
   if (groupset_.iterative_method_ != IterativeMethod::KRYLOV_RICHARDSON)
   {
-    lbs_ss_solver_.ZeroOutflowBalanceVars(groupset_);
-
     const int scope = lhs_src_scope_ | rhs_src_scope_;
 
     set_source_function_(
@@ -153,13 +259,27 @@ void SweepWGSContext<Mat, Vec, KSP>::PostSolveCallback()
     double sweep_time = sweep_scheduler_.GetAverageSweepTime();
     double chunk_overhead_ratio =
       1.0 - sweep_scheduler_.GetAngleSetTimings()[2];
-    double source_time =
-      Chi::log.ProcessEvent(lbs_solver_.GetSourceEventTag(),
-                            chi::ChiLog::EventOperation::AVERAGE_DURATION);
+    double source_time = lbs_solver_.GetSourceTiming().Average();
     size_t num_angles = groupset_.quadrature_->abscissae_.size();
     size_t num_unknowns =
       lbs_solver_.GlobalNodeCount() * num_angles * groupset_.groups_.size();
 
+    const auto idle_timings = sweep_scheduler_.GetIdleTimings();
+    const double local_idle_ratio = idle_timings[2];
+    const double local_filled_ratio =
+      idle_timings[0] > 0.0 ? idle_timings[1] / idle_timings[0] : 0.0;
+    double max_idle_ratio = 0.0;
+    double avg_idle_ratio = 0.0;
+    double avg_filled_ratio = 0.0;
+    MPI_Allreduce(&local_idle_ratio, &max_idle_ratio, 1,
+                  MPI_DOUBLE, MPI_MAX, Chi::mpi.comm);
+    MPI_Allreduce(&local_idle_ratio, &avg_idle_ratio, 1,
+                  MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+    MPI_Allreduce(&local_filled_ratio, &avg_filled_ratio, 1,
+                  MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+    avg_idle_ratio /= Chi::mpi.process_count;
+    avg_filled_ratio /= Chi::mpi.process_count;
+
     if (log_info_)
     {
       Chi::log.Log() << "\n\n";
@@ -168,6 +288,10 @@ void SweepWGSContext<Mat, Vec, KSP>::PostSolveCallback()
       Chi::log.Log() << "        Average sweep time (s):        " << sweep_time;
       Chi::log.Log() << "        Chunk-Overhead-Ratio  :        "
                      << chunk_overhead_ratio;
+      Chi::log.Log() << "        Idle-Ratio (avg/max)  :        "
+                     << avg_idle_ratio << " / " << max_idle_ratio;
+      Chi::log.Log() << "        Idle-Filled-Ratio (avg):       "
+                     << avg_filled_ratio;
       Chi::log.Log() << "        Sweep Time/Unknown (ns):       "
                      << sweep_time * 1.0e9 * Chi::mpi.process_count /
                           static_cast<double>(num_unknowns);
@@ -179,10 +303,19 @@ void SweepWGSContext<Mat, Vec, KSP>::PostSolveCallback()
         std::string("GS_") + std::to_string(groupset_.id_) +
         std::string("_SweepLog_") + std::to_string(Chi::mpi.location_id) +
         std::string(".log");
-      groupset_.PrintSweepInfoFile(sweep_scheduler_.SweepEventTag(),
+      groupset_.PrintSweepInfoFile(sweep_scheduler_.GetSweepTiming(),
                                    sweep_log_file_name);
     }
   }
+
+  //==================================================== Sweep statistics
+  if (sweep_scheduler_.SweepStatisticsEnabled())
+  {
+    const auto& statistics = sweep_scheduler_.GetSweepStatistics();
+    statistics.LogReport("Groupset " + std::to_string(groupset_.id_));
+    if (not groupset_.sweep_statistics_file_.empty())
+      statistics.ExportJSON(groupset_.sweep_statistics_file_);
+  }
 }
 
 } // namespace lbs
\ No newline at end of file
@@ -19,6 +19,16 @@ struct SweepWGSContext : public WGSContext<MatType, VecType, SolverType>
 
   DiscreteOrdinatesSolver& lbs_ss_solver_;
 
+  /**Angular multigrid coarse level sweeps, when enabled on the groupset.
+   * The coarse angular fluxes are not stored, hence the destination psi
+   * stays empty.*/
+  std::shared_ptr<chi_mesh::sweep_management::SweepChunk>
+    angular_mg_sweep_chunk_;
+  std::unique_ptr<chi_mesh::sweep_management::SweepScheduler>
+    angular_mg_sweep_scheduler_;
+  std::vector<double> angular_mg_phi_;
+  std::vector<double> angular_mg_psi_;
+
   SweepWGSContext(
     DiscreteOrdinatesSolver& lbs_solver,
     LBSGroupset& groupset,
@@ -34,16 +44,20 @@ struct SweepWGSContext : public WGSContext<MatType, VecType, SolverType>
                                                rhs_scope,
                                                log_info),
       sweep_chunk_(std::move(sweep_chunk)),
-      sweep_scheduler_(
-        lbs_solver.SweepType() == "AAH"
-          ? chi_mesh::sweep_management::SchedulingAlgorithm::DEPTH_OF_GRAPH
-          : chi_mesh::sweep_management::SchedulingAlgorithm::FIRST_IN_FIRST_OUT,
-        *groupset.angle_agg_,
-        *sweep_chunk_),
+      sweep_scheduler_(lbs_solver.SweepSchedulingAlgorithm(),
+                       *groupset.angle_agg_,
+                       *sweep_chunk_),
       lbs_ss_solver_(lbs_solver)
   {
+    if (groupset.sweep_statistics_)
+      sweep_scheduler_.EnableSweepStatistics(true);
   }
 
+  void SetAngularMGSweepChunk(
+    std::shared_ptr<chi_mesh::sweep_management::SweepChunk> sweep_chunk);
+
+  void ApplyAngularMG(VecType phi_input, VecType pc_output);
+
   void PreSetupCallback() override;
 
   void SetPreconditioner(SolverType& solver) override;
@@ -0,0 +1,416 @@
+#include "AAH_BatchedSweepChunk.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/SweepUtilities/FLUDS/AAH_FLUDS.h"
+#include "math/chi_math.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+AAH_BatchedSweepChunk::AAH_BatchedSweepChunk(
+  const chi_mesh::MeshContinuum& grid,
+  const chi_math::SpatialDiscretization& discretization,
+  const PackedUnitCellMatrices& unit_cell_matrices,
+  std::vector<lbs::CellLBSView>& cell_transport_views,
+  std::vector<double>& destination_phi,
+  std::vector<double>& destination_psi,
+  const std::vector<double>& source_moments,
+  const LBSGroupset& groupset,
+  const std::map<int, XSPtr>& xs,
+  int num_moments,
+  int max_num_cell_dofs)
+  : SweepChunk(destination_phi,
+               destination_psi,
+               grid,
+               discretization,
+               unit_cell_matrices,
+               cell_transport_views,
+               source_moments,
+               groupset,
+               xs,
+               num_moments,
+               max_num_cell_dofs,
+               std::make_unique<AAH_SweepDependencyInterface>()),
+    max_num_cell_dofs_(max_num_cell_dofs)
+{
+}
+
+// ##################################################################
+/**Grows the direction-innermost work arrays to accommodate the given
+ * number of directions.*/
+void AAH_BatchedSweepChunk::AllocateBatchStorage(size_t num_angles)
+{
+  if (num_angles <= batch_capacity_) return;
+
+  const size_t max_dofs = max_num_cell_dofs_;
+  const size_t num_groups = groupset_.groups_.size();
+
+  omega_x_.assign(num_angles, 0.0);
+  omega_y_.assign(num_angles, 0.0);
+  omega_z_.assign(num_angles, 0.0);
+  weights_.assign(num_angles, 0.0);
+  face_mu_.assign(num_angles, 0.0);
+  amat_batch_.assign(max_dofs * max_dofs * num_angles, 0.0);
+  atemp_batch_.assign(max_dofs * max_dofs * num_angles, 0.0);
+  source_batch_.assign(max_dofs * num_angles, 0.0);
+  rhs_batch_.assign(num_groups * max_dofs * num_angles, 0.0);
+  lane_scratch_.assign(num_angles, 0.0);
+  upwind_psi_.assign(num_angles, nullptr);
+
+  batch_capacity_ = num_angles;
+}
+
+// ##################################################################
+/**Sweeps all the directions of the angle set cell-by-cell.*/
+void AAH_BatchedSweepChunk::Sweep(
+  chi_mesh::sweep_management::AngleSet& angle_set)
+{
+  BeginAngleSet(angle_set);
+
+  int deploc_face_counter = -1;
+  int preloc_face_counter = -1;
+
+  // ====================================================== Loop over each
+  //                                                        cell
+  const size_t num_spls = angle_set.GetSPDS().GetSPLS().item_id.size();
+  for (size_t spls_index = 0; spls_index < num_spls; ++spls_index)
+    SweepCell(angle_set, spls_index, deploc_face_counter, preloc_face_counter);
+}
+
+// ##################################################################
+/**Sets the group subset, the dependency interface and the direction data
+ * for sweeping the cells of the given angle set.*/
+void AAH_BatchedSweepChunk::BeginAngleSet(
+  chi_mesh::sweep_management::AngleSet& angle_set)
+{
+  using namespace chi_mesh::sweep_management;
+
+  const SubSetInfo& grp_ss_info =
+    groupset_.grp_subset_infos_[angle_set.GetRefGroupSubset()];
+
+  gs_ss_size_ = grp_ss_info.ss_size;
+  gs_ss_begin_ = grp_ss_info.ss_begin;
+  gs_gi_ = groupset_.groups_[gs_ss_begin_].id_;
+
+  sweep_dependency_interface_.angle_set_ = &angle_set;
+  sweep_dependency_interface_.surface_source_active_ = IsSurfaceSourceActive();
+  sweep_dependency_interface_.gs_ss_begin_ = gs_ss_begin_;
+  sweep_dependency_interface_.gs_gi_ = gs_gi_;
+
+  auto& aah_sweep_depinterf =
+    dynamic_cast<AAH_SweepDependencyInterface&>(sweep_dependency_interface_);
+
+  // ====================================================== Direction data
+  const auto& quadrature = *groupset_.quadrature_;
+  const std::vector<size_t>& as_angle_indices = angle_set.GetAngleIndices();
+  const size_t num_angles = as_angle_indices.size();
+  aah_sweep_depinterf.SetFLUDS(
+    dynamic_cast<AAH_FLUDS&>(angle_set.GetFLUDS()), num_angles, gs_ss_size_);
+  AllocateBatchStorage(num_angles);
+
+  for (size_t a = 0; a < num_angles; ++a)
+  {
+    const size_t direction_num = as_angle_indices[a];
+    const auto& omega = quadrature.omegas_[direction_num];
+    omega_x_[a] = omega.x;
+    omega_y_[a] = omega.y;
+    omega_z_[a] = omega.z;
+    weights_[a] = quadrature.weights_[direction_num];
+  }
+}
+
+// ##################################################################
+/**Sweeps the cell at the given sweep ordering index, for all the
+ * directions of the angle set.*/
+void AAH_BatchedSweepChunk::SweepCell(
+  chi_mesh::sweep_management::AngleSet& angle_set,
+  size_t spls_index,
+  int& deploc_face_counter,
+  int& preloc_face_counter)
+{
+  using namespace chi_mesh::sweep_management;
+
+  auto& aah_sweep_depinterf =
+    dynamic_cast<AAH_SweepDependencyInterface&>(sweep_dependency_interface_);
+
+  const auto& quadrature = *groupset_.quadrature_;
+
+  const std::vector<size_t>& as_angle_indices = angle_set.GetAngleIndices();
+  const size_t num_angles = as_angle_indices.size();
+
+  const double* omega_x = omega_x_.data();
+  const double* omega_y = omega_y_.data();
+  const double* omega_z = omega_z_.data();
+  double* face_mu = face_mu_.data();
+  double* lane_scratch = lane_scratch_.data();
+
+  auto& output_phi = GetDestinationPhi();
+
+  cell_local_id_ = angle_set.GetSPDS().GetSPLS().item_id[spls_index];
+  cell_ = &grid_.local_cells[cell_local_id_];
+  sweep_dependency_interface_.cell_ptr_ = cell_;
+  sweep_dependency_interface_.cell_local_id_ = cell_local_id_;
+  cell_mapping_ = &grid_fe_view_.GetCellMapping(*cell_);
+  cell_transport_view_ = &grid_transport_view_[cell_->local_id_];
+  EvaluateCellSource();
+
+  SetCellFaceData(angle_set);
+  const auto* face_orientations = cell_face_orientations_;
+
+  cell_num_faces_ = cell_->faces_.size();
+  cell_num_nodes_ = cell_mapping_->NumNodes();
+  const auto& sigma_t = cell_transport_view_->XS().SigmaTotal();
+
+  aah_sweep_depinterf.spls_index = spls_index;
+
+  const size_t n = cell_num_nodes_;
+  const size_t nA = n * num_angles;
+
+  // =============================================== Get Cell matrices
+  const auto fe_intgrl_values = unit_cell_matrices_[cell_local_id_];
+  const auto& G = fe_intgrl_values.G_matrix;
+  const auto& M = fe_intgrl_values.M_matrix;
+  const auto& M_surf = fe_intgrl_values.face_M_matrices;
+  const auto& IntS_shapeI = fe_intgrl_values.face_Si_vectors;
+
+  // =============================================== Volumetric gradient
+  //                                                 term, all directions
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+    {
+      const auto& Gij = G[i][j];
+      double* A_ij = &amat_batch_[(i * n + j) * num_angles];
+#pragma omp simd
+      for (size_t a = 0; a < num_angles; ++a)
+        A_ij[a] = omega_x[a] * Gij.x + omega_y[a] * Gij.y + omega_z[a] * Gij.z;
+    }
+
+  std::fill(
+    rhs_batch_.begin(), rhs_batch_.begin() + gs_ss_size_ * nA, 0.0);
+
+  // =============================================== Upwinding structure
+  aah_sweep_depinterf.in_face_counter = 0;
+  aah_sweep_depinterf.preloc_face_counter = 0;
+  aah_sweep_depinterf.out_face_counter = 0;
+  aah_sweep_depinterf.deploc_face_counter = 0;
+
+  // =============================================== Surface integrals
+  int in_face_counter = -1;
+  for (int f = 0; f < cell_num_faces_; ++f)
+  {
+    const auto& face = cell_->faces_[f];
+
+    if (face_orientations[f] != FaceOrientation::INCOMING) continue;
+
+    const bool local = cell_transport_view_->IsFaceLocal(f);
+    const bool boundary = not face.has_neighbor_;
+
+    if (local) ++in_face_counter;
+    else if (not boundary)
+      ++preloc_face_counter;
+
+    const size_t num_face_nodes = cell_mapping_->NumFaceNodes(f);
+    sweep_dependency_interface_.SetupIncomingFace(
+      f, num_face_nodes, face.neighbor_id_, local, boundary);
+
+    aah_sweep_depinterf.in_face_counter = in_face_counter;
+    aah_sweep_depinterf.preloc_face_counter = preloc_face_counter;
+
+    const auto& normal = face.normal_;
+    if (cached_face_mu_ != nullptr)
+      std::copy_n(&cached_face_mu_[f * num_angles], num_angles, face_mu);
+    else
+    {
+#pragma omp simd
+      for (size_t a = 0; a < num_angles; ++a)
+        face_mu[a] = omega_x[a] * normal.x + omega_y[a] * normal.y +
+                     omega_z[a] * normal.z;
+    }
+
+    const auto M_surf_f = M_surf[f];
+    for (int fi = 0; fi < num_face_nodes; ++fi)
+    {
+      const int i = cell_mapping_->MapFaceNode(f, fi);
+      for (int fj = 0; fj < num_face_nodes; ++fj)
+      {
+        const int j = cell_mapping_->MapFaceNode(f, fj);
+
+        for (size_t a = 0; a < num_angles; ++a)
+        {
+          sweep_dependency_interface_.angle_set_index_ = a;
+          sweep_dependency_interface_.angle_num_ = as_angle_indices[a];
+          upwind_psi_[a] = sweep_dependency_interface_.GetUpwindPsi(fj);
+        }
+
+        const double Mij = M_surf_f[i][j];
+        double* A_ij = &amat_batch_[(i * n + j) * num_angles];
+#pragma omp simd
+        for (size_t a = 0; a < num_angles; ++a)
+          A_ij[a] += -face_mu[a] * Mij;
+
+        for (size_t a = 0; a < num_angles; ++a)
+        {
+          const double* psi = upwind_psi_[a];
+          if (psi == nullptr) continue;
+
+          const double mu_Nij = -face_mu[a] * Mij;
+          for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+            rhs_batch_[gsg * nA + i * num_angles + a] += psi[gsg] * mu_Nij;
+        }
+      } // for face node j
+    }   // for face node i
+  }     // for f
+
+  // =============================================== Looping over groups,
+  //                                                 mass terms and solve
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const size_t g = gs_gi_ + gsg;
+    const double sigma_tg = sigma_t[g];
+    double* rhs_g = &rhs_batch_[gsg * nA];
+
+    // q = M_n^T * q_moms
+    for (size_t i = 0; i < n; ++i)
+    {
+      double* src_i = &source_batch_[i * num_angles];
+      for (size_t a = 0; a < num_angles; ++a)
+      {
+        const double* m2d_a =
+          quadrature.GetMomentToDiscreteDirection(as_angle_indices[a]);
+        double temp_src = 0.0;
+        for (int m = 0; m < num_moments_; ++m)
+          temp_src +=
+            m2d_a[m] * q_moments_[cell_transport_view_->MapDOF(i, m, g)];
+        src_i[a] = temp_src;
+      }
+    }
+
+    // Atemp  = Amat + sigma_tgr * M
+    // b     += M * q
+    for (size_t i = 0; i < n; ++i)
+    {
+      std::fill(lane_scratch, lane_scratch + num_angles, 0.0);
+      for (size_t j = 0; j < n; ++j)
+      {
+        const double Mij = M[i][j];
+        const double* A_ij = &amat_batch_[(i * n + j) * num_angles];
+        double* T_ij = &atemp_batch_[(i * n + j) * num_angles];
+        const double* src_j = &source_batch_[j * num_angles];
+#pragma omp simd
+        for (size_t a = 0; a < num_angles; ++a)
+        {
+          T_ij[a] = A_ij[a] + Mij * sigma_tg;
+          lane_scratch[a] += Mij * src_j[a];
+        }
+      }
+      double* b_i = &rhs_g[i * num_angles];
+#pragma omp simd
+      for (size_t a = 0; a < num_angles; ++a)
+        b_i[a] += lane_scratch[a];
+    }
+
+    chi_math::GaussEliminationBatched(atemp_batch_.data(),
+                                      rhs_g,
+                                      lane_scratch,
+                                      static_cast<int>(n),
+                                      static_cast<int>(num_angles));
+  } // for gsg
+
+  // =============================================== Flux updates
+  double* cell_psi_data = nullptr;
+  if (save_angular_flux_)
+    cell_psi_data = &GetDestinationPsi()[grid_fe_view_.MapDOFLocal(
+      *cell_, 0, groupset_.psi_uk_man_, 0, 0)];
+
+  const int ni_deploc_face_counter = deploc_face_counter;
+  for (size_t a = 0; a < num_angles; ++a)
+  {
+    direction_num_ = as_angle_indices[a];
+    direction_qweight_ = weights_[a];
+    const auto& omega = quadrature.omegas_[direction_num_];
+
+    sweep_dependency_interface_.angle_set_index_ = a;
+    sweep_dependency_interface_.angle_num_ = direction_num_;
+
+    const double* d2m_op =
+      quadrature.GetDiscreteToMomentDirection(direction_num_);
+    for (int m = 0; m < num_moments_; ++m)
+    {
+      const double wn_d2m = d2m_op[m];
+      for (size_t i = 0; i < n; ++i)
+      {
+        const size_t ir = cell_transport_view_->MapDOF(i, m, gs_gi_);
+        for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+          output_phi[ir + gsg] +=
+            wn_d2m * rhs_batch_[gsg * nA + i * num_angles + a];
+      }
+    }
+
+    if (cell_psi_data != nullptr)
+      for (size_t i = 0; i < n; ++i)
+      {
+        const size_t imap = i * groupset_angle_group_stride_ +
+                            direction_num_ * groupset_group_stride_ +
+                            gs_ss_begin_;
+        for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+          cell_psi_data[imap + gsg] =
+            rhs_batch_[gsg * nA + i * num_angles + a];
+      }
+
+    // ======================================== Perform outgoing
+    //                                          surface operations
+    deploc_face_counter = ni_deploc_face_counter;
+    int out_face_counter = -1;
+    for (int f = 0; f < cell_num_faces_; ++f)
+    {
+      if (face_orientations[f] != FaceOrientation::OUTGOING) continue;
+
+      out_face_counter++;
+      const auto& face = cell_->faces_[f];
+      const bool local = cell_transport_view_->IsFaceLocal(f);
+      const bool boundary = not face.has_neighbor_;
+      const int locality = cell_transport_view_->FaceLocality(f);
+
+      if (not boundary and not local) ++deploc_face_counter;
+
+      const size_t num_face_nodes = cell_mapping_->NumFaceNodes(f);
+      sweep_dependency_interface_.SetupOutgoingFace(
+        f, num_face_nodes, face.neighbor_id_, local, boundary, locality);
+
+      aah_sweep_depinterf.out_face_counter = out_face_counter;
+      aah_sweep_depinterf.deploc_face_counter = deploc_face_counter;
+
+      const bool is_reflecting_boundary =
+        sweep_dependency_interface_.is_reflecting_bndry_;
+      const double* IntF_shapeI = IntS_shapeI[f];
+      const double mu = (cached_face_mu_ != nullptr)
+                          ? cached_face_mu_[f * num_angles + a]
+                          : omega.Dot(face.normal_);
+      const double wt = direction_qweight_;
+
+      for (int fi = 0; fi < num_face_nodes; ++fi)
+      {
+        const int i = cell_mapping_->MapFaceNode(f, fi);
+        const double* b_i = &rhs_batch_[i * num_angles + a];
+
+        double* psi = sweep_dependency_interface_.GetDownwindPsi(fi);
+
+        if (psi != nullptr)
+          if (not boundary or is_reflecting_boundary)
+          {
+            for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+              psi[gsg] = b_i[gsg * nA];
+            sweep_dependency_interface_.CommitDownwindPsi(fi);
+          }
+        if (boundary)
+          for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+            cell_transport_view_->AddOutflow(
+              f, gs_gi_ + gsg, wt * mu * b_i[gsg * nA] * IntF_shapeI[i]);
+      } // for fi
+    }   // for face
+  }     // for angle
+}
+
+} // namespace lbs
@@ -0,0 +1,63 @@
+#ifndef CHITECH_AAH_BATCHEDSWEEPCHUNK_H
+#define CHITECH_AAH_BATCHEDSWEEPCHUNK_H
+
+#include "AAH_SweepChunk.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**AAH sweep chunk that solves all the directions of an angle set for a
+ * given cell in a single pass. The cell matrices are loaded once per cell
+ * and the per-direction systems are assembled and eliminated together in
+ * contiguous storage with the direction index innermost, allowing the
+ * compiler to vectorize across directions.*/
+class AAH_BatchedSweepChunk : public SweepChunk
+{
+public:
+  AAH_BatchedSweepChunk(
+    const chi_mesh::MeshContinuum& grid,
+    const chi_math::SpatialDiscretization& discretization,
+    const PackedUnitCellMatrices& unit_cell_matrices,
+    std::vector<lbs::CellLBSView>& cell_transport_views,
+    std::vector<double>& destination_phi,
+    std::vector<double>& destination_psi,
+    const std::vector<double>& source_moments,
+    const LBSGroupset& groupset,
+    const std::map<int, XSPtr>& xs,
+    int num_moments,
+    int max_num_cell_dofs);
+
+  void Sweep(chi_mesh::sweep_management::AngleSet& angle_set) override;
+
+protected:
+  void AllocateBatchStorage(size_t num_angles);
+  /**Prepares the chunk for sweeping the cells of the angle set.*/
+  void BeginAngleSet(chi_mesh::sweep_management::AngleSet& angle_set);
+  /**Sweeps the cell at the given sweep ordering index, for all the
+   * directions of the angle set.*/
+  void SweepCell(chi_mesh::sweep_management::AngleSet& angle_set,
+                 size_t spls_index,
+                 int& deploc_face_counter,
+                 int& preloc_face_counter);
+
+  const int max_num_cell_dofs_;
+  size_t batch_capacity_ = 0;
+
+  // Direction-innermost storage
+  std::vector<double> omega_x_;
+  std::vector<double> omega_y_;
+  std::vector<double> omega_z_;
+  std::vector<double> weights_;
+  std::vector<double> face_mu_;
+  std::vector<double> amat_batch_;
+  std::vector<double> atemp_batch_;
+  std::vector<double> source_batch_;
+  std::vector<double> rhs_batch_;
+  std::vector<double> lane_scratch_;
+  std::vector<const double*> upwind_psi_;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_AAH_BATCHEDSWEEPCHUNK_H
@@ -0,0 +1,223 @@
+#include "AAH_DDSweepChunk.h"
+
+#include "math/SpatialDiscretization/CellMappings/cell_mapping_base.h"
+
+#include <cmath>
+
+namespace lbs
+{
+
+AAH_DDSweepChunk::AAH_DDSweepChunk(
+  const chi_mesh::MeshContinuum& grid,
+  const chi_math::SpatialDiscretization& discretization,
+  const PackedUnitCellMatrices& unit_cell_matrices,
+  std::vector<lbs::CellLBSView>& cell_transport_views,
+  std::vector<double>& destination_phi,
+  std::vector<double>& destination_psi,
+  const std::vector<double>& source_moments,
+  const LBSGroupset& groupset,
+  const std::map<int, XSPtr>& xs,
+  int num_moments,
+  int max_num_cell_dofs)
+  : AAH_SweepChunk(grid,
+                   discretization,
+                   unit_cell_matrices,
+                   cell_transport_views,
+                   destination_phi,
+                   destination_psi,
+                   source_moments,
+                   groupset,
+                   xs,
+                   num_moments,
+                   max_num_cell_dofs)
+{
+  upwind_sources_.resize(groupset.groups_.size(), 0.0);
+
+  // ================================== Register kernels
+  RegisterKernel("DDCellData",
+                 std::bind(&AAH_DDSweepChunk::KernelDDCellData, this));
+  RegisterKernel("DDDirectionData",
+                 std::bind(&AAH_DDSweepChunk::KernelDDDirectionData, this));
+  RegisterKernel(
+    "DDUpwindSurfaceTerms",
+    std::bind(&AAH_DDSweepChunk::KernelDDUpwindSurfaceTerms, this));
+
+  // ================================== Setup callbacks
+  cell_data_callbacks_ = {Kernel("DDCellData")};
+
+  direction_data_callbacks_and_kernels_ = {Kernel("DDDirectionData")};
+
+  surface_integral_kernels_ = {Kernel("DDUpwindSurfaceTerms")};
+
+  // Phase 4 is AssembleAndSolveGroups, the fixed-size kernels and the
+  // factor cache do not apply
+  mass_term_kernels_ = {};
+  use_fixed_size_kernels_ = false;
+
+  flux_update_kernels_ = {Kernel("KernelPhiUpdate"), Kernel("KernelPsiUpdate")};
+
+  post_cell_dir_sweep_callbacks_ = {};
+}
+
+// ##################################################################
+/**Computes the face coefficients, the opposite faces and the node
+ * weights of the current cell.*/
+void AAH_DDSweepChunk::KernelDDCellData()
+{
+  //=========================================== Node weights
+  const double* IntV_shapeI = unit_cell_matrices_[cell_local_id_].Vi_vectors;
+  double volume = 0.0;
+  for (size_t i = 0; i < cell_num_nodes_; ++i)
+    volume += IntV_shapeI[i];
+
+  node_weights_.resize(cell_num_nodes_);
+  for (size_t i = 0; i < cell_num_nodes_; ++i)
+    node_weights_[i] = IntV_shapeI[i] / volume;
+
+  //=========================================== Face coefficients
+  face_areas_.assign(cell_num_faces_, 0.0);
+  face_coefficients_.resize(cell_num_faces_);
+  for (size_t f = 0; f < cell_num_faces_; ++f)
+  {
+    const double* IntF_shapeI = IntS_shapeI_[f];
+    for (size_t i = 0; i < cell_num_nodes_; ++i)
+      face_areas_[f] += IntF_shapeI[i];
+    face_coefficients_[f] = 2.0 * face_areas_[f] / volume;
+  }
+
+  //=========================================== Opposite faces
+  const auto& faces = cell_->faces_;
+  opposite_faces_.assign(cell_num_faces_, -1);
+  for (size_t f = 0; f < cell_num_faces_; ++f)
+    for (size_t fp = 0; fp < cell_num_faces_; ++fp)
+      if (faces[f].normal_.Dot(faces[fp].normal_) < -0.999)
+      {
+        opposite_faces_[f] = static_cast<int>(fp);
+        break;
+      }
+}
+
+// ##################################################################
+/**Resets the upwind terms of the current direction.*/
+void AAH_DDSweepChunk::KernelDDDirectionData()
+{
+  leakage_coefficient_ = 0.0;
+  upwind_sources_.assign(gs_ss_size_, 0.0);
+  face_psi_in_.assign(cell_num_faces_ * gs_ss_size_, 0.0);
+}
+
+// ##################################################################
+/**Adds the face-average incoming flux of the current face to the upwind
+ * terms.*/
+void AAH_DDSweepChunk::KernelDDUpwindSurfaceTerms()
+{
+  const size_t f = sweep_dependency_interface_.current_face_idx_;
+  const double coefficient = std::fabs(face_mu_values_[f]) *
+                             face_coefficients_[f];
+  const size_t num_face_nodes = sweep_dependency_interface_.num_face_nodes_;
+
+  double* psi_in = &face_psi_in_[f * gs_ss_size_];
+  for (int fj = 0; fj < num_face_nodes; ++fj)
+  {
+    const double* psi = sweep_dependency_interface_.GetUpwindPsi(fj);
+    if (psi == nullptr) continue;
+
+    for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+      psi_in[gsg] += psi[gsg];
+  }
+
+  const double inv_num_face_nodes = 1.0 / static_cast<double>(num_face_nodes);
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    psi_in[gsg] *= inv_num_face_nodes;
+    upwind_sources_[gsg] += coefficient * psi_in[gsg];
+  }
+  leakage_coefficient_ += coefficient;
+}
+
+// ##################################################################
+/**Solves the cell-average angular flux of each group of the current group
+ * subset and assigns it to every node of the cell.*/
+void AAH_DDSweepChunk::AssembleAndSolveGroups(
+  const std::vector<double>& sigma_t)
+{
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
+
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const int g = gs_gi_ + gsg;
+
+    // ============================= Cell-average source
+    double q_avg = 0.0;
+    for (int i = 0; i < cell_num_nodes_; ++i)
+    {
+      double temp_src = 0.0;
+      for (int m = 0; m < num_moments_; ++m)
+      {
+        const size_t ir = cell_transport_view_->MapDOF(i, m, g);
+        temp_src += m2d_op[m] * q_moments_[ir];
+      } // for m
+      q_avg += node_weights_[i] * temp_src;
+    } // for i
+
+    // ============================= Solve
+    const double psi_c = (q_avg + upwind_sources_[gsg]) /
+                         (sigma_t[g] + leakage_coefficient_);
+
+    b_[gsg].assign(cell_num_nodes_, psi_c);
+  } // for gsg
+}
+
+// ##################################################################
+/**Same as SweepChunk::OutgoingSurfaceOperations with the outgoing face
+ * fluxes given by the diamond relation with the opposite face. If the
+ * opposite face is not incoming, the outgoing flux is the cell-average
+ * flux.*/
+void AAH_DDSweepChunk::OutgoingSurfaceOperations()
+{
+  using chi_mesh::sweep_management::FaceOrientation;
+
+  const size_t f = sweep_dependency_interface_.current_face_idx_;
+  const double mu = face_mu_values_[f];
+  const double wt = direction_qweight_;
+  const double face_area = face_areas_[f];
+
+  const bool on_boundary = sweep_dependency_interface_.on_boundary_;
+  const bool is_reflecting_boundary =
+    sweep_dependency_interface_.is_reflecting_bndry_;
+
+  const int fp = opposite_faces_[f];
+  const bool diamond =
+    fp >= 0 and cell_face_orientations_[fp] == FaceOrientation::INCOMING;
+
+  // ============================= Outgoing face fluxes
+  // Stored in the face psi of face f, which is not incoming
+  double* psi_out = &face_psi_in_[f * gs_ss_size_];
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const double psi_c = b_[gsg][0];
+    psi_out[gsg] =
+      diamond ? 2.0 * psi_c - face_psi_in_[fp * gs_ss_size_ + gsg] : psi_c;
+  }
+
+  const size_t num_face_nodes = cell_mapping_->NumFaceNodes(f);
+  if (not on_boundary or is_reflecting_boundary)
+    for (int fi = 0; fi < num_face_nodes; ++fi)
+    {
+      double* psi = sweep_dependency_interface_.GetDownwindPsi(fi);
+      if (psi != nullptr)
+      {
+        for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+          psi[gsg] = psi_out[gsg];
+        sweep_dependency_interface_.CommitDownwindPsi(fi);
+      }
+    }
+
+  if (on_boundary)
+    for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+      cell_transport_view_->AddOutflow(
+        static_cast<int>(f), gs_gi_ + gsg, wt * mu * psi_out[gsg] * face_area);
+}
+
+} // namespace lbs
@@ -0,0 +1,71 @@
+#ifndef CHITECH_AAH_DD_SWEEPCHUNK_H
+#define CHITECH_AAH_DD_SWEEPCHUNK_H
+
+#include "AAH_SweepChunk.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**AAH sweep chunk solving the diamond-difference equations on orthogonal
+ * meshes instead of the PWLD cell systems.
+ *
+ * The unknowns remain those of the PWLD discretization: the cell-average
+ * angular flux is solved from the face-average incoming fluxes as
+ * \f[
+ *   \psi_c = \frac{\bar{q} + \sum_{f\, in} c_f \psi_{f}}
+ *                 {\sigma_t + \sum_{f\, in} c_f},
+ *   \quad c_f = 2 |\mu_f| \frac{A_f}{V},
+ * \f]
+ * and is assigned to every node of the cell, whereas the nodes of an
+ * outgoing face get the diamond relation \f$ 2\psi_c - \psi_{f'} \f$, with
+ * \f$ f' \f$ the opposite incoming face. No cell system is assembled or
+ * factored, hence the cost of a cell-direction-group solve is that of a
+ * few multiply-adds. No negative flux fixup is applied.*/
+class AAH_DDSweepChunk : public AAH_SweepChunk
+{
+public:
+  AAH_DDSweepChunk(const chi_mesh::MeshContinuum& grid,
+                   const chi_math::SpatialDiscretization& discretization,
+                   const PackedUnitCellMatrices& unit_cell_matrices,
+                   std::vector<lbs::CellLBSView>& cell_transport_views,
+                   std::vector<double>& destination_phi,
+                   std::vector<double>& destination_psi,
+                   const std::vector<double>& source_moments,
+                   const LBSGroupset& groupset,
+                   const std::map<int, XSPtr>& xs,
+                   int num_moments,
+                   int max_num_cell_dofs);
+
+protected:
+  void AssembleAndSolveGroups(const std::vector<double>& sigma_t) override;
+  void OutgoingSurfaceOperations() override;
+
+  // kernels
+public: // public so that we can use bind
+  void KernelDDCellData();
+  void KernelDDDirectionData();
+  void KernelDDUpwindSurfaceTerms();
+
+private:
+  /**Per face of the current cell, its area, \f$ 2 A_f / V \f$ and the
+   * index of the opposite face, or -1.*/
+  std::vector<double> face_areas_;
+  std::vector<double> face_coefficients_;
+  std::vector<int> opposite_faces_;
+  /**Per node of the current cell, the volume integral of its shape
+   * function divided by the cell volume.*/
+  std::vector<double> node_weights_;
+
+  /**Sum of the incoming face coefficients and, per group of the subset,
+   * of the coefficient weighted incoming fluxes, for the current
+   * direction.*/
+  double leakage_coefficient_ = 0.0;
+  std::vector<double> upwind_sources_;
+  /**Face-average incoming fluxes, indexed as [f * gs_ss_size_ + gsg].*/
+  std::vector<double> face_psi_in_;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_AAH_DD_SWEEPCHUNK_H
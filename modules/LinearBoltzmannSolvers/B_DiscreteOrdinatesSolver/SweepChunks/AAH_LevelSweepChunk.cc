@@ -0,0 +1,182 @@
+#include "AAH_LevelSweepChunk.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+
+#include "chi_log_exceptions.h"
+
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace lbs
+{
+
+namespace
+{
+int CurrentThreadID()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
+template <typename BaseChunk>
+AAH_LevelSweepChunkT<BaseChunk>::AAH_LevelSweepChunkT(
+  const chi_mesh::MeshContinuum& grid,
+  const chi_math::SpatialDiscretization& discretization,
+  const PackedUnitCellMatrices& unit_cell_matrices,
+  std::vector<lbs::CellLBSView>& cell_transport_views,
+  std::vector<double>& destination_phi,
+  std::vector<double>& destination_psi,
+  const std::vector<double>& source_moments,
+  const LBSGroupset& groupset,
+  const std::map<int, XSPtr>& xs,
+  int num_moments,
+  int max_num_cell_dofs)
+  : BaseChunk(grid,
+              discretization,
+              unit_cell_matrices,
+              cell_transport_views,
+              destination_phi,
+              destination_psi,
+              source_moments,
+              groupset,
+              xs,
+              num_moments,
+              max_num_cell_dofs)
+{
+}
+
+// ##################################################################
+/**Sets the worker chunks.*/
+template <typename BaseChunk>
+void AAH_LevelSweepChunkT<BaseChunk>::SetWorkerChunks(
+  const std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>&
+    worker_chunks)
+{
+  worker_chunks_.clear();
+  for (const auto& worker_chunk : worker_chunks)
+  {
+    auto level_chunk =
+      std::dynamic_pointer_cast<AAH_LevelSweepChunkT>(worker_chunk);
+    ChiInvalidArgumentIf(not level_chunk or level_chunk.get() == this,
+                         "The worker chunks must be other level sweep "
+                         "chunks.");
+    worker_chunks_.push_back(level_chunk);
+  }
+}
+
+// ##################################################################
+/**Sweeps the levels in order, the cells of each level being distributed
+ * dynamically over the threads. The threads synchronize at the end of
+ * every level.*/
+template <typename BaseChunk>
+void AAH_LevelSweepChunkT<BaseChunk>::Sweep(
+  chi_mesh::sweep_management::AngleSet& angle_set)
+{
+  const auto& spds = angle_set.GetSPDS();
+  const auto& level_offsets = spds.GetSPLSLevelOffsets();
+  ChiLogicalErrorIf(level_offsets.empty() and
+                      not spds.GetSPLS().item_id.empty(),
+                    "The level sweep chunk requires levelized sweep "
+                    "orderings.");
+  if (level_offsets.empty()) return;
+
+  this->BeginAngleSet(angle_set);
+  ComputeFaceCounters(spds);
+
+  //============================================= Synchronize the workers
+  for (auto& worker_chunk : worker_chunks_)
+  {
+    worker_chunk->SetDestinationPhi(this->GetDestinationPhi());
+    worker_chunk->SetDestinationPsi(this->GetDestinationPsi());
+    worker_chunk->SetBoundarySourceActiveFlag(this->IsSurfaceSourceActive());
+    worker_chunk->BeginAngleSet(angle_set);
+  }
+
+  //============================================= Sweep level by level
+  const int num_threads = static_cast<int>(worker_chunks_.size()) + 1;
+  const size_t num_levels = level_offsets.size() - 1;
+
+  std::exception_ptr exception = nullptr;
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1)
+  {
+    const int thread_id = CurrentThreadID();
+    AAH_LevelSweepChunkT& chunk =
+      (thread_id == 0) ? *this : *worker_chunks_[thread_id - 1];
+
+    for (size_t level = 0; level < num_levels; ++level)
+    {
+      const auto level_begin = static_cast<int64_t>(level_offsets[level]);
+      const auto level_end = static_cast<int64_t>(level_offsets[level + 1]);
+
+#pragma omp for schedule(dynamic, 1)
+      for (int64_t i = level_begin; i < level_end; ++i)
+      {
+        const auto spls_index = static_cast<size_t>(i);
+        auto [deploc_face_counter, preloc_face_counter] =
+          face_counters_[spls_index];
+        try
+        {
+          chunk.SweepCell(angle_set,
+                          spls_index,
+                          deploc_face_counter,
+                          preloc_face_counter);
+        }
+        catch (...)
+        {
+#pragma omp critical
+          if (not exception) exception = std::current_exception();
+        }
+      } // for cell in level
+    }   // for level
+  }
+
+  if (exception) std::rethrow_exception(exception);
+}
+
+// ##################################################################
+/**The counters start at -1 since SweepCell increments them before use.*/
+template <typename BaseChunk>
+void AAH_LevelSweepChunkT<BaseChunk>::ComputeFaceCounters(
+  const chi_mesh::sweep_management::SPDS& spds)
+{
+  using chi_mesh::sweep_management::FaceOrientation;
+
+  const auto& spls = spds.GetSPLS().item_id;
+  const auto& cell_face_orientations = spds.CellFaceOrientations();
+
+  face_counters_.resize(spls.size());
+  int deploc_face_counter = -1;
+  int preloc_face_counter = -1;
+  for (size_t i = 0; i < spls.size(); ++i)
+  {
+    face_counters_[i] = {deploc_face_counter, preloc_face_counter};
+
+    const auto& cell = this->grid_.local_cells[spls[i]];
+    const auto& transport_view = this->grid_transport_view_[cell.local_id_];
+    const auto& face_orientations = cell_face_orientations[cell.local_id_];
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const int fi = static_cast<int>(f);
+      if (not cell.faces_[f].has_neighbor_ or transport_view.IsFaceLocal(fi))
+        continue;
+
+      if (face_orientations[f] == FaceOrientation::INCOMING)
+        ++preloc_face_counter;
+      else if (face_orientations[f] == FaceOrientation::OUTGOING)
+        ++deploc_face_counter;
+    }
+  }
+}
+
+template class AAH_LevelSweepChunkT<AAH_SweepChunk>;
+template class AAH_LevelSweepChunkT<AAH_BatchedSweepChunk>;
+
+} // namespace lbs
@@ -0,0 +1,78 @@
+#ifndef CHITECH_AAH_LEVELSWEEPCHUNK_H
+#define CHITECH_AAH_LEVELSWEEPCHUNK_H
+
+#include "AAH_SweepChunk.h"
+#include "AAH_BatchedSweepChunk.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**Interface of the sweep chunks that thread internally with worker chunks
+ * of their own, instead of the sweep scheduler executing angle sets
+ * concurrently.*/
+class LevelSweepChunkInterface
+{
+public:
+  /**Sets the chunks, of the same type, used by the additional threads. An
+   * empty vector sweeps serially.*/
+  virtual void SetWorkerChunks(
+    const std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>&
+      worker_chunks) = 0;
+
+  virtual ~LevelSweepChunkInterface() = default;
+};
+
+// ##################################################################
+/**AAH sweep chunk that sweeps an angle set level by level, a level being a
+ * wavefront of cells without local dependencies on each other (see
+ * SPDS::GetLocalSweepPlanes). The cells of a level, each with all the
+ * directions and groups of the angle set, form a batch that is executed
+ * concurrently by this chunk and its worker chunks, one per thread. The
+ * per-cell work is that of the AAH chunk BaseChunk, i.e., AAH_SweepChunk
+ * or the direction-vectorized AAH_BatchedSweepChunk.
+ *
+ * The sweep orderings must be levelized, in which case the FLUDS never
+ * reuses, within a level, the slots read by the level. The flux moments
+ * and angular fluxes of different cells are disjoint, hence all the chunks
+ * write into the same destinations.*/
+template <typename BaseChunk>
+class AAH_LevelSweepChunkT : public BaseChunk, public LevelSweepChunkInterface
+{
+public:
+  AAH_LevelSweepChunkT(const chi_mesh::MeshContinuum& grid,
+                       const chi_math::SpatialDiscretization& discretization,
+                       const PackedUnitCellMatrices& unit_cell_matrices,
+                       std::vector<lbs::CellLBSView>& cell_transport_views,
+                       std::vector<double>& destination_phi,
+                       std::vector<double>& destination_psi,
+                       const std::vector<double>& source_moments,
+                       const LBSGroupset& groupset,
+                       const std::map<int, XSPtr>& xs,
+                       int num_moments,
+                       int max_num_cell_dofs);
+
+  void Sweep(chi_mesh::sweep_management::AngleSet& angle_set) override;
+
+  void SetWorkerChunks(
+    const std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>&
+      worker_chunks) override;
+
+protected:
+  /**Computes, for every cell of the sweep ordering, the non-local
+   * downwind and upwind face counters preceding it.*/
+  void ComputeFaceCounters(const chi_mesh::sweep_management::SPDS& spds);
+
+  std::vector<std::shared_ptr<AAH_LevelSweepChunkT>> worker_chunks_;
+  /**[spls_index] -> (deploc_face_counter, preloc_face_counter)*/
+  std::vector<std::pair<int, int>> face_counters_;
+};
+
+/**Level sweeps with the per-direction AAH chunk.*/
+typedef AAH_LevelSweepChunkT<AAH_SweepChunk> AAH_LevelSweepChunk;
+/**Level sweeps with the direction-vectorized AAH chunk.*/
+typedef AAH_LevelSweepChunkT<AAH_BatchedSweepChunk> AAH_LevelBatchedSweepChunk;
+
+} // namespace lbs
+
+#endif // CHITECH_AAH_LEVELSWEEPCHUNK_H
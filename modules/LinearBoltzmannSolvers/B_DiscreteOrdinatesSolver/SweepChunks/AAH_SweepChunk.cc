@@ -11,7 +11,7 @@ namespace lbs
 AAH_SweepChunk::AAH_SweepChunk(
   const chi_mesh::MeshContinuum& grid,
   const chi_math::SpatialDiscretization& discretization,
-  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+  const PackedUnitCellMatrices& unit_cell_matrices,
   std::vector<lbs::CellLBSView>& cell_transport_views,
   std::vector<double>& destination_phi,
   std::vector<double>& destination_psi,
@@ -53,6 +53,7 @@ AAH_SweepChunk::AAH_SweepChunk(
   surface_integral_kernels_ = {Kernel("FEMUpwindSurfaceIntegrals")};
 
   mass_term_kernels_ = {Kernel("FEMSSTDMassTerms")};
+  use_fixed_size_kernels_ = true;
 
   flux_update_kernels_ = {Kernel("KernelPhiUpdate"), Kernel("KernelPsiUpdate")};
 
@@ -61,175 +62,255 @@ AAH_SweepChunk::AAH_SweepChunk(
 
 void AAH_SweepChunk::Sweep(chi_mesh::sweep_management::AngleSet& angle_set)
 {
-  const SubSetInfo& grp_ss_info =
-    groupset_.grp_subset_infos_[angle_set.GetRefGroupSubset()];
-
-  gs_ss_size_ = grp_ss_info.ss_size;
-  gs_ss_begin_ = grp_ss_info.ss_begin;
-  gs_gi_ = groupset_.groups_[gs_ss_begin_].id_;
+  BeginAngleSet(angle_set);
 
   int deploc_face_counter = -1;
   int preloc_face_counter = -1;
 
-  sweep_dependency_interface_.angle_set_ = &angle_set;
-  sweep_dependency_interface_.surface_source_active_ = IsSurfaceSourceActive();
-  sweep_dependency_interface_.gs_ss_begin_ = gs_ss_begin_;
-  sweep_dependency_interface_.gs_gi_ = gs_gi_;
-
   auto& aah_sweep_depinterf =
     dynamic_cast<AAH_SweepDependencyInterface&>(sweep_dependency_interface_);
-  aah_sweep_depinterf.fluds_ =
-    &dynamic_cast<chi_mesh::sweep_management::AAH_FLUDS&>(angle_set.GetFLUDS());
 
   // ====================================================== Loop over each
   //                                                        cell
   const auto& spds = angle_set.GetSPDS();
-  const auto& spls = spds.GetSPLS().item_id;
-  const size_t num_spls = spls.size();
-  for (size_t spls_index = 0; spls_index < num_spls; ++spls_index)
+  const size_t num_spls = spds.GetSPLS().item_id.size();
+
+  size_t spls_index = 0;
+  if (local_cycle_iterations_ > 0)
   {
-    cell_local_id_ = spls[spls_index];
-    cell_ = &grid_.local_cells[cell_local_id_];
-    sweep_dependency_interface_.cell_ptr_ = cell_;
-    sweep_dependency_interface_.cell_local_id_ = cell_local_id_;
-    cell_mapping_ = &grid_fe_view_.GetCellMapping(*cell_);
-    cell_transport_view_ = &grid_transport_view_[cell_->local_id_];
-
-    using namespace chi_mesh::sweep_management;
-    const auto& face_orientations = spds.CellFaceOrientations()[cell_local_id_];
-
-    cell_num_faces_ = cell_->faces_.size();
-    cell_num_nodes_ = cell_mapping_->NumNodes();
-    const auto& sigma_t = xs_.at(cell_->material_id_)->SigmaTotal();
-
-    aah_sweep_depinterf.spls_index = spls_index;
-
-    // =============================================== Get Cell matrices
-    const auto& fe_intgrl_values = unit_cell_matrices_[cell_local_id_];
-    G_ = &fe_intgrl_values.G_matrix;
-    M_ = &fe_intgrl_values.M_matrix;
-    M_surf_ = &fe_intgrl_values.face_M_matrices;
-    IntS_shapeI_ = &fe_intgrl_values.face_Si_vectors;
-
-    for (auto& callback : cell_data_callbacks_)
-      callback();
-
-    // =============================================== Loop over angles in set
-    const int ni_deploc_face_counter = deploc_face_counter;
-    const int ni_preloc_face_counter = preloc_face_counter;
-
-    // as = angle set
-    // ss = subset
-    const std::vector<size_t>& as_angle_indices = angle_set.GetAngleIndices();
-    const size_t as_num_angles = as_angle_indices.size();
-    for (size_t as_ss_idx = 0; as_ss_idx < as_num_angles; ++as_ss_idx)
+    auto& fluds = *aah_sweep_depinterf.fluds_;
+    for (const auto& [range_begin, range_end] : spds.GetLocalCycleSPLSRanges())
     {
-      direction_num_ = as_angle_indices[as_ss_idx];
-      omega_ = groupset_.quadrature_->omegas_[direction_num_];
-      direction_qweight_ = groupset_.quadrature_->weights_[direction_num_];
+      // Cells up to the range, including the final pass over the previous
+      // range
+      for (; spls_index < range_begin; ++spls_index)
+        SweepCell(
+          angle_set, spls_index, deploc_face_counter, preloc_face_counter);
+
+      // ============================================= Inner iterations
+      // The cells of the range are swept repeatedly, each pass reading the
+      // cyclic psi written by the previous one, without updating fluxes
+      const int range_deploc_face_counter = deploc_face_counter;
+      const int range_preloc_face_counter = preloc_face_counter;
+
+      accumulate_fluxes_ = false;
+      for (int k = 0; k < local_cycle_iterations_; ++k)
+      {
+        deploc_face_counter = range_deploc_face_counter;
+        preloc_face_counter = range_preloc_face_counter;
+        for (size_t i = range_begin; i <= range_end; ++i)
+          SweepCell(angle_set, i, deploc_face_counter, preloc_face_counter);
 
-      sweep_dependency_interface_.angle_set_index_ = as_ss_idx;
-      sweep_dependency_interface_.angle_num_ = direction_num_;
+        fluds.CopyDelayedLocalPsiToOld(range_begin, range_end);
+      }
+      accumulate_fluxes_ = true;
 
-      deploc_face_counter = ni_deploc_face_counter;
-      preloc_face_counter = ni_preloc_face_counter;
+      deploc_face_counter = range_deploc_face_counter;
+      preloc_face_counter = range_preloc_face_counter;
+    } // for cycle range
+  }
 
-      // ======================================== Reset right-handside
-      for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
-        b_[gsg].assign(cell_num_nodes_, 0.0);
+  for (; spls_index < num_spls; ++spls_index)
+    SweepCell(angle_set, spls_index, deploc_face_counter, preloc_face_counter);
+}
 
-      ExecuteKernels(direction_data_callbacks_and_kernels_);
+// ##################################################################
+/**Sets the group subset and the dependency interface for sweeping the
+ * cells of the given angle set.*/
+void AAH_SweepChunk::BeginAngleSet(
+  chi_mesh::sweep_management::AngleSet& angle_set)
+{
+  const SubSetInfo& grp_ss_info =
+    groupset_.grp_subset_infos_[angle_set.GetRefGroupSubset()];
 
-      // ======================================== Upwinding structure
-      aah_sweep_depinterf.in_face_counter = 0;
-      aah_sweep_depinterf.preloc_face_counter = 0;
-      aah_sweep_depinterf.out_face_counter = 0;
-      aah_sweep_depinterf.deploc_face_counter = 0;
+  gs_ss_size_ = grp_ss_info.ss_size;
+  gs_ss_begin_ = grp_ss_info.ss_begin;
+  gs_gi_ = groupset_.groups_[gs_ss_begin_].id_;
 
-      // ======================================== Update face orientations
-      face_mu_values_.assign(cell_num_faces_, 0.0);
-      for (int f = 0; f < cell_num_faces_; ++f)
-        face_mu_values_[f] = omega_.Dot(cell_->faces_[f].normal_);
+  sweep_dependency_interface_.angle_set_ = &angle_set;
+  sweep_dependency_interface_.surface_source_active_ = IsSurfaceSourceActive();
+  sweep_dependency_interface_.gs_ss_begin_ = gs_ss_begin_;
+  sweep_dependency_interface_.gs_gi_ = gs_gi_;
 
-      // ======================================== Surface integrals
-      int in_face_counter = -1;
-      for (int f = 0; f < cell_num_faces_; ++f)
-      {
-        const auto& face = cell_->faces_[f];
+  auto& aah_sweep_depinterf =
+    dynamic_cast<AAH_SweepDependencyInterface&>(sweep_dependency_interface_);
+  aah_sweep_depinterf.SetFLUDS(
+    dynamic_cast<chi_mesh::sweep_management::AAH_FLUDS&>(angle_set.GetFLUDS()),
+    angle_set.GetAngleIndices().size(),
+    gs_ss_size_);
+}
 
-        if (face_orientations[f] != FaceOrientation::INCOMING) continue;
+// ##################################################################
+/**Sets the number of inner iterations on local cycles.*/
+void AAH_SweepChunk::SetLocalCycleIterations(int num_iterations)
+{
+  local_cycle_iterations_ = num_iterations;
+}
+
+// ##################################################################
+/**Sweeps a single cell for all the directions of the angle set.*/
+void AAH_SweepChunk::SweepCell(
+  chi_mesh::sweep_management::AngleSet& angle_set,
+  size_t spls_index,
+  int& deploc_face_counter,
+  int& preloc_face_counter)
+{
+  auto& aah_sweep_depinterf =
+    dynamic_cast<AAH_SweepDependencyInterface&>(sweep_dependency_interface_);
 
-        const bool local = cell_transport_view_->IsFaceLocal(f);
-        const bool boundary = not face.has_neighbor_;
+  cell_local_id_ = angle_set.GetSPDS().GetSPLS().item_id[spls_index];
+  cell_ = &grid_.local_cells[cell_local_id_];
+  sweep_dependency_interface_.cell_ptr_ = cell_;
+  sweep_dependency_interface_.cell_local_id_ = cell_local_id_;
+  cell_mapping_ = &grid_fe_view_.GetCellMapping(*cell_);
+  cell_transport_view_ = &grid_transport_view_[cell_->local_id_];
+  EvaluateCellSource();
+
+  using namespace chi_mesh::sweep_management;
+  SetCellFaceData(angle_set);
+  const auto* face_orientations = cell_face_orientations_;
+
+  cell_num_faces_ = cell_->faces_.size();
+  cell_num_nodes_ = cell_mapping_->NumNodes();
+  SetCellFixedSizeKernel();
+  const auto& sigma_t = CellSigmaTotal();
+
+  aah_sweep_depinterf.spls_index = spls_index;
+
+  // =============================================== Get Cell matrices
+  const auto fe_intgrl_values = unit_cell_matrices_[cell_local_id_];
+  G_ = fe_intgrl_values.G_matrix;
+  M_ = fe_intgrl_values.M_matrix;
+  M_surf_ = fe_intgrl_values.face_M_matrices;
+  IntS_shapeI_ = fe_intgrl_values.face_Si_vectors;
+
+  for (auto& callback : cell_data_callbacks_)
+    callback();
+
+  // =============================================== Loop over angles in set
+  const int ni_deploc_face_counter = deploc_face_counter;
+  const int ni_preloc_face_counter = preloc_face_counter;
+
+  // as = angle set
+  // ss = subset
+  const std::vector<size_t>& as_angle_indices = angle_set.GetAngleIndices();
+  const size_t as_num_angles = as_angle_indices.size();
+  for (size_t as_ss_idx = 0; as_ss_idx < as_num_angles; ++as_ss_idx)
+  {
+    direction_num_ = as_angle_indices[as_ss_idx];
+    omega_ = groupset_.quadrature_->omegas_[direction_num_];
+    direction_qweight_ = groupset_.quadrature_->weights_[direction_num_];
 
-        if (local) ++in_face_counter;
-        else if (not boundary)
-          ++preloc_face_counter;
+    sweep_dependency_interface_.angle_set_index_ = as_ss_idx;
+    sweep_dependency_interface_.angle_num_ = direction_num_;
 
-        sweep_dependency_interface_.SetupIncomingFace(
-          f,
-          cell_mapping_->NumFaceNodes(f),
-          face.neighbor_id_,
-          local,
-          boundary);
+    deploc_face_counter = ni_deploc_face_counter;
+    preloc_face_counter = ni_preloc_face_counter;
 
-        aah_sweep_depinterf.in_face_counter = in_face_counter;
-        aah_sweep_depinterf.preloc_face_counter = preloc_face_counter;
+    // ======================================== Reset right-handside
+    for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+      b_[gsg].assign(cell_num_nodes_, 0.0);
 
-        // IntSf_mu_psi_Mij_dA
-        ExecuteKernels(surface_integral_kernels_);
-      } // for f
+    ExecuteKernels(direction_data_callbacks_and_kernels_);
 
-      // ======================================== Looping over groups,
-      //                                          Assembling mass terms
-      for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
-      {
-        g_ = gs_gi_ + gsg;
-        gsg_ = gsg;
-        sigma_tg_ = sigma_t[g_];
+    // ======================================== Upwinding structure
+    aah_sweep_depinterf.in_face_counter = 0;
+    aah_sweep_depinterf.preloc_face_counter = 0;
+    aah_sweep_depinterf.out_face_counter = 0;
+    aah_sweep_depinterf.deploc_face_counter = 0;
 
-        ExecuteKernels(mass_term_kernels_);
+    // ======================================== Update face orientations
+    UpdateFaceMuValues(as_ss_idx);
 
-        // ================================= Solve system
-        chi_math::GaussElimination(Atemp_, b_[gsg], scint(cell_num_nodes_));
-      }
+    // ======================================== Surface integrals
+    int in_face_counter = -1;
+    for (int f = 0; f < cell_num_faces_; ++f)
+    {
+      const auto& face = cell_->faces_[f];
 
-      // ======================================== Flux updates
-      ExecuteKernels(flux_update_kernels_);
+      if (face_orientations[f] != FaceOrientation::INCOMING) continue;
 
-      // ======================================== Perform outgoing
-      //                                               surface operations
-      int out_face_counter = -1;
-      for (int f = 0; f < cell_num_faces_; ++f)
-      {
-        if (face_orientations[f] != FaceOrientation::OUTGOING) continue;
+      const bool local = cell_transport_view_->IsFaceLocal(f);
+      const bool boundary = not face.has_neighbor_;
 
-        // ================================= Set flags and counters
-        out_face_counter++;
-        const auto& face = cell_->faces_[f];
-        const bool local = cell_transport_view_->IsFaceLocal(f);
-        const bool boundary = not face.has_neighbor_;
-        const int locality = cell_transport_view_->FaceLocality(f);
+      if (local) ++in_face_counter;
+      else if (not boundary)
+        ++preloc_face_counter;
 
-        if (not boundary and not local) ++deploc_face_counter;
+      sweep_dependency_interface_.SetupIncomingFace(
+        f,
+        cell_mapping_->NumFaceNodes(f),
+        face.neighbor_id_,
+        local,
+        boundary);
 
-        sweep_dependency_interface_.SetupOutgoingFace(
-          f,
-          cell_mapping_->NumFaceNodes(f),
-          face.neighbor_id_,
-          local,
-          boundary,
-          locality);
+      aah_sweep_depinterf.in_face_counter = in_face_counter;
+      aah_sweep_depinterf.preloc_face_counter = preloc_face_counter;
 
-        aah_sweep_depinterf.out_face_counter = out_face_counter;
-        aah_sweep_depinterf.deploc_face_counter = deploc_face_counter;
+      // IntSf_mu_psi_Mij_dA
+      ExecuteKernels(surface_integral_kernels_);
+    } // for f
 
+    // ======================================== Looping over groups,
+    //                                          Assembling mass terms
+    AddTimeDerivativeSource();
+    AssembleAndSolveGroups(sigma_t);
+
+    // ======================================== Flux updates
+    if (accumulate_fluxes_) ExecuteKernels(flux_update_kernels_);
+
+    // ======================================== Perform outgoing
+    //                                               surface operations
+    int out_face_counter = -1;
+    for (int f = 0; f < cell_num_faces_; ++f)
+    {
+      if (face_orientations[f] != FaceOrientation::OUTGOING) continue;
+
+      // ================================= Set flags and counters
+      out_face_counter++;
+      const auto& face = cell_->faces_[f];
+      const bool local = cell_transport_view_->IsFaceLocal(f);
+      const bool boundary = not face.has_neighbor_;
+      const int locality = cell_transport_view_->FaceLocality(f);
+
+      if (not boundary and not local) ++deploc_face_counter;
+
+      sweep_dependency_interface_.SetupOutgoingFace(
+        f,
+        cell_mapping_->NumFaceNodes(f),
+        face.neighbor_id_,
+        local,
+        boundary,
+        locality);
+
+      aah_sweep_depinterf.out_face_counter = out_face_counter;
+      aah_sweep_depinterf.deploc_face_counter = deploc_face_counter;
+
+      // Vacuum boundary faces only tally outflow
+      if (accumulate_fluxes_ or not boundary or
+          sweep_dependency_interface_.is_reflecting_bndry_)
         OutgoingSurfaceOperations();
-      } // for face
+    } // for face
 
-      ExecuteKernels(post_cell_dir_sweep_callbacks_);
-    } // for n
-  }   // for cell
+    ExecuteKernels(post_cell_dir_sweep_callbacks_);
+  } // for n
+}
+
+// ##################################################################
+/**Sets the FLUDS of the angle set and sizes the double precision copies of
+ * the non-local psi.*/
+void AAH_SweepDependencyInterface::SetFLUDS(
+  chi_mesh::sweep_management::AAH_FLUDS& fluds,
+  size_t num_angles,
+  size_t gs_ss_size)
+{
+  fluds_ = &fluds;
+  gs_ss_size_ = gs_ss_size;
+  if (fluds.SinglePrecisionNonLocalPsi())
+  {
+    nonlocal_upwind_psi_.assign(num_angles * gs_ss_size, 0.0);
+    nonlocal_downwind_psi_.assign(gs_ss_size, 0.0);
+  }
 }
 
 // ##################################################################
@@ -241,8 +322,22 @@ AAH_SweepDependencyInterface::GetUpwindPsi(int face_node_local_idx) const
     psi = fluds_->UpwindPsi(
       spls_index, in_face_counter, face_node_local_idx, 0, angle_set_index_);
   else if (not on_boundary_)
-    psi = fluds_->NLUpwindPsi(
-      preloc_face_counter, face_node_local_idx, 0, angle_set_index_);
+  {
+    const float* psi_sp =
+      fluds_->SinglePrecisionNonLocalPsi()
+        ? fluds_->NLUpwindPsiSP(
+            preloc_face_counter, face_node_local_idx, 0, angle_set_index_)
+        : nullptr;
+    if (psi_sp != nullptr)
+    {
+      double* psi_dp = &nonlocal_upwind_psi_[angle_set_index_ * gs_ss_size_];
+      std::copy(psi_sp, psi_sp + gs_ss_size_, psi_dp);
+      psi = psi_dp;
+    }
+    else
+      psi = fluds_->NLUpwindPsi(
+        preloc_face_counter, face_node_local_idx, 0, angle_set_index_);
+  }
   else
     psi = angle_set_->PsiBndry(neighbor_id_,
                                angle_num_,
@@ -263,8 +358,10 @@ AAH_SweepDependencyInterface::GetDownwindPsi(int face_node_local_idx) const
     psi = fluds_->OutgoingPsi(
       spls_index, out_face_counter, face_node_local_idx, angle_set_index_);
   else if (not on_boundary_)
-    psi = fluds_->NLOutgoingPsi(
-      deploc_face_counter, face_node_local_idx, angle_set_index_);
+    psi = fluds_->SinglePrecisionNonLocalPsi()
+            ? nonlocal_downwind_psi_.data()
+            : fluds_->NLOutgoingPsi(
+                deploc_face_counter, face_node_local_idx, angle_set_index_);
   else if (is_reflecting_bndry_)
     psi = angle_set_->ReflectingPsiOutBoundBndry(neighbor_id_,
                                                  angle_num_,
@@ -278,4 +375,20 @@ AAH_SweepDependencyInterface::GetDownwindPsi(int face_node_local_idx) const
   return psi;
 }
 
+// ##################################################################
+/**Rounds the psi written to a non-local face into the single precision
+ * storage of the FLUDS, if applicable.*/
+void AAH_SweepDependencyInterface::CommitDownwindPsi(
+  int face_node_local_idx) const
+{
+  if (on_local_face_ or on_boundary_ or
+      not fluds_->SinglePrecisionNonLocalPsi())
+    return;
+
+  float* psi_sp = fluds_->NLOutgoingPsiSP(
+    deploc_face_counter, face_node_local_idx, angle_set_index_);
+  for (size_t gsg = 0; gsg < gs_ss_size_; ++gsg)
+    psi_sp[gsg] = static_cast<float>(nonlocal_downwind_psi_[gsg]);
+}
+
 } // namespace lbs
\ No newline at end of file
@@ -23,8 +23,20 @@ struct AAH_SweepDependencyInterface : public SweepDependencyInterface
   int out_face_counter = 0;
   int deploc_face_counter = 0;
 
+  /**Psi of the current subset's groups, in double precision, for the
+   * non-local faces when the FLUDS stores their psi in single precision.
+   * The upwind psi has one block per angle of the angle set.*/
+  size_t gs_ss_size_ = 0;
+  mutable std::vector<double> nonlocal_upwind_psi_;
+  mutable std::vector<double> nonlocal_downwind_psi_;
+
+  void SetFLUDS(chi_mesh::sweep_management::AAH_FLUDS& fluds,
+                size_t num_angles,
+                size_t gs_ss_size);
+
   const double* GetUpwindPsi(int face_node_local_idx) const override;
   double* GetDownwindPsi(int face_node_local_idx) const override;
+  void CommitDownwindPsi(int face_node_local_idx) const override;
 };
 
 // ##################################################################
@@ -34,7 +46,7 @@ class AAH_SweepChunk : public SweepChunk
 public:
   AAH_SweepChunk(const chi_mesh::MeshContinuum& grid,
                 const chi_math::SpatialDiscretization& discretization,
-                const std::vector<UnitCellMatrices>& unit_cell_matrices,
+                const PackedUnitCellMatrices& unit_cell_matrices,
                 std::vector<lbs::CellLBSView>& cell_transport_views,
                 std::vector<double>& destination_phi,
                 std::vector<double>& destination_psi,
@@ -47,6 +59,26 @@ public:
   // 01
   void Sweep(chi_mesh::sweep_management::AngleSet& angle_set) override;
 
+  /**Sets the number of inner iterations performed on each range of cells
+   * containing local cycles, before the final pass over the range. Zero
+   * leaves the cyclic dependencies lagged to the next sweep.*/
+  void SetLocalCycleIterations(int num_iterations);
+
+protected:
+  /**Prepares the chunk for sweeping the cells of the angle set.*/
+  void BeginAngleSet(chi_mesh::sweep_management::AngleSet& angle_set);
+
+  /**Sweeps the cell at the given sweep ordering index, for all the
+   * directions of the angle set.*/
+  void SweepCell(chi_mesh::sweep_management::AngleSet& angle_set,
+                 size_t spls_index,
+                 int& deploc_face_counter,
+                 int& preloc_face_counter);
+
+  int local_cycle_iterations_ = 0;
+  /**When false, the flux moments, angular fluxes and outflow tallies are
+   * not updated, as during inner iterations on local cycles.*/
+  bool accumulate_fluxes_ = true;
 };
 
 } // namespace lbs
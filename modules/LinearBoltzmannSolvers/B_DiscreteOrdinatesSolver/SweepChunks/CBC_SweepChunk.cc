@@ -17,7 +17,7 @@ CBC_SweepChunk::CBC_SweepChunk(
   std::vector<double>& destination_psi,
   const chi_mesh::MeshContinuum& grid,
   const chi_math::SpatialDiscretization& discretization,
-  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+  const PackedUnitCellMatrices& unit_cell_matrices,
   std::vector<lbs::CellLBSView>& cell_transport_views,
   const std::vector<double>& source_moments,
   const LBSGroupset& groupset,
@@ -59,6 +59,7 @@ CBC_SweepChunk::CBC_SweepChunk(
   surface_integral_kernels_ = {Kernel("FEMUpwindSurfaceIntegrals")};
 
   mass_term_kernels_ = {Kernel("FEMSSTDMassTerms")};
+  use_fixed_size_kernels_ = true;
 
   flux_update_kernels_ = {Kernel("KernelPhiUpdate"), Kernel("KernelPsiUpdate")};
 
@@ -97,16 +98,18 @@ void CBC_SweepChunk::SetCell(const chi_mesh::Cell* cell_ptr,
   sweep_dependency_interface_.cell_local_id_ = cell_local_id_;
   cell_mapping_ = &grid_fe_view_.GetCellMapping(*cell_);
   cell_transport_view_ = &grid_transport_view_[cell_->local_id_];
+  EvaluateCellSource();
 
   cell_num_faces_ = cell_->faces_.size();
   cell_num_nodes_ = cell_mapping_->NumNodes();
+  SetCellFixedSizeKernel();
 
   // =============================================== Get Cell matrices
-  const auto& fe_intgrl_values = unit_cell_matrices_[cell_local_id_];
-  G_ = &fe_intgrl_values.G_matrix;
-  M_ = &fe_intgrl_values.M_matrix;
-  M_surf_ = &fe_intgrl_values.face_M_matrices;
-  IntS_shapeI_ = &fe_intgrl_values.face_Si_vectors;
+  const auto fe_intgrl_values = unit_cell_matrices_[cell_local_id_];
+  G_ = fe_intgrl_values.G_matrix;
+  M_ = fe_intgrl_values.M_matrix;
+  M_surf_ = fe_intgrl_values.face_M_matrices;
+  IntS_shapeI_ = fe_intgrl_values.face_Si_vectors;
 
   for (auto& callback : cell_data_callbacks_)
     callback();
@@ -122,9 +125,9 @@ void CBC_SweepChunk::SetCells(const std::vector<const chi_mesh::Cell*>& cell_ptr
 void CBC_SweepChunk::Sweep(chi_mesh::sweep_management::AngleSet& angle_set)
 {
   using FaceOrientation = chi_mesh::sweep_management::FaceOrientation;
-  const auto& face_orientations =
-    angle_set.GetSPDS().CellFaceOrientations()[cell_local_id_];
-  const auto& sigma_t = xs_.at(cell_->material_id_)->SigmaTotal();
+  SetCellFaceData(angle_set);
+  const auto* face_orientations = cell_face_orientations_;
+  const auto& sigma_t = CellSigmaTotal();
 
   // as = angle set
   // ss = subset
@@ -146,9 +149,7 @@ void CBC_SweepChunk::Sweep(chi_mesh::sweep_management::AngleSet& angle_set)
     ExecuteKernels(direction_data_callbacks_and_kernels_);
 
     // ======================================== Update face orientations
-    face_mu_values_.assign(cell_num_faces_, 0.0);
-    for (int f = 0; f < cell_num_faces_; ++f)
-      face_mu_values_[f] = omega_.Dot(cell_->faces_[f].normal_);
+    UpdateFaceMuValues(as_ss_idx);
 
     // ======================================== Surface integrals
     for (int f = 0; f < cell_num_faces_; ++f)
@@ -169,17 +170,8 @@ void CBC_SweepChunk::Sweep(chi_mesh::sweep_management::AngleSet& angle_set)
 
     // ======================================== Looping over groups,
     //                                          Assembling mass terms
-    for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
-    {
-      g_ = gs_gi_ + gsg;
-      gsg_ = gsg;
-      sigma_tg_ = sigma_t[g_];
-
-      ExecuteKernels(mass_term_kernels_);
-
-      // ================================= Solve system
-      chi_math::GaussElimination(Atemp_, b_[gsg], scint(cell_num_nodes_));
-    }
+    AddTimeDerivativeSource();
+    AssembleAndSolveGroups(sigma_t);
 
     // ======================================== Flux updates
     ExecuteKernels(flux_update_kernels_);
@@ -51,7 +51,7 @@ public:
                  std::vector<double>& destination_psi,
                  const chi_mesh::MeshContinuum& grid,
                  const chi_math::SpatialDiscretization& discretization,
-                 const std::vector<UnitCellMatrices>& unit_cell_matrices,
+                 const PackedUnitCellMatrices& unit_cell_matrices,
                  std::vector<lbs::CellLBSView>& cell_transport_views,
                  const std::vector<double>& source_moments,
                  const LBSGroupset& groupset,
@@ -0,0 +1,229 @@
+#include "CellFactorCache.h"
+
+#include "A_LBSSolver/Groupset/lbs_groupset.h"
+#include "mesh/SweepUtilities/AngleAggregation/angleaggregation.h"
+#include "mesh/SweepUtilities/AngleSet/AngleSet.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Allots the cache slots of the local cells with at most `max_num_nodes`
+ * nodes, in local order, until the memory budget is used.*/
+CellFactorCache::CellFactorCache(
+  const LBSGroupset& groupset,
+  const std::vector<CellLBSView>& cell_transport_views,
+  size_t max_num_nodes,
+  double max_mb)
+  : groupset_(groupset), cell_transport_views_(cell_transport_views)
+{
+  //=========================================== Local directions
+  direction_index_.assign(groupset.quadrature_->omegas_.size(), -1);
+  for (auto& angle_set_group : groupset.angle_agg_->angle_set_groups)
+    for (auto& angle_set : angle_set_group.AngleSets())
+      for (const size_t direction : angle_set->GetAngleIndices())
+        if (direction_index_[direction] < 0)
+          direction_index_[direction] = static_cast<int>(num_directions_++);
+
+  //=========================================== Allot slots
+  const double max_bytes = max_mb * 1024.0 * 1024.0;
+  size_t num_bytes = 0;
+  size_t num_doubles = 0;
+
+  cell_entries_.resize(cell_transport_views.size());
+  for (size_t c = 0; c < cell_transport_views.size(); ++c)
+  {
+    const auto& transport_view = cell_transport_views[c];
+    const auto num_nodes = static_cast<size_t>(transport_view.NumNodes());
+    if (num_nodes > max_num_nodes) continue;
+
+    const auto& xs = transport_view.XS();
+    const auto& class_map = GetClassMap(xs);
+    const size_t cell_slots = num_directions_ * class_map.num_classes;
+    const size_t cell_bytes =
+      cell_slots * (num_nodes * num_nodes * sizeof(double) + 1);
+    if (static_cast<double>(num_bytes + cell_bytes) > max_bytes) continue;
+
+    auto& entry = cell_entries_[c];
+    entry.xs = &xs;
+    entry.xs_revision = xs.Revision();
+    entry.class_map = &class_map;
+    entry.num_nodes = num_nodes;
+    entry.max_num_classes = class_map.num_classes;
+    entry.first_slot = num_slots_;
+    entry.data_offset = num_doubles;
+    entry.valid = true;
+
+    num_slots_ += cell_slots;
+    num_doubles += cell_slots * num_nodes * num_nodes;
+    num_bytes += cell_bytes;
+    ++num_cached_cells_;
+  }
+
+  factors_.assign(num_doubles, 0.0);
+  slot_status_ = std::make_unique<std::atomic<uint8_t>[]>(num_slots_);
+  for (size_t s = 0; s < num_slots_; ++s)
+    slot_status_[s].store(EMPTY, std::memory_order_relaxed);
+}
+
+// ##################################################################
+/**Returns the class map of the given cross section, recomputing it if the
+ * cross section was modified since.*/
+const CellFactorCache::ClassMap&
+CellFactorCache::GetClassMap(const chi_physics::MultiGroupXS& xs)
+{
+  auto [it, inserted] = class_maps_.try_emplace(&xs);
+  auto& class_map = it->second;
+  if (not inserted and class_map.xs_revision == xs.Revision())
+    return class_map;
+
+  const auto& sigma_t = xs.SigmaTotal();
+  std::vector<double> class_sigma_t;
+  class_map.xs_revision = xs.Revision();
+  class_map.group_class.clear();
+  for (const auto& group : groupset_.groups_)
+  {
+    const double sigma_tg = sigma_t[group.id_];
+    auto class_it =
+      std::find(class_sigma_t.begin(), class_sigma_t.end(), sigma_tg);
+    if (class_it == class_sigma_t.end())
+      class_it = class_sigma_t.insert(class_sigma_t.end(), sigma_tg);
+    class_map.group_class.push_back(
+      static_cast<uint32_t>(class_it - class_sigma_t.begin()));
+  }
+  class_map.num_classes = class_sigma_t.size();
+
+  return class_map;
+}
+
+// ##################################################################
+void CellFactorCache::Update()
+{
+  for (size_t c = 0; c < cell_entries_.size(); ++c)
+  {
+    auto& entry = cell_entries_[c];
+    if (entry.num_nodes == 0) continue;
+
+    const auto& xs = cell_transport_views_[c].XS();
+    if (entry.valid and entry.xs == &xs and
+        entry.xs_revision == xs.Revision())
+      continue;
+
+    const auto& class_map = GetClassMap(xs);
+    entry.xs = &xs;
+    entry.xs_revision = xs.Revision();
+    entry.class_map = &class_map;
+    entry.valid = class_map.num_classes <= entry.max_num_classes;
+
+    const size_t cell_slots = num_directions_ * entry.max_num_classes;
+    for (size_t s = 0; s < cell_slots; ++s)
+      slot_status_[entry.first_slot + s].store(EMPTY,
+                                               std::memory_order_relaxed);
+  }
+}
+
+// ##################################################################
+size_t CellFactorCache::SlotIndex(const CellEntry& entry,
+                                  size_t direction,
+                                  size_t group_index) const
+{
+  const int d = direction_index_[direction];
+  if (d < 0) return num_slots_;
+
+  return entry.first_slot +
+         static_cast<size_t>(d) * entry.max_num_classes +
+         entry.class_map->group_class[group_index];
+}
+
+// ##################################################################
+const double* CellFactorCache::Factors(const CellEntry& entry,
+                                       size_t direction,
+                                       size_t group_index) const
+{
+  const size_t slot = SlotIndex(entry, direction, group_index);
+  if (slot == num_slots_ or
+      slot_status_[slot].load(std::memory_order_acquire) != READY)
+    return nullptr;
+
+  const size_t n2 = entry.num_nodes * entry.num_nodes;
+  return &factors_[entry.data_offset + (slot - entry.first_slot) * n2];
+}
+
+// ##################################################################
+double* CellFactorCache::BeginFill(const CellEntry& entry,
+                                   size_t direction,
+                                   size_t group_index)
+{
+  const size_t slot = SlotIndex(entry, direction, group_index);
+  if (slot == num_slots_) return nullptr;
+
+  uint8_t expected = EMPTY;
+  if (not slot_status_[slot].compare_exchange_strong(
+        expected, FILLING, std::memory_order_acquire))
+    return nullptr;
+
+  const size_t n2 = entry.num_nodes * entry.num_nodes;
+  return &factors_[entry.data_offset + (slot - entry.first_slot) * n2];
+}
+
+// ##################################################################
+void CellFactorCache::EndFill(const CellEntry& entry,
+                              size_t direction,
+                              size_t group_index)
+{
+  const size_t slot = SlotIndex(entry, direction, group_index);
+  slot_status_[slot].store(READY, std::memory_order_release);
+}
+
+// ##################################################################
+double CellFactorCache::SizeMB() const
+{
+  return static_cast<double>(factors_.size() * sizeof(double) + num_slots_) /
+         (1024.0 * 1024.0);
+}
+
+// ##################################################################
+void CellFactorCache::Factor(double* A, const size_t n)
+{
+  for (size_t i = 0; i + 1 < n; ++i)
+  {
+    const double* a_i = &A[i * n];
+    const double factor = 1.0 / a_i[i];
+    for (size_t j = i + 1; j < n; ++j)
+    {
+      double* a_j = &A[j * n];
+      const double l_ji = a_j[i] * factor;
+      a_j[i] = l_ji;
+      for (size_t k = i + 1; k < n; ++k)
+        a_j[k] -= l_ji * a_i[k];
+    }
+  }
+}
+
+// ##################################################################
+void CellFactorCache::Solve(const double* LU, const size_t n, double* b)
+{
+  //================================ Forward substitution, L y = b
+  for (size_t j = 1; j < n; ++j)
+  {
+    const double* a_j = &LU[j * n];
+    double b_j = b[j];
+    for (size_t i = 0; i < j; ++i)
+      b_j -= a_j[i] * b[i];
+    b[j] = b_j;
+  }
+  //================================ Back substitution, U x = y
+  for (size_t ii = n; ii > 0; --ii)
+  {
+    const size_t i = ii - 1;
+    const double* a_i = &LU[i * n];
+    double b_i = b[i];
+    for (size_t j = i + 1; j < n; ++j)
+      b_i -= a_i[j] * b[j];
+    b[i] = b_i / a_i[i];
+  }
+}
+
+} // namespace lbs
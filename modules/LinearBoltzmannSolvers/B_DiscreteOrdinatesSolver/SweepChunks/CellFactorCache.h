@@ -0,0 +1,130 @@
+#ifndef CHITECH_LBS_CELL_FACTOR_CACHE_H
+#define CHITECH_LBS_CELL_FACTOR_CACHE_H
+
+#include "A_LBSSolver/lbs_structs.h"
+#include "physics/PhysicsMaterial/MultiGroupXS/multigroup_xs.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace lbs
+{
+class LBSGroupset;
+
+// ##################################################################
+/**Cache of the LU factors of the cell systems `Amat + sigma_tg M` of a
+ * groupset's sweeps, per (cell, direction, total cross section class). The
+ * classes of a cell are the distinct total cross sections of the groupset
+ * groups. Since neither the cell matrices, the directions nor the cross
+ * sections change between sweeps, later sweeps only need the forward and
+ * back substitutions.
+ *
+ * Cells are cached in local order, as long as the memory budget allows,
+ * for the directions swept on this location. The factors are computed by
+ * the sweep chunks on first use, any number of which may share the cache
+ * concurrently. A cell whose cross sections were modified is bypassed
+ * until the next call to Update.*/
+class CellFactorCache
+{
+public:
+  /**Groupset group to class index, for a cross section revision.*/
+  struct ClassMap
+  {
+    size_t xs_revision = 0;
+    size_t num_classes = 0;
+    std::vector<uint32_t> group_class;
+  };
+
+  struct CellEntry
+  {
+    const chi_physics::MultiGroupXS* xs = nullptr;
+    size_t xs_revision = 0;
+    const ClassMap* class_map = nullptr;
+    size_t num_nodes = 0;
+    /**Number of classes the slots were allotted for.*/
+    size_t max_num_classes = 0;
+    size_t first_slot = 0;
+    size_t data_offset = 0;
+    bool valid = false;
+  };
+
+private:
+  enum SlotStatus : uint8_t {EMPTY = 0, FILLING = 1, READY = 2};
+
+  const LBSGroupset& groupset_;
+  const std::vector<CellLBSView>& cell_transport_views_;
+  /**Per quadrature direction, its index among the local directions, or -1
+   * if not swept on this location.*/
+  std::vector<int> direction_index_;
+  size_t num_directions_ = 0;
+
+  std::map<const chi_physics::MultiGroupXS*, ClassMap> class_maps_;
+  /**Per local cell, entries without slots for uncached cells.*/
+  std::vector<CellEntry> cell_entries_;
+  std::vector<double> factors_;
+  std::unique_ptr<std::atomic<uint8_t>[]> slot_status_;
+  size_t num_slots_ = 0;
+  size_t num_cached_cells_ = 0;
+
+public:
+  CellFactorCache(const LBSGroupset& groupset,
+                  const std::vector<CellLBSView>& cell_transport_views,
+                  size_t max_num_nodes,
+                  double max_mb);
+
+  CellFactorCache(const CellFactorCache&) = delete;
+  CellFactorCache& operator=(const CellFactorCache&) = delete;
+
+  /**Revalidates the cells whose cross sections were modified, their
+   * factors being recomputed on next use. Not thread safe.*/
+  void Update();
+
+  /**Returns the entry of the cell if it is cached with the given cross
+   * section, and its current revision, otherwise nullptr.*/
+  const CellEntry* GetCellEntry(uint64_t cell_local_id,
+                                const chi_physics::MultiGroupXS& xs) const
+  {
+    const auto& entry = cell_entries_[cell_local_id];
+    if (not entry.valid or entry.xs != &xs or
+        entry.xs_revision != xs.Revision())
+      return nullptr;
+    return &entry;
+  }
+
+  /**Returns the factors of the cell system for the direction and the
+   * groupset group index, or nullptr if not yet computed.*/
+  const double* Factors(const CellEntry& entry,
+                        size_t direction,
+                        size_t group_index) const;
+
+  /**Claims the slot of the cell system for the direction and groupset
+   * group index and returns its storage, for the factors to be written and
+   * published with EndFill. Returns nullptr if the direction is not cached
+   * or another thread is computing the factors.*/
+  double* BeginFill(const CellEntry& entry,
+                    size_t direction,
+                    size_t group_index);
+  void EndFill(const CellEntry& entry, size_t direction, size_t group_index);
+
+  size_t NumCachedCells() const { return num_cached_cells_; }
+  double SizeMB() const;
+
+  /**Factors the row-major n by n matrix in place, without pivoting, with
+   * the arithmetic of chi_math::SmallLU.*/
+  static void Factor(double* A, size_t n);
+  /**Replaces b with the solution of the system factored by Factor.*/
+  static void Solve(const double* LU, size_t n, double* b);
+
+private:
+  const ClassMap& GetClassMap(const chi_physics::MultiGroupXS& xs);
+  /**Returns the slot index, or the number of slots if not cached.*/
+  size_t SlotIndex(const CellEntry& entry,
+                   size_t direction,
+                   size_t group_index) const;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_LBS_CELL_FACTOR_CACHE_H
@@ -2,6 +2,8 @@
 
 #include "A_LBSSolver/Groupset/lbs_groupset.h"
 #include "math/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
+#include "mesh/SweepUtilities/AngleSet/AngleSet.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -17,7 +19,7 @@ SweepChunk::SweepChunk(
   std::vector<double>& destination_psi,
   const chi_mesh::MeshContinuum& grid,
   const chi_math::SpatialDiscretization& discretization,
-  const std::vector<UnitCellMatrices>& unit_cell_matrices,
+  const PackedUnitCellMatrices& unit_cell_matrices,
   std::vector<lbs::CellLBSView>& cell_transport_views,
   const std::vector<double>& source_moments,
   const LBSGroupset& groupset,
@@ -73,6 +75,13 @@ SweepChunk::CallbackFunction SweepChunk::Kernel(const std::string& name) const
   return kernels_.at(name);
 }
 
+// ##################################################################
+/**Sets the function evaluating the source moments of a cell.*/
+void SweepChunk::SetCellSourceFunction(CellSourceFunction function)
+{
+  cell_source_function_ = std::move(function);
+}
+
 // ##################################################################
 /**Executes the supplied kernels list.*/
 void SweepChunk::ExecuteKernels(const std::vector<CallbackFunction>& kernels)
@@ -84,12 +93,14 @@ void SweepChunk::ExecuteKernels(const std::vector<CallbackFunction>& kernels)
 // ##################################################################
 /**Operations when outgoing fluxes are handled including passing
  * face angular fluxes downstream and computing
- * balance parameters (i.e. outflow)
+ * balance parameters (i.e. outflow). The outflow is tallied per boundary
+ * face, reflecting ones included, such that the leakage of each boundary
+ * is known without the angular fluxes.
  * */
 void SweepChunk::OutgoingSurfaceOperations()
 {
   const size_t f = sweep_dependency_interface_.current_face_idx_;
-  const auto& IntF_shapeI = (*IntS_shapeI_)[f];
+  const double* IntF_shapeI = IntS_shapeI_[f];
   const double mu = face_mu_values_[f];
   const double wt = direction_qweight_;
 
@@ -106,21 +117,161 @@ void SweepChunk::OutgoingSurfaceOperations()
 
     if (psi != nullptr)
       if (not on_boundary or is_reflecting_boundary)
+      {
         for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
           psi[gsg] = b_[gsg][i];
-    if (on_boundary and not is_reflecting_boundary)
+        sweep_dependency_interface_.CommitDownwindPsi(fi);
+      }
+    if (on_boundary)
       for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
-        cell_transport_view_->AddOutflow(gs_gi_ + gsg,
-                                         wt * mu * b_[gsg][i] * IntF_shapeI[i]);
+        cell_transport_view_->AddOutflow(
+          static_cast<int>(f), gs_gi_ + gsg,
+          wt * mu * b_[gsg][i] * IntF_shapeI[i]);
 
   } // for fi
 }
 
+// ##################################################################
+/**Sets the face orientations of the current cell and, when the angle set
+ * has a face cache, the cached face mu values.*/
+void SweepChunk::SetCellFaceData(
+  const chi_mesh::sweep_management::AngleSet& angle_set)
+{
+  const auto* face_cache = angle_set.GetFaceCache();
+  if (face_cache == nullptr)
+  {
+    cell_face_orientations_ =
+      angle_set.GetSPDS().CellFaceOrientations()[cell_local_id_].data();
+    cached_face_mu_ = nullptr;
+    cached_face_mu_stride_ = 0;
+    return;
+  }
+
+  const size_t offset = (*face_cache->cell_face_offsets)[cell_local_id_];
+  cell_face_orientations_ = &face_cache->face_orientations[offset];
+  cached_face_mu_ = &face_cache->face_mu[offset * face_cache->num_angles];
+  cached_face_mu_stride_ = face_cache->num_angles;
+}
+
+// ##################################################################
+/**Updates `face_mu_values_` for the current cell and direction.*/
+void SweepChunk::UpdateFaceMuValues(size_t as_ss_idx)
+{
+  face_mu_values_.assign(cell_num_faces_, 0.0);
+  if (cached_face_mu_ != nullptr)
+    for (int f = 0; f < cell_num_faces_; ++f)
+      face_mu_values_[f] =
+        cached_face_mu_[f * cached_face_mu_stride_ + as_ss_idx];
+  else
+    for (int f = 0; f < cell_num_faces_; ++f)
+      face_mu_values_[f] = omega_.Dot(cell_->faces_[f].normal_);
+}
+
+// ##################################################################
+/**Sets the time derivative term of the sweeps.*/
+void SweepChunk::SetTimeDerivativeTerm(
+  const TimeDerivativeTerm* time_derivative)
+{
+  time_derivative_ = time_derivative;
+}
+
+// ##################################################################
+/**Returns the total cross sections of the current cell. With an active
+ * time derivative term, the inverse velocities of the groupset groups
+ * times the inverse of theta times the time step are added.*/
+const std::vector<double>& SweepChunk::CellSigmaTotal()
+{
+  const auto& xs = cell_transport_view_->XS();
+  if (not TimeDerivativeActive()) return xs.SigmaTotal();
+
+  const auto& inv_velocity = xs.InverseVelocity();
+  const double inv_theta_dt = time_derivative_->inv_theta_dt;
+
+  time_sigma_t_ = xs.SigmaTotal();
+  for (const auto& group : groupset_.groups_)
+    time_sigma_t_[group.id_] += inv_velocity[group.id_] * inv_theta_dt;
+
+  return time_sigma_t_;
+}
+
+// ##################################################################
+/**Adds the time source of the current cell and direction, the mass matrix
+ * times the time absorption times the angular flux at the start of the
+ * step, to the right-hand sides. Applied with the surface sources, i.e.,
+ * with the fixed sources, and only when the term stores the angular fluxes
+ * of the groupset.*/
+void SweepChunk::AddTimeDerivativeSource()
+{
+  if (not TimeDerivativeActive() or not IsSurfaceSourceActive()) return;
+
+  const auto& psi_prev = time_derivative_->psi_prev;
+  const auto gs_id = static_cast<size_t>(groupset_.id_);
+  if (gs_id >= psi_prev.size() or psi_prev[gs_id].empty()) return;
+
+  const auto& M = M_;
+  const auto& inv_velocity = cell_transport_view_->XS().InverseVelocity();
+  const double inv_theta_dt = time_derivative_->inv_theta_dt;
+  const size_t cell_dir_map =
+    grid_fe_view_.MapDOFLocal(*cell_, 0, groupset_.psi_uk_man_, 0, 0) +
+    direction_num_ * groupset_group_stride_ + gs_ss_begin_;
+  const double* dir_psi_prev = &psi_prev[gs_id][cell_dir_map];
+
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const double tau = inv_velocity[gs_gi_ + gsg] * inv_theta_dt;
+    for (int i = 0; i < cell_num_nodes_; ++i)
+    {
+      double temp = 0.0;
+      for (int j = 0; j < cell_num_nodes_; ++j)
+        temp += M[i][j] * dir_psi_prev[j * groupset_angle_group_stride_ + gsg];
+      b_[gsg][i] += tau * temp;
+    } // for i
+  }   // for gsg
+}
+
+// ##################################################################
+/**Assembles mass terms and solves the cell system for each group in
+ * the current group subset. When the current cell is in the factor cache,
+ * group-batching is enabled or the cell has a fixed-size kernel, these are
+ * used instead of the generic mass term kernels.*/
+void SweepChunk::AssembleAndSolveGroups(const std::vector<double>& sigma_t)
+{
+  if (cell_factor_entry_ != nullptr)
+  {
+    KernelCachedFactorsMassTermsAndSolve(sigma_t);
+    return;
+  }
+
+  if (use_group_batched_solve_ and use_fixed_size_kernels_)
+  {
+    KernelGroupBatchedMassTermsAndSolve(sigma_t);
+    return;
+  }
+
+  if (fixed_size_kernel_ != nullptr)
+  {
+    (this->*fixed_size_kernel_)(sigma_t);
+    return;
+  }
+
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    g_ = gs_gi_ + gsg;
+    gsg_ = gsg;
+    sigma_tg_ = sigma_t[g_];
+
+    ExecuteKernels(mass_term_kernels_);
+
+    // ================================= Solve system
+    chi_math::GaussElimination(Atemp_, b_[gsg], scint(cell_num_nodes_));
+  }
+}
+
 // ##################################################################
 /**Assembles the volumetric gradient term.*/
 void SweepChunk::KernelFEMVolumetricGradientTerm()
 {
-  const auto& G = *G_;
+  const auto& G = G_;
 
   for (int i = 0; i < cell_num_nodes_; ++i)
     for (int j = 0; j < cell_num_nodes_; ++j)
@@ -132,7 +283,7 @@ void SweepChunk::KernelFEMVolumetricGradientTerm()
 void SweepChunk::KernelFEMUpwindSurfaceIntegrals()
 {
   const size_t f = sweep_dependency_interface_.current_face_idx_;
-  const auto& M_surf_f = (*M_surf_)[f];
+  const auto M_surf_f = M_surf_[f];
   const double mu = face_mu_values_[f];
   const size_t num_face_nodes = sweep_dependency_interface_.num_face_nodes_;
   for (int fi = 0; fi < num_face_nodes; ++fi)
@@ -159,8 +310,9 @@ void SweepChunk::KernelFEMUpwindSurfaceIntegrals()
 /**Assembles angular sources and applies the mass matrix terms.*/
 void SweepChunk::KernelFEMSTDMassTerms()
 {
-  const auto& M = *M_;
-  const auto& m2d_op = groupset_.quadrature_->GetMomentToDiscreteOperator();
+  const auto& M = M_;
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
 
   // ============================= Contribute source moments
   // q = M_n^T * q_moms
@@ -170,7 +322,7 @@ void SweepChunk::KernelFEMSTDMassTerms()
     for (int m = 0; m < num_moments_; ++m)
     {
       const size_t ir = cell_transport_view_->MapDOF(i, m, scint(g_));
-      temp_src += m2d_op[m][direction_num_] * q_moments_[ir];
+      temp_src += m2d_op[m] * q_moments_[ir];
     } // for m
     source_[i] = temp_src;
   } // for i
@@ -195,13 +347,14 @@ void SweepChunk::KernelFEMSTDMassTerms()
 /**Adds a single direction's contribution to the moment integrals.*/
 void SweepChunk::KernelPhiUpdate()
 {
-  const auto& d2m_op = groupset_.quadrature_->GetDiscreteToMomentOperator();
+  const double* d2m_op =
+    groupset_.quadrature_->GetDiscreteToMomentDirection(direction_num_);
 
   auto& output_phi = GetDestinationPhi();
 
   for (int m = 0; m < num_moments_; ++m)
   {
-    const double wn_d2m = d2m_op[m][direction_num_];
+    const double wn_d2m = d2m_op[m];
     for (int i = 0; i < cell_num_nodes_; ++i)
     {
       const size_t ir = cell_transport_view_->MapDOF(i, m, gs_gi_);
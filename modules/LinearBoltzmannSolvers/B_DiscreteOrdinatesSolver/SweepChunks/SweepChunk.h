@@ -2,7 +2,10 @@
 #define CHITECH_SWEEPCHUNK_H
 
 #include "mesh/SweepUtilities/sweepchunk_base.h"
+#include "mesh/Cell/cell.h"
 #include "A_LBSSolver/lbs_structs.h"
+#include "A_LBSSolver/lbs_packed_unit_cell_matrices.h"
+#include "CellFactorCache.h"
 
 namespace chi_math
 {
@@ -45,6 +48,9 @@ public:
 
   virtual const double* GetUpwindPsi(int face_node_local_idx) const = 0;
   virtual double* GetDownwindPsi(int face_node_local_idx) const = 0;
+  /**Completes writing the psi obtained from GetDownwindPsi, e.g., into
+   * storage that is not in double precision.*/
+  virtual void CommitDownwindPsi(int face_node_local_idx) const {}
 
   virtual void SetupIncomingFace(int face_id,
                                  size_t num_face_nodes,
@@ -66,12 +72,15 @@ public:
 class SweepChunk : public chi_mesh::sweep_management::SweepChunk
 {
 public:
+  /**Maximum number of cell nodes handled by the small dense kernel.*/
+  static constexpr size_t SMALL_DENSE_CAPACITY = 32;
+
   SweepChunk(
     std::vector<double>& destination_phi,
     std::vector<double>& destination_psi,
     const chi_mesh::MeshContinuum& grid,
     const chi_math::SpatialDiscretization& discretization,
-    const std::vector<UnitCellMatrices>& unit_cell_matrices,
+    const PackedUnitCellMatrices& unit_cell_matrices,
     std::vector<lbs::CellLBSView>& cell_transport_views,
     const std::vector<double>& source_moments,
     const LBSGroupset& groupset,
@@ -80,12 +89,37 @@ public:
     int max_num_cell_dofs,
     std::unique_ptr<SweepDependencyInterface> sweep_dependency_interface_ptr);
 
+  /**Enables solving all the groups of a group subset simultaneously, with
+   * the groups as the vector lane dimension. Only applies to chunks using
+   * the standard mass terms.*/
+  void SetGroupBatchedSolve(bool flag);
+
+  /**Function evaluating the source moments of a cell, given its local id,
+   * on its first visit in a sweep.*/
+  typedef std::function<void(uint64_t)> CellSourceFunction;
+  /**Sets the function called on every cell visit, before the source
+   * moments of the cell are read, when the source evaluation is fused into
+   * the sweep, see SourceFunction::DeferEvaluation.*/
+  void SetCellSourceFunction(CellSourceFunction function);
+
+  /**Sets the cache of cell system factors, possibly shared with other
+   * chunks of the groupset. Only applies to chunks using the standard mass
+   * terms.*/
+  void SetCellFactorCache(std::shared_ptr<CellFactorCache> factor_cache);
+
+  /**Sets the time derivative term of the sweeps, possibly shared with
+   * other chunks. Only applies to chunks using the standard mass terms.*/
+  void SetTimeDerivativeTerm(const TimeDerivativeTerm* time_derivative);
+
 protected:
   typedef std::function<void()> CallbackFunction;
+  /**Kernel that assembles the mass terms and solves the cell system for
+   * every group of the current group subset and direction.*/
+  typedef void (SweepChunk::*FixedSizeKernel)(const std::vector<double>&);
 
   const chi_mesh::MeshContinuum& grid_;
   const chi_math::SpatialDiscretization& grid_fe_view_;
-  const std::vector<UnitCellMatrices>& unit_cell_matrices_;
+  const PackedUnitCellMatrices& unit_cell_matrices_;
   std::vector<lbs::CellLBSView>& grid_transport_view_;
   const std::vector<double>& q_moments_;
   const LBSGroupset& groupset_;
@@ -116,14 +150,24 @@ protected:
   CellLBSView* cell_transport_view_ = nullptr;
   size_t cell_num_faces_ = 0;
   size_t cell_num_nodes_ = 0;
-  const MatVec3* G_ = nullptr;
-  const MatDbl* M_ = nullptr;
-  const std::vector<MatDbl>* M_surf_ = nullptr;
-  const std::vector<VecDbl>* IntS_shapeI_ = nullptr;
+  PackedMatrixView<chi_mesh::Vector3> G_;
+  PackedMatrixView<double> M_;
+  PackedFaceBlocksView<PackedMatrixView<double>> M_surf_;
+  PackedFaceBlocksView<const double*> IntS_shapeI_;
+
+  CellSourceFunction cell_source_function_;
 
   /**Callbacks at phase 1 : cell data established*/
   std::vector<CallbackFunction> cell_data_callbacks_;
 
+  /**Face orientations of the current cell*/
+  const chi_mesh::sweep_management::FaceOrientation* cell_face_orientations_ =
+    nullptr;
+  /**Cached face mu values of the current cell, indexed as
+   * [f*cached_face_mu_stride_ + as_ss_idx], or nullptr.*/
+  const double* cached_face_mu_ = nullptr;
+  size_t cached_face_mu_stride_ = 0;
+
   std::vector<double> face_mu_values_;
   size_t direction_num_ = 0;
   chi_mesh::Vector3 omega_;
@@ -142,6 +186,30 @@ protected:
   /**Callbacks at phase 4 : group by group mass terms*/
   std::vector<CallbackFunction> mass_term_kernels_;
 
+  /**Flag indicating that the mass terms are the standard ones
+   * (FEMSSTDMassTerms), in which case phase 4 may be replaced by a
+   * compile-time specialized kernel for common cell shapes.*/
+  bool use_fixed_size_kernels_ = false;
+  /**The specialized phase 4 kernel for the current cell, or nullptr.*/
+  FixedSizeKernel fixed_size_kernel_ = nullptr;
+
+  /**The cache of cell system factors and the entry of the current cell,
+   * if cached, in which case phase 4 uses the cached factors.*/
+  std::shared_ptr<CellFactorCache> factor_cache_;
+  const CellFactorCache::CellEntry* cell_factor_entry_ = nullptr;
+
+  /**The time derivative term, if any, and the total cross sections of the
+   * current cell with the time absorption added, see CellSigmaTotal.*/
+  const TimeDerivativeTerm* time_derivative_ = nullptr;
+  std::vector<double> time_sigma_t_;
+
+  /**Group-innermost storage for the group-batched phase 4 kernel.*/
+  bool use_group_batched_solve_ = false;
+  std::vector<double> gb_atemp_;
+  std::vector<double> gb_rhs_;
+  std::vector<double> gb_source_;
+  std::vector<double> gb_scratch_;
+
   /**Callbacks at phase 5 : flux updates*/
   std::vector<CallbackFunction> flux_update_kernels_;
 
@@ -156,6 +224,33 @@ protected:
   /**Executes the supplied kernels list.*/
   static void ExecuteKernels(const std::vector<CallbackFunction>& kernels);
   virtual void OutgoingSurfaceOperations();
+  /**Returns the fixed-size kernel for the given cell sub-type and number
+   * of nodes, the small dense kernel for other small cells, or nullptr.*/
+  static FixedSizeKernel LookupFixedSizeKernel(chi_mesh::CellType cell_type,
+                                               size_t num_nodes);
+  /**Sets the face orientations and cached face mu values of the current
+   * cell.*/
+  void SetCellFaceData(const chi_mesh::sweep_management::AngleSet& angle_set);
+  /**Updates `face_mu_values_` for the current cell and direction.*/
+  void UpdateFaceMuValues(size_t as_ss_idx);
+  /**Evaluates the source moments of the current cell, if fused.*/
+  void EvaluateCellSource()
+  {
+    if (cell_source_function_) cell_source_function_(cell_local_id_);
+  }
+  /**Sets the fixed-size kernel and the factor cache entry of the current
+   * cell.*/
+  void SetCellFixedSizeKernel();
+  /**Returns true when the time derivative term is active.*/
+  bool TimeDerivativeActive() const
+  {
+    return time_derivative_ != nullptr and time_derivative_->IsActive();
+  }
+  const std::vector<double>& CellSigmaTotal();
+  void AddTimeDerivativeSource();
+  /**Assembles mass terms and solves the cell system for each group in
+   * the current group subset.*/
+  virtual void AssembleAndSolveGroups(const std::vector<double>& sigma_t);
 
   // kernels
 public: // public so that we can use bind
@@ -164,6 +259,11 @@ public: // public so that we can use bind
   void KernelFEMSTDMassTerms();
   void KernelPhiUpdate();
   void KernelPsiUpdate();
+  template <size_t N>
+  void KernelFixedSizeMassTermsAndSolve(const std::vector<double>& sigma_t);
+  void KernelSmallDenseMassTermsAndSolve(const std::vector<double>& sigma_t);
+  void KernelGroupBatchedMassTermsAndSolve(const std::vector<double>& sigma_t);
+  void KernelCachedFactorsMassTermsAndSolve(const std::vector<double>& sigma_t);
 
 private:
   std::map<std::string, CallbackFunction> kernels_;
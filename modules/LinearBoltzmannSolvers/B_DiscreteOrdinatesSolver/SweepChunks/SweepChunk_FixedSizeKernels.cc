@@ -0,0 +1,317 @@
+#include "SweepChunk.h"
+
+#include "A_LBSSolver/Groupset/lbs_groupset.h"
+
+#include "math/small_dense_matrix.h"
+
+#include <array>
+#include <map>
+
+namespace lbs
+{
+
+namespace
+{
+
+// ##################################################################
+/**Gauss elimination without pivoting for a compile-time sized system with
+ * row-major storage. The loop bounds are constant expressions which allows
+ * the compiler to fully unroll the elimination. The arithmetic is the same
+ * as chi_math::GaussElimination.*/
+template <size_t N>
+inline void GaussEliminationFixed(std::array<double, N * N>& A,
+                                  std::array<double, N>& b)
+{
+  // Forward elimination
+  for (size_t i = 0; i + 1 < N; ++i)
+  {
+    const double bi = b[i];
+    const double factor = 1.0 / A[i * N + i];
+    for (size_t j = i + 1; j < N; ++j)
+    {
+      const double val = A[j * N + i] * factor;
+      b[j] -= val * bi;
+      for (size_t k = i + 1; k < N; ++k)
+        A[j * N + k] -= val * A[i * N + k];
+    }
+  }
+
+  // Back substitution
+  for (size_t ii = N; ii > 0; --ii)
+  {
+    const size_t i = ii - 1;
+    double bi = b[i];
+    for (size_t j = i + 1; j < N; ++j)
+      bi -= A[i * N + j] * b[j];
+    b[i] = bi / A[i * N + i];
+  }
+}
+
+} // namespace
+
+// ##################################################################
+/**Equivalent of the FEMSSTDMassTerms kernel followed by the cell solve,
+ * for all the groups of the current subset, for a cell with `N` nodes. The
+ * direction's matrix and the mass matrix are copied once into stack
+ * storage.*/
+template <size_t N>
+void SweepChunk::KernelFixedSizeMassTermsAndSolve(
+  const std::vector<double>& sigma_t)
+{
+  const auto& M = M_;
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
+
+  std::array<double, N * N> Mf;
+  std::array<double, N * N> Af;
+  for (size_t i = 0; i < N; ++i)
+    for (size_t j = 0; j < N; ++j)
+    {
+      Mf[i * N + j] = M[i][j];
+      Af[i * N + j] = Amat_[i][j];
+    }
+
+  std::array<double, N> source;
+  std::array<double, N> b;
+  std::array<double, N * N> Atemp;
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const size_t g = gs_gi_ + gsg;
+    const double sigma_tg = sigma_t[g];
+
+    // ============================= Contribute source moments
+    // q = M_n^T * q_moms
+    for (size_t i = 0; i < N; ++i)
+    {
+      double temp_src = 0.0;
+      for (int m = 0; m < num_moments_; ++m)
+      {
+        const size_t ir = cell_transport_view_->MapDOF(i, m, g);
+        temp_src += m2d_op[m] * q_moments_[ir];
+      }
+      source[i] = temp_src;
+    }
+
+    // ============================= Mass Matrix and Source
+    // Atemp  = Amat + sigma_tgr * M
+    // b     += M * q
+    auto& b_g = b_[gsg];
+    for (size_t i = 0; i < N; ++i)
+    {
+      double temp = 0.0;
+      for (size_t j = 0; j < N; ++j)
+      {
+        const double Mij = Mf[i * N + j];
+        Atemp[i * N + j] = Af[i * N + j] + Mij * sigma_tg;
+        temp += Mij * source[j];
+      }
+      b[i] = b_g[i] + temp;
+    }
+
+    GaussEliminationFixed<N>(Atemp, b);
+
+    for (size_t i = 0; i < N; ++i)
+      b_g[i] = b[i];
+  } // for gsg
+}
+
+// ##################################################################
+/**Same as KernelFixedSizeMassTermsAndSolve for cells of runtime size, up
+ * to SMALL_DENSE_CAPACITY nodes, e.g., polygons and polyhedra. The storage
+ * is contiguous and on the stack, and the LU factors of the cell system
+ * are reused by consecutive groups with the same total cross section.*/
+void SweepChunk::KernelSmallDenseMassTermsAndSolve(
+  const std::vector<double>& sigma_t)
+{
+  typedef chi_math::SmallMatrix<SMALL_DENSE_CAPACITY> SmallMatrix;
+  typedef chi_math::SmallVector<SMALL_DENSE_CAPACITY> SmallVector;
+
+  const size_t n = cell_num_nodes_;
+  const auto& M = M_;
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
+
+  SmallMatrix Mf(n, n);
+  SmallMatrix Af(n, n);
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+    {
+      Mf(i, j) = M[i][j];
+      Af(i, j) = Amat_[i][j];
+    }
+
+  SmallVector source(n);
+  SmallVector b(n);
+  chi_math::SmallLU<SMALL_DENSE_CAPACITY> lu;
+  bool factored = false;
+  double factored_sigma_t = 0.0;
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const size_t g = gs_gi_ + gsg;
+    const double sigma_tg = sigma_t[g];
+
+    // ============================= Contribute source moments
+    // q = M_n^T * q_moms
+    for (size_t i = 0; i < n; ++i)
+    {
+      double temp_src = 0.0;
+      for (int m = 0; m < num_moments_; ++m)
+      {
+        const size_t ir = cell_transport_view_->MapDOF(i, m, g);
+        temp_src += m2d_op[m] * q_moments_[ir];
+      }
+      source[i] = temp_src;
+    }
+
+    // ============================= Mass Matrix and Source
+    // Atemp  = Amat + sigma_tgr * M
+    // b     += M * q
+    if (not factored or sigma_tg != factored_sigma_t)
+    {
+      lu.Matrix().Resize(n, n);
+      chi_math::MatAdd(Af, sigma_tg, Mf, lu.Matrix());
+      lu.FactorInPlace();
+      factored = true;
+      factored_sigma_t = sigma_tg;
+    }
+
+    auto& b_g = b_[gsg];
+    for (size_t i = 0; i < n; ++i)
+      b[i] = b_g[i];
+    chi_math::Gemv(1.0, Mf, source.Data(), 1.0, b.Data());
+
+    lu.Solve(b);
+
+    for (size_t i = 0; i < n; ++i)
+      b_g[i] = b[i];
+  } // for gsg
+}
+
+// ##################################################################
+/**Returns the fixed-size kernel for the given cell sub-type and number of
+ * nodes, the runtime-sized small dense kernel for other cells of at most
+ * SMALL_DENSE_CAPACITY nodes, or nullptr otherwise.*/
+SweepChunk::FixedSizeKernel
+SweepChunk::LookupFixedSizeKernel(const chi_mesh::CellType cell_type,
+                                  const size_t num_nodes)
+{
+  typedef chi_mesh::CellType CellType;
+  typedef std::pair<CellType, size_t> Key;
+  static const std::map<Key, FixedSizeKernel> dispatch_table = {
+    {{CellType::SLAB, 2}, &SweepChunk::KernelFixedSizeMassTermsAndSolve<2>},
+    {{CellType::QUADRILATERAL, 4},
+     &SweepChunk::KernelFixedSizeMassTermsAndSolve<4>},
+    {{CellType::TETRAHEDRON, 4},
+     &SweepChunk::KernelFixedSizeMassTermsAndSolve<4>},
+    {{CellType::HEXAHEDRON, 8},
+     &SweepChunk::KernelFixedSizeMassTermsAndSolve<8>}};
+
+  const auto it = dispatch_table.find({cell_type, num_nodes});
+  if (it == dispatch_table.end())
+    return num_nodes <= SMALL_DENSE_CAPACITY
+             ? &SweepChunk::KernelSmallDenseMassTermsAndSolve
+             : nullptr;
+
+  return it->second;
+}
+
+// ##################################################################
+/**Sets the fixed-size kernel for the current cell. Must be called after
+ * `cell_` and `cell_num_nodes_` have been set.*/
+void SweepChunk::SetCellFixedSizeKernel()
+{
+  fixed_size_kernel_ =
+    use_fixed_size_kernels_
+      ? LookupFixedSizeKernel(cell_->SubType(), cell_num_nodes_)
+      : nullptr;
+
+  // The cached factors are those of the cross sections without the time
+  // absorption of the time derivative term
+  cell_factor_entry_ =
+    (use_fixed_size_kernels_ and factor_cache_ and not TimeDerivativeActive())
+      ? factor_cache_->GetCellEntry(cell_local_id_, cell_transport_view_->XS())
+      : nullptr;
+}
+
+// ##################################################################
+/**Sets the cache of cell system factors.*/
+void SweepChunk::SetCellFactorCache(
+  std::shared_ptr<CellFactorCache> factor_cache)
+{
+  factor_cache_ = std::move(factor_cache);
+}
+
+// ##################################################################
+/**Same as KernelSmallDenseMassTermsAndSolve for a cell in the factor
+ * cache. The factors of the cell system of each group are taken from the
+ * cache, or computed and stored on first use, hence only the forward and
+ * back substitutions remain in later sweeps.*/
+void SweepChunk::KernelCachedFactorsMassTermsAndSolve(
+  const std::vector<double>& sigma_t)
+{
+  const size_t n = cell_num_nodes_;
+  const auto& M = M_;
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
+
+  std::array<double, SMALL_DENSE_CAPACITY> source;
+  std::array<double, SMALL_DENSE_CAPACITY> b;
+  std::array<double, SMALL_DENSE_CAPACITY * SMALL_DENSE_CAPACITY> local_lu;
+  for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
+  {
+    const size_t g = gs_gi_ + gsg;
+    const size_t group_index = gs_ss_begin_ + gsg;
+
+    // ============================= Contribute source moments
+    // q = M_n^T * q_moms
+    for (size_t i = 0; i < n; ++i)
+    {
+      double temp_src = 0.0;
+      for (int m = 0; m < num_moments_; ++m)
+      {
+        const size_t ir = cell_transport_view_->MapDOF(i, m, g);
+        temp_src += m2d_op[m] * q_moments_[ir];
+      }
+      source[i] = temp_src;
+    }
+
+    // ============================= Source
+    // b += M * q
+    auto& b_g = b_[gsg];
+    for (size_t i = 0; i < n; ++i)
+    {
+      double temp = 0.0;
+      for (size_t j = 0; j < n; ++j)
+        temp += M[i][j] * source[j];
+      b[i] = b_g[i] + temp;
+    }
+
+    // ============================= Factors of Amat + sigma_tgr * M
+    const double* lu = factor_cache_->Factors(
+      *cell_factor_entry_, direction_num_, group_index);
+    if (lu == nullptr)
+    {
+      double* fill = factor_cache_->BeginFill(
+        *cell_factor_entry_, direction_num_, group_index);
+      double* A = (fill != nullptr) ? fill : local_lu.data();
+
+      const double sigma_tg = sigma_t[g];
+      for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+          A[i * n + j] = Amat_[i][j] + M[i][j] * sigma_tg;
+      CellFactorCache::Factor(A, n);
+
+      if (fill != nullptr)
+        factor_cache_->EndFill(
+          *cell_factor_entry_, direction_num_, group_index);
+      lu = A;
+    }
+
+    CellFactorCache::Solve(lu, n, b.data());
+
+    for (size_t i = 0; i < n; ++i)
+      b_g[i] = b[i];
+  } // for gsg
+}
+
+} // namespace lbs
@@ -0,0 +1,102 @@
+#include "SweepChunk.h"
+
+#include "A_LBSSolver/Groupset/lbs_groupset.h"
+#include "math/chi_math.h"
+
+namespace lbs
+{
+
+// ##################################################################
+/**Enables solving all the groups of a group subset simultaneously.*/
+void SweepChunk::SetGroupBatchedSolve(bool flag)
+{
+  use_group_batched_solve_ = flag;
+  if (not flag) return;
+
+  const size_t max_dofs = Amat_.size();
+  const size_t num_groups = groupset_.groups_.size();
+
+  gb_atemp_.assign(max_dofs * max_dofs * num_groups, 0.0);
+  gb_rhs_.assign(max_dofs * num_groups, 0.0);
+  gb_source_.assign(max_dofs * num_groups, 0.0);
+  gb_scratch_.assign(num_groups, 0.0);
+}
+
+// ##################################################################
+/**Equivalent of the FEMSSTDMassTerms kernel followed by the cell solve for
+ * every group in the current subset. Since the systems differ only by the
+ * scalar total cross section, the groups are assembled and eliminated
+ * together in group-innermost storage with the group index as the vector
+ * lane. The arithmetic per group is identical to the group-by-group
+ * path.*/
+void SweepChunk::KernelGroupBatchedMassTermsAndSolve(
+  const std::vector<double>& sigma_t)
+{
+  const auto& M = M_;
+  const double* m2d_op =
+    groupset_.quadrature_->GetMomentToDiscreteDirection(direction_num_);
+
+  const size_t n = cell_num_nodes_;
+  const size_t G = gs_ss_size_;
+  const double* sigma_tg = &sigma_t[gs_gi_];
+  const double* q_moments = q_moments_.data();
+  double* scratch = gb_scratch_.data();
+
+  // ============================= Contribute source moments
+  // q = M_n^T * q_moms
+  for (size_t i = 0; i < n; ++i)
+  {
+    double* src_i = &gb_source_[i * G];
+    for (size_t gsg = 0; gsg < G; ++gsg)
+      src_i[gsg] = 0.0;
+
+    for (int m = 0; m < num_moments_; ++m)
+    {
+      const double m2d = m2d_op[m];
+      const double* q_m = &q_moments[cell_transport_view_->MapDOF(i, m, gs_gi_)];
+#pragma omp simd
+      for (size_t gsg = 0; gsg < G; ++gsg)
+        src_i[gsg] += m2d * q_m[gsg];
+    }
+  }
+
+  // ============================= Mass Matrix and Source
+  // Atemp  = Amat + sigma_tgr * M
+  // b     += M * q
+  for (size_t i = 0; i < n; ++i)
+  {
+    for (size_t gsg = 0; gsg < G; ++gsg)
+      scratch[gsg] = 0.0;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+      const double Aij = Amat_[i][j];
+      const double Mij = M[i][j];
+      double* T_ij = &gb_atemp_[(i * n + j) * G];
+      const double* src_j = &gb_source_[j * G];
+#pragma omp simd
+      for (size_t gsg = 0; gsg < G; ++gsg)
+      {
+        T_ij[gsg] = Aij + Mij * sigma_tg[gsg];
+        scratch[gsg] += Mij * src_j[gsg];
+      }
+    }
+
+    double* b_i = &gb_rhs_[i * G];
+    for (size_t gsg = 0; gsg < G; ++gsg)
+      b_i[gsg] = b_[gsg][i] + scratch[gsg];
+  }
+
+  // ============================= Solve all groups
+  chi_math::GaussEliminationBatched(gb_atemp_.data(),
+                                    gb_rhs_.data(),
+                                    scratch,
+                                    static_cast<int>(n),
+                                    static_cast<int>(G));
+
+  for (size_t i = 0; i < n; ++i)
+    for (size_t gsg = 0; gsg < G; ++gsg)
+      b_[gsg][i] = gb_rhs_[i * G + gsg];
+}
+
+} // namespace lbs
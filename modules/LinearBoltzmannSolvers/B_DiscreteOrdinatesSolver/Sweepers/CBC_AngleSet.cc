@@ -9,9 +9,30 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace lbs
 {
 
+namespace
+{
+int CurrentThreadID()
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
 CBC_AngleSet::CBC_AngleSet(
   size_t id,
   size_t num_groups,
@@ -42,7 +63,7 @@ CBC_AngleSet::GetCommunicator()
 
 chi_mesh::sweep_management::AngleSetStatus CBC_AngleSet::AngleSetAdvance(
   chi_mesh::sweep_management::SweepChunk& sweep_chunk,
-  const std::vector<size_t>& timing_tags,
+  chi::RunningStatistics& chunk_timing,
   chi_mesh::sweep_management::ExecutionPermission permission)
 {
   typedef chi_mesh::sweep_management::AngleSetStatus Status;
@@ -51,66 +72,65 @@ chi_mesh::sweep_management::AngleSetStatus CBC_AngleSet::AngleSetAdvance(
 
 
   if (current_task_list_.empty())
+  {
     current_task_list_ = cbc_spds_.TaskList();
+    ready_tasks_.clear();
+    num_tasks_completed_ = 0;
+    for (const auto& cell_task : current_task_list_)
+      if (cell_task.num_dependencies_ == 0)
+        ready_tasks_.push_back(cell_task.reference_id_);
+  }
 
   sweep_chunk.SetAngleSet(*this);
 
-  auto tasks_who_received_data = async_comm_.ReceiveData();
+  using chi_mesh::sweep_management::ScopedSweepTimer;
+  using chi_mesh::sweep_management::SweepStatistics;
+  {
+    const ScopedSweepTimer timer(
+      StatisticsTime(&SweepStatistics::receive_time));
+    auto tasks_who_received_data = async_comm_.ReceiveData();
 
-  for (const uint64_t task_number : tasks_who_received_data)
-    --current_task_list_[task_number].num_dependencies_;
+    for (const uint64_t task_number : tasks_who_received_data)
+      if (--current_task_list_[task_number].num_dependencies_ == 0)
+        ready_tasks_.push_back(task_number);
+  }
 
-  async_comm_.SendData();
+  {
+    const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::send_time));
+    async_comm_.SendData();
+  }
 
   // Check if boundaries allow for execution
   for (auto& [bid, bndry] : ref_boundaries_)
     if (not bndry->CheckAnglesReadyStatus(angles_, ref_group_subset_))
+    {
+      if (sweep_statistics_) sweep_statistics_->boundary_blocked_in_pass = true;
       return Status::NOT_FINISHED;
+    }
 
-  bool all_tasks_completed = true;
-  bool a_task_executed = true;
-  while (a_task_executed)
-  {
-    a_task_executed = false;
-    for (auto& cell_task : current_task_list_)
-    {
-      if (not cell_task.completed_) all_tasks_completed = false;
-      if (cell_task.num_dependencies_ == 0 and not cell_task.completed_)
-      {
-        Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_BEGIN);
-        sweep_chunk.SetCell(cell_task.cell_ptr_, *this);
-        sweep_chunk.Sweep(*this);
+  // Without ready tasks the angle set waits on upstream data
+  if (sweep_statistics_ and ready_tasks_.empty() and
+      num_tasks_completed_ < current_task_list_.size())
+    sweep_statistics_->upstream_blocked_in_pass = true;
 
-        for (uint64_t local_task_num : cell_task.successors_)
-          --current_task_list_[local_task_num].num_dependencies_;
-        Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_END);
+  if (not ready_tasks_.empty())
+  {
+    ChiProfileTaggedRegion("Angle set", id_);
+    ChiProfileRegion("Sweep chunk");
+    const double chunk_start_time = MPI_Wtime();
+    if (worker_chunks_.empty()) ExecuteReadyTasks(sweep_chunk);
+    else
+      ExecuteReadyTasksThreaded(sweep_chunk);
+    chunk_timing.Add(MPI_Wtime() - chunk_start_time);
+  }
 
-        cell_task.completed_ = true;
-        a_task_executed = true;
-        async_comm_.SendData();
-      }
-    } // for cell_task
-    async_comm_.SendData();
+  const bool all_tasks_completed =
+    num_tasks_completed_ == current_task_list_.size();
+  bool all_messages_sent = false;
+  {
+    const ScopedSweepTimer timer(StatisticsTime(&SweepStatistics::send_time));
+    all_messages_sent = async_comm_.SendData();
   }
-  //for (auto& cell_task : current_task_list_)
-  //{
-  //  if (not cell_task.completed_) all_tasks_completed = false;
-  //  if (cell_task.num_dependencies_ == 0 and not cell_task.completed_)
-  //  {
-  //    Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_BEGIN);
-  //    sweep_chunk.SetCell(cell_task.cell_ptr_, *this);
-  //    sweep_chunk.Sweep(*this);
-  //
-  //    for (uint64_t local_task_num : cell_task.successors_)
-  //      --current_task_list_[local_task_num].num_dependencies_;
-  //    Chi::log.LogEvent(timing_tags[0], chi::ChiLog::EventType::EVENT_END);
-  //
-  //    cell_task.completed_ = true;
-  //    async_comm_.SendData();
-  //  }
-  //} // for cell_task
-
-  const bool all_messages_sent = async_comm_.SendData();
 
   if (all_tasks_completed and all_messages_sent)
   {
@@ -124,16 +144,165 @@ chi_mesh::sweep_management::AngleSetStatus CBC_AngleSet::AngleSetAdvance(
   return Status::NOT_FINISHED;
 }
 
+// ###################################################################
+/**Executes ready cell tasks until none remain. Successors whose
+ * dependencies become satisfied are pushed onto the ready list, making
+ * the cost proportional to the number of tasks rather than repeatedly
+ * rescanning the entire task list.*/
+void CBC_AngleSet::ExecuteReadyTasks(
+  chi_mesh::sweep_management::SweepChunk& sweep_chunk)
+{
+  while (not ready_tasks_.empty())
+  {
+    const uint64_t task_number = ready_tasks_.back();
+    ready_tasks_.pop_back();
+    auto& cell_task = current_task_list_[task_number];
+
+    sweep_chunk.SetCell(cell_task.cell_ptr_, *this);
+    sweep_chunk.Sweep(*this);
+
+    for (uint64_t local_task_num : cell_task.successors_)
+      if (--current_task_list_[local_task_num].num_dependencies_ == 0)
+        ready_tasks_.push_back(local_task_num);
+
+    cell_task.completed_ = true;
+    ++num_tasks_completed_;
+    async_comm_.SendData();
+  } // while ready tasks
+}
+
+// ###################################################################
+/**Executes ready cell tasks concurrently using the primary sweep chunk on
+ * thread 0 and the worker chunks on the remaining threads. Each thread owns
+ * a task deque. A thread pushes and pops newly readied tasks at the back
+ * of its own deque and, when it runs dry, steals from the front of the
+ * others. Message sends are deferred to the calling thread.*/
+void CBC_AngleSet::ExecuteReadyTasksThreaded(
+  chi_mesh::sweep_management::SweepChunk& sweep_chunk)
+{
+  if (ready_tasks_.empty()) return;
+
+  struct TaskDeque
+  {
+    std::mutex mutex;
+    std::deque<uint64_t> tasks;
+  };
+
+  const int num_threads = static_cast<int>(worker_chunks_.size()) + 1;
+  std::vector<TaskDeque> task_deques(num_threads);
+
+  for (size_t t = 0; t < ready_tasks_.size(); ++t)
+    task_deques[t % num_threads].tasks.push_back(ready_tasks_[t]);
+  std::atomic<size_t> num_pending_tasks(ready_tasks_.size());
+  std::atomic<size_t> num_executed_tasks(0);
+  ready_tasks_.clear();
+
+  for (auto& worker_chunk : worker_chunks_)
+    worker_chunk->SetAngleSet(*this);
+
+  auto PopOrSteal = [&task_deques, num_threads](int thread_id,
+                                                uint64_t& task_number)
+  {
+    {
+      auto& own = task_deques[thread_id];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (not own.tasks.empty())
+      {
+        task_number = own.tasks.back();
+        own.tasks.pop_back();
+        return true;
+      }
+    }
+    for (int k = 1; k < num_threads; ++k)
+    {
+      auto& victim = task_deques[(thread_id + k) % num_threads];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (not victim.tasks.empty())
+      {
+        task_number = victim.tasks.front();
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  };
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    const int thread_id = CurrentThreadID();
+    auto& chunk =
+      (thread_id == 0) ? sweep_chunk : *worker_chunks_[thread_id - 1];
+
+    uint64_t task_number;
+    while (num_pending_tasks.load() > 0)
+    {
+      if (not PopOrSteal(thread_id, task_number))
+      {
+        std::this_thread::yield();
+        continue;
+      }
+
+      auto& cell_task = current_task_list_[task_number];
+      chunk.SetCell(cell_task.cell_ptr_, *this);
+      chunk.Sweep(*this);
+
+      for (uint64_t local_task_num : cell_task.successors_)
+      {
+        unsigned int remaining_dependencies;
+#pragma omp atomic capture
+        remaining_dependencies =
+          --current_task_list_[local_task_num].num_dependencies_;
+
+        if (remaining_dependencies == 0)
+        {
+          ++num_pending_tasks;
+          auto& own = task_deques[thread_id];
+          std::lock_guard<std::mutex> lock(own.mutex);
+          own.tasks.push_back(local_task_num);
+        }
+      }
+
+      cell_task.completed_ = true;
+      ++num_executed_tasks;
+      --num_pending_tasks;
+    } // while pending tasks
+  } // omp parallel
+
+  num_tasks_completed_ += num_executed_tasks.load();
+  async_comm_.SendData();
+}
+
 // ###################################################################
 /**Resets the sweep buffer.*/
 void CBC_AngleSet::ResetSweepBuffers()
 {
   current_task_list_.clear();
+  ready_tasks_.clear();
+  num_tasks_completed_ = 0;
   async_comm_.Reset();
   fluds_->ClearLocalAndReceivePsi();
   executed_ = false;
 }
 
+// ###################################################################
+/**Sets the statistics of the angle set and of its communicator.*/
+void CBC_AngleSet::SetSweepStatistics(
+  chi_mesh::sweep_management::SweepStatistics* sweep_statistics)
+{
+  AngleSet::SetSweepStatistics(sweep_statistics);
+  async_comm_.SetSweepStatistics(sweep_statistics);
+}
+
+// ###################################################################
+/**Stores the worker sweep chunks used to execute cell tasks
+ * concurrently.*/
+void CBC_AngleSet::SetWorkerSweepChunks(
+  const std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>&
+    worker_chunks)
+{
+  worker_chunks_ = worker_chunks;
+}
+
 // ###################################################################
 /**Returns a pointer to a boundary flux data.*/
 const double* CBC_AngleSet::PsiBndry(uint64_t bndry_map,
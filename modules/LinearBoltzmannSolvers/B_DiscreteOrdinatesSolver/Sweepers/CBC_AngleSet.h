@@ -30,18 +30,25 @@ public:
 
   chi_mesh::sweep_management::AngleSetStatus AngleSetAdvance(
     chi_mesh::sweep_management::SweepChunk& sweep_chunk,
-    const std::vector<size_t>& timing_tags,
+    chi::RunningStatistics& chunk_timing,
     chi_mesh::sweep_management::ExecutionPermission permission) override;
 
   chi_mesh::sweep_management::AngleSetStatus FlushSendBuffers() override
   {
+    const chi_mesh::sweep_management::ScopedSweepTimer timer(
+      StatisticsTime(&chi_mesh::sweep_management::SweepStatistics::send_time));
     const bool all_messages_sent = async_comm_.SendData();
     return all_messages_sent
              ? chi_mesh::sweep_management::AngleSetStatus::MESSAGES_SENT
              : chi_mesh::sweep_management::AngleSetStatus::MESSAGES_PENDING;
   }
   void ResetSweepBuffers() override;
+  void SetWorkerSweepChunks(
+    const std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>&
+      worker_chunks) override;
   bool ReceiveDelayedData() override { return true; }
+  void SetSweepStatistics(
+    chi_mesh::sweep_management::SweepStatistics* sweep_statistics) override;
   const double* PsiBndry(uint64_t bndry_map,
                          unsigned int angle_num,
                          uint64_t cell_local_id,
@@ -58,8 +65,18 @@ public:
                                      size_t gs_ss_begin) override;
 
 protected:
+  void ExecuteReadyTasks(chi_mesh::sweep_management::SweepChunk& sweep_chunk);
+  void ExecuteReadyTasksThreaded(
+    chi_mesh::sweep_management::SweepChunk& sweep_chunk);
+
   const CBC_SPDS& cbc_spds_;
   std::vector<chi_mesh::sweep_management::Task> current_task_list_;
+  /**Tasks whose dependencies are all satisfied but that have not been
+   * executed yet.*/
+  std::vector<uint64_t> ready_tasks_;
+  size_t num_tasks_completed_ = 0;
+  std::vector<std::shared_ptr<chi_mesh::sweep_management::SweepChunk>>
+    worker_chunks_;
   CBC_ASynchronousCommunicator async_comm_;
 };
 
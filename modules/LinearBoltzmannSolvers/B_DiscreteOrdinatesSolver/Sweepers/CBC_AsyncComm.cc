@@ -4,6 +4,7 @@
 
 #include "mesh/SweepUtilities/FLUDS/FLUDS.h"
 #include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/SweepScheduler/sweep_statistics.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 #include "CBC_FLUDS.h"
 
@@ -34,6 +35,7 @@ std::vector<double>& CBC_ASynchronousCommunicator::InitGetDownwindMessageData(
 {
   MessageKey key{location_id, cell_global_id, face_id};
 
+  std::lock_guard<std::mutex> lock(outgoing_queue_mutex_);
   std::vector<double>& data = outgoing_message_queue_[key];
   if (data.empty())
     data.assign(data_size, 0.0);
@@ -94,6 +96,9 @@ bool CBC_ASynchronousCommunicator::SendData()
                   comm_set_.LocICommunicator(locJ), // comm
                   &buffer_item.mpi_request_));      // request
       buffer_item.send_initiated_ = true;
+
+      if (sweep_statistics_)
+        sweep_statistics_->CountSentMessage(buffer_item.data_array_.Size());
     }
 
     if (not buffer_item.completed_)
@@ -142,6 +147,10 @@ std::vector<uint64_t> CBC_ASynchronousCommunicator::ReceiveData()
                  comm_set_.LocICommunicator(Chi::mpi.location_id), // comm
                  MPI_STATUS_IGNORE));                              // status
 
+      if (sweep_statistics_)
+        sweep_statistics_->CountReceivedMessage(
+          static_cast<size_t>(num_items));
+
       chi_data_types::ByteArray data_array(recv_buffer);
 
       while (not data_array.EndOfBuffer())
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include "mesh/SweepUtilities/Communicators/AsyncComm.h"
@@ -59,6 +60,9 @@ protected:
   const size_t angle_set_id_;
   CBC_FLUDS& cbc_fluds_;
   std::map<MessageKey, std::vector<double>> outgoing_message_queue_;
+  /**Guards insertions into the outgoing queue when cell tasks are executed
+   * by multiple threads.*/
+  std::mutex outgoing_queue_mutex_;
 
   struct BufferItem
   {
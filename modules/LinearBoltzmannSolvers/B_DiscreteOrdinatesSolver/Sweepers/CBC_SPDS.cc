@@ -8,6 +8,7 @@
 
 #include "graphs/chi_directed_graph.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_arena.h"
 
 namespace lbs
 {
@@ -26,7 +27,8 @@ CBC_SPDS::CBC_SPDS(const chi_mesh::Vector3& omega,
 
   //============================================= Populate Cell Relationships
   Chi::log.Log0Verbose1() << "Populating cell relationships";
-  std::vector<std::set<std::pair<int, double>>> cell_successors(num_loc_cells);
+  chi::TransientArena arena;
+  CellSuccessors cell_successors(num_loc_cells, arena.Resource());
   std::set<int> location_successors;
   std::set<int> location_dependencies;
 
@@ -130,9 +132,9 @@ CBC_SPDS::CBC_SPDS(const chi_mesh::Vector3& omega,
       }
       else if (cell_face_orientations_[cell.local_id_][f] == OUTGOING)
       {
-        const auto& face = cell.faces_[f];
-        if (face.has_neighbor_ and grid.IsCellLocal(face.neighbor_id_))
-          succesors.push_back(grid.cells[face.neighbor_id_].local_id_);
+        const auto& neighbor = grid.GetFaceNeighborIndex(cell, f);
+        if (neighbor.local_id >= 0)
+          succesors.push_back(neighbor.local_id);
       }
 
     task_list_.push_back({num_dependencies,
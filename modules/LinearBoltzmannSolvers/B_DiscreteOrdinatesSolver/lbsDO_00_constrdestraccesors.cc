@@ -1,5 +1,7 @@
 #include "lbs_discrete_ordinates_solver.h"
 
+#include "mesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+
 #include "ChiObjectFactory.h"
 
 namespace lbs
@@ -28,11 +30,171 @@ chi::InputParameters lbs::DiscreteOrdinatesSolver::GetInputParameters()
     "List of direction id's for which sweep ordering info is to be printed.");
 
   params.AddOptionalParameter(
-    "sweep_type", "AAH", "The sweep type to use for sweep operatorations.");
+    "sweep_type",
+    "AAH",
+    "The sweep type to use for sweep operatorations. \"AUTO\" selects "
+    "\"AAH\" or \"CBC\" for all the groupsets from the estimated sweep "
+    "times of both, based on the analytics of the sweep orderings, and "
+    "logs the estimates.");
+
+  params.AddOptionalParameter(
+    "sweep_chunk_mode",
+    "DEFAULT",
+    "The sweep chunk implementation to use. \"DEFAULT\" solves each "
+    "direction and group separately. \"ANGLE_BATCHED\" (AAH only) assembles "
+    "and solves all the directions of an angle set together, cell-by-cell. "
+    "\"GROUP_BATCHED\" solves all the groups of a group subset together for "
+    "each direction. \"LEVEL_BATCHED\" (AAH only) levelizes the sweep "
+    "orderings and sweeps the cells of each level, i.e., of each wavefront, "
+    "concurrently with sweep_num_threads threads instead of executing angle "
+    "sets concurrently. \"LEVEL_ANGLE_BATCHED\" (AAH only) does the same "
+    "with the cells solved as with \"ANGLE_BATCHED\". "
+    "\"DIAMOND_DIFFERENCE\" (AAH only) requires an orthogonal mesh and "
+    "solves the diamond-difference equations for the cell-average angular "
+    "fluxes instead of the PWLD cell systems, the nodes of a cell all "
+    "getting its cell-average value.");
+
+  params.AddOptionalParameter(
+    "sweep_face_cache",
+    false,
+    "Flag, when set, precomputes the face mu values and face orientations of "
+    "every (cell, face, direction) in flat arrays per angle set, instead "
+    "of recomputing them during every sweep.");
+
+  params.AddOptionalParameter(
+    "sweep_face_cache_max_mb",
+    1024.0,
+    "Per-process memory budget, in MB, for the face cache of a groupset. If "
+    "the cache would exceed this limit it is not built.");
+
+  params.AddOptionalParameter(
+    "ags_pipelined_sweeps",
+    false,
+    "Flag, when set, replaces the default across-groupset scheme with one "
+    "that sweeps all the groupsets concurrently, each iteration using the "
+    "previous iterate for the across-groupset sources. The sweep of one "
+    "groupset then overlaps the pipeline fill and drain of the others. "
+    "Requires all groupsets to use richardson without DSA and no "
+    "reflecting boundaries, otherwise the default scheme is used.");
+
+  params.AddOptionalParameter(
+    "sweep_scheduling",
+    "DEFAULT",
+    "The order in which ready angle sets are executed on each location. "
+    "\"DEFAULT\" uses \"DEPTH_OF_GRAPH\" for AAH sweeps and "
+    "\"FIRST_IN_FIRST_OUT\" for CBC sweeps. \"DEPTH_OF_GRAPH\" prioritizes "
+    "the angle sets for which the location is farthest, in sweep planes, from "
+    "the end of the sweep. \"B_LEVEL\" (AAH only) prioritizes the longest "
+    "remaining critical path through the task dependency graph, weighted by "
+    "the number of cells per location. \"FARTHEST_FIRST\" (AAH only) "
+    "prioritizes the largest remaining distance, along the direction, to the "
+    "most downstream location.");
+
+  params.AddOptionalParameter(
+    "sweep_local_cycle_iterations",
+    0,
+    "Number of inner iterations performed, during each AAH sweep, on the "
+    "local cells that form cyclic dependencies (e.g. on curved or twisted "
+    "meshes), before the final pass that updates the fluxes. Each iteration "
+    "re-sweeps the cells of the cycle using the latest cyclic angular "
+    "fluxes, which reduces the number of outer iterations needed to converge "
+    "them. Zero lags the cyclic angular fluxes to the next sweep. Only "
+    "applies to the DEFAULT and GROUP_BATCHED sweep chunk modes.");
+
+  params.AddOptionalParameter(
+    "sweep_data_cache",
+    true,
+    "Flag, when set, shares the sweep orderings (SPDS) and FLUDS common data "
+    "with the other solvers and groupsets, created on the same grid, that "
+    "use the same quadrature, angle aggregation type and cycles option, "
+    "instead of rebuilding them.");
+
+  params.AddOptionalParameter(
+    "sweep_ordering_report",
+    false,
+    "Flag, when set, logs a report of every sweep ordering during "
+    "initialization: the local sweep depths and level widths, the stages "
+    "and critical path through the location dependency graph, the delayed "
+    "dependencies and the messages per location pair, with their volume.");
+
+  params.AddOptionalParameter(
+    "reflecting_bc_lagging",
+    "AUTO",
+    "Whether the reflecting boundaries use the angular fluxes of the "
+    "previous iteration instead of blocking angle sets until the reflected "
+    "angles are swept, which serializes the sweeps. The opposing one of two "
+    "parallel reflecting boundaries is always lagged. \"NONE\" lags no "
+    "other boundary, \"ALL\" lags all of them, and \"AUTO\" lags them if "
+    "every groupset uses a Krylov method other than richardson and a trial "
+    "sweep spends more than a tenth of its time stalled on the reflecting "
+    "boundaries.");
+
+  params.AddOptionalParameter(
+    "sweep_block_jacobi",
+    false,
+    "Flag, when set, sweeps in parallel block-Jacobi mode (AAH only): every "
+    "location sweeps its cells with the incoming partition-boundary angular "
+    "fluxes of the previous iteration, which are exchanged with the "
+    "neighboring locations once per iteration, instead of waiting for its "
+    "upstream locations. This removes the pipeline fill of the sweeps, at "
+    "the cost of more iterations. The lagged angular fluxes are delayed "
+    "unknowns of the within-groupset Krylov solvers, which limits the "
+    "additional iterations, and DSA is unaffected.");
+
+  params.AddOptionalParameter(
+    "sweep_lu_cache",
+    false,
+    "Flag, when set, caches the LU factors of the cell systems of the "
+    "within-groupset sweeps, per cell, direction and distinct total cross "
+    "section of the groupset groups, for cells with up to 32 nodes. The "
+    "factors are computed during the first sweep, after which the sweeps "
+    "only perform the forward and back substitutions. Cells whose cross "
+    "sections are modified are refactored.");
+
+  params.AddOptionalParameter(
+    "sweep_lu_cache_max_mb",
+    1024.0,
+    "Per-process memory budget, in MB, for the LU cache of a groupset. "
+    "Cells are cached in local order until the budget is used.");
+
+  params.AddOptionalParameter(
+    "fused_source_evaluation",
+    false,
+    "Flag, when set, evaluates the source moments swept by the "
+    "within-groupset solvers inside the sweeps instead of in a separate pass "
+    "over the domain: the sweep chunk evaluates the scattering, fission and "
+    "fixed source moments of a cell on its first visit in a sweep, while its "
+    "flux moments are in cache, and the remaining angle sets read them back "
+    "from the source moments vector.");
 
   using namespace chi_data_types;
   params.ConstrainParameterRange("sweep_type",
-                                 AllowableRangeList::New({"AAH", "CBC"}));
+                                 AllowableRangeList::New({"AAH", "CBC", "AUTO"}));
+  params.ConstrainParameterRange(
+    "sweep_chunk_mode",
+    AllowableRangeList::New(
+      {"DEFAULT",
+       "ANGLE_BATCHED",
+       "GROUP_BATCHED",
+       "LEVEL_BATCHED",
+       "LEVEL_ANGLE_BATCHED",
+       "DIAMOND_DIFFERENCE"}));
+  params.ConstrainParameterRange(
+    "sweep_scheduling",
+    AllowableRangeList::New({"DEFAULT",
+                             "FIRST_IN_FIRST_OUT",
+                             "DEPTH_OF_GRAPH",
+                             "B_LEVEL",
+                             "FARTHEST_FIRST"}));
+  params.ConstrainParameterRange(
+    "reflecting_bc_lagging",
+    AllowableRangeList::New({"NONE", "ALL", "AUTO"}));
+  params.ConstrainParameterRange("sweep_local_cycle_iterations",
+                                 AllowableRangeLowLimit::New(0));
+  params.ConstrainParameterRange("sweep_face_cache_max_mb",
+                                 AllowableRangeLowLimit::New(0.0));
+  params.ConstrainParameterRange("sweep_lu_cache_max_mb",
+                                 AllowableRangeLowLimit::New(0.0));
 
   return params;
 }
@@ -43,8 +205,74 @@ lbs::DiscreteOrdinatesSolver::DiscreteOrdinatesSolver(
   : LBSSolver(params),
     verbose_sweep_angles_(
       params.GetParamVectorValue<size_t>("directions_sweep_order_to_print")),
-    sweep_type_(params.GetParamValue<std::string>("sweep_type"))
+    sweep_type_(params.GetParamValue<std::string>("sweep_type")),
+    sweep_chunk_mode_(params.GetParamValue<std::string>("sweep_chunk_mode")),
+    sweep_face_cache_(params.GetParamValue<bool>("sweep_face_cache")),
+    sweep_face_cache_max_mb_(
+      params.GetParamValue<double>("sweep_face_cache_max_mb")),
+    ags_pipelined_sweeps_(params.GetParamValue<bool>("ags_pipelined_sweeps")),
+    sweep_scheduling_(params.GetParamValue<std::string>("sweep_scheduling")),
+    sweep_local_cycle_iterations_(
+      params.GetParamValue<int>("sweep_local_cycle_iterations")),
+    sweep_data_cache_(params.GetParamValue<bool>("sweep_data_cache")),
+    sweep_ordering_report_(params.GetParamValue<bool>("sweep_ordering_report")),
+    reflecting_bc_lagging_(
+      params.GetParamValue<std::string>("reflecting_bc_lagging")),
+    sweep_block_jacobi_(params.GetParamValue<bool>("sweep_block_jacobi")),
+    fused_source_evaluation_(
+      params.GetParamValue<bool>("fused_source_evaluation")),
+    sweep_lu_cache_(params.GetParamValue<bool>("sweep_lu_cache")),
+    sweep_lu_cache_max_mb_(
+      params.GetParamValue<double>("sweep_lu_cache_max_mb"))
 {
+  ChiInvalidArgumentIf(sweep_type_ == "CBC" and
+                         sweep_scheduling_ != "DEFAULT" and
+                         sweep_scheduling_ != "FIRST_IN_FIRST_OUT",
+                       "Priority based sweep scheduling requires sweep_type "
+                       "\"AAH\".");
+  ChiInvalidArgumentIf(LevelizedSweeps() and sweep_type_ == "CBC",
+                       "Level batched sweep chunk modes require sweep_type "
+                       "\"AAH\".");
+  ChiInvalidArgumentIf(sweep_chunk_mode_ == "ANGLE_BATCHED" and
+                         sweep_type_ == "CBC",
+                       "Sweep chunk mode \"ANGLE_BATCHED\" requires "
+                       "sweep_type \"AAH\".");
+  ChiInvalidArgumentIf(sweep_chunk_mode_ == "DIAMOND_DIFFERENCE" and
+                         sweep_type_ == "CBC",
+                       "Sweep chunk mode \"DIAMOND_DIFFERENCE\" requires "
+                       "sweep_type \"AAH\".");
+  ChiInvalidArgumentIf(sweep_block_jacobi_ and sweep_type_ == "CBC",
+                       "Block-Jacobi sweeps require sweep_type \"AAH\".");
+  ChiInvalidArgumentIf(LevelizedSweeps() and
+                         sweep_local_cycle_iterations_ > 0,
+                       "Level batched sweep chunk modes do not support "
+                       "sweep_local_cycle_iterations.");
+}
+
+/**Returns true if the sweep chunk mode sweeps by levels, in which case the
+ * sweep orderings are levelized.*/
+bool lbs::DiscreteOrdinatesSolver::LevelizedSweeps() const
+{
+  return sweep_chunk_mode_ == "LEVEL_BATCHED" or
+         sweep_chunk_mode_ == "LEVEL_ANGLE_BATCHED";
+}
+
+/**Returns the scheduling algorithm to be used by the sweep schedulers.*/
+chi_mesh::sweep_management::SchedulingAlgorithm
+lbs::DiscreteOrdinatesSolver::SweepSchedulingAlgorithm() const
+{
+  using chi_mesh::sweep_management::SchedulingAlgorithm;
+
+  if (sweep_scheduling_ == "FIRST_IN_FIRST_OUT")
+    return SchedulingAlgorithm::FIRST_IN_FIRST_OUT;
+  if (sweep_scheduling_ == "DEPTH_OF_GRAPH")
+    return SchedulingAlgorithm::DEPTH_OF_GRAPH;
+  if (sweep_scheduling_ == "B_LEVEL") return SchedulingAlgorithm::B_LEVEL;
+  if (sweep_scheduling_ == "FARTHEST_FIRST")
+    return SchedulingAlgorithm::FARTHEST_FIRST;
+
+  return sweep_type_ == "AAH" ? SchedulingAlgorithm::DEPTH_OF_GRAPH
+                              : SchedulingAlgorithm::FIRST_IN_FIRST_OUT;
 }
 
 /**Destructor for LBS*/
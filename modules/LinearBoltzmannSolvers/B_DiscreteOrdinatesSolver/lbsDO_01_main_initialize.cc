@@ -1,8 +1,12 @@
 #include "lbs_discrete_ordinates_solver.h"
 
 #include "B_DiscreteOrdinatesSolver/IterativeMethods/sweep_wgs_context.h"
+#include "B_DiscreteOrdinatesSolver/IterativeMethods/pipelined_ags_linear_solver.h"
 #include "A_LBSSolver/IterativeMethods/wgs_linear_solver.h"
 #include "A_LBSSolver/SourceFunctions/source_function.h"
+#include "mesh/SweepUtilities/AngleAggregation/angleaggregation.h"
+#include "mesh/SweepUtilities/FLUDS/FLUDS.h"
+#include "utils/chi_memory_accounting.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -15,26 +19,29 @@ void lbs::DiscreteOrdinatesSolver::Initialize()
 {
   LBSSolver::Initialize();
 
-  auto src_function = std::make_shared<SourceFunction>(*this);
-
   // Initialize source func
-  using namespace std::placeholders;
-  active_set_source_function_ =
-    std::bind(&SourceFunction::operator(), src_function, _1, _2, _3, _4);
+  InitializeSourceFunction(std::make_shared<SourceFunction>(*this));
 
   //================================================== Initialize groupsets for
   //                                                   sweeping
   InitializeSweepDataStructures();
+  if (options_.sweep_eager_limit_auto) TuneSweepMessageSizes();
   for (auto& groupset : groupsets_)
   {
     InitFluxDataStructures(groupset);
+    if (groupset.angle_set_auto_tune_) AutoTuneAngleSets(groupset);
+  }
+  SelectReflectingBCLagging();
 
+  for (auto& groupset : groupsets_)
+  {
     InitWGDSA(groupset);
     InitTGDSA(groupset);
+    InitAngularMG(groupset);
   }
 
   InitializeSolverSchemes();           //j
-  source_event_tag_ = Chi::log.GetRepeatingEventTag("Set Source");
+  LogMemoryUsage();                    //k
 }
 
 /**Initializes Within-GroupSet solvers.*/
@@ -43,22 +50,131 @@ void lbs::DiscreteOrdinatesSolver::InitializeWGSSolvers()
   wgs_solvers_.clear(); //this is required
   for (auto& groupset : groupsets_)
   {
+    InitCellFactorCache(groupset);
     std::shared_ptr<SweepChunk> sweep_chunk = SetSweepChunk(groupset);
+    FuseSourceEvaluation(*sweep_chunk, groupset);
+    SetCellFactorCache(*sweep_chunk, groupset);
 
     auto sweep_wgs_context_ptr =
     std::make_shared<SweepWGSContext<Mat, Vec, KSP>>(
       *this, groupset,
-        active_set_source_function_,
+        fused_source_function_ ? sweep_set_source_function_
+                               : active_set_source_function_,
         APPLY_WGS_SCATTER_SOURCES | APPLY_WGS_FISSION_SOURCES,  //lhs_scope
         APPLY_FIXED_SOURCES | APPLY_AGS_SCATTER_SOURCES |
         APPLY_AGS_FISSION_SOURCES,                              //rhs_scope
         options_.verbose_inner_iterations,
         sweep_chunk);
 
+    //=========================================== Threaded sweeps
+    SetSweepWorkerChunks(
+      groupset, *sweep_chunk, sweep_wgs_context_ptr->sweep_scheduler_);
+
+    //=========================================== Angular multigrid
+    if (groupset.angular_mg_groupset_)
+    {
+      auto angular_mg_sweep_chunk =
+        MakeSweepChunk(*groupset.angular_mg_groupset_,
+                       sweep_wgs_context_ptr->angular_mg_psi_);
+      FuseSourceEvaluation(*angular_mg_sweep_chunk, groupset);
+      sweep_wgs_context_ptr->SetAngularMGSweepChunk(angular_mg_sweep_chunk);
+    }
+
     auto wgs_solver =
       std::make_shared<WGSLinearSolver<Mat,Vec,KSP>>(sweep_wgs_context_ptr);
 
     wgs_solvers_.push_back(wgs_solver);
   }//for groupset
 
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Initializes the solver schemes. When pipelined sweeps are requested,
+ * the default across-groupset solver is replaced by one that sweeps all
+ * the groupsets concurrently.*/
+void lbs::DiscreteOrdinatesSolver::InitializeSolverSchemes()
+{
+  LBSSolver::InitializeSolverSchemes();
+
+  if (not ags_pipelined_sweeps_ or not options_.ags_scheme.empty()) return;
+  if (not PipelinedSweepsSupported()) return;
+
+  //=========================================== Consistent message tags
+  // AAH message tags are offset by the angle set id times the maximum number
+  // of messages, hence the latter must agree across groupsets.
+  int max_num_messages = 0;
+  for (auto& groupset : groupsets_)
+    for (auto& angle_set_group : groupset.angle_agg_->angle_set_groups)
+      for (auto& angle_set : angle_set_group.AngleSets())
+        max_num_messages =
+          std::max(angle_set->GetMaxBufferMessages(), max_num_messages);
+
+  for (auto& groupset : groupsets_)
+    for (auto& angle_set_group : groupset.angle_agg_->angle_set_groups)
+      for (auto& angle_set : angle_set_group.AngleSets())
+        angle_set->SetMaxBufferMessages(max_num_messages);
+
+  //=========================================== Pipelined AGS scheme
+  auto ags_context =
+    std::make_shared<AGSContext<Mat,Vec,KSP>>(*this, wgs_solvers_);
+
+  auto ags_solver = std::make_shared<PipelinedAGSLinearSolver<Mat,Vec,KSP>>(
+    ags_context, groupsets_.front().id_, groupsets_.back().id_);
+  ags_solver->SetVerbosity(options_.verbose_ags_iterations);
+
+  ags_solvers_.clear();
+  ags_solvers_.push_back(ags_solver);
+
+  primary_ags_solver_ = ags_solvers_.front();
+}
+
+//###################################################################
+/**Checks whether the groupsets can be swept concurrently. Groupsets must
+ * use richardson without DSA or angular multigrid, since their
+ * within-groupset solves are replaced by source iterations, and reflecting
+ * boundaries are not allowed, since their angle readiness is shared by all
+ * groupsets.*/
+bool lbs::DiscreteOrdinatesSolver::PipelinedSweepsSupported() const
+{
+  std::string reason;
+  for (const auto& groupset : groupsets_)
+  {
+    if (groupset.iterative_method_ != IterativeMethod::KRYLOV_RICHARDSON)
+      reason = "groupset " + std::to_string(groupset.id_) +
+               " does not use richardson";
+    if (groupset.apply_wgdsa_ or groupset.apply_tgdsa_)
+      reason = "groupset " + std::to_string(groupset.id_) + " uses DSA";
+    if (groupset.apply_angular_mg_)
+      reason = "groupset " + std::to_string(groupset.id_) +
+               " uses angular multigrid";
+  }
+
+  for (const auto& [bid, bndry] : sweep_boundaries_)
+    if (bndry->IsReflecting())
+      reason = "reflecting boundaries are present";
+
+  if (reason.empty()) return true;
+
+  Chi::log.Log0Warning()
+    << "ags_pipelined_sweeps is not supported because " << reason
+    << ". The default across-groupset scheme will be used.";
+  return false;
+}
+
+//###################################################################
+/**Adds the angular flux buffers of the angle sets to the accounting of
+ * the LBS solver.*/
+void lbs::DiscreteOrdinatesSolver::AccountMemoryUsage() const
+{
+  LBSSolver::AccountMemoryUsage();
+
+  size_t fluds_bytes = 0;
+  for (const auto& groupset : groupsets_)
+  {
+    if (not groupset.angle_agg_) continue;
+    for (auto& angle_set_group : groupset.angle_agg_->angle_set_groups)
+      for (auto& angle_set : angle_set_group.AngleSets())
+        fluds_bytes += angle_set->GetFLUDS().GetMemoryUsage();
+  }
+  chi::MemoryAccounting::GetInstance().SetUsage("Sweep FLUDS", fluds_bytes);
+}
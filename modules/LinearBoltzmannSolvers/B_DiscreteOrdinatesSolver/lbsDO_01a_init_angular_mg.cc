@@ -0,0 +1,81 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+// ###################################################################
+/**Builds the coarse angular level of a groupset using angular multigrid.
+ * The level is a copy of the groupset, with the same groups and subsets,
+ * using the lower order angular multigrid quadrature, for which the sweep
+ * orderings and the angle aggregation are built as for any groupset.
+ *
+ * The coarse angle sets share the boundaries of the solver, hence only
+ * vacuum and isotropic incident boundaries, whose data do not depend on
+ * the quadrature, are supported.*/
+void lbs::DiscreteOrdinatesSolver::InitAngularMG(LBSGroupset& groupset)
+{
+  if (not groupset.apply_angular_mg_) return;
+
+  const std::string fname = "lbs::DiscreteOrdinatesSolver::InitAngularMG";
+  typedef chi_mesh::sweep_management::BoundaryType SwpBndryType;
+
+  //=========================================== Checks
+  ChiInvalidArgumentIf(sweep_type_ != "AAH",
+                       fname + ": Angular multigrid requires the \"AAH\" "
+                               "sweep type.");
+  ChiInvalidArgumentIf(options_.geometry_type != GeometryType::ONED_SLAB and
+                         options_.geometry_type !=
+                           GeometryType::TWOD_CARTESIAN and
+                         options_.geometry_type !=
+                           GeometryType::THREED_CARTESIAN,
+                       fname + ": Angular multigrid is only supported in "
+                               "cartesian geometries.");
+  for (const auto& [bid, bndry] : sweep_boundaries_)
+    ChiInvalidArgumentIf(
+      bndry->Type() != SwpBndryType::INCIDENT_VACCUUM and
+        bndry->Type() != SwpBndryType::INCIDENT_ISOTROPIC_HOMOGENOUS,
+      fname + ": Angular multigrid only supports vacuum and isotropic "
+              "incident boundaries.");
+
+  //=========================================== Coarse groupset
+  auto coarse_groupset = std::make_shared<LBSGroupset>(groupset.id_);
+  coarse_groupset->groups_ = groupset.groups_;
+  coarse_groupset->quadrature_ = groupset.angular_mg_quadrature_;
+  coarse_groupset->angleagg_method_ = groupset.angleagg_method_;
+  coarse_groupset->allow_cycles_ = groupset.allow_cycles_;
+  coarse_groupset->master_num_grp_subsets_ = groupset.master_num_grp_subsets_;
+  coarse_groupset->master_num_ang_subsets_ = groupset.master_num_ang_subsets_;
+
+  const size_t num_angles = coarse_groupset->quadrature_->abscissae_.size();
+  const size_t gs_num_groups = coarse_groupset->groups_.size();
+  for (size_t n = 0; n < num_angles; ++n)
+    coarse_groupset->psi_uk_man_.AddUnknown(chi_math::UnknownType::VECTOR_N,
+                                            gs_num_groups);
+
+  coarse_groupset->BuildDiscMomOperator(options_.scattering_order,
+                                        options_.geometry_type);
+  coarse_groupset->BuildMomDiscOperator(options_.scattering_order,
+                                        options_.geometry_type);
+  coarse_groupset->BuildSubsets();
+
+  //=========================================== Sweep data
+  const auto& quadrature = coarse_groupset->quadrature_;
+  if (quadrature_sweep_data_map_.count(quadrature) == 0)
+  {
+    const auto sweep_data = GetSweepData(*coarse_groupset);
+
+    quadrature_sweep_data_map_[quadrature] = sweep_data;
+    quadrature_unq_so_grouping_map_[quadrature] = sweep_data->so_grouping_info;
+    quadrature_spds_map_[quadrature] = sweep_data->spds_list;
+    quadrature_fluds_commondata_map_[quadrature] =
+      sweep_data->fluds_common_data_list;
+  }
+
+  InitFluxDataStructures(*coarse_groupset);
+
+  groupset.angular_mg_groupset_ = coarse_groupset;
+
+  Chi::log.Log() << "Groupset " << groupset.id_ << " angular multigrid "
+                 << "coarse level with " << num_angles << " directions.";
+}
@@ -0,0 +1,84 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "SweepChunks/SweepChunk.h"
+#include "A_LBSSolver/SourceFunctions/source_function.h"
+
+#include "chi_log_exceptions.h"
+
+// ###################################################################
+/**Sets the active set source function to the given source function. With
+ * fused source evaluation, the within-groupset solvers instead get a set
+ * source function that defers the evaluations into the source moments
+ * vector to the sweeps.*/
+void lbs::DiscreteOrdinatesSolver::InitializeSourceFunction(
+  std::shared_ptr<SourceFunction> src_function)
+{
+  using namespace std::placeholders;
+  active_set_source_function_ =
+    std::bind(&SourceFunction::operator(), src_function, _1, _2, _3, _4);
+
+  if (not fused_source_evaluation_) return;
+
+  fused_source_function_ = std::move(src_function);
+  sweep_set_source_function_ = [this](LBSGroupset& groupset,
+                                      std::vector<double>& destination_q,
+                                      const std::vector<double>& phi,
+                                      SourceFlags source_flags)
+  {
+    // Only the source moments are read by the sweep chunks
+    if (&destination_q == &q_moments_local_)
+      fused_source_function_->DeferEvaluation(
+        groupset, destination_q, phi, source_flags);
+    else
+      active_set_source_function_(groupset, destination_q, phi, source_flags);
+  };
+}
+
+// ###################################################################
+/**Replaces the source function of the initialized solver, e.g., by the one
+ * of a transient executor. The within-groupset solvers refer to the set
+ * source functions of the solver, hence use the new one from their next
+ * evaluation on.*/
+void lbs::DiscreteOrdinatesSolver::ReplaceSourceFunction(
+  std::shared_ptr<SourceFunction> src_function)
+{
+  ChiLogicalErrorIf(not IsInitialized(),
+                    "The source function can only be replaced once the "
+                    "solver is initialized.");
+
+  InitializeSourceFunction(std::move(src_function));
+}
+
+// ###################################################################
+/**Makes the sweep chunk evaluate the deferred source of the groupset, if
+ * any, cell by cell. Does nothing without fused source evaluation.*/
+void lbs::DiscreteOrdinatesSolver::FuseSourceEvaluation(
+  SweepChunk& sweep_chunk, const LBSGroupset& groupset) const
+{
+  if (not fused_source_function_) return;
+
+  auto lbs_sweep_chunk = dynamic_cast<lbs::SweepChunk*>(&sweep_chunk);
+  ChiLogicalErrorIf(not lbs_sweep_chunk,
+                    "Fused source evaluation requires LBS sweep chunks.");
+
+  // The source function is looked up on every visit, since it may be
+  // replaced, see ReplaceSourceFunction
+  const int groupset_id = groupset.id_;
+  lbs_sweep_chunk->SetCellSourceFunction(
+    [this, groupset_id](uint64_t cell_local_id)
+    {
+      fused_source_function_->EvaluateDeferredCell(groupset_id,
+                                                   cell_local_id);
+    });
+}
+
+// ###################################################################
+/**Evaluates the cells of the deferred source of the groupset that were
+ * not visited by the sweep, such that the source moments vector is
+ * complete. Called after every sweep of the within-groupset solvers.*/
+void lbs::DiscreteOrdinatesSolver::CompleteDeferredSources(
+  const LBSGroupset& groupset)
+{
+  if (fused_source_function_)
+    fused_source_function_->CompleteDeferredEvaluation(groupset.id_);
+}
@@ -0,0 +1,39 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "chi_log_exceptions.h"
+
+// ###################################################################
+/**Checks that the sweeps support the time derivative term, i.e., that the
+ * sweep chunks use the standard mass terms with the total cross sections
+ * of the cells. The diffusion and angular multigrid operators of the
+ * acceleration schemes lack the time absorption, the source moments
+ * option bypasses the fixed sources the time source is applied with, and
+ * the first-collision source is that of a steady uncollided flux, hence
+ * these are not supported either.*/
+void lbs::DiscreteOrdinatesSolver::CheckTimeDerivativeSupport() const
+{
+  ChiInvalidArgumentIf(sweep_chunk_mode_ != "DEFAULT" and
+                         sweep_chunk_mode_ != "GROUP_BATCHED",
+                       "The time derivative term requires the sweep chunk "
+                       "mode \"DEFAULT\" or \"GROUP_BATCHED\", not \"" +
+                         sweep_chunk_mode_ + "\".");
+
+  ChiInvalidArgumentIf(options_.use_src_moments,
+                       "The time derivative term is not supported with "
+                       "source moments.");
+  ChiInvalidArgumentIf(options_.use_first_collision_source,
+                       "The time derivative term is not supported with the "
+                       "first-collision source.");
+
+  for (const auto& groupset : groupsets_)
+  {
+    ChiInvalidArgumentIf(groupset.apply_wgdsa_ or groupset.apply_tgdsa_,
+                         "The time derivative term is not supported with "
+                         "WGDSA or TGDSA, groupset " +
+                           std::to_string(groupset.id_) + ".");
+    ChiInvalidArgumentIf(groupset.angular_mg_groupset_ != nullptr,
+                         "The time derivative term is not supported with "
+                         "angular multigrid, groupset " +
+                           std::to_string(groupset.id_) + ".");
+  }
+}
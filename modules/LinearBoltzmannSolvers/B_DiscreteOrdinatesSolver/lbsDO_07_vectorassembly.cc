@@ -59,28 +59,10 @@ void lbs::DiscreteOrdinatesSolver::
   double* x_ref;
   VecGetArray(x,&x_ref);
 
-  int gsi = groupset.groups_.front().id_;
-  int gsf = groupset.groups_.back().id_;
-  int gss = gsf-gsi+1;
-
   int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          x_ref[index] = (*y_ptr)[mapping+g]; //Offset on purpose
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  index += CopyGroupSpanToArray(groupset.groups_.front().id_,
+                                groupset.groups_.back().id_,
+                                *y_ptr, x_ref);
 
   switch (which_phi)
   {
@@ -113,28 +95,10 @@ void lbs::DiscreteOrdinatesSolver::
   const double* x_ref;
   VecGetArrayRead(x_src,&x_ref);
 
-  int gsi = groupset.groups_.front().id_;
-  int gsf = groupset.groups_.back().id_;
-  int gss = gsf-gsi+1;
-
   int64_t index = -1;
-  for (const auto& cell : grid_ptr_->local_cells)
-  {
-    auto& transport_view = cell_transport_views_[cell.local_id_];
-
-    for (int i=0; i < cell.vertex_ids_.size(); i++)
-    {
-      for (int m=0; m < num_moments_; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          (*y_ptr)[mapping+g] = x_ref[index];
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+  index += CopyGroupSpanFromArray(groupset.groups_.front().id_,
+                                  groupset.groups_.back().id_,
+                                  x_ref, *y_ptr);
 
   switch (which_phi)
   {
@@ -224,27 +188,9 @@ SetMultiGSPETScVecFromPrimarySTLvector(const std::vector<int> &gs_ids,
   {
     auto& groupset = groupsets_.at(gs_id);
 
-    int gsi = groupset.groups_.front().id_;
-    int gsf = groupset.groups_.back().id_;
-    int gss = gsf-gsi+1;
-
-    for (const auto& cell : grid_ptr_->local_cells)
-    {
-      auto& transport_view = cell_transport_views_[cell.local_id_];
-
-      for (int i=0; i < cell.vertex_ids_.size(); i++)
-      {
-        for (int m=0; m < num_moments_; m++)
-        {
-          size_t mapping = transport_view.MapDOF(i,m,gsi);
-          for (int g=0; g<gss; g++)
-          {
-            index++;
-            x_ref[index] = (*y_ptr)[mapping+g]; //Offset on purpose
-          }//for g
-        }//for moment
-      }//for dof
-    }//for cell
+    index += CopyGroupSpanToArray(groupset.groups_.front().id_,
+                                  groupset.groups_.back().id_,
+                                  *y_ptr, x_ref + index + 1);
 
     switch (which_phi)
     {
@@ -284,27 +230,9 @@ SetPrimarySTLvectorFromMultiGSPETScVecFrom(const std::vector<int> &gs_ids,
   {
     auto& groupset = groupsets_.at(gs_id);
 
-    int gsi = groupset.groups_.front().id_;
-    int gsf = groupset.groups_.back().id_;
-    int gss = gsf-gsi+1;
-
-    for (const auto& cell : grid_ptr_->local_cells)
-    {
-      auto& transport_view = cell_transport_views_[cell.local_id_];
-
-      for (int i=0; i < cell.vertex_ids_.size(); i++)
-      {
-        for (int m=0; m < num_moments_; m++)
-        {
-          size_t mapping = transport_view.MapDOF(i,m,gsi);
-          for (int g=0; g<gss; g++)
-          {
-            index++;
-            (*y_ptr)[mapping+g] = x_ref[index];
-          }//for g
-        }//for moment
-      }//for dof
-    }//for cell
+    index += CopyGroupSpanFromArray(groupset.groups_.front().id_,
+                                    groupset.groups_.back().id_,
+                                    x_ref + index + 1, *y_ptr);
 
     switch (which_phi)
     {
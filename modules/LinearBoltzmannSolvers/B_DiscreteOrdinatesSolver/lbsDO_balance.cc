@@ -97,9 +97,17 @@ void lbs::DiscreteOrdinatesSolver::ComputeBalance()
     //====================================== Outflow
     //The group-wise outflow was determined
     //during a solve so here we just
-    //consolidate it.
-    for (int g=0; g < num_groups_; ++g)
-      local_out_flow += transport_view.GetOutflow(g);
+    //consolidate it. Reflecting boundaries
+    //return what flows out.
+    for (int f=0; f<cell.faces_.size(); ++f)
+    {
+      const auto& face = cell.faces_[f];
+      if (face.has_neighbor_ or
+          sweep_boundaries_.at(face.neighbor_id_)->IsReflecting())
+        continue;
+      for (int g=0; g < num_groups_; ++g)
+        local_out_flow += transport_view.GetOutflow(f, g);
+    }
 
     //====================================== Absorption and Src
     //Isotropic flux based absorption and source
@@ -117,6 +125,12 @@ void lbs::DiscreteOrdinatesSolver::ComputeBalance()
       }//for g
   }//for cell
 
+  //======================================== Outflows of the other angle teams
+  // Each team tallies only the outflow of the angles it sweeps.
+  if (Chi::mpi.num_angle_teams > 1)
+    MPI_Allreduce(MPI_IN_PLACE, &local_out_flow, 1, MPI_DOUBLE, MPI_SUM,
+                  Chi::mpi.cross_team_comm);
+
   //======================================== Consolidate local balances
   double local_balance = local_production + local_in_flow
                        - local_absorption - local_out_flow;
@@ -2,7 +2,9 @@
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
-/**Computes the angular flux based leakage from boundary surfaces.
+/**Computes the leakage from boundary surfaces. The leakage is consolidated
+ * from the outflow tallied per boundary face during the last sweep of the
+ * groupset, hence the angular fluxes need not be saved.
 \param groupset_id The groupset for which to compute the leakage.
 \param boundary_id uint64_t The boundary-id for which to perform the integration.
 
@@ -17,63 +19,34 @@ std::vector<double> lbs::DiscreteOrdinatesSolver::
   if (groupset_id<0 or groupset_id>=groupsets_.size())
     throw std::invalid_argument(fname + ": Invalid groupset_id specified.");
 
-  if (not options_.save_angular_flux)
-    throw std::logic_error(fname + ": Requires options.save_angular_flux to be"
-                                   " true.");
-
   //================================================== Get info
-  const auto& sdm = *discretization_;
   const auto& groupset = groupsets_.at(groupset_id);
-  const auto& psi_uk_man = groupset.psi_uk_man_;
-  const auto& quadrature = groupset.quadrature_;
-
-  const size_t num_angles = quadrature->omegas_.size();
 
   const int gsi = groupset.groups_.front().id_;
   const int gsf = groupset.groups_.back().id_;
   const int gs_num_groups = gsf+1-gsi;
 
-  //================================================== Start integration
+  //================================================== Consolidate tallies
   std::vector<double> local_leakage(gs_num_groups, 0.0);
   for (const auto& cell : grid_ptr_->local_cells)
   {
-    const auto& cell_mapping = sdm.GetCellMapping(cell);
-    const auto& fe_values = unit_cell_matrices_[cell.local_id_];
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
 
-    size_t f=0;
+    int f=0;
     for (const auto& face : cell.faces_)
     {
       if (not face.has_neighbor_ and face.neighbor_id_ == boundary_id)
-      {
-        const auto& IntF_shapeI = fe_values.face_Si_vectors[f];
-        const size_t num_face_nodes = cell_mapping.NumFaceNodes(f);
-        for (size_t fi=0; fi<num_face_nodes; ++fi)
-        {
-          const int i = cell_mapping.MapFaceNode(f, fi);
-          for (size_t n=0; n<num_angles; ++n)
-          {
-            const auto& omega  = quadrature->omegas_[n];
-            const auto& weight = quadrature->weights_[n];
-            const double mu = omega.Dot(face.normal_);
-            if (mu > 0.0)
-            {
-              for (int gi=0; gi<gs_num_groups; ++gi)
-              {
-                const int g = gi+gsi;
-                const int64_t imap = sdm.MapDOFLocal(cell, i, psi_uk_man, n, g);
-
-                const double psi = psi_new_local_[groupset_id][imap];
-
-                local_leakage[gi] += weight * mu * psi * IntF_shapeI[i];
-              }//for g
-            }//outgoing
-          }//for n
-        }//for face node
-      }//if right bndry
+        for (int gi=0; gi<gs_num_groups; ++gi)
+          local_leakage[gi] += transport_view.GetOutflow(f, gi + gsi);
       ++f;
     }//for face
   }//for cell
 
+  // Each angle team tallies only the outflow of the angles it sweeps
+  if (Chi::mpi.num_angle_teams > 1)
+    MPI_Allreduce(MPI_IN_PLACE, local_leakage.data(), gs_num_groups,
+                  MPI_DOUBLE, MPI_SUM, Chi::mpi.cross_team_comm);
+
   std::vector<double> global_leakage(gs_num_groups, 0.0);
   MPI_Allreduce(local_leakage.data(),      //sendbuf
                 global_leakage.data(),     //recvbuf,
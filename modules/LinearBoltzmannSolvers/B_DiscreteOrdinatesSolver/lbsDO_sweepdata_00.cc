@@ -38,7 +38,10 @@ namespace lbs
  * where each FLUDS mirrors a SPDS in ii).
  *
  * The Template FLUDS can be scaled with number of angles and groups which
- * provides us with the angle-set-subset- and groupset-subset capability.*/
+ * provides us with the angle-set-subset- and groupset-subset capability.
+ *
+ * All three are obtained from the sweep data cache (see GetSweepData) and
+ * are therefore possibly shared with other solvers.*/
 void DiscreteOrdinatesSolver::InitializeSweepDataStructures()
 {
   Chi::log.Log() << Chi::program_timer.GetTimeString()
@@ -51,8 +54,10 @@ void DiscreteOrdinatesSolver::InitializeSweepDataStructures()
 
     for (const auto& groupset : groupsets_)
     {
+      // Block-Jacobi sweeps have no location dependencies, hence no cycles
       bool no_cycles_parmetis_partitioning =
-        (IsPartitionTypeParmetis and (not groupset.allow_cycles_));
+        (IsPartitionTypeParmetis and (not groupset.allow_cycles_) and
+         (not sweep_block_jacobi_));
 
       bool is_1D_geometry = options_.geometry_type == GeometryType::ONED_SLAB;
 
@@ -61,94 +66,130 @@ void DiscreteOrdinatesSolver::InitializeSweepDataStructures()
     } // for groupset
   }
 
-  //=================================== Define sweep ordering groups
+  //=================================== Automatic sweep type
+  std::map<AngQuadPtr, SweepDataPtr> prebuilt_sweep_data;
+  if (sweep_type_ == "AUTO") prebuilt_sweep_data = SelectSweepType();
+
+  //=================================== Obtain the sweep data per quadrature
+  // The angle aggregation type and cycles option of the first groupset
+  // using a quadrature apply to all the groupsets using it
+  quadrature_sweep_data_map_.clear();
   quadrature_unq_so_grouping_map_.clear();
-  std::map<AngQuadPtr, bool> quadrature_allow_cycles_map_;
-  for (auto& groupset : groupsets_)
+  quadrature_spds_map_.clear();
+  quadrature_fluds_commondata_map_.clear();
+  for (const auto& groupset : groupsets_)
   {
-    if (quadrature_unq_so_grouping_map_.count(groupset.quadrature_) == 0)
-      quadrature_unq_so_grouping_map_[groupset.quadrature_] =
-        AssociateSOsAndDirections(*grid_ptr_,
-                                  *groupset.quadrature_,
-                                  groupset.angleagg_method_,
-                                  options_.geometry_type);
-
-    if (quadrature_allow_cycles_map_.count(groupset.quadrature_) == 0)
-      quadrature_allow_cycles_map_[groupset.quadrature_] =
-        groupset.allow_cycles_;
+    if (quadrature_sweep_data_map_.count(groupset.quadrature_) != 0) continue;
+
+    const auto prebuilt = prebuilt_sweep_data.find(groupset.quadrature_);
+    const auto sweep_data = prebuilt != prebuilt_sweep_data.end()
+                              ? prebuilt->second
+                              : GetSweepData(groupset);
+
+    quadrature_sweep_data_map_[groupset.quadrature_] = sweep_data;
+    quadrature_unq_so_grouping_map_[groupset.quadrature_] =
+      sweep_data->so_grouping_info;
+    quadrature_spds_map_[groupset.quadrature_] = sweep_data->spds_list;
+    quadrature_fluds_commondata_map_[groupset.quadrature_] =
+      sweep_data->fluds_common_data_list;
+
+    if (sweep_ordering_report_) LogSweepOrderingReport(groupset, *sweep_data);
   }
 
+  Chi::log.Log() << Chi::program_timer.GetTimeString()
+                 << " Done initializing sweep datastructures.\n";
+}
+
+// ###################################################################
+/**Builds the sweep ordering groups, the SPDSs and the FLUDS common data
+ * of the quadrature of the given groupset.*/
+DiscreteOrdinatesSolver::SweepDataPtr
+DiscreteOrdinatesSolver::MakeSweepData(const LBSGroupset& groupset) const
+{
+  auto sweep_data = std::make_shared<SweepData>();
+  sweep_data->grid = grid_ptr_;
+  sweep_data->quadrature = groupset.quadrature_;
+  // Nodal mappings have const members, hence copy constructed
+  sweep_data->grid_nodal_mappings.reserve(grid_nodal_mappings_.size());
+  for (const auto& cell_nodal_mapping : grid_nodal_mappings_)
+    sweep_data->grid_nodal_mappings.push_back(cell_nodal_mapping);
+
+  const auto& quadrature = *groupset.quadrature_;
+  const auto& grid = *sweep_data->grid;
+
+  //=================================== Define sweep ordering groups
+  sweep_data->so_grouping_info = AssociateSOsAndDirections(
+    grid, quadrature, groupset.angleagg_method_, options_.geometry_type);
+
   //=================================== Build sweep orderings
-  quadrature_spds_map_.clear();
-  for (const auto& [quadrature, info] : quadrature_unq_so_grouping_map_)
+  std::vector<chi_mesh::Vector3> omegas;
+  std::vector<bool> verbose_flags;
+  const auto& unique_so_groupings = sweep_data->so_grouping_info.first;
+  for (const auto& so_grouping : unique_so_groupings)
   {
-    const auto& unique_so_groupings = info.first;
+    if (so_grouping.empty()) continue;
+
+    const size_t master_dir_id = so_grouping.front();
+    omegas.push_back(quadrature.omegas_[master_dir_id]);
+
+    bool verbose = false;
+    if (not verbose_sweep_angles_.empty())
+      for (const size_t dir_id : verbose_sweep_angles_)
+        if (chi::VectorListHas(so_grouping, dir_id))
+        {
+          verbose = true;
+          break;
+        }
+    verbose_flags.push_back(verbose);
+  }
 
-    for (const auto& so_grouping : unique_so_groupings)
-    {
-      if (so_grouping.empty()) continue;
-
-      const size_t master_dir_id = so_grouping.front();
-      const auto& omega = quadrature->omegas_[master_dir_id];
-
-      bool verbose = false;
-      if (not verbose_sweep_angles_.empty())
-        for (const size_t dir_id : verbose_sweep_angles_)
-          if (chi::VectorListHas(so_grouping, dir_id))
-          {
-            verbose = true;
-            break;
-          }
-
-      if (sweep_type_ == "AAH")
-      {
-        using namespace chi_mesh::sweep_management;
-        const auto new_swp_order = std::make_shared<SPDS_AdamsAdamsHawkins>(
-          omega,
-          *this->grid_ptr_,
-          quadrature_allow_cycles_map_[quadrature],
-          verbose);
-        quadrature_spds_map_[quadrature].push_back(new_swp_order);
-      }
-      else if (sweep_type_ == "CBC")
-      {
-        const auto new_swp_order =
-          std::make_shared<CBC_SPDS>(omega,
-                                     *this->grid_ptr_,
-                                     quadrature_allow_cycles_map_[quadrature],
-                                     verbose);
-        quadrature_spds_map_[quadrature].push_back(new_swp_order);
-      }
-      else
-        ChiInvalidArgument("Unsupported sweeptype \"" + sweep_type_ + "\"");
-    }
-  } // quadrature info-pack
+  // AAH orderings are built concurrently, levelized for level batched
+  // sweep chunks and with delayed location dependencies for block-Jacobi
+  // sweeps
+  if (sweep_type_ == "AAH")
+  {
+    using namespace chi_mesh::sweep_management;
+    const auto new_swp_orders = SPDS_AdamsAdamsHawkins::MakeSweepOrderings(
+      omegas,
+      grid,
+      groupset.allow_cycles_,
+      verbose_flags,
+      /*levelized=*/LevelizedSweeps(),
+      /*delay_location_dependencies=*/sweep_block_jacobi_);
+    sweep_data->spds_list.assign(new_swp_orders.begin(),
+                                 new_swp_orders.end());
+  }
+  else if (sweep_type_ == "CBC")
+  {
+    for (size_t so = 0; so < omegas.size(); ++so)
+      sweep_data->spds_list.push_back(std::make_shared<CBC_SPDS>(
+        omegas[so], grid, groupset.allow_cycles_, verbose_flags[so]));
+  }
+  else
+    ChiInvalidArgument("Unsupported sweeptype \"" + sweep_type_ + "\"");
 
   //=================================== Build FLUDS templates
-  quadrature_fluds_commondata_map_.clear();
-  for (const auto& [quadrature, spds_list] : quadrature_spds_map_)
+  if (sweep_type_ == "AAH")
   {
     using namespace chi_mesh::sweep_management;
-    for (const auto& spds : spds_list)
-    {
-      if (sweep_type_ == "AAH")
-      {
-        quadrature_fluds_commondata_map_[quadrature].push_back(
-          std::make_unique<AAH_FLUDSCommonData>(
-            grid_nodal_mappings_, *spds, *grid_face_histogram_));
-      }
-      else if (sweep_type_ == "CBC")
-      {
-        quadrature_fluds_commondata_map_[quadrature].push_back(
-          std::make_unique<CBC_FLUDSCommonData>(*spds, grid_nodal_mappings_));
-      }
-      else
-        ChiInvalidArgument("Unsupported sweeptype \"" + sweep_type_ + "\"");
-    }
-  } // for quadrature spds-list pair
+    const auto common_data_list =
+      AAH_FLUDSCommonData::MakeCommonData(sweep_data->grid_nodal_mappings,
+                                          sweep_data->spds_list,
+                                          *grid_face_histogram_);
+    sweep_data->fluds_common_data_list.assign(common_data_list.begin(),
+                                              common_data_list.end());
+  }
+  else if (sweep_type_ == "CBC")
+  {
+    for (const auto& spds : sweep_data->spds_list)
+      sweep_data->fluds_common_data_list.push_back(
+        std::make_shared<CBC_FLUDSCommonData>(
+          *spds, sweep_data->grid_nodal_mappings));
+  }
+  else
+    ChiInvalidArgument("Unsupported sweeptype \"" + sweep_type_ + "\"");
 
-  Chi::log.Log() << Chi::program_timer.GetTimeString()
-                 << " Done initializing sweep datastructures.\n";
+  return sweep_data;
 }
 
 } // namespace lbs
\ No newline at end of file
@@ -7,6 +7,12 @@
 
 #include "math/Quadratures/angular_product_quadrature.h"
 
+#include "chi_runtime.h"
+#include "chi_mpi.h"
+
+#include <array>
+#include <set>
+
 #define POLAR_ILLEGAL_GEOTYPE (fname + \
   ": The simulation is using polar angle aggregation for which only " \
   "certain geometry types are supported, i.e., ORTHOGONAL, DIMENSION_2 " \
@@ -34,6 +40,82 @@ if ((condition)) \
 namespace lbs
 {
 
+namespace
+{
+//###################################################################
+/**Groups the directions having the same orientation, incoming, outgoing
+ * or parallel, as determined by the SPDS, relative to every face of the
+ * grid, on all the locations. Such directions have the same sweep
+ * ordering, whatever the structure of the quadrature.
+ *
+ * The face normals are reduced to their unique values, with a normal and
+ * its opposite identified, hence orthogonal grids only have three. The
+ * orientations of a direction relative to them are hashed per location,
+ * and the hashes of all the locations reduced. The groups are ordered by
+ * their first direction, hence are the same on all the locations.*/
+UniqueSOGroupings
+  GroupDirectionsBySweepOrdering(const chi_mesh::MeshContinuum& grid,
+                                 const chi_math::AngularQuadrature& quadrature)
+{
+  constexpr double tolerance = 1.0e-16; //same as the SPDS
+
+  //================================================== Unique face normals
+  std::set<std::array<double, 3>> unique_normals;
+  for (const auto& cell : grid.local_cells)
+    for (const auto& face : cell.faces_)
+    {
+      auto n = face.normal_;
+      const bool flip = n.x < 0.0 or (n.x == 0.0 and n.y < 0.0) or
+                        (n.x == 0.0 and n.y == 0.0 and n.z < 0.0);
+      if (flip) n = -1.0 * n;
+      unique_normals.insert({n.x, n.y, n.z});
+    }
+
+  /**Orientation of a direction, relative to a normal, as the SPDS.*/
+  auto Orientation = [](const double mu)
+  { return mu > tolerance ? uint64_t{1} : (mu < tolerance ? 2 : 3); };
+
+  //================================================== Hash the orientations
+  const auto& omegas = quadrature.omegas_;
+  const size_t num_dirs = omegas.size();
+  const auto location_seed =
+    0x9e3779b97f4a7c15ULL * static_cast<uint64_t>(Chi::mpi.location_id + 1);
+
+  std::vector<uint64_t> hashes(num_dirs, location_seed);
+  for (const auto& normal : unique_normals)
+  {
+    const chi_mesh::Vector3 n(normal[0], normal[1], normal[2]);
+    for (size_t d=0; d<num_dirs; ++d)
+    {
+      const double mu = omegas[d].Dot(n);
+      // both sides of a face, since either cell may own it
+      const uint64_t key = 4 * Orientation(mu) + Orientation(-mu);
+
+      auto& h = hashes[d];
+      h ^= key + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+  }
+
+  std::vector<uint64_t> global_hashes(num_dirs, 0);
+  MPI_Allreduce(hashes.data(), global_hashes.data(),
+                static_cast<int>(num_dirs), MPI_UINT64_T, MPI_BXOR,
+                Chi::mpi.comm);
+
+  //================================================== Group equal hashes
+  UniqueSOGroupings unq_so_grps;
+  std::map<uint64_t, size_t> hash_to_group;
+  for (size_t d=0; d<num_dirs; ++d)
+  {
+    const auto [it, inserted] =
+      hash_to_group.emplace(global_hashes[d], unq_so_grps.size());
+    if (inserted) unq_so_grps.emplace_back();
+    unq_so_grps[it->second].push_back(d);
+  }
+
+  return unq_so_grps;
+}
+}//namespace
+
 //###################################################################
 /**This routine groups angle-indices to groups sharing the same sweep
  * ordering. It also takes geometry into account.*/
@@ -178,6 +260,15 @@ DiscreteOrdinatesSolver::
 
       break;
     }
+
+      //====================================== Sweep ordering
+      // Directions with the same orientation relative to every face of
+      // the grid, for any quadrature.
+    case AngleAggregationType::SWEEP_ORDERING:
+    {
+      unq_so_grps = GroupDirectionsBySweepOrdering(grid, quadrature);
+      break;
+    }
     default:
       throw std::invalid_argument(fname + ": Called with UNDEFINED angle "
                                           "aggregation type.");
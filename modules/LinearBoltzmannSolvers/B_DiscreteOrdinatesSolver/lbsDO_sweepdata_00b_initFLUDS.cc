@@ -40,14 +40,47 @@ void lbs::DiscreteOrdinatesSolver::InitFluxDataStructures(LBSGroupset& groupset)
   const size_t gs_num_grps = groupset.groups_.size();
   const size_t gs_num_ss = groupset.grp_subset_infos_.size();
 
+  //=========================================== Angle teams
+  // Reflected angles might be owned by another team, which never sweeps
+  // them for this team's boundaries.
+  const auto num_angle_teams = static_cast<size_t>(Chi::mpi.num_angle_teams);
+  const auto angle_team_id = static_cast<size_t>(Chi::mpi.angle_team_id);
+  if (num_angle_teams > 1)
+    for (const auto& [bid, bndry] : sweep_boundaries_)
+      ChiInvalidArgumentIf(bndry->IsReflecting(),
+                           "Angle teams do not support reflecting "
+                           "boundaries.");
+
   //=========================================== Passing the sweep boundaries
   //                                            to the angle aggregation
   typedef chi_mesh::sweep_management::AngleAggregation AngleAgg;
   groupset.angle_agg_ = std::make_shared<AngleAgg>(
     sweep_boundaries_, gs_num_grps, gs_num_ss, groupset.quadrature_, grid_ptr_);
 
-  TAngleSetGroup angle_set_group;
+  //=========================================== Face cache offsets
+  const bool build_face_cache =
+    sweep_face_cache_ and FaceCacheFitsBudget(groupset);
+  std::shared_ptr<const std::vector<size_t>> cell_face_offsets;
+  if (build_face_cache) cell_face_offsets = MakeCellFaceOffsets();
+
+  if (groupset.angular_flux_single_precision_ and sweep_type_ != "AAH")
+    Chi::log.Log0Warning()
+      << "angular_flux_precision=\"single\" is only supported by the "
+         "\"AAH\" sweep type. Double precision will be used.";
+
+  //=========================================== Angle set ids are unique
+  //                                            across groupsets when these
+  //                                            are swept concurrently
   size_t angle_set_id = 0;
+  if (ags_pipelined_sweeps_)
+    for (auto& other_groupset : groupsets_)
+    {
+      if (&other_groupset == &groupset) break;
+      for (auto& other_group : other_groupset.angle_agg_->angle_set_groups)
+        angle_set_id += other_group.AngleSets().size();
+    }
+
+  TAngleSetGroup angle_set_group;
   for (const auto& so_grouping : unique_so_groupings)
   {
     const size_t master_dir_id = so_grouping.front();
@@ -62,15 +95,27 @@ void lbs::DiscreteOrdinatesSolver::InitFluxDataStructures(LBSGroupset& groupset)
     const auto dir_subsets =
       lbs::MakeSubSets(so_grouping.size(), groupset.master_num_ang_subsets_);
 
+    // Face caches are shared by all the group subsets of a direction subset
+    std::vector<std::shared_ptr<const sweep_namespace::AngleSetFaceCache>>
+      dir_subset_face_caches(dir_subsets.size());
+
     for (size_t gs_ss = 0; gs_ss < gs_num_ss; gs_ss++)
     {
       const size_t gs_ss_size = groupset.grp_subset_infos_[gs_ss].ss_size;
-      for (const auto& dir_ss_info : dir_subsets)
+      for (size_t dir_ss = 0; dir_ss < dir_subsets.size(); ++dir_ss)
       {
+        const auto& dir_ss_info = dir_subsets[dir_ss];
         const auto& dir_ss_begin = dir_ss_info.ss_begin;
         const auto& dir_ss_end = dir_ss_info.ss_end;
         const auto& dir_ss_size = dir_ss_info.ss_size;
 
+        // Angle sets are dealt round-robin to the angle teams
+        if (angle_set_id % num_angle_teams != angle_team_id)
+        {
+          ++angle_set_id;
+          continue;
+        }
+
         std::vector<size_t> angle_indices(dir_ss_size, 0);
         {
           size_t k = 0;
@@ -96,14 +141,21 @@ void lbs::DiscreteOrdinatesSolver::InitFluxDataStructures(LBSGroupset& groupset)
                                             sweep_boundaries_,
                                             options_.sweep_eager_limit,
                                             *grid_local_comm_set_);
+          angleSet->SetSinglePrecisionMessages(
+            groupset.angular_flux_single_precision_);
+          angleSet->SetPersistentRequests(options_.sweep_persistent_requests);
+          if (not sweep_location_eager_limits_.empty())
+            angleSet->SetLocationEagerLimits(sweep_location_eager_limits_);
+          angleSet->SetSharedMemoryExchange(options_.sweep_shared_memory);
 
           angle_set_group.AngleSets().push_back(angleSet);
         }
         else if (sweep_type_ == "CBC")
         {
-          ChiLogicalErrorIf(not options_.save_angular_flux,
+          ChiLogicalErrorIf(not SavesAngularFlux(groupset.id_),
                             "When using sweep_type \"CBC\" then "
-                            "\"save_angular_flux\" must be true.");
+                            "\"save_angular_flux\" must be true for all "
+                            "groupsets.");
           using namespace chi_mesh::sweep_management;
           std::shared_ptr<FLUDS> fluds = std::make_shared<CBC_FLUDS>(
             gs_ss_size,
@@ -126,12 +178,41 @@ void lbs::DiscreteOrdinatesSolver::InitFluxDataStructures(LBSGroupset& groupset)
         }
         else
           ChiInvalidArgument("Unsupported sweeptype \"" + sweep_type_ + "\"");
+
+        if (build_face_cache)
+        {
+          auto& face_cache = dir_subset_face_caches[dir_ss];
+          if (not face_cache)
+            face_cache = MakeAngleSetFaceCache(*sweep_ordering,
+                                               *groupset.quadrature_,
+                                               angle_indices,
+                                               cell_face_offsets);
+          angle_set_group.AngleSets().back()->SetFaceCache(face_cache);
+        }
       } // for an_ss
     }   // for gs_ss
   }     // for so_grouping
 
   groupset.angle_agg_->angle_set_groups.push_back(std::move(angle_set_group));
 
+  //=========================================== Delayed angular fluxes are
+  //                                            Krylov unknowns, which would
+  //                                            differ between angle teams
+  if (num_angle_teams > 1 and
+      groupset.iterative_method_ != IterativeMethod::KRYLOV_RICHARDSON)
+  {
+    const auto local_has_delayed_psi = static_cast<int>(
+      groupset.angle_agg_->GetNumDelayedAngularDOFs().second > 0);
+    int has_delayed_psi = 0;
+    MPI_Allreduce(&local_has_delayed_psi, &has_delayed_psi, 1, MPI_INT,
+                  MPI_MAX, Chi::mpi.cross_team_comm);
+    ChiInvalidArgumentIf(has_delayed_psi,
+                         "Groupset " + std::to_string(groupset.id_) +
+                         " has delayed angular fluxes, which angle teams "
+                         "only support with the richardson iterative "
+                         "method.");
+  }
+
   if (options_.verbose_inner_iterations)
     Chi::log.Log() << Chi::program_timer.GetTimeString()
                    << " Initialized Angle Aggregation.   "
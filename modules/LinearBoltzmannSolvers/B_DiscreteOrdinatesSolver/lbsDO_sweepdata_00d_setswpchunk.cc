@@ -1,8 +1,14 @@
 #include "lbs_discrete_ordinates_solver.h"
 
 #include "SweepChunks/AAH_SweepChunk.h"
+#include "SweepChunks/AAH_DDSweepChunk.h"
+#include "SweepChunks/AAH_BatchedSweepChunk.h"
+#include "SweepChunks/AAH_LevelSweepChunk.h"
 #include "SweepChunks/CBC_SweepChunk.h"
 
+#include "mesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
 #include "chi_log_exceptions.h"
 
 typedef chi_mesh::sweep_management::SweepChunk SweepChunk;
@@ -12,27 +18,117 @@ typedef chi_mesh::sweep_management::SweepChunk SweepChunk;
 std::shared_ptr<SweepChunk>
 lbs::DiscreteOrdinatesSolver::SetSweepChunk(LBSGroupset& groupset)
 {
-  if (sweep_type_ == "AAH")
+  return MakeSweepChunk(groupset, psi_new_local_[groupset.id_]);
+}
+
+// ###################################################################
+/**Makes the sweep chunk of the sweep type for the given groupset, writing
+ * angular fluxes to the given vector unless it is empty.*/
+std::shared_ptr<SweepChunk>
+lbs::DiscreteOrdinatesSolver::MakeSweepChunk(
+  LBSGroupset& groupset, std::vector<double>& destination_psi)
+{
+  if (sweep_type_ == "AAH" and sweep_chunk_mode_ == "ANGLE_BATCHED")
+  {
+    auto sweep_chunk = std::make_shared<AAH_BatchedSweepChunk>(
+      *grid_ptr_,                   // Spatial grid of cells
+      *discretization_,             // Spatial discretization
+      unit_cell_matrices_,   // Unit cell matrices
+      cell_transport_views_,        // Cell transport views
+      phi_new_local_,               // Destination phi
+      destination_psi,              // Destination psi
+      q_moments_local_,             // Source moments
+      groupset,                     // Reference groupset
+      matid_to_xs_map_,             // Material cross-sections
+      num_moments_,
+      max_cell_dof_count_);
+
+    return sweep_chunk;
+  }
+  else if (sweep_type_ == "AAH" and
+           sweep_chunk_mode_ == "LEVEL_ANGLE_BATCHED")
+  {
+    auto sweep_chunk = std::make_shared<AAH_LevelBatchedSweepChunk>(
+      *grid_ptr_,                   // Spatial grid of cells
+      *discretization_,             // Spatial discretization
+      unit_cell_matrices_,   // Unit cell matrices
+      cell_transport_views_,        // Cell transport views
+      phi_new_local_,               // Destination phi
+      destination_psi,              // Destination psi
+      q_moments_local_,             // Source moments
+      groupset,                     // Reference groupset
+      matid_to_xs_map_,             // Material cross-sections
+      num_moments_,
+      max_cell_dof_count_);
+
+    return sweep_chunk;
+  }
+  else if (sweep_type_ == "AAH" and sweep_chunk_mode_ == "LEVEL_BATCHED")
+  {
+    auto sweep_chunk = std::make_shared<AAH_LevelSweepChunk>(
+      *grid_ptr_,                   // Spatial grid of cells
+      *discretization_,             // Spatial discretization
+      unit_cell_matrices_,   // Unit cell matrices
+      cell_transport_views_,        // Cell transport views
+      phi_new_local_,               // Destination phi
+      destination_psi,              // Destination psi
+      q_moments_local_,             // Source moments
+      groupset,                     // Reference groupset
+      matid_to_xs_map_,             // Material cross-sections
+      num_moments_,
+      max_cell_dof_count_);
+
+    return sweep_chunk;
+  }
+  else if (sweep_type_ == "AAH" and sweep_chunk_mode_ == "DIAMOND_DIFFERENCE")
+  {
+    ChiInvalidArgumentIf(not(grid_ptr_->Attributes() & chi_mesh::ORTHOGONAL),
+                         "Sweep chunk mode \"DIAMOND_DIFFERENCE\" requires "
+                         "an orthogonal mesh.");
+
+    auto sweep_chunk = std::make_shared<AAH_DDSweepChunk>(
+      *grid_ptr_,                   // Spatial grid of cells
+      *discretization_,             // Spatial discretization
+      unit_cell_matrices_,   // Unit cell matrices
+      cell_transport_views_,        // Cell transport views
+      phi_new_local_,               // Destination phi
+      destination_psi,              // Destination psi
+      q_moments_local_,             // Source moments
+      groupset,                     // Reference groupset
+      matid_to_xs_map_,             // Material cross-sections
+      num_moments_,
+      max_cell_dof_count_);
+
+    sweep_chunk->SetLocalCycleIterations(sweep_local_cycle_iterations_);
+
+    return sweep_chunk;
+  }
+  else if (sweep_type_ == "AAH")
   {
     auto sweep_chunk = std::make_shared<AAH_SweepChunk>(
       *grid_ptr_,                   // Spatial grid of cells
       *discretization_,             // Spatial discretization
-      unit_cell_matrices_,          // Unit cell matrices
+      unit_cell_matrices_,   // Unit cell matrices
       cell_transport_views_,        // Cell transport views
       phi_new_local_,               // Destination phi
-      psi_new_local_[groupset.id_], // Destination psi
+      destination_psi,              // Destination psi
       q_moments_local_,             // Source moments
       groupset,                     // Reference groupset
       matid_to_xs_map_,             // Material cross-sections
       num_moments_,
       max_cell_dof_count_);
 
+    if (sweep_chunk_mode_ == "GROUP_BATCHED")
+      sweep_chunk->SetGroupBatchedSolve(true);
+    sweep_chunk->SetLocalCycleIterations(sweep_local_cycle_iterations_);
+    sweep_chunk->SetTimeDerivativeTerm(&time_derivative_);
+
     return sweep_chunk;
   }
   else if (sweep_type_ == "CBC")
   {
     auto sweep_chunk = std::make_shared<CBC_SweepChunk>(
-      phi_new_local_, psi_new_local_[groupset.id_],
+      phi_new_local_, destination_psi,
       *grid_ptr_,
       *discretization_,
       unit_cell_matrices_,
@@ -43,8 +139,37 @@ lbs::DiscreteOrdinatesSolver::SetSweepChunk(LBSGroupset& groupset)
       num_moments_,
       max_cell_dof_count_);
 
+    if (sweep_chunk_mode_ == "GROUP_BATCHED")
+      sweep_chunk->SetGroupBatchedSolve(true);
+    sweep_chunk->SetTimeDerivativeTerm(&time_derivative_);
+
     return sweep_chunk;
   }
   else
     ChiLogicalError("Unsupported sweep_type_ \"" + sweep_type_ + "\"");
-}
\ No newline at end of file
+}
+// ###################################################################
+/**Makes the worker chunks for threaded sweeps of the given groupset, if
+ * more than one sweep thread is requested. Level batched chunks thread
+ * internally and receive the workers, otherwise the scheduler does.*/
+void lbs::DiscreteOrdinatesSolver::SetSweepWorkerChunks(
+  LBSGroupset& groupset,
+  SweepChunk& sweep_chunk,
+  chi_mesh::sweep_management::SweepScheduler& sweep_scheduler)
+{
+  if (options_.sweep_num_threads <= 1) return;
+
+  std::vector<std::shared_ptr<SweepChunk>> worker_chunks;
+  for (int t = 1; t < options_.sweep_num_threads; ++t)
+  {
+    worker_chunks.push_back(SetSweepChunk(groupset));
+    FuseSourceEvaluation(*worker_chunks.back(), groupset);
+    SetCellFactorCache(*worker_chunks.back(), groupset);
+  }
+
+  auto level_chunk = dynamic_cast<LevelSweepChunkInterface*>(&sweep_chunk);
+  if (level_chunk != nullptr)
+    level_chunk->SetWorkerChunks(worker_chunks);
+  else
+    sweep_scheduler.SetWorkerSweepChunks(std::move(worker_chunks));
+}
@@ -0,0 +1,116 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "mesh/SweepUtilities/AngleSet/AngleSet.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "math/Quadratures/angular_quadrature_base.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace lbs
+{
+
+// ###################################################################
+/**Determines whether the face caches of all the angle sets of a groupset
+ * fit within the specified memory budget.*/
+bool DiscreteOrdinatesSolver::FaceCacheFitsBudget(
+  const LBSGroupset& groupset) const
+{
+  size_t num_local_faces = 0;
+  for (const auto& cell : grid_ptr_->local_cells)
+    num_local_faces += cell.faces_.size();
+
+  const auto& unique_so_groupings =
+    quadrature_unq_so_grouping_map_.at(groupset.quadrature_).first;
+
+  size_t num_directions = 0;
+  for (const auto& so_grouping : unique_so_groupings)
+    num_directions += so_grouping.size();
+
+  const size_t num_angle_subsets =
+    unique_so_groupings.size() * groupset.master_num_ang_subsets_;
+
+  using chi_mesh::sweep_management::FaceOrientation;
+  const double cache_size_mb =
+    static_cast<double>(num_local_faces * num_directions * sizeof(double) +
+                        num_local_faces * num_angle_subsets *
+                          sizeof(FaceOrientation)) /
+    (1024.0 * 1024.0);
+
+  if (cache_size_mb > sweep_face_cache_max_mb_)
+  {
+    Chi::log.LogAllWarning()
+      << "Sweep face cache for groupset " << groupset.id_ << " requires "
+      << cache_size_mb << " MB which exceeds sweep_face_cache_max_mb="
+      << sweep_face_cache_max_mb_ << ". The cache will not be built.";
+    return false;
+  }
+
+  return true;
+}
+
+// ###################################################################
+/**Makes the offsets, per local cell, into the flat face arrays. The last
+ * entry holds the total number of local faces.*/
+std::shared_ptr<const std::vector<size_t>>
+DiscreteOrdinatesSolver::MakeCellFaceOffsets() const
+{
+  const auto& local_cells = grid_ptr_->local_cells;
+
+  auto offsets = std::make_shared<std::vector<size_t>>(local_cells.size() + 1);
+  size_t offset = 0;
+  for (const auto& cell : local_cells)
+  {
+    (*offsets)[cell.local_id_] = offset;
+    offset += cell.faces_.size();
+  }
+  offsets->back() = offset;
+
+  return offsets;
+}
+
+// ###################################################################
+/**Builds the face cache of an angle set for the given directions and
+ * sweep ordering.*/
+std::shared_ptr<const chi_mesh::sweep_management::AngleSetFaceCache>
+DiscreteOrdinatesSolver::MakeAngleSetFaceCache(
+  const chi_mesh::sweep_management::SPDS& spds,
+  const chi_math::AngularQuadrature& quadrature,
+  const std::vector<size_t>& angle_indices,
+  std::shared_ptr<const std::vector<size_t>> cell_face_offsets) const
+{
+  using namespace chi_mesh::sweep_management;
+
+  const size_t num_angles = angle_indices.size();
+  const size_t num_faces = cell_face_offsets->back();
+  const auto& cell_face_orientations = spds.CellFaceOrientations();
+
+  auto face_cache = std::make_shared<AngleSetFaceCache>();
+  face_cache->num_angles = num_angles;
+  face_cache->face_mu.assign(num_faces * num_angles, 0.0);
+  face_cache->face_orientations.assign(num_faces, FaceOrientation::PARALLEL);
+
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const size_t offset = (*cell_face_offsets)[cell.local_id_];
+    const size_t num_cell_faces = cell.faces_.size();
+    for (size_t f = 0; f < num_cell_faces; ++f)
+    {
+      const size_t k = offset + f;
+      const auto& normal = cell.faces_[f].normal_;
+
+      face_cache->face_orientations[k] =
+        cell_face_orientations[cell.local_id_][f];
+      for (size_t a = 0; a < num_angles; ++a)
+        face_cache->face_mu[k * num_angles + a] =
+          quadrature.omegas_[angle_indices[a]].Dot(normal);
+    }
+  }
+
+  face_cache->cell_face_offsets = std::move(cell_face_offsets);
+
+  return face_cache;
+}
+
+} // namespace lbs
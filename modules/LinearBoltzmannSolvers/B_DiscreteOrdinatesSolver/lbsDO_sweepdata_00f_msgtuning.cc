@@ -0,0 +1,61 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+#include "mesh/SweepUtilities/Communicators/SweepLinkTuning.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <sstream>
+
+namespace lbs
+{
+
+// ###################################################################
+/**Measures the links to all the locations this location exchanges sweep
+ * data with and selects a message size limit per link. The measurements
+ * are recorded in the "Sweep Link Tuning" event log.*/
+void DiscreteOrdinatesSolver::TuneSweepMessageSizes()
+{
+  //============================================= Collect neighbor locations
+  std::set<int> neighbor_locations;
+  for (const auto& [quadrature, spds_list] : quadrature_spds_map_)
+    for (const auto& spds : spds_list)
+    {
+      for (int locJ : spds->GetLocationDependencies())
+        neighbor_locations.insert(locJ);
+      for (int locJ : spds->GetLocationSuccessors())
+        neighbor_locations.insert(locJ);
+      for (int locJ : spds->GetDelayedLocationDependencies())
+        neighbor_locations.insert(locJ);
+    }
+
+  //============================================= Measure
+  // Sizes up to 16 times the default eager-limit are benchmarked
+  Chi::log.Log() << "Tuning sweep message sizes.";
+  const int max_message_size = 16 * options_.sweep_eager_limit;
+  const auto measurements = chi_mesh::sweep_management::
+    MeasureSweepNeighborLinks(neighbor_locations, max_message_size);
+
+  //============================================= Record
+  const size_t event_tag = Chi::log.GetRepeatingEventTag("Sweep Link Tuning");
+
+  sweep_location_eager_limits_.clear();
+  for (const auto& [locJ, measurement] : measurements)
+  {
+    sweep_location_eager_limits_[locJ] = measurement.eager_limit;
+
+    std::stringstream outstr;
+    outstr << "locJ=" << locJ << " latency_us=" << measurement.latency_us
+           << " bandwidth_MBps=" << measurement.bandwidth_mbps
+           << " eager_limit=" << measurement.eager_limit;
+
+    Chi::log.LogEvent(event_tag,
+                      chi::ChiLog::EventType::SINGLE_OCCURRENCE,
+                      std::make_shared<chi::ChiLog::EventInfo>(
+                        outstr.str(), measurement.eager_limit));
+    Chi::log.LogAllVerbose1() << "Sweep link " << outstr.str();
+  }
+}
+
+} // namespace lbs
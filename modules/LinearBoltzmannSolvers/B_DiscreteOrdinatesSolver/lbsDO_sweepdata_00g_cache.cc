@@ -0,0 +1,83 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <tuple>
+
+namespace lbs
+{
+
+namespace
+{
+/**Grid, quadrature, angle aggregation type, cycles option, sweep type,
+ * geometry type, levelized orderings option and block-Jacobi option.*/
+typedef std::tuple<const chi_mesh::MeshContinuum*,
+                   const chi_math::AngularQuadrature*,
+                   AngleAggregationType,
+                   bool,
+                   std::string,
+                   GeometryType,
+                   bool,
+                   bool>
+  SweepDataKey;
+
+/**Process wide cache of sweep data. Entries are held weakly, hence the sweep
+ * data is released together with the last solver using it. Since an entry
+ * keeps its grid and quadrature alive, an unexpired entry can never be
+ * matched by a different grid or quadrature at the same address.*/
+template <typename SweepData>
+std::map<SweepDataKey, std::weak_ptr<const SweepData>>& SweepDataCache()
+{
+  static std::map<SweepDataKey, std::weak_ptr<const SweepData>> cache;
+  return cache;
+}
+} // namespace
+
+// ###################################################################
+/**Returns the sweep data of the quadrature of the given groupset. The sweep
+ * data of an earlier solver, or groupset, on the same grid with the same
+ * quadrature, angle aggregation type and cycles option is reused when
+ * available, otherwise it is built and added to the cache.
+ *
+ * Building the sweep data is collective. Cache hits are consistent across
+ * locations since all the locations create the same solvers in the same
+ * order.*/
+DiscreteOrdinatesSolver::SweepDataPtr
+DiscreteOrdinatesSolver::GetSweepData(const LBSGroupset& groupset)
+{
+  if (not sweep_data_cache_) return MakeSweepData(groupset);
+
+  auto& cache = SweepDataCache<SweepData>();
+
+  //=================================== Drop released entries
+  for (auto it = cache.begin(); it != cache.end();)
+    if (it->second.expired()) it = cache.erase(it);
+    else
+      ++it;
+
+  const SweepDataKey key{grid_ptr_.get(),
+                         groupset.quadrature_.get(),
+                         groupset.angleagg_method_,
+                         groupset.allow_cycles_,
+                         sweep_type_,
+                         options_.geometry_type,
+                         LevelizedSweeps(),
+                         sweep_block_jacobi_};
+
+  //=================================== Reuse
+  const auto it = cache.find(key);
+  if (it != cache.end())
+  {
+    Chi::log.Log0Verbose1() << "Reusing cached sweep datastructures.";
+    return it->second.lock();
+  }
+
+  //=================================== Build
+  auto sweep_data = MakeSweepData(groupset);
+  cache[key] = sweep_data;
+
+  return sweep_data;
+}
+
+} // namespace lbs
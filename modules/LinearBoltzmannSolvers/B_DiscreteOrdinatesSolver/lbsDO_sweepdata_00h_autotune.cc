@@ -0,0 +1,130 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "LinearBoltzmannSolvers/A_LBSSolver/Groupset/lbs_groupset.h"
+#include "LinearBoltzmannSolvers/A_LBSSolver/Tools/lbs_make_subset.h"
+
+#include "mesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+
+namespace lbs
+{
+
+// ###################################################################
+/**Selects the angle and group subset counts of a groupset by timing trial
+ * sweeps of a few candidate configurations, which include the configured
+ * one. Each candidate's flux data structures are built and swept, without
+ * sources, once to warm up and then `num_timed_sweeps` times. The slowest
+ * location determines the time of a candidate so that all locations select
+ * the same configuration. The flux data structures are then rebuilt with
+ * the fastest configuration.*/
+void DiscreteOrdinatesSolver::AutoTuneAngleSets(LBSGroupset& groupset)
+{
+  typedef chi_mesh::sweep_management::SweepScheduler SweepScheduler;
+  constexpr int num_timed_sweeps = 2;
+
+  if (sweep_type_ != "AAH")
+  {
+    Chi::log.Log0Warning() << "angle_set_auto_tune is only supported by the "
+                              "\"AAH\" sweep type.";
+    return;
+  }
+
+  //============================================= Candidates
+  const auto& unique_so_groupings =
+    quadrature_unq_so_grouping_map_[groupset.quadrature_].first;
+  size_t max_so_grouping_size = 1;
+  for (const auto& so_grouping : unique_so_groupings)
+    max_so_grouping_size = std::max(max_so_grouping_size, so_grouping.size());
+
+  const int configured_ang_subsets = groupset.master_num_ang_subsets_;
+  const int configured_grp_subsets = groupset.master_num_grp_subsets_;
+
+  std::vector<std::pair<int, int>> candidates = {
+    {configured_ang_subsets, configured_grp_subsets}};
+  for (const int num_ang_subsets : {1, 2, 4})
+    for (const int num_grp_subsets : {1, 2, 4})
+    {
+      if (num_ang_subsets > max_so_grouping_size) continue;
+      if (num_grp_subsets > groupset.groups_.size()) continue;
+      if (num_ang_subsets == configured_ang_subsets and
+          num_grp_subsets == configured_grp_subsets)
+        continue;
+      candidates.emplace_back(num_ang_subsets, num_grp_subsets);
+    }
+
+  //============================================= Time candidates
+  Chi::log.Log() << "Auto-tuning angle sets of groupset " << groupset.id_
+                 << " with " << candidates.size() << " candidates.";
+
+  std::vector<double> scratch_phi(PhiNewLocal().size(), 0.0);
+  double best_time = 0.0;
+  std::pair<int, int> best_candidate;
+  for (size_t c = 0; c < candidates.size(); ++c)
+  {
+    const auto [num_ang_subsets, num_grp_subsets] = candidates[c];
+
+    groupset.master_num_ang_subsets_ = num_ang_subsets;
+    groupset.master_num_grp_subsets_ = num_grp_subsets;
+    groupset.grp_subset_infos_ =
+      lbs::MakeSubSets(groupset.groups_.size(), num_grp_subsets);
+
+    ResetSweepOrderings(groupset);
+    InitFluxDataStructures(groupset);
+
+    auto sweep_chunk = SetSweepChunk(groupset);
+    SweepScheduler sweep_scheduler(
+      SweepSchedulingAlgorithm(), *groupset.angle_agg_, *sweep_chunk);
+    SetSweepWorkerChunks(groupset, *sweep_chunk, sweep_scheduler);
+    sweep_scheduler.SetBoundarySourceActiveFlag(false);
+    sweep_scheduler.SetDestinationPhi(scratch_phi);
+
+    double warmup_time = 0.0;
+    for (int s = 0; s <= num_timed_sweeps; ++s)
+    {
+      sweep_scheduler.ZeroOutputFluxDataStructures();
+      sweep_scheduler.Sweep();
+      if (s == 0) warmup_time = sweep_scheduler.GetAngleSetTimings()[0];
+    }
+
+    const double local_time =
+      sweep_scheduler.GetAngleSetTimings()[0] - warmup_time;
+    double candidate_time = 0.0;
+    MPI_Allreduce(
+      &local_time, &candidate_time, 1, MPI_DOUBLE, MPI_MAX, Chi::mpi.comm);
+    if (Chi::mpi.num_angle_teams > 1)
+      MPI_Allreduce(MPI_IN_PLACE, &candidate_time, 1, MPI_DOUBLE, MPI_MAX,
+                    Chi::mpi.cross_team_comm);
+    candidate_time /= num_timed_sweeps;
+
+    Chi::log.Log0Verbose1()
+      << "  angle_aggregation_num_subsets=" << num_ang_subsets
+      << " groupset_num_subsets=" << num_grp_subsets
+      << " sweep time=" << candidate_time;
+
+    if (c == 0 or candidate_time < best_time)
+    {
+      best_time = candidate_time;
+      best_candidate = candidates[c];
+    }
+  }
+
+  //============================================= Lock in the fastest
+  groupset.master_num_ang_subsets_ = best_candidate.first;
+  groupset.master_num_grp_subsets_ = best_candidate.second;
+  groupset.BuildSubsets();
+
+  ResetSweepOrderings(groupset);
+  InitFluxDataStructures(groupset);
+
+  Chi::log.Log() << "Auto-tuned angle sets of groupset " << groupset.id_
+                 << ": angle_aggregation_num_subsets=" << best_candidate.first
+                 << " groupset_num_subsets=" << best_candidate.second
+                 << " (sweep time " << best_time << " s)";
+}
+
+} // namespace lbs
@@ -0,0 +1,111 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "LinearBoltzmannSolvers/A_LBSSolver/Groupset/lbs_groupset.h"
+
+#include "mesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+namespace lbs
+{
+
+// ###################################################################
+/**Selects whether the reflecting boundaries use the angular fluxes of the
+ * previous iteration, as the opposing one of two parallel reflecting
+ * boundaries always does, instead of blocking the angle sets until their
+ * reflected angles are swept. Lagged fluxes break the dependency chains
+ * that otherwise serialize the sweeps, and become delayed angular
+ * unknowns of the within-groupset solves.
+ *
+ * With "AUTO", the boundaries are lagged only when every groupset uses a
+ * Krylov method other than richardson, which iterates on the delayed
+ * unknowns such that lagging barely affects convergence, and when a trial
+ * sweep of the first groupset is stalled on the reflecting boundaries for
+ * more than `max_wait_fraction` of its time on the slowest location. The
+ * flux data structures are then rebuilt.*/
+void DiscreteOrdinatesSolver::SelectReflectingBCLagging()
+{
+  typedef chi_mesh::sweep_management::BoundaryReflecting BoundaryReflecting;
+  typedef chi_mesh::sweep_management::SweepScheduler SweepScheduler;
+  constexpr double max_wait_fraction = 0.1;
+
+  if (reflecting_bc_lagging_ == "NONE" or groupsets_.empty()) return;
+
+  std::vector<BoundaryReflecting*> blocking_boundaries;
+  for (auto& [bid, bndry] : sweep_boundaries_)
+    if (bndry->IsReflecting())
+    {
+      auto& rbndry = dynamic_cast<BoundaryReflecting&>(*bndry);
+      if (not rbndry.IsOpposingReflected())
+        blocking_boundaries.push_back(&rbndry);
+    }
+  if (blocking_boundaries.empty()) return;
+
+  //============================================= Heuristic
+  if (reflecting_bc_lagging_ == "AUTO")
+  {
+    for (const auto& groupset : groupsets_)
+      switch (groupset.iterative_method_)
+      {
+        case IterativeMethod::GMRES:
+        case IterativeMethod::GMRES_CYCLES:
+        case IterativeMethod::KRYLOV_GMRES:
+        case IterativeMethod::KRYLOV_GMRES_CYCLES:
+        case IterativeMethod::KRYLOV_BICGSTAB:
+        case IterativeMethod::KRYLOV_BICGSTAB_CYCLES:
+          break;
+        default:
+          return;
+      }
+
+    auto& groupset = groupsets_.front();
+    std::vector<double> scratch_phi(PhiNewLocal().size(), 0.0);
+
+    auto sweep_chunk = SetSweepChunk(groupset);
+    SweepScheduler sweep_scheduler(
+      SweepSchedulingAlgorithm(), *groupset.angle_agg_, *sweep_chunk);
+    SetSweepWorkerChunks(groupset, *sweep_chunk, sweep_scheduler);
+    sweep_scheduler.SetBoundarySourceActiveFlag(false);
+    sweep_scheduler.SetDestinationPhi(scratch_phi);
+
+    // The first sweep warms up
+    for (int s = 0; s < 2; ++s)
+    {
+      if (s == 1) sweep_scheduler.EnableSweepStatistics(true);
+      sweep_scheduler.ZeroOutputFluxDataStructures();
+      sweep_scheduler.Sweep();
+    }
+
+    const auto& statistics = sweep_scheduler.GetSweepStatistics();
+    const double local_fraction =
+      statistics.sweep_time > 0.0
+        ? statistics.boundary_wait_time / statistics.sweep_time
+        : 0.0;
+    double wait_fraction = 0.0;
+    MPI_Allreduce(&local_fraction, &wait_fraction, 1, MPI_DOUBLE, MPI_MAX,
+                  Chi::mpi.comm);
+
+    Chi::log.Log0Verbose1()
+      << "Sweeps stalled on reflecting boundaries for a fraction "
+      << wait_fraction << " of the sweep time.";
+
+    if (wait_fraction <= max_wait_fraction) return;
+  }
+
+  //============================================= Lag and rebuild
+  for (auto* rbndry : blocking_boundaries) rbndry->SetOpposingReflected(true);
+
+  for (auto& groupset : groupsets_)
+  {
+    ResetSweepOrderings(groupset);
+    InitFluxDataStructures(groupset);
+  }
+
+  Chi::log.Log() << "Lagging the angular fluxes of "
+                 << blocking_boundaries.size()
+                 << " reflecting boundaries to the previous iteration.";
+}
+
+} // namespace lbs
@@ -0,0 +1,91 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace lbs
+{
+
+// ###################################################################
+/**Logs the analytics of every sweep ordering of the given sweep data, see
+ * SPDS::Analytics, one row per ordering. The message volumes are in KB,
+ * for all the directions of the ordering and the groups of the groupset.
+ * The KBA estimate is the number of stages for the angle sets of the
+ * ordering, i.e., its angle and group subsets, to be pipelined through the
+ * location graph, the stages plus the angle sets less one.*/
+void DiscreteOrdinatesSolver::LogSweepOrderingReport(
+  const LBSGroupset& groupset, const SweepData& sweep_data) const
+{
+  const auto& unique_so_groupings = sweep_data.so_grouping_info.first;
+  std::vector<size_t> num_directions;
+  for (const auto& so_grouping : unique_so_groupings)
+    if (not so_grouping.empty()) num_directions.push_back(so_grouping.size());
+
+  const double num_groups = static_cast<double>(groupset.groups_.size());
+  constexpr double KB = 1024.0;
+
+  std::stringstream outstr;
+  outstr << "Sweep ordering report, groupset " << groupset.id_ << ", "
+         << sweep_data.spds_list.size() << " ordering(s) over "
+         << Chi::mpi.process_count << " location(s):\n";
+  outstr << std::right << std::setw(4) << "SO" << std::setw(6) << "Dirs"
+         << std::setw(16) << "Depth avg/max" << std::setw(16)
+         << "Width avg/max" << std::setw(8) << "Stages" << std::setw(8)
+         << "KBA" << std::setw(10) << "Crit path" << std::setw(16)
+         << "Delayed loc/fc" << std::setw(8) << "Cyclic" << std::setw(8)
+         << "Msgs" << std::setw(8) << "Msg/loc" << std::setw(24)
+         << "Msg KB min/avg/max" << "\n";
+
+  for (size_t so = 0; so < sweep_data.spds_list.size(); ++so)
+  {
+    const auto analytics = sweep_data.spds_list[so]->ComputeAnalytics();
+
+    const size_t num_dirs = so < num_directions.size() ? num_directions[so] : 0;
+    const size_t num_angle_sets =
+      std::min<size_t>(num_dirs, groupset.master_num_ang_subsets_) *
+      groupset.master_num_grp_subsets_;
+    const size_t kba_stages =
+      analytics.num_stages + std::max<size_t>(num_angle_sets, 1) - 1;
+
+    // Face nodes to KB for all the directions and groups
+    const double to_KB = num_dirs * num_groups * sizeof(double) / KB;
+
+    std::stringstream depth, width, delayed, volume;
+    depth << std::fixed << std::setprecision(1) << analytics.avg_local_depth
+          << "/" << analytics.max_local_depth;
+    width << std::fixed << std::setprecision(1) << analytics.avg_level_width
+          << "/" << analytics.max_level_width;
+    delayed << analytics.num_delayed_location_edges << "/"
+            << analytics.num_delayed_faces;
+    volume << std::fixed << std::setprecision(1)
+           << analytics.min_message_volume * to_KB << "/"
+           << analytics.avg_message_volume * to_KB << "/"
+           << analytics.max_message_volume * to_KB;
+
+    outstr << std::setw(4) << so << std::setw(6) << num_dirs << std::setw(16)
+           << depth.str() << std::setw(16) << width.str() << std::setw(8)
+           << analytics.num_stages << std::setw(8) << kba_stages
+           << std::setw(10) << analytics.critical_path_length
+           << std::setw(16) << delayed.str() << std::setw(8)
+           << analytics.num_local_cyclic_edges << std::setw(8)
+           << analytics.num_messages << std::setw(8)
+           << analytics.max_location_messages << std::setw(24)
+           << volume.str() << "\n";
+
+    if (analytics.num_locations_in_cycles > 0)
+      outstr << "      " << analytics.num_locations_in_cycles
+             << " location(s) in cyclic location dependencies, excluded "
+                "from the stages and critical path.\n";
+  }
+
+  Chi::log.Log() << outstr.str();
+}
+
+} // namespace lbs
@@ -0,0 +1,52 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "SweepChunks/SweepChunk.h"
+#include "SweepChunks/CellFactorCache.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+// ###################################################################
+/**Makes the LU cache of the within-groupset sweeps of the given groupset,
+ * if requested.*/
+void lbs::DiscreteOrdinatesSolver::InitCellFactorCache(
+  const LBSGroupset& groupset)
+{
+  cell_factor_caches_.erase(groupset.id_);
+  if (not sweep_lu_cache_) return;
+
+  auto cache = std::make_shared<CellFactorCache>(
+    groupset,
+    cell_transport_views_,
+    lbs::SweepChunk::SMALL_DENSE_CAPACITY,
+    sweep_lu_cache_max_mb_);
+
+  Chi::log.Log0Verbose1() << "Groupset " << groupset.id_ << " LU cache: "
+                          << cache->NumCachedCells() << " local cells, "
+                          << cache->SizeMB() << " MB";
+
+  cell_factor_caches_[groupset.id_] = std::move(cache);
+}
+
+// ###################################################################
+/**Makes the sweep chunk use the LU cache of the groupset, if any.*/
+void lbs::DiscreteOrdinatesSolver::SetCellFactorCache(
+  SweepChunk& sweep_chunk, const LBSGroupset& groupset) const
+{
+  const auto it = cell_factor_caches_.find(groupset.id_);
+  if (it == cell_factor_caches_.end()) return;
+
+  auto lbs_sweep_chunk = dynamic_cast<lbs::SweepChunk*>(&sweep_chunk);
+  if (lbs_sweep_chunk) lbs_sweep_chunk->SetCellFactorCache(it->second);
+}
+
+// ###################################################################
+/**Revalidates the LU cache of the groupset, if any, against the current
+ * cell cross sections. Called before every sweep of the within-groupset
+ * solvers.*/
+void lbs::DiscreteOrdinatesSolver::UpdateCellFactorCache(
+  const LBSGroupset& groupset)
+{
+  const auto it = cell_factor_caches_.find(groupset.id_);
+  if (it != cell_factor_caches_.end()) it->second->Update();
+}
@@ -0,0 +1,159 @@
+#include "lbs_discrete_ordinates_solver.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "mesh/SweepUtilities/SPDS/SPDS.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace lbs
+{
+
+// ###################################################################
+/**Resolves the "AUTO" sweep type to "AAH" or "CBC" for all the groupsets.
+ * Options only supported by AAH select AAH outright. Otherwise the AAH
+ * sweep orderings are built and the sweep time of each sweeper is
+ * estimated from their analytics, see SPDS::Analytics, in units of cell
+ * solves of the location with the most cells:
+ *
+ * - AAH pipelines the angle sets of an ordering through the location
+ *   graph, i.e., `work (stages + A - 1) / A` for `A` angle sets, where the
+ *   work is the cells times the directions and groups of the ordering.
+ * - CBC pipelines the cells, hence its fill time is the critical path of
+ *   the ordering rather than its stages, but it pays for the per cell task
+ *   bookkeeping and messages, i.e.,
+ *   `work (1 + overhead) + critical_path work / (cells A)`.
+ *
+ * Returns the AAH sweep data per quadrature if AAH is selected, such that
+ * it is not rebuilt. Collective.*/
+std::map<DiscreteOrdinatesSolver::AngQuadPtr,
+         DiscreteOrdinatesSolver::SweepDataPtr>
+DiscreteOrdinatesSolver::SelectSweepType()
+{
+  // Cost of the per cell tasks and messages of CBC relative to the sweep
+  // of the same cells by AAH
+  constexpr double CBC_TASK_OVERHEAD = 0.25;
+
+  std::map<AngQuadPtr, SweepDataPtr> aah_sweep_data;
+
+  //=================================== Options only supported by AAH
+  std::string reason;
+  if (LevelizedSweeps() or sweep_chunk_mode_ == "ANGLE_BATCHED" or
+      sweep_chunk_mode_ == "DIAMOND_DIFFERENCE")
+    reason = "sweep_chunk_mode \"" + sweep_chunk_mode_ + "\" is AAH only";
+  if (sweep_block_jacobi_) reason = "block-Jacobi sweeps are AAH only";
+  if (sweep_scheduling_ != "DEFAULT" and
+      sweep_scheduling_ != "FIRST_IN_FIRST_OUT")
+    reason = "sweep_scheduling \"" + sweep_scheduling_ + "\" is AAH only";
+  for (const auto& groupset : groupsets_)
+  {
+    const std::string gs = "groupset " + std::to_string(groupset.id_);
+    if (groupset.apply_angular_mg_) reason = gs + " uses angular multigrid";
+    if (groupset.angle_set_auto_tune_)
+      reason = gs + " uses angle_set_auto_tune";
+    if (groupset.angular_flux_single_precision_)
+      reason = gs + " uses single precision angular fluxes";
+  }
+
+  sweep_type_ = "AAH";
+  if (not reason.empty())
+  {
+    Chi::log.Log() << "Automatic sweep type: AAH, since " << reason << ".";
+    return aah_sweep_data;
+  }
+
+  //=================================== Largest local cell count
+  unsigned long long int max_num_cells = grid_ptr_->local_cells.size();
+  MPI_Allreduce(MPI_IN_PLACE, &max_num_cells, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_MAX, Chi::mpi.comm);
+  const double num_cells = std::max(static_cast<double>(max_num_cells), 1.0);
+
+  //=================================== Estimates per groupset
+  std::stringstream outstr;
+  outstr << "Automatic sweep type selection over " << Chi::mpi.process_count
+         << " location(s), estimated sweep times relative to the sweep "
+            "without pipeline fill:\n";
+  outstr << std::right << std::setw(10) << "Groupset" << std::setw(8)
+         << "Stages" << std::setw(12) << "Crit path" << std::setw(12)
+         << "Angle sets" << std::setw(8) << "AAH" << std::setw(8) << "CBC"
+         << "\n";
+
+  double aah_time = 0.0, cbc_time = 0.0;
+  for (const auto& groupset : groupsets_)
+  {
+    auto& sweep_data = aah_sweep_data[groupset.quadrature_];
+    if (not sweep_data) sweep_data = GetSweepData(groupset);
+
+    std::vector<size_t> num_directions;
+    for (const auto& so_grouping : sweep_data->so_grouping_info.first)
+      if (not so_grouping.empty())
+        num_directions.push_back(so_grouping.size());
+
+    const double num_groups = static_cast<double>(groupset.groups_.size());
+    double gs_work = 0.0, gs_aah_time = 0.0, gs_cbc_time = 0.0;
+    size_t max_stages = 0, max_critical_path = 0, max_angle_sets = 0;
+    for (size_t so = 0; so < sweep_data->spds_list.size(); ++so)
+    {
+      const auto analytics = sweep_data->spds_list[so]->ComputeAnalytics();
+      if (analytics.num_locations_in_cycles > 0)
+        reason = "the location graph of groupset " +
+                 std::to_string(groupset.id_) + " has cycles";
+
+      const size_t num_dirs =
+        so < num_directions.size() ? num_directions[so] : 0;
+      const size_t num_angle_sets = std::max<size_t>(
+        std::min<size_t>(num_dirs, groupset.master_num_ang_subsets_) *
+          groupset.master_num_grp_subsets_,
+        1);
+      const double A = static_cast<double>(num_angle_sets);
+      const double work = num_cells * num_dirs * num_groups;
+      const double stages = static_cast<double>(analytics.num_stages);
+      const double critical_path =
+        static_cast<double>(analytics.critical_path_length);
+
+      gs_work += work;
+      gs_aah_time += work * (stages + A - 1.0) / A;
+      gs_cbc_time += work * (1.0 + CBC_TASK_OVERHEAD) +
+                     critical_path * work / (num_cells * A);
+
+      max_stages = std::max(max_stages, analytics.num_stages);
+      max_critical_path =
+        std::max(max_critical_path, analytics.critical_path_length);
+      max_angle_sets = std::max(max_angle_sets, num_angle_sets);
+    }
+    aah_time += gs_aah_time;
+    cbc_time += gs_cbc_time;
+
+    gs_work = std::max(gs_work, 1.0);
+    outstr << std::setw(10) << groupset.id_ << std::setw(8) << max_stages
+           << std::setw(12) << max_critical_path << std::setw(12)
+           << max_angle_sets << std::fixed << std::setprecision(2)
+           << std::setw(8) << gs_aah_time / gs_work << std::setw(8)
+           << gs_cbc_time / gs_work << "\n";
+  }
+
+  //=================================== Decision
+  if (not reason.empty())
+    outstr << "Selected AAH, since " << reason << ".";
+  else if (cbc_time < aah_time)
+  {
+    sweep_type_ = "CBC";
+    aah_sweep_data.clear();
+    outstr << "Selected CBC, since the cell pipeline fill of the critical "
+              "paths is estimated to cost less than the AAH stages.";
+  }
+  else
+    outstr << "Selected AAH, since the AAH stages are estimated to cost "
+              "less than the CBC task overhead and pipeline fill.";
+
+  Chi::log.Log() << outstr.str();
+
+  return aah_sweep_data;
+}
+
+} // namespace lbs
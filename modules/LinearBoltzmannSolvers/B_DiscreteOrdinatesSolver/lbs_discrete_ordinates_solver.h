@@ -3,10 +3,18 @@
 
 #include "A_LBSSolver/lbs_solver.h"
 
+namespace chi_mesh::sweep_management
+{
+enum class SchedulingAlgorithm;
+class SweepScheduler;
+}
+
 namespace lbs
 {
 
 class CBC_ASynchronousCommunicator;
+class SourceFunction;
+class CellFactorCache;
 
 /**Base class for Discrete Ordinates solvers. This class mostly establishes
  * utilities related to sweeping. From here we can derive a steady-state,
@@ -24,16 +32,59 @@ protected:
   typedef std::vector<SPDS_ptr> SPDS_ptrs;
 
   typedef chi_mesh::sweep_management::FLUDSCommonData FLUDSCommonData;
-  typedef std::unique_ptr<FLUDSCommonData> FLUDSCommonDataPtr;
+  typedef std::shared_ptr<FLUDSCommonData> FLUDSCommonDataPtr;
   typedef std::vector<FLUDSCommonDataPtr> FLUDSCommonDataPtrs;
 
+  /**Sweep data that only depends on the grid, the quadrature, the angle
+   * aggregation type and the cycles option. It is shared by all the solvers
+   * and groupsets with the same such properties. The FLUDS common data
+   * refers to the nodal mappings held here, which outlive the solver that
+   * built them.*/
+  struct SweepData
+  {
+    chi_mesh::MeshContinuumPtr grid;
+    AngQuadPtr quadrature;
+    std::vector<CellFaceNodalMapping> grid_nodal_mappings;
+    SwpOrderGroupingInfo so_grouping_info;
+    SPDS_ptrs spds_list;
+    FLUDSCommonDataPtrs fluds_common_data_list;
+  };
+  typedef std::shared_ptr<const SweepData> SweepDataPtr;
+
 protected:
+  std::map<AngQuadPtr, SweepDataPtr> quadrature_sweep_data_map_;
   std::map<AngQuadPtr, SwpOrderGroupingInfo> quadrature_unq_so_grouping_map_;
   std::map<AngQuadPtr, SPDS_ptrs> quadrature_spds_map_;
   std::map<AngQuadPtr, FLUDSCommonDataPtrs> quadrature_fluds_commondata_map_;
 
   std::vector<size_t> verbose_sweep_angles_;
-  const std::string sweep_type_;
+  /**"AAH" or "CBC", "AUTO" being resolved by SelectSweepType.*/
+  std::string sweep_type_;
+  const std::string sweep_chunk_mode_ = "DEFAULT";
+  const bool sweep_face_cache_ = false;
+  const double sweep_face_cache_max_mb_ = 1024.0;
+  const bool ags_pipelined_sweeps_ = false;
+  const std::string sweep_scheduling_ = "DEFAULT";
+  const int sweep_local_cycle_iterations_ = 0;
+  const bool sweep_data_cache_ = true;
+  const bool sweep_ordering_report_ = false;
+  const std::string reflecting_bc_lagging_ = "NONE";
+  const bool sweep_block_jacobi_ = false;
+  const bool fused_source_evaluation_ = false;
+  /**The source function, when its evaluations by the within-groupset
+   * solvers are fused into the sweeps, and the set source function handed
+   * to these solvers, which defers the evaluations.*/
+  std::shared_ptr<SourceFunction> fused_source_function_;
+  SetSourceFunction sweep_set_source_function_;
+  const bool sweep_lu_cache_ = false;
+  const double sweep_lu_cache_max_mb_ = 1024.0;
+  /**LU caches of the within-groupset sweeps per groupset id.*/
+  std::map<int, std::shared_ptr<CellFactorCache>> cell_factor_caches_;
+  /**Per neighbor location message size limits, when tuned.*/
+  std::map<int, unsigned long long int> sweep_location_eager_limits_;
+  /**Time derivative term of the sweeps, inactive unless set by a transient
+   * executor.*/
+  TimeDerivativeTerm time_derivative_;
 
 public:
   static chi::InputParameters GetInputParameters();
@@ -44,6 +95,9 @@ protected:
 
 public:
   const std::string& SweepType() const {return sweep_type_;}
+  chi_mesh::sweep_management::SchedulingAlgorithm
+  SweepSchedulingAlgorithm() const;
+  bool LevelizedSweeps() const;
   virtual ~DiscreteOrdinatesSolver() override;
 
   std::pair<size_t, size_t> GetNumPhiIterativeUnknowns() override;
@@ -51,20 +105,66 @@ public:
   // 01
   void Initialize() override;
 
+protected:
+  // 01b
+  void InitializeSourceFunction(std::shared_ptr<SourceFunction> src_function);
+  void FuseSourceEvaluation(SweepChunk& sweep_chunk,
+                            const LBSGroupset& groupset) const;
+public:
+  void ReplaceSourceFunction(std::shared_ptr<SourceFunction> src_function);
+  void CompleteDeferredSources(const LBSGroupset& groupset);
+  void UpdateCellFactorCache(const LBSGroupset& groupset);
+
+  // 02 Time derivative
+  virtual void CheckTimeDerivativeSupport() const;
+  TimeDerivativeTerm& GetTimeDerivativeTerm() { return time_derivative_; }
+
 protected:
   // 01j
   void InitializeWGSSolvers() override;
+  void InitializeSolverSchemes() override;
+  bool PipelinedSweepsSupported() const;
+  // 01k
+  void AccountMemoryUsage() const override;
 
   // Sweep Data
   void InitializeSweepDataStructures();
+  SweepDataPtr GetSweepData(const LBSGroupset& groupset);
+  SweepDataPtr MakeSweepData(const LBSGroupset& groupset) const;
+  void LogSweepOrderingReport(const LBSGroupset& groupset,
+                              const SweepData& sweep_data) const;
   static std::pair<UniqueSOGroupings, DirIDToSOMap>
   AssociateSOsAndDirections(const chi_mesh::MeshContinuum& grid,
                             const chi_math::AngularQuadrature& quadrature,
                             AngleAggregationType agg_type,
                             lbs::GeometryType lbs_geo_type);
+  void TuneSweepMessageSizes();
+  void AutoTuneAngleSets(LBSGroupset& groupset);
+  void SelectReflectingBCLagging();
   void InitFluxDataStructures(LBSGroupset& groupset);
+  bool FaceCacheFitsBudget(const LBSGroupset& groupset) const;
+  std::shared_ptr<const std::vector<size_t>> MakeCellFaceOffsets() const;
+  std::shared_ptr<const chi_mesh::sweep_management::AngleSetFaceCache>
+  MakeAngleSetFaceCache(
+    const chi_mesh::sweep_management::SPDS& spds,
+    const chi_math::AngularQuadrature& quadrature,
+    const std::vector<size_t>& angle_indices,
+    std::shared_ptr<const std::vector<size_t>> cell_face_offsets) const;
   void ResetSweepOrderings(LBSGroupset& groupset);
   virtual std::shared_ptr<SweepChunk> SetSweepChunk(LBSGroupset& groupset);
+  std::shared_ptr<SweepChunk>
+  MakeSweepChunk(LBSGroupset& groupset, std::vector<double>& destination_psi);
+  void SetSweepWorkerChunks(
+    LBSGroupset& groupset,
+    SweepChunk& sweep_chunk,
+    chi_mesh::sweep_management::SweepScheduler& sweep_scheduler);
+  void InitCellFactorCache(const LBSGroupset& groupset);
+  void SetCellFactorCache(SweepChunk& sweep_chunk,
+                          const LBSGroupset& groupset) const;
+  std::map<AngQuadPtr, SweepDataPtr> SelectSweepType();
+
+  // Angular multigrid
+  void InitAngularMG(LBSGroupset& groupset);
 
   // Vector assembly
 public:
@@ -1,6 +1,7 @@
 #ifndef LBADJOINTSOLVER_H
 #define LBADJOINTSOLVER_H
 
+#include <array>
 #include <utility>
 
 #include "B_DiscreteOrdinatesSolver/lbs_discrete_ordinates_solver.h"
@@ -18,6 +19,8 @@ class DiscreteOrdinatesAdjointSolver : public lbs::DiscreteOrdinatesSolver
 protected:
   typedef std::vector<size_t> VecSize_t;
   typedef std::pair<ResponseFunctionDesignation, VecSize_t> RespFuncAndSubs;
+  /**Per group phi, J_x, J_y and J_z.*/
+  typedef std::vector<std::array<double, 4>> MGP1Moments;
   std::vector<RespFuncAndSubs> response_functions_;
 
 public:
@@ -39,8 +42,15 @@ public:
 
   void Initialize() override;
   void MakeAdjointXSs();
+protected:
+  /**Wraps the updated forward cross sections in adjoint cross sections.*/
+  void UpdateCellCrossSections() override { MakeAdjointXSs(); }
+public:
   void InitQOIs();
   void Execute() override;
+  // 02b
+  std::vector<size_t>
+  ExecuteResponses(const std::vector<std::string>& response_names);
 
   // 04
   size_t
@@ -49,6 +59,21 @@ public:
                       const std::string& lua_function_name);
   // 05a
   void ExportImportanceMap(const std::string& file_name);
+  // 05b
+  void ExportImportanceMapCollective(const std::string& file_name);
+  void ExportImportanceMapCartesian(const std::string& file_name,
+                                    const chi_mesh::Vector3& min_corner,
+                                    const chi_mesh::Vector3& max_corner,
+                                    const std::array<size_t, 3>& num_bins);
+
+  // 06
+  std::vector<double>
+  ComputePerturbationResponses(
+    const std::vector<double>& forward_phi,
+    const std::vector<std::map<int, XSPtr>>& variants);
+
+protected:
+  std::vector<MGP1Moments> ComputeCellAverageP1Moments() const;
 };
 
 } // namespace lbs
@@ -13,11 +13,7 @@ void lbs::DiscreteOrdinatesAdjointSolver::Initialize()
   InitQOIs();
 
   //================================================== Initialize source func
-  auto src_function = std::make_shared<AdjointSourceFunction>(*this);
-
-  using namespace std::placeholders;
-  active_set_source_function_ =
-    std::bind(&SourceFunction::operator(), src_function, _1, _2, _3, _4);
+  InitializeSourceFunction(std::make_shared<AdjointSourceFunction>(*this));
 
   //================================================== Initialize groupsets for
   //                                                   sweeping
@@ -28,8 +24,9 @@ void lbs::DiscreteOrdinatesAdjointSolver::Initialize()
 
     InitWGDSA(groupset);
     InitTGDSA(groupset);
+    InitAngularMG(groupset);
   }
 
   InitializeSolverSchemes();           //j
-  source_event_tag_ = Chi::log.GetRepeatingEventTag("Set Source");
+  LogMemoryUsage();                    //k
 }
\ No newline at end of file
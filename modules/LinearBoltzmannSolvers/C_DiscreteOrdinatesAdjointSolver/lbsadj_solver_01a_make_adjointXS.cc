@@ -31,6 +31,12 @@ void DiscreteOrdinatesAdjointSolver::MakeAdjointXSs()
 
       transport_view.ReassingXS(*xs_ptr);
     }
+
+  cell_material_table_ =
+    CellMaterialTable(*grid_ptr_, matid_to_xs_map_, matid_to_src_map_);
+  precursor_engine_ = PrecursorEngine(
+    cell_material_table_, groups_.size(), max_precursors_per_material_);
+  fission_engine_ = FissionEngine(cell_material_table_, groups_.size());
 }
 
 } // namespace lbs
\ No newline at end of file
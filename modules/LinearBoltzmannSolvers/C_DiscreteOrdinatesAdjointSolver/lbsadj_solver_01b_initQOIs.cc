@@ -17,8 +17,10 @@ void DiscreteOrdinatesAdjointSolver::InitQOIs()
     const auto& qoi_designation = qoi_pair.first;
     auto& qoi_cell_subscription = qoi_pair.second;
 
+    const auto& cell_mask =
+      qoi_designation.logical_volume->GetLocalCellMask(*grid_ptr_);
     for (const auto& cell : grid_ptr_->local_cells)
-      if (qoi_designation.logical_volume->Inside(cell.centroid_))
+      if (cell_mask[cell.local_id_])
         qoi_cell_subscription.push_back(cell.local_id_);
 
     size_t num_local_subs = qoi_cell_subscription.size();
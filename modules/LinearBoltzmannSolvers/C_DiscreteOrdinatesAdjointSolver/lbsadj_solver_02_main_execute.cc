@@ -38,10 +38,8 @@ void lbs::DiscreteOrdinatesAdjointSolver::Execute()
       {
         const auto& ell = m_to_ell_em_map[m].ell;
 
-        size_t dof_map_g0 = cell_view.MapDOF(i, m, 0); //unknown map
-
         for (int g : set_group_numbers)
-          phi_old_local_[dof_map_g0 + g] *= pow(-1.0, ell);
+          phi_old_local_[cell_view.MapDOF(i, m, g)] *= pow(-1.0, ell);
       }//for moment
     }//node i
   }//for cell
@@ -0,0 +1,59 @@
+#include "lbsadj_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include "utils/chi_timer.h"
+
+//###################################################################
+/**Solves the adjoint problem of each of the named response functions in
+ * turn and stores each importance map, i.e., the adjoint flux moments, in
+ * a moment buffer.
+ *
+ * All the responses share the initialized sweep structures, iterative
+ * solvers and acceleration operators, such that a batch of responses only
+ * costs their solves. Each solve starts from a zero flux, and the
+ * reference response function is restored afterwards.
+ *
+ * \return The handles of the moment buffers, in the order of the names,
+ *         that can be used with `chiAdjointSolverApplyFluxMomentBuffer`.*/
+std::vector<size_t> lbs::DiscreteOrdinatesAdjointSolver::ExecuteResponses(
+  const std::vector<std::string>& response_names)
+{
+  for (const auto& name : response_names)
+  {
+    bool found = false;
+    for (const auto& [designation, subscriptions] : response_functions_)
+      if (designation.name == name) found = true;
+    ChiInvalidArgumentIf(not found,
+                         "No response function named \"" + name + "\".");
+  }
+
+  const std::string reference_rf =
+    basic_options_("REFERENCE_RF").StringValue();
+
+  std::vector<size_t> buffer_handles;
+  for (const auto& name : response_names)
+  {
+    const double start_time = Chi::program_timer.GetTime();
+
+    basic_options_["REFERENCE_RF"].SetStringValue(name);
+    phi_old_local_.assign(phi_old_local_.size(), 0.0);
+    phi_new_local_.assign(phi_new_local_.size(), 0.0);
+
+    Execute();
+
+    m_moment_buffers_.push_back(phi_old_local_);
+    buffer_handles.push_back(m_moment_buffers_.size() - 1);
+
+    Chi::log.Log() << "LBAdjointSolver: Response \"" << name
+                   << "\" solved in "
+                   << (Chi::program_timer.GetTime() - start_time) / 1000.0
+                   << " s, moment buffer " << buffer_handles.back() << ".";
+  }
+
+  basic_options_["REFERENCE_RF"].SetStringValue(reference_rf);
+
+  return buffer_handles;
+}
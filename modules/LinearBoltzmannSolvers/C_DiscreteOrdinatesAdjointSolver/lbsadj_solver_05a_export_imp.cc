@@ -5,7 +5,6 @@
 #include "chi_mpi.h"
 
 
-#include "math/chi_math_vectorNX.h"
 #include "math/SpatialDiscretization/FiniteElement/spatial_discretization_FE.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
@@ -14,14 +13,14 @@
 #include <fstream>
 
 //###################################################################
-/**Exports an importance map in binary format.*/
-void lbs::DiscreteOrdinatesAdjointSolver::
-  ExportImportanceMap(const std::string &file_name)
+/**Computes the cell averaged P1 moments of the importance, i.e., the
+ * absolute scalar importance and the x, y and z currents, of every local
+ * cell and group.*/
+std::vector<lbs::DiscreteOrdinatesAdjointSolver::MGP1Moments>
+lbs::DiscreteOrdinatesAdjointSolver::ComputeCellAverageP1Moments() const
 {
   const std::string fname = __FUNCTION__;
 
-  //============================================= Determine cell averaged
-  //                                              importance map
   std::set<int> set_group_numbers;
   for (const auto& groupset : groupsets_)
     for (const auto& group : groupset.groups_)
@@ -30,70 +29,90 @@ void lbs::DiscreteOrdinatesAdjointSolver::
   const auto& m_to_ell_em_map =
     groupsets_.front().quadrature_->GetMomentToHarmonicsIndexMap();
 
-  typedef chi_math::VectorN<4> Arr4; //phi, J_x, J_y, J_z
-  typedef std::vector<Arr4> MGVec4;
-  typedef std::vector<MGVec4> VecOfMGVec4;
   const size_t num_groups = set_group_numbers.size();
   const size_t num_cells = grid_ptr_->local_cells.size();
 
-  VecOfMGVec4 cell_avg_p1_moments(num_cells, MGVec4(num_groups));
-  {
-    auto fe_sdm =
-      std::dynamic_pointer_cast<chi_math::SpatialDiscretization_FE>(discretization_);
+  std::vector<MGP1Moments> cell_avg_p1_moments(num_cells,
+                                               MGP1Moments(num_groups));
+  auto fe_sdm =
+    std::dynamic_pointer_cast<chi_math::SpatialDiscretization_FE>(discretization_);
 
-    if (not fe_sdm)
-      throw std::logic_error(fname + ": Error getting finite element spatial"
-                                     " discretization_.");
+  if (not fe_sdm)
+    throw std::logic_error(fname + ": Error getting finite element spatial"
+                                   " discretization_.");
 
-    for (const auto& cell : grid_ptr_->local_cells)
-    {
-      const auto& cell_view = cell_transport_views_[cell.local_id_];
-      const int num_nodes = cell_view.NumNodes();
-      const auto& fe_values = fe_sdm->GetUnitIntegrals(cell);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& cell_view = cell_transport_views_[cell.local_id_];
+    const int num_nodes = cell_view.NumNodes();
+    const auto& fe_values = fe_sdm->GetUnitIntegrals(cell);
 
-      VecOfMGVec4 nodal_p1_moments(num_nodes);
-      for (int i = 0; i < num_nodes; ++i)
+    std::vector<MGP1Moments> nodal_p1_moments(num_nodes);
+    for (int i = 0; i < num_nodes; ++i)
+    {
+      //==================================== Get multigroup p1_moments
+      MGP1Moments p1_moments(num_groups, {0.0, 0.0, 0.0, 0.0});
+      for (int m=0; m < std::max(static_cast<int>(num_moments_), 4); ++m)
       {
-        //==================================== Get multigroup p1_moments
-        MGVec4 p1_moments(set_group_numbers.size(), VecDbl{0.0,0.0,0.0,0.0});
-        for (int m=0; m < std::max(static_cast<int>(num_moments_), 4); ++m)
+        const auto& ell = m_to_ell_em_map[m].ell;
+        const auto& em  = m_to_ell_em_map[m].m;
+
+        for (int g : set_group_numbers)
         {
-          const auto& ell = m_to_ell_em_map[m].ell;
-          const auto& em  = m_to_ell_em_map[m].m;
+          size_t dof_map = cell_view.MapDOF(i, m, g); //unknown map
 
-          size_t dof_map_g0 = cell_view.MapDOF(i, m, 0); //unknown map
+          if (ell==0 and em== 0) p1_moments[g][0] = std::fabs(phi_old_local_[dof_map]);
+          if (ell==1 and em== 1) p1_moments[g][1] = phi_old_local_[dof_map];
+          if (ell==1 and em==-1) p1_moments[g][2] = phi_old_local_[dof_map];
+          if (ell==1 and em== 0) p1_moments[g][3] = phi_old_local_[dof_map];
+        }//for g
+      }//for m
 
-          for (int g : set_group_numbers)
-          {
-            if (ell==0 and em== 0) p1_moments[g](0) = std::fabs(phi_old_local_[dof_map_g0 + g]);
-            if (ell==1 and em== 1) p1_moments[g](1) = phi_old_local_[dof_map_g0 + g];
-            if (ell==1 and em==-1) p1_moments[g](2) = phi_old_local_[dof_map_g0 + g];
-            if (ell==1 and em== 0) p1_moments[g](3) = phi_old_local_[dof_map_g0 + g];
-          }//for g
-        }//for m
+      nodal_p1_moments[i] = std::move(p1_moments);
+    }//for node i
 
-        nodal_p1_moments[i] = std::move(p1_moments);
-      }//for node i
+    //=========================================== Determine nodal average
+    //                                            p1_moments
+    for (int g : set_group_numbers)
+    {
+      std::array<double, 4> cell_p1_avg = {0.0, 0.0, 0.0, 0.0};
 
-      //=========================================== Determine nodal average
-      //                                            p1_moments
-      for (int g : set_group_numbers)
+      double volume_total = 0.0;
+      for (int i=0; i < num_nodes; ++i)
       {
-        chi_math::VectorN<4> cell_p1_avg(VecDbl{0.0,0.0,0.0,0.0});
+        double IntV_shapeI = fe_values.IntV_shapeI(i);
+        for (int k = 0; k < 4; ++k)
+          cell_p1_avg[k] += nodal_p1_moments[i][g][k] * IntV_shapeI;
+        volume_total += IntV_shapeI;
+      }//for node i
+      for (auto& value : cell_p1_avg)
+        value /= volume_total;
 
-        double volume_total = 0.0;
-        for (int i=0; i < num_nodes; ++i)
-        {
-          double IntV_shapeI = fe_values.IntV_shapeI(i);
-          cell_p1_avg += nodal_p1_moments[i][g] * IntV_shapeI;
-          volume_total += IntV_shapeI;
-        }//for node i
-        cell_p1_avg /= volume_total;
+      cell_avg_p1_moments[cell.local_id_][g] = cell_p1_avg;
+    }//for g
+  }//for cell
 
-        cell_avg_p1_moments[cell.local_id_][g] = cell_p1_avg;
-      }//for g
-    }//for cell
-  }
+  return cell_avg_p1_moments;
+}
+
+//###################################################################
+/**Exports an importance map in binary format.*/
+void lbs::DiscreteOrdinatesAdjointSolver::
+  ExportImportanceMap(const std::string &file_name)
+{
+  const std::string fname = __FUNCTION__;
+
+  //============================================= Determine cell averaged
+  //                                              importance map
+  std::set<int> set_group_numbers;
+  for (const auto& groupset : groupsets_)
+    for (const auto& group : groupset.groups_)
+      set_group_numbers.insert(group.id_);
+
+  const size_t num_groups = set_group_numbers.size();
+  const size_t num_cells = grid_ptr_->local_cells.size();
+
+  const auto cell_avg_p1_moments = ComputeCellAverageP1Moments();
 
   //============================================= Determine cell-based
   //                                              exponential-representations
@@ -183,7 +202,7 @@ void lbs::DiscreteOrdinatesAdjointSolver::
 
     for (const auto& cell : grid_ptr_->local_cells)
     {
-      MGVec4            p1_moments = cell_avg_p1_moments[cell.local_id_];
+      const auto&       p1_moments = cell_avg_p1_moments[cell.local_id_];
       VecOfABCoeffsPair exp_rep    = cell_exp_reps[cell.local_id_];
 
       auto cell_global_id = static_cast<uint64_t>(cell.global_id_);
@@ -194,7 +213,7 @@ void lbs::DiscreteOrdinatesAdjointSolver::
         file.write((char *) &g, sizeof(unsigned int));
 
         for (int m=0; m<4; ++m)
-          file.write((char *) &p1_moments[group](m), sizeof(double));
+          file.write((char *) &p1_moments[group][m], sizeof(double));
 
         file.write((char *) &exp_rep[group].first , sizeof(double));
         file.write((char *) &exp_rep[group].second, sizeof(double));
@@ -0,0 +1,215 @@
+#include "lbsadj_solver.h"
+
+#include "A_LBSSolver/Tools/lbs_cell_data_io.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "lbs_adjoint.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+//Attribute tag identifying the content of collective files
+const uint64_t IMPORTANCE_MAP_TAG = 3;
+
+//Values per group: phi, J_x, J_y, J_z, a and b coefficients
+const uint64_t NUM_GROUP_VALUES = 6;
+}//namespace
+
+//###################################################################
+/**Collectively exports the importance map to a single binary file with
+ * MPI-IO, all locations writing their cells at once, see
+ * WriteCellDataCollective. The block of each cell holds, group by group,
+ * the cell averaged phi, J_x, J_y and J_z and the a and b coefficients of
+ * the exponential representation.*/
+void lbs::DiscreteOrdinatesAdjointSolver::
+  ExportImportanceMapCollective(const std::string& file_name)
+{
+  Chi::log.Log() << "Exporting importance map to collective file "
+                 << file_name;
+
+  const auto cell_avg_p1_moments = ComputeCellAverageP1Moments();
+  const size_t num_groups = groups_.size();
+
+  CellDataBlocks blocks;
+  blocks.values.reserve(grid_ptr_->local_cells.size() * num_groups *
+                        NUM_GROUP_VALUES);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    blocks.AddCell(cell.global_id_);
+    for (const auto& p1_moments : cell_avg_p1_moments[cell.local_id_])
+    {
+      for (const double value : p1_moments)
+        blocks.AddValue(value);
+      const auto a_b = MakeExpRepFromP1(p1_moments);
+      blocks.AddValue(a_b[0]);
+      blocks.AddValue(a_b[1]);
+    }
+  }
+
+  const std::string description =
+    "Chi-Tech LinearBoltzmann: Collective importance map file\n"
+    "Attributes: tag, num_groups, values per group\n"
+    "Each cell: groups x (phi, J_x, J_y, J_z, a, b) doubles\n";
+
+  const bool succeeded =
+    WriteCellDataCollective(file_name, description,
+                            {IMPORTANCE_MAP_TAG, num_groups, NUM_GROUP_VALUES},
+                            grid_ptr_->GetGlobalNumberOfCells(), blocks);
+
+  bool all_succeeded = true;
+  MPI_Allreduce(&succeeded, &all_succeeded, 1, MPI_CXX_BOOL, MPI_LAND,
+                Chi::mpi.comm);
+  if (not all_succeeded)
+    Chi::log.Log0Error() << "Failed to export importance map " << file_name;
+}
+
+//###################################################################
+/**Exports the importance map coarsened onto a Cartesian mesh tally, e.g.,
+ * for the weight windows of a Monte Carlo code.
+ *
+ * Each cell contributes its volume weighted P1 moments to the bin
+ * containing its centroid, cells outside the tally being ignored. The bins
+ * are reduced to location 0, which writes the file. Holding only the tally,
+ * the file is small next to the cell-wise maps. The exponential
+ * representation is recomputed from the bin averaged moments. Empty bins
+ * have zero volume and values.
+ *
+ * The file holds a 400 byte header followed by the bin counts, the
+ * corners and, for every bin, with x fastest, then y and z, the bin volume
+ * and, group by group, phi, J_x, J_y, J_z, a and b.*/
+void lbs::DiscreteOrdinatesAdjointSolver::
+  ExportImportanceMapCartesian(const std::string& file_name,
+                               const chi_mesh::Vector3& min_corner,
+                               const chi_mesh::Vector3& max_corner,
+                               const std::array<size_t, 3>& num_bins)
+{
+  const std::string fname = __FUNCTION__;
+
+  const double extents[] = {max_corner.x - min_corner.x,
+                            max_corner.y - min_corner.y,
+                            max_corner.z - min_corner.z};
+  for (int d = 0; d < 3; ++d)
+    if (extents[d] <= 0.0 or num_bins[d] == 0)
+      throw std::invalid_argument(fname + ": The tally corners must be "
+                                          "increasing and the bin counts "
+                                          "positive.");
+
+  Chi::log.Log() << "Exporting coarsened importance map to binary file "
+                 << file_name;
+
+  const auto cell_avg_p1_moments = ComputeCellAverageP1Moments();
+  const size_t num_groups = groups_.size();
+  const size_t total_bins = num_bins[0] * num_bins[1] * num_bins[2];
+
+  //============================================= Accumulate the bins
+  // Per bin: the volume, then groups x (phi, J_x, J_y, J_z)
+  const size_t bin_stride = 1 + 4 * num_groups;
+  std::vector<double> local_bins(total_bins * bin_stride, 0.0);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const double coords[] = {cell.centroid_.x - min_corner.x,
+                             cell.centroid_.y - min_corner.y,
+                             cell.centroid_.z - min_corner.z};
+    size_t ijk[3];
+    bool inside = true;
+    for (int d = 0; d < 3; ++d)
+    {
+      const double fraction = coords[d] / extents[d];
+      if (fraction < 0.0 or fraction > 1.0) inside = false;
+      ijk[d] = std::min(static_cast<size_t>(fraction * num_bins[d]),
+                        num_bins[d] - 1);
+    }
+    if (not inside) continue;
+
+    const size_t bin = ijk[0] + num_bins[0] * (ijk[1] + num_bins[1] * ijk[2]);
+    const double volume = cell_transport_views_[cell.local_id_].Volume();
+    double* bin_values = &local_bins[bin * bin_stride];
+
+    bin_values[0] += volume;
+    const auto& p1_moments = cell_avg_p1_moments[cell.local_id_];
+    for (size_t g = 0; g < num_groups; ++g)
+      for (int k = 0; k < 4; ++k)
+        bin_values[1 + 4 * g + k] += p1_moments[g][k] * volume;
+  }
+
+  std::vector<double> bins;
+  if (Chi::mpi.location_id == 0) bins.assign(local_bins.size(), 0.0);
+  MPI_Reduce(local_bins.data(), bins.data(),
+             static_cast<int>(local_bins.size()), MPI_DOUBLE, MPI_SUM, 0,
+             Chi::mpi.comm);
+
+  //============================================= Write the tally
+  bool succeeded = true;
+  if (Chi::mpi.location_id == 0)
+  {
+    std::ofstream file(file_name, std::ofstream::binary | std::ofstream::out |
+                                    std::ofstream::trunc);
+    succeeded = file.is_open();
+    if (succeeded)
+    {
+      const std::string header_info =
+        "Chi-Tech LinearBoltzmann: Cartesian importance map file\n"
+        "Header size: 400 bytes\n"
+        "Structure(type-info):\n"
+        "uint64_t num_bins_x, num_bins_y, num_bins_z\n"
+        "uint64_t num_groups\n"
+        "double   x_min, y_min, z_min, x_max, y_max, z_max\n"
+        "Each bin, x fastest:\n"
+        "  double volume\n"
+        "  Each group:\n"
+        "    double phi, J_x, J_y, J_z, a_coefficient, b_coefficient\n";
+
+      char header_bytes[400];
+      memset(header_bytes, '-', 400);
+      strncpy(header_bytes, header_info.c_str(),
+              std::min<size_t>(header_info.length(), 399));
+      header_bytes[399] = '\0';
+      file.write(header_bytes, 400);
+
+      const uint64_t dims[] = {num_bins[0], num_bins[1], num_bins[2],
+                               num_groups};
+      const double corners[] = {min_corner.x, min_corner.y, min_corner.z,
+                                max_corner.x, max_corner.y, max_corner.z};
+      file.write((char*)dims, sizeof(dims));
+      file.write((char*)corners, sizeof(corners));
+
+      std::vector<double> record(1 + NUM_GROUP_VALUES * num_groups);
+      for (size_t bin = 0; bin < total_bins; ++bin)
+      {
+        const double* bin_values = &bins[bin * bin_stride];
+        const double volume = bin_values[0];
+        record.assign(record.size(), 0.0);
+        record[0] = volume;
+        if (volume > 0.0)
+          for (size_t g = 0; g < num_groups; ++g)
+          {
+            std::array<double, 4> p1_moments;
+            for (int k = 0; k < 4; ++k)
+              p1_moments[k] = bin_values[1 + 4 * g + k] / volume;
+            const auto a_b = MakeExpRepFromP1(p1_moments);
+
+            double* group_values = &record[1 + NUM_GROUP_VALUES * g];
+            for (int k = 0; k < 4; ++k)
+              group_values[k] = p1_moments[k];
+            group_values[4] = a_b[0];
+            group_values[5] = a_b[1];
+          }
+        file.write((char*)record.data(),
+                   static_cast<std::streamsize>(record.size() *
+                                                sizeof(double)));
+      }
+      succeeded = file.good();
+    }
+  }
+
+  MPI_Bcast(&succeeded, 1, MPI_CXX_BOOL, 0, Chi::mpi.comm);
+  if (not succeeded)
+    throw std::logic_error(fname + ": Failed to write file " + file_name);
+}
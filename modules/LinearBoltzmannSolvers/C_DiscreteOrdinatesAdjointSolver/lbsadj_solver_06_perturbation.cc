@@ -0,0 +1,124 @@
+#include "lbsadj_solver.h"
+
+#include "math/SpatialDiscretization/FiniteElement/spatial_discretization_FE.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+//###################################################################
+/**Computes the first-order perturbation theory estimates of the change of
+ * the response, for each of the given cross section variants, from the
+ * current adjoint flux and the given forward flux moments as
+ * \f[
+ *   \delta R_k = -\langle \phi^\dagger, \delta A_k \phi \rangle,
+ *   \quad
+ *   \delta A_k \phi_g = \delta\sigma_{t,g} \phi_g
+ *                       - \sum_{g'} \delta\sigma_{s0,g' \to g} \phi_{g'},
+ * \f]
+ * where \f$ \delta \f$ denotes the difference with the forward cross
+ * sections of this solver, and the inner products use the consistent cell
+ * mass matrices.
+ *
+ * Each variant maps material ids to perturbed forward cross sections,
+ * materials absent from a variant being unperturbed. Only the scalar flux
+ * moments are used, i.e., the angular fluxes are treated as isotropic, and
+ * fission is not perturbed. The K estimates need no sweep and share a single
+ * pass over the cells, whereas each variant would otherwise require a full
+ * forward solve.*/
+std::vector<double>
+lbs::DiscreteOrdinatesAdjointSolver::ComputePerturbationResponses(
+  const std::vector<double>& forward_phi,
+  const std::vector<std::map<int, XSPtr>>& variants)
+{
+  ChiInvalidArgumentIf(forward_phi.size() != phi_old_local_.size(),
+                       "The forward flux moments do not match the unknowns "
+                       "of the solver.");
+
+  const size_t num_groups = groups_.size();
+  for (const auto& variant : variants)
+    for (const auto& [mat_id, xs] : variant)
+    {
+      ChiInvalidArgumentIf(matid_to_xs_map_.count(mat_id) == 0,
+                           "Perturbed material " + std::to_string(mat_id) +
+                             " is not a material of the solver.");
+      ChiInvalidArgumentIf(xs->NumGroups() != num_groups,
+                           "Perturbed cross sections of material " +
+                             std::to_string(mat_id) +
+                             " have a different number of groups.");
+    }
+
+  auto pwl = std::dynamic_pointer_cast<chi_math::SpatialDiscretization_FE>(
+    discretization_);
+
+  //============================================= Reaction rate densities
+  // Per cell node, the adjoint-weighted total and scattering rates, the
+  // latter with the forward transfer matrix. The adjoint cross sections of
+  // the solver hold the transposed forward transfer matrix.
+  std::vector<double> phi_adj_scratch, phi_scratch;
+  auto RemovalRate = [&](const chi_physics::MultiGroupXS& xs,
+                         const CellLBSView& transport_view,
+                         int i,
+                         int j,
+                         bool adjoint_xs)
+  {
+    const auto& sigma_t = xs.SigmaTotal();
+    const auto& S = xs.TransferMatrix(0);
+
+    const double* phi_adj_i =
+      transport_view.GroupValues(phi_old_local_, i, 0, phi_adj_scratch);
+    const double* phi_j =
+      transport_view.GroupValues(forward_phi, j, 0, phi_scratch);
+
+    double rate = 0.0;
+    for (size_t g = 0; g < num_groups; ++g)
+    {
+      rate += phi_adj_i[g] * sigma_t[g] * phi_j[g];
+      for (const auto& [row_g, gprime, sigma] : S.Row(g))
+        rate -= adjoint_xs ? phi_adj_i[gprime] * sigma * phi_j[row_g]
+                           : phi_adj_i[row_g] * sigma * phi_j[gprime];
+    }
+    return rate;
+  };
+
+  //============================================= Accumulate over cells
+  std::vector<double> local_delta_R(variants.size(), 0.0);
+  for (const auto& cell : grid_ptr_->local_cells)
+  {
+    const auto& transport_view = cell_transport_views_[cell.local_id_];
+    const auto& fe_values = pwl->GetUnitIntegrals(cell);
+    const int num_nodes = transport_view.NumNodes();
+
+    for (size_t k = 0; k < variants.size(); ++k)
+    {
+      const auto xs_it = variants[k].find(cell.material_id_);
+      if (xs_it == variants[k].end()) continue;
+
+      const auto& ref_xs = *matid_to_xs_map_.at(cell.material_id_);
+      const auto& var_xs = *xs_it->second;
+
+      for (int i = 0; i < num_nodes; ++i)
+        for (int j = 0; j < num_nodes; ++j)
+        {
+          const double M_ij = fe_values.IntV_shapeI_shapeJ(i, j);
+          if (M_ij == 0.0) continue;
+
+          const double delta_rate =
+            RemovalRate(var_xs, transport_view, i, j, false) -
+            RemovalRate(ref_xs, transport_view, i, j, true);
+          local_delta_R[k] -= M_ij * delta_rate;
+        }
+    }//for variant
+  }//for cell
+
+  std::vector<double> delta_R(variants.size(), 0.0);
+  MPI_Allreduce(local_delta_R.data(),              //sendbuf
+                delta_R.data(),                    //recvbuf
+                static_cast<int>(delta_R.size()),  //count
+                MPI_DOUBLE,                        //datatype
+                MPI_SUM,                           //op
+                Chi::mpi.comm);                    //comm
+
+  return delta_R;
+}
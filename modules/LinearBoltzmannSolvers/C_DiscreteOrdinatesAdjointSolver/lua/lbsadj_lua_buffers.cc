@@ -11,6 +11,7 @@ namespace lbs::adjoint_lua_utils
 
 RegisterLuaFunctionAsIs(chiAdjointSolverReadFluxMomentsToBuffer);
 RegisterLuaFunctionAsIs(chiAdjointSolverApplyFluxMomentBuffer);
+RegisterLuaFunctionAsIs(chiAdjointSolverExecuteResponses);
 
 /**Reads flux-moments file to a buffer and returns a handle to that buffer.
 
@@ -79,4 +80,52 @@ int chiAdjointSolverApplyFluxMomentBuffer(lua_State* L)
   return 0;
 }
 
+/**Solves the adjoint problem of each of the given response functions in
+turn, storing each importance map in a flux-moment buffer.
+
+\param SolverHandle int Handle to the relevant solver.
+\param ResponseNames table Array of the names of the response functions.
+
+\return handles table The buffer handles, in the order of the names, that
+                      can be used with `chiAdjointSolverApplyFluxMomentBuffer`.*/
+int chiAdjointSolverExecuteResponses(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckTableValue(fname, L, 2);
+
+  const int solver_handle     = lua_tointeger(L, 1);
+
+  auto& solver = Chi::GetStackItem<lbs::DiscreteOrdinatesAdjointSolver>(
+    Chi::object_stack, solver_handle, fname);
+
+  std::vector<std::string> response_names;
+  const size_t num_names = lua_rawlen(L, 2);
+  for (size_t k = 0; k < num_names; ++k)
+  {
+    lua_rawgeti(L, 2, static_cast<lua_Integer>(k + 1));
+    if (not lua_isstring(L, -1))
+      throw std::invalid_argument(fname + ": Response names must be "
+                                          "strings.");
+    response_names.emplace_back(lua_tostring(L, -1));
+    lua_pop(L, 1);
+  }
+
+  const auto handles = solver.ExecuteResponses(response_names);
+
+  lua_newtable(L);
+  for (size_t k = 0; k < handles.size(); ++k)
+  {
+    lua_pushinteger(L, static_cast<lua_Integer>(k + 1));
+    lua_pushinteger(L, static_cast<lua_Integer>(handles[k]));
+    lua_settable(L, -3);
+  }
+
+  return 1;
+}
+
 }//namespace lbs::lua_utils
\ No newline at end of file
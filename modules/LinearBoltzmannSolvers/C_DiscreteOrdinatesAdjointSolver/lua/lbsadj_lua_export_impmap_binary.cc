@@ -10,6 +10,8 @@ namespace lbs::adjoint_lua_utils
 {
 
 RegisterLuaFunctionAsIs(chiAdjointSolverExportImportanceMapBinary);
+RegisterLuaFunctionAsIs(chiAdjointSolverExportImportanceMapCollective);
+RegisterLuaFunctionAsIs(chiAdjointSolverExportImportanceMapCartesian);
 
 int chiAdjointSolverExportImportanceMapBinary(lua_State* L)
 {
@@ -35,5 +37,88 @@ int chiAdjointSolverExportImportanceMapBinary(lua_State* L)
   return 0;
 }
 
+//###################################################################
+/**Collectively exports the importance map to a single binary file, all
+ * locations writing their cells with MPI-IO.
+
+\param SolverHandle int Handle to the adjoint solver.
+\param FileName string Name of the file.*/
+int chiAdjointSolverExportImportanceMapCollective(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2)
+    LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckIntegerValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+
+  const int solver_handle     = lua_tointeger(L, 1);
+  const std::string file_name = lua_tostring(L, 2);
+
+  auto& solver = Chi::GetStackItem<lbs::DiscreteOrdinatesAdjointSolver>(
+    Chi::object_stack, solver_handle, fname);
+
+  solver.ExportImportanceMapCollective(file_name);
+
+  return 0;
+}
+
+//###################################################################
+/**Exports the importance map coarsened onto a Cartesian mesh tally, to a
+ * binary file written by location 0.
+
+\param SolverHandle int Handle to the adjoint solver.
+\param FileName string Name of the file.
+\param MinCorner table {xmin, ymin, zmin} Lower corner of the tally.
+\param MaxCorner table {xmax, ymax, zmax} Upper corner of the tally.
+\param NumBins table {nx, ny, nz} Number of bins along each axis.*/
+int chiAdjointSolverExportImportanceMapCartesian(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 5)
+    LuaPostArgAmountError(fname, 5, num_args);
+
+  LuaCheckIntegerValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+  LuaCheckTableValue(fname, L, 3);
+  LuaCheckTableValue(fname, L, 4);
+  LuaCheckTableValue(fname, L, 5);
+
+  const int solver_handle     = lua_tointeger(L, 1);
+  const std::string file_name = lua_tostring(L, 2);
+
+  std::vector<double> min_corner, max_corner, num_bins;
+  LuaPopulateVectorFrom1DArray(fname, L, 3, min_corner);
+  LuaPopulateVectorFrom1DArray(fname, L, 4, max_corner);
+  LuaPopulateVectorFrom1DArray(fname, L, 5, num_bins);
+
+  if (min_corner.size() != 3 or max_corner.size() != 3 or
+      num_bins.size() != 3)
+    throw std::invalid_argument(fname + ": The corners and bin counts must "
+                                        "have 3 entries each.");
+
+  std::array<size_t, 3> bins{};
+  for (int d = 0; d < 3; ++d)
+  {
+    if (num_bins[d] < 1.0)
+      throw std::invalid_argument(fname + ": The bin counts must be "
+                                          "positive.");
+    bins[d] = static_cast<size_t>(num_bins[d]);
+  }
+
+  auto& solver = Chi::GetStackItem<lbs::DiscreteOrdinatesAdjointSolver>(
+    Chi::object_stack, solver_handle, fname);
+
+  solver.ExportImportanceMapCartesian(
+    file_name,
+    chi_mesh::Vector3(min_corner[0], min_corner[1], min_corner[2]),
+    chi_mesh::Vector3(max_corner[0], max_corner[1], max_corner[2]),
+    bins);
+
+  return 0;
+}
+
 }//namespace lbs
 
@@ -0,0 +1,91 @@
+#include "lbsadj_lua_utils.h"
+
+#include "C_DiscreteOrdinatesAdjointSolver/lbsadj_solver.h"
+
+#include "chi_runtime.h"
+
+#include "console/chi_console.h"
+
+namespace lbs::adjoint_lua_utils
+{
+
+RegisterLuaFunctionAsIs(chiAdjointSolverComputePerturbationResponses);
+
+/**Computes the first-order perturbation theory estimates of the change of
+the response, with the current adjoint flux, for each of a list of cross
+section variants. No transport solve is performed.
+
+\param SolverHandle int Handle to the relevant solver.
+\param BufferHandle int Handle to the moment buffer holding the forward flux
+                        moments, e.g., from
+                        `chiAdjointSolverReadFluxMomentsToBuffer`.
+\param Variants table Array of variants, each a table mapping material ids
+                      to the handles of the perturbed forward cross sections.
+                      Materials absent from a variant are unperturbed.
+
+\return changes table The estimated change of the response per variant, in
+                      the order of the variants.*/
+int chiAdjointSolverComputePerturbationResponses(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 3)
+    LuaPostArgAmountError(fname, 3, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckNilValue(fname, L, 2);
+  LuaCheckTableValue(fname, L, 3);
+
+  const int solver_handle     = lua_tointeger(L, 1);
+
+  auto& solver = Chi::GetStackItem<lbs::DiscreteOrdinatesAdjointSolver>(
+    Chi::object_stack, solver_handle, fname);
+
+  const int buffer_handle = lua_tointeger(L, 2);
+
+  if (buffer_handle < 0 or
+      buffer_handle >= solver.m_moment_buffers_.size())
+    throw std::invalid_argument(fname + ": Invalid buffer handle.");
+
+  //============================================= Read the variants
+  std::vector<std::map<int, lbs::XSPtr>> variants;
+  const size_t num_variants = lua_rawlen(L, 3);
+  for (size_t k = 0; k < num_variants; ++k)
+  {
+    lua_rawgeti(L, 3, static_cast<lua_Integer>(k + 1));
+    LuaCheckTableValue(fname, L, -1);
+
+    std::map<int, lbs::XSPtr> variant;
+    lua_pushnil(L);
+    while (lua_next(L, -2) != 0)
+    {
+      if (not lua_isinteger(L, -2) or not lua_isinteger(L, -1))
+        throw std::invalid_argument(fname + ": Variants must map material "
+                                            "ids to cross section handles.");
+
+      const int mat_id = static_cast<int>(lua_tointeger(L, -2));
+      const int xs_handle = static_cast<int>(lua_tointeger(L, -1));
+      variant[mat_id] =
+        Chi::GetStackItemPtr(Chi::multigroup_xs_stack, xs_handle, fname);
+      lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+
+    variants.push_back(std::move(variant));
+  }
+
+  const auto delta_R = solver.ComputePerturbationResponses(
+    solver.m_moment_buffers_[buffer_handle], variants);
+
+  lua_newtable(L);
+  for (size_t k = 0; k < delta_R.size(); ++k)
+  {
+    lua_pushinteger(L, static_cast<lua_Integer>(k + 1));
+    lua_pushnumber(L, delta_R[k]);
+    lua_settable(L, -3);
+  }
+
+  return 1;
+}
+
+}//namespace lbs::adjoint_lua_utils
@@ -9,10 +9,14 @@ namespace lbs::adjoint_lua_utils
   int chiAdjointSolverAddResponseFunction(lua_State* L);
   int chiAdjointSolverMakeExpRepFromP1Moments(lua_State* L);
   int chiAdjointSolverExportImportanceMapBinary(lua_State* L);
+  int chiAdjointSolverExportImportanceMapCollective(lua_State* L);
+  int chiAdjointSolverExportImportanceMapCartesian(lua_State* L);
   int chiAdjointSolverComputeInnerProduct(lua_State* L);
 
   int chiAdjointSolverReadFluxMomentsToBuffer(lua_State* L);
   int chiAdjointSolverApplyFluxMomentBuffer(lua_State* L);
+  int chiAdjointSolverExecuteResponses(lua_State* L);
+  int chiAdjointSolverComputePerturbationResponses(lua_State* L);
 }//namespace lbs
 
 #endif //LBSADJOINTSOLVER_LUA_UTILS_H
\ No newline at end of file
@@ -13,7 +13,7 @@ namespace lbs
 SweepChunkPWLRZ::SweepChunkPWLRZ(
   const chi_mesh::MeshContinuum& grid,
   const chi_math::SpatialDiscretization& discretization_primary,
-  const std::vector<lbs::UnitCellMatrices>& unit_cell_matrices,
+  const lbs::PackedUnitCellMatrices& unit_cell_matrices,
   const std::vector<lbs::UnitCellMatrices>& secondary_unit_cell_matrices,
   std::vector<lbs::CellLBSView>& cell_transport_views,
   std::vector<double>& destination_phi,
@@ -60,10 +60,26 @@ SweepChunkPWLRZ::SweepChunkPWLRZ(
     discretization_primary.GetNumLocalDOFs(unknown_manager_);
   psi_sweep_.resize(n_dof);
 
-  //  initialise mappings from direction linear index
+  //  initialise the per-direction data, indexed by direction linear index,
+  //  such that the sweep only reads contiguous arrays
+  const size_t num_directions = curvilinear_product_quadrature->omegas_.size();
+  direction_polar_levels_.assign(num_directions, 0);
   for (const auto& dir_set : curvilinear_product_quadrature->GetDirectionMap())
     for (const auto& dir_idx : dir_set.second)
-      map_polar_level_.emplace(dir_idx, dir_set.first);
+      direction_polar_levels_[dir_idx] = dir_set.first;
+
+  direction_fac_diamond_difference_ =
+    curvilinear_product_quadrature->GetDiamondDifferenceFactor();
+  direction_fac_streaming_operator_ =
+    curvilinear_product_quadrature->GetStreamingOperatorFactor();
+
+  ChiLogicalErrorIf(
+    direction_fac_diamond_difference_.size() != num_directions or
+      direction_fac_streaming_operator_.size() != num_directions,
+    "The curvilinear quadrature factors do not match its directions.");
+
+  psi_sweep_addresses_.reserve(max_num_cell_dofs);
+  Maux_psi_sweep_.reserve(max_num_cell_dofs * groupset_.groups_.size());
 
   //  set normal vector for symmetric boundary condition
   const int d = (grid_.Attributes() & chi_mesh::DIMENSION_1) ? 2 : 0;
@@ -104,22 +120,19 @@ void SweepChunkPWLRZ::CellDataCallback()
 }
 
 // ##################################################################
-/**Direction data callback.*/
+/**Direction data callback. Reads the precomputed factors of the direction
+ * and maps the nodes of the cell into the sweeping dependency of its polar
+ * level, once for all the kernels and groups.*/
 void SweepChunkPWLRZ::DirectionDataCallback()
 {
-  polar_level_ = map_polar_level_[direction_num_];
-  const auto curvilinear_product_quadrature =
-    std::dynamic_pointer_cast<chi_math::CurvilinearAngularQuadrature>(
-      groupset_.quadrature_);
+  polar_level_ = direction_polar_levels_[direction_num_];
+  fac_diamond_difference_ = direction_fac_diamond_difference_[direction_num_];
+  fac_streaming_operator_ = direction_fac_streaming_operator_[direction_num_];
 
-  ChiLogicalErrorIf(not curvilinear_product_quadrature,
-                    "Failure to cast angular quadrature to "
-                    "chi_math::CurvilinearAngularQuadrature");
-
-  fac_diamond_difference_ = curvilinear_product_quadrature
-                              ->GetDiamondDifferenceFactor()[direction_num_];
-  fac_streaming_operator_ = curvilinear_product_quadrature
-                              ->GetStreamingOperatorFactor()[direction_num_];
+  psi_sweep_addresses_.resize(cell_num_nodes_);
+  for (size_t i = 0; i < cell_num_nodes_; ++i)
+    psi_sweep_addresses_[i] = grid_fe_view_.MapDOFLocal(
+      *cell_, i, unknown_manager_, polar_level_, gs_gi_);
 }
 
 // ##################################################################
@@ -130,30 +143,42 @@ void SweepChunkPWLRZ::PostCellDirSweepCallback()
   const auto f1 = f0 - 1;
   for (size_t i = 0; i < cell_num_nodes_; ++i)
   {
-    const auto ir = grid_fe_view_.MapDOFLocal(
-      *cell_, i, unknown_manager_, polar_level_, gs_gi_);
+    const size_t ir = psi_sweep_addresses_[i];
     for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
       psi_sweep_[ir + gsg] = f0 * b_[gsg][i] - f1 * psi_sweep_[ir + gsg];
   }
 }
 
 // ##################################################################
-/**Assembles the volumetric gradient term.*/
+/**Assembles the volumetric gradient term. The angular redistribution
+ * source, Maux times the sweeping dependency, is accumulated over the
+ * nodes with the groups innermost, on contiguous storage, and scaled by
+ * the streaming operator factor once per entry of the right-hand side.*/
 void SweepChunkPWLRZ::KernelFEMRZVolumetricGradientTerm()
 {
-  const auto& G = *G_;
+  const auto& G = G_;
   const auto& Maux = *Maux_;
+  const size_t num_groups = gs_ss_size_;
 
+  Maux_psi_sweep_.assign(num_groups * cell_num_nodes_, 0.0);
   for (int i = 0; i < cell_num_nodes_; ++i)
+  {
+    double* Maux_psi_i = &Maux_psi_sweep_[i * num_groups];
     for (int j = 0; j < cell_num_nodes_; ++j)
     {
-      Amat_[i][j] = omega_.Dot(G[i][j]) + fac_streaming_operator_ * Maux[i][j];
-      const auto jr = grid_fe_view_.MapDOFLocal(
-        *cell_, j, unknown_manager_, polar_level_, gs_gi_);
-      for (int gsg = 0; gsg < gs_ss_size_; ++gsg)
-        b_[gsg][i] +=
-          fac_streaming_operator_ * Maux[i][j] * psi_sweep_[jr + gsg];
+      const double Maux_ij = Maux[i][j];
+      Amat_[i][j] = omega_.Dot(G[i][j]) + fac_streaming_operator_ * Maux_ij;
+
+      const double* psi_j = &psi_sweep_[psi_sweep_addresses_[j]];
+      for (size_t gsg = 0; gsg < num_groups; ++gsg)
+        Maux_psi_i[gsg] += Maux_ij * psi_j[gsg];
     }
+  }
+
+  for (int i = 0; i < cell_num_nodes_; ++i)
+    for (size_t gsg = 0; gsg < num_groups; ++gsg)
+      b_[gsg][i] +=
+        fac_streaming_operator_ * Maux_psi_sweep_[i * num_groups + gsg];
 }
 
 // ##################################################################
@@ -179,7 +204,7 @@ void SweepChunkPWLRZ::KernelFEMRZUpwindSurfaceIntegrals()
     if (incident_on_symmetric_boundary) return;
   }
 
-  const auto& M_surf_f = (*M_surf_)[f];
+  const auto M_surf_f = M_surf_[f];
   const double mu = face_mu_values_[f];
   const size_t num_face_nodes = cell_mapping_->NumFaceNodes(f);
   for (int fi = 0; fi < num_face_nodes; ++fi)
@@ -18,13 +18,22 @@ private:
   chi_math::UnknownManager unknown_manager_;
   /** Sweeping dependency angular intensity (for each polar level). */
   std::vector<double> psi_sweep_;
-  /** Mapping from direction linear index to direction polar level. */
-  std::map<unsigned int, unsigned int> map_polar_level_;
+  /** Polar level of each direction, by direction linear index. */
+  std::vector<unsigned int> direction_polar_levels_;
+  /** Diamond difference factor of each direction. */
+  std::vector<double> direction_fac_diamond_difference_;
+  /** Streaming operator factor of each direction. */
+  std::vector<double> direction_fac_streaming_operator_;
   /** Normal vector to determine symmetric boundary condition. */
   chi_mesh::Vector3 normal_vector_boundary_;
 
   // Runtime params
   const MatDbl*  Maux_ = nullptr;
+  /** Address in psi_sweep_ of each node of the cell, at the polar level of
+   * the current direction. */
+  std::vector<size_t> psi_sweep_addresses_;
+  /** Maux times the sweeping dependency, per group then node. */
+  std::vector<double> Maux_psi_sweep_;
 
   unsigned int polar_level_ = 0;
   double fac_diamond_difference_ = 0.0;
@@ -36,7 +45,7 @@ public:
   SweepChunkPWLRZ(
     const chi_mesh::MeshContinuum& grid,
     const chi_math::SpatialDiscretization& discretization_primary,
-    const std::vector<lbs::UnitCellMatrices>& unit_cell_matrices,
+    const lbs::PackedUnitCellMatrices& unit_cell_matrices,
     const std::vector<lbs::UnitCellMatrices>& secondary_unit_cell_matrices,
     std::vector<lbs::CellLBSView>& cell_transport_views,
     std::vector<double>& destination_phi,
@@ -32,6 +32,8 @@ public:
   DiscreteOrdinatesCurvilinearSolver&
   operator=(const DiscreteOrdinatesCurvilinearSolver&) = delete;
 
+  void CheckTimeDerivativeSupport() const override;
+
 protected:
   void PerformInputChecks() override;
   void InitializeSpatialDiscretization() override;
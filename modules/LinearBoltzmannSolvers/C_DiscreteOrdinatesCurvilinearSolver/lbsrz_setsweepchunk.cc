@@ -2,6 +2,8 @@
 
 #include "SweepChunks/lbs_curvilinear_sweepchunk_pwl.h"
 
+#include "chi_log_exceptions.h"
+
 namespace lbs
 {
 
@@ -26,4 +28,13 @@ lbs::DiscreteOrdinatesCurvilinearSolver::SetSweepChunk(
   return sweep_chunk;
 }
 
-}
\ No newline at end of file
+/**The curvilinear sweep chunk has its own angular derivative terms, to
+ * which the time derivative term is not added.*/
+void lbs::DiscreteOrdinatesCurvilinearSolver::CheckTimeDerivativeSupport()
+  const
+{
+  ChiInvalidArgument("The time derivative term is not supported by the "
+                     "curvilinear solver.");
+}
+
+}
@@ -47,6 +47,9 @@ void SteadyStateSolver::Execute()
   ags_solver.Setup();
   ags_solver.Solve();
 
+  // The solve only yields the collided flux with a first-collision source
+  lbs_solver_.AddUncollidedFlux();
+
   if (lbs_solver_.Options().use_precursors)
     lbs_solver_.ComputePrecursors();
 
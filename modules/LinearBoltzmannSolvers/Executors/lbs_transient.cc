@@ -2,7 +2,20 @@
 
 #include "ChiObjectFactory.h"
 
-#include "math/TimeIntegrations/time_integration.h"
+#include "math/TimeIntegrations/theta_scheme_time_intgr.h"
+
+#include "PointReactorKinetics/point_reactor_kinetics.h"
+
+#include "A_LBSSolver/IterativeMethods/wgs_context.h"
+#include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
+#include "A_LBSSolver/SourceFunctions/transient_source_function.h"
+#include "B_DiscreteOrdinatesSolver/lbs_discrete_ordinates_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
 
 namespace lbs
 {
@@ -27,6 +40,78 @@ chi::InputParameters TransientSolver::GetInputParameters()
   params.AddRequiredParameter<size_t>(
     "time_integration", "Handle to a time integration scheme to use");
 
+  params.AddOptionalParameter(
+    "reuse_solver_state",
+    true,
+    "If true, and the lbs solver was already initialized, e.g., by a steady "
+    "state or k-eigenvalue executor, its sweep structures, iterative solvers, "
+    "acceleration operators, flux moments, angular fluxes and precursors are "
+    "taken over as the initial state instead of initializing the solver "
+    "again.");
+
+  params.AddOptionalParameter(
+    "time_derivative",
+    "angular_flux",
+    "The angular flux at the start of the step in the time derivative. "
+    "\"angular_flux\" stores the angular fluxes of all the groupsets. "
+    "\"flux_moments\" expands them from the flux moments instead and "
+    "stores no angular fluxes, which is exact only for angular fluxes "
+    "representable by the moments of the scattering order.");
+  params.AddOptionalParameter("dt", 0.01, "Time step size [s]");
+  params.AddOptionalParameter("t_final", 0.1, "Final time of Execute [s]");
+  params.AddOptionalParameter(
+    "max_time_steps",
+    -1,
+    "Maximum number of time steps taken by Execute, unlimited if negative.");
+  params.AddOptionalParameter(
+    "verbosity",
+    1,
+    "0 logs nothing per step, 1 the fission production at the end of every "
+    "step, 2 also the start of every step.");
+
+  params.AddOptionalParameter(
+    "adaptive_time_stepping",
+    false,
+    "If true, Execute estimates the error of every step, from the "
+    "neutron population and precursor inventory, repeats the steps with "
+    "an error above adaptive_tolerance and scales dt, within "
+    "[dt_min, dt_max], to the tolerance. dt is the initial time step.");
+  params.AddOptionalParameter(
+    "adaptive_tolerance", 1.0e-3, "Relative error tolerance of a step.");
+  params.AddOptionalParameter(
+    "dt_min", 1.0e-7, "Minimum adaptive time step size [s]");
+  params.AddOptionalParameter(
+    "dt_max", 1.0e-1, "Maximum adaptive time step size [s]");
+
+  params.AddOptionalParameter<size_t>(
+    "amplitude_solver",
+    0,
+    "Handle to a point reactor kinetics solver, prk.TransientSolver, which "
+    "activates the improved quasi-static mode. The transport steps then "
+    "provide the shape of the flux, the amplitude of which is integrated by "
+    "the point kinetics solver on micro steps, with kinetics parameters "
+    "computed from the shape. Its kinetics parameters, reactivity and "
+    "source are set by this solver, its time integration is kept.");
+  params.AddOptionalParameter(
+    "iqs_micro_steps",
+    10,
+    "Number of amplitude micro steps per transport step of the improved "
+    "quasi-static mode.");
+
+  using namespace chi_data_types;
+  params.ConstrainParameterRange(
+    "time_derivative", AllowableRangeList::New({"angular_flux",
+                                                "flux_moments"}));
+  params.ConstrainParameterRange("dt", AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("adaptive_tolerance",
+                                 AllowableRangeLowLimit::New(1.0e-16));
+  params.ConstrainParameterRange("dt_min",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("dt_max",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("iqs_micro_steps",
+                                 AllowableRangeLowLimit::New(1));
+
   return params;
 }
 
@@ -35,16 +120,286 @@ TransientSolver::TransientSolver(const chi::InputParameters& params)
     lbs_solver_(Chi::GetStackItem<LBSSolver>(
       Chi::object_stack, params.GetParamValue<size_t>("lbs_solver_handle"))),
     time_integration_(Chi::GetStackItemPtrAsType<chi_math::TimeIntegration>(
-      Chi::object_stack, params.GetParamValue<size_t>("time_integration")))
+      Chi::object_stack, params.GetParamValue<size_t>("time_integration"))),
+    reuse_solver_state_(params.GetParamValue<bool>("reuse_solver_state")),
+    use_angular_flux_(params.GetParamValue<std::string>("time_derivative") ==
+                      "angular_flux"),
+    t_final_(params.GetParamValue<double>("t_final")),
+    max_time_steps_(params.GetParamValue<int>("max_time_steps")),
+    verbosity_(params.GetParamValue<int>("verbosity")),
+    adaptive_time_stepping_(
+      params.GetParamValue<bool>("adaptive_time_stepping")),
+    adaptive_tolerance_(params.GetParamValue<double>("adaptive_tolerance")),
+    dt_min_(params.GetParamValue<double>("dt_min")),
+    dt_max_(params.GetParamValue<double>("dt_max")),
+    iqs_micro_steps_(params.GetParamValue<int>("iqs_micro_steps")),
+    dt_(params.GetParamValue<double>("dt"))
+{
+  ChiInvalidArgumentIf(dt_min_ > dt_max_,
+                       "dt_min must not exceed dt_max.");
+
+  if (params.ParametersAtAssignment().Has("amplitude_solver"))
+    amplitude_solver_ = Chi::GetStackItemPtrAsType<prk::TransientSolver>(
+      Chi::object_stack, params.GetParamValue<size_t>("amplitude_solver"));
+}
+
+/**Initializes the lbs solver, or takes over its state when it was already
+ * initialized. On a takeover, the fission sources that a k-eigenvalue
+ * executor removes from the within-groupset scopes, being lagged by its
+ * power iterations, are restored. The state of the solver is then the
+ * initial condition, and the transient source function replaces that of
+ * the solver.*/
+void TransientSolver::Initialize()
+{
+  do_solver_ = dynamic_cast<DiscreteOrdinatesSolver*>(&lbs_solver_);
+  ChiInvalidArgumentIf(not do_solver_,
+                       TextName() + " requires a discrete ordinates solver.");
+
+  auto theta_scheme =
+    std::dynamic_pointer_cast<chi_math::ThetaSchemeTimeIntegration>(
+      time_integration_);
+  ChiInvalidArgumentIf(not theta_scheme,
+                       TextName() + " requires a theta scheme time "
+                                    "integration.");
+  theta_ = theta_scheme->ThetaFactor();
+  ChiInvalidArgumentIf(theta_ <= 0.0 or theta_ > 1.0,
+                       TextName() + " requires a theta in (0, 1].");
+
+  if (not(reuse_solver_state_ and lbs_solver_.IsInitialized()))
+  {
+    if (use_angular_flux_)
+    {
+      lbs_solver_.Options().save_angular_flux = true;
+      lbs_solver_.Options().save_angular_flux_groupsets.clear();
+    }
+    lbs_solver_.Initialize();
+  }
+  else
+  {
+    for (auto& wgs_solver : lbs_solver_.GetWGSSolvers())
+    {
+      auto wgs_context =
+        std::dynamic_pointer_cast<WGSContext<Mat, Vec, KSP>>(
+          wgs_solver->GetContext());
+      if (not wgs_context) continue;
+
+      wgs_context->lhs_src_scope_ |= APPLY_WGS_FISSION_SOURCES;
+      wgs_context->rhs_src_scope_ |= APPLY_AGS_FISSION_SOURCES;
+    }
+
+    Chi::log.Log() << TextName() << ": Reusing the initialized state of "
+                   << lbs_solver_.TextName() << ".";
+  }
+
+  do_solver_->CheckTimeDerivativeSupport();
+
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  for (size_t mat = 0; mat < cell_materials.NumMaterials(); ++mat)
+    ChiInvalidArgumentIf(cell_materials.XS(mat).InverseVelocity().size() !=
+                           lbs_solver_.NumGroups(),
+                         TextName() + " requires the inverse velocities of "
+                                      "all the groups of every material.");
+
+  //=========================================== Initial condition
+  phi_prev_local_ = lbs_solver_.PhiNewLocal();
+  precursor_prev_local_ = lbs_solver_.PrecursorsNewLocal();
+
+  auto& time_derivative = do_solver_->GetTimeDerivativeTerm();
+  time_derivative.inv_theta_dt = 0.0;
+  time_derivative.psi_prev.clear();
+  if (use_angular_flux_)
+  {
+    for (const auto& groupset : lbs_solver_.Groupsets())
+      ChiInvalidArgumentIf(not lbs_solver_.SavesAngularFlux(groupset.id_),
+                           TextName() + ": The angular flux time derivative "
+                           "requires the angular fluxes of all the "
+                           "groupsets to be saved, see save_angular_flux.");
+    time_derivative.psi_prev = lbs_solver_.PsiNewLocal();
+  }
+  else if (verbosity_ >= 0)
+    Chi::log.Log()
+      << TextName() << ": Time derivative from the flux moments: the "
+      << "angular flux at the start of the step is expanded from the flux "
+      << "moments instead of being stored. This is exact only when the "
+      << "angular flux is representable by the moments, i.e., the time "
+      << "derivative loses the angular detail beyond the scattering order, "
+      << "which matters most for streaming-dominated transients.";
+
+  source_function_ =
+    std::make_shared<TransientSourceFunction>(lbs_solver_, dt_, theta_);
+  source_function_->SetPreviousState(
+    use_angular_flux_ ? nullptr : &phi_prev_local_, &precursor_prev_local_);
+  do_solver_->ReplaceSourceFunction(source_function_);
+
+  InitializeIQS();
+
+  //=========================================== Adaptive history, the
+  //                                            initial condition being
+  //                                            its first point
+  adaptive_history_ = AdaptiveHistory();
+  if (adaptive_time_stepping_)
+  {
+    adaptive_history_.population[0] = ComputePopulation();
+    adaptive_history_.precursor_inventory[0] = ComputePrecursorInventory();
+    adaptive_history_.num_points = 1;
+  }
+}
+
+/**Takes time steps of size dt until the final time or the maximum number
+ * of steps is reached. With adaptive time stepping, the steps rejected by
+ * AdaptTimeStep are repeated with the reduced dt, and the last step is
+ * shortened to end at the final time.*/
+void TransientSolver::Execute()
 {
+  Chi::log.Log() << "Executing " << TextName() << ".";
+
+  int step_number = 0;
+  while ((max_time_steps_ < 0 or step_number < max_time_steps_) and
+         time_ + 1.0e-10 * dt_ < t_final_)
+  {
+    if (adaptive_time_stepping_ and t_final_ - time_ < dt_)
+      dt_ = t_final_ - time_;
+
+    Step();
+
+    //Rejected steps are repeated from the unchanged start of the step
+    if (adaptive_time_stepping_ and not AdaptTimeStep()) continue;
+
+    Advance();
+    ++step_number;
+  }
+
+  Chi::log.Log() << "Done Executing " << TextName() << ".";
+}
+
+/**Takes a theta-scheme time step of size dt from the state at the start
+ * of the step. The sweeps solve for the flux at the theta point, with the
+ * time derivative term, from which the flux moments, angular fluxes and
+ * precursor concentrations at the end of the step follow. The state at the
+ * start of the step is kept until Advance, hence a step can be repeated,
+ * e.g., with another dt. In the improved quasi-static mode, the amplitude
+ * of the flux is corrected, see CorrectIQSAmplitude, before the precursors
+ * are stepped with the delayed fission rates of the corrected flux.*/
+void TransientSolver::Step()
+{
+  const double eff_dt = theta_ * dt_;
+  if (verbosity_ >= 2)
+    Chi::log.Log() << TextName() << " Stepping with dt " << dt_;
+
+  //======================================== Evaluate the time dependent
+  //                                         sources and boundaries at the
+  //                                         theta point of the step
+  lbs_solver_.SetSourceEvaluationTime(time_ + eff_dt);
+
+  auto& time_derivative = do_solver_->GetTimeDerivativeTerm();
+  time_derivative.inv_theta_dt = 1.0 / eff_dt;
+
+  auto& phi_new = lbs_solver_.PhiNewLocal();
+  lbs_solver_.PhiOldLocal() = phi_prev_local_;
+  phi_new = phi_prev_local_;
+
+  auto& ags_solver = *lbs_solver_.GetPrimaryAGSSolver();
+  ags_solver.Setup();
+  ags_solver.Solve();
+
+  time_derivative.inv_theta_dt = 0.0;
+
+  //The leakage of the kinetics parameters is the outflow of these sweeps
+  KineticsParameters theta_parameters;
+  if (amplitude_solver_)
+    theta_parameters = ComputeKineticsParameters(phi_new);
+
+  //======================================== Compute t^{n+1} value
+  const double inv_theta = 1.0 / theta_;
+  for (size_t i = 0; i < phi_new.size(); ++i)
+    phi_new[i] = inv_theta * (phi_new[i] + (theta_ - 1.0) * phi_prev_local_[i]);
+
+  if (use_angular_flux_)
+  {
+    auto& psi_new = lbs_solver_.PsiNewLocal();
+    for (size_t gs = 0; gs < psi_new.size(); ++gs)
+    {
+      auto& psi = psi_new[gs];
+      const auto& psi_prev = time_derivative.psi_prev[gs];
+      for (size_t i = 0; i < psi.size(); ++i)
+        psi[i] = inv_theta * (psi[i] + (theta_ - 1.0) * psi_prev[i]);
+    }
+  }
+
+  if (amplitude_solver_) CorrectIQSAmplitude(theta_parameters);
+  lbs_solver_.PhiOldLocal() = phi_new;
+
+  //======================================== Precursors, from the delayed
+  //                                         fission rates at the theta point
+  if (lbs_solver_.Options().use_precursors)
+  {
+    std::vector<double> phi_theta(phi_new.size());
+    for (size_t i = 0; i < phi_new.size(); ++i)
+      phi_theta[i] = theta_ * phi_new[i] + (1.0 - theta_) * phi_prev_local_[i];
+
+    std::vector<double> delayed_fission_rates;
+    lbs_solver_.ComputeDelayedFissionRates(phi_theta, delayed_fission_rates);
+    lbs_solver_.GetPrecursorEngine().StepConcentrations(
+      lbs_solver_.GetCellMaterialTable(),
+      delayed_fission_rates,
+      precursor_prev_local_,
+      dt_,
+      theta_,
+      lbs_solver_.PrecursorsNewLocal());
+  }
+
+  //======================================== Print end of timestep
+  if (verbosity_ >= 1)
+  {
+    const double FR_new = lbs_solver_.ComputeFissionProduction(phi_new);
+
+    char buff[200];
+    snprintf(buff, 200, " dt=%.1e time=%10.4g FR=%12.6g",
+             dt_, time_ + dt_, FR_new);
+    Chi::log.Log() << TextName() << buff;
+  }
+
+  lbs_solver_.UpdateFieldFunctions();
 }
 
-void TransientSolver::Initialize() { lbs_solver_.Initialize(); }
+/**Advances the time by dt, the state at the end of the step becoming the
+ * state at the start of the next. A step estimated by AdaptTimeStep is
+ * recorded in the adaptive history and the next step takes its dt.*/
+void TransientSolver::Advance()
+{
+  auto& history = adaptive_history_;
+  const bool adapted = history.dt_next > 0.0;
+  if (adapted)
+  {
+    history.population[1] = history.population[0];
+    history.precursor_inventory[1] = history.precursor_inventory[0];
+    history.population[0] = history.step_population;
+    history.precursor_inventory[0] = history.step_precursor_inventory;
+    history.dt = dt_;
+    history.num_points = std::min<size_t>(history.num_points + 1, 2);
+  }
+
+  if (amplitude_solver_)
+  {
+    auto& state = iqs_state_;
+    state.reactivity = state.step_reactivity;
+    state.population = state.step_population;
+    state.amplitude_solution = state.step_amplitude_solution;
+  }
 
-void TransientSolver::Execute() {}
+  time_ += dt_;
 
-void TransientSolver::Step() {}
+  phi_prev_local_ = lbs_solver_.PhiNewLocal();
+  if (lbs_solver_.Options().use_precursors)
+    precursor_prev_local_ = lbs_solver_.PrecursorsNewLocal();
+  if (use_angular_flux_)
+    do_solver_->GetTimeDerivativeTerm().psi_prev = lbs_solver_.PsiNewLocal();
 
-void TransientSolver::Advance() {}
+  if (adapted)
+  {
+    dt_ = history.dt_next;
+    history.dt_next = 0.0;
+  }
+}
 
-} // namespace lbs
\ No newline at end of file
+} // namespace lbs
@@ -6,15 +6,91 @@ namespace chi_math
 {
 class TimeIntegration;
 }
+namespace prk
+{
+class TransientSolver;
+}
 
 namespace lbs
 {
 
+class DiscreteOrdinatesSolver;
+class TransientSourceFunction;
+
 class TransientSolver : public chi_physics::Solver
 {
 protected:
   LBSSolver& lbs_solver_;
   std::shared_ptr<chi_math::TimeIntegration> time_integration_;
+  const bool reuse_solver_state_;
+  /**True with the angular flux time derivative, false when the angular
+   * flux at the start of the step is expanded from the flux moments.*/
+  const bool use_angular_flux_;
+  const double t_final_;
+  const int max_time_steps_;
+  const int verbosity_;
+
+  const bool adaptive_time_stepping_;
+  const double adaptive_tolerance_;
+  const double dt_min_;
+  const double dt_max_;
+
+  /**Amplitude solver of the improved quasi-static mode, if any.*/
+  std::shared_ptr<prk::TransientSolver> amplitude_solver_;
+  const int iqs_micro_steps_;
+
+  DiscreteOrdinatesSolver* do_solver_ = nullptr;
+  std::shared_ptr<TransientSourceFunction> source_function_;
+
+  double dt_;
+  double theta_ = 1.0;
+  double time_ = 0.0;
+
+  /**Flux moments and precursor concentrations at the start of the step.
+   * The angular fluxes, with the angular flux time derivative, are those
+   * of the time derivative term of the solver.*/
+  std::vector<double> phi_prev_local_;
+  std::vector<double> precursor_prev_local_;
+
+  /**Neutron population and precursor inventory of the last two accepted
+   * times, [0] the latest, with the time step between them, and those of
+   * the latest step with the time step to follow it.*/
+  struct AdaptiveHistory
+  {
+    size_t num_points = 0;
+    double population[2] = {0.0, 0.0};
+    double precursor_inventory[2] = {0.0, 0.0};
+    double dt = 0.0;
+
+    double step_population = 0.0;
+    double step_precursor_inventory = 0.0;
+    double dt_next = 0.0;
+  } adaptive_history_;
+
+  /**Point kinetics parameters of a flux, with unit weighting. The
+   * reactivity is in dollars.*/
+  struct KineticsParameters
+  {
+    double reactivity = 0.0;
+    double generation_time = 0.0;
+    double beta = 0.0;
+    std::vector<double> betas;
+    std::vector<double> lambdas;
+  };
+
+  /**Improved quasi-static state of the last accepted time, and that of the
+   * latest step to be recorded on advancing.*/
+  struct IQSState
+  {
+    double reactivity_bias = 0.0;
+    double reactivity = 0.0;
+    double population = 0.0;
+    std::vector<double> amplitude_solution;
+
+    double step_reactivity = 0.0;
+    double step_population = 0.0;
+    std::vector<double> step_amplitude_solution;
+  } iqs_state_;
 
 public:
   static chi::InputParameters GetInputParameters();
@@ -24,6 +100,18 @@ public:
   void Execute() override;
   void Step() override;
   void Advance() override;
+  bool AdaptTimeStep();
+
+  double ComputePopulation() const;
+  double ComputePrecursorInventory() const;
+
+  KineticsParameters
+  ComputeKineticsParameters(const std::vector<double>& phi) const;
+  void InitializeIQS();
+  void CorrectIQSAmplitude(const KineticsParameters& theta_parameters);
+
+  double Time() const { return time_; }
+  double TimeStep() const { return dt_; }
 };
 
 }
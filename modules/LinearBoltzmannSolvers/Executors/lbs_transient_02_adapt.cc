@@ -0,0 +1,149 @@
+#include "lbs_transient.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lbs
+{
+
+//###################################################################
+/**Estimates the error of the latest step, accepts or rejects it, and
+ * sets the next time step.
+ *
+ * The error estimate is the predictor-corrector difference of the neutron
+ * population and precursor inventory, i.e., the relative difference of the
+ * step's values from their linear extrapolation through the last two
+ * accepted times. The difference being second order in the time step, the
+ * step is scaled by the square root of the tolerance over the error, with a
+ * safety factor, and limited to a factor of 5 reduction or 2 growth.
+ *
+ * A rejected step leaves the start of the step untouched, the step being
+ * repeated by Execute with the reduced time step. Steps at the minimum
+ * time step are always accepted. The first step, without a history to
+ * extrapolate from, is accepted with its time step kept.
+ *
+ * \return True when the step is accepted.*/
+bool TransientSolver::AdaptTimeStep()
+{
+  auto& history = adaptive_history_;
+
+  const double P_new = ComputePopulation();
+  const double C_new = ComputePrecursorInventory();
+
+  //============================================= Estimate the error
+  const bool estimated = history.num_points >= 2 and history.dt > 0.0;
+  double error = 0.0;
+  if (estimated)
+  {
+    auto RelativeDifference = [this, &history](const double* values,
+                                               double value)
+    {
+      const double slope = (values[0] - values[1]) / history.dt;
+      const double predicted = values[0] + slope * dt_;
+      const double scale = std::max(std::fabs(value), 1.0e-30);
+      return std::fabs(value - predicted) / scale;
+    };
+    error = RelativeDifference(history.population, P_new);
+    if (lbs_solver_.Options().use_precursors and
+        lbs_solver_.GetMaxPrecursorsPerMaterial() > 0)
+      error = std::max(
+        error, RelativeDifference(history.precursor_inventory, C_new));
+  }
+
+  //============================================= Scale the time step
+  double factor = estimated ? 2.0 : 1.0;
+  if (error > 0.0) factor = 0.9 * std::sqrt(adaptive_tolerance_ / error);
+  factor = std::min(std::max(factor, 0.2), 2.0);
+
+  const bool accepted = error <= adaptive_tolerance_ or dt_ <= dt_min_;
+  const double dt_step = dt_;
+  const double dt_next = std::min(std::max(dt_ * factor, dt_min_), dt_max_);
+
+  if (verbosity_ >= 1)
+  {
+    char buff[200];
+    snprintf(buff, 200, " Step %s dt=%.3e error=%.3e next dt=%.3e",
+             accepted ? "accepted" : "rejected", dt_step, error, dt_next);
+    Chi::log.Log() << TextName() << buff;
+  }
+
+  //Recorded in the history by Advance, which also applies dt_next
+  history.step_population = P_new;
+  history.step_precursor_inventory = C_new;
+  history.dt_next = dt_next;
+
+  if (not accepted) dt_ = dt_next;
+  return accepted;
+}
+
+//###################################################################
+/**Computes the global neutron population, i.e., the volume integral of
+ * the zeroth flux moments weighted with the inverse velocities.*/
+double TransientSolver::ComputePopulation() const
+{
+  const auto& phi = lbs_solver_.PhiNewLocal();
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& unit_cell_matrices = lbs_solver_.GetUnitCellMatrices();
+  const size_t num_groups = lbs_solver_.NumGroups();
+
+  std::vector<double> phi_scratch;
+  double local_population = 0.0;
+  for (const auto& transport_view : cell_transport_views)
+  {
+    const size_t cell_local_id =
+      &transport_view - cell_transport_views.data();
+    const auto& inv_velocity =
+      cell_materials.CellXS(cell_local_id).InverseVelocity();
+    const double* IntV_shapeI = unit_cell_matrices[cell_local_id].Vi_vectors;
+
+    for (int i = 0; i < transport_view.NumNodes(); ++i)
+    {
+      const double* phi_i =
+        transport_view.GroupValues(phi, i, 0, phi_scratch);
+      for (size_t g = 0; g < num_groups; ++g)
+        local_population += IntV_shapeI[i] * inv_velocity[g] * phi_i[g];
+    }
+  }
+
+  double population = 0.0;
+  MPI_Allreduce(&local_population, &population, 1,
+                MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+  return population;
+}
+
+//###################################################################
+/**Computes the global, volume integrated, precursor inventory.*/
+double TransientSolver::ComputePrecursorInventory() const
+{
+  const size_t J = lbs_solver_.GetMaxPrecursorsPerMaterial();
+  if (J == 0 or not lbs_solver_.Options().use_precursors) return 0.0;
+
+  const auto& precursors = lbs_solver_.PrecursorsNewLocal();
+  const auto& cell_materials = lbs_solver_.GetCellMaterialTable();
+  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& precursor_engine = lbs_solver_.GetPrecursorEngine();
+
+  double local_inventory = 0.0;
+  for (const auto& transport_view : cell_transport_views)
+  {
+    const size_t cell_local_id =
+      &transport_view - cell_transport_views.data();
+    const size_t num_precursors = precursor_engine.NumPrecursors(
+      cell_materials.CellMaterialIndex(cell_local_id));
+    for (size_t j = 0; j < num_precursors; ++j)
+      local_inventory +=
+        precursors[cell_local_id * J + j] * transport_view.Volume();
+  }
+
+  double inventory = 0.0;
+  MPI_Allreduce(&local_inventory, &inventory, 1,
+                MPI_DOUBLE, MPI_SUM, Chi::mpi.comm);
+  return inventory;
+}
+
+} // namespace lbs
@@ -0,0 +1,231 @@
+#include "lbs_transient.h"
+
+#include "PointReactorKinetics/point_reactor_kinetics.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+#include "chi_mpi.h"
+
+namespace lbs
+{
+
+//###################################################################
+/**Computes the point kinetics parameters of the given flux, weighted by
+ * unity, i.e., integrated over the domain and all groups.
+ *
+ * The reactivity is the static one, production less absorption and
+ * leakage over production, in dollars. The leakage is the outflow, through
+ * the non-reflecting boundaries, of the latest sweeps, such that incoming
+ * boundary fluxes are not accounted for. The decay constants are averaged
+ * over the materials, weighted by the delayed production of each
+ * precursor.*/
+TransientSolver::KineticsParameters
+TransientSolver::ComputeKineticsParameters(
+  const std::vector<double>& phi) const
+{
+  const size_t J = lbs_solver_.GetMaxPrecursorsPerMaterial();
+  const size_t num_groups = lbs_solver_.NumGroups();
+  const auto& grid = lbs_solver_.Grid();
+  const auto& cell_transport_views = lbs_solver_.GetCellTransportViews();
+  const auto& unit_cell_matrices = lbs_solver_.GetUnitCellMatrices();
+  const auto& sweep_boundaries = lbs_solver_.SweepBoundaries();
+
+  // Sums: [0] production, [1] absorption, [2] leakage, [3] population,
+  // [4+j] delayed production of precursor j, [4+J+j] decay constant
+  // weighted delayed production of precursor j
+  std::vector<double> local_sums(4 + 2 * J, 0.0);
+  std::vector<double> phi_scratch;
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto& transport_view = cell_transport_views[cell.local_id_];
+    const double* IntV_shapeI = unit_cell_matrices[cell.local_id_].Vi_vectors;
+    const auto& xs = transport_view.XS();
+    const auto& nu_sigma_f = xs.NuSigmaF();
+    const auto& nu_delayed_sigma_f = xs.NuDelayedSigmaF();
+    const auto& sigma_a = xs.SigmaAbsorption();
+    const auto& inv_velg = xs.InverseVelocity();
+    const auto& precursors = xs.Precursors();
+    const bool fissionable = xs.IsFissionable();
+
+    for (size_t f = 0; f < cell.faces_.size(); ++f)
+    {
+      const auto& face = cell.faces_[f];
+      if (face.has_neighbor_ or
+          sweep_boundaries.at(face.neighbor_id_)->IsReflecting())
+        continue;
+      for (size_t g = 0; g < num_groups; ++g)
+        local_sums[2] += transport_view.GetOutflow(static_cast<int>(f),
+                                                   static_cast<int>(g));
+    }
+
+    for (int i = 0; i < transport_view.NumNodes(); ++i)
+    {
+      const double* phi_i =
+        transport_view.GroupValues(phi, i, 0, phi_scratch);
+      const double V = IntV_shapeI[i];
+      for (size_t g = 0; g < num_groups; ++g)
+      {
+        const double phi_0g = phi_i[g];
+
+        local_sums[1] += sigma_a[g] * phi_0g * V;
+        local_sums[3] += inv_velg[g] * phi_0g * V;
+        if (not fissionable) continue;
+
+        local_sums[0] += nu_sigma_f[g] * phi_0g * V;
+        for (size_t j = 0; j < precursors.size(); ++j)
+        {
+          const double delayed_production =
+            precursors[j].fractional_yield * nu_delayed_sigma_f[g] * phi_0g *
+            V;
+          local_sums[4 + j] += delayed_production;
+          local_sums[4 + J + j] +=
+            precursors[j].decay_constant * delayed_production;
+        }
+      }
+    }
+  }
+
+  //Each angle team tallies only the outflow of the angles it sweeps
+  if (Chi::mpi.num_angle_teams > 1)
+    MPI_Allreduce(MPI_IN_PLACE, &local_sums[2], 1, MPI_DOUBLE, MPI_SUM,
+                  Chi::mpi.cross_team_comm);
+
+  std::vector<double> sums(local_sums.size(), 0.0);
+  MPI_Allreduce(local_sums.data(), sums.data(),
+                static_cast<int>(sums.size()), MPI_DOUBLE, MPI_SUM,
+                Chi::mpi.comm);
+
+  const double production = sums[0];
+  ChiLogicalErrorIf(production <= 0.0,
+                    TextName() + ": The kinetics parameters require a "
+                                 "positive fission production.");
+
+  KineticsParameters parameters;
+  parameters.generation_time = sums[3] / production;
+  for (size_t j = 0; j < J; ++j)
+  {
+    parameters.betas.push_back(sums[4 + j] / production);
+    parameters.lambdas.push_back(
+      sums[4 + j] > 0.0 ? sums[4 + J + j] / sums[4 + j] : 0.0);
+    parameters.beta += parameters.betas.back();
+  }
+
+  const double static_reactivity =
+    (production - sums[1] - sums[2]) / production;
+  parameters.reactivity =
+    parameters.beta > 0.0 ? static_reactivity / parameters.beta : 0.0;
+
+  return parameters;
+}
+
+//###################################################################
+/**Initializes the amplitude solver of the improved quasi-static mode
+ * with the kinetics parameters of the initial flux, which must be a
+ * solution of the lbs solver, e.g., of a steady state or k-eigenvalue
+ * executor. The initial reactivity, nonzero only through the
+ * discretization, is kept as a bias subtracted from the reactivities of
+ * all the steps.*/
+void TransientSolver::InitializeIQS()
+{
+  if (not amplitude_solver_) return;
+  ChiInvalidArgumentIf(not lbs_solver_.Options().use_precursors or
+                         lbs_solver_.GetMaxPrecursorsPerMaterial() == 0,
+                       TextName() + ": The improved quasi-static mode "
+                                    "requires delayed neutron precursors.");
+
+  const auto parameters = ComputeKineticsParameters(phi_prev_local_);
+
+  auto& amplitude_solver = *amplitude_solver_;
+  amplitude_solver.SetKineticsParameters(
+    parameters.lambdas, parameters.betas, parameters.generation_time);
+  amplitude_solver.SetRho(0.0);
+  amplitude_solver.SetSourceStrength(0.0);
+  amplitude_solver.Initialize();
+
+  iqs_state_ = IQSState();
+  iqs_state_.reactivity_bias = parameters.reactivity;
+  iqs_state_.population = ComputePopulation();
+  iqs_state_.amplitude_solution = amplitude_solver.SolutionPrev();
+
+  if (verbosity_ >= 0)
+  {
+    char buff[200];
+    snprintf(buff, 200, " IQS Lambda=%.4e beta=%.2f [pcm] bias=%.3e [$]",
+             parameters.generation_time, parameters.beta * 1e5,
+             parameters.reactivity);
+    Chi::log.Log() << TextName() << buff;
+  }
+}
+
+//###################################################################
+/**Corrects the amplitude of the step's flux at the end of the step with
+ * the amplitude solver.
+ *
+ * The flux of the transport step provides the shape. Its kinetics
+ * parameters, of the flux at the theta point of the step, are the ones of
+ * the latest sweeps' leakage, the reactivity at the end of the step being
+ * extrapolated from the theta point like the flux. The amplitude equation is
+ * integrated over the step on the micro steps, the reactivity interpolated
+ * linearly over the step. The flux moments and angular fluxes are then
+ * scaled such that the population follows the integrated amplitude, i.e.,
+ * the shape is normalized to the population at the start of the step.
+ *
+ * The amplitude solver is reset to the state at the start of the step
+ * before integrating, such that rejected or repeated steps are retaken.*/
+void TransientSolver::CorrectIQSAmplitude(
+  const KineticsParameters& theta_parameters)
+{
+  auto& state = iqs_state_;
+  auto& amplitude_solver = *amplitude_solver_;
+
+  const double theta_reactivity =
+    theta_parameters.reactivity - state.reactivity_bias;
+  const double reactivity =
+    (theta_reactivity + (theta_ - 1.0) * state.reactivity) / theta_;
+
+  //============================================= Integrate the amplitude
+  amplitude_solver.SetKineticsParameters(theta_parameters.lambdas,
+                                         theta_parameters.betas,
+                                         theta_parameters.generation_time);
+  amplitude_solver.SetState(time_, state.amplitude_solution);
+
+  amplitude_solver.SetTimeStep(dt_ / iqs_micro_steps_);
+  for (int k = 0; k < iqs_micro_steps_; ++k)
+  {
+    const double fraction = (k + 0.5) / iqs_micro_steps_;
+    amplitude_solver.SetRho(state.reactivity +
+                            fraction * (reactivity - state.reactivity));
+    amplitude_solver.Step();
+    amplitude_solver.Advance();
+  }
+
+  const double amplitude_ratio =
+    amplitude_solver.PopulationPrev() / state.amplitude_solution.front();
+
+  //============================================= Scale the step's solution
+  const double population = ComputePopulation();
+  const double scale = amplitude_ratio * state.population / population;
+
+  for (double& value : lbs_solver_.PhiNewLocal())
+    value *= scale;
+  for (auto& psi : lbs_solver_.PsiNewLocal())
+    for (double& value : psi)
+      value *= scale;
+
+  state.step_reactivity = reactivity;
+  state.step_population = population * scale;
+  state.step_amplitude_solution = amplitude_solver.SolutionPrev();
+
+  if (verbosity_ >= 2)
+  {
+    char buff[200];
+    snprintf(buff, 200, " IQS rho=%.4e [$] amplitude ratio=%.6g scale=%.6g",
+             reactivity, amplitude_ratio, scale);
+    Chi::log.Log() << TextName() << buff;
+  }
+}
+
+} // namespace lbs
@@ -14,6 +14,12 @@ protected:
   size_t max_iters_;
   double k_tolerance_;
   bool reinit_phi_1_;
+  bool inexact_inners_;
+  double inexact_initial_tol_;
+  double inexact_factor_;
+  const std::string initial_guess_;
+  size_t initial_guess_max_iters_;
+  double initial_guess_k_tol_;
 
   VecDbl& q_moments_local_;
   VecDbl& phi_old_local_;
@@ -26,6 +32,9 @@ protected:
   std::shared_ptr<lbs::WGSContext<Mat, Vec, KSP>> front_wgs_context_;
 
   double k_eff_ = 1.0;
+  /**The k-eigenvalue the iterations start from, that of the initial
+   * guess if any.*/
+  double initial_k_eff_ = 1.0;
 
 public:
   static chi::InputParameters GetInputParameters();
@@ -39,6 +48,12 @@ protected:
   void SetLBSFissionSource(const VecDbl& input, bool additive);
   void SetLBSScatterSource(const VecDbl& input, bool additive,
                            bool suppress_wg_scat = false);
+
+  double InexactInnerTolerance(double outer_change) const;
+  bool SetWGSRelaxedTolerance(double tolerance);
+  double FissionSourceChange(VecDbl& prev_source) const;
+
+  void ComputeDiffusionInitialGuess();
 };
 
 }
@@ -36,6 +36,50 @@ chi::InputParameters XXPowerIterationKEigen::GetInputParameters()
   params.AddOptionalParameter(
     "reinit_phi_1", true, "If true, reinitializes scalar phi fluxes to 1");
 
+  params.AddOptionalParameter(
+    "inexact_inners",
+    false,
+    "If true, the within-groupset solves of early outer iterations are only "
+    "converged to a relaxed tolerance, which is tightened towards each "
+    "groupset's own tolerance as k and the fission source converge.");
+  params.AddOptionalParameter(
+    "inexact_initial_tol",
+    1.0e-2,
+    "Within-groupset residual tolerance for the first outer iteration when "
+    "inexact_inners is enabled. It is also the loosest tolerance used.");
+  params.AddOptionalParameter(
+    "inexact_factor",
+    1.0e-1,
+    "Factor applied to the last outer change (the larger of the relative "
+    "changes in k and in the fission source) to obtain the within-groupset "
+    "residual tolerance when inexact_inners is enabled.");
+
+  params.AddOptionalParameter(
+    "initial_guess",
+    "NONE",
+    "Initial guess of the flux and k-eigenvalue. \"DIFFUSION\" starts the "
+    "power iterations from the solution of the multigroup diffusion "
+    "k-eigenvalue problem on the same grid and discretization, obtained "
+    "with MIP diffusion solves of every groupset.");
+  params.AddOptionalParameter(
+    "initial_guess_max_iters",
+    100,
+    "Maximum power iterations of the diffusion initial guess.");
+  params.AddOptionalParameter(
+    "initial_guess_k_tol",
+    1.0e-5,
+    "Tolerance on the k-eigenvalue of the diffusion initial guess.");
+
+  using namespace chi_data_types;
+  params.ConstrainParameterRange(
+    "initial_guess", AllowableRangeList::New({"NONE", "DIFFUSION"}));
+  params.ConstrainParameterRange("initial_guess_k_tol",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("inexact_initial_tol",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("inexact_factor",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+
   return params;
 }
 
@@ -47,6 +91,13 @@ XXPowerIterationKEigen::XXPowerIterationKEigen(
     max_iters_(params.GetParamValue<size_t>("max_iters")),
     k_tolerance_(params.GetParamValue<double>("k_tol")),
     reinit_phi_1_(params.GetParamValue<bool>("reinit_phi_1")),
+    inexact_inners_(params.GetParamValue<bool>("inexact_inners")),
+    inexact_initial_tol_(params.GetParamValue<double>("inexact_initial_tol")),
+    inexact_factor_(params.GetParamValue<double>("inexact_factor")),
+    initial_guess_(params.GetParamValue<std::string>("initial_guess")),
+    initial_guess_max_iters_(
+      params.GetParamValue<size_t>("initial_guess_max_iters")),
+    initial_guess_k_tol_(params.GetParamValue<double>("initial_guess_k_tol")),
 
     q_moments_local_(lbs_solver_.QMomentsLocal()),
     phi_old_local_(lbs_solver_.PhiOldLocal()),
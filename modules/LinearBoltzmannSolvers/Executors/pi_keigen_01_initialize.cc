@@ -41,6 +41,8 @@ void XXPowerIterationKEigen::Initialize()
   ChiLogicalErrorIf(not front_wgs_context_, ": Casting failure");
 
   if (reinit_phi_1_) lbs_solver_.SetPhiVectorScalarValues(phi_old_local_, 1.0);
+
+  if (initial_guess_ == "DIFFUSION") ComputeDiffusionInitialGuess();
 }
 
 } // namespace lbs
\ No newline at end of file
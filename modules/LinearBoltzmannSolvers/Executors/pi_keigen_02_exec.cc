@@ -3,6 +3,7 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
 
 #include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
 
@@ -18,9 +19,11 @@ void XXPowerIterationKEigen::Execute()
   using namespace chi_math;
 
   double F_prev = 1.0;
-  k_eff_ = 1.0;
-  double k_eff_prev = 1.0;
+  k_eff_ = initial_k_eff_;
+  double k_eff_prev = k_eff_;
   double k_eff_change = 1.0;
+  VecDbl prev_fission_source;
+  double inner_tol = inexact_initial_tol_;
 
   //================================================== Start power iterations
   int nit = 0;
@@ -31,6 +34,15 @@ void XXPowerIterationKEigen::Execute()
     SetLBSFissionSource(phi_old_local_, /*additive=*/false);
     Scale(q_moments_local_, 1.0 / k_eff_);
 
+    //================================= Relax the inner tolerance
+    bool inners_at_tolerance = true;
+    double fission_source_change = 0.0;
+    if (inexact_inners_)
+    {
+      fission_source_change = FissionSourceChange(prev_fission_source);
+      inners_at_tolerance = SetWGSRelaxedTolerance(inner_tol);
+    }
+
     //================================= This solves the inners for transport
     primary_ags_solver_->Setup();
     primary_ags_solver_->Solve();
@@ -46,7 +58,14 @@ void XXPowerIterationKEigen::Execute()
     F_prev = F_new;
     nit += 1;
 
-    if (k_eff_change < std::max(k_tolerance_, 1.0e-12)) converged = true;
+    if (k_eff_change < std::max(k_tolerance_, 1.0e-12))
+    {
+      if (inners_at_tolerance) converged = true;
+      else inner_tol = 0.0;
+    }
+    else if (inexact_inners_)
+      inner_tol =
+        InexactInnerTolerance(std::max(k_eff_change, fission_source_change));
 
     //================================= Print iteration summary
     if (lbs_solver_.Options().verbose_outer_iterations)
@@ -62,9 +81,24 @@ void XXPowerIterationKEigen::Execute()
       Chi::log.Log() << k_iter_info.str();
     }
 
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "power_iteration")
+                       .Add("iteration", nit)
+                       .Add("k_eff", k_eff_)
+                       .Add("k_eff_change", k_eff_change)
+                       .Add("reactivity", reactivity)
+                       .Add("sweeps",
+                            front_wgs_context_->counter_applications_of_inv_op_)
+                       .Add("converged", converged));
+
     if (converged) break;
   } // for k iterations
 
+  if (inexact_inners_) SetWGSRelaxedTolerance(0.0);
+
   //================================================== Print summary
   Chi::log.Log() << "\n";
   Chi::log.Log() << "        Final k-eigenvalue    :        "
@@ -2,6 +2,11 @@
 
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "A_LBSSolver/IterativeMethods/wgs_context.h"
+
+#include <cmath>
 
 namespace lbs
 {
@@ -33,4 +38,62 @@ void XXPowerIterationKEigen::SetLBSScatterSource(
       (suppress_wg_scat ? SUPPRESS_WG_SCATTER : NO_FLAGS_SET));
 }
 
-} // namespace lbs
\ No newline at end of file
+// ##################################################################
+/**Returns the relaxed within-groupset residual tolerance for an outer
+ * iteration following one with the given relative change.*/
+double XXPowerIterationKEigen::InexactInnerTolerance(
+  const double outer_change) const
+{
+  return std::min(inexact_initial_tol_, inexact_factor_ * outer_change);
+}
+
+// ##################################################################
+/**Sets the relaxed residual tolerance of all the within-groupset solvers,
+ * zero restoring the groupset tolerances. Returns true when no groupset
+ * is solved to a looser tolerance than its own.*/
+bool XXPowerIterationKEigen::SetWGSRelaxedTolerance(const double tolerance)
+{
+  bool at_groupset_tolerances = true;
+  for (auto& wgs_solver : lbs_solver_.GetWGSSolvers())
+  {
+    auto wgs_context =
+      std::dynamic_pointer_cast<lbs::WGSContext<Mat, Vec, KSP>>(
+        wgs_solver->GetContext());
+
+    wgs_context->relaxed_residual_tolerance_ = tolerance;
+    if (tolerance > wgs_context->groupset_.residual_tolerance_)
+      at_groupset_tolerances = false;
+  }
+  return at_groupset_tolerances;
+}
+
+// ##################################################################
+/**Returns the relative L2 change between the fission source currently in
+ * the source moments and the given previous source, which is then replaced
+ * by the current one. The first call returns 1.*/
+double XXPowerIterationKEigen::FissionSourceChange(VecDbl& prev_source) const
+{
+  const bool first = prev_source.size() != q_moments_local_.size();
+
+  double local_norms[2] = {0.0, 0.0};
+  if (not first)
+    for (size_t i = 0; i < q_moments_local_.size(); ++i)
+    {
+      const double diff = q_moments_local_[i] - prev_source[i];
+      local_norms[0] += diff * diff;
+      local_norms[1] += q_moments_local_[i] * q_moments_local_[i];
+    }
+  prev_source = q_moments_local_;
+
+  double global_norms[2] = {0.0, 0.0};
+  MPI_Allreduce(local_norms,    //sendbuf
+                global_norms,   //recvbuf
+                2, MPI_DOUBLE,  //count+datatype
+                MPI_SUM,        //operation
+                Chi::mpi.comm); //communicator
+
+  if (first or global_norms[1] <= 0.0) return 1.0;
+  return std::sqrt(global_norms[0] / global_norms[1]);
+}
+
+} // namespace lbs
@@ -0,0 +1,184 @@
+#include "pi_keigen.h"
+
+#include "A_LBSSolver/Acceleration/diffusion_mip.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include <cmath>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Computes the initial flux and k-eigenvalue of the power iterations
+ * from the multigroup diffusion k-eigenvalue problem.
+ *
+ * A MIP diffusion solver is made for every groupset, on the spatial
+ * discretization of the LBS solver and with Marshak vacuum boundaries.
+ * Each power iteration solves the groupsets in sequence for their scalar
+ * fluxes, with the fission source of the previous iteration and the
+ * scattering sources, within-group scattering excepted, of the latest
+ * fluxes. The resulting scalar flux, normalized to unit fission
+ * production, replaces the flux moments of the LBS solver, the higher
+ * moments being zero.*/
+void XXPowerIterationKEigen::ComputeDiffusionInitialGuess()
+{
+  typedef acceleration::DiffusionMIPSolver MIPSolver;
+  typedef const int64_t cint64;
+
+  const auto& grid = lbs_solver_.Grid();
+  const auto& sdm = lbs_solver_.SpatialDiscretization();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
+
+  //=========================================== Make the diffusion solvers
+  const auto bcs = acceleration::TranslateBCs(
+    lbs_solver_.SweepBoundaries(), /*vaccum_bcs_are_dirichlet=*/false);
+
+  std::vector<std::shared_ptr<MIPSolver>> diffusion_solvers;
+  for (const auto& groupset : groupsets_)
+  {
+    chi_math::UnknownManager uk_man;
+    uk_man.AddUnknown(chi_math::UnknownType::VECTOR_N,
+                      groupset.groups_.size());
+
+    auto matid_2_mgxs_map =
+      acceleration::PackGroupsetXS(lbs_solver_.GetMatID2XSMap(),
+                                   groupset.groups_.front().id_,
+                                   groupset.groups_.back().id_);
+
+    auto solver = std::make_shared<MIPSolver>(
+      TextName() + "_InitialGuess" + std::to_string(groupset.id_),
+      sdm,
+      uk_man,
+      bcs,
+      matid_2_mgxs_map,
+      lbs_solver_.GetUnitCellMatrices(),
+      false); // verbosity
+    solver->options.residual_tolerance = 0.1 * initial_guess_k_tol_;
+
+    solver->Initialize();
+    const std::vector<double> dummy_rhs(sdm.GetNumLocalDOFs(uk_man), 0.0);
+    solver->AssembleAand_b(dummy_rhs);
+
+    diffusion_solvers.push_back(std::move(solver));
+  }
+
+  //=========================================== Scalar flux copies
+  // Between the scalar flux of the groupset groups in an LBS flux moments
+  // vector and a diffusion vector
+  auto MapPhi0 = [&](const LBSGroupset& groupset, auto copy_function)
+  {
+    const auto& diff_uk_man =
+      diffusion_solvers[groupset.id_]->UnknownStructure();
+    const int gsi = groupset.groups_.front().id_;
+    const size_t gss = groupset.groups_.size();
+
+    for (const auto& cell : grid.local_cells)
+    {
+      const size_t num_nodes = sdm.GetCellMapping(cell).NumNodes();
+      for (size_t i = 0; i < num_nodes; ++i)
+      {
+        cint64 diff_map = sdm.MapDOFLocal(cell, i, diff_uk_man, 0, 0);
+        cint64 lbs_map = transport_views[cell.local_id_].MapDOF(i, 0, gsi);
+        for (size_t g = 0; g < gss; ++g)
+          copy_function(diff_map + g, lbs_map + g);
+      }
+    }
+  };
+  auto CopyOnlyPhi0 = [&](const LBSGroupset& groupset,
+                          const std::vector<double>& lbs_vector,
+                          std::vector<double>& diff_vector)
+  {
+    const auto& diff_uk_man =
+      diffusion_solvers[groupset.id_]->UnknownStructure();
+    diff_vector.assign(sdm.GetNumLocalDOFs(diff_uk_man), 0.0);
+    MapPhi0(groupset,
+            [&](cint64 diff_map, cint64 lbs_map)
+            { diff_vector[diff_map] = lbs_vector[lbs_map]; });
+  };
+  auto ProjectBackPhi0 = [&](const LBSGroupset& groupset,
+                             const std::vector<double>& diff_vector,
+                             std::vector<double>& lbs_vector)
+  {
+    MapPhi0(groupset,
+            [&](cint64 diff_map, cint64 lbs_map)
+            { lbs_vector[lbs_map] = diff_vector[diff_map]; });
+  };
+
+  //=========================================== Start from a flat flux
+  chi_math::Set(phi_old_local_, 0.0);
+  lbs_solver_.SetPhiVectorScalarValues(phi_old_local_, 1.0);
+
+  double F_prev = lbs_solver_.ComputeFissionProduction(phi_old_local_);
+  ChiInvalidArgumentIf(F_prev <= 0.0,
+                       "The diffusion initial guess requires a fission "
+                       "production.");
+
+  //=========================================== Power iterations
+  double k_eff = 1.0;
+  double k_eff_change = 1.0;
+  std::vector<double> q0;
+  std::vector<double> phi0;
+  size_t nit = 0;
+  while (nit < initial_guess_max_iters_)
+  {
+    const auto fission_phi = phi_old_local_;
+    for (auto& groupset : groupsets_)
+    {
+      //============================ Sources of the groupset
+      chi_math::Set(q_moments_local_, 0.0);
+      active_set_source_function_(groupset,
+                                  q_moments_local_,
+                                  fission_phi,
+                                  APPLY_AGS_FISSION_SOURCES |
+                                    APPLY_WGS_FISSION_SOURCES);
+      chi_math::Scale(q_moments_local_, 1.0 / k_eff);
+      active_set_source_function_(groupset,
+                                  q_moments_local_,
+                                  phi_old_local_,
+                                  APPLY_AGS_SCATTER_SOURCES |
+                                    APPLY_WGS_SCATTER_SOURCES |
+                                    SUPPRESS_WG_SCATTER);
+
+      //============================ Diffusion solve
+      auto& diffusion_solver = *diffusion_solvers[groupset.id_];
+      CopyOnlyPhi0(groupset, q_moments_local_, q0);
+      CopyOnlyPhi0(groupset, phi_old_local_, phi0);
+
+      diffusion_solver.Assemble_b(q0);
+      diffusion_solver.Solve(phi0, /*use_initial_guess=*/true);
+
+      ProjectBackPhi0(groupset, phi0, phi_old_local_);
+    } // for groupset
+
+    //=================================== Recompute k-eigenvalue
+    const double F_new = lbs_solver_.ComputeFissionProduction(phi_old_local_);
+    const double k_eff_new = F_new / F_prev * k_eff;
+
+    k_eff_change = std::fabs(k_eff_new - k_eff) / k_eff_new;
+    k_eff = k_eff_new;
+    F_prev = F_new;
+    ++nit;
+
+    if (lbs_solver_.Options().verbose_outer_iterations)
+      Chi::log.Log() << "  Diffusion initial guess iteration " << nit
+                     << "  k_eff " << k_eff << "  k_eff change "
+                     << k_eff_change;
+
+    if (k_eff_change < initial_guess_k_tol_) break;
+  } // while nit
+
+  //=========================================== Install the initial guess
+  chi_math::Scale(phi_old_local_, 1.0 / F_prev);
+  phi_new_local_ = phi_old_local_;
+  initial_k_eff_ = k_eff;
+
+  Chi::log.Log() << "Diffusion initial guess: k_eff " << k_eff << " after "
+                 << nit << " iterations, k_eff change " << k_eff_change;
+}
+
+} // namespace lbs
@@ -0,0 +1,29 @@
+#ifndef CHITECH_PI_KEIGEN_ANDERSON_H
+#define CHITECH_PI_KEIGEN_ANDERSON_H
+
+#include "pi_keigen.h"
+
+namespace lbs
+{
+
+/**Power iteration k-eigenvalue solver where the fission-source iterate is
+ * updated with Anderson acceleration. Each outer iteration applies the
+ * power iteration map, i.e. one inverse transport operator application,
+ * and mixes the last `anderson_depth` iterates by solving a small least
+ * squares problem for the combination with the smallest residual.*/
+class XXPowerIterationKEigenAnderson : public XXPowerIterationKEigen
+{
+protected:
+  size_t anderson_depth_;
+
+public:
+  static chi::InputParameters GetInputParameters();
+
+  explicit XXPowerIterationKEigenAnderson(const chi::InputParameters& params);
+
+  void Execute() override;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_PI_KEIGEN_ANDERSON_H
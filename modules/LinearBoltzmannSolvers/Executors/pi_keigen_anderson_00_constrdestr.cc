@@ -0,0 +1,40 @@
+#include "pi_keigen_anderson.h"
+
+#include "ChiObjectFactory.h"
+
+#include "chi_runtime.h"
+
+namespace lbs
+{
+
+RegisterChiObject(lbs, XXPowerIterationKEigenAnderson);
+
+chi::InputParameters XXPowerIterationKEigenAnderson::GetInputParameters()
+{
+  chi::InputParameters params = XXPowerIterationKEigen::GetInputParameters();
+
+  params.SetGeneralDescription(
+    "Generalized implementation of a k-Eigenvalue solver using Power "
+    "Iteration with Anderson acceleration of the fission source.");
+  params.SetDocGroup("LBSExecutors");
+
+  params.ChangeExistingParamToOptional("name",
+                                       "XXPowerIterationKEigenAnderson");
+
+  params.AddOptionalParameter(
+    "anderson_depth",
+    5,
+    "Number of previous iterates mixed by the Anderson acceleration. A value "
+    "of 0 reverts to unaccelerated power iteration.");
+
+  return params;
+}
+
+XXPowerIterationKEigenAnderson::XXPowerIterationKEigenAnderson(
+  const chi::InputParameters& params)
+  : XXPowerIterationKEigen(params),
+    anderson_depth_(params.GetParamValue<size_t>("anderson_depth"))
+{
+}
+
+} // namespace lbs
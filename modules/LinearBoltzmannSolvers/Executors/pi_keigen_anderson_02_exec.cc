@@ -0,0 +1,230 @@
+#include "pi_keigen_anderson.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
+
+#include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
+
+#include <cmath>
+#include <deque>
+#include <iomanip>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Executes the solver.
+ *
+ * The iterate x is the flux normalized to unit fission production. The
+ * power iteration map is g = G(x), i.e. the transport solution with the
+ * fission source F x / k normalized to unit production, with residual
+ * f = g - x. With the differences dF_i, dG_i of the last m residuals and
+ * maps, the next iterate is x = g - sum_i gamma_i dG_i where gamma
+ * minimizes ||f - sum_i gamma_i dF_i||, obtained from the (globally
+ * reduced) normal equations.*/
+void XXPowerIterationKEigenAnderson::Execute()
+{
+  using namespace chi_math;
+
+  k_eff_ = initial_k_eff_;
+  double k_eff_prev = k_eff_;
+  double k_eff_change = 1.0;
+  VecDbl prev_fission_source;
+  double inner_tol = inexact_initial_tol_;
+
+  //================================================== Normalize the initial
+  //                                                   iterate
+  Scale(phi_old_local_,
+        1.0 / lbs_solver_.ComputeFissionProduction(phi_old_local_));
+
+  std::deque<VecDbl> dF_history;
+  std::deque<VecDbl> dG_history;
+  VecDbl f_prev;
+  VecDbl g_prev;
+
+  //================================================== Start power iterations
+  int nit = 0;
+  bool converged = false;
+  while (nit < max_iters_)
+  {
+    const VecDbl x = phi_old_local_;
+
+    //================================= Set the fission source
+    SetLBSFissionSource(phi_old_local_, /*additive=*/false);
+    Scale(q_moments_local_, 1.0 / k_eff_);
+
+    //================================= Relax the inner tolerance
+    bool inners_at_tolerance = true;
+    double fission_source_change = 0.0;
+    if (inexact_inners_)
+    {
+      fission_source_change = FissionSourceChange(prev_fission_source);
+      inners_at_tolerance = SetWGSRelaxedTolerance(inner_tol);
+    }
+
+    //================================= This solves the inners for transport
+    primary_ags_solver_->Setup();
+    primary_ags_solver_->Solve();
+
+    //================================= Recompute k-eigenvalue
+    //x has unit production, hence the production of the solution is the
+    //ratio of the new and old eigenvalues
+    const double production =
+      lbs_solver_.ComputeFissionProduction(phi_new_local_);
+    k_eff_ = production * k_eff_;
+    double reactivity = (k_eff_ - 1.0) / k_eff_;
+
+    //================================= Map and residual
+    VecDbl g = phi_new_local_;
+    Scale(g, 1.0 / production);
+    VecDbl f = g - x;
+
+    if (not f_prev.empty() and anderson_depth_ > 0)
+    {
+      dF_history.push_back(f - f_prev);
+      dG_history.push_back(g - g_prev);
+      if (dF_history.size() > anderson_depth_)
+      {
+        dF_history.pop_front();
+        dG_history.pop_front();
+      }
+    }
+
+    //================================= Anderson mixing
+    VecDbl x_next = g;
+    const size_t m = dF_history.size();
+    if (m > 0)
+    {
+      //local normal equations packed as [A (m x m), b (m)]
+      std::vector<double> local_ne(m * m + m, 0.0);
+      for (size_t i = 0; i < m; ++i)
+      {
+        for (size_t j = i; j < m; ++j)
+          local_ne[i * m + j] = Dot(dF_history[i], dF_history[j]);
+        local_ne[m * m + i] = Dot(dF_history[i], f);
+      }
+
+      std::vector<double> global_ne(local_ne.size(), 0.0);
+      MPI_Allreduce(local_ne.data(),  //sendbuf
+                    global_ne.data(), //recvbuf
+                    static_cast<int>(global_ne.size()), MPI_DOUBLE,
+                    MPI_SUM,          //operation
+                    Chi::mpi.comm);   //communicator
+
+      double max_diag = 0.0;
+      for (size_t i = 0; i < m; ++i)
+        max_diag = std::max(max_diag, global_ne[i * m + i]);
+
+      if (max_diag > 0.0)
+      {
+        MatDbl A(m, VecDbl(m, 0.0));
+        VecDbl gamma(m, 0.0);
+        for (size_t i = 0; i < m; ++i)
+        {
+          for (size_t j = i; j < m; ++j)
+            A[i][j] = A[j][i] = global_ne[i * m + j];
+          A[i][i] += 1.0e-12 * max_diag;
+          gamma[i] = global_ne[m * m + i];
+        }
+        GaussElimination(A, gamma, static_cast<int>(m));
+
+        for (size_t i = 0; i < m; ++i)
+        {
+          const auto& dG_i = dG_history[i];
+          for (size_t k = 0; k < x_next.size(); ++k)
+            x_next[k] -= gamma[i] * dG_i[k];
+        }
+      }
+    }
+
+    //================================= Normalize the new iterate, falling
+    //                                  back to power iteration when the
+    //                                  mixed iterate has no production
+    const double x_next_production =
+      m > 0 ? lbs_solver_.ComputeFissionProduction(x_next) : 1.0;
+    if (x_next_production > 0.0 and std::isfinite(x_next_production))
+      Scale(x_next, 1.0 / x_next_production);
+    else
+    {
+      x_next = g;
+      dF_history.clear();
+      dG_history.clear();
+    }
+
+    phi_old_local_ = std::move(x_next);
+    f_prev = std::move(f);
+    g_prev = std::move(g);
+
+    //================================= Check convergence, bookkeeping
+    k_eff_change = fabs(k_eff_ - k_eff_prev) / k_eff_;
+    k_eff_prev = k_eff_;
+    nit += 1;
+
+    if (k_eff_change < std::max(k_tolerance_, 1.0e-12))
+    {
+      if (inners_at_tolerance) converged = true;
+      else inner_tol = 0.0;
+    }
+    else if (inexact_inners_)
+      inner_tol =
+        InexactInnerTolerance(std::max(k_eff_change, fission_source_change));
+
+    //================================= Print iteration summary
+    if (lbs_solver_.Options().verbose_outer_iterations)
+    {
+      std::stringstream k_iter_info;
+      k_iter_info << Chi::program_timer.GetTimeString() << " "
+                  << "  Iteration " << std::setw(5) << nit << "  k_eff "
+                  << std::setw(11) << std::setprecision(7) << k_eff_
+                  << "  k_eff change " << std::setw(12) << k_eff_change
+                  << "  reactivity " << std::setw(10) << reactivity * 1e5
+                  << "  depth " << std::setw(2) << m;
+      if (converged) k_iter_info << " CONVERGED\n";
+
+      Chi::log.Log() << k_iter_info.str();
+    }
+
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "power_iteration_anderson")
+                       .Add("iteration", nit)
+                       .Add("k_eff", k_eff_)
+                       .Add("k_eff_change", k_eff_change)
+                       .Add("reactivity", reactivity)
+                       .Add("sweeps",
+                            front_wgs_context_->counter_applications_of_inv_op_)
+                       .Add("converged", converged));
+
+    if (converged) break;
+  } // for k iterations
+
+  if (inexact_inners_) SetWGSRelaxedTolerance(0.0);
+
+  //================================================== Print summary
+  Chi::log.Log() << "\n";
+  Chi::log.Log() << "        Final k-eigenvalue    :        "
+                 << std::setprecision(7) << k_eff_;
+  Chi::log.Log() << "        Final change          :        "
+                 << std::setprecision(6) << k_eff_change << " (num_TrOps:"
+                 << front_wgs_context_->counter_applications_of_inv_op_ << ")"
+                 << "\n";
+  Chi::log.Log() << "\n";
+
+  if (lbs_solver_.Options().use_precursors)
+  {
+    lbs_solver_.ComputePrecursors();
+    chi_math::Scale(lbs_solver_.PrecursorsNewLocal(), 1.0 / k_eff_);
+  }
+
+  lbs_solver_.UpdateFieldFunctions();
+
+  Chi::log.Log()
+    << "LinearBoltzmann::KEigenvalueSolver execution completed\n\n";
+}
+
+} // namespace lbs
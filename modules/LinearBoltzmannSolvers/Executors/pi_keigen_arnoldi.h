@@ -0,0 +1,62 @@
+#ifndef CHITECH_PI_KEIGEN_ARNOLDI_H
+#define CHITECH_PI_KEIGEN_ARNOLDI_H
+
+#include "pi_keigen.h"
+
+#include <complex>
+
+namespace lbs
+{
+
+/**k-eigenvalue solver computing the `num_modes` largest k-eigenvalues and
+ * their modes with a thick-restarted Arnoldi method on the operator
+ * \f$ A = (L - S)^{-1} F \f$, of which the k-eigenvalues are the
+ * eigenvalues. An application of A is an across-groupset solve with the
+ * fission source of the vector, as in a power iteration.
+ *
+ * At each restart the invariant subspace of the projected matrix spanned
+ * by the Ritz vectors of the largest Ritz values is kept, which amounts to
+ * a Krylov-Schur restart. Since the Krylov subspace is built from all the
+ * applications of A, the modes converge together and in far fewer
+ * applications than deflated power iterations of each mode. The Arnoldi
+ * basis holds `subspace_size + 1` flux moments vectors.*/
+class XXArnoldiKEigen : public XXPowerIterationKEigen
+{
+protected:
+  typedef std::complex<double> Cplx;
+  typedef std::vector<Cplx> VecCplx;
+
+  size_t num_modes_;
+  size_t subspace_size_;
+  size_t max_restarts_;
+  double mode_tolerance_;
+  const std::string mode_file_base_;
+
+  /**The k-eigenvalues found, in decreasing magnitude, and the flux moments
+   * of their modes. The modes of complex eigenvalues are empty.*/
+  std::vector<Cplx> k_eigenvalues_;
+  std::vector<VecDbl> modes_;
+
+public:
+  static chi::InputParameters GetInputParameters();
+
+  explicit XXArnoldiKEigen(const chi::InputParameters& params);
+
+  void Execute() override;
+
+  const std::vector<Cplx>& KEigenvalues() const { return k_eigenvalues_; }
+  const std::vector<VecDbl>& Modes() const { return modes_; }
+
+protected:
+  void ApplyOperator(const VecDbl& v, VecDbl& w);
+
+  /**Computes the eigenvalues of the real square matrix, in decreasing
+   * magnitude, and eigenvectors of unit 2-norm.*/
+  static void DenseEigenPairs(const MatDbl& H,
+                              VecCplx& values,
+                              std::vector<VecCplx>& vectors);
+};
+
+} // namespace lbs
+
+#endif // CHITECH_PI_KEIGEN_ARNOLDI_H
@@ -0,0 +1,68 @@
+#include "pi_keigen_arnoldi.h"
+
+#include "ChiObjectFactory.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+
+namespace lbs
+{
+
+RegisterChiObject(lbs, XXArnoldiKEigen);
+
+chi::InputParameters XXArnoldiKEigen::GetInputParameters()
+{
+  chi::InputParameters params = XXPowerIterationKEigen::GetInputParameters();
+
+  params.SetGeneralDescription(
+    "k-Eigenvalue solver computing the fundamental and higher modes with a "
+    "thick-restarted Arnoldi method on the transport fission operator.");
+  params.SetDocGroup("LBSExecutors");
+
+  params.ChangeExistingParamToOptional("name", "XXArnoldiKEigen");
+
+  params.AddOptionalParameter(
+    "num_modes", 4, "Number of k-eigenvalues and modes to compute.");
+  params.AddOptionalParameter(
+    "subspace_size",
+    0,
+    "Maximum dimension of the Arnoldi subspace, i.e., the number of fission "
+    "operator applications between restarts plus the number of kept "
+    "vectors. Must be at least num_modes + 2. The default, 0, uses "
+    "2 num_modes + 10.");
+  params.AddOptionalParameter(
+    "max_restarts", 50, "Maximum number of Arnoldi restarts.");
+  params.AddOptionalParameter(
+    "mode_tol",
+    1.0e-6,
+    "Tolerance on the relative residual of the modes. It should not be "
+    "tighter than the within-groupset tolerances.");
+  params.AddOptionalParameter(
+    "mode_file_base",
+    "",
+    "If not empty, the flux moments of mode i are written with "
+    "WriteFluxMoments to the file base <mode_file_base>_mode<i>.");
+
+  using namespace chi_data_types;
+  params.ConstrainParameterRange("num_modes", AllowableRangeLowLimit::New(1));
+  params.ConstrainParameterRange("mode_tol",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+
+  return params;
+}
+
+XXArnoldiKEigen::XXArnoldiKEigen(const chi::InputParameters& params)
+  : XXPowerIterationKEigen(params),
+    num_modes_(params.GetParamValue<size_t>("num_modes")),
+    subspace_size_(params.GetParamValue<size_t>("subspace_size")),
+    max_restarts_(params.GetParamValue<size_t>("max_restarts")),
+    mode_tolerance_(params.GetParamValue<double>("mode_tol")),
+    mode_file_base_(params.GetParamValue<std::string>("mode_file_base"))
+{
+  if (subspace_size_ == 0) subspace_size_ = 2 * num_modes_ + 10;
+
+  ChiInvalidArgumentIf(subspace_size_ < num_modes_ + 2,
+                       "subspace_size must be at least num_modes + 2.");
+}
+
+} // namespace lbs
@@ -0,0 +1,320 @@
+#include "pi_keigen_arnoldi.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "math/chi_math_mpi.h"
+#include "math/RandomNumberGeneration/counter_based_rng.h"
+#include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
+
+#include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Applies the fission operator, w = (L - S)^{-1} F v, with an
+ * across-groupset solve. The solve starts from v.*/
+void XXArnoldiKEigen::ApplyOperator(const VecDbl& v, VecDbl& w)
+{
+  phi_old_local_ = v;
+  SetLBSFissionSource(v, /*additive=*/false);
+
+  primary_ags_solver_->Setup();
+  primary_ags_solver_->Solve();
+
+  w = phi_new_local_;
+}
+
+// ##################################################################
+/**Executes the solver.
+ *
+ * With the Arnoldi basis V of m vectors, A V = V H + v g^T, where H is the
+ * m x m projected matrix and g, the coupling to the next basis vector v, has
+ * a single nonzero entry after Arnoldi steps. The residual of the Ritz pair
+ * (theta, V y) is |g^T y|. At a restart, the Ritz vectors y_i of the kept
+ * Ritz values, the real and imaginary parts for complex pairs, are
+ * orthonormalized to Q, such that H Q = Q T with T = Q^T H Q, and the new
+ * basis [V Q, v] satisfies the same relation with the projected matrix T
+ * and the coupling g^T Q.*/
+void XXArnoldiKEigen::Execute()
+{
+  using namespace chi_math;
+
+  const size_t m = subspace_size_;
+  const size_t num_local_dofs = phi_old_local_.size();
+
+  auto GlobalDots = [](std::vector<double>& dots)
+  {
+    std::vector<double> global_dots(dots.size(), 0.0);
+    MPI_Allreduce(dots.data(),        //sendbuf
+                  global_dots.data(), //recvbuf
+                  static_cast<int>(dots.size()), MPI_DOUBLE,
+                  MPI_SUM,            //operation
+                  Chi::mpi.comm);     //communicator
+    dots = std::move(global_dots);
+  };
+
+  //================================================== Initial vector
+  // The initial flux is perturbed such that the initial vector has a
+  // component along every mode, e.g., when the initial flux is the flat
+  // fundamental mode of a homogeneous problem.
+  std::vector<VecDbl> V;
+  V.reserve(m + 1);
+  V.push_back(phi_old_local_);
+  {
+    chi_math::CounterBasedRNG rng(/*seed=*/0, Chi::mpi.location_id);
+    VecDbl perturbation(num_local_dofs);
+    rng.Fill(perturbation);
+    for (size_t k = 0; k < num_local_dofs; ++k)
+      V[0][k] *= 0.75 + 0.5 * perturbation[k];
+  }
+  Scale(V[0], 1.0 / Vec2NormMPI(V[0], Chi::mpi.comm));
+
+  MatDbl G(m + 1, VecDbl(m, 0.0));
+  size_t num_kept = 0;
+  size_t basis_size = m;
+
+  VecCplx theta;
+  std::vector<VecCplx> Y;
+  std::vector<double> residuals;
+  size_t num_converged = 0;
+
+  //================================================== Restart loop
+  size_t restart = 0;
+  for (; restart <= max_restarts_; ++restart)
+  {
+    //================================= Arnoldi expansion
+    for (size_t j = num_kept; j < m; ++j)
+    {
+      VecDbl w;
+      ApplyOperator(V[j], w);
+
+      // Classical Gram-Schmidt with one reorthogonalization
+      for (int pass = 0; pass < 2; ++pass)
+      {
+        std::vector<double> h(j + 1, 0.0);
+        for (size_t i = 0; i <= j; ++i)
+          h[i] = Dot(V[i], w);
+        GlobalDots(h);
+
+        for (size_t i = 0; i <= j; ++i)
+        {
+          G[i][j] += h[i];
+          const auto& v_i = V[i];
+          for (size_t k = 0; k < num_local_dofs; ++k)
+            w[k] -= h[i] * v_i[k];
+        }
+      }
+
+      const double beta = Vec2NormMPI(w, Chi::mpi.comm);
+      G[j + 1][j] = beta;
+
+      // Invariant subspace
+      if (beta <= 1.0e-14 * std::fabs(G[j][j]))
+      {
+        basis_size = j + 1;
+        break;
+      }
+
+      Scale(w, 1.0 / beta);
+      V.push_back(std::move(w));
+    } // for j
+
+    //================================= Ritz pairs
+    MatDbl H(basis_size, VecDbl(basis_size, 0.0));
+    for (size_t i = 0; i < basis_size; ++i)
+      for (size_t j = 0; j < basis_size; ++j)
+        H[i][j] = G[i][j];
+
+    DenseEigenPairs(H, theta, Y);
+
+    const size_t num_wanted = std::min(num_modes_, basis_size);
+    residuals.assign(num_wanted, 0.0);
+    num_converged = 0;
+    for (size_t i = 0; i < num_wanted; ++i)
+    {
+      Cplx g_y = 0.0;
+      if (basis_size == m)
+        for (size_t c = 0; c < m; ++c)
+          g_y += G[m][c] * Y[i][c];
+      residuals[i] = std::abs(g_y) / std::max(std::abs(theta[i]), 1.0e-300);
+      if (residuals[i] < mode_tolerance_ and num_converged == i)
+        ++num_converged;
+    }
+
+    //================================= Print restart summary
+    const double max_residual =
+      *std::max_element(residuals.begin(), residuals.end());
+    if (lbs_solver_.Options().verbose_outer_iterations)
+    {
+      std::stringstream iter_info;
+      iter_info << Chi::program_timer.GetTimeString() << " "
+                << "  Restart " << std::setw(4) << restart << "  k_eff "
+                << std::setw(11) << std::setprecision(7) << theta[0].real()
+                << "  converged modes " << std::setw(3) << num_converged
+                << "  max residual " << std::setw(12) << max_residual;
+      Chi::log.Log() << iter_info.str();
+    }
+
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "arnoldi")
+                       .Add("iteration", restart)
+                       .Add("k_eff", theta[0].real())
+                       .Add("converged_modes", num_converged)
+                       .Add("max_residual", max_residual)
+                       .Add("sweeps",
+                            front_wgs_context_->counter_applications_of_inv_op_)
+                       .Add("converged", num_converged == num_wanted));
+
+    if (num_converged == num_wanted or basis_size < m or
+        restart == max_restarts_)
+      break;
+
+    //================================= Kept subspace
+    // The largest Ritz values, without splitting complex pairs
+    const size_t max_kept = std::min(m - 1, num_modes_ + (m - num_modes_) / 2);
+    std::vector<VecDbl> Q;
+    for (size_t i = 0; i < basis_size and Q.size() < max_kept; ++i)
+    {
+      const bool is_complex =
+        std::fabs(theta[i].imag()) > 1.0e-12 * std::abs(theta[i]);
+      if (is_complex and Q.size() + 2 > max_kept) break;
+
+      std::vector<VecDbl> columns(1, VecDbl(basis_size));
+      for (size_t r = 0; r < basis_size; ++r)
+        columns[0][r] = Y[i][r].real();
+      if (is_complex)
+      {
+        columns.emplace_back(basis_size);
+        for (size_t r = 0; r < basis_size; ++r)
+          columns[1][r] = Y[i][r].imag();
+        ++i; // skips the conjugate
+      }
+
+      // Modified Gram-Schmidt, dropping dependent columns
+      for (auto& q : columns)
+      {
+        for (const auto& q_prev : Q)
+        {
+          const double proj = Dot(q_prev, q);
+          for (size_t r = 0; r < basis_size; ++r)
+            q[r] -= proj * q_prev[r];
+        }
+        const double q_norm = Vec2Norm(q);
+        if (q_norm < 1.0e-10) continue;
+        Scale(q, 1.0 / q_norm);
+        Q.push_back(std::move(q));
+      }
+    }
+    num_kept = Q.size();
+
+    //================================= Restart the basis
+    MatDbl G_new(m + 1, VecDbl(m, 0.0));
+    for (size_t a = 0; a < num_kept; ++a)
+    {
+      for (size_t b = 0; b < num_kept; ++b)
+      {
+        double T_ab = 0.0;
+        for (size_t r = 0; r < m; ++r)
+          for (size_t c = 0; c < m; ++c)
+            T_ab += Q[a][r] * H[r][c] * Q[b][c];
+        G_new[a][b] = T_ab;
+      }
+      double b_a = 0.0;
+      for (size_t c = 0; c < m; ++c)
+        b_a += G[m][c] * Q[a][c];
+      G_new[num_kept][a] = b_a;
+    }
+    G = std::move(G_new);
+
+    std::vector<VecDbl> V_new(num_kept, VecDbl(num_local_dofs, 0.0));
+    for (size_t a = 0; a < num_kept; ++a)
+      for (size_t r = 0; r < m; ++r)
+      {
+        const double q_ra = Q[a][r];
+        const auto& v_r = V[r];
+        auto& v_new = V_new[a];
+        for (size_t k = 0; k < num_local_dofs; ++k)
+          v_new[k] += q_ra * v_r[k];
+      }
+    V_new.push_back(std::move(V[m]));
+    V = std::move(V_new);
+  } // for restart
+
+  //================================================== Modes
+  const size_t num_found = std::min(num_modes_, basis_size);
+  k_eigenvalues_.assign(theta.begin(), theta.begin() + num_found);
+  modes_.assign(num_found, VecDbl());
+  for (size_t i = 0; i < num_found; ++i)
+  {
+    if (std::fabs(theta[i].imag()) > 1.0e-12 * std::abs(theta[i])) continue;
+
+    auto& mode = modes_[i];
+    mode.assign(num_local_dofs, 0.0);
+    for (size_t r = 0; r < basis_size; ++r)
+    {
+      const double y_r = Y[i][r].real();
+      const auto& v_r = V[r];
+      for (size_t k = 0; k < num_local_dofs; ++k)
+        mode[k] += y_r * v_r[k];
+    }
+
+    // The fundamental mode has unit production, the others unit norm
+    if (i == 0)
+      Scale(mode, 1.0 / lbs_solver_.ComputeFissionProduction(mode));
+    else
+      Scale(mode, 1.0 / Vec2NormMPI(mode, Chi::mpi.comm));
+
+    if (not mode_file_base_.empty())
+      lbs_solver_.WriteFluxMoments(
+        mode_file_base_ + "_mode" + std::to_string(i), mode);
+  }
+
+  k_eff_ = k_eigenvalues_.front().real();
+  if (not modes_.front().empty())
+  {
+    phi_old_local_ = modes_.front();
+    phi_new_local_ = modes_.front();
+  }
+
+  //================================================== Print summary
+  Chi::log.Log() << "\n";
+  for (size_t i = 0; i < num_found; ++i)
+  {
+    std::stringstream mode_info;
+    mode_info << "        Mode " << std::setw(3) << i << " k-eigenvalue :  "
+              << std::setprecision(7) << k_eigenvalues_[i].real();
+    if (k_eigenvalues_[i].imag() != 0.0)
+      mode_info << (k_eigenvalues_[i].imag() > 0.0 ? " + " : " - ")
+                << std::fabs(k_eigenvalues_[i].imag()) << "i";
+    mode_info << "  residual " << std::setprecision(6) << residuals[i];
+    Chi::log.Log() << mode_info.str();
+  }
+  Chi::log.Log() << "        Converged modes       :        "
+                 << num_converged << " of " << num_found << " (restarts: "
+                 << restart << ", num_TrOps:"
+                 << front_wgs_context_->counter_applications_of_inv_op_
+                 << ")\n";
+
+  if (lbs_solver_.Options().use_precursors)
+  {
+    lbs_solver_.ComputePrecursors();
+    chi_math::Scale(lbs_solver_.PrecursorsNewLocal(), 1.0 / k_eff_);
+  }
+
+  lbs_solver_.UpdateFieldFunctions();
+
+  Chi::log.Log() << "LinearBoltzmann::ArnoldiKEigenSolver execution "
+                    "completed\n\n";
+}
+
+} // namespace lbs
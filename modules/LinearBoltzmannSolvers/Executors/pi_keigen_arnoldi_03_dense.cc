@@ -0,0 +1,278 @@
+#include "pi_keigen_arnoldi.h"
+
+#include "chi_log_exceptions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace lbs
+{
+
+namespace
+{
+typedef std::complex<double> Cplx;
+typedef std::vector<std::vector<Cplx>> MatCplx;
+
+/**Returns the eigenvalues of the square matrix, by reduction to upper
+ * Hessenberg form with Householder reflections followed by QR iterations
+ * with Wilkinson shifts and deflation.*/
+std::vector<Cplx> EigenValues(MatCplx A)
+{
+  const size_t n = A.size();
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  //============================================= Hessenberg reduction
+  for (size_t k = 0; k + 2 < n; ++k)
+  {
+    std::vector<Cplx> v(n, 0.0);
+    double x_norm = 0.0;
+    for (size_t r = k + 1; r < n; ++r)
+    {
+      v[r] = A[r][k];
+      x_norm += std::norm(v[r]);
+    }
+    x_norm = std::sqrt(x_norm);
+    if (x_norm == 0.0) continue;
+
+    const Cplx phase =
+      std::abs(v[k + 1]) > 0.0 ? v[k + 1] / std::abs(v[k + 1]) : 1.0;
+    v[k + 1] += phase * x_norm;
+
+    double v_norm = 0.0;
+    for (size_t r = k + 1; r < n; ++r)
+      v_norm += std::norm(v[r]);
+    v_norm = std::sqrt(v_norm);
+    for (size_t r = k + 1; r < n; ++r)
+      v[r] /= v_norm;
+
+    // A = (I - 2 v v^H) A (I - 2 v v^H)
+    for (size_t c = 0; c < n; ++c)
+    {
+      Cplx vA = 0.0;
+      for (size_t s = k + 1; s < n; ++s)
+        vA += std::conj(v[s]) * A[s][c];
+      for (size_t r = k + 1; r < n; ++r)
+        A[r][c] -= 2.0 * v[r] * vA;
+    }
+    for (size_t r = 0; r < n; ++r)
+    {
+      Cplx Av = 0.0;
+      for (size_t s = k + 1; s < n; ++s)
+        Av += A[r][s] * v[s];
+      for (size_t c = k + 1; c < n; ++c)
+        A[r][c] -= 2.0 * Av * std::conj(v[c]);
+    }
+    for (size_t r = k + 2; r < n; ++r)
+      A[r][k] = 0.0;
+  }
+
+  //============================================= Shifted QR iterations
+  size_t hi = n - 1;
+  size_t num_its = 0;
+  while (hi > 0)
+  {
+    size_t lo = hi;
+    while (lo > 0 and std::abs(A[lo][lo - 1]) >
+                        eps * (std::abs(A[lo][lo]) +
+                               std::abs(A[lo - 1][lo - 1])))
+      --lo;
+    if (lo > 0) A[lo][lo - 1] = 0.0;
+
+    if (lo == hi)
+    {
+      --hi;
+      num_its = 0;
+      continue;
+    }
+
+    ChiLogicalErrorIf(++num_its > 100 * n,
+                      "QR iterations of the projected matrix did not "
+                      "converge.");
+
+    //====================================== Wilkinson shift
+    const Cplx a = A[hi - 1][hi - 1];
+    const Cplx b = A[hi - 1][hi];
+    const Cplx c = A[hi][hi - 1];
+    const Cplx d = A[hi][hi];
+    const Cplx half_tr = 0.5 * (a + d);
+    const Cplx disc = std::sqrt(half_tr * half_tr - (a * d - b * c));
+    Cplx mu = std::abs(half_tr + disc - d) < std::abs(half_tr - disc - d)
+                ? half_tr + disc
+                : half_tr - disc;
+    if (num_its % 10 == 0) mu += std::abs(c); // exceptional shift
+
+    //====================================== QR step on the active block
+    std::vector<std::pair<Cplx, Cplx>> rotations;
+    for (size_t i = lo; i <= hi; ++i)
+      A[i][i] -= mu;
+    for (size_t i = lo; i < hi; ++i)
+    {
+      const Cplx x = A[i][i];
+      const Cplx y = A[i + 1][i];
+      const double r = std::sqrt(std::norm(x) + std::norm(y));
+      const Cplx cs = r > 0.0 ? x / r : 1.0;
+      const Cplx sn = r > 0.0 ? y / r : 0.0;
+      for (size_t col = i; col <= hi; ++col)
+      {
+        const Cplx t_i = A[i][col];
+        const Cplx t_ip1 = A[i + 1][col];
+        A[i][col] = std::conj(cs) * t_i + std::conj(sn) * t_ip1;
+        A[i + 1][col] = -sn * t_i + cs * t_ip1;
+      }
+      rotations.emplace_back(cs, sn);
+    }
+    for (size_t i = lo; i < hi; ++i)
+    {
+      const auto& [cs, sn] = rotations[i - lo];
+      for (size_t row = lo; row <= std::min(i + 1, hi); ++row)
+      {
+        const Cplx t_i = A[row][i];
+        const Cplx t_ip1 = A[row][i + 1];
+        A[row][i] = t_i * cs + t_ip1 * sn;
+        A[row][i + 1] = -t_i * std::conj(sn) + t_ip1 * std::conj(cs);
+      }
+    }
+    for (size_t i = lo; i <= hi; ++i)
+      A[i][i] += mu;
+  }
+
+  std::vector<Cplx> values(n);
+  for (size_t i = 0; i < n; ++i)
+    values[i] = A[i][i];
+  return values;
+}
+
+/**Solves A x = b in place with Gaussian elimination and partial pivoting.
+ * Vanishing pivots are replaced by a small value, as suits inverse
+ * iterations.*/
+void SolveInPlace(MatCplx A, std::vector<Cplx>& b, double tiny)
+{
+  const size_t n = A.size();
+  for (size_t k = 0; k < n; ++k)
+  {
+    size_t p = k;
+    for (size_t r = k + 1; r < n; ++r)
+      if (std::abs(A[r][k]) > std::abs(A[p][k])) p = r;
+    std::swap(A[k], A[p]);
+    std::swap(b[k], b[p]);
+
+    if (std::abs(A[k][k]) < tiny) A[k][k] = tiny;
+
+    for (size_t r = k + 1; r < n; ++r)
+    {
+      const Cplx factor = A[r][k] / A[k][k];
+      if (factor == 0.0) continue;
+      for (size_t c = k; c < n; ++c)
+        A[r][c] -= factor * A[k][c];
+      b[r] -= factor * b[k];
+    }
+  }
+  for (size_t kk = n; kk > 0; --kk)
+  {
+    const size_t k = kk - 1;
+    Cplx sum = b[k];
+    for (size_t c = k + 1; c < n; ++c)
+      sum -= A[k][c] * b[c];
+    b[k] = sum / A[k][k];
+  }
+}
+
+/**Removes from x its components along the given orthonormal vectors.*/
+void Orthogonalize(std::vector<Cplx>& x,
+                   const std::vector<const std::vector<Cplx>*>& basis)
+{
+  for (const auto* u : basis)
+  {
+    Cplx proj = 0.0;
+    for (size_t i = 0; i < x.size(); ++i)
+      proj += std::conj((*u)[i]) * x[i];
+    for (size_t i = 0; i < x.size(); ++i)
+      x[i] -= proj * (*u)[i];
+  }
+}
+
+double Normalize(std::vector<Cplx>& x)
+{
+  double norm = 0.0;
+  for (const auto& xi : x)
+    norm += std::norm(xi);
+  norm = std::sqrt(norm);
+  if (norm > 0.0)
+    for (auto& xi : x)
+      xi /= norm;
+  return norm;
+}
+} // namespace
+
+// ##################################################################
+/**The eigenvectors are obtained by inverse iterations with the computed
+ * eigenvalues. The start vectors of eigenvalues equal, within a small
+ * tolerance, to earlier ones are kept orthogonal to the earlier
+ * eigenvectors, such that the vectors of a degenerate eigenvalue are
+ * independent.*/
+void XXArnoldiKEigen::DenseEigenPairs(const MatDbl& H,
+                                      VecCplx& values,
+                                      std::vector<VecCplx>& vectors)
+{
+  const size_t n = H.size();
+
+  double H_norm = 0.0;
+  MatCplx A(n, std::vector<Cplx>(n, 0.0));
+  for (size_t i = 0; i < n; ++i)
+    for (size_t j = 0; j < n; ++j)
+    {
+      A[i][j] = H[i][j];
+      H_norm = std::max(H_norm, std::fabs(H[i][j]));
+    }
+  if (H_norm == 0.0) H_norm = 1.0;
+
+  //============================================= Eigenvalues
+  const auto unsorted_values = EigenValues(A);
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&unsorted_values](size_t a, size_t b)
+                   {
+                     return std::abs(unsorted_values[a]) >
+                            std::abs(unsorted_values[b]);
+                   });
+
+  values.resize(n);
+  for (size_t i = 0; i < n; ++i)
+    values[i] = unsorted_values[order[i]];
+
+  //============================================= Eigenvectors
+  const double eps = std::numeric_limits<double>::epsilon();
+  const double degeneracy_tol = 1.0e-8 * H_norm;
+
+  vectors.assign(n, VecCplx(n, 0.0));
+  for (size_t i = 0; i < n; ++i)
+  {
+    std::vector<const VecCplx*> degenerate_vectors;
+    for (size_t j = 0; j < i; ++j)
+      if (std::abs(values[j] - values[i]) < degeneracy_tol)
+        degenerate_vectors.push_back(&vectors[j]);
+
+    MatCplx M = A;
+    const Cplx shift = values[i] + Cplx(eps * H_norm, 0.0);
+    for (size_t r = 0; r < n; ++r)
+      M[r][r] -= shift;
+
+    auto& x = vectors[i];
+    for (size_t r = 0; r < n; ++r)
+      x[r] = 1.0 + 0.1 * static_cast<double>(r % 7);
+    Orthogonalize(x, degenerate_vectors);
+    Normalize(x);
+
+    for (int it = 0; it < 3; ++it)
+    {
+      SolveInPlace(M, x, eps * H_norm);
+      Orthogonalize(x, degenerate_vectors);
+      Normalize(x);
+    }
+  }
+}
+
+} // namespace lbs
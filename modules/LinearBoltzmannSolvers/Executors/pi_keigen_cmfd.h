@@ -0,0 +1,43 @@
+#ifndef CHITECH_PI_KEIGEN_CMFD_H
+#define CHITECH_PI_KEIGEN_CMFD_H
+
+#include "pi_keigen.h"
+
+namespace lbs::acceleration
+{
+class CMFDAccelerator;
+}
+
+namespace lbs
+{
+
+/**Power iteration k-eigenvalue solver accelerated with coarse mesh finite
+ * difference (CMFD). After each transport solve, the reaction rates and
+ * currents of the iterate are tallied on a Cartesian coarse mesh, the
+ * corrected coarse diffusion eigenvalue problem is solved, and the fine
+ * flux moments and eigenvalue are updated from the coarse solution.
+ *
+ * Requires the angular fluxes to be stored (`save_angular_flux`).*/
+class XXPowerIterationKEigenCMFD : public XXPowerIterationKEigen
+{
+protected:
+  std::shared_ptr<acceleration::CMFDAccelerator> cmfd_;
+
+  const std::vector<size_t> coarse_mesh_dims_;
+  const int cmfd_max_iters_;
+  const double cmfd_k_tol_;
+  const int cmfd_inner_sweeps_;
+  const bool cmfd_verbose_;
+
+public:
+  static chi::InputParameters GetInputParameters();
+
+  explicit XXPowerIterationKEigenCMFD(const chi::InputParameters& params);
+
+  void Initialize() override;
+  void Execute() override;
+};
+
+} // namespace lbs
+
+#endif // CHITECH_PI_KEIGEN_CMFD_H
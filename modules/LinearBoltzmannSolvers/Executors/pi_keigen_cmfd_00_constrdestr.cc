@@ -0,0 +1,90 @@
+#include "pi_keigen_cmfd.h"
+
+#include "A_LBSSolver/Acceleration/cmfd.h"
+
+#include "ChiObjectFactory.h"
+
+#include "chi_runtime.h"
+#include "chi_log_exceptions.h"
+
+namespace lbs
+{
+
+RegisterChiObject(lbs, XXPowerIterationKEigenCMFD);
+
+chi::InputParameters XXPowerIterationKEigenCMFD::GetInputParameters()
+{
+  chi::InputParameters params = XXPowerIterationKEigen::GetInputParameters();
+
+  params.SetGeneralDescription(
+    "Generalized implementation of a k-Eigenvalue solver using Power "
+    "Iteration with coarse mesh finite difference (CMFD) acceleration.");
+  params.SetDocGroup("LBSExecutors");
+
+  params.ChangeExistingParamToOptional("name", "XXPowerIterationKEigenCMFD");
+
+  params.AddOptionalParameterArray(
+    "coarse_mesh_dims",
+    std::vector<size_t>{1, 1, 1},
+    "Number of coarse mesh bins in x, y and z. The bins partition the "
+    "bounding box of the mesh and fine cells are assigned by centroid.");
+
+  params.AddOptionalParameter(
+    "cmfd_max_iters", 500, "Maximum coarse power iterations per outer.");
+
+  params.AddOptionalParameter(
+    "cmfd_k_tol", 1.0e-8, "Tolerance on the coarse k-eigenvalue change.");
+
+  params.AddOptionalParameter(
+    "cmfd_inner_sweeps",
+    5,
+    "Gauss-Seidel sweeps over the coarse cells per group and coarse power "
+    "iteration.");
+
+  params.AddOptionalParameter(
+    "cmfd_verbose", false, "Flag to print coarse solve information.");
+
+  using namespace chi_data_types;
+  params.ConstrainParameterRange("cmfd_max_iters",
+                                 AllowableRangeLowLimit::New(1));
+  params.ConstrainParameterRange("cmfd_k_tol",
+                                 AllowableRangeLowLimit::New(1.0e-18));
+  params.ConstrainParameterRange("cmfd_inner_sweeps",
+                                 AllowableRangeLowLimit::New(1));
+
+  return params;
+}
+
+XXPowerIterationKEigenCMFD::XXPowerIterationKEigenCMFD(
+  const chi::InputParameters& params)
+  : XXPowerIterationKEigen(params),
+    coarse_mesh_dims_(params.GetParamVectorValue<size_t>("coarse_mesh_dims")),
+    cmfd_max_iters_(params.GetParamValue<int>("cmfd_max_iters")),
+    cmfd_k_tol_(params.GetParamValue<double>("cmfd_k_tol")),
+    cmfd_inner_sweeps_(params.GetParamValue<int>("cmfd_inner_sweeps")),
+    cmfd_verbose_(params.GetParamValue<bool>("cmfd_verbose"))
+{
+  ChiInvalidArgumentIf(coarse_mesh_dims_.size() != 3,
+                       "Parameter \"coarse_mesh_dims\" must have 3 entries.");
+}
+
+// ##################################################################
+/**Initializes the base solver and builds the coarse mesh.*/
+void XXPowerIterationKEigenCMFD::Initialize()
+{
+  XXPowerIterationKEigen::Initialize();
+
+  acceleration::CMFDAccelerator::Options options;
+  for (int d = 0; d < 3; ++d)
+    options.dims[d] = coarse_mesh_dims_[d];
+  options.max_iters = cmfd_max_iters_;
+  options.k_tol = cmfd_k_tol_;
+  options.inner_sweeps = cmfd_inner_sweeps_;
+  options.verbose = cmfd_verbose_;
+
+  cmfd_ = std::make_shared<acceleration::CMFDAccelerator>(
+    TextName() + "_CMFD", lbs_solver_, options);
+  cmfd_->Initialize();
+}
+
+} // namespace lbs
@@ -0,0 +1,144 @@
+#include "pi_keigen_cmfd.h"
+
+#include "A_LBSSolver/Acceleration/cmfd.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
+
+#include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
+
+#include <iomanip>
+
+namespace lbs
+{
+
+// ##################################################################
+/**Executes the solver.
+ *
+ * Each outer iteration performs one transport solve with the fission source
+ * of the previous iterate, tallies the result on the coarse mesh and solves
+ * the coarse eigenvalue problem. On success, the coarse eigenvalue becomes
+ * the new estimate and the flux moments are scaled to the coarse solution.
+ * Otherwise the outer reverts to a plain power iteration.*/
+void XXPowerIterationKEigenCMFD::Execute()
+{
+  using namespace chi_math;
+
+  double F_prev = 1.0;
+  k_eff_ = initial_k_eff_;
+  double k_eff_prev = k_eff_;
+  double k_eff_change = 1.0;
+  VecDbl prev_fission_source;
+  double inner_tol = inexact_initial_tol_;
+
+  //================================================== Start power iterations
+  int nit = 0;
+  bool converged = false;
+  while (nit < max_iters_)
+  {
+    //================================= Set the fission source
+    SetLBSFissionSource(phi_old_local_, /*additive=*/false);
+    Scale(q_moments_local_, 1.0 / k_eff_);
+
+    //================================= Relax the inner tolerance
+    bool inners_at_tolerance = true;
+    double fission_source_change = 0.0;
+    if (inexact_inners_)
+    {
+      fission_source_change = FissionSourceChange(prev_fission_source);
+      inners_at_tolerance = SetWGSRelaxedTolerance(inner_tol);
+    }
+
+    //================================= This solves the inners for transport
+    primary_ags_solver_->Setup();
+    primary_ags_solver_->Solve();
+
+    //================================= Recompute k-eigenvalue
+    double F_new = lbs_solver_.ComputeFissionProduction(phi_new_local_);
+    k_eff_ = F_new / F_prev * k_eff_;
+
+    //================================= Coarse mesh update. After the solve
+    //                                  phi_old equals phi_new
+    cmfd_->Tally(phi_new_local_);
+    double k_cmfd = k_eff_;
+    const bool cmfd_applied = cmfd_->SolveEigenvalue(k_cmfd);
+    if (cmfd_applied)
+    {
+      cmfd_->Prolongate(phi_old_local_);
+      k_eff_ = k_cmfd;
+    }
+    double reactivity = (k_eff_ - 1.0) / k_eff_;
+
+    //================================= Check convergence, bookkeeping
+    k_eff_change = fabs(k_eff_ - k_eff_prev) / k_eff_;
+    k_eff_prev = k_eff_;
+    F_prev = lbs_solver_.ComputeFissionProduction(phi_old_local_);
+    nit += 1;
+
+    if (k_eff_change < std::max(k_tolerance_, 1.0e-12))
+    {
+      if (inners_at_tolerance) converged = true;
+      else inner_tol = 0.0;
+    }
+    else if (inexact_inners_)
+      inner_tol =
+        InexactInnerTolerance(std::max(k_eff_change, fission_source_change));
+
+    //================================= Print iteration summary
+    if (lbs_solver_.Options().verbose_outer_iterations)
+    {
+      std::stringstream k_iter_info;
+      k_iter_info << Chi::program_timer.GetTimeString() << " "
+                  << "  Iteration " << std::setw(5) << nit << "  k_eff "
+                  << std::setw(11) << std::setprecision(7) << k_eff_
+                  << "  k_eff change " << std::setw(12) << k_eff_change
+                  << "  reactivity " << std::setw(10) << reactivity * 1e5;
+      if (not cmfd_applied) k_iter_info << "  (no CMFD)";
+      if (converged) k_iter_info << " CONVERGED\n";
+
+      Chi::log.Log() << k_iter_info.str();
+    }
+
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "power_iteration_cmfd")
+                       .Add("iteration", nit)
+                       .Add("k_eff", k_eff_)
+                       .Add("k_eff_change", k_eff_change)
+                       .Add("reactivity", reactivity)
+                       .Add("sweeps",
+                            front_wgs_context_->counter_applications_of_inv_op_)
+                       .Add("converged", converged));
+
+    if (converged) break;
+  } // for k iterations
+
+  if (inexact_inners_) SetWGSRelaxedTolerance(0.0);
+
+  //================================================== Print summary
+  Chi::log.Log() << "\n";
+  Chi::log.Log() << "        Final k-eigenvalue    :        "
+                 << std::setprecision(7) << k_eff_;
+  Chi::log.Log() << "        Final change          :        "
+                 << std::setprecision(6) << k_eff_change << " (num_TrOps:"
+                 << front_wgs_context_->counter_applications_of_inv_op_ << ")"
+                 << "\n";
+  Chi::log.Log() << "\n";
+
+  if (lbs_solver_.Options().use_precursors)
+  {
+    lbs_solver_.ComputePrecursors();
+    chi_math::Scale(lbs_solver_.PrecursorsNewLocal(), 1.0 / k_eff_);
+  }
+
+  lbs_solver_.UpdateFieldFunctions();
+
+  Chi::log.Log()
+    << "LinearBoltzmann::KEigenvalueSolver execution completed\n\n";
+}
+
+} // namespace lbs
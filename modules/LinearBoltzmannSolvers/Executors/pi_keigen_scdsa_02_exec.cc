@@ -3,10 +3,12 @@
 #include "chi_runtime.h"
 #include "chi_log.h"
 #include "utils/chi_timer.h"
+#include "utils/chi_telemetry.h"
 
 #include "A_LBSSolver/IterativeMethods/ags_linear_solver.h"
 #include "A_LBSSolver/Acceleration/diffusion_mip.h"
 #include "A_LBSSolver/Acceleration/diffusion_PWLC.h"
+#include "B_DiscreteOrdinatesSolver/IterativeMethods/sweep_wgs_context.h"
 
 #include <iomanip>
 
@@ -30,15 +32,15 @@ void XXPowerIterationKEigenSCDSA::Execute()
     SetLBSScatterSource(/*in*/ phi_temp, additive, suppress_wg_scat);
   };
 
-  const size_t tag_SCDSA_solve_time =
-    Chi::log.GetRepeatingEventTag("SCDSA_solve_time");
-  const size_t tag_sweep_timing = Chi::log.GetRepeatingEventTag("Sweep Timing");
+  chi::RunningStatistics scdsa_solve_timing;
 
   using namespace chi_math;
 
-  k_eff_ = 1.0;
-  double k_eff_prev = 1.0;
+  k_eff_ = initial_k_eff_;
+  double k_eff_prev = k_eff_;
   double k_eff_change = 1.0;
+  VecDbl prev_fission_source;
+  double inner_tol = inexact_initial_tol_;
 
   //================================================== Start power iterations
   int nit = 0;
@@ -49,6 +51,15 @@ void XXPowerIterationKEigenSCDSA::Execute()
     SetLBSFissionSource(phi_old_local_, /*additive=*/false);
     Scale(q_moments_local_, 1.0 / k_eff_);
 
+    //================================= Relax the inner tolerance
+    bool inners_at_tolerance = true;
+    double fission_source_change = 0.0;
+    if (inexact_inners_)
+    {
+      fission_source_change = FissionSourceChange(prev_fission_source);
+      inners_at_tolerance = SetWGSRelaxedTolerance(inner_tol);
+    }
+
     auto Sf_ell = q_moments_local_;
     auto Sf0_ell = CopyOnlyPhi0(front_gs_, q_moments_local_);
 
@@ -103,12 +114,10 @@ void XXPowerIterationKEigenSCDSA::Execute()
         auto Ss = CopyOnlyPhi0(front_gs_, q_moments_local_);
 
         // Solve the diffusion system
-        Chi::log.LogEvent(tag_SCDSA_solve_time,
-                          chi::ChiLog::EventType::EVENT_BEGIN);
+        const double solve_start_time = MPI_Wtime();
         diffusion_solver_->Assemble_b(Ss + Sfaux + Ss_res - Sf0_ell);
         diffusion_solver_->Solve(epsilon_kp1, /*use_initial_guess=*/true);
-        Chi::log.LogEvent(tag_SCDSA_solve_time,
-                          chi::ChiLog::EventType::EVENT_END);
+        scdsa_solve_timing.Add(MPI_Wtime() - solve_start_time);
 
         epsilon_k = epsilon_kp1;
       }
@@ -154,7 +163,14 @@ void XXPowerIterationKEigenSCDSA::Execute()
     k_eff_prev = k_eff_;
     nit += 1;
 
-    if (k_eff_change < std::max(k_tolerance_, 1.0e-12)) converged = true;
+    if (k_eff_change < std::max(k_tolerance_, 1.0e-12))
+    {
+      if (inners_at_tolerance) converged = true;
+      else inner_tol = 0.0;
+    }
+    else if (inexact_inners_)
+      inner_tol =
+        InexactInnerTolerance(std::max(k_eff_change, fission_source_change));
 
     //================================= Print iteration summary
     if (lbs_solver_.Options().verbose_outer_iterations)
@@ -170,10 +186,32 @@ void XXPowerIterationKEigenSCDSA::Execute()
       Chi::log.Log() << k_iter_info.str();
     }
 
+    auto& telemetry = chi::Telemetry::GetInstance();
+    if (telemetry.Enabled())
+      telemetry.Emit("power_iteration",
+                     chi::Telemetry::Record()
+                       .Add("method", "power_iteration_scdsa")
+                       .Add("iteration", nit)
+                       .Add("k_eff", k_eff_)
+                       .Add("k_eff_change", k_eff_change)
+                       .Add("reactivity", reactivity)
+                       .Add("sweeps",
+                            front_wgs_context_->counter_applications_of_inv_op_)
+                       .Add("converged", converged));
+
     if (converged) break;
   } // for k iterations
 
+  if (inexact_inners_) SetWGSRelaxedTolerance(0.0);
+
   //================================================== Print summary
+  typedef SweepWGSContext<Mat, Vec, KSP> SweepContext;
+  const auto sweep_context =
+    std::dynamic_pointer_cast<SweepContext>(front_wgs_context_);
+  const double total_sweep_time =
+    sweep_context ? sweep_context->sweep_scheduler_.GetSweepTiming().total
+                  : 0.0;
+
   Chi::log.Log() << "\n";
   Chi::log.Log() << "        Final k-eigenvalue    :        "
                  << std::setprecision(7) << k_eff_;
@@ -184,13 +222,8 @@ void XXPowerIterationKEigenSCDSA::Execute()
     << ")"
     << "\n"
     << "        Diffusion solve time  :        "
-    << Chi::log.ProcessEvent(tag_SCDSA_solve_time,
-                             chi::ChiLog::EventOperation::TOTAL_DURATION) *
-         1.0e-6
-    << "s\n"
-    << "        Total sweep time      :        "
-    << Chi::log.ProcessEvent(tag_sweep_timing,
-                             chi::ChiLog::EventOperation::TOTAL_DURATION);
+    << scdsa_solve_timing.total << "s\n"
+    << "        Total sweep time      :        " << total_sweep_time << "s";
   Chi::log.Log() << "\n";
 
   if (lbs_solver_.Options().use_precursors)
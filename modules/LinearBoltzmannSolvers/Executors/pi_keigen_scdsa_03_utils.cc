@@ -23,6 +23,7 @@ XXPowerIterationKEigenSCDSA::CopyOnlyPhi0(const LBSGroupset& groupset,
   const auto& diff_sdm = diffusion_solver_->SpatialDiscretization();
   const auto& diff_uk_man = diffusion_solver_->UnknownStructure();
   const auto& phi_uk_man = lbs_solver_.UnknownManager();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -31,10 +32,12 @@ XXPowerIterationKEigenSCDSA::CopyOnlyPhi0(const LBSGroupset& groupset,
     requires_ghosts_ ? diff_sdm.GetNumLocalAndGhostDOFs(diff_uk_man)
                      : diff_sdm.GetNumLocalDOFs(diff_uk_man);
 
+  // The nodal average is in the group interleaved layout
   std::vector<double> phi_data;
   if (continuous_sdm_ptr_)
     phi_data = NodallyAveragedPWLDVector(
-      phi_in, lbs_sdm, diff_sdm, phi_uk_man, lbs_pwld_ghost_info_);
+      lbs_solver_.InterleavedFluxMoments(phi_in),
+      lbs_sdm, diff_sdm, phi_uk_man, lbs_pwld_ghost_info_);
   else
     phi_data = phi_in;
 
@@ -48,7 +51,9 @@ XXPowerIterationKEigenSCDSA::CopyOnlyPhi0(const LBSGroupset& groupset,
     for (size_t i = 0; i < num_nodes; i++)
     {
       cint64 diff_phi_map = diff_sdm.MapDOFLocal(cell, i, diff_uk_man, 0, 0);
-      cint64 lbs_phi_map = lbs_sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      cint64 lbs_phi_map =
+        continuous_sdm_ptr_ ? lbs_sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi)
+                            : transport_views[cell.local_id_].MapDOF(i, 0, gsi);
 
       double* output_mapped = &output_phi_local[diff_phi_map];
       const double* phi_in_mapped = &phi_data[lbs_phi_map];
@@ -75,7 +80,7 @@ void XXPowerIterationKEigenSCDSA::ProjectBackPhi0(
   const auto& lbs_sdm = lbs_solver_.SpatialDiscretization();
   const auto& diff_sdm = diffusion_solver_->SpatialDiscretization();
   const auto& diff_uk_man = diffusion_solver_->UnknownStructure();
-  const auto& phi_uk_man = lbs_solver_.UnknownManager();
+  const auto& transport_views = lbs_solver_.GetCellTransportViews();
 
   const int gsi = groupset.groups_.front().id_;
   const size_t gss = groupset.groups_.size();
@@ -95,7 +100,7 @@ void XXPowerIterationKEigenSCDSA::ProjectBackPhi0(
     for (size_t i = 0; i < num_nodes; i++)
     {
       cint64 diff_phi_map = diff_sdm.MapDOFLocal(cell, i, diff_uk_man, 0, 0);
-      cint64 lbs_phi_map = lbs_sdm.MapDOFLocal(cell, i, phi_uk_man, 0, gsi);
+      cint64 lbs_phi_map = transport_views[cell.local_id_].MapDOF(i, 0, gsi);
 
       const double* input_mapped = &input[diff_phi_map];
       double* output_mapped = &output[lbs_phi_map];
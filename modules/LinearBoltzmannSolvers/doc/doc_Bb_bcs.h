@@ -70,4 +70,64 @@ end
 An example of a very intricate use of this functionality can be seen in the
 test \ref tests_Transport_Steady_Transport2D_5PolyA_AniHeteroBndry_lua
 
+## Batched evaluation
+With `function_batched = true` the lua function is called once for all the
+face nodes of the boundary, instead of once per node. The cell global ids,
+material ids, locations and normals are then tables with an entry per face
+node, followed by the same quadrature, group and time arguments, and the
+function must return the psi of all the nodes, node after node, e.g., for
+two angles and two groups, i0n0g0, i0n0g1, i0n1g0, i0n1g1, i1n0g0, etc.
+\code
+function luaBatchedBoundaryFunction(cell_global_ids,
+                                    material_ids,
+                                    locations,
+                                    normals,
+                                    quadrature_angle_indices,
+                                    quadrature_angle_vectors,
+                                    quadrature_phi_theta_angles,
+                                    group_indices,
+                                    time)
+    num_angles = rawlen(quadrature_angle_vectors)
+    num_groups = rawlen(group_indices)
+    psi = {}
+    dof_count = 0
+
+    for i=1,rawlen(locations) do
+        x = locations[i].x
+        for ni=1,num_angles do
+            for gi=1,num_groups do
+                dof_count = dof_count + 1
+                psi[dof_count] = x
+            end
+        end
+    end
+
+    return psi
+end
+
+chiLBSSetOptions(phys1,
+{
+  boundary_conditions =
+  {
+    { name = "zmax", type = "incident_anisotropic_heterogeneous",
+      function_name = "luaBatchedBoundaryFunction", function_batched = true},
+  }
+})
+\endcode
+
+## C++ boundary functions
+A C++ boundary function registered with lbs::RegisterBoundaryFunction, e.g.,
+a chi_mesh::sweep_management::BoundaryFunctor wrapping a lambda with the
+signature of chi_mesh::sweep_management::BoundaryFunction::EvaluateBatch, is
+used instead of a lua function when its name is the `function_name`.
+
+## Caching
+The function is evaluated when the boundary is set up for the quadrature of
+a groupset. Setting up again for the same grid, directions and evaluation
+time, e.g., for another groupset with the same quadrature, re-uses the
+fluxes, and so does re-initializing the solver with the same function.
+chiLBSUpdateSourcesAndBoundaries always evaluates the function again. With a
+time table, see chiLBSSetSourceTimeTable, the function is only evaluated at
+setup and the fluxes are scaled as time advances.
+
 \ingroup LBSUtilities */
\ No newline at end of file
@@ -59,6 +59,10 @@ public:
   uint num_groups_ = 0;
   uint last_fast_group_ = 0;
   bool do_two_grid_ = false;
+  bool do_thermal_block_solve_ = false;
+  /**Backend of the group matrices and vectors.*/
+  chi_math::PETScUtils::DeviceBackend device_backend_ =
+    chi_math::PETScUtils::DeviceBackend::CPU;
 
   size_t num_local_dofs_ = 0;
   size_t num_globl_dofs_ = 0;
@@ -74,8 +78,27 @@ public:
   chi_math::PETScUtils::PETScSolverSetup petsc_solver_;
   KSPAppContext my_app_context_;
 
+  // coupled system of the thermal groups, the group matrices on the
+  // diagonal and the upscattering blocks off it
+  Mat A_thermal_ = nullptr;
+  Mat P_thermal_ = nullptr;            // AIJ copy for coupled AMG
+  std::vector<Mat> S_thermal_;         // off-diagonal blocks, row-major
+  std::vector<IS> thermal_iss_;        // rows of each thermal group
+  Vec b_thermal_ = nullptr;
+  Vec x_thermal_ = nullptr;            // nest of the thermal x_ unless AMG
+  KSP thermal_ksp_ = nullptr;
+  KSP two_grid_ksp_ = nullptr;         // two-grid solve of the preconditioner
+  Vec b_two_grid_ = nullptr;
+
   std::vector< std::vector<double> > VF_;
 
+  // per local cell, the row-major mass matrix and the global and local dof
+  // maps, computed once, and a buffer for a rhs contribution
+  std::vector<std::vector<double>>   cell_mass_matrices_;
+  std::vector<std::vector<PetscInt>> cell_dof_maps_;
+  std::vector<std::vector<int64_t>>  cell_local_dof_maps_;
+  std::vector<std::vector<double>>   cell_rhs_;
+
 //  typedef std::pair<BoundaryType,std::vector<double>> BoundaryInfo;
   typedef std::pair<BoundaryType,std::array<std::vector<double>, 3>>
                                                   BoundaryInfo;
@@ -93,14 +116,26 @@ public:
   void Set_BCs(const std::vector<uint64_t>& globl_unique_bndry_ids);
   void Assemble_A_bext();
   void Compute_TwoGrid_Params();
+  /**Returns the collapsed data of the cross sections, and the fundamental
+   * eigenvalue of the iteration matrix in rho.*/
+  TwoGridCollapsedInfo
+  Compute_TwoGrid_Info(const chi_physics::MultiGroupXS& xs,
+                       double& rho) const;
   void Compute_TwoGrid_VolumeFractions();
+  void Compute_Cell_Mass_Matrices();
+  void Assemble_Thermal_Blocks();
 
   void Execute() override;
 
-  void Assemble_RHS(unsigned int g, int64_t iverbose);
+  void Assemble_RHS(unsigned int g, int64_t iverbose,
+                    bool fast_inscatter_only = false);
   void Assemble_RHS_TwoGrid(int64_t iverbose);
   void SolveOneGroupProblem(unsigned int g, int64_t iverbose);
   void Update_Flux_With_TwoGrid(int64_t iverbose);
+  void Add_TwoGrid_Correction(Vec x_two_grid, Vec* x_thermal);
+  void SolveThermalIterations(int64_t iverbose);
+  void SolveThermalBlockProblem(int64_t iverbose);
+  void ApplyTwoGridPreconditioner(Vec r, Vec z);
 
   //04
   void UpdateFieldFunctions();
@@ -18,7 +18,12 @@ mg_diffusion::Solver::Solver(const std::string& in_solver_name):
                                         {"verbose_level"     , int64_t (0) },
                                         {"thermal_flux_tolerance", 1.0e-2},
                                         {"max_thermal_iters" , int64_t(500)},
-                                        {"do_two_grid"       , false}
+                                        {"do_two_grid"       , false},
+                                        {"thermal_block_solve", false},
+                                        {"thermal_block_pc"  ,
+                                         std::string("fieldsplit")},
+                                        {"device_backend"    ,
+                                         std::string("cpu")}
   })
 {}
 
@@ -45,6 +50,18 @@ mg_diffusion::Solver::~Solver()
     VecDestroy(&x_[num_groups_]);
     MatDestroy(&A_[num_groups_]);
   }
+
+  if (do_thermal_block_solve_)
+  {
+    KSPDestroy(&thermal_ksp_);
+    KSPDestroy(&two_grid_ksp_);
+    VecDestroy(&b_two_grid_);
+    VecDestroy(&x_thermal_);
+    VecDestroy(&b_thermal_);
+    for (auto& S : S_thermal_) if (S) MatDestroy(&S);
+    MatDestroy(&P_thermal_);
+    MatDestroy(&A_thermal_);
+  }
 }
 
 //============================================= Initialize
@@ -127,11 +144,12 @@ void mg_diffusion::Solver::Initialize()
     // x[g] = chi_math::PETScUtils::CreateVector(n,N);
     x_[g] = chi_math::PETScUtils::CreateVectorWithGhosts(n, N,
                                                          static_cast<int64_t>(ghost_dof_indices.size()),
-                                                         ghost_dof_indices);
+                                                         ghost_dof_indices,
+                                                         device_backend_);
     VecSet(x_[g], 0.0);
-    bext_[g] = chi_math::PETScUtils::CreateVector(n, N);
+    bext_[g] = chi_math::PETScUtils::CreateVector(n, N, device_backend_);
 
-    A_[g] = chi_math::PETScUtils::CreateSquareMatrix(n, N);
+    A_[g] = chi_math::PETScUtils::CreateSquareMatrix(n, N, device_backend_);
     chi_math::PETScUtils::InitMatrixSparsity(A_[g],
                                              nodal_nnz_in_diag,
                                              nodal_nnz_off_diag);
@@ -152,7 +170,8 @@ void mg_diffusion::Solver::Initialize()
   // add two-grid mat and vec, if needed
   if (do_two_grid_)
   {
-    A_[num_groups_] = chi_math::PETScUtils::CreateSquareMatrix(n, N);
+    A_[num_groups_] =
+      chi_math::PETScUtils::CreateSquareMatrix(n, N, device_backend_);
     chi_math::PETScUtils::InitMatrixSparsity(A_[num_groups_],
                                              nodal_nnz_in_diag,
                                              nodal_nnz_off_diag);
@@ -165,9 +184,15 @@ void mg_diffusion::Solver::Initialize()
   if (do_two_grid_)
     mg_diffusion::Solver::Compute_TwoGrid_VolumeFractions();
 
+  mg_diffusion::Solver::Compute_Cell_Mass_Matrices();
+
   //============================================= Create Mats and ExtVecs
   mg_diffusion::Solver::Assemble_A_bext();
 
+  //============================================= Coupled thermal system
+  if (do_thermal_block_solve_)
+    mg_diffusion::Solver::Assemble_Thermal_Blocks();
+
   //============================================= Volume fraction for two-grid
   //                                              update
 
@@ -155,4 +155,20 @@ void mg_diffusion::Solver::Initialize_Materials(std::set<int>& material_ids)
     Compute_TwoGrid_Params();
   }
 
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Coupled thermal solve
+  do_thermal_block_solve_ = basic_options_("thermal_block_solve").BoolValue()
+                            and lfg < num_groups_;
+
+  const auto thermal_block_pc =
+    basic_options_("thermal_block_pc").StringValue();
+  if (do_thermal_block_solve_ and thermal_block_pc != "fieldsplit" and
+      thermal_block_pc != "gamg")
+    throw std::invalid_argument(
+      "mg_diffusion::Solver: Invalid thermal_block_pc \"" + thermal_block_pc +
+      "\". Allowed values are \"fieldsplit\" and \"gamg\".");
+
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Matrix backend
+  device_backend_ = chi_math::PETScUtils::DeviceBackendFromName(
+    basic_options_("device_backend").StringValue());
+
 }
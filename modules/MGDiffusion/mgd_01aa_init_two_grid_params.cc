@@ -1,85 +1,131 @@
 #include "mg_diffusion_solver.h"
 #include "chi_runtime.h"
 #include "chi_log.h"
+#include "chi_mpi_utils.h"
 #include "physics/PhysicsMaterial/chi_physicsmaterial.h"
 
+#include <algorithm>
+#include <tuple>
+
+/**Computes the two-grid collapsed data of every material.
+ *
+ * The data are cached per cross section hash, number of groups and last
+ * fast group, hence materials sharing their cross sections, or solvers
+ * reinitialized with unchanged cross sections, are not recomputed. The
+ * uncached materials are distributed round-robin over the processes and the
+ * results shared with an allgather.*/
 void mg_diffusion::Solver::Compute_TwoGrid_Params()
 {
-  // loop over all materials
-  for (const auto &mat_id_xs: matid_to_xs_map) {
+  typedef std::tuple<uint64_t, uint, uint> CacheKey;
+  static std::map<CacheKey, TwoGridCollapsedInfo> cache;
 
-    // get the P0 transfer matrix and total XS
-    const auto &isotropic_transfer_matrix = mat_id_xs.second->TransferMatrix(0);
-    const auto &sigma_t = mat_id_xs.second->SigmaTotal();
-    const auto &diffusion_coeff = mat_id_xs.second->DiffusionCoefficient();
+  // find the cross sections not in the cache
+  std::map<int, CacheKey> matid_to_key;
+  std::vector<CacheKey> uncached_keys;
+  std::vector<const chi_physics::MultiGroupXS*> uncached_xs;
+  for (const auto &[mat_id, xs]: matid_to_xs_map)
+  {
+    const CacheKey key{xs->ComputeHash(), num_groups_, last_fast_group_};
+    matid_to_key[mat_id] = key;
 
-    // put P0 transfer matrix in nicer form
-    MatDbl S(num_groups_, VecDbl(num_groups_, 0.0));
-    for (unsigned int g = 0; g < num_groups_; ++g)
-      for (const auto &[row_g, gprime, sigma]: isotropic_transfer_matrix.Row(g))
-        S[g][gprime] = sigma;
+    if (cache.count(key) > 0 or
+        std::find(uncached_keys.begin(), uncached_keys.end(), key) !=
+          uncached_keys.end())
+      continue;
 
-    // (L+D) e_new = -U e_old
-    // original matrix = diag(total) - scattering
-    // so L+D = diag(removal) - tril(scattering)
-    // and U = -triu(scattering)
-    MatDbl A(num_groups_, VecDbl(num_groups_, 0.0));
-    MatDbl B(num_groups_, VecDbl(num_groups_, 0.0));
-    for (unsigned int g = 0; g < num_groups_; ++g)
-    {
-      A[g][g] = sigma_t[g] - S[g][g];
-      for (unsigned int gp = 0; gp < g; ++gp)
-        A[g][gp] = -S[g][gp];
-      for (unsigned int gp = g + 1; gp < num_groups_; ++gp)
-        B[g][gp] = S[g][gp];
-    }
-    MatDbl Ainv = chi_math::Inverse(A);
-    // finally, obtain the iteration matrix
-    MatDbl C_ = chi_math::MatMul(Ainv, B);
-    // Perform power iteration
-    VecDbl E(num_groups_, 1.0);
-    double rho = chi_math::PowerIteration(C_, E, 10000, 1.0e-12);
+    uncached_keys.push_back(key);
+    uncached_xs.push_back(xs.get());
+  }
 
-    // Compute two-grid diffusion quantities
-    // normalize spectrum
-    std::vector<double> spectrum(num_groups_, 1.0);
-    double sum = 0.0;
-    for (unsigned int g = 0; g < num_groups_; ++g)
-      sum += std::fabs(E[g]);
-    for (unsigned int g = 0; g < num_groups_; ++g)
-      spectrum[g] = std::fabs(E[g]) / sum;
-    // D ave and Sigma_a ave
-    double collapsed_D = 0.0;
-    double collapsed_sig_a = 0.0;
-    for (unsigned int g = last_fast_group_; g < num_groups_; ++g)
+  // compute them over all processes,
+  // packed as [D, sig_a, rho, spectrum...]
+  const auto packed_infos = chi_mpi_utils::DistributeAndAllGather(
+    uncached_keys.size(),
+    [this, &uncached_xs](size_t k)
     {
-      collapsed_D += diffusion_coeff[g] * spectrum[g];
-      collapsed_sig_a += sigma_t[g] * spectrum[g];
-      for (unsigned int gp = last_fast_group_; gp < num_groups_; ++gp)
-        collapsed_sig_a -= S[g][gp] * spectrum[gp];
-    }
+      double rho = 0.0;
+      const auto tginfo = Compute_TwoGrid_Info(*uncached_xs[k], rho);
+      std::vector<double> packed = {
+        tginfo.collapsed_D, tginfo.collapsed_sig_a, rho};
+      packed.insert(
+        packed.end(), tginfo.spectrum.begin(), tginfo.spectrum.end());
+      return packed;
+    });
+
+  for (size_t k = 0; k < uncached_keys.size(); ++k)
+  {
+    const auto &packed = packed_infos[k];
+    TwoGridCollapsedInfo tginfo{
+      packed[0], packed[1], {packed.begin() + 3, packed.end()}};
+
     // Verbose output the spectrum
-    Chi::log.Log0Verbose1() << "Fundamental eigen-value: " << rho;
+    Chi::log.Log0Verbose1() << "Fundamental eigen-value: " << packed[2];
     std::stringstream outstr;
-    for (auto &xi: spectrum)
+    for (auto &xi: tginfo.spectrum)
       outstr << xi << '\n';
     Chi::log.Log0Verbose1() << outstr.str();  // jcr verbose1
 
-//    std::stringstream outstr2;
-//    for (auto &xi: diffusion_coeff)
-//      outstr2 << xi << '\n';
-//    chi::log.Log0Verbose0() << outstr2.str();  // jcr verbose1
-//
-//    std::cout << "collapsed = " << collapsed_sig_a
-//    <<", "<< collapsed_D << std::endl;
-//    chi::Exit(12345);
+    cache[uncached_keys[k]] = std::move(tginfo);
+  }
+
+  for (const auto &[mat_id, key]: matid_to_key)
+    map_mat_id_2_tginfo.insert(std::make_pair(mat_id, cache.at(key)));
+}
+
+/**Computes the two-grid collapsed data of a material's cross sections.*/
+mg_diffusion::TwoGridCollapsedInfo
+mg_diffusion::Solver::Compute_TwoGrid_Info(
+  const chi_physics::MultiGroupXS& xs, double& rho) const
+{
+  // get the P0 transfer matrix and total XS
+  const auto &isotropic_transfer_matrix = xs.TransferMatrix(0);
+  const auto &sigma_t = xs.SigmaTotal();
+  const auto &diffusion_coeff = xs.DiffusionCoefficient();
 
-    const auto mat_id = mat_id_xs.first;
-    map_mat_id_2_tginfo.insert(
-      std::make_pair(mat_id, TwoGridCollapsedInfo{collapsed_D,
-                                                  collapsed_sig_a,
-                                                  spectrum} ) );
+  // put P0 transfer matrix in nicer form
+  MatDbl S(num_groups_, VecDbl(num_groups_, 0.0));
+  for (unsigned int g = 0; g < num_groups_; ++g)
+    for (const auto &[row_g, gprime, sigma]: isotropic_transfer_matrix.Row(g))
+      S[g][gprime] = sigma;
 
-  }// end loop over materials
+  // (L+D) e_new = -U e_old
+  // original matrix = diag(total) - scattering
+  // so L+D = diag(removal) - tril(scattering)
+  // and U = -triu(scattering)
+  MatDbl A(num_groups_, VecDbl(num_groups_, 0.0));
+  MatDbl B(num_groups_, VecDbl(num_groups_, 0.0));
+  for (unsigned int g = 0; g < num_groups_; ++g)
+  {
+    A[g][g] = sigma_t[g] - S[g][g];
+    for (unsigned int gp = 0; gp < g; ++gp)
+      A[g][gp] = -S[g][gp];
+    for (unsigned int gp = g + 1; gp < num_groups_; ++gp)
+      B[g][gp] = S[g][gp];
+  }
+  MatDbl Ainv = chi_math::Inverse(A);
+  // finally, obtain the iteration matrix
+  MatDbl C_ = chi_math::MatMul(Ainv, B);
+  // Perform power iteration
+  VecDbl E(num_groups_, 1.0);
+  rho = chi_math::PowerIteration(C_, E, 10000, 1.0e-12);
 
+  // Compute two-grid diffusion quantities
+  // normalize spectrum
+  std::vector<double> spectrum(num_groups_, 1.0);
+  double sum = 0.0;
+  for (unsigned int g = 0; g < num_groups_; ++g)
+    sum += std::fabs(E[g]);
+  for (unsigned int g = 0; g < num_groups_; ++g)
+    spectrum[g] = std::fabs(E[g]) / sum;
+  // D ave and Sigma_a ave
+  double collapsed_D = 0.0;
+  double collapsed_sig_a = 0.0;
+  for (unsigned int g = last_fast_group_; g < num_groups_; ++g)
+  {
+    collapsed_D += diffusion_coeff[g] * spectrum[g];
+    collapsed_sig_a += sigma_t[g] * spectrum[g];
+    for (unsigned int gp = last_fast_group_; gp < num_groups_; ++gp)
+      collapsed_sig_a -= S[g][gp] * spectrum[gp];
+  }
+  return {collapsed_D, collapsed_sig_a, spectrum};
 }
@@ -144,19 +144,25 @@ void mg_diffusion::Solver::Assemble_A_bext()
     }//for face f
  
     //======================= Develop node mapping
-    std::vector<int64_t> imap(num_nodes, 0); //node-mapping
+    std::vector<PetscInt> imap(num_nodes, 0); //node-mapping
     for (size_t i=0; i<num_nodes; ++i)
-      imap[i] = sdm.MapDOF(cell, i);
+      imap[i] = static_cast<PetscInt>(sdm.MapDOF(cell, i));
 
     //======================= Assembly into system
+    // one blocked insertion per group, with the row-major element matrix
+    const auto n = static_cast<PetscInt>(num_nodes);
     for (uint g=0; g < num_groups_; ++g)
-      for (size_t i=0; i<num_nodes; ++i)
-        VecSetValue(bext_[g], imap[i], rhs_cell[g][i], ADD_VALUES);
+      VecSetValues(bext_[g], n, imap.data(), rhs_cell[g].data(), ADD_VALUES);
 
+    VecDbl Acell_flat(num_nodes * num_nodes);
     for (uint g=0; g < num_groups_ + i_two_grid; ++g)
+    {
       for (size_t i=0; i<num_nodes; ++i)
         for (size_t j=0; j<num_nodes; ++j)
-          MatSetValue(A_[g], imap[i], imap[j], Acell[g][i][j], ADD_VALUES);
+          Acell_flat[i * num_nodes + j] = Acell[g][i][j];
+      MatSetValues(A_[g], n, imap.data(), n, imap.data(),
+                   Acell_flat.data(), ADD_VALUES);
+    }
 
   }//for cell
 
@@ -0,0 +1,125 @@
+#include "mg_diffusion_solver.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+//============================================= assemble thermal blocks
+/**Assembles the coupled system of the thermal groups, a nest matrix with
+ * the group matrices A[g] on the diagonal and, off it, minus the mass
+ * matrices weighted by the scattering between thermal groups. Blocks
+ * without scattering, on any location, are left empty. For AMG on the
+ * whole system an AIJ copy is made, with vectors of its layout, while
+ * otherwise the solution is the nest of the thermal group fluxes.*/
+void mg_diffusion::Solver::Assemble_Thermal_Blocks()
+{
+  const auto& grid = *grid_ptr_;
+  const auto& sdm  = *sdm_ptr_;
+
+  const unsigned int lfg = last_fast_group_;
+  const unsigned int num_thermal = num_groups_ - lfg;
+
+  //============================================= Determine coupled blocks
+  std::vector<int> local_coupled(num_thermal * num_thermal, 0);
+  for (const auto& [mat_id, xs] : matid_to_xs_map)
+    for (unsigned int g = lfg; g < num_groups_; ++g)
+      for (const auto& [row_g, gp, sigma] : xs->TransferMatrix(0).Row(g))
+        if (gp >= lfg and gp != g and std::fabs(sigma) > 0.0)
+          local_coupled[(g - lfg) * num_thermal + (gp - lfg)] = 1;
+
+  std::vector<int> coupled(local_coupled.size(), 0);
+  MPI_Allreduce(local_coupled.data(),
+                coupled.data(),
+                static_cast<int>(coupled.size()),
+                MPI_INT,
+                MPI_MAX,
+                Chi::mpi.comm);
+
+  //============================================= Create blocks
+  const auto& OneDofPerNode = sdm.UNITARY_UNKNOWN_MANAGER;
+  const auto n = static_cast<int64_t>(num_local_dofs_);
+  const auto N = static_cast<int64_t>(num_globl_dofs_);
+
+  std::vector<int64_t> nodal_nnz_in_diag;
+  std::vector<int64_t> nodal_nnz_off_diag;
+  sdm.BuildSparsityPattern(nodal_nnz_in_diag,nodal_nnz_off_diag, OneDofPerNode);
+
+  S_thermal_.assign(num_thermal * num_thermal, nullptr);
+  for (size_t k = 0; k < S_thermal_.size(); ++k)
+  {
+    if (not coupled[k]) continue;
+    S_thermal_[k] =
+      chi_math::PETScUtils::CreateSquareMatrix(n, N, device_backend_);
+    chi_math::PETScUtils::InitMatrixSparsity(S_thermal_[k],
+                                             nodal_nnz_in_diag,
+                                             nodal_nnz_off_diag);
+  }
+
+  //============================================= Assemble upscattering blocks
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto& S = matid_to_xs_map.at(cell.material_id_)->TransferMatrix(0);
+
+    const auto& Mcell_flat = cell_mass_matrices_[cell.local_id_];
+    const auto& imap = cell_dof_maps_[cell.local_id_];
+    const size_t num_nodes = imap.size();
+
+    const auto nn = static_cast<PetscInt>(num_nodes);
+    VecDbl Scell_flat(num_nodes * num_nodes);
+    for (unsigned int g = lfg; g < num_groups_; ++g)
+      for (const auto& [row_g, gp, sigma] : S.Row(g))
+      {
+        if (gp < lfg or gp == g) continue;
+        auto& S_block = S_thermal_[(g - lfg) * num_thermal + (gp - lfg)];
+        if (not S_block) continue;
+
+        for (size_t k = 0; k < Scell_flat.size(); ++k)
+          Scell_flat[k] = -sigma * Mcell_flat[k];
+        MatSetValues(S_block, nn, imap.data(), nn, imap.data(),
+                     Scell_flat.data(), ADD_VALUES);
+      }
+  }//for cell
+
+  for (auto& S_block : S_thermal_)
+    if (S_block)
+    {
+      MatAssemblyBegin(S_block, MAT_FINAL_ASSEMBLY);
+      MatAssemblyEnd(S_block, MAT_FINAL_ASSEMBLY);
+    }
+
+  //============================================= Nest matrix and vectors
+  std::vector<Mat> blocks(S_thermal_);
+  for (unsigned int k = 0; k < num_thermal; ++k)
+    blocks[k * num_thermal + k] = A_[lfg + k];
+
+  const auto nt = static_cast<PetscInt>(num_thermal);
+  MatCreateNest(PETSC_COMM_WORLD, nt, nullptr, nt, nullptr,
+                blocks.data(), &A_thermal_);
+
+  thermal_iss_.assign(num_thermal, nullptr);
+  MatNestGetISs(A_thermal_, thermal_iss_.data(), nullptr);
+
+  if (basic_options_("thermal_block_pc").StringValue() == "gamg")
+  {
+    MatConvert(A_thermal_, MATAIJ, MAT_INITIAL_MATRIX, &P_thermal_);
+    MatCreateVecs(P_thermal_, &x_thermal_, &b_thermal_);
+  }
+  else
+  {
+    std::vector<Vec> b_thermal_g(num_thermal, nullptr);
+    for (auto& b : b_thermal_g)
+      VecDuplicate(b_, &b);
+    VecCreateNest(PETSC_COMM_WORLD, nt, nullptr, b_thermal_g.data(),
+                  &b_thermal_);
+    for (auto& b : b_thermal_g)
+      VecDestroy(&b);
+    VecCreateNest(PETSC_COMM_WORLD, nt, nullptr, &x_[lfg], &x_thermal_);
+  }
+
+  Chi::log.Log() << "Done assembling the coupled system of "
+                 << num_thermal << " thermal groups";
+}
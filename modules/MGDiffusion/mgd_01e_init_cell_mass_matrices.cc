@@ -0,0 +1,50 @@
+#include "mg_diffusion_solver.h"
+
+#include "math/SpatialDiscretization/spatial_discretization.h"
+#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+//============================================= compute cell mass matrices
+/**Computes, once, the mass matrix and the dof maps of every local cell,
+ * such that rebuilding a rhs costs a matrix-vector product per cell,
+ * without quadrature.*/
+void mg_diffusion::Solver::Compute_Cell_Mass_Matrices()
+{
+  const auto& grid = *grid_ptr_;
+  const auto& sdm  = *sdm_ptr_;
+
+  const size_t num_local_cells = grid.local_cells.size();
+  cell_mass_matrices_.assign(num_local_cells, {});
+  cell_dof_maps_.assign(num_local_cells, {});
+  cell_local_dof_maps_.assign(num_local_cells, {});
+  cell_rhs_.assign(num_local_cells, {});
+
+  for (const auto& cell : grid.local_cells)
+  {
+    const auto& cell_mapping = sdm.GetCellMapping(cell);
+    const auto  qp_data      = cell_mapping.MakeVolumeQuadraturePointData();
+    const size_t num_nodes   = cell_mapping.NumNodes();
+    const uint64_t c = cell.local_id_;
+
+    auto& M = cell_mass_matrices_[c];
+    M.assign(num_nodes * num_nodes, 0.0);
+    for (size_t i=0; i<num_nodes; ++i)
+      for (size_t j=0; j<num_nodes; ++j)
+        for (size_t qp : qp_data.QuadraturePointIndices())
+          M[i * num_nodes + j] += qp_data.ShapeValue(i, qp) *
+                                  qp_data.ShapeValue(j, qp) *
+                                  qp_data.JxW(qp);
+
+    auto& dof_map = cell_dof_maps_[c];
+    auto& local_dof_map = cell_local_dof_maps_[c];
+    dof_map.resize(num_nodes);
+    local_dof_map.resize(num_nodes);
+    for (size_t i=0; i<num_nodes; ++i)
+    {
+      dof_map[i] = static_cast<PetscInt>(sdm.MapDOF(cell, i));
+      local_dof_map[i] = sdm.MapDOFLocal(cell, i);
+    }
+
+    cell_rhs_[c].assign(num_nodes, 0.0);
+  }//for cell
+}
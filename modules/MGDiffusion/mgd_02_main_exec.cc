@@ -51,6 +51,22 @@ void mg_diffusion::Solver::Execute()
   }
 
   //============================================= Solve thermal groups:
+  // coupled, or with Gauss-Seidel thermal iterations
+  if (do_thermal_block_solve_)
+    mg_diffusion::Solver::SolveThermalBlockProblem(iverbose);
+  else
+    SolveThermalIterations(iverbose);
+
+  UpdateFieldFunctions();
+  Chi::log.Log() << "Done solving multi-group diffusion";
+
+}
+
+//========================================================== Thermal iterations
+/**Solves the thermal groups with Gauss-Seidel thermal iterations, one
+ * group after the other, with, optionally, two-grid acceleration.*/
+void mg_diffusion::Solver::SolveThermalIterations(const int64_t iverbose)
+{
   unsigned int thermal_iteration = 0;
   // max # of thermal iterations
   int64_t max_thermal_iters = basic_options_("max_thermal_iters").IntegerValue();
@@ -102,8 +118,4 @@ void mg_diffusion::Solver::Execute()
     else
       std::cout << "\nThermal iterations NOT converged for fixed-source problem" << std::endl;
   }
-
-  UpdateFieldFunctions();
-  Chi::log.Log() << "Done solving multi-group diffusion";
-
-}
\ No newline at end of file
+}
@@ -1,12 +1,15 @@
 #include "mg_diffusion_solver.h"
 #include "chi_runtime.h"
 #include "chi_log.h"
-#include "math/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwlc.h"
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
 
 //========================================================== Solve 1g problem
+/**Assembles the rhs of group g, the external source and the inscattering
+ * from the other groups, or only from the fast groups, e.g., when the
+ * thermal groups are solved coupled.*/
 void mg_diffusion::Solver::Assemble_RHS(const unsigned int g,
-                                        const int64_t verbose)
+                                        const int64_t verbose,
+                                        const bool fast_inscatter_only)
 {
   if (verbose > 2)
     Chi::log.Log() << "\nAssemblying RHS for group " + std::to_string(g);
@@ -15,47 +18,73 @@ void mg_diffusion::Solver::Assemble_RHS(const unsigned int g,
   VecSet(b_, 0.0);
   VecCopy(bext_[g], b_);
 
-  const auto& sdm  = *mg_diffusion::Solver::sdm_ptr_;
-  // compute inscattering term
-  for (const auto& cell :  mg_diffusion::Solver::grid_ptr_->local_cells)
-  {
-    const auto& cell_mapping = sdm.GetCellMapping(cell);
-    const auto  qp_data      = cell_mapping.MakeVolumeQuadraturePointData();
-    const size_t num_nodes   = cell_mapping.NumNodes();
+  const auto& grid = *grid_ptr_;
+
+  //============================================= Local flux arrays
+  std::vector<const double*> xlocal(num_groups_, nullptr);
+  for (uint gp = 0; gp < num_groups_; ++gp)
+    VecGetArrayRead(x_[gp], &xlocal[gp]);
 
-    const auto& xs = matid_to_xs_map.at(cell.material_id_);
-    const auto& S = xs->TransferMatrix(0);
+  // compute inscattering term, cell by cell in parallel into the cell
+  // buffers, with the precomputed mass matrices
+  const size_t gprime_end =
+    fast_inscatter_only ? last_fast_group_ : num_groups_;
+  const auto num_local_cells = static_cast<int64_t>(grid.local_cells.size());
+  std::vector<char> cell_has_rhs(num_local_cells, 0);
 
-    for (const auto& [row_g, gprime, sigma_sm] : S.Row(g))
+#pragma omp parallel
+  {
+    std::vector<double> inscatter_flux;
+
+#pragma omp for schedule(static)
+    for (int64_t c = 0; c < num_local_cells; ++c)
     {
-      if (gprime != g) // g and row_g are the same, maybe different int types
-      {
-        const double* xlocal;
-        VecGetArrayRead(x_[gprime], &xlocal);
+      const auto& cell = grid.local_cells[c];
+      const auto& xs = matid_to_xs_map.at(cell.material_id_);
+      const auto S_g = xs->TransferMatrix(0).RowSpan(g);
+      if (S_g.size == 0) continue;
 
-        for (size_t i=0; i<num_nodes; ++i)
+      const auto& local_dof_map = cell_local_dof_maps_[c];
+      const size_t num_nodes    = local_dof_map.size();
+
+      // sum of sigma_s(gp->g) times the flux of gp at each node, i.e. the
+      // row of group g applied to the other groups
+      inscatter_flux.assign(num_nodes, 0.0);
+      for (size_t j = 0; j < num_nodes; ++j)
+      {
+        const int64_t jmap = local_dof_map[j];
+        for (size_t k = 0; k < S_g.size; ++k)
         {
-          const int64_t imap = sdm.MapDOF(cell,i);
-          double inscatter_g = 0.0;
+          const size_t gprime = S_g.column_indices[k];
+          if (gprime != g and gprime < gprime_end)
+            inscatter_flux[j] += S_g.values[k] * xlocal[gprime][jmap];
+        }
+      }//for j
+
+      const auto& M = cell_mass_matrices_[c];
+      auto& cell_rhs = cell_rhs_[c];
+      for (size_t i=0; i<num_nodes; ++i)
+      {
+        double inscatter_g = 0.0;
+        for (size_t j = 0; j < num_nodes; ++j)
+          inscatter_g += M[i * num_nodes + j] * inscatter_flux[j];
+        cell_rhs[i] = inscatter_g;
+      }//for i
+      cell_has_rhs[c] = 1;
+    }//for cell
+  }//omp parallel
 
-          for (size_t j = 0; j < num_nodes; ++j)
-          {
-            const int64_t jmap = sdm.MapDOFLocal(cell, j);
+  // add inscattering values to vector
+  for (int64_t c = 0; c < num_local_cells; ++c)
+    if (cell_has_rhs[c])
+      VecSetValues(b_,
+                   static_cast<PetscInt>(cell_rhs_[c].size()),
+                   cell_dof_maps_[c].data(),
+                   cell_rhs_[c].data(),
+                   ADD_VALUES);
 
-           // get flux at node j
-            const double flxj_gp = xlocal[jmap];
-            for (size_t qp: qp_data.QuadraturePointIndices())
-              inscatter_g += sigma_sm * flxj_gp *
-                         qp_data.ShapeValue(i, qp) * qp_data.ShapeValue(j, qp) *
-                         qp_data.JxW(qp);
-          }//for j
-          // add inscattering value to vector
-          VecSetValue(b_, imap, inscatter_g, ADD_VALUES);
-        }//for i
-        VecRestoreArrayRead(x_[gprime], &xlocal);
-      }//if gp!=g
-    }// for gprime
-  }//for cell
+  for (uint gp = 0; gp < num_groups_; ++gp)
+    VecRestoreArrayRead(x_[gp], &xlocal[gp]);
 
   VecAssemblyBegin(b_);
   VecAssemblyEnd(b_);
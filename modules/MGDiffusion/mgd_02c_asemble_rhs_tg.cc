@@ -1,8 +1,6 @@
 #include "mg_diffusion_solver.h"
 
 #include "mesh/MeshContinuum/chi_meshcontinuum.h"
-#include "math/SpatialDiscretization/spatial_discretization.h"
-#include "math/SpatialDiscretization/FiniteElement/finite_element.h"
 
 #include "chi_runtime.h"
 #include "chi_log.h"
@@ -14,49 +12,88 @@ void mg_diffusion::Solver::Assemble_RHS_TwoGrid(const int64_t verbose)
 
   VecSet(b_, 0.0);
 
-  const auto& sdm  = *sdm_ptr_;
-  // compute inscattering term
-  for (const auto& cell :  grid_ptr_->local_cells)
+  const auto& grid = *grid_ptr_;
+
+  //============================================= Local flux arrays
+  std::vector<const double*> xlocal(num_groups_, nullptr);
+  std::vector<const double*> xlocal_old(num_groups_, nullptr);
+  for (uint gp = 0; gp < num_groups_; ++gp)
   {
-    const auto &cell_mapping = sdm.GetCellMapping(cell);
-    const auto qp_data = cell_mapping.MakeVolumeQuadraturePointData();
-    const size_t num_nodes = cell_mapping.NumNodes();
+    VecGetArrayRead(x_[gp], &xlocal[gp]);
+    VecGetArrayRead(x_old_[gp], &xlocal_old[gp]);
+  }
+
+  // compute inscattering term, cell by cell in parallel into the cell
+  // buffers, with the precomputed mass matrices
+  const auto num_local_cells = static_cast<int64_t>(grid.local_cells.size());
+  std::vector<char> cell_has_rhs(num_local_cells, 0);
 
-    const auto &S = matid_to_xs_map.at(cell.material_id_)->TransferMatrix(0);
+#pragma omp parallel
+  {
+    std::vector<double> delta_flux;
 
-    for (unsigned g = last_fast_group_; g < num_groups_; ++g)
+#pragma omp for schedule(static)
+    for (int64_t c = 0; c < num_local_cells; ++c)
     {
-      for (const auto &[row_g, gprime, sigma_sm]: S.Row(g)) {
-        if (gprime > g) // the upper part for the residual of two-grid accel
+      const auto& cell = grid.local_cells[c];
+      const auto& S = matid_to_xs_map.at(cell.material_id_)->TransferMatrix(0);
+
+      const auto& local_dof_map = cell_local_dof_maps_[c];
+      const size_t num_nodes    = local_dof_map.size();
+
+      // the upper part for the residual of two-grid accel, i.e.
+      // sigma_s(gp->g) times the flux change of gp > g at each node,
+      // summed over the thermal groups
+      delta_flux.assign(num_nodes, 0.0);
+      bool has_upscattering = false;
+      for (unsigned g = last_fast_group_; g < num_groups_; ++g)
+      {
+        const auto S_g = S.RowSpan(g);
+        for (size_t j = 0; j < num_nodes; ++j)
         {
-          const double *xlocal;
-          const double *xlocal_old;
-          VecGetArrayRead(x_[gprime], &xlocal);
-          VecGetArrayRead(x_old_[gprime], &xlocal_old);
-
-          for (size_t i = 0; i < num_nodes; ++i) {
-            const int64_t imap = sdm.MapDOF(cell, i);
-            double inscatter_g = 0.0;
-
-            for (size_t j = 0; j < num_nodes; ++j) {
-              const int64_t jmap = sdm.MapDOFLocal(cell, j);
-
-              // get flux at node j
-              const double delta_flxj_gp = xlocal[jmap] - xlocal_old[jmap];
-              for (size_t qp: qp_data.QuadraturePointIndices())
-                inscatter_g += sigma_sm * delta_flxj_gp *
-                               qp_data.ShapeValue(i, qp) * qp_data.ShapeValue(j, qp) *
-                               qp_data.JxW(qp);
-            }//for j
-            // add inscattering value to vector
-            VecSetValue(b_, imap, inscatter_g, ADD_VALUES);
-          }//for i
-          VecRestoreArrayRead(x_[gprime]    , &xlocal);
-          VecRestoreArrayRead(x_old_[gprime], &xlocal_old);
-        }//if gp!=g
-      }// for gprime
-    }// for g
-  }//for cell
+          const int64_t jmap = local_dof_map[j];
+          for (size_t k = 0; k < S_g.size; ++k)
+          {
+            const size_t gprime = S_g.column_indices[k];
+            if (gprime > g)
+            {
+              delta_flux[j] += S_g.values[k] *
+                               (xlocal[gprime][jmap] -
+                                xlocal_old[gprime][jmap]);
+              has_upscattering = true;
+            }
+          }
+        }//for j
+      }// for g
+      if (not has_upscattering) continue;
+
+      const auto& M = cell_mass_matrices_[c];
+      auto& cell_rhs = cell_rhs_[c];
+      for (size_t i = 0; i < num_nodes; ++i)
+      {
+        double inscatter_g = 0.0;
+        for (size_t j = 0; j < num_nodes; ++j)
+          inscatter_g += M[i * num_nodes + j] * delta_flux[j];
+        cell_rhs[i] = inscatter_g;
+      }//for i
+      cell_has_rhs[c] = 1;
+    }//for cell
+  }//omp parallel
+
+  // add inscattering values to vector
+  for (int64_t c = 0; c < num_local_cells; ++c)
+    if (cell_has_rhs[c])
+      VecSetValues(b_,
+                   static_cast<PetscInt>(cell_rhs_[c].size()),
+                   cell_dof_maps_[c].data(),
+                   cell_rhs_[c].data(),
+                   ADD_VALUES);
+
+  for (uint gp = 0; gp < num_groups_; ++gp)
+  {
+    VecRestoreArrayRead(x_[gp], &xlocal[gp]);
+    VecRestoreArrayRead(x_old_[gp], &xlocal_old[gp]);
+  }
 
   VecAssemblyBegin(b_);
   VecAssemblyEnd(b_);
@@ -13,12 +13,21 @@ void mg_diffusion::Solver::Update_Flux_With_TwoGrid(const int64_t verbose)
 {
   if (verbose > 2) Chi::log.Log() << "\nUpdating Thermal fluxes from two-grid";
 
+  // contains two_grid flux, stored in last num_groups entry
+  Add_TwoGrid_Correction(x_[num_groups_], &x_[last_fast_group_]);
+}
+
+//============================================= add two-grid correction
+/**Adds the two-grid flux, distributed over the thermal groups by the
+ * spectrum, to the thermal vectors, one per thermal group.*/
+void mg_diffusion::Solver::Add_TwoGrid_Correction(Vec x_two_grid,
+                                                  Vec* x_thermal)
+{
   const auto& grid = *grid_ptr_;
   const auto& sdm  = *sdm_ptr_;
 
-  // contains two_grid flux, stored in last num_groups entry
   const double *xlocal_tg;
-  VecGetArrayRead(x_[num_groups_], &xlocal_tg);
+  VecGetArrayRead(x_two_grid, &xlocal_tg);
 
   int counter = 0;
   for (const auto& cell : grid.local_cells)
@@ -34,7 +43,8 @@ void mg_diffusion::Solver::Update_Flux_With_TwoGrid(const int64_t verbose)
         const int64_t imap       = sdm.MapDOFLocal(cell, i);
         const int64_t imap_globl = sdm.MapDOF(cell, i);
         const double aux = xlocal_tg[imap] * VF_[counter][i] * xstg.spectrum[g];
-        VecSetValue(x_[g], imap_globl, aux, ADD_VALUES);
+        VecSetValue(x_thermal[g - last_fast_group_], imap_globl, aux,
+                    ADD_VALUES);
       }// i
     }//g
     counter++;
@@ -43,9 +53,9 @@ void mg_diffusion::Solver::Update_Flux_With_TwoGrid(const int64_t verbose)
   // finalize
   for (unsigned int g = last_fast_group_; g < num_groups_; ++g)
   {
-    VecAssemblyBegin(x_[g]);
-    VecAssemblyEnd(x_[g]);
+    VecAssemblyBegin(x_thermal[g - last_fast_group_]);
+    VecAssemblyEnd(x_thermal[g - last_fast_group_]);
   }
   // release two-grid flux
-  VecRestoreArrayRead(x_[num_groups_], &xlocal_tg);
+  VecRestoreArrayRead(x_two_grid, &xlocal_tg);
 }
\ No newline at end of file
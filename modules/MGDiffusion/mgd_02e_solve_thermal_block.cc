@@ -0,0 +1,202 @@
+#include "mg_diffusion_solver.h"
+#include "tools/tools.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <petscpc.h>
+
+namespace
+{
+/**Shell preconditioner applying the two-grid correction.*/
+PetscErrorCode TwoGridPCApply(PC pc, Vec r, Vec z)
+{
+  void* context;
+  PCShellGetContext(pc, &context);
+  auto solver = static_cast<mg_diffusion::Solver*>(context);
+
+  solver->ApplyTwoGridPreconditioner(r, z);
+  return 0;
+}
+} // namespace
+
+//========================================================== Solve thermal
+/**Solves the thermal groups coupled, instead of the Gauss-Seidel thermal
+ * iterations, with a Krylov method on the nest matrix of the thermal
+ * groups. It is preconditioned by a multiplicative field split, i.e., a
+ * block Gauss-Seidel sweep of the groups with an AMG per group, set up
+ * once, or by AMG on the whole system, followed, with two-grid
+ * acceleration, by the two-grid correction of the residual.*/
+void mg_diffusion::Solver::SolveThermalBlockProblem(const int64_t verbose)
+{
+  const unsigned int lfg = last_fast_group_;
+  const unsigned int num_thermal = num_groups_ - lfg;
+
+  //============================================= Create Krylov Solver
+  if (not thermal_ksp_)
+  {
+    const bool use_gamg =
+      basic_options_("thermal_block_pc").StringValue() == "gamg";
+
+    KSPCreate(PETSC_COMM_WORLD, &thermal_ksp_);
+    KSPSetOptionsPrefix(thermal_ksp_, "mgd_thermal_");
+    const Mat A = use_gamg ? P_thermal_ : A_thermal_;
+    KSPSetOperators(thermal_ksp_, A, A);
+    KSPSetType(thermal_ksp_, KSPGMRES);
+    const auto max_iters = basic_options_("max_thermal_iters").IntegerValue();
+    KSPSetTolerances(thermal_ksp_,
+                     basic_options_("residual_tolerance").FloatValue(),
+                     1.0e-50,
+                     1.0e10,
+                     static_cast<PetscInt>(max_iters));
+    KSPSetInitialGuessNonzero(thermal_ksp_, PETSC_TRUE);
+
+    KSPSetApplicationContext(thermal_ksp_, (void*)&my_app_context_);
+    KSPMonitorSet(thermal_ksp_, &mg_diffusion::MGKSPMonitor,
+                  nullptr, nullptr);
+
+    PC pc;
+    KSPGetPC(thermal_ksp_, &pc);
+
+    PC block_pc = pc;
+    if (do_two_grid_)
+    {
+      PCSetType(pc, PCCOMPOSITE);
+      PCCompositeSetType(pc, PC_COMPOSITE_MULTIPLICATIVE);
+      PCCompositeAddPCType(pc, use_gamg ? PCGAMG : PCFIELDSPLIT);
+      PCCompositeAddPCType(pc, PCSHELL);
+
+      PC two_grid_pc;
+      PCCompositeGetPC(pc, 0, &block_pc);
+      PCCompositeGetPC(pc, 1, &two_grid_pc);
+      PCShellSetContext(two_grid_pc, this);
+      PCShellSetApply(two_grid_pc, TwoGridPCApply);
+      PCShellSetName(two_grid_pc, "MGDiffusionTwoGrid");
+
+      // the two-grid problem is solved with its own, once set up, solver
+      VecDuplicate(b_, &b_two_grid_);
+      auto two_grid_solver =
+        chi_math::PETScUtils::CreateCommonKrylovSolverSetup(
+          A_[num_groups_],
+          TextName() + "_two_grid",
+          KSPCG,
+          PCGAMG,
+          basic_options_("residual_tolerance").FloatValue(),
+          basic_options_("max_inner_iters").IntegerValue());
+      two_grid_ksp_ = two_grid_solver.ksp;
+      KSPSetApplicationContext(two_grid_ksp_, (void*)&my_app_context_);
+      KSPMonitorCancel(two_grid_ksp_);
+      KSPMonitorSet(two_grid_ksp_, &mg_diffusion::MGKSPMonitor,
+                    nullptr, nullptr);
+    }
+    else
+      PCSetType(pc, use_gamg ? PCGAMG : PCFIELDSPLIT);
+
+    if (not use_gamg)
+    {
+      // one split per thermal group
+      for (unsigned int k = 0; k < num_thermal; ++k)
+        PCFieldSplitSetIS(block_pc, std::to_string(lfg + k).c_str(),
+                          thermal_iss_[k]);
+      PCFieldSplitSetType(block_pc, PC_COMPOSITE_MULTIPLICATIVE);
+    }
+
+    KSPSetFromOptions(thermal_ksp_);
+    KSPSetUp(thermal_ksp_);
+
+    if (not use_gamg)
+    {
+      PetscInt num_splits;
+      KSP* sub_ksps;
+      PCFieldSplitGetSubKSP(block_pc, &num_splits, &sub_ksps);
+      for (PetscInt k = 0; k < num_splits; ++k)
+      {
+        KSPSetType(sub_ksps[k], KSPPREONLY);
+        PC sub_pc;
+        KSPGetPC(sub_ksps[k], &sub_pc);
+        PCSetType(sub_pc, PCGAMG);
+        KSPSetFromOptions(sub_ksps[k]);
+      }
+      PetscFree(sub_ksps);
+    }
+  }
+
+  // copies a group vector into or out of a coupled vector
+  auto CopyGroup = [this](Vec coupled, unsigned int k, Vec group, bool in)
+  {
+    Vec sub;
+    VecGetSubVector(coupled, thermal_iss_[k], &sub);
+    if (in) VecCopy(group, sub);
+    else
+      VecCopy(sub, group);
+    VecRestoreSubVector(coupled, thermal_iss_[k], &sub);
+  };
+  const bool x_is_nest = P_thermal_ == nullptr;
+
+  //============================================= Assemble rhs
+  // the inscattering from the fast groups, already solved
+  for (unsigned int k = 0; k < num_thermal; ++k)
+  {
+    Assemble_RHS(lfg + k, verbose, /*fast_inscatter_only=*/true);
+    CopyGroup(b_thermal_, k, b_, /*in=*/true);
+    if (not x_is_nest) CopyGroup(x_thermal_, k, x_[lfg + k], /*in=*/true);
+  }
+  PetscObjectStateIncrease((PetscObject)b_thermal_);
+  PetscObjectStateIncrease((PetscObject)x_thermal_);
+
+  //============================================= Solve
+  if (verbose > 1) Chi::log.Log() << "Solving the coupled thermal groups";
+
+  KSPSolve(thermal_ksp_, b_thermal_, x_thermal_);
+
+  if (not x_is_nest)
+    for (unsigned int k = 0; k < num_thermal; ++k)
+      CopyGroup(x_thermal_, k, x_[lfg + k], /*in=*/false);
+
+  // this is required to compute the inscattering RHS correctly in parallel
+  for (unsigned int g = lfg; g < num_groups_; ++g)
+    chi_math::PETScUtils::CommunicateGhostEntries(x_[g]);
+
+  if (verbose > 0)
+  {
+    PetscInt num_iterations;
+    KSPConvergedReason reason;
+    KSPGetIterationNumber(thermal_ksp_, &num_iterations);
+    KSPGetConvergedReason(thermal_ksp_, &reason);
+
+    Chi::log.Log() << "\nCoupled thermal solve "
+                   << (reason > 0 ? "converged" : "NOT converged")
+                   << " in " << num_iterations << " iterations";
+  }
+}
+
+//========================================================== Two-grid PC
+/**Applies the two-grid correction to a residual of the coupled thermal
+ * system, as after a Gauss-Seidel thermal iteration: the residuals of the
+ * groups are summed into the rhs of the two-grid problem, whose flux is
+ * distributed over the groups by the spectrum.*/
+void mg_diffusion::Solver::ApplyTwoGridPreconditioner(Vec r, Vec z)
+{
+  const size_t num_thermal = thermal_iss_.size();
+
+  VecSet(b_two_grid_, 0.0);
+  for (size_t k = 0; k < num_thermal; ++k)
+  {
+    Vec r_g;
+    VecGetSubVector(r, thermal_iss_[k], &r_g);
+    VecAXPY(b_two_grid_, 1.0, r_g);
+    VecRestoreSubVector(r, thermal_iss_[k], &r_g);
+  }
+
+  VecSet(x_[num_groups_], 0.0);
+  KSPSolve(two_grid_ksp_, b_two_grid_, x_[num_groups_]);
+  chi_math::PETScUtils::CommunicateGhostEntries(x_[num_groups_]);
+
+  VecSet(z, 0.0);
+  std::vector<Vec> z_g(num_thermal, nullptr);
+  for (size_t k = 0; k < num_thermal; ++k)
+    VecGetSubVector(z, thermal_iss_[k], &z_g[k]);
+  Add_TwoGrid_Correction(x_[num_groups_], z_g.data());
+  for (size_t k = 0; k < num_thermal; ++k)
+    VecRestoreSubVector(z, thermal_iss_[k], &z_g[k]);
+}
@@ -0,0 +1,156 @@
+#include "chi_lua.h"
+#include "console/chi_console.h"
+
+#include "../prk_ensemble_solver.h"
+#include "prk_lua_utils.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+namespace prk::lua_utils
+{
+
+RegisterLuaFunctionAsIs(chiPRKEnsembleGetParam);
+RegisterLuaFunctionAsIs(chiPRKEnsembleSetParam);
+RegisterLuaFunctionAsIs(chiPRKEnsembleSetKineticsParameters);
+
+namespace
+{
+/**Pushes a table of the values onto the stack.*/
+void PushTable(lua_State* L, const std::vector<double>& values)
+{
+  lua_newtable(L);
+  for (size_t k = 0; k < values.size(); ++k)
+  {
+    lua_pushinteger(L, static_cast<lua_Integer>(k + 1));
+    lua_pushnumber(L, values[k]);
+    lua_settable(L, -3);
+  }
+}
+} // namespace
+
+/**Gets a parameter from the prk::EnsembleSolver.
+*
+* \param handle int Handle of the solver.
+* \param param_name  string Name of the parameter to retrieve. Either
+*        "populations_prev", "populations_next" or "periods", returned as
+*        tables with one entry per instance, or "time_prev" or "time_next".
+\return Varying*/
+int chiPRKEnsembleGetParam(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 2) LuaPostArgAmountError(fname, 2, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+
+  const int handle = lua_tointeger(L, 1);
+
+  const auto& solver =
+    Chi::GetStackItem<EnsembleSolver>(Chi::object_stack, handle, fname);
+
+  const std::string param_name = lua_tostring(L, 2);
+
+  if (param_name == "populations_prev")
+    PushTable(L, solver.PopulationsPrev());
+  else if (param_name == "populations_next")
+    PushTable(L, solver.PopulationsNext());
+  else if (param_name == "periods")
+    PushTable(L, solver.Periods());
+  else if (param_name == "time_prev")
+    lua_pushnumber(L, solver.TimePrev());
+  else if (param_name == "time_next")
+    lua_pushnumber(L, solver.TimeNext());
+  else
+    throw std::invalid_argument(fname + ": Invalid parameter \"" + param_name +
+                                "\".");
+
+  return 1;
+}
+
+/**Sets a parameter of the prk::EnsembleSolver.
+*
+* \param handle int Handle of the solver.
+* \param param_name  string Name of the parameter to set. Either "rhos" or
+*        "source_strengths", with a table of one value per instance, or
+*        "dt", with a number.
+* \param value Varying The value to be set to the parameter.*/
+int chiPRKEnsembleSetParam(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 3) LuaPostArgAmountError(fname, 3, num_args);
+
+  LuaCheckNilValue(fname, L, 1);
+  LuaCheckStringValue(fname, L, 2);
+  LuaCheckNilValue(fname, L, 3);
+
+  const int handle = lua_tointeger(L, 1);
+
+  auto& solver =
+    Chi::GetStackItem<EnsembleSolver>(Chi::object_stack, handle, fname);
+
+  const std::string param_name = lua_tostring(L, 2);
+
+  if (param_name == "rhos" or param_name == "source_strengths")
+  {
+    LuaCheckTableValue(fname, L, 3);
+    std::vector<double> values;
+    LuaPopulateVectorFrom1DArray(fname, L, 3, values);
+    if (param_name == "rhos") solver.SetRhos(values);
+    else
+      solver.SetSourceStrengths(values);
+  }
+  else if (param_name == "dt")
+  {
+    LuaCheckNumberValue(fname, L, 3);
+    solver.SetTimeStep(lua_tonumber(L, 3));
+  }
+  else
+    throw std::invalid_argument(fname + ": Invalid parameter \"" + param_name +
+                                "\".");
+
+  return 0;
+}
+
+/**Sets the kinetics parameters of one instance of the
+* prk::EnsembleSolver.
+*
+* \param handle int Handle of the solver.
+* \param instance int Index of the instance, starting at 0.
+* \param lambdas table Decay constants of the precursors.
+* \param betas table Delayed neutron fractions of the precursors.
+* \param gen_time double Neutron generation time [s].*/
+int chiPRKEnsembleSetKineticsParameters(lua_State* L)
+{
+  const std::string fname = __FUNCTION__;
+  const int num_args = lua_gettop(L);
+  if (num_args != 5) LuaPostArgAmountError(fname, 5, num_args);
+
+  LuaCheckIntegerValue(fname, L, 1);
+  LuaCheckIntegerValue(fname, L, 2);
+  LuaCheckTableValue(fname, L, 3);
+  LuaCheckTableValue(fname, L, 4);
+  LuaCheckNumberValue(fname, L, 5);
+
+  const int handle = lua_tointeger(L, 1);
+  const auto instance = lua_tointeger(L, 2);
+  if (instance < 0)
+    throw std::invalid_argument(fname + ": Invalid instance index.");
+
+  std::vector<double> lambdas, betas;
+  LuaPopulateVectorFrom1DArray(fname, L, 3, lambdas);
+  LuaPopulateVectorFrom1DArray(fname, L, 4, betas);
+  const double gen_time = lua_tonumber(L, 5);
+
+  auto& solver =
+    Chi::GetStackItem<EnsembleSolver>(Chi::object_stack, handle, fname);
+
+  solver.SetKineticsParameters(
+    static_cast<size_t>(instance), lambdas, betas, gen_time);
+
+  return 0;
+}
+
+} // namespace prk::lua_utils
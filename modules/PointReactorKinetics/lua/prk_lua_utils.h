@@ -8,6 +8,10 @@ namespace prk::lua_utils
 int chiPRKGetParam(lua_State* L);
 int chiPRKSetParam(lua_State* L);
 
+int chiPRKEnsembleGetParam(lua_State* L);
+int chiPRKEnsembleSetParam(lua_State* L);
+int chiPRKEnsembleSetKineticsParameters(lua_State* L);
+
 chi::InputParameters GetSyntax_SetParam();
 chi::ParameterBlock
 SetParam(const chi::InputParameters& params);
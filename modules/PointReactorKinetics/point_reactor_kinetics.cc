@@ -228,4 +228,63 @@ std::vector<double> TransientSolver::SolutionNext() const
 /**Sets the value of rho.*/
 void TransientSolver::SetRho(double value) { rho_ = value; }
 
+/**Sets the source strength [/s].*/
+void TransientSolver::SetSourceStrength(double value)
+{
+  ChiInvalidArgumentIf(value < 0.0, "The source strength must be "
+                                    "non-negative.");
+  source_strength_ = value;
+  if (not q_.elements_.empty()) q_[0] = value;
+}
+
+/**Sets the timestep size.*/
+void TransientSolver::SetTimeStep(double dt)
+{
+  ChiInvalidArgumentIf(dt <= 0.0, "The timestep must be positive.");
+  dt_ = dt;
+}
+
+/**Sets the kinetics parameters, e.g., as computed from a transport
+ * solution, and reassembles the precursor rows of the system. The number
+ * of precursors must remain the same after initialization.*/
+void TransientSolver::SetKineticsParameters(const std::vector<double>& lambdas,
+                                            const std::vector<double>& betas,
+                                            double gen_time)
+{
+  ChiInvalidArgumentIf(lambdas.size() != betas.size(),
+                       "The decay constants and delayed neutron fractions "
+                       "must be of the same size.");
+  ChiInvalidArgumentIf(A_.size() > 0 and lambdas.size() != num_precursors_,
+                       "The number of precursors cannot change after "
+                       "initialization.");
+  ChiInvalidArgumentIf(gen_time <= 0.0,
+                       "The neutron generation time must be positive.");
+
+  lambdas_ = lambdas;
+  betas_ = betas;
+  gen_time_ = gen_time;
+  num_precursors_ = lambdas_.size();
+  beta_ = std::accumulate(betas_.begin(), betas_.end(), /*init_val=*/0.0);
+
+  if (A_.size() == 0) return;
+  for (size_t j = 1; j <= num_precursors_; ++j)
+  {
+    A_[0][j] = lambdas_[j - 1];
+    A_[j][j] = -lambdas_[j - 1];
+    A_[j][0] = betas_[j - 1] / gen_time_;
+  }
+}
+
+/**Sets the time and solution, at the previous time step, from which the
+ * next step is taken. Allows a step to be retaken.*/
+void TransientSolver::SetState(double time,
+                               const std::vector<double>& solution)
+{
+  ChiInvalidArgumentIf(solution.size() != num_precursors_ + 1,
+                       "The solution must be of size one plus the number "
+                       "of precursors.");
+  time_ = time;
+  x_t_.elements_ = solution;
+}
+
 } // namespace prk
@@ -49,6 +49,12 @@ public:
 
 
   void SetRho(double value);
+  void SetSourceStrength(double value);
+  void SetTimeStep(double dt);
+  void SetKineticsParameters(const std::vector<double>& lambdas,
+                             const std::vector<double>& betas,
+                             double gen_time);
+  void SetState(double time, const std::vector<double>& solution);
 };
 } // namespace prk
 
@@ -0,0 +1,388 @@
+#include "prk_ensemble_solver.h"
+
+#include "ChiObjectFactory.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace prk
+{
+
+RegisterChiObject(prk, EnsembleSolver);
+
+namespace
+{
+/**Number of instances processed together by a thread, sized such that the
+ * temporaries of a block stay in the L1 cache.*/
+constexpr size_t BLOCK_SIZE = 256;
+} // namespace
+
+/**Sets input parameters.*/
+chi::InputParameters EnsembleSolver::GetInputParameters()
+{
+  chi::InputParameters params = chi_physics::Solver::GetInputParameters();
+
+  params.SetGeneralDescription(
+    "Point kinetics solver for an ensemble of independent reactors, "
+    "advanced together. Every instance is initialized with the nominal "
+    "parameters below, which can then be changed instance by instance.");
+  params.SetDocGroup("prk");
+
+  params.ChangeExistingParamToOptional("name", "prk_EnsembleSolver");
+
+  params.AddRequiredParameter<size_t>("num_instances",
+                                      "Number of reactor instances");
+
+  std::vector<double> default_lambdas = {
+    0.0124, 0.0304, 0.111, 0.301, 1.14, 3.01};
+  std::vector<double> default_betas = {
+    0.00021, 0.00142, 0.00127, 0.00257, 0.00075, 0.00027};
+
+  params.AddOptionalParameterArray("precursor_lambdas",
+                                   default_lambdas,
+                                   "Nominal array of decay constants");
+  params.AddOptionalParameterArray(
+    "precursor_betas",
+    default_betas,
+    "Nominal array of fractional delayed neutron fractions");
+
+  params.AddOptionalParameter(
+    "gen_time", 1.0e-5, "Nominal neutron generation time [s]");
+  params.AddOptionalParameter(
+    "initial_rho", 0.0, "Nominal initial reactivity [$]");
+  params.AddOptionalParameter(
+    "initial_source", 1.0, "Nominal initial source strength [/s]");
+  params.AddOptionalParameter("dt", 0.01, "Timestep size [s]");
+
+  params.AddOptionalParameter(
+    "time_integration", "implicit_euler", "Time integration scheme to use");
+
+  using namespace chi_data_types;
+  auto time_intgl_list = AllowableRangeList::New(
+    {"explicit_euler", "implicit_euler", "crank_nicolson"});
+
+  params.ConstrainParameterRange("time_integration",
+                                 std::move(time_intgl_list));
+
+  params.ConstrainParameterRange("num_instances",
+                                 AllowableRangeLowLimit::New(1));
+  params.ConstrainParameterRange("gen_time",
+                                 AllowableRangeLowLimit::New(1.0e-12));
+  params.ConstrainParameterRange(
+    "dt", AllowableRangeLowHighLimit::New(1.0e-12, 100.0));
+  params.ConstrainParameterRange("initial_source",
+                                 AllowableRangeLowLimit::New(0.0));
+  return params;
+}
+
+/**Constructor. Sets every instance to the nominal parameters.*/
+EnsembleSolver::EnsembleSolver(const chi::InputParameters& params)
+  : chi_physics::Solver(params.GetParamValue<std::string>("name")),
+    num_instances_(params.GetParamValue<size_t>("num_instances")),
+    dt_(params.GetParamValue<double>("dt")),
+    time_integration_(params.GetParamValue<std::string>("time_integration"))
+{
+  const auto lambdas = params.GetParamVectorValue<double>("precursor_lambdas");
+  const auto betas = params.GetParamVectorValue<double>("precursor_betas");
+  ChiInvalidArgumentIf(lambdas.size() != betas.size(),
+                       "The decay constants and delayed neutron fractions "
+                       "must be of the same size.");
+
+  const size_t N = num_instances_;
+  num_precursors_ = lambdas.size();
+
+  lambdas_.resize(num_precursors_ * N);
+  betas_.resize(num_precursors_ * N);
+  beta_totals_.assign(N, 0.0);
+  gen_times_.assign(N, 0.0);
+  for (size_t n = 0; n < N; ++n)
+    SetKineticsParameters(
+      n, lambdas, betas, params.GetParamValue<double>("gen_time"));
+
+  rhos_.assign(N, params.GetParamValue<double>("initial_rho"));
+  source_strengths_.assign(N, params.GetParamValue<double>("initial_source"));
+
+  Chi::log.Log() << "Created solver " << TextName() << " with " << N
+                 << " instances of " << num_precursors_ << " precursors";
+}
+
+/**Initializes the solution of every instance. As for
+ * prk::TransientSolver, an instance with a source and a negative
+ * reactivity starts from its unique steady state, the others from the
+ * critical state of unit population, with no source.*/
+void EnsembleSolver::Initialize()
+{
+  const size_t N = num_instances_;
+  const size_t J = num_precursors_;
+
+  x_t_.assign((J + 1) * N, 0.0);
+  x_tp1_ = x_t_;
+  periods_.assign(N, 0.0);
+
+  for (size_t n = 0; n < N; ++n)
+  {
+    const double gen_time = gen_times_[n];
+    const bool subcritical_source =
+      source_strengths_[n] > 0.0 and rhos_[n] < 0.0;
+
+    const double population =
+      subcritical_source ? -source_strengths_[n] * gen_time /
+                             (beta_totals_[n] * rhos_[n])
+                         : 1.0;
+    x_t_[n] = population;
+    for (size_t j = 0; j < J; ++j)
+      x_t_[(j + 1) * N + n] = betas_[j * N + n] * population /
+                              (gen_time * lambdas_[j * N + n]);
+  }
+
+  x_tp1_ = x_t_;
+  initialized_ = true;
+}
+
+/**Execution function.*/
+void EnsembleSolver::Execute() {}
+
+/**Computes the next solution of every instance.*/
+void EnsembleSolver::Step()
+{
+  ChiLogicalErrorIf(not initialized_,
+                    "The solver must be initialized before stepping.");
+
+  if (time_integration_ == "implicit_euler") StepImplicit(1.0);
+  else if (time_integration_ == "crank_nicolson")
+    StepImplicit(0.5);
+  else if (time_integration_ == "explicit_euler")
+    StepExplicit();
+  else
+    ChiLogicalError("Unsupported time integration scheme.");
+
+  const size_t N = num_instances_;
+  for (size_t n = 0; n < N; ++n)
+  {
+    double period = dt_ / log(x_tp1_[n] / x_t_[n]);
+    if (period > 0.0 and period > 1.0e6) period = 1.0e6;
+    if (period < 0.0 and period < -1.0e6) period = -1.0e6;
+    periods_[n] = period;
+  }
+}
+
+/**Advance time values function.*/
+void EnsembleSolver::Advance()
+{
+  time_ += dt_;
+  x_t_ = x_tp1_;
+}
+
+// ##################################################################
+/**Theta scheme step, (I - theta dt A) x_theta = x_t + theta dt q followed
+ * by x_tp1 = x_t + (x_theta - x_t) / theta.
+ *
+ * With tau = theta dt, the precursor rows give
+ * c_j = (c_j,t + tau beta_j / Lambda n) / (1 + tau lambda_j) which,
+ * substituted in the population row, leaves a scalar equation for n.*/
+void EnsembleSolver::StepImplicit(const double theta)
+{
+  const size_t N = num_instances_;
+  const size_t J = num_precursors_;
+  const double tau = theta * dt_;
+  const size_t num_blocks = (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+#pragma omp parallel for schedule(static)
+  for (size_t block = 0; block < num_blocks; ++block)
+  {
+    const size_t n0 = block * BLOCK_SIZE;
+    const size_t block_size = std::min(BLOCK_SIZE, N - n0);
+
+    std::array<double, BLOCK_SIZE> lhs;
+    std::array<double, BLOCK_SIZE> rhs;
+
+    // ============================= Population row
+    const double* rho = &rhos_[n0];
+    const double* beta = &beta_totals_[n0];
+    const double* gen_time = &gen_times_[n0];
+    const double* q = &source_strengths_[n0];
+    const double* n_t = &x_t_[n0];
+#pragma omp simd
+    for (size_t k = 0; k < block_size; ++k)
+    {
+      lhs[k] = 1.0 - tau * beta[k] * (rho[k] - 1.0) / gen_time[k];
+      rhs[k] = n_t[k] + tau * q[k];
+    }
+
+    // ============================= Eliminate the precursors
+    for (size_t j = 0; j < J; ++j)
+    {
+      const double* lambda_j = &lambdas_[j * N + n0];
+      const double* beta_j = &betas_[j * N + n0];
+      const double* c_t = &x_t_[(j + 1) * N + n0];
+#pragma omp simd
+      for (size_t k = 0; k < block_size; ++k)
+      {
+        const double tau_lambda = tau * lambda_j[k];
+        const double inv_diag = 1.0 / (1.0 + tau_lambda);
+        lhs[k] -= tau_lambda * inv_diag * tau * beta_j[k] / gen_time[k];
+        rhs[k] += tau_lambda * inv_diag * c_t[k];
+      }
+    }
+
+    // ============================= Population and precursors
+    double* n_tp1 = &x_tp1_[n0];
+    const double inv_theta = 1.0 / theta;
+#pragma omp simd
+    for (size_t k = 0; k < block_size; ++k)
+    {
+      rhs[k] /= lhs[k]; // n_theta
+      n_tp1[k] = n_t[k] + inv_theta * (rhs[k] - n_t[k]);
+    }
+
+    for (size_t j = 0; j < J; ++j)
+    {
+      const double* lambda_j = &lambdas_[j * N + n0];
+      const double* beta_j = &betas_[j * N + n0];
+      const double* c_t = &x_t_[(j + 1) * N + n0];
+      double* c_tp1 = &x_tp1_[(j + 1) * N + n0];
+#pragma omp simd
+      for (size_t k = 0; k < block_size; ++k)
+      {
+        const double c_theta =
+          (c_t[k] + tau * beta_j[k] / gen_time[k] * rhs[k]) /
+          (1.0 + tau * lambda_j[k]);
+        c_tp1[k] = c_t[k] + inv_theta * (c_theta - c_t[k]);
+      }
+    }
+  } // for block
+}
+
+// ##################################################################
+/**Explicit Euler step, x_tp1 = x_t + dt A x_t + dt q.*/
+void EnsembleSolver::StepExplicit()
+{
+  const size_t N = num_instances_;
+  const size_t J = num_precursors_;
+  const double dt = dt_;
+  const size_t num_blocks = (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+#pragma omp parallel for schedule(static)
+  for (size_t block = 0; block < num_blocks; ++block)
+  {
+    const size_t n0 = block * BLOCK_SIZE;
+    const size_t block_size = std::min(BLOCK_SIZE, N - n0);
+
+    const double* rho = &rhos_[n0];
+    const double* beta = &beta_totals_[n0];
+    const double* gen_time = &gen_times_[n0];
+    const double* q = &source_strengths_[n0];
+    const double* n_t = &x_t_[n0];
+    double* n_tp1 = &x_tp1_[n0];
+#pragma omp simd
+    for (size_t k = 0; k < block_size; ++k)
+      n_tp1[k] = n_t[k] + dt * (beta[k] * (rho[k] - 1.0) / gen_time[k] *
+                                  n_t[k] + q[k]);
+
+    for (size_t j = 0; j < J; ++j)
+    {
+      const double* lambda_j = &lambdas_[j * N + n0];
+      const double* beta_j = &betas_[j * N + n0];
+      const double* c_t = &x_t_[(j + 1) * N + n0];
+      double* c_tp1 = &x_tp1_[(j + 1) * N + n0];
+#pragma omp simd
+      for (size_t k = 0; k < block_size; ++k)
+      {
+        n_tp1[k] += dt * lambda_j[k] * c_t[k];
+        c_tp1[k] = c_t[k] + dt * (beta_j[k] / gen_time[k] * n_t[k] -
+                                  lambda_j[k] * c_t[k]);
+      }
+    }
+  } // for block
+}
+
+// ##################################################################
+/**Returns the populations of all the instances at the previous time
+ * step.*/
+std::vector<double> EnsembleSolver::PopulationsPrev() const
+{
+  return {x_t_.begin(), x_t_.begin() + static_cast<long>(num_instances_)};
+}
+/**Returns the populations of all the instances at the next time step.*/
+std::vector<double> EnsembleSolver::PopulationsNext() const
+{
+  return {x_tp1_.begin(), x_tp1_.begin() + static_cast<long>(num_instances_)};
+}
+
+/**Returns the time computed for the last time step.*/
+double EnsembleSolver::TimePrev() const { return time_; }
+
+/**Returns the time computed for the next time step.*/
+double EnsembleSolver::TimeNext() const { return time_ + dt_; }
+
+/**Returns the solution of an instance at the previous time step, the
+ * population followed by the precursors, as prk::TransientSolver.*/
+std::vector<double> EnsembleSolver::SolutionPrev(const size_t instance) const
+{
+  ChiInvalidArgumentIf(instance >= num_instances_, "Invalid instance index.");
+  ChiLogicalErrorIf(not initialized_, "The solver is not initialized.");
+
+  std::vector<double> solution(num_precursors_ + 1);
+  for (size_t k = 0; k <= num_precursors_; ++k)
+    solution[k] = x_t_[k * num_instances_ + instance];
+  return solution;
+}
+
+// ##################################################################
+/**Sets the reactivities [$] of all the instances.*/
+void EnsembleSolver::SetRhos(const std::vector<double>& rhos)
+{
+  ChiInvalidArgumentIf(rhos.size() != num_instances_,
+                       "One reactivity per instance is required.");
+  rhos_ = rhos;
+}
+
+/**Sets the source strengths of all the instances.*/
+void EnsembleSolver::SetSourceStrengths(
+  const std::vector<double>& source_strengths)
+{
+  ChiInvalidArgumentIf(source_strengths.size() != num_instances_,
+                       "One source strength per instance is required.");
+  source_strengths_ = source_strengths;
+}
+
+/**Sets the timestep size.*/
+void EnsembleSolver::SetTimeStep(double dt)
+{
+  ChiInvalidArgumentIf(dt <= 0.0, "The timestep must be positive.");
+  dt_ = dt;
+}
+
+/**Sets the kinetics parameters of one instance. The number of precursors
+ * is that of the whole ensemble.*/
+void EnsembleSolver::SetKineticsParameters(size_t instance,
+                                           const std::vector<double>& lambdas,
+                                           const std::vector<double>& betas,
+                                           double gen_time)
+{
+  ChiInvalidArgumentIf(instance >= num_instances_, "Invalid instance index.");
+  ChiInvalidArgumentIf(lambdas.size() != num_precursors_ or
+                         betas.size() != num_precursors_,
+                       "The number of precursors of an instance must be "
+                       "that of the ensemble.");
+  ChiInvalidArgumentIf(gen_time <= 0.0,
+                       "The neutron generation time must be positive.");
+
+  const size_t N = num_instances_;
+  for (size_t j = 0; j < num_precursors_; ++j)
+  {
+    ChiInvalidArgumentIf(lambdas[j] <= 0.0,
+                         "The decay constants must be positive.");
+    lambdas_[j * N + instance] = lambdas[j];
+    betas_[j * N + instance] = betas[j];
+  }
+  beta_totals_[instance] =
+    std::accumulate(betas.begin(), betas.end(), /*init_val=*/0.0);
+  gen_times_[instance] = gen_time;
+}
+
+} // namespace prk
@@ -0,0 +1,81 @@
+#ifndef CHITECH_PRK_ENSEMBLE_SOLVER_H
+#define CHITECH_PRK_ENSEMBLE_SOLVER_H
+
+#include "physics/SolverBase/chi_solver.h"
+
+namespace prk
+{
+/**Point kinetics solver for an ensemble of independent reactors, e.g., the
+ * sampled parameter sets of an uncertainty study, advanced together.
+
+The instances share the number of precursors, the timestep and the time
+integration scheme of prk::TransientSolver, while their kinetics
+parameters, reactivities and sources are independent. The data is stored
+structure-of-arrays, i.e., the values of a quantity for all the instances
+are contiguous, instance fastest. A step is computed in blocks of instances
+distributed over the threads, the innermost loops being over the
+instances of a block such that they vectorize.
+
+The system of an instance is arrow-shaped, the precursors coupling only
+to the population, and is solved in closed form: eliminating the
+precursors yields the population, from which the precursors are
+recovered. This avoids the dense inverse of prk::TransientSolver and is
+equivalent to it up to roundoff.*/
+class EnsembleSolver : public chi_physics::Solver
+{
+private:
+  size_t num_instances_;
+  size_t num_precursors_;
+  double dt_;
+  std::string time_integration_;
+
+  // Per instance quantities, of size num_instances_ and, for the precursor
+  // ones, num_precursors_ x num_instances_, instance fastest
+  std::vector<double> lambdas_;
+  std::vector<double> betas_;
+  std::vector<double> beta_totals_;
+  std::vector<double> gen_times_;
+  std::vector<double> rhos_;
+  std::vector<double> source_strengths_;
+
+  // Solutions, (num_precursors_ + 1) x num_instances_, the populations
+  // first, then the precursors
+  std::vector<double> x_t_, x_tp1_;
+  std::vector<double> periods_;
+  double time_ = 0.0;
+  bool initialized_ = false;
+
+public:
+  static chi::InputParameters GetInputParameters();
+  explicit EnsembleSolver(const chi::InputParameters& params);
+
+  void Initialize() override;
+  void Execute() override;
+  void Step() override;
+  void Advance() override;
+
+  // Getters and Setters
+  size_t NumInstances() const { return num_instances_; }
+  size_t NumPrecursors() const { return num_precursors_; }
+  std::vector<double> PopulationsPrev() const;
+  std::vector<double> PopulationsNext() const;
+  const std::vector<double>& Periods() const { return periods_; }
+  double TimePrev() const;
+  double TimeNext() const;
+  std::vector<double> SolutionPrev(size_t instance) const;
+
+  void SetRhos(const std::vector<double>& rhos);
+  void SetSourceStrengths(const std::vector<double>& source_strengths);
+  void SetTimeStep(double dt);
+  void SetKineticsParameters(size_t instance,
+                             const std::vector<double>& lambdas,
+                             const std::vector<double>& betas,
+                             double gen_time);
+
+private:
+  void StepImplicit(double theta);
+  void StepExplicit();
+};
+} // namespace prk
+
+#endif // CHITECH_PRK_ENSEMBLE_SOLVER_H
@@ -49,6 +49,7 @@ endif()
 message(STATUS "VTK_DIR set to ${VTK_DIR}")
 
 find_package(MPI)
+find_package(OpenMP)
 set(CMAKE_MODULE_PATH ${CMAKE_MODULE_PATH}
     "${CHI_TECH_DIR}/resources/CMakeMacros")
 
@@ -115,6 +116,9 @@ endif()
 
 set(CHI_LIBS stdc++ lua m dl ${MPI_CXX_LIBRARIES} petsc ${VTK_LIBRARIES})
 set(CHI_LIBS ${CHI_LIBS} external)
+if (OpenMP_CXX_FOUND)
+    set(CHI_LIBS ${CHI_LIBS} OpenMP::OpenMP_CXX)
+endif()
 
 #================================================ Compiler flags
 set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${MPI_CXX_COMPILE_FLAGS}")
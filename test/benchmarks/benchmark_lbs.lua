@@ -0,0 +1,80 @@
+-- Microbenchmarks of the source function and the sweeps of a discrete
+-- ordinates solver, on a 3D orthogonal mesh of hexahedra or, with
+-- dimension=2, a 2D orthogonal mesh of quadrilaterals. The group, moment and
+-- angle counts are varied with num_groups, scattering_order and
+-- num_polar/num_azimuthal.
+-- Results: benchmark_lbs.json, in the JSON format of Google Benchmark.
+if (dimension == nil) then dimension = 3 end
+if (N == nil) then N = 16 end
+if (num_groups == nil) then num_groups = 16 end
+if (scattering_order == nil) then scattering_order = 1 end
+if (num_azimuthal == nil) then num_azimuthal = 4 end
+if (num_polar == nil) then num_polar = 2 end
+if (output_file == nil) then output_file = "benchmark_lbs.json" end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+mesh={}
+L=1.0
+dx = L/N
+for i=1,(N+1) do
+  mesh[i] = (i-1)*dx
+end
+if (dimension == 2) then
+  chiMeshCreateUnpartitioned2DOrthoMesh(mesh,mesh)
+else
+  chiMeshCreateUnpartitioned3DOrthoMesh(mesh,mesh,mesh)
+end
+chiVolumeMesherExecute();
+chiVolumeMesherSetMatIDToAll(0)
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+chiPhysicsMaterialSetProperty(materials[1],
+                              TRANSPORT_XSECTIONS,
+                              SIMPLEXS1,num_groups,1.0,0.5)
+
+src={}
+for g=1,num_groups do
+  src[g] = 1.0
+end
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,
+                                    num_azimuthal, num_polar)
+
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_type = "single",
+      inner_linear_method = "richardson",
+      l_abs_tol = 1.0e-6,
+      l_max_its = 1,
+    },
+  }
+}
+
+lbs_options =
+{
+  scattering_order = scattering_order,
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+lbs.SetOptions(phys1, lbs_options)
+chiSolverInitialize(phys1)
+
+--############################################### Benchmark
+chi_unit_tests.BenchmarkLBS(phys1)
+chi_unit_tests.WriteBenchmarkResults(output_file)
@@ -0,0 +1,6 @@
+-- Microbenchmarks of the dense and sparse matrix kernels.
+-- Results: benchmark_math.json, in the JSON format of Google Benchmark.
+if (output_file == nil) then output_file = "benchmark_math.json" end
+
+chi_unit_tests.BenchmarkMath()
+chi_unit_tests.WriteBenchmarkResults(output_file)
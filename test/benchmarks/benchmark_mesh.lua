@@ -0,0 +1,28 @@
+-- Microbenchmarks of the mesh lookups, the point location and the ghost
+-- communication, on a 3D orthogonal mesh of hexahedra or, with dimension=2,
+-- a 2D orthogonal mesh of quadrilaterals.
+-- Results: benchmark_mesh.json, in the JSON format of Google Benchmark.
+if (dimension == nil) then dimension = 3 end
+if (N == nil) then N = 32 end
+if (output_file == nil) then output_file = "benchmark_mesh.json" end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+mesh={}
+L=1.0
+dx = L/N
+for i=1,(N+1) do
+  mesh[i] = (i-1)*dx
+end
+if (dimension == 2) then
+  chiMeshCreateUnpartitioned2DOrthoMesh(mesh,mesh)
+else
+  chiMeshCreateUnpartitioned3DOrthoMesh(mesh,mesh,mesh)
+end
+chiVolumeMesherExecute();
+chiVolumeMesherSetMatIDToAll(0)
+
+--############################################### Benchmark
+chi_unit_tests.BenchmarkMesh()
+chi_unit_tests.WriteBenchmarkResults(output_file)
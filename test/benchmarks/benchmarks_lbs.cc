@@ -0,0 +1,104 @@
+#include "chi_benchmark.h"
+
+#include "B_DiscreteOrdinatesSolver/lbs_discrete_ordinates_solver.h"
+#include "B_DiscreteOrdinatesSolver/IterativeMethods/sweep_wgs_context.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+#include "math/chi_math.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "console/chi_console.h"
+
+namespace chi_unit_tests::benchmarks
+{
+
+chi::InputParameters BenchmarkLBSSyntax();
+chi::ParameterBlock BenchmarkLBS(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/BenchmarkLBS,
+                        /*syntax_function=*/BenchmarkLBSSyntax,
+                        /*actual_function=*/BenchmarkLBS);
+
+chi::InputParameters BenchmarkLBSSyntax()
+{
+  chi::InputParameters params;
+
+  params.SetGeneralDescription(
+    "Benchmarks the source function and the sweeps of every groupset of an "
+    "initialized discrete ordinates solver.");
+
+  params.AddRequiredParameter<size_t>("arg0", "Handle to the solver.");
+
+  return params;
+}
+
+/**Benchmarks, per groupset, the evaluation of the scattering and fixed
+ * sources and a sweep, i.e., the sweep chunk over all the cells and angles
+ * together with the communication. The names carry the group, moment and
+ * angle counts and the type of the first local cell, the inputs varying
+ * these, and the items are the cells and the cell-angle-groups,
+ * respectively.*/
+chi::ParameterBlock BenchmarkLBS(const chi::InputParameters& params)
+{
+  const std::string fname = __FUNCTION__;
+  const size_t handle = params.GetParamValue<size_t>("arg0");
+
+  auto& solver = Chi::GetStackItem<lbs::DiscreteOrdinatesSolver>(
+    Chi::object_stack, handle, fname);
+
+  const auto& grid = solver.Grid();
+  ChiLogicalErrorIf(grid.local_cells.size() == 0,
+                    "Every location needs local cells.");
+  const auto num_local_cells = static_cast<double>(grid.local_cells.size());
+  const std::string cell_type =
+    chi_mesh::CellTypeName(grid.local_cells[0].Type());
+
+  auto source_function = solver.GetActiveSetSourceFunction();
+  auto& q_moments_local = solver.QMomentsLocal();
+  const auto& phi_old_local = solver.PhiOldLocal();
+
+  const auto source_flags =
+    lbs::APPLY_FIXED_SOURCES | lbs::APPLY_WGS_SCATTER_SOURCES |
+    lbs::APPLY_AGS_SCATTER_SOURCES;
+
+  for (auto& groupset : solver.Groupsets())
+  {
+    const size_t num_groups = groupset.groups_.size();
+    const size_t num_angles = groupset.quadrature_->abscissae_.size();
+    const std::string prefix = "/groupset:" + std::to_string(groupset.id_) +
+                               "/groups:" + std::to_string(num_groups);
+
+    RunBenchmark("SourceFunction" + prefix +
+                   "/moments:" + std::to_string(solver.NumMoments()) + "/" +
+                   cell_type,
+                 [&]()
+                 {
+                   chi_math::Set(q_moments_local, 0.0);
+                   source_function(
+                     groupset, q_moments_local, phi_old_local, source_flags);
+                   DoNotOptimize(q_moments_local.data());
+                 },
+                 num_local_cells);
+
+    typedef lbs::SweepWGSContext<Mat, Vec, KSP> SweepContext;
+    auto* sweep_context =
+      dynamic_cast<SweepContext*>(&solver.GetWGSContext(groupset.id_));
+    ChiLogicalErrorIf(not sweep_context, "The solver does not sweep.");
+
+    RunBenchmark("Sweep" + prefix + "/angles:" + std::to_string(num_angles) +
+                   "/" + cell_type,
+                 [&]()
+                 {
+                   sweep_context->ApplyInverseTransportOperator(
+                     lbs::APPLY_FIXED_SOURCES);
+                 },
+                 num_local_cells * static_cast<double>(num_angles) *
+                   static_cast<double>(num_groups));
+  }
+
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests::benchmarks
@@ -0,0 +1,130 @@
+#include "chi_benchmark.h"
+
+#include "math/chi_math.h"
+#include "math/SparseMatrix/chi_math_sparse_matrix.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "console/chi_console.h"
+
+namespace chi_unit_tests::benchmarks
+{
+
+chi::ParameterBlock BenchmarkMath(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/BenchmarkMath,
+                        /*syntax_function=*/nullptr,
+                        /*actual_function=*/BenchmarkMath);
+
+/**Benchmarks the dense solvers, at the node counts of the common cells,
+ * and the row iteration of sparse matrices.*/
+chi::ParameterBlock BenchmarkMath(const chi::InputParameters&)
+{
+  //============================================= Gauss elimination
+  // The node counts of triangles, quadrilaterals, hexahedra, and of larger
+  // polyhedra. The copies of the system are timed too, their cost being
+  // small compared to the elimination.
+  for (const int n : {3, 4, 8, 16, 32, 64})
+  {
+    MatDbl A_ref(n, VecDbl(n, -1.0));
+    for (int i = 0; i < n; ++i)
+      A_ref[i][i] = 2.0 * n;
+    const VecDbl b_ref(n, 1.0);
+
+    MatDbl A;
+    VecDbl b;
+    RunBenchmark("GaussElimination/nodes:" + std::to_string(n),
+                 [&]()
+                 {
+                   A = A_ref;
+                   b = b_ref;
+                   chi_math::GaussElimination(A, b, n);
+                   DoNotOptimize(b.data());
+                 });
+
+    constexpr int num_lanes = 8;
+    std::vector<double> A_lanes_ref(n * n * num_lanes);
+    std::vector<double> b_lanes_ref(n * num_lanes, 1.0);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        for (int lane = 0; lane < num_lanes; ++lane)
+          A_lanes_ref[(i * n + j) * num_lanes + lane] = A_ref[i][j];
+
+    std::vector<double> A_lanes, b_lanes;
+    std::vector<double> lane_scratch(num_lanes);
+    RunBenchmark("GaussEliminationBatched/nodes:" + std::to_string(n) +
+                   "/lanes:" + std::to_string(num_lanes),
+                 [&]()
+                 {
+                   A_lanes = A_lanes_ref;
+                   b_lanes = b_lanes_ref;
+                   chi_math::GaussEliminationBatched(A_lanes.data(),
+                                                     b_lanes.data(),
+                                                     lane_scratch.data(),
+                                                     n,
+                                                     num_lanes);
+                   DoNotOptimize(b_lanes.data());
+                 },
+                 /*items_per_iteration=*/num_lanes);
+  }
+
+  //============================================= Sparse matrix rows
+  // A 7-point stencil, i.e., the pattern of a finite volume discretization
+  // on a 3D orthogonal grid, iterated by row with the entry references and
+  // with the compressed row views.
+  {
+    const size_t N = 32;
+    const size_t num_rows = N * N * N;
+    chi_math::SparseMatrix matrix(num_rows, num_rows);
+    const int64_t strides[] = {1, static_cast<int64_t>(N),
+                               static_cast<int64_t>(N * N)};
+    for (size_t i = 0; i < num_rows; ++i)
+    {
+      matrix.Insert(i, i, 6.0);
+      for (const int64_t stride : strides)
+      {
+        const auto j = static_cast<int64_t>(i);
+        if (j - stride >= 0) matrix.Insert(i, j - stride, -1.0);
+        if (j + stride < static_cast<int64_t>(num_rows))
+          matrix.Insert(i, j + stride, -1.0);
+      }
+    }
+
+    size_t num_entries = 0;
+    for (size_t i = 0; i < num_rows; ++i)
+      num_entries += matrix.rowI_indices_[i].size();
+
+    const auto& const_matrix = matrix;
+    RunBenchmark("SparseMatrix/Row/rows:" + std::to_string(num_rows),
+                 [&]()
+                 {
+                   double sum = 0.0;
+                   for (size_t i = 0; i < num_rows; ++i)
+                     for (const auto& entry : const_matrix.Row(i))
+                       sum += entry.value * entry.column_index;
+                   DoNotOptimize(sum);
+                 },
+                 static_cast<double>(num_entries));
+
+    matrix.Compress();
+    RunBenchmark("SparseMatrix/RowSpan/rows:" + std::to_string(num_rows),
+                 [&]()
+                 {
+                   double sum = 0.0;
+                   for (size_t i = 0; i < num_rows; ++i)
+                   {
+                     const auto row = const_matrix.RowSpan(i);
+                     for (size_t k = 0; k < row.size; ++k)
+                       sum += row.values[k] * row.column_indices[k];
+                   }
+                   DoNotOptimize(sum);
+                 },
+                 static_cast<double>(num_entries));
+  }
+
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests::benchmarks
@@ -0,0 +1,149 @@
+#include "chi_benchmark.h"
+
+#include "mesh/MeshHandler/chi_meshhandler.h"
+#include "mesh/MeshContinuum/chi_meshcontinuum.h"
+
+#include "math/SpatialDiscretization/FiniteVolume/fv.h"
+#include "math/VectorGhostCommunicator/vector_ghost_communicator.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "console/chi_console.h"
+
+namespace chi_unit_tests::benchmarks
+{
+
+chi::ParameterBlock BenchmarkMesh(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/BenchmarkMesh,
+                        /*syntax_function=*/nullptr,
+                        /*actual_function=*/BenchmarkMesh);
+
+/**Benchmarks, on the current grid, the global-id cell lookups, the point
+ * location used by the field function interpolations and the ghost
+ * communication of a finite volume vector. The names are suffixed with the
+ * type of the first local cell.*/
+chi::ParameterBlock BenchmarkMesh(const chi::InputParameters&)
+{
+  const auto grid_ptr = chi_mesh::GetCurrentHandler().GetGrid();
+  const auto& grid = *grid_ptr;
+
+  ChiLogicalErrorIf(grid.local_cells.size() == 0,
+                    "Every location needs local cells.");
+  const std::string suffix =
+    "/" + chi_mesh::CellTypeName(grid.local_cells[0].Type());
+
+  //============================================= Global id lookups
+  std::vector<uint64_t> local_ids;
+  std::vector<uint64_t> neighbor_ids;
+  std::vector<chi_mesh::Vector3> centroids;
+  for (const auto& cell : grid.local_cells)
+  {
+    local_ids.push_back(cell.global_id_);
+    centroids.push_back(cell.centroid_);
+    for (const auto& face : cell.faces_)
+      if (face.has_neighbor_) neighbor_ids.push_back(face.neighbor_id_);
+  }
+
+  RunBenchmark("MeshContinuum/cells[local global_id]" + suffix,
+               [&]()
+               {
+                 double sum = 0.0;
+                 for (const uint64_t global_id : local_ids)
+                   sum += grid.cells[global_id].centroid_.x;
+                 DoNotOptimize(sum);
+               },
+               static_cast<double>(local_ids.size()));
+
+  RunBenchmark("MeshContinuum/cells[neighbor global_id]" + suffix,
+               [&]()
+               {
+                 double sum = 0.0;
+                 for (const uint64_t global_id : neighbor_ids)
+                   sum += grid.cells[global_id].centroid_.x;
+                 DoNotOptimize(sum);
+               },
+               static_cast<double>(neighbor_ids.size()));
+
+  RunBenchmark("MeshContinuum/MapCellGlobalID2LocalID" + suffix,
+               [&]()
+               {
+                 size_t sum = 0;
+                 for (const uint64_t global_id : local_ids)
+                   sum += grid.MapCellGlobalID2LocalID(global_id);
+                 DoNotOptimize(sum);
+               },
+               static_cast<double>(local_ids.size()));
+
+  //============================================= Point location
+  // The local cell of every local centroid, then, collectively, the cells
+  // of a lattice of points spanning the domain, as located by the point
+  // and line interpolations.
+  RunBenchmark("MeshContinuum/FindLocalCellsContainingPoints" + suffix,
+               [&]()
+               {
+                 const auto cell_ids =
+                   grid.FindLocalCellsContainingPoints(centroids);
+                 DoNotOptimize(cell_ids.data());
+               },
+               static_cast<double>(centroids.size()));
+
+  {
+    const auto [local_min, local_max] = grid.GetLocalBoundingBox();
+    double xyz_min[] = {local_min.x, local_min.y, local_min.z};
+    double xyz_max[] = {local_max.x, local_max.y, local_max.z};
+    MPI_Allreduce(MPI_IN_PLACE, xyz_min, 3, MPI_DOUBLE, MPI_MIN,
+                  Chi::mpi.comm);
+    MPI_Allreduce(MPI_IN_PLACE, xyz_max, 3, MPI_DOUBLE, MPI_MAX,
+                  Chi::mpi.comm);
+
+    const size_t N = 8;
+    std::vector<chi_mesh::Vector3> points;
+    for (size_t i = 0; i < N; ++i)
+      for (size_t j = 0; j < N; ++j)
+        for (size_t k = 0; k < N; ++k)
+        {
+          const double f[] = {(i + 0.5) / N, (j + 0.5) / N, (k + 0.5) / N};
+          double xyz[3];
+          for (int d = 0; d < 3; ++d)
+            xyz[d] = xyz_min[d] + f[d] * (xyz_max[d] - xyz_min[d]);
+          points.emplace_back(xyz[0], xyz[1], xyz[2]);
+        }
+
+    RunBenchmark("MeshContinuum/FindCellsContainingPoints" + suffix,
+                 [&]()
+                 {
+                   const auto cell_ids =
+                     grid.FindCellsContainingPoints(points);
+                   DoNotOptimize(cell_ids.data());
+                 },
+                 static_cast<double>(points.size()));
+  }
+
+  //============================================= Ghost communication
+  {
+    const auto sdm_ptr = chi_math::SpatialDiscretization_FV::New(grid);
+    const auto& sdm = *sdm_ptr;
+    const auto& uk_man = sdm.UNITARY_UNKNOWN_MANAGER;
+
+    const chi_math::VectorGhostCommunicator vgc(sdm.GetNumLocalDOFs(uk_man),
+                                                sdm.GetNumGlobalDOFs(uk_man),
+                                                sdm.GetGhostDOFIndices(uk_man),
+                                                Chi::mpi.comm);
+    auto ghosted_vector = vgc.MakeGhostedVector();
+
+    RunBenchmark("VectorGhostCommunicator/CommunicateGhostEntries" + suffix,
+                 [&]()
+                 {
+                   vgc.CommunicateGhostEntries(ghosted_vector);
+                   DoNotOptimize(ghosted_vector.data());
+                 });
+  }
+
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests::benchmarks
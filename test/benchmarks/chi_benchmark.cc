@@ -0,0 +1,175 @@
+#include "chi_benchmark.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+#include "console/chi_console.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+
+namespace chi_unit_tests::benchmarks
+{
+
+namespace
+{
+std::vector<BenchmarkResult> results_;
+
+/**Executes the kernel the given number of times and returns the duration,
+ * in seconds, of the slowest location.*/
+double TimeIterations(const std::function<void()>& kernel, size_t iterations)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  MPI_Barrier(Chi::mpi.comm);
+  const auto start = Clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    kernel();
+  const double local_duration =
+    std::chrono::duration<double>(Clock::now() - start).count();
+
+  double duration = 0.0;
+  MPI_Allreduce(&local_duration, &duration, 1, MPI_DOUBLE, MPI_MAX,
+                Chi::mpi.comm);
+  return duration;
+}
+
+/**Escapes a string for JSON.*/
+std::string JSONEscaped(const std::string& text)
+{
+  std::string escaped;
+  for (const char c : text)
+  {
+    if (c == '"' or c == '\\') escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+} // namespace
+
+// ###################################################################
+BenchmarkResult RunBenchmark(const std::string& name,
+                             const std::function<void()>& kernel,
+                             double items_per_iteration,
+                             double min_time,
+                             size_t repetitions)
+{
+  //============================================= Warm up and size the batch
+  kernel();
+  size_t iterations = 1;
+  while (TimeIterations(kernel, iterations) < min_time)
+    iterations *= 2;
+
+  //============================================= Time the repetitions
+  std::vector<double> times;
+  times.reserve(repetitions);
+  for (size_t r = 0; r < std::max<size_t>(repetitions, 1); ++r)
+    times.push_back(1.0e9 * TimeIterations(kernel, iterations) /
+                    static_cast<double>(iterations));
+  std::sort(times.begin(), times.end());
+
+  BenchmarkResult result;
+  result.name = name;
+  result.iterations = iterations;
+  result.repetitions = times.size();
+  result.real_time_min = times.front();
+  result.real_time_median = times[times.size() / 2];
+  result.real_time_max = times.back();
+  result.items_per_iteration = items_per_iteration;
+
+  Chi::log.Log() << std::left << std::setw(48) << name << std::right
+                 << std::setw(14) << std::setprecision(6)
+                 << result.real_time_median << " ns " << std::setw(12)
+                 << iterations << " iterations";
+
+  results_.push_back(result);
+  return result;
+}
+
+// ###################################################################
+const std::vector<BenchmarkResult>& GetBenchmarkResults() { return results_; }
+
+// ###################################################################
+void WriteBenchmarkResults(const std::string& file_name)
+{
+  if (Chi::mpi.location_id == 0)
+  {
+    std::ofstream file(file_name);
+    ChiLogicalErrorIf(not file.is_open(),
+                      "Failed to open \"" + file_name + "\".");
+
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%FT%T%z", std::localtime(&now));
+
+    file << "{\n"
+         << "  \"context\": {\n"
+         << "    \"date\": \"" << date << "\",\n"
+         << "    \"executable\": \"ChiTech\",\n"
+         << "    \"num_locations\": " << Chi::mpi.process_count << "\n"
+         << "  },\n"
+         << "  \"benchmarks\": [";
+    file << std::setprecision(10);
+    for (size_t b = 0; b < results_.size(); ++b)
+    {
+      const auto& result = results_[b];
+      const double items_per_second =
+        result.items_per_iteration / (1.0e-9 * result.real_time_median);
+
+      file << (b == 0 ? "\n" : ",\n") << "    {\n"
+           << "      \"name\": \"" << JSONEscaped(result.name) << "\",\n"
+           << "      \"run_name\": \"" << JSONEscaped(result.name) << "\",\n"
+           << "      \"run_type\": \"iteration\",\n"
+           << "      \"repetitions\": " << result.repetitions << ",\n"
+           << "      \"iterations\": " << result.iterations << ",\n"
+           << "      \"real_time\": " << result.real_time_median << ",\n"
+           << "      \"cpu_time\": " << result.real_time_median << ",\n"
+           << "      \"real_time_min\": " << result.real_time_min << ",\n"
+           << "      \"real_time_max\": " << result.real_time_max << ",\n"
+           << "      \"time_unit\": \"ns\",\n"
+           << "      \"items_per_second\": " << items_per_second << "\n"
+           << "    }";
+    }
+    file << "\n  ]\n}\n";
+  }
+
+  results_.clear();
+  MPI_Barrier(Chi::mpi.comm);
+}
+
+// ###################################################################
+chi::InputParameters WriteBenchmarkResultsSyntax();
+chi::ParameterBlock
+LuaWriteBenchmarkResults(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_in_lua=*/chi_unit_tests,
+                        /*name_in_lua=*/WriteBenchmarkResults,
+                        /*syntax_function=*/WriteBenchmarkResultsSyntax,
+                        /*actual_function=*/LuaWriteBenchmarkResults);
+
+chi::InputParameters WriteBenchmarkResultsSyntax()
+{
+  chi::InputParameters params;
+
+  params.SetGeneralDescription(
+    "Writes the benchmark results recorded so far, in the JSON format of "
+    "Google Benchmark.");
+
+  params.AddRequiredParameter<std::string>("arg0", "Name of the file.");
+
+  return params;
+}
+
+chi::ParameterBlock
+LuaWriteBenchmarkResults(const chi::InputParameters& params)
+{
+  WriteBenchmarkResults(params.GetParamValue<std::string>("arg0"));
+
+  return chi::ParameterBlock(); // Return empty param block
+}
+
+} // namespace chi_unit_tests::benchmarks
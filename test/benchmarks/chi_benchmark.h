@@ -0,0 +1,57 @@
+#ifndef CHITECH_CHI_BENCHMARK_H
+#define CHITECH_CHI_BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chi_unit_tests::benchmarks
+{
+
+/**The timing of a benchmark, the times being in nanoseconds per
+ * iteration and the maximum over all the locations.*/
+struct BenchmarkResult
+{
+  std::string name;
+  size_t iterations = 0;
+  size_t repetitions = 0;
+  double real_time_min = 0.0;
+  double real_time_median = 0.0;
+  double real_time_max = 0.0;
+  /**Items, e.g., cells or matrix entries, processed per iteration.*/
+  double items_per_iteration = 0.0;
+};
+
+/**Times the kernel.
+ *
+ * The number of iterations is doubled from one until a batch of iterations
+ * takes at least min_time seconds, after which the batch is timed the given
+ * number of repetitions. Every decision uses the slowest location, hence
+ * all the locations execute the same iterations, which allows collective
+ * kernels, and the result is recorded for WriteBenchmarkResults.
+ * Collective.*/
+BenchmarkResult RunBenchmark(const std::string& name,
+                             const std::function<void()>& kernel,
+                             double items_per_iteration = 1.0,
+                             double min_time = 0.1,
+                             size_t repetitions = 5);
+
+/**Returns the results recorded so far.*/
+const std::vector<BenchmarkResult>& GetBenchmarkResults();
+
+/**Writes the recorded results from location 0, in the JSON format of
+ * Google Benchmark such that its comparison tools apply, then forgets
+ * them. Collective.*/
+void WriteBenchmarkResults(const std::string& file_name);
+
+/**Prevents the compiler from optimizing away the computation of value.*/
+template <typename T>
+void DoNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace chi_unit_tests::benchmarks
+
+#endif // CHITECH_CHI_BENCHMARK_H
@@ -398,6 +398,43 @@ chi_data_types_Test00(const chi::InputParameters&)
     dummy << "Done10\n";
   }
 
+  // alignment, views, slices and wrapped vectors
+  {
+    chi_data_types::NDArray<double> nd_array5(std::vector<size_t>{2, 3});
+    double value = 0.0;
+    for (auto& val : nd_array5)
+      val = value++;
+
+    const auto address = reinterpret_cast<uintptr_t>(nd_array5.data());
+    dummy << "aligned "
+          << (address % chi_data_types::NDArray<double>::ALIGNMENT == 0)
+          << "\n";
+
+    const auto view = nd_array5.View();
+    const auto row = view.Slice(1);
+    const auto column = view.Slice(1, 2);
+    dummy << "Should be 3 4 5 and 2 5\n";
+    for (size_t j = 0; j < row.dimension(0); ++j)
+      dummy << row(j) << " ";
+    for (size_t i = 0; i < column.dimension(0); ++i)
+      dummy << column(i) << " ";
+    dummy << "\n";
+
+    const auto sub_view = view.SubView(1, 0, 2, 2);
+    sub_view.set(-1.0);
+    dummy << "Should be -1 1 -1 -1 4 -1, contiguous 1 0\n";
+    for (auto val : nd_array5)
+      dummy << val << " ";
+    dummy << view.IsContiguous() << " " << sub_view.IsContiguous() << "\n";
+
+    std::vector<double> vector = {1.0, 2.0, 3.0, 4.0};
+    chi_data_types::NDArrayView<double> vector_view(vector,
+                                                    std::vector<size_t>{2, 2});
+    vector_view(1, 0) = 7.0;
+    dummy << "Should be 7\n" << vector[2] << "\n";
+    dummy << "Done11\n";
+  }
+
   Chi::log.Log() << dummy.str();
 
   Chi::log.Log() << "GOLD_END";
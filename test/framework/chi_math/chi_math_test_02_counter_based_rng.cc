@@ -0,0 +1,145 @@
+#include "math/RandomNumberGeneration/counter_based_rng.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "console/chi_console.h"
+
+#include <iomanip>
+#include <sstream>
+
+namespace chi_unit_tests
+{
+
+chi::ParameterBlock
+chi_math_Test02_CounterBasedRNG(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/chi_math_Test02_CounterBasedRNG,
+                        /*syntax_function=*/nullptr,
+                        /*actual_function=*/chi_math_Test02_CounterBasedRNG);
+
+namespace
+{
+const char* PassFail(bool passed) { return passed ? "PASSED" : "FAILED"; }
+
+/**Logs the bijection of a counter and key next to its known answer.*/
+void CheckKnownAnswer(const std::string& name,
+                      const chi_math::CounterBasedRNG::Block& counter,
+                      const chi_math::CounterBasedRNG::Key& key,
+                      const chi_math::CounterBasedRNG::Block& known_answer)
+{
+  const auto block = chi_math::CounterBasedRNG::Philox(counter, key);
+
+  std::stringstream outstr;
+  outstr << "Philox4x32-10 " << name << ":" << std::hex << std::setfill('0');
+  for (const uint32_t word : block)
+    outstr << " " << std::setw(8) << word;
+  outstr << " " << PassFail(block == known_answer);
+
+  Chi::log.Log() << outstr.str();
+}
+} // namespace
+
+chi::ParameterBlock
+chi_math_Test02_CounterBasedRNG(const chi::InputParameters&)
+{
+  Chi::log.Log() << "GOLD_BEGIN";
+  Chi::log.Log() << "Testing chi_math::CounterBasedRNG";
+
+  //======================================================= Known answers
+  // Known-answer vectors of Random123 (kat_vectors), 10 rounds
+  CheckKnownAnswer("zeros",
+                   {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                   {0x00000000, 0x00000000},
+                   {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+  CheckKnownAnswer("ones",
+                   {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                   {0xffffffff, 0xffffffff},
+                   {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+  CheckKnownAnswer("pi",
+                   {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                   {0xa4093822, 0x299f31d0},
+                   {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+
+  //======================================================= Sequential
+  //                                                        reference
+  const uint64_t seed = 0x0123456789abcdef;
+  const uint64_t stream = 42;
+  const size_t num_values = 11;
+
+  chi_math::CounterBasedRNG rng(seed, stream);
+  std::vector<double> sequence(num_values);
+  bool in_range = true;
+  for (double& value : sequence)
+  {
+    value = rng.Rand();
+    in_range = in_range and value >= 0.0 and value < 1.0;
+  }
+  Chi::log.Log() << "Rand in [0,1): " << PassFail(in_range);
+
+  //======================================================= Fill
+  {
+    chi_math::CounterBasedRNG fill_rng(seed, stream);
+    std::vector<double> values(num_values);
+    fill_rng.Fill(values);
+    Chi::log.Log() << "Fill from the start agrees with Rand: "
+                   << PassFail(values == sequence and
+                               fill_rng.Position() == num_values);
+  }
+  {
+    // Starts in the second half of a block and ends in the first half
+    chi_math::CounterBasedRNG fill_rng(seed, stream);
+    fill_rng.Rand();
+    std::vector<double> values(7);
+    fill_rng.Fill(values);
+    const std::vector<double> expected(sequence.begin() + 1,
+                                       sequence.begin() + 8);
+    const bool next_agrees = fill_rng.Rand() == sequence[8];
+    Chi::log.Log() << "Fill from an odd position agrees with Rand: "
+                   << PassFail(values == expected and next_agrees);
+  }
+
+  //======================================================= SetPosition
+  {
+    chi_math::CounterBasedRNG position_rng(seed, stream);
+    bool agrees = true;
+    for (size_t k = num_values; k-- > 0;)
+    {
+      position_rng.SetPosition(k);
+      agrees = agrees and position_rng.Rand() == sequence[k];
+    }
+    position_rng.SetPosition(0);
+    std::vector<double> values(num_values);
+    position_rng.Fill(values);
+    Chi::log.Log() << "SetPosition agrees with Rand: "
+                   << PassFail(agrees and values == sequence);
+  }
+
+  //======================================================= Uniform
+  {
+    bool agrees = true;
+    for (size_t k = 0; k < num_values; ++k)
+      agrees = agrees and chi_math::CounterBasedRNG::Uniform(
+                            seed, stream, k) == sequence[k];
+    Chi::log.Log() << "Uniform agrees with Rand: " << PassFail(agrees);
+  }
+
+  //======================================================= Streams
+  {
+    chi_math::CounterBasedRNG other_rng(seed, stream + 1);
+    bool differs = true;
+    for (const double value : sequence)
+      differs = differs and other_rng.Rand() != value;
+
+    rng.SetStream(stream);
+    const bool restarts = rng.Position() == 0 and rng.Rand() == sequence[0];
+    Chi::log.Log() << "Streams are distinct and restartable: "
+                   << PassFail(differs and restarts);
+  }
+
+  Chi::log.Log() << "GOLD_END";
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests
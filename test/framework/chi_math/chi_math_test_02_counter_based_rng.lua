@@ -0,0 +1 @@
+chi_unit_tests.chi_math_Test02_CounterBasedRNG()
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "math/chi_math.h"
+#include "math/Statistics/alias_sampler.h"
+#include "math/Statistics/cdfsampler.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+
+#include "console/chi_console.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace chi_unit_tests
+{
+
+chi::ParameterBlock
+chi_math_Test03_AliasSampler(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/chi_math_Test03_AliasSampler,
+                        /*syntax_function=*/nullptr,
+                        /*actual_function=*/chi_math_Test03_AliasSampler);
+
+namespace
+{
+const char* PassFail(bool passed) { return passed ? "PASSED" : "FAILED"; }
+
+/**The probability of every bin implied by the tables, i.e., its own
+ * acceptance plus the rejected mass of the bins it is the alias of, over
+ * the number of bins.*/
+std::vector<double> TableProbabilities(const chi_math::AliasSampler& sampler)
+{
+  const size_t num_bins = sampler.NumBins();
+  std::vector<double> mass(num_bins, 0.0);
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    mass[i] += sampler.Acceptance(i);
+    mass[static_cast<size_t>(sampler.Alias(i))] += 1.0 - sampler.Acceptance(i);
+  }
+  for (double& value : mass)
+    value /= static_cast<double>(num_bins);
+  return mass;
+}
+
+/**Checks that the tables of a PDF reproduce it to round-off, zero bins
+ * exactly, that the frequencies sampled on a uniform grid follow it, and
+ * that the sampler of its CDF has the bins of chi_math::CDFSampler, i.e.,
+ * bins of the widths of the CDF differences that bracket the points just
+ * below their upper edges.*/
+void CheckPDF(const std::string& name, const std::vector<double>& pdf)
+{
+  const size_t num_bins = pdf.size();
+  double total = 0.0;
+  for (const double p : pdf)
+    total += p;
+
+  std::vector<double> normalized_pdf(num_bins);
+  std::vector<double> cdf(num_bins);
+  double cumulative = 0.0;
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    normalized_pdf[i] = pdf[i] / total;
+    cumulative += normalized_pdf[i];
+    cdf[i] = cumulative;
+  }
+  cdf.back() = 1.0;
+
+  //=================================== Tables
+  const chi_math::AliasSampler sampler(pdf);
+  bool reproduces = sampler.NumBins() == num_bins;
+  const auto table_pdf = TableProbabilities(sampler);
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    bool valid_entry = sampler.Acceptance(i) >= 0.0 and
+                       sampler.Acceptance(i) <= 1.0 and
+                       sampler.Alias(i) >= 0 and
+                       sampler.Alias(i) < static_cast<int>(num_bins);
+    if (pdf[i] == 0.0)
+      reproduces = reproduces and valid_entry and table_pdf[i] == 0.0;
+    else
+      reproduces = reproduces and valid_entry and
+                   std::fabs(table_pdf[i] - normalized_pdf[i]) <=
+                     1.0e-14 * normalized_pdf[i] + 1.0e-15;
+  }
+  Chi::log.Log() << name << ": tables reproduce the PDF "
+                 << PassFail(reproduces);
+
+  //=================================== Sampled frequencies
+  const size_t num_samples = 100000 * num_bins;
+  std::vector<double> x(num_samples);
+  for (size_t k = 0; k < num_samples; ++k)
+    x[k] = (static_cast<double>(k) + 0.5) / static_cast<double>(num_samples);
+  std::vector<int> bins;
+  sampler.Sample(x, bins);
+
+  std::vector<size_t> counts(num_bins, 0);
+  for (const int bin : bins)
+    ++counts[bin];
+  bool follows = true;
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    const double frequency =
+      static_cast<double>(counts[i]) / static_cast<double>(num_samples);
+    if (pdf[i] == 0.0)
+      follows = follows and counts[i] == 0;
+    else
+      follows = follows and std::fabs(frequency - normalized_pdf[i]) <=
+                              2.0 * num_bins / static_cast<double>(num_samples);
+  }
+  Chi::log.Log() << name << ": sampled frequencies follow the PDF "
+                 << PassFail(follows);
+
+  //=================================== FromCDF against CDFSampler
+  const auto cdf_sampler_alias = chi_math::AliasSampler::FromCDF(cdf);
+  const auto cdf_table_pdf = TableProbabilities(cdf_sampler_alias);
+  chi_math::CDFSampler cdf_sampler(cdf);
+  bool agrees = cdf_sampler_alias.NumBins() == num_bins;
+  double lower_edge = 0.0;
+  for (size_t i = 0; i < num_bins; ++i)
+  {
+    const double upper_edge = cdf[i];
+    const double width = upper_edge - lower_edge;
+    agrees = agrees and std::fabs(cdf_table_pdf[i] - width) <= 1.0e-14;
+    if (width > 0.0)
+      agrees = agrees and
+               cdf_sampler.Sample(0.5 * (lower_edge + upper_edge)) ==
+                 static_cast<int>(i) and
+               cdf_sampler.Sample(std::nextafter(upper_edge, 0.0)) ==
+                 static_cast<int>(i);
+    lower_edge = upper_edge;
+  }
+  Chi::log.Log() << name << ": FromCDF has the bins of CDFSampler "
+                 << PassFail(agrees);
+}
+
+/**Determines whether the sampler rejects the probabilities.*/
+bool Rejects(const std::vector<double>& probabilities)
+{
+  try
+  {
+    chi_math::AliasSampler sampler(probabilities);
+  }
+  catch (const std::invalid_argument&)
+  {
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+chi::ParameterBlock
+chi_math_Test03_AliasSampler(const chi::InputParameters&)
+{
+  Chi::log.Log() << "GOLD_BEGIN";
+  Chi::log.Log() << "Testing chi_math::AliasSampler";
+
+  CheckPDF("four bins", {0.1, 0.2, 0.3, 0.4});
+  CheckPDF("single bin", {2.5});
+  CheckPDF("zero bins", {0.0, 0.5, 0.0, 0.25, 0.25, 0.0});
+  CheckPDF("unnormalized", {3.0, 1.0, 7.0, 2.0, 11.0});
+  CheckPDF("uniform", {1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0});
+
+  Chi::log.Log() << "Rejects empty, zero and negative PDFs "
+                 << PassFail(Rejects({}) and Rejects({0.0, 0.0}) and
+                             Rejects({0.5, -0.1, 0.6}));
+
+  Chi::log.Log() << "GOLD_END";
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests
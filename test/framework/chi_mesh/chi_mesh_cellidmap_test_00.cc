@@ -0,0 +1,72 @@
+#include "mesh/MeshContinuum/chi_meshcontinuum_cellidmap.h"
+
+#include "chi_runtime.h"
+#include "chi_log.h"
+#include "chi_log_exceptions.h"
+
+#include "console/chi_console.h"
+
+namespace chi_unit_tests
+{
+
+chi::ParameterBlock
+chi_mesh_CellIDMap_Test00(const chi::InputParameters& params);
+
+RegisterWrapperFunction(/*namespace_name=*/chi_unit_tests,
+                        /*name_in_lua=*/chi_mesh_CellIDMap_Test00,
+                        /*syntax_function=*/nullptr,
+                        /*actual_function=*/chi_mesh_CellIDMap_Test00);
+
+chi::ParameterBlock
+chi_mesh_CellIDMap_Test00(const chi::InputParameters&)
+{
+  Chi::log.Log() << "Testing chi_mesh::CellIDMap";
+
+  const uint64_t empty_key = std::numeric_limits<uint64_t>::max();
+  const uint64_t N = 1000;
+
+  chi_mesh::CellIDMap map;
+
+  //============================================= Look-ups in an empty map
+  ChiLogicalErrorIf(map.Contains(0) or map.Contains(empty_key),
+                    "Empty map contains a key.");
+
+  //============================================= Inserts with rehashes
+  for (uint64_t k = 0; k < N; ++k)
+    map.Insert(3 * k, k);
+  map.Insert(3, 7);
+
+  ChiLogicalErrorIf(map.Size() != N, "Wrong size.");
+  for (uint64_t k = 0; k < N; ++k)
+  {
+    const uint64_t value = k == 1 ? 7 : k;
+    ChiLogicalErrorIf(map.At(3 * k) != value,
+                      "Wrong value for key " + std::to_string(3 * k) + ".");
+    ChiLogicalErrorIf(map.Contains(3 * k + 1),
+                      "Absent key " + std::to_string(3 * k + 1) + " found.");
+  }
+
+  //============================================= The reserved empty key
+  ChiLogicalErrorIf(map.Contains(empty_key), "The empty key is found.");
+
+  bool at_threw = false;
+  try { map.At(empty_key); }
+  catch (const std::out_of_range&) { at_threw = true; }
+  ChiLogicalErrorIf(not at_threw, "At does not throw for the empty key.");
+
+  bool insert_threw = false;
+  try { map.Insert(empty_key, 1); }
+  catch (const std::invalid_argument&) { insert_threw = true; }
+  ChiLogicalErrorIf(not insert_threw,
+                    "Insert does not throw for the empty key.");
+
+  //============================================= Clear
+  map.Clear();
+  ChiLogicalErrorIf(map.Size() != 0 or map.Contains(0), "Clear failed.");
+
+  Chi::log.Log() << "CellIDMap tests passed";
+
+  return chi::ParameterBlock();
+}
+
+} // namespace chi_unit_tests
@@ -0,0 +1 @@
+chi_unit_tests.chi_mesh_CellIDMap_Test00()
@@ -0,0 +1,70 @@
+-- Benchmark: fixed source transport on an orthogonal cube of hexahedra,
+-- KBA partitioned into px*py columns.
+-- Inputs: nx, ny, nz global cells, px*py locations, num_groups,
+--         num_azimuthal, num_polar, scattering_order and num_iterations,
+--         the fixed number of within-group iterations.
+if (nx == nil) then nx = 16 end
+if (ny == nil) then ny = nx end
+if (nz == nil) then nz = nx end
+if (px == nil) then px = 1 end
+if (py == nil) then py = math.floor(chi_number_of_processes / px) end
+if (num_groups == nil) then num_groups = 16 end
+if (num_azimuthal == nil) then num_azimuthal = 8 end
+if (num_polar == nil) then num_polar = 4 end
+if (scattering_order == nil) then scattering_order = 1 end
+if (num_iterations == nil) then num_iterations = 5 end
+
+dofile("utils/benchmark_meshes.lua")
+
+--############################################### Setup mesh
+CreateKBACubeMesh(nx, ny, nz, px, py, 10.0)
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+chiPhysicsMaterialSetProperty(materials[1],
+                              TRANSPORT_XSECTIONS,
+                              SIMPLEXS1,num_groups,1.0,0.5)
+
+src={}
+for g=1,num_groups do
+  src[g] = 1.0
+end
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,
+                                    num_azimuthal, num_polar)
+
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_type = "single",
+      inner_linear_method = "richardson",
+      l_abs_tol = 1.0e-16,
+      l_max_its = num_iterations,
+    },
+  },
+  options =
+  {
+    scattering_order = scattering_order,
+    verbose_inner_iterations = true,
+  }
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+
+--############################################### Initialize and Execute Solver
+ss_solver = lbs.SteadyStateSolver.Create({lbs_solver_handle = phys1})
+
+chiSolverInitialize(ss_solver)
+chiSolverExecute(ss_solver)
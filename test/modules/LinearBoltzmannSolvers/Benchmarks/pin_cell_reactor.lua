@@ -0,0 +1,58 @@
+-- Benchmark: fixed source transport on an extruded unstructured pin cell,
+-- i.e., a reactor-like mesh of triangular prisms, partitioned with ParMETIS.
+-- Inputs: nz layers, num_azimuthal, num_polar, scattering_order and
+--         num_iterations, the fixed number of within-group iterations.
+if (nz == nil) then nz = 8 end
+if (num_azimuthal == nil) then num_azimuthal = 8 end
+if (num_polar == nil) then num_polar = 4 end
+if (scattering_order == nil) then scattering_order = 1 end
+if (num_iterations == nil) then num_iterations = 5 end
+
+dofile("utils/benchmark_meshes.lua")
+
+--############################################### Setup mesh
+CreatePinCellMesh(nz, 10.0)
+
+--############################################### Add materials
+dofile("utils/benchmark_materials.lua") --num_groups assigned here
+
+src={}
+for g=1,num_groups do
+  src[g] = 0.0
+end
+src[1] = 1.0
+chiPhysicsMaterialAddProperty(1,ISOTROPIC_MG_SOURCE)
+chiPhysicsMaterialSetProperty(1,ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,
+                                    num_azimuthal, num_polar)
+
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_type = "polar",
+      inner_linear_method = "richardson",
+      l_abs_tol = 1.0e-16,
+      l_max_its = num_iterations,
+    },
+  },
+  options =
+  {
+    scattering_order = scattering_order,
+    verbose_inner_iterations = true,
+  }
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+
+--############################################### Initialize and Execute Solver
+ss_solver = lbs.SteadyStateSolver.Create({lbs_solver_handle = phys1})
+
+chiSolverInitialize(ss_solver)
+chiSolverExecute(ss_solver)
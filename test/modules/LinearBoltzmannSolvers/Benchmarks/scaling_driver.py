@@ -0,0 +1,239 @@
+#!/usr/bin/env python3
+"""
+Runs weak and strong scaling series of the benchmark inputs in this folder
+and collects, per run, the wall time, initialization time, sweep time,
+iteration counts and memory into a CSV file.
+
+The times are read from the profiler report printed at the end of a run,
+i.e., the "Solver initialize" and "Sweep" regions, using the slowest
+location. The memory is the maximum, over the locations, of the process
+resident memory reported after the solver initialization.
+
+Under strong scaling the global problem is fixed. Under weak scaling the
+cube benchmarks grow in x and y with the KBA columns, px*py being the
+number of locations, and the pin cell grows in z with the number of
+locations.
+
+Example:
+    ./scaling_driver.py --exe ../../../bin/ChiTech_test -p 1 2 4 8
+"""
+import argparse
+import csv
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+if sys.version_info.major < 3:
+    raise Exception("Python version detected to be " +
+                    str(sys.version_info.major) + "." +
+                    str(sys.version_info.minor) +
+                    " but is required to >= 3")
+
+# Input file, how the problem grows under weak scaling, and the sizes of
+# the problem at one location.
+BENCHMARKS = {
+    "kba_cube": {"file": "kba_cube.lua", "grow": "xy",
+                 "size": {"nx": 16, "ny": 16, "nz": 16}},
+    "pin_cell_reactor": {"file": "pin_cell_reactor.lua", "grow": "z",
+                         "size": {"nz": 8}},
+    "keigen": {"file": "keigen.lua", "grow": "xy",
+               "size": {"nx": 16, "ny": 16, "nz": 16}},
+    "transient": {"file": "transient.lua", "grow": "xy",
+                  "size": {"nx": 16, "ny": 16, "nz": 16}},
+}
+
+CSV_FIELDS = ["benchmark", "mode", "num_procs", "px", "py", "nx", "ny", "nz",
+              "exit_code", "wall_time_s", "init_time_s", "sweep_time_s",
+              "num_sweeps", "wgs_iterations", "outer_iterations",
+              "max_resident_memory_mb", "efficiency"]
+
+
+def KBAColumns(num_procs: int):
+    """Returns the px, py, px <= py, of the most square KBA partition."""
+    px = int(math.sqrt(num_procs))
+    while num_procs % px != 0:
+        px -= 1
+    return px, num_procs // px
+
+
+def ProblemSizes(benchmark: dict, mode: str, num_procs: int,
+                 size_factor: int):
+    """Returns the Lua variables setting the problem size of a run."""
+    sizes = {k: v * size_factor for k, v in benchmark["size"].items()}
+    px, py = KBAColumns(num_procs)
+    if benchmark["grow"] == "xy":
+        sizes["px"] = px
+        sizes["py"] = py
+        if mode == "weak":
+            sizes["nx"] *= px
+            sizes["ny"] *= py
+    elif mode == "weak":
+        sizes["nz"] *= num_procs
+    return sizes
+
+
+def StripHeader(line: str):
+    """Removes the location header that the log prepends to lines."""
+    return re.sub(r"^\[\d+\]  ", "", line.rstrip("\n"))
+
+
+def ParseLog(output: str):
+    """Extracts the metrics of a run from its console output."""
+    metrics = {"init_time_s": None, "sweep_time_s": None, "num_sweeps": None,
+               "wgs_iterations": 0, "outer_iterations": 0,
+               "max_resident_memory_mb": None}
+
+    in_profiler_report = False
+    sweep_time = 0.0
+    num_sweeps = 0.0
+    found_sweep = False
+    for raw_line in output.splitlines():
+        line = StripHeader(raw_line)
+
+        if re.search(r"WGS groups \[\d+-\d+\] Iteration\s+\d+", line):
+            metrics["wgs_iterations"] += 1
+        if re.search(r"Iteration\s+\d+\s+k_eff", line):
+            metrics["outer_iterations"] += 1
+
+        words = line.split()
+        if line.startswith("Process resident") and len(words) >= 5:
+            # Name, then min, average, max, location of the max and total
+            metrics["max_resident_memory_mb"] = float(words[4])
+
+        if line.startswith("Profiler report over"):
+            in_profiler_report = True
+            continue
+        if in_profiler_report:
+            if line.startswith("Final program time"):
+                in_profiler_report = False
+                continue
+            # Region name in 40 columns, then calls, min, max and mean
+            name = line[:40].strip()
+            values = line[40:].split()
+            try:
+                calls, max_time = float(values[0]), float(values[2])
+            except (IndexError, ValueError):
+                continue
+            if name == "Solver initialize":
+                metrics["init_time_s"] = max_time
+            elif name == "Sweep":
+                sweep_time += max_time
+                num_sweeps += calls
+                found_sweep = True
+
+    if found_sweep:
+        metrics["sweep_time_s"] = sweep_time
+        metrics["num_sweeps"] = int(round(num_sweeps))
+    return metrics
+
+
+def Run(argv, name: str, mode: str, num_procs: int):
+    """Runs one benchmark and returns its row for the CSV file."""
+    benchmark = BENCHMARKS[name]
+    sizes = ProblemSizes(benchmark, mode, num_procs, argv.size_factor)
+
+    cmd = [argv.mpiexec, "-np", str(num_procs), argv.exe, benchmark["file"],
+           "--suppress_color"]
+    cmd += [f"{k}={v}" for k, v in sizes.items()]
+    cmd += argv.lua_args
+
+    print("Running " + " ".join(cmd), flush=True)
+    time_start = time.perf_counter()
+    process = subprocess.run(cmd,
+                             cwd=os.path.dirname(os.path.abspath(__file__)),
+                             stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT,
+                             universal_newlines=True)
+    wall_time = time.perf_counter() - time_start
+
+    if argv.log_dir:
+        os.makedirs(argv.log_dir, exist_ok=True)
+        log_name = f"{name}_{mode}_{num_procs}.log"
+        with open(os.path.join(argv.log_dir, log_name), "w") as file:
+            file.write(process.stdout)
+
+    row = {"benchmark": name, "mode": mode, "num_procs": num_procs,
+           "px": sizes.get("px", ""), "py": sizes.get("py", ""),
+           "nx": sizes.get("nx", ""), "ny": sizes.get("ny", ""),
+           "nz": sizes.get("nz", ""), "exit_code": process.returncode,
+           "wall_time_s": round(wall_time, 3)}
+    row.update(ParseLog(process.stdout))
+    if process.returncode != 0:
+        print(f"  failed with exit code {process.returncode}")
+    return row
+
+
+def AddEfficiencies(rows: list):
+    """Computes the parallel efficiency of the sweep time, relative to the
+    run with the fewest locations of each series, i.e., T0 P0/(T P) under
+    strong scaling and T0/T under weak scaling."""
+    series = {}
+    for row in rows:
+        series.setdefault((row["benchmark"], row["mode"]), []).append(row)
+
+    for (_, mode), series_rows in series.items():
+        reference = min(series_rows, key=lambda r: r["num_procs"])
+        t0 = reference["sweep_time_s"]
+        p0 = reference["num_procs"]
+        for row in series_rows:
+            t = row["sweep_time_s"]
+            row["efficiency"] = ""
+            if not t0 or not t:
+                continue
+            if mode == "strong":
+                row["efficiency"] = round(t0 * p0 / (t * row["num_procs"]), 4)
+            else:
+                row["efficiency"] = round(t0 / t, 4)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Runs scaling series of the transport benchmarks.")
+    parser.add_argument("--exe", default="../../../bin/ChiTech_test",
+                        help="The executable to benchmark")
+    parser.add_argument("--mpiexec", default="mpiexec",
+                        help="The MPI launcher")
+    parser.add_argument("-p", "--procs", nargs="+", type=int,
+                        default=[1, 2, 4],
+                        help="The numbers of locations of the series")
+    parser.add_argument("-m", "--modes", nargs="+", default=["strong", "weak"],
+                        choices=["strong", "weak"],
+                        help="The scaling series to run")
+    parser.add_argument("-b", "--benchmarks", nargs="+",
+                        default=list(BENCHMARKS.keys()),
+                        choices=list(BENCHMARKS.keys()),
+                        help="The benchmarks to run")
+    parser.add_argument("-s", "--size_factor", type=int, default=1,
+                        help="Multiplies the cell counts of the base sizes")
+    parser.add_argument("-o", "--output", default="scaling_results.csv",
+                        help="The CSV file to write")
+    parser.add_argument("--log_dir", default=None,
+                        help="If given, the console output of every run is "
+                             "written to this folder")
+    parser.add_argument("lua_args", nargs="*",
+                        help="Further Lua variables, e.g., num_groups=32")
+    argv = parser.parse_args()
+
+    argv.exe = os.path.abspath(argv.exe)
+
+    rows = []
+    for name in argv.benchmarks:
+        for mode in argv.modes:
+            for num_procs in sorted(argv.procs):
+                rows.append(Run(argv, name, mode, num_procs))
+    AddEfficiencies(rows)
+
+    with open(argv.output, "w", newline="") as file:
+        writer = csv.DictWriter(file, fieldnames=CSV_FIELDS)
+        writer.writeheader()
+        writer.writerows(rows)
+    print("Results written to " + argv.output)
+
+    return 0 if all(row["exit_code"] == 0 for row in rows) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
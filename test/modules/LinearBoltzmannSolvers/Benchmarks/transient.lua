@@ -0,0 +1,73 @@
+-- Benchmark: quasi-static transient on the geometry of keigen.lua. Every
+-- time step changes the fuel density, updates the cross sections of the
+-- solver and re-solves the k-eigenvalue problem from the previous
+-- solution, which is the work of a time step of a thermal feedback loop.
+-- Inputs: those of keigen.lua, num_steps and num_outer_iterations, the
+--         fixed number of power iterations per step.
+if (num_steps == nil) then num_steps = 5 end
+if (nx == nil) then nx = 16 end
+if (ny == nil) then ny = nx end
+if (nz == nil) then nz = nx end
+if (px == nil) then px = 1 end
+if (py == nil) then py = math.floor(chi_number_of_processes / px) end
+if (num_azimuthal == nil) then num_azimuthal = 8 end
+if (num_polar == nil) then num_polar = 4 end
+if (scattering_order == nil) then scattering_order = 1 end
+if (num_outer_iterations == nil) then num_outer_iterations = 5 end
+
+dofile("utils/benchmark_meshes.lua")
+
+--############################################### Setup mesh
+L = 14.0
+CreateKBACubeMesh(nx, ny, nz, px, py, L)
+
+fuel = chi_mesh.RPPLogicalVolume.Create(
+  { xmin=-1000.0, xmax=0.7*L, ymin=-1000.0, ymax=0.7*L, infz=true })
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,fuel,1)
+
+--############################################### Add materials
+dofile("utils/benchmark_materials.lua") --num_groups assigned here
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,
+                                    num_azimuthal, num_polar)
+
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_type = "single",
+      inner_linear_method = "gmres",
+      l_max_its = 50,
+      gmres_restart_interval = 50,
+      l_abs_tol = 1.0e-8,
+    }
+  },
+  options =
+  {
+    boundary_conditions = { { name = "xmin", type = "reflecting"},
+                            { name = "ymin", type = "reflecting"} },
+    scattering_order = scattering_order,
+    verbose_inner_iterations = true,
+    verbose_outer_iterations = true,
+  }
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+
+--############################################### Initialize and Execute Solver
+k_solver = lbs.XXPowerIterationKEigen.Create({ lbs_solver_handle = phys1,
+                                               max_iters = num_outer_iterations,
+                                               k_tol = 1.0e-16,
+                                               reset_solution = false })
+chiSolverInitialize(k_solver)
+
+for step=1,num_steps do
+  chiPhysicsTransportXSSetState(xs_fuel, 600.0, 1.0 - 0.01*step)
+  chiLBSUpdateCrossSections(phys1)
+  chiSolverExecute(k_solver)
+end
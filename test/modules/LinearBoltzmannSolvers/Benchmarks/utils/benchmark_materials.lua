@@ -0,0 +1,22 @@
+--############################################### Benchmark materials
+-- Creates material 0, water, and material 1, fuel, with the two group
+-- cross sections of the k-eigenvalue tests. The fuel cross section is made
+-- multi-state such that its density can be changed, e.g., by a transient.
+-- Sets num_groups, xs_water and xs_fuel.
+xs_water = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs_water,CHI_XSFILE,
+                         "../Transport_Keigen/xs_water_g2.cxs")
+local xs_fuel_table = chiPhysicsTransportXSCreate()
+chiPhysicsTransportXSSet(xs_fuel_table,CHI_XSFILE,
+                         "../Transport_Keigen/xs_fuel_g2.cxs")
+xs_fuel = chiPhysicsTransportXSCreateMultiState({{600.0, xs_fuel_table}})
+
+num_groups = chiPhysicsTransportXSGet(xs_water)["num_groups"]
+
+local xs = { xs_water, xs_fuel }
+for m=0,1 do
+  local material = chiPhysicsAddMaterial("Material_"..tostring(m))
+  chiPhysicsMaterialAddProperty(material,TRANSPORT_XSECTIONS)
+  chiPhysicsMaterialSetProperty(material,TRANSPORT_XSECTIONS,
+                                EXISTING,xs[m+1])
+end
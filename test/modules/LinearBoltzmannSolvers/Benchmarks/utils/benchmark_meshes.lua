@@ -0,0 +1,64 @@
+--############################################### Benchmark meshes
+-- Mesh builders shared by the benchmark inputs. The sizes are global, the
+-- scaling driver scaling them with the number of locations for weak
+-- scaling.
+
+--Creates a cube of side L with nx*ny*nz hexahedra, KBA partitioned into
+--px*py columns.
+function CreateKBACubeMesh(nx, ny, nz, px, py, L)
+  chiMeshHandlerCreate()
+
+  local function MakeNodes(n)
+    local nodes = {}
+    for i=1,(n+1) do
+      nodes[i] = (i-1)*L/n
+    end
+    return nodes
+  end
+  local function MakeCuts(p)
+    local cuts = {}
+    for i=1,(p-1) do
+      cuts[i] = i*L/p
+    end
+    return cuts
+  end
+
+  chiMeshCreateUnpartitioned3DOrthoMesh(MakeNodes(nx),
+                                        MakeNodes(ny),
+                                        MakeNodes(nz))
+
+  chiVolumeMesherSetProperty(PARTITION_TYPE,KBA_STYLE_XYZ)
+  if (px > 1) then chiVolumeMesherSetKBACutsX(MakeCuts(px)) end
+  if (py > 1) then chiVolumeMesherSetKBACutsY(MakeCuts(py)) end
+  chiVolumeMesherSetKBAPartitioningPxPyPz(px,py,1)
+
+  chiVolumeMesherExecute();
+
+  chiVolumeMesherSetMatIDToAll(0)
+end
+
+--Extrudes the unstructured triangulation of a pin cell into nz layers of
+--total height H, partitioned with ParMETIS. The cells within half a unit
+--of the axis get material 1, the fuel, the others material 0.
+function CreatePinCellMesh(nz, H)
+  chiMeshHandlerCreate()
+
+  local umesh = chiUnpartitionedMeshFromWavefrontOBJ(
+    "../../../framework/chi_mesh/ReactorPinMesh.obj")
+
+  chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+  chiVolumeMesherCreate(VOLUMEMESHER_EXTRUDER,
+                        ExtruderTemplateType.UNPARTITIONED_MESH,
+                        umesh);
+  chiVolumeMesherSetProperty(EXTRUSION_LAYER,H,nz,"Core");
+
+  chiVolumeMesherSetProperty(PARTITION_TYPE,PARMETIS)
+
+  chiSurfaceMesherExecute();
+  chiVolumeMesherExecute();
+
+  chiVolumeMesherSetMatIDToAll(0)
+  local fuel = chi_mesh.RPPLogicalVolume.Create(
+    { xmin=-0.5,xmax=0.5,ymin=-0.5,ymax=0.5, infz=true })
+  chiVolumeMesherSetProperty(MATID_FROMLOGICAL,fuel,1)
+end
@@ -5,7 +5,7 @@
 
 #include "A_LBSSolver/Acceleration/acceleration.h"
 #include "A_LBSSolver/Acceleration/diffusion_mip.h"
-#include "LinearBoltzmannSolvers/A_LBSSolver/lbs_structs.h"
+#include "LinearBoltzmannSolvers/A_LBSSolver/lbs_packed_unit_cell_matrices.h"
 
 #include "physics/FieldFunction/fieldfunction_gridbased.h"
 
@@ -156,12 +156,15 @@ acceleration_Diffusion_DFEM(const chi::InputParameters&)
   }//for cell
 
   //============================================= Make solver
+  const lbs::PackedUnitCellMatrices packed_unit_cell_matrices(
+    unit_cell_matrices);
+
   lbs::acceleration::DiffusionMIPSolver solver("SimTest92_DSA",
                                                sdm,
                                                OneDofPerNode,
                                                bcs,
                                                matid_2_xs_map,
-                                               unit_cell_matrices,
+                                               packed_unit_cell_matrices,
                                                true);
   solver.options.ref_solution_lua_function = "MMS_phi";
   solver.options.source_lua_function = "MMS_q";
@@ -0,0 +1,106 @@
+-- 1D 1G KEigenvalue::Solver test of the higher modes using Arnoldi
+-- The slab [0,L] is homogeneous and reflecting on both sides, such that the
+-- modes are cos(B_n x) with B_n = n pi/L. With the S_N quadrature
+-- {mu_m, w_m}, normalized to unit weight, the discrete ordinates
+-- k-eigenvalues are
+--   k_n = nu_sf Lambda_n / (1 - s_s Lambda_n),
+--   Lambda_n = sum_m w_m s_t / (s_t^2 + mu_m^2 B_n^2),
+-- with s_t = 1, s_s = 0.3 and nu_sf = 0.7. For L = 10 and S16:
+-- Test: Mode 0 k-eigenvalue: 1.0000000
+--       Mode 1 k-eigenvalue: 0.9561863
+--       Mode 2 k-eigenvalue: 0.8536241
+--       Mode 3 k-eigenvalue: 0.7391736
+-- The PWLD values with 100 cells differ from these by less than 3.0e-6.
+num_procs = 4
+
+--############################################### Check num_procs
+if (check_num_procs == nil and chi_number_of_processes ~= num_procs) then
+    chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+                      "Expected "..tostring(num_procs)..
+                      ". Pass check_num_procs=false to override if possible.")
+    os.exit(false)
+end
+
+-- ##################################################
+-- ##### Parameters #####
+-- ##################################################
+
+-- Mesh variables
+if (L == nil) then L = 10.0 end
+if (n_cells == nil) then n_cells = 100 end
+
+-- Transport angle information
+if (n_angles == nil) then n_angles = 16 end
+
+-- Source iteration parameters
+if (si_max_iterations == nil) then si_max_iterations = 500 end
+if (si_tolerance == nil) then si_tolerance = 1e-10 end
+
+-- ##################################################
+-- ##### Run problem #####
+-- ##################################################
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+nodes = {}
+dx = L/n_cells
+for i=0,n_cells do
+  nodes[i+1] = i*dx
+end
+chiMeshCreateUnpartitioned1DOrthoMesh(nodes)
+chiVolumeMesherExecute()
+
+--############################################### Set Material IDs
+chiVolumeMesherSetMatIDToAll(0)
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Fissile Material")
+
+chiPhysicsMaterialAddProperty(materials[1], TRANSPORT_XSECTIONS)
+
+xs_file = "xs_1g_fissile.cxs"
+chiPhysicsMaterialSetProperty(materials[1], TRANSPORT_XSECTIONS,
+                              CHI_XSFILE, xs_file)
+
+--############################################### Setup Physics
+num_groups = 1
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle =
+        chiCreateProductQuadrature(GAUSS_LEGENDRE,n_angles),
+      inner_linear_method = "gmres",
+      l_max_its = si_max_iterations,
+      l_abs_tol = si_tolerance,
+    }
+  }
+}
+
+lbs_options =
+{
+  boundary_conditions = { { name = "zmin", type = "reflecting"},
+                          { name = "zmax", type = "reflecting"} },
+  scattering_order = 0,
+
+  use_precursors = false,
+
+  verbose_inner_iterations = false,
+  verbose_outer_iterations = true,
+}
+
+phys = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+lbs.SetOptions(phys, lbs_options)
+
+k_solver0 = lbs.XXArnoldiKEigen.Create
+({
+  lbs_solver_handle = phys,
+  num_modes = 4,
+  mode_tol = 1.0e-8
+})
+chiSolverInitialize(k_solver0)
+chiSolverExecute(k_solver0)
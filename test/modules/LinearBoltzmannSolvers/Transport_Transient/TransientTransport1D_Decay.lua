@@ -0,0 +1,141 @@
+-- 1D Transient Transport test of the decay of a flux in an infinite medium.
+-- SDM: PWLD
+-- The infinite medium, reflecting on both sides, is at the steady state of
+-- a uniform source, which is switched off at t=0. The flux stays flat and
+-- decays as phi^{n+1}/phi^n = (1/(v dt) - (1-theta) sa)/(1/(v dt) + theta sa)
+-- with sa = 0.5, v = 1 and dt = 0.1. After 10 steps:
+-- Test: Crank-Nicolson, angular flux,  Ratio1=6.06467459e-01
+--       Implicit Euler, flux moments,  Ratio2=6.13913254e-01
+num_procs = 2
+
+
+
+
+
+--############################################### Check num_procs
+if (check_num_procs==nil and chi_number_of_processes ~= num_procs) then
+  chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+    "Expected "..tostring(num_procs)..
+    ". Pass check_num_procs=false to override if possible.")
+  os.exit(false)
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+mesh={}
+N=20
+L=10.0
+xmin = 0.0
+dx = L/N
+for i=1,(N+1) do
+  k=i-1
+  mesh[i] = xmin + k*dx
+end
+chiMeshCreateUnpartitioned1DOrthoMesh(mesh)
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+chiVolumeMesherSetMatIDToAll(0)
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+
+num_groups = 1
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+  CHI_XSFILE,"xs_1g_absorber.cxs")
+
+src={}
+for g=1,num_groups do
+  src[g] = 1.0
+end
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE,8)
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_num_subsets = 1,
+      groupset_num_subsets = 1,
+      inner_linear_method = "gmres",
+      l_abs_tol = 1.0e-12,
+      l_max_its = 100,
+      gmres_restart_interval = 50,
+    },
+  }
+}
+
+lbs_options =
+{
+  boundary_conditions =
+  {
+    { name = "zmin", type = "reflecting" },
+    { name = "zmax", type = "reflecting" },
+  },
+  scattering_order = 0,
+  save_angular_flux = true,
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+lbs.SetOptions(phys1, lbs_options)
+
+--############################################### Steady state
+ss_solver = lbs.SteadyStateSolver.Create({lbs_solver_handle = phys1})
+
+chiSolverInitialize(ss_solver)
+chiSolverExecute(ss_solver)
+
+fflist,count = chiLBSGetScalarFieldFunctionList(phys1)
+
+vol0 = chi_mesh.RPPLogicalVolume.Create({infx=true, infy=true, infz=true})
+ffi1 = chiFFInterpolationCreate(VOLUME)
+chiFFInterpolationSetProperty(ffi1,OPERATION,OP_MAX)
+chiFFInterpolationSetProperty(ffi1,LOGICAL_VOLUME,vol0)
+chiFFInterpolationSetProperty(ffi1,ADD_FIELDFUNCTION,fflist[1])
+chiFFInterpolationInitialize(ffi1)
+
+function MaxPhi()
+  chiFFInterpolationExecute(ffi1)
+  return chiFFInterpolationGetValue(ffi1)
+end
+
+phi0 = MaxPhi()
+
+--############################################### Switch the source off
+chiLBSSetSourceTimeTable(phys1, "volumetric", {0.0, 1.0e-6}, {1.0, 0.0})
+
+--############################################### Crank-Nicolson transient
+cn = chi_math.CrankNicolsonTimeIntegration.Create({})
+tr_solver1 = lbs.TransientSolver.Create({ lbs_solver_handle = phys1,
+                                          time_integration = cn,
+                                          dt = 0.1,
+                                          t_final = 1.0,
+                                          time_derivative = "angular_flux" })
+chiSolverInitialize(tr_solver1)
+chiSolverExecute(tr_solver1)
+
+phi1 = MaxPhi()
+chiLog(LOG_0,string.format("Ratio1=%.8e", phi1/phi0))
+
+--############################################### Implicit Euler transient
+ie = chi_math.ImplicitEulerTimeIntegration.Create({})
+tr_solver2 = lbs.TransientSolver.Create({ lbs_solver_handle = phys1,
+                                          time_integration = ie,
+                                          dt = 0.1,
+                                          t_final = 1.0,
+                                          time_derivative = "flux_moments" })
+chiSolverInitialize(tr_solver2)
+chiSolverExecute(tr_solver2)
+
+phi2 = MaxPhi()
+chiLog(LOG_0,string.format("Ratio2=%.8e", phi2/phi1))
@@ -0,0 +1,129 @@
+-- 1D Transient Transport test of the improved quasi-static mode.
+-- SDM: PWLD
+-- The infinite medium, reflecting on both sides, is critical, with six
+-- precursor groups, and is made 21 cents supercritical at t=0 by raising
+-- its fission cross section. The flux stays flat, hence its amplitude is
+-- that of the point kinetics of the medium, integrated with implicit Euler
+-- on 10 micro steps of each of the 10 transport steps of dt = 0.01.
+-- Test: Ratio=1.27617398e+00
+num_procs = 2
+
+
+
+
+
+--############################################### Check num_procs
+if (check_num_procs==nil and chi_number_of_processes ~= num_procs) then
+  chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+    "Expected "..tostring(num_procs)..
+    ". Pass check_num_procs=false to override if possible.")
+  os.exit(false)
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+mesh={}
+N=20
+L=10.0
+xmin = 0.0
+dx = L/N
+for i=1,(N+1) do
+  k=i-1
+  mesh[i] = xmin + k*dx
+end
+chiMeshCreateUnpartitioned1DOrthoMesh(mesh)
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+chiVolumeMesherSetMatIDToAll(0)
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Fissile Material");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+
+num_groups = 1
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+  CHI_XSFILE,"xs_inf_critical_1g.cxs")
+
+--############################################### Setup Physics
+pquad0 = chiCreateProductQuadrature(GAUSS_LEGENDRE,8)
+lbs_block =
+{
+  num_groups = num_groups,
+  groupsets =
+  {
+    {
+      groups_from_to = {0, num_groups-1},
+      angular_quadrature_handle = pquad0,
+      angle_aggregation_num_subsets = 1,
+      groupset_num_subsets = 1,
+      inner_linear_method = "gmres",
+      l_abs_tol = 1.0e-12,
+      l_max_its = 200,
+      gmres_restart_interval = 50,
+    },
+  }
+}
+
+lbs_options =
+{
+  boundary_conditions =
+  {
+    { name = "zmin", type = "reflecting" },
+    { name = "zmax", type = "reflecting" },
+  },
+  scattering_order = 0,
+  use_precursors = true,
+  save_angular_flux = true,
+}
+
+phys1 = lbs.DiscreteOrdinatesSolver.Create(lbs_block)
+lbs.SetOptions(phys1, lbs_options)
+
+--############################################### Initial condition
+k_solver = lbs.XXPowerIterationKEigen.Create({ lbs_solver_handle = phys1,
+                                               k_tol = 1.0e-10 })
+chiSolverInitialize(k_solver)
+chiSolverExecute(k_solver)
+
+fflist,count = chiLBSGetScalarFieldFunctionList(phys1)
+
+vol0 = chi_mesh.RPPLogicalVolume.Create({infx=true, infy=true, infz=true})
+ffi1 = chiFFInterpolationCreate(VOLUME)
+chiFFInterpolationSetProperty(ffi1,OPERATION,OP_MAX)
+chiFFInterpolationSetProperty(ffi1,LOGICAL_VOLUME,vol0)
+chiFFInterpolationSetProperty(ffi1,ADD_FIELDFUNCTION,fflist[1])
+chiFFInterpolationInitialize(ffi1)
+
+function MaxPhi()
+  chiFFInterpolationExecute(ffi1)
+  return chiFFInterpolationGetValue(ffi1)
+end
+
+phi0 = MaxPhi()
+
+--############################################### IQS transient
+prk_solver = prk.TransientSolver.Create({ time_integration = "implicit_euler" })
+
+ie = chi_math.ImplicitEulerTimeIntegration.Create({})
+tr_solver = lbs.TransientSolver.Create({ lbs_solver_handle = phys1,
+                                         time_integration = ie,
+                                         dt = 0.01,
+                                         t_final = 0.1,
+                                         amplitude_solver = prk_solver,
+                                         iqs_micro_steps = 10 })
+chiSolverInitialize(tr_solver)
+
+-- The kinetics parameters of the initial condition are those of the
+-- transient solver's initialization, hence the perturbation follows it
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+  CHI_XSFILE,"xs_inf_21cent_1g.cxs")
+chiLBSUpdateCrossSections(phys1)
+
+chiSolverExecute(tr_solver)
+
+phi1 = MaxPhi()
+chiLog(LOG_0,string.format("Ratio=%.8e", phi1/phi0))
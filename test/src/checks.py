@@ -3,6 +3,7 @@ import warnings
 import re  # regular expressions
 import pathlib
 import difflib
+import json
 
 
 class Check:
@@ -21,6 +22,16 @@ class Check:
     def GetAnnotations(self):
         return self.annotations
 
+    def RequiresTimeLog(self):
+        """Whether the check needs the timing logs printed at the end of a
+           run, i.e., the profiler report"""
+        return False
+
+    def SetRunContext(self, wall_time: float, argv):
+        """Supplies the measured wall time of the run and the test system
+           arguments. Only needed by some checks"""
+        pass
+
 
 # ===================================================================
 class KeyValuePairCheck(Check):
@@ -451,3 +462,177 @@ class GoldFileCheck(Check):
             lines_b = ScopeFilterLines(lines_b, self.scope_keyword)
 
         return lines_a, lines_b
+
+
+# ===================================================================
+class PerformanceCheck(Check):
+    """Compares the wall time, sweep time and peak memory of a run against a
+       baseline stored in perf_baselines/<machine>.json, next to the test
+       file, keyed by the test filename. A metric fails when it exceeds its
+       baseline by more than its relative tolerance.
+
+       The wall time is the one measured by the test system. The sweep time is
+       the total, over the "Sweep" rows, of the slowest location times in the
+       profiler report, and the peak memory is the largest "Process resident"
+       maximum of the memory reports, or else the "Maximum process memory", in
+       MB."""
+
+    METRICS = ["wall_time", "sweep_time", "peak_memory"]
+    DEFAULT_TOLERANCES = {"wall_time": 0.25,
+                          "sweep_time": 0.25,
+                          "peak_memory": 0.10}
+
+    def __init__(self, params: dict, message_prefix: str):
+        super().__init__()
+        self.metrics: list = list(self.METRICS)
+        self.tolerances: dict = dict(self.DEFAULT_TOLERANCES)
+        self.baseline_key: str = ""
+        self.non_fatal: bool = False
+
+        self.wall_time = None
+        self.machine: str = ""
+        self.update_baselines: bool = False
+
+        if "metrics" in params:
+            self.metrics = params["metrics"]
+            for metric in self.metrics:
+                if metric not in self.METRICS:
+                    warnings.warn(message_prefix +
+                                  f'Unknown metric "{metric}", must be one '
+                                  f'of {self.METRICS}')
+                    raise ValueError
+        if "tolerances" in params:
+            if not isinstance(params["tolerances"], dict):
+                warnings.warn(message_prefix + '"tolerances" field must be a '
+                                               'dictionary')
+                raise ValueError
+            self.tolerances.update(params["tolerances"])
+        if "baseline_key" in params:
+            self.baseline_key = params["baseline_key"]
+        if "non_fatal" in params:
+            self.non_fatal = params["non_fatal"]
+
+    def __str__(self):
+        return f'metrics={self.metrics}, ' + \
+            f'tolerances={self.tolerances}, ' + \
+            f'non_fatal={self.non_fatal}'
+
+    def RequiresTimeLog(self):
+        return "sweep_time" in self.metrics
+
+    def SetRunContext(self, wall_time: float, argv):
+        self.wall_time = wall_time
+        self.machine = argv.perf_machine
+        self.update_baselines = argv.perf_update_baselines
+        if argv.perf_nonfatal:
+            self.non_fatal = True
+
+    def ParseMetrics(self, filename):
+        """Reads the metrics of a run from its console output"""
+        metrics = {"wall_time": self.wall_time,
+                   "sweep_time": None,
+                   "peak_memory": None}
+
+        file = open(filename, "r")
+        lines = file.readlines()
+        file.close()
+
+        in_profiler_report = False
+        sweep_time = None
+        for raw_line in lines:
+            line = re.sub(r"^\[\d+\]  ", "", raw_line.rstrip("\n"))
+            words = line.split()
+
+            if line.startswith("Process resident") and len(words) >= 5:
+                # Name, then min, average, max, location of the max and total
+                value = float(words[-3])
+                if metrics["peak_memory"] is None or \
+                        value > metrics["peak_memory"]:
+                    metrics["peak_memory"] = value
+            elif line.find("Maximum process memory") >= 0 and \
+                    metrics["peak_memory"] is None:
+                metrics["peak_memory"] = float(words[-2]) * 1024.0
+
+            if line.startswith("Profiler report over"):
+                in_profiler_report = True
+                continue
+            if in_profiler_report:
+                # Region name in 40 columns, then calls, min, max and mean
+                if line[:40].strip() == "Sweep":
+                    values = line[40:].split()
+                    sweep_time = (sweep_time or 0.0) + float(values[2])
+
+        metrics["sweep_time"] = sweep_time
+        return metrics
+
+    def PerformCheck(self, filename, errorcode, verbose: bool):
+        try:
+            outfiledir = pathlib.Path(os.path.dirname(filename) + "/")
+            baseline_dir = str(outfiledir.parent.absolute()) + \
+                "/perf_baselines/"
+            baseline_filename = baseline_dir + self.machine + ".json"
+
+            key = self.baseline_key
+            if key == "":
+                key = os.path.splitext(os.path.basename(filename))[0]
+
+            metrics = self.ParseMetrics(filename)
+            for metric in self.metrics:
+                if metrics[metric] is None:
+                    if verbose:
+                        warnings.warn(f'Performance check: metric "{metric}" '
+                                      f'not found in {filename}')
+                    self.annotations.append(f"{metric} not found")
+                    return self.non_fatal
+
+            baselines = {}
+            if os.path.isfile(baseline_filename):
+                file = open(baseline_filename, "r")
+                baselines = json.load(file)
+                file.close()
+
+            if self.update_baselines:
+                baselines[key] = {metric: metrics[metric]
+                                  for metric in self.metrics}
+                os.makedirs(baseline_dir, exist_ok=True)
+                file = open(baseline_filename, "w")
+                json.dump(baselines, file, indent=2, sort_keys=True)
+                file.write("\n")
+                file.close()
+                self.annotations.append("Perf baseline updated")
+                return True
+
+            if key not in baselines:
+                if verbose:
+                    warnings.warn(f'Performance baseline "{key}" does not '
+                                  f'exist in\n{baseline_filename}')
+                self.annotations.append("Perf baseline missing")
+                return self.non_fatal
+
+            passed = True
+            for metric in self.metrics:
+                if metric not in baselines[key]:
+                    continue
+                baseline = baselines[key][metric]
+                limit = baseline * (1.0 + self.tolerances[metric])
+                if metrics[metric] > limit:
+                    passed = False
+                    if verbose:
+                        print(f"Performance check failed : {metric} " +
+                              "{:.4g} exceeds baseline {:.4g} by more than "
+                              "{:.0f}%".format(metrics[metric], baseline,
+                                               100 * self.tolerances[metric]))
+
+            if passed:
+                return True
+
+            if self.non_fatal:
+                self.annotations.append("Perf regression")
+                return True
+
+        except Exception as e:
+            self.annotations.append("Python error")
+            if verbose:
+                warnings.warn(str(e))
+
+        return False
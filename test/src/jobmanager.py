@@ -86,6 +86,13 @@ class TestConfiguration:
                     self.checks.append(new_check)
                 except ValueError:
                     continue
+            elif check_params["type"] == "Performance":
+                try:
+                    prefix = message_prefix + f'Check number {check_num} '
+                    new_check = checks.PerformanceCheck(check_params, prefix)
+                    self.checks.append(new_check)
+                except ValueError:
+                    continue
             else:
                 warnings.warn("Unsupported check type: " + check_params["type"])
                 raise ValueError
@@ -27,7 +27,8 @@ class TestSlot:
         cmd += self.argv.exe + " "
         cmd += test.filename + " "
         cmd += "--suppress_color "
-        cmd += "--supress_beg_end_timelog "
+        if not any(check.RequiresTimeLog() for check in test.checks):
+            cmd += "--supress_beg_end_timelog "
         cmd += "master_export=false "
         for arg in test.args:
             cmd += arg + " "
@@ -80,6 +81,7 @@ class TestSlot:
         error_code = self.process.returncode
         for check in self.test.checks:
             verbose = self.argv.verbose
+            check.SetRunContext(self.time_end - self.time_start, self.argv)
             check_passed = check.PerformCheck(output_filename,
                                               error_code, verbose)
             passed = passed and check_passed